@@ -0,0 +1,134 @@
+#pragma once
+/**
+ * @file bench_world.h
+ * @brief 基准测试用的合成世界：按指定数量生成敌我单位与可渲染实体。
+ *
+ * @details
+ * 蓝图与路径点读取自真实的 assets 数据（需在仓库根目录运行），
+ * 但不创建窗口与渲染器；BlueprintManager 使用不预加载资源的构造函数。
+ */
+
+#include "game/data/behavior_index.h"
+#include "game/data/game_stats.h"
+#include "game/data/path_table.h"
+#include "game/data/position_cache.h"
+#include "game/data/waypoint_node.h"
+#include "game/defs/constants.h"
+#include "game/defs/groups.h"
+#include "game/factory/blueprint_manager.h"
+#include "game/factory/entity_factory.h"
+#include "game/loader/entity_builder_mw.h"
+#include "engine/component/render_component.h"
+#include "engine/component/sprite_component.h"
+#include "engine/component/transform_component.h"
+#include "engine/component/velocity_component.h"
+#include "engine/ecs/command_buffer.h"
+#include "engine/loader/level_loader.h"
+#include "engine/spatial/spatial_grid.h"
+#include "engine/utils/random.h"
+#include <entt/core/hashed_string.hpp>
+#include <entt/entity/registry.hpp>
+#include <entt/signal/dispatcher.hpp>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace bench {
+
+inline constexpr const char* BENCH_MAP_PATH = "assets/maps/level1.tmj";
+
+/// @brief 进程内共享的蓝图数据（只读，加载一次）
+inline std::shared_ptr<game::factory::BlueprintManager> sharedBlueprints() {
+    static auto blueprints = [] {
+        auto manager = std::make_shared<game::factory::BlueprintManager>();
+        if (!manager->loadAll()) {
+            throw std::runtime_error("benchmark: failed to load blueprints (run from the repository root)");
+        }
+        return manager;
+    }();
+    return blueprints;
+}
+
+/**
+ * @brief 合成世界：独立的注册表、分发器、路径点与实体工厂
+ */
+struct BenchWorld {
+    entt::registry registry_;
+    game::data::BehaviorIndex behaviors_{ registry_ };     ///< 在注册表之后声明，先于注册表析构
+    entt::dispatcher dispatcher_;
+    engine::ecs::CommandBuffer commands_;
+    game::data::GameStats game_stats_;
+    std::unordered_map<int, game::data::WaypointNode> waypoint_nodes_;
+    std::vector<int> start_points_;
+    game::data::PathTable path_table_;
+    std::shared_ptr<game::factory::BlueprintManager> blueprints_{ sharedBlueprints() };
+    std::unique_ptr<game::factory::EntityFactory> factory_;
+    std::mt19937 rng_{ 20240601u };
+
+    /// @param declare_groups 是否预先声明游戏的 owning group，关闭时组件池保持普通存储布局
+    explicit BenchWorld(bool declare_groups = true) {
+        auto level_data = engine::loader::LevelLoader::loadLevelDataAsync(BENCH_MAP_PATH).get();
+        if (!level_data.valid_) {
+            throw std::runtime_error("benchmark: failed to parse " + std::string(BENCH_MAP_PATH));
+        }
+        game::loader::EntityBuilderMW::collectWaypoints(level_data, waypoint_nodes_, start_points_);
+        if (start_points_.empty()) {
+            throw std::runtime_error("benchmark: level has no start waypoint");
+        }
+        path_table_.build(waypoint_nodes_);
+
+        registry_.ctx().emplace<std::shared_ptr<game::factory::BlueprintManager>>(blueprints_);
+        registry_.ctx().emplace<game::data::GameStats&>(game_stats_);
+        registry_.ctx().emplace<game::data::BehaviorIndex&>(behaviors_);
+        registry_.ctx().emplace<engine::spatial::SpatialGrid>(game::defs::BLOCK_RADIUS * 2.0f);
+        registry_.ctx().emplace<game::data::PositionCache>();
+        registry_.ctx().emplace<engine::utils::RandomService>(20240601u);
+        if (declare_groups) {
+            game::defs::declareGroups(registry_);
+        }
+        factory_ = std::make_unique<game::factory::EntityFactory>(registry_, *blueprints_);
+    }
+
+    [[nodiscard]] glm::vec2 randomPosition() {
+        std::uniform_real_distribution<float> x(0.0f, 1280.0f);
+        std::uniform_real_distribution<float> y(0.0f, 720.0f);
+        return { x(rng_), y(rng_) };
+    }
+
+    /// @brief 沿真实路径起点附近生成敌人（约 90%）与玩家单位（约 10%）
+    void spawnUnits(int count) {
+        namespace class_id = game::defs::class_id;
+        static constexpr entt::id_type ENEMY_CLASSES[] = {
+            class_id::SLIME, class_id::WOLF, class_id::GOBLIN, class_id::DARK_WITCH };
+        static constexpr entt::id_type PLAYER_CLASSES[] = {
+            class_id::WARRIOR, class_id::ARCHER, class_id::LANCER, class_id::WITCH };
+
+        for (int i = 0; i < count; ++i) {
+            if (i % 10 == 9) {
+                factory_->createPlayerUnit(PLAYER_CLASSES[i % 4], randomPosition());
+                continue;
+            }
+            const int start = start_points_[static_cast<std::size_t>(i) % start_points_.size()];
+            std::uniform_real_distribution<float> jitter(-32.0f, 32.0f);
+            const glm::vec2 position = waypoint_nodes_.at(start).position_ + glm::vec2{ jitter(rng_), jitter(rng_) };
+            factory_->createEnemyUnit(ENEMY_CLASSES[i % 4], position, start);
+        }
+    }
+
+    /// @brief 生成只带 Transform/Velocity/Sprite/Render 的纯引擎实体
+    void spawnRenderables(int count) {
+        std::uniform_real_distribution<float> speed(-60.0f, 60.0f);
+        for (int i = 0; i < count; ++i) {
+            auto entity = registry_.create();
+            registry_.emplace<engine::component::TransformComponent>(entity, randomPosition());
+            registry_.emplace<engine::component::VelocityComponent>(entity, glm::vec2{ speed(rng_), speed(rng_) });
+            registry_.emplace<engine::component::SpriteComponent>(entity,
+                engine::component::Sprite(entt::hashed_string("bench_sprite").value(), engine::utils::Rect{ 0.0f, 0.0f, 32.0f, 32.0f }));
+            registry_.emplace<engine::component::RenderComponent>(entity, engine::component::RenderComponent{ i % 3, 0.0f });
+        }
+    }
+};
+
+} // namespace bench
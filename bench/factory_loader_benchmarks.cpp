@@ -0,0 +1,129 @@
+/**
+ * @file factory_loader_benchmarks.cpp
+ * @brief 实体生成与关卡加载的基准。
+ *
+ * @details
+ * LevelLoader::applyLevelData 需要场景上下文与渲染器（瓦片实体与区块烘焙），
+ * 这里测量其与渲染无关的部分：地图/tileset 解析，以及路径点数据的提取与路径表编译。
+ * JSON 与预编译（.mwl，写到临时目录）两条路径分别测量。
+ */
+
+#include "bench_world.h"
+#include "engine/loader/cooked_level.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+namespace {
+
+void BM_EntityFactoryCreateEnemy(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        bench::BenchWorld world;
+        const auto start = world.start_points_.front();
+        const auto position = world.waypoint_nodes_.at(start).position_;
+        state.ResumeTiming();
+        for (int i = 0; i < count; ++i) {
+            benchmark::DoNotOptimize(world.factory_->createEnemyUnit(game::defs::class_id::WOLF, position, start));
+        }
+        state.PauseTiming();
+        world.registry_.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * count);
+}
+BENCHMARK(BM_EntityFactoryCreateEnemy)->Arg(1'000)->Arg(10'000)->Arg(50'000)->Unit(benchmark::kMillisecond);
+
+// 波次开场的批量路径：一次创建全部实体，逐组件整段写入
+void BM_EntityFactoryCreateEnemiesBulk(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        bench::BenchWorld world;
+        const auto start = world.start_points_.front();
+        const std::vector<glm::vec2> positions(count, world.waypoint_nodes_.at(start).position_);
+        const std::vector<int> waypoints(count, start);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(world.factory_->createEnemyUnits(game::defs::class_id::WOLF, positions, waypoints));
+        state.PauseTiming();
+        world.registry_.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(count));
+}
+BENCHMARK(BM_EntityFactoryCreateEnemiesBulk)->Arg(1'000)->Arg(10'000)->Arg(50'000)->Unit(benchmark::kMillisecond);
+
+// 预先解析 ClassIndex，生成时跳过 ID 查找，只剩模板组件复制
+void BM_EntityFactoryCreateEnemyAt(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        bench::BenchWorld world;
+        const auto start = world.start_points_.front();
+        const auto position = world.waypoint_nodes_.at(start).position_;
+        const auto index = world.blueprints_->findEnemyClass(game::defs::class_id::WOLF);
+        state.ResumeTiming();
+        for (int i = 0; i < count; ++i) {
+            benchmark::DoNotOptimize(world.factory_->createEnemyUnitAt(index, position, start));
+        }
+        state.PauseTiming();
+        world.registry_.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * count);
+}
+BENCHMARK(BM_EntityFactoryCreateEnemyAt)->Arg(1'000)->Arg(10'000)->Arg(50'000)->Unit(benchmark::kMillisecond);
+
+void BM_LevelLoaderParse(benchmark::State& state) {
+    for (auto _ : state) {
+        auto level_data = engine::loader::LevelLoader::loadLevelDataAsync(bench::BENCH_MAP_PATH, false).get();
+        if (!level_data.valid_) {
+            state.SkipWithError("failed to parse level1.tmj");
+            break;
+        }
+        benchmark::DoNotOptimize(level_data);
+    }
+}
+BENCHMARK(BM_LevelLoaderParse)->Unit(benchmark::kMillisecond);
+
+void BM_LevelLoaderParseAndApplyPaths(benchmark::State& state) {
+    for (auto _ : state) {
+        auto level_data = engine::loader::LevelLoader::loadLevelDataAsync(bench::BENCH_MAP_PATH, false).get();
+        std::unordered_map<int, game::data::WaypointNode> waypoint_nodes;
+        std::vector<int> start_points;
+        game::loader::EntityBuilderMW::collectWaypoints(level_data, waypoint_nodes, start_points);
+        game::data::PathTable path_table;
+        path_table.build(waypoint_nodes);
+        benchmark::DoNotOptimize(path_table.getNodeCount());
+    }
+}
+BENCHMARK(BM_LevelLoaderParseAndApplyPaths)->Unit(benchmark::kMillisecond);
+
+/// 映射预编译关卡并提取路径点（与 BM_LevelLoaderParseAndApplyPaths 对比）
+void BM_CookedLevelOpenAndApplyPaths(benchmark::State& state) {
+    const auto cooked_path = (std::filesystem::temp_directory_path() / "monsterwar_bench_level1.mwl").string();
+    std::string error_message;
+    if (!engine::loader::LevelLoader::cookLevel(bench::BENCH_MAP_PATH, cooked_path, error_message)) {
+        state.SkipWithError(error_message.c_str());
+        return;
+    }
+    for (auto _ : state) {
+        engine::loader::LevelLoadData level_data;
+        level_data.cooked_ = engine::loader::cooked::CookedLevel::open(cooked_path, error_message);
+        if (!level_data.cooked_) {
+            state.SkipWithError(error_message.c_str());
+            break;
+        }
+        std::unordered_map<int, game::data::WaypointNode> waypoint_nodes;
+        std::vector<int> start_points;
+        game::loader::EntityBuilderMW::collectWaypoints(level_data, waypoint_nodes, start_points);
+        game::data::PathTable path_table;
+        path_table.build(waypoint_nodes);
+        benchmark::DoNotOptimize(path_table.getNodeCount());
+    }
+    std::error_code ec;
+    std::filesystem::remove(cooked_path, ec);
+}
+BENCHMARK(BM_CookedLevelOpenAndApplyPaths)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,327 @@
+/**
+ * @file system_benchmarks.cpp
+ * @brief 热点系统的微基准：每个用例在 1k / 10k / 50k 实体的合成世界上运行一次 update。
+ */
+
+#include "bench_world.h"
+#include "game/component/stats_component.h"
+#include "engine/core/job_system.h"
+#include "engine/ecs/groups.h"
+#include "engine/render/camera.h"
+#include "engine/system/animation_system.h"
+#include "engine/system/movement_system.h"
+#include "engine/system/render_system.h"
+#include "engine/system/ysort_system.h"
+#include "engine/utils/math.h"
+#include "game/defs/tags.h"
+#include "game/system/block_system.h"
+#include "game/system/followpath_system.h"
+#include "game/system/remove_dead_system.h"
+#include "game/system/set_target_system.h"
+#include "game/system/spatial_index_system.h"
+#include "game/system/timer_system.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+constexpr float BENCH_DT = 1.0f / 60.0f;
+
+void entityCounts(benchmark::internal::Benchmark* benchmark) {
+    benchmark->Arg(1'000)->Arg(10'000)->Arg(50'000)->Unit(benchmark::kMicrosecond);
+}
+
+void setItems(benchmark::State& state) {
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+
+// --- 引擎系统 ---
+
+void BM_MovementSystem(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnRenderables(static_cast<int>(state.range(0)));
+    engine::system::MovementSystem system;
+    for (auto _ : state) {
+        system.update(world.registry_, BENCH_DT);
+    }
+    setItems(state);
+}
+BENCHMARK(BM_MovementSystem)->Apply(entityCounts);
+
+/// 积分方式对比，参数 0 为移动实体数，参数 1 为 MovementIntegration（0 = PACKED 批量向量积分，1 = PER_ENTITY 逐实体）；只有调用线程
+void BM_MovementIntegration(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnRenderables(static_cast<int>(state.range(0)));
+    engine::system::MovementSystem system;
+    system.setIntegration(static_cast<engine::system::MovementIntegration>(state.range(1)));
+    for (auto _ : state) {
+        system.update(world.registry_, BENCH_DT);
+    }
+    state.SetLabel(state.range(1) == 0 ? engine::utils::distanceKernelName() : "per_entity");
+    setItems(state);
+}
+BENCHMARK(BM_MovementIntegration)
+    ->ArgsProduct({ { 1'000, 10'000, 100'000 }, { 0, 1 } })
+    ->Unit(benchmark::kMicrosecond);
+
+/// 并行移动 + Y 排序，参数 1 为工作线程数（0 表示只有调用线程）
+void BM_ParallelMovementYSort(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnRenderables(static_cast<int>(state.range(0)));
+    engine::core::JobSystem jobs(static_cast<std::size_t>(state.range(1)));
+    world.registry_.ctx().emplace<engine::core::JobSystem&>(jobs);
+    engine::system::MovementSystem movement;
+    engine::system::YSortSystem ysort{ world.registry_ };
+    for (auto _ : state) {
+        movement.update(world.registry_, BENCH_DT);
+        ysort.update(world.registry_);
+    }
+    setItems(state);
+}
+BENCHMARK(BM_ParallelMovementYSort)
+    ->ArgsProduct({ { 10'000, 50'000 }, { 0, 1, 3, 7 } })
+    ->ArgNames({ "entities", "workers" })
+    ->Unit(benchmark::kMicrosecond);
+
+/// 热组件集遍历，参数 1 为是否使用 owning group（0 为同组件的普通 view）
+void BM_HotSetIteration(benchmark::State& state) {
+    const bool use_groups = state.range(1) != 0;
+    bench::BenchWorld world(use_groups);
+    world.spawnRenderables(static_cast<int>(state.range(0)));
+    world.spawnUnits(static_cast<int>(state.range(0)) / 10);
+    using namespace engine::component;
+    auto integrate = [](auto&& set) {
+        set.each([](auto& transform, const auto& velocity) { transform.position_ += velocity.velocity_ * BENCH_DT; });
+    };
+    auto accumulate = [](auto&& set) {
+        float sum = 0.0f;
+        set.each([&sum](const auto& render, const auto& transform, const auto&) { sum += transform.position_.y + render.getYIndex(); });
+        benchmark::DoNotOptimize(sum);
+    };
+    for (auto _ : state) {
+        if (use_groups) {
+            auto movement = engine::ecs::movementGroup(world.registry_);
+            movement.each([](auto& velocity, auto& transform) { transform.position_ += velocity.velocity_ * BENCH_DT; });
+            auto render = engine::ecs::renderGroup(world.registry_);
+            float sum = 0.0f;
+            render.each([&sum](const auto& component, const auto& transform, const auto&) { sum += transform.position_.y + component.getYIndex(); });
+            benchmark::DoNotOptimize(sum);
+        } else {
+            integrate(world.registry_.view<TransformComponent, const VelocityComponent>(entt::exclude<DisabledTag>));
+            accumulate(world.registry_.view<const RenderComponent, const TransformComponent, const SpriteComponent>(entt::exclude<DisabledTag>));
+        }
+    }
+    setItems(state);
+}
+BENCHMARK(BM_HotSetIteration)
+    ->ArgsProduct({ { 10'000, 50'000 }, { 0, 1 } })
+    ->ArgNames({ "entities", "groups" })
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_YSortSystem(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnRenderables(static_cast<int>(state.range(0)));
+    engine::system::MovementSystem movement;
+    engine::system::YSortSystem system{ world.registry_ };
+    for (auto _ : state) {
+        state.PauseTiming();
+        movement.update(world.registry_, BENCH_DT);
+        state.ResumeTiming();
+        system.update(world.registry_);
+    }
+    setItems(state);
+}
+BENCHMARK(BM_YSortSystem)->Apply(entityCounts);
+
+/// Y 排序：只有一成实体可移动（其余相当于静态瓦片），静态实体不再逐帧重算
+void BM_YSortSystemMostlyStatic(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnRenderables(static_cast<int>(state.range(0)));
+    {
+        std::vector<entt::entity> frozen;
+        int index = 0;
+        for (auto entity : world.registry_.view<engine::component::VelocityComponent>()) {
+            if (index++ % 10 != 0) {
+                frozen.push_back(entity);
+            }
+        }
+        world.registry_.remove<engine::component::VelocityComponent>(frozen.begin(), frozen.end());
+    }
+    engine::system::MovementSystem movement;
+    engine::system::YSortSystem system{ world.registry_ };
+    for (auto _ : state) {
+        state.PauseTiming();
+        movement.update(world.registry_, BENCH_DT);
+        state.ResumeTiming();
+        system.update(world.registry_);
+    }
+    setItems(state);
+}
+BENCHMARK(BM_YSortSystemMostlyStatic)->Apply(entityCounts);
+
+/// 绘制排序（不提交绘制），参数 1 为是否使用增量排序
+void BM_RenderSort(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnRenderables(static_cast<int>(state.range(0)));
+    engine::system::MovementSystem movement;
+    engine::system::YSortSystem ysort{ world.registry_ };
+    engine::system::RenderSystem system;
+    system.setIncrementalSort(state.range(1) != 0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        movement.update(world.registry_, BENCH_DT);
+        ysort.update(world.registry_);
+        system.extract(world.registry_, nullptr, 0);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(system.prepareDrawOrder());
+    }
+    setItems(state);
+}
+BENCHMARK(BM_RenderSort)
+    ->ArgsProduct({ { 1'000, 10'000, 50'000 }, { 0, 1 } })
+    ->ArgNames({ "entities", "incremental" })
+    ->Unit(benchmark::kMicrosecond);
+
+/// 视口剔除 + 绘制排序：相机只覆盖世界的一角，视野外的实体不进入排序
+void BM_RenderCullSort(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnRenderables(static_cast<int>(state.range(0)));
+    engine::system::MovementSystem movement;
+    engine::system::YSortSystem ysort{ world.registry_ };
+    engine::system::RenderSystem system;
+    const engine::render::Camera camera(glm::vec2{ 320.0f, 180.0f }, glm::vec2{ 480.0f, 270.0f });
+    for (auto _ : state) {
+        state.PauseTiming();
+        movement.update(world.registry_, BENCH_DT);
+        ysort.update(world.registry_);
+        system.extract(world.registry_, &camera, 0);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(system.prepareDrawOrder(&camera));
+    }
+    setItems(state);
+}
+BENCHMARK(BM_RenderCullSort)->Apply(entityCounts);
+
+/// 模拟侧的绘制快照提取（拷贝渲染分组的绘制数据并发布）
+void BM_RenderExtract(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnRenderables(static_cast<int>(state.range(0)));
+    engine::system::RenderSystem system;
+    system.reserve(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        system.extract(world.registry_, nullptr, 0);
+    }
+    setItems(state);
+}
+BENCHMARK(BM_RenderExtract)->Apply(entityCounts);
+
+void BM_AnimationSystem(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnUnits(static_cast<int>(state.range(0)));
+    engine::system::AnimationSystem system(world.registry_, world.dispatcher_);
+    for (auto _ : state) {
+        system.update(BENCH_DT);
+        state.PauseTiming();
+        world.dispatcher_.clear();
+        state.ResumeTiming();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_AnimationSystem)->Apply(entityCounts);
+
+// --- 游戏系统 ---
+
+void BM_SpatialIndexSystem(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnUnits(static_cast<int>(state.range(0)));
+    game::system::SpatialIndexSystem system;
+    for (auto _ : state) {
+        system.update(world.registry_);
+    }
+    setItems(state);
+}
+BENCHMARK(BM_SpatialIndexSystem)->Apply(entityCounts);
+
+void BM_SetTargetSystem(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnUnits(static_cast<int>(state.range(0)));
+    game::system::SpatialIndexSystem spatial_index;
+    game::system::SetTargetSystem system{ world.registry_ };
+    spatial_index.update(world.registry_);
+    for (auto _ : state) {
+        system.update(world.registry_, world.commands_);
+        world.commands_.apply(world.registry_);
+    }
+    setItems(state);
+}
+BENCHMARK(BM_SetTargetSystem)->Apply(entityCounts);
+
+void BM_BlockSystem(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnUnits(static_cast<int>(state.range(0)));
+    game::system::SpatialIndexSystem spatial_index;
+    game::system::BlockSystem system;
+    spatial_index.update(world.registry_);
+    for (auto _ : state) {
+        system.update(world.registry_, world.commands_);
+        world.commands_.apply(world.registry_);
+        state.PauseTiming();
+        world.dispatcher_.clear();
+        state.ResumeTiming();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_BlockSystem)->Apply(entityCounts);
+
+void BM_FollowPathSystem(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnUnits(static_cast<int>(state.range(0)));
+    game::system::FollowPathSystem system;
+    for (auto _ : state) {
+        system.update(world.registry_, world.dispatcher_, world.path_table_);
+        state.PauseTiming();
+        world.dispatcher_.clear();
+        state.ResumeTiming();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_FollowPathSystem)->Apply(entityCounts);
+
+void BM_TimerSystem(benchmark::State& state) {
+    bench::BenchWorld world;
+    world.spawnUnits(static_cast<int>(state.range(0)));
+    game::system::TimerSystem system;
+    for (auto _ : state) {
+        system.update(world.registry_, world.dispatcher_, BENCH_DT);
+        state.PauseTiming();
+        world.dispatcher_.clear();
+        state.ResumeTiming();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_TimerSystem)->Apply(entityCounts);
+
+/// 每次迭代将 10% 的单位标记为死亡后清理
+void BM_RemoveDeadSystem(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    bench::BenchWorld world;
+    game::system::RemoveDeadSystem system;
+    for (auto _ : state) {
+        state.PauseTiming();
+        const int missing = count - static_cast<int>(world.registry_.view<game::component::StatsComponent>().size());
+        if (missing > 0) {
+            world.spawnUnits(missing);
+        }
+        int index = 0;
+        for (auto entity : world.registry_.view<game::component::StatsComponent>()) {
+            if (index++ % 10 == 0) {
+                world.registry_.emplace_or_replace<game::defs::DeadTag>(entity);
+            }
+        }
+        state.ResumeTiming();
+        system.update(world.registry_);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * count / 10);
+}
+BENCHMARK(BM_RemoveDeadSystem)->Apply(entityCounts);
+
+} // namespace
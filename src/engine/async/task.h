@@ -0,0 +1,230 @@
+#pragma once
+/**
+ * @file task.h
+ * @brief C++20 协程任务 engine::async::Task<T>，以及在 TaskPool 上等待的可等待对象。
+ *
+ * @details
+ * 加载流程写成一个协程，原本分散在 future 轮询、consumeFuture 回调与阻塞 get() 中的步骤按顺序书写：
+ * @code
+ * engine::async::Task<bool> GameScene::loadAsync() {
+ *     auto& pool = context_.getTaskPool();
+ *     auto config = engine::async::runOnPool(pool, priority, [this] { return loadLevelConfig(); });   // 立即提交
+ *     loadBlueprints();                                   // 主线程步骤
+ *     co_await engine::async::nextFrame(pool);            // 让出这一帧
+ *     if (!co_await config) co_return false;              // 等待工作线程结果，在主线程上恢复
+ *     auto level = co_await engine::async::runOnPool(pool, priority, [path] { return LevelLoader::loadLevelData(path); });
+ *     co_return level.valid_;
+ * }
+ * @endcode
+ *
+ * 线程模型：协程体始终在主线程上执行。runOnPool() 的函数在 TaskPool 工作线程上执行，完成后经主线程队列恢复协程，
+ * nextFrame() 直接投递到主线程队列；两者都随 GameApp 每帧的 drainMainThread() 推进，主循环不会被加载阻塞。
+ *
+ * 生命周期：
+ * - Task 惰性启动：顶层任务由 start() 开始执行，直到第一次挂起；被 co_await 的子任务随等待开始
+ * - 协程挂起期间不能销毁 Task（恢复句柄已在主线程队列中），放弃一个未完成的任务前用 runToCompletion() 等它结束
+ * - 协程内未捕获的异常保存在 Task 中，由 result() / co_await 重新抛出
+ *
+ * 必须同步等待时（如未预取就进入场景），runToCompletion() 在当前线程上清空主线程队列直到任务完成。
+ */
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "../core/task_pool.h"
+
+namespace engine::async {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation_;      ///< co_await 本任务的协程，完成时对称转移回去
+    std::exception_ptr exception_;
+
+    /// @brief 结束时恢复等待者；顶层任务没有等待者，停在最终挂起点由 Task 销毁
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            auto continuation = handle.promise().continuation_;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+    void rethrowIfFailed() const {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value_;
+
+    Task<T> get_return_object() noexcept;
+    template <typename U>
+    void return_value(U&& value) { value_.emplace(std::forward<U>(value)); }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+};
+
+} // namespace detail
+
+/**
+ * @class Task
+ * @brief 只移动的协程任务句柄，既可被 co_await，也可作为顶层任务由 start() 启动、isDone() 轮询
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle) noexcept : handle_(handle) {}
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})), started_(other.started_) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, {});
+            started_ = other.started_;
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { reset(); }
+
+    [[nodiscard]] bool valid() const { return static_cast<bool>(handle_); }
+    [[nodiscard]] bool isStarted() const { return started_; }
+    /// @brief 已执行到末尾（或抛出异常）；空任务视为已完成
+    [[nodiscard]] bool isDone() const { return !handle_ || handle_.done(); }
+
+    /// @brief 顶层任务：开始执行直到第一次挂起（重复调用无效果）
+    void start() {
+        if (handle_ && !started_) {
+            started_ = true;
+            handle_.resume();
+        }
+    }
+
+    /// @brief 取出结果，须在 isDone() 之后调用；协程抛出的异常在此重新抛出
+    T result() {
+        handle_.promise().rethrowIfFailed();
+        if constexpr (!std::is_void_v<T>) {
+            return std::move(*handle_.promise().value_);
+        }
+    }
+
+    // --- 作为子任务被 co_await ---
+    bool await_ready() const noexcept { return isDone(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        started_ = true;
+        handle_.promise().continuation_ = awaiting;
+        return handle_;
+    }
+    T await_resume() { return result(); }
+
+private:
+    void reset() {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    Handle handle_;
+    bool started_{ false };
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+/**
+ * @class PoolAwaiter
+ * @brief runOnPool() 的结果：构造时即提交到 TaskPool，co_await 时若尚未完成则挂起，完成后在主线程上恢复
+ * @details 先创建多个 PoolAwaiter 再依次 co_await，即可让多个工作线程任务并行。
+ */
+template <typename R>
+class [[nodiscard]] PoolAwaiter {
+public:
+    template <typename Fn>
+    PoolAwaiter(core::TaskPool& pool, core::TaskPriority priority, Fn&& fn) : waiter_(std::make_shared<std::coroutine_handle<>>()) {
+        // 续体在主线程上执行，co_await 也只在主线程上发生，等待者不需要加锁
+        future_ = pool.submitThen(priority, std::forward<Fn>(fn), [waiter = waiter_] {
+            if (auto handle = std::exchange(*waiter, {})) {
+                handle.resume();
+            }
+        });
+    }
+
+    bool await_ready() const { return future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+    void await_suspend(std::coroutine_handle<> handle) const { *waiter_ = handle; }
+    /// @brief 工作线程上的异常在这里重新抛出
+    R await_resume() { return future_.get(); }
+
+private:
+    std::shared_ptr<std::coroutine_handle<>> waiter_;
+    std::future<R> future_;
+};
+
+/// @brief 在 TaskPool 工作线程上执行 fn，co_await 得到其返回值
+template <typename Fn>
+[[nodiscard]] auto runOnPool(core::TaskPool& pool, core::TaskPriority priority, Fn&& fn) {
+    return PoolAwaiter<std::invoke_result_t<std::decay_t<Fn>&>>(pool, priority, std::forward<Fn>(fn));
+}
+
+/// @brief 让出当前帧：协程在下一次 drainMainThread() 中恢复
+[[nodiscard]] inline auto nextFrame(core::TaskPool& pool) {
+    struct NextFrameAwaiter {
+        core::TaskPool* pool_;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const { pool_->postToMainThread([handle] { handle.resume(); }); }
+        void await_resume() const noexcept {}
+    };
+    return NextFrameAwaiter{ &pool };
+}
+
+/**
+ * @brief 在当前（主）线程上启动并推进任务直到完成，期间执行主线程队列中的所有任务
+ * @details 用于必须同步拿到结果、或放弃一个仍挂起的任务之前；不要在 drainMainThread() 执行的任务中调用。
+ */
+template <typename T>
+void runToCompletion(core::TaskPool& pool, Task<T>& task) {
+    task.start();
+    while (!task.isDone()) {
+        if (pool.waitForMainThreadTask(std::chrono::milliseconds(10))) {
+            pool.drainMainThread(std::chrono::hours(1));     // 不限预算：调用方本来就在等待
+        }
+    }
+}
+
+} // namespace engine::async
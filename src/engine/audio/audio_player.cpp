@@ -7,7 +7,6 @@
 #include "../core/config.h"
 #include "../resource/resource_manager.h"
 #include <algorithm>
-#include <cmath>
 
 namespace engine::audio {
 	/**
@@ -62,12 +61,9 @@ namespace engine::audio {
 	 * @param path 音效文件路径
 	 * @return 播放通道ID，失败返回-1
 	 * 
-	 * @details 当前 ResourceManager/AudioManager 不支持每个音效的增益控制。
-	 * 保持分层约定；音量旋钮已存储，以备将来混音器增益连接使用。
+	 * @details 音效经 AudioManager 的声部池播放（同帧去重、并发限制、优先级抢占）。
 	 */
 	int AudioPlayer::playSound(const std::string& path) {
-		// Current ResourceManager/AudioManager does not expose per-sound gain.
-		// Keep layering contract; volume knobs are stored for future mixer gain wiring.
 		resource_manager_.playSound(path);
 		return 0;
 	}
@@ -86,54 +82,14 @@ namespace engine::audio {
 	 * @return 播放通道ID，失败返回-1
 	 * 
 	 * @details 根据发射器和听众之间的距离计算音量衰减，实现空间化音效。
-	 * 如果距离超过最大有效距离，则不播放音效。
+	 * 衰减与剔除（超出最大距离或低于可闻增益）在音频线程上完成，这里只提交命令。
 	 */
 	int AudioPlayer::playSoundSpatial(const std::string& path, const glm::vec2& emitter_world_pos, const glm::vec2& listener_world_pos, float max_distance) {
-		if (max_distance <= 0.0f) {
-			return playSound(path);
-		}
-
-		const glm::vec2 delta = emitter_world_pos - listener_world_pos;
-		const float dist2 = (delta.x * delta.x) + (delta.y * delta.y);
-		const float max2 = max_distance * max_distance;
-		if (dist2 > max2) {
-			return 0;
-		}
-
-		// Simple linear attenuation based on distance.
-		const float dist = std::sqrt(dist2);
-		const float t = 1.0f - (dist / max_distance);
-		const float gain = std::clamp(t, 0.0f, 1.0f);
-
-		// Current AudioManager exposes only tag-level gains, so approximate by temporarily scaling sound gain.
-		// This is a best-effort approach until per-track/per-play gains are exposed.
-		const float base_gain = master_volume_ * sound_volume_;
-		resource_manager_.setSoundGain(base_gain * gain);
-		resource_manager_.playSound(path);
-		resource_manager_.setSoundGain(base_gain);
-		return 0;
+		return playSoundSpatial(engine::resource::toResourceId(path), path, emitter_world_pos, listener_world_pos, max_distance);
 	}
 
 	int AudioPlayer::playSoundSpatial(engine::resource::ResourceId id, std::string_view file_path, const glm::vec2& emitter_world_pos, const glm::vec2& listener_world_pos, float max_distance) {
-		if (max_distance <= 0.0f) {
-			return playSound(id, file_path);
-		}
-
-		const glm::vec2 delta = emitter_world_pos - listener_world_pos;
-		const float dist2 = (delta.x * delta.x) + (delta.y * delta.y);
-		const float max2 = max_distance * max_distance;
-		if (dist2 > max2) {
-			return 0;
-		}
-
-		const float dist = std::sqrt(dist2);
-		const float t = 1.0f - (dist / max_distance);
-		const float gain = std::clamp(t, 0.0f, 1.0f);
-
-		const float base_gain = master_volume_ * sound_volume_;
-		resource_manager_.setSoundGain(base_gain * gain);
-		resource_manager_.playSound(id, file_path);
-		resource_manager_.setSoundGain(base_gain);
+		resource_manager_.playSoundSpatial(id, file_path, emitter_world_pos, listener_world_pos, max_distance);
 		return 0;
 	}
 
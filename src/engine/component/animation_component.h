@@ -8,7 +8,8 @@
  *
  * 组件设计特点：
  * - 支持多动画状态机（如 idle、walk、attack）
- * - 动画数据与播放状态分离
+ * - 动画数据与播放状态分离：动画集合（AnimationSet）不可变且可在同类实体间共享，
+ *   组件本身只保存共享句柄与播放状态
  * - 通过修改 SpriteComponent 实现动画渲染
  *
  * @par 使用示例
@@ -40,6 +41,11 @@
 #include "../../engine/utils/math.h"
 #include <entt/core/hashed_string.hpp>
 #include <entt/entity/entity.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -75,50 +81,79 @@ namespace engine::component {
      *
      * @details
      * Animation 存储了一个完整的动画序列（如行走、攻击、待机动画）。
-     * 它会自动计算总时长，并支持循环播放设置。
+     * 构造时把帧序列编译为扁平时间轴：每帧结束时刻的前缀和与事件帧位图，
+     * 播放时只需在连续数组上二分查找当前帧，无需逐帧推进或查询事件表。
      *
      * @par 动画播放流程
-     * 1. AnimationSystem 根据 current_time_ms_ 确定当前帧
-     * 2. 更新 SpriteComponent 的 src_rect_ 为当前帧的源矩形
-     * 3. 达到最后一帧时，根据 loop_ 设置决定是否回到第一帧
+     * 1. AnimationSystem 推进 current_time_ms_，在 frame_end_ms_ 上二分查找当前帧
+     * 2. 途经的帧（可一次跨过多帧）按位图检查是否有帧事件
+     * 3. 更新 SpriteComponent 的 src_rect_ 为当前帧的源矩形
+     * 4. 到达末尾时，根据 loop_ 设置决定回绕还是停在最后一帧
      */
     struct Animation {
         std::vector<AnimationFrame> frames_;    ///< 动画包含的所有帧序列，按播放顺序排列
 		std::unordered_map<int, entt::id_type> events_; ///< 可选的帧事件映射，键为帧索引，值为事件ID（entt::hashed_string）
         float total_duration_ms_{};             ///< 整个动画序列的总时长（毫秒），自动计算
         bool loop_{true};                       ///< 播放完毕后是否循环，false表示播放一次后停止
+        std::vector<float> frame_end_ms_;       ///< 第 i 帧的结束时刻（前 i+1 帧时长的前缀和），单调不减
+        std::vector<std::uint64_t> event_mask_; ///< 事件帧位图，第 i 位表示进入第 i 帧时有事件（i 可等于帧数，表示播放到末尾）
 
         /**
          * @brief 构造函数，创建动画序列
          * @param frames 动画帧序列，按播放顺序
+         * @param events 帧事件映射（帧索引 -> 事件ID）
          * @param loop 是否循环播放，默认为true
          *
-         * @note 构造函数会自动计算 total_duration_ms_
+         * @note 构造函数会自动计算 total_duration_ms_、frame_end_ms_ 与 event_mask_
          */
         Animation(std::vector<AnimationFrame> frames,std::unordered_map<int, entt::id_type> events = {}, bool loop = true)
             : frames_(std::move(frames)), events_(std::move(events)), loop_(loop) {
-            // 计算动画总时长 (总时长 = 所有帧时长之和)
+            // 计算动画总时长 (总时长 = 所有帧时长之和)，并记录每帧的结束时刻
             total_duration_ms_ = 0.0f;
+            frame_end_ms_.reserve(frames_.size());
             for (const auto& frame : frames_) {
                 total_duration_ms_ += frame.duration_ms_;
+                frame_end_ms_.push_back(total_duration_ms_);
             }
+            event_mask_.assign(frames_.size() / 64 + 1, 0);
+            for (const auto& [frame_index, event_id] : events_) {
+                if (frame_index >= 0 && static_cast<std::size_t>(frame_index) <= frames_.size()) {
+                    event_mask_[static_cast<std::size_t>(frame_index) / 64] |= std::uint64_t{1} << (frame_index % 64);
+                }
+            }
+        }
+
+        /** @brief 进入第 frame_index 帧时是否有帧事件 */
+        [[nodiscard]] bool hasEvent(std::size_t frame_index) const {
+            return (event_mask_[frame_index / 64] >> (frame_index % 64)) & 1u;
+        }
+
+        /** @brief 播放时刻 time_ms 所在的帧（超出总时长时返回最后一帧） */
+        [[nodiscard]] std::size_t frameAt(float time_ms) const {
+            const auto it = std::upper_bound(frame_end_ms_.begin(), frame_end_ms_.end(), time_ms);
+            const auto index = static_cast<std::size_t>(it - frame_end_ms_.begin());
+            return index < frames_.size() ? index : frames_.size() - 1;
         }
     };
 
+    /// 动画ID到动画数据的映射集合（一类实体共享一份，创建后不再修改）
+    using AnimationSet = std::unordered_map<entt::id_type, Animation>;
+
     /**
      * @struct AnimationComponent
      * @brief ECS动画组件，管理实体的动画播放状态。
      *
      * @details
-     * AnimationComponent 是ECS架构中的动画组件，存储实体的所有动画和当前播放状态。
+     * AnimationComponent 是ECS架构中的动画组件，持有动画集合的共享句柄和当前播放状态。
      * 它本身不直接渲染，而是通过修改 SpriteComponent 来实现动画效果。
      *
      * @par 组件数据说明
-     * - animations_：存储所有可用动画（如 idle、walk、attack）
+     * - animations_：共享的不可变动画集合（如 idle、walk、attack），同类实体指向同一份数据
      * - current_animation_id_：当前播放的动画ID（使用 entt::hashed_string）
      * - current_frame_index_：当前显示的帧索引
      * - current_time_ms_：当前动画已播放的时间，用于确定当前帧
      * - speed_：播放速度倍率，1.0为正常速度，2.0为双倍速
+     * - loop_override_：逐实体的循环覆盖，设置后优先于 Animation::loop_
      *
      * @par 状态切换
      * 可以通过修改 current_animation_id_ 来切换动画状态：
@@ -127,24 +162,29 @@ namespace engine::component {
      * anim.current_animation_id_ = "walk"_hs;  // 切换到行走动画
      * anim.current_frame_index_ = 0;           // 重置到第一帧
      * anim.current_time_ms_ = 0;               // 重置时间
+     * anim.loop_override_ = true;              // 只影响该实体，不修改共享数据
      * @endcode
      */
     struct AnimationComponent {
-        std::unordered_map<entt::id_type, Animation> animations_;   ///< 动画ID到动画数据的映射集合，支持多动画状态
+        std::shared_ptr<const AnimationSet> animations_;            ///< 共享的动画集合句柄
         entt::id_type current_animation_id_{entt::null};            ///< 当前正在播放的动画ID（entt::hashed_string值）
         size_t current_frame_index_{};                              ///< 当前播放到的帧索引，从0开始
-        float current_time_ms_{};                                   ///< 当前动画已播放的时间（毫秒），用于帧切换计算
+        float current_time_ms_{};                                   ///< 当前动画（本轮循环内）已播放的时间（毫秒），据此在时间轴上确定当前帧
         float speed_{1.0f};                                         ///< 动画播放速度倍率，1.0为正常速度
+        std::optional<bool> loop_override_;                         ///< 逐实体循环覆盖，为空时使用动画自身的 loop_
+        mutable const Animation* cached_animation_{nullptr};        ///< currentAnimation() 的查找缓存
+        mutable entt::id_type cached_animation_id_{entt::null};     ///< 缓存对应的动画ID
+        mutable const AnimationSet* cached_set_{nullptr};           ///< 缓存对应的动画集合
 
         /**
-         * @brief 构造函数，创建动画组件
-         * @param animations 初始动画集合，动画ID映射到Animation对象
+         * @brief 构造函数，引用共享的动画集合
+         * @param animations 共享动画集合（通常来自 AnimationLibrary）
          * @param current_animation_id 初始播放的动画ID
          * @param current_frame_index 初始帧索引，默认为0
          * @param current_time_ms 初始播放时间，默认为0
          * @param speed 动画播放速度倍率，默认为1.0
          */
-        AnimationComponent(std::unordered_map<entt::id_type, Animation> animations,
+        AnimationComponent(std::shared_ptr<const AnimationSet> animations,
                         entt::id_type current_animation_id,
                         size_t current_frame_index = 0,
                         float current_time_ms = 0.0f,
@@ -154,6 +194,39 @@ namespace engine::component {
                         current_frame_index_(current_frame_index),
                         current_time_ms_(current_time_ms),
                         speed_(speed) {}
+
+        /**
+         * @brief 构造函数，为单个实体独占创建动画集合（如动画瓦片）
+         * @param animations 动画集合
+         * @param current_animation_id 初始播放的动画ID
+         */
+        AnimationComponent(AnimationSet animations, entt::id_type current_animation_id) :
+                        AnimationComponent(std::make_shared<const AnimationSet>(std::move(animations)), current_animation_id) {}
+
+        /**
+         * @brief 查找当前播放的动画
+         * @details 动画集合创建后不再修改，查找结果按（集合, 动画ID）缓存，切换动画前每帧只需两次比较。
+         * @return 当前动画指针，不存在时返回 nullptr
+         */
+        const Animation* currentAnimation() const {
+            if (cached_set_ == animations_.get() && cached_animation_id_ == current_animation_id_) {
+                return cached_animation_;
+            }
+            cached_set_ = animations_.get();
+            cached_animation_id_ = current_animation_id_;
+            cached_animation_ = nullptr;
+            if (animations_) {
+                if (auto it = animations_->find(current_animation_id_); it != animations_->end()) {
+                    cached_animation_ = &it->second;
+                }
+            }
+            return cached_animation_;
+        }
+
+        /** @brief 当前动画是否循环（考虑逐实体覆盖） */
+        bool isLooping(const Animation& animation) const {
+            return loop_override_.value_or(animation.loop_);
+        }
     };
 
-}
\ No newline at end of file
+}
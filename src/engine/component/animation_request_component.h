@@ -0,0 +1,31 @@
+/**
+ * @file animation_request_component.h
+ * @brief 定义 AnimationRequestComponent，系统直接写入的「切换动画」请求。
+ *
+ * @details
+ * 阻挡、攻击、动画结束回切等逻辑在同一帧内可能对同一实体多次请求切换动画。
+ * 与其逐条经过 dispatcher 派发 PlayAnimationEvent，不如直接写入本组件：
+ * 同一实体的多次写入自然合并为最后一次，AnimationSystem 每帧集中处理一次后清空存储。
+ *
+ * @par 使用示例
+ * @code
+ * // 遍历视图期间：经命令缓冲写入，同步点时同一实体只保留最后一次
+ * commands.emplace<AnimationRequestComponent>(entity, "attack"_hs, false);
+ * // 事件回调等非遍历场景：直接写入
+ * registry.emplace_or_replace<AnimationRequestComponent>(entity, "idle"_hs, true);
+ * @endcode
+ *
+ * @see engine::system::AnimationSystem 在帧推进之后统一应用并清空请求
+ */
+
+#pragma once
+#include <entt/core/fwd.hpp>
+
+namespace engine::component {
+
+struct AnimationRequestComponent {
+    entt::id_type animation_id_{};  ///< 要切换到的动画ID
+    bool loop_{true};               ///< 是否循环
+};
+
+} // namespace engine::component
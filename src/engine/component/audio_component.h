@@ -1,19 +1,18 @@
 /**
  * @file audio_component.h
- * @brief 定义 AudioComponent 组件，用于ECS架构中的实体音效管理。
+ * @brief 定义 AudioComponent 组件与 SoundTable，用于ECS架构中的实体音效管理。
  *
  * @details
- * AudioComponent 是ECS架构中的音频相关组件，负责存储实体与各种动作关联的音效映射。
- * 该组件允许实体根据不同的动作（如跳跃、攻击、受伤）播放对应的音效。
+ * 动作到音效的映射按职业只有一份：SoundTable 由蓝图管理器在加载时构建且之后不再修改，
+ * AudioComponent 只保存指向它的指针。生成单位不再复制哈希表，也没有每单位的堆分配；
+ * 一个职业通常只有一两个带音效的动作，查找是对两个并行小数组的顺序比较。
  *
  * @par 使用示例
  * @code
- * // 为玩家实体添加音频组件
- * auto entity = registry.create();
- * AudioComponent audio_comp;
- * audio_comp.action_sounds_["jump"_hs] = "jump_sound"_hs;
- * audio_comp.action_sounds_["attack"_hs] = "attack_sound"_hs;
- * registry.emplace<AudioComponent>(entity, std::move(audio_comp));
+ * // 由加载方持有音效表（生命周期需覆盖使用它的实体）
+ * auto table = std::make_shared<SoundTable>();
+ * table->add("hit"_hs, "sword_hit"_hs);
+ * registry.emplace<AudioComponent>(entity, table.get());
  * @endcode
  *
  * @see engine::audio::AudioPlayer 音频播放器
@@ -21,29 +20,55 @@
  */
 
 #pragma once
-#include <unordered_map>
-#include <entt/entity/fwd.hpp>
-
-namespace engine::core { class Context; }
+#include <cstddef>
+#include <vector>
+#include <entt/core/fwd.hpp>
 
 namespace engine::component {
 
+    /**
+     * @struct SoundTable
+     * @brief 一个职业的动作音效表：actions_[i] 的动作播放 sounds_[i]，下标即紧凑的动作序号
+     */
+    struct SoundTable {
+        std::vector<entt::id_type> actions_;    ///< 动作标识（如 "hit"、"emit" 的哈希值）
+        std::vector<entt::id_type> sounds_;     ///< 与 actions_ 同下标的音效资源 ID
+
+        /// @brief 登记动作音效；动作已存在时改写
+        void add(entt::id_type action, entt::id_type sound) {
+            for (std::size_t i = 0; i < actions_.size(); ++i) {
+                if (actions_[i] == action) {
+                    sounds_[i] = sound;
+                    return;
+                }
+            }
+            actions_.push_back(action);
+            sounds_.push_back(sound);
+        }
+
+        /// @brief 动作对应的音效，没有时返回 nullptr
+        [[nodiscard]] const entt::id_type* find(entt::id_type action) const {
+            for (std::size_t i = 0; i < actions_.size(); ++i) {
+                if (actions_[i] == action) {
+                    return &sounds_[i];
+                }
+            }
+            return nullptr;
+        }
+
+        [[nodiscard]] bool empty() const { return actions_.empty(); }
+        [[nodiscard]] std::size_t size() const { return actions_.size(); }
+    };
+
     /**
      * @struct AudioComponent
-     * @brief 音频组件，用于管理与实体动作关联的音效映射。
+     * @brief 音频组件，指向实体所属职业的共享音效表。
      *
      * @details
-     * 该组件存储动作ID到音效资源ID的映射，允许系统根据实体动作播放相应音效。
-     * 动作ID和音效ID都使用 entt::hashed_string 生成，以提高查找性能。
+     * 组件只有一个指针，可按值复制进预制模板、批量 insert 与检查点快照；音效表归蓝图管理器所有。
      */
     struct AudioComponent {
-        /**
-         * @brief 动作 ID 到音效资源 ID 的映射集合
-         * @details
-         * key: 动作标识 (例如 "jump", "hit" 的哈希值)
-         * value: 对应的音效资源 ID
-         */
-        std::unordered_map<entt::id_type, entt::id_type> action_sounds_; 
+        const SoundTable* sounds_{ nullptr };    ///< 为空表示没有配置音效
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,18 @@
+/**
+ * @file disabled_tag.h
+ * @brief 定义 DisabledTag，标记暂时停用（如被对象池回收）的实体。
+ *
+ * @details
+ * 停用的实体保留全部组件以便原地重新初始化，但引擎系统（渲染、排序、动画、移动）
+ * 与相关的游戏系统都会在视图中排除它，使其不再参与任何逻辑。
+ *
+ * @see game::factory::VisualPool 使用此标签回收投射物与特效实体
+ */
+
+#pragma once
+
+namespace engine::component {
+
+struct DisabledTag {};      ///< 停用标签，带此标签的实体被所有系统视图排除
+
+} // namespace engine::component
@@ -0,0 +1,27 @@
+/**
+ * @file lod_icon_component.h
+ * @brief 定义 LodIconComponent：相机拉远、精灵在屏幕上过小时改画的单色小方块。
+ *
+ * @details
+ * 相机缩放到精灵只剩几个像素时，完整的精灵帧既看不清也浪费填充率。带此组件的实体在屏幕尺寸
+ * 低于 RenderSystem::LOD_ICON_THRESHOLD 时不再绘制精灵，改为在其中心画一个固定像素大小的
+ * 纯色四边形；所有图标在精灵批次之后以一次 UI 矩形批量提交。没有此组件的实体（地形、特效）照常缩小绘制。
+ *
+ * @see engine::system::RenderSystem 绘制时按缩放倍数切换
+ */
+
+#pragma once
+
+#include "../utils/math.h"
+
+namespace engine::component {
+
+    /**
+     * @struct LodIconComponent
+     * @brief 远景图标的颜色（如按阵营区分）
+     */
+    struct LodIconComponent {
+        engine::utils::Color8 color_{};
+    };
+
+} // namespace engine::component
@@ -0,0 +1,18 @@
+/**
+ * @file low_detail_tag.h
+ * @brief 定义 LowDetailTag，标记当前以低细节模拟的实体。
+ *
+ * @details
+ * 实体在屏幕外、也不参与任何交互时由游戏层打上此标签：AnimationSystem 不推进其动画帧，
+ * 游戏层系统可据此降低更新频率。标签去掉后动画从暂停处继续。
+ *
+ * @see game::system::SimulationLodSystem 为敌人切换模拟细节
+ */
+
+#pragma once
+
+namespace engine::component {
+
+struct LowDetailTag {};     ///< 低细节标签，动画帧不推进
+
+} // namespace engine::component
@@ -30,8 +30,9 @@
 
 #pragma once
 
-#include <string>
+#include <string_view>
 #include <entt/entity/entity.hpp>
+#include "../utils/string_interner.h"
 
 namespace engine::component {
 
@@ -42,11 +43,15 @@ namespace engine::component {
  * @details
  * 提供两种名称表示方式：
  * - name_id_: 哈希ID，用于快速比较和查找
- * - name_: 可读字符串，用于显示和调试
+ * - name_: 可读字符串，用于显示和调试（驻留到 StringInterner，组件不持有堆内存）
  */
 struct NameComponent {
     entt::id_type name_id_{entt::null};   ///< 名称的哈希ID，用于快速查找和比较
-    std::string name_;                    ///< 实体的可读名称，用于调试和显示
+    std::string_view name_;               ///< 实体的可读名称（驻留字符串），用于调试和显示
+
+    NameComponent() = default;
+    NameComponent(entt::id_type name_id, std::string_view name)
+        : name_id_(name_id), name_(engine::utils::StringInterner::intern(name)) {}
 };
 
 }
\ No newline at end of file
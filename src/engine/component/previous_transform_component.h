@@ -0,0 +1,26 @@
+/**
+ * @file previous_transform_component.h
+ * @brief 定义 PreviousTransformComponent，记录上一模拟步的位置，供渲染插值使用。
+ *
+ * @details
+ * 模拟以固定频率推进，渲染帧率与之无关；渲染时位置取上一步与最新一步之间的插值，
+ * 避免模拟频率低于刷新率时移动单位一顿一顿。
+ * InterpolationSystem 在每个模拟步开始前写入本组件，RenderSystem 只在 tick_ 等于最新模拟步序号时插值，
+ * 未在本步快照的实体（刚停止移动、刚被传送）直接使用当前位置。
+ *
+ * @see engine::system::InterpolationSystem 写入快照
+ * @see engine::system::RenderSystem::setInterpolation 设置插值系数
+ */
+
+#pragma once
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace engine::component {
+
+struct PreviousTransformComponent {
+    glm::vec2 position_{ 0.0f, 0.0f };     ///< 模拟步开始前的位置
+    std::uint64_t tick_{0};                 ///< 快照所属的模拟步序号
+};
+
+} // namespace engine::component
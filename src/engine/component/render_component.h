@@ -4,11 +4,26 @@
  *
  * @details
  * RenderComponent 是ECS架构中的渲染排序组件，控制实体在渲染时的层级和顺序。
- * 该组件由 RenderSystem 使用，根据 layer_index_ 和 y_index_ 对实体进行排序后渲染。
+ * 该组件由 RenderSystem 使用，按打包的 64 位排序键对实体进行排序后渲染。
  *
  * @par 排序规则
- * 1. 首先按 layer_index_ 排序，值较小的先渲染（在底层）
- * 2. 同一层内按 y_index_ 排序，值较小的先渲染（实现Y轴排序）
+ * 1. 首先按层级排序，值较小的先渲染（在底层）
+ * 2. 同一层内按 Y 深度排序，值较小的先渲染（实现Y轴排序）
+ * 3. 层级与深度都相同时按纹理 ID 的低 16 位排序，同纹理的精灵相邻，批处理段更长
+ *
+ * 以上是默认的 Y_SORT 策略。每个层级可在 RenderLayerPolicies（registry 上下文）中声明其他策略：
+ * 地面瓦片、贴花等互不遮挡的层级不需要按 Y 排序，改为 TEXTURE（深度字段存纹理 ID，同纹理整段相邻）
+ * 或 NONE（保持创建顺序），YSortSystem 据此写入排序键。
+ *
+ * @par 排序键布局
+ * | 位 | 内容 |
+ * |----|------|
+ * | 63..48 | 层级 + 32768（层级限制在 int16 范围内） |
+ * | 47..16 | Y 深度 float 的保序映射（正数置符号位，负数按位取反），无精度损失；TEXTURE 层级为纹理 ID |
+ * | 15..0  | 平局决胜值（YSortSystem 写入纹理 ID 的低 16 位） |
+ *
+ * 整个组件 16 字节（排序键 + RGBA8 颜色），YSortSystem 与 RenderSystem 每帧遍历时访问的字节数更少，
+ * 排序键可直接按无符号整数比较或基数排序。
  *
  * @par 使用示例
  * @code
@@ -32,37 +47,130 @@
 #pragma once
 
 #include "../utils/math.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <unordered_map>
 
 namespace engine::component {
+    /**
+     * @enum RenderSortPolicy
+     * @brief 渲染层级内的排序策略
+     */
+    enum class RenderSortPolicy : std::uint8_t {
+        Y_SORT,     ///< 按实体底边 Y 深度排序，同深度按纹理决胜（默认，单位与会互相遮挡的装饰）
+        NONE,       ///< 不排序，保持进入绘制序列的顺序（瓦片按行优先创建）
+        TEXTURE,    ///< 只按纹理分组，同纹理的精灵合成最长的批次（地面瓦片、贴花）
+    };
+
     /**
      * @struct RenderComponent
      * @brief 渲染排序组件，控制实体的渲染层级和顺序。
      *
      * @details
-     * 该组件定义了实体在渲染时的排序规则：
-     * - layer_index_: 渲染层级，用于分层渲染（如背景层、游戏层、UI层）
-     * - y_index_: Y轴深度索引，用于同一层内的前后关系（如2.5D效果）
+     * 层级与 Y 深度打包在 sort_key_ 中，通过 get/set 访问：
+     * - 层级：用于分层渲染（如背景层、游戏层、UI层）
+     * - Y 深度：用于同一层内的前后关系（如2.5D效果）
      *
-     * 实现了 operator< 以便在容器中进行排序。
+     * 实现了 operator< 以便在容器中进行排序（直接比较排序键）。
      */
     struct RenderComponent {
-        int layer_index_{0};    ///< 渲染层级索引，较小的值表示更靠后的层（先渲染）
-        float y_index_{0.0f};   ///< Y轴深度索引，用于同一层内的渲染顺序控制，较小的值先渲染
-        engine::utils::FColor color_{ 1.0f, 1.0f, 1.0f, 1.0f }; ///< 颜色调制，用于受控着色
+        static constexpr int LAYER_BITS = 16;
+        static constexpr int DEPTH_SHIFT = 16;
+        static constexpr int LAYER_SHIFT = 48;
+        static constexpr int LAYER_BIAS = 1 << (LAYER_BITS - 1);
+
+        std::uint64_t sort_key_{ makeSortKey(0, 0.0f) };   ///< 层级 | Y 深度 | 平局决胜值，较小的先渲染
+        engine::utils::Color8 color_{};                     ///< 颜色调制（RGBA8），用于受控着色
+
+        constexpr RenderComponent() = default;
+
+        /**
+         * @param layer_index 渲染层级，较小的值表示更靠后的层（先渲染）
+         * @param y_index Y轴深度索引，较小的值先渲染
+         */
+        constexpr RenderComponent(int layer_index, float y_index = 0.0f)
+            : sort_key_(makeSortKey(layer_index, y_index)) {}
+
+        [[nodiscard]] constexpr int getLayerIndex() const {
+            return static_cast<int>(sort_key_ >> LAYER_SHIFT) - LAYER_BIAS;
+        }
+        [[nodiscard]] constexpr float getYIndex() const {
+            return depthFromBits(static_cast<std::uint32_t>(sort_key_ >> DEPTH_SHIFT));
+        }
+        [[nodiscard]] constexpr std::uint16_t getTiebreak() const {
+            return static_cast<std::uint16_t>(sort_key_);
+        }
+
+        constexpr void setLayerIndex(int layer_index) {
+            sort_key_ = makeSortKey(layer_index, getYIndex(), getTiebreak());
+        }
+        /// @brief 更新 Y 深度与平局决胜值（层级不变）
+        constexpr void setYIndex(float y_index, std::uint16_t tiebreak = 0) {
+            sort_key_ = (sort_key_ & (~std::uint64_t{ 0 } << LAYER_SHIFT)) |
+                        (std::uint64_t{ depthToBits(y_index) } << DEPTH_SHIFT) | tiebreak;
+        }
+
+        /// @brief TEXTURE 策略：深度字段改存纹理 ID，平局决胜值清零（层级不变）
+        constexpr void setTextureOrder(std::uint32_t texture_id) {
+            sort_key_ = (sort_key_ & (~std::uint64_t{ 0 } << LAYER_SHIFT)) | (std::uint64_t{ texture_id } << DEPTH_SHIFT);
+        }
+
+        /// @brief 打包排序键；层级截断到 int16 范围
+        [[nodiscard]] static constexpr std::uint64_t makeSortKey(int layer_index, float y_index, std::uint16_t tiebreak = 0) {
+            const int layer = std::clamp(layer_index, -LAYER_BIAS, LAYER_BIAS - 1) + LAYER_BIAS;
+            return (static_cast<std::uint64_t>(layer) << LAYER_SHIFT) |
+                   (std::uint64_t{ depthToBits(y_index) } << DEPTH_SHIFT) | tiebreak;
+        }
 
         /**
          * @brief 比较运算符，用于渲染排序
          * @param other 要比较的另一个 RenderComponent
          * @return true 如果当前组件应该先于 other 渲染
          *
-         * @details 首先比较 layer_index_，如果相同则比较 y_index_
+         * @details 排序键的高位是层级，比较整数即先比层级、再比 Y 深度
          */
-        bool operator<(const RenderComponent& other) const {
-            if (layer_index_ != other.layer_index_) {
-                return layer_index_ < other.layer_index_;
+        constexpr bool operator<(const RenderComponent& other) const {
+            return sort_key_ < other.sort_key_;
+        }
+
+    private:
+        /// @brief float 到 uint32 的保序映射：映射后按无符号整数比较与原浮点比较一致
+        static constexpr std::uint32_t depthToBits(float value) {
+            const auto bits = std::bit_cast<std::uint32_t>(value);
+            return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+        }
+        static constexpr float depthFromBits(std::uint32_t bits) {
+            return std::bit_cast<float>((bits & 0x80000000u) ? (bits & 0x7FFFFFFFu) : ~bits);
+        }
+    };
+    static_assert(sizeof(RenderComponent) == 16, "RenderComponent 应保持 16 字节");
+
+    /**
+     * @struct RenderLayerPolicies
+     * @brief 各渲染层级声明的排序策略（registry 上下文），未声明的层级按 Y_SORT 处理
+     *
+     * @details LevelLoader 读取 Tiled 图层的 "sort" 属性写入；策略变化时 version_ 递增，
+     *          YSortSystem 据此重算全部可渲染实体的排序键。
+     */
+    struct RenderLayerPolicies {
+        void set(int layer_index, RenderSortPolicy policy) {
+            if (get(layer_index) != policy) {
+                policies_[layer_index] = policy;
+                ++version_;
             }
-            return y_index_ < other.y_index_;
         }
+
+        [[nodiscard]] RenderSortPolicy get(int layer_index) const {
+            const auto it = policies_.find(layer_index);
+            return it == policies_.end() ? RenderSortPolicy::Y_SORT : it->second;
+        }
+
+        [[nodiscard]] std::uint32_t getVersion() const { return version_; }
+
+    private:
+        std::unordered_map<int, RenderSortPolicy> policies_;
+        std::uint32_t version_{ 0 };
     };
 
-}
\ No newline at end of file
+}
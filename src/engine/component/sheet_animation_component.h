@@ -0,0 +1,85 @@
+/**
+ * @file sheet_animation_component.h
+ * @brief 定义 SheetAnimationComponent：按时钟直接算出当前帧的精灵表动画，不需要逐步推进。
+ *
+ * @details
+ * 纯装饰的循环动画（动画瓦片、待机闪烁）没有帧事件，也不会被游戏逻辑切换。只要帧在精灵表上等距排列、
+ * 每帧时长相同，当前帧就只取决于时间：
+ *
+ *     帧序号 = (时钟 - start_ms_) / frame_ms_（循环时对 frame_count_ 取模）
+ *     源矩形左上角 = origin_ + stride_ × 帧序号
+ *
+ * 实体带上这组属性后，RenderSystem 在绘制可见条目时按快照的动画时钟算出源矩形，AnimationSystem 不再访问它：
+ * 屏幕外的实例没有任何开销，屏幕内的实例每帧只做一次除法。带帧事件（"hit"、"emit"）或需要结束事件的动画
+ * 仍使用 AnimationComponent。
+ *
+ * 动画时钟是关卡开始以来的模拟时间（毫秒，由场景经 RenderSystem::extract 传入），暂停时随模拟一起停止。
+ *
+ * @see engine::system::RenderSystem 绘制时计算当前帧
+ * @see engine::loader::BasicEntityBuilder 动画瓦片优先使用此组件
+ */
+
+#pragma once
+
+#include "animation_component.h"
+#include <glm/vec2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+namespace engine::component {
+
+    /**
+     * @struct SheetAnimationComponent
+     * @brief 精灵表动画的实例属性（可平凡拷贝，随绘制快照交接给渲染侧）
+     */
+    struct SheetAnimationComponent {
+        float start_ms_{ 0.0f };            ///< 动画时钟上第 0 帧开始的时刻
+        glm::vec2 origin_{ 0.0f };          ///< 第 0 帧源矩形的左上角
+        glm::vec2 stride_{ 0.0f };          ///< 相邻两帧源矩形的偏移
+        float frame_ms_{ 100.0f };          ///< 每帧时长（毫秒）
+        std::uint16_t frame_count_{ 1 };
+        bool loop_{ true };                 ///< false 时停在最后一帧
+
+        /**
+         * @brief 把帧序列转成精灵表属性
+         * @param animation 动画数据
+         * @param start_ms 动画时钟上的起始时刻
+         * @return 帧不等距、时长不同、大小不同或带帧事件时返回空（仍需 CPU 推进）
+         */
+        [[nodiscard]] static std::optional<SheetAnimationComponent> fromAnimation(const Animation& animation, float start_ms = 0.0f) {
+            const auto& frames = animation.frames_;
+            if (frames.empty() || frames.size() > std::numeric_limits<std::uint16_t>::max() || !animation.events_.empty()) {
+                return std::nullopt;
+            }
+            const auto& first = frames.front().src_rect_;
+            const glm::vec2 stride = frames.size() > 1 ? frames[1].src_rect_.position - first.position : glm::vec2(0.0f);
+            const float frame_ms = frames.front().duration_ms_;
+            if (frame_ms <= 0.0f) {
+                return std::nullopt;
+            }
+            for (std::size_t i = 1; i < frames.size(); ++i) {
+                const auto& rect = frames[i].src_rect_;
+                if (rect.size != first.size || rect.position != first.position + stride * static_cast<float>(i) ||
+                    std::abs(frames[i].duration_ms_ - frame_ms) > 0.01f) {
+                    return std::nullopt;
+                }
+            }
+            return SheetAnimationComponent{ start_ms, first.position, stride, frame_ms,
+                                            static_cast<std::uint16_t>(frames.size()), animation.loop_ };
+        }
+
+        /// @brief 动画时钟为 time_ms 时当前帧源矩形的左上角
+        [[nodiscard]] glm::vec2 frameOrigin(double time_ms) const {
+            const double local_ms = std::max(0.0, time_ms - static_cast<double>(start_ms_));
+            auto frame = static_cast<std::uint64_t>(local_ms / static_cast<double>(frame_ms_));
+            frame = loop_ ? frame % frame_count_ : std::min<std::uint64_t>(frame, frame_count_ - 1u);
+            return origin_ + stride_ * static_cast<float>(frame);
+        }
+    };
+    static_assert(std::is_trivially_copyable_v<SheetAnimationComponent>, "SheetAnimationComponent 应保持可平凡拷贝");
+
+} // namespace engine::component
@@ -31,13 +31,15 @@
 
 #pragma once
 #include "../utils/math.h"
+#include "../utils/string_interner.h"
 #include <SDL3/SDL_rect.h>
 #include <entt/core/hashed_string.hpp>
 #include <entt/entity/entity.hpp>
 #include <glm/vec2.hpp>
 #include <glm/common.hpp>
+#include <string_view>
+#include <type_traits>
 #include <utility>
-#include <string>
 
 namespace engine::component {
 
@@ -52,12 +54,15 @@ namespace engine::component {
 	 * 支持两种纹理引用方式：
 	 * - 通过 texture_id_：使用已加载的纹理资源ID（推荐，性能更好）
 	 * - 通过 texture_path_：使用文件路径（便于调试和懒加载）
+	 *
+	 * texture_path_ 指向 StringInterner 的驻留存储（以 '\0' 结尾，只存一个指针），Sprite 不持有堆内存，
+	 * 可平凡拷贝，共 32 字节；按 getTexturePath() 取视图。
 	 */
 	struct Sprite{
 		entt::id_type texture_id_{entt::null};  ///< 纹理资源的哈希ID，用于快速查找纹理
-    	std::string texture_path_;              ///< 纹理资源的文件路径（可选，用于加载或调试）
-    	engine::utils::Rect src_rect_{};        ///< 纹理中的源矩形区域（裁剪矩形），定义要渲染的图像部分
     	bool is_flipped_{false};                ///< 是否水平翻转显示，用于实现面向左右的角色
+    	const char* texture_path_{nullptr};     ///< 纹理资源的文件路径（驻留字符串，可选，用于加载或调试）
+    	engine::utils::Rect src_rect_{};        ///< 纹理中的源矩形区域（裁剪矩形），定义要渲染的图像部分
 
     	Sprite() = default;     ///< 默认构造函数，创建一个空的精灵
 
@@ -73,8 +78,8 @@ namespace engine::component {
 			   const engine::utils::Rect& src_rect,
 			   bool is_flipped = false)
 			   : texture_id_(texture_id),
-				 src_rect_(src_rect),
-				 is_flipped_(is_flipped) {}
+				 is_flipped_(is_flipped),
+				 src_rect_(src_rect) {}
 
 		/**
 		 * @brief 通过纹理路径构造精灵（便于调试）
@@ -82,16 +87,23 @@ namespace engine::component {
 		 * @param src_rect 源矩形区域，定义从纹理中裁剪的部分
 		 * @param is_flipped 是否水平翻转，默认为false
 		 *
-		 * @note 路径会被自动哈希为 texture_id_，便于后续快速查找
+		 * @note 路径会被自动哈希为 texture_id_，并驻留到 StringInterner
 		 */
-		Sprite(const std::string& texture_path,
+		Sprite(std::string_view texture_path,
 			   const engine::utils::Rect& src_rect,
 			   bool is_flipped = false)
-			   : texture_id_(entt::hashed_string::value(texture_path.c_str())),
-				 texture_path_(texture_path),
-				 src_rect_(src_rect),
-				 is_flipped_(is_flipped) {}
+			   : texture_id_(entt::hashed_string::value(texture_path.data(), texture_path.size())),
+				 is_flipped_(is_flipped),
+				 texture_path_(engine::utils::StringInterner::intern(texture_path).data()),
+				 src_rect_(src_rect) {}
+
+		/// @brief 纹理路径，未指定时为空视图
+		[[nodiscard]] std::string_view getTexturePath() const {
+			return texture_path_ ? std::string_view(texture_path_) : std::string_view{};
+		}
 	};
+	static_assert(std::is_trivially_copyable_v<Sprite>, "Sprite 应保持可平凡拷贝");
+	static_assert(sizeof(Sprite) <= 32, "Sprite 应保持 32 字节以内");
 
 	/**
 	 * @struct SpriteComponent
@@ -0,0 +1,100 @@
+/**
+ * @file tile_animation_component.h
+ * @brief 定义 TileAnimationComponent 与 TileAnimationClocks：同一动画瓦片的所有实例共用一个播放时钟。
+ *
+ * @details
+ * Tiled 的动画瓦片（TileInfo::animation_）在地图上往往重复成百上千次（水面、火把），
+ * 各实例的播放进度完全相同。每个不同的动画瓦片（关卡瓦片表中的一项，即一个 gid）只在
+ * TileAnimationClocks（registry 上下文）中保存一份播放状态，AnimationSystem 每步推进一次；
+ * 实例只带一个时钟下标，当前帧变化时才被改写精灵的源矩形，不再逐实体推进 AnimationComponent。
+ *
+ * 瓦片动画没有帧事件，也不会切换动画；需要这些能力的实体仍使用 AnimationComponent。
+ *
+ * @see engine::system::AnimationSystem 推进时钟并同步精灵
+ * @see engine::loader::BasicEntityBuilder 为动画瓦片挂接时钟
+ */
+
+#pragma once
+
+#include "animation_component.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::component {
+
+    /**
+     * @struct TileAnimationComponent
+     * @brief 动画瓦片实例引用的共享时钟
+     */
+    struct TileAnimationComponent {
+        std::uint32_t clock_{ 0 };      ///< TileAnimationClocks 中的下标
+    };
+
+    /**
+     * @class TileAnimationClocks
+     * @brief 动画瓦片的共享播放状态（registry 上下文），每个时钟对应一个动画瓦片
+     */
+    class TileAnimationClocks {
+    public:
+        /// @brief 新建一个时钟（拷贝动画数据），从第 0 帧开始播放
+        std::uint32_t add(const Animation& animation) {
+            clocks_.push_back(Clock{ animation });
+            return static_cast<std::uint32_t>(clocks_.size() - 1);
+        }
+
+        /**
+         * @brief 推进全部时钟
+         * @param dt 步长（秒）
+         * @return 本步是否有时钟切换了当前帧
+         */
+        bool advance(float dt) {
+            any_changed_ = false;
+            for (auto& clock : clocks_) {
+                clock.changed_ = false;
+                const auto& animation = clock.animation_;
+                if (animation.frames_.empty() || animation.total_duration_ms_ <= 0.0f) {
+                    continue;
+                }
+                float time_ms = clock.time_ms_ + dt * 1000.0f;
+                if (time_ms >= animation.total_duration_ms_) {
+                    // 非循环动画停在最后一帧
+                    time_ms = animation.loop_ ? std::fmod(time_ms, animation.total_duration_ms_) : animation.total_duration_ms_;
+                }
+                clock.time_ms_ = time_ms;
+                const auto frame_index = animation.frameAt(time_ms);
+                if (frame_index != clock.frame_index_) {
+                    clock.frame_index_ = frame_index;
+                    clock.changed_ = true;
+                    any_changed_ = true;
+                }
+            }
+            return any_changed_;
+        }
+
+        /// @brief 上一次 advance() 中该时钟是否切换了当前帧
+        [[nodiscard]] bool isChanged(std::uint32_t clock) const { return clocks_[clock].changed_; }
+
+        /// @brief 该时钟当前帧的源矩形（动画没有帧时返回空矩形）
+        [[nodiscard]] engine::utils::Rect currentFrame(std::uint32_t clock) const {
+            const auto& entry = clocks_[clock];
+            return entry.animation_.frames_.empty() ? engine::utils::Rect{} : entry.animation_.frames_[entry.frame_index_].src_rect_;
+        }
+
+        [[nodiscard]] std::size_t size() const { return clocks_.size(); }
+        [[nodiscard]] bool empty() const { return clocks_.empty(); }
+
+    private:
+        struct Clock {
+            Animation animation_;
+            float time_ms_{ 0.0f };
+            std::size_t frame_index_{ 0 };
+            bool changed_{ false };
+        };
+
+        std::vector<Clock> clocks_;
+        bool any_changed_{ false };
+    };
+
+} // namespace engine::component
@@ -26,6 +26,8 @@
 #pragma once
 #include "sprite_component.h"
 #include "animation_component.h"
+#include "../resource/resource_id.h"
+#include <cstdint>
 #include <vector>
 #include <optional>
 #include <glm/vec2.hpp>
@@ -99,6 +101,23 @@ namespace engine::component {
 				properties_(std::move(properties)) {}
 	};
 
+	/**
+	 * @struct TileChunk
+	 * @brief 烘焙后的静态瓦片区块。
+	 *
+	 * @details
+	 * 静态（无动画、无自定义属性）瓦片在关卡加载时按固定大小分块，每块预先绘制到一张
+	 * 渲染目标纹理上，运行时只需作为一个精灵实体绘制，参与正常的图层排序与视口裁剪。
+	 * 纹理由 ResourceManager 的纹理缓存持有。
+	 */
+	struct TileChunk {
+		engine::resource::ResourceId texture_id_{engine::resource::InvalidResourceId}; ///< 区块纹理的资源ID
+		glm::ivec2 chunk_coord_{0, 0};          ///< 区块在图层中的网格坐标（以区块为单位）
+		glm::vec2 origin_{0.0f, 0.0f};          ///< 区块纹理左上角的世界坐标
+		glm::vec2 size_{0.0f, 0.0f};            ///< 区块纹理尺寸（像素）
+		entt::entity entity_{entt::null};       ///< 绘制该区块的精灵实体
+	};
+
 	/**
 	 * @struct TileLayerComponent
 	 * @brief 瓦片图层组件，管理整个瓦片地图层。
@@ -108,6 +127,9 @@ namespace engine::component {
 	 * - 瓦片尺寸：每个瓦片的大小（像素）
 	 * - 地图尺寸：网格的行列数
 	 * - 瓦片实体列表：按 row * width + col 顺序存储
+	 * - 烘焙区块列表：静态瓦片被烘焙进区块纹理后，对应 tiles_ 中的位置为 entt::null
+	 * - 格子表：烘焙瓦片没有实体，按格子记录打包的 TileType 与属性标志（编码见 engine::spatial::TileGrid），
+	 *   场景加载后合并为一张 TileGrid 供导航、建造位与危险格查询
 	 *
 	 * 该组件通常由 LevelLoader 创建，用于表示 Tiled 地图中的一个图层。
 	 */
@@ -115,18 +137,26 @@ namespace engine::component {
 		glm::ivec2 tile_size_;              ///< 单个瓦片的尺寸（像素）
 		glm::ivec2 map_size_;               ///< 图层的网格大小（列数, 行数）
 		std::vector<entt::entity> tiles_;   ///< 瓦片实体列表，按 row * width + col 顺序排列
+		std::vector<TileChunk> chunks_;     ///< 烘焙后的静态瓦片区块（未启用烘焙时为空）
+		std::vector<std::uint8_t> cells_;   ///< 按 row * width + col 顺序，低 4 位 TileType、高 4 位属性标志（可为空）
 
 		/**
 		 * @brief 构造函数
 		 * @param tile_size 瓦片尺寸（宽, 高）
 		 * @param map_size 图层网格大小（列数, 行数）
 		 * @param tiles 包含所有瓦片实体的列表
+		 * @param chunks 烘焙后的静态瓦片区块
+		 * @param cells 格子表
 		 */
 		TileLayerComponent(glm::ivec2 tile_size, 
 						glm::ivec2 map_size, 
-						std::vector<entt::entity> tiles) : 
+						std::vector<entt::entity> tiles,
+						std::vector<TileChunk> chunks = {},
+						std::vector<std::uint8_t> cells = {}) : 
 						tile_size_(std::move(tile_size)), 
 						map_size_(std::move(map_size)),
-						tiles_(std::move(tiles)) {}
+						tiles_(std::move(tiles)),
+						chunks_(std::move(chunks)),
+						cells_(std::move(cells)) {}
 	};
 }  // namespace engine::component
\ No newline at end of file
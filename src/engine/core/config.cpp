@@ -1,5 +1,7 @@
 #include "config.h"
+#include "hardware_tier.h"
 #include "spdlog/spdlog.h"
+#include <algorithm>
 #include <fstream>
 #include <nlohmann/json.hpp>
 
@@ -85,6 +87,7 @@ void engine::core::Config::fromJson(const nlohmann::json& j)
         const auto& graphics_config = j["graphics"];
         vsync_enabled_ = graphics_config.value("vsync", vsync_enabled_);
         renderer_backend_ = graphics_config.value("renderer_backend", renderer_backend_);
+        pixel_perfect_ = graphics_config.value("pixel_perfect", pixel_perfect_);
     }
 
     if (j.contains("performance") && j["performance"].is_object()) {
@@ -94,6 +97,76 @@ void engine::core::Config::fromJson(const nlohmann::json& j)
             spdlog::warn("配置警告：目标 FPS ({}) 不能为负数。已重置为 0（无限制）。", target_fps_);
             target_fps_ = 0;
         }
+        idle_fps_ = perf_config.value("idle_fps", idle_fps_);
+        if (idle_fps_ < 0) {
+            spdlog::warn("配置警告：空闲帧率 ({}) 不能为负数。已重置为 0（关闭节能）。", idle_fps_);
+            idle_fps_ = 0;
+        }
+        worker_threads_ = perf_config.value("worker_threads", worker_threads_);
+        if (worker_threads_ < -1) {
+            spdlog::warn("配置警告：工作线程数 ({}) 无效。已重置为 -1（自动）。", worker_threads_);
+            worker_threads_ = -1;
+        }
+        texture_upload_budget_ms_ = perf_config.value("texture_upload_budget_ms", texture_upload_budget_ms_);
+        if (texture_upload_budget_ms_ < 0.0f) {
+            spdlog::warn("配置警告：纹理上传预算 ({}) 不能为负数。已重置为 2.0。", texture_upload_budget_ms_);
+            texture_upload_budget_ms_ = 2.0f;
+        }
+        texture_vram_budget_mb_ = perf_config.value("texture_vram_budget_mb", texture_vram_budget_mb_);
+        if (texture_vram_budget_mb_ < 0.0f) {
+            spdlog::warn("配置警告：纹理显存预算 ({}) 不能为负数。已重置为 0（不限）。", texture_vram_budget_mb_);
+            texture_vram_budget_mb_ = 0.0f;
+        }
+        simulation_hz_ = perf_config.value("simulation_hz", simulation_hz_);
+        if (simulation_hz_ < 0) {
+            spdlog::warn("配置警告：模拟频率 ({}) 不能为负数。已重置为 0（随帧率）。", simulation_hz_);
+            simulation_hz_ = 0;
+        }
+        max_simulation_steps_ = perf_config.value("max_simulation_steps", max_simulation_steps_);
+        if (max_simulation_steps_ < 1) {
+            spdlog::warn("配置警告：单帧最大模拟步数 ({}) 至少为 1。已重置为 5。", max_simulation_steps_);
+            max_simulation_steps_ = 5;
+        }
+        if (perf_config.contains("memory_budgets_mb") && perf_config["memory_budgets_mb"].is_object()) {
+            memory_budgets_mb_ = perf_config["memory_budgets_mb"].get<std::unordered_map<std::string, float>>();
+        }
+        hitch_threshold_factor_ = perf_config.value("hitch_threshold_factor", hitch_threshold_factor_);
+        hitch_log_path_ = perf_config.value("hitch_log_path", hitch_log_path_);
+        metrics_port_ = perf_config.value("metrics_port", metrics_port_);
+        if (metrics_port_ < 0 || metrics_port_ > 65535) {
+            spdlog::warn("配置警告：指标端口 ({}) 无效。已关闭指标端点。", metrics_port_);
+            metrics_port_ = 0;
+        }
+        registry_arena_mb_ = perf_config.value("registry_arena_mb", registry_arena_mb_);
+        if (registry_arena_mb_ < 0) {
+            spdlog::warn("配置警告：注册表 arena 大小 ({}) 不能为负数。已关闭。", registry_arena_mb_);
+            registry_arena_mb_ = 0;
+        }
+        quality_floor_ = perf_config.value("quality_floor", quality_floor_);
+        if (quality_floor_ < 0 || quality_floor_ > 4) {
+            spdlog::warn("配置警告：画质档位下限 ({}) 应在 0-4 之间。已截断。", quality_floor_);
+            quality_floor_ = std::clamp(quality_floor_, 0, 4);
+        }
+        if (perf_config.contains("system_rates_hz") && perf_config["system_rates_hz"].is_object()) {
+            system_rates_hz_ = perf_config["system_rates_hz"].get<std::unordered_map<std::string, float>>();
+            std::erase_if(system_rates_hz_, [](const auto& entry) {
+                if (entry.second > 0.0f) {
+                    return false;
+                }
+                spdlog::warn("配置警告：系统 {} 的执行频率 ({}) 必须大于 0。已忽略。", entry.first, entry.second);
+                return true;
+            });
+        }
+        performance_tier_ = perf_config.value("tier", performance_tier_);
+        applied_tier_ = perf_config.value("applied_tier", applied_tier_);
+        if (perf_config.contains("tier_pinned") && perf_config["tier_pinned"].is_array()) {
+            tier_pinned_ = perf_config["tier_pinned"].get<std::vector<std::string>>();
+        }
+    }
+
+    if (j.contains("debug") && j["debug"].is_object()) {
+        const auto& debug_config = j["debug"];
+        debug_tools_visible_ = debug_config.value("tools_visible", debug_tools_visible_);
     }
 
     if (j.contains("audio") && j["audio"].is_object()) {
@@ -113,6 +186,21 @@ void engine::core::Config::fromJson(const nlohmann::json& j)
             spdlog::warn("配置警告：音效音量 ({}) 必须在 0.0 - 1.0 范围内。已重置为 0.5。", sound_volume_);
             sound_volume_ = 0.5f;
         }
+        audio_sample_rate_ = audio_config.value("sample_rate", audio_sample_rate_);
+        if (audio_sample_rate_ != 0 && (audio_sample_rate_ < 8000 || audio_sample_rate_ > 192000)) {
+            spdlog::warn("配置警告：音频采样率 ({}) 必须为 0 或 8000 - 192000。已重置为 0（设备默认）。", audio_sample_rate_);
+            audio_sample_rate_ = 0;
+        }
+        audio_buffer_frames_ = audio_config.value("buffer_frames", audio_buffer_frames_);
+        if (audio_buffer_frames_ < 0 || audio_buffer_frames_ > 16384) {
+            spdlog::warn("配置警告：音频缓冲帧数 ({}) 必须在 0 - 16384 范围内。已重置为 0（设备默认）。", audio_buffer_frames_);
+            audio_buffer_frames_ = 0;
+        }
+        audio_channels_ = audio_config.value("channels", audio_channels_);
+        if (audio_channels_ < 0 || audio_channels_ > 8) {
+            spdlog::warn("配置警告：音频声道数 ({}) 必须在 0 - 8 范围内。已重置为 0（设备默认）。", audio_channels_);
+            audio_channels_ = 0;
+        }
     }
 
     // 合并输入映射，而不是整个替换
@@ -148,15 +236,75 @@ nlohmann::ordered_json engine::core::Config::toJson() const
         }},
         {"graphics", {
             {"vsync", vsync_enabled_},
-            {"renderer_backend", renderer_backend_}
+            {"renderer_backend", renderer_backend_},
+            {"pixel_perfect", pixel_perfect_}
         }},
         {"performance", {
-            {"target_fps", target_fps_}
+            {"target_fps", target_fps_},
+            {"idle_fps", idle_fps_},
+            {"worker_threads", worker_threads_},
+            {"texture_upload_budget_ms", texture_upload_budget_ms_},
+            {"texture_vram_budget_mb", texture_vram_budget_mb_},
+            {"simulation_hz", simulation_hz_},
+            {"max_simulation_steps", max_simulation_steps_},
+            {"memory_budgets_mb", memory_budgets_mb_},
+            {"hitch_threshold_factor", hitch_threshold_factor_},
+            {"hitch_log_path", hitch_log_path_},
+            {"metrics_port", metrics_port_},
+            {"registry_arena_mb", registry_arena_mb_},
+            {"quality_floor", quality_floor_},
+            {"system_rates_hz", system_rates_hz_},
+            {"tier", performance_tier_},
+            {"applied_tier", applied_tier_},
+            {"tier_pinned", tier_pinned_}
+        }},
+        {"debug", {
+            {"tools_visible", debug_tools_visible_}
         }},
         {"audio", {
             {"music_volume", music_volume_},
-            {"sound_volume", sound_volume_}
+            {"sound_volume", sound_volume_},
+            {"sample_rate", audio_sample_rate_},
+            {"buffer_frames", audio_buffer_frames_},
+            {"channels", audio_channels_}
         }},
         {"input_mappings", input_mappings_}
     };
 }
+
+/**
+ * @brief 把档位设置写入各项配置，tier_pinned_ 中列出的设置保留原值。
+ * @param settings 档位设置
+ * @param tier_name 档位名
+ */
+void engine::core::Config::applyTier(const TierSettings& settings, std::string_view tier_name)
+{
+    const auto pinned = [this](std::string_view key) {
+        return std::ranges::find(tier_pinned_, key) != tier_pinned_.end();
+    };
+    if (!pinned("renderer_backend")) {
+        renderer_backend_ = settings.renderer_backend_;
+    }
+    if (!pinned("pixel_perfect")) {
+        pixel_perfect_ = settings.pixel_perfect_;
+    }
+    if (!pinned("texture_vram_budget_mb")) {
+        texture_vram_budget_mb_ = settings.texture_vram_budget_mb_;
+    }
+    if (!pinned("worker_threads")) {
+        worker_threads_ = settings.worker_threads_;
+    }
+    if (!pinned("target_fps")) {
+        target_fps_ = settings.target_fps_;
+    }
+    if (!pinned("quality_floor")) {
+        quality_floor_ = settings.quality_floor_;
+    }
+    if (!pinned("system_rates_hz")) {
+        system_rates_hz_ = settings.system_rates_hz_;
+    }
+    applied_tier_ = tier_name;
+    spdlog::info("性能分级 '{}'：后端 {}，低分辨率世界层 {}，纹理预算 {:.0f} MB，工作线程 {}，目标 {} FPS，画质档位下限 {}{}",
+                 tier_name, renderer_backend_, pixel_perfect_, texture_vram_budget_mb_, worker_threads_, target_fps_, quality_floor_,
+                 tier_pinned_.empty() ? "" : "（部分设置已固定）");
+}
@@ -5,12 +5,15 @@
  */
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <nlohmann/json_fwd.hpp>    // nlohmann_json 提供的前向声明
 
 namespace engine::core {
 
+    struct TierSettings;
+
     /**
      * @class Config
      * @brief 配置管理类，负责加载、保存和管理游戏配置。
@@ -32,15 +35,40 @@ namespace engine::core {
 
         // 图形设置
         bool vsync_enabled_ = true;             ///< 是否启用垂直同步
-        std::string renderer_backend_ = "sdl";  ///< 渲染后端：sdl、opengl 或 vulkan
+        std::string renderer_backend_ = "sdl";  ///< 渲染后端：sdl、opengl、vulkan 或 gpu（SDL_GPU）
+        bool pixel_perfect_ = false;            ///< 世界层先画到逻辑分辨率的渲染目标再最近邻放大，窗口按整数倍缩放
 
         // 性能设置
         int target_fps_ = 144;                  ///< 目标 FPS 设置，0 表示不限制
+        int idle_fps_ = 5;                      ///< 空闲（暂停、游戏结束、窗口失去焦点）时的帧率上限，期间等待事件而不空转；0 表示关闭节能
+        int worker_threads_ = -1;               ///< 任务系统工作线程数，-1 表示硬件线程数减一，0 表示单线程
+        float texture_upload_budget_ms_ = 2.0f; ///< 每帧主线程任务队列（后台解码纹理的上传等）的时间预算（毫秒）
+        float texture_vram_budget_mb_ = 0.0f;   ///< 独立纹理的显存预算（MB），超出后按 LRU 淘汰未固定的纹理；0 表示不限
+        int simulation_hz_ = 60;                ///< 固定步长模拟频率，0 表示每帧模拟一次（步长随帧率变化）
+        int max_simulation_steps_ = 5;          ///< 单帧最多补跑的模拟步数
+        std::unordered_map<std::string, float> memory_budgets_mb_;  ///< 按内存标签（textures、registry 等）的预算（MB），空表示不设
+        float hitch_threshold_factor_ = 2.0f;   ///< 帧时长超过目标（或平滑）帧时长的该倍数时记为卡顿，不大于 1 关闭检测
+        std::string hitch_log_path_ = "logs/hitches.log";   ///< 卡顿诊断的滚动日志文件
+        int metrics_port_ = 0;                  ///< 本机指标端点（127.0.0.1）的端口，0 表示关闭
+        int registry_arena_mb_ = 0;             ///< 战斗场景组件存储的连续 arena 大小（MB，见 StorageArena），0 表示关闭
+        int quality_floor_ = 0;                 ///< 帧预算档位下限（0-4，见 FrameBudget），大于 0 时对应的降级项始终生效
+        std::unordered_map<std::string, float> system_rates_hz_;    ///< 按系统名的执行频率（Hz，见 SystemScheduler），未列出的系统每步执行
+
+        // 硬件分级（见 hardware_tier.h）
+        std::string performance_tier_ = "auto"; ///< auto（首次启动探测）、low、medium 或 high
+        std::string applied_tier_;              ///< 已写入各项设置的档位，空表示尚未分级；与 performance_tier_ 不一致时重新分级
+        std::vector<std::string> tier_pinned_;  ///< 分级不改写的设置（如 "target_fps"、"renderer_backend"），保留配置文件中的值
+
+        // 调试设置（仅 MONSTERWAR_DEBUG_TOOLS 构建生效）
+        bool debug_tools_visible_ = true;       ///< 启动时是否显示调试界面，运行时按 toggle_debug_tools 切换；关闭时整帧跳过 ImGui
 
         // 音频设置
         float master_volume_ = 0.5f;             ///< 主音量 (0.0 - 1.0)
         float music_volume_ = 0.5f;             ///< 音乐音量 (0.0 - 1.0)
         float sound_volume_ = 0.5f;             ///< 音效音量 (0.0 - 1.0)
+        int audio_sample_rate_ = 0;             ///< 音频设备采样率（Hz，0 使用设备默认值）
+        int audio_buffer_frames_ = 0;           ///< 音频设备缓冲帧数（0 使用设备默认值，越小延迟越低）
+        int audio_channels_ = 0;                ///< 音频输出声道数（0 使用设备默认值）
 
         // 存储动作名称到 SDL Scancode 名称列表的映射
         std::unordered_map<std::string, std::vector<std::string>> input_mappings_ = {   ///< 输入映射表
@@ -53,6 +81,9 @@ namespace engine::core {
             {"attack", {"K", "MouseLeft"}},
             {"pause", {"P", "Escape"}},
             {"switch_player", {"Tab"}},
+            {"screenshot", {"F12"}},
+            {"toggle_capture", {"F9"}},
+            {"toggle_debug_tools", {"F1"}},
             // 可以继续添加更多默认动作
         };
 
@@ -82,6 +113,12 @@ namespace engine::core {
          */
         [[nodiscard]] bool saveToFile(const std::string& filepath);
 
+        /**
+         * @brief 把档位设置写入各项配置（tier_pinned_ 中的设置跳过），并记下 applied_tier_
+         * @param tier_name 档位名（"low" / "medium" / "high"）
+         */
+        void applyTier(const TierSettings& settings, std::string_view tier_name);
+
     private:
         /**
          * @brief 从 JSON 对象反序列化配置。
@@ -0,0 +1,73 @@
+#include "content_cache.h"
+#include <system_error>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+void ContentCache::clear() {
+    std::scoped_lock lock(mutex_);
+    entries_.clear();
+}
+
+std::size_t ContentCache::size() const {
+    std::scoped_lock lock(mutex_);
+    std::size_t count = 0;
+    for (const auto& [type, entries] : entries_) {
+        count += entries.size();
+    }
+    return count;
+}
+
+std::shared_ptr<void> ContentCache::find(entt::id_type type, entt::id_type key) {
+    std::scoped_lock lock(mutex_);
+    auto type_it = entries_.find(type);
+    if (type_it == entries_.end()) {
+        return nullptr;
+    }
+    auto it = type_it->second.find(key);
+    if (it == type_it->second.end()) {
+        return nullptr;
+    }
+    if (!isFresh(it->second)) {
+        spdlog::info("内容缓存已过期，重新加载: {}", it->second.sources_.empty() ? std::string("<无源文件>") : it->second.sources_.front());
+        type_it->second.erase(it);
+        return nullptr;
+    }
+    return it->second.value_;
+}
+
+std::shared_ptr<void> ContentCache::insert(entt::id_type type, entt::id_type key, Entry entry) {
+    std::scoped_lock lock(mutex_);
+    auto& entries = entries_[type];
+    if (auto it = entries.find(key); it != entries.end() && isFresh(it->second)) {
+        return it->second.value_;
+    }
+    auto value = entry.value_;
+    entries.insert_or_assign(key, std::move(entry));
+    return value;
+}
+
+std::vector<std::filesystem::file_time_type> ContentCache::stampSources(const std::vector<std::string>& sources) {
+    std::vector<std::filesystem::file_time_type> stamps;
+    stamps.reserve(sources.size());
+    for (const auto& source : sources) {
+        std::error_code ec;
+        const auto stamp = std::filesystem::last_write_time(source, ec);
+        stamps.push_back(ec ? std::filesystem::file_time_type::min() : stamp);
+    }
+    return stamps;
+}
+
+bool ContentCache::isFresh(const Entry& entry) {
+    for (std::size_t i = 0; i < entry.sources_.size(); ++i) {
+        std::error_code ec;
+        const auto stamp = std::filesystem::last_write_time(entry.sources_[i], ec);
+        // 只存在于资源包中的源文件取不到修改时间，与记录时一致即视为未变（资源包运行期间不变）
+        if ((ec ? std::filesystem::file_time_type::min() : stamp) != entry.stamps_[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace engine::core
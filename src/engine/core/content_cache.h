@@ -0,0 +1,87 @@
+#pragma once
+/**
+ * @file content_cache.h
+ * @brief 应用生命周期内的已解析内容缓存：蓝图表、tileset 等只读内容跨场景重载共享。
+ *
+ * @details
+ * 重新开始或切换关卡时，新场景会再次解析同一批 JSON。ContentCache 按 (类型, 键) 保存 std::shared_ptr，
+ * 并记录生成该内容的源文件及其修改时间；取用时任一源文件的修改时间变化（或文件消失）即重新生成，
+ * 编辑资源后不必重启。
+ *
+ * - 线程安全：查找与插入持锁，加载函数在锁外执行；同一键并发未命中时保留先插入的结果
+ * - 加载失败（返回 nullptr）不缓存，下次取用重试
+ * - 缓存的内容按约定只读，所有持有者共享同一份
+ *
+ * @code
+ * auto blueprints = context.getContentCache().getOrLoad<BlueprintManager>("blueprints"_hs, sources,
+ *     [&]() -> std::shared_ptr<BlueprintManager> { ... });   // 失败返回 nullptr
+ * @endcode
+ */
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <entt/core/fwd.hpp>
+#include <entt/core/type_info.hpp>
+#include "../utils/id_map.h"
+
+namespace engine::core {
+
+class ContentCache final {
+public:
+    ContentCache() = default;
+    ContentCache(const ContentCache&) = delete;
+    ContentCache& operator=(const ContentCache&) = delete;
+
+    /**
+     * @brief 取出 (T, key) 对应的内容；未缓存或源文件已变化时调用 load 重新生成。
+     * @param sources 生成该内容所读取的文件，用于修改时间校验（可为空，表示永不过期）
+     * @param load 可调用对象 () -> std::shared_ptr<T>，失败时返回 nullptr
+     */
+    template <typename T, typename Loader>
+    std::shared_ptr<T> getOrLoad(entt::id_type key, const std::vector<std::string>& sources, Loader&& load) {
+        const entt::id_type type = entt::type_hash<std::remove_const_t<T>>::value();
+        if (auto cached = find(type, key)) {
+            return std::static_pointer_cast<T>(cached);
+        }
+        // 先记录时间再加载：加载期间被改动的文件在下次取用时会被发现
+        auto stamps = stampSources(sources);
+        std::shared_ptr<T> loaded = std::forward<Loader>(load)();
+        if (!loaded) {
+            return nullptr;
+        }
+        auto stored = insert(type, key, Entry{ std::const_pointer_cast<std::remove_const_t<T>>(loaded), sources, std::move(stamps) });
+        return std::static_pointer_cast<T>(stored);
+    }
+
+    /// @brief 丢弃所有缓存内容（已取出的 shared_ptr 仍然有效）
+    void clear();
+
+    /// @brief 缓存条目数
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<void> value_;
+        std::vector<std::string> sources_;
+        std::vector<std::filesystem::file_time_type> stamps_;
+    };
+
+    /// @brief 取出未过期的条目，过期时移除并返回 nullptr
+    std::shared_ptr<void> find(entt::id_type type, entt::id_type key);
+    /// @brief 插入条目；已有未过期条目时保留已有的并返回它
+    std::shared_ptr<void> insert(entt::id_type type, entt::id_type key, Entry entry);
+
+    static std::vector<std::filesystem::file_time_type> stampSources(const std::vector<std::string>& sources);
+    static bool isFresh(const Entry& entry);
+
+    mutable std::mutex mutex_;
+    engine::utils::IdMap<engine::utils::IdMap<Entry>> entries_;     ///< 类型 -> 键 -> 条目
+};
+
+} // namespace engine::core
@@ -22,6 +22,12 @@
  * @param resource_manager 资源管理器引用
  * @param input_manager 输入管理器引用
  * @param game_state 游戏状态引用
+ * @param job_system 任务系统引用
+ * @param time 时间管理引用
+ * @param frame_arena 帧内临时内存引用
+ * @param frame_budget 帧时间预算引用
+ * @param content_cache 已解析内容缓存引用
+ * @param task_pool 异步任务线程池引用
  */
 engine::core::Context::Context(engine::render::Renderer& renderer,
 							   engine::render::TextRenderer& text_renderer,
@@ -29,14 +35,26 @@ engine::core::Context::Context(engine::render::Renderer& renderer,
 							   engine::render::Camera& camera,
 							   engine::resource::ResourceManager& resource_manager,
 							   engine::input::InputManager& input_manager,
-							   engine::core::GameState& game_state)
+							   engine::core::GameState& game_state,
+							   engine::core::JobSystem& job_system,
+							   engine::core::Time& time,
+							   engine::memory::FrameArena& frame_arena,
+							   engine::core::FrameBudget& frame_budget,
+							   engine::core::ContentCache& content_cache,
+							   engine::core::TaskPool& task_pool)
 							 : renderer_(renderer),
 							   text_renderer_(text_renderer),
 							   dispatcher_(dispatcher),
 							   camera_(camera),
 							   resource_manager_(resource_manager),
 							   input_manager_(input_manager),
-							   game_state_(game_state)
+							   game_state_(game_state),
+							   job_system_(job_system),
+							   time_(time),
+							   frame_arena_(frame_arena),
+							   frame_budget_(frame_budget),
+							   content_cache_(content_cache),
+							   task_pool_(task_pool)
 {
 	spdlog::info("Context created.");
 }
@@ -25,6 +25,16 @@ namespace engine::render
 namespace engine::core
 {
 	class GameState;
+	class JobSystem;
+	class Time;
+	class FrameBudget;
+	class ContentCache;
+	class TaskPool;
+}
+
+namespace engine::memory
+{
+	class FrameArena;
 }
 
 
@@ -54,6 +64,18 @@ namespace engine::core
 		engine::input::InputManager& input_manager_;
 		/// 游戏状态引用
 		engine::core::GameState& game_state_;
+		/// 任务系统引用
+		engine::core::JobSystem& job_system_;
+		/// 时间管理引用（模拟步长与渲染插值系数）
+		engine::core::Time& time_;
+		/// 帧内临时内存引用
+		engine::memory::FrameArena& frame_arena_;
+		/// 帧时间预算引用（可选工作的降级档位）
+		engine::core::FrameBudget& frame_budget_;
+		/// 跨场景共享的已解析内容缓存引用
+		engine::core::ContentCache& content_cache_;
+		/// 异步任务线程池引用
+		engine::core::TaskPool& task_pool_;
 	public:
 		/**
 		 * @brief 构造函数，初始化上下文并保存各系统引用。
@@ -63,6 +85,12 @@ namespace engine::core
 		 * @param resource_manager 资源管理器引用
 		 * @param input_manager 输入管理器引用
 		 * @param game_state 游戏状态引用
+		 * @param job_system 任务系统引用
+		 * @param time 时间管理引用
+		 * @param frame_arena 帧内临时内存引用
+		 * @param frame_budget 帧时间预算引用
+		 * @param content_cache 已解析内容缓存引用
+		 * @param task_pool 异步任务线程池引用
 		 */
 		Context(engine::render::Renderer& renderer,
 				engine::render::TextRenderer& text_renderer,
@@ -70,7 +98,13 @@ namespace engine::core
 				engine::render::Camera& camera,
 				engine::resource::ResourceManager& resource_manager,
 				engine::input::InputManager& input_manager,
-				engine::core::GameState& game_state);
+				engine::core::GameState& game_state,
+				engine::core::JobSystem& job_system,
+				engine::core::Time& time,
+				engine::memory::FrameArena& frame_arena,
+				engine::core::FrameBudget& frame_budget,
+				engine::core::ContentCache& content_cache,
+				engine::core::TaskPool& task_pool);
 			
 
 		/// 禁止拷贝构造和移动
@@ -141,6 +175,60 @@ namespace engine::core
 			return dispatcher_;
 		}
 
+		/**
+		 * @brief 获取任务系统引用。
+		 * @return engine::core::JobSystem& 任务系统引用
+		 */
+		engine::core::JobSystem& getJobSystem()
+		{
+			return job_system_;
+		}
+
+		/**
+		 * @brief 获取时间管理引用。
+		 * @return engine::core::Time& 时间管理引用
+		 */
+		engine::core::Time& getTime()
+		{
+			return time_;
+		}
+
+		/**
+		 * @brief 获取帧内临时内存（仅主线程使用，GameApp::render() 结束后失效）。
+		 * @return engine::memory::FrameArena& 帧内存引用
+		 */
+		engine::memory::FrameArena& getFrameArena()
+		{
+			return frame_arena_;
+		}
+
+		/**
+		 * @brief 获取帧时间预算（超预算时各系统据此跳过可选工作）。
+		 * @return engine::core::FrameBudget& 帧时间预算引用
+		 */
+		engine::core::FrameBudget& getFrameBudget()
+		{
+			return frame_budget_;
+		}
+
+		/**
+		 * @brief 获取应用生命周期内的已解析内容缓存（蓝图、tileset 等，跨场景重载共享）。
+		 * @return engine::core::ContentCache& 内容缓存引用
+		 */
+		engine::core::ContentCache& getContentCache()
+		{
+			return content_cache_;
+		}
+
+		/**
+		 * @brief 获取异步任务线程池（加载、解码等跨帧工作，以及每帧执行一次的主线程队列）。
+		 * @return engine::core::TaskPool& 任务线程池引用
+		 */
+		engine::core::TaskPool& getTaskPool()
+		{
+			return task_pool_;
+		}
+
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+/**
+ * @file event_phase.h
+ * @brief 一帧内 dispatcher 队列的派发阶段：每个阶段只有一次 dispatcher.update()，事件在哪一次派发由入队时机唯一决定。
+ *
+ * @details
+ * 帧内顺序与各阶段派发的事件：
+ * | 阶段 | 派发位置 | 派发的事件 |
+ * |------|----------|------------|
+ * | （输入） | 不派发 | handleEvents 中的玩家指令走即时路径（dispatcher.trigger），在本帧 update 之前生效 |
+ * | SIMULATION | GameScene::simulate，每个固定步开头 | 上一步与本帧输入之后入队的玩法事件 |
+ * | FRAME | GameApp::update 末尾 | 本帧 update 中入队、未被模拟步取走的事件，以及写入线程的存档完成通知 |
+ * | UI | GameApp::render，UI 构建之后、present 之前 | 渲染阶段 UI 入队的事件 |
+ *
+ * 玩家指令（出击准备、放置、取消）不经队列：由输入回调直接 trigger，结果在本帧 render 中可见，
+ * 输入到上屏恰好一帧，与当帧有几个模拟步、入队事件被哪一次派发取走无关。
+ * 延迟由 InputManager::markCommand() 逐次结算（计数器 input.command_us / input.command_frames）。
+ */
+
+#include <cstdint>
+
+namespace engine::core {
+
+enum class EventPhase : std::uint8_t {
+    SIMULATION,     ///< 固定步开头（GameScene::simulate）
+    FRAME,          ///< 帧更新末尾（GameApp::update）
+    UI,             ///< UI 构建之后（GameApp::render）
+};
+
+} // namespace engine::core
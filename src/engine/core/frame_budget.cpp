@@ -0,0 +1,78 @@
+#include "frame_budget.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+namespace {
+    constexpr double SMOOTHING = 0.1;           ///< 指数平滑系数，约等于最近 10 帧的均值
+    constexpr double HEADROOM_RATIO = 0.7;      ///< 低于预算的该比例视为有余量
+    constexpr int STEP_DOWN_FRAMES = 30;        ///< 持续超预算多少帧后降一档
+    constexpr int STEP_UP_FRAMES = 120;         ///< 持续有余量多少帧后升一档
+    constexpr int MAX_FAST_FORWARD = 8;         ///< 与 Time::MAX_FAST_FORWARD 一致
+}
+
+void FrameBudget::setTargetFPS(int target_fps) {
+    budget_ms_ = 1000.0 / static_cast<double>(target_fps > 0 ? target_fps : 60);
+    spdlog::info("帧时间预算: {:.2f} ms", budget_ms_);
+}
+
+void FrameBudget::setMinimumLevel(int level) {
+    min_level_ = level < 0 ? 0 : (level > MAX_LEVEL ? MAX_LEVEL : level);
+    if (level_ < min_level_) {
+        level_ = min_level_;
+    }
+    if (min_level_ > 0) {
+        spdlog::info("画质档位下限: {}（{}）", min_level_, describe(min_level_));
+    }
+}
+
+void FrameBudget::record(double work_ms) {
+    smoothed_ms_ = smoothed_ms_ == 0.0 ? work_ms : smoothed_ms_ + (work_ms - smoothed_ms_) * SMOOTHING;
+
+    // 正在快进且实际倍数受上限约束时，先调整快进倍数
+    const int fast_forward = fast_forward_requested_ < fast_forward_limit_ ? fast_forward_requested_ : fast_forward_limit_;
+    if (smoothed_ms_ > budget_ms_) {
+        under_frames_ = 0;
+        if (++over_frames_ >= STEP_DOWN_FRAMES) {
+            if (fast_forward > 1) {
+                fast_forward_limit_ = fast_forward / 2;
+                over_frames_ = 0;
+                spdlog::info("帧耗时 {:.2f} ms 超出预算 {:.2f} ms，快进降至 {} 倍", smoothed_ms_, budget_ms_, fast_forward_limit_);
+            } else if (level_ < MAX_LEVEL) {
+                ++level_;
+                over_frames_ = 0;
+                spdlog::info("帧耗时 {:.2f} ms 超出预算 {:.2f} ms，画质降至档位 {}：{}", smoothed_ms_, budget_ms_, level_, describe(level_));
+            }
+        }
+    } else if (smoothed_ms_ < budget_ms_ * HEADROOM_RATIO) {
+        over_frames_ = 0;
+        if (++under_frames_ >= STEP_UP_FRAMES) {
+            if (level_ > min_level_) {
+                spdlog::info("帧耗时 {:.2f} ms 恢复余量，撤销档位 {}：{}", smoothed_ms_, level_, describe(level_));
+                --level_;
+                under_frames_ = 0;
+            } else if (fast_forward_requested_ > fast_forward_limit_ && fast_forward_limit_ < MAX_FAST_FORWARD) {
+                fast_forward_limit_ *= 2;
+                under_frames_ = 0;
+                spdlog::info("帧耗时 {:.2f} ms 恢复余量，快进上限升至 {} 倍", smoothed_ms_, fast_forward_limit_);
+            }
+        }
+    } else {
+        // 处于预算与余量线之间：保持当前档位
+        over_frames_ = 0;
+        under_frames_ = 0;
+    }
+}
+
+const char* FrameBudget::describe(int level) {
+    switch (level) {
+    case 0: return "全部开启";
+    case 1: return "血条降频";
+    case 2: return "仅显示选中单位范围";
+    case 3: return "命中特效减半";
+    case 4: return "关闭渲染插值";
+    default: return "未知";
+    }
+}
+
+} // namespace engine::core
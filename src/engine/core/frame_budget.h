@@ -0,0 +1,91 @@
+#pragma once
+/**
+ * @file frame_budget.h
+ * @brief 帧时间预算控制器：逻辑与渲染耗时超出预算时按固定顺序降低可选工作，恢复余量后逐级回升。
+ *
+ * @details
+ * GameApp 每帧记录 update + render 的 CPU 耗时（不含限帧等待与 present 阻塞），
+ * 与目标帧率对应的帧时长比较。平滑后的耗时持续超出预算时降一档，持续低于预算的 70% 时升一档；
+ * 降档快（约半秒）、升档慢（约两秒），避免在临界负载下来回切换。
+ *
+ * 快进时（setFastForward 传入大于 1 的倍数）先降快进倍数再降画质：持续超预算时快进上限减半，
+ * 降到 1 倍后才开始降画质档；恢复时先撤销画质档，全部恢复后再逐次翻倍快进上限。
+ *
+ * 硬件分级可设档位下限（setMinimumLevel，performance.quality_floor）：低档硬件从一开始就处于该档，
+ * 恢复余量时也不会回到下限以下。
+ *
+ * 档位越高，省掉的工作越多（每一档包含之前所有档位）：
+ * | 档位 | QualityStep            | 说明 |
+ * |------|------------------------|------|
+ * | 1    | THROTTLE_HEALTH_BARS   | 血条每 N 帧更新一次 |
+ * | 2    | SELECTED_RANGE_ONLY    | 只绘制选中单位与放置预览的攻击范围 |
+ * | 3    | REDUCED_EFFECTS        | 纯表现特效减半生成（升级、技能提示不受影响） |
+ * | 4    | NO_INTERPOLATION       | 关闭渲染插值，直接使用最新模拟位置 |
+ *
+ * @code
+ * if (!context.getFrameBudget().isReduced(engine::core::QualityStep::REDUCED_EFFECTS)) { ... }
+ * @endcode
+ */
+
+#include <cstdint>
+
+namespace engine::core {
+
+/// @brief 可降级的工作项，枚举值即开始生效的档位
+enum class QualityStep : std::uint8_t {
+    THROTTLE_HEALTH_BARS = 1,
+    SELECTED_RANGE_ONLY = 2,
+    REDUCED_EFFECTS = 3,
+    NO_INTERPOLATION = 4,
+};
+
+class FrameBudget final {
+public:
+    static constexpr int MAX_LEVEL = 4;
+
+    /**
+     * @brief 按目标帧率设置预算
+     * @param target_fps 目标帧率，0（不限帧）时按 60 FPS 计算
+     */
+    void setTargetFPS(int target_fps);
+
+    /// @brief 档位下限（0 到 MAX_LEVEL），当前档位低于下限时立即提升
+    void setMinimumLevel(int level);
+
+    /**
+     * @brief 记录一帧的工作耗时并在需要时调整档位
+     * @param work_ms 本帧 update + render 的 CPU 耗时（毫秒）
+     */
+    void record(double work_ms);
+
+    /**
+     * @brief 告知本帧请求的快进倍数（在 record 之前调用）
+     * @param requested 请求的快进倍数，1 表示未快进；此时快进上限保持不变
+     */
+    void setFastForward(int requested) { fast_forward_requested_ = requested; }
+
+    /// @brief 帧预算允许的快进倍数上限
+    [[nodiscard]] int getFastForwardLimit() const { return fast_forward_limit_; }
+
+    /// @brief 某项工作当前是否已被降级
+    [[nodiscard]] bool isReduced(QualityStep step) const { return level_ >= static_cast<int>(step); }
+
+    [[nodiscard]] int getLevel() const { return level_; }
+    [[nodiscard]] double getBudgetMs() const { return budget_ms_; }
+    [[nodiscard]] double getSmoothedMs() const { return smoothed_ms_; }
+
+    /// @brief 当前档位新增降级项的简短说明（调试面板使用）
+    [[nodiscard]] static const char* describe(int level);
+
+private:
+    double budget_ms_{1000.0 / 60.0};
+    double smoothed_ms_{0.0};
+    int level_{0};
+    int min_level_{0};
+    int over_frames_{0};        ///< 连续超出预算的帧数
+    int under_frames_{0};       ///< 连续留有余量的帧数
+    int fast_forward_requested_{1};
+    int fast_forward_limit_{8};
+};
+
+} // namespace engine::core
@@ -1,33 +1,62 @@
 #include "game_app.h"
 #include <spdlog/spdlog.h>
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include "Time.h"
 #include "game_state.h"
 #include "../resource/resource_manager.h"
+#include "../resource/audio_manager.h"
 #include "../render/camera.h"
 #include "../render/renderer.h"
 #include "../render/text_renderer.h"
+#include "../render/frame_capture.h"
 #include "config.h"
 #include "../input/input_manager.h"
 #include "context.h"
+#include "job_system.h"
+#include "task_pool.h"
+#include "frame_budget.h"
+#include "hardware_tier.h"
+#include "hitch_detector.h"
+#include "content_cache.h"
+#include "metrics_server.h"
+#include "init_graph.h"
+#include "startup_profiler.h"
+#include "system_scheduler.h"
+#include "../memory/frame_arena.h"
+#include "../memory/memory_tracker.h"
+#include "../memory/storage_arena.h"
+#include "../ecs/registry_census.h"
+#include "../io/save_service.h"
 #include "../scene/scene_manager.h"
 #include "../audio/audio_player.h"
 #include "../audio/audio_locator.h"
 #include "../audio/log_audio_player.h"
 #include "../utils/events.h"
-#include "../utils/future_utils.h"
 #include "../../game/defs/event.h"
 #include "../scene/scene.h"
 #include "../../game/data/game_stats.h"
-#include "../../game/ui/hero_inspector_ui.h"
+#include "../../game/data/checkpoint_info.h"
 #include "../../game/component/class_name_component.h"
 #include "../../game/component/player_component.h"
 #include "../../game/component/stats_component.h"
 #include "../../game/component/target_component.h"
 #include "../../game/defs/tags.h"
+#include "../system/render_system.h"
+#include "../../game/system/simulation_lod_system.h"
+#include "../../game/system/set_target_system.h"
+#include "../utils/profiler.h"
+#include <entt/core/hashed_string.hpp>
+#if MONSTERWAR_DEBUG_TOOLS
+#include "../debug/debug_tools.h"
+#include "../../game/ui/hero_inspector_ui.h"
+#include "../../game/ui/profiler_ui.h"
 #include <imgui.h>
 #include <backends/imgui_impl_sdl3.h>
 #include <backends/imgui_impl_sdlrenderer3.h>
+#endif
 
 
 /**
@@ -35,6 +64,10 @@
  */
 engine::core::GameApp::GameApp() = default;
 
+namespace {
+	constexpr const char* CONFIG_PATH = "assets/config.json";
+}
+
 /**
  * @brief 析构函数，清理游戏资源。
  */
@@ -53,22 +86,247 @@ engine::core::GameApp::~GameApp()
  */
 void engine::core::GameApp::run()
 {
+	const auto boot_start = std::chrono::steady_clock::now();
+	bool first_frame = true;
 	if (!init()) {
 		spdlog::error("游戏应用程序初始化失败，无法运行！");
 		return;
 	}
 	time_->setTargetFPS(config_->target_fps_);
+	{
+		float refresh_rate = 0.0f;
+		if (const auto* mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window_))) {
+			refresh_rate = mode->refresh_rate;
+		}
+		time_->setVSync(config_->vsync_enabled_, refresh_rate);
+	}
 	time_->setTimeScale(1.0);
+	time_->setSimulationRate(config_->simulation_hz_, config_->max_simulation_steps_);
+	frame_budget_->setTargetFPS(config_->target_fps_);
+	frame_budget_->setMinimumLevel(config_->quality_floor_);
+	engine::core::SystemScheduler::setConfiguredRates(config_->system_rates_hz_);  // 分级之后，第一个场景建立调度器之前
+	hitch_detector_->setLogPath(config_->hitch_log_path_);
+	hitch_detector_->configure(config_->hitch_threshold_factor_, config_->target_fps_);
+	if (config_->metrics_port_ > 0) {
+		metrics_server_ = std::make_unique<engine::core::MetricsServer>();
+		if (!metrics_server_->start(static_cast<std::uint16_t>(config_->metrics_port_))) {
+			metrics_server_.reset();
+		}
+	}
+	if (!SDL_AddEventWatch(&GameApp::onWindowEvent, this)) {
+		spdlog::warn("无法注册窗口事件监视，拖动窗口时画面会暂停: {}", SDL_GetError());
+	}
+	auto& startup = engine::core::StartupProfiler::instance();
+	int frames_after_scene = -1;	// 启动剖析：本关首帧之后已等待的帧数（-1 表示场景尚未就绪）
 	while(is_running_) {
-		time_->update();
-       float delta_time = time_->getScaledDeltaTime();
+		const auto frame_start = std::chrono::steady_clock::now();
+		runFrame(false);
+		if (first_frame) {
+			first_frame = false;
+			const std::chrono::duration<double, std::milli> boot = std::chrono::steady_clock::now() - boot_start;
+			spdlog::info("首帧已呈现：启动后 {:.0f} ms（图集{}）", boot.count(),
+				resource_manager_->isMappedPreloadComplete() ? "已就绪" : "仍在后台加载");
+			startup.mark("t.first_frame");
+		}
+		if (!profile_startup_) {
+			continue;
+		}
+		if (resource_manager_->isMappedPreloadComplete()) {
+			startup.mark("t.atlas_ready");
+		}
+		if (frames_after_scene < 0 && startup.consumeSceneReady()) {
+			// 场景在这一帧的 update 中完成初始化，这一帧呈现的就是本关的第一帧
+			const std::chrono::duration<double, std::milli> frame = std::chrono::steady_clock::now() - frame_start;
+			startup.addPhase("frame.first_scene", frame.count());
+			startup.mark("t.first_scene_frame");
+			frames_after_scene = 0;
+		}
+		// 等到后台图集也就绪再结束本次运行，最多再跑 PROFILE_STARTUP_MAX_WAIT_FRAMES 帧
+		if (frames_after_scene >= 0 && (resource_manager_->isMappedPreloadComplete() || ++frames_after_scene > PROFILE_STARTUP_MAX_WAIT_FRAMES)) {
+			is_running_ = false;
+		}
+	}
+	close();
+}
 
+/**
+ * @brief 执行一帧。
+ * @details 外层帧的事件泵入期间置 in_event_pump_；系统模态循环（拖动、缩放窗口）嵌在泵入里时，
+ *          onWindowEvent 以 live 方式插入帧。插入帧自己计时（Time::update 从上一帧结束算起）。
+ *          外层帧先泵入事件、后计时：插入帧改写的是 Time 上一帧的步数与插值，外层帧随后的 Time::update
+ *          从最后一个插入帧结束算起，模拟时间不重复也不丢失。
+ */
+void engine::core::GameApp::runFrame(bool live)
+{
+	auto& profiler = engine::utils::Profiler::instance();
+	bool idle_frame = false;
+	if (!live) {
+		in_event_pump_ = true;
+		idle_frame = waitWhileIdle();
+		in_event_pump_ = false;
+		profiler.beginFrame();
+	}
+	// 外层帧的事件处理在计时之前：泵入中插入的帧会推进 Time，之后再计算本帧的步数
+	std::chrono::duration<double, std::milli> events_work{ 0.0 };
+	if (!live) {
+		const auto events_start = std::chrono::steady_clock::now();
+		in_event_pump_ = true;
 		handleEvents();
-		update(delta_time);
-		render();
-		//spdlog::info("delta_time: {}", delta_time);
+		in_event_pump_ = false;
+		events_work = std::chrono::steady_clock::now() - events_start;
+		if (live_frames_ > 0) {
+			spdlog::debug("窗口模态循环结束，期间插入 {} 帧", live_frames_);
+			live_frames_ = 0;
+		}
+	}
+	time_->update();
+	time_->advanceSimulation();
+	ENGINE_PROFILE_COUNTER("sim.steps", time_->getSimulationSteps());
+	float delta_time = time_->getScaledDeltaTime();
+
+	const auto work_start = std::chrono::steady_clock::now();
+	update(delta_time);
+	render();
+	if (live) {
+		return;
+	}
+	if (input_manager_->getLatencyStats().events_ > 0) {
+		last_input_ns_ = SDL_GetTicksNS();
+	}
+	// 预算只统计 CPU 工作量：限帧等待在 time_->update() 中，present 的阻塞在 render() 中单独扣除
+	const std::chrono::duration<double, std::milli> work = std::chrono::steady_clock::now() - work_start + events_work;
+	frame_budget_->setFastForward(time_->getFastForward());
+	frame_budget_->record(work.count() - present_ms_);
+	time_->setFastForwardLimit(frame_budget_->getFastForwardLimit());   // 下一帧生效
+	ENGINE_PROFILE_COUNTER("budget.level", frame_budget_->getLevel());
+	profiler.endFrame();
+	ENGINE_PROFILE_FRAME_MARK();
+	{
+		auto* scene = scene_manager_->getCurrentScene();
+		if (idle_frame) {
+			hitch_detector_->skipFrame();
+		}
+		hitch_detector_->endFrame(scene ? &scene->getRegistry() : nullptr);
+	}
+	if (metrics_server_) {
+		const auto now = std::chrono::steady_clock::now();
+		if (metrics_server_->isSampleDue(now)) {
+			sampleMetrics(now);
+		}
 	}
-	close();
+}
+
+/**
+ * @brief 填写并发布一份指标快照。
+ * @details 数据与调试面板同源：分析器历史帧、Time 帧统计、场景的组件普查、内存标签与纹理显存。
+ *          快照数组保留容量，稳态下只有普查与内存统计本身的开销。
+ */
+void engine::core::GameApp::sampleMetrics(std::chrono::steady_clock::time_point now)
+{
+	ENGINE_PROFILE_SCOPE("GameApp::sampleMetrics");
+	auto& snapshot = metrics_server_->beginSample();
+	snapshot.uptime_s_ = static_cast<double>(SDL_GetTicksNS()) / 1e9;
+	auto* scene = scene_manager_->getCurrentScene();
+	snapshot.scene_ = scene ? scene->getSceneName() : std::string{};
+
+	// 帧时间：平均、1% low 与最大值来自 Time，分位数来自分析器历史帧
+	const auto frame_stats = time_->getFrameStats();
+	snapshot.frame_avg_ms_ = frame_stats.average_ms_;
+	snapshot.frame_one_percent_low_ms_ = frame_stats.one_percent_low_ms_;
+	snapshot.frame_max_ms_ = frame_stats.max_ms_;
+	snapshot.frame_samples_ = frame_stats.sample_count_;
+	const auto& profiler = engine::utils::Profiler::instance();
+	const auto& history = profiler.getHistory();
+	metrics_frame_ms_.clear();
+	double history_ms = 0.0;
+	for (const auto& frame : history) {
+		metrics_frame_ms_.push_back(frame.durationMs());
+		history_ms += frame.durationMs();
+	}
+	const auto percentile = [this](double p) {
+		if (metrics_frame_ms_.empty()) {
+			return 0.0;
+		}
+		const auto index = static_cast<std::size_t>(p * static_cast<double>(metrics_frame_ms_.size() - 1));
+		std::nth_element(metrics_frame_ms_.begin(), metrics_frame_ms_.begin() + static_cast<std::ptrdiff_t>(index), metrics_frame_ms_.end());
+		return metrics_frame_ms_[index];
+	};
+	snapshot.frame_p50_ms_ = percentile(0.50);
+	snapshot.frame_p95_ms_ = percentile(0.95);
+	snapshot.frame_p99_ms_ = percentile(0.99);
+
+	snapshot.scopes_.clear();
+	for (const auto& stats : profiler.computeScopeStats()) {
+		if (stats.name_) {
+			snapshot.scopes_.push_back({ stats.name_, stats.last_ms_, stats.p50_ms_, stats.p99_ms_, stats.calls_ });
+		}
+	}
+	// 计数器取最近一帧的值；evt.* 是各事件通道的帧内数量，另按历史帧合计换算为每秒速率
+	snapshot.counters_.clear();
+	if (!history.empty()) {
+		for (const auto& [name, value] : history.back().counters_) {
+			auto& counter = snapshot.counters_.emplace_back(MetricsSnapshot::Counter{ name, value, 0.0 });
+			if (counter.name_.starts_with("evt.") && history_ms > 0.0) {
+				std::int64_t total = 0;
+				for (const auto& frame : history) {
+					for (const auto& [frame_name, frame_value] : frame.counters_) {
+						if (frame_name == name) {
+							total += frame_value;
+							break;
+						}
+					}
+				}
+				counter.per_second_ = static_cast<double>(total) * 1000.0 / history_ms;
+			}
+		}
+	}
+
+	snapshot.entities_ = 0;
+	snapshot.storages_.clear();
+	if (scene) {
+		snapshot.entities_ = scene->getRegistry().storage<entt::entity>().size();
+		if (auto* census = scene->getRegistry().ctx().find<engine::ecs::RegistryCensus>()) {
+			for (const auto& row : census->refresh()) {
+				snapshot.storages_.push_back({ row.name_, row.size_, row.capacity_, row.bytes_ });
+			}
+		}
+	}
+
+	scene_manager_->reportMemoryUsage();
+	snapshot.memory_.clear();
+	for (const auto& entry : engine::memory::MemoryTracker::instance().collect()) {
+		snapshot.memory_.push_back({ engine::memory::memoryTagName(entry.tag_), entry.totalBytes(), entry.budget_bytes_, entry.over_budget_ });
+	}
+
+	using Kind = engine::resource::TextureMemoryInfo::Kind;
+	snapshot.textures_.assign({ { "texture", 0, 0 }, { "atlas_page", 0, 0 }, { "atlas_mip", 0, 0 }, { "render_target", 0, 0 } });
+	for (const auto& info : resource_manager_->getTextureMemoryUsage()) {
+		const std::size_t slot = info.kind_ == Kind::ATLAS_PAGE ? 1 : info.kind_ == Kind::ATLAS_MIP ? 2 : info.kind_ == Kind::RENDER_TARGET ? 3 : 0;
+		++snapshot.textures_[slot].count_;
+		snapshot.textures_[slot].bytes_ += info.bytes_;
+	}
+	metrics_server_->publish(now);
+}
+
+/**
+ * @brief 窗口事件监视：模态循环中的重绘事件插入一帧。
+ * @details 监视回调可能在任意线程、任意时刻被调用；只有主线程正处在外层帧的事件泵入中
+ *          （场景与渲染器都不在使用中）时才插入，插入帧内的泵入不会再嵌套插入。
+ */
+bool engine::core::GameApp::onWindowEvent(void* userdata, SDL_Event* event)
+{
+	auto* app = static_cast<GameApp*>(userdata);
+	if (event->type != SDL_EVENT_WINDOW_EXPOSED || event->window.data1 != 1) {
+		return true;	// 只处理模态循环（live resize）发出的重绘
+	}
+	if (!SDL_IsMainThread() || !app->in_event_pump_ || app->in_live_frame_ || !app->is_running_) {
+		return true;
+	}
+	app->in_live_frame_ = true;
+	++app->live_frames_;
+	app->runFrame(true);
+	app->in_live_frame_ = false;
+	return true;
 }
 
 void engine::core::GameApp::setOnInitCallback(std::function<void(engine::core::Context&)> callback)
@@ -76,6 +334,19 @@ void engine::core::GameApp::setOnInitCallback(std::function<void(engine::core::C
     on_init_ = std::move(callback);
 }
 
+void engine::core::GameApp::setCaptureOptions(bool record_on_start, std::string output_dir)
+{
+	capture_on_start_ = record_on_start;
+	if (!output_dir.empty()) {
+		capture_dir_ = std::move(output_dir);
+	}
+}
+
+void engine::core::GameApp::setStartupProfiling(bool enabled)
+{
+	profile_startup_ = enabled;
+}
+
 void engine::core::GameApp::setRendererBackend(std::string backend)
 {
 	renderer_backend_override_ = std::move(backend);
@@ -87,30 +358,52 @@ void engine::core::GameApp::setRendererBackend(std::string backend)
  */
 bool engine::core::GameApp::init()
 {
-	if (initConfig() &&
-		initSDL() &&
-		initDispatcher() &&
-		initInputManager() &&
-		initTime() && 
-		initResourceManager()&&
-		initAudioPlayer()&&
-		initRenderer()&&
-		initGameState()&&
-		initTextRenderer()&&
-		initCamera()&&
-		initContext()&&
-        initSceneManager()&&
-		initImGui()) 
-	{
-      if (!waitForResourceMapping(true)) {
-			return false;
-		}
+	// 依赖图：配置解析、音频设备、ImGui 字体与资源映射解析在后台进行，与窗口和渲染器创建重叠
+	using engine::core::InitAffinity;
+	InitGraph graph;
+	graph.add("config", {}, InitAffinity::ANY, [this] { return initConfig(); });
+	graph.add("sdl", {}, InitAffinity::MAIN, [this] { return initSDL(); });
+	graph.add("window", { "sdl", "config" }, InitAffinity::MAIN, [this] { return initWindow(); });
+	graph.add("dispatcher", {}, InitAffinity::ANY, [this] { return initDispatcher(); });
+	graph.add("input_manager", { "window", "dispatcher", "config" }, InitAffinity::MAIN, [this] { return initInputManager(); });
+	graph.add("time", { "sdl" }, InitAffinity::ANY, [this] { return initTime(); });
+	// 工作线程数可能由首次启动的硬件分级决定（initWindow 中）
+	graph.add("job_system", { "config", "window" }, InitAffinity::ANY, [this] { return initJobSystem(); });
+	graph.add("task_pool", {}, InitAffinity::ANY, [this] { return initTaskPool(); });
+	graph.add("frame_arena", {}, InitAffinity::ANY, [this] { return initFrameArena(); });
+	graph.add("frame_budget", {}, InitAffinity::ANY, [this] { return initFrameBudget(); });
+	graph.add("content_cache", {}, InitAffinity::ANY, [this] { return initContentCache(); });
+	graph.add("resource_manager", { "window", "task_pool" }, InitAffinity::ANY, [this] { return initResourceManager(); });
+	graph.add("resource_mapping", { "resource_manager" }, InitAffinity::ANY, [this] { return initResourceMapping(); });
+	graph.add("audio_player", { "resource_manager", "config" }, InitAffinity::MAIN, [this] { return initAudioPlayer(); });
+	graph.add("renderer", { "window", "resource_manager", "job_system" }, InitAffinity::MAIN, [this] { return initRenderer(); });
+	graph.add("frame_capture", { "renderer", "task_pool" }, InitAffinity::MAIN, [this] { return initFrameCapture(); });
+	graph.add("game_state", { "window" }, InitAffinity::MAIN, [this] { return initGameState(); });
+	graph.add("text_renderer", { "window", "resource_manager", "renderer" }, InitAffinity::MAIN, [this] { return initTextRenderer(); });
+	graph.add("camera", { "game_state" }, InitAffinity::ANY, [this] { return initCamera(); });
+#if MONSTERWAR_DEBUG_TOOLS
+	graph.add("imgui_context", {}, InitAffinity::ANY, [this] { return initImGuiContext(); });
+	graph.add("imgui", { "imgui_context", "window" }, InitAffinity::MAIN, [this] { return initImGui(); });
+#endif
+	graph.add("context", { "renderer", "text_renderer", "dispatcher", "camera", "resource_manager", "input_manager",
+		"game_state", "job_system", "time", "frame_arena", "frame_budget", "content_cache", "task_pool" },
+		InitAffinity::MAIN, [this] { return initContext(); });
+	graph.add("scene_manager", { "context" }, InitAffinity::MAIN, [this] { return initSceneManager(); });
+	graph.add("preload", { "resource_mapping", "renderer" }, InitAffinity::MAIN, [this] { return preloadResources(); });
 
-		if (resource_manager_ && !resource_manager_->preloadMappedResources()) {
-			spdlog::error("主线程预加载资源失败。");
-			return false;
+	const bool ok = graph.run();
+	graph.logReport();
+	if (profile_startup_) {
+		auto& startup = engine::core::StartupProfiler::instance();
+		for (const auto& timing : graph.getTimings()) {
+			if (timing.ran_) {
+				startup.addPhase("init." + timing.name_, timing.end_ms_ - timing.start_ms_);
+			}
 		}
-
+		startup.addPhase("init.total", graph.getTotalMs());
+	}
+	if (ok)
+	{
 		spdlog::info("游戏应用程序初始化成功。");
 		
 		
@@ -118,8 +411,12 @@ bool engine::core::GameApp::init()
 		if (on_init_) {
 			on_init_(*context_);
 		}
-     hero_inspector_ui_ = std::make_unique<game::ui::HeroInspectorUI>();
+#if MONSTERWAR_DEBUG_TOOLS
+		initDebugTools();
+#endif
 		dispatcher_->sink<utils::QuitEvent>().connect<&GameApp::onQuitEvent>(this);
+		input_manager_->onAction(entt::hashed_string("screenshot").value()).connect<&GameApp::onScreenshot>(this);
+		input_manager_->onAction(entt::hashed_string("toggle_capture").value()).connect<&GameApp::onToggleCapture>(this);
 
 		// // 创建并推送第一个游戏场景，传入会话数据
 		// auto scene = std::make_unique<game::scene::TitleScene>(
@@ -134,11 +431,45 @@ bool engine::core::GameApp::init()
 	
 }
 
+bool engine::core::GameApp::waitWhileIdle()
+{
+	const bool halted = game_state_->isPaused() || game_state_->isGameOver();
+	const bool unfocused = (SDL_GetWindowFlags(window_) & SDL_WINDOW_INPUT_FOCUS) == 0;
+	const bool recent_input = SDL_GetTicksNS() - last_input_ns_ < IDLE_INPUT_GRACE_NS;
+	const bool idle = config_->idle_fps_ > 0 && (halted || unfocused) && !recent_input;
+	if (idle && !idle_) {
+		spdlog::debug("进入空闲节能（{}）", halted ? "模拟已停止" : "窗口失去焦点");
+	} else if (!idle && idle_) {
+		spdlog::debug("退出空闲节能");
+	}
+	idle_ = idle;
+	// 模拟停止后世界层不再变化，冻结为缓存；失去焦点但战斗仍在进行时只降帧
+	if (idle && halted) {
+		renderer_->freezeWorld();
+	} else {
+		renderer_->thawWorld();
+	}
+	if (!idle) {
+		return false;
+	}
+
+	int fps = config_->idle_fps_;
+	if (!halted && config_->simulation_hz_ > 0) {
+		// 帧率不能低到单帧补跑的步数追不上模拟频率，否则后台的战斗会变慢
+		fps = std::max(fps, (config_->simulation_hz_ + config_->max_simulation_steps_ - 1) / config_->max_simulation_steps_);
+	}
+	ENGINE_PROFILE_SCOPE("GameApp::idleWait");
+	// 事件到达时立即返回，事件本身留在队列中由 InputManager 取出
+	SDL_WaitEventTimeout(nullptr, std::max(1, 1000 / fps));
+	return true;
+}
+
 /**
  * @brief 处理 SDL 事件。
  */
 void engine::core::GameApp::handleEvents()
 {
+	ENGINE_PROFILE_SCOPE("GameApp::handleEvents");
 	input_manager_->Update();
 
 	// 修复：将输入事件分发给场景管理器
@@ -153,9 +484,29 @@ void engine::core::GameApp::handleEvents()
  */
 void engine::core::GameApp::update(float& delta_time)
 {
+	ENGINE_PROFILE_SCOPE("GameApp::update");
+	if (task_pool_) {
+		// 工作线程投递的续体（纹理上传等）在场景更新前执行，共用纹理上传预算
+		ENGINE_PROFILE_SCOPE("TaskPool::drainMainThread");
+		const auto budget = std::chrono::duration<float, std::micro>(config_->texture_upload_budget_ms_ * 1000.0f);
+		task_pool_->drainMainThread(std::chrono::duration_cast<std::chrono::microseconds>(budget));
+	}
+	if (resource_manager_) {
+		ENGINE_PROFILE_SCOPE("ResourceManager::update");
+		resource_manager_->update();
+	}
 	if (scene_manager_) {
 		scene_manager_->update(delta_time);
 	}
+	drainEvents(EventPhase::FRAME);
+}
+
+void engine::core::GameApp::drainEvents(EventPhase phase)
+{
+	ENGINE_PROFILE_SCOPE("Dispatcher::update");
+	if (phase == EventPhase::FRAME) {
+		engine::io::SaveService::instance().dispatchEvents(*dispatcher_);	// 写入线程的完成通知并入主线程事件流
+	}
 	dispatcher_->update();
 }
 
@@ -164,32 +515,79 @@ void engine::core::GameApp::update(float& delta_time)
  */
 void engine::core::GameApp::render()
 {
-	// 1. 清除屏幕
+	ENGINE_PROFILE_SCOPE("GameApp::render");
+	// 1. 清除屏幕；启用像素完美输出时世界层改画到低分辨率目标，由 Scene::render() 在 UI 之前放大
 	renderer_->clearScreen();
+	// 需要捕获的帧整帧画在暂存纹理上，ImGui 之前贴回窗口（调试界面不进入画面）
+	SDL_Texture* capture_target = nullptr;
+	if (frame_capture_) {
+		const glm::ivec2 size = renderer_->getLogicalTargetSize();
+		capture_target = frame_capture_->beginFrame(size.x, size.y);
+		if (capture_target) {
+			renderer_->setFrameTarget(capture_target);
+		}
+	}
+	renderer_->beginWorldPass();
 
-	if (imgui_initialized_) {
+#if MONSTERWAR_DEBUG_TOOLS
+	// 调试工具关闭时整帧跳过 ImGui（NewFrame、面板构建与 Render 都不执行）
+	auto* debug_scene = getDebugToolsScene();
+	const bool debug_visible = debug_tools_ && debug_tools_->isVisible(debug_scene);
+	input_manager_->setImGuiInputEnabled(debug_visible);
+	if (debug_visible) {
 		ImGui_ImplSDL3_NewFrame();
 		ImGui_ImplSDLRenderer3_NewFrame();
 		ImGui::NewFrame();
+	} else if (debug_tools_) {
+		debug_tools_->hide(scene_manager_ ? scene_manager_->getCurrentScene() : nullptr);
 	}
+#endif
 
 	// 2. 具体渲染代码
 	if (scene_manager_) {
+		ENGINE_PROFILE_SCOPE("SceneManager::render");
 		scene_manager_->render();
 	}
+	renderer_->endWorldPass();		// 场景未经过 Scene::render() 时在这里收尾（已结束时不做任何事）
+	if (capture_target) {
+		renderer_->setFrameTarget(nullptr);
+		renderer_->drawFullscreenTexture(capture_target);
+	}
 
-	renderImGui();
+#if MONSTERWAR_DEBUG_TOOLS
+	if (debug_visible) {
+		ENGINE_PROFILE_SCOPE("ImGui::build");
+		debug_tools_->render(*debug_scene);
+	}
+#endif
 
-	// UI 在渲染阶段 enqueue 的事件需要在本帧尽快派发，避免按钮操作延迟到下一帧才生效。
-	dispatcher_->update();
+	// UI 在渲染阶段 enqueue 的事件在本帧派发；玩家指令不依赖这一次派发（即时路径，见 event_phase.h）
+	drainEvents(EventPhase::UI);
 
-	if (imgui_initialized_) {
+#if MONSTERWAR_DEBUG_TOOLS
+	if (debug_visible) {
+		ENGINE_PROFILE_SCOPE("ImGui::render");
 		ImGui::Render();
+		renderer_->flush();		// ImGui 直接使用 SDL_Renderer，须画在已记录的 UI 之上
 		ImGui_ImplSDLRenderer3_RenderDrawData(ImGui::GetDrawData(), sdl_renderer_);
 	}
+#endif
 
 	// 3. 更新屏幕显示
-	renderer_->present();
+	{
+		ENGINE_PROFILE_SCOPE("Renderer::present");
+		const auto present_start = std::chrono::steady_clock::now();
+		renderer_->present();
+		present_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - present_start).count();
+	}
+	input_manager_->onFramePresented();
+	if (frame_capture_) {
+		frame_capture_->endFrame();		// 读回数帧之前的暂存纹理，此时其绘制早已完成
+	}
+
+	// 4. 回收帧内临时内存（本帧的 pmr 容器此后全部失效）
+	ENGINE_PROFILE_COUNTER("arena.bytes", static_cast<std::int64_t>(frame_arena_->getBytesUsed()));
+	frame_arena_->reset();
 }
 
 /**
@@ -198,15 +596,27 @@ void engine::core::GameApp::render()
 void engine::core::GameApp::close()
 {
 	dispatcher_->sink<engine::utils::QuitEvent>().disconnect<&GameApp::onQuitEvent>(this);
+	if (input_manager_) {
+		input_manager_->onAction(entt::hashed_string("screenshot").value()).disconnect<&GameApp::onScreenshot>(this);
+		input_manager_->onAction(entt::hashed_string("toggle_capture").value()).disconnect<&GameApp::onToggleCapture>(this);
+#if MONSTERWAR_DEBUG_TOOLS
+		input_manager_->onAction(entt::hashed_string("toggle_debug_tools").value()).disconnect<&GameApp::onToggleDebugTools>(this);
+#endif
+	}
 	spdlog::trace("关闭 GameApp ...");
-   if (resource_mapping_future_.valid()) {
-		try {
-			resource_mapping_future_.get();
-		} catch (const std::exception& e) {
-			spdlog::warn("资源映射异步任务结束异常: {}", e.what());
-		}
+#if MONSTERWAR_DEBUG_TOOLS
+	shutdownImGui();
+#endif
+	if (renderer_) {
+		renderer_->releaseWorldTarget();	// 纹理须在 SDL_Renderer 之前销毁
+		renderer_->releaseUnderlay();
+	}
+	if (frame_capture_) {
+		frame_capture_->release();		// 读回未完成的帧并等待编码，暂存纹理同样须先于 SDL_Renderer 销毁
+		frame_capture_.reset();
 	}
- shutdownImGui();
+	SDL_RemoveEventWatch(&GameApp::onWindowEvent, this);
+	metrics_server_.reset();	// 服务线程只读快照，先于场景与资源停止
 	if (sdl_renderer_ != nullptr) {
 		SDL_DestroyRenderer(sdl_renderer_);
 		sdl_renderer_ = nullptr;
@@ -217,6 +627,10 @@ void engine::core::GameApp::close()
 	}
 	engine::audio::AudioLocator::provide(nullptr);
 	scene_manager_->close();
+	engine::io::SaveService::instance().shutdown();	// 场景关闭时提交的存档写完再退出
+	if (task_pool_) {
+		task_pool_->shutdown();	// 续体捕获了资源管理器，先丢弃主线程队列再销毁
+	}
 
 	resource_manager_.reset();
 	
@@ -231,7 +645,11 @@ void engine::core::GameApp::close()
 bool engine::core::GameApp::initConfig()
 {
 	try{
-		config_ = std::make_unique<engine::core::Config>("assets/config.json");
+		config_ = std::make_unique<engine::core::Config>(CONFIG_PATH);
+		engine::memory::MemoryTracker::instance().setBudgets(config_->memory_budgets_mb_);
+		engine::memory::StorageArena::setConfiguredCapacity(static_cast<std::size_t>(config_->registry_arena_mb_) * 1024 * 1024);
+		// 资源管理器依赖 window -> config，打开音频设备时已是配置的格式
+		engine::resource::AudioManager::setDeviceSettings({ config_->audio_sample_rate_, config_->audio_buffer_frames_, config_->audio_channels_ });
 	}
 	catch (const std::exception& e)
 	{
@@ -242,7 +660,12 @@ bool engine::core::GameApp::initConfig()
 	return true;
 }
 
-bool engine::core::GameApp::initImGui()
+#if MONSTERWAR_DEBUG_TOOLS
+/**
+ * @brief 创建 ImGui 上下文并读取中文字体文件（不依赖窗口，可在后台线程执行）。
+ * @return 初始化成功返回 true，否则返回 false。
+ */
+bool engine::core::GameApp::initImGuiContext()
 {
 	try {
 		IMGUI_CHECKVERSION();
@@ -256,6 +679,22 @@ bool engine::core::GameApp::initImGui()
 		} else {
 			io.FontDefault = chinese_font;
 		}
+	}
+	catch (const std::exception& e) {
+		spdlog::error("创建 ImGui 上下文失败: {}", e.what());
+		return false;
+	}
+	spdlog::trace("ImGui 上下文创建成功。");
+	return true;
+}
+
+/**
+ * @brief 初始化 ImGui 的 SDL3 平台与渲染后端（需要窗口与渲染器，主线程执行）。
+ * @return 初始化成功返回 true，否则返回 false。
+ */
+bool engine::core::GameApp::initImGui()
+{
+	try {
 		if (!ImGui_ImplSDL3_InitForSDLRenderer(window_, sdl_renderer_) || !ImGui_ImplSDLRenderer3_Init(sdl_renderer_)) {
 			spdlog::error("初始化 ImGui 后端失败");
 			return false;
@@ -270,47 +709,74 @@ bool engine::core::GameApp::initImGui()
 	return true;
 }
 
-void engine::core::GameApp::renderImGui()
+void engine::core::GameApp::initDebugTools()
 {
-	if (!imgui_initialized_) {
-		return;
-	}
+	debug_tools_ = std::make_unique<engine::debug::DebugTools>();
+	debug_tools_->setEnabled(config_->debug_tools_visible_);
+	hero_inspector_ui_ = std::make_unique<game::ui::HeroInspectorUI>();
+	profiler_ui_ = std::make_unique<game::ui::ProfilerUI>();
 
-	auto* current_scene = scene_manager_ ? scene_manager_->getCurrentScene() : nullptr;
-   if (current_scene && current_scene->getSceneName() == "TitleScene") {
-		return;
+	using engine::scene::Scene;
+	debug_tools_->addPanel("战况", [this](Scene& scene) { renderStatsPanel(scene); }, true);
+	debug_tools_->addPanel("设置", [this](Scene& scene) { renderSettingsPanel(scene); }, true);
+	debug_tools_->addPanel("调试工具", [this](Scene& scene) { renderDebugActionsPanel(scene); }, true);
+	debug_tools_->addPanel("英雄信息", [this](Scene& scene) { hero_inspector_ui_->render(scene); }, true);
+	debug_tools_->addPanel("性能分析", [this](Scene& scene) { profiler_ui_->render(scene); }, true);
+	debug_tools_->addPanel("纹理显存", [this](Scene& scene) { renderTextureMemoryPanel(scene); });
+	debug_tools_->addPanel("内存", [this](Scene& scene) { renderMemoryPanel(scene); });
+	// 面板不绘制时断开存储信号，普查不在热路径上留下任何开销
+	debug_tools_->addPanel("组件普查", [this](Scene& scene) { renderCensusPanel(scene); }, false, [](Scene& scene) {
+		if (auto* census = scene.getRegistry().ctx().find<engine::ecs::RegistryCensus>()) {
+			census->setEnabled(false);
+		}
+	});
+	input_manager_->onAction(entt::hashed_string("toggle_debug_tools").value()).connect<&GameApp::onToggleDebugTools>(this);
+}
+
+engine::scene::Scene* engine::core::GameApp::getDebugToolsScene() const
+{
+	if (!imgui_initialized_ || !scene_manager_) {
+		return nullptr;
+	}
+	auto* current_scene = scene_manager_->getCurrentScene();
+	if (current_scene && current_scene->getSceneName() == "TitleScene") {
+		return nullptr;
 	}
+	return current_scene;
+}
 
- if (current_scene) {
-		auto& registry = current_scene->getRegistry();
-		if (registry.ctx().contains<game::data::GameStats&>()) {
-			auto& game_stats = registry.ctx().get<game::data::GameStats&>();
-			ImGui::SetNextWindowPos(ImVec2(12.0f, 12.0f), ImGuiCond_Always, ImVec2(0.0f, 0.0f));
-			ImGui::SetNextWindowBgAlpha(0.25f);
-			const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration |
-				ImGuiWindowFlags_AlwaysAutoResize |
-				ImGuiWindowFlags_NoSavedSettings |
-				ImGuiWindowFlags_NoMove |
-				ImGuiWindowFlags_NoFocusOnAppearing |
-				ImGuiWindowFlags_NoNav;
-			ImGui::Begin("战况", nullptr, flags);
-			ImGui::Text("场景：%s", current_scene->getSceneName().c_str());
-			ImGui::Text("金币：%.1f", game_stats.cost_);
-			ImGui::Text("基地生命：%d", game_stats.home_hp_);
-			ImGui::Text("敌人击杀：%d", game_stats.enemy_killed_count_);
-			ImGui::End();
-		}
+void engine::core::GameApp::renderStatsPanel(engine::scene::Scene& scene)
+{
+	auto& registry = scene.getRegistry();
+	if (!registry.ctx().contains<game::data::GameStats&>()) {
+		return;
 	}
+	auto& game_stats = registry.ctx().get<game::data::GameStats&>();
+	ImGui::SetNextWindowPos(ImVec2(12.0f, 12.0f), ImGuiCond_Always, ImVec2(0.0f, 0.0f));
+	ImGui::SetNextWindowBgAlpha(0.25f);
+	const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration |
+		ImGuiWindowFlags_AlwaysAutoResize |
+		ImGuiWindowFlags_NoSavedSettings |
+		ImGuiWindowFlags_NoMove |
+		ImGuiWindowFlags_NoFocusOnAppearing |
+		ImGuiWindowFlags_NoNav;
+	ImGui::Begin("战况", nullptr, flags);
+	ImGui::Text("场景：%s", scene.getSceneName().c_str());
+	ImGui::Text("金币：%.1f", game_stats.cost_);
+	ImGui::Text("基地生命：%d", game_stats.home_hp_);
+	ImGui::Text("敌人击杀：%d", game_stats.enemy_killed_count_);
+	ImGui::End();
+}
 
+void engine::core::GameApp::renderSettingsPanel(engine::scene::Scene& scene)
+{
 	ImGui::SetNextWindowPos(ImVec2(12.0f, 130.0f), ImGuiCond_Once);
 	ImGui::SetNextWindowBgAlpha(0.85f);
 	ImGui::Begin("设置", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
-    if (current_scene) {
-		auto& game_state = current_scene->getContext().getGameState();
-		if (ImGui::Button(game_state.isPaused() ? "继续" : "暂停")) {
-			game_state.setState(game_state.isPaused() ? engine::core::GameStateType::Playing
-													   : engine::core::GameStateType::Paused);
-		}
+	auto& game_state = scene.getContext().getGameState();
+	if (ImGui::Button(game_state.isPaused() ? "继续" : "暂停")) {
+		game_state.setState(game_state.isPaused() ? engine::core::GameStateType::Playing
+												   : engine::core::GameStateType::Paused);
 	}
 	if (time_) {
 		float scale_value = time_->getTimeScale();
@@ -328,6 +794,35 @@ void engine::core::GameApp::renderImGui()
 		if (ImGui::Button("2.0x")) {
 			time_->setTimeScale(2.0);
 		}
+
+		// 快进：每帧多跑几个固定步长的子步，步长不变
+		ImGui::TextUnformatted("快进");
+		for (const int factor : { 1, 2, 4, 8 }) {
+			ImGui::SameLine();
+			const std::string label = std::to_string(factor) + "x##fast_forward";
+			if (ImGui::RadioButton(label.c_str(), time_->getFastForward() == factor)) {
+				time_->setFastForward(factor);
+			}
+		}
+		if (time_->getEffectiveFastForward() < time_->getFastForward()) {
+			ImGui::Text("帧预算限制：实际 %dx", time_->getEffectiveFastForward());
+		}
+
+		const auto frame_stats = time_->getFrameStats();
+		if (frame_stats.sample_count_ > 0) {
+			ImGui::Separator();
+			ImGui::Text("帧时间：平均 %.2f ms (%.0f FPS)", frame_stats.average_ms_,
+				frame_stats.average_ms_ > 0.0f ? 1000.0f / frame_stats.average_ms_ : 0.0f);
+			ImGui::Text("1%% low：%.2f ms (%.0f FPS)  最大：%.2f ms", frame_stats.one_percent_low_ms_,
+				frame_stats.one_percent_low_ms_ > 0.0f ? 1000.0f / frame_stats.one_percent_low_ms_ : 0.0f,
+				frame_stats.max_ms_);
+			ImGui::Text("帧节奏：%s  休眠超时 %.0f us", time_->isVSyncPaced() ? "垂直同步" : "软件限帧",
+				frame_stats.sleep_overshoot_us_);
+			std::array<float, 240> history{};
+			const auto count = time_->copyFrameHistory(history.data(), history.size());
+			ImGui::PlotHistogram("##frame_times", history.data(), static_cast<int>(count), 0, nullptr,
+				0.0f, std::max(frame_stats.max_ms_, 1.0f), ImVec2(240.0f, 48.0f));
+		}
 	}
 	if (audio_player_) {
 		float master = audio_player_->getMasterVolume();
@@ -344,52 +839,258 @@ void engine::core::GameApp::renderImGui()
 		}
 	}
 	ImGui::End();
+}
 
-	if (current_scene) {
-		auto& dispatcher = current_scene->getContext().getDispatcher();
-		ImGui::SetNextWindowPos(ImVec2(12.0f, 350.0f), ImGuiCond_Once);
-		ImGui::SetNextWindowBgAlpha(0.85f);
-		ImGui::Begin("调试工具", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
-		if (ImGui::Button("重开关卡")) {
-			dispatcher.trigger(game::defs::RestartEvent{});
+void engine::core::GameApp::renderDebugActionsPanel(engine::scene::Scene& scene)
+{
+	auto& dispatcher = scene.getContext().getDispatcher();
+	ImGui::SetNextWindowPos(ImVec2(12.0f, 350.0f), ImGuiCond_Once);
+	ImGui::SetNextWindowBgAlpha(0.85f);
+	ImGui::Begin("调试工具", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+	if (ImGui::Button("重开关卡")) {
+		dispatcher.trigger(game::defs::RestartEvent{});
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("重试本波")) {
+		dispatcher.trigger(game::defs::RetryWaveEvent{});
+	}
+	if (const auto* checkpoints = scene.getRegistry().ctx().find<game::data::CheckpointInfo>()) {
+		rewind_wave_ = std::clamp(rewind_wave_, 0, checkpoints->last_wave_);
+		ImGui::SliderInt("##rewind_wave", &rewind_wave_, 0, checkpoints->last_wave_, "第 %d 波前");
+		ImGui::SameLine();
+		if (ImGui::Button("回退")) {
+			dispatcher.trigger(game::defs::RewindToWaveEvent{ rewind_wave_ });
 		}
-		if (ImGui::Button("回标题")) {
-			dispatcher.trigger(game::defs::BackToTitleEvent{});
+		ImGui::Text("检查点：%zu 实体 / %zu 组件，%.2f ms", checkpoints->entity_count_,
+			checkpoints->component_count_, checkpoints->capture_ms_);
+	}
+	if (ImGui::Button("回标题")) {
+		dispatcher.trigger(game::defs::BackToTitleEvent{});
+	}
+	if (ImGui::Button("保存")) {
+		dispatcher.trigger(game::defs::SaveEvent{});
+	}
+	if (ImGui::Button("通关")) {
+		dispatcher.trigger(game::defs::LevelClearEvent{});
+	}
+	if (scene.getRegistry().ctx().contains<game::data::GameStats&>()) {
+		auto& game_stats = scene.getRegistry().ctx().get<game::data::GameStats&>();
+		if (ImGui::Button("COST +10")) {
+			game_stats.cost_ += 10.0f;
 		}
-		if (ImGui::Button("保存")) {
-			dispatcher.trigger(game::defs::SaveEvent{});
+		ImGui::SameLine();
+		if (ImGui::Button("COST +100")) {
+			game_stats.cost_ += 100.0f;
 		}
-		if (ImGui::Button("通关")) {
-			dispatcher.trigger(game::defs::LevelClearEvent{});
+	}
+	if (const auto* lod_stats = scene.getRegistry().ctx().find<game::system::SimulationLodStats>()) {
+		ImGui::Text("低细节敌人：%zu / %zu（+%zu -%zu）", lod_stats->low_count_, lod_stats->enemy_count_,
+			lod_stats->demoted_, lod_stats->promoted_);
+	}
+	if (const auto* acquire_stats = scene.getRegistry().ctx().find<game::system::TargetAcquireStats>()) {
+		ImGui::Text("空闲索敌：%zu（唤醒 %zu，推迟 %zu，快照扫描 %zu）", acquire_stats->scanned_, acquire_stats->woken_,
+			acquire_stats->deferred_, acquire_stats->brute_force_);
+	}
+	if (const auto* sort_stats = scene.getRegistry().ctx().find<engine::system::RenderSortStats>()) {
+		ImGui::Text("渲染排序(%s)：%zu / %zu", sort_stats->incremental_ ? "增量" : "全量",
+			sort_stats->reorder_count_, sort_stats->entry_count_);
+		ImGui::Text("视口剔除：%zu", sort_stats->culled_count_);
+	}
+	if (renderer_) {
+		const auto& batch_stats = renderer_->getSpriteBatchStats();
+		ImGui::Text("精灵批次：%zu 次提交 / %zu 精灵", batch_stats.draw_call_count_, batch_stats.sprite_count_);
+	}
+	if (frame_budget_) {
+		const int level = frame_budget_->getLevel();
+		ImGui::Text("帧预算：%.2f / %.2f ms", frame_budget_->getSmoothedMs(), frame_budget_->getBudgetMs());
+		ImGui::Text("降级档位：%d / %d（%s）", level, engine::core::FrameBudget::MAX_LEVEL,
+			engine::core::FrameBudget::describe(level));
+	}
+	if (hitch_detector_ && hitch_detector_->isEnabled()) {
+		ImGui::Text("卡顿：%llu 次（已转储 %llu 次），阈值 %.2f ms，最近 %.2f ms",
+			static_cast<unsigned long long>(hitch_detector_->getHitchCount()),
+			static_cast<unsigned long long>(hitch_detector_->getDumpCount()),
+			hitch_detector_->getThresholdMs(), hitch_detector_->getLastHitchMs());
+	}
+	ImGui::End();
+}
+
+void engine::core::GameApp::renderTextureMemoryPanel(engine::scene::Scene&)
+{
+	if (!resource_manager_) {
+		return;
+	}
+	ImGui::SetNextWindowPos(ImVec2(460.0f, 450.0f), ImGuiCond_Once);
+	ImGui::SetNextWindowBgAlpha(0.85f);
+	if (!ImGui::Begin("纹理显存", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+		ImGui::End();
+		return;
+	}
+	// 只在面板打开时统计：逐张查询纹理属性，不值得每帧做
+	using Kind = engine::resource::TextureMemoryInfo::Kind;
+	const auto usage = resource_manager_->getTextureMemoryUsage();
+	std::size_t total = 0;
+	for (const auto& info : usage) {
+		total += info.bytes_;
+	}
+	ImGui::Text("共 %zu 张，约 %.1f MB", usage.size(), static_cast<double>(total) / (1024.0 * 1024.0));
+	constexpr std::size_t MAX_ROWS = 24;
+	if (ImGui::BeginTable("##texture_memory", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+		ImGui::TableSetupColumn("纹理");
+		ImGui::TableSetupColumn("尺寸");
+		ImGui::TableSetupColumn("格式");
+		ImGui::TableSetupColumn("KB");
+		ImGui::TableHeadersRow();
+		for (std::size_t i = 0; i < std::min(usage.size(), MAX_ROWS); ++i) {
+			const auto& info = usage[i];
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			if (info.kind_ == Kind::ATLAS_PAGE) {
+				ImGui::TextUnformatted("图集页");
+			} else if (info.kind_ == Kind::ATLAS_MIP) {
+				ImGui::TextUnformatted("图集缩小页");
+			} else {
+				ImGui::Text("%s%08x", info.kind_ == Kind::RENDER_TARGET ? "RT " : "",
+					static_cast<unsigned>(info.id_));
+			}
+			ImGui::TableNextColumn();
+			ImGui::Text("%dx%d", info.size_.x, info.size_.y);
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(info.format_name_.data(), info.format_name_.data() + info.format_name_.size());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.0f", static_cast<double>(info.bytes_) / 1024.0);
 		}
-		if (current_scene->getRegistry().ctx().contains<game::data::GameStats&>()) {
-			auto& game_stats = current_scene->getRegistry().ctx().get<game::data::GameStats&>();
-			if (ImGui::Button("COST +10")) {
-				game_stats.cost_ += 10.0f;
+		ImGui::EndTable();
+	}
+	ImGui::End();
+}
+
+void engine::core::GameApp::renderMemoryPanel(engine::scene::Scene&)
+{
+	if (!scene_manager_ || !resource_manager_) {
+		return;
+	}
+	ImGui::SetNextWindowPos(ImVec2(460.0f, 450.0f), ImGuiCond_Once);
+	ImGui::SetNextWindowBgAlpha(0.85f);
+	if (!ImGui::Begin("内存", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+		ImGui::End();
+		return;
+	}
+	// 上报部分需要遍历纹理与 UI 树，同样只在面板打开时刷新
+	scene_manager_->reportMemoryUsage();
+	const auto stats = engine::memory::MemoryTracker::instance().collect();
+	if (ImGui::BeginTable("##memory_tags", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+		ImGui::TableSetupColumn("标签");
+		ImGui::TableSetupColumn("合计 MB");
+		ImGui::TableSetupColumn("计数 MB");
+		ImGui::TableSetupColumn("上报 MB");
+		ImGui::TableSetupColumn("已回收 MB");
+		ImGui::TableSetupColumn("预算 MB");
+		ImGui::TableHeadersRow();
+		constexpr double MB = 1024.0 * 1024.0;
+		for (const auto& entry : stats) {
+			const auto name = engine::memory::memoryTagName(entry.tag_);
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(name.data(), name.data() + name.size());
+			ImGui::TableNextColumn();
+			if (entry.over_budget_) {
+				ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%.2f", static_cast<double>(entry.totalBytes()) / MB);
+			} else {
+				ImGui::Text("%.2f", static_cast<double>(entry.totalBytes()) / MB);
 			}
-			ImGui::SameLine();
-			if (ImGui::Button("COST +100")) {
-				game_stats.cost_ += 100.0f;
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", static_cast<double>(entry.tracked_bytes_) / MB);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", static_cast<double>(entry.reported_bytes_) / MB);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.2f", static_cast<double>(entry.reclaimed_bytes_) / MB);
+			ImGui::TableNextColumn();
+			if (entry.budget_bytes_ > 0) {
+				ImGui::Text("%.2f", static_cast<double>(entry.budget_bytes_) / MB);
+			} else {
+				ImGui::TextUnformatted("-");
 			}
 		}
-		ImGui::End();
+		ImGui::EndTable();
 	}
+	ImGui::End();
+}
 
-	if (current_scene && hero_inspector_ui_) {
-		hero_inspector_ui_->render(*current_scene);
+void engine::core::GameApp::renderCensusPanel(engine::scene::Scene& scene)
+{
+	auto* census = scene.getRegistry().ctx().find<engine::ecs::RegistryCensus>();
+	if (!census) {
+		return;
 	}
+	census->setEnabled(true);
+	ImGui::SetNextWindowPos(ImVec2(460.0f, 450.0f), ImGuiCond_Once);
+	ImGui::SetNextWindowBgAlpha(0.85f);
+	if (!ImGui::Begin("组件普查", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+		ImGui::End();
+		return;
+	}
+	const auto& storages = census->refresh();
+	ImGui::Text("%zu 个存储，约 %.1f KB", storages.size(), static_cast<double>(census->getTotalBytes()) / 1024.0);
+	if (ImGui::BeginTable("##census_archetypes", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+		for (const auto& archetype : census->getArchetypes()) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(archetype.label_.c_str());
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", archetype.count_);
+		}
+		ImGui::EndTable();
+	}
+	if (ImGui::BeginTable("##census_storages", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollY,
+		ImVec2(0.0f, 260.0f))) {
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("存储");
+		ImGui::TableSetupColumn("数量");
+		ImGui::TableSetupColumn("容量");
+		ImGui::TableSetupColumn("KB");
+		ImGui::TableSetupColumn("增/s");
+		ImGui::TableSetupColumn("删/s");
+		ImGui::TableHeadersRow();
+		for (const auto& row : storages) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(row.name_.data(), row.name_.data() + row.name_.size());
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", row.size_);
+			ImGui::TableNextColumn();
+			ImGui::Text("%zu", row.capacity_);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", static_cast<double>(row.bytes_) / 1024.0);
+			ImGui::TableNextColumn();
+			if (row.watched_) {
+				ImGui::Text("%.0f", row.emplace_per_second_);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.0f", row.remove_per_second_);
+			} else {
+				ImGui::TextUnformatted("-");
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted("-");
+			}
+		}
+		ImGui::EndTable();
+	}
+	ImGui::End();
 }
 
 void engine::core::GameApp::shutdownImGui()
 {
-	if (!imgui_initialized_) {
-		return;
+	if (imgui_initialized_) {
+		ImGui_ImplSDLRenderer3_Shutdown();
+		ImGui_ImplSDL3_Shutdown();
+		imgui_initialized_ = false;
+	}
+	// 后端初始化失败时上下文可能已由 initImGuiContext 创建
+	if (ImGui::GetCurrentContext()) {
+		ImGui::DestroyContext();
 	}
-	ImGui_ImplSDLRenderer3_Shutdown();
-	ImGui_ImplSDL3_Shutdown();
-	ImGui::DestroyContext();
-	imgui_initialized_ = false;
 }
+#endif
 
 /**
  * @brief 初始化 SDL 系统。
@@ -402,19 +1103,45 @@ bool engine::core::GameApp::initSDL()
 		spdlog::error("SDL 初始化失败! SDL错误: {}", SDL_GetError());
 		return false;
 	}
+	return true;
+}
 
+/**
+ * @brief 创建窗口与渲染器（依赖 SDL 与配置）。
+ * @return 初始化成功返回 true，否则返回 false。
+ */
+bool engine::core::GameApp::initWindow()
+{
 	window_ = SDL_CreateWindow(config_->window_title_.c_str(), static_cast<int>(config_->window_width_ * config_->window_scale_), static_cast<int>(config_->window_height_ * config_->window_scale_), SDL_WINDOW_RESIZABLE);
 	if (window_ == nullptr) {
 		spdlog::error("无法创建窗口! SDL错误: {}", SDL_GetError());
 		return false;
 	}
+	if (!createSdlRenderer() || !applyHardwareTier()) {
+		return false;
+	}
+	int vsync_mode = config_->vsync_enabled_ ? SDL_RENDERER_VSYNC_ADAPTIVE : SDL_RENDERER_VSYNC_DISABLED;
+	SDL_SetRenderVSync(sdl_renderer_, vsync_mode);
+	
+	// 像素风输出：逻辑画面按整数倍放大，多余部分留黑边，像素不会被拉成不等宽
+	const auto presentation = config_->pixel_perfect_ ? SDL_LOGICAL_PRESENTATION_INTEGER_SCALE : SDL_LOGICAL_PRESENTATION_LETTERBOX;
+	SDL_SetRenderLogicalPresentation(sdl_renderer_, static_cast<int>(config_->window_width_ * config_->logical_scale_), static_cast<int>(config_->window_height_ * config_->logical_scale_), presentation);
+	is_running_ = true;
+	return true;
+}
 
-   const std::string backend = !renderer_backend_override_.empty() ? renderer_backend_override_ : config_->renderer_backend_;
+bool engine::core::GameApp::createSdlRenderer()
+{
+	const std::string backend = !renderer_backend_override_.empty() ? renderer_backend_override_ : config_->renderer_backend_;
 	const char* renderer_driver = nullptr;
 	if (backend == "opengl") {
 		renderer_driver = "opengl";
 	} else if (backend == "vulkan") {
 		renderer_driver = "vulkan";
+	} else if (backend == "gpu") {
+		// SDL_GPU 之上的 SDL_Renderer 实现：精灵批次、文字、UI 与 ImGui 录入同一个命令缓冲，
+		// 顶点每帧经传输缓冲一次性上传
+		renderer_driver = "gpu";
 	} else if (backend == "sdl" || backend == "default" || backend.empty()) {
 		renderer_driver = nullptr;
 	} else {
@@ -431,14 +1158,39 @@ bool engine::core::GameApp::initSDL()
 		spdlog::error("无法创建渲染器! SDL错误: {}", SDL_GetError());
 		return false;
 	}
-	int vsync_mode = config_->vsync_enabled_ ? SDL_RENDERER_VSYNC_ADAPTIVE : SDL_RENDERER_VSYNC_DISABLED;
-	SDL_SetRenderVSync(sdl_renderer_, vsync_mode);
-	
-	SDL_SetRenderLogicalPresentation(sdl_renderer_, static_cast<int>(config_->window_width_ * config_->logical_scale_), static_cast<int>(config_->window_height_ * config_->logical_scale_), SDL_LOGICAL_PRESENTATION_LETTERBOX);
-	is_running_ = true;
 	return true;
 }
 
+bool engine::core::GameApp::applyHardwareTier()
+{
+	const std::string& requested = config_->performance_tier_;
+	const bool probe_tier = requested == "auto";
+	auto tier = parseHardwareTier(requested);
+	if (!probe_tier && !tier) {
+		spdlog::warn("未知性能分级 '{}'（应为 auto、low、medium 或 high），保持现有设置。", requested);
+		return true;
+	}
+	// 已分级：auto 只在首次启动探测；显式档位与已应用的一致时不再改写
+	if (probe_tier ? !config_->applied_tier_.empty() : config_->applied_tier_ == requested) {
+		return true;
+	}
+	const auto probe = probeHardware(sdl_renderer_, probe_tier);
+	if (probe_tier) {
+		tier = chooseTier(probe);
+	}
+	const std::string previous_backend = config_->renderer_backend_;
+	config_->applyTier(tierSettings(*tier, probe), hardwareTierName(*tier));
+	if (!config_->saveToFile(CONFIG_PATH)) {
+		spdlog::warn("性能分级结果未能写入 '{}'，下次启动将重新探测。", CONFIG_PATH);
+	}
+	if (!renderer_backend_override_.empty() || config_->renderer_backend_ == previous_backend) {
+		return true;
+	}
+	SDL_DestroyRenderer(sdl_renderer_);
+	sdl_renderer_ = nullptr;
+	return createSdlRenderer();
+}
+
 /**
  * @brief 初始化时间系统。
  * @return 初始化成功返回 true，否则返回 false。
@@ -456,16 +1208,102 @@ bool engine::core::GameApp::initTime()
 	return true;
 }
 
+/**
+ * @brief 初始化任务系统。
+ * @return 初始化成功返回 true，否则返回 false。
+ */
+bool engine::core::GameApp::initJobSystem()
+{
+	try {
+		const auto worker_count = config_->worker_threads_ < 0
+			? JobSystem::defaultWorkerCount()
+			: static_cast<std::size_t>(config_->worker_threads_);
+		job_system_ = std::make_unique<JobSystem>(worker_count);
+	}
+	catch (const std::exception& e) {
+		spdlog::error("初始化任务系统失败: {}", e.what());
+		return false;
+	}
+	spdlog::trace("任务系统初始化成功。");
+	return true;
+}
+
+/**
+ * @brief 初始化异步任务线程池。
+ * @return 初始化成功返回 true，否则返回 false。
+ */
+bool engine::core::GameApp::initTaskPool()
+{
+	try {
+		task_pool_ = std::make_unique<TaskPool>();
+	}
+	catch (const std::exception& e) {
+		spdlog::error("初始化任务线程池失败: {}", e.what());
+		return false;
+	}
+	spdlog::trace("任务线程池初始化成功。");
+	return true;
+}
+
+/**
+ * @brief 初始化帧内临时内存分配器。
+ * @return 初始化成功返回 true，否则返回 false。
+ */
+bool engine::core::GameApp::initFrameArena()
+{
+	try {
+		frame_arena_ = std::make_unique<engine::memory::FrameArena>();
+	}
+	catch (const std::exception& e) {
+		spdlog::error("初始化帧内存分配器失败: {}", e.what());
+		return false;
+	}
+	spdlog::trace("帧内存分配器初始化成功。");
+	return true;
+}
+
+/**
+ * @brief 初始化帧时间预算控制器与卡顿检测。
+ * @return 初始化成功返回 true，否则返回 false。
+ */
+bool engine::core::GameApp::initFrameBudget()
+{
+	try {
+		frame_budget_ = std::make_unique<engine::core::FrameBudget>();
+		hitch_detector_ = std::make_unique<engine::core::HitchDetector>();
+	}
+	catch (const std::exception& e) {
+		spdlog::error("初始化帧时间预算失败: {}", e.what());
+		return false;
+	}
+	spdlog::trace("帧时间预算初始化成功。");
+	return true;
+}
+
+/**
+ * @brief 初始化已解析内容缓存。
+ * @return 初始化成功返回 true，否则返回 false。
+ */
+bool engine::core::GameApp::initContentCache()
+{
+	try {
+		content_cache_ = std::make_unique<engine::core::ContentCache>();
+	}
+	catch (const std::exception& e) {
+		spdlog::error("初始化内容缓存失败: {}", e.what());
+		return false;
+	}
+	spdlog::trace("内容缓存初始化成功。");
+	return true;
+}
+
 /**
  * @brief 初始化资源管理器。
  * @return 初始化成功返回 true，否则返回 false。
  */
 bool engine::core::GameApp::initResourceManager() {
 	try {
-		resource_manager_ = std::make_unique<engine::resource::ResourceManager>(sdl_renderer_);
-     resource_mapping_future_ = std::async(std::launch::async, [this]() -> bool {
-			return resource_manager_->loadResources("assets/data/resource_mapping.json", false) ? true : false;
-		});
+		resource_manager_ = std::make_unique<engine::resource::ResourceManager>(sdl_renderer_, *task_pool_);
 	}
 	catch (const std::exception& e) {
 		spdlog::error("初始化资源管理器失败: {}", e.what());
@@ -483,6 +1321,8 @@ bool engine::core::GameApp::initRenderer()
 {
 	try {
 		renderer_ = std::make_unique<engine::render::Renderer>(sdl_renderer_, resource_manager_.get());
+		renderer_->setJobSystem(job_system_.get());
+		renderer_->setWorldTargetEnabled(config_->pixel_perfect_);
 	}
 	catch (const std::exception& e) {
 		spdlog::error("初始化渲染器失败: {}", e.what());
@@ -492,6 +1332,16 @@ bool engine::core::GameApp::initRenderer()
 	return true;
 }
 
+bool engine::core::GameApp::initFrameCapture()
+{
+	frame_capture_ = std::make_unique<engine::render::FrameCapture>(sdl_renderer_, task_pool_.get(), capture_dir_);
+	if (capture_on_start_) {
+		frame_capture_->setRecording(true);
+	}
+	spdlog::trace("帧捕获初始化成功（输出目录 {}）。", capture_dir_);
+	return true;
+}
+
 /**
  * @brief 初始化文本渲染器。
  * @return 初始化成功返回 true，否则返回 false。
@@ -500,6 +1350,7 @@ bool engine::core::GameApp::initTextRenderer()
 {
 	try {
 		text_renderer_ = std::make_unique<engine::render::TextRenderer>(sdl_renderer_, resource_manager_.get());
+		text_renderer_->setBeforeSubmit([renderer = renderer_.get()] { renderer->flush(); });
 	}
 	catch (const std::exception& e) {
 		spdlog::error("初始化文本渲染器失败: {}", e.what());
@@ -543,19 +1394,36 @@ bool engine::core::GameApp::initInputManager()
 	return true;
 }
 
-bool engine::core::GameApp::waitForResourceMapping(bool log_as_error)
+/**
+ * @brief 解析资源映射文件（只登记路径，不加载资源）。
+ * @return 解析成功返回 true，否则返回 false。
+ */
+bool engine::core::GameApp::initResourceMapping()
 {
-    return engine::utils::consumeFuture(
-		resource_mapping_future_,
-		[](bool result) { return result; },
-		[log_as_error](const std::exception& e) {
-			if (log_as_error) {
-				spdlog::error("等待资源映射异步任务失败: {}", e.what());
-			} else {
-				spdlog::warn("资源映射异步任务结束异常: {}", e.what());
-			}
-			return false;
-		});
+	if (!resource_manager_->loadResources("assets/data/resource_mapping.json", false)) {
+		spdlog::error("加载资源映射失败。");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief 提交映射资源与图集的后台预加载，之后开启纹理流式加载。
+ * @details 启动分层：初始化只等待首帧必需的部分（窗口、渲染器、资源映射解析），图集解码在工作线程进行、
+ *          解码完成后由 ResourceManager::update() 逐帧检查并打包上传；标题界面按 isMappedPreloadComplete() 放开开始按钮。
+ *          期间绘制的纹理按流式模式显示占位纹理，图集就绪后改用图集区域。
+ * @return 成功返回 true，否则返回 false。
+ */
+bool engine::core::GameApp::preloadResources()
+{
+	if (!resource_manager_->preloadMappedResources(true)) {
+		spdlog::error("主线程预加载资源失败。");
+		return false;
+	}
+	// 之后的缓存未命中都走后台解码 + 占位纹理，不再在绘制途中同步读盘
+	resource_manager_->setTextureStreaming(true);
+	resource_manager_->setTextureVramBudget(static_cast<std::size_t>(config_->texture_vram_budget_mb_ * 1024.0f * 1024.0f));
+	return true;
 }
 
 /**
@@ -572,7 +1440,13 @@ bool engine::core::GameApp::initContext()
 			*camera_,
 			*resource_manager_,
 			*input_manager_,
-			*game_state_);
+			*game_state_,
+			*job_system_,
+			*time_,
+			*frame_arena_,
+			*frame_budget_,
+			*content_cache_,
+			*task_pool_);
 	}
 	catch (const std::exception& e) {
 		spdlog::error("初始化上下文失败: {}", e.what());
@@ -607,7 +1481,7 @@ bool engine::core::GameApp::initAudioPlayer()
 bool engine::core::GameApp::initGameState()
 {
     try {
-		game_state_ = std::make_unique<engine::core::GameState>(renderer_->getSDLRenderer(), window_, engine::core::GameStateType::Title);
+		game_state_ = std::make_unique<engine::core::GameState>(sdl_renderer_, window_, engine::core::GameStateType::Title);
 	}
 	catch (const std::exception& e) {
 		spdlog::error("初始化游戏状态失败: {}", e.what());
@@ -628,6 +1502,31 @@ bool engine::core::GameApp::initDispatcher()
 	return true;
 }
 
+bool engine::core::GameApp::onScreenshot()
+{
+	if (frame_capture_) {
+		frame_capture_->requestScreenshot();
+	}
+	return true;
+}
+
+bool engine::core::GameApp::onToggleCapture()
+{
+	if (frame_capture_) {
+		frame_capture_->setRecording(!frame_capture_->isRecording());
+	}
+	return true;
+}
+
+#if MONSTERWAR_DEBUG_TOOLS
+bool engine::core::GameApp::onToggleDebugTools()
+{
+	debug_tools_->toggle();
+	spdlog::info("调试工具已{}", debug_tools_->isEnabled() ? "显示" : "隐藏");
+	return true;
+}
+#endif
+
 void engine::core::GameApp::onQuitEvent()
 {
 	is_running_ = false;
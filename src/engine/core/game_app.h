@@ -4,19 +4,24 @@
  * @brief 定义 GameApp 类，游戏应用的核心类，负责初始化、运行和管理游戏循环。
  */
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <functional>
-#include <future>
 #include <string>
+#include <vector>
 #include <entt/signal/dispatcher.hpp>
+#include "event_phase.h"
 // Forward declarations in global namespace
 struct SDL_Renderer;
 struct SDL_Window;
+union SDL_Event;
 
 namespace engine::resource {
     class ResourceManager;
 }
 namespace engine::render {
+    class FrameCapture;
     class Renderer;
     class TextRenderer;
     class Camera;
@@ -27,20 +32,34 @@ namespace engine::input {
 namespace engine::scene
 {
     class SceneManager;
+    class Scene;
 }
 
 namespace engine::audio
 {
     class IAudioPlayer;
 }
+namespace engine::memory {
+    class FrameArena;
+}
+namespace engine::debug {
+    class DebugTools;
+}
 namespace game::ui {
     class HeroInspectorUI;
+    class ProfilerUI;
 }
 namespace engine::core {
     class Time;
     class Config;
     class Context;
     class GameState;
+    class JobSystem;
+    class FrameBudget;
+    class HitchDetector;
+    class ContentCache;
+    class TaskPool;
+    class MetricsServer;
 
     /**
      * @class GameApp
@@ -64,6 +83,35 @@ namespace engine::core {
 
         /// 时间管理器
         std::unique_ptr<engine::core::Time> time_;
+        /// 任务系统（工作线程池），需晚于场景销毁
+        std::unique_ptr<engine::core::JobSystem> job_system_;
+        /// 异步任务线程池（加载与解码）及主线程任务队列，需晚于资源管理器销毁
+        std::unique_ptr<engine::core::TaskPool> task_pool_;
+        /// 帧内临时内存，每帧渲染结束后整体回收
+        std::unique_ptr<engine::memory::FrameArena> frame_arena_;
+        /// 帧时间预算，超预算时逐级降低可选工作
+        std::unique_ptr<engine::core::FrameBudget> frame_budget_;
+        std::unique_ptr<engine::core::HitchDetector> hitch_detector_;     ///< 卡顿检测（帧尾判定，超阈值时写诊断日志）
+        /// 已解析内容缓存（蓝图、tileset），跨场景重载共享
+        std::unique_ptr<engine::core::ContentCache> content_cache_;
+        /// 本机性能指标端点（performance.metrics_port 大于 0 时创建）
+        std::unique_ptr<engine::core::MetricsServer> metrics_server_;
+        /// 指标采样复用的帧时长数组
+        std::vector<double> metrics_frame_ms_;
+        /// 本帧 present 耗时（毫秒），从预算统计中扣除（垂直同步时 present 会阻塞等待）
+        double present_ms_{0.0};
+        /// 空闲节能：当前是否处于空闲（暂停、游戏结束或失去焦点，且近期没有输入）
+        bool idle_{false};
+        /// 最近一次有用户输入的帧结束时刻（SDL_GetTicksNS），之后 IDLE_INPUT_GRACE_NS 内保持全速
+        std::uint64_t last_input_ns_{0};
+        /// 输入后保持全速的时长：菜单交互期间不降帧，世界层也照常绘制（选中、范围显示等可能改变画面）
+        static constexpr std::uint64_t IDLE_INPUT_GRACE_NS = 500'000'000;
+        /// 主线程正在泵入系统事件（拖动、缩放窗口时系统的模态循环就嵌在这次泵入里）
+        bool in_event_pump_{false};
+        /// 正在执行模态循环中插入的帧，不再嵌套
+        bool in_live_frame_{false};
+        /// 本次模态循环中已插入的帧数（结束时输出日志）
+        int live_frames_{0};
         /// 资源管理器
         std::unique_ptr<engine::resource::ResourceManager> resource_manager_;
         /// 渲染器
@@ -84,14 +132,30 @@ namespace engine::core {
         std::unique_ptr<engine::audio::IAudioPlayer> audio_player_;
         /// 游戏状态
         std::unique_ptr<GameState> game_state_;
-        /// 资源映射异步加载任务
-        std::future<bool> resource_mapping_future_;
         /// 渲染后端覆盖值，空字符串表示使用配置文件
         std::string renderer_backend_override_;
+        /// 截图与录帧（暂存纹理环 + 后台 PNG 编码）
+        std::unique_ptr<engine::render::FrameCapture> frame_capture_;
+        /// 捕获输出目录
+        std::string capture_dir_{"captures"};
+        /// 启动后立即开始录制（--capture）
+        bool capture_on_start_{false};
+        /// 启动剖析（--profile-startup）：记录各初始化步骤，本关首帧呈现且图集就绪后结束 run()
+        bool profile_startup_{false};
+        /// 启动剖析时本关首帧之后最多再等待图集的帧数
+        static constexpr int PROFILE_STARTUP_MAX_WAIT_FRAMES = 600;
+#if MONSTERWAR_DEBUG_TOOLS
         /// ImGui 是否已初始化
         bool imgui_initialized_{false};
+        /// 调试面板「回退」选择的检查点波次
+        int rewind_wave_{0};
+        /// 调试工具宿主（关闭时整帧跳过 ImGui）
+        std::unique_ptr<engine::debug::DebugTools> debug_tools_;
         /// 英雄信息面板
         std::unique_ptr<game::ui::HeroInspectorUI> hero_inspector_ui_;
+        /// 性能分析面板
+        std::unique_ptr<game::ui::ProfilerUI> profiler_ui_;
+#endif
         /// 初始化回调函数
         std::function<void(engine::core::Context&)> on_init_;
 
@@ -123,14 +187,54 @@ namespace engine::core {
          */
         void setOnInitCallback(std::function<void(engine::core::Context&)> callback);
         void setRendererBackend(std::string backend);
+
+        /**
+         * @brief 设置帧捕获选项（需在 run() 之前调用）。
+         * @param record_on_start 启动后立即开始录制。
+         * @param output_dir 输出目录，空字符串表示默认的 captures/。
+         */
+        void setCaptureOptions(bool record_on_start, std::string output_dir);
+
+        /**
+         * @brief 启动剖析模式（需在 run() 之前调用）。
+         * @details 初始化步骤耗时记入 StartupProfiler；初始场景完成初始化、其首帧呈现且映射资源预加载完成后 run() 返回。
+         */
+        void setStartupProfiling(bool enabled);
         
     private:
         /**
          * @brief 初始化所有游戏系统。
+         * @details 各步骤按依赖图（InitGraph）执行：无需主线程的步骤在后台并行，结束后输出启动耗时报告。
          * @return bool 初始化成功返回 true，否则返回 false。
          */
         [[nodiscard]] bool init();
         
+        /**
+         * @brief 空闲节能：判定本帧是否空闲；空闲时以 SDL_WaitEventTimeout 等待事件（最长一个空闲帧间隔），
+         *        模拟已停止（暂停、游戏结束）时冻结世界层，只合成其上的 UI 与菜单。
+         * @return bool 本帧是否为空闲帧。
+         */
+        [[nodiscard]] bool waitWhileIdle();
+
+        /**
+         * @brief 执行一帧：事件、计时、固定步长模拟、更新、渲染与帧尾统计。
+         * @param live 由窗口模态循环中的重绘事件插入的帧：不再泵入事件（外层帧正在泵入），
+         *             也不记入性能分析、帧预算与卡顿检测（外层帧尚未结束）。
+         */
+        void runFrame(bool live);
+
+        /**
+         * @brief SDL 事件监视回调：Windows 上拖动或缩放窗口时，主线程停在系统的模态循环里，
+         *        SDL 在其中定时发送 data1 为 1 的 SDL_EVENT_WINDOW_EXPOSED，此时直接插入一帧，
+         *        模拟与画面不随窗口操作冻结，结束后也不会带着一个巨大的 dt 补跑。
+         */
+        static bool onWindowEvent(void* userdata, SDL_Event* event);
+
+        /**
+         * @brief 填写并发布一份指标快照（指标端点启用时每 MetricsServer::SAMPLE_INTERVAL 一次，在帧尾调用）
+         */
+        void sampleMetrics(std::chrono::steady_clock::time_point now);
+
         /**
          * @brief 处理 SDL 事件。
          */
@@ -146,6 +250,9 @@ namespace engine::core {
          * @brief 渲染游戏画面。
          */
         void render();
+
+        /// @brief 派发 dispatcher 队列中的事件；FRAME 与 UI 阶段每帧各调用一次（见 event_phase.h）
+        void drainEvents(EventPhase phase);
         
         /**
          * @brief 关闭游戏，清理资源。
@@ -159,28 +266,89 @@ namespace engine::core {
         [[nodiscard]] bool initConfig();
         
         /**
-         * @brief 初始化 SDL 系统。
+         * @brief 初始化 SDL 系统（视频与音频子系统）。
          * @return bool 初始化成功返回 true，否则返回 false。
          */
         [[nodiscard]] bool initSDL();
+
+        /**
+         * @brief 创建窗口与渲染器。
+         * @return bool 初始化成功返回 true，否则返回 false。
+         */
+        [[nodiscard]] bool initWindow();
+        /// @brief 按配置（或命令行覆盖）的后端创建 SDL 渲染器，失败时回退到默认后端
+        [[nodiscard]] bool createSdlRenderer();
+        /**
+         * @brief 首次启动（或 performance.tier 改变后）探测硬件并把档位写入配置；档位换了后端时重建渲染器
+         * @return 重建渲染器失败时返回 false
+         */
+        [[nodiscard]] bool applyHardwareTier();
         
         /**
          * @brief 初始化时间系统。
          * @return bool 初始化成功返回 true，否则返回 false。
          */
         [[nodiscard]] bool initTime();
+
+        /**
+         * @brief 初始化任务系统（工作线程数来自配置）。
+         * @return bool 初始化成功返回 true，否则返回 false。
+         */
+        [[nodiscard]] bool initJobSystem();
+
+        /**
+         * @brief 初始化异步任务线程池。
+         * @return bool 初始化成功返回 true，否则返回 false。
+         */
+        [[nodiscard]] bool initTaskPool();
+
+        /**
+         * @brief 初始化帧内临时内存分配器。
+         * @return bool 初始化成功返回 true，否则返回 false。
+         */
+        [[nodiscard]] bool initFrameArena();
+
+        /**
+         * @brief 初始化帧时间预算控制器。
+         * @return bool 初始化成功返回 true，否则返回 false。
+         */
+        [[nodiscard]] bool initFrameBudget();
+
+        /**
+         * @brief 初始化已解析内容缓存。
+         * @return bool 初始化成功返回 true，否则返回 false。
+         */
+        [[nodiscard]] bool initContentCache();
         
         /**
          * @brief 初始化资源管理器。
          * @return bool 初始化成功返回 true，否则返回 false。
          */
         [[nodiscard]] bool initResourceManager();
+
+        /**
+         * @brief 解析资源映射文件（可在后台线程执行）。
+         * @return bool 解析成功返回 true，否则返回 false。
+         */
+        [[nodiscard]] bool initResourceMapping();
+
+        /**
+         * @brief 构建图集、提交映射资源的后台预加载并开启纹理流式加载。
+         * @return bool 成功返回 true，否则返回 false。
+         */
+        [[nodiscard]] bool preloadResources();
         
         /**
          * @brief 初始化渲染器。
          * @return bool 初始化成功返回 true，否则返回 false。
          */
         [[nodiscard]] bool initRenderer();
+
+        /**
+         * @brief 初始化帧捕获（截图 / 录帧热键来自输入映射 screenshot、toggle_capture）。
+         * @return bool 初始化成功返回 true，否则返回 false。
+         */
+        [[nodiscard]] bool initFrameCapture();
         
         /**
          * @brief 初始化文本渲染器。
@@ -211,10 +379,23 @@ namespace engine::core {
          * @return bool 初始化成功返回 true，否则返回 false。
          */
         [[nodiscard]] bool initSceneManager();
+#if MONSTERWAR_DEBUG_TOOLS
+        [[nodiscard]] bool initImGuiContext();
         [[nodiscard]] bool initImGui();
-        [[nodiscard]] bool waitForResourceMapping(bool log_as_error);
-        void renderImGui();
         void shutdownImGui();
+
+        /// @brief 创建调试工具宿主并注册全部调试面板（on_init_ 之后调用）
+        void initDebugTools();
+        /// @brief 当前场景可以显示调试界面时返回它（标题场景不显示）
+        [[nodiscard]] engine::scene::Scene* getDebugToolsScene() const;
+        void renderStatsPanel(engine::scene::Scene& scene);
+        void renderSettingsPanel(engine::scene::Scene& scene);
+        void renderDebugActionsPanel(engine::scene::Scene& scene);
+        void renderTextureMemoryPanel(engine::scene::Scene& scene);
+        void renderMemoryPanel(engine::scene::Scene& scene);
+        void renderCensusPanel(engine::scene::Scene& scene);
+        bool onToggleDebugTools();
+#endif
         
         /**
          * @brief 初始化物理引擎。
@@ -239,5 +420,7 @@ namespace engine::core {
         [[nodiscard]] bool initDispatcher();
 
         void onQuitEvent();
+        bool onScreenshot();
+        bool onToggleCapture();
     };
 }
\ No newline at end of file
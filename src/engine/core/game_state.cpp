@@ -127,6 +127,9 @@ void engine::core::GameState::setWindowLogicalSize(glm::vec2 size)
 {
     int width = static_cast<int>(size.x);
     int height = static_cast<int>(size.y);
-    SDL_SetRenderLogicalPresentation(renderer_, width, height, SDL_LOGICAL_PRESENTATION_LETTERBOX);
+    // 保留当前的呈现模式（信箱或整数倍缩放）
+    SDL_RendererLogicalPresentation mode = SDL_LOGICAL_PRESENTATION_LETTERBOX;
+    SDL_GetRenderLogicalPresentation(renderer_, nullptr, nullptr, &mode);
+    SDL_SetRenderLogicalPresentation(renderer_, width, height, mode);
     spdlog::info("Window logical size set to: {}x{}", width, height);
 }
@@ -0,0 +1,156 @@
+#include "hardware_tier.h"
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+namespace {
+
+constexpr int BENCH_TARGET_SIZE = 512;
+constexpr int BENCH_SPRITE_SIZE = 32;
+
+/// @brief 显存估计：能建 16K 纹理的按独立显卡计（系统内存的一半，至多 8 GB），否则按共享内存的八分之一
+int estimateVramMb(const HardwareProbe& probe) {
+    if (probe.software_renderer_ || probe.max_texture_size_ == 0) {
+        return 0;
+    }
+    if (probe.max_texture_size_ >= 16384) {
+        return std::min(probe.system_ram_mb_ / 2, 8192);
+    }
+    return std::min(probe.system_ram_mb_ / 8, 1024);
+}
+
+/**
+ * @brief 在离屏目标上绘制 BENCH_SPRITES 个半透明精灵，读回一个像素等待完成
+ * @return BENCH_PASSES 次中的最短耗时（毫秒），无法创建目标时返回 0
+ */
+double runSpriteBenchmark(SDL_Renderer* renderer) {
+    SDL_Texture* target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, BENCH_TARGET_SIZE, BENCH_TARGET_SIZE);
+    SDL_Texture* sprite = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, BENCH_SPRITE_SIZE, BENCH_SPRITE_SIZE);
+    if (!target || !sprite) {
+        spdlog::warn("硬件探测：无法创建基准纹理，跳过精灵基准: {}", SDL_GetError());
+        SDL_DestroyTexture(target);
+        SDL_DestroyTexture(sprite);
+        return 0.0;
+    }
+    std::array<std::uint32_t, BENCH_SPRITE_SIZE * BENCH_SPRITE_SIZE> pixels;
+    pixels.fill(0xC0FFFFFFu);
+    SDL_UpdateTexture(sprite, nullptr, pixels.data(), BENCH_SPRITE_SIZE * static_cast<int>(sizeof(std::uint32_t)));
+    SDL_SetTextureBlendMode(sprite, SDL_BLENDMODE_BLEND);
+
+    SDL_Texture* previous_target = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, target);
+    const SDL_Rect probe_pixel{ 0, 0, 1, 1 };
+    double best_ms = std::numeric_limits<double>::max();
+    for (int pass = 0; pass < BENCH_PASSES; ++pass) {
+        const auto start = std::chrono::steady_clock::now();
+        SDL_RenderClear(renderer);
+        std::uint32_t seed = 0x9E3779B9u;
+        for (int i = 0; i < BENCH_SPRITES; ++i) {
+            seed = seed * 1664525u + 1013904223u;   // 线性同余，位置每次相同
+            const float x = static_cast<float>((seed >> 8) % (BENCH_TARGET_SIZE - BENCH_SPRITE_SIZE));
+            const float y = static_cast<float>((seed >> 20) % (BENCH_TARGET_SIZE - BENCH_SPRITE_SIZE));
+            const SDL_FRect dst{ x, y, static_cast<float>(BENCH_SPRITE_SIZE), static_cast<float>(BENCH_SPRITE_SIZE) };
+            SDL_RenderTexture(renderer, sprite, nullptr, &dst);
+        }
+        SDL_DestroySurface(SDL_RenderReadPixels(renderer, &probe_pixel));
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best_ms = std::min(best_ms, elapsed.count());
+    }
+    SDL_SetRenderTarget(renderer, previous_target);
+    SDL_DestroyTexture(sprite);
+    SDL_DestroyTexture(target);
+    return best_ms;
+}
+
+} // namespace
+
+HardwareProbe probeHardware(SDL_Renderer* renderer, bool run_benchmark) {
+    HardwareProbe probe;
+    probe.logical_cores_ = std::max(1, SDL_GetNumLogicalCPUCores());
+    probe.system_ram_mb_ = SDL_GetSystemRAM();
+    probe.gpu_drivers_ = SDL_GetNumGPUDrivers();
+    if (renderer) {
+        if (const char* name = SDL_GetRendererName(renderer)) {
+            probe.renderer_name_ = name;
+        }
+        probe.software_renderer_ = probe.renderer_name_ == SDL_SOFTWARE_RENDERER;
+        probe.max_texture_size_ = static_cast<int>(SDL_GetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 0));
+        if (run_benchmark) {
+            probe.sprite_bench_ms_ = runSpriteBenchmark(renderer);
+        }
+    }
+    probe.vram_estimate_mb_ = estimateVramMb(probe);
+    spdlog::info("硬件探测: {} 逻辑核心, 内存 {} MB, 渲染器 {}（最大纹理 {}）, SDL_GPU 驱动 {} 个, 显存估计 {} MB, 精灵基准 {:.2f} ms",
+                 probe.logical_cores_, probe.system_ram_mb_, probe.renderer_name_.empty() ? "无" : probe.renderer_name_,
+                 probe.max_texture_size_, probe.gpu_drivers_, probe.vram_estimate_mb_, probe.sprite_bench_ms_);
+    return probe;
+}
+
+HardwareTier chooseTier(const HardwareProbe& probe) {
+    if (probe.software_renderer_ || probe.logical_cores_ <= 2 || probe.sprite_bench_ms_ > BENCH_LOW_MS) {
+        return HardwareTier::LOW;
+    }
+    if (probe.logical_cores_ >= 8 && probe.vram_estimate_mb_ >= 2048 && probe.sprite_bench_ms_ <= BENCH_HIGH_MS) {
+        return HardwareTier::HIGH;
+    }
+    return HardwareTier::MEDIUM;
+}
+
+TierSettings tierSettings(HardwareTier tier, const HardwareProbe& probe) {
+    TierSettings settings;
+    const float vram = static_cast<float>(probe.vram_estimate_mb_);
+    switch (tier) {
+    case HardwareTier::LOW:
+        settings.renderer_backend_ = "sdl";
+        settings.pixel_perfect_ = true;
+        settings.texture_vram_budget_mb_ = std::clamp(vram / 4.0f, 64.0f, 128.0f);
+        settings.worker_threads_ = std::clamp(probe.logical_cores_ - 1, 0, 2);
+        settings.target_fps_ = 30;
+        settings.quality_floor_ = 3;        // QualityStep::REDUCED_EFFECTS
+        settings.system_rates_hz_ = { { "OrientationSystem", 15.0f }, { "HealthBarSystem", 15.0f }, { "SelectionSystem", 20.0f } };
+        break;
+    case HardwareTier::MEDIUM:
+        settings.renderer_backend_ = "sdl";
+        settings.pixel_perfect_ = false;
+        settings.texture_vram_budget_mb_ = std::clamp(vram / 4.0f, 128.0f, 256.0f);
+        settings.worker_threads_ = -1;
+        settings.target_fps_ = 60;
+        settings.quality_floor_ = 1;        // QualityStep::THROTTLE_HEALTH_BARS
+        settings.system_rates_hz_ = { { "OrientationSystem", 30.0f }, { "HealthBarSystem", 30.0f }, { "SelectionSystem", 30.0f } };
+        break;
+    case HardwareTier::HIGH:
+        settings.renderer_backend_ = probe.gpu_drivers_ > 0 ? "gpu" : "sdl";
+        settings.pixel_perfect_ = false;
+        settings.texture_vram_budget_mb_ = std::clamp(vram / 3.0f, 256.0f, 1024.0f);
+        settings.worker_threads_ = -1;
+        settings.target_fps_ = 144;
+        settings.quality_floor_ = 0;
+        break;
+    }
+    return settings;
+}
+
+std::string_view hardwareTierName(HardwareTier tier) {
+    switch (tier) {
+    case HardwareTier::LOW: return "low";
+    case HardwareTier::MEDIUM: return "medium";
+    case HardwareTier::HIGH: return "high";
+    }
+    return "medium";
+}
+
+std::optional<HardwareTier> parseHardwareTier(std::string_view name) {
+    for (const auto tier : { HardwareTier::LOW, HardwareTier::MEDIUM, HardwareTier::HIGH }) {
+        if (name == hardwareTierName(tier)) {
+            return tier;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace engine::core
@@ -0,0 +1,77 @@
+#pragma once
+/**
+ * @file hardware_tier.h
+ * @brief 首次启动的硬件探测与性能分级：按核心数、渲染器能力、显存估计与一次合成精灵基准选出档位，写入配置。
+ *
+ * @details
+ * 部署环境从集成显卡的展台机到游戏 PC 都有，config.json 却是同一份。GameApp 在创建渲染器之后调用：
+ * - probeHardware()：逻辑核心数、系统内存、渲染器名称与最大纹理尺寸、SDL_GPU 驱动数，
+ *   可选地在离屏目标上绘制 BENCH_SPRITES 个精灵（取 BENCH_PASSES 次中的最短耗时，读回一个像素强制完成）
+ * - chooseTier()：软件渲染、双核及以下或基准过慢为 LOW；核心、显存估计与基准都充裕为 HIGH；其余为 MEDIUM
+ * - tierSettings()：档位对应的各项设置，由 Config::applyTier() 写入（performance.tier_pinned 中列出的设置保留原值）
+ *
+ * SDL 不提供显存查询，vram_estimate_mb_ 由最大纹理尺寸与系统内存粗略推算，只用于选择纹理预算。
+ * 分级只在 performance.tier 与已应用的档位不一致时执行一次（"auto" 表示探测），之后各项设置照常可改。
+ */
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct SDL_Renderer;
+
+namespace engine::core {
+
+enum class HardwareTier : std::uint8_t {
+    LOW,        ///< 集成显卡 / 软件渲染：低分辨率世界层、特效减半、30 FPS
+    MEDIUM,
+    HIGH,       ///< 独立显卡：SDL_GPU 后端（可用时）、全部效果、144 FPS
+};
+
+/// @brief 一次探测的结果（写入日志）
+struct HardwareProbe {
+    int logical_cores_{ 1 };
+    int system_ram_mb_{ 0 };
+    std::string renderer_name_;
+    int max_texture_size_{ 0 };
+    bool software_renderer_{ false };
+    int gpu_drivers_{ 0 };                  ///< 可用的 SDL_GPU 驱动数，0 表示 "gpu" 后端不可用
+    int vram_estimate_mb_{ 0 };
+    double sprite_bench_ms_{ 0.0 };         ///< 合成精灵基准的最短耗时，未运行时为 0
+};
+
+/// @brief 档位写入配置的设置
+struct TierSettings {
+    std::string renderer_backend_;
+    bool pixel_perfect_{ false };           ///< 世界层画到逻辑分辨率目标再放大（低分辨率世界层）
+    float texture_vram_budget_mb_{ 0.0f };
+    int worker_threads_{ -1 };
+    int target_fps_{ 60 };
+    int quality_floor_{ 0 };                ///< FrameBudget 档位下限：特效密度、血条频率等从该档开始就降级
+    std::unordered_map<std::string, float> system_rates_hz_;    ///< 表现类系统的执行频率（见 SystemScheduler::throttleable()）
+};
+
+inline constexpr int BENCH_SPRITES = 4000;  ///< 基准每次绘制的精灵数
+inline constexpr int BENCH_PASSES = 3;
+inline constexpr double BENCH_LOW_MS = 12.0;    ///< 超过即 LOW（约为 30 FPS 预算的三分之一）
+inline constexpr double BENCH_HIGH_MS = 3.0;    ///< 不超过才可能 HIGH
+
+/**
+ * @brief 探测硬件
+ * @param renderer 已创建的渲染器；为 nullptr 时跳过渲染器相关项与基准
+ * @param run_benchmark 是否运行合成精灵基准（显式指定档位时不需要）
+ */
+[[nodiscard]] HardwareProbe probeHardware(SDL_Renderer* renderer, bool run_benchmark);
+
+[[nodiscard]] HardwareTier chooseTier(const HardwareProbe& probe);
+
+[[nodiscard]] TierSettings tierSettings(HardwareTier tier, const HardwareProbe& probe);
+
+[[nodiscard]] std::string_view hardwareTierName(HardwareTier tier);
+
+/// @brief 解析 "low" / "medium" / "high"，其他值返回空
+[[nodiscard]] std::optional<HardwareTier> parseHardwareTier(std::string_view name);
+
+} // namespace engine::core
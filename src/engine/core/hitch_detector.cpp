@@ -0,0 +1,187 @@
+#include "hitch_detector.h"
+#include "../utils/profiler.h"
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <entt/entity/registry.hpp>
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+
+namespace engine::core {
+
+namespace {
+    constexpr double SMOOTHING = 0.05;          ///< 平滑帧时长的指数平滑系数
+
+    /// @brief 一帧内同名作用域的汇总
+    struct ScopeTotal {
+        const char* name_{ nullptr };
+        double ms_{ 0.0 };
+        std::uint32_t calls_{ 0 };
+        std::uint32_t allocations_{ 0 };
+    };
+
+    const std::pair<const char*, std::int64_t>* findCounter(const engine::utils::FrameCapture& frame, std::string_view name) {
+        for (const auto& counter : frame.counters_) {
+            if (name == counter.first) {
+                return &counter;
+            }
+        }
+        return nullptr;
+    }
+}
+
+HitchDetector::HitchDetector() = default;
+
+HitchDetector::~HitchDetector() = default;
+
+void HitchDetector::configure(float factor, int target_fps) {
+    factor_ = static_cast<double>(factor);
+    target_ms_ = 1000.0 / static_cast<double>(target_fps > 0 ? target_fps : 60);
+    if (isEnabled()) {
+        spdlog::info("卡顿检测: 阈值 {:.1f} 倍帧时长（至少 {:.2f} ms），日志 {}", factor_, getThresholdMs(), log_path_);
+    }
+}
+
+double HitchDetector::getThresholdMs() const {
+    return factor_ * std::max(target_ms_, smoothed_ms_);
+}
+
+void HitchDetector::endFrame(const entt::registry* registry) {
+    if (!isEnabled()) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    const double frame_ms = has_last_frame_ ? std::chrono::duration<double, std::milli>(now - last_frame_).count() : 0.0;
+    last_frame_ = now;
+
+    // 场景切换后上一帧的存储大小不可比，本帧只采样不比较
+    const bool comparable = has_last_frame_ && registry != nullptr && registry == registry_;
+    has_last_frame_ = true;
+    registry_ = registry;
+    std::swap(previous_sizes_, current_sizes_);
+    if (registry) {
+        captureSizes(*registry, current_sizes_);
+    } else {
+        current_sizes_.clear();
+    }
+
+    if (frame_ms <= getThresholdMs()) {
+        smoothed_ms_ = smoothed_ms_ == 0.0 ? frame_ms : smoothed_ms_ + (frame_ms - smoothed_ms_) * SMOOTHING;
+        return;
+    }
+
+    ++hitch_count_;
+    last_hitch_ms_ = frame_ms;
+    if (has_dumped_ && std::chrono::duration<double>(now - last_dump_).count() < COOLDOWN_SECONDS) {
+        ++suppressed_;
+        return;
+    }
+    has_dumped_ = true;
+    last_dump_ = now;
+    dump(frame_ms, comparable ? registry : nullptr);
+}
+
+void HitchDetector::captureSizes(const entt::registry& registry, StorageSizes& out) {
+    out.clear();
+    for (auto [id, storage] : registry.storage()) {
+        out.emplace_back(id, storage.size());
+    }
+}
+
+bool HitchDetector::ensureLogger() {
+    if (logger_) {
+        return true;
+    }
+    if (logger_failed_) {
+        return false;
+    }
+    try {
+        // 不注册到 spdlog 注册表，避免与默认日志器的全局级别和 sink 互相影响
+        auto sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(log_path_, MAX_FILE_BYTES, MAX_FILES);
+        logger_ = std::make_shared<spdlog::logger>("hitch", std::move(sink));
+        logger_->set_pattern("[%Y-%m-%d %H:%M:%S.%e] %v");
+        logger_->set_level(spdlog::level::info);
+        logger_->flush_on(spdlog::level::info);
+    }
+    catch (const spdlog::spdlog_ex& e) {
+        spdlog::error("卡顿日志无法打开，已停止写入: {} ({})", log_path_, e.what());
+        logger_failed_ = true;
+        return false;
+    }
+    return true;
+}
+
+void HitchDetector::dump(double frame_ms, const entt::registry* registry) {
+    if (!ensureLogger()) {
+        return;
+    }
+    ++dump_count_;
+    spdlog::warn("卡顿: 帧时长 {:.2f} ms（阈值 {:.2f} ms），诊断已写入 {}", frame_ms, getThresholdMs(), log_path_);
+    logger_->info("==== 卡顿 #{}: {:.2f} ms（阈值 {:.2f} ms，平滑帧时长 {:.2f} ms，冷却期内另有 {} 次未转储）====",
+        hitch_count_, frame_ms, getThresholdMs(), smoothed_ms_, suppressed_);
+    suppressed_ = 0;
+
+    const auto& profiler = engine::utils::Profiler::instance();
+    const auto& history = profiler.getHistory();
+    if (!profiler.isEnabled() || profiler.isCapturePaused() || history.empty()) {
+        logger_->info("  （分析器未归档，无作用域与计数器）");
+    } else {
+        const std::size_t count = std::min(FRAMES_PER_DUMP, history.size());
+        std::vector<ScopeTotal> scopes;
+        for (std::size_t i = history.size() - count; i < history.size(); ++i) {
+            const auto& frame = history[i];
+            const auto* previous = i > 0 ? &history[i - 1] : nullptr;
+            logger_->info("  帧 {}: {:.2f} ms，分配 {} 次 / {} B{}", frame.frame_index_, frame.durationMs(),
+                frame.allocations_, frame.allocated_bytes_, i + 1 == history.size() ? "（卡顿帧）" : "");
+
+            scopes.clear();
+            for (const auto& sample : frame.samples_) {
+                const std::string_view name = sample.name_;
+                auto it = std::ranges::find_if(scopes, [&](const ScopeTotal& total) { return name == total.name_; });
+                if (it == scopes.end()) {
+                    scopes.push_back(ScopeTotal{ sample.name_ });
+                    it = std::prev(scopes.end());
+                }
+                it->ms_ += static_cast<double>(sample.end_ns_ - sample.start_ns_) / 1.0e6;
+                ++it->calls_;
+                it->allocations_ += sample.allocations_;
+            }
+            std::ranges::sort(scopes, std::ranges::greater{}, &ScopeTotal::ms_);
+            for (std::size_t s = 0; s < std::min(TOP_SCOPES, scopes.size()); ++s) {
+                logger_->info("    {:<40} {:8.3f} ms  x{}  分配 {}", scopes[s].name_, scopes[s].ms_, scopes[s].calls_, scopes[s].allocations_);
+            }
+
+            for (const auto& [name, value] : frame.counters_) {
+                const auto* before = previous ? findCounter(*previous, name) : nullptr;
+                if (before && before->second != value) {
+                    logger_->info("    # {} = {} ({:+})", name, value, value - before->second);
+                } else {
+                    logger_->info("    # {} = {}", name, value);
+                }
+            }
+        }
+    }
+
+    if (!registry) {
+        logger_->info("  注册表: 本帧切换了场景或没有场景，不比较存储大小");
+        return;
+    }
+    std::size_t changed = 0;
+    for (const auto& [id, size] : current_sizes_) {
+        const auto it = std::ranges::find(previous_sizes_, id, &StorageSizes::value_type::first);
+        const std::size_t before = it != previous_sizes_.end() ? it->second : 0u;
+        if (before == size) {
+            continue;
+        }
+        const auto* storage = registry->storage(id);
+        const std::string_view name = storage ? storage->type().name() : std::string_view{ "?" };
+        logger_->info("  存储 {}: {} -> {} ({:+})", name, before, size,
+            static_cast<std::int64_t>(size) - static_cast<std::int64_t>(before));
+        ++changed;
+    }
+    if (changed == 0) {
+        logger_->info("  注册表: 存储大小无变化");
+    }
+}
+
+} // namespace engine::core
@@ -0,0 +1,109 @@
+#pragma once
+/**
+ * @file hitch_detector.h
+ * @brief 卡顿检测：帧时长超过阈值时，把最近几帧的诊断信息写入滚动日志文件。
+ *
+ * @details
+ * GameApp 每帧在 Profiler::endFrame() 之后调用 endFrame()。阈值为
+ * factor × max(目标帧时长, 平滑帧时长)：平滑帧时长只由未判为卡顿的帧更新，
+ * 垂直同步或机器本身较慢时以实际的稳定帧时长为基准，只报告相对的尖峰。
+ *
+ * 稳态开销：一次计时、一次比较，以及当前注册表各存储的大小（每个存储两个整数，复用数组容量）。
+ * 只有判为卡顿时才会格式化并写文件，写文件的日志器在第一次卡顿时才创建；
+ * 两次转储之间至少间隔 COOLDOWN_SECONDS，连续的卡顿只计数。
+ *
+ * 每次转储包含：
+ * - 最近 FRAMES_PER_DUMP 帧的耗时、耗时最高的作用域（按名称汇总）与计数器
+ *   （`evt.*` 为各事件通道的帧内数量，`res.tex_sync_loads` 为纹理缓存未命中的同步加载累计数，
+ *   `dead.destroyed` 为 RemoveDeadSystem 的累计删除数；与上一帧不同的累计值附带差值）
+ * - 卡顿帧前后注册表各存储大小的变化
+ *
+ * 分析器关闭或暂停归档时只记录帧时长与注册表变化。
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <entt/core/fwd.hpp>
+#include <entt/entity/fwd.hpp>
+
+namespace spdlog {
+class logger;
+}
+
+namespace engine::core {
+
+class HitchDetector final {
+public:
+    static constexpr std::size_t FRAMES_PER_DUMP = 4;       ///< 每次转储的历史帧数（含卡顿帧）
+    static constexpr std::size_t TOP_SCOPES = 12;           ///< 每帧列出的作用域数
+    static constexpr double COOLDOWN_SECONDS = 1.0;         ///< 两次转储的最小间隔
+    static constexpr std::size_t MAX_FILE_BYTES = 1u << 20; ///< 单个日志文件上限，超出后滚动
+    static constexpr std::size_t MAX_FILES = 3;             ///< 保留的滚动文件数
+
+    HitchDetector();
+    ~HitchDetector();
+
+    HitchDetector(const HitchDetector&) = delete;
+    HitchDetector& operator=(const HitchDetector&) = delete;
+
+    /**
+     * @brief 设置阈值倍数与目标帧率
+     * @param factor 阈值倍数，不大于 1 时关闭检测
+     * @param target_fps 目标帧率，0（不限帧）时按 60 FPS 计算
+     */
+    void configure(float factor, int target_fps);
+
+    /// @brief 日志路径（默认 logs/hitches.log），需在第一次卡顿之前设置
+    void setLogPath(std::string path) { log_path_ = std::move(path); }
+
+    /**
+     * @brief 结束一帧：计时、判定卡顿并在需要时转储
+     * @param registry 当前场景的注册表，没有场景时传 nullptr
+     */
+    void endFrame(const entt::registry* registry);
+
+    [[nodiscard]] bool isEnabled() const { return factor_ > 1.0; }
+
+    /// @brief 本帧不参与判定（空闲帧主动等待事件，帧时长不代表卡顿），下一次 endFrame() 重新开始计时
+    void skipFrame() { has_last_frame_ = false; }
+
+    [[nodiscard]] double getThresholdMs() const;
+    [[nodiscard]] std::uint64_t getHitchCount() const { return hitch_count_; }
+    [[nodiscard]] std::uint64_t getDumpCount() const { return dump_count_; }
+    [[nodiscard]] double getLastHitchMs() const { return last_hitch_ms_; }
+
+private:
+    using StorageSizes = std::vector<std::pair<entt::id_type, std::size_t>>;
+
+    static void captureSizes(const entt::registry& registry, StorageSizes& out);
+    void dump(double frame_ms, const entt::registry* registry);
+    [[nodiscard]] bool ensureLogger();
+
+    std::string log_path_{ "logs/hitches.log" };
+    std::shared_ptr<spdlog::logger> logger_;
+    bool logger_failed_{ false };
+
+    double factor_{ 2.0 };
+    double target_ms_{ 1000.0 / 60.0 };
+    double smoothed_ms_{ 0.0 };
+    std::chrono::steady_clock::time_point last_frame_{};
+    std::chrono::steady_clock::time_point last_dump_{};
+    bool has_last_frame_{ false };
+    bool has_dumped_{ false };
+
+    const entt::registry* registry_{ nullptr };     ///< 上一帧采样的注册表（场景切换后重新采样）
+    StorageSizes previous_sizes_;
+    StorageSizes current_sizes_;
+
+    std::uint64_t hitch_count_{ 0 };
+    std::uint64_t dump_count_{ 0 };
+    std::uint64_t suppressed_{ 0 };                 ///< 冷却期内未转储的卡顿数
+    double last_hitch_ms_{ 0.0 };
+};
+
+} // namespace engine::core
@@ -0,0 +1,239 @@
+#include "init_graph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <format>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+namespace {
+
+constexpr std::size_t NO_STEP = std::numeric_limits<std::size_t>::max();
+
+const char* affinityName(InitAffinity affinity) {
+    return affinity == InitAffinity::MAIN ? "主线程" : "后台";
+}
+
+} // namespace
+
+void InitGraph::add(std::string name, std::vector<std::string> dependencies, InitAffinity affinity, Step step) {
+    Node node;
+    node.name_ = std::move(name);
+    node.dependency_names_ = std::move(dependencies);
+    node.affinity_ = affinity;
+    node.step_ = std::move(step);
+    nodes_.push_back(std::move(node));
+}
+
+bool InitGraph::resolve() {
+    std::unordered_map<std::string, std::size_t> index;
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        if (!index.emplace(nodes_[i].name_, i).second) {
+            spdlog::error("初始化步骤重名: '{}'", nodes_[i].name_);
+            return false;
+        }
+    }
+    for (auto& node : nodes_) {
+        node.dependencies_.clear();
+        node.dependents_.clear();
+    }
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        for (const auto& dependency : nodes_[i].dependency_names_) {
+            auto it = index.find(dependency);
+            if (it == index.end()) {
+                spdlog::error("初始化步骤 '{}' 依赖不存在的步骤 '{}'", nodes_[i].name_, dependency);
+                return false;
+            }
+            nodes_[i].dependencies_.push_back(it->second);
+            nodes_[it->second].dependents_.push_back(i);
+        }
+    }
+
+    // Kahn 拓扑排序：能全部出队说明无环
+    std::vector<std::size_t> in_degree(nodes_.size());
+    std::vector<std::size_t> queue;
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        in_degree[i] = nodes_[i].dependencies_.size();
+        if (in_degree[i] == 0) {
+            queue.push_back(i);
+        }
+    }
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        for (const auto dependent : nodes_[queue[head]].dependents_) {
+            if (--in_degree[dependent] == 0) {
+                queue.push_back(dependent);
+            }
+        }
+    }
+    if (queue.size() != nodes_.size()) {
+        spdlog::error("初始化步骤之间存在循环依赖");
+        return false;
+    }
+    return true;
+}
+
+bool InitGraph::run() {
+    timings_.assign(nodes_.size(), {});
+    previous_main_.assign(nodes_.size(), NO_STEP);
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        timings_[i].name_ = nodes_[i].name_;
+        timings_[i].affinity_ = nodes_[i].affinity_;
+    }
+    total_ms_ = 0.0;
+    if (!resolve()) {
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto elapsed_ms = [start]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+    // 每个步骤的记录只由执行它的线程写入，run() 返回前汇合全部线程后才读取
+    const auto execute = [&](std::size_t index) {
+        auto& timing = timings_[index];
+        timing.ran_ = true;
+        timing.start_ms_ = elapsed_ms();
+        bool ok = false;
+        try {
+            ok = nodes_[index].step_();
+        } catch (const std::exception& e) {
+            spdlog::error("初始化步骤 '{}' 抛出异常: {}", nodes_[index].name_, e.what());
+        }
+        timing.end_ms_ = elapsed_ms();
+        timing.ok_ = ok;
+        if (!ok) {
+            spdlog::error("初始化步骤 '{}' 失败", nodes_[index].name_);
+        }
+        return ok;
+    };
+
+    std::mutex mutex;
+    std::condition_variable completed;
+    std::vector<std::size_t> pending(nodes_.size());
+    std::vector<std::size_t> ready_main;
+    std::vector<std::size_t> ready_any;
+    std::size_t running = 0;
+    bool failed = false;
+
+    const auto push_ready = [&](std::size_t index) {
+        (nodes_[index].affinity_ == InitAffinity::MAIN ? ready_main : ready_any).push_back(index);
+    };
+    // 需持有 mutex
+    const auto complete = [&](std::size_t index, bool ok) {
+        if (!ok) {
+            failed = true;
+            return;
+        }
+        for (const auto dependent : nodes_[index].dependents_) {
+            if (--pending[dependent] == 0) {
+                push_ready(dependent);
+            }
+        }
+    };
+
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        pending[i] = nodes_[i].dependencies_.size();
+        if (pending[i] == 0) {
+            push_ready(i);
+        }
+    }
+
+    std::vector<std::future<void>> workers;
+    std::size_t last_main = NO_STEP;
+    std::unique_lock lock(mutex);
+    while (true) {
+        if (!failed) {
+            for (const auto index : ready_any) {
+                ++running;
+                workers.push_back(std::async(std::launch::async, [&, index]() {
+                    const bool ok = execute(index);
+                    std::lock_guard guard(mutex);
+                    complete(index, ok);
+                    --running;
+                    completed.notify_all();
+                }));
+            }
+            ready_any.clear();
+        }
+        if (!failed && !ready_main.empty()) {
+            // 多个主线程步骤同时就绪时按添加顺序执行
+            const auto it = std::min_element(ready_main.begin(), ready_main.end());
+            const std::size_t index = *it;
+            ready_main.erase(it);
+            previous_main_[index] = last_main;
+            last_main = index;
+            lock.unlock();
+            const bool ok = execute(index);
+            lock.lock();
+            complete(index, ok);
+            continue;
+        }
+        if (running == 0) {
+            break;
+        }
+        completed.wait(lock);
+    }
+    lock.unlock();
+    for (auto& worker : workers) {
+        worker.wait();
+    }
+    total_ms_ = elapsed_ms();
+
+    return !failed && std::ranges::all_of(timings_, [](const InitStepTiming& timing) { return timing.ok_; });
+}
+
+std::vector<std::size_t> InitGraph::getCriticalPath() const {
+    std::vector<std::size_t> path;
+    std::size_t current = NO_STEP;
+    for (std::size_t i = 0; i < timings_.size(); ++i) {
+        if (timings_[i].ran_ && (current == NO_STEP || timings_[i].end_ms_ > timings_[current].end_ms_)) {
+            current = i;
+        }
+    }
+    // 前驱取依赖与主线程上一个步骤中最晚结束的那个：主线程步骤也可能是被前一个主线程步骤挡住
+    while (current != NO_STEP) {
+        path.push_back(current);
+        std::size_t previous = previous_main_.empty() ? NO_STEP : previous_main_[current];
+        for (const auto dependency : nodes_[current].dependencies_) {
+            if (previous == NO_STEP || timings_[dependency].end_ms_ > timings_[previous].end_ms_) {
+                previous = dependency;
+            }
+        }
+        current = previous;
+    }
+    std::ranges::reverse(path);
+    return path;
+}
+
+void InitGraph::logReport() const {
+    double serial_ms = 0.0;
+    for (const auto& timing : timings_) {
+        serial_ms += timing.end_ms_ - timing.start_ms_;
+    }
+    std::string critical;
+    for (const auto index : getCriticalPath()) {
+        const auto& timing = timings_[index];
+        if (!critical.empty()) {
+            critical += " -> ";
+        }
+        critical += std::format("{} {:.1f}", timing.name_, timing.end_ms_ - timing.start_ms_);
+    }
+    spdlog::info("启动初始化耗时 {:.1f} ms（各步骤串行合计 {:.1f} ms），关键路径: {}", total_ms_, serial_ms, critical);
+    for (const auto& timing : timings_) {
+        if (!timing.ran_) {
+            spdlog::info("  {:<18} {:<4} 跳过", timing.name_, affinityName(timing.affinity_));
+            continue;
+        }
+        spdlog::info("  {:<18} {:<4} {:8.1f} - {:8.1f} ms  ({:.1f} ms){}", timing.name_, affinityName(timing.affinity_),
+                     timing.start_ms_, timing.end_ms_, timing.end_ms_ - timing.start_ms_, timing.ok_ ? "" : " 失败");
+    }
+}
+
+} // namespace engine::core
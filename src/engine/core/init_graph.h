@@ -0,0 +1,90 @@
+#pragma once
+/**
+ * @file init_graph.h
+ * @brief 启动初始化依赖图：按声明的依赖并行执行各初始化步骤，并输出启动耗时报告。
+ *
+ * @details
+ * 每个步骤声明名称、依赖与线程亲和性：
+ * - MAIN：必须在调用 run() 的线程（主线程）执行，如创建窗口、渲染器与 ImGui 后端
+ * - ANY：依赖全部完成后立即在后台线程执行，如解析配置、打开音频设备、读取字体与资源映射
+ *
+ * 主线程在等待后台步骤期间执行已就绪的 MAIN 步骤，冷启动时间因此由关键路径决定，而不是所有步骤之和。
+ * 任一步骤失败（返回 false 或抛出异常）后不再启动新步骤，等待已启动的后台步骤结束后 run() 返回 false。
+ *
+ * @code
+ * InitGraph graph;
+ * graph.add("config", {}, InitAffinity::ANY, [this] { return initConfig(); });
+ * graph.add("window", { "sdl", "config" }, InitAffinity::MAIN, [this] { return initWindow(); });
+ * if (!graph.run()) { ... }
+ * graph.logReport();
+ * @endcode
+ */
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace engine::core {
+
+enum class InitAffinity {
+    MAIN,   ///< 只能在主线程执行
+    ANY,    ///< 可在后台线程执行
+};
+
+/// @brief 单个步骤的耗时记录（相对 run() 开始的毫秒数）
+struct InitStepTiming {
+    std::string name_;
+    InitAffinity affinity_{InitAffinity::MAIN};
+    double start_ms_{0.0};
+    double end_ms_{0.0};
+    bool ok_{false};
+    bool ran_{false};           ///< false 表示因依赖失败而跳过
+};
+
+class InitGraph final {
+public:
+    using Step = std::function<bool()>;
+
+    /**
+     * @brief 添加步骤（须在 run() 之前）
+     * @param dependencies 依赖的步骤名，可引用稍后添加的步骤
+     */
+    void add(std::string name, std::vector<std::string> dependencies, InitAffinity affinity, Step step);
+
+    /**
+     * @brief 执行全部步骤，阻塞到所有已启动的步骤结束
+     * @return 全部成功返回 true；依赖缺失、存在环或任一步骤失败返回 false
+     */
+    [[nodiscard]] bool run();
+
+    /// @brief 按添加顺序的耗时记录（run() 之后有效）
+    [[nodiscard]] const std::vector<InitStepTiming>& getTimings() const { return timings_; }
+    /// @brief run() 的总耗时（毫秒）
+    [[nodiscard]] double getTotalMs() const { return total_ms_; }
+    /// @brief 关键路径：从最后结束的步骤沿最晚结束的依赖回溯得到的步骤下标（按执行顺序）
+    [[nodiscard]] std::vector<std::size_t> getCriticalPath() const;
+
+    /// @brief 输出启动耗时报告：总耗时、串行总和、关键路径与各步骤区间
+    void logReport() const;
+
+private:
+    struct Node {
+        std::string name_;
+        std::vector<std::string> dependency_names_;
+        std::vector<std::size_t> dependencies_;
+        std::vector<std::size_t> dependents_;
+        InitAffinity affinity_{InitAffinity::MAIN};
+        Step step_;
+    };
+
+    /// @brief 解析依赖名并检查环，失败时记录错误
+    [[nodiscard]] bool resolve();
+
+    std::vector<Node> nodes_;
+    std::vector<InitStepTiming> timings_;
+    std::vector<std::size_t> previous_main_;    ///< 主线程上紧挨着之前执行的步骤（用于关键路径）
+    double total_ms_{0.0};
+};
+
+} // namespace engine::core
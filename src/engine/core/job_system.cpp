@@ -0,0 +1,130 @@
+#include "job_system.h"
+#include "../memory/allocation_counter.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+namespace {
+    thread_local bool t_inside_job = false;
+}
+
+std::size_t JobSystem::defaultWorkerCount() {
+    const unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+JobSystem::JobSystem(std::size_t worker_count) {
+    queues_.reserve(std::max<std::size_t>(worker_count, 1));
+    for (std::size_t i = 0; i < std::max<std::size_t>(worker_count, 1); ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers_.reserve(worker_count);
+    for (std::size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+    spdlog::info("JobSystem 启动: {} 个工作线程", worker_count);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void JobSystem::parallelFor(std::size_t task_count, const std::function<void(std::size_t)>& task) {
+    if (task_count == 0) {
+        return;
+    }
+    if (workers_.empty()) {
+        const bool previous = std::exchange(t_inside_job, true);
+        for (std::size_t i = 0; i < task_count; ++i) {
+            task(i);
+        }
+        t_inside_job = previous;
+        return;
+    }
+
+    remaining_.store(task_count, std::memory_order_relaxed);
+    {
+        // 先计数再入队，取任务时的递减不会早于这里的递增
+        std::lock_guard lock(wake_mutex_);
+        queued_ += task_count;
+    }
+    for (std::size_t i = 0; i < task_count; ++i) {
+        auto& queue = *queues_[i % queues_.size()];
+        std::lock_guard lock(queue.mutex_);
+        queue.jobs_.push_back(Job{ &task, i });
+    }
+    wake_cv_.notify_all();
+
+    // 调用线程参与执行，取不到任务时等待其他线程完成手上的任务
+    Job job;
+    while (remaining_.load(std::memory_order_acquire) > 0) {
+        if (tryPop(0, false, job)) {
+            execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::tryPop(std::size_t first, bool own, Job& job) {
+    for (std::size_t offset = 0; offset < queues_.size(); ++offset) {
+        auto& queue = *queues_[(first + offset) % queues_.size()];
+        std::lock_guard lock(queue.mutex_);
+        if (queue.jobs_.empty()) {
+            continue;
+        }
+        if (own && offset == 0) {
+            job = queue.jobs_.back();
+            queue.jobs_.pop_back();
+        } else {
+            job = queue.jobs_.front();
+            queue.jobs_.pop_front();
+        }
+        std::lock_guard wake_lock(wake_mutex_);
+        --queued_;
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::isInsideJob() {
+    return t_inside_job;
+}
+
+void JobSystem::execute(const Job& job) {
+    const bool previous = std::exchange(t_inside_job, true);
+    (*job.task_)(job.index_);
+    t_inside_job = previous;
+    remaining_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::workerLoop(std::size_t worker_index) {
+    ENGINE_PROFILE_THREAD_NAME(("JobSystem worker " + std::to_string(worker_index)).c_str());
+    engine::memory::markJobWorkerThread();
+    Job job;
+    while (true) {
+        {
+            std::unique_lock lock(wake_mutex_);
+            wake_cv_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+            if (stopping_) {
+                return;
+            }
+        }
+        while (tryPop(worker_index, true, job)) {
+            execute(job);
+        }
+    }
+}
+
+} // namespace engine::core
@@ -0,0 +1,150 @@
+#pragma once
+/**
+ * @file job_system.h
+ * @brief 工作窃取线程池与按块并行遍历 EnTT 视图的辅助函数。
+ *
+ * @details
+ * 用法：
+ * @code
+ * auto view = registry.view<VelocityComponent, TransformComponent>();
+ * engine::core::parallelEach(registry, view, [&](entt::entity entity, engine::ecs::CommandBuffer&) {
+ *     view.get<TransformComponent>(entity).position_ += view.get<VelocityComponent>(entity).velocity_ * dt;
+ * });
+ * @endcode
+ *
+ * 并行回调只能读写实体自身的组件。添加/移除组件、分发事件等结构性修改必须写入
+ * 回调收到的 engine::ecs::CommandBuffer（每块一个），遍历结束后在调用线程上按块顺序提交，
+ * 因此结果与串行遍历完全一致（与工作线程数无关）。
+ *
+ * JobSystem 通过 registry.ctx().emplace<engine::core::JobSystem&>() 提供给系统；
+ * 上下文中没有 JobSystem、实体数太少或已处在任务内部（如系统调度器的并行阶段）时，parallelEach 退化为串行遍历。
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <entt/entity/registry.hpp>
+#include "../ecs/command_buffer.h"
+#include "../utils/profiler.h"
+
+namespace engine::core {
+
+/**
+ * @class JobSystem
+ * @brief 固定大小的工作窃取线程池
+ *
+ * @details
+ * 每个工作线程拥有一个任务队列：提交时任务被轮流放入各队列，工作线程优先从自己队列尾部取任务，
+ * 空闲时从其他队列头部窃取。调用 parallelFor 的线程也会参与执行，直到全部任务完成才返回，
+ * 因此 worker_count 为 0 时等价于串行执行。
+ */
+class JobSystem final {
+public:
+    /// @brief 默认工作线程数：硬件线程数减一（主线程也参与执行）
+    static std::size_t defaultWorkerCount();
+
+    explicit JobSystem(std::size_t worker_count = defaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * @brief 执行 task(0) ... task(task_count - 1)，阻塞直到全部完成
+     * @details 任务之间没有顺序保证；只能由同一线程（主线程）调用，不支持在任务内部嵌套调用。
+     */
+    void parallelFor(std::size_t task_count, const std::function<void(std::size_t)>& task);
+
+    /// @brief 当前线程是否正在执行 parallelFor 的任务（此时 parallelEach 退化为串行，不嵌套调用 parallelFor）
+    [[nodiscard]] static bool isInsideJob();
+
+    /// @brief 参与执行的线程总数（工作线程 + 调用线程）
+    [[nodiscard]] std::size_t getThreadCount() const { return workers_.size() + 1; }
+
+private:
+    struct Job {
+        const std::function<void(std::size_t)>* task_{nullptr};
+        std::size_t index_{0};
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex_;
+        std::deque<Job> jobs_;
+    };
+
+    void workerLoop(std::size_t worker_index);
+    /// @brief 依次从 first 开始的队列取一个任务，own 为 true 时首个队列从尾部取
+    bool tryPop(std::size_t first, bool own, Job& job);
+    void execute(const Job& job);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::size_t queued_{0};                     ///< 尚未被取走的任务数（wake_mutex_ 保护）
+    bool stopping_{false};
+
+    std::atomic<std::size_t> remaining_{0};     ///< 当前批次尚未完成的任务数
+};
+
+/// 每块的默认实体数；低于两块时直接串行，避免调度开销超过收益
+inline constexpr std::size_t PARALLEL_EACH_GRAIN = 1024;
+
+/**
+ * @brief 将视图中的实体分块并行处理
+ * @param registry 实体所属注册表（从其上下文获取 JobSystem，并回放命令）
+ * @param view EnTT 视图；遍历期间不得对其组件存储做结构性修改
+ * @param fn 回调，签名为 void(entt::entity, ecs::CommandBuffer&)
+ * @param grain 每块实体数
+ */
+template <typename View, typename Fn>
+void parallelEach(entt::registry& registry, const View& view, Fn&& fn, std::size_t grain = PARALLEL_EACH_GRAIN) {
+    // 每个实例化各自复用缓冲，避免每帧重新分配
+    thread_local std::vector<entt::entity> entities;
+    thread_local std::vector<ecs::CommandBuffer> buffers;
+
+    entities.assign(view.begin(), view.end());
+    const std::size_t count = entities.size();
+    grain = grain > 0 ? grain : 1;
+    const std::size_t chunk_count = (count + grain - 1) / grain;
+
+    auto* jobs = registry.ctx().contains<JobSystem&>() ? &registry.ctx().get<JobSystem&>() : nullptr;
+    if (!jobs || jobs->getThreadCount() < 2 || chunk_count < 2 || JobSystem::isInsideJob()) {
+        if (buffers.empty()) {
+            buffers.emplace_back();
+        }
+        for (const auto entity : entities) {
+            fn(entity, buffers.front());
+        }
+        buffers.front().apply(registry);
+        return;
+    }
+
+    if (buffers.size() < chunk_count) {
+        buffers.resize(chunk_count);
+    }
+    jobs->parallelFor(chunk_count, [&](std::size_t chunk) {
+        ENGINE_PROFILE_SCOPE("ParallelChunk");
+        const std::size_t begin = chunk * grain;
+        const std::size_t end = begin + grain < count ? begin + grain : count;
+        auto& buffer = buffers[chunk];
+        for (std::size_t i = begin; i < end; ++i) {
+            fn(entities[i], buffer);
+        }
+    });
+
+    // 按块顺序回放，与串行遍历的修改顺序一致
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        buffers[chunk].apply(registry);
+    }
+}
+
+} // namespace engine::core
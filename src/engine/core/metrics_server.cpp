@@ -0,0 +1,147 @@
+#include "metrics_server.h"
+#include "../io/tcp_listener.h"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+namespace {
+
+std::string httpResponse(std::string_view status, std::string_view content_type, std::string_view body) {
+    std::string response;
+    response.reserve(body.size() + 128);
+    response += "HTTP/1.1 ";
+    response += status;
+    response += "\r\nContent-Type: ";
+    response += content_type;
+    response += "\r\nContent-Length: ";
+    response += std::to_string(body.size());
+    response += "\r\nCache-Control: no-store\r\nConnection: close\r\n\r\n";
+    response += body;
+    return response;
+}
+
+nlohmann::json toJson(const MetricsSnapshot& snapshot) {
+    nlohmann::json scopes = nlohmann::json::array();
+    for (const auto& scope : snapshot.scopes_) {
+        scopes.push_back({ { "name", scope.name_ }, { "last_ms", scope.last_ms_ }, { "p50_ms", scope.p50_ms_ },
+                           { "p99_ms", scope.p99_ms_ }, { "calls", scope.calls_ } });
+    }
+    nlohmann::json counters = nlohmann::json::object();
+    for (const auto& counter : snapshot.counters_) {
+        counters[std::string(counter.name_)] = { { "value", counter.value_ }, { "per_second", counter.per_second_ } };
+    }
+    nlohmann::json storages = nlohmann::json::array();
+    for (const auto& storage : snapshot.storages_) {
+        storages.push_back({ { "name", storage.name_ }, { "size", storage.size_ }, { "capacity", storage.capacity_ },
+                             { "bytes", storage.bytes_ } });
+    }
+    nlohmann::json memory = nlohmann::json::object();
+    for (const auto& tag : snapshot.memory_) {
+        memory[std::string(tag.name_)] = { { "bytes", tag.bytes_ }, { "budget_bytes", tag.budget_bytes_ },
+                                           { "over_budget", tag.over_budget_ } };
+    }
+    nlohmann::json textures = nlohmann::json::object();
+    for (const auto& kind : snapshot.textures_) {
+        textures[std::string(kind.kind_)] = { { "count", kind.count_ }, { "bytes", kind.bytes_ } };
+    }
+    return {
+        { "sequence", snapshot.sequence_ },
+        { "uptime_s", snapshot.uptime_s_ },
+        { "scene", snapshot.scene_ },
+        { "frame", { { "avg_ms", snapshot.frame_avg_ms_ }, { "p50_ms", snapshot.frame_p50_ms_ },
+                     { "p95_ms", snapshot.frame_p95_ms_ }, { "p99_ms", snapshot.frame_p99_ms_ },
+                     { "one_percent_low_ms", snapshot.frame_one_percent_low_ms_ }, { "max_ms", snapshot.frame_max_ms_ },
+                     { "samples", snapshot.frame_samples_ } } },
+        { "scopes", std::move(scopes) },
+        { "counters", std::move(counters) },
+        { "census", { { "entities", snapshot.entities_ }, { "storages", std::move(storages) } } },
+        { "memory", std::move(memory) },
+        { "textures", std::move(textures) },
+    };
+}
+
+} // namespace
+
+MetricsServer::MetricsServer() = default;
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start(std::uint16_t port) {
+    stop();
+    listener_ = std::make_unique<engine::io::TcpListener>();
+    if (!listener_->open(port)) {
+        spdlog::warn("指标端点无法监听 127.0.0.1:{}: {}", port, listener_->getLastError());
+        listener_.reset();
+        return false;
+    }
+    stop_requested_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread([this] { serve(); });
+    spdlog::info("指标端点已启动: http://127.0.0.1:{}/metrics", listener_->getLocalPort());
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (thread_.joinable()) {
+        stop_requested_.store(true, std::memory_order_relaxed);
+        thread_.join();
+    }
+    listener_.reset();
+}
+
+bool MetricsServer::isSampleDue(std::chrono::steady_clock::time_point now) const {
+    return isRunning() && now - last_publish_ >= SAMPLE_INTERVAL;
+}
+
+MetricsSnapshot& MetricsServer::beginSample() {
+    return snapshots_[write_index_];
+}
+
+void MetricsServer::publish(std::chrono::steady_clock::time_point now) {
+    snapshots_[write_index_].sequence_ = ++sequence_;
+    // 写好的一份换到中间并标记为新，换回来的一份（可能是服务线程刚放下的旧快照）下次写入
+    const auto previous = middle_index_.exchange(static_cast<std::uint8_t>(write_index_ | FRESH_BIT), std::memory_order_acq_rel);
+    write_index_ = previous & INDEX_MASK;
+    last_publish_ = now;
+}
+
+std::string MetricsServer::serializeLatest() {
+    if (middle_index_.load(std::memory_order_relaxed) & FRESH_BIT) {
+        read_index_ = middle_index_.exchange(read_index_, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+    const auto& snapshot = snapshots_[read_index_];
+    if (snapshot.sequence_ == 0) {
+        return R"({"sequence":0})";     // 尚未采样
+    }
+    return toJson(snapshot).dump();
+}
+
+void MetricsServer::serve() {
+    std::string request;
+    std::array<char, 1024> buffer{};
+    while (!stop_requested_.load(std::memory_order_relaxed)) {
+        auto connection = listener_->accept(ACCEPT_TIMEOUT_MS);
+        if (!connection) {
+            continue;
+        }
+        // 只读到请求头结束，请求体（如果有）忽略
+        request.clear();
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+            const auto received = connection->receive(buffer, REQUEST_TIMEOUT_MS);
+            if (!received) {
+                break;
+            }
+            request.append(buffer.data(), *received);
+        }
+        const std::string_view line = std::string_view(request).substr(0, request.find("\r\n"));
+        if (line.starts_with("GET /metrics ") || line.starts_with("GET / ")) {
+            connection->sendAll(httpResponse("200 OK", "application/json", serializeLatest()));
+        } else if (!line.empty()) {
+            connection->sendAll(httpResponse("404 Not Found", "text/plain", "not found\n"));
+        }
+    }
+}
+
+} // namespace engine::core
@@ -0,0 +1,146 @@
+#pragma once
+/**
+ * @file metrics_server.h
+ * @brief 本机性能指标端点：后台线程在 127.0.0.1 上以 HTTP/JSON 提供最近一次采样的快照，供监控抓取。
+ *
+ * @details
+ * 默认关闭，config.json 的 performance.metrics_port 大于 0 时启用。
+ *
+ * - 采样：GameApp 每 SAMPLE_INTERVAL 在帧尾填写一份 MetricsSnapshot（beginSample / publish），
+ *   内容为分析器的逐作用域耗时、帧时间分位数、计数器（含 `evt.*` 事件通道的每秒速率）、
+ *   实体普查、内存标签与纹理显存汇总
+ * - 交接：三份快照轮换（三缓冲），帧线程写完后一次原子交换即发布，从不等待服务线程；
+ *   快照中的数组跨采样复用容量
+ * - 服务：后台线程逐个接受连接，`GET /metrics`（或 `/`）返回最新快照的 JSON，其他路径返回 404；
+ *   序列化在服务线程上进行，只访问它当前持有的那份快照
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace engine::io {
+class TcpListener;
+}
+
+namespace engine::core {
+
+/**
+ * @struct MetricsSnapshot
+ * @brief 一次采样的全部指标（除场景名外，名称均为静态或驻留字符串，快照内只保存视图）
+ */
+struct MetricsSnapshot {
+    struct Scope {
+        std::string_view name_;
+        double last_ms_{ 0.0 };
+        double p50_ms_{ 0.0 };
+        double p99_ms_{ 0.0 };
+        std::uint32_t calls_{ 0 };
+    };
+    struct Counter {
+        std::string_view name_;
+        std::int64_t value_{ 0 };           ///< 最近一帧的值
+        double per_second_{ 0.0 };          ///< 分析器历史帧内的合计 / 历史时长（`evt.*` 即事件速率）
+    };
+    struct Storage {
+        std::string_view name_;
+        std::size_t size_{ 0 };
+        std::size_t capacity_{ 0 };
+        std::size_t bytes_{ 0 };
+    };
+    struct MemoryTag {
+        std::string_view name_;
+        std::size_t bytes_{ 0 };
+        std::size_t budget_bytes_{ 0 };
+        bool over_budget_{ false };
+    };
+    struct TextureKind {
+        std::string_view kind_;
+        std::size_t count_{ 0 };
+        std::size_t bytes_{ 0 };
+    };
+
+    std::uint64_t sequence_{ 0 };           ///< 采样序号
+    double uptime_s_{ 0.0 };
+    std::string scene_;                     ///< 当前场景名（拷贝：场景可能先于服务线程的读取销毁）
+    // 帧时间
+    double frame_avg_ms_{ 0.0 };
+    double frame_p50_ms_{ 0.0 };
+    double frame_p95_ms_{ 0.0 };
+    double frame_p99_ms_{ 0.0 };
+    double frame_one_percent_low_ms_{ 0.0 };
+    double frame_max_ms_{ 0.0 };
+    std::size_t frame_samples_{ 0 };
+    std::vector<Scope> scopes_;
+    std::vector<Counter> counters_;
+    // 实体普查
+    std::size_t entities_{ 0 };
+    std::vector<Storage> storages_;
+    std::vector<MemoryTag> memory_;
+    std::vector<TextureKind> textures_;
+};
+
+/**
+ * @class MetricsServer
+ * @brief 指标快照的三缓冲与 HTTP 服务线程
+ */
+class MetricsServer final {
+public:
+    static constexpr std::chrono::milliseconds SAMPLE_INTERVAL{ 1000 };    ///< 帧线程的采样间隔
+    static constexpr int ACCEPT_TIMEOUT_MS = 200;       ///< 服务线程检查停止请求的间隔
+    static constexpr int REQUEST_TIMEOUT_MS = 1000;     ///< 读取请求头的最长等待
+    static constexpr std::size_t MAX_REQUEST_BYTES = 4096;
+
+    MetricsServer();
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /**
+     * @brief 监听 127.0.0.1:port 并启动服务线程
+     * @return 端口无法监听时返回 false（游戏照常运行，只是没有指标端点）
+     */
+    bool start(std::uint16_t port);
+    /// @brief 停止服务线程并关闭监听
+    void stop();
+
+    [[nodiscard]] bool isRunning() const { return thread_.joinable(); }
+
+    /// @brief 距上次发布是否已满 SAMPLE_INTERVAL（帧线程每帧调用，只做一次时间比较）
+    [[nodiscard]] bool isSampleDue(std::chrono::steady_clock::time_point now) const;
+
+    /// @brief 取得帧线程独占的快照（保留上一次写入该份时的数组容量）
+    [[nodiscard]] MetricsSnapshot& beginSample();
+    /// @brief 发布 beginSample() 返回的快照
+    void publish(std::chrono::steady_clock::time_point now);
+
+    /// @brief 服务线程：把最新快照序列化为 JSON（没有新发布时沿用手中的一份）
+    [[nodiscard]] std::string serializeLatest();
+
+private:
+    void serve();
+
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH_BIT = 0x4;      ///< 中间份是否为尚未被服务线程取走的新快照
+
+    std::array<MetricsSnapshot, 3> snapshots_;
+    std::uint8_t write_index_{ 0 };                     ///< 帧线程持有
+    std::atomic<std::uint8_t> middle_index_{ 1 };       ///< 交换位（低两位为下标，另含 FRESH_BIT）
+    std::uint8_t read_index_{ 2 };                      ///< 服务线程持有
+    std::uint64_t sequence_{ 0 };
+    std::chrono::steady_clock::time_point last_publish_{};
+
+    std::unique_ptr<engine::io::TcpListener> listener_;
+    std::thread thread_;
+    std::atomic<bool> stop_requested_{ false };
+};
+
+} // namespace engine::core
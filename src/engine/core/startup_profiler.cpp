@@ -0,0 +1,118 @@
+#include "startup_profiler.h"
+#include "../io/save_service.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+namespace engine::core {
+
+StartupProfiler& StartupProfiler::instance() {
+    static StartupProfiler profiler;
+    return profiler;
+}
+
+void StartupProfiler::beginRun() {
+    std::scoped_lock lock(mutex_);
+    current_.clear();
+    run_start_ = std::chrono::steady_clock::now();
+    scene_ready_.store(false, std::memory_order_relaxed);
+}
+
+void StartupProfiler::endRun() {
+    std::scoped_lock lock(mutex_);
+    runs_.push_back(std::move(current_));
+    current_.clear();
+}
+
+void StartupProfiler::addPhase(std::string_view name, double ms) {
+    add(name, Kind::PHASE, ms, true);
+}
+
+void StartupProfiler::mark(std::string_view name) {
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - run_start_;
+    add(name, Kind::MILESTONE, elapsed.count(), false);
+}
+
+void StartupProfiler::add(std::string_view name, Kind kind, double ms, bool accumulate) {
+    if (!isEnabled()) {
+        return;
+    }
+    std::scoped_lock lock(mutex_);
+    const auto it = std::ranges::find(current_, name, &Entry::name_);
+    if (it == current_.end()) {
+        current_.push_back(Entry{ std::string(name), kind, ms });
+    } else if (accumulate) {
+        it->ms_ += ms;
+    }
+}
+
+bool StartupProfiler::hasMark(std::string_view name) const {
+    std::scoped_lock lock(mutex_);
+    const auto it = std::ranges::find(current_, name, &Entry::name_);
+    return it != current_.end() && it->kind_ == Kind::MILESTONE;
+}
+
+std::size_t StartupProfiler::getRunCount() const {
+    std::scoped_lock lock(mutex_);
+    return runs_.size();
+}
+
+std::vector<StartupProfiler::Row> StartupProfiler::summarize() const {
+    std::scoped_lock lock(mutex_);
+    std::vector<Row> rows;
+    std::vector<std::size_t> warm_counts;
+    for (std::size_t run = 0; run < runs_.size(); ++run) {
+        for (const auto& entry : runs_[run]) {
+            auto it = std::ranges::find(rows, entry.name_, &Row::name_);
+            if (it == rows.end()) {
+                rows.push_back(Row{ entry.name_, entry.kind_ });
+                warm_counts.push_back(0);
+                it = rows.end() - 1;
+            }
+            auto& warm_count = warm_counts[static_cast<std::size_t>(it - rows.begin())];
+            ++it->samples_;
+            if (run == 0) {
+                it->first_ms_ = entry.ms_;
+                continue;
+            }
+            it->warm_min_ms_ = warm_count == 0 ? entry.ms_ : std::min(it->warm_min_ms_, entry.ms_);
+            it->warm_max_ms_ = std::max(it->warm_max_ms_, entry.ms_);
+            it->warm_mean_ms_ += entry.ms_;
+            ++warm_count;
+        }
+    }
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        if (warm_counts[i] > 0) {
+            rows[i].warm_mean_ms_ /= static_cast<double>(warm_counts[i]);
+        }
+    }
+    return rows;
+}
+
+bool StartupProfiler::writeReport(const std::string& path) const {
+    const auto rows = summarize();
+    const auto runs = getRunCount();
+    spdlog::info("启动耗时汇总（{} 次运行；首次为进程冷启动，其余为同进程重复）", runs);
+    spdlog::info("{:<32} {:>10} {:>10} {:>10} {:>10}", "阶段 / 里程碑", "首次 ms", "重复均值", "重复最小", "重复最大");
+    std::string csv = "name,kind,first_ms,warm_mean_ms,warm_min_ms,warm_max_ms,samples\n";
+    for (const auto& row : rows) {
+        const bool milestone = row.kind_ == Kind::MILESTONE;
+        spdlog::info("{:<32} {:>10.2f} {:>10.2f} {:>10.2f} {:>10.2f}{}", row.name_, row.first_ms_, row.warm_mean_ms_,
+                     row.warm_min_ms_, row.warm_max_ms_, milestone ? "  @" : "");
+        csv += fmt::format("{},{},{:.3f},{:.3f},{:.3f},{:.3f},{}\n", row.name_, milestone ? "milestone" : "phase", row.first_ms_,
+                           row.warm_mean_ms_, row.warm_min_ms_, row.warm_max_ms_, row.samples_);
+    }
+    if (path.empty()) {
+        return true;
+    }
+    std::string error_message;
+    if (!engine::io::writeRawFile(path, std::as_bytes(std::span(csv)), error_message)) {
+        spdlog::error("写入启动耗时报告失败: {}", error_message);
+        return false;
+    }
+    spdlog::info("启动耗时报告已写入: {}", path);
+    return true;
+}
+
+} // namespace engine::core
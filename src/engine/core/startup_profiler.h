@@ -0,0 +1,132 @@
+#pragma once
+/**
+ * @file startup_profiler.h
+ * @brief 启动与关卡加载的分阶段计时（--profile-startup）：多次冷/热启动的各阶段耗时汇总为一张表。
+ *
+ * @details
+ * 进程级单例，默认关闭；关闭时 ENGINE_STARTUP_PHASE 只做一次原子读取。每次运行（beginRun / endRun）记录两类数据：
+ * - 阶段（PHASE）：作用域耗时，同名阶段在一次运行内累加（如逐个 tileset 的解析），可在任意线程记录
+ * - 里程碑（MILESTONE）：相对本次运行开始的时刻，如首帧呈现、图集就绪
+ *
+ * 第一次运行是进程冷启动（内容缓存为空、SDL 首次初始化），之后的运行在同一进程内重复，磁盘缓存已热。
+ * 需要冷磁盘缓存的数据时先清空系统文件缓存再启动进程，只看第一列。
+ *
+ * @code
+ * {
+ *     ENGINE_STARTUP_PHASE("level.json_parse");
+ *     ...
+ * }
+ * engine::core::StartupProfiler::instance().mark("t.first_frame");
+ * @endcode
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::core {
+
+class StartupProfiler final {
+public:
+    enum class Kind {
+        PHASE,
+        MILESTONE,
+    };
+
+    /// @brief 汇总表的一行
+    struct Row {
+        std::string name_;
+        Kind kind_{Kind::PHASE};
+        double first_ms_{0.0};          ///< 第一次运行（进程冷启动）
+        double warm_mean_ms_{0.0};      ///< 其后各次运行的均值（只有一次运行时为 0）
+        double warm_min_ms_{0.0};
+        double warm_max_ms_{0.0};
+        std::size_t samples_{0};        ///< 记录到该项的运行次数
+    };
+
+    static StartupProfiler& instance();
+
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    [[nodiscard]] bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /// @brief 开始一次运行（以调用时刻为里程碑的零点）
+    void beginRun();
+    /// @brief 结束本次运行并归档
+    void endRun();
+
+    /// @brief 累加一个阶段的耗时（线程安全）
+    void addPhase(std::string_view name, double ms);
+    /// @brief 记下一个里程碑（本次运行已记过同名里程碑时忽略）
+    void mark(std::string_view name);
+
+    /// @brief 场景加载完成，下一次呈现的帧即本关首帧（由 GameScene::init 调用）
+    void notifySceneReady() { scene_ready_.store(true, std::memory_order_relaxed); }
+    /// @brief 取走本次运行的「场景已就绪」标记
+    [[nodiscard]] bool consumeSceneReady() { return scene_ready_.exchange(false, std::memory_order_relaxed); }
+
+    /// @brief 本次运行是否已记下该里程碑
+    [[nodiscard]] bool hasMark(std::string_view name) const;
+    [[nodiscard]] std::size_t getRunCount() const;
+    /// @brief 按首次出现的顺序汇总全部运行
+    [[nodiscard]] std::vector<Row> summarize() const;
+
+    /// @brief 把汇总表写入日志，并以 CSV 写到 path（为空时只写日志）
+    bool writeReport(const std::string& path) const;
+
+private:
+    StartupProfiler() = default;
+
+    struct Entry {
+        std::string name_;
+        Kind kind_{Kind::PHASE};
+        double ms_{0.0};
+    };
+
+    void add(std::string_view name, Kind kind, double ms, bool accumulate);
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<bool> scene_ready_{false};
+    mutable std::mutex mutex_;
+    std::chrono::steady_clock::time_point run_start_{};
+    std::vector<Entry> current_;
+    std::vector<std::vector<Entry>> runs_;
+};
+
+/**
+ * @class ScopedStartupPhase
+ * @brief 作用域结束时把耗时记入当前运行（未启用时不读时钟）
+ */
+class ScopedStartupPhase final {
+public:
+    explicit ScopedStartupPhase(const char* name)
+        : name_(StartupProfiler::instance().isEnabled() ? name : nullptr) {
+        if (name_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    ~ScopedStartupPhase() {
+        if (name_) {
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_;
+            StartupProfiler::instance().addPhase(name_, elapsed.count());
+        }
+    }
+
+    ScopedStartupPhase(const ScopedStartupPhase&) = delete;
+    ScopedStartupPhase& operator=(const ScopedStartupPhase&) = delete;
+
+private:
+    const char* name_;
+    std::chrono::steady_clock::time_point start_{};
+};
+
+} // namespace engine::core
+
+#define ENGINE_STARTUP_PHASE_CONCAT_INNER(a, b) a##b
+#define ENGINE_STARTUP_PHASE_CONCAT(a, b) ENGINE_STARTUP_PHASE_CONCAT_INNER(a, b)
+/// @brief 记录所在作用域的启动阶段耗时（名称须为静态生命周期字符串）
+#define ENGINE_STARTUP_PHASE(name) \
+    ::engine::core::ScopedStartupPhase ENGINE_STARTUP_PHASE_CONCAT(engine_startup_phase_, __LINE__)(name)
@@ -0,0 +1,409 @@
+#include "system_scheduler.h"
+#include "job_system.h"
+#include "../utils/profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+namespace {
+
+/// @brief "struct game::component::TargetComponent" -> "TargetComponent"
+std::string_view shortTypeName(std::string_view name) {
+    if (const auto pos = name.rfind("::"); pos != std::string_view::npos) {
+        name.remove_prefix(pos + 2);
+    } else if (const auto space = name.rfind(' '); space != std::string_view::npos) {
+        name.remove_prefix(space + 1);
+    }
+    return name;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief 启动时由配置写入，只在主线程上读写
+std::unordered_map<std::string, float>& configuredRates() {
+    static std::unordered_map<std::string, float> rates_hz;
+    return rates_hz;
+}
+
+} // namespace
+
+void ScheduleTiming::record(double ms) {
+    ++runs_;
+    total_ms_ += ms;
+    max_ms_ = std::max(max_ms_, ms);
+}
+
+bool TickRate::isDueIn(std::uint64_t begin, std::uint64_t end) const {
+    if (begin >= end) {
+        return false;
+    }
+    if (interval_ <= 1) {
+        return true;
+    }
+    const std::uint64_t to_next = (phase_ + interval_ - begin % interval_) % interval_;
+    return begin + to_next < end;
+}
+
+SystemScheduler::SystemBuilder& SystemScheduler::SystemBuilder::exclusive() {
+    scheduler_->systems_[index_].exclusive_ = true;
+    return *this;
+}
+
+SystemScheduler::SystemBuilder& SystemScheduler::SystemBuilder::after(std::string name) {
+    scheduler_->systems_[index_].after_names_.push_back(std::move(name));
+    return *this;
+}
+
+SystemScheduler::SystemBuilder& SystemScheduler::SystemBuilder::runIf(Condition condition) {
+    scheduler_->systems_[index_].condition_ = std::move(condition);
+    return *this;
+}
+
+SystemScheduler::SystemBuilder& SystemScheduler::SystemBuilder::throttleable() {
+    scheduler_->systems_[index_].throttleable_ = true;
+    return *this;
+}
+
+SystemScheduler::SystemBuilder SystemScheduler::add(std::string name, Run run) {
+    built_ = false;
+    auto& system = systems_.emplace_back();
+    system.name_ = std::move(name);
+    system.run_ = std::move(run);
+    return SystemBuilder(*this, systems_.size() - 1);
+}
+
+void SystemScheduler::addExternalRate(std::string name) {
+    built_ = false;
+    external_rates_.push_back(ExternalRate{ std::move(name) });
+}
+
+void SystemScheduler::setConfiguredRates(std::unordered_map<std::string, float> rates_hz) {
+    configuredRates() = std::move(rates_hz);
+}
+
+TickRate SystemScheduler::getRate(std::string_view name) const {
+    if (const auto it = std::ranges::find(systems_, name, &System::name_); it != systems_.end()) {
+        return it->rate_;
+    }
+    if (const auto it = std::ranges::find(external_rates_, name, &ExternalRate::name_); it != external_rates_.end()) {
+        return it->rate_;
+    }
+    return {};
+}
+
+void SystemScheduler::assignRates() {
+    const auto& rates_hz = configuredRates();
+    const auto intervalFor = [this, &rates_hz](const std::string& name) -> std::uint32_t {
+        const auto it = rates_hz.find(name);
+        if (it == rates_hz.end() || tick_hz_ <= 0.0f || it->second <= 0.0f || it->second >= tick_hz_) {
+            return 1;
+        }
+        return static_cast<std::uint32_t>(std::max(1L, std::lround(tick_hz_ / it->second)));
+    };
+
+    // 两个降频条目 (i, p) 与 (j, q) 在 p ≡ q (mod gcd(i, j)) 时每 lcm(i, j) 步重叠一次，否则从不重叠；
+    // 按登记顺序逐个选择与已放置条目重叠最少的相位（相同时取最小的相位）
+    std::vector<const TickRate*> placed;
+    const auto place = [&placed](TickRate& rate, std::uint32_t interval) {
+        rate = TickRate{ interval, 0 };
+        if (interval <= 1) {
+            return;
+        }
+        double best_overlap = std::numeric_limits<double>::max();
+        for (std::uint32_t phase = 0; phase < interval; ++phase) {
+            double overlap = 0.0;
+            for (const auto* other : placed) {
+                const auto common = std::gcd(interval, other->interval_);
+                if (phase % common == other->phase_ % common) {
+                    overlap += 1.0 / static_cast<double>(std::lcm(interval, other->interval_));
+                }
+            }
+            if (overlap < best_overlap) {
+                best_overlap = overlap;
+                rate.phase_ = phase;
+            }
+        }
+        placed.push_back(&rate);
+    };
+
+    for (auto& system : systems_) {
+        const auto interval = intervalFor(system.name_);
+        if (interval > 1 && !system.throttleable_) {
+            spdlog::warn("系统调度: {} 影响模拟结果，不能降频，忽略配置的频率", system.name_);
+            system.rate_ = {};
+            continue;
+        }
+        place(system.rate_, interval);
+    }
+    for (auto& external : external_rates_) {
+        place(external.rate_, intervalFor(external.name_));
+    }
+}
+
+bool SystemScheduler::conflicts(const System& lhs, const System& rhs, std::string_view* conflict) {
+    if (lhs.exclusive_ || rhs.exclusive_) {
+        if (conflict) {
+            *conflict = "独占";
+        }
+        return true;
+    }
+    for (const auto& a : lhs.accesses_) {
+        for (const auto& b : rhs.accesses_) {
+            if (a.type_ == b.type_ && a.kind_ == b.kind_ && (a.write_ || b.write_)) {
+                if (conflict) {
+                    *conflict = shortTypeName(a.name_);
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool SystemScheduler::build(entt::registry& registry) {
+    built_ = false;
+    warmed_up_ = false;
+    stages_.clear();
+    const std::size_t count = systems_.size();
+
+    auto findSystem = [this](std::string_view name) {
+        return static_cast<std::size_t>(std::ranges::find(systems_, name, &System::name_) - systems_.begin());
+    };
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& system = systems_[i];
+        if (findSystem(system.name_) != i) {
+            spdlog::error("系统调度: 系统名重复: {}", system.name_);
+            return false;
+        }
+        system.after_.clear();
+        for (const auto& name : system.after_names_) {
+            const std::size_t index = findSystem(name);
+            if (index == count || index == i) {
+                spdlog::error("系统调度: {} 的 after() 引用了不存在的系统 {}", system.name_, name);
+                return false;
+            }
+            system.after_.push_back(index);
+        }
+    }
+
+    // 前驱：先登记的冲突系统 + 显式约束
+    std::vector<std::vector<std::size_t>> predecessors(count);
+    std::vector<std::vector<std::size_t>> successors(count);
+    for (std::size_t j = 0; j < count; ++j) {
+        for (std::size_t i = 0; i < j; ++i) {
+            if (conflicts(systems_[i], systems_[j])) {
+                predecessors[j].push_back(i);
+            }
+        }
+        for (const auto index : systems_[j].after_) {
+            if (std::ranges::find(predecessors[j], index) == predecessors[j].end()) {
+                predecessors[j].push_back(index);
+            }
+        }
+        for (const auto index : predecessors[j]) {
+            successors[index].push_back(j);
+        }
+    }
+
+    // Kahn 拓扑排序，层级 = 最长前驱链长度；就绪的系统按登记顺序处理
+    std::vector<std::size_t> pending(count);
+    for (std::size_t j = 0; j < count; ++j) {
+        pending[j] = predecessors[j].size();
+        systems_[j].stage_ = 0;
+    }
+    std::vector<bool> done(count, false);
+    std::size_t processed = 0;
+    std::size_t stage_count = 0;
+    for (bool progressed = true; progressed;) {
+        progressed = false;
+        for (std::size_t j = 0; j < count; ++j) {
+            if (done[j] || pending[j] > 0) {
+                continue;
+            }
+            done[j] = true;
+            progressed = true;
+            ++processed;
+            auto& system = systems_[j];
+            system.wait_reason_.clear();
+            std::size_t reason_index = count;
+            for (const auto index : predecessors[j]) {
+                if (reason_index == count || systems_[index].stage_ > systems_[reason_index].stage_) {
+                    reason_index = index;
+                }
+            }
+            if (reason_index != count) {
+                system.stage_ = systems_[reason_index].stage_ + 1;
+                std::string_view conflict;
+                if (!conflicts(systems_[reason_index], system, &conflict)) {
+                    conflict = "after";
+                }
+                system.wait_reason_ = std::format("{}: {}", systems_[reason_index].name_, conflict);
+            }
+            stage_count = std::max(stage_count, system.stage_ + 1);
+            for (const auto next : successors[j]) {
+                --pending[next];
+            }
+        }
+    }
+    if (processed != count) {
+        std::string cycle;
+        for (std::size_t j = 0; j < count; ++j) {
+            if (!done[j]) {
+                cycle += cycle.empty() ? systems_[j].name_ : ", " + systems_[j].name_;
+            }
+        }
+        spdlog::error("系统调度: after() 约束与登记顺序成环: {}", cycle);
+        return false;
+    }
+
+    auto& profiler = engine::utils::Profiler::instance();
+    stages_.resize(stage_count);
+    std::size_t widest = 0;
+    for (std::size_t j = 0; j < count; ++j) {
+        auto& system = systems_[j];
+        auto& stage = stages_[system.stage_];
+        stage.systems_.push_back(j);
+        widest = std::max(widest, stage.systems_.size());
+        system.profile_name_ = profiler.internName(system.name_);
+        system.timing_ = {};
+        for (const auto assure : system.assure_) {
+            assure(registry);
+        }
+    }
+    for (std::size_t s = 0; s < stage_count; ++s) {
+        stages_[s].profile_name_ = profiler.internName(std::format("Stage {}", s + 1));
+    }
+    assignRates();
+    active_.clear();
+    active_.reserve(widest);
+    tick_ = 0;
+    built_ = true;
+    return true;
+}
+
+void SystemScheduler::runSystem(std::size_t index) {
+    auto& system = systems_[index];
+    ENGINE_PROFILE_SCOPE_INTERNED(system.profile_name_);
+    const auto start = std::chrono::steady_clock::now();
+    system.run_(system.commands_);
+    system.last_ms_ = elapsedMs(start);
+    system.timing_.record(system.last_ms_);
+}
+
+void SystemScheduler::run(entt::registry& registry) {
+    if (!built_) {
+        return;
+    }
+    auto* jobs = registry.ctx().contains<JobSystem&>() ? &registry.ctx().get<JobSystem&>() : nullptr;
+    const bool parallel = warmed_up_ && jobs && jobs->getThreadCount() > 1 && !JobSystem::isInsideJob();
+
+    for (auto& stage : stages_) {
+        ENGINE_PROFILE_SCOPE_INTERNED(stage.profile_name_);
+        const auto start = std::chrono::steady_clock::now();
+        active_.clear();
+        for (const auto index : stage.systems_) {
+            const auto& system = systems_[index];
+            if (system.rate_.isDue(tick_) && (!system.condition_ || system.condition_())) {
+                active_.push_back(index);
+            }
+        }
+        if (active_.empty()) {
+            continue;
+        }
+
+        if (parallel && active_.size() > 1) {
+            jobs->parallelFor(active_.size(), [this](std::size_t i) { runSystem(active_[i]); });
+        } else {
+            for (const auto index : active_) {
+                runSystem(index);
+            }
+        }
+
+        // 按登记顺序提交，与串行执行的修改顺序一致
+        double serial_ms = 0.0;
+        for (const auto index : active_) {
+            auto& system = systems_[index];
+            system.commands_.apply(registry);
+            serial_ms += system.last_ms_;
+        }
+        stage.timing_.record(elapsedMs(start));
+        stage.serial_timing_.record(serial_ms);
+    }
+    ++tick_;
+    warmed_up_ = true;
+}
+
+std::string SystemScheduler::describe() const {
+    std::string text = std::format("系统调度: {} 个系统，{} 个阶段", systems_.size(), stages_.size());
+    for (std::size_t s = 0; s < stages_.size(); ++s) {
+        text += std::format("\n  阶段 {:>2}:", s + 1);
+        for (const auto index : stages_[s].systems_) {
+            const auto& system = systems_[index];
+            text += std::format(" {}{}", system.name_, system.condition_ ? "（条件）" : "");
+            if (system.rate_.interval_ > 1) {
+                text += std::format("（每 {} 步，相位 {}）", system.rate_.interval_, system.rate_.phase_);
+            }
+            if (!system.wait_reason_.empty()) {
+                text += std::format(" [等待 {}]", system.wait_reason_);
+            }
+        }
+    }
+    for (const auto& external : external_rates_) {
+        if (external.rate_.interval_ > 1) {
+            text += std::format("\n  场景内: {}（每 {} 步，相位 {}）", external.name_, external.rate_.interval_, external.rate_.phase_);
+        }
+    }
+    return text;
+}
+
+void SystemScheduler::logSchedule() const {
+    spdlog::info("{}", describe());
+}
+
+void SystemScheduler::logTimings() const {
+    std::uint64_t steps = 0;
+    double total_ms = 0.0;
+    double serial_ms = 0.0;
+    for (const auto& stage : stages_) {
+        steps = std::max(steps, stage.timing_.runs_);
+        total_ms += stage.timing_.total_ms_;
+        serial_ms += stage.serial_timing_.total_ms_;
+    }
+    if (steps == 0) {
+        return;
+    }
+    // 条件执行的阶段运行次数较少，按步数而不是各阶段平均值求和
+    spdlog::info("系统调度耗时: 每步平均 {:.3f} ms（各系统串行合计 {:.3f} ms），{} 步",
+                 total_ms / static_cast<double>(steps), serial_ms / static_cast<double>(steps), steps);
+    for (std::size_t s = 0; s < stages_.size(); ++s) {
+        const auto& stage = stages_[s];
+        spdlog::info("  阶段 {:>2}: 平均 {:7.3f} ms  最大 {:7.3f} ms  系统合计 {:7.3f} ms", s + 1,
+                     stage.timing_.averageMs(), stage.timing_.max_ms_, stage.serial_timing_.averageMs());
+        for (const auto index : stage.systems_) {
+            const auto& system = systems_[index];
+            spdlog::info("    {:<24} 平均 {:7.3f} ms  最大 {:7.3f} ms  x{}", system.name_,
+                         system.timing_.averageMs(), system.timing_.max_ms_, system.timing_.runs_);
+        }
+    }
+}
+
+void SystemScheduler::resetTimings() {
+    for (auto& stage : stages_) {
+        stage.timing_ = {};
+        stage.serial_timing_ = {};
+    }
+    for (auto& system : systems_) {
+        system.timing_ = {};
+    }
+}
+
+} // namespace engine::core
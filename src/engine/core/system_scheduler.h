@@ -0,0 +1,234 @@
+#pragma once
+/**
+ * @file system_scheduler.h
+ * @brief 声明式系统调度器：系统声明读写的组件与资源，调度器据此排出阶段，互不冲突的系统在线程池上并行执行。
+ *
+ * @details
+ * 每个系统登记一个回调与它访问的数据：
+ * - reads<T...>() / writes<T...>()：组件存储；经 CommandBuffer 延迟添加/移除的组件同样算作写
+ * - readsResource<T...>() / writesResource<T...>()：注册表上下文变量、dispatcher 等共享对象（只用作类型标记）
+ * - exclusive()：立即创建/销毁实体、立即触发带监听者的信号等无法逐类型声明的修改，与其他所有系统互斥
+ * - after(name)：与数据无关的显式先后约束
+ * - runIf(condition)：本步是否执行（不执行的系统仍占据自己的阶段，不改变排程）
+ * - throttleable()：只影响表现、降频不改变模拟结果的系统，可按配置的频率每 N 步执行一次
+ *
+ * 两个系统访问同一类型且至少一方写入即为冲突，冲突的系统按登记顺序先后执行；
+ * 其余系统按依赖图的拓扑层级分入阶段，同一阶段内的系统互不冲突，经 JobSystem::parallelFor 并行执行。
+ * 每个系统有自己的 CommandBuffer，阶段结束后在调用线程上按登记顺序提交。
+ * 因此只要声明完整，结果与按登记顺序串行执行完全一致（与线程数无关），回放与检查点不受影响。
+ *
+ * 声明须覆盖信号监听者的访问：例如 patch<TransformComponent> 会经 YSortSystem 的信号写入其脏集合，
+ * 调用方要同时声明 writesResource<YSortSystem>()。上下文变量的插入是结构性修改，须在 build() 之前完成，
+ * 系统内只能 get/find 或对已存在的变量 insert_or_assign。
+ *
+ * 并行阶段内的系统运行在任务中，其内部的 parallelEach 退化为串行（见 JobSystem::isInsideJob）；
+ * 只有一个系统的阶段在调用线程上执行，内部仍可分块并行。build() 在主线程上建立声明过的组件存储，
+ * 第一次 run() 整体串行执行，未声明（如只出现在 exclude 中）的存储也在主线程上建立，之后才开始并行。
+ *
+ * 降频：performance.system_rates_hz（setConfiguredRates）按名字给出频率，build() 按 setTickHz() 的步频换算成间隔步数，
+ * 并为降频的系统自动选择相位，使间隔相同或成倍数的系统尽量不落在同一步。场景中按帧执行、不经调度器的系统
+ * （血条、悬停拾取）以 addExternalRate() 登记后参与相位分配，用 getRate() 取得结果并按 getTick() 判断。
+ * 模拟相关的系统不能标记 throttleable()：无头模拟与回放按全频执行它们，降频会在配置不同的机器间失去同步。
+ *
+ * @code
+ * scheduler.add("MovementSystem", [this](engine::ecs::CommandBuffer&) { movement_system_->update(registry_, dt_); })
+ *     .reads<VelocityComponent>()
+ *     .writes<TransformComponent>();
+ * scheduler.add("SpatialIndexSystem", [this](engine::ecs::CommandBuffer&) { spatial_index_system_->update(registry_); })
+ *     .reads<TransformComponent, EnemyComponent>()
+ *     .writesResource<engine::spatial::SpatialGrid>();
+ * if (!scheduler.build(registry_)) { ... }
+ * scheduler.logSchedule();
+ * scheduler.run(registry_);          // 每个模拟步一次
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <entt/core/type_info.hpp>
+#include <entt/entity/registry.hpp>
+#include "../ecs/command_buffer.h"
+
+namespace engine::core {
+
+/// @brief 一个阶段或系统的累计耗时
+struct ScheduleTiming {
+    std::uint64_t runs_{ 0 };
+    double total_ms_{ 0.0 };
+    double max_ms_{ 0.0 };
+
+    [[nodiscard]] double averageMs() const { return runs_ > 0 ? total_ms_ / static_cast<double>(runs_) : 0.0; }
+    void record(double ms);
+};
+
+/// @brief 降频系统的执行步：tick % interval_ == phase_
+struct TickRate {
+    std::uint32_t interval_{ 1 };
+    std::uint32_t phase_{ 0 };
+
+    [[nodiscard]] bool isDue(std::uint64_t tick) const { return interval_ <= 1 || tick % interval_ == phase_; }
+    /// @brief [begin, end) 中是否有执行步（按帧检查的调用方用上次检查时的 getTick() 作 begin）
+    [[nodiscard]] bool isDueIn(std::uint64_t begin, std::uint64_t end) const;
+};
+
+class SystemScheduler final {
+public:
+    using Run = std::function<void(ecs::CommandBuffer&)>;
+    using Condition = std::function<bool()>;
+
+    /// @brief add() 返回的声明接口，在 build() 之前使用
+    class SystemBuilder {
+    public:
+        template <typename... Components>
+        SystemBuilder& reads() {
+            (scheduler_->addComponentAccess<Components>(index_, false), ...);
+            return *this;
+        }
+        template <typename... Components>
+        SystemBuilder& writes() {
+            (scheduler_->addComponentAccess<Components>(index_, true), ...);
+            return *this;
+        }
+        template <typename... Resources>
+        SystemBuilder& readsResource() {
+            (scheduler_->addResourceAccess<Resources>(index_, false), ...);
+            return *this;
+        }
+        template <typename... Resources>
+        SystemBuilder& writesResource() {
+            (scheduler_->addResourceAccess<Resources>(index_, true), ...);
+            return *this;
+        }
+        SystemBuilder& exclusive();
+        /// @brief 在名为 name 的系统之后执行（可引用稍后登记的系统）
+        SystemBuilder& after(std::string name);
+        SystemBuilder& runIf(Condition condition);
+        /// @brief 允许按配置降频（只用于不影响模拟结果的系统）
+        SystemBuilder& throttleable();
+
+    private:
+        friend class SystemScheduler;
+        SystemBuilder(SystemScheduler& scheduler, std::size_t index) : scheduler_(&scheduler), index_(index) {}
+
+        SystemScheduler* scheduler_;
+        std::size_t index_;
+    };
+
+    /// @brief 一个阶段：互不冲突的系统（登记下标，升序）
+    struct Stage {
+        std::vector<std::size_t> systems_;
+        const char* profile_name_{ nullptr };
+        ScheduleTiming timing_;             ///< 阶段墙钟耗时（含提交命令）
+        ScheduleTiming serial_timing_;      ///< 阶段内各系统耗时之和，与 timing_ 对比即并行收益
+    };
+
+    /// @brief 登记系统（名字唯一）；登记顺序即冲突系统的执行顺序
+    SystemBuilder add(std::string name, Run run);
+
+    /// @brief 登记不经调度器执行、但按配置降频并参与相位分配的名字（build() 之前）
+    void addExternalRate(std::string name);
+
+    /// @brief 各系统的目标频率（Hz，按名字），启动时由配置设置；之后 build() 的调度器生效
+    static void setConfiguredRates(std::unordered_map<std::string, float> rates_hz);
+
+    /// @brief run() 的调用频率（固定步长模拟频率），不大于 0 时不降频
+    void setTickHz(float tick_hz) { tick_hz_ = tick_hz; }
+
+    /**
+     * @brief 解析约束、排出阶段并建立声明过的组件存储
+     * @return 名字重复、after() 引用不存在的系统或约束成环时返回 false（记录错误日志）
+     */
+    [[nodiscard]] bool build(entt::registry& registry);
+
+    /// @brief 依次执行各阶段，须在 build() 成功之后、由主线程调用
+    void run(entt::registry& registry);
+
+    [[nodiscard]] bool isBuilt() const { return built_; }
+    [[nodiscard]] std::size_t getSystemCount() const { return systems_.size(); }
+    [[nodiscard]] const std::vector<Stage>& getStages() const { return stages_; }
+    /// @brief 已执行的 run() 次数
+    [[nodiscard]] std::uint64_t getTick() const { return tick_; }
+    /// @brief 系统或 addExternalRate() 名字的执行步（未降频或不存在时为每步执行）
+    [[nodiscard]] TickRate getRate(std::string_view name) const;
+
+    /// @brief 排程文本：每个阶段一行，列出阶段内的系统及各自等待的前驱
+    [[nodiscard]] std::string describe() const;
+    void logSchedule() const;
+    /// @brief 输出各阶段与系统的平均/最大耗时
+    void logTimings() const;
+    void resetTimings();
+
+private:
+    enum class AccessKind : std::uint8_t { COMPONENT, RESOURCE };
+
+    struct Access {
+        entt::id_type type_{ 0 };
+        std::string_view name_;
+        AccessKind kind_{ AccessKind::COMPONENT };
+        bool write_{ false };
+    };
+
+    struct System {
+        std::string name_;
+        const char* profile_name_{ nullptr };
+        Run run_;
+        Condition condition_;
+        std::vector<Access> accesses_;
+        std::vector<void (*)(entt::registry&)> assure_;     ///< 在主线程上建立声明过的组件存储
+        std::vector<std::string> after_names_;
+        std::vector<std::size_t> after_;
+        std::size_t stage_{ 0 };
+        std::string wait_reason_;               ///< 排在当前阶段的原因：层级最高的前驱与冲突类型
+        ecs::CommandBuffer commands_;
+        ScheduleTiming timing_;
+        double last_ms_{ 0.0 };
+        TickRate rate_;
+        bool exclusive_{ false };
+        bool throttleable_{ false };
+    };
+
+    struct ExternalRate {
+        std::string name_;
+        TickRate rate_;
+    };
+
+    template <typename T>
+    static void assureStorage(entt::registry& registry) {
+        static_cast<void>(registry.storage<T>());
+    }
+
+    template <typename T>
+    void addComponentAccess(std::size_t index, bool write) {
+        auto& system = systems_[index];
+        system.accesses_.push_back(Access{ entt::type_hash<T>::value(), entt::type_name<T>::value(), AccessKind::COMPONENT, write });
+        system.assure_.push_back(&assureStorage<T>);
+    }
+
+    template <typename T>
+    void addResourceAccess(std::size_t index, bool write) {
+        systems_[index].accesses_.push_back(Access{ entt::type_hash<T>::value(), entt::type_name<T>::value(), AccessKind::RESOURCE, write });
+    }
+
+    /// @brief 两个系统是否不能同时执行；conflict 非空时写入第一个冲突的类型名
+    [[nodiscard]] static bool conflicts(const System& lhs, const System& rhs, std::string_view* conflict = nullptr);
+    /// @brief 执行单个系统并计时（可能在工作线程上）
+    void runSystem(std::size_t index);
+    /// @brief 按配置的频率换算间隔，并为降频的条目错开相位
+    void assignRates();
+
+    std::vector<System> systems_;
+    std::vector<ExternalRate> external_rates_;
+    std::vector<Stage> stages_;
+    std::vector<std::size_t> active_;       ///< 当前阶段本步执行的系统（复用容量）
+    float tick_hz_{ 0.0f };
+    std::uint64_t tick_{ 0 };
+    bool built_{ false };
+    bool warmed_up_{ false };               ///< 第一次 run() 串行执行之后为 true
+};
+
+} // namespace engine::core
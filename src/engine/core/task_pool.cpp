@@ -0,0 +1,133 @@
+#include "task_pool.h"
+#include "../utils/profiler.h"
+
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <spdlog/spdlog.h>
+
+namespace engine::core {
+
+std::size_t TaskPool::defaultWorkerCount() {
+    return std::clamp<std::size_t>(std::thread::hardware_concurrency() / 4, 2, 4);
+}
+
+TaskPool::TaskPool(std::size_t worker_count) {
+    workers_.reserve(worker_count);
+    for (std::size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&TaskPool::workerLoop, this, i);
+    }
+    spdlog::info("TaskPool 启动: {} 个工作线程", worker_count);
+}
+
+TaskPool::~TaskPool() {
+    shutdown();
+}
+
+void TaskPool::enqueue(TaskPriority priority, Task task) {
+    {
+        std::lock_guard lock(mutex_);
+        if (!stopping_ && !workers_.empty()) {
+            (priority == TaskPriority::FRAME ? frame_tasks_ : background_tasks_).push_back(std::move(task));
+            wake_cv_.notify_one();
+            return;
+        }
+    }
+    task();
+}
+
+void TaskPool::workerLoop([[maybe_unused]] std::size_t worker_index) {
+    ENGINE_PROFILE_THREAD_NAME(("TaskPool worker " + std::to_string(worker_index)).c_str());
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock(mutex_);
+            wake_cv_.wait(lock, [this] { return stopping_ || !frame_tasks_.empty() || !background_tasks_.empty(); });
+            auto& queue = !frame_tasks_.empty() ? frame_tasks_ : background_tasks_;
+            if (queue.empty()) {
+                return;     // 已停止且队列已清空
+            }
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        task();
+    }
+}
+
+void TaskPool::postToMainThread(Task task) {
+    {
+        std::lock_guard lock(main_mutex_);
+        if (main_closed_) {
+            return;
+        }
+        main_tasks_.push_back(std::move(task));
+    }
+    main_cv_.notify_one();
+}
+
+std::size_t TaskPool::drainMainThread(std::chrono::microseconds budget) {
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t available = 0;
+    {
+        std::lock_guard lock(main_mutex_);
+        available = main_tasks_.size();
+    }
+    std::size_t executed = 0;
+    while (executed < available && (executed == 0 || std::chrono::steady_clock::now() - start < budget)) {
+        Task task;
+        {
+            std::lock_guard lock(main_mutex_);
+            if (main_tasks_.empty()) {
+                break;
+            }
+            task = std::move(main_tasks_.front());
+            main_tasks_.pop_front();
+        }
+        try {
+            task();
+        } catch (const std::exception& e) {
+            spdlog::error("主线程任务抛出异常: {}", e.what());
+        }
+        ++executed;
+    }
+    ENGINE_PROFILE_COUNTER("tasks.main_queued", static_cast<std::int64_t>(getMainThreadQueuedCount()));
+    ENGINE_PROFILE_COUNTER("tasks.queued", static_cast<std::int64_t>(getQueuedCount()));
+    return executed;
+}
+
+bool TaskPool::waitForMainThreadTask(std::chrono::milliseconds timeout) {
+    std::unique_lock lock(main_mutex_);
+    return main_cv_.wait_for(lock, timeout, [this] { return main_closed_ || !main_tasks_.empty(); }) && !main_tasks_.empty();
+}
+
+void TaskPool::shutdown() {
+    {
+        std::lock_guard lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    wake_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    {
+        std::lock_guard lock(main_mutex_);
+        main_closed_ = true;
+        main_tasks_.clear();
+    }
+    main_cv_.notify_all();
+}
+
+std::size_t TaskPool::getQueuedCount() const {
+    std::lock_guard lock(mutex_);
+    return frame_tasks_.size() + background_tasks_.size();
+}
+
+std::size_t TaskPool::getMainThreadQueuedCount() const {
+    std::lock_guard lock(main_mutex_);
+    return main_tasks_.size();
+}
+
+} // namespace engine::core
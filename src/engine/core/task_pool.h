@@ -0,0 +1,145 @@
+#pragma once
+/**
+ * @file task_pool.h
+ * @brief 常驻的异步任务线程池（替代 std::async）与每帧清空一次的主线程任务队列。
+ *
+ * @details
+ * JobSystem 负责帧内的数据并行（parallelFor 阻塞到全部完成）；TaskPool 负责跨帧的异步工作：
+ * 关卡与配置解析、图片/音频解码等。每次 std::async 都新建并销毁一个线程，TaskPool 的线程在启动时创建、
+ * 退出时回收，提交只是一次入队。
+ *
+ * - 两档优先级：FRAME 是当前帧正在等待的工作（进入场景时的加载、主线程阻塞等待的图集解码），
+ *   BACKGROUND 是预取与流式加载；工作线程总是先取 FRAME 队列
+ * - submit() 返回 std::future，可直接交给 engine::utils::consumeFuture；与 std::async 不同，
+ *   future 析构时不等待任务结束，任务捕获了调用方对象时由调用方在析构前自行 wait()
+ * - submitThen() 任务完成后把续体投递到主线程队列；postToMainThread() 任意线程投递，
+ *   GameApp 每帧在场景更新前调用一次 drainMainThread()，在预算内执行（SDL 纹理上传等只能在渲染线程做的事）
+ *
+ * 任务不要阻塞等待同一线程池中的其他任务（工作线程数有限，可能互相等待）。
+ *
+ * @code
+ * auto& tasks = context.getTaskPool();
+ * future_ = tasks.submit(engine::core::TaskPriority::BACKGROUND, [path] { return parse(path); });
+ * tasks.submitThen(engine::core::TaskPriority::BACKGROUND, [path] { return decode(path); },
+ *                  [this, id] { upload(id); });          // 解码完成后在主线程上执行
+ * @endcode
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace engine::core {
+
+/// @brief 任务优先级
+enum class TaskPriority : std::uint8_t {
+    FRAME,          ///< 当前帧正在等待结果
+    BACKGROUND,     ///< 预取、流式加载等可以稍后完成的工作
+};
+
+class TaskPool final {
+public:
+    using Task = std::function<void()>;
+
+    /// @brief 默认工作线程数：硬件线程数的四分之一，限制在 [2, 4]（任务以 I/O 与解码为主，不与 JobSystem 争抢核心）
+    static std::size_t defaultWorkerCount();
+
+    explicit TaskPool(std::size_t worker_count = defaultWorkerCount());
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /**
+     * @brief 提交任务，返回其结果的 future（任务抛出的异常由 future.get() 重新抛出）
+     * @details shutdown() 之后提交的任务在调用线程上立即执行。
+     */
+    template <typename Fn>
+    [[nodiscard]] auto submit(TaskPriority priority, Fn&& fn) -> std::future<std::invoke_result_t<std::decay_t<Fn>&>> {
+        using Result = std::invoke_result_t<std::decay_t<Fn>&>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+        auto future = task->get_future();
+        enqueue(priority, [task] { (*task)(); });
+        return future;
+    }
+
+    /**
+     * @brief 提交任务，完成（结果已写入返回的 future）后把 then 投递到主线程队列
+     * @details then 无参数，通常凭捕获的键取回调用方保存的 future；shutdown() 后续体被丢弃。
+     */
+    template <typename Fn, typename Then>
+    [[nodiscard]] auto submitThen(TaskPriority priority, Fn&& fn, Then&& then) -> std::future<std::invoke_result_t<std::decay_t<Fn>&>> {
+        using Result = std::invoke_result_t<std::decay_t<Fn>&>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+        auto future = task->get_future();
+        enqueue(priority, [this, task, then = Task(std::forward<Then>(then))]() mutable {
+            (*task)();
+            postToMainThread(std::move(then));
+        });
+        return future;
+    }
+
+    /// @brief 投递到主线程队列（线程安全），由下一次 drainMainThread() 执行；shutdown() 后丢弃
+    void postToMainThread(Task task);
+
+    /**
+     * @brief 在主线程上按投递顺序执行队列中的任务，直到用完预算（至少执行一个，保证进度）
+     * @details 只执行调用时已在队列中的任务；执行期间新投递的任务（如协程的 nextFrame()）留到下一次调用。
+     * @return 本次执行的任务数
+     */
+    std::size_t drainMainThread(std::chrono::microseconds budget);
+
+    /// @brief 阻塞到主线程队列非空或超时（阻塞等待协程完成时使用，见 engine::async::runToCompletion）
+    bool waitForMainThreadTask(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief 执行完已排队的任务后回收工作线程，并丢弃主线程队列
+     * @details 须在续体捕获的对象（如 ResourceManager）销毁之前调用；析构时自动调用。
+     */
+    void shutdown();
+
+    [[nodiscard]] std::size_t getWorkerCount() const { return workers_.size(); }
+    /// @brief 已排队、尚未开始执行的任务数（两档合计）
+    [[nodiscard]] std::size_t getQueuedCount() const;
+    [[nodiscard]] std::size_t getMainThreadQueuedCount() const;
+
+private:
+    void enqueue(TaskPriority priority, Task task);
+    void workerLoop(std::size_t worker_index);
+
+    std::vector<std::thread> workers_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_cv_;
+    std::deque<Task> frame_tasks_;
+    std::deque<Task> background_tasks_;
+    bool stopping_{ false };
+
+    mutable std::mutex main_mutex_;
+    std::condition_variable main_cv_;
+    std::deque<Task> main_tasks_;
+    bool main_closed_{ false };
+};
+
+/**
+ * @brief 有线程池时提交到线程池，否则退回 std::async（无头模拟、基准与命令行工具不创建 TaskPool）
+ * @details 两种 future 的析构语义不同（见文件说明），调用方按线程池的语义处理：需要时自行 wait()。
+ */
+template <typename Fn>
+[[nodiscard]] auto runAsync(TaskPool* pool, TaskPriority priority, Fn&& fn) -> std::future<std::invoke_result_t<std::decay_t<Fn>&>> {
+    if (pool) {
+        return pool->submit(priority, std::forward<Fn>(fn));
+    }
+    return std::async(std::launch::async, std::forward<Fn>(fn));
+}
+
+} // namespace engine::core
@@ -1,5 +1,9 @@
 ﻿#include "time.h"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <thread>
 #include <SDL3/SDL_timer.h>
 
 /**
@@ -20,7 +24,7 @@ void engine::core::Time::update()
 {
 	frame_start_time_ = SDL_GetTicksNS();
 	auto current_delta_time = static_cast<double>(frame_start_time_ - last_time_) / 1e9;
-	if (target_fps_ > 0)
+	if (target_fps_ > 0 && !vsync_paced_)
 	{
 		limitFrameRate(current_delta_time);
 	}
@@ -28,7 +32,7 @@ void engine::core::Time::update()
 		delta_time_ = current_delta_time;
 	}
 	last_time_ = SDL_GetTicksNS();
-
+	recordFrame(delta_time_);
 }
 
 /**
@@ -46,6 +50,24 @@ void engine::core::Time::setTimeScale(double scale)
 	}
 }
 
+/**
+ * @brief 设置快进倍数。
+ * @param factor 快进倍数。
+ */
+void engine::core::Time::setFastForward(int factor)
+{
+	fast_forward_ = std::clamp(factor, 1, MAX_FAST_FORWARD);
+}
+
+/**
+ * @brief 设置帧预算允许的快进倍数上限。
+ * @param limit 上限。
+ */
+void engine::core::Time::setFastForwardLimit(int limit)
+{
+	fast_forward_limit_ = std::clamp(limit, 1, MAX_FAST_FORWARD);
+}
+
 /**
  * @brief 设置游戏运行的目标 FPS。
  * @param fps 目标帧率（如 60），设为 0 表示不限制。
@@ -70,18 +92,184 @@ void engine::core::Time::setTargetFPS(int fps)
 	}
 }
 
+/**
+ * @brief 告知垂直同步状态。
+ * @param enabled 是否启用垂直同步。
+ * @param refresh_rate 显示器刷新率（Hz），未知时传 0。
+ */
+void engine::core::Time::setVSync(bool enabled, float refresh_rate)
+{
+	// 刷新率未知时无法判断呈现能否兜住目标帧率，保留软件限帧
+	vsync_paced_ = enabled && refresh_rate > 0.0f &&
+		(target_fps_ == 0 || static_cast<float>(target_fps_) >= std::floor(refresh_rate));
+	if (vsync_paced_) {
+		spdlog::info("垂直同步 ({:.0f} Hz) 负责帧节奏，跳过软件限帧", refresh_rate);
+	}
+	else if (enabled) {
+		spdlog::info("垂直同步已开启，目标 FPS 低于刷新率 ({:.0f} Hz)，仍使用软件限帧", refresh_rate);
+	}
+}
+
 /**
  * @brief 内部辅助方法，若实际运行速度过快则强制延迟以维持目标帧率。
  * @param current_delta_time 当前帧处理完毕实际耗费的时间。
  */
-void engine::core::Time::limitFrameRate(float current_delta_time)
+void engine::core::Time::limitFrameRate(double current_delta_time)
 {
 	if (current_delta_time < target_frame_time_) {
-		double time_to_wait = target_frame_time_ - current_delta_time;
-		Uint64 ns_to_wait = static_cast<Uint64>(time_to_wait * 1e9);
-		SDL_DelayNS(ns_to_wait);
+		waitUntil(last_time_ + static_cast<Uint64>(target_frame_time_ * 1e9));
 		delta_time_ = static_cast<double>(SDL_GetTicksNS() - last_time_) / 1e9;
 	}else{
 		delta_time_ = current_delta_time;
 	}
 }
+
+/**
+ * @brief 高精度等待到指定时间点。
+ * @param deadline_ns SDL_GetTicksNS() 时间轴上的截止时间。
+ *
+ * 系统休眠的唤醒误差可达 1~15ms（取决于平台与定时器分辨率），直接休眠整段会明显超时；
+ * 全程自旋又会让一个核心满载。这里休眠到截止时间前 spin_threshold_ns_，余下部分让出时间片自旋，
+ * 并按每次休眠的实测超时调整阈值：定时器精度高时几乎全程休眠，精度差时自旋段相应变长。
+ */
+void engine::core::Time::waitUntil(Uint64 deadline_ns)
+{
+	constexpr Uint64 MIN_SPIN_NS = 200'000;
+	constexpr Uint64 MAX_SPIN_NS = 4'000'000;
+
+	Uint64 now = SDL_GetTicksNS();
+	if (now + spin_threshold_ns_ < deadline_ns) {
+		const Uint64 sleep_ns = deadline_ns - now - spin_threshold_ns_;
+		SDL_DelayNS(sleep_ns);
+		const Uint64 woke = SDL_GetTicksNS();
+		last_overshoot_ns_ = static_cast<double>(woke - now) - static_cast<double>(sleep_ns);
+
+		// 超时量的 1.5 倍作为新的自旋阈值：误差变大时立即放宽，变小时缓慢收紧
+		const double wanted = std::max(last_overshoot_ns_, 0.0) * 1.5;
+		const double current = static_cast<double>(spin_threshold_ns_);
+		const double next = wanted > current ? wanted : current * 0.95 + wanted * 0.05;
+		spin_threshold_ns_ = std::clamp(static_cast<Uint64>(next), MIN_SPIN_NS, MAX_SPIN_NS);
+		now = woke;
+	}
+	while (now < deadline_ns) {
+		std::this_thread::yield();
+		now = SDL_GetTicksNS();
+	}
+}
+
+/**
+ * @brief 记录一帧的帧时间。
+ * @param frame_seconds 帧时间（秒）。
+ */
+void engine::core::Time::recordFrame(double frame_seconds)
+{
+	frame_history_ms_[frame_history_next_] = static_cast<float>(frame_seconds * 1000.0);
+	frame_history_next_ = (frame_history_next_ + 1) % FRAME_HISTORY_SIZE;
+	frame_history_count_ = std::min(frame_history_count_ + 1, FRAME_HISTORY_SIZE);
+}
+
+/**
+ * @brief 计算最近若干帧的帧时间统计。
+ * @return FrameTimeStats 统计结果。
+ */
+engine::core::FrameTimeStats engine::core::Time::getFrameStats() const
+{
+	FrameTimeStats stats;
+	stats.sleep_overshoot_us_ = static_cast<float>(last_overshoot_ns_ / 1000.0);
+	stats.sample_count_ = frame_history_count_;
+	if (frame_history_count_ == 0) {
+		return stats;
+	}
+
+	std::array<float, FRAME_HISTORY_SIZE> sorted{};
+	const auto begin = sorted.begin();
+	const auto end = begin + static_cast<std::ptrdiff_t>(frame_history_count_);
+	std::copy_n(frame_history_ms_.begin(), frame_history_count_, begin);
+
+	stats.average_ms_ = std::accumulate(begin, end, 0.0f) / static_cast<float>(frame_history_count_);
+	stats.max_ms_ = *std::max_element(begin, end);
+
+	// 最慢 1% 的帧（至少一帧）取平均
+	const std::size_t worst_count = std::max<std::size_t>(frame_history_count_ / 100, 1);
+	const auto worst_begin = end - static_cast<std::ptrdiff_t>(worst_count);
+	std::nth_element(begin, worst_begin, end);
+	stats.one_percent_low_ms_ = std::accumulate(worst_begin, end, 0.0f) / static_cast<float>(worst_count);
+	return stats;
+}
+
+/**
+ * @brief 按写入顺序复制最近的帧时间。
+ * @param out 输出缓冲。
+ * @param capacity 输出缓冲容量。
+ * @return std::size_t 实际复制的帧数。
+ */
+std::size_t engine::core::Time::copyFrameHistory(float* out, std::size_t capacity) const
+{
+	const std::size_t count = std::min(capacity, frame_history_count_);
+	// 最旧的一帧位于 next - count（环形）
+	std::size_t index = (frame_history_next_ + FRAME_HISTORY_SIZE - count) % FRAME_HISTORY_SIZE;
+	for (std::size_t i = 0; i < count; ++i) {
+		out[i] = frame_history_ms_[index];
+		index = (index + 1) % FRAME_HISTORY_SIZE;
+	}
+	return count;
+}
+
+/**
+ * @brief 设置固定步长模拟参数。
+ * @param hz 模拟频率，0 表示变步长。
+ * @param max_steps 单帧最多执行的模拟步数。
+ */
+void engine::core::Time::setSimulationRate(int hz, int max_steps)
+{
+	simulation_hz_ = std::max(hz, 0);
+	max_simulation_steps_ = std::max(max_steps, 1);
+	accumulator_ = 0.0;
+	if (simulation_hz_ > 0) {
+		spdlog::info("固定步长模拟: {} Hz，单帧最多 {} 步", simulation_hz_, max_simulation_steps_);
+	}
+	else {
+		spdlog::info("模拟步长随帧率变化");
+	}
+}
+
+/**
+ * @brief 累加本帧时间并计算模拟步数与插值系数。
+ */
+void engine::core::Time::advanceSimulation()
+{
+	const double scaled_delta = delta_time_ * time_scale_;
+	// 快进只增加步数：累加器按倍数累计、单帧补跑上限同比放大，步长不变
+	const int fast_forward = getEffectiveFastForward();
+	if (simulation_hz_ <= 0) {
+		fixed_delta_time_ = scaled_delta;
+		simulation_steps_ = fast_forward;
+		interpolation_alpha_ = 1.0f;
+		simulation_tick_ += static_cast<std::uint64_t>(fast_forward);
+		return;
+	}
+
+	// 时间缩放体现在步长上：每秒的模拟步数保持不变，慢动作时每步推进得更少
+	const double step = 1.0 / static_cast<double>(simulation_hz_);
+	fixed_delta_time_ = step * time_scale_;
+	accumulator_ += delta_time_ * static_cast<double>(fast_forward);
+	int steps = static_cast<int>(accumulator_ / step);
+	const int max_steps = max_simulation_steps_ * fast_forward;
+	if (steps > max_steps) {
+		spdlog::debug("模拟落后 {} 步，丢弃超出的 {} 步", steps, steps - max_steps);
+		steps = max_steps;
+		accumulator_ = 0.0;
+	}
+	else {
+		accumulator_ -= static_cast<double>(steps) * step;
+	}
+	simulation_steps_ = steps;
+	interpolation_alpha_ = static_cast<float>(std::clamp(accumulator_ / step, 0.0, 1.0));
+	simulation_tick_ += static_cast<std::uint64_t>(steps);
+}
+
+void engine::core::Time::overrideSimulationSteps(int steps)
+{
+	simulation_tick_ = simulation_tick_ - static_cast<std::uint64_t>(simulation_steps_) + static_cast<std::uint64_t>(steps);
+	simulation_steps_ = steps;
+}
@@ -1,7 +1,21 @@
 ﻿#pragma once
 #include <SDL3/SDL_stdinc.h> 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
 namespace engine::core {
+    /**
+     * @brief 最近若干帧的帧时间统计（毫秒）。
+     */
+    struct FrameTimeStats {
+        float average_ms_ = 0.0f;           ///< 平均帧时间
+        float one_percent_low_ms_ = 0.0f;   ///< 最慢 1% 帧的平均帧时间（换算为 FPS 即 "1% low"）
+        float max_ms_ = 0.0f;               ///< 最长帧时间
+        float sleep_overshoot_us_ = 0.0f;   ///< 最近一次休眠的超时量（微秒），反映系统定时器精度
+        std::size_t sample_count_ = 0;      ///< 参与统计的帧数
+    };
+
     /**
      * @brief 基础时间管理类，负责计算 Delta Time、管理时间缩放以及帧率限制。
      */
@@ -14,7 +28,33 @@ namespace engine::core {
 
         int target_fps_ = 0;             ///< 期望的目标帧率
         double target_frame_time_ = 0.0; ///< 目标帧率对应的每帧时长
+
+        // 帧节奏
+        bool vsync_paced_ = false;              ///< 垂直同步已把帧率限制在目标以内，跳过软件限帧
+        Uint64 spin_threshold_ns_ = 1'000'000;  ///< 距截止时间小于该值时改为自旋等待，随实测休眠误差自适应
+        double last_overshoot_ns_ = 0.0;        ///< 最近一次休眠的超时量
+
+        // 帧时间历史（环形缓冲）
+        static constexpr std::size_t FRAME_HISTORY_SIZE = 512;
+        std::array<float, FRAME_HISTORY_SIZE> frame_history_ms_{};  ///< 最近若干帧的帧时间（毫秒）
+        std::size_t frame_history_next_ = 0;    ///< 下一次写入位置
+        std::size_t frame_history_count_ = 0;   ///< 已写入的帧数（不超过容量）
+
+        // 固定步长模拟
+        int simulation_hz_ = 0;                 ///< 模拟频率，0 表示每帧一步、步长随帧率变化
+        int max_simulation_steps_ = 5;          ///< 单帧最多补跑的模拟步数，超出部分直接丢弃，防止卡顿后雪崩
+        double fixed_delta_time_ = 0.0;         ///< 本帧每个模拟步的步长（秒，已含时间缩放）
+        double accumulator_ = 0.0;              ///< 尚未模拟的累计时间（秒）
+        int simulation_steps_ = 0;              ///< 本帧需要执行的模拟步数
+        float interpolation_alpha_ = 1.0f;      ///< 渲染插值系数：剩余累计时间占一步的比例
+        std::uint64_t simulation_tick_ = 0;     ///< 已执行（含本帧待执行）的模拟步总数
+
+        // 快进
+        int fast_forward_ = 1;                  ///< 请求的快进倍数：每帧按该倍数的时间累计模拟步，步长不变
+        int fast_forward_limit_ = 8;            ///< 帧预算允许的快进倍数上限
     public:
+        static constexpr int MAX_FAST_FORWARD = 8;  ///< 快进倍数上限
+
         /**
          * @brief 构造函数，初始化计时数据。
          */
@@ -57,6 +97,26 @@ namespace engine::core {
          */
 		float getTimeScale() const { return static_cast<float>(time_scale_); }
 
+        /**
+         * @brief 设置快进倍数（1、2、4、8）。
+         * 与时间缩放不同，快进不放大步长，而是每帧多执行几个同样步长的模拟步，
+         * 寻路的到点阈值、动画帧事件等按步长设计的逻辑在快进下保持原样。
+         * @param factor 快进倍数，截断到 [1, MAX_FAST_FORWARD]。
+         */
+		void setFastForward(int factor);
+
+        /** @brief 请求的快进倍数 */
+		int getFastForward() const { return fast_forward_; }
+
+        /** @brief 实际生效的快进倍数（请求值与帧预算上限取小） */
+		int getEffectiveFastForward() const { return fast_forward_ < fast_forward_limit_ ? fast_forward_ : fast_forward_limit_; }
+
+        /**
+         * @brief 设置帧预算允许的快进倍数上限，由 GameApp 每帧根据 FrameBudget 更新。
+         * @param limit 上限，截断到 [1, MAX_FAST_FORWARD]。
+         */
+		void setFastForwardLimit(int limit);
+
         /**
          * @brief 设置游戏运行的目标 FPS。
          * @param fps 目标帧率（如 60），设为 0 表示不限制。
@@ -69,11 +129,85 @@ namespace engine::core {
          */
 		int getTargetFPS() const { return target_fps_; }
 
+        /**
+         * @brief 告知垂直同步状态，用于决定是否仍需软件限帧。
+         * @param enabled 是否启用垂直同步。
+         * @param refresh_rate 显示器刷新率（Hz），未知时传 0。
+         * @note 垂直同步开启且目标帧率不低于刷新率时，呈现本身就会阻塞到下一次刷新，软件限帧只会叠加延迟，因此跳过。
+         */
+		void setVSync(bool enabled, float refresh_rate);
+
+        /**
+         * @brief 当前是否由垂直同步负责帧节奏。
+         * @return bool true 表示跳过软件限帧。
+         */
+		bool isVSyncPaced() const { return vsync_paced_; }
+
+        /**
+         * @brief 计算最近若干帧的帧时间统计（平均、1% low、最大），调试面板每帧调用一次即可。
+         * @return FrameTimeStats 统计结果。
+         */
+		FrameTimeStats getFrameStats() const;
+
+        /**
+         * @brief 按写入顺序复制最近的帧时间（毫秒），供调试面板绘制直方图。
+         * @param out 输出缓冲。
+         * @param capacity 输出缓冲容量，不足时只复制最近的部分。
+         * @return std::size_t 实际复制的帧数。
+         */
+		std::size_t copyFrameHistory(float* out, std::size_t capacity) const;
+
+        /**
+         * @brief 设置固定步长模拟参数。
+         * @param hz 模拟频率（如 30、60），0 表示每帧一步、步长等于缩放后的帧间隔。
+         * @param max_steps 单帧最多执行的模拟步数。
+         */
+		void setSimulationRate(int hz, int max_steps);
+
+        /**
+         * @brief 获取模拟频率。
+         * @return int 模拟频率，0 表示变步长。
+         */
+		int getSimulationRate() const { return simulation_hz_; }
+
+        /**
+         * @brief 把本帧时间并入累加器，算出本帧要执行的模拟步数与渲染插值系数。
+         * 每帧在 update() 之后调用一次。
+         */
+		void advanceSimulation();
+
+        /** @brief 本帧需要执行的模拟步数（固定步长下可能为 0；快进时为多个子步） */
+		int getSimulationSteps() const { return simulation_steps_; }
+
+        /**
+         * @brief 改写本帧实际执行的模拟步数，模拟步总数随之修正。
+         * 锁步联机等待对方（少跑）或追赶对方（多跑）时调用，使 getSimulationTick() 与实际执行的步一致。
+         */
+		void overrideSimulationSteps(int steps);
+
+        /** @brief 每个模拟步的步长（秒，已含时间缩放） */
+		float getFixedDeltaTime() const { return static_cast<float>(fixed_delta_time_); }
+
+        /** @brief 渲染插值系数，0 对应上一模拟状态，1 对应最新模拟状态 */
+		float getInterpolationAlpha() const { return interpolation_alpha_; }
+
+        /** @brief 已调度的模拟步总数；本帧第 i 步的序号为 getSimulationTick() - getSimulationSteps() + i + 1（i 从 0 开始） */
+		std::uint64_t getSimulationTick() const { return simulation_tick_; }
+
 	private:
         /**
          * @brief 内部辅助方法，若实际运行速度过快则强制延迟以维持目标帧率。
          * @param current_delta_time 当前帧处理完毕实际耗费的时间。
          */
-		void limitFrameRate(float current_delta_time);
+		void limitFrameRate(double current_delta_time);
+
+        /**
+         * @brief 高精度等待到指定时间点：先粗粒度休眠，剩余不足 spin_threshold_ns_ 时自旋。
+         * @param deadline_ns SDL_GetTicksNS() 时间轴上的截止时间。
+         */
+		void waitUntil(Uint64 deadline_ns);
+
+        /** @brief 记录一帧的帧时间。 */
+		void recordFrame(double frame_seconds);
     };
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "timer_wheel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace engine::core {
+
+namespace {
+    constexpr double TICK_EPSILON = 1.0e-4;     ///< 秒数恰为步长整数倍时，浮点误差不多算一步
+}
+
+TimerWheel::TimerWheel(float tick_seconds, std::size_t reserve)
+    : tick_seconds_(tick_seconds > 0.0f ? tick_seconds : 1.0f / 60.0f) {
+    lists_.fill(NONE);
+    nodes_.reserve(reserve);
+    expired_.reserve(std::max<std::size_t>(reserve / 4, 16));
+}
+
+TimerId TimerWheel::schedule(std::uint64_t due_tick, entt::entity entity, entt::id_type event) {
+    std::uint32_t index = free_;
+    if (index != NONE) {
+        free_ = nodes_[index].next_;
+    } else {
+        index = static_cast<std::uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    auto& node = nodes_[index];
+    node.due_ = std::max(due_tick, now_ + 1);
+    node.expiry_ = Expiry{ entity, event };
+    link(index);
+    ++active_;
+    return TimerId{ index, node.generation_ };
+}
+
+bool TimerWheel::cancel(TimerId& id) {
+    const bool pending = isPending(id);
+    if (pending) {
+        unlink(id.index_);
+        release(id.index_);
+    }
+    id = TimerId{};
+    return pending;
+}
+
+bool TimerWheel::isPending(TimerId id) const {
+    return id && id.index_ < nodes_.size()
+        && nodes_[id.index_].generation_ == id.generation_
+        && nodes_[id.index_].list_ != NONE;
+}
+
+std::span<const TimerWheel::Expiry> TimerWheel::advance() {
+    expired_.clear();
+    ++now_;
+
+    // 低 6 位回绕：第 1 级当前槽的条目进入下 64 步，下放到第 0 级；更高级别依次类推，先下放高级别
+    if ((now_ & SLOT_MASK) == 0) {
+        std::uint32_t levels = 1;
+        while (levels < LEVELS - 1 && ((now_ >> (SLOT_BITS * levels)) & SLOT_MASK) == 0) {
+            ++levels;
+        }
+        if (levels == LEVELS - 1 && ((now_ >> (SLOT_BITS * levels)) & SLOT_MASK) == 0) {
+            cascade(OVERFLOW_LIST);
+        }
+        for (std::uint32_t level = levels; level >= 1; --level) {
+            cascade(level * SLOTS + static_cast<std::uint32_t>((now_ >> (SLOT_BITS * level)) & SLOT_MASK));
+        }
+    }
+
+    // 第 0 级的槽只容纳 64 步以内的条目，当前槽里的条目都恰好在本步到期
+    auto& head = lists_[now_ & SLOT_MASK];
+    for (std::uint32_t index = head; index != NONE;) {
+        const std::uint32_t next = nodes_[index].next_;
+        expired_.push_back(nodes_[index].expiry_);
+        release(index);
+        index = next;
+    }
+    head = NONE;
+    return expired_;
+}
+
+void TimerWheel::clear() {
+    lists_.fill(NONE);
+    free_ = NONE;
+    for (std::size_t i = nodes_.size(); i-- > 0;) {
+        auto& node = nodes_[i];
+        if (node.list_ != NONE) {
+            node.list_ = NONE;
+            node.generation_ = node.generation_ + 1 == 0 ? 1 : node.generation_ + 1;
+        }
+        node.next_ = free_;
+        free_ = static_cast<std::uint32_t>(i);
+    }
+    expired_.clear();
+    active_ = 0;
+    now_ = 0;
+}
+
+std::uint64_t TimerWheel::ticksFor(float seconds) const {
+    const double ticks = std::ceil(static_cast<double>(seconds) / static_cast<double>(tick_seconds_) - TICK_EPSILON);
+    return ticks > 1.0 ? static_cast<std::uint64_t>(ticks) : 1u;
+}
+
+float TimerWheel::secondsUntil(std::uint64_t due_tick) const {
+    return due_tick > now_ ? static_cast<float>(due_tick - now_) * tick_seconds_ : 0.0f;
+}
+
+void TimerWheel::link(std::uint32_t index) {
+    auto& node = nodes_[index];
+    const std::uint64_t delta = node.due_ - now_;
+    std::uint32_t list = OVERFLOW_LIST;
+    for (std::uint32_t level = 0; level < LEVELS; ++level) {
+        if (delta < (std::uint64_t{ 1 } << (SLOT_BITS * (level + 1)))) {
+            list = level * SLOTS + static_cast<std::uint32_t>((node.due_ >> (SLOT_BITS * level)) & SLOT_MASK);
+            break;
+        }
+    }
+    node.list_ = list;
+    node.prev_ = NONE;
+    node.next_ = lists_[list];
+    if (node.next_ != NONE) {
+        nodes_[node.next_].prev_ = index;
+    }
+    lists_[list] = index;
+}
+
+void TimerWheel::unlink(std::uint32_t index) {
+    const auto& node = nodes_[index];
+    if (node.prev_ != NONE) {
+        nodes_[node.prev_].next_ = node.next_;
+    } else {
+        lists_[node.list_] = node.next_;
+    }
+    if (node.next_ != NONE) {
+        nodes_[node.next_].prev_ = node.prev_;
+    }
+}
+
+void TimerWheel::release(std::uint32_t index) {
+    auto& node = nodes_[index];
+    node.list_ = NONE;
+    node.generation_ = node.generation_ + 1 == 0 ? 1 : node.generation_ + 1;
+    node.next_ = free_;
+    free_ = index;
+    --active_;
+}
+
+void TimerWheel::cascade(std::uint32_t list) {
+    std::uint32_t index = lists_[list];
+    lists_[list] = NONE;
+    while (index != NONE) {
+        const std::uint32_t next = nodes_[index].next_;
+        link(index);
+        index = next;
+    }
+}
+
+} // namespace engine::core
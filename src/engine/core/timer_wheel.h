@@ -0,0 +1,127 @@
+#pragma once
+/**
+ * @file timer_wheel.h
+ * @brief 以模拟步为单位的分层时间轮：系统登记 {实体, 事件} 的到期时刻，只在到期的那一步取出。
+ *
+ * @details
+ * 每步由模拟循环调用一次 advance()，之后同一步内的各系统从 getExpired() 读取本步到期的条目，
+ * 按事件 id 挑出自己关心的处理；到期列表在下一次 advance() 前保持有效。
+ *
+ * 结构为 4 级、每级 64 槽的时间轮（覆盖 2^24 步，60 Hz 下约 77 小时），更远的条目放入溢出链表：
+ * - schedule()/cancel() 为 O(1)：条目存放在复用的节点池中，槽位是池内下标串成的双向链表
+ * - advance() 只取出当前槽；低位回绕时把上一级对应槽的条目下放一级，每个条目至多下放 3 次，
+ *   每步开销与登记的计时器总数无关
+ * - 节点池与到期列表的容量在帧间复用，稳态下不分配
+ *
+ * 时刻以 advance() 的次数计（暂停时模拟不推进，计时也不推进）。scheduleAfter(n) 在其后第 n 次 advance() 到期，
+ * 与「每步先减 dt 再判断是否归零」的逐帧计时在同一步触发。
+ * 时间轮是值类型，拷贝即完整的计时状态，可随检查点一起保存与恢复；TimerId 在拷贝之间保持有效。
+ *
+ * @code
+ * auto& timers = registry.ctx().get<engine::core::TimerWheel>();
+ * const auto id = timers.scheduleAfter(timers.ticksFor(cooldown), entity, "skill_ready"_hs);
+ * timers.advance();                                   // 模拟循环每步一次
+ * for (const auto& expiry : timers.getExpired()) {    // 各系统读取本步到期的条目
+ *     if (expiry.event_ == "skill_ready"_hs) { ... }
+ * }
+ * @endcode
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <entt/entity/entity.hpp>
+
+namespace engine::core {
+
+/// @brief 计时器句柄：节点下标 + 代数，节点复用后旧句柄自动失效
+struct TimerId {
+    std::uint32_t index_{ 0 };
+    std::uint32_t generation_{ 0 };     ///< 0 表示空句柄
+
+    [[nodiscard]] explicit operator bool() const { return generation_ != 0; }
+};
+
+class TimerWheel final {
+public:
+    /// @brief 一个到期条目
+    struct Expiry {
+        entt::entity entity_{ entt::null };
+        entt::id_type event_{ 0 };
+    };
+
+    /**
+     * @param tick_seconds 一步的时长（固定步长），只用于秒与步数的换算
+     * @param reserve 预留的计时器数量
+     */
+    explicit TimerWheel(float tick_seconds = 1.0f / 60.0f, std::size_t reserve = 256);
+
+    /// @brief 在第 due_tick 步到期；不晚于当前步时在下一步到期
+    TimerId schedule(std::uint64_t due_tick, entt::entity entity, entt::id_type event);
+    /// @brief 在其后第 ticks 次 advance() 到期（0 按 1 处理）
+    TimerId scheduleAfter(std::uint64_t ticks, entt::entity entity, entt::id_type event) {
+        return schedule(now_ + ticks, entity, event);
+    }
+
+    /**
+     * @brief 取消尚未到期的计时器并把句柄置空
+     * @return 句柄已到期、已取消或为空时返回 false
+     */
+    bool cancel(TimerId& id);
+
+    /// @brief 句柄对应的计时器是否仍在等待
+    [[nodiscard]] bool isPending(TimerId id) const;
+
+    /// @brief 推进一步，取出本步到期的条目（顺序只取决于登记与推进的历史，重放时一致）
+    std::span<const Expiry> advance();
+
+    /// @brief 最近一次 advance() 取出的条目
+    [[nodiscard]] std::span<const Expiry> getExpired() const { return expired_; }
+
+    /// @brief 清空所有计时器并把时刻归零（保留容量）
+    void clear();
+
+    [[nodiscard]] std::uint64_t getTick() const { return now_; }
+    [[nodiscard]] float getTickSeconds() const { return tick_seconds_; }
+    [[nodiscard]] std::size_t size() const { return active_; }
+
+    /// @brief 至少 seconds 秒所需的步数（至少 1 步）
+    [[nodiscard]] std::uint64_t ticksFor(float seconds) const;
+    /// @brief 距第 due_tick 步还剩的秒数，已到期为 0
+    [[nodiscard]] float secondsUntil(std::uint64_t due_tick) const;
+
+private:
+    static constexpr std::uint32_t SLOT_BITS = 6;
+    static constexpr std::uint32_t SLOTS = 1u << SLOT_BITS;
+    static constexpr std::uint32_t SLOT_MASK = SLOTS - 1;
+    static constexpr std::uint32_t LEVELS = 4;
+    static constexpr std::uint32_t NONE = ~0u;
+    static constexpr std::uint32_t OVERFLOW_LIST = LEVELS * SLOTS;     ///< lists_ 的最后一项
+
+    struct Node {
+        std::uint64_t due_{ 0 };
+        Expiry expiry_;
+        std::uint32_t prev_{ NONE };
+        std::uint32_t next_{ NONE };
+        std::uint32_t list_{ NONE };        ///< 所在链表，NONE 表示空闲
+        std::uint32_t generation_{ 1 };
+    };
+
+    void link(std::uint32_t index);
+    void unlink(std::uint32_t index);
+    void release(std::uint32_t index);
+    /// @brief 把一个链表的条目按到期时刻重新放入更低的级别
+    void cascade(std::uint32_t list);
+
+    float tick_seconds_;
+    std::uint64_t now_{ 0 };
+    std::size_t active_{ 0 };
+    std::vector<Node> nodes_;
+    std::uint32_t free_{ NONE };                        ///< 空闲节点链表头（经 next_ 串联）
+    std::array<std::uint32_t, LEVELS * SLOTS + 1> lists_{};    ///< 各槽链表头，最后一项为溢出链表
+    std::vector<Expiry> expired_;
+};
+
+} // namespace engine::core
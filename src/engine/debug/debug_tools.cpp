@@ -0,0 +1,58 @@
+#include "debug_tools.h"
+
+#include <imgui.h>
+#include <utility>
+
+namespace engine::debug {
+
+void DebugTools::addPanel(std::string name, DebugPanel::RenderFunc render, bool open, DebugPanel::RenderFunc on_hide) {
+    DebugPanel panel;
+    panel.name_ = std::move(name);
+    panel.render_ = std::move(render);
+    panel.on_hide_ = std::move(on_hide);
+    panel.open_ = open;
+    panels_.push_back(std::move(panel));
+}
+
+void DebugTools::render(engine::scene::Scene& scene) {
+    // 面板列表贴在右上角，只占一个标题栏；折叠后面板本身照常绘制
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - 12.0f, viewport->WorkPos.y + 12.0f),
+        ImGuiCond_Once, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowBgAlpha(0.85f);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_Once);
+    if (ImGui::Begin("调试面板", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing)) {
+        for (auto& panel : panels_) {
+            ImGui::Checkbox(panel.name_.c_str(), &panel.open_);
+        }
+        ImGui::TextDisabled("F1（toggle_debug_tools）隐藏全部调试界面");
+    }
+    ImGui::End();
+
+    for (auto& panel : panels_) {
+        if (panel.open_) {
+            panel.render_(scene);
+            panel.drawn_ = true;
+        } else {
+            hidePanel(panel, &scene);
+        }
+    }
+}
+
+void DebugTools::hide(engine::scene::Scene* scene) {
+    for (auto& panel : panels_) {
+        hidePanel(panel, scene);
+    }
+}
+
+void DebugTools::hidePanel(DebugPanel& panel, engine::scene::Scene* scene) {
+    if (!panel.drawn_) {
+        return;
+    }
+    panel.drawn_ = false;
+    if (scene && panel.on_hide_) {
+        panel.on_hide_(*scene);
+    }
+}
+
+} // namespace engine::debug
@@ -0,0 +1,70 @@
+#pragma once
+/**
+ * @file debug_tools.h
+ * @brief 调试工具宿主：各调试面板（性能分析、组件普查、内存等）注册到这里，由 GameApp 统一绘制。
+ *
+ * @details
+ * 宿主关闭（运行时按 toggle_debug_tools 切换）时 GameApp 整帧跳过 ImGui：不调用 NewFrame / Render，
+ * 也不再把输入事件转发给 ImGui，面板里的注册表查询同样不会执行。
+ * 面板从打开变为不绘制（取消勾选或宿主关闭）时调用一次 on_hide_，用于断开只在面板可见时需要的信号
+ * （组件普查的存储信号等）。
+ *
+ * 以 MONSTERWAR_DEBUG_TOOLS=OFF 构建时本文件与 ImGui 均不参与编译。
+ */
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace engine::scene {
+class Scene;
+}
+
+namespace engine::debug {
+
+/**
+ * @struct DebugPanel
+ * @brief 一个调试面板：render_ 自行 Begin / End 它的 ImGui 窗口
+ */
+struct DebugPanel {
+    using RenderFunc = std::function<void(engine::scene::Scene&)>;
+
+    std::string name_;      ///< 在面板列表中显示的名称
+    RenderFunc render_;
+    RenderFunc on_hide_;    ///< 可选：面板停止绘制时调用一次
+    bool open_{ false };
+    bool drawn_{ false };   ///< 上一帧是否绘制过
+};
+
+/**
+ * @class DebugTools
+ * @brief 调试面板的注册表与总开关
+ */
+class DebugTools final {
+public:
+    /// @brief 注册面板；open 为初始是否勾选
+    void addPanel(std::string name, DebugPanel::RenderFunc render, bool open = false, DebugPanel::RenderFunc on_hide = {});
+
+    void setEnabled(bool enabled) { enabled_ = enabled; }
+    void toggle() { enabled_ = !enabled_; }
+    [[nodiscard]] bool isEnabled() const { return enabled_; }
+
+    /// @brief 本帧是否需要 ImGui：宿主已打开且有场景可供面板查询
+    [[nodiscard]] bool isVisible(const engine::scene::Scene* scene) const { return enabled_ && scene != nullptr; }
+
+    /// @brief 绘制面板列表与所有勾选的面板（须在 ImGui::NewFrame 之后调用）
+    void render(engine::scene::Scene& scene);
+
+    /// @brief 本帧不绘制：上一帧绘制过的面板收到 on_hide_（scene 为空时只清除标记）
+    void hide(engine::scene::Scene* scene);
+
+    [[nodiscard]] const std::vector<DebugPanel>& getPanels() const { return panels_; }
+
+private:
+    void hidePanel(DebugPanel& panel, engine::scene::Scene* scene);
+
+    std::vector<DebugPanel> panels_;
+    bool enabled_{ true };
+};
+
+} // namespace engine::debug
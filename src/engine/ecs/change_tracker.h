@@ -0,0 +1,99 @@
+#pragma once
+/**
+ * @file change_tracker.h
+ * @brief 组件变化跟踪：经 registry 信号收集「上次处理以来变化过」的实体，供增量系统只遍历脏集合。
+ *
+ * @details
+ * ChangeTracker<Component...> 连接每个列出组件的 on_construct / on_update / on_destroy 信号：
+ * - 构造或更新（registry.emplace / emplace_or_replace / replace / patch）任一组件时把实体记入脏集合
+ * - 销毁任一组件时移出，集合中不会残留已销毁的句柄
+ * - 使用方每次处理完调用 clear()；重复标记由 entt::sparse_set 去重
+ *
+ * 只有经 registry 的写入会发出信号。就地改写组件的代码（取引用后直接赋值）需要改用 patch，
+ * 或在写完后补一次 registry.patch<T>(entity)；并行遍历中写入的，遍历结束后在主线程统一 patch
+ * （信号回调不是线程安全的）。
+ *
+ * @code
+ * engine::ecs::ChangeTracker<StatsComponent, TransformComponent> changes_{ registry };
+ * ...
+ * registry.patch<StatsComponent>(target, [&](auto& stats) { stats.hp_ -= damage; });
+ * ...
+ * for (auto entity : changes_.dirty()) { ... }
+ * changes_.clear();
+ * @endcode
+ */
+
+#include <cstddef>
+#include <entt/entity/registry.hpp>
+#include <entt/entity/sparse_set.hpp>
+
+namespace engine::ecs {
+
+template<typename... Component>
+class ChangeTracker final {
+    static_assert(sizeof...(Component) > 0, "ChangeTracker 至少需要一个组件类型");
+
+public:
+    /// @brief 连接信号；已存在的实体不会自动标记，需要时调用 markAll()
+    explicit ChangeTracker(entt::registry& registry) : registry_(registry) {
+        (connect<Component>(), ...);
+    }
+
+    ~ChangeTracker() {
+        (disconnect<Component>(), ...);
+    }
+
+    ChangeTracker(const ChangeTracker&) = delete;
+    ChangeTracker& operator=(const ChangeTracker&) = delete;
+
+    /// @brief 把当前带有任一列出组件的实体全部标记为脏（接管创建前已存在的实体）
+    void markAll() {
+        (markStorage<Component>(), ...);
+    }
+
+    /// @brief 手动标记（例如信号之外的变化来源）
+    void mark(entt::entity entity) {
+        if (!dirty_.contains(entity)) {
+            dirty_.push(entity);
+        }
+    }
+
+    /// @brief 上次 clear() 以来变化过的实体（按首次标记的顺序）
+    [[nodiscard]] const entt::sparse_set& dirty() const { return dirty_; }
+    [[nodiscard]] bool contains(entt::entity entity) const { return dirty_.contains(entity); }
+    [[nodiscard]] std::size_t size() const { return dirty_.size(); }
+    [[nodiscard]] bool empty() const { return dirty_.empty(); }
+
+    /// @brief 处理完脏集合后清空
+    void clear() { dirty_.clear(); }
+
+private:
+    void onChanged(entt::registry&, entt::entity entity) { mark(entity); }
+    void onDestroyed(entt::registry&, entt::entity entity) { dirty_.remove(entity); }
+
+    template<typename T>
+    void connect() {
+        registry_.on_construct<T>().template connect<&ChangeTracker::onChanged>(this);
+        registry_.on_update<T>().template connect<&ChangeTracker::onChanged>(this);
+        registry_.on_destroy<T>().template connect<&ChangeTracker::onDestroyed>(this);
+    }
+
+    template<typename T>
+    void disconnect() {
+        registry_.on_construct<T>().disconnect(this);
+        registry_.on_update<T>().disconnect(this);
+        registry_.on_destroy<T>().disconnect(this);
+    }
+
+    template<typename T>
+    void markStorage() {
+        for (auto entity : registry_.view<T>()) {
+            mark(entity);
+        }
+    }
+
+    entt::registry& registry_;
+    entt::sparse_set dirty_;
+};
+
+} // namespace engine::ecs
@@ -0,0 +1,39 @@
+#include "command_buffer.h"
+
+namespace engine::ecs {
+
+void CommandBuffer::apply(entt::registry& registry) {
+    if (pending_ > 0) {
+        for (auto& batch : batches_) {
+            if (!batch->empty()) {
+                batch->apply(registry);
+            }
+        }
+        pending_ = 0;
+    }
+
+    if (!destroyed_.empty()) {
+        std::sort(destroyed_.begin(), destroyed_.end());
+        destroyed_.erase(std::unique(destroyed_.begin(), destroyed_.end()), destroyed_.end());
+        destroyed_.erase(std::remove_if(destroyed_.begin(), destroyed_.end(),
+                                        [&](entt::entity entity) { return !registry.valid(entity); }),
+                         destroyed_.end());
+        registry.destroy(destroyed_.begin(), destroyed_.end());
+        destroyed_.clear();
+    }
+
+    // 回调可能继续记录命令，先交换出来再执行；新记录留到下一个同步点
+    if (!callbacks_.empty()) {
+        auto callbacks = std::move(callbacks_);
+        callbacks_.clear();
+        for (auto& callback : callbacks) {
+            callback(registry);
+        }
+        if (callbacks_.empty()) {
+            callbacks.clear();
+            callbacks_ = std::move(callbacks);  // 归还容量
+        }
+    }
+}
+
+} // namespace engine::ecs
@@ -0,0 +1,126 @@
+#pragma once
+/**
+ * @file command_buffer.h
+ * @brief 延迟结构性修改的命令缓冲：系统遍历期间只记录，在同步点按组件类型批量提交。
+ *
+ * @details
+ * 在遍历视图时直接 emplace/remove 会引发稀疏集交换，并打乱其他视图的迭代。
+ * CommandBuffer 按组件类型分桶记录操作，apply() 时每个桶按实体排序、同一实体只保留
+ * 最后一次记录的操作，再连续提交到同一存储；销毁操作最后执行，通用回调（如事件分发）
+ * 按记录顺序在结构性修改之后执行。
+ *
+ * @code
+ * block_system_->update(registry_, command_buffer_);
+ * command_buffer_.apply(registry_);   // 同步点：之后的系统可以看到阻挡关系
+ * @endcode
+ */
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <entt/core/type_info.hpp>
+#include <entt/entity/registry.hpp>
+
+namespace engine::ecs {
+
+class CommandBuffer final {
+public:
+    CommandBuffer() = default;
+    CommandBuffer(CommandBuffer&&) = default;
+    CommandBuffer& operator=(CommandBuffer&&) = default;
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    /// @brief 记录添加（已存在时替换）组件
+    template <typename Component, typename... Args>
+    void emplace(entt::entity entity, Args&&... args) {
+        batch<Component>().ops_.push_back({ entity, Component{ std::forward<Args>(args)... } });
+    }
+
+    /// @brief 记录移除组件（实体没有该组件时忽略）
+    template <typename Component>
+    void remove(entt::entity entity) {
+        batch<Component>().ops_.push_back({ entity, std::nullopt });
+    }
+
+    /// @brief 记录销毁实体
+    void destroy(entt::entity entity) { destroyed_.push_back(entity); }
+
+    /// @brief 记录任意回调，签名为 void(entt::registry&)
+    template <typename Fn>
+    void push(Fn&& fn) { callbacks_.emplace_back(std::forward<Fn>(fn)); }
+
+    /// @brief 同步点：提交并清空全部记录（保留容量）
+    void apply(entt::registry& registry);
+
+    [[nodiscard]] bool empty() const { return pending_ == 0 && destroyed_.empty() && callbacks_.empty(); }
+
+private:
+    struct BatchBase {
+        virtual ~BatchBase() = default;
+        virtual void apply(entt::registry& registry) = 0;
+        [[nodiscard]] virtual bool empty() const = 0;
+    };
+
+    template <typename Component>
+    struct Batch final : BatchBase {
+        struct Op {
+            entt::entity entity_;
+            std::optional<Component> value_;    ///< 为空表示移除
+        };
+        std::vector<Op> ops_;
+        std::vector<entt::entity> removed_;
+
+        void apply(entt::registry& registry) override {
+            // 按实体排序使提交顺序贴近存储布局；稳定排序保证同一实体的最后一次记录排在最后
+            std::stable_sort(ops_.begin(), ops_.end(), [](const Op& lhs, const Op& rhs) {
+                return entt::to_entity(lhs.entity_) < entt::to_entity(rhs.entity_);
+            });
+            removed_.clear();
+            for (std::size_t i = 0; i < ops_.size(); ++i) {
+                if (i + 1 < ops_.size() && ops_[i + 1].entity_ == ops_[i].entity_) {
+                    continue;
+                }
+                auto& op = ops_[i];
+                if (!registry.valid(op.entity_)) {
+                    continue;
+                }
+                if (!op.value_) {
+                    removed_.push_back(op.entity_);
+                } else if constexpr (std::is_empty_v<Component>) {
+                    registry.emplace_or_replace<Component>(op.entity_);
+                } else {
+                    registry.emplace_or_replace<Component>(op.entity_, std::move(*op.value_));
+                }
+            }
+            registry.remove<Component>(removed_.begin(), removed_.end());
+            ops_.clear();
+        }
+
+        [[nodiscard]] bool empty() const override { return ops_.empty(); }
+    };
+
+    template <typename Component>
+    Batch<Component>& batch() {
+        ++pending_;
+        auto& slot = batch_index_[entt::type_id<Component>().hash()];
+        if (!slot) {
+            batches_.push_back(std::make_unique<Batch<Component>>());
+            slot = batches_.back().get();
+        }
+        return static_cast<Batch<Component>&>(*slot);
+    }
+
+    std::vector<std::unique_ptr<BatchBase>> batches_;               ///< 按首次记录顺序排列，跨帧复用
+    std::unordered_map<entt::id_type, BatchBase*> batch_index_;
+    std::vector<entt::entity> destroyed_;
+    std::vector<std::function<void(entt::registry&)>> callbacks_;
+    std::size_t pending_{0};                                        ///< 未提交的组件操作数
+};
+
+} // namespace engine::ecs
@@ -0,0 +1,81 @@
+#include "event_queues.h"
+
+#include <cstdint>
+#include "../utils/profiler.h"
+
+namespace engine::ecs {
+
+EventQueues::StatsSlot EventQueues::makeStats(std::string_view type_name, bool batched) {
+    // entt::type_name 形如 "game::defs::AttackHitEvent"，计数器只保留最后一段
+    if (const auto pos = type_name.rfind("::"); pos != std::string_view::npos) {
+        type_name.remove_prefix(pos + 2);
+    }
+    StatsSlot slot;
+    slot.stats_.name_ = std::string(type_name);
+    slot.stats_.batched_ = batched;
+    if (engine::utils::Profiler::isThreadSuppressed()) {
+        return slot;    // 不发布计数器，也不驻留名字
+    }
+    auto& profiler = engine::utils::Profiler::instance();
+    slot.count_counter_ = profiler.internName("evt." + slot.stats_.name_);
+    slot.peak_counter_ = profiler.internName("evt." + slot.stats_.name_ + ".peak");
+    return slot;
+}
+
+void EventQueues::disconnect(const void* instance) {
+    for (auto& channel : channels_) {
+        channel->disconnect(instance);
+    }
+}
+
+void EventQueues::sample(const entt::dispatcher& dispatcher) {
+    for (auto& tracked : tracked_) {
+        tracked.slot_.record(tracked.queued_(dispatcher));
+    }
+}
+
+std::size_t EventQueues::flush() {
+    std::size_t dispatched = 0;
+    // 监听函数可能向其他通道追加事件，按下标遍历以容忍派发期间新建通道
+    for (std::size_t i = 0; i < channels_.size(); ++i) {
+        dispatched += channels_[i]->flush();
+    }
+    return dispatched;
+}
+
+void EventQueues::clear() {
+    for (auto& channel : channels_) {
+        channel->clear();
+    }
+}
+
+void EventQueues::publishStats() {
+    auto publish = [](StatsSlot& slot) {
+        ENGINE_PROFILE_COUNTER(slot.count_counter_, static_cast<std::int64_t>(slot.stats_.frame_count_));
+        ENGINE_PROFILE_COUNTER(slot.peak_counter_, static_cast<std::int64_t>(slot.stats_.frame_peak_));
+        slot.stats_.total_ += slot.stats_.frame_count_;
+        slot.stats_.peak_frame_count_ = std::max(slot.stats_.peak_frame_count_, slot.stats_.frame_count_);
+        slot.stats_.frame_count_ = 0;
+        slot.stats_.frame_peak_ = 0;
+    };
+    for (auto& channel : channels_) {
+        publish(channel->slot_);
+    }
+    for (auto& tracked : tracked_) {
+        publish(tracked.slot_);
+    }
+}
+
+std::vector<EventChannelStats> EventQueues::getStats() const {
+    std::vector<EventChannelStats> stats;
+    stats.reserve(channels_.size() + tracked_.size());
+    for (const auto& channel : channels_) {
+        stats.push_back(channel->slot_.stats_);
+    }
+    for (const auto& tracked : tracked_) {
+        stats.push_back(tracked.slot_.stats_);
+    }
+    return stats;
+}
+
+} // namespace engine::ecs
@@ -0,0 +1,196 @@
+#pragma once
+/**
+ * @file event_queues.h
+ * @brief 按事件类型分队列、批量派发的事件通道，并统计每帧事件数与队列峰值。
+ *
+ * @details
+ * entt::dispatcher 对每个事件逐个调用监听函数；命中、治疗这类每帧成百上千条的事件更适合
+ * 一次交给处理系统一整段连续数组。EventQueues 为每种事件类型维护一个 std::vector 队列，
+ * 监听函数签名为 void(std::span<const Event>)，flush() 时按通道注册顺序整段派发。
+ *
+ * - 派发期间向同一通道追加的事件留到下一次 flush（与 dispatcher.update() 语义一致）
+ * - 队列在帧间复用容量，稳定后不再分配
+ * - track<Event>() 可对仍走 entt::dispatcher 的事件采样队列长度，统计一并写入分析器计数器
+ *
+ * @code
+ * event_queues.sink<AttackHitEvent>().connect<&CombatResolveSystem::onAttackEvents>(this);
+ * event_queues.enqueue(AttackHitEvent{ attacker, target, atk });
+ * dispatcher.update();
+ * event_queues.flush();           // 同步点：整段派发本帧累计的事件
+ * event_queues.publishStats();    // 每帧一次：写入 "evt.<类型名>" 与 "evt.<类型名>.peak" 计数器
+ * @endcode
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <entt/core/type_info.hpp>
+#include <entt/signal/dispatcher.hpp>
+#include <entt/signal/sigh.hpp>
+#include "../utils/id_map.h"
+
+namespace engine::ecs {
+
+/// @brief 单个事件类型的统计
+struct EventChannelStats {
+    std::string name_;                  ///< 去掉命名空间的类型名
+    std::size_t frame_count_{0};        ///< 本帧派发（或采样到）的事件数
+    std::size_t frame_peak_{0};         ///< 本帧队列最大长度
+    std::size_t peak_{0};               ///< 历史最大队列长度
+    std::size_t total_{0};              ///< 累计派发（或采样到）的事件数，publishStats 时累加
+    std::size_t peak_frame_count_{0};   ///< 历史单帧最大事件数
+    bool batched_{true};                ///< false 表示 track() 采样的 dispatcher 事件
+};
+
+class EventQueues final {
+public:
+    EventQueues() = default;
+    EventQueues(const EventQueues&) = delete;
+    EventQueues& operator=(const EventQueues&) = delete;
+
+    /// @brief 追加一个事件，等待下一次 flush
+    template <typename Event>
+    void enqueue(Event&& event) {
+        channel<std::decay_t<Event>>().push(std::forward<Event>(event));
+    }
+
+    /// @brief 原地构造事件
+    template <typename Event, typename... Args>
+    void emplace(Args&&... args) {
+        channel<Event>().push(Event{ std::forward<Args>(args)... });
+    }
+
+    /// @brief 批量监听入口，签名为 void(std::span<const Event>)
+    template <typename Event>
+    [[nodiscard]] auto sink() {
+        return entt::sink{ channel<Event>().signal_ };
+    }
+
+    /// @brief 断开 instance 在所有通道上的监听
+    void disconnect(const void* instance);
+
+    /// @brief 对仍由 entt::dispatcher 派发的事件类型采样队列长度（不改变其派发方式）
+    template <typename Event>
+    void track() {
+        const auto id = entt::type_hash<Event>::value();
+        if (std::ranges::find(tracked_, id, &Tracked::id_) == tracked_.end()) {
+            tracked_.push_back({ id, [](const entt::dispatcher& dispatcher) { return dispatcher.size<Event>(); },
+                                 makeStats(entt::type_name<Event>::value(), false) });
+        }
+    }
+
+    /**
+     * @brief 在 dispatcher.update() 之前调用，记录各跟踪类型即将派发的事件数
+     * @details 同一帧可多次调用（多个派发点），事件数累加、峰值取最大。
+     */
+    void sample(const entt::dispatcher& dispatcher);
+
+    /**
+     * @brief 按通道注册顺序整段派发所有待处理事件
+     * @return 本次派发的事件总数
+     */
+    std::size_t flush();
+
+    /// @brief 丢弃所有待处理事件（场景重置时使用）
+    void clear();
+
+    /// @brief 写入本帧统计到分析器计数器并清零帧内统计（每帧调用一次）
+    void publishStats();
+
+    /// @brief 当前统计快照：批量通道在前（注册顺序），跟踪类型在后
+    [[nodiscard]] std::vector<EventChannelStats> getStats() const;
+
+    /// @brief 某类型的待处理事件数
+    template <typename Event>
+    [[nodiscard]] std::size_t size() const {
+        auto it = index_.find(entt::type_hash<Event>::value());
+        return it == index_.end() ? 0u : it->second->pending();
+    }
+
+private:
+    struct StatsSlot {
+        EventChannelStats stats_;
+        const char* count_counter_{nullptr};    ///< 驻留的计数器名（见 Profiler::internName）
+        const char* peak_counter_{nullptr};
+
+        void record(std::size_t count) {
+            stats_.frame_count_ += count;
+            stats_.frame_peak_ = std::max(stats_.frame_peak_, count);
+            stats_.peak_ = std::max(stats_.peak_, count);
+        }
+    };
+
+    struct ChannelBase {
+        virtual ~ChannelBase() = default;
+        virtual std::size_t flush() = 0;
+        virtual void clear() = 0;
+        virtual void disconnect(const void* instance) = 0;
+        [[nodiscard]] virtual std::size_t pending() const = 0;
+
+        StatsSlot slot_;
+    };
+
+    template <typename Event>
+    struct Channel final : ChannelBase {
+        std::vector<Event> queue_;
+        std::vector<Event> dispatching_;
+        entt::sigh<void(std::span<const Event>)> signal_;
+
+        void push(Event event) {
+            queue_.push_back(std::move(event));
+            slot_.stats_.frame_peak_ = std::max(slot_.stats_.frame_peak_, queue_.size());
+            slot_.stats_.peak_ = std::max(slot_.stats_.peak_, queue_.size());
+        }
+
+        std::size_t flush() override {
+            if (queue_.empty()) {
+                return 0;
+            }
+            // 先交换出来：监听函数追加的同类事件进入新队列，留到下一次 flush
+            std::swap(queue_, dispatching_);
+            signal_.publish(std::span<const Event>{ dispatching_ });
+            const std::size_t count = dispatching_.size();
+            slot_.stats_.frame_count_ += count;
+            dispatching_.clear();
+            return count;
+        }
+
+        void clear() override { queue_.clear(); }
+
+        void disconnect(const void* instance) override { entt::sink{ signal_ }.disconnect(instance); }
+
+        [[nodiscard]] std::size_t pending() const override { return queue_.size(); }
+    };
+
+    struct Tracked {
+        entt::id_type id_;
+        std::size_t (*queued_)(const entt::dispatcher&);
+        StatsSlot slot_;
+    };
+
+    template <typename Event>
+    Channel<Event>& channel() {
+        auto& slot = index_[entt::type_hash<Event>::value()];
+        if (!slot) {
+            auto created = std::make_unique<Channel<Event>>();
+            created->slot_ = makeStats(entt::type_name<Event>::value(), true);
+            slot = created.get();
+            channels_.push_back(std::move(created));
+        }
+        return static_cast<Channel<Event>&>(*slot);
+    }
+
+    static StatsSlot makeStats(std::string_view type_name, bool batched);
+
+    std::vector<std::unique_ptr<ChannelBase>> channels_;    ///< 按首次使用顺序排列，决定派发顺序
+    engine::utils::IdMap<ChannelBase*> index_;
+    std::vector<Tracked> tracked_;
+};
+
+} // namespace engine::ecs
@@ -0,0 +1,47 @@
+#pragma once
+/**
+ * @file groups.h
+ * @brief 引擎热点组件组合的 EnTT 拥有型分组（owning group）。
+ *
+ * @details
+ * 分组拥有的组件在各自存储中按组内顺序紧密排列，遍历时无需稀疏查找。
+ * 同一组件只能被一个分组拥有，因此：
+ * - TransformComponent 归渲染分组所有（渲染、Y 排序两个系统每帧遍历）；
+ * - 移动分组只拥有 VelocityComponent，TransformComponent 作为非拥有成员获取。
+ *
+ * 图像图层（带 ParallaxComponent）同样具有这三种组件，但由 ParallaxRenderSystem 单独绘制，
+ * 渲染分组把它们排除在外，RenderSystem 的剔除/排序与 YSortSystem 都不会遍历到它们。
+ *
+ * 被拥有的存储不能再直接 registry.sort<>()，需要排序时使用分组的 sort()（见 RenderSystem）。
+ * 分组在首次调用时创建，场景初始化时调用 declareGroups() 提前建立，避免首帧整理存储。
+ */
+
+#include <entt/entity/registry.hpp>
+#include "../component/disabled_tag.h"
+#include "../component/parallax_component.h"
+#include "../component/render_component.h"
+#include "../component/sprite_component.h"
+#include "../component/transform_component.h"
+#include "../component/velocity_component.h"
+
+namespace engine::ecs {
+
+/// @brief 可渲染实体：拥有 Render / Transform / Sprite（不含图像图层）
+inline auto renderGroup(entt::registry& registry) {
+    return registry.group<component::RenderComponent, component::TransformComponent, component::SpriteComponent>(
+        entt::get<>, entt::exclude<component::DisabledTag, component::ParallaxComponent>);
+}
+
+/// @brief 可移动实体：拥有 Velocity，获取 Transform
+inline auto movementGroup(entt::registry& registry) {
+    return registry.group<component::VelocityComponent>(
+        entt::get<component::TransformComponent>, entt::exclude<component::DisabledTag>);
+}
+
+/// @brief 建立引擎层全部分组
+inline void declareGroups(entt::registry& registry) {
+    static_cast<void>(renderGroup(registry));
+    static_cast<void>(movementGroup(registry));
+}
+
+} // namespace engine::ecs
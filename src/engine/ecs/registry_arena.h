@@ -0,0 +1,40 @@
+#pragma once
+/**
+ * @file registry_arena.h
+ * @brief 注册表与其 StorageArena 的绑定，以及在 arena 中预留组件存储的辅助函数。
+ *
+ * @details
+ * 场景创建 arena 后把 RegistryArena 放进注册表的上下文变量；各处预留存储改用 reserveStorage<T>()，
+ * 预留期间的分配落在 arena 中。注册表没有绑定 arena 时与直接调用 storage<T>().reserve() 相同。
+ *
+ * @code
+ * registry.ctx().emplace<engine::ecs::RegistryArena>(arena.get());
+ * engine::ecs::reserveStorage<TransformComponent>(registry, 1024);
+ * @endcode
+ */
+
+#include "../memory/storage_arena.h"
+#include <cstddef>
+#include <entt/entity/registry.hpp>
+
+namespace engine::ecs {
+
+/// @brief 注册表上下文变量：组件存储所用的 arena（不拥有）
+struct RegistryArena {
+    engine::memory::StorageArena* arena_{ nullptr };
+};
+
+/// @brief 注册表绑定的 arena，没有绑定时返回 nullptr
+[[nodiscard]] inline engine::memory::StorageArena* registryArena(entt::registry& registry) {
+    const auto* binding = registry.ctx().find<RegistryArena>();
+    return binding ? binding->arena_ : nullptr;
+}
+
+/// @brief 把组件 T 的存储预留到 capacity 个元素（注册表绑定了 arena 时在 arena 中分配）
+template <typename T>
+void reserveStorage(entt::registry& registry, std::size_t capacity) {
+    const engine::memory::StorageArenaScope scope{ registryArena(registry) };
+    registry.storage<T>().reserve(capacity);
+}
+
+} // namespace engine::ecs
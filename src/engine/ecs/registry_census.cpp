@@ -0,0 +1,79 @@
+#include "registry_census.h"
+#include <algorithm>
+#include <utility>
+
+namespace engine::ecs {
+
+namespace {
+
+/// @brief "struct game::defs::DeadTag" -> "DeadTag"
+std::string_view shortTypeName(std::string_view name) {
+    if (const auto pos = name.rfind("::"); pos != std::string_view::npos) {
+        name.remove_prefix(pos + 2);
+    } else if (const auto space = name.rfind(' '); space != std::string_view::npos) {
+        name.remove_prefix(space + 1);
+    }
+    return name;
+}
+
+} // namespace
+
+RegistryCensus::~RegistryCensus() {
+    setEnabled(false);
+}
+
+void RegistryCensus::setEnabled(bool enabled) {
+    if (enabled_ == enabled) {
+        return;
+    }
+    enabled_ = enabled;
+    for (auto& slot : slots_) {
+        slot.connect_(registry_, slot, enabled);
+        slot.emplaced_ = slot.removed_ = 0;
+        slot.sampled_emplaced_ = slot.sampled_removed_ = 0;
+        slot.emplace_rate_ = slot.remove_rate_ = 0.0;
+    }
+    sampled_at_ = std::chrono::steady_clock::now();
+}
+
+const std::vector<StorageCensus>& RegistryCensus::refresh() {
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(now - sampled_at_).count();
+    if (enabled_ && elapsed >= 1.0) {
+        for (auto& slot : slots_) {
+            slot.emplace_rate_ = static_cast<double>(slot.emplaced_ - slot.sampled_emplaced_) / elapsed;
+            slot.remove_rate_ = static_cast<double>(slot.removed_ - slot.sampled_removed_) / elapsed;
+            slot.sampled_emplaced_ = slot.emplaced_;
+            slot.sampled_removed_ = slot.removed_;
+        }
+        sampled_at_ = now;
+    }
+
+    storages_.clear();
+    total_bytes_ = 0;
+    for (auto [id, storage] : std::as_const(registry_).storage()) {
+        StorageCensus row;
+        row.name_ = shortTypeName(storage.type().name());
+        row.size_ = storage.size();
+        row.capacity_ = storage.capacity();
+        row.bytes_ = (storage.extent() + storage.size()) * sizeof(entt::entity);
+        const auto hash = storage.type().hash();
+        if (const auto it = std::ranges::find(slots_, hash, &Slot::type_); it != slots_.end()) {
+            row.watched_ = true;
+            row.bytes_ += row.capacity_ * it->value_size_;
+            row.emplace_per_second_ = it->emplace_rate_;
+            row.remove_per_second_ = it->remove_rate_;
+        }
+        total_bytes_ += row.bytes_;
+        storages_.push_back(row);
+    }
+    std::ranges::sort(storages_, std::ranges::greater{}, &StorageCensus::bytes_);
+
+    archetype_counts_.clear();
+    for (const auto& archetype : archetypes_) {
+        archetype_counts_.push_back(ArchetypeCensus{ archetype.label_, archetype.count_(registry_) });
+    }
+    return storages_;
+}
+
+} // namespace engine::ecs
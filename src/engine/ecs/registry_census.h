@@ -0,0 +1,152 @@
+#pragma once
+/**
+ * @file registry_census.h
+ * @brief 注册表普查：逐个存储的数量/容量/字节与增删频率，以及按组件组合统计的实体数（调试面板使用）。
+ *
+ * @details
+ * - 存储行来自 registry.storage() 的类型擦除遍历，所有存储都有数量与容量
+ * - watch<T>() 登记过的类型额外计入值数组字节，并在启用时经 on_construct / on_destroy 信号统计每秒增删次数
+ *   （标签组件反复挂取造成的存储抖动就体现在这里）
+ * - addArchetype<T...>(label) 登记一种组件组合，refresh() 时按视图计数
+ * - 只在面板展开时 setEnabled(true)：关闭时不连接任何信号，热路径上没有额外开销
+ *
+ * @code
+ * auto census = std::make_unique<engine::ecs::RegistryCensus>(registry);
+ * census->watch<TransformComponent>();
+ * census->addArchetype<EnemyComponent, BlockedByComponent>("敌人+被阻挡");
+ * registry.ctx().emplace<engine::ecs::RegistryCensus&>(*census);
+ * ...
+ * census->setEnabled(true);
+ * for (const auto& row : census->refresh()) { ... }
+ * @endcode
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <entt/core/type_info.hpp>
+#include <entt/entity/registry.hpp>
+
+namespace engine::ecs {
+
+/**
+ * @brief 单个存储的普查结果
+ */
+struct StorageCensus {
+    std::string_view name_;             ///< 类型名（去掉命名空间）
+    std::size_t size_{ 0 };
+    std::size_t capacity_{ 0 };
+    std::size_t bytes_{ 0 };            ///< 稀疏索引 + 紧凑实体数组，登记过的类型另含值数组
+    bool watched_{ false };             ///< 是否登记了类型（字节含值数组、有增删频率）
+    double emplace_per_second_{ 0.0 };
+    double remove_per_second_{ 0.0 };
+};
+
+/**
+ * @brief 一种组件组合的实体数
+ */
+struct ArchetypeCensus {
+    std::string label_;
+    std::size_t count_{ 0 };
+};
+
+class RegistryCensus final {
+public:
+    explicit RegistryCensus(entt::registry& registry) : registry_(registry) {}
+    ~RegistryCensus();
+
+    RegistryCensus(const RegistryCensus&) = delete;
+    RegistryCensus& operator=(const RegistryCensus&) = delete;
+
+    /// @brief 登记组件类型（重复登记忽略）；已启用时立即开始统计增删
+    template <typename T>
+    void watch() {
+        const auto hash = entt::type_hash<T>::value();
+        for (const auto& slot : slots_) {
+            if (slot.type_ == hash) {
+                return;
+            }
+        }
+        auto& slot = slots_.emplace_back();
+        slot.type_ = hash;
+        slot.value_size_ = std::is_empty_v<T> ? 0u : sizeof(T);
+        slot.connect_ = &connectSlot<T>;
+        if (enabled_) {
+            slot.connect_(registry_, slot, true);
+        }
+    }
+
+    /// @brief 登记一种组件组合，refresh() 时统计同时拥有这些组件的实体数
+    template <typename... T>
+    void addArchetype(std::string label) {
+        archetypes_.push_back(Archetype{ std::move(label), [](const entt::registry& registry) {
+            std::size_t count = 0;
+            for ([[maybe_unused]] const auto entity : registry.view<T...>()) {
+                ++count;
+            }
+            return count;
+        } });
+    }
+
+    /// @brief 启用时连接全部登记类型的信号并清零计数，关闭时断开
+    void setEnabled(bool enabled);
+    [[nodiscard]] bool isEnabled() const { return enabled_; }
+
+    /**
+     * @brief 重新统计全部存储与组合，按字节数降序；距上次采样满 1 秒时更新增删频率
+     * @return 存储行（下次 refresh() 前有效）
+     */
+    const std::vector<StorageCensus>& refresh();
+
+    [[nodiscard]] const std::vector<StorageCensus>& getStorages() const { return storages_; }
+    [[nodiscard]] const std::vector<ArchetypeCensus>& getArchetypes() const { return archetype_counts_; }
+    [[nodiscard]] std::size_t getTotalBytes() const { return total_bytes_; }
+
+private:
+    struct Slot {
+        entt::id_type type_{ 0 };
+        std::size_t value_size_{ 0 };
+        std::uint64_t emplaced_{ 0 };
+        std::uint64_t removed_{ 0 };
+        std::uint64_t sampled_emplaced_{ 0 };   ///< 上次采样时的计数
+        std::uint64_t sampled_removed_{ 0 };
+        double emplace_rate_{ 0.0 };
+        double remove_rate_{ 0.0 };
+        void (*connect_)(entt::registry&, Slot&, bool){ nullptr };
+    };
+
+    struct Archetype {
+        std::string label_;
+        std::size_t (*count_)(const entt::registry&){ nullptr };
+    };
+
+    static void countEmplace(Slot& slot, entt::registry&, entt::entity) { ++slot.emplaced_; }
+    static void countRemove(Slot& slot, entt::registry&, entt::entity) { ++slot.removed_; }
+
+    template <typename T>
+    static void connectSlot(entt::registry& registry, Slot& slot, bool connect) {
+        if (connect) {
+            registry.on_construct<T>().template connect<&RegistryCensus::countEmplace>(slot);
+            registry.on_destroy<T>().template connect<&RegistryCensus::countRemove>(slot);
+        } else {
+            registry.on_construct<T>().template disconnect<&RegistryCensus::countEmplace>(slot);
+            registry.on_destroy<T>().template disconnect<&RegistryCensus::countRemove>(slot);
+        }
+    }
+
+    entt::registry& registry_;
+    std::deque<Slot> slots_;                    ///< deque 扩容不移动已有元素，信号持有的槽引用保持有效
+    std::vector<Archetype> archetypes_;
+    std::vector<StorageCensus> storages_;
+    std::vector<ArchetypeCensus> archetype_counts_;
+    std::size_t total_bytes_{ 0 };
+    std::chrono::steady_clock::time_point sampled_at_{};
+    bool enabled_{ false };
+};
+
+} // namespace engine::ecs
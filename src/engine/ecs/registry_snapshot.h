@@ -0,0 +1,194 @@
+#pragma once
+/**
+ * @file registry_snapshot.h
+ * @brief 注册表的内存快照：按组件列表整存储复制，恢复时批量写回，实体标识（含版本号）保持不变。
+ *
+ * @details
+ * capture() 经 entt::snapshot 遍历实体表与每个组件存储，把实体与组件值复制进按类型分开的连续数组；
+ * restore() 清空注册表后按 entt::snapshot_loader 相同的顺序重建实体表，再对每个组件存储做一次
+ * registry.insert 批量写回（不要求组件可默认构造，这是不直接使用 snapshot_loader 的原因）。
+ *
+ * - 只复制 Component 列表中的类型；findUncovered() 列出注册表中有数据但不在列表里的存储，恢复会丢失它们
+ * - 恢复会逐个触发 on_destroy / on_construct 信号，依赖信号维护的索引（Y 排序、血条等）随之保持一致
+ * - registry.ctx() 不在快照中
+ * - 快照对象可重复 capture，数组容量复用
+ * - getStorageBytes() 按同一组件列表估算注册表存储的内存占用（内存面板使用）
+ *
+ * @code
+ * engine::ecs::RegistrySnapshot<TransformComponent, SpriteComponent, DeadTag> snapshot;
+ * snapshot.capture(registry);
+ * ...
+ * snapshot.restore(registry);     // 回到 capture 时的状态
+ * @endcode
+ */
+
+#include "registry_arena.h"
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <entt/core/type_info.hpp>
+#include <entt/entity/registry.hpp>
+#include <entt/entity/snapshot.hpp>
+
+namespace engine::ecs {
+
+template <typename... Component>
+class RegistrySnapshot final {
+    using entity_type = typename entt::entt_traits<entt::entity>::entity_type;
+
+public:
+    /// @brief 复制注册表当前的实体表与所有列出的组件存储
+    void capture(const entt::registry& registry) {
+        entities_.clear();
+        entity_header_.clear();
+        (std::get<Pool<Component>>(pools_).clear(), ...);
+
+        Writer writer{ *this };
+        const entt::snapshot snapshot{ registry };
+        writer.template select<entt::entity>();
+        snapshot.template get<entt::entity>(writer);
+        ((writer.template select<Component>(), snapshot.template get<Component>(writer)), ...);
+        captured_ = true;
+    }
+
+    /// @brief 清空注册表（ctx 除外）并写回快照内容；未 capture 过时什么也不做
+    void restore(entt::registry& registry) const {
+        if (!captured_) {
+            return;
+        }
+        registry.clear();
+
+        // 与 snapshot_loader 相同：按写出顺序以原标识重建实体（含已释放的），再恢复空闲链表长度
+        auto& storage = registry.storage<entt::entity>();
+        reserveStorage<entt::entity>(registry, entities_.size());
+        for (const auto entity : entities_) {
+            static_cast<void>(registry.create(entity));
+        }
+        storage.free_list(entity_header_.size() > 1 ? entity_header_[1] : entity_type{ 0 });
+
+        (restorePool<Component>(registry), ...);
+    }
+
+    [[nodiscard]] bool empty() const { return !captured_; }
+
+    /// @brief 快照中存活的实体数
+    [[nodiscard]] std::size_t getEntityCount() const {
+        return entity_header_.size() > 1 ? static_cast<std::size_t>(entity_header_[1]) : 0u;
+    }
+
+    /// @brief 快照中组件实例的总数（空类型标签也计入）
+    [[nodiscard]] std::size_t getComponentCount() const {
+        return (std::get<Pool<Component>>(pools_).entities_.size() + ... + 0u);
+    }
+
+    /**
+     * @brief 注册表存储的内存估算（字节）
+     * @details 所有存储的稀疏索引与紧凑实体数组，加上列出组件的值数组（按已分配容量计）；
+     *          不在组件列表中的存储只计索引部分。
+     */
+    [[nodiscard]] static std::size_t getStorageBytes(const entt::registry& registry) {
+        std::size_t bytes = 0;
+        for (auto [id, storage] : registry.storage()) {
+            bytes += (storage.extent() + storage.size()) * sizeof(entt::entity);
+        }
+        return (bytes + ... + valueBytes<Component>(registry));
+    }
+
+    /// @brief 按列表顺序对每个组件类型调用 visitor.template operator()<T>()
+    template <typename Visitor>
+    static void forEachComponent(Visitor&& visitor) {
+        (visitor.template operator()<Component>(), ...);
+    }
+
+    /// @brief 注册表中有数据但不在组件列表里的存储类型名（恢复时这些组件会丢失）
+    [[nodiscard]] static std::vector<std::string_view> findUncovered(const entt::registry& registry) {
+        std::vector<std::string_view> uncovered;
+        for (auto [id, storage] : registry.storage()) {
+            const auto hash = storage.type().hash();
+            if (!storage.empty() && hash != entt::type_hash<entt::entity>::value() &&
+                ((hash != entt::type_hash<Component>::value()) && ...)) {
+                uncovered.push_back(storage.type().name());
+            }
+        }
+        return uncovered;
+    }
+
+private:
+    template <typename T>
+    struct Pool {
+        std::vector<entt::entity> entities_;
+        std::vector<T> values_;     ///< 空类型标签不使用
+
+        void clear() {
+            entities_.clear();
+            values_.clear();
+        }
+    };
+
+    /// @brief entt::snapshot 的输出归档：计数、实体与组件值分别写入当前选中类型的数组
+    class Writer {
+    public:
+        explicit Writer(RegistrySnapshot& owner) : owner_(owner) {}
+
+        template <typename T>
+        void select() {
+            select_entities_ = std::is_same_v<T, entt::entity>;
+            if constexpr (!std::is_same_v<T, entt::entity>) {
+                current_ = &std::get<Pool<T>>(owner_.pools_).entities_;
+            }
+        }
+
+        void operator()(entity_type count) {
+            if (select_entities_) {
+                owner_.entity_header_.push_back(count);     // 实体表：总数、存活数
+            }
+        }
+
+        void operator()(entt::entity entity) {
+            (select_entities_ ? owner_.entities_ : *current_).push_back(entity);
+        }
+
+        template <typename T>
+        void operator()(const T& value) {
+            std::get<Pool<T>>(owner_.pools_).values_.push_back(value);
+        }
+
+    private:
+        RegistrySnapshot& owner_;
+        std::vector<entt::entity>* current_{ nullptr };
+        bool select_entities_{ false };
+    };
+
+    template <typename T>
+    [[nodiscard]] static std::size_t valueBytes(const entt::registry& registry) {
+        if constexpr (std::is_empty_v<T>) {
+            return 0u;
+        } else {
+            const auto* storage = registry.storage<T>();
+            return storage ? storage->capacity() * sizeof(T) : 0u;
+        }
+    }
+
+    template <typename T>
+    void restorePool(entt::registry& registry) const {
+        const auto& pool = std::get<Pool<T>>(pools_);
+        if (pool.entities_.empty()) {
+            return;
+        }
+        reserveStorage<T>(registry, pool.entities_.size());
+        if constexpr (std::is_empty_v<T>) {
+            registry.insert<T>(pool.entities_.begin(), pool.entities_.end());
+        } else {
+            registry.insert<T>(pool.entities_.begin(), pool.entities_.end(), pool.values_.begin());
+        }
+    }
+
+    std::vector<entt::entity> entities_;        ///< 实体表（含已释放的标识，顺序与 entt::snapshot 写出一致）
+    std::vector<entity_type> entity_header_;    ///< entt::snapshot 为实体表写出的计数
+    std::tuple<Pool<Component>...> pools_;
+    bool captured_{ false };
+};
+
+} // namespace engine::ecs
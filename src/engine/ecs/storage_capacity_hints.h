@@ -0,0 +1,89 @@
+#pragma once
+/**
+ * @file storage_capacity_hints.h
+ * @brief 跨场景保留的存储容量：场景销毁前记下各存储的容量，下一个同类场景建实体前一次预留到位。
+ *
+ * @details
+ * 切关与（没有检查点时的）重开会销毁整个场景，新场景的 entt::registry 从空存储开始按倍数增长，
+ * 关卡加载与前几波期间反复重新分配。StorageCapacityHints 放在 ContentCache 中（不随场景销毁），
+ * 以存储 id（entt::type_hash）为键保存观测到的最大容量：
+ * - record()：场景清理时遍历注册表的全部存储与实体存储，取容量的最大值
+ * - reserve<T>()：新场景在创建任何实体之前按记录预留（没有记录的类型不做任何事）
+ *
+ * 记录只增不减，取各关卡的最大值；首个场景没有记录，仍依赖 CapacityPlanner 的估算。
+ *
+ * @code
+ * auto hints = context.getContentCache().getOrLoad<engine::ecs::StorageCapacityHints>("storage_capacity"_hs, {}, [] {
+ *     return std::make_shared<engine::ecs::StorageCapacityHints>();
+ * });
+ * hints->reserveEntities(registry);
+ * hints->reserve<TransformComponent>(registry);
+ * ...
+ * hints->record(registry);     // 场景清理时
+ * @endcode
+ */
+
+#include "registry_arena.h"
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <entt/core/type_info.hpp>
+#include <entt/entity/registry.hpp>
+
+namespace engine::ecs {
+
+class StorageCapacityHints final {
+public:
+    /// @brief 记下注册表中每个存储（含实体存储）的容量，与已有记录取最大值
+    void record(const entt::registry& registry) {
+        for (auto [id, storage] : registry.storage()) {
+            note(id, storage.capacity());
+        }
+        if (const auto* entities = registry.storage<entt::entity>()) {
+            note(entt::type_hash<entt::entity>::value(), entities->capacity());
+        }
+    }
+
+    /// @brief 按记录预留组件 T 的存储
+    template <typename T>
+    void reserve(entt::registry& registry) const {
+        if (const auto capacity = find(entt::type_hash<T>::value()); capacity > 0) {
+            reserveStorage<T>(registry, capacity);
+        }
+    }
+
+    /// @brief 按记录预留实体存储
+    void reserveEntities(entt::registry& registry) const {
+        if (const auto capacity = find(entt::type_hash<entt::entity>::value()); capacity > 0) {
+            reserveStorage<entt::entity>(registry, capacity);
+        }
+    }
+
+    /// @brief 已记录的元素总数（日志用）
+    [[nodiscard]] std::size_t totalCapacity() const {
+        std::size_t total = 0;
+        for (const auto& [id, capacity] : capacities_) {
+            total += capacity;
+        }
+        return total;
+    }
+
+    [[nodiscard]] bool empty() const { return capacities_.empty(); }
+
+private:
+    void note(entt::id_type id, std::size_t capacity) {
+        if (capacity > 0) {
+            auto& stored = capacities_[id];
+            stored = std::max(stored, capacity);
+        }
+    }
+
+    [[nodiscard]] std::size_t find(entt::id_type id) const {
+        const auto it = capacities_.find(id);
+        return it != capacities_.end() ? it->second : 0;
+    }
+
+    std::unordered_map<entt::id_type, std::size_t> capacities_;
+};
+
+} // namespace engine::ecs
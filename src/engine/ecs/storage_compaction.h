@@ -0,0 +1,107 @@
+#pragma once
+/**
+ * @file storage_compaction.h
+ * @brief 波次间隔中的存储整理：按调用方给出的确定性键重排紧凑数组，收缩空闲容量过大的存储。
+ *
+ * @details
+ * 一波大量敌人清空之后，各组件存储的容量停在峰值，增删交替也打乱了紧凑数组的顺序，
+ * 同一批单位在各存储中的位置互不对应。在没有单位移动的波次间隔中整理一次：
+ * - sortStoragesByKey<T...>(registry, key)：把列出的存储按 key(entity) 升序稳定重排（只重排变乱了的存储），
+ *   键相同的实体保持原有的相对顺序。被分组拥有的存储（Transform / Sprite / Render / Velocity / Stats）不能直接排序，
+ *   不要列出；渲染分组已由 RenderSystem 按绘制顺序整理
+ * - shrinkStorages()：容量超出「当前数量 + headroom」slack 倍且多出至少 MIN_SHRINK_SLOTS 个元素的存储
+ *   先 shrink_to_fit() 再预留回「当前数量 + headroom」，headroom 为后续波次的峰值需求，
+ *   下一波开战时不会重新扩容。注册表绑定了 StorageArena 时跳过：arena 内的释放是空操作，收缩只会多占 arena
+ *
+ * 重排改变视图的遍历顺序，模拟结果依赖它。键必须在需要逐步一致的各次运行中相同：实体句柄（含下标）不满足，
+ * 实机的预热、UI 与地图区块实体也占用下标，回收的句柄版本号也不同；应使用生成序号一类记录在组件上的值。
+ * 实体标识本身不重新编号：目标、阻挡者等组件、检查点与回放都引用它们。
+ *
+ * @code
+ * engine::ecs::sortStoragesByKey<AnimationComponent, TargetComponent>(registry, [&](entt::entity e) { return spawnOrder(e); });
+ * const auto shrink = engine::ecs::shrinkStorages(registry, next_wave_enemies);
+ * @endcode
+ */
+
+#include "registry_arena.h"
+#include <algorithm>
+#include <cstddef>
+#include <entt/core/type_info.hpp>
+#include <entt/entity/entity.hpp>
+#include <utility>
+#include <entt/entity/registry.hpp>
+
+namespace engine::ecs {
+
+/// @brief 一次收缩的结果
+struct ShrinkResult {
+    std::size_t storages_{ 0 };         ///< 收缩的存储数
+    std::size_t released_slots_{ 0 };   ///< 释放的元素容量
+    bool skipped_{ false };             ///< 注册表绑定了 arena，未收缩
+};
+
+inline constexpr float DEFAULT_SHRINK_SLACK = 1.5f;        ///< 容量超出需求的倍数阈值
+inline constexpr std::size_t MIN_SHRINK_SLOTS = 256;      ///< 至少多出这么多元素才收缩（小存储不值得重新分配）
+
+/// @brief 稳定排序（键相同的实体不交换，重排结果只取决于键与原有顺序）
+struct StableSort {
+    template <typename It, typename Compare>
+    void operator()(It first, It last, Compare compare) const {
+        std::stable_sort(std::move(first), std::move(last), std::move(compare));
+    }
+};
+
+/**
+ * @brief 把列出的存储按 key(entity) 升序稳定重排
+ * @param key 实体到可比较键的映射，须对需要逐步一致的各次运行给出相同结果
+ * @return 实际重排的存储数（已有序或不存在的不计）
+ */
+template <typename... Component, typename Key>
+std::size_t sortStoragesByKey(entt::registry& registry, Key key) {
+    std::size_t sorted = 0;
+    const auto less = [&key](const entt::entity lhs, const entt::entity rhs) { return key(lhs) < key(rhs); };
+    auto sort_one = [&]<typename T>() {
+        const auto* storage = std::as_const(registry).storage<T>();
+        // 按基类（实体序列）比较，迭代顺序与 sort() 的排序结果一致
+        if (!storage || storage->size() < 2 || std::ranges::is_sorted(static_cast<const entt::sparse_set&>(*storage), less)) {
+            return;
+        }
+        registry.sort<T>(less, StableSort{});
+        ++sorted;
+    };
+    (sort_one.template operator()<Component>(), ...);
+    return sorted;
+}
+
+/**
+ * @brief 收缩空闲容量过大的存储（含实体存储以外的全部存储）
+ * @param headroom 每个存储在当前数量之外保留的容量（后续波次的峰值需求）
+ * @param slack 容量超出 (数量 + headroom) 的倍数达到该值才收缩
+ */
+inline ShrinkResult shrinkStorages(entt::registry& registry, std::size_t headroom, float slack = DEFAULT_SHRINK_SLACK) {
+    ShrinkResult result;
+    if (registryArena(registry)) {
+        result.skipped_ = true;
+        return result;
+    }
+    const auto entity_storage = entt::type_hash<entt::entity>::value();
+    for (auto [id, storage] : registry.storage()) {
+        if (storage.type().hash() == entity_storage) {
+            continue;
+        }
+        const auto capacity = storage.capacity();
+        const auto target = storage.size() + headroom;
+        if (capacity < target + MIN_SHRINK_SLOTS || static_cast<float>(capacity) < static_cast<float>(target) * slack) {
+            continue;
+        }
+        storage.shrink_to_fit();
+        storage.reserve(target);
+        if (storage.capacity() < capacity) {
+            ++result.storages_;
+            result.released_slots_ += capacity - storage.capacity();
+        }
+    }
+    return result;
+}
+
+} // namespace engine::ecs
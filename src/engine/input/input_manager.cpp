@@ -2,11 +2,39 @@
 #include "spdlog/spdlog.h"
 #include "../utils/events.h"
 #include "../core/config.h"
+#include "../utils/profiler.h"
+#include <algorithm>
+#include <bit>
+#if MONSTERWAR_DEBUG_TOOLS
 #include <imgui.h>
 #include <backends/imgui_impl_sdl3.h>
+#endif
 
 namespace engine::input {
 
+namespace {
+
+/// @brief 计入延迟统计的用户输入事件
+bool isUserInputEvent(Uint32 type) {
+	switch (type) {
+	case SDL_EVENT_KEY_DOWN:
+	case SDL_EVENT_KEY_UP:
+	case SDL_EVENT_MOUSE_BUTTON_DOWN:
+	case SDL_EVENT_MOUSE_BUTTON_UP:
+	case SDL_EVENT_MOUSE_MOTION:
+	case SDL_EVENT_MOUSE_WHEEL:
+		return true;
+	default:
+		return false;
+	}
+}
+
+double nsToMs(Uint64 ns) {
+	return static_cast<double>(ns) / 1'000'000.0;
+}
+
+} // namespace
+
 /**
  * @brief 构造函数
  * 
@@ -41,24 +69,124 @@ InputManager::InputManager(SDL_Renderer* sdl_renderer, entt::dispatcher* dispatc
  */
 void InputManager::Update()
 {
-   mouse_wheel_delta_ = { 0.0f, 0.0f };
-	for (auto& [action_id, state] : action_states_) {
-		if (state == ActionState::PRESSED) {
-			state = ActionState::HELD;
+	mouse_wheel_delta_ = { 0.0f, 0.0f };
+	// PRESSED → HELD、RELEASED → INACTIVE：只需清空两个单帧位集
+	std::ranges::fill(pressed_bits_, 0u);
+	std::ranges::fill(released_bits_, 0u);
+	// 一次泵入，按批取出：高回报率鼠标每帧可能有数百个移动事件
+	SDL_PumpEvents();
+	int count = 0;
+	do {
+		count = SDL_PeepEvents(event_batch_.data(), EVENT_BATCH_SIZE, SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
+		if (count < 0) {
+			spdlog::warn("输入管理器: SDL_PeepEvents 失败: {}", SDL_GetError());
+			break;
+		}
+		const Uint64 now_ns = SDL_GetTicksNS();
+		for (int i = 0; i < count; ++i) {
+			queueEvent(event_batch_[static_cast<std::size_t>(i)], now_ns);
+		}
+	} while (count == EVENT_BATCH_SIZE);
+	flushPendingMotion();
+	fireActionSignals();
+}
+
+void InputManager::queueEvent(const SDL_Event& event, Uint64 now_ns)
+{
+	if (isUserInputEvent(event.type)) {
+		const Uint64 timestamp = event.common.timestamp;
+		++frame_latency_.events_;
+		if (timestamp != 0 && timestamp <= now_ns) {
+			frame_latency_.consume_max_ms_ = std::max(frame_latency_.consume_max_ms_, nsToMs(now_ns - timestamp));
+			if (oldest_event_ns_ == 0 || timestamp < oldest_event_ns_) {
+				oldest_event_ns_ = timestamp;
+			}
+			newest_event_ns_ = std::max(newest_event_ns_, timestamp);
+			if (event.type != SDL_EVENT_MOUSE_MOTION && event.type != SDL_EVENT_MOUSE_WHEEL) {
+				last_button_ns_ = timestamp;
+				last_button_frame_ = presented_frames_;
+			}
 		}
-		else if (state == ActionState::RELEASED) {
-			state = ActionState::INACTIVE;
+	}
+
+	if (event.type == SDL_EVENT_MOUSE_MOTION) {
+		// 只保留最新的一个：中间位置既不影响动作状态，也不需要逐个做坐标转换
+		if (has_pending_motion_) {
+			++frame_latency_.coalesced_motion_;
 		}
+		pending_motion_ = event;
+		has_pending_motion_ = true;
+		return;
 	}
-	SDL_Event event;
-	while (SDL_PollEvent(&event)) {
-		processEvent(event);
+	// 按钮/滚轮事件自带坐标或依赖当前悬停位置，先让之前的移动落地以保持顺序
+	if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN || event.type == SDL_EVENT_MOUSE_BUTTON_UP || event.type == SDL_EVENT_MOUSE_WHEEL) {
+		flushPendingMotion();
 	}
-	// 触发对应动作的实体响应
-	for (auto& [action_id, state] : action_states_) {
-		if(state != ActionState::INACTIVE) {
-			if(auto it = action_entities_.find(action_id); it != action_entities_.end()) {
-				it->second.at(static_cast<size_t>(state)).collect([](bool result){ 
+	processEvent(event);
+}
+
+void InputManager::flushPendingMotion()
+{
+	if (has_pending_motion_) {
+		has_pending_motion_ = false;
+		processEvent(pending_motion_);
+	}
+}
+
+void InputManager::onFramePresented()
+{
+	const Uint64 now_ns = SDL_GetTicksNS();
+	if (oldest_event_ns_ != 0 && oldest_event_ns_ <= now_ns) {
+		frame_latency_.present_max_ms_ = nsToMs(now_ns - oldest_event_ns_);
+		frame_latency_.present_min_ms_ = nsToMs(now_ns - std::min(newest_event_ns_, now_ns));
+	}
+	if (command_input_ns_ != 0 && command_input_ns_ <= now_ns) {
+		frame_latency_.command_ms_ = nsToMs(now_ns - command_input_ns_);
+		frame_latency_.command_frames_ = static_cast<std::uint32_t>(presented_frames_ - command_frame_ + 1);
+		ENGINE_PROFILE_COUNTER("input.command_us", static_cast<std::int64_t>(frame_latency_.command_ms_ * 1000.0));
+		ENGINE_PROFILE_COUNTER("input.command_frames", static_cast<std::int64_t>(frame_latency_.command_frames_));
+		spdlog::debug("玩家指令: 输入 → 上屏 {:.2f} ms（{} 帧）", frame_latency_.command_ms_, frame_latency_.command_frames_);
+	}
+	latency_ = frame_latency_;
+	ENGINE_PROFILE_COUNTER("input.events", static_cast<std::int64_t>(latency_.events_));
+	ENGINE_PROFILE_COUNTER("input.motion_coalesced", static_cast<std::int64_t>(latency_.coalesced_motion_));
+	ENGINE_PROFILE_COUNTER("input.consume_us", static_cast<std::int64_t>(latency_.consume_max_ms_ * 1000.0));
+	ENGINE_PROFILE_COUNTER("input.present_us", static_cast<std::int64_t>(latency_.present_max_ms_ * 1000.0));
+	frame_latency_ = {};
+	oldest_event_ns_ = 0;
+	newest_event_ns_ = 0;
+	command_input_ns_ = 0;
+	++presented_frames_;
+}
+
+void InputManager::markCommand()
+{
+	++frame_latency_.commands_;
+	// 同一帧的多条指令按最早的输入计
+	if (command_input_ns_ == 0 && last_button_ns_ != 0) {
+		command_input_ns_ = last_button_ns_;
+		command_frame_ = last_button_frame_;
+	}
+}
+
+void InputManager::fireActionSignals()
+{
+	for (std::size_t word = 0; word < action_words_; ++word) {
+		std::uint64_t active = down_bits_[word] | released_bits_[word];
+		while (active != 0) {
+			const int bit = std::countr_zero(active);
+			active &= active - 1;
+			const std::uint64_t mask = std::uint64_t{ 1 } << bit;
+			ActionState state = ActionState::HELD;
+			if (released_bits_[word] & mask) {
+				state = ActionState::RELEASED;
+			}
+			else if (pressed_bits_[word] & mask) {
+				state = ActionState::PRESSED;
+			}
+			auto& signal = action_signals_[word * 64 + static_cast<std::size_t>(bit)][static_cast<std::size_t>(state)];
+			if (!signal.empty()) {
+				signal.collect([](bool result) {
 					return result;
 				});
 			}
@@ -72,17 +200,24 @@ void InputManager::quit() {
 
 entt::sink<entt::sigh<bool()>> InputManager::onAction(entt::id_type action_id, ActionState state)
 {
-	if (action_states_.find(action_id) == action_states_.end()) {
-		spdlog::warn("输入管理器: 动作 ID '{}' 未在配置中定义, 绑定的事件将永远不会被触发。请检查 config.json 中的拼写。", action_id);
-	}
-
 	size_t state_idx = static_cast<size_t>(state);
 	if (state_idx >= 3) {
 		spdlog::error("输入管理器: 尝试为无效的状态 ({}) 绑定动作 ID '{}'。", state_idx, action_id);
 		throw std::out_of_range("输入管理器: ActionState 索引超出范围");
 	}
 
-	return action_entities_[action_id].at(state_idx);
+	const ActionIndex index = getActionIndex(action_id);
+	if (index == ActionIndex::INVALID) {
+		spdlog::warn("输入管理器: 动作 ID '{}' 未在配置中定义, 绑定的事件将永远不会被触发。请检查 config.json 中的拼写。", action_id);
+		return unmapped_signals_[action_id][state_idx];
+	}
+	return action_signals_[static_cast<std::size_t>(index)][state_idx];
+}
+
+ActionIndex InputManager::getActionIndex(entt::id_type action_id) const
+{
+	auto it = action_index_.find(action_id);
+	return it == action_index_.end() ? ActionIndex::INVALID : it->second;
 }
 
 /**
@@ -94,10 +229,12 @@ entt::sink<entt::sigh<bool()>> InputManager::onAction(entt::id_type action_id, A
  */
 bool InputManager::isActionDown(entt::id_type action_id) const
 {
-	if (auto it = action_states_.find(action_id); it == action_states_.end()) {
+	const ActionIndex index = getActionIndex(action_id);
+	if (index == ActionIndex::INVALID) {
 		spdlog::warn("输入映射警告: 未找到动作 ID '{}'.", action_id);
 		return false;
-	}else return it->second == ActionState::HELD || it->second == ActionState::PRESSED;
+	}
+	return isActionDown(index);
 }
 
 /**
@@ -109,11 +246,12 @@ bool InputManager::isActionDown(entt::id_type action_id) const
  */
 bool InputManager::isActionPressed(entt::id_type action_id) const
 {
-	if (auto it = action_states_.find(action_id); it == action_states_.end()) {
+	const ActionIndex index = getActionIndex(action_id);
+	if (index == ActionIndex::INVALID) {
 		spdlog::warn("输入映射警告: 未找到动作 ID '{}'.", action_id);
 		return false;
-	}else return it->second == ActionState::PRESSED;
-
+	}
+	return isActionPressed(index);
 }
 
 /**
@@ -125,11 +263,12 @@ bool InputManager::isActionPressed(entt::id_type action_id) const
  */
 bool InputManager::isActionReleased(entt::id_type action_id) const
 {
-	if (auto it = action_states_.find(action_id); it == action_states_.end()) {
+	const ActionIndex index = getActionIndex(action_id);
+	if (index == ActionIndex::INVALID) {
 		spdlog::warn("输入映射警告: 未找到动作 ID '{}'.", action_id);
 		return false;
 	}
-	else return it->second == ActionState::RELEASED;
+	return isActionReleased(index);
 }
 
 /**
@@ -155,6 +294,29 @@ glm::vec2 InputManager::getLogicalMousePosition() const
 	return logical_mouse_position_;
 }
 
+glm::vec2 InputManager::latchLogicalMousePosition() const
+{
+	// 不泵入事件：渲染可能正在窗口模态循环插入的帧中（外层帧的 SDL_PumpEvents 之内），泵入会重入。
+	// 全局光标位置直接向系统查询，不经过事件队列，减去窗口位置即窗口坐标
+	SDL_Window* window = SDL_GetRenderWindow(sdl_renderer_);
+	if (!window || SDL_GetMouseFocus() != window) {
+		return logical_mouse_position_;
+	}
+	float x = 0.0f;
+	float y = 0.0f;
+	SDL_GetGlobalMouseState(&x, &y);
+	int window_x = 0;
+	int window_y = 0;
+	if (!SDL_GetWindowPosition(window, &window_x, &window_y)) {
+		return logical_mouse_position_;
+	}
+	glm::vec2 logical{ 0.0f };
+	if (!SDL_RenderCoordinatesFromWindow(sdl_renderer_, x - static_cast<float>(window_x), y - static_cast<float>(window_y), &logical.x, &logical.y)) {
+		return logical_mouse_position_;
+	}
+	return logical;
+}
+
 glm::vec2 InputManager::getMouseWheelDelta() const
 {
 	return mouse_wheel_delta_;
@@ -168,7 +330,8 @@ glm::vec2 InputManager::getMouseWheelDelta() const
  */
 void InputManager::processEvent(const SDL_Event& event)
 {
-    if (ImGui::GetCurrentContext()) {
+#if MONSTERWAR_DEBUG_TOOLS
+    if (imgui_input_enabled_ && ImGui::GetCurrentContext()) {
 		SDL_Event imgui_event = event;
 		if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN || event.type == SDL_EVENT_MOUSE_BUTTON_UP) {
 			SDL_RenderCoordinatesFromWindow(sdl_renderer_, static_cast<float>(event.button.x), static_cast<float>(event.button.y), &imgui_event.button.x, &imgui_event.button.y);
@@ -184,6 +347,7 @@ void InputManager::processEvent(const SDL_Event& event)
 			return;
 		}
 	}
+#endif
 
 	switch (event.type) {
 	case SDL_EVENT_KEY_DOWN:
@@ -191,32 +355,21 @@ void InputManager::processEvent(const SDL_Event& event)
 		SDL_Scancode scancode = event.key.scancode;
 		bool is_down = event.key.down;
 		bool is_repeat = event.key.repeat;
-		if (auto it = input_to_action_.find(scancode); it == input_to_action_.end()) {
+		const auto key = static_cast<std::size_t>(scancode);
+		if (key >= static_cast<std::size_t>(SDL_SCANCODE_COUNT) || !updateActionStates(scancode_actions_.data() + key * action_words_, is_down, is_repeat)) {
 			spdlog::debug("输入映射: 未找到按键 {} 的映射.", SDL_GetScancodeName(scancode));
 			return;
 		}
-		else {
-			const std::vector<entt::id_type>& actions = it->second;
-			for (entt::id_type action_id : actions) {
-				updateActionStates(action_id, is_down, is_repeat);
-			}
-		}
 		break;
 	}
 	case SDL_EVENT_MOUSE_BUTTON_DOWN:
 	case SDL_EVENT_MOUSE_BUTTON_UP: {
 		Uint32 mouse_button = event.button.button;
 		bool is_down = (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN);
-		if (auto it = input_to_action_.find(mouse_button); it == input_to_action_.end()) {
+		if (mouse_button >= MOUSE_BUTTON_SLOTS || !updateActionStates(mouse_button_actions_.data() + mouse_button * action_words_, is_down, false)) {
 			spdlog::debug("输入映射: 未找到鼠标按钮 {} 的映射.", mouse_button);
 			return;
 		}
-		else {
-			const std::vector<entt::id_type>& actions = it->second;
-			for (entt::id_type action_id : actions) {
-				updateActionStates(action_id, is_down, false);
-			}
-		}
 		// 计算逻辑渲染坐标系下的鼠标位置
 		mouse_position_ = {event.button.x, event.button.y};
 		SDL_RenderCoordinatesFromWindow(sdl_renderer_, mouse_position_.x, mouse_position_.y, &logical_mouse_position_.x, &logical_mouse_position_.y);
@@ -254,8 +407,8 @@ void InputManager::initializeMapFromConfig(const engine::core::Config* config)
 {
 	spdlog::trace("初始化输入映射...");
 	auto actions_to_keyname_ = config->input_mappings_;
-	input_to_action_.clear();
-	action_states_.clear();
+	action_index_.clear();
+	action_ids_.clear();
 
 	if (actions_to_keyname_.find("mouse_left") == actions_to_keyname_.end()) {
 		spdlog::debug("配置中没有定义 'mouse_left' 动作, 添加默认映射到 'MouseLeft'.");
@@ -266,20 +419,36 @@ void InputManager::initializeMapFromConfig(const engine::core::Config* config)
 		actions_to_keyname_["mouse_right"] = { "MouseRight" };
 	}
 
+	// 第一遍：为每个动作分配稠密下标，确定位集宽度
+	for (const auto& [action_name, key_names] : actions_to_keyname_) {
+		entt::id_type action_id = entt::hashed_string(action_name.c_str());
+		if (action_index_.emplace(action_id, static_cast<ActionIndex>(action_ids_.size())).second) {
+			action_ids_.push_back(action_id);
+		}
+	}
+	action_words_ = (action_ids_.size() + 63) / 64;
+	scancode_actions_.assign(static_cast<std::size_t>(SDL_SCANCODE_COUNT) * action_words_, 0u);
+	mouse_button_actions_.assign(MOUSE_BUTTON_SLOTS * action_words_, 0u);
+	down_bits_.assign(action_words_, 0u);
+	pressed_bits_.assign(action_words_, 0u);
+	released_bits_.assign(action_words_, 0u);
+	action_signals_ = std::vector<ActionSignals>(action_ids_.size());
+
+	// 第二遍：把按键/鼠标按钮编译为动作位集
 	for (const auto& [action_name, key_names] : actions_to_keyname_) {
 		entt::id_type action_id = entt::hashed_string(action_name.c_str());
-		action_states_[action_id] = ActionState::INACTIVE;
-		spdlog::trace("映射动作: {} (ID: {})", action_name, action_id);
+		const ActionIndex action = action_index_.at(action_id);
+		spdlog::trace("映射动作: {} (ID: {}, 下标: {})", action_name, action_id, static_cast<std::uint32_t>(action));
 
 		for (const std::string& key_name : key_names) {
 			SDL_Scancode scancode = stringToScancode(key_name);
 			Uint32 mouse_button = stringToMouseButton(key_name);
 			if (scancode != SDL_SCANCODE_UNKNOWN) {      // 如果scancode有效,则将action添加到scancode_to_actions_map_中
-				input_to_action_[scancode].push_back(action_id);
+				mapInput(scancode_actions_, static_cast<std::size_t>(scancode), action);
 				spdlog::trace("  映射按键: {} (Scancode: {}) 到动作: {}", key_name, static_cast<int>(scancode), action_name);
 			}
-			else if (mouse_button != 0) {             // 如果鼠标按钮有效,则将action添加到mouse_button_to_actions_map_中
-				input_to_action_[mouse_button].push_back(action_id);
+			else if (mouse_button != 0 && mouse_button < MOUSE_BUTTON_SLOTS) {             // 如果鼠标按钮有效,则将action添加到mouse_button_to_actions_map_中
+				mapInput(mouse_button_actions_, mouse_button, action);
 				spdlog::trace("  映射鼠标按钮: {} (Button ID: {}) 到动作: {}", key_name, static_cast<int>(mouse_button), action_name);
 				// else if: 未来可添加其它输入类型 ...
 			}
@@ -291,33 +460,47 @@ void InputManager::initializeMapFromConfig(const engine::core::Config* config)
 	
 }
 
+void InputManager::mapInput(std::vector<std::uint64_t>& table, std::size_t input, ActionIndex action)
+{
+	const auto index = static_cast<std::size_t>(action);
+	table[input * action_words_ + index / 64] |= std::uint64_t{ 1 } << (index % 64);
+}
+
 /**
- * @brief 更新特定动作的状态
+ * @brief 按输入的动作位集整体更新动作状态
  * 
- * @param action_id 动作ID
+ * @param actions 该输入关联的动作位集
  * @param is_input_active 输入是否处于激活状态（按下）
  * @param is_repeat_event 是否为 SDL 的按键重复事件
- * @details 根据输入状态更新动作的状态，处理按键重复事件
+ * @return 该输入是否关联了任何动作
+ * @details 与逐个动作的状态机等价：按下 → PRESSED，重复 → HELD，松开 → RELEASED（覆盖本帧的 PRESSED）
  */
-void InputManager::updateActionStates(entt::id_type action_id, bool is_input_active, bool is_repeat_event)
+bool InputManager::updateActionStates(const std::uint64_t* actions, bool is_input_active, bool is_repeat_event)
 {
-    auto it = action_states_.find(action_id);
-    if (it == action_states_.end()) {
-        spdlog::warn("输入映射警告: 未找到动作 ID '{}'.", action_id);
-        return;
-    }
-
-    if (is_input_active) {
-        if (is_repeat_event) {
-            it->second = ActionState::HELD;
-        }
-        else {
-            it->second = ActionState::PRESSED;
-        }
-    }
-    else {
-        it->second = ActionState::RELEASED;
-    }
+	bool mapped = false;
+	for (std::size_t word = 0; word < action_words_; ++word) {
+		const std::uint64_t mask = actions[word];
+		if (mask == 0) {
+			continue;
+		}
+		mapped = true;
+		if (is_input_active) {
+			down_bits_[word] |= mask;
+			released_bits_[word] &= ~mask;
+			if (is_repeat_event) {
+				pressed_bits_[word] &= ~mask;
+			}
+			else {
+				pressed_bits_[word] |= mask;
+			}
+		}
+		else {
+			down_bits_[word] &= ~mask;
+			pressed_bits_[word] &= ~mask;
+			released_bits_[word] |= mask;
+		}
+	}
+	return mapped;
 }
 
 /**
@@ -4,14 +4,18 @@
  * @brief 输入管理器，负责处理键盘、鼠标事件并将其映射为游戏动作
  */
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <unordered_map>
 #include <string>
+#include <SDL3/SDL_events.h>
 #include <SDL3/SDL_render.h>
 #include <glm/vec2.hpp>
 #include <vector>
 #include <entt/entt.hpp>
-#include <variant>
 #include <entt/core/hashed_string.hpp>
+#include "../utils/id_map.h"
 
 namespace engine::core
 {
@@ -35,11 +39,37 @@ namespace engine::input
 		INACTIVE, ///< 动作未激活
 	};
 
+	/**
+	 * @enum ActionIndex
+	 * @brief 动作在配置加载时分配的稠密下标，可由 InputManager::getActionIndex 预先解析后用于逐帧查询
+	 */
+	enum class ActionIndex : std::uint32_t {
+		INVALID = 0xFFFFFFFFu, ///< 未在配置中定义的动作
+	};
+
+	/**
+	 * @struct InputLatencyStats
+	 * @brief 最近一帧的输入统计与延迟（事件时间戳来自 SDL，单位与 SDL_GetTicksNS 一致）
+	 */
+	struct InputLatencyStats {
+		std::uint32_t events_{ 0 };             ///< 本帧消费的输入事件数（含被合并的鼠标移动）
+		std::uint32_t coalesced_motion_{ 0 };   ///< 被合并丢弃的鼠标移动事件数
+		double consume_max_ms_{ 0.0 };          ///< 事件产生 → 被本帧 Update() 消费的最大延迟
+		double present_max_ms_{ 0.0 };          ///< 事件产生 → 本帧 present 完成的最大延迟（输入到上屏的上界）
+		double present_min_ms_{ 0.0 };          ///< 本帧最新事件 → present 完成的延迟
+		std::uint32_t commands_{ 0 };           ///< 本帧生效的玩家指令数（见 InputManager::markCommand）
+		double command_ms_{ 0.0 };              ///< 指令对应的按键/按钮事件 → present 完成的延迟
+		std::uint32_t command_frames_{ 0 };     ///< 指令跨越的帧数，1 表示在消费该输入的同一帧上屏
+	};
+
 	/**
 	 * @class InputManager
 	 * @brief 负责事件循环轮询、输入状态维护及动作映射的类
 	 * 
-	 * 该类通过 SDL_PollEvent 获取原始输入事件，并将其转化为配置中定义的抽象动作。
+	 * 该类通过 SDL_PeepEvents 批量取出原始输入事件，并将其转化为配置中定义的抽象动作。
+	 * 同一帧内的多个鼠标移动事件只保留最后一个做坐标转换（遇到按钮/滚轮事件前先落地，保证顺序）。
+	 * 输入映射在配置加载时编译为稠密数组：每个按键/鼠标按钮对应一个动作位集，
+	 * 动作状态保存为「按下 / 本帧按下 / 本帧释放」三个位集，查询只是一次位测试。
 	 */
 	class InputManager final
 	{
@@ -48,30 +78,56 @@ namespace engine::input
 		
 		SDL_Renderer* sdl_renderer_; ///< SDL 渲染器，用于坐标转换
 
-		/**
-		 * @brief 动作对应的实体列表
-		 * 每个动作名称映射到一个包含三个信号槽的数组，分别对应按下、持续按下和释放事件。
-		 * 这些信号槽用于注册实体对特定动作事件的响应。
-		 * @see entt::sigh
-		 */
-		std::unordered_map<entt::id_type,std::array<entt::sigh<bool()>,3>> action_entities_; ///< 动作对应的实体列表
+		using ActionSignals = std::array<entt::sigh<bool()>, 3>;  ///< 按下、持续按下、释放三个信号槽
+
+		static constexpr std::size_t MOUSE_BUTTON_SLOTS = 8;    ///< 支持的鼠标按钮 ID 上限（SDL_BUTTON_LEFT..X2 为 1..5）
+
+		engine::utils::IdMap<ActionIndex> action_index_;    ///< 动作 ID → 稠密下标
+		std::vector<entt::id_type> action_ids_;             ///< 稠密下标 → 动作 ID
+		std::size_t action_words_{ 0 };                     ///< 每个动作位集占用的 64 位字数
 
 		/**
-		 * @brief 输入映射表。
-		 * 键可以是 SDL_Scancode (键盘) 或 Uint32 (鼠标按钮)。
-		 * 值是关联到该输入的动作名称列表。
+		 * @brief 编译后的输入映射表（扁平数组，每个输入占 action_words_ 个字）
+		 * 位 i 置位表示该输入关联到下标为 i 的动作。
 		 */
-		std::unordered_map<std::variant<SDL_Scancode, Uint32>, std::vector<entt::id_type>> input_to_action_;
-		
+		std::vector<std::uint64_t> scancode_actions_;       ///< SDL_SCANCODE_COUNT 个按键
+		std::vector<std::uint64_t> mouse_button_actions_;   ///< MOUSE_BUTTON_SLOTS 个鼠标按钮
+
+		// --- 动作状态位集（按稠密下标） ---
+		std::vector<std::uint64_t> down_bits_;      ///< 处于按下状态（PRESSED 或 HELD）
+		std::vector<std::uint64_t> pressed_bits_;   ///< 本帧刚按下
+		std::vector<std::uint64_t> released_bits_;  ///< 本帧刚释放
 
 		/**
-		 * @brief 动作当前的状态表
+		 * @brief 动作对应的实体响应信号槽（按稠密下标）
+		 * @see entt::sigh
 		 */
-		std::unordered_map<entt::id_type, ActionState> action_states_;
+		std::vector<ActionSignals> action_signals_;
+		/// @brief 未在配置中定义的动作的信号槽（仅为保持 onAction 的返回值有效，永远不会被触发）
+		std::unordered_map<entt::id_type, ActionSignals> unmapped_signals_;
 
 		glm::vec2 logical_mouse_position_; ///< 逻辑渲染坐标系下的鼠标位置
 		glm::vec2 mouse_position_; ///< 窗口坐标系下的鼠标位置
      glm::vec2 mouse_wheel_delta_{ 0.0f, 0.0f }; ///< 本帧鼠标滚轮增量
+
+		static constexpr int EVENT_BATCH_SIZE = 64;         ///< 每次 SDL_PeepEvents 取出的事件数
+		std::array<SDL_Event, EVENT_BATCH_SIZE> event_batch_{};
+		SDL_Event pending_motion_{};                        ///< 本帧最新的鼠标移动，延迟到需要时再处理
+		bool has_pending_motion_{ false };
+
+		// --- 延迟统计（本帧） ---
+		InputLatencyStats latency_;                         ///< 上一次 onFramePresented() 时的快照
+		InputLatencyStats frame_latency_;                   ///< 正在累计的本帧统计
+		Uint64 oldest_event_ns_{ 0 };                       ///< 本帧消费的最早输入事件时间戳（0 表示无）
+		Uint64 newest_event_ns_{ 0 };
+		Uint64 last_button_ns_{ 0 };                        ///< 最近一次按键/鼠标按钮事件的时间戳（跨帧保留）
+		std::uint64_t last_button_frame_{ 0 };              ///< 消费该事件时的帧序号
+		Uint64 command_input_ns_{ 0 };                      ///< 本帧第一条玩家指令对应的输入时间戳（0 表示无）
+		std::uint64_t command_frame_{ 0 };
+		std::uint64_t presented_frames_{ 0 };               ///< onFramePresented() 的调用次数
+#if MONSTERWAR_DEBUG_TOOLS
+		bool imgui_input_enabled_{ false };                 ///< 调试界面可见时才把事件交给 ImGui（见 setImGuiInputEnabled）
+#endif
 	public:
 		/**
 		 * @brief 构造函数
@@ -116,6 +172,17 @@ namespace engine::input
 		 */
 		bool isActionReleased(entt::id_type action_id) const;
 
+		/**
+		 * @brief 解析动作的稠密下标，逐帧查询的调用方可在初始化时解析一次
+		 * @return 未在配置中定义时返回 ActionIndex::INVALID
+		 */
+		ActionIndex getActionIndex(entt::id_type action_id) const;
+
+		// --- 按稠密下标查询（纯位测试，INVALID 返回 false） ---
+		bool isActionDown(ActionIndex index) const { return testBit(down_bits_, index); }
+		bool isActionPressed(ActionIndex index) const { return testBit(pressed_bits_, index); }
+		bool isActionReleased(ActionIndex index) const { return testBit(released_bits_, index); }
+
 		/**
 		 * @brief 获取当前鼠标在窗口坐标系下的位置
 		 * @return 鼠标位置 (x, y)
@@ -125,6 +192,30 @@ namespace engine::input
 
 		void quit();
 
+		/**
+		 * @brief 在 present 完成后调用，结算本帧输入到上屏的延迟并写入分析器计数器
+		 * @details 计数器："input.events"、"input.motion_coalesced"、"input.consume_us"、"input.present_us"
+		 */
+		void onFramePresented();
+
+		/// @brief 最近一帧的输入延迟统计
+		const InputLatencyStats& getLatencyStats() const { return latency_; }
+
+		/**
+		 * @brief 游戏代码在一条玩家指令产生可见结果时调用（如出击准备、放置单位），
+		 * 本帧 present 时结算「触发它的最近一次按键/按钮事件 → 上屏」的延迟与跨越的帧数
+		 * @details 计数器："input.command_us"、"input.command_frames"；按钮事件不在本帧消费时帧数大于 1
+		 */
+		void markCommand();
+
+#if MONSTERWAR_DEBUG_TOOLS
+		/**
+		 * @brief 是否把事件转发给 ImGui 并遵从其输入捕获
+		 * @details 调试界面隐藏时不再构建 ImGui 帧，WantCapture* 停留在最后一帧的值，须关闭转发以免吞掉游戏输入
+		 */
+		void setImGuiInputEnabled(bool enabled) { imgui_input_enabled_ = enabled; }
+#endif
+
 		/**
 		 * @brief 获取鼠标在逻辑渲染坐标系下的位置。
 		 * 会考虑 SDL 的逻辑大小缩放。
@@ -132,6 +223,15 @@ namespace engine::input
 		 */
 		glm::vec2 getLogicalMousePosition() const;
 
+		/**
+		 * @brief 重新采样鼠标的逻辑坐标（提交绘制前的晚采样，不改变本帧的输入状态）
+		 * @details 以 SDL_GetGlobalMouseState() 直接向系统查询光标，减去窗口位置换算为窗口坐标，
+		 *          比帧开头 update() 时的位置晚一整帧的模拟与渲染。不调用 SDL_PumpEvents()：渲染可能在窗口模态循环
+		 *          插入的帧中、即外层帧的泵入之内进行，泵入会重入；积压的事件照常留给下一帧。
+		 *          窗口没有鼠标焦点或查询失败时返回 getLogicalMousePosition()
+		 */
+		glm::vec2 latchLogicalMousePosition() const;
+
 	private:
 		/**
 		 * @brief 处理单个 SDL 事件
@@ -139,6 +239,15 @@ namespace engine::input
 		 */
 		void processEvent(const SDL_Event& event);
 
+		/**
+		 * @brief 批量取出的单个事件的入口：记录延迟，合并鼠标移动，其余转交 processEvent
+		 * @param now_ns 本批次取出时的 SDL_GetTicksNS()
+		 */
+		void queueEvent(const SDL_Event& event, Uint64 now_ns);
+
+		/// @brief 处理被延迟的最后一个鼠标移动事件
+		void flushPendingMotion();
+
 		/**
 		 * @brief 从配置文件初始化输入映射
 		 * @param config 配置对象指针
@@ -146,12 +255,24 @@ namespace engine::input
 		void initializeMapFromConfig(const engine::core::Config* config);
 
 		/**
-		 * @brief 更新特定动作的状态
-		 * @param action_id 动作ID
+		 * @brief 按输入的动作位集整体更新动作状态
+		 * @param actions 该输入关联的动作位集（action_words_ 个字）
 		 * @param is_input_active 输入是否处于激活状态（按下）
 		 * @param is_repeat_event 是否为 SDL 的按键重复事件
+		 * @return 该输入是否关联了任何动作
 		 */
-		void updateActionStates(entt::id_type action_id,bool is_input_active,bool is_repeat_event);
+		bool updateActionStates(const std::uint64_t* actions, bool is_input_active, bool is_repeat_event);
+
+		/// @brief 对所有非 INACTIVE 的动作触发对应状态的信号槽（只遍历置位的位）
+		void fireActionSignals();
+
+		/// @brief 按稠密下标登记一个按键/按钮到动作位集
+		void mapInput(std::vector<std::uint64_t>& table, std::size_t input, ActionIndex action);
+
+		static bool testBit(const std::vector<std::uint64_t>& bits, ActionIndex index) {
+			const auto i = static_cast<std::size_t>(index);
+			return i / 64 < bits.size() && ((bits[i / 64] >> (i % 64)) & 1u) != 0;
+		}
 
 		/**
 		 * @brief 将字符串键名转换为 SDL_Scancode
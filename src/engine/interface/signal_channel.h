@@ -0,0 +1,94 @@
+#pragma once
+/**
+ * @file signal_channel.h
+ * @brief 定义 SignalChannel，按事件类型在编译期确定的通知通道（取代 Subject/Observer 的 std::any 通知）。
+ *
+ * @details
+ * 每种事件是一个小的可平凡拷贝结构体（不超过 MAX_EVENT_SIZE 字节），通道内部是 entt::sigh<void(const Event&)>：
+ * 发布时按引用把栈上的事件交给各个监听者，不装箱、不分配，也没有虚函数与 any_cast；
+ * 监听者以成员函数指针连接（sink().connect<&T::onX>(this)），类型不匹配在编译期报错。
+ *
+ * 监听者持有 entt::scoped_connection，析构时自动断开，对应原 Observer 析构时的解除关系；
+ * 通道本身须比所有连接活得更久（通常由同一个对象先声明通道、后声明连接）。
+ *
+ * @code
+ * engine::interface::SignalChannel<engine::interface::ScoreChanged> score;
+ * entt::scoped_connection connection = score.sink().connect<&engine::ui::UIText::onScoreChanged>(text);
+ * score.publish({ 42 });   // text 显示 "Score: 42"
+ * @endcode
+ */
+
+#include <entt/signal/sigh.hpp>
+#include <cstddef>
+#include <type_traits>
+
+namespace engine::interface {
+
+/**
+ * @brief 事件类型枚举
+ *
+ * 作为 StatChanged 的模板参数，为每个统计项生成互不相同的事件类型。
+ */
+enum class EventType {
+    HEALTH_CHANGED,             ///< @brief 生命值改变
+    MAX_HEALTH_CHANGED,         ///< @brief 最大生命值改变
+    SCORE_CHANGED,              ///< @brief 得分改变
+    GOLD_CHANGED,               ///< @brief 金币改变
+    WAVE_CHANGED,               ///< @brief 波次改变
+    STATE_CHANGED,              ///< @brief 游戏状态（进行/暂停/结束）改变
+    SELECTION_CHANGED,          ///< @brief 选中对象改变
+    // 未来可添加更多事件类型
+};
+
+/// @brief 事件负载的大小上限：按值放在发布方的栈上，两三个标量即可
+inline constexpr std::size_t MAX_EVENT_SIZE = 32;
+
+/// @brief 可以经 SignalChannel 发布的事件类型
+template <typename Event>
+concept ChannelEvent = std::is_trivially_copyable_v<Event> && sizeof(Event) <= MAX_EVENT_SIZE;
+
+/**
+ * @brief 整数统计项变化事件；不同的 EventType 是不同的类型，一个监听函数只能连接到对应的通道
+ */
+template <EventType Type>
+struct StatChanged {
+    static constexpr EventType TYPE = Type;
+    int value_{ 0 };
+};
+
+using HealthChanged = StatChanged<EventType::HEALTH_CHANGED>;
+using MaxHealthChanged = StatChanged<EventType::MAX_HEALTH_CHANGED>;
+using ScoreChanged = StatChanged<EventType::SCORE_CHANGED>;
+using GoldChanged = StatChanged<EventType::GOLD_CHANGED>;
+using WaveChanged = StatChanged<EventType::WAVE_CHANGED>;
+using StateChanged = StatChanged<EventType::STATE_CHANGED>;
+using SelectionChanged = StatChanged<EventType::SELECTION_CHANGED>;
+
+/**
+ * @class SignalChannel
+ * @brief 单一事件类型的通知通道
+ */
+template <ChannelEvent Event>
+class SignalChannel final {
+public:
+    using Signal = entt::sigh<void(const Event&)>;
+
+    SignalChannel() = default;
+    // 连接记录着通道地址，通道不可复制或移动
+    SignalChannel(const SignalChannel&) = delete;
+    SignalChannel& operator=(const SignalChannel&) = delete;
+
+    /// @brief 连接 / 断开监听者（connect 返回的连接可交给 entt::scoped_connection 管理）
+    [[nodiscard]] entt::sink<Signal> sink() { return entt::sink{ signal_ }; }
+
+    /// @brief 依次同步调用所有监听者
+    void publish(const Event& event) const { signal_.publish(event); }
+
+    [[nodiscard]] bool empty() const { return signal_.empty(); }
+    [[nodiscard]] std::size_t size() const { return signal_.size(); }
+
+private:
+    Signal signal_;
+};
+
+} // namespace engine::interface
@@ -0,0 +1,206 @@
+#include "asset_pack.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+namespace engine::io::pack {
+
+namespace {
+
+constexpr std::size_t DATA_ALIGNMENT = 16;
+
+std::uint64_t alignUp(std::uint64_t value) {
+    return (value + DATA_ALIGNMENT - 1) & ~static_cast<std::uint64_t>(DATA_ALIGNMENT - 1);
+}
+
+bool inRange(std::uint64_t offset, std::uint64_t count, std::uint64_t limit) {
+    return offset <= limit && count <= limit - offset;
+}
+
+bool entryLess(const EntryRecord& entry, engine::resource::ResourceId id) {
+    return entry.id_ < id;
+}
+
+} // namespace
+
+std::string normalizePath(std::string_view path, const std::string& base) {
+    std::filesystem::path result(path);
+    if (result.is_absolute() && !base.empty()) {
+        auto relative = result.lexically_relative(base);
+        if (!relative.empty()) {
+            result = std::move(relative);
+        }
+    }
+    return result.lexically_normal().generic_string();
+}
+
+// --- AssetPack ---
+
+bool AssetPack::open(const std::string& path, std::string& error_message) {
+    path_ = path;
+    entries_ = {};
+    if (!file_.open(path)) {
+        error_message = "无法映射资源包: " + path;
+        return false;
+    }
+    const auto fail = [&](std::string message) {
+        error_message = std::move(message);
+        file_.close();
+        return false;
+    };
+    if (file_.size() < sizeof(Header)) {
+        return fail("资源包文件过小: " + path);
+    }
+    const auto& header = *reinterpret_cast<const Header*>(file_.data());
+    if (header.magic_ != MAGIC || header.version_ != VERSION) {
+        return fail("资源包格式或版本不匹配: " + path);
+    }
+    const std::uint64_t toc_bytes = static_cast<std::uint64_t>(header.entry_count_) * sizeof(EntryRecord);
+    if (!inRange(header.toc_offset_, toc_bytes, file_.size()) || header.toc_offset_ % alignof(EntryRecord) != 0) {
+        return fail("资源包目录越界: " + path);
+    }
+    entries_ = { reinterpret_cast<const EntryRecord*>(file_.data() + header.toc_offset_), header.entry_count_ };
+    for (const auto& entry : entries_) {
+        if (!inRange(entry.path_offset_, entry.path_length_, file_.size()) ||
+            !inRange(entry.offset_, entry.stored_size_, file_.size())) {
+            entries_ = {};
+            return fail("资源包条目越界: " + path);
+        }
+    }
+    return true;
+}
+
+const EntryRecord* AssetPack::findEntry(std::string_view normalized_path) const {
+    const auto id = engine::resource::toResourceId(normalized_path);
+    for (auto it = std::lower_bound(entries_.begin(), entries_.end(), id, entryLess);
+         it != entries_.end() && it->id_ == id; ++it) {
+        const std::string_view stored(reinterpret_cast<const char*>(file_.data() + it->path_offset_), it->path_length_);
+        if (stored == normalized_path) {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+std::span<const std::byte> AssetPack::find(std::string_view normalized_path) const {
+    const auto* entry = findEntry(normalized_path);
+    if (!entry || entry->compression_ != static_cast<std::uint32_t>(Compression::NONE)) {
+        return {};
+    }
+    return file_.bytes().subspan(static_cast<std::size_t>(entry->offset_), static_cast<std::size_t>(entry->size_));
+}
+
+bool AssetPack::contains(std::string_view normalized_path) const {
+    const auto* entry = findEntry(normalized_path);
+    return entry && entry->compression_ == static_cast<std::uint32_t>(Compression::NONE);
+}
+
+// --- 打包 ---
+
+bool writeAssetPack(const std::string& root_dir, const std::string& output_path,
+                    const std::string& base, std::string& error_message) {
+    struct Source {
+        std::string file_;          ///< 磁盘路径
+        std::string path_;          ///< 规范化后的条目路径
+        EntryRecord record_;
+    };
+
+    std::error_code ec;
+    const auto output_abs = std::filesystem::weakly_canonical(output_path, ec);
+    std::vector<Source> sources;
+    for (auto it = std::filesystem::recursive_directory_iterator(root_dir, ec);
+         !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        if (!it->is_regular_file()) {
+            continue;
+        }
+        const auto& file = it->path();
+        std::error_code same_ec;
+        if (file.extension() == EXTENSION || file.extension() == ".tmp" ||
+            std::filesystem::equivalent(file, output_abs, same_ec)) {
+            continue;
+        }
+        Source source;
+        source.file_ = file.string();
+        source.path_ = normalizePath(std::filesystem::absolute(file).string(), base);
+        source.record_.id_ = engine::resource::toResourceId(source.path_);
+        source.record_.size_ = static_cast<std::uint64_t>(it->file_size());
+        source.record_.stored_size_ = source.record_.size_;
+        sources.push_back(std::move(source));
+    }
+    if (ec) {
+        error_message = "无法遍历资源目录 '" + root_dir + "': " + ec.message();
+        return false;
+    }
+    std::sort(sources.begin(), sources.end(), [](const Source& lhs, const Source& rhs) {
+        return lhs.record_.id_ != rhs.record_.id_ ? lhs.record_.id_ < rhs.record_.id_ : lhs.path_ < rhs.path_;
+    });
+
+    // 先排好全部偏移：Header | TOC | 路径 | 数据
+    Header header;
+    header.entry_count_ = static_cast<std::uint32_t>(sources.size());
+    header.toc_offset_ = sizeof(Header);
+    std::uint64_t cursor = header.toc_offset_ + sources.size() * sizeof(EntryRecord);
+    for (auto& source : sources) {
+        source.record_.path_offset_ = static_cast<std::uint32_t>(cursor);
+        source.record_.path_length_ = static_cast<std::uint32_t>(source.path_.size());
+        cursor += source.path_.size();
+    }
+    if (cursor > UINT32_MAX) {
+        error_message = "资源包目录与路径段超过 4 GiB";
+        return false;
+    }
+    for (auto& source : sources) {
+        cursor = alignUp(cursor);
+        source.record_.offset_ = cursor;
+        cursor += source.record_.stored_size_;
+    }
+
+    const std::string temp_path = output_path + ".tmp";
+    const auto write_image = [&]() {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            error_message = "无法写入资源包: " + temp_path;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        for (const auto& source : sources) {
+            out.write(reinterpret_cast<const char*>(&source.record_), sizeof(EntryRecord));
+        }
+        for (const auto& source : sources) {
+            out.write(source.path_.data(), static_cast<std::streamsize>(source.path_.size()));
+        }
+        std::vector<char> buffer;
+        for (const auto& source : sources) {
+            const auto padding = source.record_.offset_ - static_cast<std::uint64_t>(out.tellp());
+            out.write("\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0", static_cast<std::streamsize>(padding));
+            std::ifstream in(source.file_, std::ios::binary);
+            buffer.resize(static_cast<std::size_t>(source.record_.size_));
+            if (!in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+                error_message = "读取资源文件失败: " + source.file_;
+                return false;
+            }
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+        if (!out) {
+            error_message = "写入资源包失败: " + temp_path;
+            return false;
+        }
+        return true;
+    };
+    if (!write_image()) {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    std::filesystem::rename(temp_path, output_path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        error_message = "无法替换资源包: " + output_path;
+        return false;
+    }
+    return true;
+}
+
+} // namespace engine::io::pack
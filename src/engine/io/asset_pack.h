@@ -0,0 +1,101 @@
+#pragma once
+/**
+ * @file asset_pack.h
+ * @brief 资源包（.mwpak）二进制格式、内存映射读取器与打包函数。
+ *
+ * @details
+ * 把 assets/ 下的松散文件打成一个文件，启动时整体映射，避免机械硬盘与冷缓存下数百次打开与小块读取：
+ * - 目录（TOC）按 ResourceId（规范化相对路径的哈希）升序排列，查找为二分
+ * - 每个条目同时记录原始路径，查找时校验，哈希冲突不会返回错误的文件
+ * - 数据按 16 字节对齐存放，读取为零拷贝视图
+ * - compression_ 预留压缩方式，当前只写入 NONE；读取器遇到未知压缩方式时视为缺失，由调用方回退到松散文件
+ *
+ * 布局：Header | EntryRecord[] | 路径字符串 | 数据。字节序为小端。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "../resource/resource_id.h"
+#include "../utils/mapped_file.h"
+
+namespace engine::io::pack {
+
+inline constexpr std::uint32_t MAGIC = 0x4B50574Du;        ///< "MWPK"（小端）
+inline constexpr std::uint32_t VERSION = 1;
+inline constexpr std::string_view EXTENSION = ".mwpak";
+
+enum class Compression : std::uint32_t {
+    NONE = 0,
+};
+
+struct Header {
+    std::uint32_t magic_{MAGIC};
+    std::uint32_t version_{VERSION};
+    std::uint32_t entry_count_{0};
+    std::uint32_t reserved_{0};
+    std::uint64_t toc_offset_{0};       ///< EntryRecord[] 相对文件起始的偏移
+};
+
+struct EntryRecord {
+    engine::resource::ResourceId id_{};     ///< 规范化路径的哈希
+    std::uint32_t path_offset_{0};          ///< 路径字符串相对文件起始的偏移
+    std::uint32_t path_length_{0};
+    std::uint32_t compression_{0};          ///< Compression
+    std::uint64_t offset_{0};               ///< 数据相对文件起始的偏移
+    std::uint64_t size_{0};                 ///< 原始字节数
+    std::uint64_t stored_size_{0};          ///< 包内字节数（未压缩时等于 size_）
+};
+
+/**
+ * @brief 规范化资源路径：绝对路径转为相对 base 的路径，消去 "."/".."，统一使用 '/'
+ * @details 包内条目与查找都经过同一规范化，"assets/maps/../textures/a.png" 与绝对路径都能命中 "assets/textures/a.png"。
+ */
+std::string normalizePath(std::string_view path, const std::string& base);
+
+/**
+ * @class AssetPack
+ * @brief 只读的已映射资源包
+ */
+class AssetPack final {
+public:
+    /**
+     * @brief 映射并校验资源包
+     * @return 成功返回 true；失败时 error_message 记录原因
+     */
+    bool open(const std::string& path, std::string& error_message);
+
+    [[nodiscard]] bool isOpen() const { return file_.isOpen(); }
+    [[nodiscard]] const std::string& getPath() const { return path_; }
+    [[nodiscard]] std::size_t size() const { return entries_.size(); }
+
+    /**
+     * @brief 按规范化路径查找条目数据
+     * @return 数据视图，映射存活期间有效；不存在或无法直接读取时返回空 span
+     */
+    [[nodiscard]] std::span<const std::byte> find(std::string_view normalized_path) const;
+    [[nodiscard]] bool contains(std::string_view normalized_path) const;
+
+private:
+    [[nodiscard]] const EntryRecord* findEntry(std::string_view normalized_path) const;
+
+    std::string path_;
+    engine::utils::MappedFile file_;
+    std::span<const EntryRecord> entries_;
+};
+
+/**
+ * @brief 将 root_dir 下的全部常规文件打包为资源包
+ * @param root_dir 资源根目录（如 "assets"）
+ * @param output_path 输出文件路径
+ * @param base 条目路径的基准目录（运行时查找以当前工作目录为基准）
+ * @param error_message 失败原因
+ * @return 写入成功返回 true
+ */
+[[nodiscard]] bool writeAssetPack(const std::string& root_dir, const std::string& output_path,
+                                  const std::string& base, std::string& error_message);
+
+} // namespace engine::io::pack
@@ -0,0 +1,95 @@
+#pragma once
+/**
+ * @file binary_archive.h
+ * @brief 按原始字节读写可平凡拷贝值的最小二进制归档，可直接交给 entt::snapshot / entt::snapshot_loader。
+ *
+ * @details
+ * entt 的快照以 archive(value) 的形式逐个写出实体数、实体与组件；这里对每个值做一次 memcpy，
+ * 不做字段级的版本兼容——组件布局变化时由存档外层的 schema 版本号拒绝旧数据。
+ * 字节序为本机序（与回放日志、资源包一样只支持小端平台）。
+ * 非快照内容（如会话存档里的名字）可用 string() 写出带 32 位长度前缀的字符串。
+ *
+ * @code
+ * std::vector<std::byte> bytes;
+ * engine::io::BinaryOutputArchive output{ bytes };
+ * entt::snapshot{ registry }.get<entt::entity>(output).get<TransformComponent>(output);
+ *
+ * engine::io::BinaryInputArchive input{ bytes };
+ * entt::snapshot_loader{ registry }.get<entt::entity>(input).get<TransformComponent>(input);
+ * if (!input.ok()) { ... }    // 数据截断
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace engine::io {
+
+class BinaryOutputArchive final {
+public:
+    explicit BinaryOutputArchive(std::vector<std::byte>& out) : out_(out) {}
+
+    template <typename T>
+    void operator()(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "BinaryOutputArchive 只写出可平凡拷贝的值");
+        const auto* begin = reinterpret_cast<const std::byte*>(&value);
+        out_.insert(out_.end(), begin, begin + sizeof(T));
+    }
+
+    /// @brief 写出 32 位长度前缀 + 字符串字节
+    void string(std::string_view text) {
+        (*this)(static_cast<std::uint32_t>(text.size()));
+        const auto* begin = reinterpret_cast<const std::byte*>(text.data());
+        out_.insert(out_.end(), begin, begin + text.size());
+    }
+
+private:
+    std::vector<std::byte>& out_;
+};
+
+class BinaryInputArchive final {
+public:
+    explicit BinaryInputArchive(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+    /// @brief 读取一个值；剩余数据不足时置零并标记失败，之后的读取全部失败
+    template <typename T>
+    void operator()(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "BinaryInputArchive 只读取可平凡拷贝的值");
+        if (!ok_ || bytes_.size() - offset_ < sizeof(T)) {
+            ok_ = false;
+            value = T{};
+            return;
+        }
+        std::memcpy(&value, bytes_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+    }
+
+    /// @brief 读取 string() 写出的字符串，失败规则同 operator()
+    void string(std::string& text) {
+        std::uint32_t size = 0;
+        (*this)(size);
+        if (!ok_ || bytes_.size() - offset_ < size) {
+            ok_ = false;
+            text.clear();
+            return;
+        }
+        text.assign(reinterpret_cast<const char*>(bytes_.data() + offset_), size);
+        offset_ += size;
+    }
+
+    [[nodiscard]] bool ok() const { return ok_; }
+    [[nodiscard]] bool done() const { return offset_ >= bytes_.size(); }
+
+private:
+    std::span<const std::byte> bytes_;
+    std::size_t offset_{ 0 };
+    bool ok_{ true };
+};
+
+} // namespace engine::io
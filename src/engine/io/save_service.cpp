@@ -0,0 +1,307 @@
+#include "save_service.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <utility>
+#include <entt/core/hashed_string.hpp>
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace engine::io {
+
+namespace {
+
+constexpr std::array<std::uint32_t, 256> makeCrcTable() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t value = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            value = (value & 1u) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+        }
+        table[i] = value;
+    }
+    return table;
+}
+
+constexpr auto CRC_TABLE = makeCrcTable();
+
+/// @brief 把文件内容落盘（ofstream::flush() 只交给操作系统缓存，断电时可能丢失）
+bool syncFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+    const HANDLE handle = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    const bool ok = FlushFileBuffers(handle) != 0;
+    CloseHandle(handle);
+    return ok;
+#else
+    const int fd = ::open(path.c_str(), O_WRONLY);
+    if (fd < 0) {
+        return false;
+    }
+    const bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#endif
+}
+
+/// @brief 把目录项（重命名结果）落盘；Windows 的 NTFS 日志随文件数据提交，不需要单独同步目录
+void syncDirectory([[maybe_unused]] const std::filesystem::path& directory) {
+#ifndef _WIN32
+    const int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#endif
+}
+
+/// @brief 写出 prefix + body 到临时文件并落盘后重命名覆盖目标路径
+bool writeAtomically(const std::string& path, std::span<const std::byte> prefix, std::span<const std::byte> body,
+                     std::string& error_message) {
+    std::error_code ec;
+    const auto parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            error_message = "无法写入文件: " + temp_path;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(prefix.data()), static_cast<std::streamsize>(prefix.size()));
+        file.write(reinterpret_cast<const char*>(body.data()), static_cast<std::streamsize>(body.size()));
+        file.flush();
+        if (!file) {
+            error_message = "写入文件失败: " + temp_path;
+            return false;
+        }
+    }
+    // 临时文件落盘后才替换：否则断电后重命名可能先于数据生效，留下一个空存档
+    if (!syncFile(temp_path)) {
+        error_message = "同步文件失败: " + temp_path;
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    // 崩溃或断电时要么是原文件，要么是完整的新文件
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        error_message = "重命名文件失败: " + ec.message();
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    syncDirectory(parent);
+    return true;
+}
+
+} // namespace
+
+std::uint32_t crc32(std::span<const std::byte> bytes) {
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (const std::byte byte : bytes) {
+        crc = CRC_TABLE[(crc ^ std::to_integer<std::uint32_t>(byte)) & 0xFFu] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+bool writeSaveFile(const std::string& path, entt::id_type kind, std::uint32_t schema,
+                   std::span<const std::byte> payload, std::string& error_message) {
+    static_assert(std::endian::native == std::endian::little, "存档按小端直接写出");
+
+    SaveHeader header;
+    header.kind_ = kind;
+    header.schema_ = schema;
+    header.payload_size_ = payload.size();
+    header.checksum_ = crc32(payload);
+    return writeAtomically(path, std::as_bytes(std::span{ &header, 1 }), payload, error_message);
+}
+
+bool writeRawFile(const std::string& path, std::span<const std::byte> bytes, std::string& error_message) {
+    return writeAtomically(path, {}, bytes, error_message);
+}
+
+std::optional<SaveContent> readSaveFile(const std::string& path, entt::id_type kind, std::string& error_message) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        error_message = "无法打开存档: " + path;
+        return std::nullopt;
+    }
+    const auto file_size = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(0);
+
+    SaveHeader header;
+    if (file_size < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        error_message = "存档过短: " + path;
+        return std::nullopt;
+    }
+    if (header.magic_ != SAVE_MAGIC || header.version_ != SAVE_VERSION) {
+        error_message = "存档格式或版本不匹配: " + path;
+        return std::nullopt;
+    }
+    if (header.kind_ != kind) {
+        error_message = "存档内容类型不匹配: " + path;
+        return std::nullopt;
+    }
+    if (header.payload_size_ != file_size - sizeof(header)) {
+        error_message = "存档长度与头部记录不符（可能被截断）: " + path;
+        return std::nullopt;
+    }
+
+    SaveContent content;
+    content.schema_ = header.schema_;
+    content.payload_.resize(static_cast<std::size_t>(header.payload_size_));
+    if (!file.read(reinterpret_cast<char*>(content.payload_.data()), static_cast<std::streamsize>(content.payload_.size()))) {
+        error_message = "读取存档失败: " + path;
+        return std::nullopt;
+    }
+    if (crc32(content.payload_) != header.checksum_) {
+        error_message = "存档校验和不匹配: " + path;
+        return std::nullopt;
+    }
+    return content;
+}
+
+SaveService& SaveService::instance() {
+    static SaveService service;
+    return service;
+}
+
+SaveService::~SaveService() {
+    shutdown();
+}
+
+void SaveService::submit(std::string path, entt::id_type kind, std::uint32_t schema, std::vector<std::byte> payload) {
+    {
+        std::scoped_lock lock(mutex_);
+        ++stats_.submitted_;
+        auto it = std::find_if(queue_.begin(), queue_.end(), [&](const Job& job) { return job.path_ == path; });
+        if (it != queue_.end()) {
+            // 还没写出的旧内容已经过时，原位替换保持与其他路径的先后顺序
+            it->kind_ = kind;
+            it->schema_ = schema;
+            it->payload_ = std::move(payload);
+            it->raw_ = false;
+            ++stats_.coalesced_;
+            return;
+        }
+        queue_.push_back(Job{ std::move(path), kind, schema, std::move(payload) });
+        startWorker();
+    }
+    work_cv_.notify_one();
+}
+
+void SaveService::submitRaw(std::string path, std::vector<std::byte> bytes) {
+    {
+        std::scoped_lock lock(mutex_);
+        ++stats_.submitted_;
+        auto it = std::find_if(queue_.begin(), queue_.end(), [&](const Job& job) { return job.path_ == path; });
+        if (it != queue_.end()) {
+            it->raw_ = true;
+            it->payload_ = std::move(bytes);
+            ++stats_.coalesced_;
+            return;
+        }
+        Job job{ std::move(path) };
+        job.payload_ = std::move(bytes);
+        job.raw_ = true;
+        queue_.push_back(std::move(job));
+        startWorker();
+    }
+    work_cv_.notify_one();
+}
+
+void SaveService::startWorker() {
+    if (!worker_.joinable()) {
+        stop_ = false;
+        worker_ = std::thread(&SaveService::run, this);
+    }
+}
+
+bool SaveService::flush() {
+    std::unique_lock lock(mutex_);
+    idle_cv_.wait(lock, [this] { return queue_.empty() && !busy_; });
+    return std::exchange(all_ok_, true);
+}
+
+void SaveService::shutdown() {
+    {
+        std::scoped_lock lock(mutex_);
+        if (!worker_.joinable()) {
+            return;
+        }
+        stop_ = true;
+    }
+    work_cv_.notify_one();
+    worker_.join();
+    std::scoped_lock lock(mutex_);
+    worker_ = std::thread{};
+}
+
+std::size_t SaveService::dispatchEvents(entt::dispatcher& dispatcher) {
+    return completed_.dispatch(dispatcher);
+}
+
+SaveService::Stats SaveService::getStats() const {
+    std::scoped_lock lock(mutex_);
+    return stats_;
+}
+
+void SaveService::run() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            break;      // stop_ 且已写完
+        }
+        Job job = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+        lock.unlock();
+
+        std::string error_message;
+        const bool ok = job.raw_ ? writeRawFile(job.path_, job.payload_, error_message)
+                                 : writeSaveFile(job.path_, job.kind_, job.schema_, job.payload_, error_message);
+        if (ok) {
+            spdlog::info("{}已写出: {}（{} 字节）", job.raw_ ? "文件" : "存档", job.path_, job.payload_.size());
+        } else {
+            spdlog::error("{}", error_message);
+        }
+        completed_.post(SaveCompletedEvent{ entt::hashed_string::value(job.path_.c_str(), job.path_.size()),
+                                            job.raw_ ? entt::id_type{ 0 } : job.kind_, ok });
+
+        lock.lock();
+        busy_ = false;
+        if (ok) {
+            ++stats_.written_;
+        } else {
+            ++stats_.failed_;
+            all_ok_ = false;
+        }
+        if (queue_.empty()) {
+            idle_cv_.notify_all();
+        }
+    }
+    idle_cv_.notify_all();
+}
+
+} // namespace engine::io
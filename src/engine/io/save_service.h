@@ -0,0 +1,159 @@
+#pragma once
+/**
+ * @file save_service.h
+ * @brief 存档文件（.mwsav）格式与单线程后台写入服务。
+ *
+ * @details
+ * 存档布局：SaveHeader | 负载，小端。头部记录内容类型、内容自身的 schema 版本、负载长度与 CRC32，
+ * 读取时任何一项不符都视为损坏而不是读出半截数据。
+ *
+ * 写入一律先写 `<路径>.tmp`、落盘（fsync / FlushFileBuffers）后再重命名覆盖，进程崩溃或断电时磁盘上仍是上一份完整存档。
+ *
+ * SaveService 持有一个常驻的写入线程（首次提交时启动），代替每次保存各起一个 std::async：
+ * - submit() 只把负载移入队列，校验和计算与磁盘 I/O 都在写入线程完成
+ * - 同一路径还未写出的旧请求直接被新请求替换，频繁自动存档不会排队积压
+ * - flush() 等待队列清空，场景退出前调用；shutdown() 写完剩余请求后结束线程
+ * - submitRaw() 按原样写出字节（不加 SaveHeader），供遥测 CSV/JSON 等纯文本导出复用同一写入线程
+ * - 每个请求写完后写入线程投递一条 SaveCompletedEvent（无锁队列），主线程调用 dispatchEvents() 转入 dispatcher
+ *
+ * @code
+ * auto& saves = engine::io::SaveService::instance();
+ * saves.submit("assets/save/SLOT_1.mwsav", "session"_hs, 1, std::move(payload));
+ * saves.flush();
+ *
+ * std::string error;
+ * if (auto save = engine::io::readSaveFile("assets/save/SLOT_1.mwsav", "session"_hs, error)) {
+ *     // save->schema_, save->payload_
+ * }
+ * @endcode
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <entt/core/fwd.hpp>
+#include "../utils/thread_event_queue.h"
+
+namespace engine::io {
+
+inline constexpr std::uint32_t SAVE_MAGIC = 0x5653574Du;    ///< "MWSV"（小端）
+inline constexpr std::uint32_t SAVE_VERSION = 1;
+
+struct SaveHeader {
+    std::uint32_t magic_{ SAVE_MAGIC };
+    std::uint32_t version_{ SAVE_VERSION };     ///< 外层格式版本
+    entt::id_type kind_{ 0 };                   ///< 内容类型（调用方约定，如 "session"_hs）
+    std::uint32_t schema_{ 0 };                 ///< 内容自身的版本，由调用方解释
+    std::uint64_t payload_size_{ 0 };
+    std::uint32_t checksum_{ 0 };               ///< 负载的 CRC32
+    std::uint32_t reserved_{ 0 };
+};
+
+static_assert(std::is_trivially_copyable_v<SaveHeader>);
+
+/// @brief 校验通过的存档内容
+struct SaveContent {
+    std::uint32_t schema_{ 0 };
+    std::vector<std::byte> payload_;
+};
+
+/// @brief CRC32（IEEE 802.3 多项式）
+[[nodiscard]] std::uint32_t crc32(std::span<const std::byte> bytes);
+
+/// @brief 同步写出一份存档（临时文件 + 重命名），供写入线程与不便等待队列的场合使用
+bool writeSaveFile(const std::string& path, entt::id_type kind, std::uint32_t schema,
+                   std::span<const std::byte> payload, std::string& error_message);
+
+/// @brief 同步按原样写出字节（临时文件 + 重命名，不加头部）
+bool writeRawFile(const std::string& path, std::span<const std::byte> bytes, std::string& error_message);
+
+/**
+ * @brief 读取并校验存档
+ * @return 魔数、格式版本、内容类型、长度与校验和均匹配时返回内容，否则返回空并写入 error_message
+ */
+[[nodiscard]] std::optional<SaveContent> readSaveFile(const std::string& path, entt::id_type kind,
+                                                      std::string& error_message);
+
+/// @brief 一次写入完成（成功或失败），经 SaveService::dispatchEvents() 在主线程上派发
+struct SaveCompletedEvent {
+    entt::id_type path_hash_{ 0 };      ///< 目标路径的 entt::hashed_string 值
+    entt::id_type kind_{ 0 };           ///< submitRaw() 写出的请求为 0
+    bool ok_{ false };
+};
+
+class SaveService final {
+public:
+    /// @brief 写入统计（只增不减）
+    struct Stats {
+        std::uint64_t submitted_{ 0 };      ///< 提交次数
+        std::uint64_t coalesced_{ 0 };      ///< 被同路径新请求替换而未写出的次数
+        std::uint64_t written_{ 0 };        ///< 成功写出次数
+        std::uint64_t failed_{ 0 };         ///< 写出失败次数
+    };
+
+    static SaveService& instance();
+
+    SaveService(const SaveService&) = delete;
+    SaveService& operator=(const SaveService&) = delete;
+
+    /// @brief 提交一次写入；同一路径尚未写出的请求被本次内容替换
+    void submit(std::string path, entt::id_type kind, std::uint32_t schema, std::vector<std::byte> payload);
+
+    /// @brief 提交一次不带存档头部的原样写入（文本导出等）；同路径合并规则与 submit 相同
+    void submitRaw(std::string path, std::vector<std::byte> bytes);
+
+    /**
+     * @brief 阻塞直到已提交的写入全部完成
+     * @return 自上次 flush 以来的写入是否全部成功
+     */
+    bool flush();
+
+    /// @brief 写完剩余请求并结束写入线程；之后的 submit 会重新启动线程
+    void shutdown();
+
+    /**
+     * @brief 把写入线程投递的 SaveCompletedEvent 转入 dispatcher（主线程，dispatcher.update() 之前）
+     * @details 没有消费者时（无头模拟、命令行工具）队列写满后新事件被丢弃，不影响写入。
+     */
+    std::size_t dispatchEvents(entt::dispatcher& dispatcher);
+
+    [[nodiscard]] Stats getStats() const;
+
+private:
+    struct Job {
+        std::string path_;
+        entt::id_type kind_{ 0 };
+        std::uint32_t schema_{ 0 };
+        std::vector<std::byte> payload_;
+        bool raw_{ false };             ///< 原样写出，不加 SaveHeader
+    };
+
+    SaveService() = default;
+    ~SaveService();
+
+    /// @brief 写入线程未运行时启动（持有 mutex_ 时调用）
+    void startWorker();
+    void run();
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;       ///< 有新请求或要求退出
+    std::condition_variable idle_cv_;       ///< 队列清空且没有正在写出的请求
+    std::deque<Job> queue_;
+    std::thread worker_;
+    Stats stats_;
+    bool busy_{ false };                    ///< 写入线程正在写出一个请求（已出队）
+    bool stop_{ false };
+    bool all_ok_{ true };                   ///< 自上次 flush 以来没有失败
+    /// 只有写入线程一个生产者
+    utils::ThreadEventQueue<SaveCompletedEvent, 64, utils::SpscQueue> completed_;
+};
+
+} // namespace engine::io
@@ -0,0 +1,188 @@
+#include "tcp_listener.h"
+
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace engine::io {
+
+namespace {
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+constexpr NativeSocket INVALID_NATIVE = INVALID_SOCKET;
+
+/// Winsock 只需初始化一次，进程退出时清理
+bool ensureWinsock() {
+    struct Winsock {
+        bool ok_{ false };
+        Winsock() {
+            WSADATA data{};
+            ok_ = WSAStartup(MAKEWORD(2, 2), &data) == 0;
+        }
+        ~Winsock() {
+            if (ok_) {
+                WSACleanup();
+            }
+        }
+    };
+    static Winsock winsock;
+    return winsock.ok_;
+}
+
+std::string lastSocketError() {
+    return "WSA 错误 " + std::to_string(WSAGetLastError());
+}
+
+void closeNative(NativeSocket socket) {
+    closesocket(socket);
+}
+
+int pollNative(NativeSocket socket, int timeout_ms) {
+    WSAPOLLFD entry{ socket, POLLRDNORM, 0 };
+    return WSAPoll(&entry, 1, timeout_ms);
+}
+#else
+using NativeSocket = int;
+constexpr NativeSocket INVALID_NATIVE = -1;
+
+bool ensureWinsock() {
+    return true;
+}
+
+std::string lastSocketError() {
+    return std::strerror(errno);
+}
+
+void closeNative(NativeSocket socket) {
+    ::close(socket);
+}
+
+int pollNative(NativeSocket socket, int timeout_ms) {
+    pollfd entry{ socket, POLLIN, 0 };
+    return ::poll(&entry, 1, timeout_ms);
+}
+#endif
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;    // 对端已关闭时不产生 SIGPIPE
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+NativeSocket toNative(std::uintptr_t handle) {
+    return static_cast<NativeSocket>(handle);
+}
+
+} // namespace
+
+TcpConnection::~TcpConnection() {
+    closeNative(toNative(handle_));
+}
+
+std::optional<std::size_t> TcpConnection::receive(std::span<char> buffer, int timeout_ms) {
+    if (pollNative(toNative(handle_), timeout_ms) <= 0) {
+        return std::nullopt;
+    }
+    const auto received = ::recv(toNative(handle_), buffer.data(), static_cast<int>(buffer.size()), 0);
+    if (received <= 0) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(received);
+}
+
+bool TcpConnection::sendAll(std::string_view data) {
+    while (!data.empty()) {
+        const auto sent = ::send(toNative(handle_), data.data(), static_cast<int>(data.size()), SEND_FLAGS);
+        if (sent <= 0) {
+            return false;
+        }
+        data.remove_prefix(static_cast<std::size_t>(sent));
+    }
+    return true;
+}
+
+TcpListener::~TcpListener() {
+    close();
+}
+
+bool TcpListener::open(std::uint16_t port) {
+    close();
+    if (!ensureWinsock()) {
+        last_error_ = "Winsock 初始化失败";
+        return false;
+    }
+    const NativeSocket native = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (native == INVALID_NATIVE) {
+        last_error_ = "创建 TCP 套接字失败: " + lastSocketError();
+        return false;
+    }
+    const int reuse = 1;
+    ::setsockopt(native, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);   // 只接受本机连接
+    address.sin_port = htons(port);
+    if (::bind(native, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        last_error_ = "绑定端口 " + std::to_string(port) + " 失败: " + lastSocketError();
+        closeNative(native);
+        return false;
+    }
+    if (::listen(native, 4) != 0) {
+        last_error_ = "监听失败: " + lastSocketError();
+        closeNative(native);
+        return false;
+    }
+
+    sockaddr_in bound{};
+    socklen_t bound_size = sizeof(bound);
+    local_port_ = port;
+    if (::getsockname(native, reinterpret_cast<sockaddr*>(&bound), &bound_size) == 0) {
+        local_port_ = ntohs(bound.sin_port);
+    }
+    handle_ = static_cast<std::uintptr_t>(native);
+    open_ = true;
+    last_error_.clear();
+    return true;
+}
+
+void TcpListener::close() {
+    if (open_) {
+        closeNative(toNative(handle_));
+        open_ = false;
+    }
+    handle_ = 0;
+    local_port_ = 0;
+}
+
+std::optional<TcpConnection> TcpListener::accept(int timeout_ms) {
+    if (!open_ || pollNative(toNative(handle_), timeout_ms) <= 0) {
+        return std::nullopt;
+    }
+    const NativeSocket client = ::accept(toNative(handle_), nullptr, nullptr);
+    if (client == INVALID_NATIVE) {
+        last_error_ = "接受连接失败: " + lastSocketError();
+        return std::nullopt;
+    }
+    return std::optional<TcpConnection>(std::in_place, static_cast<std::uintptr_t>(client));
+}
+
+} // namespace engine::io
@@ -0,0 +1,82 @@
+#pragma once
+/**
+ * @file tcp_listener.h
+ * @brief 只绑定回环地址的阻塞式 TCP 监听套接字（RAII），供本机的指标端点逐个应答短连接。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace engine::io {
+
+/**
+ * @class TcpConnection
+ * @brief 一个已接受的连接，析构时关闭
+ */
+class TcpConnection final {
+public:
+    explicit TcpConnection(std::uintptr_t handle) : handle_(handle) {}
+    ~TcpConnection();
+
+    TcpConnection(const TcpConnection&) = delete;
+    TcpConnection& operator=(const TcpConnection&) = delete;
+
+    /**
+     * @brief 等待并读取一段数据
+     * @param timeout_ms 最长等待时间
+     * @return 读到的字节数；超时、对端关闭或出错时返回空
+     */
+    std::optional<std::size_t> receive(std::span<char> buffer, int timeout_ms);
+
+    /// @brief 写出全部数据（阻塞），失败返回 false
+    bool sendAll(std::string_view data);
+
+private:
+    std::uintptr_t handle_{ 0 };
+};
+
+/**
+ * @class TcpListener
+ * @brief 监听 127.0.0.1 上指定端口的 TCP 套接字
+ *
+ * @details 平台差异（Winsock / BSD 套接字）与 UdpSocket 相同。accept() 带超时，
+ *          服务线程循环调用即可及时响应停止请求。
+ */
+class TcpListener final {
+public:
+    TcpListener() = default;
+    ~TcpListener();
+
+    TcpListener(const TcpListener&) = delete;
+    TcpListener& operator=(const TcpListener&) = delete;
+
+    /**
+     * @brief 创建套接字并监听 127.0.0.1:port（0 表示由系统分配）
+     * @return 成功返回 true；失败原因见 getLastError()
+     */
+    bool open(std::uint16_t port);
+    void close();
+
+    /**
+     * @brief 等待一个连接
+     * @param timeout_ms 最长等待时间
+     * @return 超时或出错时返回空
+     */
+    std::optional<TcpConnection> accept(int timeout_ms);
+
+    [[nodiscard]] bool isOpen() const { return open_; }
+    [[nodiscard]] std::uint16_t getLocalPort() const { return local_port_; }
+    [[nodiscard]] const std::string& getLastError() const { return last_error_; }
+
+private:
+    std::uintptr_t handle_{ 0 };    ///< SOCKET / 文件描述符（避免在头文件中引入平台头文件）
+    std::uint16_t local_port_{ 0 };
+    bool open_{ false };
+    std::string last_error_;
+};
+
+} // namespace engine::io
@@ -0,0 +1,247 @@
+#include "udp_socket.h"
+
+#include <charconv>
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace engine::io {
+
+namespace {
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+
+/// Winsock 只需初始化一次，进程退出时清理
+bool ensureWinsock() {
+    struct Winsock {
+        bool ok_{ false };
+        Winsock() {
+            WSADATA data{};
+            ok_ = WSAStartup(MAKEWORD(2, 2), &data) == 0;
+        }
+        ~Winsock() {
+            if (ok_) {
+                WSACleanup();
+            }
+        }
+    };
+    static Winsock winsock;
+    return winsock.ok_;
+}
+
+std::string lastSocketError() {
+    return "WSA 错误 " + std::to_string(WSAGetLastError());
+}
+
+bool wouldBlock() {
+    const int error = WSAGetLastError();
+    // 频繁收到对端端口不可达（ICMP）也会报 WSAECONNRESET，对无连接的 UDP 视同无数据
+    return error == WSAEWOULDBLOCK || error == WSAECONNRESET;
+}
+
+void closeNative(NativeSocket socket) {
+    closesocket(socket);
+}
+
+bool setNonBlocking(NativeSocket socket) {
+    u_long enabled = 1;
+    return ioctlsocket(socket, FIONBIO, &enabled) == 0;
+}
+#else
+using NativeSocket = int;
+
+bool ensureWinsock() {
+    return true;
+}
+
+std::string lastSocketError() {
+    return std::strerror(errno);
+}
+
+bool wouldBlock() {
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNREFUSED;
+}
+
+void closeNative(NativeSocket socket) {
+    ::close(socket);
+}
+
+bool setNonBlocking(NativeSocket socket) {
+    const int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+
+NativeSocket toNative(std::uintptr_t handle) {
+    return static_cast<NativeSocket>(handle);
+}
+
+sockaddr_in toSockaddr(const UdpEndpoint& endpoint) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(endpoint.address_);
+    address.sin_port = htons(endpoint.port_);
+    return address;
+}
+
+} // namespace
+
+std::optional<UdpEndpoint> UdpEndpoint::resolve(const std::string& host, std::uint16_t port) {
+    if (!ensureWinsock()) {
+        return std::nullopt;
+    }
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 || !result) {
+        return std::nullopt;
+    }
+    const auto* address = reinterpret_cast<const sockaddr_in*>(result->ai_addr);
+    UdpEndpoint endpoint{ ntohl(address->sin_addr.s_addr), port };
+    freeaddrinfo(result);
+    return endpoint;
+}
+
+std::optional<UdpEndpoint> UdpEndpoint::parse(std::string_view text) {
+    const auto colon = text.rfind(':');
+    if (colon == std::string_view::npos || colon == 0) {
+        return std::nullopt;
+    }
+    const auto port_text = text.substr(colon + 1);
+    std::uint16_t port = 0;
+    const auto [end, error] = std::from_chars(port_text.data(), port_text.data() + port_text.size(), port);
+    if (error != std::errc{} || end != port_text.data() + port_text.size() || port == 0) {
+        return std::nullopt;
+    }
+    return resolve(std::string(text.substr(0, colon)), port);
+}
+
+std::string UdpEndpoint::toString() const {
+    return std::to_string((address_ >> 24) & 0xFFu) + "." + std::to_string((address_ >> 16) & 0xFFu) + "." +
+           std::to_string((address_ >> 8) & 0xFFu) + "." + std::to_string(address_ & 0xFFu) + ":" + std::to_string(port_);
+}
+
+UdpSocket::~UdpSocket() {
+    close();
+}
+
+UdpSocket::UdpSocket(UdpSocket&& other) noexcept {
+    *this = std::move(other);
+}
+
+UdpSocket& UdpSocket::operator=(UdpSocket&& other) noexcept {
+    if (this != &other) {
+        close();
+        handle_ = std::exchange(other.handle_, 0);
+        local_port_ = std::exchange(other.local_port_, 0);
+        open_ = std::exchange(other.open_, false);
+        last_error_ = std::move(other.last_error_);
+    }
+    return *this;
+}
+
+bool UdpSocket::open(std::uint16_t port) {
+    close();
+    if (!ensureWinsock()) {
+        last_error_ = "Winsock 初始化失败";
+        return false;
+    }
+    const NativeSocket native = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#ifdef _WIN32
+    if (native == INVALID_SOCKET) {
+#else
+    if (native < 0) {
+#endif
+        last_error_ = "创建 UDP 套接字失败: " + lastSocketError();
+        return false;
+    }
+
+    const sockaddr_in address = toSockaddr(UdpEndpoint{ INADDR_ANY, port });
+    if (::bind(native, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        last_error_ = "绑定端口 " + std::to_string(port) + " 失败: " + lastSocketError();
+        closeNative(native);
+        return false;
+    }
+    if (!setNonBlocking(native)) {
+        last_error_ = "设置非阻塞失败: " + lastSocketError();
+        closeNative(native);
+        return false;
+    }
+
+    sockaddr_in bound{};
+    socklen_t bound_size = sizeof(bound);
+    local_port_ = port;
+    if (::getsockname(native, reinterpret_cast<sockaddr*>(&bound), &bound_size) == 0) {
+        local_port_ = ntohs(bound.sin_port);
+    }
+    handle_ = static_cast<std::uintptr_t>(native);
+    open_ = true;
+    last_error_.clear();
+    return true;
+}
+
+void UdpSocket::close() {
+    if (open_) {
+        closeNative(toNative(handle_));
+        open_ = false;
+    }
+    handle_ = 0;
+    local_port_ = 0;
+}
+
+bool UdpSocket::sendTo(const UdpEndpoint& to, std::span<const std::uint8_t> data) {
+    if (!open_ || data.size() > MAX_DATAGRAM_SIZE) {
+        last_error_ = open_ ? "数据报过大: " + std::to_string(data.size()) + " 字节" : "套接字未打开";
+        return false;
+    }
+    const sockaddr_in address = toSockaddr(to);
+    const auto sent = ::sendto(toNative(handle_), reinterpret_cast<const char*>(data.data()), static_cast<int>(data.size()), 0,
+                               reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    if (sent < 0) {
+        if (!wouldBlock()) {
+            last_error_ = "发送失败: " + lastSocketError();
+        }
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::size_t> UdpSocket::receive(std::span<std::uint8_t> buffer, UdpEndpoint& from) {
+    if (!open_) {
+        return std::nullopt;
+    }
+    sockaddr_in address{};
+    socklen_t address_size = sizeof(address);
+    const auto received = ::recvfrom(toNative(handle_), reinterpret_cast<char*>(buffer.data()), static_cast<int>(buffer.size()), 0,
+                                     reinterpret_cast<sockaddr*>(&address), &address_size);
+    if (received < 0) {
+        if (!wouldBlock()) {
+            last_error_ = "接收失败: " + lastSocketError();
+        }
+        return std::nullopt;
+    }
+    from = UdpEndpoint{ ntohl(address.sin_addr.s_addr), ntohs(address.sin_port) };
+    return static_cast<std::size_t>(received);
+}
+
+} // namespace engine::io
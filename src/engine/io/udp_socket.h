@@ -0,0 +1,83 @@
+#pragma once
+/**
+ * @file udp_socket.h
+ * @brief 非阻塞 UDP 套接字（RAII），供锁步联机收发每个模拟步的小数据包。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace engine::io {
+
+/**
+ * @struct UdpEndpoint
+ * @brief IPv4 地址与端口（主机字节序）
+ */
+struct UdpEndpoint {
+    std::uint32_t address_{ 0 };
+    std::uint16_t port_{ 0 };
+
+    /// @brief 解析主机名或点分十进制地址，失败时返回空
+    [[nodiscard]] static std::optional<UdpEndpoint> resolve(const std::string& host, std::uint16_t port);
+    /// @brief 解析 "主机:端口" 形式的字符串
+    [[nodiscard]] static std::optional<UdpEndpoint> parse(std::string_view text);
+
+    [[nodiscard]] std::string toString() const;
+    bool operator==(const UdpEndpoint&) const = default;
+};
+
+/**
+ * @class UdpSocket
+ * @brief 绑定本地端口的非阻塞 UDP 套接字
+ *
+ * @details
+ * Windows 使用 Winsock（首次打开时 WSAStartup），其他平台使用 BSD 套接字。
+ * receive() 没有待读数据时立即返回空，调用方每帧轮询即可，不需要单独的网络线程。
+ */
+class UdpSocket final {
+public:
+    /// @brief 单个数据报的上限：远小于常见 MTU，避免 IP 分片
+    static constexpr std::size_t MAX_DATAGRAM_SIZE = 1200;
+
+    UdpSocket() = default;
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+    UdpSocket(UdpSocket&& other) noexcept;
+    UdpSocket& operator=(UdpSocket&& other) noexcept;
+
+    /**
+     * @brief 创建套接字并绑定到本机所有地址的 port（0 表示由系统分配）
+     * @return 成功返回 true；失败原因见 getLastError()
+     */
+    bool open(std::uint16_t port);
+    void close();
+
+    /// @brief 发送一个数据报（超过 MAX_DATAGRAM_SIZE 时拒绝发送）
+    bool sendTo(const UdpEndpoint& to, std::span<const std::uint8_t> data);
+
+    /**
+     * @brief 读取一个待处理的数据报
+     * @param buffer 接收缓冲区，超出部分被截断
+     * @param from 发送方地址
+     * @return 收到的字节数；没有待读数据或出错时返回空
+     */
+    std::optional<std::size_t> receive(std::span<std::uint8_t> buffer, UdpEndpoint& from);
+
+    [[nodiscard]] bool isOpen() const { return open_; }
+    [[nodiscard]] std::uint16_t getLocalPort() const { return local_port_; }
+    [[nodiscard]] const std::string& getLastError() const { return last_error_; }
+
+private:
+    std::uintptr_t handle_{ 0 };    ///< SOCKET / 文件描述符（避免在头文件中引入平台头文件）
+    std::uint16_t local_port_{ 0 };
+    bool open_{ false };
+    std::string last_error_;
+};
+
+} // namespace engine::io
@@ -0,0 +1,97 @@
+#include "virtual_fs.h"
+
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <SDL3/SDL_iostream.h>
+#include <spdlog/spdlog.h>
+
+namespace engine::io {
+
+VirtualFS& VirtualFS::instance() {
+    static VirtualFS vfs;
+    return vfs;
+}
+
+VirtualFS::VirtualFS() {
+    std::error_code ec;
+    base_ = std::filesystem::current_path(ec).string();
+}
+
+bool VirtualFS::mount(const std::string& pack_path) {
+    std::error_code ec;
+    base_ = std::filesystem::current_path(ec).string();
+    if (!std::filesystem::is_regular_file(pack_path, ec)) {
+        spdlog::info("未找到资源包 '{}'，使用松散文件", pack_path);
+        return false;
+    }
+    std::string error_message;
+    if (!pack_.open(pack_path, error_message)) {
+        spdlog::error("挂载资源包失败: {}", error_message);
+        return false;
+    }
+    spdlog::info("已挂载资源包 '{}'，{} 个条目{}", pack_path, pack_.size(), loose_override_ ? "（松散文件优先）" : "");
+    return true;
+}
+
+std::optional<std::span<const std::byte>> VirtualFS::findPacked(std::string_view path) const {
+    if (!pack_.isOpen()) {
+        return std::nullopt;
+    }
+    if (loose_override_) {
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(std::filesystem::path(path), ec)) {
+            return std::nullopt;
+        }
+    }
+    const auto normalized = pack::normalizePath(path, base_);
+    if (!pack_.contains(normalized)) {
+        return std::nullopt;
+    }
+    return pack_.find(normalized);
+}
+
+std::optional<FileData> VirtualFS::read(std::string_view path) const {
+    if (auto packed = findPacked(path)) {
+        return FileData(*packed);
+    }
+    std::ifstream file(std::filesystem::path(path), std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    std::vector<std::byte> buffer(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
+        return std::nullopt;
+    }
+    return FileData(std::move(buffer));
+}
+
+SDL_IOStream* VirtualFS::openIO(std::string_view path) const {
+    if (auto packed = findPacked(path)) {
+        return SDL_IOFromConstMem(packed->data(), packed->size());
+    }
+    return SDL_IOFromFile(std::string(path).c_str(), "rb");
+}
+
+bool VirtualFS::exists(std::string_view path) const {
+    if (findPacked(path)) {
+        return true;
+    }
+    std::error_code ec;
+    return std::filesystem::is_regular_file(std::filesystem::path(path), ec);
+}
+
+std::optional<std::uint64_t> VirtualFS::fileSize(std::string_view path) const {
+    if (auto packed = findPacked(path)) {
+        return packed->size();
+    }
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(std::filesystem::path(path), ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    return static_cast<std::uint64_t>(size);
+}
+
+} // namespace engine::io
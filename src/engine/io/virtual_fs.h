@@ -0,0 +1,103 @@
+#pragma once
+/**
+ * @file virtual_fs.h
+ * @brief 资源读取的统一入口：优先从已映射的资源包（.mwpak）读取，支持松散文件覆盖。
+ *
+ * @details
+ * 纹理、字体、音频、关卡与蓝图加载都经由 VirtualFS 打开文件：
+ * - 已挂载资源包且包内存在该路径时，返回指向映射内存的零拷贝视图 / SDL_IOStream
+ * - 未挂载资源包、包内不存在，或开启松散文件覆盖且磁盘上存在同名文件时，读取磁盘文件
+ *
+ * 开发时用 --loose-assets 开启覆盖，修改 assets/ 下的文件无需重新打包。
+ * 挂载在启动时（任何加载线程开始前）完成，之后的读取均为只读操作，可在任意线程调用。
+ *
+ * @code
+ * auto& vfs = engine::io::VirtualFS::instance();
+ * if (auto file = vfs.read("assets/data/enemy_data.json")) {
+ *     auto json = nlohmann::json::parse(file->text());
+ * }
+ * SDL_Surface* surface = IMG_Load_IO(vfs.openIO(path), true);
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "asset_pack.h"
+
+struct SDL_IOStream;
+
+namespace engine::io {
+
+/// @brief 读取结果：包内文件为映射内存视图，松散文件持有读入的缓冲
+class FileData final {
+public:
+    explicit FileData(std::span<const std::byte> mapped) : view_(mapped) {}
+    explicit FileData(std::vector<std::byte> owned) : owned_(std::move(owned)), view_(owned_) {}
+
+    FileData(const FileData&) = delete;
+    FileData& operator=(const FileData&) = delete;
+    FileData(FileData&& other) noexcept
+        : owned_(std::move(other.owned_)), view_(owned_.empty() ? other.view_ : std::span<const std::byte>(owned_)) {}
+    FileData& operator=(FileData&&) = delete;
+
+    [[nodiscard]] std::span<const std::byte> bytes() const { return view_; }
+    [[nodiscard]] std::string_view text() const {
+        return { reinterpret_cast<const char*>(view_.data()), view_.size() };
+    }
+    [[nodiscard]] std::size_t size() const { return view_.size(); }
+
+private:
+    std::vector<std::byte> owned_;
+    std::span<const std::byte> view_;
+};
+
+class VirtualFS final {
+public:
+    static VirtualFS& instance();
+
+    VirtualFS(const VirtualFS&) = delete;
+    VirtualFS& operator=(const VirtualFS&) = delete;
+
+    /**
+     * @brief 挂载资源包（启动时调用一次）
+     * @param pack_path 资源包路径；文件不存在时不视为错误，继续使用松散文件
+     * @return 挂载成功返回 true
+     */
+    bool mount(const std::string& pack_path);
+
+    /// @brief 开启后磁盘上存在的松散文件优先于包内同名条目（开发用）
+    void setLooseOverride(bool enabled) { loose_override_ = enabled; }
+    [[nodiscard]] bool isLooseOverride() const { return loose_override_; }
+    [[nodiscard]] bool isMounted() const { return pack_.isOpen(); }
+
+    /// @brief 读取整个文件，不存在时返回 std::nullopt
+    [[nodiscard]] std::optional<FileData> read(std::string_view path) const;
+
+    /**
+     * @brief 打开只读 SDL_IOStream，失败时返回 nullptr（SDL_GetError 可取原因）
+     * @details 包内文件返回 SDL_IOFromConstMem，调用方负责关闭（通常把 closeio 传给 *_IO 加载函数）。
+     */
+    [[nodiscard]] SDL_IOStream* openIO(std::string_view path) const;
+
+    [[nodiscard]] bool exists(std::string_view path) const;
+    /// @brief 文件字节数，不存在时返回 std::nullopt
+    [[nodiscard]] std::optional<std::uint64_t> fileSize(std::string_view path) const;
+
+private:
+    VirtualFS();
+
+    /// @brief 命中资源包时返回包内数据（松散覆盖时先检查磁盘）
+    [[nodiscard]] std::optional<std::span<const std::byte>> findPacked(std::string_view path) const;
+
+    pack::AssetPack pack_;
+    std::string base_;              ///< 规范化路径的基准目录（挂载时的工作目录）
+    bool loose_override_{false};
+};
+
+} // namespace engine::io
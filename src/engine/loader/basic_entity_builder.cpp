@@ -10,16 +10,19 @@
 
 #include "level_loader.h"
 #include "../core/context.h"
-#include "../component/animation_component.h"
 #include "../component/name_component.h"
 #include "../component/sprite_component.h"
 #include "../component/transform_component.h"
 #include "../component/render_component.h"
+#include "../component/sheet_animation_component.h"
+#include "../component/tile_animation_component.h"
 #include "../resource/resource_manager.h"
 
 #include <entt/entt.hpp>
 #include <spdlog/spdlog.h>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace engine::loader {
 
@@ -93,6 +96,51 @@ entt::entity BasicEntityBuilder::getEntityID() {
     return entity_id_;
 }
 
+void BasicEntityBuilder::buildTiles(std::span<const TileSpawn> tiles, std::span<entt::entity> entities) {
+    // 连续的普通瓦片攒成一段批量创建，遇到需要逐个构建的瓦片先提交前一段，保持行优先的创建顺序
+    std::size_t run_begin = 0;
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        const auto* tile_info = tiles[i].tile_info_;
+        if (!tile_info->animation_ && !tile_info->properties_) {
+            continue;
+        }
+        buildPlainTiles(tiles.subspan(run_begin, i - run_begin), entities.subspan(run_begin, i - run_begin));
+        entities[i] = configure(tiles[i].index_, tile_info)->build()->getEntityID();
+        run_begin = i + 1;
+    }
+    buildPlainTiles(tiles.subspan(run_begin), entities.subspan(run_begin));
+}
+
+void BasicEntityBuilder::buildPlainTiles(std::span<const TileSpawn> tiles, std::span<entt::entity> entities) {
+    if (tiles.empty()) {
+        return;
+    }
+
+    registry_.create(entities.begin(), entities.end());
+
+    const auto map_size = level_loader_.getMapSize();
+    const auto tile_size = level_loader_.getTileSize();
+    auto& resource_manager = context_.getResourceManager();
+    std::unordered_set<entt::id_type> loaded_textures;
+    std::vector<engine::component::TransformComponent> transforms;
+    std::vector<engine::component::SpriteComponent> sprites;
+    transforms.reserve(tiles.size());
+    sprites.reserve(tiles.size());
+    for (const auto& tile : tiles) {
+        const auto& sprite = tile.tile_info_->sprite_;
+        if (loaded_textures.insert(sprite.texture_id_).second) {
+            resource_manager.loadTexture(sprite.texture_id_, sprite.getTexturePath());
+        }
+        transforms.emplace_back(glm::vec2((tile.index_ % map_size.x) * tile_size.x, (tile.index_ / map_size.x) * tile_size.y));
+        sprites.emplace_back(sprite);
+    }
+
+    registry_.insert<engine::component::TransformComponent>(entities.begin(), entities.end(), transforms.begin());
+    registry_.insert<engine::component::SpriteComponent>(entities.begin(), entities.end(), sprites.begin());
+    registry_.insert<engine::component::RenderComponent>(entities.begin(), entities.end(),
+        engine::component::RenderComponent(level_loader_.current_layer_, 0.0f));
+}
+
 void BasicEntityBuilder::buildBase() {
     entity_id_ = registry_.create();
     if (object_json_ && object_json_->contains("name")) {
@@ -109,7 +157,7 @@ void BasicEntityBuilder::buildSprite() {
     }
 
     auto& resource_manager = context_.getResourceManager();
-    resource_manager.loadTexture(tile_info_->sprite_.texture_id_, tile_info_->sprite_.texture_path_);
+    resource_manager.loadTexture(tile_info_->sprite_.texture_id_, tile_info_->sprite_.getTexturePath());
     registry_.emplace<engine::component::SpriteComponent>(entity_id_, tile_info_->sprite_);
 }
 
@@ -146,10 +194,21 @@ void BasicEntityBuilder::buildRender() {
 
 void BasicEntityBuilder::buildAnimation() {
     if (tile_info_ && tile_info_->animation_) {
-        std::unordered_map<entt::id_type, engine::component::Animation> animations;
-        auto animation_id = entt::hashed_string("tile");
-        animations.emplace(animation_id, std::move(tile_info_->animation_.value()));
-        registry_.emplace<engine::component::AnimationComponent>(entity_id_, std::move(animations), animation_id);
+        // 等距、等时长的帧交给渲染侧按动画时钟计算，完全不经过 AnimationSystem
+        if (const auto sheet = engine::component::SheetAnimationComponent::fromAnimation(*tile_info_->animation_)) {
+            registry_.emplace<engine::component::SheetAnimationComponent>(entity_id_, *sheet);
+            if (auto* sprite = registry_.try_get<engine::component::SpriteComponent>(entity_id_)) {
+                sprite->sprite_.src_rect_ = tile_info_->animation_->frames_.front().src_rect_;
+            }
+            return;
+        }
+        // 其余动画瓦片：同一瓦片的实例共用一个时钟，由 AnimationSystem 统一推进；新实例从时钟的当前帧开始显示
+        const auto clock = level_loader_.tileClockFor(*tile_info_);
+        registry_.emplace<engine::component::TileAnimationComponent>(entity_id_, clock);
+        auto* sprite = registry_.try_get<engine::component::SpriteComponent>(entity_id_);
+        if (sprite && !tile_info_->animation_->frames_.empty()) {
+            sprite->sprite_.src_rect_ = registry_.ctx().get<engine::component::TileAnimationClocks>().currentFrame(clock);
+        }
     }
 }
 
@@ -28,6 +28,7 @@
 #include <entt/entity/registry.hpp>
 #include <glm/vec2.hpp>
 #include <nlohmann/json.hpp>
+#include <span>
 #include <string>
 
 namespace engine::component {
@@ -41,6 +42,12 @@ namespace engine::core {
 namespace engine::loader {
     class LevelLoader;
 
+    /// @brief 待创建实体的一个瓦片格子：图层内索引 + 瓦片信息
+    struct TileSpawn {
+        int index_{0};
+        const engine::component::TileInfo* tile_info_{nullptr};
+    };
+
     /**
      * @class BasicEntityBuilder
      * @brief 基础实体构建器，实现建造者模式构建游戏实体。
@@ -63,6 +70,14 @@ namespace engine::loader {
         virtual BasicEntityBuilder* build();
         entt::entity getEntityID();
 
+        /**
+         * @brief 创建一个瓦片图层的逐格瓦片实体，entities[i] 写入 tiles[i] 对应的实体。
+         * @details 默认实现按行优先顺序处理：连续的普通瓦片（无动画、无自定义属性）一次 registry.create(first, last)
+         *          创建，变换/精灵/渲染组件逐类型 insert；其余瓦片逐个 configure()->build()。
+         *          组件存储中的顺序与逐个构建时相同。子类需要为普通瓦片添加组件时重写本函数。
+         */
+        virtual void buildTiles(std::span<const TileSpawn> tiles, std::span<entt::entity> entities);
+
         void buildBase();
         void buildSprite();
         void buildTransform();
@@ -71,6 +86,9 @@ namespace engine::loader {
         void buildAudio();
 
     protected:
+        /** @brief 批量创建一段普通瓦片（见 buildTiles）。 */
+        void buildPlainTiles(std::span<const TileSpawn> tiles, std::span<entt::entity> entities);
+
         LevelLoader& level_loader_;
         engine::core::Context& context_;
         entt::registry& registry_;
@@ -0,0 +1,234 @@
+#include "cooked_level.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace engine::loader::cooked {
+
+namespace {
+
+constexpr std::size_t SECTION_ALIGNMENT = 8;
+
+std::size_t alignUp(std::size_t value) {
+    return (value + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+bool inRange(std::size_t offset, std::size_t count, std::size_t limit) {
+    return offset <= limit && count <= limit - offset;
+}
+
+} // namespace
+
+// --- CookedLevel ---
+
+template <typename T>
+bool CookedLevel::bindSection(const Section& section, std::span<const T>& out, std::string& error_message) const {
+    const std::size_t bytes = static_cast<std::size_t>(section.count_) * sizeof(T);
+    if (!inRange(section.offset_, bytes, file_.size()) || section.offset_ % alignof(T) != 0) {
+        error_message = "预编译关卡段越界: " + path_;
+        return false;
+    }
+    // 映射基址按页对齐，段偏移按记录对齐，记录均为平凡可复制类型，可直接按数组读取
+    out = { reinterpret_cast<const T*>(file_.data() + section.offset_), section.count_ };
+    return true;
+}
+
+std::shared_ptr<const CookedLevel> CookedLevel::open(const std::string& path, std::string& error_message) {
+    std::shared_ptr<CookedLevel> level(new CookedLevel());
+    level->path_ = path;
+    if (!level->file_.open(path)) {
+        error_message = "无法映射预编译关卡: " + path;
+        return nullptr;
+    }
+    if (level->file_.size() < sizeof(Header)) {
+        error_message = "预编译关卡文件过小: " + path;
+        return nullptr;
+    }
+    level->header_ = reinterpret_cast<const Header*>(level->file_.data());
+    const auto& header = *level->header_;
+    if (header.magic_ != MAGIC || header.version_ != VERSION) {
+        error_message = "预编译关卡格式或版本不匹配: " + path;
+        return nullptr;
+    }
+
+    if (!level->bindSection(header.strings_, level->strings_, error_message) ||
+        !level->bindSection(header.dependencies_, level->dependencies_, error_message) ||
+        !level->bindSection(header.tiles_, level->tiles_, error_message) ||
+        !level->bindSection(header.frames_, level->frames_, error_message) ||
+        !level->bindSection(header.layers_, level->layers_, error_message) ||
+        !level->bindSection(header.cells_, level->cells_, error_message) ||
+        !level->bindSection(header.blob_, level->blob_, error_message)) {
+        return nullptr;
+    }
+
+    // 一次性校验所有交叉引用，之后的访问器无需再做边界检查
+    const std::size_t blob_size = level->blob_.size();
+    const bool strings_ok = std::ranges::all_of(level->strings_, [&](const StringRecord& record) {
+        return inRange(record.offset_, record.length_, blob_size);
+    });
+    const bool tiles_ok = std::ranges::all_of(level->tiles_, [&](const TileRecord& tile) {
+        return inRange(tile.first_frame_, tile.frame_count_, level->frames_.size()) &&
+               inRange(tile.properties_offset_, tile.properties_size_, blob_size);
+    });
+    const bool layers_ok = std::ranges::all_of(level->layers_, [&](const LayerRecord& layer) {
+        return inRange(layer.first_cell_, layer.cell_count_, level->cells_.size()) &&
+               inRange(layer.objects_offset_, layer.objects_size_, blob_size);
+    });
+    const bool cells_ok = std::ranges::all_of(level->cells_, [&](std::uint32_t cell) {
+        return cell == NONE || cell < level->tiles_.size();
+    });
+    if (!strings_ok || !tiles_ok || !layers_ok || !cells_ok) {
+        error_message = "预编译关卡数据引用越界: " + path;
+        return nullptr;
+    }
+
+    if (!level->checkDependencies(error_message)) {
+        return nullptr;
+    }
+    return level;
+}
+
+bool CookedLevel::checkDependencies(std::string& error_message) const {
+    const auto base_dir = std::filesystem::path(path_).parent_path();
+    for (const auto& dependency : dependencies_) {
+        const auto source = base_dir / std::filesystem::path(std::string(getString(dependency.path_)));
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(source, ec);
+        if (ec || size != dependency.size_) {
+            error_message = "预编译关卡已过期（源文件变化）: " + source.string();
+            return false;
+        }
+        const auto write_time = std::filesystem::last_write_time(source, ec);
+        if (ec || write_time.time_since_epoch().count() != dependency.write_time_) {
+            error_message = "预编译关卡已过期（源文件变化）: " + source.string();
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string_view CookedLevel::getString(std::uint32_t index) const {
+    if (index >= strings_.size()) {
+        return {};
+    }
+    const auto& record = strings_[index];
+    return { reinterpret_cast<const char*>(blob_.data()) + record.offset_, record.length_ };
+}
+
+std::span<const std::uint32_t> CookedLevel::getCells(const LayerRecord& layer) const {
+    return cells_.subspan(layer.first_cell_, layer.cell_count_);
+}
+
+std::span<const std::uint8_t> CookedLevel::getBlob(std::uint32_t offset, std::uint32_t size) const {
+    if (!inRange(offset, size, blob_.size())) {
+        return {};
+    }
+    return blob_.subspan(offset, size);
+}
+
+std::uint32_t CookedLevel::findTile(std::uint32_t gid) const {
+    // 写入时按 gid 升序排列
+    const auto it = std::ranges::lower_bound(tiles_, gid, {}, &TileRecord::gid_);
+    if (it == tiles_.end() || it->gid_ != gid) {
+        return NONE;
+    }
+    return static_cast<std::uint32_t>(it - tiles_.begin());
+}
+
+// --- CookedLevelWriter ---
+
+std::uint32_t CookedLevelWriter::addString(std::string_view value) {
+    if (auto it = string_index_.find(std::string(value)); it != string_index_.end()) {
+        return it->second;
+    }
+    const auto index = static_cast<std::uint32_t>(strings_.size());
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(value.data());
+    strings_.push_back(StringRecord{ addBlob({ bytes, value.size() }), static_cast<std::uint32_t>(value.size()) });
+    string_index_.emplace(std::string(value), index);
+    return index;
+}
+
+std::uint32_t CookedLevelWriter::addBlob(std::span<const std::uint8_t> data) {
+    const auto offset = static_cast<std::uint32_t>(blob_.size());
+    blob_.insert(blob_.end(), data.begin(), data.end());
+    return offset;
+}
+
+bool CookedLevelWriter::addDependency(const std::string& path, std::string_view relative_path) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    const auto write_time = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return false;
+    }
+    DependencyRecord record;
+    record.path_ = addString(relative_path);
+    record.size_ = size;
+    record.write_time_ = static_cast<std::int64_t>(write_time.time_since_epoch().count());
+    dependencies_.push_back(record);
+    return true;
+}
+
+bool CookedLevelWriter::write(const std::string& path, std::string& error_message) {
+    if (!std::ranges::is_sorted(tiles_, {}, &TileRecord::gid_)) {
+        error_message = "瓦片表未按 gid 排序: " + path;
+        return false;
+    }
+
+    std::vector<std::byte> image(sizeof(Header));
+    auto append = [&image]<typename T>(const std::vector<T>& values) {
+        Section section;
+        image.resize(alignUp(image.size()));
+        section.offset_ = static_cast<std::uint32_t>(image.size());
+        section.count_ = static_cast<std::uint32_t>(values.size());
+        const auto* bytes = reinterpret_cast<const std::byte*>(values.data());
+        image.insert(image.end(), bytes, bytes + values.size() * sizeof(T));
+        return section;
+    };
+
+    Header header = header_;
+    header.magic_ = MAGIC;
+    header.version_ = VERSION;
+    header.strings_ = append(strings_);
+    header.dependencies_ = append(dependencies_);
+    header.tiles_ = append(tiles_);
+    header.frames_ = append(frames_);
+    header.layers_ = append(layers_);
+    header.cells_ = append(cells_);
+    header.blob_ = append(blob_);
+    std::memcpy(image.data(), &header, sizeof(Header));
+
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            error_message = "无法写入预编译关卡: " + temp_path;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+        if (!file) {
+            error_message = "写入预编译关卡失败: " + temp_path;
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        error_message = "无法替换预编译关卡: " + path;
+        return false;
+    }
+    return true;
+}
+
+std::string cookedPathFor(const std::string& map_path) {
+    return std::filesystem::path(map_path).replace_extension(std::string(EXTENSION)).string();
+}
+
+} // namespace engine::loader::cooked
@@ -0,0 +1,208 @@
+#pragma once
+/**
+ * @file cooked_level.h
+ * @brief 预编译关卡（.mwl）二进制格式、内存映射读取器与写入器。
+ *
+ * @details
+ * 离线把 Tiled 地图 (.tmj) 及其引用的 tileset (.tsj) 烘焙成一个紧凑的二进制文件：
+ * - 解析完成的瓦片表（纹理路径、源矩形、类型、动画帧、自定义属性），按 gid 去重
+ * - 瓦片图层的扁平单元数组（每格直接存瓦片表下标，无需运行时查 tileset）
+ * - 对象图层（MessagePack 编码，路径点图等对象数据随之保存，解码比文本 JSON 快一个数量级）
+ *
+ * 运行时通过 MappedFile 映射整个文件，各段记录直接按偏移读取，不做任何 JSON 文本解析。
+ * 文件内所有路径均相对 .mwl 所在目录；依赖段记录源文件的大小与修改时间，任一不一致即判定过期，
+ * 调用方应回退到 JSON 路径。
+ *
+ * 布局：Header | 各段（8 字节对齐）| blob（字符串与 MessagePack 数据）。字节序为小端。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "../utils/mapped_file.h"
+
+namespace engine::loader::cooked {
+
+inline constexpr std::uint32_t MAGIC = 0x564C574Du;        ///< "MWLV"（小端）
+inline constexpr std::uint32_t VERSION = 1;
+inline constexpr std::uint32_t NONE = 0xFFFFFFFFu;         ///< 空下标/空字符串
+inline constexpr std::string_view EXTENSION = ".mwl";
+
+/// @brief 段描述：相对文件起始的字节偏移与记录数（blob 段为字节数）
+struct Section {
+    std::uint32_t offset_{0};
+    std::uint32_t count_{0};
+};
+
+struct Header {
+    std::uint32_t magic_{MAGIC};
+    std::uint32_t version_{VERSION};
+    std::int32_t map_width_{0};
+    std::int32_t map_height_{0};
+    std::int32_t tile_width_{0};
+    std::int32_t tile_height_{0};
+    std::uint32_t background_color_{NONE};  ///< 背景色字符串（如 "#47aba9"），NONE 表示未设置
+    std::uint32_t reserved_{0};
+    Section strings_;       ///< StringRecord[]
+    Section dependencies_;  ///< DependencyRecord[]
+    Section tiles_;         ///< TileRecord[]
+    Section frames_;        ///< FrameRecord[]
+    Section layers_;        ///< LayerRecord[]
+    Section cells_;         ///< std::uint32_t[]（瓦片表下标，NONE 为空格）
+    Section blob_;
+};
+
+struct StringRecord {
+    std::uint32_t offset_{0};   ///< blob 内偏移
+    std::uint32_t length_{0};
+};
+
+/// @brief 源文件指纹，用于判定预编译结果是否过期
+struct DependencyRecord {
+    std::uint32_t path_{NONE};
+    std::uint32_t reserved_{0};
+    std::uint64_t size_{0};
+    std::int64_t write_time_{0};    ///< std::filesystem::file_time_type 的计数
+};
+
+struct TileRecord {
+    std::uint32_t gid_{0};              ///< 原始 gid（含翻转位）
+    std::uint32_t texture_path_{NONE};
+    float src_x_{0.0f};
+    float src_y_{0.0f};
+    float src_width_{0.0f};
+    float src_height_{0.0f};
+    std::uint32_t type_{0};             ///< engine::component::TileType
+    std::uint32_t flipped_{0};
+    std::uint32_t first_frame_{0};
+    std::uint32_t frame_count_{0};
+    std::uint32_t properties_offset_{0};    ///< 瓦片 JSON 的 MessagePack（blob 内）
+    std::uint32_t properties_size_{0};      ///< 0 表示无自定义属性
+};
+
+struct FrameRecord {
+    float src_x_{0.0f};
+    float src_y_{0.0f};
+    float src_width_{0.0f};
+    float src_height_{0.0f};
+    float duration_ms_{0.0f};
+};
+
+enum class LayerType : std::uint32_t {
+    IMAGE,
+    TILE,
+    OBJECT,
+    UNSUPPORTED,    ///< 保留占位，使运行时图层序号与 JSON 路径一致
+};
+
+struct LayerRecord {
+    LayerType type_{LayerType::TILE};
+    std::uint32_t name_{NONE};
+    std::uint32_t visible_{1};          ///< 不可见图层同样保留（路径点等对象数据可能放在其中）
+    std::uint32_t has_order_{0};        ///< 是否带 "order" 属性
+    std::int32_t order_{0};
+    float offset_x_{0.0f};
+    float offset_y_{0.0f};
+    float parallax_x_{1.0f};
+    float parallax_y_{1.0f};
+    std::uint32_t repeat_x_{0};
+    std::uint32_t repeat_y_{0};
+    std::uint32_t image_{NONE};         ///< 图片图层的纹理路径
+    std::int32_t width_{0};
+    std::int32_t height_{0};
+    std::uint32_t first_cell_{0};
+    std::uint32_t cell_count_{0};
+    std::uint32_t objects_offset_{0};   ///< 对象数组的 MessagePack（blob 内）
+    std::uint32_t objects_size_{0};
+    std::uint32_t sort_policy_{0};      ///< engine::component::RenderSortPolicy（"sort" 属性，0 为 Y_SORT）
+};
+
+static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<TileRecord> &&
+              std::is_trivially_copyable_v<LayerRecord> && std::is_trivially_copyable_v<DependencyRecord>);
+
+/**
+ * @class CookedLevel
+ * @brief 已映射的预编译关卡（只读），各访问器直接返回映射内存的视图
+ */
+class CookedLevel final {
+public:
+    /**
+     * @brief 映射并校验文件
+     * @param path .mwl 文件路径
+     * @param error_message 失败原因
+     * @return 校验失败（格式、版本、越界或依赖过期）时返回 nullptr
+     */
+    [[nodiscard]] static std::shared_ptr<const CookedLevel> open(const std::string& path, std::string& error_message);
+
+    [[nodiscard]] const std::string& getPath() const { return path_; }
+    [[nodiscard]] const Header& getHeader() const { return *header_; }
+
+    [[nodiscard]] std::string_view getString(std::uint32_t index) const;
+    [[nodiscard]] std::span<const TileRecord> getTiles() const { return tiles_; }
+    [[nodiscard]] std::span<const FrameRecord> getFrames() const { return frames_; }
+    [[nodiscard]] std::span<const LayerRecord> getLayers() const { return layers_; }
+    [[nodiscard]] std::span<const std::uint32_t> getCells(const LayerRecord& layer) const;
+    [[nodiscard]] std::span<const std::uint8_t> getBlob(std::uint32_t offset, std::uint32_t size) const;
+
+    /// @brief 按原始 gid（含翻转位）查找瓦片表下标，未收录时返回 NONE
+    [[nodiscard]] std::uint32_t findTile(std::uint32_t gid) const;
+
+private:
+    CookedLevel() = default;
+
+    template <typename T>
+    bool bindSection(const Section& section, std::span<const T>& out, std::string& error_message) const;
+    bool checkDependencies(std::string& error_message) const;
+
+    std::string path_;
+    engine::utils::MappedFile file_;
+    const Header* header_{nullptr};
+    std::span<const StringRecord> strings_;
+    std::span<const DependencyRecord> dependencies_;
+    std::span<const TileRecord> tiles_;
+    std::span<const FrameRecord> frames_;
+    std::span<const LayerRecord> layers_;
+    std::span<const std::uint32_t> cells_;
+    std::span<const std::uint8_t> blob_;
+};
+
+/**
+ * @class CookedLevelWriter
+ * @brief 收集各段记录并一次性写出 .mwl 文件（烘焙工具使用）
+ */
+class CookedLevelWriter final {
+public:
+    Header header_;
+    std::vector<DependencyRecord> dependencies_;
+    std::vector<TileRecord> tiles_;             ///< 必须按 gid 升序（cells_ 直接引用其下标）
+    std::vector<FrameRecord> frames_;
+    std::vector<LayerRecord> layers_;
+    std::vector<std::uint32_t> cells_;
+
+    /// @brief 写入（去重）字符串并返回其下标
+    std::uint32_t addString(std::string_view value);
+    /// @brief 追加一段二进制数据，返回 blob 内偏移
+    std::uint32_t addBlob(std::span<const std::uint8_t> data);
+    /// @brief 记录源文件当前的大小与修改时间
+    bool addDependency(const std::string& path, std::string_view relative_path);
+
+    /// @brief 写出文件（先写临时文件再重命名，避免读到半成品）
+    bool write(const std::string& path, std::string& error_message);
+
+private:
+    std::vector<StringRecord> strings_;
+    std::vector<std::uint8_t> blob_;
+    std::unordered_map<std::string, std::uint32_t> string_index_;
+};
+
+/// @brief 给定 Tiled 地图路径，返回同目录同名的 .mwl 路径
+[[nodiscard]] std::string cookedPathFor(const std::string& map_path);
+
+} // namespace engine::loader::cooked
@@ -7,36 +7,81 @@
 #include "../component/sprite_component.h"
 #include "../component/render_component.h"
 #include "../component/animation_component.h"
+#include "../component/tile_animation_component.h"
 #include "../component/audio_component.h"
 #include "../scene/scene.h"
 #include "../core/context.h"
+#include "../core/content_cache.h"
+#include "../core/startup_profiler.h"
+#include "../core/job_system.h"
+#include "../io/virtual_fs.h"
 #include "../render/renderer.h"
 #include "../resource/resource_manager.h"
 #include "../render/animation.h"
+#include "../spatial/tile_grid.h"
 #include "../utils/math.h"
+#include "../utils/profiler.h"
+#include "cooked_level.h"
 #include <nlohmann/json.hpp>
-#include <fstream>
 #include <spdlog/spdlog.h>
 #include <glm/vec2.hpp>
+#include <algorithm>
 #include <filesystem>
+#include <functional>
 #include <SDL3/SDL_rect.h>
 #include <entt/core/hashed_string.hpp>
 #include <entt/entity/entity.hpp>
 #include <future>
+#include <limits>
+#include <set>
+#include <system_error>
+#include <unordered_map>
+#include <cmath>
+#include <glm/common.hpp>
+#include <glm/vector_relational.hpp>
 
 namespace engine::loader {
 
 namespace {
 
+/// 解析阶段的一个任务：某个图层内的一段格子 [begin_, end_)
+struct CellChunk {
+    std::size_t layer_{0};
+    std::size_t begin_{0};
+    std::size_t end_{0};
+};
+
+/// 把各图层的格子切成不超过 chunk_cells 的段（图层顺序、段内顺序与行优先顺序一致）
+std::vector<CellChunk> splitCells(std::span<const std::size_t> cell_counts, std::size_t chunk_cells) {
+    std::vector<CellChunk> chunks;
+    for (std::size_t layer = 0; layer < cell_counts.size(); ++layer) {
+        for (std::size_t begin = 0; begin < cell_counts[layer]; begin += chunk_cells) {
+            chunks.push_back(CellChunk{layer, begin, std::min(begin + chunk_cells, cell_counts[layer])});
+        }
+    }
+    return chunks;
+}
+
+/// 在 JobSystem 上执行 task(0) ... task(count - 1)；只有一段或已处在任务内部时串行执行
+void runChunks(engine::core::JobSystem& jobs, std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (count > 1 && jobs.getThreadCount() > 1 && !engine::core::JobSystem::isInsideJob()) {
+        jobs.parallelFor(count, task);
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        task(i);
+    }
+}
+
 bool readJsonFile(const std::string& file_path, nlohmann::json& out_json, std::string& error_message) {
-    std::ifstream file(file_path);
-    if (!file.is_open()) {
+    const auto file = engine::io::VirtualFS::instance().read(file_path);
+    if (!file) {
         error_message = "无法打开文件: " + file_path;
         return false;
     }
 
     try {
-        file >> out_json;
+        out_json = nlohmann::json::parse(file->text());
         return true;
     } catch (const nlohmann::json::parse_error& e) {
         error_message = "解析 JSON 文件失败: " + file_path + " (" + e.what() + ")";
@@ -44,52 +89,138 @@ bool readJsonFile(const std::string& file_path, nlohmann::json& out_json, std::s
     }
 }
 
+/// @brief 解析图层的 "sort" 属性（"y" / "none" / "texture"），无法识别时返回空
+std::optional<engine::component::RenderSortPolicy> parseSortPolicy(const nlohmann::json& value) {
+    const auto text = value.is_string() ? value.get<std::string>() : std::string{};
+    if (text == "y") {
+        return engine::component::RenderSortPolicy::Y_SORT;
+    }
+    if (text == "none") {
+        return engine::component::RenderSortPolicy::NONE;
+    }
+    if (text == "texture") {
+        return engine::component::RenderSortPolicy::TEXTURE;
+    }
+    return std::nullopt;
+}
+
+/// @brief 在 registry 上下文中声明层级的排序策略（YSortSystem 据此写入排序键）
+void declareSortPolicy(entt::registry& registry, int layer_index, engine::component::RenderSortPolicy policy) {
+    auto& ctx = registry.ctx();
+    if (!ctx.contains<engine::component::RenderLayerPolicies>()) {
+        ctx.emplace<engine::component::RenderLayerPolicies>();
+    }
+    ctx.get<engine::component::RenderLayerPolicies>().set(layer_index, policy);
+}
+
+/// @brief 流式读取地图文件：瓦片图层的 data 数组直接进入 gid 缓冲（见 tiled_map_reader.h）
+bool readMapFile(const std::string& file_path, LevelLoadData& level_data) {
+    const auto file = engine::io::VirtualFS::instance().read(file_path);
+    if (!file) {
+        level_data.error_message = "无法打开文件: " + file_path;
+        return false;
+    }
+
+    std::string error;
+    if (!readTiledMap(file->text(), level_data.level_json, level_data.layer_cells_, error)) {
+        level_data.error_message = "解析 JSON 文件失败: " + file_path + " (" + error + ")";
+        return false;
+    }
+    return true;
+}
+
 std::string resolvePathForFile(const std::string& relative_path, const std::string& file_path) {
     try {
         const auto base_dir = std::filesystem::path(file_path).parent_path();
         return std::filesystem::canonical(base_dir / relative_path).string();
     } catch (const std::exception&) {
-        return relative_path;
+        // 文件只存在于资源包中时无法 canonical，按词法规范化（VirtualFS 用同样的规则查找）
+        return (std::filesystem::path(file_path).parent_path() / relative_path).lexically_normal().string();
+    }
+}
+
+/// @brief 读取 tileset 文件并记录其路径（后续解析图片路径时需要）
+std::shared_ptr<const TilesetData> readTileset(const std::string& tileset_path, std::string& error_message) {
+    auto tileset = std::make_shared<TilesetData>();
+    if (!readJsonFile(tileset_path, tileset->json_, error_message)) {
+        return nullptr;
     }
+    tileset->json_["file_path"] = tileset_path;
+    return tileset;
 }
 
 } // namespace
 
-std::future<LevelLoadData> LevelLoader::loadLevelDataAsync(const std::string& map_path) {
-    return std::async(std::launch::async, [map_path]() {
-        LevelLoadData level_data;
-        level_data.level_path = map_path;
+std::future<LevelLoadData> LevelLoader::loadLevelDataAsync(const std::string& map_path, bool prefer_cooked,
+                                                           engine::core::ContentCache* content_cache,
+                                                           engine::core::TaskPool* task_pool,
+                                                           engine::core::TaskPriority priority) {
+    return engine::core::runAsync(task_pool, priority, [map_path, prefer_cooked, content_cache]() {
+        return loadLevelData(map_path, prefer_cooked, content_cache);
+    });
+}
 
-        if (!readJsonFile(map_path, level_data.level_json, level_data.error_message)) {
+LevelLoadData LevelLoader::loadLevelData(const std::string& map_path, bool prefer_cooked,
+                                         engine::core::ContentCache* content_cache) {
+    ENGINE_PROFILE_SCOPE("LevelLoader::loadLevelData");
+    LevelLoadData level_data;
+    level_data.level_path = map_path;
+
+    if (prefer_cooked) {
+        const auto cooked_path = cooked::cookedPathFor(map_path);
+        std::error_code ec;
+        if (std::filesystem::exists(cooked_path, ec)) {
+            std::string reason;
+            ENGINE_STARTUP_PHASE("level.cooked_open");
+            if (auto level = cooked::CookedLevel::open(cooked_path, reason)) {
+                level_data.cooked_ = std::move(level);
+                level_data.valid_ = true;
+                return level_data;
+            }
+            spdlog::warn("预编译关卡不可用，回退到 JSON 解析: {}", reason);
+        }
+    }
+
+    {
+        ENGINE_STARTUP_PHASE("level.json_parse");
+        if (!readMapFile(map_path, level_data)) {
             return level_data;
         }
+    }
 
-        if (level_data.level_json.contains("tilesets") && level_data.level_json["tilesets"].is_array()) {
-            for (const auto& tileset_json : level_data.level_json["tilesets"]) {
-                if (!tileset_json.contains("source") || !tileset_json["source"].is_string() ||
-                    !tileset_json.contains("firstgid") || !tileset_json["firstgid"].is_number_integer()) {
-                    level_data.error_message = "tilesets 对象中缺少有效 'source' 或 'firstgid' 字段。";
-                    return level_data;
-                }
+    if (level_data.level_json.contains("tilesets") && level_data.level_json["tilesets"].is_array()) {
+        ENGINE_PROFILE_SCOPE("LevelLoader::parseTilesets");
+        ENGINE_STARTUP_PHASE("level.tileset_parse");
+        for (const auto& tileset_json : level_data.level_json["tilesets"]) {
+            if (!tileset_json.contains("source") || !tileset_json["source"].is_string() ||
+                !tileset_json.contains("firstgid") || !tileset_json["firstgid"].is_number_integer()) {
+                level_data.error_message = "tilesets 对象中缺少有效 'source' 或 'firstgid' 字段。";
+                return level_data;
+            }
 
-                const auto tileset_path = resolvePathForFile(tileset_json["source"].get<std::string>(), map_path);
-                ParsedTileset parsed_tileset;
-                parsed_tileset.first_gid = tileset_json["firstgid"].get<int>();
-                parsed_tileset.file_path = tileset_path;
-                if (!readJsonFile(tileset_path, parsed_tileset.json_data, level_data.error_message)) {
-                    return level_data;
-                }
-                parsed_tileset.json_data["file_path"] = tileset_path;
-                level_data.tilesets.emplace_back(std::move(parsed_tileset));
+            const auto tileset_path = resolvePathForFile(tileset_json["source"].get<std::string>(), map_path);
+            ParsedTileset parsed_tileset;
+            parsed_tileset.first_gid = tileset_json["firstgid"].get<int>();
+            parsed_tileset.file_path = tileset_path;
+            // 同一 tileset 通常被多个关卡引用：有缓存时按路径共享，文件未修改就不再解析
+            parsed_tileset.data = content_cache
+                ? content_cache->getOrLoad<const TilesetData>(entt::hashed_string::value(tileset_path.c_str()), { tileset_path },
+                    [&]() { return readTileset(tileset_path, level_data.error_message); })
+                : readTileset(tileset_path, level_data.error_message);
+            if (!parsed_tileset.data) {
+                return level_data;
             }
+            level_data.tilesets.emplace_back(std::move(parsed_tileset));
         }
+    }
 
-        level_data.valid_ = true;
-        return level_data;
-    });
+    level_data.valid_ = true;
+    return level_data;
 }
 
 bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene::Scene* scene) {
+    ENGINE_PROFILE_SCOPE("LevelLoader::applyLevelData");
+    ENGINE_STARTUP_PHASE("level.instantiate");
     if (!level_data.valid_) {
         spdlog::error("关卡数据无效: {}", level_data.error_message);
         return false;
@@ -107,6 +238,21 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
     map_path_ = level_data.level_path;
     tileset_data_.clear();
     cache_ = {};
+    cooked_ = nullptr;
+    tile_table_.clear();
+    tile_ids_.clear();
+    tile_clocks_.clear();
+    releaseStreaming();
+
+    if (level_data.cooked_) {
+        // 流式图层此后仍按区块读取映射内存，由加载器持有映射
+        streamed_level_ = level_data.cooked_;
+        const bool applied = applyCookedLevel(*level_data.cooked_);
+        if (streamed_layers_.empty()) {
+            streamed_level_.reset();
+        }
+        return applied;
+    }
 
     const auto& json_data = level_data.level_json;
     map_size_ = glm::ivec2(json_data.value("width", 0), json_data.value("height", 0));
@@ -118,7 +264,7 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
     }
 
     for (const auto& tileset : level_data.tilesets) {
-        tileset_data_[tileset.first_gid] = tileset.json_data;
+        tileset_data_[tileset.first_gid] = tileset.data;
     }
 
     current_layer_ = 0;
@@ -127,24 +273,52 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
         return false;
     }
 
-    for (const auto& layer_json : json_data["layers"]) {
+    // 解析阶段：先解析全部可见瓦片图层的格子，之后按图层顺序逐层创建
+    const auto& layers = json_data["layers"];
+    const TileLayerCells no_cells;
+    auto cells_of = [&](std::size_t index) -> const TileLayerCells& {
+        return index < level_data.layer_cells_.size() ? level_data.layer_cells_[index] : no_cells;
+    };
+    std::vector<const TileLayerCells*> tile_layers;
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        if (layers[i].value("type", "none") == "tilelayer" && layers[i].value("visible", true) && cells_of(i).present_) {
+            tile_layers.push_back(&cells_of(i));
+        }
+    }
+    const auto tile_records = resolveJsonTileLayers(tile_layers);
+    const TileLayerRecords no_records;
+    std::size_t next_tile_layer = 0;
+
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        const auto& layer_json = layers[i];
         std::string layer_type = layer_json.value("type", "none");
         if (!layer_json.value("visible", true)) {
             spdlog::info("图层 '{}' 不可见，跳过加载。", layer_json.value("name", "Unnamed"));
             continue;
         }
+        std::optional<engine::component::RenderSortPolicy> sort_policy;
         if (layer_json.contains("properties")) {
             for (auto& property : layer_json["properties"]) {
                 if (property.contains("name") && property["name"] == "order") {
                     current_layer_ = property["value"].get<int>();
+                } else if (property.contains("name") && property["name"] == "sort") {
+                    sort_policy = parseSortPolicy(property.value("value", nlohmann::json{}));
+                    if (!sort_policy) {
+                        spdlog::warn("图层 '{}' 的 sort 属性无效，按 y 处理", layer_json.value("name", "Unnamed"));
+                    }
                 }
             }
         }
+        if (sort_policy) {
+            declareSortPolicy(scene_->getRegistry(), current_layer_, *sort_policy);
+        }
 
         if (layer_type == "imagelayer") {
             loadImageLayer(layer_json);
         } else if (layer_type == "tilelayer") {
-            loadTileLayer(layer_json);
+            const auto& cells = cells_of(i);
+            const bool resolved = next_tile_layer < tile_layers.size() && tile_layers[next_tile_layer] == &cells;
+            loadTileLayer(layer_json, cells, resolved ? tile_records[next_tile_layer++] : no_records);
         } else if (layer_type == "objectgroup") {
             loadObjectLayer(layer_json);
         } else {
@@ -157,14 +331,329 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
     return true;
 }
 
-    LevelLoader::~LevelLoader() = default;
+    LevelLoader::~LevelLoader() {
+        releaseStreaming();
+    }
 
     bool LevelLoader::loadLevel(const std::string& level_path, engine::scene::Scene* scene) {
-        auto level_data = loadLevelDataAsync(level_path).get();
+        auto level_data = loadLevelData(level_path);
         return applyLevelData(level_data, scene);
     }
 
+    bool LevelLoader::cookLevel(const std::string& map_path, const std::string& output_path, std::string& error_message) {
+        auto level_data = loadLevelData(map_path, false);
+        if (!level_data.valid_) {
+            error_message = level_data.error_message;
+            return false;
+        }
+        const auto& json_data = level_data.level_json;
+        if (!json_data.contains("layers") || !json_data["layers"].is_array()) {
+            error_message = "地图文件 '" + map_path + "' 中缺少或无效的 'layers' 数组。";
+            return false;
+        }
+
+        const std::string cooked_path = output_path.empty() ? cooked::cookedPathFor(map_path) : output_path;
+        std::error_code ec;
+        const auto cooked_dir = std::filesystem::weakly_canonical(std::filesystem::absolute(cooked_path).parent_path(), ec);
+        // 写入文件的路径均相对 .mwl 所在目录，运行时再拼接并规范化，得到与 JSON 路径相同的纹理键
+        auto relative = [&cooked_dir](std::string_view path) {
+            const auto rel = std::filesystem::path(path).lexically_relative(cooked_dir);
+            return rel.empty() ? std::string(path) : rel.generic_string();
+        };
+
+        // 复用 JSON 路径的瓦片解析逻辑，保证两条路径得到相同的 TileInfo
+        LevelLoader resolver;
+        resolver.map_path_ = map_path;
+        resolver.tile_size_ = glm::ivec2(json_data.value("tilewidth", 0), json_data.value("tileheight", 0));
+        for (const auto& tileset : level_data.tilesets) {
+            resolver.tileset_data_[tileset.first_gid] = tileset.data;
+        }
+
+        cooked::CookedLevelWriter writer;
+        writer.header_.map_width_ = json_data.value("width", 0);
+        writer.header_.map_height_ = json_data.value("height", 0);
+        writer.header_.tile_width_ = resolver.tile_size_.x;
+        writer.header_.tile_height_ = resolver.tile_size_.y;
+        if (json_data.contains("backgroundcolor")) {
+            writer.header_.background_color_ = writer.addString(json_data["backgroundcolor"].get<std::string>());
+        }
+
+        const auto map_file = std::filesystem::weakly_canonical(map_path, ec).string();
+        bool dependencies_ok = writer.addDependency(map_path, relative(map_file));
+        for (const auto& tileset : level_data.tilesets) {
+            dependencies_ok = writer.addDependency(tileset.file_path, relative(tileset.file_path)) && dependencies_ok;
+        }
+        if (!dependencies_ok) {
+            error_message = "无法读取关卡源文件信息: " + map_path;
+            return false;
+        }
+
+        const auto& layers = json_data["layers"];
+        const auto& layer_cells = level_data.layer_cells_;
+
+        // 收集地图中出现的全部 gid（含翻转位），按升序生成瓦片表
+        std::set<std::uint32_t> gids;
+        for (std::size_t i = 0; i < layers.size(); ++i) {
+            const auto& layer_json = layers[i];
+            if (i < layer_cells.size()) {
+                for (const auto gid : layer_cells[i].gids_) {
+                    if (gid != 0) {
+                        gids.insert(static_cast<std::uint32_t>(gid));
+                    }
+                }
+            }
+            if (layer_json.contains("objects") && layer_json["objects"].is_array()) {
+                for (const auto& object : layer_json["objects"]) {
+                    if (const auto gid = object.value("gid", 0u); gid != 0) {
+                        gids.insert(gid);
+                    }
+                }
+            }
+        }
+
+        std::unordered_map<std::uint32_t, std::uint32_t> tile_index;
+        for (const auto gid : gids) {
+            const auto tile_info = resolver.getTileInfoByGid(static_cast<int>(gid));
+            if (tile_info.type_ == engine::component::TileType::EMPTY &&
+                tile_info.sprite_.texture_id_ == entt::null &&
+                tile_info.sprite_.getTexturePath().empty()) {
+                continue;
+            }
+
+            cooked::TileRecord record;
+            record.gid_ = gid;
+            if (!tile_info.sprite_.getTexturePath().empty()) {
+                record.texture_path_ = writer.addString(relative(tile_info.sprite_.getTexturePath()));
+            }
+            record.src_x_ = tile_info.sprite_.src_rect_.position.x;
+            record.src_y_ = tile_info.sprite_.src_rect_.position.y;
+            record.src_width_ = tile_info.sprite_.src_rect_.size.x;
+            record.src_height_ = tile_info.sprite_.src_rect_.size.y;
+            record.type_ = static_cast<std::uint32_t>(tile_info.type_);
+            record.flipped_ = tile_info.sprite_.is_flipped_ ? 1u : 0u;
+            if (tile_info.animation_) {
+                record.first_frame_ = static_cast<std::uint32_t>(writer.frames_.size());
+                for (const auto& frame : tile_info.animation_->frames_) {
+                    writer.frames_.push_back(cooked::FrameRecord{ frame.src_rect_.position.x, frame.src_rect_.position.y,
+                        frame.src_rect_.size.x, frame.src_rect_.size.y, frame.duration_ms_ });
+                }
+                record.frame_count_ = static_cast<std::uint32_t>(tile_info.animation_->frames_.size());
+            }
+            if (tile_info.properties_) {
+                const auto bytes = nlohmann::json::to_msgpack(*tile_info.properties_);
+                record.properties_offset_ = writer.addBlob(bytes);
+                record.properties_size_ = static_cast<std::uint32_t>(bytes.size());
+            }
+            tile_index.emplace(gid, static_cast<std::uint32_t>(writer.tiles_.size()));
+            writer.tiles_.push_back(record);
+        }
+
+        for (std::size_t i = 0; i < layers.size(); ++i) {
+            const auto& layer_json = layers[i];
+            cooked::LayerRecord layer;
+            const std::string layer_type = layer_json.value("type", "none");
+            layer.name_ = writer.addString(layer_json.value("name", "Unnamed"));
+            layer.visible_ = layer_json.value("visible", true) ? 1u : 0u;
+            if (layer_json.contains("properties")) {
+                for (const auto& property : layer_json["properties"]) {
+                    if (property.contains("name") && property["name"] == "order") {
+                        layer.has_order_ = 1;
+                        layer.order_ = property["value"].get<int>();
+                    } else if (property.contains("name") && property["name"] == "sort") {
+                        if (const auto policy = parseSortPolicy(property.value("value", nlohmann::json{}))) {
+                            layer.sort_policy_ = static_cast<std::uint32_t>(*policy);
+                        }
+                    }
+                }
+            }
+            layer.offset_x_ = layer_json.value("offsetx", 0.0f);
+            layer.offset_y_ = layer_json.value("offsety", 0.0f);
+
+            if (layer_type == "imagelayer") {
+                layer.type_ = cooked::LayerType::IMAGE;
+                layer.parallax_x_ = layer_json.value("parallaxx", 1.0f);
+                layer.parallax_y_ = layer_json.value("parallaxy", 1.0f);
+                layer.repeat_x_ = layer_json.value("repeatx", false) ? 1u : 0u;
+                layer.repeat_y_ = layer_json.value("repeaty", false) ? 1u : 0u;
+                // 不可见图层运行时会被跳过，无需解析其图片路径
+                const std::string image_path = layer_json.value("image", "");
+                if (layer.visible_ && !image_path.empty()) {
+                    layer.image_ = writer.addString(relative(resolver.resolvePath(image_path, map_path)));
+                }
+            } else if (layer_type == "tilelayer") {
+                layer.type_ = cooked::LayerType::TILE;
+                layer.width_ = layer_json.value("width", 0);
+                layer.height_ = layer_json.value("height", 0);
+                if (i < layer_cells.size() && layer_cells[i].present_) {
+                    layer.first_cell_ = static_cast<std::uint32_t>(writer.cells_.size());
+                    for (const auto gid : layer_cells[i].gids_) {
+                        const auto it = tile_index.find(static_cast<std::uint32_t>(gid));
+                        writer.cells_.push_back(it != tile_index.end() ? it->second : cooked::NONE);
+                    }
+                    layer.cell_count_ = static_cast<std::uint32_t>(writer.cells_.size()) - layer.first_cell_;
+                }
+            } else if (layer_type == "objectgroup") {
+                layer.type_ = cooked::LayerType::OBJECT;
+                if (layer_json.contains("objects") && layer_json["objects"].is_array()) {
+                    const auto bytes = nlohmann::json::to_msgpack(layer_json["objects"]);
+                    layer.objects_offset_ = writer.addBlob(bytes);
+                    layer.objects_size_ = static_cast<std::uint32_t>(bytes.size());
+                }
+            } else {
+                layer.type_ = cooked::LayerType::UNSUPPORTED;
+            }
+            writer.layers_.push_back(layer);
+        }
+
+        if (!writer.write(cooked_path, error_message)) {
+            return false;
+        }
+        spdlog::info("关卡预编译完成: {} -> {}（{} 种瓦片，{} 个图层）",
+            map_path, cooked_path, writer.tiles_.size(), writer.layers_.size());
+        return true;
+    }
+
+    bool LevelLoader::applyCookedLevel(const cooked::CookedLevel& level) {
+        ENGINE_PROFILE_SCOPE("LevelLoader::applyCookedLevel");
+        const auto& header = level.getHeader();
+        map_size_ = glm::ivec2(header.map_width_, header.map_height_);
+        tile_size_ = glm::ivec2(header.tile_width_, header.tile_height_);
+        if (header.background_color_ != cooked::NONE) {
+            const auto color = engine::utils::parseHexColor(level.getString(header.background_color_));
+            scene_->getContext().getRenderer().setBackgroundColor(color);
+        }
+
+        // 文件内路径相对 .mwl 所在目录，每个字符串只规范化一次
+        std::unordered_map<std::uint32_t, std::string> resolved_paths;
+        auto resolve_path = [&](std::uint32_t index) -> std::string {
+            if (index == cooked::NONE) {
+                return {};
+            }
+            auto [it, inserted] = resolved_paths.try_emplace(index);
+            if (inserted) {
+                it->second = resolvePathForFile(std::string(level.getString(index)), level.getPath());
+            }
+            return it->second;
+        };
+
+        cooked_ = &level;
+        try {
+            const auto frames = level.getFrames();
+            tile_table_.reserve(level.getTiles().size());
+            for (const auto& record : level.getTiles()) {
+                engine::component::Sprite sprite(resolve_path(record.texture_path_),
+                    engine::utils::Rect{ record.src_x_, record.src_y_, record.src_width_, record.src_height_ },
+                    record.flipped_ != 0);
+
+                std::optional<engine::component::Animation> animation = std::nullopt;
+                if (record.frame_count_ > 0) {
+                    std::vector<engine::component::AnimationFrame> animation_frames;
+                    animation_frames.reserve(record.frame_count_);
+                    for (const auto& frame : frames.subspan(record.first_frame_, record.frame_count_)) {
+                        animation_frames.emplace_back(
+                            engine::utils::Rect{ frame.src_x_, frame.src_y_, frame.src_width_, frame.src_height_ }, frame.duration_ms_);
+                    }
+                    animation = engine::component::Animation(std::move(animation_frames), {}, true);
+                }
+
+                std::optional<nlohmann::json> properties = std::nullopt;
+                if (record.properties_size_ > 0) {
+                    const auto bytes = level.getBlob(record.properties_offset_, record.properties_size_);
+                    properties = nlohmann::json::from_msgpack(bytes.begin(), bytes.end());
+                }
+
+                tile_table_.emplace_back(std::move(sprite), static_cast<engine::component::TileType>(record.type_),
+                    std::move(animation), std::move(properties));
+            }
+
+            // 解析阶段：格子中已是瓦片表索引，只需并行分类；流式图层不整图分类，区块载入时再读格子
+            auto streams = [&](const cooked::LayerRecord& layer) {
+                return tile_streaming_enabled_ && layer.cell_count_ >= STREAMING_MIN_CELLS;
+            };
+            std::vector<std::span<const std::uint32_t>> tile_cells;
+            std::vector<std::size_t> cell_counts;
+            for (const auto& layer : level.getLayers()) {
+                if (layer.type_ == cooked::LayerType::TILE && layer.visible_) {
+                    tile_cells.push_back(streams(layer) ? std::span<const std::uint32_t>{} : level.getCells(layer));
+                    cell_counts.push_back(tile_cells.back().size());
+                }
+            }
+            const auto tile_records = classifyTileLayers(cell_counts, [&](std::size_t layer, std::size_t index) -> std::uint32_t {
+                const auto cell = tile_cells[layer][index];
+                return cell == cooked::NONE ? NO_TILE : cell;
+            });
+            std::size_t next_tile_layer = 0;
+
+            current_layer_ = 0;
+            for (const auto& layer : level.getLayers()) {
+                const std::string layer_name(level.getString(layer.name_));
+                if (!layer.visible_) {
+                    spdlog::info("图层 '{}' 不可见，跳过加载。", layer_name);
+                    continue;
+                }
+                if (layer.has_order_) {
+                    current_layer_ = layer.order_;
+                }
+                // 未声明时为 Y_SORT，与策略表的默认值相同，写入不会改变策略表
+                declareSortPolicy(scene_->getRegistry(), current_layer_,
+                                  static_cast<engine::component::RenderSortPolicy>(layer.sort_policy_));
+
+                const glm::vec2 offset(layer.offset_x_, layer.offset_y_);
+                switch (layer.type_) {
+                case cooked::LayerType::IMAGE:
+                    if (layer.image_ == cooked::NONE) {
+                        spdlog::error("图层 '{}' 缺少 'image' 属性。", layer_name);
+                        break;
+                    }
+                    addImageLayer(layer_name, resolve_path(layer.image_), offset,
+                        glm::vec2(layer.parallax_x_, layer.parallax_y_), glm::bvec2(layer.repeat_x_ != 0, layer.repeat_y_ != 0));
+                    break;
+                case cooked::LayerType::TILE: {
+                    const auto& records = tile_records[next_tile_layer++];
+                    if (streams(layer) && entity_builder_) {
+                        buildStreamedTileLayer(layer_name, glm::ivec2(layer.width_, layer.height_), offset, level.getCells(layer));
+                        break;
+                    }
+                    if (records.cell_count_ == 0) {
+                        spdlog::error("图层 '{}' 缺少 'data' 属性。", layer_name);
+                        break;
+                    }
+                    if (!entity_builder_) {
+                        spdlog::error("实体生成器未初始化，无法加载瓦片图层。");
+                        break;
+                    }
+                    buildTileLayer(layer_name, glm::ivec2(layer.width_, layer.height_), offset, records);
+                    break;
+                }
+                case cooked::LayerType::OBJECT: {
+                    if (layer.objects_size_ == 0) {
+                        spdlog::error("对象图层 '{}' 缺少 'objects' 属性。", layer_name);
+                        break;
+                    }
+                    const auto bytes = level.getBlob(layer.objects_offset_, layer.objects_size_);
+                    const auto objects = nlohmann::json::from_msgpack(bytes.begin(), bytes.end());
+                    loadObjects(objects, layer_name);
+                    break;
+                }
+                default:
+                    spdlog::warn("不支持的图层类型: {}", layer_name);
+                    break;
+                }
+                current_layer_++;
+            }
+        } catch (const nlohmann::json::exception& e) {
+            spdlog::error("预编译关卡 '{}' 数据损坏: {}", level.getPath(), e.what());
+            cooked_ = nullptr;
+            return false;
+        }
+
+        cooked_ = nullptr;
+        spdlog::info("关卡数据应用完成: {}（预编译）", level.getPath());
+        return true;
+    }
+
     void LevelLoader::loadImageLayer(const nlohmann::json& layer_json) {
+        ENGINE_PROFILE_SCOPE("LevelLoader::loadImageLayer");
         // 获取纹理相对路径 （会自动处理'\/'符号）
         const std::string& image_path = layer_json.value("image", "");
         if (image_path.empty()) {
@@ -172,9 +661,6 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
             return;
         }
         auto texture_path = resolvePath(image_path, map_path_);
-        auto* resource_manager = &scene_->getContext().getResourceManager();
-        auto texture_size = resource_manager->getTextureSize(entt::hashed_string(texture_path.c_str()),texture_path);
-        auto sprite = engine::component::Sprite(texture_path,engine::utils::Rect{0,0,texture_size.x,texture_size.y});
         // 获取图层偏移量（json中没有则代表未设置，给默认值即可）
         const glm::vec2 offset = glm::vec2(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
 
@@ -182,8 +668,15 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
         const glm::vec2 scroll_factor = glm::vec2(layer_json.value("parallaxx", 1.0f), layer_json.value("parallaxy", 1.0f));
         const glm::bvec2 repeat = glm::bvec2(layer_json.value("repeatx", false), layer_json.value("repeaty", false));
 
-        // 获取图层名称
-        const std::string& layer_name = layer_json.value("name", "Unnamed");
+        addImageLayer(layer_json.value("name", "Unnamed"), texture_path, offset, scroll_factor, repeat);
+    }
+
+    void LevelLoader::addImageLayer(const std::string& layer_name, const std::string& texture_path,
+                                    glm::vec2 offset, glm::vec2 scroll_factor, glm::bvec2 repeat) {
+        auto* resource_manager = &scene_->getContext().getResourceManager();
+        auto texture_size = resource_manager->getTextureSize(entt::hashed_string(texture_path.c_str()),texture_path);
+        auto sprite = engine::component::Sprite(texture_path,engine::utils::Rect{0,0,texture_size.x,texture_size.y});
+
         entt::id_type name_id = entt::hashed_string(layer_name.c_str());
         //Todo：使用ecs组件系统来管理图层对象，避免过度依赖GameObject的构造函数和成员函数，增强灵活性和可扩展性
         auto& registry = scene_->getRegistry();
@@ -193,19 +686,65 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
             registry.emplace<engine::component::ParallaxComponent>(entity, scroll_factor, repeat);
             registry.emplace<engine::component::SpriteComponent>(entity, sprite);
             registry.emplace<engine::component::RenderComponent>(entity, current_layer_, 0.0f);
-        // // 创建游戏对象
-        // auto game_object = std::make_unique<engine::object::GameObject>(layer_name);
-        // // 依次添加Transform，Parallax组件
-        // game_object->addComponent<engine::component::TransformComponent>(offset);
-        // game_object->addComponent<engine::component::ParallaxComponent>(texture_id, scroll_factor, repeat);
-        // // 添加到场景中
-        // scene.addGameObject(std::move(game_object));
         spdlog::info("加载图层: '{}' 完成", layer_name);
     }
 
-    void LevelLoader::loadTileLayer(const nlohmann::json& layer_json)
+    void LevelLoader::buildTileLayer(const std::string& layer_name, glm::ivec2 layer_map_size, glm::vec2 layer_offset,
+                                     const TileLayerRecords& records)
     {
-        if (!layer_json.contains("data") || !layer_json["data"].is_array()) {
+        auto name_id = entt::hashed_string(layer_name.c_str());
+        auto& registry = scene_->getRegistry();
+        auto entity = registry.create();
+        registry.emplace<engine::component::NameComponent>(entity, name_id, layer_name);
+
+        if (layer_map_size.x <= 0 || layer_map_size.y <= 0) {
+            spdlog::error("图层 '{}' 缺少或无效的 width/height。", layer_name);
+            return;
+        }
+        // 瓦片实体列表按格子索引排列（瓦片数量 = 地图宽度 * 地图高度），空格与烘焙瓦片为 entt::null
+        std::vector<entt::entity> tiles(records.cell_count_, entt::null);
+
+        // 创建阶段：需要实体的瓦片交给构建器批量创建，再按格子索引写回
+        std::vector<TileSpawn> spawns;
+        spawns.reserve(records.spawned_.size());
+        for (const auto& tile : records.spawned_) {
+            spawns.push_back(TileSpawn{tile.index_, &tile_table_[tile.tile_]});
+        }
+        std::vector<entt::entity> spawned(spawns.size(), entt::null);
+        entity_builder_->buildTiles(spawns, spawned);
+        for (std::size_t i = 0; i < spawned.size(); ++i) {
+            tiles[static_cast<std::size_t>(records.spawned_[i].index_)] = spawned[i];
+        }
+
+        auto chunks = bakeTileChunks(layer_name, layer_map_size, records.baked_);
+
+        // 格子表：烘焙瓦片没有实体可查，导航与建造位在这里按格子读取类型与属性
+        using engine::spatial::TileGrid;
+        std::vector<TileGrid::Cell> cells(records.cell_count_, TileGrid::packCell(engine::component::TileType::EMPTY));
+        for (const auto* group : { &records.baked_, &records.spawned_ }) {
+            const TileGrid::Cell group_flags = group == &records.spawned_ ? TileGrid::ENTITY : 0;
+            for (const auto& tile : *group) {
+                const auto& info = tile_table_[tile.tile_];
+                const auto flags = static_cast<TileGrid::Cell>(group_flags | TileGrid::typeFlags(info.type_) |
+                                                               (info.properties_ ? TileGrid::PROPERTIES : 0));
+                cells[static_cast<std::size_t>(tile.index_)] = TileGrid::packCell(info.type_, flags);
+            }
+        }
+
+        // 添加 TileLayerComponent
+        registry.emplace<engine::component::TileLayerComponent>(entity, tile_size_, layer_map_size, std::move(tiles),
+                                                                std::move(chunks), std::move(cells));
+
+        // 可选：添加 TransformComponent 处理图层偏移
+        registry.emplace<engine::component::TransformComponent>(entity, layer_offset);
+
+        spdlog::info("图层 '{}' 加载完成 ({}x{})", layer_name, layer_map_size.x, layer_map_size.y);
+    }
+
+    void LevelLoader::loadTileLayer(const nlohmann::json& layer_json, const TileLayerCells& cells, const TileLayerRecords& records)
+    {
+        ENGINE_PROFILE_SCOPE("LevelLoader::loadTileLayer");
+        if (!cells.present_) {
             spdlog::error("图层 '{}' 缺少 'data' 属性。", layer_json.value("name", "Unnamed"));
             return;
         }
@@ -215,71 +754,437 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
             return;
         }
 
-        auto layer_name = layer_json.value("name", "Unnamed");
-        auto name_id = entt::hashed_string(layer_name.c_str());
-        auto& registry = scene_->getRegistry();
-        auto entity = registry.create();
-        registry.emplace<engine::component::NameComponent>(entity, name_id, layer_name);
-
         const glm::ivec2 layer_map_size(layer_json.value("width", 0), layer_json.value("height", 0));
-        if (layer_map_size.x <= 0 || layer_map_size.y <= 0) {
-            spdlog::error("图层 '{}' 缺少或无效的 width/height。", layer_json.value("name", "Unnamed"));
-            return;
+        const glm::vec2 layer_offset(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
+        buildTileLayer(layer_json.value("name", "Unnamed"), layer_map_size, layer_offset, records);
+    }
+
+    std::vector<LevelLoader::TileLayerRecords> LevelLoader::resolveJsonTileLayers(std::span<const TileLayerCells* const> layers)
+    {
+        ENGINE_PROFILE_SCOPE("LevelLoader::resolveJsonTileLayers");
+        std::vector<std::size_t> cell_counts(layers.size());
+        for (std::size_t layer = 0; layer < layers.size(); ++layer) {
+            cell_counts[layer] = layers[layer]->gids_.size();
         }
-        // 准备 TileInfo Vector (瓦片数量 = 地图宽度 * 地图高度)
-        std::vector<entt::entity> tiles;
 
-        tiles.reserve(static_cast<size_t>(layer_map_size.x) * static_cast<size_t>(layer_map_size.y));
+        // 工作线程：收集每段内出现过的不同 gid（流式解析已把格子读入 gid 缓冲）
+        const auto chunks = splitCells(cell_counts, RESOLVE_CHUNK_CELLS);
+        std::vector<std::vector<int>> chunk_gids(chunks.size());
+        runChunks(scene_->getContext().getJobSystem(), chunks.size(), [&](std::size_t c) {
+            const auto& chunk = chunks[c];
+            const auto& layer_gids = layers[chunk.layer_]->gids_;
+            auto& distinct = chunk_gids[c];
+            for (auto index = chunk.begin_; index < chunk.end_; ++index) {
+                const int gid = layer_gids[index];
+                if (gid != 0) {
+                    distinct.push_back(gid);
+                }
+            }
+            std::ranges::sort(distinct);
+            distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+        });
+
+        // 主线程：收录瓦片（不同 gid 通常只有几十个；解析会写入 tileset 共享的 resolved_ 缓存）
+        for (const auto& distinct : chunk_gids) {
+            for (const int gid : distinct) {
+                internTile(gid);
+            }
+        }
 
-        // 获取图层数据 (瓦片 ID 列表)
-        const auto& data = layer_json["data"];
-        size_t index = 0; // 用于跟踪当前瓦片在图层中的位置（从0开始）
-        // 根据gid获取必要信息，并依次填充 TileInfo Vector
-        for (const auto& gid : data) {
+        // 此后 tile_ids_ 与 tile_table_ 只读，分类可以并行
+        return classifyTileLayers(cell_counts, [&](std::size_t layer, std::size_t index) -> std::uint32_t {
+            const int gid = layers[layer]->gids_[index];
             if (gid == 0) {
-                index++;
-                tiles.push_back(entt::null);
-                continue;
+                return NO_TILE;
             }
+            const auto it = tile_ids_.find(gid);
+            return it == tile_ids_.end() ? NO_TILE : it->second;
+        });
+    }
 
-            auto tile_info = getTileInfoByGid(gid);
+    template <typename CellOf>
+    std::vector<LevelLoader::TileLayerRecords> LevelLoader::classifyTileLayers(std::span<const std::size_t> cell_counts, CellOf&& cell_of)
+    {
+        ENGINE_PROFILE_SCOPE("LevelLoader::classifyTileLayers");
+        const auto chunks = splitCells(cell_counts, RESOLVE_CHUNK_CELLS);
+        std::vector<TileLayerRecords> chunk_records(chunks.size());
+        runChunks(scene_->getContext().getJobSystem(), chunks.size(), [&](std::size_t c) {
+            const auto& chunk = chunks[c];
+            auto& records = chunk_records[c];
+            for (auto index = chunk.begin_; index < chunk.end_; ++index) {
+                const std::uint32_t tile_id = cell_of(chunk.layer_, index);
+                if (tile_id == NO_TILE) {
+                    continue;
+                }
+                // 静态瓦片（无动画、无自定义属性）进入烘焙路径，其余仍创建实体
+                const auto& tile_info = tile_table_[tile_id];
+                auto& target = tile_baking_enabled_ && !tile_info.animation_ && !tile_info.properties_ ? records.baked_ : records.spawned_;
+                target.push_back(BakedTile{static_cast<int>(index), tile_id});
+            }
+        });
 
-            if (tile_info.type_ == engine::component::TileType::EMPTY &&
-                tile_info.sprite_.texture_id_ == entt::null &&
-                tile_info.sprite_.texture_path_.empty()) {
-                index++;
-                tiles.push_back(entt::null);
+        // 按段顺序拼接，结果与串行逐格解析相同
+        std::vector<TileLayerRecords> layers(cell_counts.size());
+        for (std::size_t layer = 0; layer < cell_counts.size(); ++layer) {
+            layers[layer].cell_count_ = cell_counts[layer];
+        }
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+            auto& layer = layers[chunks[c].layer_];
+            const auto& records = chunk_records[c];
+            layer.baked_.insert(layer.baked_.end(), records.baked_.begin(), records.baked_.end());
+            layer.spawned_.insert(layer.spawned_.end(), records.spawned_.begin(), records.spawned_.end());
+        }
+        return layers;
+    }
+
+    std::vector<engine::component::TileChunk> LevelLoader::bakeTileChunks(const std::string& layer_name,
+                                                                          glm::ivec2 layer_map_size,
+                                                                          const std::vector<BakedTile>& baked_tiles)
+    {
+        std::vector<engine::component::TileChunk> chunks;
+        if (baked_tiles.empty()) {
+            return chunks;
+        }
+
+        // 按区块对瓦片分桶（保持行优先顺序，与逐实体绘制时的Y排序一致）
+        const glm::ivec2 chunk_count((layer_map_size.x + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE,
+                                     (layer_map_size.y + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE);
+        std::vector<std::vector<BakedTile>> buckets(static_cast<size_t>(chunk_count.x) * static_cast<size_t>(chunk_count.y));
+        for (const auto& tile : baked_tiles) {
+            const int cx = (tile.index_ % layer_map_size.x) / TILE_CHUNK_SIZE;
+            const int cy = (tile.index_ / layer_map_size.x) / TILE_CHUNK_SIZE;
+            buckets[static_cast<size_t>(cy) * chunk_count.x + cx].push_back(tile);
+        }
+
+        for (int cy = 0; cy < chunk_count.y; ++cy) {
+            for (int cx = 0; cx < chunk_count.x; ++cx) {
+                const auto& bucket = buckets[static_cast<size_t>(cy) * chunk_count.x + cx];
+                if (bucket.empty()) {
+                    continue;
+                }
+                auto chunk = bakeChunk(layer_name, layer_map_size, glm::ivec2(cx, cy), bucket);
+                if (!chunk) {
+                    continue;
+                }
+                // 区块纹理归场景所有，离开场景后卸载（否则每张地图的区块都会一直驻留）
+                scene_->getResources().acquireTexture(chunk->texture_id_);
+                chunks.push_back(*chunk);
+            }
+        }
+
+        spdlog::info("图层 '{}' 烘焙完成：{} 个静态瓦片 -> {} 个区块", layer_name, baked_tiles.size(), chunks.size());
+        return chunks;
+    }
+
+    std::optional<engine::component::TileChunk> LevelLoader::bakeChunk(const std::string& layer_name, glm::ivec2 layer_map_size,
+                                                                      glm::ivec2 chunk_coord, std::span<const BakedTile> tiles)
+    {
+        auto& context = scene_->getContext();
+        auto& renderer = context.getRenderer();
+        auto& resource_manager = context.getResourceManager();
+        auto& registry = scene_->getRegistry();
+
+        // 区块范围取其中所有瓦片矩形的并集（超出网格的大尺寸瓦片也能完整烘焙）
+        glm::vec2 min_pos(std::numeric_limits<float>::max());
+        glm::vec2 max_pos(std::numeric_limits<float>::lowest());
+        for (const auto& tile : tiles) {
+            const glm::vec2 pos((tile.index_ % layer_map_size.x) * tile_size_.x,
+                                (tile.index_ / layer_map_size.x) * tile_size_.y);
+            min_pos = glm::min(min_pos, pos);
+            max_pos = glm::max(max_pos, pos + tile_table_[tile.tile_].sprite_.src_rect_.size);
+        }
+        const glm::ivec2 texture_size(static_cast<int>(std::ceil(max_pos.x - min_pos.x)),
+                                      static_cast<int>(std::ceil(max_pos.y - min_pos.y)));
+
+        const auto chunk_key = map_path_ + "#" + layer_name + "#" + std::to_string(chunk_coord.x) + "_" + std::to_string(chunk_coord.y);
+        const auto texture_id = engine::resource::toResourceId(chunk_key);
+        auto* texture = resource_manager.createRenderTarget(texture_id, texture_size);
+        if (!texture || !renderer.beginRenderToTexture(texture)) {
+            spdlog::error("图层 '{}' 区块 ({}, {}) 烘焙失败", layer_name, chunk_coord.x, chunk_coord.y);
+            return std::nullopt;
+        }
+        for (const auto& tile : tiles) {
+            const glm::vec2 pos((tile.index_ % layer_map_size.x) * tile_size_.x,
+                                (tile.index_ / layer_map_size.x) * tile_size_.y);
+            const auto& sprite = tile_table_[tile.tile_].sprite_;
+            renderer.drawSpriteToTarget(sprite, pos - min_pos, sprite.src_rect_.size);
+        }
+        renderer.endRenderToTexture();
+
+        const glm::vec2 chunk_size(texture_size);
+        auto chunk_entity = registry.create();
+        registry.emplace<engine::component::TransformComponent>(chunk_entity, min_pos);
+        registry.emplace<engine::component::SpriteComponent>(chunk_entity,
+            engine::component::Sprite(texture_id, engine::utils::Rect{0.0f, 0.0f, chunk_size.x, chunk_size.y}));
+        registry.emplace<engine::component::RenderComponent>(chunk_entity, current_layer_, 0.0f);
+
+        return engine::component::TileChunk{texture_id, chunk_coord, min_pos, chunk_size, chunk_entity};
+    }
+
+    void LevelLoader::buildStreamedTileLayer(const std::string& layer_name, glm::ivec2 layer_map_size, glm::vec2 layer_offset,
+                                             std::span<const std::uint32_t> cells)
+    {
+        ENGINE_PROFILE_SCOPE("LevelLoader::buildStreamedTileLayer");
+        if (layer_map_size.x <= 0 || layer_map_size.y <= 0 ||
+            cells.size() != static_cast<std::size_t>(layer_map_size.x) * static_cast<std::size_t>(layer_map_size.y)) {
+            spdlog::error("图层 '{}' 缺少或无效的 width/height。", layer_name);
+            return;
+        }
+
+        // 格子表覆盖整张地图（导航与建造位需要），每格一个字节；只有带自定义属性的瓦片常驻为实体
+        using engine::spatial::TileGrid;
+        std::vector<TileGrid::Cell> grid_cells(cells.size(), TileGrid::packCell(engine::component::TileType::EMPTY));
+        std::vector<TileSpawn> spawns;
+        for (std::size_t index = 0; index < cells.size(); ++index) {
+            if (cells[index] == cooked::NONE) {
                 continue;
             }
+            const auto& info = tile_table_[cells[index]];
+            const bool baked = tile_baking_enabled_ && !info.animation_ && !info.properties_;
+            const auto flags = static_cast<TileGrid::Cell>((baked ? 0 : TileGrid::ENTITY) | TileGrid::typeFlags(info.type_) |
+                                                           (info.properties_ ? TileGrid::PROPERTIES : 0));
+            grid_cells[index] = TileGrid::packCell(info.type_, flags);
+            if (info.properties_) {
+                spawns.push_back(TileSpawn{static_cast<int>(index), &info});
+            }
+        }
 
-            auto tile_entity = entity_builder_->configure(static_cast<int>(index), &tile_info)->build()->getEntityID();
-            tiles.push_back(tile_entity);
-            index++;
+        std::vector<entt::entity> tiles(cells.size(), entt::null);
+        std::vector<entt::entity> spawned(spawns.size(), entt::null);
+        entity_builder_->buildTiles(spawns, spawned);
+        for (std::size_t i = 0; i < spawned.size(); ++i) {
+            tiles[static_cast<std::size_t>(spawns[i].index_)] = spawned[i];
         }
 
-        // 添加 TileLayerComponent
-        registry.emplace<engine::component::TileLayerComponent>(entity, tile_size_, layer_map_size, std::move(tiles));
-        
-        // 可选：添加 TransformComponent 处理图层偏移
-        glm::vec2 layer_offset(layer_json.value("offsetx", 0.0f), layer_json.value("offsety", 0.0f));
+        auto& registry = scene_->getRegistry();
+        auto entity = registry.create();
+        registry.emplace<engine::component::NameComponent>(entity, entt::hashed_string(layer_name.c_str()), layer_name);
+        registry.emplace<engine::component::TileLayerComponent>(entity, tile_size_, layer_map_size, std::move(tiles),
+                                                                std::vector<engine::component::TileChunk>{}, std::move(grid_cells));
         registry.emplace<engine::component::TransformComponent>(entity, layer_offset);
-        
-        spdlog::info("图层 '{}' 加载完成 ({}x{})", layer_name, layer_map_size.x, layer_map_size.y);
+
+        StreamedLayer layer;
+        layer.entity_ = entity;
+        layer.name_ = layer_name;
+        layer.render_layer_ = current_layer_;
+        layer.map_size_ = layer_map_size;
+        layer.cells_ = cells;
+        layer.chunk_count_ = glm::ivec2((layer_map_size.x + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE,
+                                        (layer_map_size.y + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE);
+        layer.chunks_.resize(static_cast<std::size_t>(layer.chunk_count_.x) * static_cast<std::size_t>(layer.chunk_count_.y));
+        streamed_layers_.push_back(std::move(layer));
+
+        spdlog::info("图层 '{}' 按区块流式加载 ({}x{}，{} 个常驻瓦片实体)", layer_name, layer_map_size.x, layer_map_size.y, spawns.size());
+    }
+
+    void LevelLoader::updateStreaming(const engine::utils::Rect& view)
+    {
+        if (streamed_layers_.empty()) {
+            return;
+        }
+        ENGINE_PROFILE_SCOPE("LevelLoader::updateStreaming");
+        const glm::vec2 chunk_extent(tile_size_ * TILE_CHUNK_SIZE);
+        if (chunk_extent.x <= 0.0f || chunk_extent.y <= 0.0f) {
+            return;
+        }
+        // 视野外扩 margin 后覆盖的区块范围 [first, last)
+        auto chunk_range = [&](const StreamedLayer& layer, float margin) {
+            const glm::ivec2 first(glm::floor((view.position - margin) / chunk_extent));
+            const glm::ivec2 last = glm::ivec2(glm::floor((view.position + view.size + margin) / chunk_extent)) + 1;
+            return std::pair{ glm::clamp(first, glm::ivec2(0), layer.chunk_count_), glm::clamp(last, glm::ivec2(0), layer.chunk_count_) };
+        };
+
+        int budget = STREAMING_CHUNKS_PER_UPDATE;
+        for (auto& layer : streamed_layers_) {
+            // 释放：远离视野的驻留区块（倒序遍历，streamOutChunk 从 resident_ 中交换删除）
+            const auto [keep_first, keep_last] = chunk_range(layer, STREAMING_UNLOAD_MARGIN);
+            for (auto i = layer.resident_.size(); i-- > 0;) {
+                const auto chunk_index = layer.resident_[i];
+                const glm::ivec2 coord(static_cast<int>(chunk_index) % layer.chunk_count_.x,
+                                       static_cast<int>(chunk_index) / layer.chunk_count_.x);
+                if (glm::any(glm::lessThan(coord, keep_first)) || glm::any(glm::greaterThanEqual(coord, keep_last))) {
+                    streamOutChunk(layer, chunk_index);
+                }
+            }
+
+            // 载入：视野内的区块全部载入，外扩范围内的按预算载入
+            for (const float margin : { 0.0f, STREAMING_LOAD_MARGIN }) {
+                const auto [first, last] = chunk_range(layer, margin);
+                for (int cy = first.y; cy < last.y; ++cy) {
+                    for (int cx = first.x; cx < last.x; ++cx) {
+                        const auto chunk_index = static_cast<std::uint32_t>(cy * layer.chunk_count_.x + cx);
+                        if (layer.chunks_[chunk_index].resident_) {
+                            continue;
+                        }
+                        if (margin > 0.0f && budget <= 0) {
+                            break;
+                        }
+                        streamInChunk(layer, chunk_index);
+                        if (margin > 0.0f) {
+                            --budget;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void LevelLoader::streamInChunk(StreamedLayer& layer, std::uint32_t chunk_index)
+    {
+        auto& chunk = layer.chunks_[chunk_index];
+        const glm::ivec2 coord(static_cast<int>(chunk_index) % layer.chunk_count_.x,
+                               static_cast<int>(chunk_index) / layer.chunk_count_.x);
+        const glm::ivec2 first = coord * TILE_CHUNK_SIZE;
+        const glm::ivec2 last = glm::min(first + glm::ivec2(TILE_CHUNK_SIZE), layer.map_size_);
+
+        // 区块内的格子直接读映射内存，按与整图加载相同的规则分为烘焙瓦片与装饰瓦片（带自定义属性的已常驻）
+        std::vector<BakedTile> baked;
+        std::vector<TileSpawn> spawns;
+        for (int y = first.y; y < last.y; ++y) {
+            for (int x = first.x; x < last.x; ++x) {
+                const int index = y * layer.map_size_.x + x;
+                const auto tile_id = layer.cells_[static_cast<std::size_t>(index)];
+                if (tile_id == cooked::NONE) {
+                    continue;
+                }
+                const auto& info = tile_table_[tile_id];
+                if (info.properties_) {
+                    continue;
+                }
+                if (tile_baking_enabled_ && !info.animation_) {
+                    baked.push_back(BakedTile{index, tile_id});
+                } else {
+                    spawns.push_back(TileSpawn{index, &info});
+                }
+            }
+        }
+
+        // 构建器按 current_layer_ 写入渲染层级
+        const int saved_layer = current_layer_;
+        current_layer_ = layer.render_layer_;
+        auto& registry = scene_->getRegistry();
+        auto& layer_component = registry.get<engine::component::TileLayerComponent>(layer.entity_);
+        if (!baked.empty()) {
+            if (const auto baked_chunk = bakeChunk(layer.name_, layer.map_size_, coord, baked)) {
+                chunk.texture_ = scene_->getContext().getResourceManager().acquireTexture(baked_chunk->texture_id_);
+                layer_component.chunks_.push_back(*baked_chunk);
+            }
+        }
+        std::vector<entt::entity> spawned(spawns.size(), entt::null);
+        entity_builder_->buildTiles(spawns, spawned);
+        for (std::size_t i = 0; i < spawns.size(); ++i) {
+            layer_component.tiles_[static_cast<std::size_t>(spawns[i].index_)] = spawned[i];
+        }
+        current_layer_ = saved_layer;
+
+        chunk.resident_ = true;
+        layer.resident_.push_back(chunk_index);
+    }
+
+    void LevelLoader::streamOutChunk(StreamedLayer& layer, std::uint32_t chunk_index)
+    {
+        auto& chunk = layer.chunks_[chunk_index];
+        const glm::ivec2 coord(static_cast<int>(chunk_index) % layer.chunk_count_.x,
+                               static_cast<int>(chunk_index) / layer.chunk_count_.x);
+        auto& registry = scene_->getRegistry();
+        auto& layer_component = registry.get<engine::component::TileLayerComponent>(layer.entity_);
+
+        auto& chunks = layer_component.chunks_;
+        if (const auto it = std::ranges::find(chunks, coord, &engine::component::TileChunk::chunk_coord_); it != chunks.end()) {
+            if (registry.valid(it->entity_)) {
+                registry.destroy(it->entity_);
+            }
+            *it = chunks.back();
+            chunks.pop_back();
+        }
+        // 装饰瓦片实体按格子查找；带自定义属性的瓦片常驻，不随区块释放
+        const glm::ivec2 first = coord * TILE_CHUNK_SIZE;
+        const glm::ivec2 last = glm::min(first + glm::ivec2(TILE_CHUNK_SIZE), layer.map_size_);
+        for (int y = first.y; y < last.y; ++y) {
+            for (int x = first.x; x < last.x; ++x) {
+                const auto index = static_cast<std::size_t>(y * layer.map_size_.x + x);
+                auto& entity = layer_component.tiles_[index];
+                if (entity == entt::null || tile_table_[layer.cells_[index]].properties_) {
+                    continue;
+                }
+                if (registry.valid(entity)) {
+                    registry.destroy(entity);
+                }
+                entity = entt::null;
+            }
+        }
+        // 纹理在引用归零后的 ResourceManager::update() 中卸载，期间重新载入会直接替换渲染目标
+        scene_->getContext().getResourceManager().release(chunk.texture_);
+        chunk = StreamedChunk{};
+
+        const auto it = std::ranges::find(layer.resident_, chunk_index);
+        *it = layer.resident_.back();
+        layer.resident_.pop_back();
+    }
+
+    void LevelLoader::resetStreaming()
+    {
+        auto& registry = scene_->getRegistry();
+        for (auto& layer : streamed_layers_) {
+            // 恢复出的注册表是存档时的状态：其中的区块实体与装饰瓦片实体都按当前视野重新载入
+            if (auto* layer_component = registry.try_get<engine::component::TileLayerComponent>(layer.entity_)) {
+                for (const auto& chunk : layer_component->chunks_) {
+                    if (registry.valid(chunk.entity_)) {
+                        registry.destroy(chunk.entity_);
+                    }
+                }
+                layer_component->chunks_.clear();
+                for (std::size_t index = 0; index < layer_component->tiles_.size(); ++index) {
+                    auto& entity = layer_component->tiles_[index];
+                    if (entity != entt::null && !tile_table_[layer.cells_[index]].properties_) {
+                        if (registry.valid(entity)) {
+                            registry.destroy(entity);
+                        }
+                        entity = entt::null;
+                    }
+                }
+            }
+            auto& resource_manager = scene_->getContext().getResourceManager();
+            for (auto& chunk : layer.chunks_) {
+                resource_manager.release(chunk.texture_);
+                chunk = StreamedChunk{};
+            }
+            layer.resident_.clear();
+        }
+    }
+
+    void LevelLoader::releaseStreaming()
+    {
+        if (!streamed_layers_.empty()) {
+            auto& resource_manager = scene_->getContext().getResourceManager();
+            for (const auto& layer : streamed_layers_) {
+                for (const auto& chunk : layer.chunks_) {
+                    resource_manager.release(chunk.texture_);
+                }
+            }
+        }
+        streamed_layers_.clear();
+        streamed_level_.reset();
     }
 
     void LevelLoader::loadObjectLayer(const nlohmann::json& layer_json)
     {
+        ENGINE_PROFILE_SCOPE("LevelLoader::loadObjectLayer");
         if (!layer_json.contains("objects") || !layer_json["objects"].is_array()) {
             spdlog::error("对象图层 '{}' 缺少 'objects' 属性。", layer_json.value("name", "Unnamed"));
             return;
         }
 
+        loadObjects(layer_json["objects"], layer_json.value("name", "Unnamed"));
+    }
+
+    void LevelLoader::loadObjects(const nlohmann::json& objects, const std::string& layer_name)
+    {
         if (!entity_builder_) {
             spdlog::error("实体生成器未初始化，无法加载对象图层。");
             return;
         }
 
-        const auto& objects = layer_json["objects"];
         for (const auto& object : objects) {
             if (!object.value("visible", true)) {
                 continue;
@@ -291,19 +1196,17 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
                 continue;
             }
 
-            auto tile_info = getTileInfoByGid(gid);
-            if (tile_info.type_ == engine::component::TileType::EMPTY &&
-                tile_info.sprite_.texture_id_ == entt::null &&
-                tile_info.sprite_.texture_path_.empty()) {
-                spdlog::warn("对象图层 '{}' 中 gid 为 {} 的瓦片无效，已跳过。", layer_json.value("name", "Unnamed"), gid);
+            const auto tile_id = internTile(gid);
+            if (tile_id == NO_TILE) {
+                spdlog::warn("对象图层 '{}' 中 gid 为 {} 的瓦片无效，已跳过。", layer_name, gid);
                 continue;
             }
 
-            entity_builder_->configure(&object, &tile_info)->build();
+            entity_builder_->configure(&object, &tile_table_[tile_id])->build();
         }
-    } 
-    
-    const nlohmann::json* LevelLoader::findTileset(int gid)
+    }
+
+    const TilesetData* LevelLoader::findTileset(int gid)
     {
         // 清除GID的最高三位（翻转信息），得到原始GID值
         const int FLIP_MASK = 0x1FFFFFFF;
@@ -325,7 +1228,7 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
         auto current_it = std::prev(it);
         cache_.first_gid = current_it->first;
         cache_.next_first_gid = (it == tileset_data_.end()) ? -1 : it->first;
-        cache_.data = &current_it->second;
+        cache_.data = current_it->second.get();
 
         return cache_.data;
     }
@@ -339,14 +1242,35 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
         const int FLIP_MASK = 0x1FFFFFFF;
         int original_gid = gid & FLIP_MASK;
 
-        const nlohmann::json* tileset_ptr = findTileset(original_gid);
+        const TilesetData* tileset_ptr = findTileset(original_gid);
         if (!tileset_ptr) {
             if (original_gid != 0) spdlog::warn("gid为 {} 的瓦片未找到图块集。", original_gid);
             return make_empty_data();
         }
 
-        const auto& tileset = *tileset_ptr;
-        auto local_id = original_gid - cache_.first_gid;
+        // 解析结果随 tileset 一起共享：同一瓦片在图层内、跨关卡、重新开始时都只解析一次
+        const auto local_id = original_gid - cache_.first_gid;
+        if (local_id < 0) {
+            return make_empty_data();
+        }
+        auto& resolved = tileset_ptr->resolved_;
+        const auto slot = static_cast<std::size_t>(local_id);
+        if (slot < resolved.size() && resolved[slot]) {
+            return *resolved[slot];
+        }
+        TileData data = resolveTileData(tileset_ptr->json_, local_id);
+        if (slot >= resolved.size()) {
+            resolved.resize(slot + 1);
+        }
+        resolved[slot] = data;
+        return data;
+    }
+
+    TileData LevelLoader::resolveTileData(const nlohmann::json& tileset, int local_id)
+    {
+        auto make_empty_data = []() {
+            return TileData{ engine::component::TileInfo(engine::component::Sprite(), engine::component::TileType::EMPTY), nullptr };
+        };
         const std::string file_path = tileset.value("file_path", "");
 
         if (tileset.contains("image")) {
@@ -455,8 +1379,64 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
         return make_empty_data();
     }
 
+    std::uint32_t LevelLoader::internTile(int gid)
+    {
+        if (cooked_) {
+            // 预编译瓦片表已在烘焙时去重，格子直接引用其索引
+            const auto index = cooked_->findTile(static_cast<std::uint32_t>(gid));
+            return index == cooked::NONE ? NO_TILE : index;
+        }
+
+        auto [it, inserted] = tile_ids_.try_emplace(gid, NO_TILE);
+        if (!inserted) {
+            return it->second;
+        }
+        auto tile_info = getTileInfoByGid(gid);
+        if (tile_info.type_ == engine::component::TileType::EMPTY &&
+            tile_info.sprite_.texture_id_ == entt::null &&
+            tile_info.sprite_.getTexturePath().empty()) {
+            return NO_TILE;     // 空结果同样记住，无效 gid 也只解析一次
+        }
+        it->second = static_cast<std::uint32_t>(tile_table_.size());
+        tile_table_.push_back(std::move(tile_info));
+        return it->second;
+    }
+
+    std::uint32_t LevelLoader::tileClockFor(const engine::component::TileInfo& tile_info)
+    {
+        auto& ctx = scene_->getRegistry().ctx();
+        if (!ctx.contains<engine::component::TileAnimationClocks>()) {
+            ctx.emplace<engine::component::TileAnimationClocks>();
+        }
+        auto& clocks = ctx.get<engine::component::TileAnimationClocks>();
+
+        // 自定义构建器可能传入瓦片表以外的 TileInfo，指针比较用 std::less 保证全序
+        const auto* begin = tile_table_.data();
+        const std::less<const engine::component::TileInfo*> before;
+        if (before(&tile_info, begin) || !before(&tile_info, begin + tile_table_.size())) {
+            return clocks.add(*tile_info.animation_);
+        }
+        const auto index = static_cast<std::size_t>(&tile_info - begin);
+        if (tile_clocks_.size() < tile_table_.size()) {
+            tile_clocks_.resize(tile_table_.size(), NO_TILE);
+        }
+        if (tile_clocks_[index] == NO_TILE) {
+            tile_clocks_[index] = clocks.add(*tile_info.animation_);
+        }
+        return tile_clocks_[index];
+    }
+
     engine::component::TileInfo LevelLoader::getTileInfoByGid(int gid)
     {
+        if (cooked_) {
+            // 预编译瓦片表按含翻转位的原始 gid 收录，翻转已在烘焙时解析
+            const auto index = cooked_->findTile(static_cast<std::uint32_t>(gid));
+            if (index == cooked::NONE) {
+                return engine::component::TileInfo(engine::component::Sprite(), engine::component::TileType::EMPTY);
+            }
+            return tile_table_[index];
+        }
+
         auto data = getTileDataByGid(gid);
         
         // 处理翻转信息 (Tiled 使用 GID 的高位存储翻转)
@@ -472,38 +1452,20 @@ bool LevelLoader::applyLevelData(const LevelLoadData& level_data, engine::scene:
 
     void LevelLoader::loadTileset(const std::string& tileset_path, int first_gid)
     {
-        std::ifstream tileset_file(tileset_path);
-        if (!tileset_file.is_open()) {
-            spdlog::error("无法打开 Tileset 文件: {}", tileset_path);
-            return;
-        }
-
-        nlohmann::json ts_json;
-        try {
-            tileset_file >> ts_json;
-        }
-        catch (const nlohmann::json::parse_error& e) {
-            spdlog::error("解析 Tileset JSON 文件 '{}' 失败: {} (at byte {})", tileset_path, e.what(), e.byte);
+        std::string error_message;
+        auto tileset = readTileset(tileset_path, error_message);
+        if (!tileset) {
+            spdlog::error("加载 Tileset 失败: {}", error_message);
             return;
         }
-        ts_json["file_path"] = tileset_path;    // 将文件路径存储到json中，后续解析图片路径时需要
-        tileset_data_[first_gid] = std::move(ts_json);
+        tileset_data_[first_gid] = std::move(tileset);
         spdlog::info("Tileset 文件 '{}' 加载完成，firstgid: {}", tileset_path, first_gid);
     }
 
     std::string LevelLoader::resolvePath(const std::string& relative_path, const std::string& file_path)
     {
-        try {
-            // 获取地图文件的父目录（相对于可执行文件） "assets/maps/level1.tmj" -> "assets/maps"
-            auto map_dir = std::filesystem::path(file_path).parent_path();
-            // 合并路径（相对于可执行文件）并返回。
-            auto final_path = std::filesystem::canonical(map_dir / relative_path);
-            return final_path.string();
-        }
-        catch (const std::exception& e) {
-            spdlog::error("解析路径失败: {}", e.what());
-            return relative_path;
-        }
+        // 以地图文件的父目录为基准（"assets/maps/level1.tmj" -> "assets/maps"），文件仅在资源包中时按词法规范化
+        return resolvePathForFile(relative_path, file_path);
     }
 
     engine::component::TileType LevelLoader::getTileType(const nlohmann::json& tile_json)
@@ -2,16 +2,22 @@
 #include <string>
 #include <glm/vec2.hpp>
 #include <nlohmann/json.hpp>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <optional>
 #include <future>
+#include <span>
+#include <unordered_map>
 #include <vector>
 
 
 #include "../utils/math.h"
+#include "../core/task_pool.h"
 #include "../component/tilelayer_component.h"
+#include "../resource/resource_handle.h"
 #include "basic_entity_builder.h"
+#include "tiled_map_reader.h"
 namespace engine::component {
     struct TileInfo;
     enum class TileType;
@@ -24,6 +30,12 @@ namespace engine::object {
 namespace engine::scene {
     class Scene;
 }
+namespace engine::loader::cooked {
+    class CookedLevel;
+}
+namespace engine::core {
+    class ContentCache;
+}
 
 namespace engine::loader {
     /**
@@ -35,16 +47,33 @@ namespace engine::loader {
         const nlohmann::json* json_ptr = nullptr; ///< 指向 tileset 中该瓦片 JSON 对象的指针
     };
 
+    /**
+     * @brief 解析后的 tileset：JSON 只读，可经 ContentCache 在多个关卡与重新开始之间共享。
+     * @details resolved_ 按本地 ID 缓存解析出的 TileData（省去 tiles 数组线性查找与路径规范化），
+     *          只在主线程应用关卡时惰性填充。
+     */
+    struct TilesetData {
+        nlohmann::json json_;
+        mutable std::vector<std::optional<TileData>> resolved_;
+    };
+
     struct ParsedTileset {
         int first_gid = -1;
         std::string file_path;
-        nlohmann::json json_data;
+        std::shared_ptr<const TilesetData> data;
     };
 
+    /**
+     * @brief 关卡解析结果。
+     * 命中有效的预编译关卡（.mwl）时只设置 cooked_，level_json 与 tilesets 为空；否则为 JSON 解析结果。
+     * 地图经 readTiledMap 流式解析：瓦片图层的 data 数组在 layer_cells_ 中，不在 level_json 里。
+     */
     struct LevelLoadData {
         std::string level_path;
         nlohmann::json level_json;
+        std::vector<TileLayerCells> layer_cells_;   ///< 与 level_json["layers"] 一一对应的格子 gid
         std::vector<ParsedTileset> tilesets;
+        std::shared_ptr<const cooked::CookedLevel> cooked_;    ///< 已映射的预编译关卡（可为空）
         bool valid_ = false;
         std::string error_message;
     };
@@ -61,15 +90,68 @@ namespace engine::loader {
         std::string map_path_;      ///< 地图文件所在的目录路径（用于解析相对路径）
         glm::ivec2 map_size_;       ///< 地图的总尺寸（以瓦片为单位，x为宽，y为高）
         glm::ivec2 tile_size_;      ///< 单个瓦片的标准尺寸（像素）
-        std::map<int, nlohmann::json> tileset_data_;    ///< 已加载的瓦片集数据缓存，Key 为 firstgid
+        std::map<int, std::shared_ptr<const TilesetData>> tileset_data_;    ///< 当前关卡引用的瓦片集，Key 为 firstgid
         std::unique_ptr<BasicEntityBuilder> entity_builder_;  ///< 实体构建器，用于创建瓦片实体并添加组件
         struct TilesetCache {
             int first_gid = -1;
             int next_first_gid = -1;
-            const nlohmann::json* data = nullptr;
+            const TilesetData* data = nullptr;
         } cache_;
 
+        const cooked::CookedLevel* cooked_{nullptr};    ///< 正在应用的预编译关卡（JSON 路径为空）
+        /// 关卡瓦片表：每个不同的 gid 只解析一次，逐格瓦片与对象按索引引用。预编译关卡时与 TileRecord 一一对应
+        std::vector<engine::component::TileInfo> tile_table_;
+        std::unordered_map<int, std::uint32_t> tile_ids_;   ///< JSON 路径：含翻转位的 gid -> tile_table_ 索引（NO_TILE 表示空瓦片）
+        std::vector<std::uint32_t> tile_clocks_;            ///< tile_table_ 索引 -> TileAnimationClocks 下标（NO_TILE 表示尚未创建）
+
+        static constexpr std::uint32_t NO_TILE = UINT32_MAX;    ///< 空瓦片 / 无效 gid
+
         int current_layer_{0};  ///< 当前图层的渲染顺序索引
+        bool tile_baking_enabled_{true};    ///< 是否将静态瓦片烘焙为区块纹理
+
+        static constexpr int TILE_CHUNK_SIZE = 16;  ///< 每个烘焙区块的边长（以瓦片为单位）
+
+        static constexpr std::size_t RESOLVE_CHUNK_CELLS = 4096;   ///< 解析阶段每个任务处理的格子数
+
+        static constexpr std::size_t STREAMING_MIN_CELLS = 64 * 64;    ///< 瓦片图层格子数达到此值时流式加载（level1/2 为 25x19）
+        static constexpr float STREAMING_LOAD_MARGIN = 512.0f;          ///< 视野外扩该距离（像素）内的区块需要驻留，与 RenderSystem 的粗剔除一致
+        static constexpr float STREAMING_UNLOAD_MARGIN = 1536.0f;       ///< 视野外扩该距离之外的区块才释放，来回移动时不反复烘焙
+        static constexpr int STREAMING_CHUNKS_PER_UPDATE = 4;           ///< 每次更新最多载入的视野外区块数（视野内的区块总是立即载入）
+
+        /// 一个非空格子（图层内索引 + 瓦片表索引），烘焙与建实体两条路径共用
+        struct BakedTile {
+            int index_{0};
+            std::uint32_t tile_{0};
+        };
+
+        /// 瓦片图层的扁平解析结果：解析阶段在工作线程上生成，创建阶段在主线程上批量建实体
+        struct TileLayerRecords {
+            std::size_t cell_count_{0};         ///< 格子总数（含空格）
+            std::vector<BakedTile> baked_;      ///< 进入烘焙路径的静态瓦片（行优先）
+            std::vector<BakedTile> spawned_;    ///< 需要创建实体的瓦片（行优先）
+        };
+
+        /// 流式图层的一个区块；驻留时装饰瓦片（无自定义属性）的实体记在 TileLayerComponent::tiles_ 中
+        struct StreamedChunk {
+            bool resident_{false};
+            engine::resource::TextureHandle texture_;   ///< 区块纹理的引用（区块内没有静态瓦片时为空）
+        };
+
+        /// 流式瓦片图层：格子直接读映射内存，区块按视野烘焙与释放
+        struct StreamedLayer {
+            entt::entity entity_{entt::null};           ///< 持有 TileLayerComponent 的图层实体
+            std::string name_;
+            int render_layer_{0};
+            glm::ivec2 map_size_{0};
+            std::span<const std::uint32_t> cells_;      ///< 预编译关卡中的格子（瓦片表下标，cooked::NONE 为空格）
+            glm::ivec2 chunk_count_{0};
+            std::vector<StreamedChunk> chunks_;         ///< 按 cy * chunk_count_.x + cx 排列
+            std::vector<std::uint32_t> resident_;       ///< 驻留区块的下标
+        };
+
+        std::shared_ptr<const cooked::CookedLevel> streamed_level_;    ///< 流式图层格子所在的映射，随加载器存活
+        std::vector<StreamedLayer> streamed_layers_;
+        bool tile_streaming_enabled_{true};     ///< 是否对大地图的瓦片图层流式加载
     public:
         LevelLoader() = default;
         ~LevelLoader();
@@ -77,6 +159,39 @@ namespace engine::loader {
         glm::ivec2 getMapSize() const { return map_size_; }
         glm::ivec2 getTileSize() const { return tile_size_; }
 
+        /**
+         * @brief 设置是否启用静态瓦片烘焙。
+         * @param enabled true 时无动画、无自定义属性的瓦片会被烘焙进区块纹理，不再创建单独实体。
+         */
+        void setTileBakingEnabled(bool enabled) { tile_baking_enabled_ = enabled; }
+        bool isTileBakingEnabled() const { return tile_baking_enabled_; }
+
+        /**
+         * @brief 设置是否对大地图启用瓦片流式加载（只对预编译关卡生效，格子直接读映射的 .mwl）。
+         * @param enabled true 时格子数不少于 STREAMING_MIN_CELLS 的瓦片图层按区块流式加载：区块纹理与装饰瓦片
+         *                （无自定义属性）的实体只在相机附近时存在；带自定义属性的瓦片（建造位等）仍在加载时全部创建，
+         *                格子表（TileGrid）覆盖整张地图。
+         */
+        void setTileStreamingEnabled(bool enabled) { tile_streaming_enabled_ = enabled; }
+        bool isTileStreamingEnabled() const { return tile_streaming_enabled_; }
+
+        /// @brief 当前关卡是否有流式瓦片图层；有时加载器须随场景存活，并每帧调用 updateStreaming()
+        bool isStreaming() const { return !streamed_layers_.empty(); }
+
+        /**
+         * @brief 按视野载入与释放流式区块。
+         * @param view 相机视野（世界坐标）。视野内的区块立即载入，外扩 STREAMING_LOAD_MARGIN 内的区块每次最多载入
+         *             STREAMING_CHUNKS_PER_UPDATE 个，外扩 STREAMING_UNLOAD_MARGIN 之外的区块释放。
+         * @note 会烘焙渲染目标并创建/销毁实体，须在渲染阶段之外调用。
+         */
+        void updateStreaming(const engine::utils::Rect& view);
+
+        /**
+         * @brief 注册表整体恢复（回溯存档点）后调用：销毁恢复出的流式实体、释放全部区块纹理引用，
+         *        之后的 updateStreaming() 按当前视野重新载入。
+         */
+        void resetStreaming();
+
         /**
          * @brief 加载关卡数据到指定的 Scene 对象中。
          * @param map_path Tiled JSON 地图文件的完整路径。
@@ -86,11 +201,35 @@ namespace engine::loader {
         [[nodiscard]]bool loadLevel(const std::string& map_path, engine::scene::Scene* scene);
 
         /**
-         * @brief 异步读取并解析关卡文件与 tileset 文件。
+         * @brief 在调用线程上读取并解析关卡文件与 tileset 文件。
          * @param map_path Tiled JSON 地图文件的完整路径。
+         * @param prefer_cooked 为 true 时优先映射同目录下未过期的 .mwl 预编译关卡，失败再回退到 JSON。
+         * @param content_cache 非空时 tileset 经由该缓存按路径共享（修改时间变化时重新解析）。
+         * @return 关卡解析结果。
+         */
+        [[nodiscard]] static LevelLoadData loadLevelData(const std::string& map_path, bool prefer_cooked = true,
+                                                         engine::core::ContentCache* content_cache = nullptr);
+
+        /**
+         * @brief 异步读取并解析关卡文件与 tileset 文件（见 loadLevelData）。
+         * @param content_cache 非空时调用方需保证其存活到任务结束。
+         * @param task_pool 非空时提交到该线程池，否则退回 std::async（无头模拟与命令行工具）。
+         * @param priority 提交到线程池时的优先级：进入场景时等待结果用 FRAME，预取用 BACKGROUND。
          * @return future 关卡解析结果。
          */
-        [[nodiscard]] static std::future<LevelLoadData> loadLevelDataAsync(const std::string& map_path);
+        [[nodiscard]] static std::future<LevelLoadData> loadLevelDataAsync(const std::string& map_path, bool prefer_cooked = true,
+                                                                           engine::core::ContentCache* content_cache = nullptr,
+                                                                           engine::core::TaskPool* task_pool = nullptr,
+                                                                           engine::core::TaskPriority priority = engine::core::TaskPriority::BACKGROUND);
+
+        /**
+         * @brief 将 Tiled 地图及其 tileset 预编译为 .mwl 二进制关卡。
+         * @param map_path Tiled JSON 地图文件路径。
+         * @param output_path 输出路径，为空时写到地图同目录同名的 .mwl。
+         * @param error_message 失败原因。
+         * @return bool 写入成功返回 true。
+         */
+        [[nodiscard]] static bool cookLevel(const std::string& map_path, const std::string& output_path, std::string& error_message);
 
         /**
          * @brief 将已经解析好的关卡数据应用到场景中。
@@ -109,12 +248,62 @@ namespace engine::loader {
         }
 
     private:
+        /** @brief 从预编译关卡应用全部图层（瓦片信息直接取自预解析的瓦片表）。 */
+        bool applyCookedLevel(const cooked::CookedLevel& level);
         /** @brief 解析并向场景添加图像图层（Image Layer）。 */
         void loadImageLayer(const nlohmann::json& layer_json);
-        /** @brief 解析并向场景添加瓦片图层（Tile Layer），包括处理每个瓦片的渲染数据。 */
-        void loadTileLayer(const nlohmann::json& layer_json);
+        /** @brief 创建图像图层实体（JSON 与预编译路径共用）。 */
+        void addImageLayer(const std::string& layer_name, const std::string& texture_path,
+                           glm::vec2 offset, glm::vec2 scroll_factor, glm::bvec2 repeat);
+        /** @brief 向场景添加瓦片图层（Tile Layer），格子已由 resolveJsonTileLayers() 解析。 */
+        void loadTileLayer(const nlohmann::json& layer_json, const TileLayerCells& cells, const TileLayerRecords& records);
+        /**
+         * @brief JSON 关卡的解析阶段：并行收集各瓦片图层出现的 gid，串行收录不同的 gid，再并行分类。
+         * @param layers 按出现顺序排列的可见瓦片图层的格子（均含 data 数组）。
+         * @return 与 layers 一一对应的扁平记录。
+         */
+        std::vector<TileLayerRecords> resolveJsonTileLayers(std::span<const TileLayerCells* const> layers);
+        /**
+         * @brief 按瓦片表把各图层的格子分为烘焙瓦片与实体瓦片，按 RESOLVE_CHUNK_CELLS 分块在 JobSystem 上并行。
+         * @param cell_counts 各图层的格子数。
+         * @param cell_of 可调用对象 (size_t layer, size_t index) -> std::uint32_t，返回 tile_table_ 索引，空格返回 NO_TILE；
+         *                在工作线程上调用，只能读取。
+         */
+        template <typename CellOf>
+        std::vector<TileLayerRecords> classifyTileLayers(std::span<const std::size_t> cell_counts, CellOf&& cell_of);
+        /** @brief 创建瓦片图层实体、逐格瓦片实体（经 BasicEntityBuilder::buildTiles 批量创建）与烘焙区块（JSON 与预编译路径共用）。 */
+        void buildTileLayer(const std::string& layer_name, glm::ivec2 layer_map_size, glm::vec2 layer_offset,
+                            const TileLayerRecords& records);
+        /**
+         * @brief 将静态瓦片按区块烘焙到渲染目标纹理，并为每个区块创建一个精灵实体。
+         * @param layer_name 图层名称（用于生成区块纹理ID）。
+         * @param layer_map_size 图层网格大小。
+         * @param baked_tiles 待烘焙的瓦片列表。
+         * @return std::vector<engine::component::TileChunk> 创建的区块信息。
+         */
+        std::vector<engine::component::TileChunk> bakeTileChunks(const std::string& layer_name,
+                                                                  glm::ivec2 layer_map_size,
+                                                                  const std::vector<BakedTile>& baked_tiles);
+        /**
+         * @brief 烘焙一个区块的静态瓦片并创建绘制它的精灵实体（纹理引用由调用方持有）。
+         * @param tiles 区块内的瓦片（行优先）。
+         * @return 渲染目标创建失败时返回空。
+         */
+        std::optional<engine::component::TileChunk> bakeChunk(const std::string& layer_name, glm::ivec2 layer_map_size,
+                                                              glm::ivec2 chunk_coord, std::span<const BakedTile> tiles);
+        /** @brief 创建流式瓦片图层：图层实体、完整的格子表与带自定义属性的瓦片实体，区块留待 updateStreaming() 载入。 */
+        void buildStreamedTileLayer(const std::string& layer_name, glm::ivec2 layer_map_size, glm::vec2 layer_offset,
+                                    std::span<const std::uint32_t> cells);
+        /** @brief 载入流式区块：烘焙静态瓦片，创建装饰瓦片实体。 */
+        void streamInChunk(StreamedLayer& layer, std::uint32_t chunk_index);
+        /** @brief 释放流式区块：销毁其实体，释放纹理引用。 */
+        void streamOutChunk(StreamedLayer& layer, std::uint32_t chunk_index);
+        /** @brief 释放全部区块纹理引用并清空流式状态（不访问注册表）。 */
+        void releaseStreaming();
         /** @brief 解析并向场景添加对象图层（Object Layer），如实体生成点、触发器等。 */
         void loadObjectLayer(const nlohmann::json& layer_json);
+        /** @brief 逐个构建对象数组中的可见对象（JSON 与预编译路径共用）。 */
+        void loadObjects(const nlohmann::json& objects, const std::string& layer_name);
 
         /**
          * @brief 获取瓦片的综合数据。
@@ -123,6 +312,20 @@ namespace engine::loader {
          */
         TileData getTileDataByGid(int gid);
 
+        /**
+         * @brief 取得 gid 在关卡瓦片表中的索引，首次出现时解析并收录。
+         * @param gid 全局瓦片 ID（含翻转位）。
+         * @return std::uint32_t tile_table_ 索引；空瓦片或无效 gid 返回 NO_TILE。
+         */
+        std::uint32_t internTile(int gid);
+
+        /**
+         * @brief 取得动画瓦片的共享时钟，同一瓦片表项的首个实例创建时钟（registry 上下文中的 TileAnimationClocks）。
+         * @param tile_info 带动画的瓦片；不在瓦片表中时单独创建一个时钟。
+         * @return std::uint32_t TileAnimationClocks 下标。
+         */
+        std::uint32_t tileClockFor(const engine::component::TileInfo& tile_info);
+
         /**
          * @brief 获取瓦片的渲染信息（纹理坐标、源路径等）。
          * @param gid 全局瓦片 ID。
@@ -133,9 +336,14 @@ namespace engine::loader {
         /**
          * @brief 内部查找包含特定 GID 的 Tileset JSON 对象。
          * @param gid 全局瓦片 ID。
-         * @return const nlohmann::json* 返回对应的 tileset JSON 指针，未找到则返回 nullptr。
+         * @return const TilesetData* 返回对应的 tileset，未找到则返回 nullptr。
+         */
+        const TilesetData* findTileset(int gid);
+
+        /**
+         * @brief 解析 tileset 中本地 ID 对应的瓦片（不经过 resolved_ 缓存）。
          */
-        const nlohmann::json* findTileset(int gid);
+        TileData resolveTileData(const nlohmann::json& tileset, int local_id);
 
         /**
          * @brief 加载并解析外部 Tiled tileset 文件 (.tsj)。
@@ -0,0 +1,159 @@
+#include "tiled_map_reader.h"
+
+#include <utility>
+
+namespace engine::loader {
+
+namespace {
+
+/**
+ * @brief 构建 DOM 的 SAX 处理器，顶层 layers[i].data 数组改为写入 TileLayerCells。
+ * @details 与 nlohmann 自带的 DOM 解析器一样维护父节点栈：子节点总在下一个兄弟节点插入前完成，
+ *          栈中的指针不会因父数组扩容而失效。
+ */
+class TiledMapSax final : public nlohmann::json_sax<nlohmann::json> {
+public:
+    TiledMapSax(nlohmann::json& root, std::vector<TileLayerCells>& cells) : root_(root), cells_(cells) {}
+
+    [[nodiscard]] const std::string& getError() const { return error_; }
+
+    bool null() override { return scalar(nullptr); }
+    bool boolean(bool value) override { return scalar(value); }
+    bool number_float(number_float_t value, const string_t&) override { return scalar(value); }
+    bool string(string_t& value) override { return scalar(std::move(value)); }
+    bool binary(binary_t& value) override { return scalar(nlohmann::json::binary(std::move(value))); }
+
+    bool number_integer(number_integer_t value) override {
+        if (capture_) {
+            capture_->gids_.push_back(static_cast<std::int32_t>(value));
+            return true;
+        }
+        return scalar(value);
+    }
+
+    bool number_unsigned(number_unsigned_t value) override {
+        if (capture_) {
+            // 带翻转位的 gid 超出 int32 范围：按位保留，与 DOM 路径的 get<int>() 结果一致
+            capture_->gids_.push_back(static_cast<std::int32_t>(static_cast<std::uint32_t>(value)));
+            return true;
+        }
+        return scalar(value);
+    }
+
+    bool start_object(std::size_t) override {
+        if (capture_) {
+            return invalidCell();
+        }
+        stack_.push_back(place(nlohmann::json::value_t::object));
+        return true;
+    }
+
+    bool end_object() override {
+        stack_.pop_back();
+        return true;
+    }
+
+    bool key(string_t& value) override {
+        key_ = std::move(value);
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (capture_) {
+            return invalidCell();
+        }
+        if (isLayer() && key_ == "data") {
+            capture_ = &cells_.back();
+            capture_->present_ = true;
+            capture_->gids_.reserve(reserve_hint_);     // 同一地图的图层通常等大（Tiled 按字母序输出，data 先于 width/height）
+            return true;
+        }
+        const bool is_layers = !layers_ && stack_.size() == 1 && stack_.back()->is_object() && key_ == "layers";
+        stack_.push_back(place(nlohmann::json::value_t::array));
+        if (is_layers) {
+            layers_ = stack_.back();
+        }
+        return true;
+    }
+
+    bool end_array() override {
+        if (capture_) {
+            reserve_hint_ = capture_->gids_.size();
+            capture_ = nullptr;
+            return true;
+        }
+        stack_.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        error_ = ex.what();
+        return false;
+    }
+
+private:
+    /// 当前处在顶层 layers 数组的某个图层对象内
+    [[nodiscard]] bool isLayer() const {
+        return layers_ && stack_.size() == 3 && stack_[1] == layers_ && stack_.back()->is_object();
+    }
+
+    template <typename Value>
+    bool scalar(Value&& value) {
+        if (capture_) {
+            capture_->gids_.push_back(0);
+            return true;
+        }
+        place(std::forward<Value>(value));
+        return true;
+    }
+
+    /// 把值插入当前父节点（数组追加，对象按最近的键），返回新节点
+    template <typename Value>
+    nlohmann::json* place(Value&& value) {
+        if (stack_.empty()) {
+            root_ = nlohmann::json(std::forward<Value>(value));
+            return &root_;
+        }
+        auto* parent = stack_.back();
+        if (parent->is_array()) {
+            if (parent == layers_) {
+                cells_.emplace_back();      // 与 layers 数组逐元素对应
+            }
+            parent->emplace_back(std::forward<Value>(value));
+            return &parent->back();
+        }
+        auto& slot = (*parent)[key_];
+        slot = nlohmann::json(std::forward<Value>(value));
+        return &slot;
+    }
+
+    bool invalidCell() {
+        error_ = "图层 data 数组中只能包含数字";
+        return false;
+    }
+
+    nlohmann::json& root_;
+    std::vector<TileLayerCells>& cells_;
+    std::vector<nlohmann::json*> stack_;
+    std::string key_;
+    std::string error_;
+    const nlohmann::json* layers_{ nullptr };   ///< 顶层 layers 数组
+    TileLayerCells* capture_{ nullptr };        ///< 正在读取的 data 数组
+    std::size_t reserve_hint_{ 0 };             ///< 上一个 data 数组的长度
+};
+
+} // namespace
+
+bool readTiledMap(std::string_view text, nlohmann::json& out_json, std::vector<TileLayerCells>& out_cells,
+                  std::string& error_message) {
+    out_json = nullptr;
+    out_cells.clear();
+    TiledMapSax sax(out_json, out_cells);
+    if (!nlohmann::json::sax_parse(text, &sax)) {
+        error_message = sax.getError();
+        return false;
+    }
+    return true;
+}
+
+} // namespace engine::loader
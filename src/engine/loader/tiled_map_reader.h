@@ -0,0 +1,44 @@
+#pragma once
+/**
+ * @file tiled_map_reader.h
+ * @brief Tiled 地图 (.tmj) 的流式读取：瓦片图层的 data 数组直接写入 int32 gid 缓冲，不进入 JSON DOM。
+ *
+ * @details
+ * 瓦片图层的 data 数组是 .tmj 的绝大部分内容（每格一个数字）。建完整 DOM 时每格是一个
+ * nlohmann::json 节点（16 字节以上并逐个构造），之后还要逐格 is_number_integer / get 一遍。
+ * 这里用 SAX 接口边解析边分流：
+ * - 顶层 layers 数组中各图层的 data 数组（整数数组）写入 TileLayerCells，按图层宽高预留容量
+ * - 其余内容（地图属性、图层属性、对象图层）照常建成 DOM，体积很小，对象构建器依赖其 JSON 属性
+ *
+ * 需要完整 DOM（含 data）的工具代码继续使用 nlohmann::json::parse。
+ */
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace engine::loader {
+
+/**
+ * @struct TileLayerCells
+ * @brief 一个瓦片图层的格子 gid（行优先，含翻转位；非整数元素记为 0）
+ */
+struct TileLayerCells {
+    bool present_{ false };             ///< 图层含 data 数组（可能为空数组）
+    std::vector<std::int32_t> gids_;
+};
+
+/**
+ * @brief 流式解析 Tiled 地图文本。
+ * @param text 地图文件内容。
+ * @param out_json 输出的 DOM；layers[i] 的 data 数组已移入 out_cells[i]，不在 DOM 中。
+ * @param out_cells 与 out_json["layers"] 一一对应（没有 data 数组的图层 present_ 为 false）。
+ * @param error_message 失败原因。
+ * @return 解析成功返回 true。
+ */
+[[nodiscard]] bool readTiledMap(std::string_view text, nlohmann::json& out_json, std::vector<TileLayerCells>& out_cells,
+                                std::string& error_message);
+
+} // namespace engine::loader
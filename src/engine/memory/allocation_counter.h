@@ -0,0 +1,102 @@
+#pragma once
+/**
+ * @file allocation_counter.h
+ * @brief 全局 operator new 的逐线程分配计数。
+ *
+ * @details
+ * allocation_hooks.cpp 替换全局 operator new/delete：每次分配把当前线程的次数与字节数加一
+ * （thread_local 自增，无原子操作、无锁），MONSTERWAR_TRACY 开启时同时报告给 Tracy。
+ * 只统计经 operator new 的分配；SDL、stb 等直接调用 malloc 的库不在其中。
+ *
+ * 计数只增不减，用两次读数的差值衡量一段代码的分配：
+ * @code
+ * const auto before = engine::memory::threadAllocations();
+ * simulation.step();
+ * const auto allocated = engine::memory::threadAllocations() - before;    // allocated.count_、allocated.bytes_
+ * @endcode
+ *
+ * ZeroAllocationScope 标记期望不分配的区间（如开战后的 GameScene::update），由全局的零分配检查模式决定行为：
+ * 关闭时不做任何事；WARN 时只统计，调用方在区间结束后报告；ASSERT 时区间内每次分配都在分配发生的调用栈上
+ * 触发 assert（调试构建），可直接在调试器中定位分配来源。检查构造区间的线程，以及区间打开期间的 JobSystem 工作线程：
+ * 工作线程启动时调用 markJobWorkerThread()，此后它们的分配在有区间打开时（原子地）累加到共享计数，
+ * 调度器并行阶段中的分配因此也计入区间。其它线程（音频、资源加载）不计入。
+ *
+ * 区间内按波次而不是逐步发生的工作（波次切换、检查点与自动存档、存储整理）用 ZeroAllocationSuspend 包起来：
+ * 其中的分配不触发断言，也不计入外层区间（threadAllocations() 仍然统计）。
+ */
+
+#include <cstdint>
+
+namespace engine::memory {
+
+struct AllocationCount {
+    std::uint64_t count_{ 0 };      ///< operator new 调用次数
+    std::uint64_t bytes_{ 0 };      ///< 请求的字节数
+
+    [[nodiscard]] friend AllocationCount operator-(const AllocationCount& lhs, const AllocationCount& rhs) {
+        return AllocationCount{ lhs.count_ - rhs.count_, lhs.bytes_ - rhs.bytes_ };
+    }
+};
+
+/// @brief 当前线程累计的分配次数与字节数
+[[nodiscard]] AllocationCount threadAllocations() noexcept;
+
+/// @brief 零分配检查模式（命令行 --zero-alloc[=assert]）
+enum class ZeroAllocationMode : std::uint8_t {
+    OFF,        ///< 不检查
+    WARN,       ///< 统计区间内的分配，由调用方报告
+    ASSERT,     ///< 区间内的分配触发 assert（NDEBUG 构建中同 WARN）
+};
+
+/// @brief 把当前线程标记为 JobSystem 工作线程，零分配区间打开期间它的分配计入区间（见文件说明）
+void markJobWorkerThread() noexcept;
+
+void setZeroAllocationMode(ZeroAllocationMode mode) noexcept;
+[[nodiscard]] ZeroAllocationMode getZeroAllocationMode() noexcept;
+
+/**
+ * @class ZeroAllocationScope
+ * @brief RAII：期望不分配的区间，检查模式为 OFF 或 enabled 为 false 时不生效
+ */
+class ZeroAllocationScope final {
+public:
+    explicit ZeroAllocationScope(bool enabled = true) noexcept;
+    ~ZeroAllocationScope();
+
+    ZeroAllocationScope(const ZeroAllocationScope&) = delete;
+    ZeroAllocationScope& operator=(const ZeroAllocationScope&) = delete;
+
+    [[nodiscard]] bool isActive() const noexcept { return active_; }
+    /// @brief 进入区间以来当前线程与工作线程的分配
+    [[nodiscard]] AllocationCount allocated() const noexcept;
+    /// @brief 提前结束区间（之后的分配不再检查），返回区间内的分配
+    AllocationCount finish() noexcept;
+
+private:
+    void close() noexcept;
+
+    AllocationCount start_{};
+    AllocationCount start_suspended_{}; ///< 进入区间时当前线程在放行区间内的累计分配
+    AllocationCount start_workers_{};   ///< 进入区间时工作线程的共享计数
+    bool active_{ false };
+    bool trap_{ false };            ///< ASSERT 模式：区间内的分配（含工作线程）触发断言
+    bool previous_trap_{ false };   ///< 嵌套区间退出时恢复外层的断言状态
+};
+
+/**
+ * @class ZeroAllocationSuspend
+ * @brief RAII：在零分配区间内临时放行，区间内的分配不断言、不计入外层 ZeroAllocationScope（见文件说明）
+ */
+class ZeroAllocationSuspend final {
+public:
+    ZeroAllocationSuspend() noexcept;
+    ~ZeroAllocationSuspend();
+
+    ZeroAllocationSuspend(const ZeroAllocationSuspend&) = delete;
+    ZeroAllocationSuspend& operator=(const ZeroAllocationSuspend&) = delete;
+
+private:
+    bool previous_trap_{ false };
+};
+
+} // namespace engine::memory
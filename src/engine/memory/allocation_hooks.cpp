@@ -0,0 +1,225 @@
+/**
+ * @file allocation_hooks.cpp
+ * @brief 替换全局 operator new/delete：逐线程计数每次分配，MONSTERWAR_TRACY=ON 时同时报告给 Tracy 内存分析。
+ *
+ * @details 计数是 thread_local 的两个整数自增，开销可忽略，因此始终启用（见 allocation_counter.h）。
+ * JobSystem 工作线程只在有零分配区间打开时额外做两次原子累加，供区间统计并行阶段的分配。
+ * 对齐版本与带尺寸的 delete 一并替换，保证 Tracy 看到的分配/释放成对出现。
+ * 零分配区间的断言也在这里触发，调用栈停在发生分配的位置。
+ * 当前线程处于 StorageArenaScope 时分配转发到注册表存储区，释放 arena 内的地址为空操作（见 storage_arena.h）。
+ */
+#include "allocation_counter.h"
+#include "storage_arena.h"
+#include "../utils/profiler.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace {
+
+// 常量初始化的 thread_local，首次访问不会触发动态初始化（也就不会在 operator new 中递归分配）
+constinit thread_local engine::memory::AllocationCount t_allocations{};
+constinit thread_local bool t_trap = false;     ///< 当前线程处于 ASSERT 模式的零分配区间
+constinit thread_local bool t_job_worker = false;   ///< 当前线程是 JobSystem 工作线程
+constinit thread_local std::uint32_t t_suspend_depth = 0;     ///< 当前线程嵌套的 ZeroAllocationSuspend 层数
+constinit thread_local engine::memory::AllocationCount t_suspended{};   ///< 当前线程在放行区间内的累计分配
+std::atomic<engine::memory::ZeroAllocationMode> g_zero_allocation_mode{ engine::memory::ZeroAllocationMode::OFF };
+
+// 工作线程在区间打开期间的共享计数；g_open_scopes / g_trap_scopes 为打开的区间数与其中 ASSERT 模式的区间数
+constinit std::atomic<std::uint64_t> g_worker_count{ 0 };
+constinit std::atomic<std::uint64_t> g_worker_bytes{ 0 };
+constinit std::atomic<int> g_open_scopes{ 0 };
+constinit std::atomic<int> g_trap_scopes{ 0 };
+constinit std::atomic<int> g_suspended{ 0 };   ///< 放行中的 ZeroAllocationSuspend 数，期间工作线程的分配也不计入
+
+void countAllocation(std::size_t size) noexcept {
+    ++t_allocations.count_;
+    t_allocations.bytes_ += size;
+    if (t_suspend_depth > 0) [[unlikely]] {
+        ++t_suspended.count_;
+        t_suspended.bytes_ += size;
+    }
+    if (t_trap) [[unlikely]] {
+        // 断言的输出本身可能分配，先解除再断言
+        t_trap = false;
+        assert(!"零分配区间内发生了 operator new，见调用栈");
+        t_trap = true;
+    }
+    if (t_job_worker && g_open_scopes.load(std::memory_order_relaxed) > 0 && g_suspended.load(std::memory_order_relaxed) == 0) [[unlikely]] {
+        g_worker_count.fetch_add(1, std::memory_order_relaxed);
+        g_worker_bytes.fetch_add(size, std::memory_order_relaxed);
+        if (g_trap_scopes.load(std::memory_order_relaxed) > 0) {
+            // 同上，断言期间的分配不再进入这里
+            t_job_worker = false;
+            assert(!"零分配区间内工作线程发生了 operator new，见调用栈");
+            t_job_worker = true;
+        }
+    }
+}
+
+engine::memory::AllocationCount workerAllocations() noexcept {
+    return engine::memory::AllocationCount{ g_worker_count.load(std::memory_order_relaxed),
+                                            g_worker_bytes.load(std::memory_order_relaxed) };
+}
+
+void* trackedAlloc(std::size_t size) {
+    void* ptr = engine::memory::StorageArena::allocateActive(size, alignof(std::max_align_t));
+    if (!ptr) {
+        ptr = std::malloc(size == 0 ? 1 : size);
+    }
+    if (!ptr) {
+        throw std::bad_alloc{};
+    }
+    countAllocation(size);
+#if MONSTERWAR_TRACY
+    TracyAlloc(ptr, size);
+#endif
+    return ptr;
+}
+
+void* trackedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+    const auto align = static_cast<std::size_t>(alignment);
+    const std::size_t rounded = (size + align - 1) / align * align;
+    void* ptr = engine::memory::StorageArena::allocateActive(size, align);
+    if (!ptr) {
+#ifdef _MSC_VER
+        ptr = _aligned_malloc(rounded == 0 ? align : rounded, align);
+#else
+        ptr = std::aligned_alloc(align, rounded == 0 ? align : rounded);
+#endif
+    }
+    if (!ptr) {
+        throw std::bad_alloc{};
+    }
+    countAllocation(size);
+#if MONSTERWAR_TRACY
+    TracyAlloc(ptr, size);
+#endif
+    return ptr;
+}
+
+void trackedFree(void* ptr) noexcept {
+    if (ptr) {
+#if MONSTERWAR_TRACY
+        TracyFree(ptr);
+#endif
+        if (!engine::memory::StorageArena::owns(ptr)) {
+            std::free(ptr);
+        }
+    }
+}
+
+void trackedAlignedFree(void* ptr) noexcept {
+    if (ptr) {
+#if MONSTERWAR_TRACY
+        TracyFree(ptr);
+#endif
+        if (engine::memory::StorageArena::owns(ptr)) {
+            return;
+        }
+#ifdef _MSC_VER
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+}
+
+} // namespace
+
+engine::memory::AllocationCount engine::memory::threadAllocations() noexcept {
+    return t_allocations;
+}
+
+void engine::memory::markJobWorkerThread() noexcept {
+    t_job_worker = true;
+}
+
+void engine::memory::setZeroAllocationMode(ZeroAllocationMode mode) noexcept {
+    g_zero_allocation_mode.store(mode, std::memory_order_relaxed);
+}
+
+engine::memory::ZeroAllocationMode engine::memory::getZeroAllocationMode() noexcept {
+    return g_zero_allocation_mode.load(std::memory_order_relaxed);
+}
+
+engine::memory::ZeroAllocationScope::ZeroAllocationScope(bool enabled) noexcept
+    : start_(t_allocations), start_suspended_(t_suspended), start_workers_(workerAllocations()), previous_trap_(t_trap) {
+    const auto mode = getZeroAllocationMode();
+    active_ = enabled && mode != ZeroAllocationMode::OFF;
+    trap_ = active_ && mode == ZeroAllocationMode::ASSERT;
+    if (active_) {
+        g_open_scopes.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (trap_) {
+        t_trap = true;
+        g_trap_scopes.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+engine::memory::ZeroAllocationScope::~ZeroAllocationScope() {
+    close();
+}
+
+engine::memory::AllocationCount engine::memory::ZeroAllocationScope::allocated() const noexcept {
+    const auto own = (threadAllocations() - start_) - (t_suspended - start_suspended_);
+    const auto workers = workerAllocations() - start_workers_;
+    return AllocationCount{ own.count_ + workers.count_, own.bytes_ + workers.bytes_ };
+}
+
+engine::memory::AllocationCount engine::memory::ZeroAllocationScope::finish() noexcept {
+    const auto result = allocated();
+    close();
+    return result;
+}
+
+void engine::memory::ZeroAllocationScope::close() noexcept {
+    if (active_) {
+        g_open_scopes.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (trap_) {
+        g_trap_scopes.fetch_sub(1, std::memory_order_relaxed);
+    }
+    t_trap = previous_trap_;
+    active_ = false;
+    trap_ = false;
+}
+
+engine::memory::ZeroAllocationSuspend::ZeroAllocationSuspend() noexcept
+    : previous_trap_(std::exchange(t_trap, false)) {
+    ++t_suspend_depth;
+    g_suspended.fetch_add(1, std::memory_order_relaxed);
+}
+
+engine::memory::ZeroAllocationSuspend::~ZeroAllocationSuspend() {
+    g_suspended.fetch_sub(1, std::memory_order_relaxed);
+    --t_suspend_depth;
+    t_trap = previous_trap_;
+}
+
+void* operator new(std::size_t size) { return trackedAlloc(size); }
+void* operator new[](std::size_t size) { return trackedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return trackedAlignedAlloc(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return trackedAlignedAlloc(size, alignment); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return trackedAlloc(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return trackedAlloc(size); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* ptr) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { trackedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { trackedAlignedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { trackedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { trackedAlignedFree(ptr); }
@@ -0,0 +1,52 @@
+#include "frame_arena.h"
+#include "memory_tracker.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <spdlog/spdlog.h>
+
+namespace engine::memory {
+
+FrameArena::FrameArena(std::size_t initial_capacity)
+    : buffer_(initial_capacity > 0 ? std::make_unique_for_overwrite<std::byte[]>(initial_capacity) : nullptr),
+      capacity_(initial_capacity),
+      overflow_(MemoryTracker::instance().resource(MemoryTag::FRAME)) {
+    MemoryTracker::instance().setReported(MemoryTag::FRAME, capacity_);
+}
+
+FrameArena::~FrameArena() = default;
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    // 按实际地址对齐（主块本身只保证 new 的默认对齐）
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer_.get());
+    const std::size_t offset = ((base + used_ + alignment - 1) & ~(alignment - 1)) - base;
+    if (buffer_ && offset + bytes <= capacity_) {
+        used_ = offset + bytes;
+        return buffer_.get() + offset;
+    }
+
+    ++overflow_count_;
+    overflow_bytes_ += bytes;
+    return overflow_.allocate(bytes, alignment);
+}
+
+void FrameArena::reset() {
+    const std::size_t frame_bytes = getBytesUsed();
+    peak_bytes_ = std::max(peak_bytes_, frame_bytes);
+
+    if (overflow_count_ > 0) {
+        // 扩大到本帧用量的下一个 2 的幂，同等负载下一帧起全部落在主块内
+        const std::size_t new_capacity = std::bit_ceil(frame_bytes + frame_bytes / 4);
+        spdlog::debug("FrameArena 本帧溢出 {} 次（{} 字节），主块扩大到 {} 字节", overflow_count_, frame_bytes, new_capacity);
+        overflow_.release();
+        buffer_ = std::make_unique_for_overwrite<std::byte[]>(new_capacity);
+        capacity_ = new_capacity;
+        MemoryTracker::instance().setReported(MemoryTag::FRAME, capacity_);
+    }
+
+    used_ = 0;
+    overflow_bytes_ = 0;
+    overflow_count_ = 0;
+}
+
+} // namespace engine::memory
@@ -0,0 +1,79 @@
+#pragma once
+/**
+ * @file frame_arena.h
+ * @brief 帧内临时数据的线性（bump）分配器，配合 std::pmr 容器使用。
+ *
+ * @details
+ * 每帧构建又丢弃的临时容器（HUD 文本、调试面板的曲线数据、遍历时收集的实体列表）
+ * 若使用默认分配器，每帧都会有一批 malloc/free。FrameArena 从一块预先分配的内存顺序切分，
+ * deallocate 为空操作，GameApp::render() 结束时整体 reset()。
+ *
+ * - 当前块用尽时从上游分配溢出块，本帧照常可用；reset() 时把主块扩大到本帧峰值，
+ *   此后同等负载下不再分配
+ * - 只在主线程使用（无锁），任务系统的工作线程不得持有帧内存
+ * - 帧内存在 reset() 之后全部失效：不要存入组件、跨帧成员或异步任务
+ *
+ * @code
+ * auto& arena = context.getFrameArena();
+ * auto entities = arena.makeVector<entt::entity>(view.size());
+ * auto text = arena.makeString();
+ * std::format_to(std::back_inserter(text), "Wave {}", wave);
+ * @endcode
+ */
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace engine::memory {
+
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    /// @param initial_capacity 主块初始大小（字节）
+    explicit FrameArena(std::size_t initial_capacity = 256 * 1024);
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /// @brief 回收本帧全部分配（每帧一次，由 GameApp 在渲染结束后调用）
+    void reset();
+
+    /// @brief 以本 arena 为内存资源的空 vector，可选预留容量
+    template <typename T>
+    [[nodiscard]] std::pmr::vector<T> makeVector(std::size_t reserve = 0) {
+        std::pmr::vector<T> result{ this };
+        result.reserve(reserve);
+        return result;
+    }
+
+    /// @brief 以本 arena 为内存资源的空字符串
+    [[nodiscard]] std::pmr::string makeString(std::size_t reserve = 0) {
+        std::pmr::string result{ this };
+        result.reserve(reserve);
+        return result;
+    }
+
+    [[nodiscard]] std::size_t getBytesUsed() const { return used_ + overflow_bytes_; }      ///< 本帧已分配字节数
+    [[nodiscard]] std::size_t getPeakBytes() const { return peak_bytes_; }                 ///< 历史单帧峰值
+    [[nodiscard]] std::size_t getCapacity() const { return capacity_; }                    ///< 主块大小
+    [[nodiscard]] std::size_t getOverflowCount() const { return overflow_count_; }         ///< 本帧溢出块数量
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::unique_ptr<std::byte[]> buffer_;   ///< 主块
+    std::size_t capacity_{0};
+    std::size_t used_{0};
+
+    std::pmr::monotonic_buffer_resource overflow_;  ///< 主块用尽后的溢出分配（计入 MemoryTag::FRAME），reset() 时整体释放
+    std::size_t overflow_bytes_{0};
+    std::size_t overflow_count_{0};
+    std::size_t peak_bytes_{0};
+};
+
+} // namespace engine::memory
@@ -0,0 +1,46 @@
+#pragma once
+/**
+ * @file memory_estimate.h
+ * @brief 标准容器自身堆内存的估算，供管理器向 MemoryTracker 上报用量。
+ *
+ * @details
+ * 只计算容器直接持有的那块内存（vector 的容量、哈希表的桶与节点、字符串的堆缓冲），
+ * 不递归到元素内部；元素自身持有堆内存时由调用方逐个累加。
+ * 节点式容器的每节点开销按两个指针估算，数值用于预算与对比，不是精确字节数。
+ */
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <entt/container/dense_map.hpp>
+
+namespace engine::memory {
+
+template <typename T, typename Allocator>
+[[nodiscard]] std::size_t containerBytes(const std::vector<T, Allocator>& values) {
+    return values.capacity() * sizeof(T);
+}
+
+/// @brief 短字符串优化时缓冲在对象内部，不计堆内存
+template <typename Char, typename Traits, typename Allocator>
+[[nodiscard]] std::size_t containerBytes(const std::basic_string<Char, Traits, Allocator>& text) {
+    const auto* object = reinterpret_cast<const std::byte*>(&text);
+    const auto* data = reinterpret_cast<const std::byte*>(text.data());
+    const bool inline_buffer = data >= object && data < object + sizeof(text);
+    return inline_buffer ? 0 : (text.capacity() + 1) * sizeof(Char);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+[[nodiscard]] std::size_t containerBytes(const std::unordered_map<Key, Value, Hash, Equal, Allocator>& map) {
+    return map.bucket_count() * sizeof(void*) + map.size() * (sizeof(std::pair<const Key, Value>) + 2 * sizeof(void*));
+}
+
+/// @brief entt::dense_map：稀疏桶数组 + 紧凑的（下一节点下标, 键值对）数组
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+[[nodiscard]] std::size_t containerBytes(const entt::dense_map<Key, Value, Hash, Equal, Allocator>& map) {
+    return map.bucket_count() * sizeof(std::size_t) + map.size() * (sizeof(std::size_t) + sizeof(std::pair<Key, Value>));
+}
+
+} // namespace engine::memory
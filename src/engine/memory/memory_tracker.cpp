@@ -0,0 +1,125 @@
+#include "memory_tracker.h"
+#include "../utils/logging.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace engine::memory {
+
+namespace {
+
+constexpr std::array<std::string_view, MEMORY_TAG_COUNT> TAG_NAMES{
+    "registry", "blueprints", "animation", "textures", "audio", "ui", "frame"
+};
+
+constexpr double toMb(std::size_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+} // namespace
+
+std::string_view memoryTagName(MemoryTag tag) {
+    const auto i = static_cast<std::size_t>(tag);
+    return i < TAG_NAMES.size() ? TAG_NAMES[i] : std::string_view{ "unknown" };
+}
+
+void* TrackingResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    void* ptr = upstream_->allocate(bytes, alignment);
+    const std::size_t now = bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    std::size_t peak = peak_bytes_.load(std::memory_order_relaxed);
+    while (now > peak && !peak_bytes_.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+    return ptr;
+}
+
+void TrackingResource::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) {
+    upstream_->deallocate(ptr, bytes, alignment);
+    bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+    allocations_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+MemoryTracker& MemoryTracker::instance() {
+    static MemoryTracker tracker;
+    return tracker;
+}
+
+void MemoryTracker::setReported(MemoryTag tag, std::size_t bytes) {
+    reported_[index(tag)].store(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::addReclaimed(MemoryTag tag, std::size_t bytes) {
+    reclaimed_[index(tag)].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::setBudget(MemoryTag tag, std::size_t bytes) {
+    budgets_[index(tag)] = bytes;
+    warned_[index(tag)] = false;
+}
+
+void MemoryTracker::setBudgets(const std::unordered_map<std::string, float>& budgets_mb) {
+    for (const auto& [name, mb] : budgets_mb) {
+        const auto it = std::ranges::find(TAG_NAMES, std::string_view{ name });
+        if (it == TAG_NAMES.end()) {
+            ENGINE_LOG_WARN("未知的内存预算标签: {}", name);
+            continue;
+        }
+        const auto bytes = static_cast<std::size_t>(std::max(mb, 0.0f) * 1024.0f * 1024.0f);
+        setBudget(static_cast<MemoryTag>(std::distance(TAG_NAMES.begin(), it)), bytes);
+    }
+}
+
+std::vector<MemoryTagStats> MemoryTracker::collect() {
+    std::vector<MemoryTagStats> stats;
+    stats.reserve(MEMORY_TAG_COUNT);
+    for (std::size_t i = 0; i < MEMORY_TAG_COUNT; ++i) {
+        MemoryTagStats entry;
+        entry.tag_ = static_cast<MemoryTag>(i);
+        entry.tracked_bytes_ = resources_[i].getBytes();
+        entry.tracked_peak_ = resources_[i].getPeakBytes();
+        entry.allocations_ = resources_[i].getAllocationCount();
+        entry.reported_bytes_ = reported_[i].load(std::memory_order_relaxed);
+        entry.reclaimed_bytes_ = reclaimed_[i].load(std::memory_order_relaxed);
+        entry.budget_bytes_ = budgets_[i];
+        entry.over_budget_ = entry.budget_bytes_ > 0 && entry.totalBytes() > entry.budget_bytes_;
+        if (entry.over_budget_ && !warned_[i]) {
+            ENGINE_LOG_WARN("内存超出预算: {} {:.2f} MB / {:.2f} MB", TAG_NAMES[i], toMb(entry.totalBytes()), toMb(entry.budget_bytes_));
+        }
+        warned_[i] = entry.over_budget_;
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+void MemoryTracker::writeReport(std::string_view label) {
+    const auto stats = collect();
+    std::size_t total = 0;
+    for (const auto& entry : stats) {
+        total += entry.totalBytes();
+    }
+    ENGINE_LOG_INFO("内存报告 [{}]: 共 {:.2f} MB", label, toMb(total));
+    for (const auto& entry : stats) {
+        ENGINE_LOG_INFO("  {:<10} {:>8.2f} MB（计数 {:.2f} MB / 峰值 {:.2f} MB / {} 次分配，上报 {:.2f} MB，累计回收 {:.2f} MB）{}",
+            memoryTagName(entry.tag_), toMb(entry.totalBytes()), toMb(entry.tracked_bytes_), toMb(entry.tracked_peak_),
+            entry.allocations_, toMb(entry.reported_bytes_), toMb(entry.reclaimed_bytes_), entry.over_budget_ ? " 超出预算" : "");
+    }
+
+    if (report_path_.empty()) {
+        return;
+    }
+    std::ofstream file(report_path_, std::exchange(report_written_, true) ? std::ios::app : std::ios::trunc);
+    if (!file.is_open()) {
+        ENGINE_LOG_ERROR("无法写入内存报告: {}", report_path_);
+        return;
+    }
+    file << "# " << label << '\n'
+         << "tag,total_bytes,tracked_bytes,tracked_peak,allocations,reported_bytes,budget_bytes,over_budget,reclaimed_bytes\n";
+    for (const auto& entry : stats) {
+        file << memoryTagName(entry.tag_) << ',' << entry.totalBytes() << ',' << entry.tracked_bytes_ << ','
+             << entry.tracked_peak_ << ',' << entry.allocations_ << ',' << entry.reported_bytes_ << ','
+             << entry.budget_bytes_ << ',' << (entry.over_budget_ ? 1 : 0) << ',' << entry.reclaimed_bytes_ << '\n';
+    }
+}
+
+} // namespace engine::memory
@@ -0,0 +1,143 @@
+#pragma once
+/**
+ * @file memory_tracker.h
+ * @brief 按子系统分标签的内存统计：每个标签一个计数的 std::pmr::memory_resource，外加由管理器上报的估算值。
+ *
+ * @details
+ * 两种来源合并为一个标签的用量：
+ * - 计数：容器以 MemoryTracker::resource(tag) 为内存资源时，每次分配/释放都记到该标签（原子计数，可跨线程）
+ * - 上报：内存不经过本进程分配器或无法改用 pmr 的部分（SDL 纹理、音频缓冲、注册表组件存储、UI 树）
+ *   由所属管理器估算后 setReported() 写入，以最后一次上报为准
+ *
+ * 预算来自 config.json 的 performance.memory_budgets_mb，超出时 collect() 报告 over_budget_，
+ * 每个标签首次越界时打一条警告。
+ *
+ * @code
+ * std::pmr::unordered_map<Key, Value> map{ engine::memory::MemoryTracker::instance().resource(MemoryTag::ANIMATION) };
+ * engine::memory::MemoryTracker::instance().setReported(MemoryTag::TEXTURES, texture_bytes);
+ * @endcode
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::memory {
+
+enum class MemoryTag : std::uint8_t {
+    REGISTRY,       ///< 注册表组件存储
+    BLUEPRINTS,     ///< 蓝图与其他游戏数据
+    ANIMATION,      ///< 共享动画集合
+    TEXTURES,       ///< 纹理显存（估算）
+    AUDIO,          ///< 已解码音频缓冲
+    UI,             ///< UI 元素树
+    FRAME,          ///< 帧内存（FrameArena）
+    COUNT
+};
+
+inline constexpr std::size_t MEMORY_TAG_COUNT = static_cast<std::size_t>(MemoryTag::COUNT);
+
+/// @brief 标签名（报告、面板与 config.json 的预算键使用）
+[[nodiscard]] std::string_view memoryTagName(MemoryTag tag);
+
+/**
+ * @brief 转发到上游资源并计数的内存资源
+ */
+class TrackingResource final : public std::pmr::memory_resource {
+public:
+    explicit TrackingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream) {}
+
+    [[nodiscard]] std::size_t getBytes() const { return bytes_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t getPeakBytes() const { return peak_bytes_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t getAllocationCount() const { return allocations_.load(std::memory_order_relaxed); }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource* upstream_;
+    std::atomic<std::size_t> bytes_{0};
+    std::atomic<std::size_t> peak_bytes_{0};
+    std::atomic<std::size_t> allocations_{0};   ///< 当前未释放的分配次数
+};
+
+/**
+ * @brief 单个标签的统计
+ */
+struct MemoryTagStats {
+    MemoryTag tag_{MemoryTag::COUNT};
+    std::size_t tracked_bytes_{0};      ///< 经 pmr 资源分配、尚未释放的字节数
+    std::size_t tracked_peak_{0};
+    std::size_t allocations_{0};
+    std::size_t reported_bytes_{0};     ///< 管理器上报的估算值
+    std::size_t reclaimed_bytes_{0};    ///< 累计回收的字节数（如波次间隔的存储收缩）
+    std::size_t budget_bytes_{0};       ///< 0 表示不设预算
+    bool over_budget_{false};
+
+    [[nodiscard]] std::size_t totalBytes() const { return tracked_bytes_ + reported_bytes_; }
+};
+
+/**
+ * @class MemoryTracker
+ * @brief 进程级的标签内存统计
+ */
+class MemoryTracker final {
+public:
+    static MemoryTracker& instance();
+
+    MemoryTracker(const MemoryTracker&) = delete;
+    MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+    /// @brief 标签对应的计数内存资源，生命周期与进程相同
+    [[nodiscard]] std::pmr::memory_resource* resource(MemoryTag tag) { return &resources_[index(tag)]; }
+
+    /// @brief 写入管理器估算的用量（覆盖上一次上报）
+    void setReported(MemoryTag tag, std::size_t bytes);
+
+    /// @brief 累计一次回收（如收缩存储释放的字节数），面板与报告中单独列出
+    void addReclaimed(MemoryTag tag, std::size_t bytes);
+
+    /// @brief 设置预算（字节），0 取消预算
+    void setBudget(MemoryTag tag, std::size_t bytes);
+
+    /// @brief 读取 {标签名: MB} 形式的预算表，未知标签名忽略并警告
+    void setBudgets(const std::unordered_map<std::string, float>& budgets_mb);
+
+    /// @brief 全部标签的当前统计；首次越过预算的标签打一条警告
+    [[nodiscard]] std::vector<MemoryTagStats> collect();
+
+    /**
+     * @brief 输出报告：写日志，并在设置了报告路径时以 CSV 追加一段（每段以标题行开头；进程内首次写入时截断文件）
+     * @param label 报告标题（如退出的场景名）
+     */
+    void writeReport(std::string_view label);
+
+    /// @brief 设置 --memreport 的输出路径；为空时 writeReport 只写日志
+    void setReportPath(std::string path) { report_path_ = std::move(path); }
+    [[nodiscard]] bool isReportEnabled() const { return report_enabled_; }
+    void setReportEnabled(bool enabled) { report_enabled_ = enabled; }
+
+private:
+    MemoryTracker() = default;
+
+    static constexpr std::size_t index(MemoryTag tag) { return static_cast<std::size_t>(tag); }
+
+    std::array<TrackingResource, MEMORY_TAG_COUNT> resources_;     ///< 逐个默认构造，上游均为 new_delete_resource()
+    std::array<std::atomic<std::size_t>, MEMORY_TAG_COUNT> reported_{};
+    std::array<std::atomic<std::size_t>, MEMORY_TAG_COUNT> reclaimed_{};
+    std::array<std::size_t, MEMORY_TAG_COUNT> budgets_{};
+    std::array<bool, MEMORY_TAG_COUNT> warned_{};
+    std::string report_path_;
+    bool report_enabled_{false};
+    bool report_written_{false};    ///< 本进程是否已写过报告文件
+};
+
+} // namespace engine::memory
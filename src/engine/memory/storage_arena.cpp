@@ -0,0 +1,219 @@
+#include "storage_arena.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace engine::memory {
+
+namespace {
+
+// operator new / delete 中访问，均为常量初始化，不会触发动态初始化
+constinit thread_local StorageArena* t_active = nullptr;
+constinit std::array<std::atomic<std::uintptr_t>, StorageArena::MAX_LIVE_ARENAS> g_begin{};
+constinit std::array<std::atomic<std::uintptr_t>, StorageArena::MAX_LIVE_ARENAS> g_end{};
+constinit std::atomic<std::size_t> g_live{ 0 };
+/// 已被某个 arena 占用、区间尚未发布的槽位（g_end 仍为 0，owns() 不会匹配任何地址）
+constexpr std::uintptr_t CLAIMED_SLOT = 1;
+std::atomic<std::size_t> g_configured_capacity{ 0 };
+
+std::size_t roundUp(std::size_t value, std::size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+#ifdef _WIN32
+/// @brief 有锁页权限（SeLockMemoryPrivilege）时整段以大页提交；没有权限时 VirtualAlloc 失败
+void* reserveLargePages(std::size_t& size) {
+    const SIZE_T large_page = GetLargePageMinimum();
+    if (large_page == 0) {
+        return nullptr;
+    }
+    size = roundUp(size, large_page);
+    return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+}
+
+void* reserveRegion(std::size_t size) {
+    return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool commitRegion(std::byte* begin, std::size_t size) {
+    return VirtualAlloc(begin, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void releaseRegion(void* reservation, std::size_t) {
+    VirtualFree(reservation, 0, MEM_RELEASE);
+}
+#else
+/// @brief 需要系统预先配置大页池（vm.nr_hugepages）；没有时 mmap 失败
+void* reserveLargePages(std::size_t& size) {
+#ifdef MAP_HUGETLB
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+#else
+    (void)size;
+    return nullptr;
+#endif
+}
+
+void* reserveRegion(std::size_t size) {
+    void* ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+bool commitRegion(std::byte* begin, std::size_t size) {
+    if (mprotect(begin, size, PROT_READ | PROT_WRITE) != 0) {
+        return false;
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(begin, size, MADV_HUGEPAGE);     // 透明大页只是建议，失败不影响使用
+#endif
+    return true;
+}
+
+void releaseRegion(void* reservation, std::size_t size) {
+    munmap(reservation, size);
+}
+#endif
+
+} // namespace
+
+std::string_view storageArenaBackingName(StorageArena::Backing backing) {
+    switch (backing) {
+        case StorageArena::Backing::LARGE_PAGES: return "大页";
+        case StorageArena::Backing::ALIGNED: return "2 MB 对齐";
+        case StorageArena::Backing::NONE: break;
+    }
+    return "无";
+}
+
+StorageArena::StorageArena(std::size_t capacity) {
+    capacity = roundUp(std::max<std::size_t>(capacity, REGION_ALIGNMENT), REGION_ALIGNMENT);
+    for (std::size_t i = 0; i < MAX_LIVE_ARENAS; ++i) {
+        // 比较交换占位：两个线程同时构造时不会拿到同一个槽位
+        std::uintptr_t expected = 0;
+        if (g_begin[i].compare_exchange_strong(expected, CLAIMED_SLOT, std::memory_order_acq_rel)) {
+            slot_ = i;
+            break;
+        }
+    }
+    if (slot_ == MAX_LIVE_ARENAS) {
+        spdlog::warn("注册表存储区：同时存活的 arena 超过 {} 个，本场景使用普通堆", MAX_LIVE_ARENAS);
+        return;
+    }
+
+    std::size_t large_size = capacity;
+    if (void* large = reserveLargePages(large_size)) {
+        reservation_ = large;
+        reservation_size_ = large_size;
+        base_ = static_cast<std::byte*>(large);
+        capacity_ = large_size;
+        committed_ = large_size;
+        backing_ = Backing::LARGE_PAGES;
+    } else if (void* region = reserveRegion(capacity + REGION_ALIGNMENT)) {
+        // 多预留一个对齐单位，保证区间起点落在 2 MB 边界上
+        reservation_ = region;
+        reservation_size_ = capacity + REGION_ALIGNMENT;
+        base_ = reinterpret_cast<std::byte*>(roundUp(reinterpret_cast<std::uintptr_t>(region), REGION_ALIGNMENT));
+        capacity_ = capacity;
+        backing_ = Backing::ALIGNED;
+    } else {
+        spdlog::warn("注册表存储区：无法预留 {} MB 地址区间，本场景使用普通堆", capacity / (1024 * 1024));
+        g_begin[slot_].store(0, std::memory_order_release);
+        slot_ = MAX_LIVE_ARENAS;
+        return;
+    }
+
+    const auto begin = reinterpret_cast<std::uintptr_t>(base_);
+    g_end[slot_].store(begin + capacity_, std::memory_order_relaxed);
+    g_begin[slot_].store(begin, std::memory_order_release);
+    g_live.fetch_add(1, std::memory_order_relaxed);
+    spdlog::info("注册表存储区：预留 {} MB（{}）", capacity_ / (1024 * 1024), storageArenaBackingName(backing_));
+}
+
+StorageArena::~StorageArena() {
+    if (backing_ == Backing::NONE) {
+        return;
+    }
+    spdlog::info("注册表存储区释放：已用 {:.1f} / 提交 {:.1f} MB，回退到堆 {} 次",
+                 static_cast<double>(used_) / (1024.0 * 1024.0), static_cast<double>(committed_) / (1024.0 * 1024.0), fallbacks_);
+    g_begin[slot_].store(0, std::memory_order_release);
+    g_end[slot_].store(0, std::memory_order_relaxed);
+    g_live.fetch_sub(1, std::memory_order_relaxed);
+    releaseRegion(reservation_, reservation_size_);
+}
+
+bool StorageArena::commit(std::size_t end) noexcept {
+    if (end <= committed_) {
+        return true;
+    }
+    const std::size_t target = std::min(roundUp(end, REGION_ALIGNMENT), capacity_);
+    if (!commitRegion(base_ + committed_, target - committed_)) {
+        return false;
+    }
+    committed_ = target;
+    return true;
+}
+
+void* StorageArena::allocate(std::size_t size, std::size_t alignment) noexcept {
+    if (backing_ == Backing::NONE) {
+        return nullptr;
+    }
+    const std::size_t offset = roundUp(used_, alignment);
+    const std::size_t end = offset + (size == 0 ? 1 : size);
+    if (end > capacity_ || !commit(end)) {
+        ++fallbacks_;
+        return nullptr;
+    }
+    used_ = end;
+    return base_ + offset;
+}
+
+bool StorageArena::owns(const void* ptr) noexcept {
+    if (g_live.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+    for (std::size_t i = 0; i < MAX_LIVE_ARENAS; ++i) {
+        const auto begin = g_begin[i].load(std::memory_order_acquire);
+        if (begin != 0 && address >= begin && address < g_end[i].load(std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void* StorageArena::allocateActive(std::size_t size, std::size_t alignment) noexcept {
+    return t_active ? t_active->allocate(size, alignment) : nullptr;
+}
+
+void StorageArena::setConfiguredCapacity(std::size_t bytes) {
+    g_configured_capacity.store(bytes, std::memory_order_relaxed);
+}
+
+std::size_t StorageArena::getConfiguredCapacity() {
+    return g_configured_capacity.load(std::memory_order_relaxed);
+}
+
+StorageArenaScope::StorageArenaScope(StorageArena* arena) noexcept : previous_(t_active) {
+    if (arena) {
+        t_active = arena;
+    }
+}
+
+StorageArenaScope::~StorageArenaScope() {
+    t_active = previous_;
+}
+
+} // namespace engine::memory
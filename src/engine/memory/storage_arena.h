@@ -0,0 +1,102 @@
+#pragma once
+/**
+ * @file storage_arena.h
+ * @brief 注册表组件存储的场景级 arena：一段连续的大页（或 2 MB 对齐）地址区间，场景退出时整体释放。
+ *
+ * @details
+ * EnTT 的组件存储经 std::allocator（即全局 operator new）按页分配，分散在堆上各处，
+ * 热循环遍历多个存储时 TLB 未命中随之分散。StorageArena 预留一段连续地址区间：
+ * - Windows 有锁页权限时整体以大页（MEM_LARGE_PAGES）提交；Linux 先尝试 MAP_HUGETLB
+ * - 否则按 2 MB 对齐预留、逐 2 MB 提交（Linux 上附加 MADV_HUGEPAGE，由透明大页合并）
+ * - 顺序切分，释放为空操作；析构时一次归还整段区间
+ *
+ * 注册表的类型保持 entt::registry（std::allocator 无状态，无法按注册表指定内存来源），
+ * 改由 StorageArenaScope 在当前线程上把全局 operator new 转发到 arena（见 allocation_hooks.cpp）。
+ * 只在「预留存储」的调用周围开启（engine::ecs::reserveStorage），因此区间内只有注册表自身持有的分配：
+ * 组件页、packed 数组与存储对象；之后的增长照常来自堆，arena 用尽时同样回退到堆。
+ * operator delete 遇到 arena 内的地址直接返回；arena 的生命周期必须长于注册表（Scene 中先于 registry_ 声明）。
+ *
+ * 默认关闭，config.json 的 performance.registry_arena_mb 大于 0 时由 GameScene 创建。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace engine::memory {
+
+class StorageArena final {
+public:
+    static constexpr std::size_t REGION_ALIGNMENT = 2 * 1024 * 1024;   ///< 区间对齐与提交粒度（2 MB）
+    static constexpr std::size_t MAX_LIVE_ARENAS = 4;                   ///< 同时存活的 arena 上限（正在运行与预取中的场景）
+
+    enum class Backing : std::uint8_t {
+        NONE,           ///< 预留失败，所有分配回退到堆
+        LARGE_PAGES,    ///< 显式大页，整段一次提交
+        ALIGNED,        ///< 2 MB 对齐区间，按需提交
+    };
+
+    /// @param capacity 预留的字节数（向上取整到 REGION_ALIGNMENT）
+    explicit StorageArena(std::size_t capacity);
+    ~StorageArena();
+
+    StorageArena(const StorageArena&) = delete;
+    StorageArena& operator=(const StorageArena&) = delete;
+
+    /**
+     * @brief 从 arena 切分（只由 StorageArenaScope 所在的线程调用）
+     * @return 区间用尽或需要提交的页无法提交时返回 nullptr，调用方回退到堆
+     */
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment) noexcept;
+
+    [[nodiscard]] Backing getBacking() const { return backing_; }
+    [[nodiscard]] std::size_t getCapacity() const { return capacity_; }
+    [[nodiscard]] std::size_t getCommittedBytes() const { return committed_; }
+    [[nodiscard]] std::size_t getUsedBytes() const { return used_; }
+    [[nodiscard]] std::size_t getFallbackCount() const { return fallbacks_; }
+
+    /// @brief 地址是否属于任一存活的 arena（operator delete 调用，无锁）
+    [[nodiscard]] static bool owns(const void* ptr) noexcept;
+    /// @brief 当前线程开启了 StorageArenaScope 时从其 arena 分配，否则返回 nullptr
+    [[nodiscard]] static void* allocateActive(std::size_t size, std::size_t alignment) noexcept;
+
+    /// @brief 配置的容量（GameApp 按 performance.registry_arena_mb 设置，0 表示关闭）
+    static void setConfiguredCapacity(std::size_t bytes);
+    [[nodiscard]] static std::size_t getConfiguredCapacity();
+
+private:
+    friend class StorageArenaScope;
+
+    [[nodiscard]] bool commit(std::size_t end) noexcept;
+
+    std::byte* base_{ nullptr };          ///< 对齐后的区间起点
+    void* reservation_{ nullptr };        ///< 系统返回的原始地址（释放用）
+    std::size_t reservation_size_{ 0 };
+    std::size_t capacity_{ 0 };
+    std::size_t committed_{ 0 };
+    std::size_t used_{ 0 };
+    std::size_t fallbacks_{ 0 };          ///< 用尽后回退到堆的次数
+    std::size_t slot_{ MAX_LIVE_ARENAS };
+    Backing backing_{ Backing::NONE };
+};
+
+/// @brief 后备类型名（日志用）
+[[nodiscard]] std::string_view storageArenaBackingName(StorageArena::Backing backing);
+
+/**
+ * @class StorageArenaScope
+ * @brief RAII：区间内当前线程的 operator new 从 arena 分配（arena 为 nullptr 时不做任何事，可嵌套）
+ */
+class StorageArenaScope final {
+public:
+    explicit StorageArenaScope(StorageArena* arena) noexcept;
+    ~StorageArenaScope();
+
+    StorageArenaScope(const StorageArenaScope&) = delete;
+    StorageArenaScope& operator=(const StorageArenaScope&) = delete;
+
+private:
+    StorageArena* previous_{ nullptr };
+};
+
+} // namespace engine::memory
@@ -62,6 +62,22 @@ const glm::vec2& Camera::getPosition() const {
     return position_;
 }
 
+/**
+ * @brief 设置缩放倍数
+ * @param zoom 新的缩放倍数
+ * @param screen_anchor 缩放前后保持不动的屏幕点
+ *
+ * @details 锚点下的世界坐标在缩放前后相同：position' = anchor_world - anchor / zoom'
+ */
+void Camera::setZoom(float zoom, std::optional<glm::vec2> screen_anchor)
+{
+    const glm::vec2 anchor = screen_anchor.value_or(glm::vec2(0.0f));
+    const glm::vec2 anchor_world = screenToWorld(anchor);
+    zoom_ = glm::clamp(zoom, MIN_ZOOM, MAX_ZOOM);
+    position_ = anchor_world - anchor / zoom_;
+    clampPosition();
+}
+
 /**
  * @brief 限制相机位置在边界内
  * 
@@ -77,7 +93,7 @@ void Camera::clampPosition()
     if (limit_bounds_.has_value() && limit_bounds_->size.x > 0 && limit_bounds_->size.y > 0) {
         // 计算允许的相机位置范围
         glm::vec2 min_cam_pos = limit_bounds_->position;
-        glm::vec2 max_cam_pos = limit_bounds_->position + limit_bounds_->size - viewport_size_;
+        glm::vec2 max_cam_pos = limit_bounds_->position + limit_bounds_->size - getViewSize();
 
         // 确保 max_cam_pos 不小于 min_cam_pos (视口可能比世界还大)
         max_cam_pos.x = std::max(min_cam_pos.x, max_cam_pos.x);
@@ -94,11 +110,11 @@ void Camera::clampPosition()
  * @return 转换后的屏幕坐标
  * 
  * @details
- * 计算方法：屏幕坐标 = 世界坐标 - 相机位置
+ * 计算方法：屏幕坐标 = (世界坐标 - 相机位置) * 缩放倍数
  */
 glm::vec2 Camera::worldToScreen(const glm::vec2& world_pos) const {
     // 将世界坐标减去相机左上角位置
-    return world_pos - position_;
+    return (world_pos - position_) * zoom_;
 }
 
 /**
@@ -108,14 +124,14 @@ glm::vec2 Camera::worldToScreen(const glm::vec2& world_pos) const {
  * @return 转换后的屏幕坐标（考虑视差效果）
  * 
  * @details
- * 计算方法：屏幕坐标 = 世界坐标 - 相机位置 * 视差因子
+ * 计算方法：屏幕坐标 = (世界坐标 - 相机位置 * 视差因子) * 缩放倍数
  * 视差因子小于1时，图层移动速度比相机慢，产生远景效果
  * 视差因子大于1时，图层移动速度比相机快，产生近景效果
  */
 glm::vec2 Camera::worldToScreenWithParallax(const glm::vec2 &world_pos, const glm::vec2 &scroll_factor) const
 {
     // 相机位置应用滚动因子
-    return world_pos - position_ * scroll_factor;
+    return (world_pos - position_ * scroll_factor) * zoom_;
 }
 
 /**
@@ -124,12 +140,12 @@ glm::vec2 Camera::worldToScreenWithParallax(const glm::vec2 &world_pos, const gl
  * @return 转换后的世界坐标
  * 
  * @details
- * 计算方法：世界坐标 = 屏幕坐标 + 相机位置
+ * 计算方法：世界坐标 = 屏幕坐标 / 缩放倍数 + 相机位置
  */
 glm::vec2 Camera::screenToWorld(const glm::vec2 &screen_pos) const
 {
-    // 将屏幕坐标加上相机左上角位置
-    return screen_pos + position_;
+    // 将屏幕坐标换算为世界长度后加上相机左上角位置
+    return screen_pos / zoom_ + position_;
 }
 
 /**
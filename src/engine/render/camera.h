@@ -9,6 +9,7 @@
  * - 支持视差滚动效果
  * - 限制相机移动范围
  * - 相机移动平滑过渡
+ * - 缩放：zoom_ 为屏幕像素 / 世界像素，视野的世界尺寸 = 视口大小 / zoom_
  * 
  * @see engine::system::RenderSystem 使用相机进行渲染的系统
  * @see engine::component::ParallaxComponent 与相机配合实现视差效果的组件
@@ -38,8 +39,12 @@ private:
     glm::vec2 position_;                                                     ///< 相机左上角的世界坐标
     std::optional<engine::utils::Rect> limit_bounds_;                        ///< 限制相机的移动范围，空值表示不限制
     float smooth_speed_ = 5.0f;                                              ///< 相机移动的平滑速度
+    float zoom_ = 1.0f;                                                      ///< 缩放倍数，小于 1 为拉远
 
 public:
+    static constexpr float MIN_ZOOM = 0.25f;    ///< 最远（4 倍视野）
+    static constexpr float MAX_ZOOM = 2.0f;
+
     /**
      * @brief 构造相机对象
      * @param viewport_size 视口大小
@@ -104,10 +109,33 @@ public:
     
     /**
      * @brief 获取视口大小
-     * @return 视口大小
+     * @return 视口大小（屏幕像素）
      */
     glm::vec2 getViewportSize() const;
 
+    /**
+     * @brief 设置缩放倍数（限制在 [MIN_ZOOM, MAX_ZOOM]）
+     * @param zoom 新的缩放倍数
+     * @param screen_anchor 缩放前后保持在同一屏幕位置的点（如鼠标位置），为空时以视口左上角为锚点
+     */
+    void setZoom(float zoom, std::optional<glm::vec2> screen_anchor = std::nullopt);
+
+    /**
+     * @brief 获取缩放倍数
+     * @return 屏幕像素 / 世界像素
+     */
+    float getZoom() const { return zoom_; }
+
+    /**
+     * @brief 获取视野的世界尺寸（视口大小 / 缩放倍数），剔除与流式加载按它计算
+     */
+    glm::vec2 getViewSize() const { return viewport_size_ / zoom_; }
+
+    /**
+     * @brief 获取视野的世界矩形
+     */
+    engine::utils::Rect getViewRect() const { return { position_, getViewSize() }; }
+
     /**
      * @brief 禁用拷贝和移动语义
      */
@@ -0,0 +1,108 @@
+#include "circle_mask_layer.h"
+#include "renderer.h"
+#include "camera.h"
+#include "image.h"
+#include "../resource/resource_id.h"
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+#include <glm/common.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace engine::render {
+
+namespace {
+    /// 遮罩四周留出的像素，线性过滤不会采样到边缘之外
+    constexpr int MASK_PADDING = 2;
+}
+
+void CircleMaskLayer::TextureDeleter::operator()(SDL_Texture* texture) const {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+    }
+}
+
+CircleMaskLayer::CircleMaskLayer(float resolution_scale)
+    : resolution_scale_(std::clamp(resolution_scale, 0.05f, 1.0f)) {}
+
+CircleMaskLayer::~CircleMaskLayer() = default;
+
+void CircleMaskLayer::setCircles(std::span<const Circle> circles) {
+    incoming_.clear();
+    for (const auto& circle : circles) {
+        if (circle.radius_ > 0.0f) {
+            incoming_.push_back(circle);
+        }
+    }
+    if (incoming_ != circles_) {
+        circles_.swap(incoming_);
+        dirty_ = true;
+    }
+}
+
+bool CircleMaskLayer::rebuild(Renderer& renderer) {
+    // 所有圆的世界包围盒，映射到遮罩像素
+    glm::vec2 world_min{ circles_.front().center_ - circles_.front().radius_ };
+    glm::vec2 world_max{ circles_.front().center_ + circles_.front().radius_ };
+    for (const auto& circle : circles_) {
+        world_min = glm::min(world_min, circle.center_ - circle.radius_);
+        world_max = glm::max(world_max, circle.center_ + circle.radius_);
+    }
+    const float padding = static_cast<float>(MASK_PADDING) / resolution_scale_;
+    origin_ = world_min - padding;
+    const glm::vec2 extent = (world_max - world_min + 2.0f * padding) * resolution_scale_;
+    used_size_ = { static_cast<int>(std::ceil(extent.x)), static_cast<int>(std::ceil(extent.y)) };
+
+    if (!texture_ || used_size_.x > texture_size_.x || used_size_.y > texture_size_.y) {
+        const glm::ivec2 size{ std::max(used_size_.x, texture_size_.x), std::max(used_size_.y, texture_size_.y) };
+        texture_.reset(renderer.createUICacheTexture(size));
+        if (!texture_) {
+            texture_size_ = { 0, 0 };
+            return false;
+        }
+        texture_size_ = size;
+        if (!SDL_SetTextureScaleMode(texture_.get(), SDL_SCALEMODE_LINEAR)) {
+            spdlog::warn("无法设置范围遮罩的缩放模式为线性插值：{}", SDL_GetError());
+        }
+    }
+
+    // 不透明白色的圆依次画入：重叠处仍为不透明，得到并集
+    static const Image circle_image(engine::resource::toResourceId("ui_circle"));
+    if (!renderer.beginRenderToTexture(texture_.get())) {
+        return false;
+    }
+    for (const auto& circle : circles_) {
+        const glm::vec2 top_left = (circle.center_ - circle.radius_ - origin_) * resolution_scale_;
+        const float diameter = circle.radius_ * 2.0f * resolution_scale_;
+        renderer.drawUIImage(circle_image, top_left, glm::vec2{ diameter, diameter });
+    }
+    renderer.endRenderToTexture();
+    ++rebuild_count_;
+    return true;
+}
+
+void CircleMaskLayer::draw(Renderer& renderer, const Camera& camera, const engine::utils::FColor& color) {
+    if (circles_.empty()) {
+        return;
+    }
+    if (dirty_ || !texture_) {
+        if (!rebuild(renderer)) {
+            return;
+        }
+        dirty_ = false;
+    }
+
+    // 遮罩为预乘 alpha 的白色：颜色调制也按预乘写入，整体透明度由 alpha 调制控制
+    SDL_SetTextureColorMod(texture_.get(),
+                           static_cast<Uint8>(color.r * color.a * 255.0f),
+                           static_cast<Uint8>(color.g * color.a * 255.0f),
+                           static_cast<Uint8>(color.b * color.a * 255.0f));
+    SDL_SetTextureAlphaMod(texture_.get(), static_cast<Uint8>(color.a * 255.0f));
+
+    const glm::vec2 size{ static_cast<float>(used_size_.x), static_cast<float>(used_size_.y) };
+    renderer.drawUITexture(texture_.get(),
+                           engine::utils::Rect{ glm::vec2{ 0.0f }, size },
+                           engine::utils::Rect{ camera.worldToScreen(origin_), size / resolution_scale_ * camera.getZoom() });
+}
+
+} // namespace engine::render
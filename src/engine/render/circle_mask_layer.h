@@ -0,0 +1,77 @@
+/**
+ * @file circle_mask_layer.h
+ * @brief 一组圆的并集遮罩：烘焙到低分辨率渲染目标，按需重建，一次绘制合成到世界中。
+ *
+ * @details
+ * 攻击范围这类半透明大圆逐个绘制时，重叠处会叠加变深，而且每个圆都是一次全尺寸的 alpha 混合。
+ * CircleMaskLayer 把所有圆以不透明白色画进一张低分辨率目标（并集，重叠处不叠加），
+ * 合成时按颜色调制整张遮罩一次绘制：
+ * - setCircles() 与上一次的圆列表逐项比较，只有变化时才标记重建
+ * - 遮罩覆盖所有圆的包围盒，分辨率为世界像素 × resolution_scale，纹理只增不减
+ * - 合成使用线性过滤放大，圆边缘保持平滑
+ *
+ * @code
+ * layer.setCircles(circles);                   // 每帧提交当前圆列表
+ * layer.draw(renderer, camera, RANGE_COLOR);   // 变化时重建，然后一次合成
+ * @endcode
+ */
+
+#pragma once
+#include "../utils/math.h"
+#include <glm/vec2.hpp>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+struct SDL_Texture;
+
+namespace engine::render {
+    class Renderer;
+    class Camera;
+
+    class CircleMaskLayer final {
+    public:
+        /// @brief 世界空间中的圆
+        struct Circle {
+            glm::vec2 center_{0.0f};
+            float radius_{0.0f};
+
+            bool operator==(const Circle&) const = default;
+        };
+
+        /// @param resolution_scale 遮罩像素与世界像素之比（0.25 即每 4×4 世界像素一个遮罩像素）
+        explicit CircleMaskLayer(float resolution_scale = 0.25f);
+        ~CircleMaskLayer();
+
+        CircleMaskLayer(const CircleMaskLayer&) = delete;
+        CircleMaskLayer& operator=(const CircleMaskLayer&) = delete;
+
+        /// @brief 提交当前的圆列表（半径非正的圆被忽略）；与上次相同时不触发重建
+        void setCircles(std::span<const Circle> circles);
+
+        /// @brief 需要时重建遮罩，然后以 color 合成到屏幕（一次绘制）
+        void draw(Renderer& renderer, const Camera& camera, const engine::utils::FColor& color);
+
+        [[nodiscard]] bool empty() const { return circles_.empty(); }
+        /// @brief 遮罩累计重建次数
+        [[nodiscard]] std::size_t getRebuildCount() const { return rebuild_count_; }
+
+    private:
+        struct TextureDeleter {
+            void operator()(SDL_Texture* texture) const;
+        };
+
+        bool rebuild(Renderer& renderer);   ///< @brief 把 circles_ 画进遮罩纹理
+
+        float resolution_scale_;
+        std::vector<Circle> circles_;           ///< 当前圆列表
+        std::vector<Circle> incoming_;          ///< setCircles 的比较缓冲（复用容量）
+        bool dirty_{false};
+        std::unique_ptr<SDL_Texture, TextureDeleter> texture_;
+        glm::ivec2 texture_size_{0, 0};         ///< 纹理实际尺寸（只增不减）
+        glm::ivec2 used_size_{0, 0};            ///< 本次遮罩使用的区域（像素）
+        glm::vec2 origin_{0.0f};                ///< 遮罩左上角对应的世界坐标
+        std::size_t rebuild_count_{0};
+    };
+} // namespace engine::render
@@ -0,0 +1,168 @@
+#include "frame_capture.h"
+#include "../core/task_pool.h"
+#include "../utils/profiler.h"
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <format>
+#include <system_error>
+#include <utility>
+
+namespace engine::render {
+
+namespace {
+
+/// @brief 文件名用的时间戳（UTC，精确到秒）
+std::string timestamp() {
+    return std::format("{:%Y%m%d_%H%M%S}", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+}
+
+} // namespace
+
+FrameCapture::FrameCapture(SDL_Renderer* renderer, engine::core::TaskPool* tasks, std::filesystem::path output_dir)
+    : renderer_(renderer), tasks_(tasks), output_dir_(std::move(output_dir)) {
+}
+
+FrameCapture::~FrameCapture() {
+    release();
+}
+
+void FrameCapture::setRecording(bool recording) {
+    if (recording == recording_) {
+        return;
+    }
+    recording_ = recording;
+    if (recording_) {
+        clip_dir_ = output_dir_ / ("clip_" + timestamp());
+        clip_frames_ = 0;
+        last_record_ns_ = 0;
+        spdlog::info("开始录制: {}（{} FPS）", clip_dir_.string(), RECORD_FPS);
+    } else {
+        spdlog::info("停止录制: {} 帧 -> {}", clip_frames_, clip_dir_.string());
+    }
+}
+
+SDL_Texture* FrameCapture::beginFrame(int width, int height) {
+    ++frame_;
+    const std::uint64_t now_ns = SDL_GetTicksNS();
+    const bool record = recording_ && now_ns - last_record_ns_ >= 1'000'000'000ull / RECORD_FPS;
+    if (!screenshot_requested_ && !record) {
+        return nullptr;
+    }
+    Slot& slot = ring_[frame_ % RING_SIZE];
+    if (slot.pending_ || encodes_.size() >= MAX_PENDING_ENCODES) {
+        // 读回或编码跟不上：宁可丢帧也不等待
+        ++stats_.dropped_;
+        return nullptr;
+    }
+    if (!ensureTexture(slot, width, height)) {
+        return nullptr;
+    }
+    if (screenshot_requested_) {
+        screenshot_requested_ = false;
+        slot.path_ = output_dir_ / std::format("screenshot_{}_{}.png", timestamp(), frame_);
+    } else {
+        last_record_ns_ = now_ns;
+        slot.path_ = clip_dir_ / std::format("frame_{:06}.png", clip_frames_++);
+    }
+    slot.frame_ = frame_;
+    slot.pending_ = true;
+    return slot.texture_;
+}
+
+void FrameCapture::endFrame() {
+    collectEncodes();
+    for (auto& slot : ring_) {
+        if (slot.pending_ && frame_ >= slot.frame_ + READBACK_DELAY) {
+            readback(slot);
+        }
+    }
+}
+
+void FrameCapture::release() {
+    for (auto& slot : ring_) {
+        if (slot.pending_) {
+            readback(slot);
+        }
+    }
+    for (auto& encode : encodes_) {
+        encode.wait();
+    }
+    collectEncodes();
+    for (auto& slot : ring_) {
+        if (slot.texture_) {
+            SDL_DestroyTexture(slot.texture_);
+            slot.texture_ = nullptr;
+        }
+    }
+    if (stats_.captured_ > 0) {
+        spdlog::info("帧捕获: 读回 {} 帧，写入 {} 帧，丢弃 {} 帧", stats_.captured_, stats_.written_, stats_.dropped_);
+    }
+    stats_ = {};
+}
+
+bool FrameCapture::ensureTexture(Slot& slot, int width, int height) {
+    if (slot.texture_ && slot.width_ == width && slot.height_ == height) {
+        return true;
+    }
+    if (slot.texture_) {
+        SDL_DestroyTexture(slot.texture_);
+    }
+    slot.texture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!slot.texture_) {
+        spdlog::error("创建捕获暂存纹理失败 ({}x{})：{}", width, height, SDL_GetError());
+        return false;
+    }
+    // 整张不透明地贴回窗口
+    SDL_SetTextureBlendMode(slot.texture_, SDL_BLENDMODE_NONE);
+    slot.width_ = width;
+    slot.height_ = height;
+    return true;
+}
+
+void FrameCapture::readback(Slot& slot) {
+    ENGINE_PROFILE_SCOPE("FrameCapture::readback");
+    slot.pending_ = false;
+    const auto start = std::chrono::steady_clock::now();
+    SDL_Texture* previous = SDL_GetRenderTarget(renderer_);
+    SDL_Surface* surface = nullptr;
+    if (SDL_SetRenderTarget(renderer_, slot.texture_)) {
+        surface = SDL_RenderReadPixels(renderer_, nullptr);
+    }
+    SDL_SetRenderTarget(renderer_, previous);
+    stats_.readback_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (!surface) {
+        spdlog::error("读回捕获帧失败：{}", SDL_GetError());
+        ++stats_.dropped_;
+        return;
+    }
+    ++stats_.captured_;
+    encodes_.push_back(engine::core::runAsync(tasks_, engine::core::TaskPriority::BACKGROUND,
+        [surface, path = std::move(slot.path_)] {
+            std::error_code error;
+            std::filesystem::create_directories(path.parent_path(), error);
+            const bool ok = IMG_SavePNG(surface, path.string().c_str());
+            if (!ok) {
+                spdlog::error("写入捕获帧失败 {}：{}", path.string(), SDL_GetError());
+            }
+            SDL_DestroySurface(surface);
+            return ok;
+        }));
+}
+
+void FrameCapture::collectEncodes() {
+    std::erase_if(encodes_, [this](std::future<bool>& encode) {
+        if (encode.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+        if (encode.get()) {
+            ++stats_.written_;
+        } else {
+            ++stats_.dropped_;
+        }
+        return true;
+    });
+}
+
+} // namespace engine::render
@@ -0,0 +1,117 @@
+#pragma once
+/**
+ * @file frame_capture.h
+ * @brief 截图与连续录帧：场景画在暂存纹理环上，几帧之后再读回，PNG 编码交给后台线程。
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <string>
+#include <vector>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+
+namespace engine::core {
+    class TaskPool;
+}
+
+namespace engine::render {
+
+/// @brief 捕获统计（调试面板与退出日志）
+struct FrameCaptureStats {
+    std::uint64_t captured_{ 0 };   ///< 已读回并提交编码的帧数
+    std::uint64_t written_{ 0 };    ///< 编码并写盘成功的帧数
+    std::uint64_t dropped_{ 0 };    ///< 编码积压或暂存纹理仍在使用而丢弃的帧数
+    double readback_ms_{ 0.0 };     ///< 最近一次读回在主线程上的耗时
+};
+
+/**
+ * @class FrameCapture
+ * @brief 不阻塞渲染管线的帧捕获。
+ *
+ * @details
+ * SDL_Renderer 不能直接复制窗口的后台缓冲，读回当帧画面（SDL_RenderReadPixels）要等 GPU 画完这一帧。
+ * 因此需要捕获的帧由 GameApp 经 Renderer::setFrameTarget() 把场景画到环中的一张暂存纹理（逻辑分辨率），
+ * 再整张贴回窗口（ImGui 在其后绘制，不进入画面）；该纹理在 READBACK_DELAY 帧之后才读回，
+ * 此时它的绘制命令早已随之前的 present 执行完，读回只剩拷贝，不再等待正在进行的帧。
+ * 读回得到的表面交给 TaskPool 的后台线程以 PNG 写盘（IMG_SavePNG），主线程不做编码。
+ *
+ * - 截图：requestScreenshot()，写到 <输出目录>/screenshot_<时间>.png
+ * - 录制：setRecording(true)，按 RECORD_FPS 抽帧写到 <输出目录>/clip_<时间>/frame_NNNNNN.png，
+ *   可直接用 ffmpeg -framerate 30 -i frame_%06d.png 合成视频
+ * 编码积压超过 MAX_PENDING_ENCODES 时丢帧（计入 dropped_），不让后台线程拖慢主循环。
+ */
+class FrameCapture final {
+public:
+    static constexpr std::size_t RING_SIZE = 3;                 ///< 暂存纹理数：本帧与仍在等待读回的帧
+    static constexpr std::uint64_t READBACK_DELAY = 2;          ///< 绘制后第几帧读回
+    static constexpr std::size_t MAX_PENDING_ENCODES = 8;       ///< 同时排队的编码任务上限
+    static constexpr int RECORD_FPS = 30;                       ///< 录制时的抽帧频率
+
+    /**
+     * @param renderer SDL 渲染器（暂存纹理的创建与读回）
+     * @param tasks 编码用的线程池，nullptr 时退回 std::async
+     * @param output_dir 输出目录，不存在时自动创建
+     */
+    FrameCapture(SDL_Renderer* renderer, engine::core::TaskPool* tasks, std::filesystem::path output_dir);
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    /// @brief 下一帧截图一次
+    void requestScreenshot() { screenshot_requested_ = true; }
+
+    /// @brief 开始 / 停止录制；开始时新建 clip_<时间> 目录
+    void setRecording(bool recording);
+    [[nodiscard]] bool isRecording() const { return recording_; }
+
+    /**
+     * @brief 帧首调用：本帧需要捕获时返回环中的暂存纹理（调用方以 setFrameTarget() 画到其上），否则返回 nullptr
+     * @param width 逻辑分辨率宽度
+     * @param height 逻辑分辨率高度
+     */
+    [[nodiscard]] SDL_Texture* beginFrame(int width, int height);
+
+    /// @brief present 之后调用：读回已满 READBACK_DELAY 帧的暂存纹理并提交编码
+    void endFrame();
+
+    /// @brief 读回所有未读回的帧、等待编码完成并销毁暂存纹理（需在 SDL_DestroyRenderer 之前调用）
+    void release();
+
+    [[nodiscard]] const FrameCaptureStats& getStats() const { return stats_; }
+
+private:
+    struct Slot {
+        SDL_Texture* texture_{ nullptr };
+        int width_{ 0 };
+        int height_{ 0 };
+        std::uint64_t frame_{ 0 };      ///< 绘制该纹理的帧序号
+        std::filesystem::path path_;    ///< 读回后写入的文件
+        bool pending_{ false };         ///< 已绘制、尚未读回
+    };
+
+    [[nodiscard]] bool ensureTexture(Slot& slot, int width, int height);
+    void readback(Slot& slot);
+    /// @brief 回收已完成的编码任务
+    void collectEncodes();
+
+    SDL_Renderer* renderer_;
+    engine::core::TaskPool* tasks_;
+    std::filesystem::path output_dir_;
+    std::array<Slot, RING_SIZE> ring_{};
+    std::vector<std::future<bool>> encodes_;
+    std::uint64_t frame_{ 0 };
+    bool screenshot_requested_{ false };
+    bool recording_{ false };
+    std::filesystem::path clip_dir_;
+    std::uint64_t clip_frames_{ 0 };
+    std::uint64_t last_record_ns_{ 0 };
+    FrameCaptureStats stats_;
+};
+
+} // namespace engine::render
@@ -175,4 +175,15 @@ namespace engine::render {
 		 */
 		void setIsFlipped(bool is_flipped) { is_flipped_ = is_flipped; }
 	};
+
+	/**
+	 * @struct UINineSlice
+	 * @brief 九宫格切分：源图四边各留多少像素不拉伸（角保持原尺寸，边沿单轴拉伸，中心双轴拉伸）
+	 */
+	struct UINineSlice {
+		float left_{0.0f};
+		float top_{0.0f};
+		float right_{0.0f};
+		float bottom_{0.0f};
+	};
 }
\ No newline at end of file
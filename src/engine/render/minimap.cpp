@@ -0,0 +1,146 @@
+#include "minimap.h"
+#include "camera.h"
+#include "../component/sprite_component.h"
+#include "../component/tilelayer_component.h"
+#include "../component/transform_component.h"
+#include "../spatial/spatial_grid.h"
+#include <SDL3/SDL.h>
+#include <entt/entity/registry.hpp>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace engine::render {
+
+namespace {
+    constexpr float MARKER_SIZE = 3.0f;             ///< 单位点边长（小地图像素）
+    constexpr float PATH_DOT_SIZE = 1.0f;           ///< 路径点边长
+    constexpr float PATH_DOT_SPACING = 2.0f;        ///< 路径采样间距（小地图像素）
+    constexpr float VIEW_LINE_WIDTH = 1.0f;         ///< 视野框线宽
+    constexpr engine::utils::FColor PATH_COLOR{ 0.95f, 0.85f, 0.45f, 0.9f };
+    constexpr engine::utils::FColor VIEW_COLOR{ 1.0f, 1.0f, 1.0f, 0.9f };
+    constexpr engine::utils::FColor FRAME_COLOR{ 0.0f, 0.0f, 0.0f, 0.6f };
+
+    /// 绘制一个 SpriteComponent + TransformComponent 实体到当前渲染目标（与 RenderSystem 相同的位置/大小规则）
+    void drawScaled(Renderer& renderer, const entt::registry& registry, entt::entity entity, float scale) {
+        if (entity == entt::null) {
+            return;
+        }
+        const auto* sprite = registry.try_get<engine::component::SpriteComponent>(entity);
+        const auto* transform = registry.try_get<engine::component::TransformComponent>(entity);
+        if (!sprite || !transform) {
+            return;
+        }
+        const glm::vec2 position = transform->position_ + sprite->offset_;
+        const glm::vec2 size = sprite->size_ * transform->scale_;
+        renderer.drawSpriteToTarget(sprite->sprite_, position * scale, size * scale);
+    }
+}
+
+void Minimap::TextureDeleter::operator()(SDL_Texture* texture) const {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+    }
+}
+
+Minimap::Minimap(float max_extent) : max_extent_(std::max(max_extent, 16.0f)) {}
+
+Minimap::~Minimap() = default;
+
+void Minimap::setWorld(glm::vec2 world_size) {
+    world_size_ = glm::max(world_size, glm::vec2{ 0.0f });
+    const float long_edge = std::max(world_size_.x, world_size_.y);
+    scale_ = long_edge > 0.0f ? max_extent_ / long_edge : 0.0f;
+    size_ = glm::ceil(world_size_ * scale_);
+    texture_.reset();
+    dirty_ = true;
+}
+
+void Minimap::setPaths(std::vector<std::pair<glm::vec2, glm::vec2>> segments) {
+    paths_ = std::move(segments);
+    dirty_ = true;
+}
+
+bool Minimap::bake(Renderer& renderer, entt::registry& registry) {
+    if (!texture_) {
+        texture_.reset(renderer.createUICacheTexture(glm::ivec2{ size_ }));
+        if (!texture_) {
+            return false;
+        }
+        // 底图只缩小不放大，最近邻采样保持瓦片边缘清晰
+        SDL_SetTextureScaleMode(texture_.get(), SDL_SCALEMODE_NEAREST);
+    }
+    if (!renderer.beginRenderToTexture(texture_.get())) {
+        return false;
+    }
+    // 图层按创建顺序（即 Tiled 中的顺序）叠加；已烘焙的区块整块缩小，其余瓦片逐个绘制
+    registry.view<engine::component::TileLayerComponent>().each([&](const auto& layer) {
+        for (const auto& chunk : layer.chunks_) {
+            drawScaled(renderer, registry, chunk.entity_, scale_);
+        }
+        for (const auto tile : layer.tiles_) {
+            drawScaled(renderer, registry, tile, scale_);
+        }
+    });
+
+    rects_.clear();
+    for (const auto& [from, to] : paths_) {
+        const glm::vec2 a = from * scale_;
+        const glm::vec2 b = to * scale_;
+        const int steps = std::max(1, static_cast<int>(glm::distance(a, b) / PATH_DOT_SPACING));
+        for (int i = 0; i <= steps; ++i) {
+            const glm::vec2 point = a + (b - a) * (static_cast<float>(i) / static_cast<float>(steps));
+            rects_.push_back({ engine::utils::Rect{ point - PATH_DOT_SIZE * 0.5f, glm::vec2{ PATH_DOT_SIZE } }, PATH_COLOR });
+        }
+    }
+    renderer.drawUIFilledRects(rects_);
+    renderer.endRenderToTexture();
+    ++bake_count_;
+    return true;
+}
+
+void Minimap::draw(Renderer& renderer, entt::registry& registry, const Camera& camera,
+                   const engine::spatial::SpatialGrid& grid, std::span<const MarkerStyle> styles,
+                   glm::vec2 screen_position) {
+    if (scale_ <= 0.0f || size_.x < 1.0f || size_.y < 1.0f) {
+        return;
+    }
+    if (dirty_ || !texture_) {
+        if (!bake(renderer, registry)) {
+            return;
+        }
+        dirty_ = false;
+    }
+
+    renderer.drawUIFilledRect(engine::utils::Rect{ screen_position - 1.0f, size_ + 2.0f }, FRAME_COLOR);
+    renderer.drawUITexture(texture_.get(),
+                           engine::utils::Rect{ glm::vec2{ 0.0f }, size_ },
+                           engine::utils::Rect{ screen_position, size_ });
+
+    // 单位点与视野框合并为一次几何提交
+    rects_.clear();
+    for (const auto& entry : grid.getEntries()) {
+        const auto style = std::find_if(styles.begin(), styles.end(),
+                                        [&](const MarkerStyle& s) { return (entry.mask_ & s.mask_) != 0; });
+        if (style == styles.end()) {
+            continue;
+        }
+        const glm::vec2 point = glm::clamp(entry.position_ * scale_, glm::vec2{ 0.0f }, size_);
+        rects_.push_back({ engine::utils::Rect{ screen_position + point - MARKER_SIZE * 0.5f, glm::vec2{ MARKER_SIZE } },
+                           style->color_ });
+    }
+
+    const glm::vec2 view_min = glm::clamp(camera.getPosition() * scale_, glm::vec2{ 0.0f }, size_);
+    const glm::vec2 view_max = glm::clamp((camera.getPosition() + camera.getViewSize()) * scale_,
+                                          glm::vec2{ 0.0f }, size_);
+    const glm::vec2 view_size = view_max - view_min;
+    const glm::vec2 origin = screen_position + view_min;
+    rects_.push_back({ engine::utils::Rect{ origin, { view_size.x, VIEW_LINE_WIDTH } }, VIEW_COLOR });
+    rects_.push_back({ engine::utils::Rect{ { origin.x, origin.y + view_size.y - VIEW_LINE_WIDTH }, { view_size.x, VIEW_LINE_WIDTH } }, VIEW_COLOR });
+    rects_.push_back({ engine::utils::Rect{ origin, { VIEW_LINE_WIDTH, view_size.y } }, VIEW_COLOR });
+    rects_.push_back({ engine::utils::Rect{ { origin.x + view_size.x - VIEW_LINE_WIDTH, origin.y }, { VIEW_LINE_WIDTH, view_size.y } }, VIEW_COLOR });
+    renderer.drawUIFilledRects(rects_);
+}
+
+} // namespace engine::render
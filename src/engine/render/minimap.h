@@ -0,0 +1,95 @@
+/**
+ * @file minimap.h
+ * @brief 小地图：静态瓦片层烘焙到低分辨率渲染目标，动态单位从空间网格读取后以一次几何提交绘制成点。
+ *
+ * @details
+ * - 烘焙：所有 TileLayerComponent 的区块实体与未烘焙瓦片实体按缩放比例画进一张渲染目标，
+ *   路径线段按小地图像素采样成点一并画入；只在 setWorld() / setPaths() / invalidate() 之后的第一次 draw() 执行
+ * - 每帧：贴一次烘焙纹理，再把空间网格中匹配各样式掩码的条目与相机视野框合并为一次 drawUIFilledRects()
+ *
+ * 不重新运行 RenderSystem，逐帧开销与单位数成正比且只是几个浮点运算。
+ *
+ * @code
+ * minimap.setWorld(world_size);
+ * minimap.setPaths(segments);
+ * minimap.draw(renderer, registry, camera, grid, styles, screen_position);
+ * @endcode
+ */
+
+#pragma once
+#include "renderer.h"
+#include "../utils/math.h"
+#include <entt/entity/fwd.hpp>
+#include <glm/vec2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+struct SDL_Texture;
+
+namespace engine::spatial {
+    class SpatialGrid;
+}
+
+namespace engine::render {
+    class Camera;
+
+    class Minimap final {
+    public:
+        /// @brief 空间网格条目的显示样式：条目掩码与 mask_ 按位与非零时按该颜色绘制（取第一个匹配的样式）
+        struct MarkerStyle {
+            std::uint32_t mask_{0};
+            engine::utils::FColor color_{};
+        };
+
+        /// @param max_extent 小地图长边的像素数
+        explicit Minimap(float max_extent = 192.0f);
+        ~Minimap();
+
+        Minimap(const Minimap&) = delete;
+        Minimap& operator=(const Minimap&) = delete;
+
+        /// @brief 设置地图的世界尺寸（像素），并标记重新烘焙
+        void setWorld(glm::vec2 world_size);
+        /// @brief 设置要烘焙进底图的路径线段（世界坐标），并标记重新烘焙
+        void setPaths(std::vector<std::pair<glm::vec2, glm::vec2>> segments);
+        /// @brief 地图内容变化（瓦片被替换等）后调用，下一次 draw() 重新烘焙
+        void invalidate() { dirty_ = true; }
+
+        /// @brief 小地图在屏幕上的尺寸（未设置世界尺寸时为 0）
+        [[nodiscard]] glm::vec2 getSize() const { return size_; }
+        /// @brief 累计烘焙次数
+        [[nodiscard]] std::size_t getBakeCount() const { return bake_count_; }
+
+        /**
+         * @brief 需要时重新烘焙，然后绘制底图、单位点与相机视野框
+         * @param registry 读取瓦片图层（仅烘焙时）
+         * @param grid 动态单位的来源
+         * @param styles 单位点的样式，按顺序匹配
+         * @param screen_position 小地图左上角的屏幕坐标
+         */
+        void draw(Renderer& renderer, entt::registry& registry, const Camera& camera,
+                  const engine::spatial::SpatialGrid& grid, std::span<const MarkerStyle> styles,
+                  glm::vec2 screen_position);
+
+    private:
+        struct TextureDeleter {
+            void operator()(SDL_Texture* texture) const;
+        };
+
+        bool bake(Renderer& renderer, entt::registry& registry);
+
+        float max_extent_;
+        glm::vec2 world_size_{0.0f};
+        glm::vec2 size_{0.0f};                  ///< 小地图像素尺寸
+        float scale_{0.0f};                     ///< 小地图像素 / 世界像素
+        std::vector<std::pair<glm::vec2, glm::vec2>> paths_;
+        std::unique_ptr<SDL_Texture, TextureDeleter> texture_;
+        bool dirty_{true};
+        std::vector<UIFilledRect> rects_;       ///< 每帧的点与视野框（复用容量）
+        std::size_t bake_count_{0};
+    };
+} // namespace engine::render
@@ -0,0 +1,142 @@
+#include "render_command_list.h"
+#include "../core/job_system.h"
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace engine::render {
+
+namespace {
+    /// 每块展开的命令数；少于两块时串行展开，避免调度开销超过收益
+    constexpr std::size_t EXPAND_GRAIN = 2048;
+}
+
+void RenderCommandList::add(SDL_Texture* texture, glm::vec2 texture_size, glm::vec2 offset, const SpriteCommand& command) {
+    if (runs_.empty() || runs_.back().texture_ != texture || runs_.back().offset_ != offset) {
+        runs_.push_back(Run{texture, {1.0f / texture_size.x, 1.0f / texture_size.y}, offset, commands_.size(), 0});
+    }
+    commands_.push_back(command);
+    Run& run = runs_.back();
+    ++run.count_;
+    run.rotated_ = run.rotated_ || command.angle_ != 0.0f;
+    run.flipped_ = run.flipped_ || command.flip_;
+}
+
+void RenderCommandList::expand(const Run& run, std::size_t begin, std::size_t end) {
+    if (run.rotated_) {
+        run.flipped_ ? expandPath<true, true>(run, begin, end) : expandPath<true, false>(run, begin, end);
+    } else {
+        run.flipped_ ? expandPath<false, true>(run, begin, end) : expandPath<false, false>(run, begin, end);
+    }
+}
+
+/**
+ * 旋转以目标矩形中心为轴（与 SDL_RenderTextureRotated 一致），水平翻转通过交换左右 UV 实现，
+ * 着色直接写入顶点颜色，无需修改纹理状态。不含旋转的段直接写四个角，
+ * 不含翻转的段不检查翻转标志。
+ */
+template <bool Rotated, bool Flipped>
+void RenderCommandList::expandPath(const Run& run, std::size_t begin, std::size_t end) {
+    SDL_Vertex* out = vertices_.data() + begin * 4;
+    for (std::size_t i = begin; i < end; ++i) {
+        const auto& command = commands_[i];
+        float u0 = command.src_.x * run.inv_texture_size_.x;
+        float u1 = (command.src_.x + command.src_.w) * run.inv_texture_size_.x;
+        const float v0 = command.src_.y * run.inv_texture_size_.y;
+        const float v1 = (command.src_.y + command.src_.h) * run.inv_texture_size_.y;
+        if constexpr (Flipped) {
+            if (command.flip_) {
+                std::swap(u0, u1);
+            }
+        }
+
+        if constexpr (!Rotated) {
+            const float x0 = command.dest_.x + run.offset_.x;
+            const float y0 = command.dest_.y + run.offset_.y;
+            const float x1 = x0 + command.dest_.w;
+            const float y1 = y0 + command.dest_.h;
+            out[0] = SDL_Vertex{ { x0, y0 }, command.tint_, { u0, v0 } };
+            out[1] = SDL_Vertex{ { x1, y0 }, command.tint_, { u1, v0 } };
+            out[2] = SDL_Vertex{ { x1, y1 }, command.tint_, { u1, v1 } };
+            out[3] = SDL_Vertex{ { x0, y1 }, command.tint_, { u0, v1 } };
+            out += 4;
+        } else {
+            const glm::vec2 half{ command.dest_.w * 0.5f, command.dest_.h * 0.5f };
+            const glm::vec2 center{ command.dest_.x + run.offset_.x + half.x, command.dest_.y + run.offset_.y + half.y };
+            const glm::vec2 corners[4] = {
+                { -half.x, -half.y }, { half.x, -half.y }, { half.x, half.y }, { -half.x, half.y }
+            };
+            const glm::vec2 uvs[4] = { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+
+            float cos_a = 1.0f;
+            float sin_a = 0.0f;
+            if (command.angle_ != 0.0f) {
+                constexpr float deg_to_rad = 3.14159265358979323846f / 180.0f;
+                cos_a = std::cos(command.angle_ * deg_to_rad);
+                sin_a = std::sin(command.angle_ * deg_to_rad);
+            }
+            for (int corner = 0; corner < 4; ++corner) {
+                const glm::vec2& c = corners[corner];
+                // 屏幕坐标 y 轴向下，正角度为顺时针旋转
+                out->position.x = center.x + c.x * cos_a - c.y * sin_a;
+                out->position.y = center.y + c.x * sin_a + c.y * cos_a;
+                out->color = command.tint_;
+                out->tex_coord.x = uvs[corner].x;
+                out->tex_coord.y = uvs[corner].y;
+                ++out;
+            }
+        }
+    }
+}
+
+std::size_t RenderCommandList::submit(SDL_Renderer* renderer, engine::core::JobSystem* jobs) {
+    if (commands_.empty()) {
+        runs_.clear();
+        return 0;
+    }
+
+    // 1. 展开顶点：按固定大小分块，块不跨段（每块只需知道所属段的 UV 归一化系数）
+    vertices_.resize(commands_.size() * 4);
+    chunks_.clear();
+    std::size_t longest_run = 0;
+    for (std::size_t r = 0; r < runs_.size(); ++r) {
+        const Run& run = runs_[r];
+        longest_run = std::max(longest_run, run.count_);
+        for (std::size_t begin = run.first_; begin < run.first_ + run.count_; begin += EXPAND_GRAIN) {
+            chunks_.push_back(Chunk{r, begin, std::min(begin + EXPAND_GRAIN, run.first_ + run.count_)});
+        }
+    }
+    if (jobs && jobs->getThreadCount() > 1 && chunks_.size() > 1) {
+        jobs->parallelFor(chunks_.size(), [this](std::size_t index) {
+            const Chunk& chunk = chunks_[index];
+            expand(runs_[chunk.run_], chunk.begin_, chunk.end_);
+        });
+    } else {
+        for (const auto& run : runs_) {
+            expand(run, run.first_, run.first_ + run.count_);
+        }
+    }
+
+    // 2. 固定模式的索引只依赖段长，所有段共用
+    for (int quad = static_cast<int>(indices_.size() / 6); quad < static_cast<int>(longest_run); ++quad) {
+        const int base = quad * 4;
+        indices_.insert(indices_.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+    }
+
+    // 3. 逐段提交，顶点指针指向段首，保持记录顺序
+    for (const auto& run : runs_) {
+        if (!SDL_RenderGeometry(renderer, run.texture_,
+                                vertices_.data() + run.first_ * 4, static_cast<int>(run.count_ * 4),
+                                indices_.data(), static_cast<int>(run.count_ * 6))) {
+            spdlog::error("批量渲染精灵失败：{}", SDL_GetError());
+        }
+    }
+    const std::size_t draw_calls = runs_.size();
+    commands_.clear();
+    runs_.clear();
+    return draw_calls;
+}
+
+} // namespace engine::render
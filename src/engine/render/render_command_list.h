@@ -0,0 +1,91 @@
+/**
+ * @file render_command_list.h
+ * @brief 一帧内世界精灵的绘制命令列表：记录与提交分离，顶点展开可分块并行。
+ *
+ * @details
+ * 批处理期间 Renderer::drawSprite() 只把纹理已解析好的定长命令（世界空间目标矩形、源矩形、旋转、颜色、翻转）
+ * 追加到列表里，相邻的同纹理、同相机偏移的命令归为一段。提交时：
+ * 1. 所有命令一次性展开为顶点（每条命令固定占 4 个顶点，互不依赖，命令数足够多时交给 JobSystem 分块并行）；
+ *    相机变换以段的偏移量在展开时统一加上。每段按记录时汇总的标志选择展开路径：
+ *    没有旋转的段只写轴对齐的四个角（不做三角运算），再按是否含翻转命令区分是否检查 UV 交换
+ * 2. 按段依次调用 SDL_RenderGeometry，每段一次（段内共用同一份固定模式的索引缓冲）
+ *
+ * 绘制顺序与逐个提交完全一致。列表与缓冲跨帧复用容量。
+ */
+
+#pragma once
+#include <SDL3/SDL_render.h>
+#include <cstddef>
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace engine::core {
+    class JobSystem;
+}
+
+namespace engine::render {
+
+    /**
+     * @struct SpriteCommand
+     * @brief 一条屏幕空间的精灵绘制命令
+     */
+    struct SpriteCommand {
+        SDL_FRect dest_;        ///< 目标矩形（加上段偏移后为屏幕坐标）
+        SDL_FRect src_;         ///< 纹理（图集页）内的源矩形，像素
+        float angle_;           ///< 绕目标矩形中心的旋转角度（度）
+        SDL_FColor tint_;       ///< 顶点颜色
+        bool flip_;             ///< 是否水平翻转
+    };
+
+    class RenderCommandList final {
+    public:
+        /**
+         * @brief 追加一条命令；纹理或偏移与上一条不同时开启新的一段
+         * @param texture 命令使用的纹理（图集页）
+         * @param texture_size 纹理尺寸，用于归一化 UV
+         * @param offset 展开时加到目标矩形上的偏移（世界坐标到屏幕坐标，即负的相机位置）
+         */
+        void add(SDL_Texture* texture, glm::vec2 texture_size, glm::vec2 offset, const SpriteCommand& command);
+
+        /**
+         * @brief 展开顶点并逐段提交，然后清空列表
+         * @param renderer SDL 渲染器（只能在创建它的线程调用）
+         * @param jobs 用于并行展开顶点的任务系统，为空时串行
+         * @return 发出的 SDL_RenderGeometry 调用次数
+         */
+        std::size_t submit(SDL_Renderer* renderer, engine::core::JobSystem* jobs);
+
+        [[nodiscard]] bool empty() const { return commands_.empty(); }
+        [[nodiscard]] std::size_t size() const { return commands_.size(); }
+
+    private:
+        /// @brief 一段连续的同纹理命令
+        struct Run {
+            SDL_Texture* texture_{nullptr};
+            glm::vec2 inv_texture_size_{0.0f};
+            glm::vec2 offset_{0.0f};
+            std::size_t first_{0};
+            std::size_t count_{0};
+            bool rotated_{false};       ///< 段内有旋转的命令
+            bool flipped_{false};       ///< 段内有翻转的命令
+        };
+
+        /// @brief 并行展开的一块命令（不跨段）
+        struct Chunk {
+            std::size_t run_{0};
+            std::size_t begin_{0};
+            std::size_t end_{0};
+        };
+
+        void expand(const Run& run, std::size_t begin, std::size_t end);   ///< @brief 按段标志选择路径展开 [begin, end)
+        template <bool Rotated, bool Flipped>
+        void expandPath(const Run& run, std::size_t begin, std::size_t end);
+
+        std::vector<SpriteCommand> commands_;
+        std::vector<Run> runs_;
+        std::vector<Chunk> chunks_;                 ///< 本次提交的展开分块
+        std::vector<SDL_Vertex> vertices_;          ///< 展开后的顶点（第 i 条命令占 [4i, 4i + 4)）
+        std::vector<int> indices_;                  ///< 固定模式的四边形索引，只在最长段变长时追加
+    };
+
+} // namespace engine::render
@@ -0,0 +1,109 @@
+#pragma once
+/**
+ * @file render_state.h
+ * @brief 模拟与渲染之间交接的绘制快照，以及无锁的三缓冲交换。
+ *
+ * @details
+ * 模拟更新结束时，RenderSystem::extract() 把可绘制实体的最小绘制数据（位置、大小、旋转、精灵帧、
+ * 着色、排序键）拷贝进一个 RenderStateFrame，之后的剔除、排序与绘制只读快照，不再访问 entt::registry。
+ * 每个条目同时记录上一模拟步与本步结束时的位置，渲染按插值系数在两者之间插值，不需要按实体匹配两份快照。
+ *
+ * RenderStateBuffers 持有三份快照：写入端（模拟）、读取端（渲染）各占一份，第三份是交接位。
+ * publish() 与 acquire() 各是一次原子交换：模拟可以连续发布多份（只保留最新的），渲染取不到新快照时
+ * 继续使用手上的一份；两端从不读写同一份快照，渲染线程与模拟线程分离后也无需加锁。
+ *
+ * @code
+ * auto& frame = buffers.beginWrite();      // 模拟线程
+ * frame.entries_.clear();
+ * // ... 填写 frame ...
+ * buffers.publish();
+ *
+ * if (const auto* frame = buffers.acquire()) {   // 渲染线程
+ *     for (const auto& entry : frame->entries_) { ... }
+ * }
+ * @endcode
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <entt/entity/entity.hpp>
+#include <glm/vec2.hpp>
+#include "../component/sheet_animation_component.h"
+#include "../component/sprite_component.h"
+#include "../utils/math.h"
+
+namespace engine::render {
+
+/// @brief 一个可绘制实体在某次模拟更新结束时的绘制数据（可平凡拷贝）
+struct RenderStateEntry {
+    entt::entity entity_{ entt::null };         ///< 只作为跨帧绘制顺序的键，渲染端不用它访问注册表
+    component::Sprite sprite_{};                ///< 精灵帧（纹理与源矩形）的拷贝
+    glm::vec2 previous_position_{ 0.0f };       ///< 上一模拟步结束时的绘制位置（不插值时与 position_ 相同）
+    glm::vec2 position_{ 0.0f };                ///< 本步结束时的绘制位置（已加精灵偏移）
+    glm::vec2 size_{ 0.0f };                    ///< 绘制大小（已乘变换缩放）
+    float angle_{ 0.0f };
+    utils::Color8 tint_{};
+    std::uint64_t sort_key_{ 0 };
+    std::uint32_t sheet_{ NO_SHEET };           ///< RenderStateFrame::sheets_ 下标：绘制时按动画时钟计算源矩形
+    utils::Color8 lod_icon_{ 0.0f, 0.0f, 0.0f, 0.0f };  ///< 远景图标颜色（LodIconComponent），透明表示没有图标
+
+    static constexpr std::uint32_t NO_SHEET = UINT32_MAX;
+};
+
+/// @brief 一次模拟更新提取出的全部绘制数据
+struct RenderStateFrame {
+    std::vector<RenderStateEntry> entries_;
+    std::vector<component::SheetAnimationComponent> sheets_;   ///< 精灵表动画条目的属性（多数条目没有）
+    std::uint64_t tick_{ 0 };                   ///< 提取时的模拟步序号；与渲染时的序号不符时不插值
+    double animation_time_ms_{ 0.0 };           ///< 提取时的动画时钟（SheetAnimationComponent）
+};
+
+class RenderStateBuffers final {
+public:
+    RenderStateBuffers() = default;
+    RenderStateBuffers(const RenderStateBuffers&) = delete;
+    RenderStateBuffers& operator=(const RenderStateBuffers&) = delete;
+
+    /// @brief 写入端：取得可写的快照（内容为三帧前的旧数据，容量复用）
+    [[nodiscard]] RenderStateFrame& beginWrite() { return frames_[write_index_]; }
+
+    /// @brief 写入端：发布 beginWrite() 写好的快照，换回交接位上的一份继续写
+    void publish() {
+        write_index_ = static_cast<std::uint8_t>(middle_.exchange(static_cast<std::uint8_t>(write_index_ | FRESH_BIT),
+                                                                  std::memory_order_acq_rel) & INDEX_MASK);
+    }
+
+    /**
+     * @brief 读取端：有新发布的快照时换到最新的一份，返回当前持有的快照
+     * @return 从未发布过时返回 nullptr；指针在下一次 acquire() 之前有效
+     */
+    [[nodiscard]] const RenderStateFrame* acquire() {
+        if (middle_.load(std::memory_order_acquire) & FRESH_BIT) {
+            read_index_ = static_cast<std::uint8_t>(middle_.exchange(read_index_, std::memory_order_acq_rel) & INDEX_MASK);
+            has_frame_ = true;
+        }
+        return has_frame_ ? &frames_[read_index_] : nullptr;
+    }
+
+    /// @brief 为三份快照预留条目容量（单线程初始化时调用）
+    void reserve(std::size_t count) {
+        for (auto& frame : frames_) {
+            frame.entries_.reserve(count);
+        }
+    }
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3u;
+    static constexpr std::uint8_t FRESH_BIT = 0x4u;     ///< 交接位上是尚未被读取端取走的新快照
+
+    std::array<RenderStateFrame, 3> frames_;
+    std::uint8_t write_index_{ 0 };                     ///< 写入端独占
+    alignas(64) std::atomic<std::uint8_t> middle_{ 1 };     ///< 交接位的下标 | FRESH_BIT
+    alignas(64) std::uint8_t read_index_{ 2 };              ///< 读取端独占
+    bool has_frame_{ false };
+};
+
+} // namespace engine::render
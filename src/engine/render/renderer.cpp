@@ -6,9 +6,27 @@
 #include <SDL3/SDL.h>
 #include <stdexcept>
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <cmath>
+#include <utility>
 
 namespace engine::render {
+    namespace {
+        /// 单个视差图层一帧最多提交的副本数，防止极小的平铺图片生成海量顶点
+        constexpr std::size_t MAX_PARALLAX_TILES = 4096;
+        /// 纹理预热使用的离屏目标边长：只为触发上传，画多小都可以
+        constexpr int WARM_TARGET_SIZE = 16;
+
+        /// 相机缩放倍数对应的图集缩小级：每拉远一倍（屏幕上一个像素覆盖两个原图像素）降一级
+        int mipLevelForZoom(float zoom) {
+            if (zoom >= 1.0f) {
+                return 0;
+            }
+            // 留一点余量，使 0.5、0.25 这类整倍数不因浮点误差落到上一级
+            return std::clamp(static_cast<int>(std::floor(-std::log2(zoom) + 1e-3f)), 0, engine::resource::MAX_ATLAS_MIP_LEVELS);
+        }
+    }
+
     /**
      * @brief 构造一个新的 Renderer 对象。
      * 
@@ -30,7 +48,8 @@ namespace engine::render {
     /**
      * @brief 在世界空间中绘制一个精灵。
      * 
-     * 根据相机的当前位置计算屏幕位置，执行视口裁剪以优化性能，并支持缩放、旋转和水平翻转。
+     * 根据相机的当前位置与缩放倍数计算屏幕位置，执行视口裁剪以优化性能，并支持缩放、旋转和水平翻转。
+     * 相机拉远时从图集的缩小页取样（见 TextureAtlasConfig::mip_levels_）。
      * 
      * @param camera 用于坐标转换的相机。
      * @param sprite 包含纹理信息和状态的精灵对象。
@@ -40,34 +59,44 @@ namespace engine::render {
      */
     void Renderer::drawSprite(const Camera & camera, const engine::component::Sprite & sprite, const glm::vec2 & position, const glm::vec2 & size, float angle, const engine::utils::FColor& tint)
     {
-           auto texture = resource_manager_->getTexture(sprite.texture_id_, sprite.texture_path_);
+    // 纹理可能已被打包进图集，源矩形需要加上其在图集页中的偏移（缩小页中还要按级别缩放）
+    const float zoom = camera.getZoom();
+    const auto& region = resolveTexture(sprite.texture_id_, sprite.getTexturePath(), mipLevelForZoom(zoom));
+    auto texture = region.texture_;
     if (!texture) {
         spdlog::error("无法为 ID {} 获取纹理。", sprite.texture_id_);
         return;
     }
 
-    // 应用相机变换
-    glm::vec2 screen_position = camera.worldToScreen(position);
-
-    // 计算目标矩形
-    SDL_FRect dest_rect = {
-        screen_position.x,
-        screen_position.y,
-        size.x,
-        size.y
+    SDL_FRect src_rect = {
+        region.offset_.x + sprite.src_rect_.position.x * region.scale_,
+        region.offset_.y + sprite.src_rect_.position.y * region.scale_,
+        sprite.src_rect_.size.x * region.scale_,
+        sprite.src_rect_.size.y * region.scale_
     };
+    if (region.placeholder_) {
+        // 纹理仍在后台加载：用整张占位纹理铺满目标矩形
+        src_rect = { 0.0f, 0.0f, region.size_.x, region.size_.y };
+    }
 
-    if (!isRectInViewport(camera, dest_rect)) { // 视口裁剪：如果精灵超出视口，则不绘制
-        // spdlog::info("精灵超出视口范围，ID: {}", sprite.getTextureId());
+    if (batching_) {
+        // 批处理中记录缩放后的世界坐标，相机平移作为整段的偏移在展开顶点时一次加上
+        const glm::vec2 view_min = camera.getPosition() * zoom;
+        const SDL_FRect world_rect = { position.x * zoom, position.y * zoom, size.x * zoom, size.y * zoom };
+        if (!isRectInViewport(camera, { world_rect.x - view_min.x, world_rect.y - view_min.y, world_rect.w, world_rect.h })) {
+            return;
+        }
+        appendBatchQuad(texture, src_rect, world_rect, -view_min, angle, sprite.is_flipped_, tint);
         return;
     }
 
-    SDL_FRect src_rect = {
-        sprite.src_rect_.position.x,
-        sprite.src_rect_.position.y,
-        sprite.src_rect_.size.x,
-        sprite.src_rect_.size.y
-    };
+    // 应用相机变换
+    const glm::vec2 screen_position = camera.worldToScreen(position);
+    const SDL_FRect dest_rect = { screen_position.x, screen_position.y, size.x * zoom, size.y * zoom };
+    if (!isRectInViewport(camera, dest_rect)) { // 视口裁剪：如果精灵超出视口，则不绘制
+        return;
+    }
+    flush();
 
     if (!SDL_SetTextureColorMod(texture,
                                 static_cast<Uint8>(tint.r * 255.0f),
@@ -79,10 +108,15 @@ namespace engine::render {
         spdlog::error("设置精灵透明度调制失败（ID: {}）：{}", sprite.texture_id_, SDL_GetError());
     }
 
-    // 执行绘制(默认旋转中心为精灵的中心点)
-    if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect, &dest_rect, angle, NULL, sprite.is_flipped_ ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
+    // 执行绘制：无旋转、无翻转时走普通纹理拷贝，否则绕精灵中心旋转
+    ++frame_stats_.draw_calls_;
+    if (angle == 0.0f && !sprite.is_flipped_) {
+        if (!SDL_RenderTexture(renderer_, texture, &src_rect, &dest_rect)) {
+            spdlog::error("渲染纹理失败（ID: {}）：{}", sprite.texture_id_, SDL_GetError());
+        }
+    } else if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect, &dest_rect, angle, NULL, sprite.is_flipped_ ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
         spdlog::error("渲染旋转纹理失败（ID: {}）：{}", sprite.texture_id_, SDL_GetError());
-    }   
+    }
 
     SDL_SetTextureColorMod(texture, 255, 255, 255);
     SDL_SetTextureAlphaMod(texture, 255);
@@ -101,12 +135,14 @@ namespace engine::render {
                                 const glm::vec2& position,
                                 const std::optional<glm::vec2>& size,
                                 const engine::utils::FColor& tint) {
-        auto texture = resource_manager_->getTexture(image.getTextureId(), image.getTexturePath());
+        flushSpriteBatch();
+        const auto region = resource_manager_->getTextureRegion(image.getTextureId(), image.getTexturePath());
+        auto texture = region.texture_;
         if (!texture) {
             spdlog::error("无法为 ID {} 获取纹理。", image.getTextureId());
             return;
         }
-		auto src_rect = getImageSrcRect(image);
+		auto src_rect = getImageSrcRect(image, region);
 		if (!src_rect.has_value()) {
 			spdlog::error("无法获取精灵的源矩形，ID: {}", image.getTextureId());
 			return;
@@ -119,21 +155,61 @@ namespace engine::render {
             dest_w,
             dest_h
         };
-        if (!SDL_SetTextureColorMod(texture,
-                                    static_cast<Uint8>(tint.r * 255.0f),
-                                    static_cast<Uint8>(tint.g * 255.0f),
-                                    static_cast<Uint8>(tint.b * 255.0f))) {
-            spdlog::error("设置 UI 纹理颜色调制失败（ID: {}）：{}", image.getTextureId(), SDL_GetError());
+        // 着色写入顶点颜色，不再逐张切换纹理的颜色/透明度调制
+        appendUIQuad(texture, src_rect.value(), dest_rect, SDL_FColor{ tint.r, tint.g, tint.b, tint.a });
+    }
+
+    /**
+     * @brief 九宫格绘制：3×3 个四边形，四角保持源尺寸，边与中心拉伸填满目标区域。
+     */
+    void Renderer::drawUINineSlice(const Image& image,
+                                   const engine::utils::Rect& dest,
+                                   const UINineSlice& slice,
+                                   const engine::utils::FColor& tint) {
+        if (tint.a <= 0.0f || dest.size.x <= 0.0f || dest.size.y <= 0.0f) {
+            return;
         }
-        if (!SDL_SetTextureAlphaMod(texture, static_cast<Uint8>(tint.a * 255.0f))) {
-            spdlog::error("设置 UI 纹理透明度调制失败（ID: {}）：{}", image.getTextureId(), SDL_GetError());
+        flushSpriteBatch();
+        const auto region = resource_manager_->getTextureRegion(image.getTextureId(), image.getTexturePath());
+        auto texture = region.texture_;
+        if (!texture) {
+            spdlog::error("无法为 ID {} 获取纹理。", image.getTextureId());
+            return;
         }
-        if (!SDL_RenderTexture(renderer_, texture, &src_rect.value(), &dest_rect)) {
-            spdlog::error("渲染 UI 纹理失败（ID: {}）：{}", image.getTextureId(), SDL_GetError());
+        const auto src_rect = getImageSrcRect(image, region);
+        if (!src_rect.has_value()) {
+            spdlog::error("无法获取九宫格图片的源矩形，ID: {}", image.getTextureId());
+            return;
         }
+        const SDL_FRect src = src_rect.value();
+
+        // 源图上的切分宽度不超过源图本身；目标区域放不下两侧时按比例缩小，角不会互相重叠
+        const float src_left = std::clamp(slice.left_, 0.0f, src.w);
+        const float src_right = std::clamp(slice.right_, 0.0f, src.w - src_left);
+        const float src_top = std::clamp(slice.top_, 0.0f, src.h);
+        const float src_bottom = std::clamp(slice.bottom_, 0.0f, src.h - src_top);
+        const float scale_x = src_left + src_right > dest.size.x ? dest.size.x / (src_left + src_right) : 1.0f;
+        const float scale_y = src_top + src_bottom > dest.size.y ? dest.size.y / (src_top + src_bottom) : 1.0f;
 
-        SDL_SetTextureColorMod(texture, 255, 255, 255);
-        SDL_SetTextureAlphaMod(texture, 255);
+        const float src_x[4] = { src.x, src.x + src_left, src.x + src.w - src_right, src.x + src.w };
+        const float src_y[4] = { src.y, src.y + src_top, src.y + src.h - src_bottom, src.y + src.h };
+        const float dest_x[4] = { dest.position.x, dest.position.x + src_left * scale_x,
+                                  dest.position.x + dest.size.x - src_right * scale_x, dest.position.x + dest.size.x };
+        const float dest_y[4] = { dest.position.y, dest.position.y + src_top * scale_y,
+                                  dest.position.y + dest.size.y - src_bottom * scale_y, dest.position.y + dest.size.y };
+        const SDL_FColor color{ tint.r, tint.g, tint.b, tint.a };
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                const SDL_FRect piece_dest{ dest_x[column], dest_y[row],
+                                            dest_x[column + 1] - dest_x[column], dest_y[row + 1] - dest_y[row] };
+                if (piece_dest.w <= 0.0f || piece_dest.h <= 0.0f) {
+                    continue;   // 切分宽度为 0 的边与角
+                }
+                const SDL_FRect piece_src{ src_x[column], src_y[row],
+                                           src_x[column + 1] - src_x[column], src_y[row + 1] - src_y[row] };
+                appendUIQuad(texture, piece_src, piece_dest, color);
+            }
+        }
     }
 
     void Renderer::drawFilledCircle(const Camera& camera, const glm::vec2& center, float radius, const engine::utils::FColor& color) {
@@ -143,20 +219,537 @@ namespace engine::render {
 
         static const Image circle_image(engine::resource::toResourceId("ui_circle"));
         const glm::vec2 screen_center = camera.worldToScreen(center);
-        drawUIImage(circle_image, screen_center - glm::vec2(radius, radius), glm::vec2{ radius * 2.0f, radius * 2.0f }, color);
+        const float screen_radius = radius * camera.getZoom();
+        drawUIImage(circle_image, screen_center - glm::vec2(screen_radius), glm::vec2{ screen_radius * 2.0f }, color);
+    }
+
+    /**
+     * @brief 开始精灵批处理，重置统计并清空顶点缓冲。
+     */
+    void Renderer::beginSpriteBatch() {
+        flush();
+        batching_ = true;
+        batch_stats_ = {};
+        flushed_sprite_count_ = 0;
+    }
+
+    /**
+     * @brief 结束精灵批处理，提交剩余的顶点。
+     */
+    void Renderer::endSpriteBatch() {
+        flush();
+        batching_ = false;
+    }
+
+    /**
+     * @brief 把一条精灵命令记录到当前批次。
+     * 
+     * 纹理（图集页）或相机偏移变化时只在命令列表中开启新的一段，不立即提交；纹理尺寸按纹理缓存，
+     * 连续的同纹理精灵不重复查询。顶点在 flushSpriteBatch() 中统一展开。
+     */
+    void Renderer::appendBatchQuad(SDL_Texture* texture, const SDL_FRect& src_rect, const SDL_FRect& dest_rect,
+        glm::vec2 offset, float angle, bool flip_horizontal, const engine::utils::FColor& tint) {
+        if (texture != batch_texture_) {
+            if (!SDL_GetTextureSize(texture, &batch_texture_size_.x, &batch_texture_size_.y) ||
+                batch_texture_size_.x <= 0.0f || batch_texture_size_.y <= 0.0f) {
+                spdlog::error("无法获取批处理纹理尺寸：{}", SDL_GetError());
+                batch_texture_ = nullptr;
+                return;
+            }
+            batch_texture_ = texture;
+        }
+        flushUIDrawList();
+        batch_commands_.add(texture, batch_texture_size_, offset,
+            SpriteCommand{ dest_rect, src_rect, angle, { tint.r, tint.g, tint.b, tint.a }, flip_horizontal });
+        ++batch_stats_.sprite_count_;
+    }
+
+    /**
+     * @brief 展开并提交已记录的命令，每段同纹理命令一次 SDL_RenderGeometry 调用。
+     */
+    void Renderer::flushSpriteBatch() {
+        if (!batch_commands_.empty()) {
+            const std::size_t draw_calls = batch_commands_.submit(renderer_, job_system_);
+            batch_stats_.draw_call_count_ += draw_calls;
+            frame_stats_.draw_calls_ += draw_calls;
+            frame_stats_.batched_sprites_ += batch_stats_.sprite_count_ - flushed_sprite_count_;
+            flushed_sprite_count_ = batch_stats_.sprite_count_;
+            ++frame_stats_.batches_;
+        }
+        batch_texture_ = nullptr;
+    }
+
+    /**
+     * @brief 绘制视差图层，所有可见副本以一次 SDL_RenderGeometry 调用提交。
+     *
+     * 平铺轴上的第一个副本取视口左/上边缘及之前最近的对齐位置（first ∈ (-size, 0]），
+     * 之后连续排布直到越过视口另一侧；超出视口的部分由光栅化裁剪，不必拆分四边形。
+     */
+    std::size_t Renderer::drawParallaxLayer(const Camera& camera, const engine::component::Sprite& sprite,
+        const glm::vec2& position, const glm::vec2& size, const glm::vec2& scroll_factor, const glm::bvec2& repeat,
+        const engine::utils::FColor& tint) {
+        if (size.x <= 0.0f || size.y <= 0.0f) {
+            return 0;
+        }
+        flush();
+
+        const float zoom = camera.getZoom();
+        const auto& region = resolveTexture(sprite.texture_id_, sprite.getTexturePath(), mipLevelForZoom(zoom));
+        auto texture = region.texture_;
+        if (!texture) {
+            spdlog::error("无法为 ID {} 获取纹理。", sprite.texture_id_);
+            return 0;
+        }
+        glm::vec2 texture_size{ 0.0f };
+        if (!SDL_GetTextureSize(texture, &texture_size.x, &texture_size.y) ||
+            texture_size.x <= 0.0f || texture_size.y <= 0.0f) {
+            spdlog::error("无法获取视差图层纹理尺寸：{}", SDL_GetError());
+            return 0;
+        }
+
+        // 每个轴上的起点与副本数；不平铺的轴只有原位置一份，完全在视口外时为 0（均为屏幕像素）
+        const glm::vec2 origin = camera.worldToScreenWithParallax(position, scroll_factor);
+        const glm::vec2 viewport = camera.getViewportSize();
+        const glm::vec2 extent = size * zoom;
+        const auto span = [](float start, float extent, float view, bool tiled) -> std::pair<float, int> {
+            if (!tiled) {
+                return { start, (start + extent < 0.0f || start > view) ? 0 : 1 };
+            }
+            const float first = start - std::ceil(start / extent) * extent;
+            return { first, static_cast<int>(std::ceil((view - first) / extent)) };
+        };
+        const auto [first_x, count_x] = span(origin.x, extent.x, viewport.x, repeat.x);
+        const auto [first_y, count_y] = span(origin.y, extent.y, viewport.y, repeat.y);
+        const auto count = static_cast<std::size_t>(count_x) * static_cast<std::size_t>(count_y);
+        if (count_x <= 0 || count_y <= 0) {
+            return 0;
+        }
+        if (count > MAX_PARALLAX_TILES) {
+            spdlog::warn("视差图层副本数 {} 超过上限 {}（ID: {}），跳过绘制", count, MAX_PARALLAX_TILES, sprite.texture_id_);
+            return 0;
+        }
+
+        SDL_FRect src_rect = {
+            region.offset_.x + sprite.src_rect_.position.x * region.scale_,
+            region.offset_.y + sprite.src_rect_.position.y * region.scale_,
+            sprite.src_rect_.size.x * region.scale_,
+            sprite.src_rect_.size.y * region.scale_
+        };
+        if (region.placeholder_) {
+            src_rect = { 0.0f, 0.0f, region.size_.x, region.size_.y };
+        }
+        float u0 = src_rect.x / texture_size.x;
+        float u1 = (src_rect.x + src_rect.w) / texture_size.x;
+        const float v0 = src_rect.y / texture_size.y;
+        const float v1 = (src_rect.y + src_rect.h) / texture_size.y;
+        if (sprite.is_flipped_) {
+            std::swap(u0, u1);
+        }
+
+        const SDL_FColor color{ tint.r, tint.g, tint.b, tint.a };
+        parallax_vertices_.clear();
+        parallax_indices_.clear();
+        parallax_vertices_.reserve(count * 4);
+        parallax_indices_.reserve(count * 6);
+        for (int row = 0; row < count_y; ++row) {
+            const float y0 = first_y + static_cast<float>(row) * extent.y;
+            const float y1 = y0 + extent.y;
+            for (int column = 0; column < count_x; ++column) {
+                const float x0 = first_x + static_cast<float>(column) * extent.x;
+                const float x1 = x0 + extent.x;
+                const int base = static_cast<int>(parallax_vertices_.size());
+                parallax_vertices_.push_back(SDL_Vertex{ { x0, y0 }, color, { u0, v0 } });
+                parallax_vertices_.push_back(SDL_Vertex{ { x1, y0 }, color, { u1, v0 } });
+                parallax_vertices_.push_back(SDL_Vertex{ { x1, y1 }, color, { u1, v1 } });
+                parallax_vertices_.push_back(SDL_Vertex{ { x0, y1 }, color, { u0, v1 } });
+                parallax_indices_.insert(parallax_indices_.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+            }
+        }
+        ++frame_stats_.draw_calls_;
+        if (!SDL_RenderGeometry(renderer_, texture,
+                                parallax_vertices_.data(), static_cast<int>(parallax_vertices_.size()),
+                                parallax_indices_.data(), static_cast<int>(parallax_indices_.size()))) {
+            spdlog::error("渲染视差图层失败（ID: {}）：{}", sprite.texture_id_, SDL_GetError());
+            return 0;
+        }
+        return count;
+    }
+
+    /**
+     * @brief 切换到离屏渲染目标并清空为透明。
+     */
+    bool Renderer::beginRenderToTexture(SDL_Texture* target) {
+        flush();
+        if (!target || !SDL_SetRenderTarget(renderer_, target)) {
+            spdlog::error("设置离屏渲染目标失败：{}", SDL_GetError());
+            return false;
+        }
+        window_clip_stack_.swap(ui_clip_stack_);
+        ui_clip_stack_.clear();
+        SDL_SetRenderClipRect(renderer_, nullptr);
+        SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 0);
+        if (!SDL_RenderClear(renderer_)) {
+            spdlog::error("清空离屏渲染目标失败：{}", SDL_GetError());
+        }
+        return true;
+    }
+
+    /**
+     * @brief 恢复窗口为渲染目标。
+     */
+    void Renderer::endRenderToTexture() {
+        flush();
+        // 世界层进行中时（如范围遮罩在世界层内重建）回到世界层目标而不是窗口
+        SDL_Texture* target = frame_target_;
+        if (world_pass_active_ && !world_replaying_) {
+            target = world_target_;
+        }
+        if (!SDL_SetRenderTarget(renderer_, target)) {
+            spdlog::error("恢复默认渲染目标失败：{}", SDL_GetError());
+        }
+        ui_clip_stack_.swap(window_clip_stack_);
+        window_clip_stack_.clear();
+        SDL_SetRenderClipRect(renderer_, ui_clip_stack_.empty() ? nullptr : &ui_clip_stack_.back());
+    }
+
+    void Renderer::beginWorldPass() {
+        if (world_pass_active_ || (!world_target_enabled_ && !world_frozen_)) {
+            return;
+        }
+        flush();
+
+        // 目标尺寸取逻辑分辨率：世界坐标与屏幕坐标的换算保持不变，鼠标拾取也无需调整
+        const glm::ivec2 logical_size = getLogicalTargetSize();
+        const int width = logical_size.x;
+        const int height = logical_size.y;
+        if (world_frozen_ && world_cached_ && world_target_ && world_target_size_ == glm::ivec2{ width, height }) {
+            // 重放：渲染目标保持为窗口，endWorldPass() 把缓存贴出
+            world_pass_active_ = true;
+            world_replaying_ = true;
+            return;
+        }
+        world_cached_ = false;
+        if (!world_target_ || world_target_size_ != glm::ivec2{ width, height }) {
+            releaseWorldTarget();
+            world_target_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+            if (!world_target_) {
+                spdlog::error("创建世界层渲染目标失败 ({}x{})：{}，改为直接绘制到窗口", width, height, SDL_GetError());
+                world_target_enabled_ = false;
+                world_frozen_ = false;
+                return;
+            }
+            if (!SDL_SetTextureScaleMode(world_target_, SDL_SCALEMODE_NEAREST)) {
+                spdlog::warn("无法设置世界层渲染目标的缩放模式为最邻近插值：{}", SDL_GetError());
+            }
+            // 窗口刚以背景色清空，世界层整张覆盖即可，不需要再混合一次
+            SDL_SetTextureBlendMode(world_target_, SDL_BLENDMODE_NONE);
+            world_target_size_ = { width, height };
+            spdlog::info("世界层渲染目标：{}x{}", width, height);
+        }
+        if (!SDL_SetRenderTarget(renderer_, world_target_)) {
+            spdlog::error("设置世界层渲染目标失败：{}", SDL_GetError());
+            return;
+        }
+        world_pass_active_ = true;
+        setDrawColor(static_cast<Uint8>(back_ground_.r * 255), static_cast<Uint8>(back_ground_.g * 255), static_cast<Uint8>(back_ground_.b * 255), static_cast<Uint8>(back_ground_.a * 255));
+        if (!SDL_RenderClear(renderer_)) {
+            spdlog::error("清空世界层渲染目标失败：{}", SDL_GetError());
+        }
+    }
+
+    void Renderer::endWorldPass() {
+        if (!world_pass_active_) {
+            return;
+        }
+        flush();
+        world_pass_active_ = false;
+        if (world_replaying_) {
+            world_replaying_ = false;
+        } else {
+            if (!SDL_SetRenderTarget(renderer_, frame_target_)) {
+                spdlog::error("恢复默认渲染目标失败：{}", SDL_GetError());
+                return;
+            }
+            world_cached_ = world_frozen_;
+        }
+        // 目标为逻辑分辨率，整张贴到逻辑画面上；逻辑呈现负责放大到输出分辨率
+        ++frame_stats_.draw_calls_;
+        if (!SDL_RenderTexture(renderer_, world_target_, nullptr, nullptr)) {
+            spdlog::error("绘制世界层渲染目标失败：{}", SDL_GetError());
+        }
+    }
+
+    void Renderer::releaseWorldTarget() {
+        if (world_pass_active_) {
+            endWorldPass();
+        }
+        if (world_target_) {
+            SDL_DestroyTexture(world_target_);
+            world_target_ = nullptr;
+        }
+        world_target_size_ = { 0, 0 };
+        world_cached_ = false;
+    }
+
+    glm::ivec2 Renderer::getLogicalTargetSize() const {
+        int width = 0;
+        int height = 0;
+        SDL_GetRenderLogicalPresentation(renderer_, &width, &height, nullptr);
+        if (width <= 0 || height <= 0) {
+            SDL_GetCurrentRenderOutputSize(renderer_, &width, &height);
+        }
+        return { width, height };
+    }
+
+    void Renderer::discardWorldPass() {
+        if (!world_pass_active_) {
+            return;
+        }
+        flush();
+        world_pass_active_ = false;
+        if (!world_replaying_ && !SDL_SetRenderTarget(renderer_, frame_target_)) {
+            spdlog::error("恢复默认渲染目标失败：{}", SDL_GetError());
+        }
+        world_replaying_ = false;
+    }
+
+    bool Renderer::hasUnderlay() const {
+        return underlay_valid_ && underlay_ && underlay_size_ == getLogicalTargetSize();
+    }
+
+    bool Renderer::beginUnderlayCapture() {
+        discardWorldPass();
+        flush();
+        const glm::ivec2 size = getLogicalTargetSize();
+        if (!underlay_ || underlay_size_ != size) {
+            releaseUnderlay();
+            underlay_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size.x, size.y);
+            if (!underlay_) {
+                spdlog::error("创建底图渲染目标失败 ({}x{})：{}", size.x, size.y, SDL_GetError());
+                return false;
+            }
+            // 底图整张不透明地覆盖窗口；模糊时线性采样
+            SDL_SetTextureBlendMode(underlay_, SDL_BLENDMODE_NONE);
+            SDL_SetTextureScaleMode(underlay_, SDL_SCALEMODE_LINEAR);
+            underlay_size_ = size;
+        }
+        if (!SDL_SetRenderTarget(renderer_, underlay_)) {
+            spdlog::error("设置底图渲染目标失败：{}", SDL_GetError());
+            return false;
+        }
+        underlay_capturing_ = true;
+        underlay_return_target_ = frame_target_;
+        frame_target_ = underlay_;
+        underlay_valid_ = false;
+        setDrawColor(static_cast<Uint8>(back_ground_.r * 255), static_cast<Uint8>(back_ground_.g * 255), static_cast<Uint8>(back_ground_.b * 255), static_cast<Uint8>(back_ground_.a * 255));
+        if (!SDL_RenderClear(renderer_)) {
+            spdlog::error("清空底图渲染目标失败：{}", SDL_GetError());
+        }
+        return true;
+    }
+
+    void Renderer::endUnderlayCapture(float dim, int blur_passes) {
+        if (!underlay_capturing_) {
+            return;
+        }
+        endWorldPass();     // 被覆盖的场景没有经过 Scene::render() 时在这里收尾
+        flush();
+
+        // 模糊：逐级缩小一半（线性采样即 2x2 平均），再一次放大回底图，只在捕获时做一次
+        std::vector<SDL_Texture*> levels;
+        SDL_Texture* source = underlay_;
+        glm::ivec2 size = underlay_size_;
+        for (int i = 0; i < blur_passes && size.x > 1 && size.y > 1; ++i) {
+            size = glm::max(size / 2, glm::ivec2{ 1, 1 });
+            SDL_Texture* level = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size.x, size.y);
+            if (!level) {
+                spdlog::warn("创建底图模糊缓冲失败 ({}x{})：{}", size.x, size.y, SDL_GetError());
+                break;
+            }
+            SDL_SetTextureBlendMode(level, SDL_BLENDMODE_NONE);
+            SDL_SetTextureScaleMode(level, SDL_SCALEMODE_LINEAR);
+            if (SDL_SetRenderTarget(renderer_, level)) {
+                SDL_RenderTexture(renderer_, source, nullptr, nullptr);
+            }
+            levels.push_back(level);
+            source = level;
+        }
+        if (!SDL_SetRenderTarget(renderer_, underlay_)) {
+            spdlog::error("设置底图渲染目标失败：{}", SDL_GetError());
+        }
+        if (source != underlay_) {
+            SDL_RenderTexture(renderer_, source, nullptr, nullptr);
+        }
+        for (SDL_Texture* level : levels) {
+            SDL_DestroyTexture(level);
+        }
+
+        // 压暗一并烘焙进底图，之后每帧只贴一张纹理
+        if (dim > 0.0f) {
+            SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND);
+            SDL_SetRenderDrawColor(renderer_, 0, 0, 0, static_cast<Uint8>(std::clamp(dim, 0.0f, 1.0f) * 255.0f));
+            SDL_RenderFillRect(renderer_, nullptr);
+        }
+
+        underlay_capturing_ = false;
+        frame_target_ = underlay_return_target_;
+        underlay_return_target_ = nullptr;
+        if (!SDL_SetRenderTarget(renderer_, frame_target_)) {
+            spdlog::error("恢复默认渲染目标失败：{}", SDL_GetError());
+        }
+        underlay_valid_ = true;
+    }
+
+    void Renderer::drawUnderlay() {
+        if (underlay_valid_) {
+            drawFullscreenTexture(underlay_);
+        }
+    }
+
+    void Renderer::setFrameTarget(SDL_Texture* target) {
+        flush();
+        frame_target_ = target;
+        if (!SDL_SetRenderTarget(renderer_, target)) {
+            spdlog::error("设置帧渲染目标失败：{}", SDL_GetError());
+            return;
+        }
+        if (target) {
+            setDrawColor(static_cast<Uint8>(back_ground_.r * 255), static_cast<Uint8>(back_ground_.g * 255), static_cast<Uint8>(back_ground_.b * 255), static_cast<Uint8>(back_ground_.a * 255));
+            if (!SDL_RenderClear(renderer_)) {
+                spdlog::error("清空帧渲染目标失败：{}", SDL_GetError());
+            }
+        }
+    }
+
+    void Renderer::drawFullscreenTexture(SDL_Texture* texture) {
+        if (!texture) {
+            return;
+        }
+        flush();
+        ++frame_stats_.draw_calls_;
+        if (!SDL_RenderTexture(renderer_, texture, nullptr, nullptr)) {
+            spdlog::error("绘制整屏纹理失败：{}", SDL_GetError());
+        }
+    }
+
+    void Renderer::releaseUnderlay() {
+        if (underlay_capturing_) {
+            endUnderlayCapture(0.0f, 0);
+        }
+        if (underlay_) {
+            SDL_DestroyTexture(underlay_);
+            underlay_ = nullptr;
+        }
+        underlay_size_ = { 0, 0 };
+        underlay_valid_ = false;
+    }
+
+    void Renderer::thawWorld() {
+        if (!world_frozen_) {
+            return;
+        }
+        world_frozen_ = false;
+        world_cached_ = false;
+        // 未开启像素完美输出时，渲染目标只是为冻结而建
+        if (!world_target_enabled_ && !world_pass_active_) {
+            releaseWorldTarget();
+        }
+    }
+
+    /**
+     * @brief 以渲染目标局部坐标绘制精灵，支持水平翻转。
+     */
+    void Renderer::drawSpriteToTarget(const engine::component::Sprite& sprite, const glm::vec2& position, const glm::vec2& size) {
+        // 烘焙结果会长期保留，不能使用占位纹理
+        const auto region = resource_manager_->getTextureRegion(sprite.texture_id_, sprite.getTexturePath(), false);
+        auto texture = region.texture_;
+        if (!texture) {
+            spdlog::error("无法为 ID {} 获取纹理。", sprite.texture_id_);
+            return;
+        }
+        const SDL_FRect src_rect = {
+            region.offset_.x + sprite.src_rect_.position.x,
+            region.offset_.y + sprite.src_rect_.position.y,
+            sprite.src_rect_.size.x,
+            sprite.src_rect_.size.y
+        };
+        const SDL_FRect dest_rect = { position.x, position.y, size.x, size.y };
+        ++frame_stats_.draw_calls_;
+        if (!SDL_RenderTextureRotated(renderer_, texture, &src_rect, &dest_rect, 0.0, NULL, sprite.is_flipped_ ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
+            spdlog::error("离屏渲染纹理失败（ID: {}）：{}", sprite.texture_id_, SDL_GetError());
+        }
+    }
+
+    std::size_t Renderer::warmTextures(std::span<SDL_Texture* const> textures) {
+        if (textures.empty()) {
+            return 0;
+        }
+        SDL_Texture* target = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, WARM_TARGET_SIZE, WARM_TARGET_SIZE);
+        if (!target) {
+            spdlog::warn("创建纹理预热目标失败：{}", SDL_GetError());
+            return 0;
+        }
+        std::size_t drawn = 0;
+        if (beginRenderToTexture(target)) {
+            const SDL_FRect dest_rect = { 0.0f, 0.0f, static_cast<float>(WARM_TARGET_SIZE), static_cast<float>(WARM_TARGET_SIZE) };
+            SDL_Texture* previous = nullptr;
+            for (SDL_Texture* texture : textures) {
+                // 同一图集页的多个区域通常相邻出现
+                if (!texture || texture == previous) {
+                    continue;
+                }
+                previous = texture;
+                if (SDL_RenderTexture(renderer_, texture, nullptr, &dest_rect)) {
+                    ++drawn;
+                }
+            }
+            endRenderToTexture();
+            // 命令队列立即交给驱动，上传在这里完成，而不是推迟到下一次 present
+            SDL_FlushRenderer(renderer_);
+        }
+        SDL_DestroyTexture(target);
+        return drawn;
     }
 
     /**
      * @brief 更新屏幕，将当前缓冲区的内容呈现。
      */
     void Renderer::present() {
+        flush();
+        const std::uint64_t present_start = SDL_GetTicksNS();
         SDL_RenderPresent(renderer_);
+        last_frame_stats_ = frame_stats_;
+        last_frame_stats_.present_ms_ = static_cast<double>(SDL_GetTicksNS() - present_start) / 1'000'000.0;
+        frame_stats_ = {};
+        resetTextureCache();
+    }
+
+    /**
+     * @brief 解析纹理并缓存最近一次结果。
+     *
+     * 精灵按图层/纹理排序后，相邻精灵通常共用同一纹理（或同一图集页），命中时无需查哈希表。
+     */
+    const engine::resource::TextureRegion& Renderer::resolveTexture(engine::resource::ResourceId id, std::string_view file_path, int mip_level) {
+        if (id != last_texture_id_ || mip_level != last_texture_mip_ || id == engine::resource::InvalidResourceId) {
+            last_texture_region_ = resource_manager_->getTextureRegion(id, file_path, true, mip_level);
+            const bool cacheable = last_texture_region_.texture_ && !last_texture_region_.placeholder_;
+            last_texture_id_ = cacheable ? id : engine::resource::InvalidResourceId;
+            last_texture_mip_ = mip_level;
+        }
+        return last_texture_region_;
+    }
+
+    void Renderer::resetTextureCache() {
+        last_texture_id_ = engine::resource::InvalidResourceId;
+        last_texture_region_ = {};
     }
 
     /**
      * @brief 清除当前渲染目标的所有内容。
      */
     void Renderer::clearScreen() {
+        // 纹理可能在两帧之间被加载、卸载或打包，缓存只在一帧内有效
+        resetTextureCache();
         setDrawColor(static_cast<Uint8>(back_ground_.r * 255), static_cast<Uint8>(back_ground_.g * 255), static_cast<Uint8>(back_ground_.b * 255), static_cast<Uint8>(back_ground_.a * 255));
          if (SDL_RenderClear(renderer_) == false) {
             spdlog::error("清除渲染器失败：{}", SDL_GetError());
@@ -178,18 +771,17 @@ namespace engine::render {
 	}
 
     /**
-     * @brief 获取精灵在纹理中的源矩形。
+     * @brief 获取图片在纹理中的源矩形。
      * 
-     * 如果精灵没有自定义裁剪区域，则返回纹理的完整尺寸。
+     * 如果图片没有自定义裁剪区域，则返回整张纹理（或其在图集中的整块区域）。
      * 
-     * @param sprite 精灵对象。
+     * @param image 图片对象。
+     * @param region 图片纹理解析后的绘制位置。
      * @return std::optional<SDL_FRect> 成功返回矩形区域，失败返回 nullopt。
      */
-    std::optional<SDL_FRect> Renderer::getImageSrcRect(const Image& image) {
-        auto texture = resource_manager_->getTexture(image.getTextureId(), image.getTexturePath());
-        if (!texture) {
-            spdlog::error("无法为 ID {} 获取纹理。", image.getTextureId());
-            return std::nullopt;
+    std::optional<SDL_FRect> Renderer::getImageSrcRect(const Image& image, const engine::resource::TextureRegion& region) {
+        if (region.placeholder_) {
+            return SDL_FRect{ 0.0f, 0.0f, region.size_.x, region.size_.y };
         }
         auto src_rect = image.getSourceRect();
         if (src_rect.has_value()) {
@@ -197,16 +789,15 @@ namespace engine::render {
                 spdlog::error("源矩形尺寸无效，ID: {}", image.getTextureId());
                 return std::nullopt;
             }
+            src_rect->x += region.offset_.x;
+            src_rect->y += region.offset_.y;
             return src_rect;
         }
-        else {
-            SDL_FRect result = { 0, 0, 0, 0 };
-            if (!SDL_GetTextureSize(texture, &result.w, &result.h)) {
-                spdlog::error("无法获取纹理尺寸，ID: {}", image.getTextureId());
-                return std::nullopt;
-            }
-            return result;
+        if (region.size_.x <= 0.0f || region.size_.y <= 0.0f) {
+            spdlog::error("无法获取纹理尺寸，ID: {}", image.getTextureId());
+            return std::nullopt;
         }
+        return SDL_FRect{ region.offset_.x, region.offset_.y, region.size_.x, region.size_.y };
     }
 
     /**
@@ -266,64 +857,209 @@ namespace engine::render {
         if (color.a <= 0.0f) {
             return;
         }
+        flushSpriteBatch();
+        const SDL_FRect sdl_rect = { rect.position.x, rect.position.y, rect.size.x, rect.size.y };
+        appendUIQuad(nullptr, {}, sdl_rect, SDL_FColor{ color.r, color.g, color.b, color.a });
+    }
+
+    /**
+     * @brief 在屏幕空间（UI 层）中绘制一个矩形边框。
+     * 
+     * 上下两条贯穿全宽，左右两条夹在其间，四条互不重叠，半透明边框的角不会叠色。
+     * 
+     * @param rect 矩形区域。
+     * @param color 边框颜色。
+     * @param thickness 边框宽度。
+     */
+    void Renderer::drawUIOutlineRect(const engine::utils::Rect& rect, const engine::utils::FColor& color, float thickness) {
+        if (color.a <= 0.0f || thickness <= 0.0f || rect.size.x <= 0.0f || rect.size.y <= 0.0f) {
+            return;
+        }
+        flushSpriteBatch();
+        const float x = rect.position.x;
+        const float y = rect.position.y;
+        const float w = rect.size.x;
+        const float h = rect.size.y;
+        const float t = std::min({ thickness, w * 0.5f, h * 0.5f });
+        const SDL_FColor sdl_color{ color.r, color.g, color.b, color.a };
+        appendUIQuad(nullptr, {}, SDL_FRect{ x, y, w, t }, sdl_color);
+        appendUIQuad(nullptr, {}, SDL_FRect{ x, y + h - t, w, t }, sdl_color);
+        if (h > t * 2.0f) {
+            appendUIQuad(nullptr, {}, SDL_FRect{ x, y + t, t, h - t * 2.0f }, sdl_color);
+            appendUIQuad(nullptr, {}, SDL_FRect{ x + w - t, y + t, t, h - t * 2.0f }, sdl_color);
+        }
+    }
 
-        // 创建SDL_FRect结构
-        SDL_FRect sdl_rect = {
-            rect.position.x,
-            rect.position.y,
-            rect.size.x,
-            rect.size.y
-        };
+    /**
+     * @brief 将一组纯色矩形追加到 UI 绘制列表（同属一段无纹理四边形）。
+     */
+    void Renderer::drawUIFilledRects(std::span<const UIFilledRect> rects) {
+        if (rects.empty()) {
+            return;
+        }
+        flushSpriteBatch();
 
-        if (!SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND)) {
-            spdlog::error("设置 UI 填充矩形混合模式失败：{}", SDL_GetError());
+        ui_vertices_.reserve(ui_vertices_.size() + rects.size() * 4);
+        ui_indices_.reserve(ui_indices_.size() + rects.size() * 6);
+        for (const auto& [rect, color] : rects) {
+            if (color.a <= 0.0f) {
+                continue;
+            }
+            const SDL_FRect sdl_rect = { rect.position.x, rect.position.y, rect.size.x, rect.size.y };
+            appendUIQuad(nullptr, {}, sdl_rect, SDL_FColor{ color.r, color.g, color.b, color.a });
         }
+    }
 
-        // 设置绘制颜色
-        SDL_SetRenderDrawColor(renderer_,
-                               static_cast<Uint8>(color.r * 255),
-                               static_cast<Uint8>(color.g * 255),
-                               static_cast<Uint8>(color.b * 255),
-                               static_cast<Uint8>(color.a * 255));
+    /**
+     * @brief 追加一个 UI 四边形；纹理（或有无纹理）变化时开启新的一段，否则延长最后一段。
+     */
+    void Renderer::appendUIQuad(SDL_Texture* texture, const SDL_FRect& src_rect, const SDL_FRect& dest_rect, const SDL_FColor& color) {
+        float u0 = 0.0f;
+        float v0 = 0.0f;
+        float u1 = 0.0f;
+        float v1 = 0.0f;
+        if (texture) {
+            if (texture != ui_texture_) {
+                if (!SDL_GetTextureSize(texture, &ui_texture_size_.x, &ui_texture_size_.y) ||
+                    ui_texture_size_.x <= 0.0f || ui_texture_size_.y <= 0.0f) {
+                    spdlog::error("无法获取 UI 纹理尺寸：{}", SDL_GetError());
+                    ui_texture_ = nullptr;
+                    return;
+                }
+                ui_texture_ = texture;
+            }
+            u0 = src_rect.x / ui_texture_size_.x;
+            v0 = src_rect.y / ui_texture_size_.y;
+            u1 = (src_rect.x + src_rect.w) / ui_texture_size_.x;
+            v1 = (src_rect.y + src_rect.h) / ui_texture_size_.y;
+        }
 
-        // 填充矩形
-        if (!SDL_RenderFillRect(renderer_, &sdl_rect)) {
-            spdlog::error("渲染填充矩形失败：{}", SDL_GetError());
+        const int base = static_cast<int>(ui_vertices_.size());
+        const float x0 = dest_rect.x;
+        const float y0 = dest_rect.y;
+        const float x1 = dest_rect.x + dest_rect.w;
+        const float y1 = dest_rect.y + dest_rect.h;
+        ui_vertices_.push_back(SDL_Vertex{ { x0, y0 }, color, { u0, v0 } });
+        ui_vertices_.push_back(SDL_Vertex{ { x1, y0 }, color, { u1, v0 } });
+        ui_vertices_.push_back(SDL_Vertex{ { x1, y1 }, color, { u1, v1 } });
+        ui_vertices_.push_back(SDL_Vertex{ { x0, y1 }, color, { u0, v1 } });
+        if (ui_segments_.empty() || ui_segments_.back().texture_ != texture) {
+            ui_segments_.push_back(UIDrawSegment{ texture, static_cast<int>(ui_indices_.size()), 0 });
         }
+        ui_indices_.insert(ui_indices_.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        ui_segments_.back().index_count_ += 6;
     }
 
     /**
-     * @brief 在屏幕空间（UI 层）中绘制一个矩形边框。
-     * @param rect 矩形区域。
-     * @param color 边框颜色。
+     * @brief 按记录顺序提交 UI 绘制列表。
+     * 
+     * 各段共用同一份顶点缓冲，只传入各自的索引区间；不跨段重排，后画的 UI 始终覆盖先画的。
      */
-    void Renderer::drawUIOutlineRect(const engine::utils::Rect& rect, const engine::utils::FColor& color) {
-        if (color.a <= 0.0f) {
+    void Renderer::flushUIDrawList() {
+        if (ui_segments_.empty()) {
             return;
         }
+        // 无纹理的几何体按绘制混合模式混合，有纹理时使用纹理自身的混合模式
+        if (!SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND)) {
+            spdlog::error("设置 UI 绘制列表混合模式失败：{}", SDL_GetError());
+        }
+        const int vertex_count = static_cast<int>(ui_vertices_.size());
+        for (const auto& segment : ui_segments_) {
+            ++frame_stats_.draw_calls_;
+            if (!SDL_RenderGeometry(renderer_, segment.texture_,
+                                    ui_vertices_.data(), vertex_count,
+                                    ui_indices_.data() + segment.first_index_, segment.index_count_)) {
+                spdlog::error("渲染 UI 绘制列表失败：{}", SDL_GetError());
+            }
+        }
+        frame_stats_.ui_quads_ += ui_vertices_.size() / 4;
+        ui_vertices_.clear();
+        ui_indices_.clear();
+        ui_segments_.clear();
+        ui_texture_ = nullptr;
+    }
 
-        // 创建SDL_FRect结构
-        SDL_FRect sdl_rect = {
-            rect.position.x,
-            rect.position.y,
-            rect.size.x,
-            rect.size.y
-        };
+    /**
+     * @brief 提交全部延迟的绘制。精灵批次与 UI 绘制列表不会同时非空，先后顺序无关。
+     */
+    void Renderer::flush() {
+        flushUIDrawList();
+        flushSpriteBatch();
+    }
 
-        if (!SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND)) {
-            spdlog::error("设置 UI 边框矩形混合模式失败：{}", SDL_GetError());
+    /**
+     * @brief 创建 UI 缓存用的渲染目标纹理（预乘 alpha 混合、最邻近采样）。
+     */
+    SDL_Texture* Renderer::createUICacheTexture(glm::ivec2 size) {
+        if (size.x <= 0 || size.y <= 0) {
+            return nullptr;
+        }
+        SDL_Texture* texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size.x, size.y);
+        if (!texture) {
+            spdlog::error("创建 UI 缓存纹理失败 ({}x{})：{}", size.x, size.y, SDL_GetError());
+            return nullptr;
+        }
+        if (!SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED)) {
+            spdlog::warn("无法设置 UI 缓存纹理混合模式：{}", SDL_GetError());
+        }
+        if (!SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST)) {
+            spdlog::warn("无法设置 UI 缓存纹理缩放模式为最邻近插值");
+        }
+        return texture;
+    }
+
+    /**
+     * @brief 在屏幕空间绘制纹理的指定区域。
+     */
+    void Renderer::drawUITexture(SDL_Texture* texture, const engine::utils::Rect& src, const engine::utils::Rect& dest) {
+        if (!texture) {
+            return;
+        }
+        flush();
+        const SDL_FRect src_rect = { src.position.x, src.position.y, src.size.x, src.size.y };
+        const SDL_FRect dest_rect = { dest.position.x, dest.position.y, dest.size.x, dest.size.y };
+        ++frame_stats_.draw_calls_;
+        if (!SDL_RenderTexture(renderer_, texture, &src_rect, &dest_rect)) {
+            spdlog::error("渲染 UI 纹理失败：{}", SDL_GetError());
         }
+    }
 
-        // 设置绘制颜色
-        SDL_SetRenderDrawColor(renderer_,
-                               static_cast<Uint8>(color.r * 255),
-                               static_cast<Uint8>(color.g * 255),
-                               static_cast<Uint8>(color.b * 255),
-                               static_cast<Uint8>(color.a * 255));
+    /**
+     * @brief 压入 UI 裁剪矩形（与栈顶求交）。
+     */
+    void Renderer::pushUIClipRect(const engine::utils::Rect& rect) {
+        flush();
+        SDL_Rect clip = {
+            static_cast<int>(std::floor(rect.position.x)),
+            static_cast<int>(std::floor(rect.position.y)),
+            static_cast<int>(std::ceil(rect.size.x)),
+            static_cast<int>(std::ceil(rect.size.y))
+        };
+        if (!ui_clip_stack_.empty()) {
+            SDL_Rect intersection{};
+            if (!SDL_GetRectIntersection(&clip, &ui_clip_stack_.back(), &intersection)) {
+                intersection = { clip.x, clip.y, 0, 0 };    // 不相交：裁掉全部内容
+            }
+            clip = intersection;
+        }
+        ui_clip_stack_.push_back(clip);
+        if (!SDL_SetRenderClipRect(renderer_, &clip)) {
+            spdlog::error("设置 UI 裁剪矩形失败：{}", SDL_GetError());
+        }
+    }
 
-        // 绘制矩形边框
-        if (!SDL_RenderRect(renderer_, &sdl_rect)) {
-            spdlog::error("渲染矩形边框失败：{}", SDL_GetError());
+    /**
+     * @brief 弹出 UI 裁剪矩形。
+     */
+    void Renderer::popUIClipRect() {
+        if (ui_clip_stack_.empty()) {
+            return;
+        }
+        flush();
+        ui_clip_stack_.pop_back();
+        const SDL_Rect* clip = ui_clip_stack_.empty() ? nullptr : &ui_clip_stack_.back();
+        if (!SDL_SetRenderClipRect(renderer_, clip)) {
+            spdlog::error("恢复 UI 裁剪矩形失败：{}", SDL_GetError());
         }
     }
 }
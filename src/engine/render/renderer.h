@@ -8,6 +8,10 @@
  * - UI 元素绘制（屏幕空间）
  * - 矩形绘制（填充和边框）
  * - 渲染状态管理（清屏、呈现、背景色设置）
+ * - 精灵批处理（SpriteBatch）：记录为绘制命令，连续的同纹理精灵合并为一次 SDL_RenderGeometry 调用
+ * - UI 绘制列表：纯色矩形、边框、图片与九宫格面板按顺序累积为四边形，同纹理的相邻段合并提交
+ * - 视差图层：平铺覆盖视口的全部副本合并为一次 SDL_RenderGeometry 调用
+ * - UI 缓存纹理：保留模式 UI 子树的离屏渲染目标与贴图
  * 
  * 该类封装了 SDL 的渲染 API，提供了更高级、更方便的渲染接口。
  * 
@@ -16,14 +20,25 @@
 
 #pragma once
 #include "image.h"
+#include "render_command_list.h"
+#include "../resource/resource_id.h"
+#include "../resource/texture_atlas.h"
 #include <glm/glm.hpp>
 #include "../utils/math.h"
+#include <SDL3/SDL_render.h>
+#include <cstddef>
 #include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
 
 struct SDL_Renderer;
 namespace engine::resource {
 	class ResourceManager;
 }
+namespace engine::core {
+	class JobSystem;
+}
 namespace engine::component {
 	struct Sprite;
 }
@@ -31,6 +46,38 @@ namespace engine::component {
 namespace engine::render {
 	class Camera;
 
+	/**
+	 * @struct SpriteBatchStats
+	 * @brief 精灵批处理统计，记录最近一次批处理（begin 到 end）的提交情况
+	 */
+	struct SpriteBatchStats {
+		std::size_t sprite_count_{0};       ///< 进入批处理的精灵数量（已剔除视口外精灵）
+		std::size_t draw_call_count_{0};    ///< 实际发出的 SDL_RenderGeometry 调用次数
+	};
+
+	/**
+	 * @struct RenderFrameStats
+	 * @brief 一帧（两次 present 之间）经 Renderer 发出的绘制统计
+	 *
+	 * @details 只计 Renderer 自身的 SDL_Render* 调用；TextRenderer 与 ImGui 直接使用 SDL_Renderer，不在此列。
+	 */
+	struct RenderFrameStats {
+		std::size_t draw_calls_{0};         ///< SDL_RenderTexture / SDL_RenderGeometry 等调用次数
+		std::size_t batches_{0};            ///< 精灵批次提交次数（每次提交含一到多个同纹理段）
+		std::size_t batched_sprites_{0};    ///< 经批处理提交的精灵数
+		std::size_t ui_quads_{0};           ///< 经 UI 绘制列表提交的四边形数
+		double present_ms_{0.0};            ///< SDL_RenderPresent 耗时：驱动排队满或垂直同步时在此等待 GPU
+	};
+
+	/**
+	 * @struct UIFilledRect
+	 * @brief 批量绘制用的屏幕空间纯色矩形
+	 */
+	struct UIFilledRect {
+		engine::utils::Rect rect_;
+		engine::utils::FColor color_;
+	};
+
 	/**
 	 * @class Renderer
 	 * @brief 核心渲染类，负责封装 SDL 渲染操作和处理场景绘制逻辑。
@@ -48,9 +95,60 @@ namespace engine::render {
 		SDL_Renderer* renderer_ = nullptr;
 		/// 用于获取纹理和资源的管理类指针
 		engine::resource::ResourceManager* resource_manager_ = nullptr;
+		/// 并行展开批次顶点用的任务系统（可为空）
+		engine::core::JobSystem* job_system_ = nullptr;
 
 		engine::utils::FColor back_ground_{0.0f, 0.0f, 0.0f, 0.0f}; ///< 背景颜色，用于清屏或绘制背景色
 
+		// --- 精灵批处理状态 ---
+		bool batching_ = false;                     ///< 是否处于 beginSpriteBatch/endSpriteBatch 之间
+		SDL_Texture* batch_texture_ = nullptr;      ///< 最近一条批处理命令使用的纹理
+		glm::vec2 batch_texture_size_{0.0f};        ///< 该纹理的尺寸，纹理不变时不再查询
+		RenderCommandList batch_commands_;          ///< 自上次提交以来记录的精灵命令（可跨多个纹理/图集页）
+		SpriteBatchStats batch_stats_{};            ///< 当前/最近一次批处理的统计
+		std::size_t flushed_sprite_count_ = 0;      ///< 本次批处理中已提交的精灵数（分次提交时计入帧统计）
+		RenderFrameStats frame_stats_{};            ///< 本帧累计中的绘制统计
+		RenderFrameStats last_frame_stats_{};       ///< 上一次 present 时结算的统计
+
+		// --- UI 绘制列表（纯色四边形纹理为空；与精灵批次互斥，追加任一方前先提交另一方）---
+		struct UIDrawSegment {
+			SDL_Texture* texture_ = nullptr;
+			int first_index_ = 0;
+			int index_count_ = 0;
+		};
+		std::vector<SDL_Vertex> ui_vertices_;       ///< 自上次提交以来的 UI 顶点（跨帧复用）
+		std::vector<int> ui_indices_;               ///< 对应的索引，每个四边形 6 个
+		std::vector<UIDrawSegment> ui_segments_;    ///< 按绘制顺序排列，相邻段纹理不同
+		SDL_Texture* ui_texture_ = nullptr;         ///< 最近一个 UI 四边形使用的纹理
+		glm::vec2 ui_texture_size_{0.0f};           ///< 该纹理的尺寸，纹理不变时不再查询
+		std::vector<SDL_Vertex> parallax_vertices_; ///< 视差图层平铺的顶点缓冲（跨帧复用）
+		std::vector<int> parallax_indices_;         ///< 视差图层平铺的索引缓冲（跨帧复用）
+		std::vector<SDL_Rect> ui_clip_stack_;       ///< UI 裁剪矩形栈（栈顶为当前生效的裁剪区域）
+
+		// --- 世界层渲染目标（像素完美输出）---
+		bool world_target_enabled_ = false;         ///< 是否把世界层画到逻辑分辨率的渲染目标
+		bool world_pass_active_ = false;            ///< 是否处于 beginWorldPass/endWorldPass 之间
+		SDL_Texture* world_target_ = nullptr;       ///< 世界层渲染目标（尺寸随逻辑分辨率重建）
+		glm::ivec2 world_target_size_{0, 0};
+		bool world_frozen_ = false;                 ///< 世界层冻结：下一次世界层绘制被保留，之后各帧直接重放
+		bool world_cached_ = false;                 ///< world_target_ 中保存着一帧完整的世界层
+		bool world_replaying_ = false;              ///< 本帧的世界层由缓存重放（beginWorldPass 到 endWorldPass 之间）
+
+		// --- 叠加场景的底图（被覆盖场景的冻结画面）---
+		SDL_Texture* underlay_ = nullptr;           ///< 被覆盖场景最后一帧的完整画面（逻辑分辨率）
+		glm::ivec2 underlay_size_{0, 0};
+		bool underlay_capturing_ = false;           ///< 处于 beginUnderlayCapture/endUnderlayCapture 之间
+		bool underlay_valid_ = false;               ///< 底图内容有效，invalidateUnderlay() 后需重新捕获
+		SDL_Texture* underlay_return_target_ = nullptr; ///< 捕获底图前的帧渲染目标，结束时恢复
+
+		SDL_Texture* frame_target_ = nullptr;       ///< 整帧绘制的目标（nullptr 为窗口）；世界层、离屏烘焙、底图结束后回到这里
+		std::vector<SDL_Rect> window_clip_stack_;   ///< 离屏渲染期间暂存的窗口裁剪栈（裁剪区域按渲染目标各自独立）
+
+		// --- 纹理解析缓存（同一帧内连续使用同一纹理的精灵跳过查表） ---
+		engine::resource::ResourceId last_texture_id_ = engine::resource::InvalidResourceId;
+		engine::resource::TextureRegion last_texture_region_{};
+		int last_texture_mip_ = 0;                  ///< last_texture_region_ 对应的图集缩小级
+
 	public:
 		/**
 		 * @brief 构造 Renderer 实例。
@@ -74,6 +172,168 @@ namespace engine::render {
 		 */
        void drawSprite(const Camera& camera, const engine::component::Sprite& sprite, const glm::vec2& position, const glm::vec2& size, float angle = 0.0f, const engine::utils::FColor& tint = { 1.0f, 1.0f, 1.0f, 1.0f });
 
+		/**
+		 * @brief 绘制一个视差图层，平铺时覆盖视口的全部副本合并为一次几何提交。
+		 * @param camera 用于计算视差偏移与视口范围的相机。
+		 * @param sprite 图层精灵（单个副本的纹理区域）。
+		 * @param position 图层的世界空间左上角坐标（平铺的对齐原点）。
+		 * @param size 单个副本的绘制大小，非正时不绘制。
+		 * @param scroll_factor 视差滚动因子，见 Camera::worldToScreenWithParallax()。
+		 * @param repeat 是否在 X / Y 轴上循环平铺。
+		 * @param tint 顶点颜色。
+		 * @return std::size_t 提交的副本数，图层完全在视口外时为 0。
+		 *
+		 * @details
+		 * 平铺轴上从视口左/上边缘之前最近的一个副本开始，连续铺到视口另一侧；
+		 * 每个副本是一个使用相同 UV 区间的四边形，因此图集中的纹理同样可以平铺。
+		 * 会先提交尚未结束的精灵批次，以保持绘制顺序。
+		 */
+		std::size_t drawParallaxLayer(const Camera& camera, const engine::component::Sprite& sprite,
+			const glm::vec2& position, const glm::vec2& size, const glm::vec2& scroll_factor, const glm::bvec2& repeat,
+			const engine::utils::FColor& tint = { 1.0f, 1.0f, 1.0f, 1.0f });
+
+		/**
+		 * @brief 开始一次精灵批处理。
+		 * 
+		 * @details
+		 * 在 beginSpriteBatch() 与 endSpriteBatch() 之间调用 drawSprite() 时，精灵不会立即绘制，
+		 * 而是以定长命令的形式记录到 RenderCommandList 中（相邻同纹理命令归为一段）。
+		 * 插入非批处理绘制或 endSpriteBatch() 时一次性展开顶点（命令多时分块并行）并逐段提交，
+		 * 因此绘制顺序与逐个提交时完全一致。着色通过顶点颜色实现，旋转与翻转直接烘焙到顶点/UV。
+		 */
+		void beginSpriteBatch();
+
+		/**
+		 * @brief 结束精灵批处理，提交剩余顶点。
+		 */
+		void endSpriteBatch();
+
+		/**
+		 * @brief 将后续绘制重定向到指定的渲染目标纹理，并以透明色清空。
+		 * @param target 以 SDL_TEXTUREACCESS_TARGET 创建的纹理。
+		 * @return bool 设置成功返回 true。
+		 */
+		bool beginRenderToTexture(SDL_Texture* target);
+
+		/**
+		 * @brief 恢复默认渲染目标（窗口，或进行中的世界层渲染目标）。
+		 */
+		void endRenderToTexture();
+
+		/**
+		 * @brief 开启/关闭世界层渲染目标。
+		 * @details 开启后 beginWorldPass() 与 endWorldPass() 之间的绘制落在逻辑分辨率（即地图像素网格）的纹理上，
+		 *          结束时以最近邻采样一次放大到窗口。高分辨率显示器上世界精灵的填充与混合只按逻辑像素计算，
+		 *          配合整数倍逻辑呈现得到像素完美的画面；其后的 UI 仍按输出分辨率绘制。
+		 */
+		void setWorldTargetEnabled(bool enabled) { world_target_enabled_ = enabled; }
+		[[nodiscard]] bool isWorldTargetEnabled() const { return world_target_enabled_; }
+
+		/**
+		 * @brief 开始世界层绘制（未开启世界层渲染目标或已在进行中时什么也不做）。
+		 */
+		void beginWorldPass();
+
+		/**
+		 * @brief 结束世界层绘制：恢复窗口为渲染目标并把世界层纹理铺满逻辑画面（未在进行中时什么也不做）。
+		 */
+		void endWorldPass();
+
+		/**
+		 * @brief 销毁世界层渲染目标（需在 SDL_DestroyRenderer 之前调用），下一次 beginWorldPass() 重新创建。
+		 */
+		void releaseWorldTarget();
+
+		/**
+		 * @brief 冻结世界层：下一次世界层照常绘制并保留在渲染目标中，其后每帧的世界层直接贴出这张缓存。
+		 * @details 供暂停、游戏结束等世界不再变化的空闲帧使用（未开启像素完美输出时也会为此创建渲染目标）。
+		 *          重放期间 isWorldReplaying() 为 true，场景应跳过世界层的绘制，只画其上的 UI 与菜单；
+		 *          逻辑分辨率变化时自动重新捕获。重复调用没有副作用。
+		 */
+		void freezeWorld() { world_frozen_ = true; }
+
+		/**
+		 * @brief 解除冻结并丢弃缓存，世界层恢复逐帧绘制；仅为冻结创建的渲染目标随之释放。
+		 */
+		void thawWorld();
+
+		/// @brief 本帧世界层是否由缓存重放（场景据此跳过世界层绘制）
+		[[nodiscard]] bool isWorldReplaying() const { return world_replaying_; }
+
+		/**
+		 * @brief 放弃进行中的世界层且不贴出（本帧不需要世界层时调用，例如栈底场景已由底图代替）。
+		 */
+		void discardWorldPass();
+
+		/**
+		 * @brief 开始捕获底图：放弃进行中的世界层，之后的绘制（含再次开启的世界层）落在底图渲染目标上。
+		 * @details 供 SceneManager 把被叠加场景覆盖的场景画一次；底图为逻辑分辨率，以背景色清空。
+		 * @return bool 底图渲染目标可用时返回 true。
+		 */
+		bool beginUnderlayCapture();
+
+		/**
+		 * @brief 结束捕获，恢复窗口为渲染目标，并把覆盖层要求的效果一次烘焙进底图。
+		 * @param dim 压暗程度 [0, 1]（叠加的黑色不透明度）。
+		 * @param blur_passes 模糊级数：每级缩小一半，结束后线性放大回原尺寸。
+		 */
+		void endUnderlayCapture(float dim, int blur_passes);
+
+		/// @brief 底图有效且与当前逻辑分辨率一致（分辨率变化后需重新捕获）
+		[[nodiscard]] bool hasUnderlay() const;
+
+		/// @brief 标记底图失效（场景栈变化时），下一次需要时重新捕获
+		void invalidateUnderlay() { underlay_valid_ = false; }
+
+		/// @brief 把底图铺满逻辑画面（没有有效底图时不做任何事）。
+		void drawUnderlay();
+
+		/// @brief 销毁底图渲染目标（需在 SDL_DestroyRenderer 之前调用）。
+		void releaseUnderlay();
+
+		/**
+		 * @brief 把之后的整帧绘制重定向到 target 并以背景色清空；传 nullptr 恢复窗口。
+		 * @details 用于帧捕获：场景画在逻辑分辨率的暂存纹理上，再整张贴回窗口。
+		 *          世界层、离屏烘焙与底图捕获结束时都回到该目标而不是窗口。需在 beginWorldPass() 之前设置。
+		 */
+		void setFrameTarget(SDL_Texture* target);
+
+		/// @brief 把纹理整张铺满当前渲染目标的逻辑画面
+		void drawFullscreenTexture(SDL_Texture* texture);
+
+		/// @brief 世界层、底图与帧捕获渲染目标的尺寸：逻辑分辨率，未设置逻辑呈现时取输出尺寸
+		[[nodiscard]] glm::ivec2 getLogicalTargetSize() const;
+
+		/**
+		 * @brief 在当前渲染目标的局部坐标中绘制精灵（不经过相机变换与视口裁剪）。
+		 * @param sprite 要绘制的精灵。
+		 * @param position 渲染目标内的左上角坐标。
+		 * @param size 绘制大小。
+		 * 
+		 * @details 用于离屏烘焙（如静态瓦片区块），需在 beginRenderToTexture() 之后调用。
+		 */
+		void drawSpriteToTarget(const engine::component::Sprite& sprite, const glm::vec2& position, const glm::vec2& size);
+
+		/**
+		 * @brief 把每张纹理各画一次到临时的小离屏目标上并立即提交给驱动。
+		 * @param textures 需要预热的纹理（重复项与空指针会跳过重复绘制或忽略）。
+		 * @return 实际绘制的纹理数。
+		 *
+		 * @details 驱动通常在纹理第一次被采样时才完成上传与驻留，场景加载末尾调用一次，
+		 *          这部分开销落在加载期而不是第一次绘制该纹理的那一帧。不计入帧统计。
+		 */
+		std::size_t warmTextures(std::span<SDL_Texture* const> textures);
+
+		/**
+		 * @brief 获取最近一次精灵批处理的统计。
+		 */
+		[[nodiscard]] const SpriteBatchStats& getSpriteBatchStats() const { return batch_stats_; }
+
+		/**
+		 * @brief 获取上一帧（最近一次 present）的绘制统计。
+		 */
+		[[nodiscard]] const RenderFrameStats& getFrameStats() const { return last_frame_stats_; }
+
 		/**
 		 * @brief 在屏幕空间（UI 层）中绘制一个图片。
 		 * @param image 要绘制的图片。
@@ -105,8 +365,66 @@ namespace engine::render {
 		 * @brief 在屏幕空间（UI 层）中绘制一个矩形边框。
 		 * @param rect 矩形区域。
 		 * @param color 边框颜色。
+		 * @param thickness 边框宽度（像素，向内），由四个纯色四边形组成。
+		 */
+		void drawUIOutlineRect(const engine::utils::Rect& rect, const engine::utils::FColor& color, float thickness = 1.0f);
+
+		/**
+		 * @brief 在屏幕空间（UI 层）中一次性绘制一组填充矩形。
+		 * @param rects 矩形列表，按顺序绘制（后面的覆盖前面的）。
+		 * 
+		 * @details 与 drawUIFilledRect 相同地追加到 UI 绘制列表，只省去逐个调用的开销，适用于血条等大量小矩形。
+		 */
+		void drawUIFilledRects(std::span<const UIFilledRect> rects);
+
+		/**
+		 * @brief 在屏幕空间（UI 层）中以九宫格方式绘制图片，四角不随目标尺寸拉伸。
+		 * @param image 要绘制的图片。
+		 * @param dest 屏幕上的目标区域。
+		 * @param slice 源图四边的不拉伸宽度（像素）；目标区域不足以放下两侧时按比例缩小。
+		 * @param tint 顶点颜色。
+		 */
+		void drawUINineSlice(const Image& image,
+				  const engine::utils::Rect& dest,
+				  const UINineSlice& slice,
+				  const engine::utils::FColor& tint = { 1.0f, 1.0f, 1.0f, 1.0f });
+
+		/**
+		 * @brief 创建一张用于缓存 UI 子树的渲染目标纹理（调用方负责 SDL_DestroyTexture）。
+		 * @param size 纹理尺寸（像素）。
+		 * @return 失败时返回 nullptr。
+		 * 
+		 * @details 纹理以透明色清空后按普通 alpha 混合绘入，内容即为预乘 alpha，
+		 *          因此混合模式设为 SDL_BLENDMODE_BLEND_PREMULTIPLIED，贴回屏幕时与直接绘制结果一致。
 		 */
-		void drawUIOutlineRect(const engine::utils::Rect& rect, const engine::utils::FColor& color);
+		[[nodiscard]] SDL_Texture* createUICacheTexture(glm::ivec2 size);
+
+		/**
+		 * @brief 在屏幕空间（UI 层）中绘制整张纹理。
+		 * @param texture 要绘制的纹理（通常为 createUICacheTexture() 创建的缓存）。
+		 * @param src 纹理内的源区域。
+		 * @param dest 屏幕上的目标区域。
+		 */
+		void drawUITexture(SDL_Texture* texture, const engine::utils::Rect& src, const engine::utils::Rect& dest);
+
+		/**
+		 * @brief 压入一个 UI 裁剪矩形，后续 UI 绘制只作用于它与当前裁剪区域的交集。
+		 * @param rect 当前渲染目标坐标系中的裁剪区域。
+		 */
+		void pushUIClipRect(const engine::utils::Rect& rect);
+
+		/**
+		 * @brief 弹出最近一次压入的 UI 裁剪矩形，恢复上一层裁剪区域（栈空时关闭裁剪）。
+		 */
+		void popUIClipRect();
+
+		/**
+		 * @brief 提交所有延迟的绘制（精灵批次与 UI 绘制列表）。
+		 * 
+		 * @details Renderer 内部在裁剪、渲染目标切换与 present 时自动调用；
+		 *          绕过 Renderer 直接使用 SDL_Renderer 绘制（TextRenderer、ImGui）之前必须调用，以保证绘制顺序。
+		 */
+		void flush();
 
 		/**
 		 * @brief 将当前的后备缓冲区呈现到屏幕。
@@ -143,6 +461,11 @@ namespace engine::render {
 		 */
 		void setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255);
 
+		/**
+		 * @brief 设置用于并行展开精灵批次顶点的任务系统（为空时串行展开）。
+		 */
+		void setJobSystem(engine::core::JobSystem* job_system) { job_system_ = job_system; }
+
 		/**
 		 * @brief 获取原始 SDL 渲染器指针。
 		 * @return SDL_Renderer* 内部渲染器指针。
@@ -159,11 +482,20 @@ namespace engine::render {
 
 	private:
 		/**
-		 * @brief 根据精灵状态（如动画帧）计算纹理的源矩形区域。
+		 * @brief 计算图片在（图集页或独立）纹理中的源矩形区域。
 		 * @param image 图片对象。
-		 * @return std::optional<SDL_FRect> 源矩形，若无有效纹理则返回 nullopt。
+		 * @param region 图片纹理解析后的绘制位置。
+		 * @return std::optional<SDL_FRect> 源矩形，若尺寸无效则返回 nullopt。
 		 */
-		std::optional<SDL_FRect> getImageSrcRect(const Image& image);
+		std::optional<SDL_FRect> getImageSrcRect(const Image& image, const engine::resource::TextureRegion& region);
+
+		/**
+		 * @brief 解析精灵纹理，与上一次解析的 ID 相同时直接复用结果。
+		 * @details 缓存只在一帧内有效（clearScreen/present 时清除）；占位纹理不缓存。缩小级不同视为不同的查询。
+		 * @param mip_level 图集缩小级（由相机缩放倍数决定）。
+		 */
+		const engine::resource::TextureRegion& resolveTexture(engine::resource::ResourceId id, std::string_view file_path, int mip_level = 0);
+		void resetTextureCache();
 
 		/**
 		 * @brief 检查一个矩形是否在相机的可见视口内。
@@ -175,5 +507,41 @@ namespace engine::render {
 		 * 实现了简单的视锥体剔除，优化渲染性能。
 		 */
 		bool isRectInViewport(const Camera& camera, const SDL_FRect& rect);
+
+		/**
+		 * @brief 将一条精灵命令追加到当前批次。
+		 * @param texture 精灵纹理。
+		 * @param src_rect 纹理源矩形（像素）。
+		 * @param dest_rect 目标矩形（乘以相机缩放倍数后的世界坐标）。
+		 * @param offset 展开顶点时加到目标矩形上的偏移（负的相机位置 × 缩放倍数），同偏移的相邻命令共享一段。
+		 * @param angle 绕目标矩形中心的旋转角度（度）。
+		 * @param flip_horizontal 是否水平翻转。
+		 * @param tint 顶点颜色。
+		 */
+		void appendBatchQuad(SDL_Texture* texture, const SDL_FRect& src_rect, const SDL_FRect& dest_rect,
+			glm::vec2 offset, float angle, bool flip_horizontal, const engine::utils::FColor& tint);
+
+		/**
+		 * @brief 展开并提交当前批次（如有），每段同纹理命令一次 SDL_RenderGeometry。
+		 * 
+		 * @details 追加 UI 四边形前调用，以保证绘制顺序；其余场合使用 flush()。
+		 */
+		void flushSpriteBatch();
+
+		/**
+		 * @brief 向 UI 绘制列表追加一个四边形，与上一个四边形纹理相同时并入同一段。
+		 * @param texture 纹理，纯色四边形为 nullptr。
+		 * @param src_rect 纹理内的源区域（像素），纯色四边形忽略。
+		 * @param dest_rect 屏幕上的目标区域。
+		 * @param color 顶点颜色（纹理的颜色调制）。
+		 */
+		void appendUIQuad(SDL_Texture* texture, const SDL_FRect& src_rect, const SDL_FRect& dest_rect, const SDL_FColor& color);
+
+		/**
+		 * @brief 按顺序提交 UI 绘制列表，每段一次 SDL_RenderGeometry。
+		 * 
+		 * @details 追加精灵批处理命令前调用，以保证绘制顺序；其余场合使用 flush()。
+		 */
+		void flushUIDrawList();
 	};
 }
\ No newline at end of file
@@ -3,10 +3,17 @@
 #include <stdexcept>
 #include <string>
 #include <glm/glm.hpp>
+#include <spdlog/spdlog.h>
 #include "../utils/math.h"
 
 #include "../resource/resource_manager.h"
+#include "../resource/glyph_atlas.h"
 #include "../resource/font_manager.h"
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
 
 namespace engine::render {
 
@@ -14,6 +21,20 @@ namespace engine::render {
     static bool ttf_initialized = false;
     static int text_renderer_instances = 0;
 
+    namespace {
+        constexpr glm::vec2 SHADOW_OFFSET{ 2.0f, 2.0f };               ///< 阴影相对正文的偏移
+        constexpr SDL_FColor SHADOW_COLOR{ 0.0f, 0.0f, 0.0f, 1.0f };
+
+        /// @brief 可缩放图集的排版以字号 0 为键，与普通字号的排版互不干扰
+        constexpr int SCALABLE_LAYOUT_SIZE = 0;
+
+        /// @brief 排版缓存的键：字符串哈希与 (字体 ID, 字号) 混合
+        std::uint64_t layoutKey(engine::resource::ResourceId font_id, int font_size, std::string_view text) {
+            const std::uint64_t font_bits = (static_cast<std::uint64_t>(font_id) << 32) | static_cast<std::uint32_t>(font_size);
+            return std::hash<std::string_view>{}(text) ^ (font_bits * 0x9E3779B97F4A7C15ull);
+        }
+    }
+
     /**
      * @brief 构造 TextRenderer 实例。
      * @param sdl_renderer SDL 渲染器指针
@@ -32,26 +53,12 @@ namespace engine::render {
             }
             ttf_initialized = true;
         }
-        
-        // 初始化 TTF_TextEngine
-        text_engine_ = TTF_CreateRendererTextEngine(sdl_renderer_);
-        if (!text_engine_) {
-            throw std::runtime_error("Failed to create TTF_TextEngine: " + std::string(SDL_GetError()));
-        }
     }
     
     /**
      * @brief 析构函数，释放资源。
      */
     TextRenderer::~TextRenderer() {
-        // 必须先销毁缓存的 TTF_Text（它们依赖 text_engine_ / SDL_ttf 全局状态）
-        text_cache_.clear();
-
-        if (text_engine_) {
-            TTF_DestroyRendererTextEngine(text_engine_);
-            text_engine_ = nullptr;
-        }
-        
         // 关闭 SDL3_ttf 库（仅当所有 TextRenderer 实例都被销毁时）
         --text_renderer_instances;
         if (ttf_initialized && text_renderer_instances <= 0) {
@@ -86,30 +93,13 @@ namespace engine::render {
                                int font_size,
                                const glm::vec2& position,
                                const engine::utils::FColor& color) {
-        // 获取字体
-        TTF_Font* font = resource_manager_->getFont(font_id, font_path, font_size);
-        if (!font) {
+        auto* atlas = getAtlas(font_id, font_path, font_size);
+        if (!atlas) {
             return;
         }
         
-        // 将世界坐标转换为屏幕坐标
-        glm::vec2 screen_pos = camera.worldToScreen(position);
-        
-        // 创建文本对象
-        TTF_Text* ttf_text = TTF_CreateText(text_engine_, font, text.c_str(), 0);
-        if (!ttf_text) {
-            return;
-        }
-        TTF_SetTextColorFloat(ttf_text, 0.0f, 0.0f, 0.0f, 1.0f);
-        TTF_DrawRendererText(ttf_text, position.x + 2, position.y + 2);
-        
-        TTF_SetTextColorFloat(ttf_text, color.r, color.g, color.b, color.a);
-        
-        // 绘制文本
-        TTF_DrawRendererText(ttf_text, screen_pos.x, screen_pos.y);
-        
-        // 销毁文本对象
-        TTF_DestroyText(ttf_text);
+        // 将世界坐标转换为屏幕坐标（阴影与正文使用同一屏幕位置）
+        drawGlyphText(*atlas, getLayout(*atlas, font_id, font_size, text), camera.worldToScreen(position), color);
     }
     
     /**
@@ -135,44 +125,14 @@ namespace engine::render {
                                  int font_size,
                                  const glm::vec2& position,
                                  const engine::utils::FColor& color,
-                                 bool is_dirty) {
-        TTF_Text* ttf_text = nullptr;
-
-        if (is_dirty) {
-            // 获取字体
-            TTF_Font* font = resource_manager_->getFont(font_id, font_path, font_size);
-            if (!font) {
-                return;
-            }
-
-            // 从缓存获取 / 创建文本对象
-            ttf_text = getTTFText(text);
-            if (!ttf_text) {
-                ttf_text = createTTFText(text, font);
-                if (!ttf_text) {
-                    return;
-                }
-            }
-
-            // 仅在脏时同步状态（昂贵）
-            TTF_SetTextFont(ttf_text, font);
-            TTF_SetTextString(ttf_text, text.c_str(), 0);
-        } else {
-            // 干净时直接复用缓存
-            ttf_text = getTTFText(text);
-            if (!ttf_text) {
-                // 理论上不应发生：干净意味着之前已创建并同步
-                return;
-            }
+                                 bool /*is_dirty*/) {
+        auto* atlas = getAtlas(font_id, font_path, font_size);
+        if (!atlas) {
+            return;
         }
 
-        TTF_SetTextColorFloat(ttf_text, 0.0f, 0.0f, 0.0f, 1.0f);
-        TTF_DrawRendererText(ttf_text, position.x + 2, position.y + 2);
-
-        TTF_SetTextColorFloat(ttf_text, color.r, color.g, color.b, color.a);
-        
         // 直接使用屏幕坐标绘制文本
-        TTF_DrawRendererText(ttf_text, position.x, position.y);
+        drawGlyphText(*atlas, getLayout(*atlas, font_id, font_size, text), position, color);
     }
 
     void TextRenderer::drawUIText(std::string &&text, const std::string &font_path, int font_size, const glm::vec2 &position, const engine::utils::FColor &color)
@@ -187,28 +147,34 @@ namespace engine::render {
                                  const glm::vec2 &position,
                                  const engine::utils::FColor &color)
     {
-        // 获取字体
-        TTF_Font* font = resource_manager_->getFont(font_id, font_path, font_size);
-        if (!font) {
-            return;
-        }
-        
-        // 创建文本对象
-        TTF_Text* ttf_text = TTF_CreateText(text_engine_, font, text.c_str(), 0);
-        if (!ttf_text) {
+        // 字形已缓存，临时字符串与持久字符串走同一路径
+        drawUIText(text, font_id, font_path, font_size, position, color, true);
+    }
+
+    void TextRenderer::drawScaledUIText(std::string_view text,
+                                        engine::resource::ResourceId font_id,
+                                        std::string_view font_path,
+                                        float font_size,
+                                        const glm::vec2& position,
+                                        const engine::utils::FColor& color) {
+        auto* atlas = resource_manager_->getScalableGlyphAtlas(font_id, font_path);
+        if (!atlas || font_size <= 0.0f) {
             return;
         }
-        
-        TTF_SetTextColorFloat(ttf_text, 0.0f, 0.0f, 0.0f, 1.0f);
-        TTF_DrawRendererText(ttf_text, position.x + 2, position.y + 2); 
+        const float scale = font_size / static_cast<float>(engine::resource::FontManager::SCALABLE_BASE_SIZE);
+        drawGlyphText(*atlas, getLayout(*atlas, font_id, SCALABLE_LAYOUT_SIZE, text), position, color, scale);
+    }
 
-        TTF_SetTextColorFloat(ttf_text, color.r, color.g, color.b, color.a);
-        
-        // 直接使用屏幕坐标绘制文本
-        TTF_DrawRendererText(ttf_text, position.x, position.y);
-        
-        // 销毁文本对象
-        TTF_DestroyText(ttf_text);
+    glm::vec2 TextRenderer::getScaledTextSize(std::string_view text,
+                                              engine::resource::ResourceId font_id,
+                                              std::string_view font_path,
+                                              float font_size) {
+        auto* atlas = resource_manager_->getScalableGlyphAtlas(font_id, font_path);
+        if (!atlas || font_size <= 0.0f) {
+            return { 0.0f, 0.0f };
+        }
+        const float scale = font_size / static_cast<float>(engine::resource::FontManager::SCALABLE_BASE_SIZE);
+        return getLayout(*atlas, font_id, SCALABLE_LAYOUT_SIZE, text).size_ * scale;
     }
 
     /**
@@ -237,51 +203,189 @@ namespace engine::render {
                                         engine::resource::ResourceId font_id,
                                         std::string_view font_path,
                                         int font_size,
-                                        bool is_dirty) {
-        TTF_Font* font = resource_manager_->getFont(font_id, font_path, font_size);
-        if (!font) {
+                                        bool /*is_dirty*/) {
+        auto* atlas = getAtlas(font_id, font_path, font_size);
+        if (!atlas) {
             return { 0.0f, 0.0f };
         }
+        return getLayout(*atlas, font_id, font_size, text).size_;
+    }
+
+    engine::resource::GlyphAtlas* TextRenderer::getAtlas(engine::resource::ResourceId font_id,
+                                                         std::string_view font_path,
+                                                         int font_size) {
+        return resource_manager_->getGlyphAtlas(font_id, font_path, font_size);
+    }
+
+    void TextRenderer::drawTextBatch(const Camera& camera,
+                                     std::span<const WorldTextItem> items,
+                                     engine::resource::ResourceId font_id,
+                                     std::string_view font_path,
+                                     int font_size) {
+        if (items.empty()) {
+            return;
+        }
+        auto* atlas = getAtlas(font_id, font_path, font_size);
+        if (!atlas) {
+            return;
+        }
+        auto origin_of = [&](const WorldTextItem& item, const TextLayout& layout) {
+            const glm::vec2 screen = camera.worldToScreen(item.position_);
+            return glm::vec2{ std::round(screen.x - layout.size_.x * 0.5f), std::round(screen.y) };
+        };
+
+        // 与 drawGlyphText 相同：先阴影后正文，多页时阴影单独提交；第二遍的排版查询都会命中
+        for (const auto& item : items) {
+            const auto& layout = getLayout(*atlas, font_id, font_size, item.text_);
+            appendLayout(layout, origin_of(item, layout) + SHADOW_OFFSET,
+                         SDL_FColor{ SHADOW_COLOR.r, SHADOW_COLOR.g, SHADOW_COLOR.b, item.color_.a });
+        }
+        if (atlas->getPageCount() > 1) {
+            flushPages(*atlas);
+        }
+        for (const auto& item : items) {
+            const auto& layout = getLayout(*atlas, font_id, font_size, item.text_);
+            appendLayout(layout, origin_of(item, layout),
+                         SDL_FColor{ item.color_.r, item.color_.g, item.color_.b, item.color_.a });
+        }
+        flushPages(*atlas);
+    }
 
-        TTF_Text* ttf_text = nullptr;
-        if (is_dirty) {
-            ttf_text = getTTFText(text);
-            if (!ttf_text) {
-                ttf_text = createTTFText(text, font);
-                if (!ttf_text) {
-                    return { 0.0f, 0.0f };
-                }
+    const TextRenderer::TextLayout& TextRenderer::getLayout(engine::resource::GlyphAtlas& atlas,
+                                                            engine::resource::ResourceId font_id,
+                                                            int font_size,
+                                                            std::string_view text) {
+        const std::uint64_t key = layoutKey(font_id, font_size, text);
+        if (auto it = layouts_.find(key); it != layouts_.end()) {
+            auto& cached = it->second;
+            if (cached.atlas_serial_ == atlas.getSerial() && cached.text_ == text) {
+                cached.last_used_ = ++layout_serial_;
+                return cached;
             }
+        } else if (layouts_.size() >= LAYOUT_CACHE_CAPACITY) {
+            trimLayouts();
+        }
 
-            TTF_SetTextFont(ttf_text, font);
-            TTF_SetTextString(ttf_text, text.c_str(), 0);
-        } else {
-            ttf_text = getTTFText(text);
-            if (!ttf_text) {
-                return { 0.0f, 0.0f };
+        // 未命中、哈希碰撞或图集已重建：原地重新排版（碰撞时复用旧条目的容量）
+        auto& layout = layouts_[key];
+        layout.text_.assign(text);
+        layout.atlas_serial_ = atlas.getSerial();
+        layout.last_used_ = ++layout_serial_;
+        layout.glyphs_.clear();
+
+        float pen_x = 0.0f;
+        float pen_y = 0.0f;
+        float width = 0.0f;
+        int lines = 1;
+        std::uint32_t previous = 0;
+
+        const char* cursor = text.data();
+        std::size_t remaining = text.size();
+        while (remaining > 0) {
+            const std::uint32_t codepoint = SDL_StepUTF8(&cursor, &remaining);
+            if (codepoint == 0) {
+                break;
+            }
+            if (codepoint == '\n') {
+                width = std::max(width, pen_x);
+                pen_x = 0.0f;
+                pen_y += atlas.getLineSkip();
+                previous = 0;
+                ++lines;
+                continue;
             }
+            if (previous != 0) {
+                pen_x += atlas.getKerning(previous, codepoint);
+            }
+
+            const auto& glyph = atlas.getGlyph(codepoint);
+            if (glyph.src_.w > 0.0f) {
+                layout.glyphs_.push_back(LaidGlyph{ glyph.page_, glyph.src_, { pen_x, pen_y } });
+            }
+            pen_x += glyph.advance_;
+            previous = codepoint;
         }
+        // 尺寸与 GlyphAtlas::measureText 一致：最宽一行 × (行高 + 其余行的行距)
+        width = std::max(width, pen_x);
+        layout.size_ = text.empty() ? glm::vec2{ 0.0f, 0.0f }
+                                    : glm::vec2{ width, atlas.getLineHeight() + atlas.getLineSkip() * static_cast<float>(lines - 1) };
+        return layout;
+    }
 
-        int w = 0, h = 0;
-        TTF_GetTextSize(ttf_text, &w, &h);
-        return { static_cast<float>(w), static_cast<float>(h) };
+    void TextRenderer::trimLayouts() {
+        trim_scratch_.clear();
+        for (const auto& [key, layout] : layouts_) {
+            trim_scratch_.push_back(layout.last_used_);
+        }
+        const auto cut = trim_scratch_.begin() + static_cast<std::ptrdiff_t>(trim_scratch_.size() / 4);
+        std::nth_element(trim_scratch_.begin(), cut, trim_scratch_.end());
+        const std::uint64_t threshold = *cut;
+        std::erase_if(layouts_, [threshold](const auto& entry) { return entry.second.last_used_ < threshold; });
     }
-    TTF_Text *TextRenderer::getTTFText(const std::string &text)
-    {
-        const auto cache_key = reinterpret_cast<std::uintptr_t>(&text);
-        auto it = text_cache_.find(cache_key);
-        if (it == text_cache_.end()) {
-            return nullptr;
+
+    /**
+     * @brief 先阴影后正文。单页时两遍顶点合并为一次提交；
+     * 字形跨多页时先提交全部阴影，保证阴影不会盖住其他页上的正文。
+     */
+    void TextRenderer::drawGlyphText(const engine::resource::GlyphAtlas& atlas,
+                                     const TextLayout& layout,
+                                     const glm::vec2& position,
+                                     const engine::utils::FColor& color,
+                                     float scale) {
+        if (layout.glyphs_.empty()) {
+            return;
+        }
+        // 对齐到整数像素，避免位图字体被线性过滤模糊
+        const glm::vec2 origin{ std::round(position.x), std::round(position.y) };
+
+        appendLayout(layout, origin + SHADOW_OFFSET, SHADOW_COLOR, scale);
+        if (atlas.getPageCount() > 1) {
+            flushPages(atlas);
         }
-        return it->second.get();
+        appendLayout(layout, origin, SDL_FColor{ color.r, color.g, color.b, color.a }, scale);
+        flushPages(atlas);
     }
-    TTF_Text *TextRenderer::createTTFText(const std::string &text, TTF_Font *font)
-    {
-        const auto cache_key = reinterpret_cast<std::uintptr_t>(&text);
-        auto& slot = text_cache_[cache_key];
-        if (!slot) {
-            slot = std::unique_ptr<TTF_Text, TTFTextDeleter>(TTF_CreateText(text_engine_, font, text.c_str(), 0));
+
+    void TextRenderer::appendLayout(const TextLayout& layout, const glm::vec2& position, const SDL_FColor& color, float scale) {
+        constexpr float inv_page = 1.0f / static_cast<float>(engine::resource::GlyphAtlas::PAGE_SIZE);
+        for (const auto& glyph : layout.glyphs_) {
+            if (page_batches_.size() <= glyph.page_) {
+                page_batches_.resize(glyph.page_ + 1);
+            }
+            auto& batch = page_batches_[glyph.page_];
+            const int base = static_cast<int>(batch.vertices_.size());
+            const float u0 = glyph.src_.x * inv_page;
+            const float v0 = glyph.src_.y * inv_page;
+            const float u1 = (glyph.src_.x + glyph.src_.w) * inv_page;
+            const float v1 = (glyph.src_.y + glyph.src_.h) * inv_page;
+            const float x0 = position.x + glyph.offset_.x * scale;
+            const float y0 = position.y + glyph.offset_.y * scale;
+            const float x1 = x0 + glyph.src_.w * scale;
+            const float y1 = y0 + glyph.src_.h * scale;
+            batch.vertices_.push_back(SDL_Vertex{ { x0, y0 }, color, { u0, v0 } });
+            batch.vertices_.push_back(SDL_Vertex{ { x1, y0 }, color, { u1, v0 } });
+            batch.vertices_.push_back(SDL_Vertex{ { x1, y1 }, color, { u1, v1 } });
+            batch.vertices_.push_back(SDL_Vertex{ { x0, y1 }, color, { u0, v1 } });
+            batch.indices_.insert(batch.indices_.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        }
+    }
+
+    void TextRenderer::flushPages(const engine::resource::GlyphAtlas& atlas) {
+        if (before_submit_) {
+            before_submit_();
+        }
+        for (std::size_t page = 0; page < page_batches_.size(); ++page) {
+            auto& batch = page_batches_[page];
+            if (batch.vertices_.empty()) {
+                continue;
+            }
+            if (!SDL_RenderGeometry(sdl_renderer_, atlas.getPageTexture(static_cast<std::uint32_t>(page)),
+                                    batch.vertices_.data(), static_cast<int>(batch.vertices_.size()),
+                                    batch.indices_.data(), static_cast<int>(batch.indices_.size()))) {
+                spdlog::error("批量渲染文本失败：{}", SDL_GetError());
+            }
+            batch.vertices_.clear();
+            batch.indices_.clear();
         }
-        return slot.get();
     }
-}
\ No newline at end of file
+}
@@ -2,14 +2,27 @@
 /**
  * @file text_renderer.h
  * @brief 定义 TextRenderer 类，用于处理 SDL3_ttf 文本渲染。
+ *
+ * @details
+ * 文本按 FontManager 中缓存的字形图集排版，每个字形只在首次出现时光栅化一次；
+ * 之后任意字符串（包括每帧变化的数字）都只需查表生成顶点，不再创建 TTF_Text 或分配纹理。
+ *
+ * 排版结果（尺寸与逐字形的四边形）按 (字体 ID, 字号, 字符串哈希) 缓存在 LRU 表中：
+ * 内容不变的文本再次测量或绘制只是一次哈希查找，不再逐字解码 UTF-8、查字距，也不分配内存。
+ *
+ * drawScaledUIText() 使用字体的可缩放图集（固定字号光栅化、线性过滤），按目标字号缩放排版结果，
+ * 适合波次横幅等大字号或字号随动画变化的文本。
  */
 
+#include <functional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <glm/vec2.hpp>
-#include <SDL3_ttf/SDL_ttf.h>
+#include <SDL3/SDL_render.h>
+#include <vector>
 #include <unordered_map>
-#include <memory>
+#include <utility>
 #include <cstddef>
 #include <cstdint>
 #include "../resource/resource_id.h"
@@ -22,6 +35,7 @@ namespace engine::utils {
 }
 namespace engine::resource {
     class ResourceManager;
+    class GlyphAtlas;
 }
 
 namespace engine::render {
@@ -34,19 +48,53 @@ namespace engine::render {
      * 支持两种文本渲染模式：
      * 1. UI 文本：直接使用屏幕坐标，不跟随相机移动
      * 2. 世界文本：使用世界坐标，跟随相机移动
+     * 
+     * 每次绘制先写入阴影顶点，再写入正文顶点，同一图集页的顶点一次 SDL_RenderGeometry 提交。
      */
     class TextRenderer final {
+    public:
+        /// @brief drawTextBatch() 的一条世界文本
+        struct WorldTextItem {
+            std::string_view text_;
+            glm::vec2 position_{ 0.0f, 0.0f };          ///< 世界坐标，文本顶边中点对齐到此处
+            engine::utils::FColor color_{ 1.0f, 1.0f, 1.0f, 1.0f };
+        };
     private:
         /// SDL 渲染上下文指针
         SDL_Renderer* sdl_renderer_ = nullptr;
         /// 资源管理器指针，用于获取字体
         engine::resource::ResourceManager* resource_manager_ = nullptr;
-        /// SDL3_ttf 文本引擎，用于高效渲染文本
-        TTF_TextEngine* text_engine_ = nullptr;
-        struct TTFTextDeleter {
-            void operator()(TTF_Text* text) const { if (text) TTF_DestroyText(text); }
+        /**
+         * @brief 单个图集页的顶点缓冲（跨帧复用）
+         */
+        struct PageBatch {
+            std::vector<SDL_Vertex> vertices_;
+            std::vector<int> indices_;
+        };
+        std::vector<PageBatch> page_batches_;
+        /// 提交字形顶点前调用（由 GameApp 设为 Renderer::flush，保证文本画在之前的 UI 之上）
+        std::function<void()> before_submit_;
+
+        /// @brief 排版后的一个字形四边形（相对文本左上角）
+        struct LaidGlyph {
+            std::uint32_t page_{ 0 };
+            SDL_FRect src_{};                       ///< 图集内的像素区域
+            glm::vec2 offset_{ 0.0f, 0.0f };
         };
-        std::unordered_map<std::uintptr_t, std::unique_ptr<TTF_Text, TTFTextDeleter>> text_cache_;
+        /**
+         * @brief 一段文本的排版缓存
+         */
+        struct TextLayout {
+            std::string text_;                      ///< 原文，键的哈希碰撞时比较
+            std::uint32_t atlas_serial_{ 0 };       ///< 排版时的图集实例，字体卸载重建后重新排版
+            glm::vec2 size_{ 0.0f, 0.0f };
+            std::vector<LaidGlyph> glyphs_;
+            std::uint64_t last_used_{ 0 };
+        };
+        static constexpr std::size_t LAYOUT_CACHE_CAPACITY = 1024;     ///< 超出后淘汰最久未用的四分之一
+        std::unordered_map<std::uint64_t, TextLayout> layouts_;         ///< (字体 ID, 字号, 字符串哈希) → 排版
+        std::uint64_t layout_serial_ = 0;                               ///< 每次查询递增（LRU）
+        std::vector<std::uint64_t> trim_scratch_;                       ///< 淘汰时排序用，跨次复用
     public:
         /**
          * @brief 构造 TextRenderer 实例。
@@ -84,6 +132,16 @@ namespace engine::render {
                  const glm::vec2& position,
                  const engine::utils::FColor& color);
 
+        /**
+         * @brief 以同一字体绘制一组世界文本（如飘字），全部阴影与正文合并提交。
+         * @details 单页图集时整组只有一次 SDL_RenderGeometry；字形跨多页时先提交全部阴影，再提交全部正文。
+         */
+        void drawTextBatch(const Camera& camera,
+                           std::span<const WorldTextItem> items,
+                           engine::resource::ResourceId font_id,
+                           std::string_view font_path,
+                           int font_size);
+
         /**
          * @brief 在屏幕空间中绘制文本（UI 层，不跟随相机）。
          * @param text 要绘制的文本字符串。
@@ -91,6 +149,7 @@ namespace engine::render {
          * @param font_size 字体大小（点值）。
          * @param position 文本的屏幕坐标位置。
          * @param color 文本颜色。
+         * @param is_dirty 兼容旧接口保留；字形缓存后无需区分文本是否变化。
          */
         void drawUIText(const std::string& text,
                        const std::string& font_path,
@@ -126,6 +185,23 @@ namespace engine::render {
                    int font_size,
                    const glm::vec2& position,
                    const engine::utils::FColor& color);
+        /**
+         * @brief 以可缩放图集在屏幕空间绘制文本，字号可为任意值且逐帧变化，不会为新字号打开字体或光栅化。
+         * @param font_size 目标字号（点值，可为小数）。
+         */
+        void drawScaledUIText(std::string_view text,
+                              engine::resource::ResourceId font_id,
+                              std::string_view font_path,
+                              float font_size,
+                              const glm::vec2& position,
+                              const engine::utils::FColor& color);
+
+        /// @brief drawScaledUIText() 绘制时的文本尺寸
+        glm::vec2 getScaledTextSize(std::string_view text,
+                                    engine::resource::ResourceId font_id,
+                                    std::string_view font_path,
+                                    float font_size);
+
         /**
          * @brief 获取文本的渲染尺寸。
          * @param text 文本内容。
@@ -147,13 +223,43 @@ namespace engine::render {
                       int font_size,
                       bool is_dirty);
 
+        /**
+         * @brief 设置每次提交字形顶点前的回调。
+         * @details 文本直接使用 SDL_Renderer 绘制，而 Renderer 的 UI 绘制列表会延迟提交；
+         *          回调应先提交其中已记录的面板与图片，否则它们会盖住之后绘制的文本。
+         */
+        void setBeforeSubmit(std::function<void()> callback) { before_submit_ = std::move(callback); }
+
+        /// @brief 排版缓存中的条目数
+        [[nodiscard]] std::size_t getLayoutCacheSize() const { return layouts_.size(); }
+
         // 禁用拷贝和移动语义
         TextRenderer(const TextRenderer&) = delete;
         TextRenderer& operator=(const TextRenderer&) = delete;
         TextRenderer(TextRenderer&&) = delete;
         TextRenderer& operator=(TextRenderer&&) = delete;
     private:
-        TTF_Text* getTTFText(const std::string& text);
-        TTF_Text* createTTFText(const std::string& text, TTF_Font* font);
+        /// @brief 获取字体对应的字形图集
+        engine::resource::GlyphAtlas* getAtlas(engine::resource::ResourceId font_id, std::string_view font_path, int font_size);
+
+        /**
+         * @brief 取文本的排版，未缓存（或图集已重建）时按字形度量排版并写入缓存
+         * @details 返回的引用在下一次 getLayout() 之前有效（之后可能被淘汰）。
+         */
+        const TextLayout& getLayout(engine::resource::GlyphAtlas& atlas, engine::resource::ResourceId font_id,
+                                    int font_size, std::string_view text);
+
+        /// @brief 超出容量时按最近使用序号淘汰最久未用的四分之一
+        void trimLayouts();
+
+        /// @brief 绘制阴影与正文（屏幕坐标），scale 为可缩放图集的缩放比例
+        void drawGlyphText(const engine::resource::GlyphAtlas& atlas, const TextLayout& layout,
+                           const glm::vec2& position, const engine::utils::FColor& color, float scale = 1.0f);
+
+        /// @brief 将排版好的四边形按 scale 缩放并平移到 position，追加到对应图集页的顶点缓冲
+        void appendLayout(const TextLayout& layout, const glm::vec2& position, const SDL_FColor& color, float scale = 1.0f);
+
+        /// @brief 提交并清空所有图集页的顶点缓冲
+        void flushPages(const engine::resource::GlyphAtlas& atlas);
     };
 }
\ No newline at end of file
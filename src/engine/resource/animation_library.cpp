@@ -0,0 +1,46 @@
+#include "animation_library.h"
+#include "../memory/memory_estimate.h"
+#include "../memory/memory_tracker.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::resource {
+
+AnimationLibrary::AnimationLibrary()
+    : sets_(engine::memory::MemoryTracker::instance().resource(engine::memory::MemoryTag::ANIMATION)) {
+}
+
+AnimationLibrary::AnimationSetPtr AnimationLibrary::add(ResourceId group, ResourceId id, engine::component::AnimationSet animations) {
+    const std::pmr::polymorphic_allocator<engine::component::AnimationSet> allocator{ sets_.get_allocator().resource() };
+    AnimationSetPtr set = std::allocate_shared<engine::component::AnimationSet>(allocator, std::move(animations));
+    auto [it, inserted] = sets_.insert_or_assign(makeKey(group, id), set);
+    if (!inserted) {
+        spdlog::warn("动画集合被覆盖: group={}, id={}", group, id);
+    }
+    return it->second;
+}
+
+AnimationLibrary::AnimationSetPtr AnimationLibrary::get(ResourceId group, ResourceId id) const {
+    if (auto it = sets_.find(makeKey(group, id)); it != sets_.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+bool AnimationLibrary::contains(ResourceId group, ResourceId id) const {
+    return sets_.contains(makeKey(group, id));
+}
+
+std::size_t AnimationLibrary::getContentBytes() const {
+    using engine::memory::containerBytes;
+    std::size_t bytes = 0;
+    for (const auto& [key, set] : sets_) {
+        bytes += containerBytes(*set);
+        for (const auto& [name, animation] : *set) {
+            bytes += containerBytes(animation.frames_) + containerBytes(animation.events_) +
+                     containerBytes(animation.frame_end_ms_) + containerBytes(animation.event_mask_);
+        }
+    }
+    return bytes;
+}
+
+} // namespace engine::resource
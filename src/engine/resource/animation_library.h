@@ -0,0 +1,75 @@
+/**
+ * @file animation_library.h
+ * @brief 定义 AnimationLibrary 类，集中存放可共享的不可变动画集合。
+ *
+ * @details
+ * 同一类实体（如同一种敌人）的动画帧序列与帧事件完全相同。AnimationLibrary 为每一类
+ * 只构建一份 AnimationSet，实体的 AnimationComponent 仅持有其共享句柄，
+ * 避免每次生成实体时复制整套 unordered_map / vector。
+ *
+ * 动画集合以 (分组ID, 条目ID) 为键，分组用于区分不同来源（如敌人、玩家、投射物），
+ * 避免不同类别中同名条目互相覆盖。
+ *
+ * 查找表与集合对象本身从 MemoryTag::ANIMATION 的计数内存资源分配；集合内部的帧数组与事件表
+ * 由 getContentBytes() 估算。
+ *
+ * @see engine::component::AnimationComponent 持有共享句柄的组件
+ */
+
+#pragma once
+#include "resource_id.h"
+#include "../component/animation_component.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <unordered_map>
+
+namespace engine::resource {
+
+    /**
+     * @class AnimationLibrary
+     * @brief 不可变动画集合的存储库，按 (分组, ID) 查找。
+     */
+    class AnimationLibrary final {
+    public:
+        using AnimationSetPtr = std::shared_ptr<const engine::component::AnimationSet>;
+
+        AnimationLibrary();
+
+        /**
+         * @brief 添加（或替换）一个动画集合
+         * @param group 分组ID
+         * @param id 条目ID
+         * @param animations 动画集合
+         * @return 新集合的共享句柄
+         */
+        AnimationSetPtr add(ResourceId group, ResourceId id, engine::component::AnimationSet animations);
+
+        /**
+         * @brief 获取动画集合
+         * @return 共享句柄，不存在时返回 nullptr
+         */
+        [[nodiscard]] AnimationSetPtr get(ResourceId group, ResourceId id) const;
+
+        /** @brief 是否存在指定动画集合 */
+        [[nodiscard]] bool contains(ResourceId group, ResourceId id) const;
+
+        /** @brief 动画集合数量 */
+        [[nodiscard]] std::size_t size() const { return sets_.size(); }
+
+        /** @brief 清空所有动画集合（已被实体引用的集合在引用释放前仍然有效） */
+        void clear() { sets_.clear(); }
+
+        /** @brief 集合内部帧数组、事件表等堆内存的估算（字节） */
+        [[nodiscard]] std::size_t getContentBytes() const;
+
+    private:
+        static std::uint64_t makeKey(ResourceId group, ResourceId id) {
+            return (static_cast<std::uint64_t>(group) << 32) | static_cast<std::uint64_t>(id);
+        }
+
+        std::pmr::unordered_map<std::uint64_t, AnimationSetPtr> sets_;  ///< (分组, ID) 到共享动画集合的映射
+    };
+
+} // namespace engine::resource
@@ -3,57 +3,199 @@
 #include <stdexcept>
 #include <string>
 #include <algorithm> // for std::clamp
+#include <cmath>
+#include <chrono>
 #include <spdlog/spdlog.h>
+#include "../core/task_pool.h"
+#include "../io/virtual_fs.h"
+#include "../utils/profiler.h"
 
 namespace engine::resource {
 
+    namespace {
+        using CachedAudio = AudioManager::CachedAudio;
+        using AudioFuture = std::future<CachedAudio>;
+
+        /// 衰减后低于该增益的空间化音效直接剔除，不占用声部
+        constexpr float MIN_AUDIBLE_GAIN = 0.05f;
+
+        /// 之后打开的混音器设备使用的输出格式（setDeviceSettings）
+        AudioDeviceSettings configured_device{};
+
+        /**
+         * @brief 按距离线性衰减的增益。
+         * @param delta 发射器到听众的位移
+         * @param max_distance 最大有效距离（> 0）
+         */
+        float spatialGain(const glm::vec2& delta, float max_distance) {
+            const float dist = std::sqrt((delta.x * delta.x) + (delta.y * delta.y));
+            return std::clamp(1.0f - (dist / max_distance), 0.0f, 1.0f);
+        }
+
+        /**
+         * @brief 估算音频的常驻内存
+         * @details 预解码音效按 帧数 × 声道数 × 采样字节数 估算 PCM 大小；
+         *          流式音乐只保留压缩数据，按文件大小计。
+         */
+        std::size_t residentBytes(MIX_Audio* audio, const std::string& path, bool predecode) {
+            if (!audio) {
+                return 0;
+            }
+            if (predecode) {
+                SDL_AudioSpec spec{};
+                const Sint64 frames = MIX_GetAudioDuration(audio);
+                if (frames > 0 && MIX_GetAudioFormat(audio, &spec)) {
+                    return static_cast<std::size_t>(frames) * static_cast<std::size_t>(spec.channels) *
+                           static_cast<std::size_t>(SDL_AUDIO_BYTESIZE(spec.format));
+                }
+            }
+            const auto size = engine::io::VirtualFS::instance().fileSize(path);
+            return size ? static_cast<std::size_t>(*size) : 0u;
+        }
+
+        /**
+         * @brief 加载音频并估算其常驻内存（可在任意线程调用）
+         * @details 传入 mixer 后预解码会直接解码为混音器的输出格式：采样率不同的音效在这里重采样一次，
+         *          播放时不再转换。常驻内存因此按设备格式计。
+         */
+        CachedAudio loadAudio(MIX_Mixer* mixer, const std::string& path, bool predecode) {
+            MIX_Audio* audio = MIX_LoadAudio_IO(mixer, engine::io::VirtualFS::instance().openIO(path), predecode, true);
+            return CachedAudio{ std::unique_ptr<MIX_Audio, AudioManager::MixAudioDeleter>(audio), residentBytes(audio, path, predecode) };
+        }
+
+        /// @brief 在工作线程上加载音频（MIX_LoadAudio 可在任意线程调用）
+        AudioFuture decodeAsync(engine::core::TaskPool& tasks, MIX_Mixer* mixer, std::string path, bool predecode) {
+            return tasks.submit(engine::core::TaskPriority::BACKGROUND, [mixer, path = std::move(path), predecode]() {
+                CachedAudio loaded = loadAudio(mixer, path, predecode);
+                if (!loaded.audio_) {
+                    spdlog::error("后台加载音频失败: {} 错误: {}", path, SDL_GetError());
+                }
+                return loaded;
+            });
+        }
+
+        /// @brief 等待后台解码完成，返回结果（失败或不存在时 audio_ 为空）
+        template <typename Pending>
+        CachedAudio takePending(Pending& pending, ResourceId id) {
+            auto it = pending.find(id);
+            if (it == pending.end()) {
+                return {};
+            }
+            CachedAudio loaded = it->second.get();
+            pending.erase(it);
+            return loaded;
+        }
+
+        /// @brief 等待仍在解码的任务后丢弃结果（任务使用 mixer，线程池的 future 析构时不等待）
+        template <typename Pending>
+        void discardPending(Pending& pending) {
+            for (auto& [id, future] : pending) {
+                if (future.valid()) {
+                    future.wait();
+                }
+            }
+            pending.clear();
+        }
+    } // namespace
+
     /**
      * @brief 构造函数。初始化 SDL_mixer 并打开音频设备。
      * @throws std::runtime_error 如果 SDL_mixer 初始化失败或无法打开音频设备。
      */
-    AudioManager::AudioManager() {
+    AudioManager::AudioManager(engine::core::TaskPool& tasks) : tasks_(tasks) {
         // 1. 初始化 (SDL3 中 MIX_Init 不需要参数)
         if (!MIX_Init()) {
             throw std::runtime_error("SDL_Mixer 初始化失败: " + std::string(SDL_GetError()));
         }
 
         // 2. 创建混音器设备
-        // 使用默认播放设备
+        // 使用默认播放设备；缓冲帧数只能经提示在打开设备前给出
         SDL_AudioDeviceID device_id = SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK;
-        mixer_.reset(MIX_CreateMixerDevice(device_id, NULL));
+        const AudioDeviceSettings settings = configured_device;
+        if (settings.buffer_frames_ > 0) {
+            SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, std::to_string(settings.buffer_frames_).c_str());
+        }
+        SDL_AudioSpec requested{};
+        SDL_AudioSpec* requested_spec = nullptr;
+        if (settings.sample_rate_ > 0 || settings.channels_ > 0) {
+            // 未配置的一项沿用设备默认值
+            SDL_AudioSpec device_default{ SDL_AUDIO_F32, 2, 48000 };
+            SDL_GetAudioDeviceFormat(device_id, &device_default, nullptr);
+            requested.format = SDL_AUDIO_F32;
+            requested.channels = settings.channels_ > 0 ? settings.channels_ : device_default.channels;
+            requested.freq = settings.sample_rate_ > 0 ? settings.sample_rate_ : device_default.freq;
+            requested_spec = &requested;
+        }
+        mixer_.reset(MIX_CreateMixerDevice(device_id, requested_spec));
 
         if (!mixer_) {
             throw std::runtime_error("SDL_Mixer 打开音频失败: " + std::string(SDL_GetError()));
         }
 
+        // 查询实际生效的格式与缓冲帧数（设备可能不接受请求的值）
+        if (!MIX_GetMixerFormat(mixer_.get(), &device_spec_)) {
+            device_spec_ = requested;
+        }
+        SDL_AudioSpec device_format{};
+        if (!SDL_GetAudioDeviceFormat(device_id, &device_format, &device_buffer_frames_)) {
+            device_buffer_frames_ = 0;
+        }
+        if (requested_spec && device_spec_.freq != requested.freq) {
+            spdlog::warn("音频设备不接受 {} Hz 采样率，实际为 {} Hz。", requested.freq, device_spec_.freq);
+        }
+        spdlog::info("音频设备: {} Hz, {} 声道, 缓冲 {} 帧, 输出延迟 {:.1f} ms",
+            device_spec_.freq, device_spec_.channels, device_buffer_frames_, getOutputLatencyMs());
+
         // 3. 创建专门播放音乐的轨道
         music_track_.reset(MIX_CreateTrack(mixer_.get()));
         if (!music_track_) {
             spdlog::error("无法创建背景音乐轨道: {}", SDL_GetError());
         }
 
-		sound_track_.reset(MIX_CreateTrack(mixer_.get()));
-		if (!sound_track_) {
-			spdlog::error("无法创建音效轨道: {}", SDL_GetError());
+		// 音效声部池：一次性创建，播放时只切换轨道上的音频
+		voices_.reserve(SOUND_VOICE_COUNT);
+		for (std::size_t i = 0; i < SOUND_VOICE_COUNT; ++i) {
+			std::unique_ptr<MIX_Track, TrackDeleter> track(MIX_CreateTrack(mixer_.get()));
+			if (!track) {
+				spdlog::error("无法创建音效轨道: {}", SDL_GetError());
+				break;
+			}
+			MIX_TagTrack(track.get(), "sound");
+			voices_.push_back(Voice{ std::move(track) });
 		}
+		frame_sounds_.reserve(SOUND_VOICE_COUNT);
 
 		if (music_track_) {
 			MIX_TagTrack(music_track_.get(), "music");
 		}
-		if (sound_track_) {
-			MIX_TagTrack(sound_track_.get(), "sound");
-		}
 
         // 4. 设置主音量 (SDL3 范围是 0.0 - 1.0)
 		//MIX_SetMasterGain(mixer_.get(), 0.25f);
+
+        // 5. 启动音频线程：此后声部池只由该线程访问
+        running_.store(true, std::memory_order_release);
+        audio_thread_ = std::thread(&AudioManager::audioThreadMain, this);
         
         spdlog::trace("AudioManager 构造成功。");
     }
 
+    void AudioManager::setDeviceSettings(const AudioDeviceSettings& settings) {
+        configured_device = settings;
+    }
+
+    float AudioManager::getOutputLatencyMs() const {
+        if (device_buffer_frames_ <= 0 || device_spec_.freq <= 0) {
+            return 0.0f;
+        }
+        return static_cast<float>(device_buffer_frames_) * 1000.0f / static_cast<float>(device_spec_.freq);
+    }
+
     /**
      * @brief 析构函数。清理所有音频资源并关闭 SDL_mixer。
      */
     AudioManager::~AudioManager() {
+        // 先停掉音频线程，之后声部池回到当前线程
+        stopAudioThread();
         if (mixer_) {
             // 停止所有主要标签的轨道
 			// 注意：这需要在播放时正确设置标签 (MIX_TagTrack)
@@ -66,7 +208,7 @@ namespace engine::resource {
             // 重要：必须在 MIX_Quit 之前手动 reset 资源
             // 否则 unique_ptr 会在 MIX_Quit 之后析构，导致非法访问
             music_track_.reset();
-			sound_track_.reset();
+			voices_.clear();
             mixer_.reset();
         }
 
@@ -88,9 +230,17 @@ namespace engine::resource {
             return nullptr;
         }
 
-        auto it = sounds_.find(id);
-        if (it != sounds_.end()) {
-            return it->second.get();
+        {
+            std::scoped_lock lock(cache_mutex_);
+            auto it = sounds_.find(id);
+            if (it != sounds_.end()) {
+                return it->second.audio_.get();
+            }
+        }
+        // 正在后台解码：等待其完成，失败时再按下方同步路径重试并报告错误
+        if (auto pending = takePending(pending_sounds_, id); pending.audio_) {
+            std::scoped_lock lock(cache_mutex_);
+            return cacheSound(id, std::move(pending));
         }
 
         if (file_path.empty()) {
@@ -99,20 +249,21 @@ namespace engine::resource {
         }
 
         spdlog::debug("加载音效: {} (id={})", file_path, id);
+        ENGINE_PROFILE_SCOPE("AudioManager::loadSound");
 
         // 2. 加载音效
         // 音效通常较短，使用 predecode = true (预解码) 将 PCM 数据加载到内存中，
-        // 以避免播放时的解码开销，保证低延迟。
-        MIX_Audio* raw_audio = MIX_LoadAudio(mixer_.get(), std::string(file_path).c_str(), true);
+        // 以避免播放时的解码开销，保证低延迟。解码期间不持锁，音频线程照常播放。
+        CachedAudio loaded = loadAudio(mixer_.get(), std::string(file_path), true);
 
-        if (!raw_audio) {
+        if (!loaded.audio_) {
             throw std::runtime_error("加载音效失败: " + std::string(file_path) + " 错误: " + std::string(SDL_GetError()));
         }
 
         // 3. 存入缓存
-        sounds_.emplace(id, std::unique_ptr<MIX_Audio, MixAudioDeleter>(raw_audio));
-        spdlog::debug("成功加载并缓存音效: {} (id={})", file_path, id);
-        return raw_audio;
+        spdlog::debug("成功加载并缓存音效: {} (id={}, {} 字节)", file_path, id, loaded.bytes_);
+        std::scoped_lock lock(cache_mutex_);
+        return cacheSound(id, std::move(loaded));
     }
 
     /**
@@ -124,9 +275,16 @@ namespace engine::resource {
         if (id == InvalidResourceId) {
             return nullptr;
         }
-        auto it = sounds_.find(id);
-        if (it != sounds_.end()) {
-            return it->second.get();
+        {
+            std::scoped_lock lock(cache_mutex_);
+            auto it = sounds_.find(id);
+            if (it != sounds_.end()) {
+                return it->second.audio_.get();
+            }
+        }
+        if (auto pending = takePending(pending_sounds_, id); pending.audio_) {
+            std::scoped_lock lock(cache_mutex_);
+            return cacheSound(id, std::move(pending));
         }
         if (file_path.empty()) {
             spdlog::warn("音效未缓存且未提供路径 (id={})", id);
@@ -146,9 +304,11 @@ namespace engine::resource {
      * @param file_path 要卸载的音效文件路径。
      */
     void AudioManager::unloadSound(ResourceId id) {
+        std::scoped_lock lock(cache_mutex_);
         auto it = sounds_.find(id);
         if (it != sounds_.end()) {
             spdlog::debug("卸载音效: id={}", id);
+            sound_bytes_ -= it->second.bytes_;
             sounds_.erase(it);
         } else {
             spdlog::warn("尝试卸载未加载的音效: id={}", id);
@@ -159,34 +319,347 @@ namespace engine::resource {
      * @brief 清空音效缓存，释放所有音效资源。
      */
     void AudioManager::clearSounds() {
+        discardPending(pending_sounds_);    // 等待后台解码结束，结果随之释放
+        std::scoped_lock lock(cache_mutex_);
         if (!sounds_.empty()) {
             spdlog::debug("正在清除所有 {} 个缓存的音效。", sounds_.size());
             sounds_.clear();
         }
+        sound_bytes_ = 0;
     }
 
     /**
-     * @brief 播放音效（即发即弃模式）。
+     * @brief 播放音效（即发即弃模式）：只提交命令，声部分配在音频线程上完成。
      * @param file_path 音效文件路径。
      */
-    void AudioManager::playSound(ResourceId id, std::string_view file_path) {
-        if (!sound_track_) return;
+    void AudioManager::playSound(ResourceId id, std::string_view file_path, float gain) {
+        if (id == InvalidResourceId) return;
+        rememberSoundPath(id, file_path);
+        SoundCommand command;
+        command.sound_id_ = id;
+        command.gain_ = gain;
+        submit(command);
+    }
 
-        MIX_Audio* audio = getSound(id, file_path);
-        if (!audio) return;
+    void AudioManager::playSoundSpatial(ResourceId id, std::string_view file_path, const glm::vec2& emitter, const glm::vec2& listener, float max_distance) {
+        if (id == InvalidResourceId) return;
+        rememberSoundPath(id, file_path);
+        SoundCommand command;
+        command.sound_id_ = id;
+        command.position_ = emitter;
+        command.listener_ = listener;
+        command.max_distance_ = max_distance;
+        submit(command);
+    }
 
-        MIX_SetTrackAudio(sound_track_.get(), audio);
-        if (!MIX_PlayTrack(sound_track_.get(), 0)) {
-            spdlog::error("播放音效失败: id={} - {}", id, SDL_GetError());
+    void AudioManager::rememberSoundPath(ResourceId id, std::string_view file_path) {
+        if (!file_path.empty() && !sound_paths_.contains(id)) {
+            sound_paths_.emplace(id, std::string(file_path));
         }
     }
 
     /**
-     * @brief 停止当前播放的音效。
+     * @brief 停止所有音效声部。
      */
 	void AudioManager::stopSound() {
-		if (sound_track_) {
-			MIX_StopTrack(sound_track_.get(), 0);
+		SoundCommand command;
+		command.type_ = SoundCommand::Type::STOP_ALL;
+		submit(command);
+	}
+
+	void AudioManager::releaseSound(ResourceId id) {
+		if (id == InvalidResourceId) return;
+		SoundCommand command;
+		command.type_ = SoundCommand::Type::RELEASE;
+		command.sound_id_ = id;
+		submit(command);
+	}
+
+	void AudioManager::setSoundPolicy(ResourceId id, SoundPolicy policy) {
+		SoundCommand command;
+		command.type_ = SoundCommand::Type::SET_POLICY;
+		command.sound_id_ = id;
+		command.policy_ = policy;
+		submit(command);
+	}
+
+	void AudioManager::setSoundBudget(std::size_t bytes) {
+		SoundCommand command;
+		command.type_ = SoundCommand::Type::SET_BUDGET;
+		command.budget_bytes_ = bytes;
+		submit(command);
+	}
+
+	void AudioManager::beginSoundFrame() {
+		// 音频线程报告的未命中音效：按记录的路径提交后台解码，解码完成后的播放即可命中
+		ResourceId missing = InvalidResourceId;
+		while (missing_sounds_.tryPop(missing)) {
+			if (auto it = sound_paths_.find(missing); it != sound_paths_.end()) {
+				requestSound(missing, it->second);
+			}
+		}
+
+		// 汇报的是音频线程处理完的上一帧
+		[[maybe_unused]] const auto deduped = stat_deduped_.exchange(0, std::memory_order_relaxed);
+		[[maybe_unused]] const auto dropped = stat_dropped_.exchange(0, std::memory_order_relaxed);
+		ENGINE_PROFILE_COUNTER("audio.voices", static_cast<std::int64_t>(stat_voices_.load(std::memory_order_relaxed)));
+		ENGINE_PROFILE_COUNTER("audio.deduped", static_cast<std::int64_t>(deduped));
+		ENGINE_PROFILE_COUNTER("audio.dropped", static_cast<std::int64_t>(dropped));
+		ENGINE_PROFILE_COUNTER("audio.queue_full", static_cast<std::int64_t>(queue_full_));
+		ENGINE_PROFILE_COUNTER("audio.resident_bytes", static_cast<std::int64_t>(getResidentBytes()));
+		ENGINE_PROFILE_COUNTER("audio.latency_us", static_cast<std::int64_t>(getOutputLatencyMs() * 1000.0f));
+		queue_full_ = 0;
+
+		SoundCommand command;
+		command.type_ = SoundCommand::Type::BEGIN_FRAME;
+		submit(command);
+	}
+
+	void AudioManager::submit(const SoundCommand& command) {
+		if (!commands_.tryPush(command)) {
+			++queue_full_;      // 音频线程严重滞后时宁可丢音效，也不阻塞主线程
+			return;
+		}
+		wake_.fetch_add(1, std::memory_order_release);
+		wake_.notify_one();
+	}
+
+	// --- 音频线程 ---
+
+	void AudioManager::audioThreadMain() {
+		std::uint32_t observed = wake_.load(std::memory_order_acquire);
+		while (running_.load(std::memory_order_acquire)) {
+			commands_.drain([this](const SoundCommand& command) { execute(command); });
+			// 取空之后才等待：期间新提交的命令会改变 wake_，wait 立即返回
+			wake_.wait(observed, std::memory_order_acquire);
+			observed = wake_.load(std::memory_order_acquire);
+		}
+	}
+
+	void AudioManager::stopAudioThread() {
+		if (!audio_thread_.joinable()) return;
+		running_.store(false, std::memory_order_release);
+		wake_.fetch_add(1, std::memory_order_release);
+		wake_.notify_one();
+		audio_thread_.join();
+	}
+
+	void AudioManager::execute(const SoundCommand& command) {
+		switch (command.type_) {
+		case SoundCommand::Type::PLAY: {
+			float gain = command.gain_;
+			if (command.max_distance_ > 0.0f) {
+				gain *= spatialGain(command.position_ - command.listener_, command.max_distance_);
+				if (gain < MIN_AUDIBLE_GAIN) {
+					break;  // 太远听不见，不占用声部
+				}
+			}
+			playVoice(command.sound_id_, gain);
+			break;
+		}
+		case SoundCommand::Type::SET_GAIN:
+			sound_gain_ = std::max(0.0f, command.gain_);
+			for (const Voice& voice : voices_) {
+				MIX_SetTrackGain(voice.track_.get(), sound_gain_ * voice.gain_);
+			}
+			break;
+		case SoundCommand::Type::SET_POLICY:
+			sound_policies_[command.sound_id_] = command.policy_;
+			break;
+		case SoundCommand::Type::SET_BUDGET:
+			sound_budget_bytes_ = command.budget_bytes_;
+			break;
+		case SoundCommand::Type::STOP_ALL:
+			for (Voice& voice : voices_) {
+				MIX_StopTrack(voice.track_.get(), 0);
+			}
+			break;
+		case SoundCommand::Type::BEGIN_FRAME:
+			endVoiceFrame();
+			break;
+		case SoundCommand::Type::RELEASE:
+			if (std::ranges::find(released_sounds_, command.sound_id_) == released_sounds_.end()) {
+				released_sounds_.push_back(command.sound_id_);
+			}
+			break;
+		}
+	}
+
+    bool AudioManager::playVoice(ResourceId id, float gain) {
+        if (voices_.empty() || id == InvalidResourceId) return false;
+        gain = std::clamp(gain, 0.0f, 1.0f);
+
+        // 1. 同帧去重：同一音效本帧只占一个声部，增益取最大值（如多处同时命中时听到最近的一处）
+        if (auto it = std::ranges::find(frame_sounds_, id, &FrameSound::sound_id_); it != frame_sounds_.end()) {
+            ++frame_deduped_;
+            Voice& voice = voices_[it->voice_];
+            if (gain > voice.gain_) {
+                voice.gain_ = gain;
+                MIX_SetTrackGain(voice.track_.get(), sound_gain_ * gain);
+            }
+            return true;
+        }
+
+        const auto policy_it = sound_policies_.find(id);
+        const SoundPolicy policy = policy_it != sound_policies_.end() ? policy_it->second : SoundPolicy{};
+
+        // 2. 选择声部：同音效达到上限时重启其最早的声部；否则取空闲声部；再否则按优先级抢占
+        Voice* oldest_same = nullptr;
+        Voice* free_voice = nullptr;
+        Voice* steal = nullptr;
+        int same_count = 0;
+        for (Voice& voice : voices_) {
+            const bool playing = MIX_TrackPlaying(voice.track_.get());
+            if (!playing) {
+                if (!free_voice) free_voice = &voice;
+                continue;
+            }
+            if (voice.sound_id_ == id) {
+                ++same_count;
+                if (!oldest_same || voice.started_ < oldest_same->started_) oldest_same = &voice;
+            }
+            if (voice.priority_ <= policy.priority_ &&
+                (!steal || voice.priority_ < steal->priority_ ||
+                 (voice.priority_ == steal->priority_ && voice.started_ < steal->started_))) {
+                steal = &voice;
+            }
+        }
+
+        Voice* target = nullptr;
+        if (oldest_same && same_count >= std::max(policy.max_voices_, 1)) {
+            target = oldest_same;
+        } else if (free_voice) {
+            target = free_voice;
+        } else {
+            target = steal;
+        }
+        if (!target) {
+            ++frame_dropped_;
+            return false;
+        }
+
+        // 3. 取缓存：持锁直到音频交给轨道，防止主线程同时卸载；未命中时不在本线程同步解码
+        {
+            std::scoped_lock lock(cache_mutex_);
+            auto cached = sounds_.find(id);
+            if (cached == sounds_.end()) {
+                missing_sounds_.tryPush(id);
+                ++frame_dropped_;
+                return false;
+            }
+            cached->second.last_used_ = ++use_serial_;
+            MIX_SetTrackAudio(target->track_.get(), cached->second.audio_.get());
+        }
+
+        target->sound_id_ = id;
+        target->priority_ = policy.priority_;
+        target->gain_ = gain;
+        target->started_ = ++voice_serial_;
+        MIX_SetTrackGain(target->track_.get(), sound_gain_ * gain);
+        if (!MIX_PlayTrack(target->track_.get(), 0)) {
+            spdlog::error("播放音效失败: id={} - {}", id, SDL_GetError());
+            return false;
+        }
+        // 被重新占用的声部不再代表本帧早先触发的其它音效
+        const auto voice_index = static_cast<std::size_t>(target - voices_.data());
+        std::erase_if(frame_sounds_, [voice_index](const FrameSound& sound) { return sound.voice_ == voice_index; });
+        frame_sounds_.push_back({ id, voice_index });
+        return true;
+    }
+
+	void AudioManager::endVoiceFrame() {
+		unloadReleasedSounds();
+		enforceSoundBudget();
+		std::uint32_t active = 0;
+		for (const Voice& voice : voices_) {
+			active += MIX_TrackPlaying(voice.track_.get()) ? 1u : 0u;
+		}
+		stat_voices_.store(active, std::memory_order_relaxed);
+		stat_deduped_.fetch_add(static_cast<std::uint32_t>(frame_deduped_), std::memory_order_relaxed);
+		stat_dropped_.fetch_add(static_cast<std::uint32_t>(frame_dropped_), std::memory_order_relaxed);
+		frame_sounds_.clear();
+		frame_deduped_ = 0;
+		frame_dropped_ = 0;
+	}
+
+	MIX_Audio* AudioManager::cacheSound(ResourceId id, CachedAudio entry) {
+		MIX_Audio* raw_audio = entry.audio_.get();
+		entry.last_used_ = ++use_serial_;
+		auto [it, inserted] = sounds_.emplace(id, std::move(entry));
+		if (!inserted) {
+			return it->second.audio_.get();
+		}
+		sound_bytes_ += it->second.bytes_;
+		return raw_audio;
+	}
+
+	MIX_Audio* AudioManager::cacheMusic(ResourceId id, CachedAudio entry) {
+		MIX_Audio* raw_audio = entry.audio_.get();
+		auto [it, inserted] = music_.emplace(id, std::move(entry));
+		if (!inserted) {
+			return it->second.audio_.get();
+		}
+		music_bytes_ += it->second.bytes_;
+		return raw_audio;
+	}
+
+	std::size_t AudioManager::enforceSoundBudget() {
+		std::scoped_lock lock(cache_mutex_);
+		std::size_t evicted = 0;
+		while (sound_bytes_ > sound_budget_bytes_) {
+			// 音效种类只有几十个，线性找最久未播放、且没有声部正在播放的一个
+			auto victim = sounds_.end();
+			for (auto it = sounds_.begin(); it != sounds_.end(); ++it) {
+				if (!isSoundPlaying(it->first) && (victim == sounds_.end() || it->second.last_used_ < victim->second.last_used_)) {
+					victim = it;
+				}
+			}
+			if (victim == sounds_.end()) {
+				break;  // 全部在播放，下一帧再试
+			}
+			const ResourceId id = victim->first;
+			detachSound(id);
+			spdlog::debug("音效缓存超出预算，淘汰: id={} ({} 字节)", id, victim->second.bytes_);
+			sound_bytes_ -= victim->second.bytes_;
+			sounds_.erase(victim);
+			++evicted;
+		}
+		return evicted;
+	}
+
+	std::size_t AudioManager::unloadReleasedSounds() {
+		if (released_sounds_.empty()) {
+			return 0;
+		}
+		std::scoped_lock lock(cache_mutex_);
+		const auto before = released_sounds_.size();
+		std::erase_if(released_sounds_, [this](ResourceId id) {
+			if (isSoundPlaying(id)) {
+				return false;   // 播完之后的帧边界再卸载
+			}
+			detachSound(id);
+			if (auto it = sounds_.find(id); it != sounds_.end()) {
+				spdlog::debug("卸载已释放的音效: id={} ({} 字节)", id, it->second.bytes_);
+				sound_bytes_ -= it->second.bytes_;
+				sounds_.erase(it);
+			}
+			return true;
+		});
+		return before - released_sounds_.size();
+	}
+
+	bool AudioManager::isSoundPlaying(ResourceId id) const {
+		return std::ranges::any_of(voices_, [id](const Voice& voice) {
+			return voice.sound_id_ == id && MIX_TrackPlaying(voice.track_.get());
+		});
+	}
+
+	void AudioManager::detachSound(ResourceId id) {
+		for (Voice& voice : voices_) {
+			if (voice.sound_id_ == id) {
+				MIX_SetTrackAudio(voice.track_.get(), nullptr);
+				voice.sound_id_ = InvalidResourceId;
+			}
 		}
 	}
 
@@ -206,7 +679,10 @@ namespace engine::resource {
 
         auto it = music_.find(id);
         if (it != music_.end()) {
-            return it->second.get();
+            return it->second.audio_.get();
+        }
+        if (auto pending = takePending(pending_music_, id); pending.audio_) {
+            return cacheMusic(id, std::move(pending));
         }
 
         if (file_path.empty()) {
@@ -215,18 +691,18 @@ namespace engine::resource {
         }
 
         spdlog::debug("加载音乐: {} (id={})", file_path, id);
+        ENGINE_PROFILE_SCOPE("AudioManager::loadMusic");
 
         // 2. 加载音乐
         // 关键优化：音乐文件通常较大（如 BGM），将 predecode 设置为 false。
         // 这样会保留源格式（如 mp3/ogg），在播放时流式解码，大幅减少内存占用。
-        MIX_Audio* raw_audio = MIX_LoadAudio(mixer_.get(), std::string(file_path).c_str(), false);
+        CachedAudio loaded = loadAudio(mixer_.get(), std::string(file_path), false);
 
-        if (!raw_audio) {
+        if (!loaded.audio_) {
             throw std::runtime_error("加载音乐失败: " + std::string(file_path) + " 错误: " + std::string(SDL_GetError()));
         }
 
-        music_.emplace(id, std::unique_ptr<MIX_Audio, MixAudioDeleter>(raw_audio));
-        return raw_audio;
+        return cacheMusic(id, std::move(loaded));
     }
 
     /**
@@ -240,7 +716,10 @@ namespace engine::resource {
         }
         auto it = music_.find(id);
         if (it != music_.end()) {
-            return it->second.get();
+            return it->second.audio_.get();
+        }
+        if (auto pending = takePending(pending_music_, id); pending.audio_) {
+            return cacheMusic(id, std::move(pending));
         }
         if (file_path.empty()) {
             spdlog::warn("音乐未缓存且未提供路径 (id={})", id);
@@ -263,6 +742,7 @@ namespace engine::resource {
         auto it = music_.find(id);
         if (it != music_.end()) {
             spdlog::debug("卸载音乐: id={}", id);
+            music_bytes_ -= it->second.bytes_;
             music_.erase(it);
         } else {
             spdlog::warn("尝试卸载未加载的音乐: id={}", id);
@@ -273,10 +753,12 @@ namespace engine::resource {
      * @brief 清空音乐缓存，释放所有音乐资源。
      */
     void AudioManager::clearMusic() {
+        discardPending(pending_music_);
         if (!music_.empty()) {
             spdlog::debug("正在清除所有 {} 个缓存的音乐。", music_.size());
             music_.clear();
         }
+        music_bytes_ = 0;
     }
 
     /**
@@ -362,9 +844,10 @@ namespace engine::resource {
      * @param gain 增益值（0.0f-1.0f）。
      */
 	void AudioManager::setSoundGain(float gain) {
-		if (sound_track_) {
-			MIX_SetTrackGain(sound_track_.get(), std::max(0.0f, gain));
-		}
+		SoundCommand command;
+		command.type_ = SoundCommand::Type::SET_GAIN;
+		command.gain_ = gain;
+		submit(command);
 	}
 
     /**
@@ -382,6 +865,74 @@ namespace engine::resource {
     /**
      * @brief 清理所有音频资源（包括音效和音乐）。
      */
+    /**
+     * @brief 在工作线程上开始解码音效（预解码为 PCM）。
+     */
+    bool AudioManager::requestSound(ResourceId id, std::string_view file_path) {
+        if (id == InvalidResourceId) {
+            return false;
+        }
+        if (pending_sounds_.contains(id)) {
+            return true;
+        }
+        {
+            std::scoped_lock lock(cache_mutex_);
+            if (sounds_.contains(id)) {
+                return true;
+            }
+        }
+        if (file_path.empty()) {
+            spdlog::warn("请求后台加载音效失败：未提供路径 (id={})", id);
+            return false;
+        }
+        pending_sounds_.emplace(id, decodeAsync(tasks_, mixer_.get(), std::string(file_path), true));
+        return true;
+    }
+
+    /**
+     * @brief 在工作线程上开始加载音乐（保留压缩格式，播放时流式解码）。
+     */
+    bool AudioManager::requestMusic(ResourceId id, std::string_view file_path) {
+        if (id == InvalidResourceId) {
+            return false;
+        }
+        if (music_.contains(id) || pending_music_.contains(id)) {
+            return true;
+        }
+        if (file_path.empty()) {
+            spdlog::warn("请求后台加载音乐失败：未提供路径 (id={})", id);
+            return false;
+        }
+        pending_music_.emplace(id, decodeAsync(tasks_, mixer_.get(), std::string(file_path), false));
+        return true;
+    }
+
+    /**
+     * @brief 收入所有已完成的后台解码结果。
+     */
+    std::size_t AudioManager::collectPending() {
+        std::size_t collected = 0;
+        auto collect = [&collected](auto& pending, auto&& cache) {
+            for (auto it = pending.begin(); it != pending.end();) {
+                if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    ++it;
+                    continue;
+                }
+                if (auto loaded = it->second.get(); loaded.audio_) {
+                    cache(it->first, std::move(loaded));
+                    ++collected;
+                }
+                it = pending.erase(it);
+            }
+        };
+        collect(pending_sounds_, [this](ResourceId id, CachedAudio loaded) {
+            std::scoped_lock lock(cache_mutex_);
+            cacheSound(id, std::move(loaded));
+        });
+        collect(pending_music_, [this](ResourceId id, CachedAudio loaded) { cacheMusic(id, std::move(loaded)); });
+        return collected;
+    }
+
     void AudioManager::clearAudio() {
         clearMusic();
         clearSounds();
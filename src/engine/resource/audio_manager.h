@@ -4,8 +4,22 @@
 #include <string>       // 用于 std::string
 #include <string_view>
 #include <unordered_map> // 用于 std::unordered_map
+#include <future>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
 #include <SDL3_mixer/SDL_mixer.h>
+#include <glm/vec2.hpp>
 #include "resource_id.h"
+#include "../utils/id_map.h"
+#include "../utils/spsc_queue.h"
+
+namespace engine::core {
+	class TaskPool;
+}
 
 /**
  * @namespace engine::resource
@@ -13,12 +27,69 @@
  */
 namespace engine::resource {
 
+	/**
+	 * @struct SoundPolicy
+	 * @brief 单个音效的并发策略（资源映射文件 "sound_policy" 段，未配置时使用默认值）
+	 */
+	struct SoundPolicy {
+		int max_voices_{ 4 };   ///< 同一音效同时占用的最大声部数，超出时抢占其最早的声部
+		int priority_{ 0 };     ///< 声部耗尽时，只能抢占优先级不高于自身的声部
+	};
+
+	/**
+	 * @struct AudioDeviceSettings
+	 * @brief 打开混音器设备时请求的输出格式（配置文件 "audio" 段），各项为 0 时使用设备默认值
+	 */
+	struct AudioDeviceSettings {
+		int sample_rate_{ 0 };      ///< 采样率（Hz），应与大部分音效素材一致，避免加载时重采样
+		int buffer_frames_{ 0 };    ///< 设备缓冲帧数，越小音效延迟越低、回调越频繁（SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES）
+		int channels_{ 0 };         ///< 输出声道数
+	};
+
+	/**
+	 * @struct SoundCommand
+	 * @brief 主线程提交给音频线程的音效命令（可平凡拷贝，经 SpscQueue 传递）
+	 */
+	struct SoundCommand {
+		enum class Type : std::uint8_t {
+			PLAY,           ///< 播放 sound_id_；max_distance_ > 0 时按 position_ 与 listener_ 的距离衰减
+			SET_GAIN,       ///< 设置音效总增益 gain_
+			SET_POLICY,     ///< 设置 sound_id_ 的并发策略 policy_
+			SET_BUDGET,     ///< 设置音效缓存预算 budget_bytes_
+			STOP_ALL,       ///< 停止所有音效声部
+			BEGIN_FRAME,    ///< 帧边界：清空同帧去重表、按预算淘汰缓存、汇报统计
+			RELEASE,        ///< sound_id_ 已无人引用：没有声部在播放时从缓存卸载，否则等声部结束
+		};
+
+		Type type_{ Type::PLAY };
+		ResourceId sound_id_{ InvalidResourceId };
+		float gain_{ 1.0f };
+		glm::vec2 position_{ 0.0f };    ///< 发射器世界位置
+		glm::vec2 listener_{ 0.0f };    ///< 听众世界位置
+		float max_distance_{ 0.0f };    ///< 最大有效距离，<= 0 表示不做空间衰减
+		SoundPolicy policy_{};
+		std::size_t budget_bytes_{ 0 };
+	};
+
 	/**
 	 * @class AudioManager
 	 * @brief 音频管理器类，负责音频资源（音乐和音效）的加载、缓存及生命周期管理。
 	 * 
 	 * 该类封装了 SDL_mixer 的功能，并使用 std::unique_ptr 确保在对象销毁时正确释放音频设备和资源。
 	 * 采用懒加载策略（Load-on-demand）并在内部通过哈希表缓存已加载的资源。
+	 *
+	 * 音效通过固定大小的声部池（MIX_Track）播放：
+	 * - 同一帧内重复触发的同一音效只占一个声部（增益取最大值）
+	 * - 每个音效受 SoundPolicy::max_voices_ 限制，超出时重启其最早的声部
+	 * - 声部耗尽时抢占优先级最低（同级取最早）的声部，优先级更高的声部不会被抢占
+	 *
+	 * 声部池由专门的音频线程持有：主线程只把 SoundCommand 压入无锁队列，
+	 * 声部分配、增益变更与 MIX_* 调用都在音频线程上完成，混音器加锁不会阻塞模拟。
+	 * 音效缓存（sounds_）由 cache_mutex_ 保护；音频线程遇到未缓存的音效时不做同步加载，
+	 * 而是经 missing_sounds_ 通知主线程提交后台解码。背景音乐仍在主线程上播放。
+	 *
+	 * 混音器设备按 setDeviceSettings() 配置的采样率、声道与缓冲帧数打开。预解码音效在加载时即转换为混音器格式，
+	 * 采样率与设备不同的素材只在加载时重采样一次，播放时不再经过重采样；流式音乐仍在播放时转换。
 	 */
 	class AudioManager final {
 	public:
@@ -52,20 +123,87 @@ namespace engine::resource {
 			}
 		};
 
+		/**
+		 * @struct CachedAudio
+		 * @brief 缓存中的音频及其常驻内存估算
+		 */
+		struct CachedAudio {
+			std::unique_ptr<MIX_Audio, MixAudioDeleter> audio_;
+			std::size_t bytes_{ 0 };        ///< 音效为预解码 PCM 大小，音乐为压缩文件大小
+			std::uint64_t last_used_{ 0 };  ///< 最近一次播放的序号（LRU）
+		};
+
 	private:
 		std::unique_ptr<MIX_Mixer, MixerDeleter> mixer_; ///< SDL_mixer 混音器设备指针
 		std::unique_ptr<MIX_Track, TrackDeleter> music_track_; ///< 专门播放 BGM 的轨道
-		std::unique_ptr<MIX_Track, TrackDeleter> sound_track_; ///< 专门播放 SFX 的轨道
-		std::unordered_map<ResourceId, std::unique_ptr<MIX_Audio, MixAudioDeleter>> music_; ///< 音乐资源缓存映射表 (资源ID -> 资源指针)
-		std::unordered_map<ResourceId, std::unique_ptr<MIX_Audio, MixAudioDeleter>> sounds_; ///< 音效资源缓存映射表 (资源ID -> 资源指针)
+
+		/// @brief 音效声部：一条 MIX_Track 及其当前播放的音效
+		struct Voice {
+			std::unique_ptr<MIX_Track, TrackDeleter> track_;
+			ResourceId sound_id_{ InvalidResourceId };
+			int priority_{ 0 };
+			float gain_{ 1.0f };            ///< 本次播放的相对增益（空间衰减等），与 sound_gain_ 相乘
+			std::uint64_t started_{ 0 };    ///< 开始播放的序号，越小越早
+		};
+
+		/// @brief 本帧已开始播放的音效，用于同帧去重
+		struct FrameSound {
+			ResourceId sound_id_{ InvalidResourceId };
+			std::size_t voice_{ 0 };
+		};
+
+		static constexpr std::size_t SOUND_VOICE_COUNT = 16;   ///< 音效声部数
+		static constexpr std::size_t COMMAND_QUEUE_CAPACITY = 1024;    ///< 音效命令队列容量（约数十帧的峰值播放量）
+		static constexpr std::size_t MISSING_QUEUE_CAPACITY = 64;
+
+		// --- 仅音频线程访问 ---
+		std::vector<Voice> voices_;                     ///< 音效声部池（构造时一次性创建）
+		std::vector<FrameSound> frame_sounds_;          ///< 本帧已触发的音效（数量很少，线性查找）
+		engine::utils::IdMap<SoundPolicy> sound_policies_;
+		float sound_gain_{ 1.0f };
+		std::uint64_t voice_serial_{ 0 };
+		std::size_t frame_dropped_{ 0 };                ///< 本帧因并发限制/优先级被丢弃的播放请求
+		std::size_t frame_deduped_{ 0 };                ///< 本帧被同帧去重合并的播放请求
+		std::vector<ResourceId> released_sounds_;       ///< 已释放、等声部播放结束后卸载的音效
+
+		// --- 线程间通信 ---
+		engine::utils::SpscQueue<SoundCommand, COMMAND_QUEUE_CAPACITY> commands_;     ///< 主线程 -> 音频线程
+		engine::utils::SpscQueue<ResourceId, MISSING_QUEUE_CAPACITY> missing_sounds_; ///< 音频线程 -> 主线程：播放时未缓存的音效
+		std::atomic<std::uint32_t> wake_{ 0 };          ///< 每次提交命令递增，音频线程在其上等待
+		std::atomic<bool> running_{ false };
+		std::thread audio_thread_;
+		std::atomic<std::uint32_t> stat_voices_{ 0 };   ///< 音频线程汇报的统计，主线程写入计数器
+		std::atomic<std::uint32_t> stat_deduped_{ 0 };
+		std::atomic<std::uint32_t> stat_dropped_{ 0 };
+		std::uint32_t queue_full_{ 0 };                 ///< 本帧因队列已满被丢弃的命令（主线程）
+
+		// --- 缓存 ---
+		std::mutex cache_mutex_;                        ///< 保护 sounds_ 与 use_serial_（主线程增删，音频线程查找/淘汰）
+		engine::utils::IdMap<CachedAudio> music_; ///< 音乐资源缓存映射表（保留压缩格式，播放时流式解码）
+		engine::utils::IdMap<CachedAudio> sounds_; ///< 音效资源缓存映射表（预解码 PCM，受 sound_budget_bytes_ 约束）
+		engine::core::TaskPool& tasks_;                 ///< 后台解码使用的任务线程池
+		std::unordered_map<ResourceId, std::future<CachedAudio>> pending_sounds_; ///< 工作线程解码中的音效（主线程）
+		std::unordered_map<ResourceId, std::future<CachedAudio>> pending_music_;  ///< 工作线程加载中的音乐
+		engine::utils::IdMap<std::string> sound_paths_; ///< 播放过的音效路径，供缓存未命中时重新解码（主线程）
+
+		static constexpr std::size_t DEFAULT_SOUND_BUDGET_BYTES = 64u * 1024u * 1024u;   ///< 预解码音效的默认内存预算
+		std::size_t sound_budget_bytes_{ DEFAULT_SOUND_BUDGET_BYTES };  ///< 音频线程持有，经 SET_BUDGET 命令修改
+		std::atomic<std::size_t> sound_bytes_{ 0 };     ///< 当前缓存的音效 PCM 字节数
+		std::size_t music_bytes_{ 0 };      ///< 当前缓存的音乐字节数
+		std::uint64_t use_serial_{ 0 };
+
+		// --- 设备 ---
+		SDL_AudioSpec device_spec_{};       ///< 混音器实际使用的输出格式
+		int device_buffer_frames_{ 0 };     ///< 设备实际的缓冲帧数（查询失败时为 0）
 
 
 	public:
 		/**
 		 * @brief 构造函数。初始化 SDL_mixer 并打开音频设备。
+		 * @param tasks 后台解码使用的任务线程池
 		 * @throws std::runtime_error 如果 SDL_mixer 初始化失败或无法打开音频设备。
 		 */
-		AudioManager();
+		explicit AudioManager(engine::core::TaskPool& tasks);
 
 		/**
 		 * @brief 析构函数。清理所有缓存的音频资源并关闭 SDL_mixer。
@@ -78,6 +216,11 @@ namespace engine::resource {
 		AudioManager(AudioManager&&) = delete;
 		AudioManager& operator=(AudioManager&&) = delete;
 
+		/**
+		 * @brief 设置之后创建的音频管理器打开设备时使用的输出格式（GameApp 在读取配置后、创建资源管理器前调用）
+		 */
+		static void setDeviceSettings(const AudioDeviceSettings& settings);
+
 		// 友元类声明，允许 ResourceManager 访问私有方法
 		friend class ResourceManager;
 
@@ -111,14 +254,87 @@ private:
 		void clearSounds();
 
 		/**
-		 * @brief 播放音效（即发即弃模式）。
-		 * @param file_path 音效文件路径。
+		 * @brief 播放音效（即发即弃模式）：只向音频线程提交命令，不触碰混音器。
+		 * @details 音频线程上经过同帧去重、并发限制与优先级抢占。
+		 * @param file_path 音效文件路径，记录下来供缓存未命中时后台重新解码。
+		 * @param gain 相对增益（0.0f-1.0f），与音效总增益相乘。
 		 */
-		void playSound(ResourceId id, std::string_view file_path = {});
+		void playSound(ResourceId id, std::string_view file_path = {}, float gain = 1.0f);
 		void playSound(const std::string& file_path);
 
+		/**
+		 * @brief 播放空间化音效：距离衰减与剔除在音频线程上计算。
+		 * @param max_distance 最大有效距离，<= 0 时等同 playSound。
+		 */
+		void playSoundSpatial(ResourceId id, std::string_view file_path, const glm::vec2& emitter, const glm::vec2& listener, float max_distance);
+
+		/// @brief 记录音效路径，供音频线程报告缓存未命中时重新解码（主线程）
+		void rememberSoundPath(ResourceId id, std::string_view file_path);
+
+		/// @brief 停止所有音效声部
 		void stopSound();
 
+		/// @brief 释放不再被引用的音效：由音频线程在没有声部播放它时卸载，正在播放的一次会完整播完
+		void releaseSound(ResourceId id);
+
+		/// @brief 设置/覆盖某个音效的并发策略
+		void setSoundPolicy(ResourceId id, SoundPolicy policy);
+
+		/**
+		 * @brief 开始新的一帧（主线程每帧调用一次）：为未命中的音效提交后台解码、写入计数器，并向音频线程提交帧边界。
+		 * @details 计数器："audio.voices"、"audio.deduped"、"audio.dropped"、"audio.queue_full"、"audio.resident_bytes"、"audio.latency_us"
+		 */
+		void beginSoundFrame();
+
+		/// @brief 设置预解码音效缓存的内存预算（字节），超出时淘汰最久未播放且未在播放的音效
+		void setSoundBudget(std::size_t bytes);
+
+		/// @brief 常驻内存中的音频字节数（音效 PCM + 音乐文件）
+		[[nodiscard]] std::size_t getResidentBytes() const { return sound_bytes_.load(std::memory_order_relaxed) + music_bytes_; }
+
+		/**
+		 * @brief 设备缓冲带来的输出延迟（毫秒）：缓冲帧数 / 采样率，查询不到缓冲帧数时为 0
+		 * @details 构造时打开设备后测得并记入日志，另以计数器 "audio.latency_us" 发布
+		 */
+		[[nodiscard]] float getOutputLatencyMs() const;
+
+		/// @brief 混音器实际使用的输出格式
+		[[nodiscard]] const SDL_AudioSpec& getDeviceSpec() const { return device_spec_; }
+
+		/// @brief 向音频线程提交命令，队列已满时丢弃并计数（主线程）
+		void submit(const SoundCommand& command);
+
+		/// @brief 音频线程主循环：等待唤醒并按顺序执行队列中的命令
+		void audioThreadMain();
+
+		/// @brief 在音频线程上执行一条命令
+		void execute(const SoundCommand& command);
+
+		/// @brief 为音效分配声部并开始播放（音频线程），返回是否占用了声部（被去重合并也返回 true）
+		bool playVoice(ResourceId id, float gain);
+
+		/// @brief 帧边界处理：淘汰缓存、汇报统计并清空同帧去重表（音频线程）
+		void endVoiceFrame();
+
+		/// @brief 按 LRU 淘汰音效直到不超过预算，返回淘汰数量（音频线程）
+		std::size_t enforceSoundBudget();
+
+		/// @brief 卸载已释放且不再播放的音效，返回卸载数量（音频线程）
+		std::size_t unloadReleasedSounds();
+
+		/// @brief 是否有声部正在播放该音效（音频线程）
+		[[nodiscard]] bool isSoundPlaying(ResourceId id) const;
+
+		/// @brief 让仍指向该音效的声部放开它，随后即可从缓存移除（音频线程）
+		void detachSound(ResourceId id);
+
+		/// @brief 停止并等待音频线程退出
+		void stopAudioThread();
+
+		/// @brief 收入一条音效/音乐缓存并累计常驻字节数（cacheSound 需持有 cache_mutex_）
+		MIX_Audio* cacheSound(ResourceId id, CachedAudio entry);
+		MIX_Audio* cacheMusic(ResourceId id, CachedAudio entry);
+
 		/**
 		 * @brief 从文件路径加载背景音乐（Music）。
 		 * @param file_path 音乐文件的路径。
@@ -163,6 +379,25 @@ private:
 		void setSoundGain(float gain);
 		void setMasterGain(float gain);
 
+		/**
+		 * @brief 在工作线程上开始解码音效/音乐，不阻塞调用线程。
+		 *
+		 * 已缓存或已在解码中时直接返回 true。解码结果由 collectPending() 收入缓存；
+		 * 在此之前调用 load/get 会等待该解码完成，不会重复加载。
+		 * @return 无效 ID 或未提供路径时返回 false。
+		 */
+		bool requestSound(ResourceId id, std::string_view file_path);
+		bool requestMusic(ResourceId id, std::string_view file_path);
+
+		/**
+		 * @brief 将已完成的后台解码结果收入缓存（主线程每帧调用，不阻塞）。
+		 * @return 本次收入的资源数量。
+		 */
+		std::size_t collectPending();
+
+		/// @brief 尚未完成的后台解码数量
+		[[nodiscard]] std::size_t getPendingCount() const { return pending_sounds_.size() + pending_music_.size(); }
+
 		/**
 		 * @brief 清理所有音频资源（包括音效和音乐）。
 		 */
@@ -1,5 +1,9 @@
 #include "font_manager.h"
 #include <spdlog/spdlog.h>
+#include "../io/virtual_fs.h"
+#include "../utils/profiler.h"
+#include "../core/task_pool.h"
+#include <chrono>
 
 namespace engine::resource {
 
@@ -8,7 +12,8 @@ namespace engine::resource {
  * @attention 如果 TTF_Init() 失败，将抛出异常。
  * @throws std::runtime_error 如果 SDL_ttf 初始化失败。
  */
-FontManager::FontManager()
+FontManager::FontManager(SDL_Renderer* renderer, engine::core::TaskPool* tasks)
+	: renderer_(renderer), tasks_(tasks)
 {
 	if (!TTF_WasInit() && !TTF_Init()) {
 		throw std::runtime_error("FontManager 错误: TTF_Init 失败：" + std::string(SDL_GetError()));
@@ -21,6 +26,10 @@ FontManager::FontManager()
  */
 FontManager::~FontManager()
 {
+	for (auto& pending : pending_) {
+		pending.fonts_.wait();  // 打开中的字体随结果一起关闭，须在 TTF_Quit 之前
+	}
+	pending_.clear();
 	if (!fonts_.empty()) {
 		spdlog::debug("FontManager 不为空，调用 clearFonts 处理清理逻辑。");
 		clearFonts();       // 调用 clearFonts 处理清理逻辑
@@ -61,8 +70,9 @@ TTF_Font* FontManager::loadFont(ResourceId id, std::string_view file_path, int p
     }
 
     // 缓存中不存在，则加载字体
+    ENGINE_PROFILE_SCOPE("FontManager::loadFont");
     spdlog::debug("正在加载字体：{} ({}pt, id={})", file_path, point_size, id);
-    TTF_Font* raw_font = TTF_OpenFont(std::string(file_path).c_str(), static_cast<float>(point_size));
+    TTF_Font* raw_font = TTF_OpenFontIO(engine::io::VirtualFS::instance().openIO(file_path), true, static_cast<float>(point_size));
     if (!raw_font) {
         spdlog::error("加载字体 '{}' ({}pt, id={}) 失败：{}", file_path, point_size, id, SDL_GetError());
         return nullptr;
@@ -108,6 +118,10 @@ void FontManager::unloadFont(ResourceId id, int point_size)
     auto it = fonts_.find(key);
     if (it != fonts_.end()) {
         spdlog::debug("卸载字体：id={} ({}pt)", id, point_size);
+        atlases_.erase(key);    // 图集引用字体，必须先释放
+        if (point_size == SCALABLE_BASE_SIZE) {
+            scalable_atlases_.erase(id);
+        }
         fonts_.erase(it);       // unique_ptr 会处理 TTF_CloseFont
     }
     else {
@@ -125,6 +139,128 @@ TTF_Font* FontManager::getFont(const std::string& file_path, int point_size)
     return getFont(toResourceId(file_path), file_path, point_size);
 }
 
+/**
+ * @brief 获取字体对应的字形图集，未创建时加载字体并创建。
+ */
+GlyphAtlas* FontManager::getGlyphAtlas(ResourceId id, std::string_view file_path, int point_size)
+{
+    FontKey key = { id, point_size };
+    auto it = atlases_.find(key);
+    if (it != atlases_.end()) {
+        return it->second.get();
+    }
+    if (!renderer_) {
+        return nullptr;
+    }
+
+    TTF_Font* font = getFont(id, file_path, point_size);
+    if (!font) {
+        return nullptr;
+    }
+    spdlog::debug("为字体 id={} ({}pt) 创建字形图集", id, point_size);
+    auto& atlas = atlases_[key];
+    atlas = std::make_unique<GlyphAtlas>(renderer_, font);
+    return atlas.get();
+}
+
+GlyphAtlas* FontManager::getScalableAtlas(ResourceId id, std::string_view file_path)
+{
+    auto it = scalable_atlases_.find(id);
+    if (it != scalable_atlases_.end()) {
+        return it->second.get();
+    }
+    if (!renderer_) {
+        return nullptr;
+    }
+
+    TTF_Font* font = getFont(id, file_path, SCALABLE_BASE_SIZE);
+    if (!font) {
+        return nullptr;
+    }
+    spdlog::debug("为字体 id={} 创建可缩放字形图集 ({}pt)", id, SCALABLE_BASE_SIZE);
+    auto& atlas = scalable_atlases_[id];
+    atlas = std::make_unique<GlyphAtlas>(renderer_, font, true);
+    return atlas.get();
+}
+
+void FontManager::requestFont(ResourceId id, std::string_view file_path, const std::vector<int>& point_sizes,
+                              std::string_view glyphs, bool scalable)
+{
+    if (id == InvalidResourceId || file_path.empty()) {
+        spdlog::error("无法预加载字体：缺少资源ID或路径 (id={})", id);
+        return;
+    }
+    std::vector<int> sizes;
+    for (const int size : point_sizes) {
+        if (size > 0 && !fonts_.contains(FontKey{ id, size })) {
+            sizes.push_back(size);
+        }
+    }
+    if (scalable && !fonts_.contains(FontKey{ id, SCALABLE_BASE_SIZE })) {
+        sizes.push_back(SCALABLE_BASE_SIZE);
+    }
+
+    auto open_all = [path = std::string(file_path), sizes, id]() {
+        // 每个字号各自打开一个 TTF_Font；打开后只交给主线程使用，不会被并发访问
+        std::vector<std::pair<int, FontPtr>> opened;
+        for (const int size : sizes) {
+            TTF_Font* font = TTF_OpenFontIO(engine::io::VirtualFS::instance().openIO(path), true, static_cast<float>(size));
+            if (!font) {
+                spdlog::error("预加载字体 '{}' ({}pt, id={}) 失败：{}", path, size, id, SDL_GetError());
+                continue;
+            }
+            opened.emplace_back(size, FontPtr(font));
+        }
+        return opened;
+    };
+
+    PendingFonts pending{ id, std::string(glyphs), scalable, {} };
+    if (tasks_) {
+        pending.fonts_ = tasks_->submit(engine::core::TaskPriority::BACKGROUND, std::move(open_all));
+    } else {
+        std::promise<std::vector<std::pair<int, FontPtr>>> opened;
+        opened.set_value(open_all());
+        pending.fonts_ = opened.get_future();
+    }
+    pending_.push_back(std::move(pending));
+    spdlog::debug("开始后台打开字体: {} ({} 个字号, id={})", file_path, sizes.size(), id);
+}
+
+std::size_t FontManager::collectPending()
+{
+    std::size_t collected = 0;
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (it->fonts_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        ENGINE_PROFILE_SCOPE("FontManager::collectPending");
+        for (auto& [size, font] : it->fonts_.get()) {
+            const FontKey key{ it->id_, size };
+            fonts_.try_emplace(key, std::move(font));   // 期间已被同步加载时保留已有的那份
+            ++collected;
+        }
+        // 预先光栅化常用字符：图集纹理只能在渲染线程创建与更新
+        if (renderer_ && !it->glyphs_.empty()) {
+            for (const auto& [key, font] : fonts_) {
+                if (key.id != it->id_ || (it->scalable_ && key.point_size == SCALABLE_BASE_SIZE)) {
+                    continue;
+                }
+                if (auto* atlas = getGlyphAtlas(key.id, {}, key.point_size)) {
+                    atlas->warm(it->glyphs_);
+                }
+            }
+            if (it->scalable_) {
+                if (auto* atlas = getScalableAtlas(it->id_, {})) {
+                    atlas->warm(it->glyphs_);
+                }
+            }
+        }
+        it = pending_.erase(it);
+    }
+    return collected;
+}
+
 void FontManager::unloadFont(const std::string& file_path, int point_size)
 {
     unloadFont(toResourceId(file_path), point_size);
@@ -137,6 +273,8 @@ void FontManager::clearFonts()
 {
     if (!fonts_.empty()) {
         spdlog::debug("正在清理所有 {} 个缓存的字体。", fonts_.size());
+        atlases_.clear();       // 图集引用字体，必须先释放
+        scalable_atlases_.clear();
         fonts_.clear();         // unique_ptr 会处理删除
     }
 }
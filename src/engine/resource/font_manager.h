@@ -11,9 +11,16 @@
 #include <unordered_map> // 用于 std::unordered_map
 #include <utility>      // 用于 std::pair
 #include <functional>   // 用于 std::hash
+#include <future>
+#include <vector>
 
 #include <SDL3_ttf/SDL_ttf.h> // SDL_ttf 主头文件
 #include "resource_id.h"
+#include "glyph_atlas.h"
+
+namespace engine::core {
+	class TaskPool;
+}
 
 namespace engine::resource {
 	/**
@@ -21,6 +28,12 @@ namespace engine::resource {
 	 * @brief 字体资源管理器，负责 SDL3_ttf 的初始化与字体资源的集中管理。
 	 * 
 	 * 该类通过 RAII 机制确保 SDL3_ttf 正确初始化与退出，并利用内部缓存避免重复加载相同路径和大小的字体。
+	 * 同时为每个（字体ID, 字号）维护一个持久的 GlyphAtlas，供 TextRenderer 批量绘制文本。
+	 *
+	 * 预加载：requestFont() 在工作线程上打开一组字号（读文件与解析字体表），collectPending() 在主线程收入缓存，
+	 * 并为每个字号预先光栅化给定的字符集，新字号第一次出现时不再卡顿。
+	 * 可缩放图集：每个字体另有一个以 SCALABLE_BASE_SIZE 光栅化的图集，按目标字号缩放四边形绘制，
+	 * 动画中的字号变化不会重新打开字体或光栅化。
 	 */
 	class FontManager final {
 	private:
@@ -78,14 +91,41 @@ namespace engine::resource {
 		 */
 		std::unordered_map<FontKey, std::unique_ptr<TTF_Font, SDLFontDeleter>, FontKeyHasher> fonts_;
 
+		/**
+		 * @brief 每个字体对应的字形图集（声明在 fonts_ 之后，保证先于字体销毁）。
+		 */
+		std::unordered_map<FontKey, std::unique_ptr<GlyphAtlas>, FontKeyHasher> atlases_;
+
+		/**
+		 * @brief 每个字体的可缩放图集（以 SCALABLE_BASE_SIZE 光栅化、线性过滤缩放绘制），同样先于字体销毁。
+		 */
+		std::unordered_map<ResourceId, std::unique_ptr<GlyphAtlas>> scalable_atlases_;
+
+		using FontPtr = std::unique_ptr<TTF_Font, SDLFontDeleter>;
+		/// @brief 工作线程上打开的一组字号，等待 collectPending() 收入缓存
+		struct PendingFonts {
+			ResourceId id_{ InvalidResourceId };
+			std::string glyphs_;                ///< 收入后预先光栅化的字符
+			bool scalable_{ false };            ///< 同时预热可缩放图集
+			std::future<std::vector<std::pair<int, FontPtr>>> fonts_;
+		};
+		std::vector<PendingFonts> pending_;
+
+		SDL_Renderer* renderer_ = nullptr;   ///< 用于创建图集纹理，为空时不提供图集
+		engine::core::TaskPool* tasks_ = nullptr;   ///< 预加载使用的线程池，为空时 requestFont 同步打开
+
 	public:
 
 		/**
 		 * @brief 构造函数。初始化 SDL_ttf。
+		 * @param renderer 用于创建字形图集纹理的渲染器，可为空（此时不提供图集）。
 		 * @attention 如果 TTF_Init() 失败，将抛出异常。
 		 * @throws std::runtime_error 如果 SDL_ttf 初始化失败。
 		 */
-		FontManager();
+		explicit FontManager(SDL_Renderer* renderer = nullptr, engine::core::TaskPool* tasks = nullptr);
+
+		/// @brief 可缩放图集的光栅化字号：缩小绘制为主，放大到约 1.5 倍以内仍然清晰
+		static constexpr int SCALABLE_BASE_SIZE = 48;
 
 		/**
 		 * @brief 析构函数。清空所有字体缓存并关闭 SDL_ttf。
@@ -121,6 +161,32 @@ private:
 		TTF_Font* getFont(ResourceId id, std::string_view file_path, int point_size);
 		TTF_Font* getFont(const std::string& file_path, int point_size);
 
+		/**
+		 * @brief 获取字体对应的字形图集，未创建时加载字体并创建。
+		 * @return GlyphAtlas 指针。字体加载失败或没有渲染器时返回 nullptr。
+		 */
+		GlyphAtlas* getGlyphAtlas(ResourceId id, std::string_view file_path, int point_size);
+
+		/**
+		 * @brief 获取字体的可缩放图集（SCALABLE_BASE_SIZE 字号，页纹理线性过滤），未创建时加载并创建。
+		 * @return 字体加载失败或没有渲染器时返回 nullptr。
+		 */
+		GlyphAtlas* getScalableAtlas(ResourceId id, std::string_view file_path);
+
+		/**
+		 * @brief 在工作线程上打开一组字号，已缓存的字号跳过。
+		 * @param glyphs 收入缓存后为每个字号预先光栅化的字符（UTF-8）。
+		 * @param scalable 同时创建并预热可缩放图集。
+		 */
+		void requestFont(ResourceId id, std::string_view file_path, const std::vector<int>& point_sizes,
+		                 std::string_view glyphs, bool scalable);
+
+		/// @brief 收入已打开的字体并预热图集（主线程每帧调用），返回收入的字号数
+		std::size_t collectPending();
+
+		/// @brief 仍在工作线程上打开的字体组数
+		[[nodiscard]] std::size_t getPendingCount() const { return pending_.size(); }
+
 		/**
 		 * @brief 卸载特定字体并从缓存中移除。
 		 * @param file_path 字体文件的路径。
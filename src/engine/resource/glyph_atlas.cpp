@@ -0,0 +1,176 @@
+#include "glyph_atlas.h"
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace engine::resource {
+
+GlyphAtlas::GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font, bool scalable)
+	: renderer_(renderer), font_(font), scalable_(scalable) {
+	static std::uint32_t next_serial = 0;   // 图集只在主线程创建
+	serial_ = ++next_serial;
+	line_height_ = static_cast<float>(TTF_GetFontHeight(font_));
+	line_skip_ = static_cast<float>(TTF_GetFontLineSkip(font_));
+}
+
+GlyphAtlas::~GlyphAtlas() {
+	for (auto& page : pages_) {
+		if (page.texture_) {
+			SDL_DestroyTexture(page.texture_);
+		}
+	}
+}
+
+bool GlyphAtlas::addPage() {
+	SDL_Texture* texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, PAGE_SIZE, PAGE_SIZE);
+	if (!texture) {
+		spdlog::error("创建字形图集页失败：{}", SDL_GetError());
+		return false;
+	}
+	// 清空为透明，留白区域在线性过滤时才不会采到脏数据
+	const std::vector<Uint32> clear_pixels(static_cast<std::size_t>(PAGE_SIZE) * PAGE_SIZE, 0u);
+	SDL_UpdateTexture(texture, nullptr, clear_pixels.data(), PAGE_SIZE * static_cast<int>(sizeof(Uint32)));
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	if (scalable_) {
+		SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_LINEAR);   // 缩放绘制，不受渲染器默认过滤方式影响
+	}
+
+	pages_.push_back(Page{ texture });
+	spdlog::debug("字形图集新增第 {} 页", pages_.size());
+	return true;
+}
+
+bool GlyphAtlas::allocate(int w, int h, std::uint32_t& page, SDL_Rect& rect) {
+	const int padded_w = w + GLYPH_PADDING;
+	const int padded_h = h + GLYPH_PADDING;
+	if (padded_w > PAGE_SIZE || padded_h > PAGE_SIZE) {
+		spdlog::warn("字形尺寸 {}x{} 超出图集页大小", w, h);
+		return false;
+	}
+
+	if (pages_.empty() && !addPage()) {
+		return false;
+	}
+
+	auto* current = &pages_.back();
+	if (current->cursor_x_ + padded_w > PAGE_SIZE) {
+		// 换到下一行
+		current->cursor_y_ += current->shelf_height_;
+		current->cursor_x_ = 0;
+		current->shelf_height_ = 0;
+	}
+	if (current->cursor_y_ + padded_h > PAGE_SIZE) {
+		if (!addPage()) {
+			return false;
+		}
+		current = &pages_.back();
+	}
+
+	page = static_cast<std::uint32_t>(pages_.size() - 1);
+	rect = SDL_Rect{ current->cursor_x_, current->cursor_y_, w, h };
+	current->cursor_x_ += padded_w;
+	current->shelf_height_ = std::max(current->shelf_height_, padded_h);
+	return true;
+}
+
+const Glyph& GlyphAtlas::getGlyph(std::uint32_t codepoint) {
+	auto it = glyphs_.find(codepoint);
+	if (it != glyphs_.end()) {
+		return it->second;
+	}
+
+	// 失败的字形也缓存为空白字形，避免每帧重试
+	Glyph& glyph = glyphs_[codepoint];
+	int advance = 0;
+	if (!TTF_GetGlyphMetrics(font_, codepoint, nullptr, nullptr, nullptr, nullptr, &advance)) {
+		spdlog::warn("字体不包含字符 U+{:04X}", codepoint);
+		return glyph;
+	}
+	glyph.advance_ = static_cast<float>(advance);
+
+	SDL_Surface* rendered = TTF_RenderGlyph_Blended(font_, codepoint, SDL_Color{ 255, 255, 255, 255 });
+	if (!rendered) {
+		return glyph;   // 空白字符（如空格）没有可见像素
+	}
+	SDL_Surface* surface = SDL_ConvertSurface(rendered, SDL_PIXELFORMAT_ARGB8888);
+	SDL_DestroySurface(rendered);
+	if (!surface) {
+		spdlog::error("转换字形像素格式失败：{}", SDL_GetError());
+		return glyph;
+	}
+
+	std::uint32_t page = 0;
+	SDL_Rect rect{};
+	if (surface->w > 0 && surface->h > 0 && allocate(surface->w, surface->h, page, rect)) {
+		if (SDL_UpdateTexture(pages_[page].texture_, &rect, surface->pixels, surface->pitch)) {
+			glyph.page_ = page;
+			glyph.src_ = SDL_FRect{ static_cast<float>(rect.x), static_cast<float>(rect.y),
+			                        static_cast<float>(rect.w), static_cast<float>(rect.h) };
+		} else {
+			spdlog::error("写入字形图集失败：{}", SDL_GetError());
+		}
+	}
+	SDL_DestroySurface(surface);
+	return glyph;
+}
+
+std::size_t GlyphAtlas::warm(std::string_view text) {
+	const std::size_t before = glyphs_.size();
+	const char* cursor = text.data();
+	std::size_t remaining = text.size();
+	while (remaining > 0) {
+		const std::uint32_t codepoint = SDL_StepUTF8(&cursor, &remaining);
+		if (codepoint == 0) {
+			break;
+		}
+		if (codepoint != '\n') {
+			getGlyph(codepoint);
+		}
+	}
+	return glyphs_.size() - before;
+}
+
+float GlyphAtlas::getKerning(std::uint32_t previous, std::uint32_t codepoint) const {
+	int kerning = 0;
+	if (!TTF_GetGlyphKerning(font_, previous, codepoint, &kerning)) {
+		return 0.0f;
+	}
+	return static_cast<float>(kerning);
+}
+
+glm::vec2 GlyphAtlas::measureText(std::string_view text) {
+	if (text.empty()) {
+		return { 0.0f, 0.0f };
+	}
+
+	float width = 0.0f;
+	float pen_x = 0.0f;
+	int lines = 1;
+	std::uint32_t previous = 0;
+
+	const char* cursor = text.data();
+	std::size_t remaining = text.size();
+	while (remaining > 0) {
+		const std::uint32_t codepoint = SDL_StepUTF8(&cursor, &remaining);
+		if (codepoint == 0) {
+			break;
+		}
+		if (codepoint == '\n') {
+			width = std::max(width, pen_x);
+			pen_x = 0.0f;
+			previous = 0;
+			++lines;
+			continue;
+		}
+		if (previous != 0) {
+			pen_x += getKerning(previous, codepoint);
+		}
+		pen_x += getGlyph(codepoint).advance_;
+		previous = codepoint;
+	}
+	width = std::max(width, pen_x);
+	return { width, line_height_ + line_skip_ * static_cast<float>(lines - 1) };
+}
+
+} // namespace engine::resource
@@ -0,0 +1,104 @@
+#pragma once
+/**
+ * @file glyph_atlas.h
+ * @brief 定义 GlyphAtlas 类：单个字体（字体ID + 字号）的字形图集与字形度量缓存。
+ */
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec2.hpp>
+#include <SDL3/SDL_rect.h>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+struct TTF_Font;
+
+namespace engine::resource {
+
+	/**
+	 * @struct Glyph
+	 * @brief 已缓存字形在图集中的位置与排版度量
+	 */
+	struct Glyph {
+		std::uint32_t page_{0};     ///< 所在图集页
+		SDL_FRect src_{};           ///< 图集内的像素区域（宽高即绘制尺寸），空白字形为 0
+		float advance_{0.0f};       ///< 笔位前进量（像素）
+	};
+
+	/**
+	 * @class GlyphAtlas
+	 * @brief 字形图集：按需光栅化字形并打包进若干张图集纹理，之后任何字符串都只需查表排版。
+	 *
+	 * @details
+	 * 每个字形首次出现时用 TTF_RenderGlyph_Blended 光栅化一次（白色，绘制时用顶点颜色着色），
+	 * 以行（shelf）方式打包进固定大小的图集页，页满时新建一页。图集不拥有字体，
+	 * 由 FontManager 保证其生命周期短于对应的 TTF_Font。
+	 *
+	 * 可缩放图集（scalable）以较大字号光栅化，页纹理固定线性过滤，TextRenderer 按目标字号缩放四边形绘制，
+	 * 一个图集即可覆盖任意字号（含逐帧变化的动画字号）。
+	 */
+	class GlyphAtlas final {
+	public:
+		static constexpr int PAGE_SIZE = 512;      ///< 图集页边长（像素）
+		static constexpr int GLYPH_PADDING = 1;    ///< 字形间留白，避免线性过滤采样到相邻字形
+
+		GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font, bool scalable = false);
+		~GlyphAtlas();
+
+		GlyphAtlas(const GlyphAtlas&) = delete;
+		GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+		/**
+		 * @brief 获取字形，未缓存时光栅化并写入图集
+		 * @return 字体不支持或光栅化失败时返回空白字形（advance 为 0）
+		 */
+		const Glyph& getGlyph(std::uint32_t codepoint);
+
+		/**
+		 * @brief 预先光栅化一段文本中的全部字符（预加载时调用，避免首次绘制时卡顿）
+		 * @return 本次新光栅化的字形数
+		 */
+		std::size_t warm(std::string_view text);
+
+		/// @brief 两个相邻字符之间的字距调整（像素）
+		[[nodiscard]] float getKerning(std::uint32_t previous, std::uint32_t codepoint) const;
+
+		/**
+		 * @brief 按缓存的字形度量计算文本尺寸（支持 '\n' 换行）
+		 */
+		glm::vec2 measureText(std::string_view text);
+
+		[[nodiscard]] float getLineHeight() const { return line_height_; }
+		[[nodiscard]] float getLineSkip() const { return line_skip_; }
+		[[nodiscard]] SDL_Texture* getPageTexture(std::uint32_t page) const { return pages_[page].texture_; }
+		[[nodiscard]] std::size_t getPageCount() const { return pages_.size(); }
+		[[nodiscard]] std::size_t getGlyphCount() const { return glyphs_.size(); }
+		/// @brief 实例序号（单调递增）：字体卸载后重建的图集序号不同，排版缓存据此判断缓存的字形位置是否仍然有效
+		[[nodiscard]] std::uint32_t getSerial() const { return serial_; }
+		[[nodiscard]] bool isScalable() const { return scalable_; }
+
+	private:
+		struct Page {
+			SDL_Texture* texture_{nullptr};
+			int cursor_x_{0};       ///< 当前行的下一个写入位置
+			int cursor_y_{0};       ///< 当前行顶部
+			int shelf_height_{0};   ///< 当前行高度
+		};
+
+		/// @brief 在图集中为 w x h 的字形分配区域，必要时新建一页
+		bool allocate(int w, int h, std::uint32_t& page, SDL_Rect& rect);
+		bool addPage();
+
+		SDL_Renderer* renderer_{nullptr};
+		TTF_Font* font_{nullptr};
+		std::uint32_t serial_{0};
+		bool scalable_{false};
+		float line_height_{0.0f};
+		float line_skip_{0.0f};
+		std::vector<Page> pages_;
+		std::unordered_map<std::uint32_t, Glyph> glyphs_;
+	};
+
+} // namespace engine::resource
@@ -0,0 +1,45 @@
+#include "resource_handle.h"
+#include "resource_manager.h"
+
+engine::resource::ResourceScope::~ResourceScope() {
+	releaseAll();
+}
+
+engine::resource::TextureHandle engine::resource::ResourceScope::acquireTexture(ResourceId id, std::string_view file_path) {
+	const auto handle = resource_manager_->acquireTexture(id, file_path);
+	if (handle.valid()) {
+		textures_.push_back(handle);
+	}
+	return handle;
+}
+
+engine::resource::SoundHandle engine::resource::ResourceScope::acquireSound(ResourceId id, std::string_view file_path) {
+	const auto handle = resource_manager_->acquireSound(id, file_path);
+	if (handle.valid()) {
+		sounds_.push_back(handle);
+	}
+	return handle;
+}
+
+engine::resource::FontHandle engine::resource::ResourceScope::acquireFont(ResourceId id, std::string_view file_path, int point_size) {
+	const auto handle = resource_manager_->acquireFont(id, file_path, point_size);
+	if (handle.valid()) {
+		fonts_.push_back(handle);
+	}
+	return handle;
+}
+
+void engine::resource::ResourceScope::releaseAll() {
+	for (const auto handle : textures_) {
+		resource_manager_->release(handle);
+	}
+	for (const auto handle : sounds_) {
+		resource_manager_->release(handle);
+	}
+	for (const auto handle : fonts_) {
+		resource_manager_->release(handle);
+	}
+	textures_.clear();
+	sounds_.clear();
+	fonts_.clear();
+}
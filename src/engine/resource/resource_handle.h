@@ -0,0 +1,81 @@
+/**
+ * @file resource_handle.h
+ * @brief 定义带代数的资源句柄（TextureHandle、SoundHandle、FontHandle）与按场景持有句柄的 ResourceScope。
+ *
+ * 句柄只记录资源键与代数，不持有指针：ResourceManager 为每个被引用的资源维护引用计数与代数，
+ * 引用归零的资源在之后的 update() 中卸载并把代数加一，此前发出的句柄随之失效（isAlive() 返回 false），
+ * 对失效句柄的 release() 被忽略，不会误减重新加载后的引用计数。
+ * 渲染与播放仍按 ResourceId 取裸指针，句柄只决定资源何时可以卸载。
+ */
+
+#pragma once
+
+#include "resource_id.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace engine::resource {
+	class ResourceManager;
+
+	/// @brief 句柄所指的资源种类
+	enum class ResourceKind : std::uint8_t {
+		TEXTURE,
+		SOUND,
+		FONT,
+		COUNT
+	};
+
+	/**
+	 * @struct ResourceHandle
+	 * @brief 资源的引用句柄；种类是模板参数，不同种类的句柄不能混用。
+	 * @details 字体句柄的 id_ 是字体 ID 与字号组合后的键，不能直接传给 getFont()。
+	 */
+	template <ResourceKind Kind>
+	struct ResourceHandle {
+		static constexpr ResourceKind KIND = Kind;
+
+		ResourceId id_{ InvalidResourceId };    ///< 资源键
+		std::uint32_t generation_{ 0 };         ///< 发出句柄时资源的代数，0 表示空句柄
+
+		[[nodiscard]] bool valid() const { return generation_ != 0; }
+		bool operator==(const ResourceHandle&) const = default;
+	};
+
+	using TextureHandle = ResourceHandle<ResourceKind::TEXTURE>;
+	using SoundHandle = ResourceHandle<ResourceKind::SOUND>;
+	using FontHandle = ResourceHandle<ResourceKind::FONT>;
+
+	/**
+	 * @class ResourceScope
+	 * @brief 一组同生共死的资源引用，通常归一个场景所有，Scene::clean() 时整体释放。
+	 *
+	 * 释放只让引用计数归零，资源要到之后的 ResourceManager::update() 才真正卸载；
+	 * 切换场景时新场景在同一帧内重新获取的资源（如重开本关）因此不会被卸载再加载。
+	 * ResourceManager 须比 ResourceScope 存活更久。
+	 */
+	class ResourceScope final {
+	public:
+		explicit ResourceScope(ResourceManager& resource_manager) : resource_manager_(&resource_manager) {}
+		~ResourceScope();
+
+		ResourceScope(const ResourceScope&) = delete;
+		ResourceScope& operator=(const ResourceScope&) = delete;
+
+		/// @brief 获取资源引用（未加载时提交后台加载），返回的句柄同时记入本作用域
+		TextureHandle acquireTexture(ResourceId id, std::string_view file_path = {});
+		SoundHandle acquireSound(ResourceId id, std::string_view file_path = {});
+		FontHandle acquireFont(ResourceId id, std::string_view file_path, int point_size);
+
+		/// @brief 释放本作用域持有的全部引用（可重复调用，之后仍可继续获取）
+		void releaseAll();
+
+		[[nodiscard]] std::size_t size() const { return textures_.size() + sounds_.size() + fonts_.size(); }
+
+	private:
+		ResourceManager* resource_manager_;
+		std::vector<TextureHandle> textures_;
+		std::vector<SoundHandle> sounds_;
+		std::vector<FontHandle> fonts_;
+	};
+}
@@ -2,22 +2,29 @@
 #include "texture_manager.h"
 #include "audio_manager.h"
 #include "font_manager.h" 
+#include "../core/startup_profiler.h"
+#include "../core/task_pool.h"
+#include "../io/virtual_fs.h"
+#include "../utils/profiler.h"
 #include <SDL3_mixer/SDL_mixer.h>
 #include <SDL3_ttf/SDL_ttf.h> 
 #include <glm/glm.hpp>
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <filesystem>
 #include <fstream>
-#include <cstdio>
+#include <unordered_set>
 
 /**
  * @brief 构造函数，初始化各个子资源管理器。
  * @param renderer SDL_Renderer 指针，用于创建纹理。
+ * @param task_pool 图片与音频解码使用的任务线程池。
  */
-engine::resource::ResourceManager::ResourceManager(SDL_Renderer* renderer)
-	: texture_manager_(std::make_unique<TextureManager>(renderer)),
-	  font_manager_(std::make_unique<FontManager>()),
-	  audio_manager_(std::make_unique<AudioManager>()) {
+engine::resource::ResourceManager::ResourceManager(SDL_Renderer* renderer, engine::core::TaskPool& task_pool)
+	: texture_manager_(std::make_unique<TextureManager>(renderer, task_pool)),
+	  font_manager_(std::make_unique<FontManager>(renderer, &task_pool)),
+	  audio_manager_(std::make_unique<AudioManager>(task_pool)) {
 	spdlog::trace("ResourceManager 构造成功。");
 }
 
@@ -27,7 +34,7 @@ engine::resource::ResourceManager::ResourceManager(SDL_Renderer* renderer)
 engine::resource::ResourceManager::~ResourceManager() = default;
 
 std::string_view engine::resource::ResourceManager::resolvePath(
-	const std::unordered_map<ResourceId, std::string>& mapping,
+	const engine::utils::IdMap<std::string>& mapping,
 	ResourceId id,
 	std::string_view fallback) const {
 	if (!fallback.empty()) {
@@ -41,32 +48,22 @@ std::string_view engine::resource::ResourceManager::resolvePath(
 }
 
 bool engine::resource::ResourceManager::loadResources(std::string_view mapping_path, bool preload) {
-	const std::string mapping_path_str(mapping_path);
-	std::FILE* fp = std::fopen(mapping_path_str.c_str(), "rb");
-	if (!fp) {
+	ENGINE_PROFILE_SCOPE("ResourceManager::loadResources");
+	const auto file = engine::io::VirtualFS::instance().read(mapping_path);
+	if (!file) {
 		spdlog::error("无法打开资源映射文件: {}", mapping_path);
 		return false;
 	}
 
-	std::string content;
-	std::fseek(fp, 0, SEEK_END);
-	const long size = std::ftell(fp);
-	std::fseek(fp, 0, SEEK_SET);
-	if (size > 0) {
-		content.resize(static_cast<size_t>(size));
-		std::fread(content.data(), 1, static_cast<size_t>(size), fp);
-	}
-	std::fclose(fp);
-
 	nlohmann::json j;
 	try {
-		j = nlohmann::json::parse(content);
+		j = nlohmann::json::parse(file->text());
 	} catch (const std::exception& e) {
 		spdlog::error("解析资源映射文件失败: {}", e.what());
 		return false;
 	}
 
-	auto load_string_map = [&](const char* key, std::unordered_map<ResourceId, std::string>& mapping,
+	auto load_string_map = [&](const char* key, engine::utils::IdMap<std::string>& mapping,
 		auto loader) {
 		if (!j.contains(key) || !j[key].is_object()) {
 			return;
@@ -107,12 +104,79 @@ bool engine::resource::ResourceManager::loadResources(std::string_view mapping_p
 	load_string_map("font", font_mapping_, [](ResourceId, std::string_view) {});
 	load_string_map("fonts", font_mapping_, [](ResourceId, std::string_view) {});
 
+	// 预解码音效缓存预算（MB）
+	if (j.contains("sound_cache_mb") && j["sound_cache_mb"].is_number()) {
+		audio_manager_->setSoundBudget(static_cast<std::size_t>(std::max(0.0, j["sound_cache_mb"].get<double>()) * 1024.0 * 1024.0));
+	}
+
+	// 音效并发策略：{ "sword_hit": { "max_voices": 3, "priority": 0 } }
+	if (j.contains("sound_policy") && j["sound_policy"].is_object()) {
+		for (auto it = j["sound_policy"].begin(); it != j["sound_policy"].end(); ++it) {
+			if (!it.value().is_object()) {
+				continue;
+			}
+			SoundPolicy policy;
+			policy.max_voices_ = it.value().value("max_voices", policy.max_voices_);
+			policy.priority_ = it.value().value("priority", policy.priority_);
+			audio_manager_->setSoundPolicy(toResourceId(it.key()), policy);
+		}
+	}
+
+	if (j.contains("texture_atlas") && j["texture_atlas"].is_object()) {
+		const auto& atlas = j["texture_atlas"];
+		atlas_config_ = TextureAtlasConfig{};
+		atlas_config_.page_size_ = atlas.value("page_size", atlas_config_.page_size_);
+		atlas_config_.max_entry_size_ = atlas.value("max_entry_size", atlas_config_.max_entry_size_);
+		atlas_config_.padding_ = atlas.value("padding", atlas_config_.padding_);
+		atlas_config_.pixel_format_ = parseAtlasPixelFormat(atlas.value("pixel_format", std::string("rgba8888")));
+		atlas_config_.mip_levels_ = atlas.value("mip_levels", atlas_config_.mip_levels_);
+		if (atlas.contains("sources") && atlas["sources"].is_array()) {
+			for (const auto& source : atlas["sources"]) {
+				if (source.is_string()) {
+					atlas_config_.sources_.push_back(source.get<std::string>());
+				}
+			}
+		}
+	}
+
 	spdlog::info("资源映射表加载完成: {}", mapping_path);
 	return true;
 }
 
-bool engine::resource::ResourceManager::preloadMappedResources() {
-	auto preload_map = [this](const std::unordered_map<ResourceId, std::string>& mapping, auto loader) {
+std::vector<std::string> engine::resource::ResourceManager::collectAtlasFiles() const {
+	std::vector<std::string> atlas_files;
+	for (const auto& source : atlas_config_.sources_) {
+		std::error_code ec;
+		if (std::filesystem::is_directory(source, ec)) {
+			std::vector<std::string> directory_files;
+			for (const auto& entry : std::filesystem::directory_iterator(source, ec)) {
+				if (entry.is_regular_file() && entry.path().extension() == ".png") {
+					directory_files.push_back(entry.path().generic_string());
+				}
+			}
+			std::ranges::sort(directory_files);
+			atlas_files.insert(atlas_files.end(), directory_files.begin(), directory_files.end());
+		} else if (std::filesystem::is_regular_file(source, ec)) {
+			atlas_files.push_back(source);
+		} else {
+			spdlog::warn("图集来源不存在: {}", source);
+		}
+	}
+	return atlas_files;
+}
+
+void engine::resource::ResourceManager::registerAtlasAliases() {
+	for (const auto& [id, path] : texture_mapping_) {
+		const auto target = toResourceId(path);
+		if (id != target && texture_manager_->addAtlasAlias(id, target)) {
+			// 打包完成前以逻辑名单独加载的同一图片不再需要
+			texture_manager_->dropTexture(id);
+		}
+	}
+}
+
+bool engine::resource::ResourceManager::preloadMappedResources(bool defer_atlas) {
+	auto preload_map = [this](const engine::utils::IdMap<std::string>& mapping, auto loader) {
 		for (const auto& [id, path] : mapping) {
 			try {
 				loader(id, path);
@@ -122,18 +186,280 @@ bool engine::resource::ResourceManager::preloadMappedResources() {
 		}
 	};
 
-	preload_map(texture_mapping_, [this](ResourceId id, const std::string& path) {
-		loadTexture(id, path);
-	});
-	preload_map(sound_mapping_, [this](ResourceId id, const std::string& path) {
-		loadSound(id, path);
-	});
-	preload_map(music_mapping_, [this](ResourceId id, const std::string& path) {
-		loadMusic(id, path);
-	});
+	std::unordered_set<ResourceId> deferred_atlas_files;
+	if (atlas_config_.enabled()) {
+		ENGINE_STARTUP_PHASE("preload.atlas");
+		const auto atlas_files = collectAtlasFiles();
+		if (defer_atlas) {
+			texture_manager_->beginAtlasBuild(atlas_files, atlas_config_, engine::core::TaskPriority::BACKGROUND);
+			for (const auto& path : atlas_files) {
+				deferred_atlas_files.insert(toResourceId(path));
+			}
+		} else {
+			texture_manager_->buildAtlas(atlas_files, atlas_config_);
+			registerAtlasAliases();
+		}
+	}
+
+	// 其余资源只提交后台解码，不阻塞首帧；即将打包进图集的图片不另行解码为独立纹理
+	{
+		ENGINE_STARTUP_PHASE("preload.textures");
+		preload_map(texture_mapping_, [this, &deferred_atlas_files](ResourceId id, const std::string& path) {
+			if (!deferred_atlas_files.contains(toResourceId(path))) {
+				texture_manager_->requestTexture(id, path);
+			}
+		});
+	}
+	{
+		ENGINE_STARTUP_PHASE("preload.sounds");
+		preload_map(sound_mapping_, [this](ResourceId id, const std::string& path) {
+			audio_manager_->requestSound(id, path);
+		});
+	}
+	{
+		ENGINE_STARTUP_PHASE("preload.music");
+		preload_map(music_mapping_, [this](ResourceId id, const std::string& path) {
+			audio_manager_->requestMusic(id, path);
+		});
+	}
 	return true;
 }
 
+void engine::resource::ResourceManager::requestPreload(const PreloadManifest& manifest) {
+	for (const auto& path : manifest.textures_) {
+		requestTexture(toResourceId(path), path);
+	}
+	for (const auto id : manifest.sounds_) {
+		requestSound(id);
+	}
+	for (const auto id : manifest.music_) {
+		requestMusic(id);
+	}
+	for (const auto& font : manifest.fonts_) {
+		const auto id = toResourceId(font.path_);
+		font_manager_->requestFont(id, resolvePath(font_mapping_, id, font.path_), font.sizes_, font.glyphs_, font.scalable_);
+	}
+	spdlog::debug("已提交后台预加载: {} 纹理, {} 音效, {} 音乐, {} 字体",
+		manifest.textures_.size(), manifest.sounds_.size(), manifest.music_.size(), manifest.fonts_.size());
+}
+
+void engine::resource::ResourceManager::acquireManifest(const PreloadManifest& manifest, ResourceScope& scope) {
+	for (const auto& path : manifest.textures_) {
+		scope.acquireTexture(toResourceId(path), path);
+	}
+	for (const auto id : manifest.sounds_) {
+		scope.acquireSound(id);
+	}
+	spdlog::debug("已获取清单引用: {} 纹理, {} 音效", manifest.textures_.size(), manifest.sounds_.size());
+}
+
+namespace {
+	/// @brief 字体按 (字体 ID, 字号) 缓存，句柄的键把两者合成一个 ResourceId
+	engine::resource::ResourceId fontHandleKey(engine::resource::ResourceId id, int point_size) {
+		return id ^ (static_cast<engine::resource::ResourceId>(point_size) * 0x9E3779B9u);
+	}
+}
+
+template <engine::resource::ResourceKind Kind>
+engine::resource::ResourceHandle<Kind> engine::resource::ResourceManager::retain(ResourceId key, ResourceId resource_id, int point_size) {
+	auto& entry = handles_[static_cast<std::size_t>(Kind)][key];
+	entry.resource_id_ = resource_id;
+	entry.point_size_ = point_size;
+	++entry.refs_;
+	return ResourceHandle<Kind>{ key, entry.generation_ };
+}
+
+template <engine::resource::ResourceKind Kind>
+void engine::resource::ResourceManager::releaseHandle(ResourceHandle<Kind> handle) {
+	if (!handle.valid()) {
+		return;
+	}
+	auto& entries = handles_[static_cast<std::size_t>(Kind)];
+	auto it = entries.find(handle.id_);
+	if (it == entries.end() || it->second.generation_ != handle.generation_ || it->second.refs_ == 0) {
+		spdlog::warn("忽略已失效的资源句柄: id={} (代数 {})", handle.id_, handle.generation_);
+		return;
+	}
+	if (--it->second.refs_ == 0) {
+		if constexpr (Kind == ResourceKind::TEXTURE) {
+			texture_manager_->unpin(it->second.resource_id_);
+		}
+		unreferenced_.emplace_back(Kind, handle.id_);
+	}
+}
+
+template <engine::resource::ResourceKind Kind>
+bool engine::resource::ResourceManager::isHandleAlive(ResourceHandle<Kind> handle) const {
+	const auto& entries = handles_[static_cast<std::size_t>(Kind)];
+	const auto it = entries.find(handle.id_);
+	return handle.valid() && it != entries.end() && it->second.generation_ == handle.generation_;
+}
+
+engine::resource::TextureHandle engine::resource::ResourceManager::acquireTexture(ResourceId id, std::string_view file_path) {
+	if (!requestTexture(id, file_path)) {
+		spdlog::warn("无法获取纹理引用（没有路径或加载失败）: id={}", id);
+		return {};
+	}
+	const auto handle = retain<ResourceKind::TEXTURE>(id, id, 0);
+	texture_manager_->pin(id);
+	return handle;
+}
+
+engine::resource::SoundHandle engine::resource::ResourceManager::acquireSound(ResourceId id, std::string_view file_path) {
+	if (!requestSound(id, file_path)) {
+		spdlog::warn("无法获取音效引用（没有路径或加载失败）: id={}", id);
+		return {};
+	}
+	return retain<ResourceKind::SOUND>(id, id, 0);
+}
+
+engine::resource::FontHandle engine::resource::ResourceManager::acquireFont(ResourceId id, std::string_view file_path, int point_size) {
+	if (!getFont(id, file_path, point_size)) {
+		return {};
+	}
+	return retain<ResourceKind::FONT>(fontHandleKey(id, point_size), id, point_size);
+}
+
+void engine::resource::ResourceManager::release(TextureHandle handle) {
+	releaseHandle(handle);
+}
+
+void engine::resource::ResourceManager::release(SoundHandle handle) {
+	releaseHandle(handle);
+}
+
+void engine::resource::ResourceManager::release(FontHandle handle) {
+	releaseHandle(handle);
+}
+
+bool engine::resource::ResourceManager::isAlive(TextureHandle handle) const {
+	return isHandleAlive(handle);
+}
+
+bool engine::resource::ResourceManager::isAlive(SoundHandle handle) const {
+	return isHandleAlive(handle);
+}
+
+bool engine::resource::ResourceManager::isAlive(FontHandle handle) const {
+	return isHandleAlive(handle);
+}
+
+std::size_t engine::resource::ResourceManager::unloadUnreferenced() {
+	if (unreferenced_.empty()) {
+		return 0;
+	}
+	std::size_t unloaded = 0;
+	std::erase_if(unreferenced_, [this, &unloaded](const std::pair<ResourceKind, ResourceId>& queued) {
+		const auto [kind, key] = queued;
+		auto& entries = handles_[static_cast<std::size_t>(kind)];
+		auto it = entries.find(key);
+		if (it == entries.end() || it->second.refs_ > 0) {
+			return true;    // 期间被重新获取（如重开本关），保留
+		}
+		auto& entry = it->second;
+		switch (kind) {
+		case ResourceKind::TEXTURE:
+			if (texture_manager_->pending_.contains(entry.resource_id_)) {
+				return false;   // 解码完成后再卸载
+			}
+			if (texture_manager_->findAtlasRegion(entry.resource_id_)) {
+				break;          // 图集区域与图集页共享，随图集常驻
+			}
+			if (texture_manager_->textures_.contains(entry.resource_id_)) {
+				texture_manager_->unloadTexture(entry.resource_id_);
+				++unloaded;
+			}
+			texture_manager_->evicted_.erase(entry.resource_id_);
+			break;
+		case ResourceKind::SOUND:
+			audio_manager_->releaseSound(entry.resource_id_);   // 音频线程等声部播完后卸载
+			++unloaded;
+			break;
+		case ResourceKind::FONT:
+			font_manager_->unloadFont(entry.resource_id_, entry.point_size_);
+			++unloaded;
+			break;
+		case ResourceKind::COUNT:
+			break;
+		}
+		++entry.generation_;
+		return true;
+	});
+	if (unloaded > 0) {
+		spdlog::debug("已卸载 {} 个不再被引用的资源", unloaded);
+	}
+	return unloaded;
+}
+
+bool engine::resource::ResourceManager::isMappedPreloadComplete() const {
+	return !texture_manager_->isAtlasBuildPending();
+}
+
+float engine::resource::ResourceManager::getMappedPreloadProgress() const {
+	return texture_manager_->getAtlasBuildProgress();
+}
+
+void engine::resource::ResourceManager::update() {
+	if (texture_manager_->updateAtlasBuild()) {
+		registerAtlasAliases();
+	}
+	audio_manager_->collectPending();
+	font_manager_->collectPending();
+	unloadUnreferenced();
+	audio_manager_->beginSoundFrame();
+	texture_manager_->beginFrame();
+	ENGINE_PROFILE_COUNTER("res.tex_sync_loads", static_cast<std::int64_t>(texture_manager_->getCacheStats().sync_loads_));
+	ENGINE_PROFILE_COUNTER("res.tex_resident_kb", static_cast<std::int64_t>(texture_manager_->getResidentBytes() / 1024));
+	std::int64_t referenced = 0;
+	for (const auto& entries : handles_) {
+		referenced += std::ranges::count_if(entries, [](const auto& entry) { return entry.second.refs_ > 0; });
+	}
+	ENGINE_PROFILE_COUNTER("res.handles", referenced);
+}
+
+std::size_t engine::resource::ResourceManager::getAudioResidentBytes() const {
+	return audio_manager_->getResidentBytes();
+}
+
+float engine::resource::ResourceManager::getAudioOutputLatencyMs() const {
+	return audio_manager_->getOutputLatencyMs();
+}
+
+void engine::resource::ResourceManager::setSoundCacheBudget(std::size_t bytes) {
+	audio_manager_->setSoundBudget(bytes);
+}
+
+void engine::resource::ResourceManager::setTextureVramBudget(std::size_t bytes) {
+	texture_manager_->setVramBudget(bytes);
+}
+
+std::size_t engine::resource::ResourceManager::getTextureResidentBytes() const {
+	return texture_manager_->getResidentBytes();
+}
+
+std::size_t engine::resource::ResourceManager::getPendingCount() const {
+	return texture_manager_->getPendingCount() + audio_manager_->getPendingCount() + font_manager_->getPendingCount();
+}
+
+void engine::resource::ResourceManager::setTextureStreaming(bool enabled) {
+	texture_manager_->setStreaming(enabled);
+}
+
+bool engine::resource::ResourceManager::requestTexture(ResourceId id, std::string_view file_path) {
+	const auto resolved = resolvePath(texture_mapping_, id, file_path);
+	return texture_manager_->requestTexture(id, resolved);
+}
+
+bool engine::resource::ResourceManager::requestSound(ResourceId id, std::string_view file_path) {
+	const auto resolved = resolvePath(sound_mapping_, id, file_path);
+	return audio_manager_->requestSound(id, resolved);
+}
+
+bool engine::resource::ResourceManager::requestMusic(ResourceId id, std::string_view file_path) {
+	const auto resolved = resolvePath(music_mapping_, id, file_path);
+	return audio_manager_->requestMusic(id, resolved);
+}
+
 
 // --- 统一资源访问接口 ---
 
@@ -170,8 +496,8 @@ void engine::resource::ResourceManager::unloadTexture(ResourceId id) {
  * @return 包含宽度（x）和高度（y）的 glm::vec2。
  */
 glm::vec2 engine::resource::ResourceManager::getTextureSize(ResourceId id, std::string_view file_path) {
-	const auto resolved = resolvePath(texture_mapping_, id, file_path);
-	return texture_manager_->getTextureSize(id, resolved);
+	// 已打包的纹理返回其在图集中的原始尺寸；尺寸查询总是同步解析，不返回占位纹理尺寸
+	return getTextureRegion(id, file_path, false).size_;
 }
 
 SDL_Texture* engine::resource::ResourceManager::loadTexture(const std::string& file_path) {
@@ -216,6 +542,37 @@ glm::vec2 engine::resource::ResourceManager::getTextureSize(entt::hashed_string
 	return getTextureSize(id, std::string_view{ str_hs.data(), str_hs.size() });
 }
 
+/**
+ * @brief 解析纹理的实际绘制位置（图集区域或独立纹理）。
+ * @param id 纹理资源ID。
+ * @param file_path 纹理文件的相对路径。
+ * @param allow_placeholder 流式模式下是否允许返回占位纹理。
+ * @param mip_level 期望的图集缩小级。
+ * @return 纹理无效时 texture_ 为 nullptr。
+ */
+engine::resource::TextureRegion engine::resource::ResourceManager::getTextureRegion(ResourceId id, std::string_view file_path, bool allow_placeholder,
+	int mip_level) {
+	if (const auto* region = texture_manager_->findAtlasRegion(id)) {
+		return texture_manager_->selectMip(*region, mip_level);
+	}
+	const auto resolved = resolvePath(texture_mapping_, id, file_path);
+	// 以逻辑名引用、但按路径打包的纹理：登记别名，下次直接命中
+	if (!resolved.empty() && texture_manager_->addAtlasAlias(id, toResourceId(resolved))) {
+		return texture_manager_->selectMip(*texture_manager_->findAtlasRegion(id), mip_level);
+	}
+	return texture_manager_->getTextureRegion(id, resolved, allow_placeholder, mip_level);
+}
+
+/**
+ * @brief 创建渲染目标纹理。
+ * @param id 纹理资源ID。
+ * @param size 纹理尺寸（像素）。
+ * @return SDL_Texture 指针，失败返回 nullptr。
+ */
+SDL_Texture* engine::resource::ResourceManager::createRenderTarget(ResourceId id, glm::ivec2 size) {
+	return texture_manager_->createRenderTarget(id, size);
+}
+
 /**
  * @brief 清空所有已加载的纹理资源。
  */
@@ -223,6 +580,14 @@ void engine::resource::ResourceManager::clearTextures(){
 	texture_manager_->clearTextures();
 }
 
+std::vector<engine::resource::TextureMemoryInfo> engine::resource::ResourceManager::getTextureMemoryUsage() const {
+	return texture_manager_->collectMemoryUsage();
+}
+
+engine::resource::TextureCacheStats engine::resource::ResourceManager::getTextureCacheStats() const {
+	return texture_manager_->getCacheStats();
+}
+
 
 //--- 统一音乐音效访问接口 ---
 
@@ -239,9 +604,17 @@ MIX_Audio* engine::resource::ResourceManager::loadSound(ResourceId id, std::stri
  * @brief 播放音效。
  * @param file_path 音频文件相对路径。
  */
-void engine::resource::ResourceManager::playSound(ResourceId id, std::string_view file_path) {
+void engine::resource::ResourceManager::playSound(ResourceId id, std::string_view file_path, float gain) {
 	const auto resolved = resolvePath(sound_mapping_, id, file_path);
-	audio_manager_->playSound(id, resolved);
+	audio_manager_->playSound(id, resolved, gain);
+}
+
+/**
+ * @brief 播放空间化音效。
+ */
+void engine::resource::ResourceManager::playSoundSpatial(ResourceId id, std::string_view file_path, const glm::vec2& emitter, const glm::vec2& listener, float max_distance) {
+	const auto resolved = resolvePath(sound_mapping_, id, file_path);
+	audio_manager_->playSoundSpatial(id, resolved, emitter, listener, max_distance);
 }
 
 /**
@@ -381,6 +754,19 @@ TTF_Font* engine::resource::ResourceManager::getFont(ResourceId id, std::string_
 	return font_manager_->getFont(id, resolved, point_size);
 }
 
+/**
+ * @brief 获取字体对应的持久字形图集。
+ */
+engine::resource::GlyphAtlas* engine::resource::ResourceManager::getGlyphAtlas(ResourceId id, std::string_view file_path, int point_size) {
+	const auto resolved = resolvePath(font_mapping_, id, file_path);
+	return font_manager_->getGlyphAtlas(id, resolved, point_size);
+}
+
+engine::resource::GlyphAtlas* engine::resource::ResourceManager::getScalableGlyphAtlas(ResourceId id, std::string_view file_path) {
+	const auto resolved = resolvePath(font_mapping_, id, file_path);
+	return font_manager_->getScalableAtlas(id, resolved);
+}
+
 /**
  * @brief 卸载指定路径和大小的字体资源。
  * @param file_path 字体文件路径。
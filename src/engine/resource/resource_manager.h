@@ -1,10 +1,17 @@
 #pragma once
+#include <chrono>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <glm/glm.hpp>
+#include <array>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include "resource_id.h"
+#include "resource_handle.h"
+#include "texture_atlas.h"
+#include "../utils/id_map.h"
 
 // Forward declarations of SDL and SDL-related types in global namespace
 struct SDL_Renderer;
@@ -12,10 +19,39 @@ struct SDL_Texture;
 struct MIX_Audio;
 struct TTF_Font;
 
+namespace engine::core {
+	class TaskPool;
+}
+
 namespace engine::resource {
 	class TextureManager;
 	class FontManager;
 	class AudioManager;
+	class GlyphAtlas;
+
+	/**
+	 * @struct FontPreload
+	 * @brief 需要提前打开的一个字体及其字号（来自 ui_config.json 的 "font_preload"）
+	 */
+	struct FontPreload {
+		std::string path_;                      ///< 字体文件路径
+		std::vector<int> sizes_;                ///< 需要的字号
+		std::string glyphs_;                    ///< 打开后为每个字号预先光栅化的字符（UTF-8）
+		bool scalable_{ false };                ///< 同时预热可缩放图集（动画或大字号文本使用）
+	};
+
+	/**
+	 * @struct PreloadManifest
+	 * @brief 一组需要提前在后台加载的资源（如某一关卡会用到的精灵表与音效）
+	 */
+	struct PreloadManifest {
+		std::vector<std::string> textures_;     ///< 纹理文件路径
+		std::vector<ResourceId> sounds_;        ///< 音效 ID（映射表逻辑名或路径的哈希）
+		std::vector<ResourceId> music_;         ///< 音乐 ID
+		std::vector<FontPreload> fonts_;        ///< 字体与字号
+
+		[[nodiscard]] bool empty() const { return textures_.empty() && sounds_.empty() && music_.empty() && fonts_.empty(); }
+	};
 
 	/**
 	 * @class ResourceManager
@@ -28,12 +64,38 @@ namespace engine::resource {
 		std::unique_ptr<TextureManager> texture_manager_; ///< 负责纹理加载与缓存的内部管理器
 		std::unique_ptr<FontManager> font_manager_;       ///< 负责字体加载与缓存的内部管理器
 		std::unique_ptr<AudioManager> audio_manager_;     ///< 负责音效和音乐加载与缓存的内部管理器
-		std::unordered_map<ResourceId, std::string> texture_mapping_;
-		std::unordered_map<ResourceId, std::string> sound_mapping_;
-		std::unordered_map<ResourceId, std::string> music_mapping_;
-		std::unordered_map<ResourceId, std::string> font_mapping_;
+		engine::utils::IdMap<std::string> texture_mapping_;
+		engine::utils::IdMap<std::string> sound_mapping_;
+		engine::utils::IdMap<std::string> music_mapping_;
+		engine::utils::IdMap<std::string> font_mapping_;
+		TextureAtlasConfig atlas_config_;   ///< 映射文件 "texture_atlas" 段，预加载时据此打包小纹理
+
+		/// @brief 展开 atlas_config_ 的来源（目录只展开一层 .png，排序保证每次打包结果一致）
+		std::vector<std::string> collectAtlasFiles() const;
+		/// @brief 图集打包完成后把映射表中指向已打包图片的逻辑名登记为别名
+		void registerAtlasAliases();
+
+		/// @brief 被句柄引用的资源：引用计数与代数（归零卸载后代数加一，旧句柄失效）
+		struct HandleEntry {
+			std::uint32_t refs_{ 0 };
+			std::uint32_t generation_{ 1 };
+			ResourceId resource_id_{ InvalidResourceId };   ///< 字体句柄的键组合了字号，这里记下字体 ID
+			int point_size_{ 0 };                           ///< 仅字体使用
+		};
+		std::array<engine::utils::IdMap<HandleEntry>, static_cast<std::size_t>(ResourceKind::COUNT)> handles_;
+		std::vector<std::pair<ResourceKind, ResourceId>> unreferenced_;    ///< 引用归零、等待 update() 卸载的资源键
+
+		template <ResourceKind Kind>
+		ResourceHandle<Kind> retain(ResourceId key, ResourceId resource_id, int point_size);
+		template <ResourceKind Kind>
+		void releaseHandle(ResourceHandle<Kind> handle);
+		template <ResourceKind Kind>
+		[[nodiscard]] bool isHandleAlive(ResourceHandle<Kind> handle) const;
+
+		/// @brief 卸载引用仍为零的资源（纹理尚在解码、音效仍有声部在播放时留到之后），返回卸载数量
+		std::size_t unloadUnreferenced();
 
-		std::string_view resolvePath(const std::unordered_map<ResourceId, std::string>& mapping,
+		std::string_view resolvePath(const engine::utils::IdMap<std::string>& mapping,
 			ResourceId id,
 			std::string_view fallback) const;
 	public:
@@ -41,8 +103,9 @@ namespace engine::resource {
 		/**
 		 * @brief 构造函数，初始化各个子资源管理器。
 		 * @param renderer SDL_Renderer 指针，用于创建纹理。
+		 * @param task_pool 图片与音频解码使用的任务线程池，须比资源管理器存活更久。
 		 */
-		explicit ResourceManager(SDL_Renderer* renderer);
+		ResourceManager(SDL_Renderer* renderer, engine::core::TaskPool& task_pool);
 
 		/**
 		 * @brief 析构函数，确保所有持有的资源管理器被正确销毁。
@@ -64,9 +127,89 @@ namespace engine::resource {
 
 		/**
 		 * @brief 预加载当前映射表中已解析的纹理、音效和音乐资源。
-		 * @return 预加载完成返回 true。
+		 *
+		 * 配置了 "texture_atlas" 时先把其中的小纹理打包进图集页（须在主线程调用），
+		 * 映射表中指向已打包图片的逻辑名同样解析到图集区域。其余资源只提交后台解码，
+		 * 不等待完成，由 update() 逐帧收尾。
+		 * @param defer_atlas 为 true 时图集图片也只提交后台解码，由 update() 在全部解码完成后打包上传，
+		 *        启动不等待图集（首帧只需要标题界面的少量资源）；期间 isMappedPreloadComplete() 为 false。
+		 * @return 预加载启动成功返回 true。
 		 */
-		bool preloadMappedResources();
+		bool preloadMappedResources(bool defer_atlas = false);
+
+		/// @brief 延迟的图集是否已打包完成（未延迟或未配置图集时总为 true）
+		[[nodiscard]] bool isMappedPreloadComplete() const;
+
+		/// @brief 延迟图集的解码进度 [0, 1]
+		[[nodiscard]] float getMappedPreloadProgress() const;
+
+		/**
+		 * @brief 提交一组资源的后台加载（图片/音频解码与字体打开在工作线程进行）。
+		 * @param manifest 需要预加载的资源清单；字体打开后由 update() 收入缓存并预先光栅化字符。
+		 */
+		void requestPreload(const PreloadManifest& manifest);
+
+		/**
+		 * @brief 以句柄获取清单中纹理与音效的引用（同时提交后台加载），句柄记入 scope。
+		 * @details 音乐是流式的且随时可能被别的场景继续播放，不计引用。
+		 */
+		void acquireManifest(const PreloadManifest& manifest, ResourceScope& scope);
+
+		// --- 句柄与引用计数 ---
+		/**
+		 * @brief 获取纹理引用并提交后台加载；引用期间纹理被固定，不因显存预算被淘汰。
+		 * @return 纹理无法加载（没有路径、曾加载失败）时返回空句柄。
+		 */
+		TextureHandle acquireTexture(ResourceId id, std::string_view file_path = {});
+		/// @brief 获取音效引用并提交后台加载
+		SoundHandle acquireSound(ResourceId id, std::string_view file_path = {});
+		/// @brief 获取字体（字体 ID + 字号）引用，字体同步加载
+		FontHandle acquireFont(ResourceId id, std::string_view file_path, int point_size);
+
+		/**
+		 * @brief 释放引用；归零的资源在之后的 update() 中卸载，期间重新获取则保留。
+		 * @details 空句柄与已失效（代数不符）的句柄被忽略。图集中的纹理与图集页共享，只取消引用、不卸载。
+		 */
+		void release(TextureHandle handle);
+		void release(SoundHandle handle);
+		void release(FontHandle handle);
+
+		/// @brief 句柄所指的资源是否仍是发出句柄时的那一份（未被卸载）
+		[[nodiscard]] bool isAlive(TextureHandle handle) const;
+		[[nodiscard]] bool isAlive(SoundHandle handle) const;
+		[[nodiscard]] bool isAlive(FontHandle handle) const;
+
+		/**
+		 * @brief 每帧在渲染线程调用：收入已加载的音频，卸载引用归零的资源，推进纹理驻留的帧计数并在超出显存预算时淘汰。
+		 *
+		 * 已解码纹理的上传由解码任务投递到 TaskPool 的主线程队列，随 GameApp 每帧的 drainMainThread() 在预算内执行。
+		 * 同时把纹理缓存未命中的同步加载累计数与纹理显存估算发布为分析器计数器 res.tex_sync_loads、res.tex_resident_kb，
+		 * 被句柄引用的资源数发布为 res.handles。
+		 */
+		void update();
+
+		/// @brief 尚未完成的后台加载数量（纹理 + 音频 + 字体组）
+		[[nodiscard]] std::size_t getPendingCount() const;
+
+		/// @brief 常驻内存中的音频字节数（预解码音效 PCM + 流式音乐的压缩数据）
+		[[nodiscard]] std::size_t getAudioResidentBytes() const;
+
+		/// @brief 音频设备缓冲带来的输出延迟（毫秒，缓冲帧数 / 采样率），查询不到时为 0
+		[[nodiscard]] float getAudioOutputLatencyMs() const;
+
+		/// @brief 设置预解码音效缓存的内存预算（字节），超出后按 LRU 淘汰未在播放的音效
+		void setSoundCacheBudget(std::size_t bytes);
+
+		/// @brief 设置独立纹理的显存预算（字节，0 不限），超出后按 LRU 淘汰未固定、上一帧未绘制的纹理
+		void setTextureVramBudget(std::size_t bytes);
+
+		/// @brief 独立纹理（不含图集页）的显存估算
+		[[nodiscard]] std::size_t getTextureResidentBytes() const;
+
+		/**
+		 * @brief 开启后，渲染时遇到未加载的纹理不再同步读盘，而是后台加载并暂时绘制占位纹理。
+		 */
+		void setTextureStreaming(bool enabled);
 
 		// --- 统一资源访问接口 ---
 	// -- Texture --
@@ -105,11 +248,47 @@ namespace engine::resource {
 		glm::vec2 getTextureSize(const std::string& file_path);
 		glm::vec2 getTextureSize(entt::hashed_string str_hs);
 
+		/**
+		 * @brief 解析纹理的实际绘制位置：已打包进图集时返回图集页及子区域，否则返回独立纹理。
+		 * 渲染器据此偏移源矩形，调用方无需关心纹理是否被打包。
+		 * @param file_path 纹理文件的相对路径，为空时使用映射配置中的路径。
+		 * @param allow_placeholder 流式模式下纹理未就绪时是否返回占位纹理（为 false 时同步加载，
+		 *        用于烘焙到渲染目标等不能接受占位结果的场合）。
+		 * @param mip_level 期望的图集缩小级（相机拉远时由渲染器按缩放倍数选择），独立纹理忽略此参数。
+		 * @return 纹理无效时 texture_ 为 nullptr。
+		 */
+		TextureRegion getTextureRegion(ResourceId id, std::string_view file_path = {}, bool allow_placeholder = true,
+		                               int mip_level = 0);
+
+		/**
+		 * @brief 提交纹理的后台解码，不阻塞。
+		 * @return 已可用或已在加载中返回 true。
+		 */
+		bool requestTexture(ResourceId id, std::string_view file_path = {});
+
+		/**
+		 * @brief 创建可作为渲染目标的纹理（如烘焙后的瓦片区块），与普通纹理共用缓存。
+		 * @param id 纹理资源ID，已存在时会被替换。
+		 * @param size 纹理尺寸（像素）。
+		 * @return 创建成功返回 SDL_Texture 指针，失败返回 nullptr。
+		 */
+		SDL_Texture* createRenderTarget(ResourceId id, glm::ivec2 size);
+
 		/**
 		 * @brief 清空所有已加载的纹理资源。
 		 */
 		void clearTextures();
 
+		/**
+		 * @brief 纹理缓存的逐张显存估算（按字节数降序），供调试面板显示。
+		 */
+		[[nodiscard]] std::vector<TextureMemoryInfo> getTextureMemoryUsage() const;
+
+		/**
+		 * @brief 纹理缓存的累计查询与未命中统计（会话遥测据此计算命中率）。
+		 */
+		[[nodiscard]] TextureCacheStats getTextureCacheStats() const;
+
 		// -- Sound Effects (Chunks) --
 		/**
 		 * @brief 载入音效（Sound Effect）资源。
@@ -121,12 +300,19 @@ namespace engine::resource {
 		MIX_Audio* loadSound(entt::hashed_string str_hs);
 
 		/**
-		 * @brief 播放音效。
+		 * @brief 播放音效（经声部池的同帧去重、并发限制与优先级抢占，见 AudioManager）。
 		 * @param file_path 音频文件相对路径。
+		 * @param gain 相对增益（0.0f-1.0f），用于空间衰减等逐次播放的音量。
 		 */
-		void playSound(ResourceId id, std::string_view file_path = {});
+		void playSound(ResourceId id, std::string_view file_path = {}, float gain = 1.0f);
 		void playSound(const std::string& file_path);
 		void playSound(entt::hashed_string str_hs);
+
+		/**
+		 * @brief 播放空间化音效，距离衰减与剔除在音频线程上计算。
+		 * @param max_distance 最大有效距离，<= 0 时等同 playSound。
+		 */
+		void playSoundSpatial(ResourceId id, std::string_view file_path, const glm::vec2& emitter, const glm::vec2& listener, float max_distance);
 		void stopSound();
 
 		/**
@@ -138,6 +324,13 @@ namespace engine::resource {
 		MIX_Audio* getSound(const std::string& file_path);
 		MIX_Audio* getSound(entt::hashed_string str_hs);
 
+		/**
+		 * @brief 提交音效/音乐的后台加载，不阻塞。
+		 * @return 已可用或已在加载中返回 true。
+		 */
+		bool requestSound(ResourceId id, std::string_view file_path = {});
+		bool requestMusic(ResourceId id, std::string_view file_path = {});
+
 		/**
 		 * @brief 卸载指定的音效资源。
 		 * @param file_path 音频文件路径。
@@ -226,6 +419,21 @@ namespace engine::resource {
 		TTF_Font* getFont(const std::string& file_path, int point_size);
 		TTF_Font* getFont(entt::hashed_string str_hs, int point_size);
 
+		/**
+		 * @brief 获取字体（字体ID + 字号）对应的持久字形图集。
+		 * @param file_path 字体文件路径，为空时使用映射配置中的路径。
+		 * @param point_size 字体的大小（号）。
+		 * @return GlyphAtlas 指针，失败时返回 nullptr。
+		 */
+		GlyphAtlas* getGlyphAtlas(ResourceId id, std::string_view file_path, int point_size);
+
+		/**
+		 * @brief 获取字体的可缩放字形图集：以固定字号光栅化一次，按任意字号缩放绘制。
+		 * @param file_path 字体文件路径，为空时使用映射配置中的路径。
+		 * @return GlyphAtlas 指针，失败时返回 nullptr。
+		 */
+		GlyphAtlas* getScalableGlyphAtlas(ResourceId id, std::string_view file_path);
+
 		/**
 		 * @brief 卸载指定路径和大小的字体资源。
 		 * @param file_path 字体文件路径。
@@ -0,0 +1,118 @@
+#pragma once
+/**
+ * @file texture_atlas.h
+ * @brief 纹理图集的配置与查询结果类型（打包逻辑见 TextureManager::buildAtlas），以及纹理显存统计条目。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/vec2.hpp>
+#include "resource_id.h"
+
+struct SDL_Texture;
+
+namespace engine::resource {
+
+	/**
+	 * @struct TextureAtlasConfig
+	 * @brief 资源映射文件中 "texture_atlas" 段的内容
+	 *
+	 * @details
+	 * sources 中的每一项可以是单个图片文件或目录（目录只扫描一层 .png）。
+	 * 宽或高超过 max_entry_size_ 的图片（大型精灵表、瓦片集）不参与打包，仍按独立纹理加载。
+	 * mip_levels_ > 0 时每页额外生成逐级减半的缩小页（2×2 按透明度加权平均），相机拉远时渲染器按缩放倍数
+	 * 选用其中一级；为使每级的子区域仍落在整数像素上，图片的位置与占位尺寸按 2^mip_levels_ 对齐。
+	 */
+	/**
+	 * @brief 图集页的像素格式
+	 *
+	 * @details 16 位格式只适合纯 UI 的图集：RGBA4444 的透明度只有 16 级，RGB565 没有透明通道。
+	 *          渲染器不支持所选格式时回退为 RGBA8888 并打印警告。
+	 */
+	enum class AtlasPixelFormat {
+		RGBA8888,   ///< 每像素 4 字节（默认）
+		RGBA4444,   ///< 每像素 2 字节，4 位透明度
+		RGB565,     ///< 每像素 2 字节，不透明
+	};
+
+	/// @brief 解析映射文件中的格式名（"rgba8888" / "rgba4444" / "rgb565"），未知名称返回 RGBA8888
+	[[nodiscard]] inline AtlasPixelFormat parseAtlasPixelFormat(std::string_view name) {
+		if (name == "rgba4444") {
+			return AtlasPixelFormat::RGBA4444;
+		}
+		if (name == "rgb565") {
+			return AtlasPixelFormat::RGB565;
+		}
+		return AtlasPixelFormat::RGBA8888;
+	}
+
+	inline constexpr int MAX_ATLAS_MIP_LEVELS = 4;
+
+	struct TextureAtlasConfig {
+		std::vector<std::string> sources_;  ///< 参与打包的文件或目录
+		int page_size_{2048};               ///< 图集页边长（像素），受渲染器最大纹理尺寸限制
+		int max_entry_size_{512};           ///< 单张图片允许的最大边长
+		int padding_{2};                    ///< 图片之间的留白，避免缩放采样到相邻图片
+		AtlasPixelFormat pixel_format_{AtlasPixelFormat::RGBA8888}; ///< 图集页的像素格式
+		int mip_levels_{2};                 ///< 额外生成的缩小级数（0 为不生成，上限 MAX_ATLAS_MIP_LEVELS）
+
+		[[nodiscard]] bool enabled() const { return !sources_.empty(); }
+	};
+
+	/**
+	 * @struct TextureRegion
+	 * @brief 纹理 ID 解析后的实际绘制位置：独立纹理时 offset 为 0、size 为整张纹理；
+	 *        已打包时 texture 为图集页，offset/size 为其中的子区域。
+	 *
+	 * @details 按缩小级解析时 texture 为该级的缩小页，offset/size 为缩小页中的像素，scale_ 为 2^-级别；
+	 *          调用方的源矩形（原图像素）需乘以 scale_ 再加上 offset_。
+	 */
+	struct TextureRegion {
+		SDL_Texture* texture_{nullptr};
+		glm::vec2 offset_{0.0f};
+		glm::vec2 size_{0.0f};
+		float scale_{1.0f};         ///< 原图像素 → texture_ 像素
+		std::uint16_t page_{0};     ///< 所在图集页（查询缩小页用）
+		std::uint8_t mip_levels_{0};///< 该页可用的缩小级数，独立纹理为 0
+		bool placeholder_{false};   ///< 纹理仍在后台加载，texture_ 为占位纹理（调用方应使用其整张区域）
+	};
+
+	/**
+	 * @struct TextureMemoryInfo
+	 * @brief 纹理缓存中一张 GPU 纹理的显存估算（宽 × 高 × 每像素字节，不含驱动的对齐与 mipmap）
+	 *
+	 * @details 图集的缩小页作为独立条目（ATLAS_MIP）列出。
+	 */
+	struct TextureMemoryInfo {
+		enum class Kind {
+			TEXTURE,        ///< 独立加载的纹理
+			ATLAS_PAGE,     ///< 图集页
+			ATLAS_MIP,      ///< 图集页的缩小页
+			RENDER_TARGET,  ///< 渲染目标（如烘焙的瓦片区块）
+		};
+
+		ResourceId id_{InvalidResourceId};  ///< 图集页为 InvalidResourceId
+		Kind kind_{Kind::TEXTURE};
+		glm::ivec2 size_{0, 0};
+		std::string_view format_name_;      ///< SDL 像素格式名（静态字符串）
+		std::size_t bytes_{0};
+	};
+
+	/**
+	 * @struct TextureCacheStats
+	 * @brief 纹理缓存查询统计（只增不减），命中率 = 1 - (sync_loads_ + async_misses_) / lookups_
+	 */
+	struct TextureCacheStats {
+		std::uint64_t lookups_{0};          ///< getTexture / getTextureRegion 的查询次数
+		std::uint64_t sync_loads_{0};       ///< 未命中导致的同步加载（含等待后台解码）
+		std::uint64_t async_misses_{0};     ///< 流式模式下未命中、以占位纹理代替的查询
+
+		[[nodiscard]] double hitRate() const {
+			return lookups_ > 0 ? 1.0 - static_cast<double>(sync_loads_ + async_misses_) / static_cast<double>(lookups_) : 1.0;
+		}
+	};
+
+} // namespace engine::resource
@@ -2,13 +2,93 @@
 #include <SDL3_image/SDL_image.h>
 #include <SDL3/SDL_render.h>
 #include <spdlog/spdlog.h>  
+#include "../core/task_pool.h"
+#include "../io/virtual_fs.h"
+#include "../utils/profiler.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+SDL_PixelFormat toSDLPixelFormat(engine::resource::AtlasPixelFormat format) {
+    switch (format) {
+        case engine::resource::AtlasPixelFormat::RGBA4444: return SDL_PIXELFORMAT_ARGB4444;
+        case engine::resource::AtlasPixelFormat::RGB565:   return SDL_PIXELFORMAT_RGB565;
+        default:                                           return SDL_PIXELFORMAT_RGBA32;
+    }
+}
+
+/// 渲染器能否直接以该格式创建纹理（否则 SDL_CreateTextureFromSurface 会换成 32 位格式）
+bool rendererSupportsFormat(SDL_Renderer* renderer, SDL_PixelFormat format) {
+    const auto* formats = static_cast<const SDL_PixelFormat*>(SDL_GetPointerProperty(
+        SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER, nullptr));
+    for (; formats && *formats != SDL_PIXELFORMAT_UNKNOWN; ++formats) {
+        if (*formats == format) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 把 RGBA32 表面缩小一半：每个 2×2 块取透明度加权的颜色平均，透明度取算术平均。
+ * @details 按透明度加权可避免透明像素（通常为黑色）把轮廓边缘染暗。
+ */
+SDL_Surface* downsampleRGBA32(const SDL_Surface* source) {
+    const int width = std::max(source->w / 2, 1);
+    const int height = std::max(source->h / 2, 1);
+    SDL_Surface* target = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGBA32);
+    if (!target) {
+        return nullptr;
+    }
+    for (int y = 0; y < height; ++y) {
+        const auto* row0 = static_cast<const std::uint8_t*>(source->pixels) + static_cast<std::size_t>(y * 2) * source->pitch;
+        const auto* row1 = static_cast<const std::uint8_t*>(source->pixels) +
+                           static_cast<std::size_t>(std::min(y * 2 + 1, source->h - 1)) * source->pitch;
+        auto* out = static_cast<std::uint8_t*>(target->pixels) + static_cast<std::size_t>(y) * target->pitch;
+        for (int x = 0; x < width; ++x) {
+            const int x0 = x * 2 * 4;
+            const int x1 = std::min(x * 2 + 1, source->w - 1) * 4;
+            const std::uint8_t* texels[4] = { row0 + x0, row0 + x1, row1 + x0, row1 + x1 };
+            std::uint32_t alpha = 0;
+            std::uint32_t rgb[3] = { 0, 0, 0 };
+            for (const auto* texel : texels) {
+                alpha += texel[3];
+                for (int c = 0; c < 3; ++c) {
+                    rgb[c] += static_cast<std::uint32_t>(texel[c]) * texel[3];
+                }
+            }
+            for (int c = 0; c < 3; ++c) {
+                out[x * 4 + c] = alpha > 0 ? static_cast<std::uint8_t>(rgb[c] / alpha) : 0;
+            }
+            out[x * 4 + 3] = static_cast<std::uint8_t>((alpha + 2) / 4);
+        }
+    }
+    return target;
+}
+
+engine::resource::TextureMemoryInfo describeTexture(SDL_Texture* texture) {
+    using Kind = engine::resource::TextureMemoryInfo::Kind;
+    engine::resource::TextureMemoryInfo info;
+    info.size_ = { texture->w, texture->h };
+    info.format_name_ = SDL_GetPixelFormatName(texture->format);
+    info.bytes_ = static_cast<std::size_t>(texture->w) * static_cast<std::size_t>(texture->h) *
+                  static_cast<std::size_t>(SDL_BYTESPERPIXEL(texture->format));
+    const auto access = SDL_GetNumberProperty(SDL_GetTextureProperties(texture), SDL_PROP_TEXTURE_ACCESS_NUMBER,
+                                              SDL_TEXTUREACCESS_STATIC);
+    info.kind_ = access == SDL_TEXTUREACCESS_TARGET ? Kind::RENDER_TARGET : Kind::TEXTURE;
+    return info;
+}
+
+} // namespace
 
 /**
  * @brief 构造函数，初始化纹理管理器。
  * @param renderer 指向有效的 SDL_Renderer 上下文的指针。不能为空。
+ * @param tasks 解码使用的任务线程池。
  * @throws std::runtime_error 如果 renderer 为 nullptr。
  */
-engine::resource::TextureManager::TextureManager(SDL_Renderer* renderer):renderer_(renderer){
+engine::resource::TextureManager::TextureManager(SDL_Renderer* renderer, engine::core::TaskPool& tasks):renderer_(renderer), tasks_(tasks){
 	if (!renderer) {
 		throw std::runtime_error("TextureManager initialization failed: renderer is nullptr");
 	}
@@ -29,13 +109,18 @@ SDL_Texture* engine::resource::TextureManager::loadTexture(ResourceId id, std::s
     if (it != textures_.end()) {
         return it->second.get();
     }
+    // 已在后台解码：等它完成，避免重复解码同一文件
+    if (SDL_Texture* pending = finishPending(id)) {
+        return pending;
+    }
 
     if (file_path.empty()) {
         spdlog::error("加载纹理失败：未提供文件路径 (id={})", id);
         return nullptr;
     }
 
-    SDL_Texture* raw_texture = IMG_LoadTexture(renderer_, std::string(file_path).c_str());
+    ENGINE_PROFILE_SCOPE("TextureManager::loadTexture");
+    SDL_Texture* raw_texture = IMG_LoadTexture_IO(renderer_, engine::io::VirtualFS::instance().openIO(file_path), true);
 
     if (!raw_texture) {
         spdlog::error("加载纹理失败: '{}' (id={}): {}", file_path, id, SDL_GetError());
@@ -47,8 +132,7 @@ SDL_Texture* engine::resource::TextureManager::loadTexture(ResourceId id, std::s
         }
     }
 
-    // 使用带有自定义删除器的 unique_ptr 存储加载的纹理
-    textures_.emplace(id, std::unique_ptr<SDL_Texture, SDLTextureDeleter>(raw_texture));
+    storeTexture(id, file_path, raw_texture, false);
     spdlog::debug("成功加载并缓存纹理: {} (id={})", file_path, id);
 
     return raw_texture;
@@ -63,15 +147,26 @@ SDL_Texture* engine::resource::TextureManager::getTexture(ResourceId id, std::st
     if (id == InvalidResourceId) {
         return nullptr;
     }
-    auto it = textures_.find(id);
-    if (it != textures_.end()) {
-        return it->second.get();
+    ++cache_stats_.lookups_;
+    if (SDL_Texture* texture = touch(id)) {
+        return texture;
+    }
+    if (SDL_Texture* pending = finishPending(id)) {
+        ++cache_stats_.sync_loads_;
+        return pending;
     }
     if (file_path.empty()) {
+        // 被淘汰的纹理按记下的路径重新加载
+        if (auto evicted = evicted_.find(id); evicted != evicted_.end()) {
+            const std::string path = evicted->second;
+            ++cache_stats_.sync_loads_;
+            return loadTexture(id, path);
+        }
         spdlog::warn("纹理未缓存且未提供路径 (id={})", id);
         return nullptr;
     }
 	spdlog::debug("纹理未缓存，尝试加载: {} (id={})", file_path, id);
+    ++cache_stats_.sync_loads_;
     return loadTexture(id, file_path);
 }
 
@@ -80,9 +175,13 @@ SDL_Texture* engine::resource::TextureManager::getTexture(ResourceId id, std::st
  * @param file_path 要卸载的纹理文件的路径。
  */
 void engine::resource::TextureManager::unloadTexture(ResourceId id) {
-    auto it = textures_.find(id);
-    if (it != textures_.end()) {
-        textures_.erase(it);
+    if (atlas_regions_.erase(id) > 0) {
+        // 图集页由其余区域共享，只移除区域登记
+        spdlog::debug("已移除图集纹理区域: id={}", id);
+        return;
+    }
+    evicted_.erase(id);
+    if (dropTexture(id)) {
         spdlog::debug("已卸载纹理: id={}", id);
     } else {
         spdlog::warn("尝试卸载未加载的纹理: id={}", id);
@@ -95,7 +194,10 @@ void engine::resource::TextureManager::unloadTexture(ResourceId id) {
  * @return glm::vec2 包含该纹理宽度 (x) 和高度 (y) 的向量。若纹理无效则返回 {0, 0}。
  */
 glm::vec2 engine::resource::TextureManager::getTextureSize(ResourceId id, std::string_view file_path) {
-        SDL_Texture* texture = getTexture(id, file_path);
+    if (const auto* region = findAtlasRegion(id)) {
+        return region->size_;
+    }
+    SDL_Texture* texture = getTexture(id, file_path);
     if (!texture) {
 		spdlog::error("无法获取纹理: id={}", id);
         return glm::vec2(0);
@@ -126,14 +228,611 @@ glm::vec2 engine::resource::TextureManager::getTextureSize(const std::string& fi
     return getTextureSize(toResourceId(file_path), file_path);
 }
 
+/**
+ * @brief 创建渲染目标纹理（如瓦片区块烘焙），由纹理缓存统一管理生命周期。
+ * @param id 纹理资源ID，已存在时会被替换。
+ * @param size 纹理尺寸（像素）。
+ * @return SDL_Texture* 新纹理指针，失败返回 nullptr。
+ */
+SDL_Texture* engine::resource::TextureManager::createRenderTarget(ResourceId id, glm::ivec2 size) {
+    if (id == InvalidResourceId || size.x <= 0 || size.y <= 0) {
+        spdlog::error("创建渲染目标纹理失败：参数无效 (id={}, size={}x{})", id, size.x, size.y);
+        return nullptr;
+    }
+
+    SDL_Texture* raw_texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size.x, size.y);
+    if (!raw_texture) {
+        spdlog::error("创建渲染目标纹理失败 (id={}): {}", id, SDL_GetError());
+        return nullptr;
+    }
+    if (!SDL_SetTextureScaleMode(raw_texture, SDL_SCALEMODE_NEAREST)) {
+        spdlog::warn("无法设置渲染目标纹理缩放模式为最邻近插值");
+    }
+    if (!SDL_SetTextureBlendMode(raw_texture, SDL_BLENDMODE_BLEND)) {
+        spdlog::warn("无法设置渲染目标纹理混合模式: {}", SDL_GetError());
+    }
+
+    storeTexture(id, {}, raw_texture, true);
+    spdlog::debug("已创建渲染目标纹理: id={} ({}x{})", id, size.x, size.y);
+    return raw_texture;
+}
+
+/**
+ * @brief 同步打包小图片到图集页：提交解码后立即等待并打包。
+ * @param file_paths 图片路径列表。
+ * @param config 图集参数。
+ * @return 成功打包的图片数量。
+ */
+std::size_t engine::resource::TextureManager::buildAtlas(const std::vector<std::string>& file_paths, const TextureAtlasConfig& config) {
+    ENGINE_PROFILE_SCOPE("TextureManager::buildAtlas");
+    // 主线程在等待结果，解码优先于流式解码
+    beginAtlasBuild(file_paths, config, engine::core::TaskPriority::FRAME);
+    return finishAtlasBuild();
+}
+
+/**
+ * @brief 提交图集图片的后台解码，不等待；之后由 updateAtlasBuild() 在全部解码完成时打包上传。
+ */
+void engine::resource::TextureManager::beginAtlasBuild(const std::vector<std::string>& file_paths, const TextureAtlasConfig& config,
+                                                       engine::core::TaskPriority priority) {
+    cancelAtlasBuild();
+    PendingAtlas pending;
+    pending.config_ = config;
+    std::unordered_set<ResourceId> seen;
+    for (const auto& path : file_paths) {
+        if (!seen.insert(toResourceId(path)).second) {
+            continue;
+        }
+        pending.paths_.push_back(path);
+        pending.decodes_.push_back(tasks_.submit(priority,
+            [file = path]() { return IMG_Load_IO(engine::io::VirtualFS::instance().openIO(file), true); }));
+    }
+    pending_atlas_ = std::move(pending);
+}
+
+bool engine::resource::TextureManager::updateAtlasBuild() {
+    if (!pending_atlas_) {
+        return false;
+    }
+    for (const auto& decode : pending_atlas_->decodes_) {
+        if (decode.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+    }
+    finishAtlasBuild();
+    return true;
+}
+
+float engine::resource::TextureManager::getAtlasBuildProgress() const {
+    if (!pending_atlas_ || pending_atlas_->decodes_.empty()) {
+        return 1.0f;
+    }
+    std::size_t ready = 0;
+    for (const auto& decode : pending_atlas_->decodes_) {
+        ready += decode.wait_for(std::chrono::seconds(0)) == std::future_status::ready ? 1 : 0;
+    }
+    return static_cast<float>(ready) / static_cast<float>(pending_atlas_->decodes_.size());
+}
+
+void engine::resource::TextureManager::cancelAtlasBuild() {
+    if (!pending_atlas_) {
+        return;
+    }
+    // 解码任务只捕获路径，但结果表面需要释放
+    for (auto& decode : pending_atlas_->decodes_) {
+        if (SDL_Surface* surface = decode.get()) {
+            SDL_DestroySurface(surface);
+        }
+    }
+    pending_atlas_.reset();
+}
+
+/**
+ * @brief 等待挂起的解码并打包：先在 CPU 侧把所有图片拷贝进页面 Surface，最后每页只上传一次。
+ * @return 成功打包的图片数量；没有挂起的构建时返回 0。
+ */
+std::size_t engine::resource::TextureManager::finishAtlasBuild() {
+    if (!pending_atlas_) {
+        return 0;
+    }
+    ENGINE_PROFILE_SCOPE("TextureManager::finishAtlasBuild");
+    PendingAtlas pending = std::move(*pending_atlas_);
+    pending_atlas_.reset();
+    const auto& config = pending.config_;
+    const auto& unique_paths = pending.paths_;
+    auto& decodes = pending.decodes_;
+    clearAtlas();
+
+    int page_size = config.page_size_;
+    const auto max_texture_size = SDL_GetNumberProperty(SDL_GetRendererProperties(renderer_),
+                                                        SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 0);
+    if (max_texture_size > 0) {
+        page_size = std::min(page_size, static_cast<int>(max_texture_size));
+    }
+    const int padding = std::max(config.padding_, 0);
+    const int max_entry_size = std::min(config.max_entry_size_, page_size - padding);
+    // 缩小级数受页边长限制；位置与占位尺寸按 2^级数 对齐，每级缩小页中的子区域都是整数像素，且图片不共用同一个缩小像素
+    int mip_levels = std::clamp(config.mip_levels_, 0, MAX_ATLAS_MIP_LEVELS);
+    while (mip_levels > 0 && (page_size >> mip_levels) < 1) {
+        --mip_levels;
+    }
+    const int align = 1 << mip_levels;
+    const auto alignUp = [align](int value) { return (value + align - 1) / align * align; };
+    if (page_size <= 0 || max_entry_size <= 0) {
+        spdlog::error("图集参数无效 (page_size={}, max_entry_size={})", page_size, max_entry_size);
+        pending_atlas_ = std::move(pending);
+        cancelAtlasBuild();
+        return 0;
+    }
+
+    // 解码已在 beginAtlasBuild() 中全部并行提交到工作线程，主线程只负责拷贝与上传
+    struct Entry {
+        ResourceId id_;
+        SDL_Surface* surface_;
+    };
+    std::vector<Entry> entries;
+    entries.reserve(unique_paths.size());
+    for (std::size_t i = 0; i < unique_paths.size(); ++i) {
+        const std::string_view path = unique_paths[i];
+        const ResourceId id = toResourceId(path);
+        SDL_Surface* loaded = decodes[i].get();
+        if (!loaded) {
+            spdlog::warn("图集跳过无法加载的图片: '{}': {}", path, SDL_GetError());
+            continue;
+        }
+        if (loaded->w > max_entry_size || loaded->h > max_entry_size) {
+            spdlog::debug("图集跳过过大的图片: '{}' ({}x{})", path, loaded->w, loaded->h);
+            SDL_DestroySurface(loaded);
+            continue;
+        }
+        SDL_Surface* converted = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(loaded);
+        if (!converted) {
+            spdlog::warn("图集转换像素格式失败: '{}': {}", path, SDL_GetError());
+            continue;
+        }
+        // 原样拷贝像素（含透明度），不做混合
+        SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE);
+        entries.push_back(Entry{ id, converted });
+    }
+
+    // 按高度降序排布，行内高度接近，浪费最少
+    std::ranges::sort(entries, [](const Entry& a, const Entry& b) {
+        return a.surface_->h != b.surface_->h ? a.surface_->h > b.surface_->h : a.surface_->w > b.surface_->w;
+    });
+
+    struct Placement {
+        std::size_t page_;
+        SDL_Rect rect_;
+    };
+    std::vector<Placement> placements;
+    placements.reserve(entries.size());
+    std::vector<SDL_Surface*> page_surfaces;
+    int cursor_x = 0;
+    int cursor_y = 0;
+    int shelf_height = 0;
+    for (const auto& entry : entries) {
+        const int padded_w = alignUp(entry.surface_->w + padding);
+        const int padded_h = alignUp(entry.surface_->h + padding);
+        if (cursor_x + padded_w > page_size) {
+            cursor_y += shelf_height;
+            cursor_x = 0;
+            shelf_height = 0;
+        }
+        if (page_surfaces.empty() || cursor_y + padded_h > page_size) {
+            SDL_Surface* page = SDL_CreateSurface(page_size, page_size, SDL_PIXELFORMAT_RGBA32);
+            if (!page) {
+                spdlog::error("创建图集页失败：{}", SDL_GetError());
+                break;
+            }
+            SDL_FillSurfaceRect(page, nullptr, 0);
+            page_surfaces.push_back(page);
+            cursor_x = 0;
+            cursor_y = 0;
+            shelf_height = 0;
+        }
+        SDL_Rect rect{ cursor_x, cursor_y, entry.surface_->w, entry.surface_->h };
+        if (!SDL_BlitSurface(entry.surface_, nullptr, page_surfaces.back(), &rect)) {
+            spdlog::warn("写入图集页失败 (id={}): {}", entry.id_, SDL_GetError());
+            placements.push_back(Placement{ page_surfaces.size(), {} });    // 越界页号表示未放置
+            continue;
+        }
+        placements.push_back(Placement{ page_surfaces.size() - 1, rect });
+        cursor_x += padded_w;
+        shelf_height = std::max(shelf_height, padded_h);
+    }
+
+    // 页面先在 CPU 侧转换为目标格式，SDL_CreateTextureFromSurface 在渲染器支持时沿用该格式
+    SDL_PixelFormat page_format = toSDLPixelFormat(config.pixel_format_);
+    if (page_format != SDL_PIXELFORMAT_RGBA32 && !rendererSupportsFormat(renderer_, page_format)) {
+        spdlog::warn("渲染器不支持图集页格式 {}，改用 RGBA8888", SDL_GetPixelFormatName(page_format));
+        page_format = SDL_PIXELFORMAT_RGBA32;
+    }
+    // 转换为目标格式后上传并释放表面，失败时返回 nullptr
+    const auto upload = [&](SDL_Surface* surface) -> SDL_Texture* {
+        if (page_format != SDL_PIXELFORMAT_RGBA32) {
+            if (SDL_Surface* converted = SDL_ConvertSurface(surface, page_format)) {
+                SDL_DestroySurface(surface);
+                surface = converted;
+            } else {
+                spdlog::warn("图集页转换为 {} 失败：{}", SDL_GetPixelFormatName(page_format), SDL_GetError());
+            }
+        }
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surface);
+        SDL_DestroySurface(surface);
+        if (texture) {
+            SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        }
+        return texture;
+    };
+    std::vector<SDL_Texture*> page_textures;
+    page_textures.reserve(page_surfaces.size());
+    atlas_mip_pages_.resize(static_cast<std::size_t>(mip_levels));
+    int built_mip_levels = mip_levels;      // 各页都成功生成的级数
+    for (SDL_Surface* page : page_surfaces) {
+        // 缩小页由上一级的 RGBA32 表面逐级生成，须在转换格式之前
+        std::vector<SDL_Surface*> chain;
+        for (const SDL_Surface* previous = page; static_cast<int>(chain.size()) < mip_levels; previous = chain.back()) {
+            SDL_Surface* smaller = downsampleRGBA32(previous);
+            if (!smaller) {
+                spdlog::warn("生成图集缩小页失败：{}", SDL_GetError());
+                break;
+            }
+            chain.push_back(smaller);
+        }
+        SDL_Texture* texture = upload(page);
+        if (texture) {
+            atlas_pages_.emplace_back(texture);
+        } else {
+            spdlog::error("上传图集页失败：{}", SDL_GetError());
+        }
+        page_textures.push_back(texture);
+        int uploaded = 0;
+        for (std::size_t level = 0; level < chain.size(); ++level) {
+            SDL_Texture* mip = upload(chain[level]);
+            if (mip && uploaded == static_cast<int>(level)) {
+                ++uploaded;
+            }
+            atlas_mip_pages_[level].emplace_back(mip);      // 与 page_textures 按页号对应（失败时为空）
+        }
+        for (std::size_t level = chain.size(); level < atlas_mip_pages_.size(); ++level) {
+            atlas_mip_pages_[level].emplace_back(nullptr);
+        }
+        built_mip_levels = std::min(built_mip_levels, uploaded);
+    }
+
+    std::size_t packed = 0;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        if (i < placements.size() && placements[i].page_ < page_textures.size() && page_textures[placements[i].page_]) {
+            const auto& rect = placements[i].rect_;
+            TextureRegion region;
+            region.texture_ = page_textures[placements[i].page_];
+            region.offset_ = glm::vec2(static_cast<float>(rect.x), static_cast<float>(rect.y));
+            region.size_ = glm::vec2(static_cast<float>(rect.w), static_cast<float>(rect.h));
+            region.page_ = static_cast<std::uint16_t>(placements[i].page_);
+            region.mip_levels_ = static_cast<std::uint8_t>(built_mip_levels);
+            atlas_regions_.insert_or_assign(entries[i].id_, region);
+            // 之前单独加载过的同一纹理不再需要
+            dropTexture(entries[i].id_);
+            evicted_.erase(entries[i].id_);
+            ++packed;
+        }
+        SDL_DestroySurface(entries[i].surface_);
+    }
+
+    spdlog::info("纹理图集构建完成：{} 张图片打包进 {} 页 ({}x{}, {}, {} 级缩小页)", packed, atlas_pages_.size(), page_size, page_size,
+                 SDL_GetPixelFormatName(page_format), built_mip_levels);
+    return packed;
+}
+
+/**
+ * @brief 在工作线程上开始解码纹理，解码结果由投递到主线程队列的 uploadDecoded 上传。
+ * @param id 纹理资源ID。
+ * @param file_path 纹理文件路径。
+ * @return 已可用或已在解码中返回 true。
+ */
+bool engine::resource::TextureManager::requestTexture(ResourceId id, std::string_view file_path) {
+    if (id == InvalidResourceId) {
+        return false;
+    }
+    if (textures_.contains(id) || atlas_regions_.contains(id) || pending_.contains(id)) {
+        return true;
+    }
+    if (failed_.contains(id)) {
+        return false;
+    }
+    PendingTexture pending;
+    if (!file_path.empty()) {
+        pending.path_ = std::string(file_path);
+    } else if (auto evicted = evicted_.find(id); evicted != evicted_.end()) {
+        pending.path_ = evicted->second;
+    } else {
+        return false;
+    }
+    pending.surface_ = tasks_.submitThen(engine::core::TaskPriority::BACKGROUND,
+        [path = pending.path_]() { return SurfacePtr(IMG_Load_IO(engine::io::VirtualFS::instance().openIO(path), true)); },
+        [this, id]() { uploadDecoded(id); });
+    pending_.emplace(id, std::move(pending));
+    spdlog::debug("开始后台解码纹理: {} (id={})", file_path, id);
+    return true;
+}
+
+/**
+ * @brief 上传一张已解码的纹理（主线程队列中的续体）。
+ * @param id 纹理资源ID。
+ */
+void engine::resource::TextureManager::uploadDecoded(ResourceId id) {
+    auto it = pending_.find(id);
+    if (it == pending_.end() || it->second.surface_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+    ENGINE_PROFILE_SCOPE("TextureManager::uploadDecoded");
+    const std::string path = std::move(it->second.path_);
+    SurfacePtr surface = it->second.surface_.get();
+    pending_.erase(it);
+    if (!surface) {
+        spdlog::error("后台解码纹理失败: '{}' (id={})", path, id);
+        failed_.insert(id);
+        return;
+    }
+    if (!uploadSurface(id, path, surface.get())) {
+        failed_.insert(id);
+    }
+}
+
+SDL_Texture* engine::resource::TextureManager::finishPending(ResourceId id) {
+    auto it = pending_.find(id);
+    if (it == pending_.end()) {
+        return nullptr;
+    }
+    const std::string path = std::move(it->second.path_);
+    SurfacePtr surface = it->second.surface_.get();
+    pending_.erase(it);
+    if (!surface) {
+        spdlog::error("后台解码纹理失败: '{}' (id={})", path, id);
+        return nullptr;
+    }
+    return uploadSurface(id, path, surface.get());
+}
+
+SDL_Texture* engine::resource::TextureManager::uploadSurface(ResourceId id, std::string_view file_path, SDL_Surface* surface) {
+    SDL_Texture* raw_texture = SDL_CreateTextureFromSurface(renderer_, surface);
+    if (!raw_texture) {
+        spdlog::error("上传纹理失败: '{}' (id={}): {}", file_path, id, SDL_GetError());
+        return nullptr;
+    }
+    if (!SDL_SetTextureScaleMode(raw_texture, SDL_SCALEMODE_NEAREST)) {
+        spdlog::warn("无法设置纹理缩放模式为最邻近插值");
+    }
+    storeTexture(id, file_path, raw_texture, false);
+    spdlog::debug("成功上传并缓存纹理: {} (id={})", file_path, id);
+    return raw_texture;
+}
+
+SDL_Texture* engine::resource::TextureManager::storeTexture(ResourceId id, std::string_view file_path, SDL_Texture* texture, bool render_target) {
+    ResidentTexture entry;
+    entry.texture_.reset(texture);
+    entry.path_ = std::string(file_path);
+    entry.bytes_ = describeTexture(texture).bytes_;
+    entry.last_used_ = frame_;
+    entry.render_target_ = render_target;
+    dropTexture(id);
+    resident_bytes_ += entry.bytes_;
+    evicted_.erase(id);
+    textures_.insert_or_assign(id, std::move(entry));
+    return texture;
+}
+
+bool engine::resource::TextureManager::dropTexture(ResourceId id) {
+    auto it = textures_.find(id);
+    if (it == textures_.end()) {
+        return false;
+    }
+    resident_bytes_ -= std::min(resident_bytes_, it->second.bytes_);
+    textures_.erase(it);
+    return true;
+}
+
+SDL_Texture* engine::resource::TextureManager::touch(ResourceId id) {
+    auto it = textures_.find(id);
+    if (it == textures_.end()) {
+        return nullptr;
+    }
+    it->second.last_used_ = frame_;
+    return it->second.get();
+}
+
+/**
+ * @brief 推进帧计数；超出显存预算时淘汰最久未使用的纹理，直到回到预算以内。
+ *
+ * 上一帧画过的纹理本帧多半还要画，淘汰它只会立刻重新加载，因此不作为候选；
+ * 候选全部用尽仍超出预算时保留现状（只告警一次），等画面切换后再淘汰。
+ */
+std::size_t engine::resource::TextureManager::beginFrame() {
+    ++frame_;
+    if (vram_budget_bytes_ == 0 || resident_bytes_ <= vram_budget_bytes_) {
+        over_budget_warned_ = false;
+        return 0;
+    }
+    ENGINE_PROFILE_SCOPE("TextureManager::evict");
+    struct Candidate {
+        ResourceId id_;
+        std::uint64_t last_used_;
+    };
+    std::vector<Candidate> candidates;
+    for (const auto& [id, entry] : textures_) {
+        if (!entry.render_target_ && !entry.path_.empty() && entry.last_used_ + 1 < frame_ && !pinned_.contains(id)) {
+            candidates.push_back(Candidate{ id, entry.last_used_ });
+        }
+    }
+    std::ranges::sort(candidates, {}, &Candidate::last_used_);
+
+    std::size_t evicted = 0;
+    std::size_t evicted_bytes = 0;
+    for (const auto& candidate : candidates) {
+        if (resident_bytes_ <= vram_budget_bytes_) {
+            break;
+        }
+        auto it = textures_.find(candidate.id_);
+        evicted_bytes += it->second.bytes_;
+        evicted_.insert_or_assign(candidate.id_, std::move(it->second.path_));
+        dropTexture(candidate.id_);
+        ++evicted;
+    }
+    if (evicted > 0) {
+        spdlog::debug("纹理超出显存预算：淘汰 {} 张 ({:.1f} MB)，驻留 {:.1f} / {:.1f} MB", evicted,
+            evicted_bytes / (1024.0 * 1024.0), resident_bytes_ / (1024.0 * 1024.0), vram_budget_bytes_ / (1024.0 * 1024.0));
+    }
+    if (resident_bytes_ > vram_budget_bytes_ && !over_budget_warned_) {
+        over_budget_warned_ = true;
+        spdlog::warn("纹理显存 {:.1f} MB 超出预算 {:.1f} MB，剩余纹理均已固定或正在使用",
+            resident_bytes_ / (1024.0 * 1024.0), vram_budget_bytes_ / (1024.0 * 1024.0));
+    }
+    return evicted;
+}
+
+SDL_Texture* engine::resource::TextureManager::getPlaceholder() {
+    if (!placeholder_) {
+        SDL_Texture* texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 1, 1);
+        if (!texture) {
+            spdlog::error("创建占位纹理失败：{}", SDL_GetError());
+            return nullptr;
+        }
+        const Uint8 pixel[4] = { 255, 255, 255, 48 };
+        SDL_UpdateTexture(texture, nullptr, pixel, sizeof(pixel));
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        placeholder_.reset(texture);
+    }
+    return placeholder_.get();
+}
+
+const engine::resource::TextureRegion* engine::resource::TextureManager::findAtlasRegion(ResourceId id) const {
+    auto it = atlas_regions_.find(id);
+    return it != atlas_regions_.end() ? &it->second : nullptr;
+}
+
+bool engine::resource::TextureManager::addAtlasAlias(ResourceId alias, ResourceId target) {
+    const auto* region = findAtlasRegion(target);
+    if (!region || alias == InvalidResourceId) {
+        return false;
+    }
+    atlas_regions_.insert_or_assign(alias, *region);
+    return true;
+}
+
+/**
+ * @brief 解析纹理 ID 的实际绘制位置。
+ * @param id 纹理资源ID。
+ * @param file_path 未缓存时的加载路径。
+ * @param allow_placeholder 流式模式下是否允许以占位纹理代替尚未就绪的纹理。
+ * @return 纹理无效时 texture_ 为 nullptr。
+ */
+engine::resource::TextureRegion engine::resource::TextureManager::getTextureRegion(ResourceId id, std::string_view file_path, bool allow_placeholder,
+                                                                                  int mip_level) {
+    if (const auto* region = findAtlasRegion(id)) {
+        ++cache_stats_.lookups_;
+        return selectMip(*region, mip_level);
+    }
+    TextureRegion region;
+    if (SDL_Texture* texture = touch(id)) {
+        ++cache_stats_.lookups_;
+        region.texture_ = texture;
+    } else {
+        // 被淘汰的纹理即使未开启流式模式也后台重新加载，不在绘制途中同步读盘
+        if ((streaming_ || evicted_.contains(id)) && allow_placeholder) {
+            if (requestTexture(id, file_path) && !textures_.contains(id)) {
+                ++cache_stats_.lookups_;
+                ++cache_stats_.async_misses_;
+                region.texture_ = getPlaceholder();
+                region.size_ = glm::vec2(1.0f);
+                region.placeholder_ = region.texture_ != nullptr;
+                return region;
+            }
+            if (failed_.contains(id)) {
+                return region;
+            }
+        }
+        region.texture_ = getTexture(id, file_path);
+    }
+    if (region.texture_ && !SDL_GetTextureSize(region.texture_, &region.size_.x, &region.size_.y)) {
+        spdlog::error("无法查询纹理尺寸: id={}", id);
+    }
+    return region;
+}
+
+/**
+ * @brief 取图集区域在缩小页中的对应区域。
+ * @details 打包时位置与尺寸按 2^级数 对齐，右移即为缩小页中的像素；尺寸不足一像素时取 1。
+ */
+engine::resource::TextureRegion engine::resource::TextureManager::selectMip(const TextureRegion& region, int mip_level) const {
+    const int level = std::min(mip_level, static_cast<int>(region.mip_levels_));
+    if (level <= 0 || region.placeholder_) {
+        return region;
+    }
+    const auto& pages = atlas_mip_pages_[static_cast<std::size_t>(level - 1)];
+    if (region.page_ >= pages.size() || !pages[region.page_]) {
+        return region;
+    }
+    const float scale = 1.0f / static_cast<float>(1 << level);
+    TextureRegion mip = region;
+    mip.texture_ = pages[region.page_].get();
+    mip.offset_ = region.offset_ * scale;
+    mip.size_ = glm::max(region.size_ * scale, glm::vec2(1.0f));
+    mip.scale_ = scale;
+    return mip;
+}
+
+std::vector<engine::resource::TextureMemoryInfo> engine::resource::TextureManager::collectMemoryUsage() const {
+    std::vector<TextureMemoryInfo> usage;
+    usage.reserve(textures_.size() + atlas_pages_.size());
+    for (const auto& [id, texture] : textures_) {
+        if (texture.texture_) {
+            auto info = describeTexture(texture.get());
+            info.id_ = id;
+            usage.push_back(info);
+        }
+    }
+    for (const auto& page : atlas_pages_) {
+        if (page) {
+            auto info = describeTexture(page.get());
+            info.kind_ = TextureMemoryInfo::Kind::ATLAS_PAGE;
+            usage.push_back(info);
+        }
+    }
+    for (const auto& level : atlas_mip_pages_) {
+        for (const auto& page : level) {
+            if (page) {
+                auto info = describeTexture(page.get());
+                info.kind_ = TextureMemoryInfo::Kind::ATLAS_MIP;
+                usage.push_back(info);
+            }
+        }
+    }
+    std::ranges::sort(usage, [](const TextureMemoryInfo& a, const TextureMemoryInfo& b) { return a.bytes_ > b.bytes_; });
+    return usage;
+}
+
+void engine::resource::TextureManager::clearAtlas() {
+    atlas_regions_.clear();
+    atlas_pages_.clear();
+    atlas_mip_pages_.clear();
+}
+
 /**
  * @brief 清空当前所有的纹理缓存，释放所有占用的 SDL 纹理资源。
  */
 void engine::resource::TextureManager::clearTextures() {
+    cancelAtlasBuild();
+    clearAtlas();
+    pending_.clear();   // 不等待：仍在解码的任务只捕获路径，结果随共享状态释放，续体找不到条目时直接返回
+    failed_.clear();
+    evicted_.clear();
 	if (textures_.empty()) {
         spdlog::debug("纹理资源已为空，无需清空");
         return;
     }
     textures_.clear();
+    resident_bytes_ = 0;
     spdlog::debug("已清空所有纹理资源");
 }
\ No newline at end of file
@@ -4,9 +4,22 @@
 #include <string>       // 用于 std::string
 #include <string_view>
 #include <unordered_map> // 用于 std::unordered_map
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <unordered_set>
 #include <SDL3/SDL_render.h> // 用于 SDL_Texture 和 SDL_Renderer
 #include <glm/glm.hpp>
 #include "resource_id.h"
+#include "texture_atlas.h"
+#include "../utils/id_map.h"
+
+namespace engine::core {
+	class TaskPool;
+	enum class TaskPriority : std::uint8_t;
+}
 
 namespace engine::resource {
 
@@ -14,8 +27,12 @@ namespace engine::resource {
 	 * @class TextureManager
 	 * @brief 负责 SDL 纹理资源的集中管理、加载与缓存。
 	 * 
-	 * 该类通过 std::unordered_map 提供纹理缓存功能，避免同一资源的重复加载，
+	 * 该类通过以资源ID为键的扁平哈希表（engine::utils::IdMap）提供纹理缓存功能，避免同一资源的重复加载，
 	 * 并利用 std::unique_ptr 确保在对象销毁或资源卸载时自动调用 SDL_DestroyTexture。
+	 *
+	 * 驻留管理：每张独立纹理记录显存估算与最近一次被查询（绘制）的帧。设置了显存预算时，beginFrame()
+	 * 在超出预算后按 LRU 淘汰未固定、上一帧未使用的纹理（渲染目标与图集页不淘汰），并记下其路径；
+	 * 之后再被绘制时后台重新解码，期间绘制占位纹理。被场景持有句柄的纹理由 ResourceManager 固定（pin / unpin）。
 	 */
 	class TextureManager final {
 	private:
@@ -35,16 +52,72 @@ namespace engine::resource {
 			}
 		};
 
+		/**
+		 * @struct SDLSurfaceDeleter
+		 * @brief 工作线程解码结果（SDL_Surface）的删除器。
+		 */
+		struct SDLSurfaceDeleter {
+			void operator()(SDL_Surface* surface) const {
+				if (surface) {
+					SDL_DestroySurface(surface);
+				}
+			}
+		};
+		using SurfacePtr = std::unique_ptr<SDL_Surface, SDLSurfaceDeleter>;
+
+		/// @brief 缓存中的一张独立纹理及其驻留信息
+		struct ResidentTexture {
+			std::unique_ptr<SDL_Texture, SDLTextureDeleter> texture_;
+			std::string path_;                  ///< 来源文件（淘汰后据此重新加载；渲染目标为空）
+			std::size_t bytes_{0};              ///< 显存估算
+			std::uint64_t last_used_{0};        ///< 最近一次被查询的帧（beginFrame 计数）
+			bool render_target_{false};         ///< 渲染目标的内容无法重新加载，不参与淘汰
+
+			[[nodiscard]] SDL_Texture* get() const { return texture_.get(); }
+		};
+
+		/// @brief 已提交解码、尚未打包的图集（beginAtlasBuild 与 finishAtlasBuild 之间）
+		struct PendingAtlas {
+			TextureAtlasConfig config_;
+			std::vector<std::string> paths_;                    ///< 去重后的图片路径
+			std::vector<std::future<SDL_Surface*>> decodes_;    ///< 与 paths_ 一一对应
+		};
+
+		/// @brief 已在工作线程上开始解码、尚未上传到 GPU 的纹理
+		struct PendingTexture {
+			std::string path_;
+			std::future<SurfacePtr> surface_;
+		};
+
 		SDL_Renderer* renderer_; ///< 指向 SDL 渲染上下文的指针，用于生成纹理。
-		std::unordered_map<ResourceId, std::unique_ptr<SDL_Texture, SDLTextureDeleter>> textures_; ///< 存储已加载纹理的映射表，键为资源ID。
+		engine::core::TaskPool& tasks_;                                             ///< 解码任务与上传续体使用的线程池
+		engine::utils::IdMap<ResidentTexture> textures_;                            ///< 存储已加载纹理的映射表，键为资源ID。
+		std::vector<std::unique_ptr<SDL_Texture, SDLTextureDeleter>> atlas_pages_;  ///< 图集页纹理
+		std::vector<std::vector<std::unique_ptr<SDL_Texture, SDLTextureDeleter>>> atlas_mip_pages_; ///< [级别 - 1][页] 图集缩小页
+		engine::utils::IdMap<TextureRegion> atlas_regions_;                               ///< 已打包纹理 ID → 图集页内区域
+		std::optional<PendingAtlas> pending_atlas_;                                 ///< 后台解码中的图集
+		std::unordered_map<ResourceId, PendingTexture> pending_;                    ///< 后台解码中的纹理
+		std::unordered_set<ResourceId> failed_;                                     ///< 后台解码失败的纹理，流式模式下不再重试
+		std::unique_ptr<SDL_Texture, SDLTextureDeleter> placeholder_;               ///< 未就绪纹理的占位纹理（按需创建）
+		bool streaming_{false};                                                     ///< 为 true 时缓存未命中改为后台加载并返回占位纹理
+		TextureCacheStats cache_stats_;                                             ///< 查询与未命中计数
+
+		// --- 驻留管理 ---
+		std::uint64_t frame_{0};                                                    ///< beginFrame() 计数
+		std::size_t resident_bytes_{0};                                             ///< textures_ 的显存估算合计（不含图集页）
+		std::size_t vram_budget_bytes_{0};                                          ///< 独立纹理的显存预算，0 表示不限
+		std::unordered_set<ResourceId> pinned_;                                     ///< 不参与淘汰的纹理
+		engine::utils::IdMap<std::string> evicted_;                                 ///< 已淘汰纹理 → 来源路径，再次使用时后台重新加载
+		bool over_budget_warned_{false};                                            ///< 无可淘汰纹理的告警只输出一次
 
 	public:
 		/**
 		 * @brief 构造函数，初始化纹理管理器。
 		 * @param renderer 指向有效的 SDL_Renderer 上下文的指针。不能为空。
+		 * @param tasks 解码使用的任务线程池；投递到其主线程队列的上传续体捕获了本对象，须在本对象销毁前 shutdown()。
 		 * @throws std::runtime_error 如果 renderer 为 nullptr。
 		 */
-		explicit TextureManager(SDL_Renderer* renderer);
+		TextureManager(SDL_Renderer* renderer, engine::core::TaskPool& tasks);
 
 		// 禁止拷贝和移动语义以确保资源所有权的唯一性
 		TextureManager(const TextureManager&) = delete;
@@ -88,8 +161,143 @@ private:
 		glm::vec2 getTextureSize(const std::string& file_path);
 
 		/**
-		 * @brief 清空当前所有的纹理缓存，释放所有占用的 SDL 纹理资源。
+		 * @brief 创建一张可作为渲染目标的空白纹理并以指定 ID 缓存。
+		 * @param id 纹理资源 ID，若已存在同 ID 纹理则先替换。
+		 * @param size 纹理尺寸（像素）。
+		 * @return SDL_Texture* 创建成功返回纹理指针，失败返回 nullptr。
+		 */
+		SDL_Texture* createRenderTarget(ResourceId id, glm::ivec2 size);
+
+		/**
+		 * @brief 将一组小图片打包进若干张图集页。
+		 *
+		 * 图片按高度降序以行（shelf）方式排布，页满时新建一页；超出 max_entry_size_ 或加载失败的图片跳过。
+		 * 每张图片以 toResourceId(路径) 登记区域，已存在的同 ID 独立纹理会被释放。重复调用会先清空旧图集。
+		 * config.mip_levels_ > 0 时为每页生成缩小页（见 TextureAtlasConfig）。
+		 * @param file_paths 图片路径列表。
+		 * @param config 图集参数。
+		 * @return 成功打包的图片数量。
+		 */
+		std::size_t buildAtlas(const std::vector<std::string>& file_paths, const TextureAtlasConfig& config);
+
+		/**
+		 * @brief 提交图集图片的后台解码后立即返回（启动时不阻塞首帧）。已有挂起的构建时先取消。
+		 * @details 解码完成前旧图集（如有）保持可用；打包由 updateAtlasBuild() 在主线程完成。
+		 */
+		void beginAtlasBuild(const std::vector<std::string>& file_paths, const TextureAtlasConfig& config,
+		                     engine::core::TaskPriority priority);
+
+		/**
+		 * @brief 挂起的图集解码全部完成时打包并上传（主线程，每帧调用）。
+		 * @return 本次调用完成了构建时返回 true。
+		 */
+		bool updateAtlasBuild();
+
+		/// @brief 是否有已提交解码、尚未打包的图集
+		[[nodiscard]] bool isAtlasBuildPending() const { return pending_atlas_.has_value(); }
+
+		/// @brief 挂起图集的解码进度 [0, 1]，没有挂起的构建时为 1
+		[[nodiscard]] float getAtlasBuildProgress() const;
+
+		/// @brief 挂起图集的图片路径（没有时为空），用于避免把这些图片另行加载为独立纹理
+		[[nodiscard]] const std::vector<std::string>* getPendingAtlasPaths() const {
+			return pending_atlas_ ? &pending_atlas_->paths_ : nullptr;
+		}
+
+		/**
+		 * @brief 查询纹理 ID 在图集中的区域。
+		 * @return 未打包时返回 nullptr。
+		 */
+		const TextureRegion* findAtlasRegion(ResourceId id) const;
+
+		/**
+		 * @brief 为已打包的纹理登记别名（如映射表中的逻辑名）。
+		 * @return target 未打包时返回 false。
+		 */
+		bool addAtlasAlias(ResourceId alias, ResourceId target);
+
+		/**
+		 * @brief 解析纹理 ID 的实际绘制位置，优先使用图集，否则回退到独立纹理。
+		 *
+		 * 缓存未命中时：流式模式且 allow_placeholder 为 true 时发起后台加载并返回占位纹理；
+		 * 否则同步从磁盘加载。
+		 * @param mip_level 期望的缩小级，只对图集中的纹理生效（超出该页可用级数时取最小一级）。
+		 */
+		TextureRegion getTextureRegion(ResourceId id, std::string_view file_path = {}, bool allow_placeholder = true,
+		                               int mip_level = 0);
+
+		/**
+		 * @brief 把图集区域换成第 mip_level 级缩小页中的对应区域；独立纹理或 mip_level <= 0 时原样返回。
+		 */
+		TextureRegion selectMip(const TextureRegion& region, int mip_level) const;
+
+		/**
+		 * @brief 释放所有图集页及区域表。
+		 */
+		void clearAtlas();
+
+		/// @brief 等待挂起的图集解码并打包，返回打包的图片数量
+		std::size_t finishAtlasBuild();
+
+		/// @brief 丢弃挂起的图集构建（等待解码任务结束并释放其表面）
+		void cancelAtlasBuild();
+
+		/**
+		 * @brief 在工作线程上开始解码纹理（IMG_Load，BACKGROUND 优先级），不阻塞调用线程。
+		 *
+		 * 解码完成后上传续体投递到 TaskPool 的主线程队列，由每帧的 drainMainThread() 在预算内执行。
+		 * @return 已缓存、已打包或已在解码中时返回 true；无效 ID 或缺少路径时返回 false。
+		 */
+		bool requestTexture(ResourceId id, std::string_view file_path);
+
+		/**
+		 * @brief 主线程续体：把已解码完成的纹理上传到 GPU。
+		 *
+		 * 已被 finishPending() 取走或被 clearTextures() 丢弃时什么也不做；
+		 * 同一 ID 重新请求、新的解码尚未完成时留给新请求自己的续体。
+		 */
+		void uploadDecoded(ResourceId id);
+
+		/**
+		 * @brief 每帧调用一次：推进帧计数，超出显存预算时按 LRU 淘汰。
+		 * @return 本帧淘汰的纹理数量。
+		 */
+		std::size_t beginFrame();
+
+		/// @brief 设置独立纹理的显存预算（字节），0 表示不限；下一次 beginFrame() 生效
+		void setVramBudget(std::size_t bytes) { vram_budget_bytes_ = bytes; }
+		/// @brief 固定 / 取消固定一张纹理（固定的纹理不被淘汰，未加载的不会因此加载）
+		void pin(ResourceId id) { pinned_.insert(id); }
+		void unpin(ResourceId id) { pinned_.erase(id); }
+		[[nodiscard]] std::size_t getResidentBytes() const { return resident_bytes_; }
+
+		/// @brief 开启/关闭流式模式（影响 getTextureRegion 的缓存未命中行为）
+		void setStreaming(bool enabled) { streaming_ = enabled; }
+		[[nodiscard]] std::size_t getPendingCount() const { return pending_.size(); }
+		/// @brief 缓存查询与未命中的累计统计（卡顿诊断与会话遥测使用）
+		[[nodiscard]] const TextureCacheStats& getCacheStats() const { return cache_stats_; }
+
+		/// @brief 等待后台解码完成并立即上传；未在解码中时返回 nullptr
+		SDL_Texture* finishPending(ResourceId id);
+		/// @brief 把解码好的 Surface 上传为纹理并缓存
+		SDL_Texture* uploadSurface(ResourceId id, std::string_view file_path, SDL_Surface* surface);
+		/// @brief 登记一张新纹理（替换同 ID 的旧纹理），更新显存合计并清除淘汰记录
+		SDL_Texture* storeTexture(ResourceId id, std::string_view file_path, SDL_Texture* texture, bool render_target);
+		/// @brief 移出缓存并扣除显存合计；不存在时返回 false
+		bool dropTexture(ResourceId id);
+		/// @brief 命中时记录使用帧并返回纹理，未缓存时返回 nullptr
+		SDL_Texture* touch(ResourceId id);
+		/// @brief 占位纹理（半透明白色，1x1），创建失败时返回 nullptr
+		SDL_Texture* getPlaceholder();
+
+		/**
+		 * @brief 清空当前所有的纹理缓存（含图集与淘汰记录，保留固定集合与预算），释放所有占用的 SDL 纹理资源。
 		 */
 		void clearTextures();
+
+		/**
+		 * @brief 列出缓存中每张纹理（含图集页与渲染目标，不含占位纹理）的显存估算，按字节数降序。
+		 */
+		[[nodiscard]] std::vector<TextureMemoryInfo> collectMemoryUsage() const;
 	};
 }
\ No newline at end of file
@@ -2,8 +2,13 @@
 #include <algorithm> 
 #include "../core/context.h"
 #include "../core/game_state.h"
+#include "../render/renderer.h"
 #include "../render/camera.h" // 添加Camera头文件
 #include "../ui/ui_manager.h" // 添加UI管理器头文件
+#include "../ui/ui_element.h"
+#include "../ecs/registry_snapshot.h"
+#include "../memory/memory_tracker.h"
+#include "../memory/storage_arena.h"
 #include "../utils/events.h"
 #include "../utils/logging.h"
 /**
@@ -13,7 +18,7 @@
  * @param scene_manager 场景管理器引用。
  */
 engine::scene::Scene::Scene(const std::string_view scene_name, engine::core::Context& context)
-	:scene_name_(scene_name), context_(context)
+	:scene_name_(scene_name), context_(context), resources_(context.getResourceManager())
 {
 	// 初始化UI管理器
 	ui_manager_ = std::make_unique<engine::ui::UIManager>(context_);
@@ -55,6 +60,9 @@ void engine::scene::Scene::render()
 {
  if(is_initialized_){
 		
+		// 世界层到此结束：低分辨率目标（若启用）放大到窗口，UI 仍按输出分辨率绘制
+		context_.getRenderer().endWorldPass();
+
 		// 渲染UI（在游戏对象之上）
 		if (ui_manager_) {
 			ui_manager_->render();
@@ -97,6 +105,17 @@ void engine::scene::Scene::clean()
 		is_initialized_ = false;
         ENGINE_LOG_TRACE("Scene {} 清理完成", scene_name_);
 	}
+	// 预取后未进入的场景也可能已获取了资源
+	resources_.releaseAll();
+}
+
+void engine::scene::Scene::reportMemoryUsage() const
+{
+	using engine::memory::MemoryTag;
+	auto& tracker = engine::memory::MemoryTracker::instance();
+	tracker.setReported(MemoryTag::REGISTRY, engine::ecs::RegistrySnapshot<>::getStorageBytes(registry_));
+	const auto* root = ui_manager_ ? ui_manager_->getRootElement() : nullptr;
+	tracker.setReported(MemoryTag::UI, root ? root->estimateTreeBytes() : 0u);
 }
 
 void engine::scene::Scene::onPause()
@@ -126,6 +145,16 @@ void engine::scene::Scene::requestReplaceScene(std::unique_ptr<engine::scene::Sc
     context_.getDispatcher().trigger<engine::utils::ReplaceSceneEvent>(engine::utils::ReplaceSceneEvent{std::move(scene)});
 }
 
+void engine::scene::Scene::requestReplaceScene(entt::id_type prefetch_key, std::unique_ptr<engine::scene::Scene>&& fallback)
+{
+    context_.getDispatcher().trigger<engine::utils::ReplaceSceneEvent>(engine::utils::ReplaceSceneEvent{std::move(fallback), prefetch_key});
+}
+
+void engine::scene::Scene::requestPrefetchScene(entt::id_type key, std::unique_ptr<engine::scene::Scene>&& scene)
+{
+    context_.getDispatcher().trigger<engine::utils::PrefetchSceneEvent>(engine::utils::PrefetchSceneEvent{key, std::move(scene)});
+}
+
 void engine::scene::Scene::quit()
 {
     context_.getDispatcher().trigger<engine::utils::QuitEvent>();
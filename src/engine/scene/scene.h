@@ -3,18 +3,27 @@
 #include <vector>
 #include <memory>
 #include <entt/entity/registry.hpp>
+#include "../resource/resource_handle.h"
 namespace engine::core {
 	class Context;
 }
-namespace engine::resource {
-	class ResourceManager;
-}
 namespace engine::ui {
 	class UIManager;
 }
+namespace engine::memory {
+	class StorageArena;
+}
 namespace engine::scene {
 	class SceneManager;
 
+	/**
+	 * @brief 叠加场景对其下方冻结底图的处理，捕获时一次烘焙（见 SceneManager::render()）。
+	 */
+	struct UnderlayStyle {
+		float dim_ = 0.0f;      ///< 压暗程度 [0, 1]
+		int blur_passes_ = 0;   ///< 模糊级数，每级把底图缩小一半后再线性放大，0 表示不模糊
+	};
+
 	/**
 	 * @class Scene
 	 * @brief 场景基类，负责管理属于该场景的所有游戏对象及其生命周期。
@@ -25,11 +34,13 @@ namespace engine::scene {
 protected:
 	std::string scene_name_;                        ///< 场景的唯一标识名称
 	engine::core::Context& context_;               ///< 指向引擎全局上下文的引用
+	std::unique_ptr<engine::memory::StorageArena> storage_arena_; ///< 组件存储的 arena（可选，须先于 registry_ 声明、晚于它析构）
 	entt::registry registry_;                      ///< 实体组件系统的注册表
 
 	bool is_initialized_ = false;                   ///< 标记场景是否已完成初始化
    bool is_paused_ = false;                        ///< 标记场景是否处于暂停状态
 	std::unique_ptr<engine::ui::UIManager> ui_manager_; ///< UI管理器，负责管理场景中的所有UI元素
+	engine::resource::ResourceScope resources_;     ///< 本场景持有的资源引用，clean() 时释放，之后的帧中卸载
 	public:
 		/**
 		 * @brief 构造函数。
@@ -48,6 +59,23 @@ protected:
 
 		/** @brief 初始化场景内容。在进入场景时由 SceneManager 调用。 */
 		virtual void init();
+		/**
+		 * @brief 在进入场景之前开始后台加载（场景被预取时由 SceneManager 调用一次）。
+		 * @details 只应启动不依赖其它场景状态的工作（文件解析、资源流式加载等），
+		 *          init() 负责消费其结果；默认不做任何事，init() 照常同步加载。
+		 */
+		virtual void prefetch() {}
+		/** @brief 预取期间每帧在主线程上调用，用于推进需要主线程的加载步骤。 */
+		virtual void updatePrefetch() {}
+		/**
+		 * @brief 预取的场景能否进入；为 false 时 SceneManager 推迟切换，当前场景照常更新并收到 onLoadProgress()。
+		 * @details 默认 true。以协程加载的场景在协程结束前返回 false，进入时 init() 不再阻塞。
+		 */
+		virtual bool isReadyToInit() const { return true; }
+		/** @brief 预取进度 [0, 1]。 */
+		virtual float getLoadProgress() const { return 1.0f; }
+		/** @brief 等待切换到的预取场景加载期间，每帧以其进度调用当前场景（用于显示加载进度）。 */
+		virtual void onLoadProgress(float /*progress*/) {}
 		/** 
 		 * @brief 更新场景逻辑。每帧由主循环调用。
 		 * @param delta_time 自上一帧的时间间隔（秒）。
@@ -59,13 +87,25 @@ protected:
 		virtual void onPause();
 		/** @brief 场景从暂停状态恢复。 */
 		virtual void onResume();
+		/**
+		 * @brief 本场景压在其它场景之上时，对下方冻结底图的压暗 / 模糊要求。
+		 * @details 默认不做处理；下方场景被暂停后不再更新，SceneManager 只在压入后捕获一次其画面。
+		 */
+		virtual UnderlayStyle getUnderlayStyle() const { return {}; }
 		/** @brief 处理场景特定的输入。 @return 是否处理了输入事件。 */
 		virtual bool handleInput();
-		/** @brief 清理场景资源。在退出或销毁场景前调用。 */
+		/** @brief 清理场景资源。在退出或销毁场景前调用；同时释放 resources_ 中的资源引用。 */
 		virtual void clean();
+		/**
+		 * @brief 向 MemoryTracker 上报本场景的内存估算（注册表存储、UI 树）。
+		 * @details 默认只能按类型擦除的存储统计索引部分；知道组件列表的场景应覆盖以计入组件值。
+		 */
+		virtual void reportMemoryUsage() const;
 
 		/** @brief 获取UI管理器。 @return UI管理器指针。 */
 		engine::ui::UIManager* getUIManager() { return ui_manager_.get(); }
+		/** @brief 本场景的资源引用作用域（加载器向其中登记场景专属的资源）。 */
+		engine::resource::ResourceScope& getResources() { return resources_; }
 
 		//getters and setter
 		const std::string& getSceneName() const { return scene_name_; }
@@ -87,6 +127,12 @@ protected:
 		/// @brief 请求替换当前场景。
 		void requestReplaceScene(std::unique_ptr<engine::scene::Scene>&& scene);
 
+		/// @brief 请求替换当前场景，优先使用 prefetch_key 对应的预取场景，未命中时使用 fallback。
+		void requestReplaceScene(entt::id_type prefetch_key, std::unique_ptr<engine::scene::Scene>&& fallback);
+
+		/// @brief 请求在后台预取一个场景，供之后以相同 key 切换。
+		void requestPrefetchScene(entt::id_type key, std::unique_ptr<engine::scene::Scene>&& scene);
+
 		/// @brief 退出游戏。
 		void quit();
 
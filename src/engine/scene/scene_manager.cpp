@@ -1,6 +1,10 @@
 #include"scene_manager.h"
 #include "scene.h"
 #include "../core/context.h"
+#include "../render/renderer.h"
+#include "../memory/memory_tracker.h"
+#include "../resource/resource_manager.h"
+#include "../utils/profiler.h"
 #include <spdlog/spdlog.h>
 #include <entt/entt.hpp>
 #include <utility>
@@ -18,6 +22,7 @@ SceneManager::SceneManager(engine::core::Context& context)
 	context_.getDispatcher().sink<utils::PushSceneEvent>().connect<&SceneManager::onPushScene>(this);
 	context_.getDispatcher().sink<utils::PopSceneEvent>().connect<&SceneManager::onPopScene>(this);
 	context_.getDispatcher().sink<utils::ReplaceSceneEvent>().connect<&SceneManager::onReplaceScene>(this);
+	context_.getDispatcher().sink<utils::PrefetchSceneEvent>().connect<&SceneManager::onPrefetchScene>(this);
 }
 
 /**
@@ -50,31 +55,70 @@ Scene* SceneManager::getCurrentScene() const
  * @param delta_time 帧间隔时间。
  */
 void SceneManager::update(float delta_time) {
+	ENGINE_PROFILE_SCOPE("SceneManager::update");
 	// 只更新栈顶（当前）场景
 	Scene* current_scene = getCurrentScene();
 	if (current_scene) {
 		current_scene->update(delta_time);
 	}
+	// 推进预取场景中需要主线程的加载步骤
+	if (prefetched_scene_) {
+		prefetched_scene_->updatePrefetch();
+	}
 	// 执行可能的切换场景操作
 	processPendingActions();
 }
 
 /**
- * @brief 帧渲染逻辑：从底向上叠加渲染场景栈中的所有场景。
+ * @brief 帧渲染逻辑：栈顶以下的场景画成冻结底图，栈顶场景绘制在其上。
  */
 void SceneManager::render() {
-  // 从底向上渲染，让顶层菜单覆盖在暂停中的游戏场景之上
-	for (const auto& scene : scene_stack_) {
-		if (scene) {
-			scene->render();
+	if (scene_stack_.size() < 2) {
+		for (const auto& scene : scene_stack_) {
+			if (scene) {
+				scene->render();
+			}
+		}
+		return;
+	}
+
+	// 被覆盖的场景已暂停、不再更新，画面不会变化：压入后只从底向上画一次到底图，之后每帧贴出
+	auto& renderer = context_.getRenderer();
+	Scene* top = scene_stack_.back().get();
+	if (!renderer.hasUnderlay()) {
+		ENGINE_PROFILE_SCOPE("SceneManager::captureUnderlay");
+		if (renderer.beginUnderlayCapture()) {
+			renderer.beginWorldPass();
+			for (std::size_t i = 0; i + 1 < scene_stack_.size(); ++i) {
+				if (scene_stack_[i]) {
+					scene_stack_[i]->render();
+				}
+			}
+			const UnderlayStyle style = top ? top->getUnderlayStyle() : UnderlayStyle{};
+			renderer.endUnderlayCapture(style.dim_, style.blur_passes_);
 		}
 	}
+	if (renderer.hasUnderlay()) {
+		renderer.discardWorldPass();	// GameApp 开启的世界层属于被覆盖的场景，本帧不再需要
+		renderer.drawUnderlay();
+	} else {
+		// 底图不可用：退回逐帧从底向上绘制
+		for (std::size_t i = 0; i + 1 < scene_stack_.size(); ++i) {
+			if (scene_stack_[i]) {
+				scene_stack_[i]->render();
+			}
+		}
+	}
+	if (top) {
+		top->render();
+	}
 }
 
 /**
  * @brief 处理输入逻辑：通常只传递给栈顶场景。
  */
 void SceneManager::handleInput() {
+	ENGINE_PROFILE_SCOPE("SceneManager::handleInput");
 	// 只考虑栈顶场景
 	Scene* current_scene = getCurrentScene();
 	if (current_scene) {
@@ -92,13 +136,53 @@ void SceneManager::close()
 	while (!scene_stack_.empty()) {
 		if (scene_stack_.back()) {
 			spdlog::debug("正在清理场景 '{}' 。", scene_stack_.back()->getSceneName());
-			scene_stack_.back()->clean();
+			cleanScene(*scene_stack_.back());
 		}
 		scene_stack_.pop_back();
 	}
+	cancelPrefetch();
+	pending_scene_.reset();		// 推迟中的切换目标尚未 init()，析构时等待其加载任务
+	pending_action_ = PendingAction::None;
 	context_.getDispatcher().disconnect(this);
 }
 
+namespace {
+
+/// @brief 上报纹理显存与音频缓冲的估算
+void reportResourceMemory(const engine::resource::ResourceManager& resource_manager)
+{
+	using engine::memory::MemoryTag;
+	auto& tracker = engine::memory::MemoryTracker::instance();
+	std::size_t texture_bytes = 0;
+	for (const auto& info : resource_manager.getTextureMemoryUsage()) {
+		texture_bytes += info.bytes_;
+	}
+	tracker.setReported(MemoryTag::TEXTURES, texture_bytes);
+	tracker.setReported(MemoryTag::AUDIO, resource_manager.getAudioResidentBytes());
+}
+
+} // namespace
+
+void SceneManager::reportMemoryUsage() const
+{
+	if (!scene_stack_.empty() && scene_stack_.back()) {
+		scene_stack_.back()->reportMemoryUsage();
+	}
+	reportResourceMemory(context_.getResourceManager());
+}
+
+void SceneManager::cleanScene(Scene& scene)
+{
+	auto& tracker = engine::memory::MemoryTracker::instance();
+	if (tracker.isReportEnabled() && scene.isInitialized()) {
+		// 退出的场景不一定在栈顶（replaceScene 自顶向下清理整栈），按该场景本身上报
+		scene.reportMemoryUsage();
+		reportResourceMemory(context_.getResourceManager());
+		tracker.writeReport(scene.getSceneName());
+	}
+	scene.clean();
+}
+
 /**
  * @brief 处理由 requestXXX 函数提交的异步操作。
  */
@@ -107,6 +191,7 @@ void SceneManager::processPendingActions()
 	if (pending_action_ == PendingAction::None) {
 		return;
 	}
+	ENGINE_PROFILE_SCOPE("SceneManager::processPendingActions");
 	switch (pending_action_) {
 	case PendingAction::Push:
 		pushScene(std::move(pending_scene_));
@@ -115,6 +200,14 @@ void SceneManager::processPendingActions()
 		popScene();
 		break;
 	case PendingAction::Replace:
+		if (pending_scene_ && !pending_scene_->isReadyToInit()) {
+			// 预取的场景仍在加载：推迟切换，当前场景照常更新并显示进度
+			pending_scene_->updatePrefetch();
+			if (auto* current_scene = getCurrentScene()) {
+				current_scene->onLoadProgress(pending_scene_->getLoadProgress());
+			}
+			return;
+		}
 		replaceScene(std::move(pending_scene_));
 		break;
 	default:
@@ -130,6 +223,7 @@ void SceneManager::processPendingActions()
 void SceneManager::pushScene(std::unique_ptr<Scene>&& scene)
 {
 	if(!scene) return;
+	ENGINE_PROFILE_SCOPE("SceneManager::pushScene");
     pauseTopScene();
 	spdlog::debug("正在将场景 '{}' 压入栈。", scene->getSceneName());
 	// 初始化新场景
@@ -147,6 +241,7 @@ void SceneManager::pauseTopScene()
 	if (auto* current_scene = getCurrentScene()) {
 		current_scene->onPause();
 	}
+	context_.getRenderer().invalidateUnderlay();	// 被覆盖的场景变了，下一帧重新捕获
 }
 
 void SceneManager::resumeTopScene()
@@ -154,6 +249,7 @@ void SceneManager::resumeTopScene()
 	if (auto* current_scene = getCurrentScene()) {
 		current_scene->onResume();
 	}
+	context_.getRenderer().invalidateUnderlay();
 }
 
 /**
@@ -161,13 +257,14 @@ void SceneManager::resumeTopScene()
  */
 void SceneManager::popScene()
 {
+	ENGINE_PROFILE_SCOPE("SceneManager::popScene");
 	if (scene_stack_.empty()) {
 		spdlog::warn("尝试弹出场景失败：场景栈为空。");
 		context_.getDispatcher().trigger<utils::QuitEvent>();
 		return;
 	}
 	if (scene_stack_.back()) {
-		scene_stack_.back()->clean();       // 显式调用清理
+		cleanScene(*scene_stack_.back());   // 显式调用清理
 	}
 	scene_stack_.pop_back();
    resumeTopScene();
@@ -180,6 +277,7 @@ void SceneManager::popScene()
 void SceneManager::replaceScene(std::unique_ptr<Scene>&& scene)
 {
 	if (!scene) return;
+	ENGINE_PROFILE_SCOPE("SceneManager::replaceScene");
 
 	std::string old_scene_name = scene_stack_.empty() ? "None" : scene_stack_.back()->getSceneName();
 	spdlog::debug("正在用场景 '{}' 替换场景 '{}' 。", scene->getSceneName(), old_scene_name);
@@ -187,7 +285,7 @@ void SceneManager::replaceScene(std::unique_ptr<Scene>&& scene)
 	// 清理并移除场景栈中所有场景
 	while (!scene_stack_.empty()) {
 		if (scene_stack_.back()) {
-			scene_stack_.back()->clean();
+			cleanScene(*scene_stack_.back());
 		}
 		scene_stack_.pop_back();
 	}
@@ -216,7 +314,43 @@ void SceneManager::onPushScene(utils::PushSceneEvent &event)
 void SceneManager::onReplaceScene(utils::ReplaceSceneEvent &event)
 {
 	pending_action_ = PendingAction::Replace;
+	if (auto prefetched = takePrefetchedScene(event.prefetch_key)) {
+		spdlog::debug("使用预取的场景 '{}' 。", prefetched->getSceneName());
+		pending_scene_ = std::move(prefetched);
+		return;
+	}
 	pending_scene_ = std::move(event.scene);
 }
 
+void SceneManager::onPrefetchScene(utils::PrefetchSceneEvent &event)
+{
+	if (!event.scene || event.key == entt::id_type{}) return;
+	if (hasPrefetchedScene(event.key)) {
+		return;     // 同一场景已在预取，保留已完成的进度
+	}
+	cancelPrefetch();
+	spdlog::debug("开始预取场景 '{}' (key={})。", event.scene->getSceneName(), event.key);
+	prefetched_key_ = event.key;
+	prefetched_scene_ = std::move(event.scene);
+	prefetched_scene_->prefetch();
+}
+
+void SceneManager::cancelPrefetch()
+{
+	if (prefetched_scene_) {
+		spdlog::debug("丢弃预取的场景 '{}' 。", prefetched_scene_->getSceneName());
+	}
+	prefetched_scene_.reset();
+	prefetched_key_ = {};
+}
+
+std::unique_ptr<Scene> SceneManager::takePrefetchedScene(entt::id_type key)
+{
+	if (key == entt::id_type{} || !hasPrefetchedScene(key)) {
+		return nullptr;
+	}
+	prefetched_key_ = {};
+	return std::move(prefetched_scene_);
+}
+
 } // namespace engine::scene
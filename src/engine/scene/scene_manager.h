@@ -19,6 +19,12 @@ namespace engine::scene {
 	 *
 	 * 采用“延迟处理”机制（Pending Actions），确保在帧更新期间请求场景切换时，
 	 * 不会立即破坏当前正在遍历的场景数据，而是在帧末尾统一处理。
+	 *
+	 * 预取（Prefetch）：场景可以提前把下一个场景交给管理器（PrefetchSceneEvent），
+	 * 管理器立即调用其 prefetch() 并每帧调用 updatePrefetch()，使加载与当前场景并行；
+	 * 之后以相同 key 请求替换时直接换上该场景，init() 只需消费已就绪的结果。
+	 * 预取场景的 isReadyToInit() 为 false 时切换推迟到它加载完成，其间当前场景照常更新，
+	 * 并每帧经 onLoadProgress() 收到加载进度。
 	 */
 	class SceneManager {
 	private:
@@ -38,6 +44,9 @@ namespace engine::scene {
 		PendingAction pending_action_ = PendingAction::None; ///< 当前帧末尾要执行的操作
 		std::unique_ptr<Scene> pending_scene_;               ///< 待处理的目标场景实例
 
+		std::unique_ptr<Scene> prefetched_scene_;            ///< 正在后台预取、尚未进入场景栈的场景
+		entt::id_type prefetched_key_{};                     ///< prefetched_scene_ 的标识
+
 	public:
 		/**
 		 * @brief 构造场景管理器。
@@ -57,6 +66,13 @@ namespace engine::scene {
 		void onPopScene();
 		void onPushScene(utils::PushSceneEvent& event);
 		void onReplaceScene(utils::ReplaceSceneEvent& event);
+		void onPrefetchScene(utils::PrefetchSceneEvent& event);
+
+		/** @brief 是否存在以 key 标识的预取场景 */
+		[[nodiscard]] bool hasPrefetchedScene(entt::id_type key) const { return prefetched_scene_ && prefetched_key_ == key; }
+
+		/** @brief 丢弃预取场景（等待其后台任务结束） */
+		void cancelPrefetch();
 		/**
 		 * @brief 获取当前正处于栈顶的活动场景。
 		 * @return Scene* 指向当前场景的指针，如果栈为空则返回 nullptr。
@@ -83,6 +99,9 @@ namespace engine::scene {
 		/** @brief 立即清理场景栈并调用所有场景的 clean() 方法。 */
 		void close();
 
+		/** @brief 刷新 MemoryTracker 中由上报得到的用量：当前场景、纹理与音频缓冲。 */
+		void reportMemoryUsage() const;
+
 		/** @brief 获取会话数据实例 */
 		std::shared_ptr<game::data::SessionData> getSessionData() {
 			return session_data_;
@@ -98,9 +117,15 @@ namespace engine::scene {
 		bool isSessionDataInitialized() const { return session_data_initialized_; }
 
 	private:
+		/** @brief 取出与 key 匹配的预取场景，未命中时返回 nullptr */
+		std::unique_ptr<Scene> takePrefetchedScene(entt::id_type key);
+
 		/** @brief 处理由 requestXXX 函数提交的异步操作。 */
 		void processPendingActions();
 
+		/** @brief 场景退出前输出内存报告（--memreport 开启时），随后调用其 clean()。 */
+		void cleanScene(Scene& scene);
+
 		/** @brief 内部执行：初始化新场景并压入栈。 */
 		void pushScene(std::unique_ptr<Scene>&& scene);
 		/** @brief 内部执行：暂停当前栈顶场景。 */
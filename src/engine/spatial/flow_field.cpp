@@ -0,0 +1,333 @@
+/**
+ * @file flow_field.cpp
+ * @brief FlowField 类的实现：Dijkstra 积分代价、方向码与增量更新。
+ */
+
+#include "flow_field.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace engine::spatial {
+
+    namespace {
+        constexpr float DIAGONAL = 0.70710678f;
+
+        /// 与 FlowField::OFFSETS 一一对应的单位方向
+        constexpr std::array<glm::vec2, 8> UNIT_DIRECTIONS{ {
+            { 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f },
+            { DIAGONAL, DIAGONAL }, { -DIAGONAL, DIAGONAL }, { DIAGONAL, -DIAGONAL }, { -DIAGONAL, -DIAGONAL } } };
+
+        constexpr std::uint32_t stepCost(std::size_t dir) {
+            return dir < 4 ? FlowField::ORTHOGONAL_STEP : FlowField::DIAGONAL_STEP;
+        }
+    } // namespace
+
+    void FlowField::build(const glm::vec2& origin, float cell_size, const glm::ivec2& size,
+                          std::vector<std::uint8_t> costs, std::span<const glm::vec2> goals)
+    {
+        clear();
+        if (size.x <= 0 || size.y <= 0 || cell_size <= 0.0f
+            || costs.size() != static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y)) {
+            spdlog::error("FlowField: 无效的网格 ({}x{}, 格子 {}, 权重 {} 个)", size.x, size.y, cell_size, costs.size());
+            return;
+        }
+
+        origin_ = origin;
+        cell_size_ = cell_size;
+        size_ = size;
+        costs_ = std::move(costs);
+        integration_.assign(costs_.size(), UNREACHABLE);
+        directions_.assign(costs_.size(), DIR_NONE);
+
+        std::vector<HeapItem> heap;
+        for (const auto& goal : goals) {
+            const int cell = cellAt(goal);
+            if (cell < 0) {
+                spdlog::warn("FlowField: 目标点 ({}, {}) 在网格外，已忽略", goal.x, goal.y);
+                continue;
+            }
+            // 目标格子始终可通行，否则流场会以一个不可进入的格子为终点
+            costs_[cell] = std::max(costs_[cell], DEFAULT_COST);
+            integration_[cell] = 0;
+            directions_[cell] = DIR_GOAL;
+            heap.push_back(HeapItem{ 0, cell });
+        }
+        base_costs_ = costs_;
+
+        changed_.clear();
+        propagate(heap);
+        for (int cell = 0; cell < static_cast<int>(costs_.size()); ++cell) {
+            updateDirection(cell);
+        }
+        last_updated_cells_ = changed_.size();
+        if (goals.empty()) {
+            spdlog::warn("FlowField: 没有目标点，所有格子都不可达");
+        }
+    }
+
+    void FlowField::clear() {
+        size_ = glm::ivec2{ 0 };
+        base_costs_.clear();
+        costs_.clear();
+        integration_.clear();
+        directions_.clear();
+        changed_.clear();
+        last_updated_cells_ = 0;
+    }
+
+    void FlowField::setCellCost(int cell, std::uint8_t cost) {
+        if (!isValidCell(cell)) {
+            return;
+        }
+        if (directions_[cell] == DIR_GOAL) {
+            cost = std::max(cost, DEFAULT_COST);
+        }
+        const std::uint8_t old_cost = costs_[cell];
+        if (old_cost == cost) {
+            return;
+        }
+        costs_[cell] = cost;
+        changed_.clear();
+
+        const int columns = size_.x;
+        const glm::ivec2 coord{ cell % columns, cell / columns };
+        auto in_bounds = [&](const glm::ivec2& c) { return c.x >= 0 && c.y >= 0 && c.x < size_.x && c.y < size_.y; };
+
+        std::vector<HeapItem> heap;
+        std::vector<int> invalidated;
+        if (old_cost == BLOCKED) {
+            // 变为可通行：先由邻格求出本格的代价，再连同邻格一起松弛（墙角两侧的对角边也随之打开）
+            for (std::size_t dir = 0; dir < OFFSETS.size(); ++dir) {
+                const int from = neighbor(cell, dir);
+                if (from >= 0 && integration_[from] != UNREACHABLE) {
+                    const std::uint32_t candidate = integration_[from] + stepCost(dir) * costs_[from];
+                    if (candidate < integration_[cell]) {
+                        integration_[cell] = candidate;
+                    }
+                }
+            }
+            if (integration_[cell] != UNREACHABLE) {
+                changed_.push_back(cell);
+                heap.push_back(HeapItem{ integration_[cell], cell });
+            }
+            for (const auto& offset : OFFSETS) {
+                if (const auto other = coord + offset; in_bounds(other)) {
+                    const int other_cell = other.y * columns + other.x;
+                    if (integration_[other_cell] != UNREACHABLE) {
+                        heap.push_back(HeapItem{ integration_[other_cell], other_cell });
+                    }
+                }
+            }
+        } else if (cost != BLOCKED && cost < old_cost) {
+            // 进入本格变便宜：只可能让经过本格的邻格代价变小，从本格重新松弛即可
+            if (integration_[cell] != UNREACHABLE) {
+                heap.push_back(HeapItem{ integration_[cell], cell });
+            }
+        } else {
+            // 进入本格变贵（或不可通行）：经过本格的子树失效。不可通行时本格自身以及
+            // 斜穿其墙角的格子也失效
+            std::vector<int> roots;
+            for (std::size_t dir = 0; dir < OFFSETS.size(); ++dir) {
+                const auto child = coord - OFFSETS[dir];
+                if (!in_bounds(child)) {
+                    continue;
+                }
+                const int child_cell = child.y * columns + child.x;
+                if (directions_[child_cell] == dir) {
+                    roots.push_back(child_cell);
+                }
+            }
+            if (cost == BLOCKED) {
+                roots.push_back(cell);
+                for (const auto& offset : OFFSETS) {
+                    const auto other = coord + offset;
+                    if (!in_bounds(other)) {
+                        continue;
+                    }
+                    const int other_cell = other.y * columns + other.x;
+                    const auto dir = directions_[other_cell];
+                    if (dir < 4 || dir >= OFFSETS.size()) {
+                        continue;
+                    }
+                    // other 的对角移动经过的两个正交格之一是本格
+                    const auto step = OFFSETS[dir];
+                    if (other + glm::ivec2{ step.x, 0 } == coord || other + glm::ivec2{ 0, step.y } == coord) {
+                        roots.push_back(other_cell);
+                    }
+                }
+            }
+            invalidated = invalidateSubtree(roots);
+
+            // 子树边界上未受影响的格子仍是最优的，以它们为起点重新扩展进失效区域
+            for (const int lost : invalidated) {
+                const glm::ivec2 lost_coord{ lost % columns, lost / columns };
+                for (const auto& offset : OFFSETS) {
+                    if (const auto other = lost_coord + offset; in_bounds(other)) {
+                        const int other_cell = other.y * columns + other.x;
+                        if (integration_[other_cell] != UNREACHABLE && costs_[other_cell] != BLOCKED) {
+                            heap.push_back(HeapItem{ integration_[other_cell], other_cell });
+                        }
+                    }
+                }
+            }
+        }
+
+        std::make_heap(heap.begin(), heap.end(), std::greater<>{});
+        propagate(heap);
+
+        // 方向只取决于邻格的积分代价与权重：重算代价变化的格子、失效格子与本格周围一圈
+        auto refresh_around = [&](int center) {
+            const glm::ivec2 center_coord{ center % columns, center / columns };
+            updateDirection(center);
+            for (const auto& offset : OFFSETS) {
+                if (const auto other = center_coord + offset; in_bounds(other)) {
+                    updateDirection(other.y * columns + other.x);
+                }
+            }
+        };
+        refresh_around(cell);
+        for (const int changed : changed_) {
+            refresh_around(changed);
+        }
+        for (const int lost : invalidated) {
+            refresh_around(lost);
+        }
+        last_updated_cells_ = changed_.size() + invalidated.size();
+    }
+
+    void FlowField::resetCellCost(int cell) {
+        if (isValidCell(cell)) {
+            setCellCost(cell, base_costs_[cell]);
+        }
+    }
+
+    int FlowField::cellAt(const glm::vec2& position) const {
+        if (!isBuilt()) {
+            return -1;
+        }
+        const float x = std::floor((position.x - origin_.x) / cell_size_);
+        const float y = std::floor((position.y - origin_.y) / cell_size_);
+        if (x < 0.0f || y < 0.0f || x >= static_cast<float>(size_.x) || y >= static_cast<float>(size_.y)) {
+            return -1;
+        }
+        return static_cast<int>(y) * size_.x + static_cast<int>(x);
+    }
+
+    glm::vec2 FlowField::cellCenter(int cell) const {
+        const glm::vec2 coord{ static_cast<float>(cell % size_.x), static_cast<float>(cell / size_.x) };
+        return origin_ + (coord + 0.5f) * cell_size_;
+    }
+
+    glm::vec2 FlowField::sample(const glm::vec2& position) const {
+        const int cell = cellAt(position);
+        if (cell < 0) {
+            return glm::vec2{ 0.0f };
+        }
+        const auto dir = directions_[cell];
+        return dir < UNIT_DIRECTIONS.size() ? UNIT_DIRECTIONS[dir] : glm::vec2{ 0.0f };
+    }
+
+    float FlowField::distance(int cell) const {
+        if (!isReachable(cell)) {
+            return std::numeric_limits<float>::max();
+        }
+        return static_cast<float>(integration_[cell]) * cell_size_ / static_cast<float>(ORTHOGONAL_STEP);
+    }
+
+    int FlowField::neighbor(int cell, std::size_t dir) const {
+        const glm::ivec2 coord{ cell % size_.x, cell / size_.x };
+        const auto offset = OFFSETS[dir];
+        const auto target = coord + offset;
+        if (target.x < 0 || target.y < 0 || target.x >= size_.x || target.y >= size_.y) {
+            return -1;
+        }
+        const int target_cell = target.y * size_.x + target.x;
+        if (costs_[target_cell] == BLOCKED) {
+            return -1;
+        }
+        if (dir >= 4) {
+            // 不穿墙角：两个正交的相邻格都须可通行（这两个格子必在网格内）
+            if (costs_[coord.y * size_.x + target.x] == BLOCKED || costs_[target.y * size_.x + coord.x] == BLOCKED) {
+                return -1;
+            }
+        }
+        return target_cell;
+    }
+
+    void FlowField::propagate(std::vector<HeapItem>& heap) {
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<>{});
+            const auto [cost, cell] = heap.back();
+            heap.pop_back();
+            if (cost != integration_[cell]) {
+                continue;   // 过期条目
+            }
+            // 邻格 next 进入本格的代价：步长 × 本格权重
+            for (std::size_t dir = 0; dir < OFFSETS.size(); ++dir) {
+                const int next = neighbor(cell, dir);
+                if (next < 0) {
+                    continue;
+                }
+                const std::uint32_t candidate = cost + stepCost(dir) * costs_[cell];
+                if (candidate < integration_[next]) {
+                    integration_[next] = candidate;
+                    changed_.push_back(next);
+                    heap.push_back(HeapItem{ candidate, next });
+                    std::push_heap(heap.begin(), heap.end(), std::greater<>{});
+                }
+            }
+        }
+    }
+
+    void FlowField::updateDirection(int cell) {
+        if (directions_[cell] == DIR_GOAL) {
+            return;
+        }
+        directions_[cell] = DIR_NONE;
+        if (costs_[cell] == BLOCKED || integration_[cell] == UNREACHABLE) {
+            return;
+        }
+        std::uint32_t best = UNREACHABLE;
+        for (std::size_t dir = 0; dir < OFFSETS.size(); ++dir) {
+            const int next = neighbor(cell, dir);
+            if (next < 0 || integration_[next] == UNREACHABLE) {
+                continue;
+            }
+            const std::uint32_t candidate = integration_[next] + stepCost(dir) * costs_[next];
+            if (candidate < best) {
+                best = candidate;
+                directions_[cell] = static_cast<std::uint8_t>(dir);
+            }
+        }
+    }
+
+    std::vector<int> FlowField::invalidateSubtree(std::span<const int> roots) {
+        std::vector<int> subtree;
+        for (const int root : roots) {
+            if (integration_[root] != UNREACHABLE && directions_[root] != DIR_GOAL) {
+                integration_[root] = UNREACHABLE;
+                subtree.push_back(root);
+            }
+        }
+        // subtree 同时作为遍历队列：方向码指向已失效格子的邻格也失效
+        for (std::size_t i = 0; i < subtree.size(); ++i) {
+            const int parent = subtree[i];
+            const glm::ivec2 coord{ parent % size_.x, parent / size_.x };
+            for (std::size_t dir = 0; dir < OFFSETS.size(); ++dir) {
+                const auto child = coord - OFFSETS[dir];
+                if (child.x < 0 || child.y < 0 || child.x >= size_.x || child.y >= size_.y) {
+                    continue;
+                }
+                const int child_cell = child.y * size_.x + child.x;
+                if (directions_[child_cell] == dir && integration_[child_cell] != UNREACHABLE) {
+                    integration_[child_cell] = UNREACHABLE;
+                    subtree.push_back(child_cell);
+                }
+            }
+        }
+        return subtree;
+    }
+
+} // namespace engine::spatial
@@ -0,0 +1,154 @@
+/**
+ * @file flow_field.h
+ * @brief 定义 FlowField 类，基于格子代价的多目标流场导航。
+ *
+ * @details
+ * 从目标格子出发做一次 Dijkstra，得到每个格子到最近目标的积分代价（integration field），
+ * 再为每个格子记下代价最小的相邻格子方向。单位导航时只需查所在格子的方向，
+ * 每个单位 O(1)，与单位数量无关；同一目标集合的所有单位共用一份流场。
+ *
+ * @par 代价模型
+ * - 每个格子一个 8 位权重：0 表示不可通行，其余值乘以步长即进入该格子的代价
+ * - 8 邻接：正交步长 10、对角步长 14；对角移动要求两个相邻的正交格都可通行（不穿墙角）
+ * - 目标格子的积分代价恒为 0
+ *
+ * @par 增量更新
+ * setCellCost() 只重算受影响的区域，而不是整张图：
+ * - 权重降低（或格子变为可通行）：从该格子重新松弛，只向代价变小的格子扩展
+ * - 权重升高（或格子变为不可通行）：沿方向格子反查出经过该格子的子树，置为不可达后
+ *   以子树边界上未受影响的格子为起点重新做 Dijkstra
+ * 之后只重算积分代价变化的格子及其邻格的方向。
+ *
+ * @par 使用示例
+ * @code
+ * field.build(origin, 32.0f, {40, 30}, std::move(costs), goals);
+ * velocity = field.sample(position) * speed;
+ * field.setCellCost(field.cellAt(tower_position), 8);     // 建造位被占用，绕行但不封死
+ * @endcode
+ */
+
+#pragma once
+#include <glm/vec2.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace engine::spatial {
+
+    /**
+     * @class FlowField
+     * @brief 均匀网格上的多目标流场：积分代价 + 每格的前进方向。
+     */
+    class FlowField final {
+    public:
+        static constexpr std::uint8_t BLOCKED = 0;                  ///< 不可通行格子的权重
+        static constexpr std::uint8_t DEFAULT_COST = 1;             ///< 普通格子的权重
+        static constexpr std::uint32_t UNREACHABLE = std::numeric_limits<std::uint32_t>::max();
+        static constexpr std::uint32_t ORTHOGONAL_STEP = 10;        ///< 正交移动的步长代价
+        static constexpr std::uint32_t DIAGONAL_STEP = 14;          ///< 对角移动的步长代价（约 10·√2）
+
+        /**
+         * @brief 构建流场
+         * @param origin 网格左上角的世界坐标
+         * @param cell_size 格子边长（像素）
+         * @param size 网格大小（列数, 行数）
+         * @param costs 每个格子的权重（行优先，大小须为 列数 × 行数），0 为不可通行
+         * @param goals 目标点（世界坐标），网格外的点被忽略
+         */
+        void build(const glm::vec2& origin, float cell_size, const glm::ivec2& size,
+                   std::vector<std::uint8_t> costs, std::span<const glm::vec2> goals);
+
+        /** @brief 清空流场（isBuilt() 返回 false） */
+        void clear();
+
+        /**
+         * @brief 修改一个格子的权重并增量更新流场
+         * @param cell 格子下标（cellAt() 的返回值，负数或越界时忽略）
+         * @param cost 新权重，0 为不可通行
+         */
+        void setCellCost(int cell, std::uint8_t cost);
+
+        /** @brief 把格子的权重恢复为 build() 时的值 */
+        void resetCellCost(int cell);
+
+        /** @brief 世界坐标所在的格子下标，网格外返回 -1 */
+        [[nodiscard]] int cellAt(const glm::vec2& position) const;
+
+        /** @brief 格子中心的世界坐标 */
+        [[nodiscard]] glm::vec2 cellCenter(int cell) const;
+
+        /**
+         * @brief 查询世界坐标处的前进方向
+         * @return 单位向量；网格外、不可达或位于目标格子时返回零向量
+         */
+        [[nodiscard]] glm::vec2 sample(const glm::vec2& position) const;
+
+        /** @brief 格子是否为目标 */
+        [[nodiscard]] bool isGoal(int cell) const { return isValidCell(cell) && directions_[cell] == DIR_GOAL; }
+
+        /** @brief 格子能否到达任一目标（目标格子本身也算） */
+        [[nodiscard]] bool isReachable(int cell) const { return isValidCell(cell) && integration_[cell] != UNREACHABLE; }
+
+        /**
+         * @brief 格子到最近目标的加权距离（像素，积分代价按步长换算）
+         * @return 不可达时返回 float 最大值
+         */
+        [[nodiscard]] float distance(int cell) const;
+
+        [[nodiscard]] std::uint8_t getCellCost(int cell) const { return costs_[cell]; }
+        [[nodiscard]] std::uint32_t getIntegration(int cell) const { return integration_[cell]; }
+        [[nodiscard]] bool isBuilt() const { return !integration_.empty(); }
+        [[nodiscard]] const glm::ivec2& getSize() const { return size_; }
+        [[nodiscard]] float getCellSize() const { return cell_size_; }
+        [[nodiscard]] const glm::vec2& getOrigin() const { return origin_; }
+
+        /** @brief 最近一次 build() / setCellCost() 中积分代价被改写的次数（含失效的格子，性能计数用） */
+        [[nodiscard]] std::size_t getLastUpdatedCells() const { return last_updated_cells_; }
+
+    private:
+        static constexpr std::uint8_t DIR_GOAL = 8;     ///< 方向码：目标格子
+        static constexpr std::uint8_t DIR_NONE = 0xFF;  ///< 方向码：不可达或不可通行
+
+        /// 8 个邻接方向：前 4 个正交，后 4 个对角
+        static constexpr std::array<glm::ivec2, 8> OFFSETS{ {
+            { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+            { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 } } };
+
+        struct HeapItem {
+            std::uint32_t cost_;
+            int cell_;
+            bool operator>(const HeapItem& other) const { return cost_ > other.cost_; }
+        };
+
+        [[nodiscard]] bool isValidCell(int cell) const { return cell >= 0 && static_cast<std::size_t>(cell) < costs_.size(); }
+
+        /**
+         * @brief 从 cell 沿方向 dir 走一步到达的格子
+         * @return 越界、目标不可通行或对角穿墙角时返回 -1
+         */
+        [[nodiscard]] int neighbor(int cell, std::size_t dir) const;
+
+        /** @brief 以堆中的格子为起点做 Dijkstra 松弛，记录代价变化的格子 */
+        void propagate(std::vector<HeapItem>& heap);
+
+        /** @brief 按邻格积分代价重算一个格子的方向码 */
+        void updateDirection(int cell);
+
+        /** @brief 把以 roots 为根（沿方向码反查）的子树置为不可达，返回子树中的格子 */
+        std::vector<int> invalidateSubtree(std::span<const int> roots);
+
+        glm::vec2 origin_{ 0.0f };
+        float cell_size_{ 32.0f };
+        glm::ivec2 size_{ 0 };
+        std::vector<std::uint8_t> base_costs_;      ///< build() 时的权重，resetCellCost() 用
+        std::vector<std::uint8_t> costs_;           ///< 当前权重
+        std::vector<std::uint32_t> integration_;    ///< 到最近目标的积分代价
+        std::vector<std::uint8_t> directions_;      ///< 每格的方向码（OFFSETS 下标 / DIR_GOAL / DIR_NONE）
+        std::vector<int> changed_;                  ///< 本次更新中积分代价变化的格子（临时）
+        std::size_t last_updated_cells_{ 0 };
+    };
+
+} // namespace engine::spatial
@@ -0,0 +1,168 @@
+/**
+ * @file spatial_grid.cpp
+ * @brief SpatialGrid 类的实现。
+ *
+ * @details
+ * 重建流程（endBuild）：
+ * 1. 计算所有条目的包围盒，确定网格原点与单元数量
+ * 2. 第一遍统计每个单元的条目数，前缀和得到 cell_start_
+ * 3. 第二遍把条目写入对应单元的连续区间
+ */
+
+#include "spatial_grid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "../utils/logging.h"
+
+namespace engine::spatial {
+
+namespace {
+    /// 单元总数上限，防止个别离群坐标导致网格过大
+    constexpr std::size_t MAX_CELL_COUNT = 1u << 16;
+}
+
+SpatialGrid::SpatialGrid(float cell_size)
+    : configured_cell_size_(cell_size > 0.0f ? cell_size : 64.0f),
+      cell_size_(configured_cell_size_),
+      inv_cell_size_(1.0f / cell_size_) {
+}
+
+void SpatialGrid::beginBuild() {
+    pending_.clear();
+}
+
+void SpatialGrid::insert(entt::entity entity, const glm::vec2& position, std::uint32_t mask) {
+    pending_.push_back(Entry{entity, position, mask});
+}
+
+void SpatialGrid::endBuild() {
+    entries_.clear();
+    cell_start_.clear();
+    cells_x_ = 0;
+    cells_y_ = 0;
+    if (pending_.empty()) {
+        return;
+    }
+
+    glm::vec2 min_pos = pending_.front().position_;
+    glm::vec2 max_pos = min_pos;
+    for (const auto& entry : pending_) {
+        min_pos.x = std::min(min_pos.x, entry.position_.x);
+        min_pos.y = std::min(min_pos.y, entry.position_.y);
+        max_pos.x = std::max(max_pos.x, entry.position_.x);
+        max_pos.y = std::max(max_pos.y, entry.position_.y);
+    }
+
+    origin_ = min_pos;
+    cell_size_ = configured_cell_size_;
+    inv_cell_size_ = 1.0f / cell_size_;
+    cells_x_ = static_cast<int>((max_pos.x - min_pos.x) * inv_cell_size_) + 1;
+    cells_y_ = static_cast<int>((max_pos.y - min_pos.y) * inv_cell_size_) + 1;
+    while (static_cast<std::size_t>(cells_x_) * static_cast<std::size_t>(cells_y_) > MAX_CELL_COUNT) {
+        // 坐标范围异常大时放大本次重建的单元尺寸，保证网格规模可控；下次重建恢复为给定尺寸
+        cell_size_ *= 2.0f;
+        inv_cell_size_ = 1.0f / cell_size_;
+        cells_x_ = static_cast<int>((max_pos.x - min_pos.x) * inv_cell_size_) + 1;
+        cells_y_ = static_cast<int>((max_pos.y - min_pos.y) * inv_cell_size_) + 1;
+        ENGINE_LOG_WARN("SpatialGrid 范围过大，单元尺寸放大为 {}", cell_size_);
+    }
+
+    const std::size_t cell_count = static_cast<std::size_t>(cells_x_) * static_cast<std::size_t>(cells_y_);
+    cell_start_.assign(cell_count + 1, 0);
+
+    auto cell_of = [this](const glm::vec2& position) {
+        const int cx = clampCellX(position.x);
+        const int cy = clampCellY(position.y);
+        return static_cast<std::size_t>(cy) * static_cast<std::size_t>(cells_x_) + static_cast<std::size_t>(cx);
+    };
+
+    for (const auto& entry : pending_) {
+        ++cell_start_[cell_of(entry.position_) + 1];
+    }
+    for (std::size_t i = 1; i <= cell_count; ++i) {
+        cell_start_[i] += cell_start_[i - 1];
+    }
+
+    entries_.resize(pending_.size());
+    cursor_.assign(cell_start_.begin(), cell_start_.end() - 1);
+    for (const auto& entry : pending_) {
+        entries_[cursor_[cell_of(entry.position_)]++] = entry;
+    }
+}
+
+void SpatialGrid::queryRadius(const glm::vec2& center, float radius, std::uint32_t mask, std::vector<entt::entity>& out) const {
+    out.clear();
+    forEachInRadius(center, radius, mask, [&out](const Entry& entry, float) {
+        out.push_back(entry.entity_);
+    });
+}
+
+std::span<const entt::entity> SpatialGrid::queryCircle(const glm::vec2& center, float radius, std::uint32_t mask,
+                                                       std::pmr::vector<entt::entity>& out) const {
+    const std::size_t first = out.size();
+    forEachInRadius(center, radius, mask, [&out](const Entry& entry, float) {
+        out.push_back(entry.entity_);
+    });
+    return std::span<const entt::entity>(out).subspan(first);
+}
+
+std::span<const entt::entity> SpatialGrid::queryCone(const glm::vec2& apex, const glm::vec2& direction, float radius, float cos_half_angle,
+                                                     std::uint32_t mask, std::pmr::vector<entt::entity>& out) const {
+    const std::size_t first = out.size();
+    forEachInCone(apex, direction, radius, cos_half_angle, mask, [&out](const Entry& entry, float) {
+        out.push_back(entry.entity_);
+    });
+    return std::span<const entt::entity>(out).subspan(first);
+}
+
+std::span<const entt::entity> SpatialGrid::queryCapsule(const glm::vec2& from, const glm::vec2& to, float radius, std::uint32_t mask,
+                                                        std::pmr::vector<entt::entity>& out) const {
+    const std::size_t first = out.size();
+    forEachInCapsule(from, to, radius, mask, [&out](const Entry& entry, float) {
+        out.push_back(entry.entity_);
+    });
+    return std::span<const entt::entity>(out).subspan(first);
+}
+
+entt::entity SpatialGrid::queryNearest(const glm::vec2& center, float radius, std::uint32_t mask) const {
+    entt::entity best = entt::null;
+    float best_distance_sq = std::numeric_limits<float>::max();
+    forEachInRadius(center, radius, mask, [&](const Entry& entry, float distance_sq) {
+        if (distance_sq < best_distance_sq) {
+            best_distance_sq = distance_sq;
+            best = entry.entity_;
+        }
+    });
+    return best;
+}
+
+void SpatialGrid::queryNearestK(const glm::vec2& center, float radius, std::size_t k, std::uint32_t mask, std::vector<entt::entity>& out) const {
+    out.clear();
+    if (k == 0) {
+        return;
+    }
+    scratch_.clear();
+    forEachInRadius(center, radius, mask, [this](const Entry& entry, float distance_sq) {
+        scratch_.emplace_back(distance_sq, entry.entity_);
+    });
+    const auto count = std::min(k, scratch_.size());
+    std::partial_sort(scratch_.begin(), scratch_.begin() + static_cast<std::ptrdiff_t>(count), scratch_.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    out.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        out.push_back(scratch_[i].second);
+    }
+}
+
+int SpatialGrid::clampCellX(float x) const {
+    const int cell = static_cast<int>(std::floor((x - origin_.x) * inv_cell_size_));
+    return std::clamp(cell, 0, cells_x_ - 1);
+}
+
+int SpatialGrid::clampCellY(float y) const {
+    const int cell = static_cast<int>(std::floor((y - origin_.y) * inv_cell_size_));
+    return std::clamp(cell, 0, cells_y_ - 1);
+}
+
+} // namespace engine::spatial
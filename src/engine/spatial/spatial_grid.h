@@ -0,0 +1,297 @@
+/**
+ * @file spatial_grid.h
+ * @brief 定义 SpatialGrid 类，基于均匀网格的二维空间索引。
+ *
+ * @details
+ * SpatialGrid 将实体按位置划分到固定大小的网格单元中，用于加速半径查询与最近邻查询，
+ * 替代目标锁定、阻挡判定、鼠标拾取等系统中的 O(N×M) 暴力距离扫描。
+ *
+ * @par 数据布局
+ * 每次重建时先收集所有条目，再根据条目包围盒确定网格范围，使用计数排序把条目按单元
+ * 连续存放（cell_start_ 记录每个单元在 entries_ 中的起始下标），查询时只需访问
+ * 与查询圆相交的少量单元，内存访问连续、无逐单元分配。
+ *
+ * @par 分层过滤
+ * 每个条目携带一个 32 位图层掩码（如玩家、敌人、受伤单位），查询时传入掩码按位过滤。
+ * 掩码的具体含义由使用方（游戏层）定义，引擎层不依赖任何游戏组件。
+ *
+ * @par 使用示例
+ * @code
+ * grid.beginBuild();
+ * grid.insert(entity, position, LAYER_ENEMY);
+ * grid.endBuild();
+ * auto nearest = grid.queryNearest(center, radius, LAYER_ENEMY);
+ * @endcode
+ *
+ * @par 范围查询
+ * 溅射、扇形横扫与投射物穿透路径分别用圆形、扇形、胶囊体查询，只遍历形状包围盒覆盖的单元。
+ * 收集型查询把结果追加到调用方的 std::pmr::vector（通常以 FrameArena 为内存资源），返回本次追加的一段，
+ * 同一帧的多次查询共用一个容器而不逐次分配。
+ *
+ * @note 网格中保存的是重建时刻的实体句柄与位置，使用方在访问组件前仍需用 registry.valid() 校验。
+ */
+
+#pragma once
+#include <entt/entity/entity.hpp>
+#include <glm/vec2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace engine::spatial {
+
+    /**
+     * @class SpatialGrid
+     * @brief 均匀网格空间索引，支持按图层掩码过滤的半径查询与最近 k 个查询。
+     */
+    class SpatialGrid final {
+    public:
+        /**
+         * @struct Entry
+         * @brief 网格中的一个条目。
+         */
+        struct Entry {
+            entt::entity entity_{entt::null};   ///< 实体句柄
+            glm::vec2 position_{0.0f, 0.0f};    ///< 重建时刻的位置
+            std::uint32_t mask_{0};             ///< 图层掩码
+        };
+
+        /**
+         * @brief 构造函数
+         * @param cell_size 网格单元边长（像素），应与常见查询半径同一量级
+         */
+        explicit SpatialGrid(float cell_size = 64.0f);
+
+        /** @brief 开始一次重建，清空上次的条目 */
+        void beginBuild();
+
+        /**
+         * @brief 添加一个条目（需在 beginBuild() 与 endBuild() 之间调用）
+         * @param entity 实体句柄
+         * @param position 实体位置
+         * @param mask 图层掩码
+         */
+        void insert(entt::entity entity, const glm::vec2& position, std::uint32_t mask);
+
+        /** @brief 结束重建，按单元整理条目 */
+        void endBuild();
+
+        /**
+         * @brief 遍历半径内所有匹配掩码的条目
+         * @tparam Func 可调用对象，签名为 void(const Entry&, float distance_sq)
+         * @param center 查询圆心
+         * @param radius 查询半径
+         * @param mask 图层掩码，条目掩码与之按位与非零即匹配
+         * @param func 回调
+         */
+        template<typename Func>
+        void forEachInRadius(const glm::vec2& center, float radius, std::uint32_t mask, Func&& func) const {
+            if (entries_.empty() || radius < 0.0f) {
+                return;
+            }
+            const float radius_sq = radius * radius;
+            const int min_x = clampCellX(center.x - radius);
+            const int max_x = clampCellX(center.x + radius);
+            const int min_y = clampCellY(center.y - radius);
+            const int max_y = clampCellY(center.y + radius);
+            for (int cy = min_y; cy <= max_y; ++cy) {
+                for (int cx = min_x; cx <= max_x; ++cx) {
+                    const auto cell = static_cast<std::size_t>(cy) * static_cast<std::size_t>(cells_x_) + static_cast<std::size_t>(cx);
+                    for (auto i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i) {
+                        const auto& entry = entries_[i];
+                        if ((entry.mask_ & mask) == 0) {
+                            continue;
+                        }
+                        const glm::vec2 delta = entry.position_ - center;
+                        const float distance_sq = delta.x * delta.x + delta.y * delta.y;
+                        if (distance_sq <= radius_sq) {
+                            func(entry, distance_sq);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief 遍历扇形内所有匹配掩码的条目（含顶点处的条目）
+         * @param apex 扇形顶点
+         * @param direction 扇形中心方向（单位向量）
+         * @param radius 扇形半径
+         * @param cos_half_angle 半张角的余弦，条目方向与 direction 夹角的余弦不小于它即在扇形内
+         * @param func 回调，签名为 void(const Entry&, float distance_sq)
+         */
+        template<typename Func>
+        void forEachInCone(const glm::vec2& apex, const glm::vec2& direction, float radius, float cos_half_angle,
+                           std::uint32_t mask, Func&& func) const {
+            forEachInRadius(apex, radius, mask, [&](const Entry& entry, float distance_sq) {
+                const glm::vec2 delta = entry.position_ - apex;
+                const float along = delta.x * direction.x + delta.y * direction.y;
+                // 比较平方避免开方：along >= cos * |delta|，along 为负时只有半张角超过 90° 才可能命中
+                const float bound = cos_half_angle * cos_half_angle * distance_sq;
+                const bool inside = cos_half_angle >= 0.0f ? (along >= 0.0f && along * along >= bound)
+                                                           : (along >= 0.0f || along * along <= bound);
+                if (distance_sq == 0.0f || inside) {
+                    func(entry, distance_sq);
+                }
+            });
+        }
+
+        /**
+         * @brief 遍历胶囊体（线段 from→to 外扩 radius）内所有匹配掩码的条目
+         * @param func 回调，签名为 void(const Entry&, float distance_sq)，distance_sq 为到线段的距离平方
+         */
+        template<typename Func>
+        void forEachInCapsule(const glm::vec2& from, const glm::vec2& to, float radius, std::uint32_t mask, Func&& func) const {
+            if (entries_.empty() || radius < 0.0f) {
+                return;
+            }
+            const glm::vec2 segment = to - from;
+            const float length_sq = segment.x * segment.x + segment.y * segment.y;
+            const float inv_length_sq = length_sq > 0.0f ? 1.0f / length_sq : 0.0f;
+            const float radius_sq = radius * radius;
+            const int min_x = clampCellX((from.x < to.x ? from.x : to.x) - radius);
+            const int max_x = clampCellX((from.x < to.x ? to.x : from.x) + radius);
+            const int min_y = clampCellY((from.y < to.y ? from.y : to.y) - radius);
+            const int max_y = clampCellY((from.y < to.y ? to.y : from.y) + radius);
+            for (int cy = min_y; cy <= max_y; ++cy) {
+                for (int cx = min_x; cx <= max_x; ++cx) {
+                    const auto cell = static_cast<std::size_t>(cy) * static_cast<std::size_t>(cells_x_) + static_cast<std::size_t>(cx);
+                    for (auto i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i) {
+                        const auto& entry = entries_[i];
+                        if ((entry.mask_ & mask) == 0) {
+                            continue;
+                        }
+                        const glm::vec2 delta = entry.position_ - from;
+                        float t = (delta.x * segment.x + delta.y * segment.y) * inv_length_sq;
+                        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+                        const float dx = delta.x - segment.x * t;
+                        const float dy = delta.y - segment.y * t;
+                        const float distance_sq = dx * dx + dy * dy;
+                        if (distance_sq <= radius_sq) {
+                            func(entry, distance_sq);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief 有上限的邻近遍历：先查 center 所在单元，再查与圆相交的相邻单元（最多一圈），
+         *        匹配掩码的条目累计检查 max_checks 个后停止
+         * @details 供分离/避让这类每个实体都要做的查询：单元再拥挤，每个实体的开销也有上限，
+         *          总开销与实体数成线性。半径大于单元边长时只取相邻一圈，圈外的条目不检查。
+         * @param func 回调，签名为 void(const Entry&, float distance_sq)，只对圆内的条目调用
+         * @return 实际检查（做了距离判断）的条目数
+         */
+        template<typename Func>
+        std::size_t forEachNearby(const glm::vec2& center, float radius, std::uint32_t mask, std::size_t max_checks,
+                                  Func&& func) const {
+            if (entries_.empty() || radius < 0.0f || max_checks == 0) {
+                return 0;
+            }
+            const float radius_sq = radius * radius;
+            const int own_x = clampCellX(center.x);
+            const int own_y = clampCellY(center.y);
+            std::size_t checks = 0;
+            // 返回 false 表示已达上限
+            auto visit = [&](int cx, int cy) {
+                const auto cell = static_cast<std::size_t>(cy) * static_cast<std::size_t>(cells_x_) + static_cast<std::size_t>(cx);
+                for (auto i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i) {
+                    const auto& entry = entries_[i];
+                    if ((entry.mask_ & mask) == 0) {
+                        continue;
+                    }
+                    const glm::vec2 delta = entry.position_ - center;
+                    const float distance_sq = delta.x * delta.x + delta.y * delta.y;
+                    if (distance_sq <= radius_sq) {
+                        func(entry, distance_sq);
+                    }
+                    if (++checks >= max_checks) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            if (!visit(own_x, own_y)) {
+                return checks;
+            }
+            const int min_x = own_x - 1 > clampCellX(center.x - radius) ? own_x - 1 : clampCellX(center.x - radius);
+            const int max_x = own_x + 1 < clampCellX(center.x + radius) ? own_x + 1 : clampCellX(center.x + radius);
+            const int min_y = own_y - 1 > clampCellY(center.y - radius) ? own_y - 1 : clampCellY(center.y - radius);
+            const int max_y = own_y + 1 < clampCellY(center.y + radius) ? own_y + 1 : clampCellY(center.y + radius);
+            for (int cy = min_y; cy <= max_y; ++cy) {
+                for (int cx = min_x; cx <= max_x; ++cx) {
+                    if ((cx != own_x || cy != own_y) && !visit(cx, cy)) {
+                        return checks;
+                    }
+                }
+            }
+            return checks;
+        }
+
+        /**
+         * @brief 收集圆内所有匹配掩码的实体，追加到 out 末尾
+         * @return 本次追加的一段，在下一次向 out 追加之前有效
+         */
+        std::span<const entt::entity> queryCircle(const glm::vec2& center, float radius, std::uint32_t mask,
+                                                  std::pmr::vector<entt::entity>& out) const;
+
+        /// @brief 收集扇形内所有匹配掩码的实体，追加到 out 末尾（参数见 forEachInCone）
+        std::span<const entt::entity> queryCone(const glm::vec2& apex, const glm::vec2& direction, float radius, float cos_half_angle,
+                                                std::uint32_t mask, std::pmr::vector<entt::entity>& out) const;
+
+        /// @brief 收集胶囊体内所有匹配掩码的实体，追加到 out 末尾
+        std::span<const entt::entity> queryCapsule(const glm::vec2& from, const glm::vec2& to, float radius, std::uint32_t mask,
+                                                   std::pmr::vector<entt::entity>& out) const;
+
+        /**
+         * @brief 收集半径内所有匹配掩码的实体
+         * @param center 查询圆心
+         * @param radius 查询半径
+         * @param mask 图层掩码
+         * @param out 输出列表（会先被清空）
+         */
+        void queryRadius(const glm::vec2& center, float radius, std::uint32_t mask, std::vector<entt::entity>& out) const;
+
+        /**
+         * @brief 查询半径内距离最近的匹配实体
+         * @return 最近的实体，不存在时返回 entt::null
+         */
+        [[nodiscard]] entt::entity queryNearest(const glm::vec2& center, float radius, std::uint32_t mask) const;
+
+        /**
+         * @brief 查询半径内距离最近的 k 个匹配实体，按距离升序输出
+         * @param out 输出列表（会先被清空）
+         */
+        void queryNearestK(const glm::vec2& center, float radius, std::size_t k, std::uint32_t mask, std::vector<entt::entity>& out) const;
+
+        /** @brief 当前条目数量 */
+        [[nodiscard]] std::size_t size() const { return entries_.size(); }
+
+        /** @brief 上一次重建的全部条目（按单元排列），用于小地图等整体遍历 */
+        [[nodiscard]] std::span<const Entry> getEntries() const { return entries_; }
+
+        /** @brief 上一次重建使用的网格单元边长 */
+        [[nodiscard]] float getCellSize() const { return cell_size_; }
+
+    private:
+        int clampCellX(float x) const;
+        int clampCellY(float y) const;
+
+        float configured_cell_size_;                ///< 构造时给定的单元边长，每次重建从它开始
+        float cell_size_;                           ///< 本次重建的单元边长（范围过大时临时放大）
+        float inv_cell_size_;                       ///< 本次重建的单元边长倒数
+        glm::vec2 origin_{0.0f, 0.0f};              ///< 网格左上角的世界坐标
+        int cells_x_{0};                            ///< 水平方向单元数
+        int cells_y_{0};                            ///< 垂直方向单元数
+        std::vector<Entry> pending_;                ///< 重建期间收集的条目
+        std::vector<Entry> entries_;                ///< 按单元连续排列的条目
+        std::vector<std::size_t> cell_start_;       ///< 每个单元在 entries_ 中的起始下标（长度为单元数 + 1）
+        std::vector<std::size_t> cursor_;           ///< 重建时每个单元的写入位置（复用缓冲）
+        mutable std::vector<std::pair<float, entt::entity>> scratch_;   ///< 最近 k 个查询的临时缓冲
+    };
+
+} // namespace engine::spatial
@@ -0,0 +1,84 @@
+/**
+ * @file tile_grid.cpp
+ * @brief TileGrid 类的实现：瓦片层合并与坐标换算。
+ */
+
+#include "tile_grid.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <entt/entity/registry.hpp>
+
+namespace engine::spatial {
+
+    void TileGrid::build(const entt::registry& registry, const glm::ivec2& map_size, const glm::ivec2& tile_size,
+                         const glm::vec2& origin)
+    {
+        clear();
+        if (map_size.x <= 0 || map_size.y <= 0 || tile_size.x <= 0 || tile_size.y <= 0) {
+            spdlog::error("TileGrid: 无效的网格 ({}x{}, 瓦片 {}x{})", map_size.x, map_size.y, tile_size.x, tile_size.y);
+            return;
+        }
+        size_ = map_size;
+        tile_size_ = tile_size;
+        origin_ = origin;
+        cells_.assign(static_cast<std::size_t>(map_size.x) * static_cast<std::size_t>(map_size.y),
+                      packCell(engine::component::TileType::EMPTY));
+
+        std::size_t layer_count = 0;
+        registry.view<engine::component::TileLayerComponent>().each([&](const auto& layer) {
+            if (layer.map_size_ != map_size || layer.cells_.size() != cells_.size()) {
+                return;
+            }
+            ++layer_count;
+            for (std::size_t i = 0; i < cells_.size(); ++i) {
+                const Cell incoming = layer.cells_[i];
+                const auto incoming_type = static_cast<engine::component::TileType>(incoming & TYPE_MASK);
+                auto type = static_cast<engine::component::TileType>(cells_[i] & TYPE_MASK);
+                // 特殊类型优先于 NORMAL，NORMAL 优先于 EMPTY
+                if (incoming_type != engine::component::TileType::EMPTY &&
+                    (type == engine::component::TileType::EMPTY || type == engine::component::TileType::NORMAL)) {
+                    type = incoming_type;
+                }
+                cells_[i] = packCell(type, static_cast<Cell>(cells_[i] | incoming));
+            }
+        });
+        spdlog::debug("TileGrid: 合并 {} 个瓦片层 ({}x{})，不可通行 {} 格", layer_count, map_size.x, map_size.y, countFlag(BLOCKED));
+    }
+
+    void TileGrid::clear() {
+        cells_.clear();
+        size_ = glm::ivec2{ 0 };
+        tile_size_ = glm::ivec2{ 0 };
+        origin_ = glm::vec2{ 0.0f };
+    }
+
+    int TileGrid::cellAt(const glm::vec2& position) const {
+        if (!isBuilt()) {
+            return -1;
+        }
+        const float x = std::floor((position.x - origin_.x) / static_cast<float>(tile_size_.x));
+        const float y = std::floor((position.y - origin_.y) / static_cast<float>(tile_size_.y));
+        if (x < 0.0f || y < 0.0f || x >= static_cast<float>(size_.x) || y >= static_cast<float>(size_.y)) {
+            return -1;
+        }
+        return static_cast<int>(y) * size_.x + static_cast<int>(x);
+    }
+
+    int TileGrid::indexOf(const glm::ivec2& coord) const {
+        if (coord.x < 0 || coord.y < 0 || coord.x >= size_.x || coord.y >= size_.y) {
+            return -1;
+        }
+        return coord.y * size_.x + coord.x;
+    }
+
+    glm::vec2 TileGrid::cellCenter(int cell) const {
+        const glm::vec2 coord{ coordOf(cell) };
+        return origin_ + (coord + 0.5f) * glm::vec2{ tile_size_ };
+    }
+
+    std::size_t TileGrid::countFlag(Cell flags) const {
+        return static_cast<std::size_t>(std::ranges::count_if(cells_, [flags](Cell cell) { return (cell & flags) != 0; }));
+    }
+
+} // namespace engine::spatial
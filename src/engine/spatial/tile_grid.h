@@ -0,0 +1,142 @@
+/**
+ * @file tile_grid.h
+ * @brief 定义 TileGrid 类，关卡瓦片层合并后的格子查询表。
+ *
+ * @details
+ * 每个格子一个字节：低 4 位为 TileType，高 4 位为属性标志。关卡加载时由 LevelLoader 为每个瓦片层
+ * 写好 TileLayerComponent::cells_，场景再调用一次 build() 把同尺寸的图层合并成一张表。
+ * 之后的障碍、危险格、建造位判断都是数组读取，不需要遍历瓦片实体（烘焙进区块的瓦片本来也没有实体）。
+ *
+ * @par 图层合并
+ * - 属性标志按位或：任一图层在该格是 SOLID，合并后的格子就有 BLOCKED
+ * - TileType 取各图层中「特殊」的类型（非 EMPTY、非 NORMAL），都没有时取 NORMAL，全空时为 EMPTY
+ *
+ * @par 使用示例
+ * @code
+ * grid.build(registry, map_size, tile_size);
+ * const int cell = grid.cellAt(position);
+ * if (grid.hasFlag(cell, TileGrid::HAZARD)) { ... }
+ * grid.forEachNeighbor(cell, [&](int neighbor) { ... });
+ * @endcode
+ */
+
+#pragma once
+#include "../component/tilelayer_component.h"
+#include <glm/vec2.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <entt/entity/fwd.hpp>
+
+namespace engine::spatial {
+
+    /**
+     * @class TileGrid
+     * @brief 均匀网格上每格一个字节的瓦片类型与属性表。
+     */
+    class TileGrid final {
+    public:
+        using Cell = std::uint8_t;
+
+        static constexpr Cell TYPE_MASK = 0x0F;     ///< 低 4 位：engine::component::TileType
+        // --- 属性标志（高 4 位） ---
+        static constexpr Cell BLOCKED = 1u << 4;    ///< 不可通行（TileType::SOLID）
+        static constexpr Cell HAZARD = 1u << 5;     ///< 危险格（TileType::HAZARD）
+        static constexpr Cell ENTITY = 1u << 6;     ///< 该格有瓦片实体（带动画或自定义属性，未烘焙）
+        static constexpr Cell PROPERTIES = 1u << 7; ///< 瓦片带 Tiled 自定义属性（建造位等，详情查瓦片实体）
+
+        /**
+         * @brief 打包一个格子的值
+         * @param type 瓦片类型
+         * @param flags 属性标志（只保留高 4 位）
+         */
+        [[nodiscard]] static constexpr Cell packCell(engine::component::TileType type, Cell flags = 0) {
+            return static_cast<Cell>((static_cast<Cell>(type) & TYPE_MASK) | (flags & ~TYPE_MASK));
+        }
+
+        /** @brief 由瓦片类型推导的属性标志（BLOCKED、HAZARD） */
+        [[nodiscard]] static constexpr Cell typeFlags(engine::component::TileType type) {
+            switch (type) {
+            case engine::component::TileType::SOLID: return BLOCKED;
+            case engine::component::TileType::HAZARD: return HAZARD;
+            default: return 0;
+            }
+        }
+
+        /**
+         * @brief 合并注册表中所有与地图同尺寸的瓦片层
+         * @param registry 含 TileLayerComponent 的注册表
+         * @param map_size 地图网格大小（列数, 行数）
+         * @param tile_size 瓦片尺寸（像素）
+         * @param origin 网格左上角的世界坐标
+         */
+        void build(const entt::registry& registry, const glm::ivec2& map_size, const glm::ivec2& tile_size,
+                   const glm::vec2& origin = glm::vec2{ 0.0f });
+
+        /** @brief 清空（isBuilt() 返回 false） */
+        void clear();
+
+        /** @brief 世界坐标所在的格子下标，网格外返回 -1 */
+        [[nodiscard]] int cellAt(const glm::vec2& position) const;
+        /** @brief 网格坐标（列, 行）对应的下标，越界返回 -1 */
+        [[nodiscard]] int indexOf(const glm::ivec2& coord) const;
+        /** @brief 下标对应的网格坐标（列, 行） */
+        [[nodiscard]] glm::ivec2 coordOf(int cell) const { return { cell % size_.x, cell / size_.x }; }
+        /** @brief 格子中心的世界坐标 */
+        [[nodiscard]] glm::vec2 cellCenter(int cell) const;
+
+        /** @brief 格子的打包值，越界时为 0（EMPTY、无标志） */
+        [[nodiscard]] Cell getCell(int cell) const { return isValidCell(cell) ? cells_[cell] : Cell{ 0 }; }
+        [[nodiscard]] engine::component::TileType getType(int cell) const {
+            return static_cast<engine::component::TileType>(getCell(cell) & TYPE_MASK);
+        }
+        /** @brief 格子是否带有 flags 中的任一标志 */
+        [[nodiscard]] bool hasFlag(int cell, Cell flags) const { return (getCell(cell) & flags) != 0; }
+        /** @brief 网格外也视为不可通行 */
+        [[nodiscard]] bool isBlocked(int cell) const { return !isValidCell(cell) || hasFlag(cell, BLOCKED); }
+
+        /**
+         * @brief 依次以邻格下标调用 fn（越界的邻格跳过）
+         * @param diagonal 是否包含 4 个对角邻格（对角邻格不检查墙角，需要时由调用方判断）
+         */
+        template <typename Fn>
+        void forEachNeighbor(int cell, Fn&& fn, bool diagonal = false) const {
+            if (!isValidCell(cell)) {
+                return;
+            }
+            const glm::ivec2 coord = coordOf(cell);
+            const std::size_t count = diagonal ? OFFSETS.size() : 4;
+            for (std::size_t i = 0; i < count; ++i) {
+                const int neighbor = indexOf(coord + OFFSETS[i]);
+                if (neighbor >= 0) {
+                    fn(neighbor);
+                }
+            }
+        }
+
+        /** @brief 全部格子中带有 flags 任一标志的个数 */
+        [[nodiscard]] std::size_t countFlag(Cell flags) const;
+
+        [[nodiscard]] bool isBuilt() const { return !cells_.empty(); }
+        [[nodiscard]] std::span<const Cell> getCells() const { return cells_; }
+        [[nodiscard]] const glm::ivec2& getSize() const { return size_; }
+        [[nodiscard]] const glm::ivec2& getTileSize() const { return tile_size_; }
+        [[nodiscard]] const glm::vec2& getOrigin() const { return origin_; }
+
+    private:
+        /// 4 个正交方向在前，4 个对角方向在后（与 FlowField 的邻接顺序一致）
+        static constexpr std::array<glm::ivec2, 8> OFFSETS{ {
+            { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+            { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 } } };
+
+        [[nodiscard]] bool isValidCell(int cell) const { return cell >= 0 && static_cast<std::size_t>(cell) < cells_.size(); }
+
+        std::vector<Cell> cells_;           ///< 行优先，row * 列数 + col
+        glm::ivec2 size_{ 0, 0 };
+        glm::ivec2 tile_size_{ 0, 0 };
+        glm::vec2 origin_{ 0.0f, 0.0f };
+    };
+
+} // namespace engine::spatial
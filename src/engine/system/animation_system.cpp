@@ -1,10 +1,18 @@
 #include "animation_system.h"
 #include "../component/animation_component.h"
+#include "../component/animation_request_component.h"
 #include "../component/sprite_component.h"
+#include "../component/disabled_tag.h"
+#include "../component/low_detail_tag.h"
+#include "../component/tile_animation_component.h"
+#include "../core/job_system.h"
 #include "../utils/events.h"
+#include "../utils/profiler.h"
+#include <algorithm>
+#include <cmath>
 #include <entt/entity/registry.hpp>
 #include <entt/signal/dispatcher.hpp>
-#include <spdlog/spdlog.h>
+#include "../utils/deferred_log.h"
 
 namespace engine::system {
 
@@ -18,76 +26,141 @@ AnimationSystem::~AnimationSystem() {
 }
 
 void AnimationSystem::update(float dt) {
-    auto view = registry_.view<engine::component::AnimationComponent, engine::component::SpriteComponent>();
-    for (auto entity : view) {
+    // 低细节实体在屏幕外，动画停在当前帧，恢复后从暂停处继续
+    auto view = registry_.view<engine::component::AnimationComponent, engine::component::SpriteComponent>(
+        entt::exclude<engine::component::DisabledTag, engine::component::LowDetailTag>);
+    // 帧推进只修改实体自身的组件，可分块并行；事件分发延迟到遍历结束后按顺序执行
+    core::parallelEach(registry_, view, [&](entt::entity entity, ecs::CommandBuffer& commands) {
         auto& anim_component = view.get<engine::component::AnimationComponent>(entity);
         auto& sprite_component = view.get<engine::component::SpriteComponent>(entity);
 
         // 如果动画不存在，则跳过
-        auto it = anim_component.animations_.find(anim_component.current_animation_id_);
-        if (it == anim_component.animations_.end()) {
-            continue;
+        const auto* animation = anim_component.currentAnimation();
+        if (!animation) {
+            return;
         }
 
-        // 获取当前动画
-        auto& current_animation = it->second;
-        // 如果没有帧，则跳过
-        if (current_animation.frames_.empty()) {
-            continue;
+        // 获取当前动画（共享数据，只读）
+        const auto& current_animation = *animation;
+        // 如果没有帧或总时长为 0，则跳过
+        const std::size_t frame_count = current_animation.frames_.size();
+        if (frame_count == 0 || current_animation.total_duration_ms_ <= 0.0f) {
+            return;
+        }
+
+        const bool looping = anim_component.isLooping(current_animation);
+        const float total_ms = current_animation.total_duration_ms_;
+        std::size_t frame_index = std::min(anim_component.current_frame_index_, frame_count - 1);
+        float time_ms = anim_component.current_time_ms_;
+        // 非循环动画已播放完毕：停在最后一帧，不再重复发送结束事件
+        if (!looping && time_ms >= total_ms) {
+            sprite_component.sprite_.src_rect_ = current_animation.frames_.back().src_rect_;
+            return;
         }
 
         // 更新当前播放时间 (推进计时器)
-        anim_component.current_time_ms_ += dt * 1000.0f * anim_component.speed_;
-
-        // 获取当前帧
-        const auto& current_frame = current_animation.frames_[anim_component.current_frame_index_];
-
-        // 检查是否需要切换到下一帧
-        if (anim_component.current_time_ms_ >= current_frame.duration_ms_) {
-            anim_component.current_time_ms_ -= current_frame.duration_ms_;
-            anim_component.current_frame_index_++;
-            const int frame_index = static_cast<int>(anim_component.current_frame_index_);
-            if (auto ev_it = current_animation.events_.find(frame_index);ev_it != current_animation.events_.end()) {
-                const entt::id_type event_id = ev_it->second;
-                spdlog::info("动画事件触发: 实体={}, 动画={:x}, 帧={}, 事件={:x}",entt::to_integral(entity), anim_component.current_animation_id_, frame_index, event_id);
-                dispatcher_.enqueue(engine::utils::AnimationEvent{ entity, event_id, anim_component.current_animation_id_ });
+        time_ms += dt * 1000.0f * anim_component.speed_;
+
+        // 依次检查 (from, to] 之间进入的帧是否带事件；位图为空的帧不查事件表
+        const entt::id_type animation_id = anim_component.current_animation_id_;
+        auto emitEvents = [&](std::size_t from, std::size_t to) {
+            for (std::size_t entered = from + 1; entered <= to; ++entered) {
+                if (!current_animation.hasEvent(entered)) {
+                    continue;
+                }
+                const int event_frame = static_cast<int>(entered);
+                const entt::id_type event_id = current_animation.events_.at(event_frame);
+                commands.push([this, entity, event_id, animation_id, event_frame](entt::registry&) {
+                    ENGINE_LOG_INFO_DEFERRED("动画事件触发: 实体={}, 动画={:x}, 帧={}, 事件={:x}",entt::to_integral(entity), animation_id, event_frame, event_id);
+                    dispatcher_.enqueue(engine::utils::AnimationEvent{ entity, event_id, animation_id });
+                });
             }
+        };
 
-            // 处理动画播放完成
-            if (anim_component.current_frame_index_ >= current_animation.frames_.size()) {
-                if (current_animation.loop_) {
-                    anim_component.current_frame_index_ = 0;
+        if (time_ms >= current_animation.frame_end_ms_[frame_index]) {
+            if (time_ms >= total_ms) {
+                // 播放到末尾：先结算到末尾为止的帧事件
+                emitEvents(frame_index, frame_count);
+                if (looping) {
+                    // 大步长下可能跨过整轮，被跨过的整轮不再重复发送帧事件
+                    time_ms = std::fmod(time_ms, total_ms);
+                    frame_index = 0;
                 } else {
                     // 动画播放完毕且不循环，停在最后一帧
-                    anim_component.current_frame_index_ = current_animation.frames_.size() - 1;
+                    time_ms = total_ms;
+                    frame_index = frame_count - 1;
                     // 发送动画播放结束事件
-                    dispatcher_.enqueue(engine::utils::AnimationFinishedEvent{entity, anim_component.current_animation_id_});
+                    commands.push([this, entity, animation_id](entt::registry&) {
+                        dispatcher_.enqueue(engine::utils::AnimationFinishedEvent{entity, animation_id});
+                    });
                 }
             }
+            if (time_ms < total_ms) {
+                const std::size_t next_index = current_animation.frameAt(time_ms);
+                emitEvents(frame_index, next_index);
+                frame_index = next_index;
+            }
         }
-        
+        anim_component.current_time_ms_ = time_ms;
+        anim_component.current_frame_index_ = frame_index;
+
         // 更新 SpriteComponent 的源矩形 （根据当前动画帧的源矩形信息）
         const auto& next_frame = current_animation.frames_[anim_component.current_frame_index_];
         sprite_component.sprite_.src_rect_ = next_frame.src_rect_;
+    });
+
+    updateTileClocks(dt);
+    applyRequests();
+}
+
+void AnimationSystem::updateTileClocks(float dt) {
+    auto* clocks = registry_.ctx().find<engine::component::TileAnimationClocks>();
+    if (!clocks || clocks->empty()) {
+        return;
+    }
+    ENGINE_PROFILE_COUNTER("anim.tile_clocks", static_cast<std::int64_t>(clocks->size()));
+    if (!clocks->advance(dt)) {
+        return;
+    }
+    // 只有当前帧切换了的时钟才改写实例；低细节实体同样同步（瓦片不会降级，改写只是一次赋值）
+    auto view = registry_.view<engine::component::TileAnimationComponent, engine::component::SpriteComponent>(
+        entt::exclude<engine::component::DisabledTag>);
+    for (auto [entity, tile, sprite] : view.each()) {
+        if (clocks->isChanged(tile.clock_)) {
+            sprite.sprite_.src_rect_ = clocks->currentFrame(tile.clock_);
+        }
     }
 }
 
-void AnimationSystem::onPlayAnimationEvent(const engine::utils::PlayAnimationEvent& event) {
-    // 使用try_get方法来安全获取可能存在的组件。如果不存在则返回nullptr
-    if (auto anim = registry_.try_get<engine::component::AnimationComponent>(event.entity_); anim) {
+void AnimationSystem::applyRequests() {
+    auto& requests = registry_.storage<engine::component::AnimationRequestComponent>();
+    ENGINE_PROFILE_COUNTER("anim.requests", static_cast<std::int64_t>(requests.size()));
+    if (requests.empty()) {
+        return;
+    }
+    auto view = registry_.view<engine::component::AnimationRequestComponent, engine::component::AnimationComponent>();
+    for (auto [entity, request, anim] : view.each()) {
         // 先检查动画是否存在，避免 .at() 导致的崩溃
-        if (anim->animations_.contains(event.animation_id_)) {
-            anim->current_animation_id_ = event.animation_id_;      // 替换动画ID
-            anim->current_frame_index_ = 0;
-            anim->current_time_ms_ = 0.0f;
-            anim->animations_.at(event.animation_id_).loop_ = event.loop_;
+        if (anim.animations_ && anim.animations_->contains(request.animation_id_)) {
+            anim.current_animation_id_ = request.animation_id_;     // 替换动画ID
+            anim.current_frame_index_ = 0;
+            anim.current_time_ms_ = 0.0f;
+            anim.loop_override_ = request.loop_;                    // 循环设置属于逐实体状态，不修改共享动画数据
         } else {
             // 将 hashed_string 转换回字符串在日志里是不可能的（除非事先存了映射），
             // 这里我们打印 ID 的 16 进制值方便调试。
-            spdlog::warn("尝试播放不存在的动画 ID: {:x}，实体 ID: {}", 
-                         event.animation_id_, entt::to_integral(event.entity_));
+            ENGINE_LOG_WARN("尝试播放不存在的动画 ID: {:x}，实体 ID: {}",
+                         request.animation_id_, entt::to_integral(entity));
         }
     }
+    // 没有动画组件的实体上的请求一并丢弃
+    requests.clear();
+}
+
+void AnimationSystem::onPlayAnimationEvent(const engine::utils::PlayAnimationEvent& event) {
+    if (registry_.valid(event.entity_)) {
+        registry_.emplace_or_replace<engine::component::AnimationRequestComponent>(event.entity_, event.animation_id_, event.loop_);
+    }
 }
 
 } // namespace engine::system
\ No newline at end of file
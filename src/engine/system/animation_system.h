@@ -9,6 +9,8 @@ namespace engine::system {
  * @brief 动画系统
  * 
  * 负责更新实体的动画组件，并同步到精灵组件。
+ * 切换动画的请求（AnimationRequestComponent）在帧推进之后统一应用，同一实体同一帧内只生效最后一次。
+ * 动画瓦片不带 AnimationComponent：共享时钟（TileAnimationClocks）每步推进一次，当前帧变化时才改写其实例的精灵。
  */
 class AnimationSystem {
     // 将依赖保存为成员变量，方便回调函数使用
@@ -22,7 +24,9 @@ public:
     void update(float dt);  ///< @brief 现在更新函数只需要传入dt，注册表和dispatcher在构造函数中传入
 
 private:
-    void onPlayAnimationEvent(const engine::utils::PlayAnimationEvent& event);  ///< @brief 播放动画事件处理函数
+    void applyRequests();   ///< @brief 应用并清空本帧累计的 AnimationRequestComponent
+    void updateTileClocks(float dt);    ///< @brief 推进动画瓦片的共享时钟，并同步切换了帧的实例
+    void onPlayAnimationEvent(const engine::utils::PlayAnimationEvent& event);  ///< @brief 兼容旧接口：转为写入动画请求
 };
 
 } // namespace engine::system
\ No newline at end of file
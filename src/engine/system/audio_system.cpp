@@ -2,6 +2,7 @@
 #include <entt/entt.hpp>
 #include "../audio/audio_locator.h"
 #include "../component/audio_component.h"
+#include "../component/transform_component.h"
 #include <spdlog/spdlog.h>
 using namespace entt::literals;
 engine::system::AudioSystem::AudioSystem(entt::registry& registry, entt::dispatcher& dispatcher)
@@ -10,33 +11,54 @@ engine::system::AudioSystem::AudioSystem(entt::registry& registry, entt::dispatc
 	dispatcher_.sink<engine::utils::PlaySoundEvent>().connect<&AudioSystem::onPlayAnimationEvent>(this);
 }
 
-engine::system::AudioSystem::~AudioSystem() = default;
+engine::system::AudioSystem::~AudioSystem() {
+	dispatcher_.disconnect(this);
+}
+
+void engine::system::AudioSystem::setListener(const glm::vec2& position, float max_distance)
+{
+	listener_position_ = position;
+	listener_distance_ = max_distance;
+}
+
+void engine::system::AudioSystem::play(entt::entity entity, entt::id_type sound_id)
+{
+	auto& audio = engine::audio::AudioLocator::get();
+	if (listener_distance_ > 0.0f && entity != entt::null) {
+		if (const auto* transform = registry_.try_get<engine::component::TransformComponent>(entity)) {
+			audio.playSoundSpatial(sound_id, {}, transform->position_, listener_position_, listener_distance_);
+			return;
+		}
+	}
+	audio.playSound(sound_id);
+}
 
 void engine::system::AudioSystem::onPlayAnimationEvent(const engine::utils::PlaySoundEvent& event)
 {
+	// 大规模战斗中每帧可能有数十条，逐条日志只在 trace 级别输出
 	if (event.entity_ == entt::null) {
-		spdlog::info("播放音效事件: sound_id={:x}", event.sound_id_);
-		engine::audio::AudioLocator::get().playSound(event.sound_id_);
-       return;
+		spdlog::trace("播放音效事件: sound_id={:x}", event.sound_id_);
+		play(entt::null, event.sound_id_);
+		return;
 	}
 
 	if (!registry_.valid(event.entity_)) {
 		spdlog::warn("播放音效事件目标实体已失效: entity={}, sound_id={:x}", entt::to_integral(event.entity_), event.sound_id_);
-		engine::audio::AudioLocator::get().playSound(event.sound_id_);
+		play(entt::null, event.sound_id_);
 		return;
 	}
 
-	if (auto audio_comp = registry_.try_get<engine::component::AudioComponent>(event.entity_)) {
-		auto it = audio_comp->action_sounds_.find(event.sound_id_);
-		if (it != audio_comp->action_sounds_.end()) {
-			spdlog::info("播放音效事件: entity={}, sound_id={:x}", entt::to_integral(event.entity_), it->second);
-			engine::audio::AudioLocator::get().playSound(it->second);
+	const auto* audio_comp = registry_.try_get<engine::component::AudioComponent>(event.entity_);
+	if (audio_comp && audio_comp->sounds_) {
+		if (const auto* sound_id = audio_comp->sounds_->find(event.sound_id_)) {
+			spdlog::trace("播放音效事件: entity={}, sound_id={:x}", entt::to_integral(event.entity_), *sound_id);
+			play(event.entity_, *sound_id);
 		} else {
 			spdlog::warn("实体 {} 没有对应动作的音效: sound_id={:x}", entt::to_integral(event.entity_), event.sound_id_);
-			engine::audio::AudioLocator::get().playSound(event.sound_id_);
+			play(event.entity_, event.sound_id_);
 		}
-   } else {
-		spdlog::info("播放音效事件: entity={} 没有 AudioComponent，sound_id={:x}", entt::to_integral(event.entity_), event.sound_id_);
-		engine::audio::AudioLocator::get().playSound(event.sound_id_);
+	} else {
+		spdlog::trace("播放音效事件: entity={} 没有 AudioComponent，sound_id={:x}", entt::to_integral(event.entity_), event.sound_id_);
+		play(event.entity_, event.sound_id_);
 	}
 }
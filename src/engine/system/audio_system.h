@@ -1,5 +1,6 @@
 #pragma once
 #include <entt/fwd.hpp>
+#include <glm/vec2.hpp>
 #include "../utils/events.h"
 namespace engine::system {
 	/**
@@ -7,17 +8,30 @@ namespace engine::system {
 	 * @brief 音频系统，负责根据实体的动作状态播放对应的音效。
 	 *
 	 * @details
-	 * AudioSystem 监听实体的动作状态变化（如攻击、受伤、死亡等），并根据实体的 AudioComponent 中
-	 * 定义的动作-音效映射关系，调用音频播放器播放相应的音效。该系统与 AnimationSystem 配合使用，
+	 * AudioSystem 监听实体的动作状态变化（如攻击、受伤、死亡等），并根据实体 AudioComponent 指向的
+	 * 职业音效表（SoundTable）查出动作对应的音效，调用音频播放器播放。该系统与 AnimationSystem 配合使用，
 	 * 确保在动画播放时同步触发正确的音效。
+	 *
+	 * 设置了听众（setListener）后，带 TransformComponent 的实体音效走 playSoundSpatial：
+	 * 超出听觉半径的直接剔除，其余按距离衰减增益。
 	 */
 	class AudioSystem {
 	public:
 		AudioSystem(entt::registry& registry, entt::dispatcher& dispatcher);
 		~AudioSystem();
+
+		/**
+		 * @brief 设置听众位置与听觉半径（每帧由场景按相机更新）
+		 * @param max_distance 听觉半径，<= 0 表示关闭空间化（所有音效以原音量播放）
+		 */
+		void setListener(const glm::vec2& position, float max_distance);
 	private:
 		void onPlayAnimationEvent(const engine::utils::PlaySoundEvent& event);
+		/// @brief 播放实体的音效：有位置且设置了听众时空间化，否则直接播放
+		void play(entt::entity entity, entt::id_type sound_id);
 		entt::registry& registry_;
 		entt::dispatcher& dispatcher_;
+		glm::vec2 listener_position_{ 0.0f, 0.0f };
+		float listener_distance_{ 0.0f };
 	};
 } // namespace engine::system
\ No newline at end of file
@@ -35,5 +35,7 @@ class AnimationSystem;   ///< 动画系统前向声明
 class MovementSystem;    ///< 移动系统前向声明
 class YSortSystem;      ///< Y轴排序系统前向声明
 class AudioSystem;      ///< 音频系统前向声明
+class InterpolationSystem; ///< 渲染插值快照系统前向声明
+class ParallaxRenderSystem; ///< 视差图层渲染系统前向声明
 
 }   // namespace engine::system
\ No newline at end of file
@@ -0,0 +1,27 @@
+/**
+ * @file interpolation_system.cpp
+ * @brief InterpolationSystem 类的实现。
+ */
+
+#include "interpolation_system.h"
+#include "../component/previous_transform_component.h"
+#include "../component/transform_component.h"
+#include "../ecs/groups.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::system {
+
+void InterpolationSystem::snapshot(entt::registry& registry, std::uint64_t tick) {
+    spdlog::trace("InterpolationSystem::snapshot");
+
+    // 只有会移动的实体需要插值；PreviousTransformComponent 不属于移动分组，遍历期间添加不会打乱分组顺序
+    auto view = ecs::movementGroup(registry);
+    for (auto entity : view) {
+        const auto& transform = view.get<engine::component::TransformComponent>(entity);
+        auto& previous = registry.get_or_emplace<engine::component::PreviousTransformComponent>(entity);
+        previous.position_ = transform.position_;
+        previous.tick_ = tick;
+    }
+}
+
+}   // namespace engine::system
@@ -0,0 +1,38 @@
+/**
+ * @file interpolation_system.h
+ * @brief 定义 InterpolationSystem，在每个模拟步开始前记录移动实体的位置。
+ *
+ * @details
+ * 固定步长模拟下，一帧可能执行 0 步、1 步或多步。每步开始时调用 snapshot()，
+ * 把移动分组内实体的当前位置写入 PreviousTransformComponent，
+ * 渲染时按 Time::getInterpolationAlpha() 在快照与当前位置之间插值。
+ *
+ * @par 使用示例
+ * @code
+ * for (int i = 0; i < steps; ++i) {
+ *     interpolation_system->snapshot(registry, first_tick + i);
+ *     // ... 其余模拟系统 ...
+ * }
+ * render_system->setInterpolation(time.getInterpolationAlpha(), time.getSimulationTick());
+ * @endcode
+ *
+ * @see engine::component::PreviousTransformComponent
+ */
+
+#pragma once
+#include <cstdint>
+#include <entt/entity/registry.hpp>
+
+namespace engine::system {
+
+class InterpolationSystem {
+public:
+    /**
+     * @brief 记录移动分组内所有实体的位置
+     * @param registry EnTT实体注册表
+     * @param tick 即将执行的模拟步序号
+     */
+    void snapshot(entt::registry& registry, std::uint64_t tick);
+};
+
+} // namespace engine::system
@@ -8,27 +8,59 @@
  * 并根据速度和时间增量更新实体位置。
  *
  * @par 实现细节
- * - 使用 registry.view<>() 创建组件视图，只遍历符合条件的实体
- * - view.get<>() 获取特定组件的引用，避免查找开销
- * - 使用 const 引用读取速度，非const引用修改位置
+ * - PACKED：一次遍历分组收集速度非零的实体到紧凑数组，utils::integratePositions() 批量积分后按同一顺序写回并 patch
+ * - PER_ENTITY：位置在并行遍历中直接写入，遍历结束后为速度非零的实体统一 registry.patch
+ * - 两种方式的结果逐位相同，变化跟踪（YSortSystem 等）都只看到本步实际移动的实体
  */
 
 #include "movement_system.h"
 #include "../component/velocity_component.h"
 #include "../component/transform_component.h"
-#include <spdlog/spdlog.h>
+#include "../ecs/groups.h"
+#include "../core/job_system.h"
+#include "../utils/math.h"
 
 namespace engine::system {
 
 void MovementSystem::update(entt::registry& registry, float delta_time) {
-    spdlog::trace("MovementSystem::update");
+    if (integration_ == MovementIntegration::PACKED) {
+        updatePacked(registry, delta_time);
+    } else {
+        updatePerEntity(registry, delta_time);
+    }
+}
 
-    // 创建组件视图：只获取同时具有 VelocityComponent 和 TransformComponent 的实体
-    // 这是ECS的核心优势：高效查询具有特定组件组合的实体
-    auto view = registry.view<engine::component::VelocityComponent, engine::component::TransformComponent>();
+void MovementSystem::updatePacked(entt::registry& registry, float delta_time) {
+    if (delta_time == 0.0f) {
+        return;
+    }
+    auto group = ecs::movementGroup(registry);
+    movers_.clear();
+    positions_.clear();
+    velocities_.clear();
+    for (const auto [entity, velocity, transform] : group.each()) {
+        if (velocity.velocity_.x != 0.0f || velocity.velocity_.y != 0.0f) {
+            movers_.push_back(entity);
+            positions_.push_back(transform.position_);
+            velocities_.push_back(velocity.velocity_);
+        }
+    }
+    utils::integratePositions(positions_.data(), velocities_.data(), positions_.size(), delta_time);
 
-    // 遍历视图中的所有实体
-    for (auto entity : view) {
+    // 写回与 on_update 合为一次遍历（信号回调不是线程安全的，在调用线程执行）
+    auto& transforms = registry.storage<engine::component::TransformComponent>();
+    for (std::size_t i = 0; i < movers_.size(); ++i) {
+        transforms.get(movers_[i]).position_ = positions_[i];
+        registry.patch<engine::component::TransformComponent>(movers_[i]);
+    }
+}
+
+void MovementSystem::updatePerEntity(entt::registry& registry, float delta_time) {
+    // 移动分组：同时具有 VelocityComponent 和 TransformComponent 的实体，VelocityComponent 在组内紧密排列
+    auto view = ecs::movementGroup(registry);
+
+    // 每个实体只修改自身的 TransformComponent，可分块并行
+    core::parallelEach(registry, view, [&](entt::entity entity, ecs::CommandBuffer&) {
         // 从视图中获取组件引用
         // velocity 使用 const 引用，因为只需要读取速度值
         const auto& velocity = view.get<engine::component::VelocityComponent>(entity);
@@ -39,6 +71,17 @@ void MovementSystem::update(entt::registry& registry, float delta_time) {
         // 更新位置：新位置 = 原位置 + 速度 × 时间增量
         // 这是基本的欧拉积分，适用于简单的线性运动
         transform.position_ += velocity.velocity_ * delta_time;
+    });
+
+    // 信号回调不是线程安全的，在主线程补发 on_update；被阻挡、攻击中速度为零的单位不发
+    if (delta_time == 0.0f) {
+        return;
+    }
+    for (auto entity : view) {
+        const auto& velocity = view.get<engine::component::VelocityComponent>(entity).velocity_;
+        if (velocity.x != 0.0f || velocity.y != 0.0f) {
+            registry.patch<engine::component::TransformComponent>(entity);
+        }
     }
 }
 
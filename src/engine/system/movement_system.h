@@ -10,7 +10,7 @@
  * @par ECS架构角色
  * - 查询：获取具有 TransformComponent 和 VelocityComponent 的实体视图
  * - 处理：计算新位置 = 原位置 + 速度 × 时间增量
- * - 修改：更新 TransformComponent 的 position_ 字段
+ * - 修改：更新 TransformComponent 的 position_ 字段，并为实际移动的实体发出 on_update 信号
  *
  * @par 使用示例
  * @code
@@ -29,8 +29,17 @@
 
 #pragma once
 #include <entt/entity/registry.hpp>
+#include <glm/vec2.hpp>
+#include <cstdint>
+#include <vector>
 
 namespace engine::system {
+    /// @brief 位置积分的实现方式
+    enum class MovementIntegration : std::uint8_t {
+        PACKED,         ///< 收集到紧凑数组后批量向量积分（默认）
+        PER_ENTITY,     ///< 逐实体 view.get，分块并行
+    };
+
     /**
      * @class MovementSystem
      * @brief ECS移动系统，负责根据速度更新实体位置。
@@ -42,11 +51,14 @@ namespace engine::system {
      * 该系统使用 EnTT 的 view 功能高效遍历符合条件的实体，
      * 避免遍历所有实体，提高性能。
      *
-     * @par 系统执行流程
-     * 1. 创建实体视图：registry.view<VelocityComponent, TransformComponent>()
-     * 2. 遍历视图中的所有实体
-     * 3. 读取 VelocityComponent 的速度值
-     * 4. 更新 TransformComponent 的位置值
+     * @par 系统执行流程（默认 MovementIntegration::PACKED）
+     * 1. 遍历移动分组（VelocityComponent 紧密排列），把速度非零的实体与其位置、速度收集到紧凑数组
+     * 2. 以 utils::integratePositions() 批量积分（AVX2 每次 4 个实体，SSE2 / NEON 每次 2 个）
+     * 3. 按收集顺序写回 TransformComponent，并调用 registry.patch<TransformComponent>()（ecs::ChangeTracker 据此增量更新）
+     *
+     * 速度为零的实体（被阻挡、攻击中）不读也不写。TransformComponent 归渲染分组所有，与速度的存储顺序不同，
+     * 无法原地按块积分，因此经紧凑数组中转；收集与写回各一次稀疏查找，与逐实体路径的查找次数相同。
+     * MovementIntegration::PER_ENTITY 是原来的逐实体路径（经 parallelEach 分块并行），保留用于对比（见 bench/）。
      *
      * @par 扩展建议
      * 可以添加以下功能增强：
@@ -64,5 +76,17 @@ namespace engine::system {
          * @note 只有同时具有 VelocityComponent 和 TransformComponent 的实体才会被处理
          */
         void update(entt::registry& registry, float deltaTime);
+
+        void setIntegration(MovementIntegration integration) { integration_ = integration; }
+        [[nodiscard]] MovementIntegration getIntegration() const { return integration_; }
+
+    private:
+        void updatePacked(entt::registry& registry, float delta_time);
+        void updatePerEntity(entt::registry& registry, float delta_time);
+
+        MovementIntegration integration_{ MovementIntegration::PACKED };
+        std::vector<entt::entity> movers_;      ///< 本步速度非零的实体（分组顺序），容量跨步复用
+        std::vector<glm::vec2> positions_;      ///< 与 movers_ 一一对应
+        std::vector<glm::vec2> velocities_;
     };
 } // namespace engine::system
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "parallax_render_system.h"
+#include "../component/disabled_tag.h"
+#include "../component/parallax_component.h"
+#include "../component/render_component.h"
+#include "../component/sprite_component.h"
+#include "../component/transform_component.h"
+#include "../render/renderer.h"
+#include "../render/camera.h"
+#include "../utils/profiler.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace engine::system {
+
+void ParallaxRenderSystem::update(entt::registry& registry, render::Renderer& renderer, const render::Camera& camera) {
+    auto view = registry.view<component::ParallaxComponent, component::TransformComponent,
+                              component::SpriteComponent, component::RenderComponent>(entt::exclude<component::DisabledTag>);
+
+    layers_.clear();
+    for (auto entity : view) {
+        if (view.get<component::ParallaxComponent>(entity).is_visible_) {
+            layers_.push_back(LayerEntry{entity, view.get<component::RenderComponent>(entity).getLayerIndex()});
+        }
+    }
+    // 图层数很少，每帧直接稳定排序；同层保持创建顺序（即地图中的图层顺序）
+    std::stable_sort(layers_.begin(), layers_.end(),
+                     [](const LayerEntry& lhs, const LayerEntry& rhs) { return lhs.layer_index_ < rhs.layer_index_; });
+
+    ParallaxRenderStats stats;
+    for (const auto& layer : layers_) {
+        const auto& parallax = view.get<component::ParallaxComponent>(layer.entity_);
+        const auto& transform = view.get<component::TransformComponent>(layer.entity_);
+        const auto& sprite = view.get<component::SpriteComponent>(layer.entity_);
+        const auto& render = view.get<component::RenderComponent>(layer.entity_);
+
+        const auto tiles = renderer.drawParallaxLayer(camera, sprite.sprite_, transform.position_ + sprite.offset_,
+                                                      sprite.size_ * transform.scale_, parallax.scroll_factor_,
+                                                      parallax.repeat_, render.color_.toFColor());
+        if (tiles > 0) {
+            ++stats.layer_count_;
+            stats.tile_count_ += tiles;
+        }
+    }
+    ENGINE_PROFILE_COUNTER("parallax.tiles", static_cast<std::int64_t>(stats.tile_count_));
+    registry.ctx().insert_or_assign(stats);
+}
+
+} // namespace engine::system
@@ -0,0 +1,56 @@
+/**
+ * @file parallax_render_system.h
+ * @brief 定义 ParallaxRenderSystem，绘制关卡中的图像图层（视差背景）。
+ *
+ * @details
+ * 图像图层实体带有 ParallaxComponent，由 LevelLoader 创建。它们不进入渲染分组
+ * （ecs::renderGroup 排除 ParallaxComponent），因此既不参与 RenderSystem 的剔除与 Y 排序，
+ * 也不会被 YSortSystem 重算 Y 深度。
+ *
+ * 每帧按 RenderComponent::getLayerIndex() 顺序逐层调用 Renderer::drawParallaxLayer()：
+ * 根据相机位置与视差因子算出覆盖视口所需的副本范围，一个图层的所有副本合并为一次几何提交。
+ * 图像图层作为背景绘制在 RenderSystem 之前。
+ *
+ * @see engine::component::ParallaxComponent
+ * @see engine::render::Renderer::drawParallaxLayer
+ */
+
+#pragma once
+#include <entt/entity/registry.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace engine::render {
+    class Renderer;
+    class Camera;
+}
+
+namespace engine::system {
+    /**
+     * @struct ParallaxRenderStats
+     * @brief 视差图层绘制统计，每帧由 ParallaxRenderSystem 写入 registry 上下文
+     */
+    struct ParallaxRenderStats {
+        std::size_t layer_count_{0};        ///< 本帧提交的图层数（即 SDL_RenderGeometry 调用次数）
+        std::size_t tile_count_{0};         ///< 本帧提交的副本总数
+    };
+
+    class ParallaxRenderSystem final {
+    public:
+        /**
+         * @brief 按图层顺序绘制所有可见的图像图层，并发布 ParallaxRenderStats
+         * @param registry EnTT实体注册表
+         * @param renderer 渲染器
+         * @param camera 提供视差偏移与视口范围的相机
+         */
+        void update(entt::registry& registry, engine::render::Renderer& renderer, const engine::render::Camera& camera);
+
+    private:
+        struct LayerEntry {
+            entt::entity entity_{entt::null};
+            int layer_index_{0};
+        };
+
+        std::vector<LayerEntry> layers_;    ///< 本帧待绘制的图层（跨帧复用容量）
+    };
+} // namespace engine::system
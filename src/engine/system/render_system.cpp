@@ -3,16 +3,23 @@
  * @brief RenderSystem 类的实现，ECS渲染系统的具体逻辑。
  *
  * @details
- * 本文件实现了 RenderSystem::update() 方法，遍历所有具有
- * TransformComponent 和 SpriteComponent 的实体，并调用 Renderer 进行绘制。
+ * 本文件实现了 RenderSystem 的提取与绘制：extract() 遍历所有具有
+ * TransformComponent 和 SpriteComponent 的实体并写入绘制快照，update() 只读快照调用 Renderer 进行绘制。
  *
  * @par 实现细节
- * - 使用 registry.view<>() 高效查询可渲染实体
+ * - 提取时遍历渲染分组，按外扩的视野粗剔除后拷贝绘制数据
+ * - 排序前先按相机视野对快照做精确剔除，只有可见条目进入排序与绘制
+ * - 增量模式下维护持久的绘制顺序索引，仅对顺序发生变化的条目做插入修复
+ * - 新实体排序后经暂存区归并进已有序列
+ * - 全量排序与大面积乱序时对 64 位排序键做 LSD 基数排序（稳定，等键时保持原顺序）
+ * - 绘制包裹在 Renderer 的精灵批处理中，减少驱动调用
+ * - 相机拉远后屏幕上过小的单位改画远景图标，批次结束后一次提交
  * - 计算最终渲染参数（位置、大小、旋转）
  * - 调用 renderer.drawSprite() 提交渲染命令
  *
  * @par 坐标计算
  * - 最终位置 = transform.position_ + sprite.offset_
+ *   （有本步位置快照时，提取记下上一步的位置，绘制时按插值系数在两者之间插值）
  * - 最终大小 = sprite.size_ * transform.scale_
  * - 旋转角度 = transform.rotation_
  */
@@ -21,44 +28,369 @@
 #include "../component/transform_component.h"
 #include "../component/sprite_component.h"
 #include "../component/render_component.h"
+#include "../component/previous_transform_component.h"
+#include "../component/sheet_animation_component.h"
+#include "../component/lod_icon_component.h"
+#include "../ecs/groups.h"
 #include <spdlog/spdlog.h>
+#include <glm/common.hpp>
 #include <glm/vec2.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include "../render/renderer.h"
 #include "../render/camera.h"
+#include "../utils/profiler.h"
 
 namespace engine::system {
 
-void RenderSystem::update(entt::registry& registry, render::Renderer& renderer, const render::Camera& camera) {
-    
-    registry.sort<component::RenderComponent>([](const auto& lhs, const auto& rhs) {
-        return lhs < rhs; // 按深度排序，确保正确的渲染顺序
-    });
+namespace {
+    /// 相邻逆序对超过条目数的该比例时，放弃插入修复，改为整体稳定排序
+    constexpr std::size_t REPAIR_FALLBACK_DIVISOR = 4;
+    /// 视野外扩边距（像素），与 Renderer::isRectInViewport 保持一致
+    constexpr float CULL_MARGIN = 128.0f;
+    /// 提取时的视野外扩边距（像素）：相机在两次提取之间仍可能移动，渲染侧再按 CULL_MARGIN 精确剔除
+    constexpr float EXTRACT_MARGIN = 512.0f;
+    /// 条目数少于该值时用 std::stable_sort，基数排序的直方图开销不划算
+    constexpr std::size_t RADIX_SORT_MIN = 256;
 
-    // 获取同时具有 RenderComponent, TransformComponent 和 SpriteComponent 的实体视图
-    auto view = registry.view<component::RenderComponent, component::TransformComponent, component::SpriteComponent>();
-    
+    /**
+     * @brief 按 sort_key_ 做 LSD 基数排序（每趟 8 位，稳定）
+     * @details 一次遍历统计全部 8 个字节的直方图；所有键在某一字节上相同（如同一层级的高位）时跳过该趟。
+     *          排序键相同的条目保持输入顺序，同深度同纹理的精灵不会逐帧交换前后。
+     */
+    template <typename Entry>
+    void radixSortByKey(Entry* first, Entry* last, std::vector<Entry>& scratch) {
+        const auto count = static_cast<std::size_t>(last - first);
+        if (count < RADIX_SORT_MIN) {
+            std::stable_sort(first, last);
+            return;
+        }
+        constexpr std::size_t PASSES = sizeof(std::uint64_t);
+        std::array<std::array<std::uint32_t, 256>, PASSES> histograms{};
+        for (const Entry* it = first; it != last; ++it) {
+            for (std::size_t pass = 0; pass < PASSES; ++pass) {
+                ++histograms[pass][(it->sort_key_ >> (pass * 8)) & 0xFFu];
+            }
+        }
+
+        scratch.resize(count);
+        Entry* source = first;
+        Entry* target = scratch.data();
+        for (std::size_t pass = 0; pass < PASSES; ++pass) {
+            const auto shift = pass * 8;
+            auto& histogram = histograms[pass];
+            if (histogram[(source->sort_key_ >> shift) & 0xFFu] == count) {
+                continue;
+            }
+            std::uint32_t offset = 0;
+            for (auto& bucket : histogram) {
+                const auto bucket_count = bucket;
+                bucket = offset;
+                offset += bucket_count;
+            }
+            for (const Entry* it = source; it != source + count; ++it) {
+                target[histogram[(it->sort_key_ >> shift) & 0xFFu]++] = *it;
+            }
+            std::swap(source, target);
+        }
+        if (source != first) {
+            std::copy(source, source + count, first);
+        }
+    }
+}
+
+void RenderSystem::setIncrementalSort(bool enabled) {
+    if (incremental_sort_ == enabled) {
+        return;
+    }
+    incremental_sort_ = enabled;
+    draw_order_.clear();
+    in_order_.clear();
+    spdlog::info("RenderSystem 排序模式切换为: {}", enabled ? "增量" : "全量");
+}
 
-    // 遍历 RenderComponent 的存储（已按深度排序），确保正确的渲染顺序
-    for (auto [entity, render] : registry.storage<component::RenderComponent>().each()) {
-        // 仅处理视图中包含的实体
-        if (!view.contains(entity)) {
+void RenderSystem::update(render::Renderer& renderer, const render::Camera& camera) {
+    prepareDrawOrder(&camera);
+    for (const auto& [entity, offset] : late_offsets_) {
+        if (findVisible(entity)) {
+            visible_[visible_slot_[entt::to_entity(entity)] - 1].position_ += offset;
+        }
+    }
+    late_offsets_.clear();
+
+    // 较长边缩放后低于阈值的精灵改画图标；缩放倍数全帧相同，阈值先换算为世界尺寸
+    const float zoom = camera.getZoom();
+    const float icon_world_threshold = LOD_ICON_THRESHOLD / zoom;
+    lod_icons_.clear();
+
+    // 连续的同纹理精灵合并为一次几何提交
+    renderer.beginSpriteBatch();
+    for (const auto& entry : draw_order_) {
+        // 绘制参数已在剔除阶段缓存，绘制时不再回查组件存储
+        const auto& visible = visible_[visible_slot_[entt::to_entity(entry.entity_)] - 1];
+        if (visible.lod_icon_.a > 0 &&
+            std::max(std::abs(visible.size_.x), std::abs(visible.size_.y)) < icon_world_threshold) {
+            // 透明度随精灵着色（淡出中的单位图标也一起淡出）
+            const glm::vec2 center = camera.worldToScreen(visible.position_ + visible.size_ * 0.5f);
+            auto color = visible.lod_icon_.toFColor();
+            color.a *= visible.tint_.a / 255.0f;
+            lod_icons_.push_back({ engine::utils::Rect{ center - LOD_ICON_SIZE * 0.5f, glm::vec2(LOD_ICON_SIZE) }, color });
+            continue;
+        }
+        if (visible.sheet_) {
+            // 精灵表动画：当前帧只取决于动画时钟，只有画出来的实例才计算
+            auto sprite = *visible.sprite_;
+            sprite.src_rect_.position = visible.sheet_->frameOrigin(animation_time_ms_);
+            renderer.drawSprite(camera, sprite, visible.position_, visible.size_, visible.angle_, visible.tint_.toFColor());
             continue;
         }
+        renderer.drawSprite(camera, *visible.sprite_, visible.position_, visible.size_, visible.angle_, visible.tint_.toFColor());
+    }
+    renderer.endSpriteBatch();
+    if (!lod_icons_.empty()) {
+        renderer.drawUIFilledRects(lod_icons_);
+    }
+}
 
-        // 获取组件（此时已保证实体在该视图中）
+void RenderSystem::extract(entt::registry& registry, const render::Camera* camera, std::uint64_t tick, double animation_time_ms) {
+    glm::vec2 view_min{0.0f};
+    glm::vec2 view_max{0.0f};
+    if (camera) {
+        view_min = camera->getPosition() - glm::vec2(EXTRACT_MARGIN);
+        view_max = camera->getPosition() + camera->getViewSize() + glm::vec2(EXTRACT_MARGIN);
+    }
+
+    auto& frame = render_state_.beginWrite();
+    frame.entries_.clear();
+    frame.sheets_.clear();
+    frame.tick_ = tick;
+    frame.animation_time_ms_ = animation_time_ms;
+
+    const auto& previous_storage = registry.storage<component::PreviousTransformComponent>();
+    const auto& sheet_storage = registry.storage<component::SheetAnimationComponent>();
+    const auto& icon_storage = registry.storage<component::LodIconComponent>();
+    auto view = ecs::renderGroup(registry);
+    frame.entries_.reserve(view.size());
+    for (auto entity : view) {
         const auto& transform = view.get<component::TransformComponent>(entity);
         const auto& sprite = view.get<component::SpriteComponent>(entity);
-        const auto& render_component = view.get<component::RenderComponent>(entity);
 
-        // 计算最终渲染位置：实体位置 + 精灵偏移
-        auto position = transform.position_ + sprite.offset_;
+        // 计算最终渲染位置：实体位置 + 精灵偏移；计算最终渲染大小：精灵大小 × 变换缩放
+        const auto position = transform.position_ + sprite.offset_;
+        const auto size = sprite.size_ * transform.scale_;
+
+        if (camera) {
+            // 负缩放会得到负宽高，先归一化再做相交测试；上一步位置与本步相差不到一帧的移动，按本步位置判断即可
+            const auto rect_min = glm::min(position, position + size);
+            const auto rect_max = glm::max(position, position + size);
+            if (rect_max.x < view_min.x || rect_min.x > view_max.x ||
+                rect_max.y < view_min.y || rect_min.y > view_max.y) {
+                continue;
+            }
+        }
+
+        // 快照不是最新一步的（已停止移动、刚传送）不插值，上一步位置即本步位置
+        auto previous_position = position;
+        if (previous_storage.contains(entity)) {
+            const auto& previous = previous_storage.get(entity);
+            if (previous.tick_ == tick) {
+                previous_position = previous.position_ + sprite.offset_;
+            }
+        }
 
-        // 计算最终渲染大小：精灵大小 × 变换缩放
-        auto size = sprite.size_ * transform.scale_;
+        auto sheet = render::RenderStateEntry::NO_SHEET;
+        if (sheet_storage.contains(entity)) {
+            sheet = static_cast<std::uint32_t>(frame.sheets_.size());
+            frame.sheets_.push_back(sheet_storage.get(entity));
+        }
 
-        // 调用渲染器绘制
-        renderer.drawSprite(camera, sprite.sprite_, position, size, transform.rotation_, render_component.color_);
+        const auto& render = view.get<component::RenderComponent>(entity);
+        render::RenderStateEntry entry{entity, sprite.sprite_, previous_position, position, size,
+                                       transform.rotation_, render.color_, render.sort_key_, sheet};
+        if (icon_storage.contains(entity)) {
+            entry.lod_icon_ = icon_storage.get(entity).color_;
+        }
+        frame.entries_.push_back(entry);
     }
+    // 发布之后这份快照归交接位所有，不再访问 frame
+    ENGINE_PROFILE_COUNTER("render.extracted", static_cast<std::int64_t>(frame.entries_.size()));
+    render_state_.publish();
+}
+
+void RenderSystem::reserve(std::size_t count) {
+    render_state_.reserve(count);
+    visible_.reserve(count);
+    draw_order_.reserve(count);
+    sort_scratch_.reserve(count);
+}
+
+std::size_t RenderSystem::prepareDrawOrder(const render::Camera* camera) {
+    const auto* frame = render_state_.acquire();
+    if (!frame) {
+        return 0;
+    }
+    cullVisible(*frame, camera);
+    ENGINE_PROFILE_COUNTER("render.visible", static_cast<std::int64_t>(visible_.size()));
+
+    if (incremental_sort_) {
+        updateDrawOrder();
+    } else {
+        sortFull();
+    }
+    sort_stats_ = RenderSortStats{draw_order_.size(), last_reorder_count_, incremental_sort_, culled_count_};
+    return draw_order_.size();
+}
+
+void RenderSystem::cullVisible(const render::RenderStateFrame& frame, const render::Camera* camera) {
+    // 清除上一帧的可见标记（只需遍历上一帧的可见列表）
+    for (const auto& visible : visible_) {
+        visible_slot_[entt::to_entity(visible.entity_)] = 0;
+    }
+    visible_.clear();
+
+    // 世界坐标下的视野范围（相机位置起的一个视野大小，即视口大小 / 缩放倍数），
+    // 外扩边距与 Renderer::isRectInViewport 一致，避免旋转精灵在边缘被提前剔除
+    glm::vec2 view_min{0.0f};
+    glm::vec2 view_max{0.0f};
+    if (camera) {
+        view_min = camera->getPosition() - glm::vec2(CULL_MARGIN);
+        view_max = camera->getPosition() + camera->getViewSize() + glm::vec2(CULL_MARGIN);
+    }
+
+    animation_time_ms_ = frame.animation_time_ms_;
+
+    // 在快照记录的上一模拟步与最新模拟步位置之间插值；快照之后又推进了模拟却没有提取时不插值
+    const bool interpolate = interpolation_alpha_ < 1.0f && frame.tick_ == interpolation_tick_;
+
+    visible_.reserve(frame.entries_.size());
+    for (const auto& entry : frame.entries_) {
+        const auto position = interpolate ? glm::mix(entry.previous_position_, entry.position_, interpolation_alpha_) : entry.position_;
+        const auto size = entry.size_;
+
+        if (camera) {
+            // 负缩放会得到负宽高，先归一化再做相交测试
+            const auto rect_min = glm::min(position, position + size);
+            const auto rect_max = glm::max(position, position + size);
+            if (rect_max.x < view_min.x || rect_min.x > view_max.x ||
+                rect_max.y < view_min.y || rect_min.y > view_max.y) {
+                continue;
+            }
+        }
+
+        const auto index = static_cast<std::size_t>(entt::to_entity(entry.entity_));
+        if (index >= visible_slot_.size()) {
+            visible_slot_.resize(index + 1, 0);
+        }
+        const auto* sheet = entry.sheet_ == render::RenderStateEntry::NO_SHEET ? nullptr : &frame.sheets_[entry.sheet_];
+        visible_.push_back(VisibleSprite{entry.entity_, &entry.sprite_, position, size, entry.angle_, entry.tint_, entry.sort_key_, sheet,
+                                         entry.lod_icon_});
+        visible_slot_[index] = static_cast<std::uint32_t>(visible_.size());
+    }
+    culled_count_ = frame.entries_.size() - visible_.size();
+}
+
+void RenderSystem::setLateLatchOffset(entt::entity entity, glm::vec2 offset) {
+    late_offsets_.emplace_back(entity, offset);
+}
+
+void RenderSystem::setInterpolation(float alpha, std::uint64_t tick) {
+    interpolation_alpha_ = glm::clamp(alpha, 0.0f, 1.0f);
+    interpolation_tick_ = tick;
+}
+
+const RenderSystem::VisibleSprite* RenderSystem::findVisible(entt::entity entity) const {
+    const auto index = static_cast<std::size_t>(entt::to_entity(entity));
+    if (index >= visible_slot_.size() || visible_slot_[index] == 0) {
+        return nullptr;
+    }
+    // 实体索引可能被新实体复用，需比对完整句柄（含版本）
+    const auto& visible = visible_[visible_slot_[index] - 1];
+    return visible.entity_ == entity ? &visible : nullptr;
+}
+
+void RenderSystem::sortFull() {
+    draw_order_.clear();
+    for (const auto& visible : visible_) {
+        draw_order_.push_back(DrawEntry{visible.sort_key_, visible.entity_});
+    }
+    // 按排序键（层级、深度、纹理）排序，确保正确的渲染顺序
+    radixSortByKey(draw_order_.data(), draw_order_.data() + draw_order_.size(), sort_scratch_);
+    last_reorder_count_ = draw_order_.size();
+}
+
+void RenderSystem::updateDrawOrder() {
+    std::size_t reordered = 0;
+
+    // 1. 剔除失效条目（实体已销毁、不再可渲染或离开视野），同时刷新排序键；
+    //    YSortSystem 只重算移动/被 patch 的实体，键未变的条目保持有序，记下第一个键变化的位置
+    std::size_t kept = 0;
+    std::size_t first_changed = draw_order_.size();
+    for (const auto& entry : draw_order_) {
+        const auto* visible = findVisible(entry.entity_);
+        if (!visible) {
+            in_order_[entt::to_entity(entry.entity_)] = 0;
+            continue;
+        }
+        if (first_changed == draw_order_.size() && entry.sort_key_ != visible->sort_key_) {
+            first_changed = kept;
+        }
+        draw_order_[kept++] = DrawEntry{visible->sort_key_, entry.entity_};
+    }
+    first_changed = std::min(first_changed, kept);
+    draw_order_.resize(kept);
+
+    // 2. 修复已有序列：上一帧有序，first_changed 之前的前缀仍然有序，只需从该处开始检查
+    const std::size_t repair_begin = std::max<std::size_t>(first_changed, 1);
+    std::size_t descents = 0;
+    for (std::size_t i = repair_begin; i < kept; ++i) {
+        if (draw_order_[i] < draw_order_[i - 1]) {
+            ++descents;
+        }
+    }
+    if (descents > kept / REPAIR_FALLBACK_DIVISOR) {
+        // 大面积乱序（如整体切换图层、刷怪与大规模混战），插入排序会退化为 O(n^2)
+        radixSortByKey(draw_order_.data(), draw_order_.data() + kept, sort_scratch_);
+        reordered += kept;
+    } else if (descents > 0) {
+        for (std::size_t i = repair_begin; i < kept; ++i) {
+            if (!(draw_order_[i] < draw_order_[i - 1])) {
+                continue;
+            }
+            const DrawEntry entry = draw_order_[i];
+            std::size_t j = i;
+            do {
+                draw_order_[j] = draw_order_[j - 1];
+                --j;
+            } while (j > 0 && entry < draw_order_[j - 1]);
+            draw_order_[j] = entry;
+            ++reordered;
+        }
+    }
+
+    // 3. 追加新进入视野的可渲染实体，排序后与已有序列归并
+    if (in_order_.size() < visible_slot_.size()) {
+        in_order_.resize(visible_slot_.size(), 0);
+    }
+    for (const auto& visible : visible_) {
+        const auto index = static_cast<std::size_t>(entt::to_entity(visible.entity_));
+        if (in_order_[index]) {
+            continue;
+        }
+        in_order_[index] = 1;
+        draw_order_.push_back(DrawEntry{visible.sort_key_, visible.entity_});
+    }
+    if (draw_order_.size() > kept) {
+        const auto middle = draw_order_.begin() + static_cast<std::ptrdiff_t>(kept);
+        radixSortByKey(draw_order_.data() + kept, draw_order_.data() + draw_order_.size(), sort_scratch_);
+        // 经暂存区归并（std::merge 稳定，等键时已有条目在前）；std::inplace_merge 每次调用都会申请临时缓冲
+        sort_scratch_.resize(draw_order_.size());
+        std::merge(draw_order_.begin(), middle, middle, draw_order_.end(), sort_scratch_.begin());
+        std::copy(sort_scratch_.begin(), sort_scratch_.end(), draw_order_.begin());
+        reordered += draw_order_.size() - kept;
+    }
+
+    last_reorder_count_ = reordered;
 }
 
-} // namespace engine::system
\ No newline at end of file
+} // namespace engine::system
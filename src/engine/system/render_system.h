@@ -16,10 +16,15 @@
  * - 输出：调用 Renderer 绘制精灵
  *
  * @par 渲染流程
- * 1. 查询所有可渲染实体（具有 Transform + Sprite）
- * 2. 计算世界坐标：transform.position + sprite.offset
- * 3. 应用缩放：sprite.size * transform.scale
- * 4. 调用 renderer.drawSprite() 提交渲染
+ * 1. 提取（模拟侧，每次模拟更新结束时）：遍历渲染分组，计算世界坐标（transform.position + sprite.offset）与
+ *    大小（sprite.size * transform.scale），把视野附近实体的绘制数据拷贝进 RenderStateBuffers 的一份快照并发布
+ * 2. 可见性剔除（渲染侧）：取最新快照，按插值系数求出绘制位置，只把与相机视野相交的条目写入紧凑的可见列表
+ * 3. 只对可见列表排序
+ * 4. 按可见列表中缓存的参数调用 renderer.drawSprite() 提交渲染；带 SheetAnimationComponent 的条目
+ *    在这里按快照的动画时钟算出当前帧，装饰动画不需要逐步推进；带 LodIconComponent 的条目在相机拉远到
+ *    屏幕尺寸低于 LOD_ICON_THRESHOLD 时改画单色图标，精灵批次结束后一次提交
+ *
+ * 第 2~4 步只读快照，不访问 entt::registry；渲染移到独立线程时，模拟与渲染之间只经三缓冲交接。
  *
  * @see engine::component::TransformComponent 定义渲染位置
  * @see engine::component::SpriteComponent 定义渲染外观
@@ -28,13 +33,31 @@
 
 #pragma once
 #include <entt/entity/registry.hpp>
+#include <glm/vec2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../render/render_state.h"
+#include "../render/renderer.h"
+#include "../utils/math.h"
 
 namespace engine::render {
-    class Renderer;  ///< 前向声明：渲染器类
     class Camera;    ///< 前向声明：摄像机类
 }
 
 namespace engine::system {
+    /**
+     * @struct RenderSortStats
+     * @brief 渲染排序统计，由 getSortStats() 取得；场景在更新阶段写入 registry 上下文，供调试面板读取
+     */
+    struct RenderSortStats {
+        std::size_t entry_count_{0};      ///< 本帧参与绘制排序的条目数
+        std::size_t reorder_count_{0};    ///< 本帧被重新排序的条目数
+        bool incremental_{true};          ///< 本帧是否使用增量排序模式
+        std::size_t culled_count_{0};     ///< 本帧被视口剔除、未进入排序的条目数
+    };
+
     /**
      * @class RenderSystem
      * @brief ECS渲染系统，负责绘制场景中的所有实体。
@@ -44,14 +67,29 @@ namespace engine::system {
      * 根据组件数据计算渲染参数，并调用 Renderer 进行绘制。
      *
      * @par 渲染顺序
-     * 目前按实体在 EnTT registry 中的顺序渲染。
-     * 如需控制渲染顺序（如实现层级），可考虑：
-     * - 添加 ZComponent 存储深度值
-     * - 使用 registry.sort<>() 对实体排序
-     * - 实现多遍渲染（先背景后前景）
+     * 按 RenderComponent 的 64 位排序键（层级 | Y 深度 | 纹理决胜值）排序后渲染，支持两种模式：
+     * - 增量模式（默认）：系统持有一份持久的绘制顺序索引，每帧只刷新排序键，
+     *   利用相邻帧之间顺序几乎不变的特点，用插入排序修复已有条目，
+     *   新加入的实体先排好序再与已有序列归并，代价接近 O(n)。
+     *   YSortSystem 只重算移动过的实体，刷新排序键时记下第一个键发生变化的条目，
+     *   插入修复从该处开始；没有键变化时整个修复步骤被跳过。
+     * - 全量模式：每帧对可见条目重新做一次稳定排序。
+     *
+     * 层级的排序策略（RenderLayerPolicies）由 YSortSystem 写入排序键：TEXTURE 层级整段按纹理分组、NONE 层级保持原顺序，
+     * 排序本身不区分策略。
+     *
+     * 排序键相同的条目（同层级、同深度、纹理 ID 低 16 位相同）保持原有顺序；全量排序、大面积乱序回退
+     * 与新条目的排序对 64 位键做 LSD 基数排序，条目较少时改用 std::stable_sort。
+     *
+     * 排序之前先做一次可见性剔除：视野之外的实体既不进入排序，也不会触发纹理查找。
+     *
+     * 每帧被移动位置的条目数可通过 getLastReorderCount() 获取，完整统计见 getSortStats()，用于观察排序开销。
      */
     class RenderSystem {
     public:
+        static constexpr float LOD_ICON_THRESHOLD = 16.0f;  ///< 精灵屏幕尺寸（较长边，像素）低于此值时改画远景图标
+        static constexpr float LOD_ICON_SIZE = 6.0f;        ///< 远景图标边长（屏幕像素）
+
         /** @brief 默认构造函数 */
         RenderSystem() = default;
 
@@ -59,15 +97,117 @@ namespace engine::system {
         ~RenderSystem() = default;
 
         /**
-         * @brief 更新（渲染）所有符合条件的实体
+         * @brief 提取渲染分组的绘制数据并发布为最新快照（模拟侧，每次模拟更新结束后调用一次）
          * @param registry EnTT实体注册表
+         * @param camera 用于粗剔除的摄像机（按 EXTRACT_MARGIN 外扩），为空时提取全部实体
+         * @param tick 最新模拟步序号；只有位置快照 tick_ 与之相等的实体才记录上一步位置用于插值
+         * @param animation_time_ms 动画时钟（关卡开始以来的模拟时间，毫秒），精灵表动画据此计算当前帧
+         *
+         * @note 只有同时具有 TransformComponent 和 SpriteComponent 的实体才会被提取
+         */
+        void extract(entt::registry& registry, const engine::render::Camera* camera, std::uint64_t tick,
+                     double animation_time_ms = 0.0);
+
+        /**
+         * @brief 绘制最新快照（渲染侧，不访问注册表）
          * @param renderer 渲染器引用，用于实际绘制
-         * @param camera 摄像机引用，用于坐标转换
+         * @param camera 摄像机引用，用于剔除与坐标转换
+         */
+        void update(engine::render::Renderer& renderer, const engine::render::Camera& camera);
+
+        /**
+         * @brief 对最新快照执行可见性剔除与绘制排序（不提交绘制），并更新 getSortStats()
+         * @param camera 用于剔除的摄像机，为空时不剔除（全部视为可见）
+         * @return 参与排序的条目数；尚未提取过快照时为 0
          *
-         * @note 只有同时具有 TransformComponent 和 SpriteComponent 的实体才会被渲染
+         * @note update() 内部先调用本函数；基准测试可单独调用以测量剔除与排序开销
+         */
+        std::size_t prepareDrawOrder(const engine::render::Camera* camera = nullptr);
+
+        /// @brief 为快照与可见列表预留容量（关卡开始前按峰值人口调用，战斗中途不再扩容）
+        void reserve(std::size_t count);
+
+        /**
+         * @brief 设置是否使用增量排序模式
+         * @param enabled true 使用持久绘制顺序索引，false 每帧全量排序
          */
-        void update(entt::registry& registry,
-                    engine::render::Renderer& renderer,
-                    const engine::render::Camera& camera);
+        void setIncrementalSort(bool enabled);
+
+        /**
+         * @brief 设置本帧的渲染插值参数（固定步长模拟时由场景在绘制前调用）
+         * @param alpha 插值系数，1 表示直接使用当前位置
+         * @param tick 最新模拟步序号；与快照的 tick_ 不符（本帧之后没有再提取）时不插值
+         * @see engine::component::PreviousTransformComponent
+         */
+        void setInterpolation(float alpha, std::uint64_t tick);
+
+        /**
+         * @brief 下一次 update() 绘制 entity 时平移 offset（世界坐标），绘制后清除
+         * @details 跟随鼠标的精灵（放置预览）在模拟中按帧开头的鼠标位置摆放，场景在提交绘制前按晚采样的鼠标位置
+         *          给出修正；只改绘制位置，不改排序键与剔除结果
+         */
+        void setLateLatchOffset(entt::entity entity, glm::vec2 offset);
+
+        /** @brief 最近一次 prepareDrawOrder() 的排序统计 */
+        [[nodiscard]] const RenderSortStats& getSortStats() const { return sort_stats_; }
+
+        /** @brief 是否处于增量排序模式 */
+        [[nodiscard]] bool isIncrementalSort() const { return incremental_sort_; }
+
+        /**
+         * @brief 获取上一帧被重新排序的条目数
+         * @return 增量模式下为插入修复移动的条目数与新并入条目数之和；全量模式下为参与排序的条目总数
+         */
+        [[nodiscard]] std::size_t getLastReorderCount() const { return last_reorder_count_; }
+
+    private:
+        /**
+         * @struct DrawEntry
+         * @brief 绘制顺序索引中的一项，缓存排序键避免排序时反复查询组件存储
+         */
+        struct DrawEntry {
+            std::uint64_t sort_key_{0};         ///< 缓存的排序键（RenderComponent::sort_key_）
+            entt::entity entity_{entt::null};   ///< 实体句柄
+
+            bool operator<(const DrawEntry& other) const { return sort_key_ < other.sort_key_; }
+        };
+
+        /**
+         * @struct VisibleSprite
+         * @brief 可见性剔除后的一条绘制数据（已插值），绘制时不再回查快照
+         */
+        struct VisibleSprite {
+            entt::entity entity_{entt::null};
+            const engine::component::Sprite* sprite_{nullptr};  ///< 指向读取端持有的快照，仅在本帧内有效
+            glm::vec2 position_{0.0f};          ///< 世界坐标（已加精灵偏移）
+            glm::vec2 size_{0.0f};              ///< 绘制大小（已乘变换缩放）
+            float angle_{0.0f};
+            engine::utils::Color8 tint_{};
+            std::uint64_t sort_key_{0};
+            const engine::component::SheetAnimationComponent* sheet_{nullptr};  ///< 精灵表动画属性（快照内），为空时直接用 sprite_
+            engine::utils::Color8 lod_icon_{0.0f, 0.0f, 0.0f, 0.0f};         ///< 远景图标颜色，透明表示没有图标
+        };
+
+        void cullVisible(const engine::render::RenderStateFrame& frame, const engine::render::Camera* camera);  ///< @brief 构建本帧可见列表
+        /// @brief 实体本帧可见时返回其在 visible_ 中的数据，否则返回 nullptr
+        [[nodiscard]] const VisibleSprite* findVisible(entt::entity entity) const;
+        void updateDrawOrder();     ///< @brief 增量维护可见条目的绘制顺序索引
+        void sortFull();            ///< @brief 每帧对可见条目全量重排
+
+        engine::render::RenderStateBuffers render_state_;   ///< 模拟侧写入、渲染侧读取的三缓冲快照
+        std::vector<VisibleSprite> visible_;     ///< 本帧可见的渲染条目（快照中的顺序）
+        std::vector<std::uint32_t> visible_slot_;   ///< 以实体索引为下标，值为 visible_ 下标 + 1，0 表示不可见
+        std::size_t culled_count_{0};            ///< 本帧被剔除的条目数
+        std::vector<DrawEntry> draw_order_;      ///< 持久的绘制顺序索引（已按排序键有序）
+        std::vector<std::uint8_t> in_order_;     ///< 以实体索引为下标，标记实体是否已在 draw_order_ 中
+        std::vector<DrawEntry> sort_scratch_;    ///< 基数排序与归并的暂存区（跨帧复用容量）
+        std::vector<engine::render::UIFilledRect> lod_icons_;  ///< 本帧改画为图标的条目（屏幕坐标，跨帧复用容量）
+        std::vector<std::pair<entt::entity, glm::vec2>> late_offsets_;  ///< 本帧绘制前的晚采样修正（跨帧复用容量）
+        bool incremental_sort_{true};            ///< 是否使用增量排序模式
+        std::size_t last_reorder_count_{0};      ///< 上一帧被重新排序的条目数
+        RenderSortStats sort_stats_{};
+        double animation_time_ms_{0.0};          ///< 当前快照的动画时钟
+        float interpolation_alpha_{1.0f};        ///< 渲染插值系数
+        std::uint64_t interpolation_tick_{0};    ///< 最新模拟步序号
     };
 } // namespace engine::system
\ No newline at end of file
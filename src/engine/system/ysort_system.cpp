@@ -3,12 +3,11 @@
  * @brief YSortSystem 类的实现，负责根据实体Y坐标更新渲染排序。
  * 
  * @details
- * 本文件实现了 YSortSystem::update() 方法，遍历所有具有
- * TransformComponent、RenderComponent 和 SpriteComponent 的实体，
- * 根据实体的Y坐标位置更新其渲染排序索引。
+ * 本文件实现了 YSortSystem 的 update() 方法：只为被信号标记为脏的实体重算渲染排序索引，
+ * 静态实体与停下的单位排序键保持不变。
  * 
  * @par 实现细节
- * - 使用 registry.view<>() 高效查询符合条件的实体
+ * - 脏集合由 ecs::ChangeTracker 维护，重复标记自动去重，组件销毁时同步移除
  * - 计算排序索引：transform.position_.y + sprite.size_.y
  * - 这样可以确保实体的底部边缘对齐排序，产生更自然的视觉效果
  */
@@ -18,18 +17,29 @@
 #include "../component/render_component.h"
 #include "../component/transform_component.h"
 #include "../component/sprite_component.h"
+#include "../component/parallax_component.h"
+#include "../ecs/groups.h"
+#include "../utils/profiler.h"
 
 namespace engine::system {
+    YSortSystem::YSortSystem(entt::registry& registry) : changes_(registry) {
+        // 接管系统创建前已存在的可渲染实体
+        for (auto entity : ecs::renderGroup(registry)) {
+            changes_.mark(entity);
+        }
+    }
+
+    YSortSystem::~YSortSystem() = default;
+
     /**
-     * @brief 更新所有实体的Y轴排序索引
+     * @brief 更新可移动实体与脏实体的Y轴排序索引
      * @param registry EnTT实体注册表，包含所有实体和组件
      * 
      * @details
-     * 该方法实现了Y轴排序的核心逻辑：
-     * 1. 创建实体视图：获取同时具有 RenderComponent、TransformComponent 和 SpriteComponent 的实体
-     * 2. 遍历视图中的所有实体
-     * 3. 计算排序索引：transform.position_.y + sprite.size_.y
-     * 4. 更新 RenderComponent 的 y_index_ 为计算值
+     * 1. 遍历脏集合：被 emplace / replace / patch 过变换或精灵的实体（含 MovementSystem 本步移动过的实体、
+     *    已停用的池化实体，恢复启用时排序键已是最新值）
+     * 2. 计算排序索引：transform.position_.y + sprite.size_.y
+     * 3. 写入 RenderComponent 排序键的 Y 深度，平局决胜值取纹理 ID 的低 16 位
      * 
      * @par 排序计算说明
      * 使用 transform.position_.y + sprite.size_.y 而不是简单的 transform.position_.y，
@@ -37,24 +47,48 @@ namespace engine::system {
      * 例如，较高的角色会从其底部开始与其他角色比较，而不是从顶部。
      * 
      * @par 性能考虑
-     * - 使用 EnTT 的 view 功能，避免遍历所有实体
-     * - 只查询必要的组件，减少内存访问
-     * - 计算简单，每帧执行成本低
+     * - 静态瓦片、已放置单位与被阻挡 / 攻击中停下的单位不再逐帧访问，开销与「本帧实际移动的实体数」成正比
+     * - 未被重算的排序键保持原值，RenderSystem 增量排序扫描到的键变化随之减少
      */
     void YSortSystem::update(entt::registry& registry) {
-        // 获取同时具有 RenderComponent、TransformComponent 和 SpriteComponent 的实体视图
-        auto view = registry.view<component::RenderComponent, const component::TransformComponent, const component::SpriteComponent>();
-        
-        // 遍历视图中的所有实体
-        for (auto entity : view) {
-            // 获取组件引用
-            auto& render = view.get<component::RenderComponent>(entity);
-            const auto& transform = view.get<const component::TransformComponent>(entity);
-            const auto& sprite = view.get<const component::SpriteComponent>(entity);
-            
-            // 计算排序索引：使用实体底部的Y坐标
-            // 这样可以确保实体的底部边缘对齐排序，产生更自然的视觉效果
-            render.y_index_ = transform.position_.y + sprite.size_.y;
+        // 层级策略变化（加载关卡时声明）后，已有实体的排序键全部按新策略重算
+        const auto* policies = registry.ctx().find<component::RenderLayerPolicies>();
+        if (policies != policies_ || (policies && policies->getVersion() != policy_version_)) {
+            policies_ = policies;
+            policy_version_ = policies ? policies->getVersion() : 0;
+            for (auto entity : ecs::renderGroup(registry)) {
+                changes_.mark(entity);
+            }
         }
+
+        // 信号标记的脏实体：按存储逐个判断，停用（DisabledTag）的实体同样更新；图像图层不参与 Y 排序
+        auto& renders = registry.storage<component::RenderComponent>();
+        const auto& transforms = registry.storage<component::TransformComponent>();
+        const auto& sprites = registry.storage<component::SpriteComponent>();
+        const auto& parallaxes = registry.storage<component::ParallaxComponent>();
+        for (auto entity : changes_.dirty()) {
+            if (renders.contains(entity) && transforms.contains(entity) && sprites.contains(entity) &&
+                !parallaxes.contains(entity)) {
+                const auto& sprite = sprites.get(entity);
+                auto& render = renders.get(entity);
+                switch (policies ? policies->get(render.getLayerIndex()) : component::RenderSortPolicy::Y_SORT) {
+                case component::RenderSortPolicy::NONE:
+                    render.setYIndex(0.0f);
+                    break;
+                case component::RenderSortPolicy::TEXTURE:
+                    render.setTextureOrder(static_cast<std::uint32_t>(sprite.sprite_.texture_id_));
+                    break;
+                default:
+                    // 使用实体底部的Y坐标，确保底部边缘对齐排序；同深度按纹理排，便于合批
+                    render.setYIndex(transforms.get(entity).position_.y + sprite.size_.y,
+                                     static_cast<std::uint16_t>(sprite.sprite_.texture_id_));
+                    break;
+                }
+            }
+        }
+
+        last_update_count_ = changes_.size();
+        changes_.clear();
+        ENGINE_PROFILE_COUNTER("ysort.updated", static_cast<std::int64_t>(last_update_count_));
     }
-}
+}
\ No newline at end of file
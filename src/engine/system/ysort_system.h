@@ -4,7 +4,7 @@
  * 
  * @details
  * YSortSystem 是ECS架构中的系统（System），负责根据实体的Y轴位置
- * 更新其 RenderComponent 的 y_index_ 值，实现2D游戏中的Y轴排序效果。
+ * 更新其 RenderComponent 排序键中的 Y 深度，实现2D游戏中的Y轴排序效果。
  * 
  * 该系统解决了2D游戏中的深度排序问题，特别是在2.5D视角的游戏中：
  * - 角色在场景中移动时，根据其Y坐标自动调整渲染顺序
@@ -12,15 +12,27 @@
  * - 实现角色之间的遮挡关系
  * 
  * @par ECS架构角色
- * - 查询：获取同时具有 TransformComponent 和 RenderComponent 的实体
+ * - 查询：上次更新以来被构造 / patch 过变换、精灵或渲染组件的实体（图像图层除外）
  * - 处理：读取实体的Y坐标位置
- * - 修改：更新 RenderComponent 的 y_index_ 字段
+ * - 修改：RenderComponent::setYIndex()（Y 深度与纹理平局决胜值）
+ *
+ * @par 增量更新
+ * 静态瓦片、已放置的单位位置不变，不必每帧重算。系统经 ecs::ChangeTracker 监听 TransformComponent、
+ * SpriteComponent、RenderComponent 的 on_construct/on_update 信号（registry.emplace / replace / patch），
+ * update() 只处理脏集合；MovementSystem 为本步实际移动的实体补发 patch，停下的单位不再重算。
+ * 因此绕过 registry 直接改写位置的代码需要随后调用 registry.patch<TransformComponent>(entity)。
  * 
+ * @par 排序策略
+ * 层级在 RenderLayerPolicies（registry 上下文）中声明为 NONE / TEXTURE 时不写 Y 深度：
+ * NONE 的排序键只剩层级，TEXTURE 的深度字段存纹理 ID。这些层级的实体移动也不会改变排序键，
+ * RenderSystem 不必为它们修复顺序。策略表变化时全部可渲染实体重新计算一次。
+ *
  * @par 排序原理
  * 1. 读取实体的 TransformComponent.position_.y
- * 2. 将该值赋给 RenderComponent.y_index_
- * 3. RenderSystem 在渲染时根据 y_index_ 排序
+ * 2. 将该值写入 RenderComponent 的排序键（同深度按纹理 ID 低 16 位决胜）
+ * 3. RenderSystem 在渲染时根据排序键排序
  * 4. Y值较小的实体先渲染（在底层），Y值较大的实体后渲染（在上层）
+ *    没有被重算的实体排序键保持不变，RenderSystem 的增量排序只需修复键变化的条目
  * 
  * @see engine::component::TransformComponent 存储实体位置数据
  * @see engine::component::RenderComponent 存储渲染排序数据
@@ -28,7 +40,12 @@
  */
 
 #pragma once
+#include <cstddef>
 #include <entt/entity/registry.hpp>
+#include "../component/render_component.h"
+#include "../component/sprite_component.h"
+#include "../component/transform_component.h"
+#include "../ecs/change_tracker.h"
 
 namespace engine::system {
     /**
@@ -40,35 +57,47 @@ namespace engine::system {
      * 游戏世界中的垂直位置正确显示层级关系。
      * 
      * @par 系统执行流程
-     * 1. 创建实体视图：registry.view<TransformComponent, RenderComponent>()
-     * 2. 遍历视图中的所有实体
-     * 3. 读取 TransformComponent 的 position_.y 值
-     * 4. 更新 RenderComponent 的 y_index_ 为该Y值
-     * 5. RenderSystem 会使用此值进行排序渲染
+     * 1. 遍历信号收集的脏集合（停用的池化实体同样更新，恢复启用时无需重算）
+     * 2. 更新 RenderComponent 的 Y 深度为 position_.y + size_.y 并清空脏集合
+     * 3. RenderSystem 会使用此值进行排序渲染
      * 
      * @par 应用场景
      * - 2D平台游戏中的角色与背景排序
      * - 2.5D视角游戏中的深度关系
      * - 任何需要根据Y坐标确定渲染顺序的场景
      */
-    class YSortSystem {
+    class YSortSystem final {
     public:
         /**
-         * @brief 默认构造函数
+         * @brief 构造函数，连接组件信号并把已存在的可渲染实体全部标记为脏
+         * @param registry EnTT实体注册表
          */
-        YSortSystem() = default;
-        
+        explicit YSortSystem(entt::registry& registry);
+
         /**
-         * @brief 默认析构函数
+         * @brief 析构函数，断开组件信号
          */
-        ~YSortSystem() = default;
+        ~YSortSystem();
+
+        YSortSystem(const YSortSystem&) = delete;
+        YSortSystem& operator=(const YSortSystem&) = delete;
 
         /**
-         * @brief 更新所有实体的Y轴排序索引
-         * @param registry EnTT实体注册表，包含所有实体和组件
+         * @brief 更新脏实体的Y轴排序索引
+         * @param registry EnTT实体注册表，须与构造时传入的相同
          * 
-         * @note 只有同时具有 TransformComponent 和 RenderComponent 的实体才会被处理
+         * @note 只有同时具有 RenderComponent、TransformComponent 和 SpriteComponent 的实体才会被处理
          */
         void update(entt::registry& registry);
+
+        /** @brief 上一次 update() 重算的实体数（脏集合大小） */
+        [[nodiscard]] std::size_t getLastUpdateCount() const { return last_update_count_; }
+
+    private:
+        /// 等待重算 Y 深度的实体
+        ecs::ChangeTracker<component::TransformComponent, component::SpriteComponent, component::RenderComponent> changes_;
+        std::size_t last_update_count_{0};      ///< 上一次重算的实体数
+        const component::RenderLayerPolicies* policies_{nullptr};   ///< 上一次 update() 使用的策略表
+        std::uint32_t policy_version_{0};       ///< 上一次 update() 时策略表的版本
     };
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 /**
  * @file hover_state.h
- * @brief 定义HoverState类，表示UI元素的悬停状态。
+ * @brief 定义HoverState，表示UI元素的悬停状态。
  */
 
 #include "ui_state.h"
@@ -9,58 +9,28 @@
 namespace engine::ui::state {
 
 /**
- * @class HoverState
+ * @struct HoverState
  * @brief UI元素的悬停状态，表示鼠标悬停在元素上的状态。
  * 
- * HoverState类实现了UIState接口，处理UI元素在悬停状态下的行为：
- * - 进入状态时设置悬停状态的精灵
- * - 处理输入事件，当鼠标离开时切换回NormalState
- * - 处理输入事件，当鼠标按下时切换到PressedState
+ * - 进入状态时设置悬停状态的图片
+ * - 鼠标离开时切换回 NormalState
+ * - 鼠标按下时切换到 PressedState
  */
-class HoverState : public UIState {
-public:
+struct HoverState {
     /**
-     * @brief 构造函数。
+     * @brief 进入状态时调用，设置悬停状态的图片。
      * @param owner 状态所属的UIInteractive对象。
      */
-    HoverState(engine::ui::UIInteractive* owner);
-    
-    /**
-     * @brief 析构函数。
-     */
-    ~HoverState() override = default;
-    
-    /**
-     * @brief 进入状态时调用。
-     * 
-     * 进入悬停状态时，会设置悬停状态的精灵。
-     */
-    void enter() override;
-    
-    /**
-     * @brief 退出状态时调用。
-     * 
-     * 退出悬停状态时的清理操作。
-     */
-    void exit() override;
-    
-    /**
-     * @brief 状态更新时调用。
-     * @param deltaTime 自上一帧的时间间隔（秒）。
-     * 
-     * 悬停状态的更新操作。
-     */
-    void update(float deltaTime) override;
-    
+    void enter(engine::ui::UIInteractive& owner) const;
+
     /**
-     * @brief 处理输入事件时调用。
-     * @return 如果需要切换状态，返回新状态的指针；否则返回nullptr。
-     * 
-     * 处理悬停状态下的输入事件：
-     * - 当鼠标离开时，切换回NormalState
-     * - 当鼠标按下时，切换到PressedState
+     * @brief 处理输入事件。
+     * @param owner 状态所属的UIInteractive对象。
+     * @return 鼠标离开时返回 NormalState，鼠标按下时返回 PressedState，否则为空。
      */
-    std::unique_ptr<UIState> handleInput() override;
+    UITransition handleInput(engine::ui::UIInteractive& owner) const;
+
+    bool isIdle() const { return false; }
 };
 
 } // namespace engine::ui::state
@@ -1,11 +1,11 @@
 #pragma once
 /**
  * @file ui_state.h
- * @brief 定义UIState类，作为UI元素状态的基类。
+ * @brief 定义 UIState：可交互 UI 元素的值类型状态机。
  */
 
-#include <memory>
-#include <glm/vec2.hpp>
+#include <optional>
+#include <variant>
 
 namespace engine::ui {
     class UIInteractive;
@@ -13,63 +13,23 @@ namespace engine::ui {
 
 namespace engine::ui::state {
 
+struct NormalState;
+struct HoverState;
+struct PressedState;
+
 /**
- * @class UIState
- * @brief UI元素状态的基类，定义了状态的基本接口。
+ * @brief UI元素的当前状态，直接嵌入 UIInteractive，切换状态不分配内存。
  * 
- * UIState类是一个抽象基类，定义了状态的四个基本方法：
- * - enter()：进入状态时调用
- * - exit()：退出状态时调用
- * - update()：状态更新时调用
- * - handleInput()：处理输入事件时调用
+ * 各状态都是无数据的结构体，提供两个方法：
+ * - enter(owner)：进入状态时调用（切换图片、播放音效）
+ * - handleInput(owner)：处理输入，返回要切换到的状态；返回空表示保持当前状态
  * 
- * 所有具体的UI状态类都应该继承自这个类并实现这些方法。
+ * 另有 isIdle()：光标不在元素上时 handleInput() 是否必然返回空，UIManager 据此跳过空闲元素。
+ * std::monostate 表示未启用状态机（不响应悬停与按下）。
  */
-class UIState {
-protected:
-    engine::ui::UIInteractive* owner_; ///< 状态所属的UIInteractive对象
+using UIState = std::variant<std::monostate, NormalState, HoverState, PressedState>;
 
-public:
-    /**
-     * @brief 构造函数。
-     * @param owner 状态所属的UIInteractive对象。
-     */
-    UIState(engine::ui::UIInteractive* owner) : owner_(owner) {}
-    
-    /**
-     * @brief 析构函数。
-     */
-    virtual ~UIState() = default;
-    
-    /**
-     * @brief 进入状态时调用。
-     * 
-     * 当UI元素切换到该状态时，会调用此方法进行初始化。
-     */
-    virtual void enter() = 0;
-    
-    /**
-     * @brief 退出状态时调用。
-     * 
-     * 当UI元素从该状态切换到其他状态时，会调用此方法进行清理。
-     */
-    virtual void exit() = 0;
-    
-    /**
-     * @brief 状态更新时调用。
-     * @param deltaTime 自上一帧的时间间隔（秒）。
-     * 
-     * 每帧更新时，会调用当前状态的此方法。
-     */
-    virtual void update(float deltaTime) = 0;
-    
-    /**
-     * @brief 处理输入事件时调用。
-     * @return 如果需要切换状态，返回新状态的指针；否则返回nullptr。
-     * 
-     * 当UI元素处理输入事件时，会调用当前状态的此方法。
-     */
-    virtual std::unique_ptr<UIState> handleInput() = 0;
-};
+/// @brief handleInput() 的结果：要切换到的状态，空表示保持不变
+using UITransition = std::optional<UIState>;
 
-}
\ No newline at end of file
+}
@@ -37,7 +37,7 @@ UIButton::UIButton(engine::core::Context& context, const std::string& text, cons
     setSize({ 200.0f, 50.0f });
     
     // 设置初始状态为正常状态
-    setState(std::make_unique<state::NormalState>(this));
+    setState(state::NormalState{});
 }
 
 /**
@@ -92,7 +92,7 @@ UIButton::UIButton(
     setClickCallback(std::move(callback));
     
     // 设置初始状态为正常状态
-    setState(std::make_unique<state::NormalState>(this));
+    setState(state::NormalState{});
 }
 
 /**
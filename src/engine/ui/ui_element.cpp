@@ -1,11 +1,28 @@
 #include "ui_element.h"
 #include "../core/context.h"
 #include "../input/input_manager.h"
+#include "../memory/memory_estimate.h"
+#include "../render/renderer.h"
+#include <SDL3/SDL_render.h>
+#include <spdlog/spdlog.h>
 #include <algorithm>
+#include <limits>
+#include <utility>
 #include <glm/glm.hpp>
 
 namespace engine::ui {
 
+namespace {
+    /// 缓存纹理四周的留白，容纳文本阴影与取整误差
+    constexpr float CACHE_PADDING = 2.0f;
+}
+
+void UIElement::TextureDeleter::operator()(SDL_Texture* texture) const {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+    }
+}
+
 /**
  * @brief 构造函数。
  * @param context 引擎上下文引用。
@@ -45,10 +62,139 @@ void UIElement::render() {
 
     // 渲染所有子元素
     for (auto& child : children_) {
-        child->render();
+        child->composite();
     }
 }
 
+/**
+ * @brief 合成元素。
+ * 
+ * 未缓存（或正处于外层缓存的重建过程中）时直接绘制；缓存元素只在被标脏后重建纹理，
+ * 其余帧只贴一次图。纹理创建失败时永久退回直接绘制。
+ */
+void UIElement::composite() {
+    if (!visible_) {
+        return;
+    }
+
+    if (!cached_ || cache_depth_ > 0) {
+        render();
+        render_dirty_ = false;
+        return;
+    }
+
+    if (render_dirty_ && !rebuildCache()) {
+        render();
+        return;
+    }
+
+    if (cache_rect_.size.x > 0.0f && cache_rect_.size.y > 0.0f) {
+        context_.getRenderer().drawUITexture(cache_texture_.get(),
+                                             engine::utils::Rect{ glm::vec2{ 0.0f }, cache_rect_.size },
+                                             engine::utils::Rect{ cache_rect_.position - render_origin_, cache_rect_.size });
+    }
+}
+
+/**
+ * @brief 重新计算子树包围盒，必要时扩大纹理，再把子树绘制进去。
+ * @return 纹理不可用时返回 false（同时关闭缓存）。
+ */
+bool UIElement::rebuildCache() {
+    glm::vec2 min{ std::numeric_limits<float>::max() };
+    glm::vec2 max{ std::numeric_limits<float>::lowest() };
+    accumulateBounds(min, max);
+    render_dirty_ = false;
+    ++cache_rebuilds_;
+
+    if (min.x > max.x || min.y > max.y) {
+        cache_rect_ = {};       // 子树没有可见内容
+        return true;
+    }
+
+    const glm::vec2 origin = glm::floor(min) - CACHE_PADDING;
+    const glm::vec2 size = glm::ceil(max) + CACHE_PADDING - origin;
+    const glm::ivec2 needed{ size };
+
+    auto& renderer = context_.getRenderer();
+    if (!cache_texture_ || needed.x > cache_texture_size_.x || needed.y > cache_texture_size_.y) {
+        const glm::ivec2 allocated = glm::max(needed, cache_texture_size_);
+        cache_texture_.reset(renderer.createUICacheTexture(allocated));
+        cache_texture_size_ = cache_texture_ ? allocated : glm::ivec2{ 0, 0 };
+    }
+    if (!cache_texture_ || !renderer.beginRenderToTexture(cache_texture_.get())) {
+        spdlog::warn("UI 缓存纹理不可用，元素 {} 退回直接绘制", id_);
+        cached_ = false;
+        cache_texture_.reset();
+        cache_texture_size_ = { 0, 0 };
+        return false;
+    }
+
+    const glm::vec2 previous_origin = std::exchange(render_origin_, origin);
+    ++cache_depth_;
+    render();
+    --cache_depth_;
+    render_origin_ = previous_origin;
+    renderer.endRenderToTexture();
+
+    cache_rect_ = { origin, size };
+    return true;
+}
+
+void UIElement::accumulateBounds(glm::vec2& min, glm::vec2& max) const {
+    if (!visible_) {
+        return;
+    }
+    const auto rect = getDrawRect();
+    if (rect.size.x > 0.0f && rect.size.y > 0.0f) {
+        min = glm::min(min, rect.position);
+        max = glm::max(max, rect.position + rect.size);
+    }
+    if (clipsChildren()) {
+        return;
+    }
+    for (const auto& child : children_) {
+        child->accumulateBounds(min, max);
+    }
+}
+
+engine::utils::Rect UIElement::getDrawRect() const {
+    return { getWorldPosition(), getSize() };
+}
+
+void UIElement::markDirty() {
+    // 不能在已脏的祖先处提前停止：非缓存元素的标记不会被及时清除
+    for (UIElement* element = this; element; element = element->parent_) {
+        element->render_dirty_ = true;
+    }
+}
+
+void UIElement::setCached(bool cached) {
+    if (cached_ == cached) {
+        return;
+    }
+    cached_ = cached;
+    if (!cached_) {
+        cache_texture_.reset();
+        cache_texture_size_ = { 0, 0 };
+        cache_rect_ = {};
+    }
+    markDirty();
+}
+
+std::uint32_t UIElement::consumeCacheRebuilds() {
+    return std::exchange(cache_rebuilds_, 0u);
+}
+
+std::size_t UIElement::estimateTreeBytes() const {
+    std::size_t bytes = sizeof(UIElement) + engine::memory::containerBytes(children_) +
+                        engine::memory::containerBytes(child_ids_) +
+                        static_cast<std::size_t>(cache_texture_size_.x) * static_cast<std::size_t>(cache_texture_size_.y) * 4u;
+    for (const auto& child : children_) {
+        bytes += child->estimateTreeBytes();
+    }
+    return bytes;
+}
+
 /**
  * @brief 处理输入事件。
  * @return 如果事件被处理，返回true；否则返回false。
@@ -75,7 +221,9 @@ bool UIElement::handleInput() {
 void UIElement::addChild(std::unique_ptr<UIElement> child) {
     if (child) {
         child->setParent(this);
+        indexChild(child.get());
         children_.emplace_back(std::move(child));
+        markLayoutDirty();
     }
 }
 
@@ -83,7 +231,9 @@ void UIElement::addChild(std::unique_ptr<UIElement> child, int order_index) {
     if (child) {
         child->setParent(this);
         child->setOrderIndex(order_index);
+        indexChild(child.get());
         children_.emplace_back(std::move(child));
+        markLayoutDirty();
     }
 }
 
@@ -96,35 +246,33 @@ void UIElement::removeChild(UIElement* child) {
         return;
     }
 
-    for (auto it = children_.begin(); it != children_.end(); ++it) {
-        if (it->get() == child) {
-            children_.erase(it);
-            break;
-        }
+    auto it = std::find_if(children_.begin(), children_.end(), [child](const auto& element) { return element.get() == child; });
+    if (it == children_.end()) {
+        return;
     }
+    unindexChild(child);
+    children_.erase(it);
+    markLayoutDirty();
 }
 
 UIElement* UIElement::getChildById(entt::id_type id) const {
-    for (const auto& child : children_) {
-        if (child && child->getId() == id) {
-            return child.get();
-        }
+    if (auto it = child_ids_.find(id); it != child_ids_.end()) {
+        return it->second;
     }
     return nullptr;
 }
 
 bool UIElement::removeChildById(entt::id_type id) {
-    for (auto it = children_.begin(); it != children_.end(); ++it) {
-        if (*it && (*it)->getId() == id) {
-            children_.erase(it);
-            return true;
-        }
+    auto* child = getChildById(id);
+    if (!child) {
+        return false;
     }
-    return false;
+    removeChild(child);
+    return true;
 }
 
 void UIElement::sortChildrenByOrderIndex() {
-    std::stable_sort(children_.begin(), children_.end(), [](const auto& lhs, const auto& rhs) {
+    const auto less = [](const auto& lhs, const auto& rhs) {
         if (!lhs || !rhs) {
             return lhs != nullptr;
         }
@@ -132,7 +280,70 @@ void UIElement::sortChildrenByOrderIndex() {
             return lhs->getOrderIndex() < rhs->getOrderIndex();
         }
         return lhs->getId() < rhs->getId();
-    });
+    };
+    // 子元素多按顺序加入，先做一次线性检查，避免无谓的排序与重建缓存
+    if (std::is_sorted(children_.begin(), children_.end(), less)) {
+        return;
+    }
+    std::stable_sort(children_.begin(), children_.end(), less);
+    // 重复 ID 的索引应指向排序后最靠前的一个
+    child_ids_.clear();
+    for (const auto& child : children_) {
+        if (child && child->id_ != 0) {
+            child_ids_.try_emplace(child->id_, child.get());
+        }
+    }
+    markLayoutDirty();
+}
+
+void UIElement::setId(entt::id_type id) {
+    if (id_ == id) {
+        return;
+    }
+    if (parent_) {
+        parent_->unindexChild(this);
+    }
+    id_ = id;
+    if (parent_) {
+        parent_->indexChild(this);
+    }
+}
+
+void UIElement::indexChild(UIElement* child) {
+    if (child->id_ == 0) {
+        return;
+    }
+    auto [it, inserted] = child_ids_.try_emplace(child->id_, child);
+    if (inserted || it->second == child) {
+        return;
+    }
+    // 已有同 ID 的子元素：保持指向绘制顺序中最靠前的一个
+    for (const auto& element : children_) {
+        if (element.get() == it->second) {
+            return;
+        }
+        if (element.get() == child) {
+            it->second = child;
+            return;
+        }
+    }
+}
+
+void UIElement::unindexChild(const UIElement* child) {
+    if (child->id_ == 0) {
+        return;
+    }
+    auto it = child_ids_.find(child->id_);
+    if (it == child_ids_.end() || it->second != child) {
+        return;
+    }
+    for (const auto& element : children_) {
+        if (element.get() != child && element && element->id_ == child->id_) {
+            it->second = element.get();
+            return;
+        }
+    }
+    child_ids_.erase(it);
 }
 
 /**
@@ -140,16 +351,33 @@ void UIElement::sortChildrenByOrderIndex() {
  * @return 元素在世界坐标系中的位置。
  */
 glm::vec2 UIElement::getWorldPosition() const {
-    glm::vec2 world_pos = position_;
-    const UIElement* current_parent = parent_;
+    if (world_position_dirty_) {
+        // 父元素的世界坐标同样取自缓存，一次重算只走到第一个仍然有效的祖先
+        world_position_ = parent_ ? parent_->getWorldPosition() + position_ : position_;
+        world_position_dirty_ = false;
+    }
+    return world_position_;
+}
 
-    // 递归计算世界坐标
-    while (current_parent) {
-        world_pos += current_parent->position_;
-        current_parent = current_parent->parent_;
+void UIElement::invalidateWorldPosition() {
+    if (world_position_dirty_) {
+        return;
+    }
+    world_position_dirty_ = true;
+    for (const auto& child : children_) {
+        if (child) {
+            child->invalidateWorldPosition();
+        }
     }
+}
 
-    return world_pos;
+void UIElement::collectInputTargets(std::vector<UIInteractive*>& out) {
+    if (!visible_ || !enabled_) {
+        return;
+    }
+    for (auto it = children_.rbegin(); it != children_.rend(); ++it) {
+        (*it)->collectInputTargets(out);
+    }
 }
 
 /**
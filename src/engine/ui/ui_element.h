@@ -4,10 +4,16 @@
  * @brief 定义UIElement类，作为所有UI控件的基类。
  */
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
 #include <entt/core/hashed_string.hpp>
+#include "../utils/id_map.h"
+#include "../utils/math.h"
+
+struct SDL_Texture;
 
 namespace engine::core {
     class Context;
@@ -15,6 +21,8 @@ namespace engine::core {
 
 namespace engine::ui {
 
+class UIInteractive;
+
 /**
  * @class UIElement
  * @brief 所有UI控件的基类，提供通用的UI元素功能。
@@ -24,13 +32,22 @@ namespace engine::ui {
  * - 子元素管理（添加、移除、遍历）
  * - 通用的更新、渲染和输入处理接口
  * - 基本的交互事件处理
+ * - 保留模式渲染：setCached(true) 的子树烘焙到离屏纹理，未变化时每帧只需一次贴图
+ *
+ * 位置、尺寸、可见性、文本等会影响外观的修改都通过 markDirty() 沿父链上报，
+ * 缓存子树只在自身或后代被标脏后的下一次 composite() 中重建。
+ *
+ * 世界坐标按元素缓存：setPosition() 与挂到新的父元素时把自身及全部后代标记为失效，
+ * 下一次 getWorldPosition() 只沿父链重算到第一个仍然有效的祖先。
  */
 class UIElement {
 protected:
     /// 指向父元素的指针
     UIElement* parent_ = nullptr;
-    /// 子元素列表
+    /// 子元素列表（按绘制顺序）
     std::vector<std::unique_ptr<UIElement>> children_;
+    /// 子元素 ID 索引（ID 为 0 的子元素不建索引；重复 ID 时指向 children_ 中最靠前的一个）
+    engine::utils::IdMap<UIElement*> child_ids_;
     /// 元素标识
     entt::id_type id_ = 0;
     /// 子元素排序键
@@ -39,6 +56,10 @@ protected:
     glm::vec2 position_ = { 0.0f, 0.0f };
     /// 元素大小
     glm::vec2 size_ = { 0.0f, 0.0f };
+    /// 缓存的世界坐标（world_position_dirty_ 为 false 时有效）
+    mutable glm::vec2 world_position_ = { 0.0f, 0.0f };
+    /// 世界坐标是否需要重算；元素失效时其后代一定也已失效
+    mutable bool world_position_dirty_ = true;
     /// 可见性状态
     bool visible_ = true;
     /// 启用状态
@@ -46,6 +67,39 @@ protected:
     /// 上下文引用
     engine::core::Context& context_;
 
+    /// 外观自上次合成以来是否变化
+    bool render_dirty_ = true;
+    /// 是否将子树缓存到离屏纹理
+    bool cached_ = false;
+
+    /// 布局版本号：任何元素的位置、尺寸、可见/启用状态或层级变化时递增（UIManager 据此重建命中列表）
+    static inline std::uint64_t layout_version_ = 0;
+
+    /// @brief 布局变化：标脏并递增布局版本号
+    void markLayoutDirty() {
+        ++layout_version_;
+        markDirty();
+    }
+
+    /// 当前绘制坐标系原点（重建缓存时为缓存纹理左上角的屏幕坐标，否则为 0）
+    static inline glm::vec2 render_origin_{ 0.0f, 0.0f };
+
+    /**
+     * @brief 获取元素在当前渲染目标中的绘制位置。
+     * @details 子类的 render() 应使用本函数而不是 getWorldPosition()，以便同一份绘制代码
+     *          既能直接画到屏幕，也能画进缓存纹理。
+     */
+    glm::vec2 getRenderPosition() const { return getWorldPosition() - render_origin_; }
+
+    /**
+     * @brief 获取元素自身实际绘制区域（屏幕坐标），用于计算缓存纹理尺寸。
+     * @details 默认为 [getWorldPosition(), getSize()]；绘制区域与布局矩形不一致的子类（如居中对齐的文本）需覆盖。
+     */
+    virtual engine::utils::Rect getDrawRect() const;
+
+    /// @brief 子元素是否被裁剪到本元素区域内（裁剪时子树包围盒不超出自身）
+    virtual bool clipsChildren() const { return false; }
+
 public:
     /**
      * @brief 构造函数。
@@ -69,12 +123,49 @@ public:
      */
     virtual void render();
 
+    /**
+     * @brief 合成元素：未缓存时直接 render()，缓存时按需重建纹理并贴图。
+     * @details 父元素绘制子元素、UIManager 绘制根元素时都经过本函数。
+     */
+    void composite();
+
     /**
      * @brief 处理输入事件。
      * @return 如果事件被处理，返回true；否则返回false。
      */
     virtual bool handleInput();
 
+    /**
+     * @brief 标记外观已变化，并沿父链向上传播到根元素。
+     * @details 子类中影响绘制结果的 setter 都应调用本函数。
+     */
+    void markDirty();
+
+    /**
+     * @brief 设置是否将本元素及其子树缓存到离屏纹理。
+     * @details 适用于变化不频繁的面板（HUD、暂停菜单等）。嵌套的缓存子树在外层重建时直接绘制进外层纹理。
+     */
+    void setCached(bool cached);
+    bool isCached() const { return cached_; }
+
+    /// @brief 本帧（自上次 consumeCacheRebuilds() 起）重建的缓存纹理数
+    static std::uint32_t consumeCacheRebuilds();
+
+    /**
+     * @brief 子树内存估算（字节）：元素对象、子元素数组与索引、缓存纹理（按 RGBA8 计）
+     * @details 元素对象按基类大小计，子类自身的成员（文本、图片路径等）不计入，结果是下限。
+     */
+    [[nodiscard]] std::size_t estimateTreeBytes() const;
+
+    /// @brief 当前布局版本号
+    static std::uint64_t getLayoutVersion() { return layout_version_; }
+
+    /**
+     * @brief 按 handleInput() 的遍历顺序（上层优先、子元素先于父元素）收集输入可达的交互元素。
+     * @details 只进入可见且启用的子树；自身不可见的交互元素仍会被收集，以便清除其悬停状态。
+     */
+    virtual void collectInputTargets(std::vector<UIInteractive*>& out);
+
     /**
      * @brief 添加子元素。
      * @param child 要添加的子元素。
@@ -95,7 +186,7 @@ public:
     virtual void removeChild(UIElement* child);
 
     /**
-     * @brief 通过 ID 查找子元素。
+     * @brief 通过 ID 查找子元素（哈希索引，O(1)）。
      * @param id 元素 ID。
      * @return 找到则返回子元素指针，否则返回 nullptr。
      */
@@ -109,13 +200,14 @@ public:
     bool removeChildById(entt::id_type id);
 
     /**
-     * @brief 按排序键整理子元素顺序。
+     * @brief 按排序键整理子元素顺序（已有序时直接返回）。
      */
     void sortChildrenByOrderIndex();
 
     /**
      * @brief 获取元素的世界坐标位置。
      * @return 元素在世界坐标系中的位置。
+     * @details 返回缓存值；失效时由父元素的（缓存的）世界坐标加上自身位置重算。
      */
     virtual glm::vec2 getWorldPosition() const;
 
@@ -137,13 +229,22 @@ public:
      * @brief 设置父元素指针。
      * @param parent 父元素指针。
      */
-    void setParent(UIElement* parent) { parent_ = parent; }
+    void setParent(UIElement* parent) {
+        parent_ = parent;
+        invalidateWorldPosition();
+    }
 
     entt::id_type getId() const { return id_; }
-    void setId(entt::id_type id) { id_ = id; }
+    /// @brief 设置元素 ID，已挂在父元素下时同步更新父元素的 ID 索引
+    void setId(entt::id_type id);
 
     int getOrderIndex() const { return order_index_; }
-    void setOrderIndex(int order_index) { order_index_ = order_index; }
+    void setOrderIndex(int order_index) {
+        if (order_index_ != order_index) {
+            order_index_ = order_index;
+            markLayoutDirty();
+        }
+    }
 
     /**
      * @brief 获取元素位置。
@@ -155,7 +256,13 @@ public:
      * @brief 设置元素位置。
      * @param position 元素位置（相对于父元素）。
      */
-    void setPosition(const glm::vec2& position) { position_ = position; }
+    void setPosition(const glm::vec2& position) {
+        if (position_ != position) {
+            position_ = position;
+            invalidateWorldPosition();
+            markLayoutDirty();
+        }
+    }
 
     /**
      * @brief 获取元素大小。
@@ -167,7 +274,12 @@ public:
      * @brief 设置元素大小。
      * @param size 元素大小。
      */
-    virtual void setSize(const glm::vec2& size) { size_ = size; }
+    virtual void setSize(const glm::vec2& size) {
+        if (size_ != size) {
+            size_ = size;
+            markLayoutDirty();
+        }
+    }
 
     /**
      * @brief 检查元素是否可见。
@@ -179,7 +291,12 @@ public:
      * @brief 设置元素可见性。
      * @param visible 可见性状态。
      */
-    void setVisible(bool visible) { visible_ = visible; }
+    void setVisible(bool visible) {
+        if (visible_ != visible) {
+            visible_ = visible;
+            markLayoutDirty();
+        }
+    }
 
     /**
      * @brief 检查元素是否启用。
@@ -191,14 +308,46 @@ public:
      * @brief 设置元素启用状态。
      * @param enabled 启用状态。
      */
-    void setEnabled(bool enabled) { enabled_ = enabled; }
+    void setEnabled(bool enabled) {
+        if (enabled_ != enabled) {
+            enabled_ = enabled;
+            markLayoutDirty();
+        }
+    }
 
     /**
      * @brief 清空所有子元素。
      */
     void clearChildren() {
         children_.clear();
+        child_ids_.clear();
+        markLayoutDirty();
     }
+
+private:
+    /// @brief 使自身及全部后代的世界坐标缓存失效（已失效时后代必然也已失效，直接返回）
+    void invalidateWorldPosition();
+
+    /// @brief 子元素加入或 ID 变化后登记索引
+    void indexChild(UIElement* child);
+    /// @brief 子元素移除或 ID 变化前注销索引（重复 ID 时改指向下一个同 ID 的子元素）
+    void unindexChild(const UIElement* child);
+
+    /// @brief 子树在屏幕坐标中的包围盒（只统计可见元素）
+    void accumulateBounds(glm::vec2& min, glm::vec2& max) const;
+    /// @brief 重新计算包围盒并把子树绘制进缓存纹理
+    bool rebuildCache();
+
+    struct TextureDeleter {
+        void operator()(SDL_Texture* texture) const;
+    };
+
+    std::unique_ptr<SDL_Texture, TextureDeleter> cache_texture_;
+    glm::ivec2 cache_texture_size_{ 0, 0 };     ///< 纹理实际尺寸（只增不减，尺寸变小时复用）
+    engine::utils::Rect cache_rect_;            ///< 缓存内容在屏幕上的区域
+
+    static inline int cache_depth_ = 0;             ///< 正在重建的缓存嵌套层数
+    static inline std::uint32_t cache_rebuilds_ = 0;
 };
 
 }
@@ -62,7 +62,7 @@ void UIImage::render() {
     }
 
     // 渲染自身
-    auto position = getWorldPosition();
+    auto position = getRenderPosition();
     if (size_.x == 0.0f && size_.y == 0.0f) {   // 如果尺寸为0，则使用纹理的原始尺寸
         context_.getRenderer().drawUIImage(image_, position);
     } else {
@@ -73,4 +73,12 @@ void UIImage::render() {
     UIElement::render();
 }
 
+engine::utils::Rect UIImage::getDrawRect() const {
+    if (size_.x == 0.0f && size_.y == 0.0f && image_.getSourceRect().has_value()) {
+        const auto& source = *image_.getSourceRect();
+        return { getWorldPosition(), glm::vec2{ source.w, source.h } };
+    }
+    return UIElement::getDrawRect();
+}
+
 } // namespace engine::ui 
\ No newline at end of file
@@ -68,19 +68,24 @@ public:
     // --- 核心方法 ---
     void render() override;
 
+protected:
+    /// 尺寸为 0 时按源矩形大小计算绘制区域
+    engine::utils::Rect getDrawRect() const override;
+
+public:
     // --- Setters & Getters ---
     const engine::render::Image& getImage() const { return image_; }
-    void setImage(engine::render::Image image) { image_ = std::move(image); }
+    void setImage(engine::render::Image image) { image_ = std::move(image); markDirty(); }
 
     std::string_view getTexturePath() const { return image_.getTexturePath(); }
     entt::id_type getTextureId() const { return image_.getTextureId(); }
-    void setTexturePath(std::string_view texture_path) { image_.setTexturePath(texture_path); }
+    void setTexturePath(std::string_view texture_path) { image_.setTexturePath(texture_path); markDirty(); }
 
     const std::optional<SDL_FRect>& getSourceRect() const { return image_.getSourceRect(); }
-    void setSourceRect(std::optional<SDL_FRect> source_rect) { image_.setSourceRect(std::move(source_rect)); }
+    void setSourceRect(std::optional<SDL_FRect> source_rect) { image_.setSourceRect(std::move(source_rect)); markDirty(); }
 
     bool isFlipped() const { return image_.getIsFlipped(); }
-    void setFlipped(bool flipped) { image_.setIsFlipped(flipped); }
+    void setFlipped(bool flipped) { image_.setIsFlipped(flipped); markDirty(); }
 };
 
 } // namespace engine::ui
\ No newline at end of file
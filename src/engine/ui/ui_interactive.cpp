@@ -4,8 +4,8 @@
 #include "../audio/audio_player.h"
 #include "../resource/resource_manager.h"
 #include "../input/input_manager.h"
-#include "./state/ui_state.h"
 #include "../audio/audio_locator.h"
+#include <type_traits>
 
 namespace engine::ui {
 
@@ -20,6 +20,22 @@ namespace engine::ui {
  * 4. 如果鼠标在元素范围内，拦截输入防止穿透
  */
 bool UIInteractive::handleInput() {
+    if (!visible_ || !enabled_ || !interactive_) {
+        return handleOwnInput();
+    }
+    
+    // 首先处理子元素的输入
+    if (UIElement::handleInput()) {
+        return true;
+    }
+    
+    return handleOwnInput();
+}
+
+/**
+ * @brief 处理自身输入：不可交互时清除悬停，否则推进状态机并更新悬停状态。
+ */
+bool UIInteractive::handleOwnInput() {
     if (!visible_ || !enabled_ || !interactive_) {
         if (hovered_) {
             hovered_ = false;
@@ -29,20 +45,19 @@ bool UIInteractive::handleInput() {
         }
         return false;
     }
-    
-    // 首先处理子元素的输入
-    if (UIElement::handleInput()) {
-        return true;
-    }
-    
+
     bool handled = false;
     // 调用当前状态的handleInput
-    if (current_state_) {
-        auto new_state = current_state_->handleInput();
-        if (new_state) {
-            setState(std::move(new_state));
-            handled = true;
+    const auto transition = std::visit([this](const auto& state) -> state::UITransition {
+        if constexpr (std::is_same_v<std::decay_t<decltype(state)>, std::monostate>) {
+            return std::nullopt;
+        } else {
+            return state.handleInput(*this);
         }
+    }, current_state_);
+    if (transition) {
+        setState(*transition);
+        handled = true;
     }
     
     auto& input_manager = context_.getInputManager();
@@ -72,18 +87,13 @@ bool UIInteractive::handleInput() {
  * 
  * 更新过程包括：
  * 1. 检查元素是否可见和启用
- * 2. 调用当前状态的update方法
- * 3. 调用父类update方法更新子元素
+ * 2. 调用父类update方法更新子元素
  */
 void UIInteractive::update(float delta_time) {
     if (!visible_ || !enabled_) {
         return;
     }
 
-    if (current_state_) {
-        current_state_->update(delta_time);
-    }
-
     UIElement::update(delta_time);
 }
 
@@ -103,7 +113,7 @@ void UIInteractive::render() {
     // 渲染当前图片
     if (current_image_) {
         auto& renderer = context_.getRenderer();
-        auto position = getWorldPosition();
+        auto position = getRenderPosition();
         renderer.drawUIImage(*current_image_, position, size_);
     }
     
@@ -113,29 +123,17 @@ void UIInteractive::render() {
 
 /**
  * @brief 设置当前状态。
- * @param state 新的状态实例。
+ * @param state 新的状态。
  * 
- * 设置过程包括：
- * 1. 调用当前状态的exit方法
- * 2. 设置新状态
- * 3. 调用新状态的enter方法
- */
-void UIInteractive::setState(std::unique_ptr<state::UIState> state) {
-    if (current_state_) {
-        current_state_->exit();
-    }
-    current_state_ = std::move(state);
-    if (current_state_) {
-        current_state_->enter();
-    }
-}
-
-/**
- * @brief 获取当前状态。
- * @return 当前状态指针。
+ * 状态是嵌入在元素中的值，替换时不分配内存；随后调用新状态的enter方法。
  */
-state::UIState* UIInteractive::getCurrentState() const {
-    return current_state_.get();
+void UIInteractive::setState(state::UIState state) {
+    current_state_ = state;
+    std::visit([this](const auto& current) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(current)>, std::monostate>) {
+            current.enter(*this);
+        }
+    }, current_state_);
 }
 
 /**
@@ -171,7 +169,10 @@ engine::render::Image* UIInteractive::getImage(engine::resource::ResourceId name
  * @param image 图片指针。
  */
 void UIInteractive::setCurrentImage(engine::render::Image* image) {
-    current_image_ = image;
+    if (current_image_ != image) {
+        current_image_ = image;
+        markDirty();
+    }
 }
 
 /**
@@ -236,7 +237,28 @@ void UIInteractive::playSound(std::string_view name) {
  * @param interactive 是否可交互。
  */
 void UIInteractive::setInteractive(bool interactive) {
-    interactive_ = interactive;
+    if (interactive_ != interactive) {
+        interactive_ = interactive;
+        ++layout_version_;
+    }
+}
+
+bool UIInteractive::isIdle() const {
+    return !hovered_ && std::visit([](const auto& state) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(state)>, std::monostate>) {
+            return true;
+        } else {
+            return state.isIdle();
+        }
+    }, current_state_);
+}
+
+void UIInteractive::collectInputTargets(std::vector<UIInteractive*>& out) {
+    // 与 handleInput() 一致：子元素先于自身，自身不可交互时不进入子树
+    if (visible_ && enabled_ && interactive_) {
+        UIElement::collectInputTargets(out);
+    }
+    out.push_back(this);
 }
 
 /**
@@ -11,6 +11,9 @@
 #include <string_view>
 #include "../render/image.h"
 #include "./state/ui_state.h"
+#include "./state/normal_state.h"
+#include "./state/hover_state.h"
+#include "./state/pressed_state.h"
 #include <glm/glm.hpp>
 #include "../resource/resource_id.h"
 
@@ -19,23 +22,20 @@ namespace engine::core {
 }
 
 namespace engine::ui {
-    namespace state {
-        class UIState;
-    }
 
     /**
      * @class UIInteractive
      * @brief 可交互UI元素的基类，支持状态管理、精灵切换和声音播放。
      * 
      * UIInteractive类主要功能包括：
-     * - 状态管理（正常、悬停、按下等状态）
+     * - 状态管理（正常、悬停、按下等状态；状态为嵌入的值类型，切换不分配内存）
      * - 精灵管理（不同状态的精灵切换）
      * - 声音管理（不同状态的声音播放）
      * - 点击事件回调
      * - 输入处理
      */
     class UIInteractive  : public UIElement {
-        std::unique_ptr<state::UIState> current_state_; ///< 当前状态
+        state::UIState current_state_; ///< 当前状态（std::monostate 表示未启用状态机）
         std::unordered_map<engine::resource::ResourceId, std::unique_ptr<engine::render::Image>> images_; ///< 精灵映射表
         std::unordered_map<engine::resource::ResourceId, engine::resource::ResourceId> sound_; ///< 声音映射表
         engine::render::Image* current_image_ = nullptr; ///< 当前显示的精灵
@@ -68,6 +68,21 @@ namespace engine::ui {
          * @return 如果事件被处理，返回true；否则返回false。
          */
         bool handleInput() override;
+
+        /**
+         * @brief 只处理本元素自身的输入（状态机与悬停回调），不遍历子元素。
+         * @return 语义同 handleInput()。
+         * @details UIManager 的命中列表按遍历顺序逐个调用本函数，替代逐层递归。
+         */
+        bool handleOwnInput();
+
+        /**
+         * @brief 是否处于空闲状态：未悬停且当前状态在光标不在元素上时不会切换。
+         * @details 空闲且光标不在其上的元素，handleOwnInput() 必然什么都不做，可直接跳过。
+         */
+        bool isIdle() const;
+
+        void collectInputTargets(std::vector<UIInteractive*>& out) override;
         
         /**
          * @brief 渲染UI元素及其子元素。
@@ -75,16 +90,16 @@ namespace engine::ui {
         void render() override;
 
         /**
-         * @brief 设置当前状态。
-         * @param state 新的状态实例。
+         * @brief 设置当前状态，并调用新状态的 enter()。
+         * @param state 新的状态（如 state::NormalState{}）。
          */
-        void setState(std::unique_ptr<state::UIState> state);
+        void setState(state::UIState state);
         
         /**
          * @brief 获取当前状态。
-         * @return 当前状态指针。
+         * @return 当前状态，可用 std::holds_alternative 判断具体类型。
          */
-        state::UIState* getCurrentState() const;
+        const state::UIState& getCurrentState() const { return current_state_; }
         
         /**
          * @brief 添加精灵。
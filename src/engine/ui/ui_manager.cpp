@@ -1,5 +1,8 @@
 #include "ui_manager.h"
+#include "ui_interactive.h"
 #include "../core/context.h"
+#include "../input/input_manager.h"
+#include "../utils/profiler.h"
 #include <spdlog/spdlog.h>
 namespace engine::ui {
 
@@ -47,26 +50,63 @@ void UIManager::update(float delta_time) {
 /**
  * @brief 渲染所有UI元素。
  * 
- * 渲染过程会递归调用所有UI元素的render方法。
+ * 渲染过程从根元素开始逐层合成：缓存子树未变化时只贴一次图，被标脏的子树在此时重建。
  */
 void UIManager::render() {
+    ENGINE_PROFILE_SCOPE("UIManager::render");
     if (root_element_) {
-        root_element_->render();
+        root_element_->composite();
     }
+    ENGINE_PROFILE_COUNTER("ui.cache_rebuilds", static_cast<std::int64_t>(UIElement::consumeCacheRebuilds()));
 }
 
 /**
  * @brief 处理输入事件。
  * @return 如果事件被处理，返回true；否则返回false。
  * 
- * 处理过程会调用根元素的handleInput方法，
- * 根元素会递归处理所有子元素的输入事件。
+ * 结果与从根元素递归调用 handleInput 一致：按遍历顺序处理交互元素，遇到第一个返回 true 的即停止。
+ * 光标不在其上且处于空闲状态的元素在递归版本中同样什么都不做，这里直接跳过。
+ * 回调修改了布局（元素可能已被销毁）时本帧提前结束，下一帧按新布局重建列表。
  */
 bool UIManager::handleInput() {
-    if (root_element_) {
-        return root_element_->handleInput();
+    if (!root_element_) {
+        return false;
+    }
+    if (hit_targets_version_ != UIElement::getLayoutVersion()) {
+        rebuildHitTargets();
+    }
+
+    const glm::vec2 mouse = context_.getInputManager().getLogicalMousePosition();
+    const std::uint64_t version = hit_targets_version_;
+    [[maybe_unused]] std::int64_t visited = 0;
+    bool handled = false;
+    for (const auto& target : hit_targets_) {
+        const auto& rect = target.rect_;
+        const bool inside = mouse.x >= rect.position.x && mouse.y >= rect.position.y &&
+                            mouse.x <= rect.position.x + rect.size.x && mouse.y <= rect.position.y + rect.size.y;
+        if (!inside && target.element_->isIdle()) {
+            continue;
+        }
+        ++visited;
+        handled = target.element_->handleOwnInput();
+        if (handled || UIElement::getLayoutVersion() != version) {
+            break;
+        }
+    }
+    ENGINE_PROFILE_COUNTER("ui.input_targets", static_cast<std::int64_t>(hit_targets_.size()));
+    ENGINE_PROFILE_COUNTER("ui.input_visited", visited);
+    return handled;
+}
+
+void UIManager::rebuildHitTargets() {
+    collect_buffer_.clear();
+    root_element_->collectInputTargets(collect_buffer_);
+    hit_targets_.clear();
+    hit_targets_.reserve(collect_buffer_.size());
+    for (auto* element : collect_buffer_) {
+        hit_targets_.push_back({ element, engine::utils::Rect{ element->getWorldPosition(), element->getSize() } });
     }
-    return false;
+    hit_targets_version_ = UIElement::getLayoutVersion();
 }
 
 /**
@@ -4,8 +4,12 @@
  * @brief 定义UIManager类，用于管理整个UI系统。
  */
 
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <vector>
 #include "ui_element.h"
+#include "../utils/math.h"
 
 namespace engine::core {
     class Context;
@@ -22,6 +26,9 @@ namespace engine::ui {
  * - 协调UI元素的更新、渲染和输入处理
  * - 处理UI元素的添加和移除
  * - 提供访问UI元素的方法
+ *
+ * 输入处理不再逐层递归：交互元素按遍历顺序扁平化为命中列表（仅在布局版本变化时重建，
+ * 同时缓存世界矩形），每帧只调用光标之下或处于非空闲状态（悬停、按下）的元素。
  */
 class UIManager {
 private:
@@ -30,6 +37,18 @@ private:
     /// UI根元素
     std::unique_ptr<UIElement> root_element_;
 
+    struct HitTarget {
+        UIInteractive* element_{nullptr};
+        engine::utils::Rect rect_;      ///< 构建列表时的世界矩形
+    };
+    /// 输入可达的交互元素，上层在前（与 handleInput 遍历顺序一致）
+    std::vector<HitTarget> hit_targets_;
+    std::vector<UIInteractive*> collect_buffer_;
+    std::uint64_t hit_targets_version_ = std::numeric_limits<std::uint64_t>::max();
+
+    /// @brief 按当前布局重建命中列表
+    void rebuildHitTargets();
+
 public:
     /**
      * @brief 构造函数。
@@ -23,8 +23,10 @@ UIPanel::~UIPanel() = default;
  * 
  * 渲染过程包括：
  * 1. 检查元素是否可见
- * 2. 绘制背景（如果背景颜色不透明）
+ * 2. 绘制背景（九宫格图片或纯色，背景颜色不透明时）
  * 3. 绘制边框（如果边框宽度大于0且边框颜色不透明）
+ * 
+ * 背景与边框都追加到渲染器的 UI 绘制列表，与其他面板、图片合并提交。
  * 4. 调用父类render方法渲染子元素
  */
 void UIPanel::render() {
@@ -36,7 +38,7 @@ void UIPanel::render() {
     auto& renderer = context_.getRenderer();
 
     // 计算世界位置
-    glm::vec2 world_pos = getWorldPosition();
+    glm::vec2 world_pos = getRenderPosition();
     
     // 创建Rect结构
     engine::utils::Rect rect;
@@ -45,16 +47,26 @@ void UIPanel::render() {
 
     // 绘制背景
     if (background_color_.a > 0.0f) {
-        renderer.drawUIFilledRect(rect, background_color_);
+        if (background_image_) {
+            renderer.drawUINineSlice(*background_image_, rect, background_slice_, background_color_);
+        } else {
+            renderer.drawUIFilledRect(rect, background_color_);
+        }
     }
 
     // 绘制边框
     if (border_width_ > 0.0f && border_color_.a > 0.0f) {
-        renderer.drawUIOutlineRect(rect, border_color_);
+        renderer.drawUIOutlineRect(rect, border_color_, border_width_);
     }
 
     // 调用父类render方法渲染子元素
-    UIElement::render();
+    if (clip_children_) {
+        renderer.pushUIClipRect(rect);
+        UIElement::render();
+        renderer.popUIClipRect();
+    } else {
+        UIElement::render();
+    }
 }
 
 }
\ No newline at end of file
@@ -5,7 +5,9 @@
  */
 
 #include "ui_element.h"
+#include "../render/image.h"
 #include <glm/glm.hpp>
+#include <optional>
 #include "../utils/math.h" // 用于FColor定义
 
 using namespace engine::utils;
@@ -22,9 +24,10 @@ namespace engine::ui {
  * 
  * UIPanel类是一个容器控件，主要功能包括：
  * - 作为其他UI元素的父容器
- * - 支持设置背景颜色
+ * - 支持设置背景颜色或九宫格背景图片
  * - 支持设置边框
  * - 管理子元素的布局
+ * - 可选地把子元素裁剪到面板区域内（滚动列表）
  */
 class UIPanel : public UIElement {
 private:
@@ -32,8 +35,13 @@ private:
     FColor background_color_ = { 0.0f, 0.0f, 0.0f, 0.0f }; // 透明黑色
     /// 边框颜色
     FColor border_color_ = { 0.0f, 0.0f, 0.0f, 0.0f }; // 透明黑色
+    /// 九宫格背景图片（设置后代替纯色背景，按背景颜色着色）
+    std::optional<engine::render::Image> background_image_;
+    engine::render::UINineSlice background_slice_;
     /// 边框宽度
     float border_width_ = 0.0f;
+    /// 是否裁剪子元素
+    bool clip_children_ = false;
 
 public:
     /**
@@ -63,7 +71,23 @@ public:
      * @brief 设置背景颜色。
      * @param color 背景颜色。
      */
-    void setBackgroundColor(const FColor& color) { background_color_ = color; }
+    void setBackgroundColor(const FColor& color) { background_color_ = color; markDirty(); }
+
+    /**
+     * @brief 设置九宫格背景图片，四角不随面板尺寸拉伸。
+     * @param image 背景图片。
+     * @param slice 源图四边的不拉伸宽度（像素）。
+     * @details 背景颜色作为图片的着色；背景颜色仍为默认的全透明时改为不着色的白色。
+     */
+    void setBackgroundImage(const engine::render::Image& image, const engine::render::UINineSlice& slice) {
+        background_image_ = image;
+        background_slice_ = slice;
+        if (background_color_.a <= 0.0f) {
+            background_color_ = { 1.0f, 1.0f, 1.0f, 1.0f };
+        }
+        markDirty();
+    }
+    void clearBackgroundImage() { background_image_.reset(); markDirty(); }
 
     /**
      * @brief 获取边框颜色。
@@ -75,7 +99,7 @@ public:
      * @brief 设置边框颜色。
      * @param color 边框颜色。
      */
-    void setBorderColor(const FColor& color) { border_color_ = color; }
+    void setBorderColor(const FColor& color) { border_color_ = color; markDirty(); }
 
     /**
      * @brief 获取边框宽度。
@@ -87,7 +111,17 @@ public:
      * @brief 设置边框宽度。
      * @param width 边框宽度。
      */
-    void setBorderWidth(float width) { border_width_ = width; }
+    void setBorderWidth(float width) { border_width_ = width; markDirty(); }
+
+    /**
+     * @brief 设置是否把子元素裁剪到面板区域内。
+     * @param clip 为 true 时超出面板的部分不绘制。
+     */
+    void setClipChildren(bool clip) { clip_children_ = clip; markDirty(); }
+    bool getClipChildren() const { return clip_children_; }
+
+protected:
+    bool clipsChildren() const override { return clip_children_; }
 };
 
 }
\ No newline at end of file
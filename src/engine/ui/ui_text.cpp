@@ -2,6 +2,9 @@
 #include "../core/context.h"
 #include "../render/camera.h"
 #include <glm/glm.hpp>
+#include <algorithm>
+#include <array>
+#include <format>
 
 namespace engine::ui {
 
@@ -46,7 +49,7 @@ const glm::vec2& UIText::getSize() const
  * 渲染过程包括：
  * 1. 检查元素是否可见
  * 2. 获取文本渲染器
- * 3. 计算世界位置（UI世界位置即为屏幕位置）
+ * 3. 计算绘制位置（UI世界位置即为屏幕位置；重建缓存时相对缓存纹理）
  * 4. 根据对齐方式调整文本位置
  * 5. 使用TextRenderer绘制UI文本
  * 6. 调用父类render方法渲染子元素
@@ -61,30 +64,21 @@ void UIText::render() {
     // 获取文本渲染器
     auto& text_renderer = context_.getTextRenderer();
     
-    // 计算世界位置（在此系统中，UI 世界位置即为屏幕位置）
-    glm::vec2 world_pos = getWorldPosition();
-    
-    // 根据对齐方式调整文本位置
-    glm::vec2 render_pos = world_pos;
-    
-    if (alignment_ != TextAlignment::LEFT) {
-        const glm::vec2& text_size = size_;
-        if (alignment_ == TextAlignment::CENTER) {
-            render_pos.x -= text_size.x * 0.5f;
-            render_pos.y -= text_size.y * 0.5f; // 同时进行水平和垂直居中
-        } else if (alignment_ == TextAlignment::RIGHT) {
-            render_pos.x -= text_size.x;
-        }
-    }
+    // 计算绘制位置（UI 世界位置即为屏幕位置，重建缓存时相对缓存纹理），并根据对齐方式调整
+    const glm::vec2 render_pos = alignedPosition(getRenderPosition());
     
     // 使用TextRenderer绘制UI文本（屏幕空间）
-    text_renderer.drawUIText(text_,
-                           font_id_,
-                           font_path_,
-                           font_size_,
-                           render_pos,
-                           color_,
-                           is_dirty_);
+    if (scalable_) {
+        text_renderer.drawScaledUIText(text_, font_id_, font_path_, static_cast<float>(font_size_) * scale_, render_pos, color_);
+    } else {
+        text_renderer.drawUIText(text_,
+                               font_id_,
+                               font_path_,
+                               font_size_,
+                               render_pos,
+                               color_,
+                               is_dirty_);
+    }
 
     is_dirty_ = false;
     
@@ -92,19 +86,38 @@ void UIText::render() {
     UIElement::render();
 }
 
-void UIText::onNotify(engine::interface::EventType event_type, const std::any &data)
+void UIText::onScoreChanged(const engine::interface::ScoreChanged& event)
+{
+    // 在栈缓冲区里格式化，文本未变化时 setText 不做任何事
+    std::array<char, 32> buffer{};
+    const auto result = std::format_to_n(buffer.data(), buffer.size(), "Score: {}", event.value_);
+    setText(std::string_view(buffer.data(), std::min(static_cast<std::size_t>(result.size), buffer.size())));
+}
+
+engine::utils::Rect UIText::getDrawRect() const
+{
+    ensureUpToDate();
+    return { alignedPosition(getWorldPosition()), size_ };
+}
+
+void UIText::updateAlignOffset()
 {
-    if (event_type == engine::interface::EventType::SCORE_CHANGED) {
-        // 安全地从 std::any 中提取数据
-        if (const int* score = std::any_cast<int>(&data)) {
-            setText("Score: " + std::to_string(*score));
-        }
+    if (alignment_ == TextAlignment::CENTER) {
+        align_offset_ = -size_ * 0.5f;    // 同时进行水平和垂直居中
+    } else if (alignment_ == TextAlignment::RIGHT) {
+        align_offset_ = { -size_.x, 0.0f };
+    } else {
+        align_offset_ = { 0.0f, 0.0f };
     }
 }
 
 void UIText::updateSize()
 {
-    size_ = context_.getTextRenderer().getTextSize(text_, font_id_, font_path_, font_size_, is_dirty_);
+    // 排版由 TextRenderer 按 (字体, 字号, 字符串) 缓存，重复出现的文本只是一次查表
+    auto& text_renderer = context_.getTextRenderer();
+    size_ = scalable_ ? text_renderer.getScaledTextSize(text_, font_id_, font_path_, static_cast<float>(font_size_) * scale_)
+                      : text_renderer.getTextSize(text_, font_id_, font_path_, font_size_, is_dirty_);
+    updateAlignOffset();
 }
 
 void UIText::ensureUpToDate() const
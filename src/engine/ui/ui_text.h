@@ -6,9 +6,10 @@
 
 #include "ui_element.h"
 #include <string>
+#include <string_view>
 #include <glm/glm.hpp>
 #include "../utils/math.h" // 用于FColor定义
-#include "../../engine/interface/observer.h"
+#include "../interface/signal_channel.h"
 #include "../resource/resource_id.h"
 
 using namespace engine::utils;
@@ -39,7 +40,7 @@ enum class TextAlignment {
  * - 支持设置文本颜色
  * - 支持设置文本对齐方式
  */
-class UIText : public UIElement, public engine::interface::Observer {
+class UIText : public UIElement {
 private:
     /// 文本内容
     std::string text_;
@@ -53,6 +54,12 @@ private:
     FColor color_ = { 1.0f, 1.0f, 1.0f, 1.0f }; // 白色
     /// 文本对齐方式
     TextAlignment alignment_ = TextAlignment::LEFT;
+    /// 锚点到文本左上角的偏移，尺寸或对齐方式变化时更新，绘制时不再重新推导
+    glm::vec2 align_offset_{ 0.0f, 0.0f };
+    /// 使用字体的可缩放图集绘制（大字号或字号随动画变化的文本）
+    bool scalable_ = false;
+    /// 可缩放文本的字号倍率，实际字号为 font_size_ * scale_
+    float scale_ = 1.0f;
 
     // 脏标识：当文本/字体/字号变化时标记为 true
     bool is_dirty_ = true;
@@ -93,12 +100,16 @@ public:
     const std::string& getText() const { return text_; }
 
     /**
-     * @brief 设置文本内容。
-     * @param text 文本内容。
+     * @brief 设置文本内容，内容未变化时不触发重新排版。
+     * @param text 文本内容（每帧刷新的 HUD 可直接传入帧内存中的字符串）。
      */
-    void setText(const std::string& text) { 
-        text_ = text; 
+    void setText(std::string_view text) { 
+        if (text == text_) {
+            return;
+        }
+        text_.assign(text);     // 复用已有容量
         is_dirty_ = true;
+        markDirty();
     }
 
     /**
@@ -115,6 +126,7 @@ public:
         font_path_ = font_path; 
         font_id_ = engine::resource::toResourceId(font_path);
         is_dirty_ = true;
+        markDirty();
     }
 
     engine::resource::ResourceId getFontId() const { return font_id_; }
@@ -123,6 +135,7 @@ public:
         font_id_ = font_id;
         font_path_.clear();
         is_dirty_ = true;
+        markDirty();
     }
 
     /**
@@ -138,6 +151,7 @@ public:
     void setFontSize(int font_size) { 
         font_size_ = font_size; 
         is_dirty_ = true;
+        markDirty();
     }
 
     /**
@@ -150,7 +164,7 @@ public:
      * @brief 设置文本颜色。
      * @param color 文本颜色。
      */
-    void setColor(const FColor& color) { color_ = color; }
+    void setColor(const FColor& color) { color_ = color; markDirty(); }
 
     /**
      * @brief 获取文本对齐方式。
@@ -162,19 +176,54 @@ public:
      * @brief 设置文本对齐方式。
      * @param alignment 文本对齐方式。
      */
-    void setAlignment(TextAlignment alignment) { alignment_ = alignment; }
+    void setAlignment(TextAlignment alignment) { alignment_ = alignment; updateAlignOffset(); markDirty(); }
+
+    /**
+     * @brief 改用字体的可缩放图集绘制：任意字号共用一个图集，setScale() 逐帧变化时不会重新光栅化。
+     */
+    void setScalable(bool scalable) {
+        scalable_ = scalable;
+        is_dirty_ = true;
+        markDirty();
+    }
+    bool isScalable() const { return scalable_; }
+
     /**
-     * @brief 处理事件通知。
-     * @param event_type 事件类型。
-     * @param data 事件数据。
+     * @brief 设置字号倍率（仅可缩放文本生效，用于弹出、缩放等动画）。
+     * @param scale 倍率，实际字号为 font_size * scale。
      */
-    void onNotify(engine::interface::EventType event_type, const std::any& data) override;
+    void setScale(float scale) {
+        if (scale == scale_) {
+            return;
+        }
+        scale_ = scale;
+        if (scalable_) {
+            is_dirty_ = true;
+            markDirty();
+        }
+    }
+    float getScale() const { return scale_; }
+    /**
+     * @brief 得分变化时显示 "Score: N"（连接到 SignalChannel<ScoreChanged>）。
+     * @param event 得分变化事件。
+     */
+    void onScoreChanged(const engine::interface::ScoreChanged& event);
+
+protected:
+    /// 绘制区域按对齐方式偏移
+    engine::utils::Rect getDrawRect() const override;
 
 private:
     /**
      * @brief 更新文本的尺寸。
      */
     void updateSize();
+
+    /// @brief 按对齐方式与当前尺寸重新计算 align_offset_
+    void updateAlignOffset();
+
+    /// @brief 把锚点换算为文本左上角
+    glm::vec2 alignedPosition(glm::vec2 anchor) const { return anchor + align_offset_; }
 };
 
 }
\ No newline at end of file
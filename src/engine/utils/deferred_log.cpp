@@ -0,0 +1,222 @@
+#include "deferred_log.h"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <csignal>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::utils::log {
+
+namespace {
+
+/// 后台线程两次写出之间的最长间隔
+constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(50);
+/// 崩溃处理等待后台线程让出写出锁的次数（每次 5 ms）
+constexpr int CRASH_LOCK_ATTEMPTS = 20;
+
+constexpr std::array FATAL_SIGNALS{ SIGSEGV, SIGABRT, SIGFPE, SIGILL };
+
+std::atomic<bool> crash_flushed{ false };
+std::terminate_handler previous_terminate = nullptr;
+
+void onFatalSignal(int signal) {
+    DeferredLog::instance().flushForCrash();
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
+
+void onTerminate() {
+    DeferredLog::instance().flushForCrash();
+    if (previous_terminate) {
+        previous_terminate();
+    }
+    std::abort();
+}
+
+/// 所属线程退出时标记缓冲，剩余记录仍由后台线程取出
+struct ThreadRingHandle {
+    std::shared_ptr<DeferredLogRing> ring_;
+    ~ThreadRingHandle() {
+        if (ring_) {
+            ring_->alive_.store(false, std::memory_order_release);
+        }
+    }
+};
+
+struct FormattedRecord {
+    std::int64_t time_ns_;
+    spdlog::level::level_enum level_;
+    std::string text_;
+};
+
+} // namespace
+
+struct DeferredLog::Impl {
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<DeferredLogRing>> rings_;
+    std::mutex drain_mutex_;                    ///< 后台线程、flush() 与崩溃处理互斥地消费缓冲
+    std::vector<FormattedRecord> pending_;
+    std::thread thread_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    bool stop_requested_{ false };
+};
+
+DeferredLogRing::DeferredLogRing() : data_(std::make_unique<std::byte[]>(CAPACITY)) {}
+
+std::byte* DeferredLogRing::beginWrite(std::size_t bytes) {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+    const std::size_t offset = head & (CAPACITY - 1);
+    // 记录不跨越缓冲末尾：放不下时把末尾剩余部分整体填充
+    const std::size_t padding = bytes > CAPACITY - offset ? CAPACITY - offset : 0;
+    if (head + padding + bytes - tail > CAPACITY) {
+        return nullptr;
+    }
+    if (padding >= sizeof(DeferredRecordHeader)) {
+        DeferredRecordHeader filler{};
+        filler.size_ = static_cast<std::uint32_t>(padding);
+        std::memcpy(data_.get() + offset, &filler, sizeof(filler));
+    }
+    head += padding;
+    reserved_head_ = head + bytes;
+    return data_.get() + (head & (CAPACITY - 1));
+}
+
+DeferredLog& DeferredLog::instance() {
+    static DeferredLog log;
+    return log;
+}
+
+DeferredLog::DeferredLog() : impl_(std::make_unique<Impl>()) {}
+
+DeferredLog::~DeferredLog() {
+    stop();
+}
+
+void DeferredLog::start() {
+    if (running_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    impl_->stop_requested_ = false;
+    impl_->thread_ = std::thread([this] {
+        auto& impl = *impl_;
+        while (true) {
+            std::unique_lock lock(impl.wake_mutex_);
+            impl.wake_.wait_for(lock, FLUSH_INTERVAL, [&] { return impl.stop_requested_; });
+            const bool stopping = impl.stop_requested_;
+            lock.unlock();
+            drainAll();
+            if (stopping) {
+                break;
+            }
+        }
+    });
+    previous_terminate = std::set_terminate(&onTerminate);
+    for (const int signal : FATAL_SIGNALS) {
+        std::signal(signal, &onFatalSignal);
+    }
+    static_cast<void>(threadRing());      // 启动线程（主线程）的缓冲此时登记，战斗中的首条日志不再分配
+    running_.store(true, std::memory_order_release);
+}
+
+void DeferredLog::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard lock(impl_->wake_mutex_);
+        impl_->stop_requested_ = true;
+    }
+    impl_->wake_.notify_one();
+    if (impl_->thread_.joinable()) {
+        impl_->thread_.join();
+    }
+    drainAll();     // 停止前最后一刻写入的记录
+}
+
+void DeferredLog::flush() {
+    drainAll();
+    if (auto* logger = spdlog::default_logger_raw()) {
+        logger->flush();
+    }
+}
+
+DeferredLogRing& DeferredLog::threadRing() {
+    thread_local ThreadRingHandle handle;
+    if (!handle.ring_) {
+        handle.ring_ = std::make_shared<DeferredLogRing>();
+        std::lock_guard lock(impl_->rings_mutex_);
+        impl_->rings_.push_back(handle.ring_);
+    }
+    return *handle.ring_;
+}
+
+void DeferredLog::drainAll() {
+    std::lock_guard drain_lock(impl_->drain_mutex_);
+    std::vector<std::shared_ptr<DeferredLogRing>> rings;
+    {
+        std::lock_guard lock(impl_->rings_mutex_);
+        // 线程已退出且记录已取完的缓冲不再保留
+        std::erase_if(impl_->rings_, [](const auto& ring) {
+            return !ring->alive_.load(std::memory_order_acquire) && ring->empty();
+        });
+        rings = impl_->rings_;
+    }
+    writeRecords(rings);
+}
+
+void DeferredLog::flushForCrash() {
+    if (crash_flushed.exchange(true)) {
+        return;
+    }
+    // 崩溃可能发生在持锁的后台线程上：等待有限次数后放弃，不在崩溃处理中死锁
+    std::unique_lock drain_lock(impl_->drain_mutex_, std::try_to_lock);
+    for (int attempt = 0; !drain_lock.owns_lock() && attempt < CRASH_LOCK_ATTEMPTS; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        drain_lock.try_lock();
+    }
+    std::unique_lock rings_lock(impl_->rings_mutex_, std::try_to_lock);
+    if (drain_lock.owns_lock() && rings_lock.owns_lock()) {
+        const auto rings = impl_->rings_;
+        rings_lock.unlock();
+        writeRecords(rings);
+    }
+    if (auto* logger = spdlog::default_logger_raw()) {
+        logger->flush();
+    }
+}
+
+void DeferredLog::writeRecords(const std::vector<std::shared_ptr<DeferredLogRing>>& rings) {
+    auto& pending = impl_->pending_;
+    pending.clear();
+    fmt::memory_buffer buffer;
+    for (const auto& ring : rings) {
+        ring->drain([&](const DeferredRecordHeader& header, const std::byte* args) {
+            buffer.clear();
+            const auto& site = *header.site_;
+            fmt::format_to(std::back_inserter(buffer), "[{}:{} {}] ", site.file_, site.line_, site.func_);
+            header.format_fn_(buffer, std::string_view(header.format_, header.format_size_), args);
+            pending.push_back(FormattedRecord{ header.time_ns_, site.level_, std::string(buffer.data(), buffer.size()) });
+        });
+    }
+    auto* logger = spdlog::default_logger_raw();
+    if (!logger) {
+        return;
+    }
+    // 各线程内已按时间有序，合并后按记录时刻排序，与同步写出的顺序一致
+    std::ranges::stable_sort(pending, {}, &FormattedRecord::time_ns_);
+    for (const auto& record : pending) {
+        const spdlog::log_clock::time_point time{ std::chrono::duration_cast<spdlog::log_clock::duration>(
+            std::chrono::nanoseconds(record.time_ns_)) };
+        logger->log(time, spdlog::source_loc{}, record.level_, spdlog::string_view_t(record.text_.data(), record.text_.size()));
+    }
+    if (const auto dropped = dropped_.exchange(0, std::memory_order_relaxed); dropped > 0) {
+        logger->warn("延迟日志缓冲已满，丢弃 {} 条", dropped);
+    }
+}
+
+} // namespace engine::utils::log
@@ -0,0 +1,293 @@
+#pragma once
+/**
+ * @file deferred_log.h
+ * @brief 延迟格式化的二进制日志：调用线程只把格式串与原始参数写入本线程的环形缓冲，后台线程格式化并写出。
+ *
+ * @details
+ * ENGINE_LOG_* 即使通过了级别检查，也要在调用线程上格式化消息、经 spdlog 的 sink 写出（异步 logger 也要先格式化）。
+ * 逐次触发的 info 日志（每个音效、每次阻挡、每个动画事件、每次花费金币）改用 ENGINE_LOG_*_DEFERRED：
+ * - 调用点：检查级别，按参数大小在本线程的环形缓冲中占位，写入记录头（调用点信息、格式串、解码函数、时间戳）
+ *   与参数的原始字节；字符串参数按长度前缀拷贝（超过 MAX_STRING_BYTES 截断）。不格式化、不加锁、不分配
+ * - 后台线程（DeferredLog::start() 启动）定期取出各线程的记录，按时间戳排序后格式化，以记录时刻写入默认 logger
+ * - 缓冲已满时丢弃本条并计数，后台线程下次写出时报告丢弃条数
+ * - 进程收到致命信号或 std::terminate 时，在崩溃线程上同步取出全部记录并刷新 logger，崩溃前的日志不会丢失
+ *
+ * 参数只能是算术类型、枚举与字符串（std::string、std::string_view、const char*）；其他类型在编译期报错，
+ * 需要时在调用点先转换。格式串必须是字符串字面量（记录只保存指针）。后台线程未启动时（命令行工具、
+ * 批量模拟的线程日志器覆盖）退化为 ENGINE_LOG_* 的同步写出。
+ */
+
+#include "logging.h"
+#include "spsc_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace engine::utils::log {
+
+/// @brief 调用点的静态信息（每个宏展开处一份）
+struct DeferredSite {
+    spdlog::level::level_enum level_;
+    const char* file_;
+    int line_;
+    const char* func_;
+};
+
+/// @brief 把参数字节解码并按格式串追加到缓冲
+using DeferredFormatFn = void (*)(fmt::memory_buffer& out, std::string_view format, const std::byte* args);
+
+/// @brief 环形缓冲中一条记录的头部，参数字节紧随其后
+struct DeferredRecordHeader {
+    const DeferredSite* site_;
+    DeferredFormatFn format_fn_;        ///< 为空表示缓冲末尾的填充
+    const char* format_;
+    std::uint32_t format_size_;
+    std::uint32_t size_;                ///< 整条记录（含头部与对齐填充）的字节数
+    std::int64_t time_ns_;              ///< spdlog::log_clock 的纪元时间
+};
+
+/**
+ * @class DeferredLogRing
+ * @brief 单个线程的记录缓冲（单生产者：所属线程；单消费者：后台线程或崩溃处理）
+ */
+class DeferredLogRing final {
+public:
+    static constexpr std::size_t CAPACITY = 64 * 1024;
+    static constexpr std::size_t RECORD_ALIGN = 8;
+
+    DeferredLogRing();
+
+    /**
+     * @brief 占用 bytes 字节（已按 RECORD_ALIGN 取整）写入一条记录
+     * @return 写入位置；缓冲剩余空间不足时返回空指针，调用方丢弃本条
+     */
+    [[nodiscard]] std::byte* beginWrite(std::size_t bytes);
+    /// @brief 提交 beginWrite 占用的记录
+    void endWrite() { head_.store(reserved_head_, std::memory_order_release); }
+
+    /**
+     * @brief 消费端依次处理当前可见的全部记录
+     * @return 处理的记录数
+     */
+    template <typename Fn>
+    std::size_t drain(Fn&& fn) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        std::size_t count = 0;
+        while (tail != head) {
+            const std::size_t offset = tail & (CAPACITY - 1);
+            if (CAPACITY - offset < sizeof(DeferredRecordHeader)) {
+                tail += CAPACITY - offset;      // 末尾放不下头部的空隙，生产端直接跳过
+                continue;
+            }
+            DeferredRecordHeader header;
+            std::memcpy(&header, data_.get() + offset, sizeof(header));
+            if (header.format_fn_) {
+                fn(header, data_.get() + offset + sizeof(header));
+                ++count;
+            }
+            tail += header.size_;
+        }
+        tail_.store(tail, std::memory_order_release);
+        return count;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+    std::atomic<bool> alive_{ true };       ///< 所属线程是否仍在运行（退出后由后台线程取完并移除）
+
+private:
+    std::unique_ptr<std::byte[]> data_;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_{ 0 };   ///< 已提交的写入位置（生产者持有）
+    std::size_t reserved_head_{ 0 };                                 ///< beginWrite 占用后的写入位置
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_{ 0 };   ///< 下一次读取位置（消费者持有）
+};
+static_assert(sizeof(DeferredRecordHeader) % DeferredLogRing::RECORD_ALIGN == 0, "记录头须保持 RECORD_ALIGN 对齐");
+
+/**
+ * @class DeferredLog
+ * @brief 各线程记录缓冲的登记表与后台写出线程（进程级单例）
+ */
+class DeferredLog final {
+public:
+    static DeferredLog& instance();
+
+    /// @brief 启动后台写出线程，并安装崩溃时的同步刷新（致命信号与 std::terminate）
+    void start();
+    /// @brief 写出剩余记录并停止后台线程；之后的延迟日志退化为同步写出
+    void stop();
+    /// @brief 在调用线程上立即写出全部已记录的日志
+    void flush();
+
+    [[nodiscard]] bool isRunning() const { return running_.load(std::memory_order_relaxed); }
+
+    /// @brief 当前线程的记录缓冲（首次调用时登记）
+    [[nodiscard]] DeferredLogRing& threadRing();
+
+    /// @brief 记录一条因缓冲已满而丢弃的日志
+    void countDropped() { dropped_.fetch_add(1, std::memory_order_relaxed); }
+
+    /// @brief 崩溃处理：不等待后台线程，尽力写出全部记录（只执行一次）
+    void flushForCrash();
+
+private:
+    DeferredLog();
+    ~DeferredLog();
+
+    struct Impl;
+    /// @brief 取出全部线程的记录并写出（持有写出锁）
+    void drainAll();
+    /// @brief 格式化给定缓冲中的记录，按时间戳排序后写入默认 logger（调用方持有写出锁）
+    void writeRecords(const std::vector<std::shared_ptr<DeferredLogRing>>& rings);
+
+    std::unique_ptr<Impl> impl_;
+    std::atomic<bool> running_{ false };
+    std::atomic<std::uint64_t> dropped_{ 0 };
+};
+
+namespace detail {
+
+/// @brief 记录中保存的字符串：2 字节长度 + 内容
+struct DeferredString {};
+
+inline constexpr std::size_t MAX_STRING_BYTES = 256;
+
+template <typename T>
+struct DeferredStored {
+    using type = std::remove_cvref_t<T>;
+    static_assert(std::is_arithmetic_v<type> || std::is_enum_v<type>,
+                  "延迟日志的参数只能是算术类型、枚举或字符串");
+};
+template <typename T>
+    requires std::convertible_to<const T&, std::string_view> && (!std::is_arithmetic_v<std::remove_cvref_t<T>>)
+struct DeferredStored<T> {
+    using type = DeferredString;
+};
+
+template <typename T>
+using DeferredStoredT = typename DeferredStored<T>::type;
+
+/// @brief 记录中一个参数的字节数
+template <typename T>
+[[nodiscard]] std::size_t storedSize(const T& value) {
+    if constexpr (std::is_same_v<DeferredStoredT<T>, DeferredString>) {
+        return sizeof(std::uint16_t) + std::min(std::string_view(value).size(), MAX_STRING_BYTES);
+    } else {
+        return sizeof(DeferredStoredT<T>);
+    }
+}
+
+template <typename T>
+std::byte* storeArg(std::byte* out, const T& value) {
+    if constexpr (std::is_same_v<DeferredStoredT<T>, DeferredString>) {
+        const std::string_view text(value);
+        const auto size = static_cast<std::uint16_t>(std::min(text.size(), MAX_STRING_BYTES));
+        std::memcpy(out, &size, sizeof(size));
+        std::memcpy(out + sizeof(size), text.data(), size);
+        return out + sizeof(size) + size;
+    } else {
+        const DeferredStoredT<T> stored = value;
+        std::memcpy(out, &stored, sizeof(stored));
+        return out + sizeof(stored);
+    }
+}
+
+/// @brief 解码后的参数类型：字符串为指向记录内部的 string_view
+template <typename Stored>
+using DeferredDecodedT = std::conditional_t<std::is_same_v<Stored, DeferredString>, std::string_view, Stored>;
+
+template <typename Stored>
+const std::byte* loadArg(const std::byte* in, DeferredDecodedT<Stored>& out) {
+    if constexpr (std::is_same_v<Stored, DeferredString>) {
+        std::uint16_t size = 0;
+        std::memcpy(&size, in, sizeof(size));
+        out = std::string_view(reinterpret_cast<const char*>(in + sizeof(size)), size);
+        return in + sizeof(size) + size;
+    } else {
+        std::memcpy(&out, in, sizeof(Stored));
+        return in + sizeof(Stored);
+    }
+}
+
+template <typename... Stored>
+void formatRecord(fmt::memory_buffer& out, std::string_view format, const std::byte* args) {
+    std::tuple<DeferredDecodedT<Stored>...> values;
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((args = loadArg<Stored>(args, std::get<I>(values))), ...);    // 逗号折叠保证按参数顺序读取
+    }(std::index_sequence_for<Stored...>{});
+    std::apply([&](auto&... value) {
+        fmt::vformat_to(std::back_inserter(out), fmt::string_view(format.data(), format.size()), fmt::make_format_args(value...));
+    }, values);
+}
+
+} // namespace detail
+
+/**
+ * @brief 延迟日志的写入入口
+ * @details 级别检查与 write() 相同；后台线程未运行或当前线程有日志器覆盖时直接同步写出。
+ */
+template <typename... Args>
+inline void writeDeferred(const DeferredSite& site, fmt::format_string<Args...> format, Args&&... args) {
+    auto* logger = threadLogger() ? threadLogger() : spdlog::default_logger_raw();
+    if (!logger || !logger->should_log(site.level_)) {
+        return;
+    }
+    auto& deferred = DeferredLog::instance();
+    if (threadLogger() || !deferred.isRunning()) {
+        write(site.level_, site.file_, site.line_, site.func_, format, std::forward<Args>(args)...);
+        return;
+    }
+
+    std::size_t bytes = sizeof(DeferredRecordHeader) + (std::size_t{ 0 } + ... + detail::storedSize(args));
+    bytes = (bytes + DeferredLogRing::RECORD_ALIGN - 1) & ~(DeferredLogRing::RECORD_ALIGN - 1);
+    auto& ring = deferred.threadRing();
+    std::byte* out = ring.beginWrite(bytes);
+    if (!out) {
+        deferred.countDropped();
+        return;
+    }
+    const fmt::string_view text = format;
+    const DeferredRecordHeader header{
+        &site, &detail::formatRecord<detail::DeferredStoredT<Args>...>, text.data(), static_cast<std::uint32_t>(text.size()),
+        static_cast<std::uint32_t>(bytes),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(spdlog::log_clock::now().time_since_epoch()).count() };
+    std::memcpy(out, &header, sizeof(header));
+    [[maybe_unused]] std::byte* cursor = out + sizeof(header);
+    ((cursor = detail::storeArg(cursor, args)), ...);
+    ring.endWrite();
+}
+
+} // namespace engine::utils::log
+
+#define ENGINE_LOG_DEFERRED_AT(LEVEL, ...)                                                                          \
+    do {                                                                                                            \
+        static const ::engine::utils::log::DeferredSite engine_log_site_{ LEVEL, __FILE__, __LINE__, __func__ };    \
+        ::engine::utils::log::writeDeferred(engine_log_site_, __VA_ARGS__);                                         \
+    } while (false)
+
+#if ENGINE_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define ENGINE_LOG_DEBUG_DEFERRED(...) ENGINE_LOG_DEFERRED_AT(spdlog::level::debug, __VA_ARGS__)
+#else
+#define ENGINE_LOG_DEBUG_DEFERRED(...) ENGINE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if ENGINE_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define ENGINE_LOG_INFO_DEFERRED(...) ENGINE_LOG_DEFERRED_AT(spdlog::level::info, __VA_ARGS__)
+#else
+#define ENGINE_LOG_INFO_DEFERRED(...) ENGINE_LOG_DISABLED(__VA_ARGS__)
+#endif
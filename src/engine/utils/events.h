@@ -8,6 +8,7 @@
 
 #pragma once
 #include <memory>
+#include <entt/core/fwd.hpp>
 #include <entt/entity/entity.hpp>
 
 namespace engine::scene {
@@ -51,9 +52,25 @@ namespace engine::utils {
      * 
      * 当需要替换整个场景栈时触发此事件。
      * @var scene 用于替换的新场景实例
+     * @var prefetch_key 非 0 且与已预取的场景匹配时，改用预取的场景（scene 作为未命中时的后备）
      */
     struct ReplaceSceneEvent {
         std::unique_ptr<engine::scene::Scene> scene;
+        entt::id_type prefetch_key{};
+    };
+
+    /**
+     * @struct PrefetchSceneEvent
+     * @brief 预取场景事件。
+     *
+     * SceneManager 持有该场景并调用其 prefetch()，之后每帧调用 updatePrefetch()，
+     * 直到以相同 key 的 ReplaceSceneEvent 切换过去（场景未就绪时切换推迟到其加载完成）。同一时刻只保留一个预取场景。
+     * @var key 由调用方定义的场景标识（如「第 N 关」）
+     * @var scene 待预取的场景实例（尚未 init）
+     */
+    struct PrefetchSceneEvent {
+        entt::id_type key{};
+        std::unique_ptr<engine::scene::Scene> scene;
     };
     /// @brief 播放动画事件
     struct PlayAnimationEvent {
@@ -0,0 +1,39 @@
+#pragma once
+/**
+ * @file id_map.h
+ * @brief 以 entt::id_type（哈希字符串值）为键的扁平哈希表。
+ *
+ * @details
+ * 资源缓存、蓝图表、输入动作状态等表的键本身就是哈希值，std::unordered_map 每个元素一次堆分配、
+ * 查找要跳链表节点；entt::dense_map 把键值对连续存放在一个数组里，配合 entt::identity
+ * 直接把 ID 当作哈希值，查找只需一次取模和一次连续内存访问。
+ *
+ * 注意与 std::unordered_map 的差异：
+ * - erase 采用「与末尾交换再弹出」，会使指向被移动元素的迭代器/引用失效
+ * - at() 在键不存在时只断言不抛异常，需要异常语义时用 getOrThrow()
+ */
+
+#include <stdexcept>
+#include <string>
+#include <entt/container/dense_map.hpp>
+#include <entt/core/fwd.hpp>
+#include <entt/core/utility.hpp>
+
+namespace engine::utils {
+
+template <typename Value>
+using IdMap = entt::dense_map<entt::id_type, Value, entt::identity>;
+
+/**
+ * @brief 按 ID 取值，不存在时抛出 std::out_of_range（与 std::unordered_map::at 一致）
+ * @param what 出错时写入异常信息的表名
+ */
+template <typename Value>
+const Value& getOrThrow(const IdMap<Value>& map, entt::id_type id, const char* what) {
+    if (auto it = map.find(id); it != map.end()) {
+        return it->second;
+    }
+    throw std::out_of_range(std::string(what) + ": 未找到 ID " + std::to_string(id));
+}
+
+} // namespace engine::utils
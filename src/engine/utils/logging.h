@@ -1,41 +1,119 @@
 #pragma once
 
+#include <iterator>
 #include <utility>
 
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
+/**
+ * @brief 编译期最低日志级别（取值同 SPDLOG_LEVEL_*）
+ *
+ * @details
+ * 低于该级别的 ENGINE_LOG_* 宏会被展开为空语句，参数不会被求值也不会被格式化。
+ * 可通过 CMake 的 MONSTERWAR_LOG_ACTIVE_LEVEL 或直接定义该宏覆盖，默认保留全部级别。
+ */
+#ifndef ENGINE_LOG_ACTIVE_LEVEL
+#define ENGINE_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
 namespace engine::utils::log {
 
+/// @brief 当前线程的日志器覆盖，为空时使用 spdlog 默认日志器
+inline spdlog::logger*& threadLogger() {
+    thread_local spdlog::logger* logger = nullptr;
+    return logger;
+}
+
+/**
+ * @brief 作用域内让当前线程的 ENGINE_LOG_* 写入指定日志器，不经过全局默认日志器
+ * @details 批量模拟的工作线程用它把日志导向各自的日志器（或无 sink 的静默日志器）。
+ */
+class ScopedThreadLogger final {
+public:
+    explicit ScopedThreadLogger(spdlog::logger* logger) : previous_(threadLogger()) { threadLogger() = logger; }
+    ~ScopedThreadLogger() { threadLogger() = previous_; }
+
+    ScopedThreadLogger(const ScopedThreadLogger&) = delete;
+    ScopedThreadLogger& operator=(const ScopedThreadLogger&) = delete;
+
+private:
+    spdlog::logger* previous_;
+};
+
+/**
+ * @brief 统一的日志写入入口
+ * @details 先检查运行时级别，只有会被输出时才格式化消息，且前缀与正文写入同一缓冲区。
+ */
+template <typename... Args>
+inline void write(spdlog::level::level_enum level, const char* file, int line, const char* func,
+                  fmt::format_string<Args...> format, Args&&... args) {
+    auto* logger = threadLogger() ? threadLogger() : spdlog::default_logger_raw();
+    if (!logger || !logger->should_log(level)) {
+        return;
+    }
+
+    fmt::memory_buffer buffer;
+    fmt::format_to(std::back_inserter(buffer), "[{}:{} {}] ", file, line, func);
+    fmt::format_to(std::back_inserter(buffer), format, std::forward<Args>(args)...);
+    logger->log(level, spdlog::string_view_t(buffer.data(), buffer.size()));
+}
+
 template <typename... Args>
 inline void trace(const char* file, int line, const char* func, fmt::format_string<Args...> format, Args&&... args) {
-    spdlog::trace("[{}:{} {}] {}", file, line, func, fmt::format(format, std::forward<Args>(args)...));
+    write(spdlog::level::trace, file, line, func, format, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
 inline void debug(const char* file, int line, const char* func, fmt::format_string<Args...> format, Args&&... args) {
-    spdlog::debug("[{}:{} {}] {}", file, line, func, fmt::format(format, std::forward<Args>(args)...));
+    write(spdlog::level::debug, file, line, func, format, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
 inline void info(const char* file, int line, const char* func, fmt::format_string<Args...> format, Args&&... args) {
-    spdlog::info("[{}:{} {}] {}", file, line, func, fmt::format(format, std::forward<Args>(args)...));
+    write(spdlog::level::info, file, line, func, format, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
 inline void warn(const char* file, int line, const char* func, fmt::format_string<Args...> format, Args&&... args) {
-    spdlog::warn("[{}:{} {}] {}", file, line, func, fmt::format(format, std::forward<Args>(args)...));
+    write(spdlog::level::warn, file, line, func, format, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
 inline void error(const char* file, int line, const char* func, fmt::format_string<Args...> format, Args&&... args) {
-    spdlog::error("[{}:{} {}] {}", file, line, func, fmt::format(format, std::forward<Args>(args)...));
+    write(spdlog::level::err, file, line, func, format, std::forward<Args>(args)...);
 }
 
 } // namespace engine::utils::log
 
+#define ENGINE_LOG_DISABLED(...) static_cast<void>(0)
+
+#if ENGINE_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
 #define ENGINE_LOG_TRACE(...) engine::utils::log::trace(__FILE__, __LINE__, __func__, __VA_ARGS__)
+#else
+#define ENGINE_LOG_TRACE(...) ENGINE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if ENGINE_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
 #define ENGINE_LOG_DEBUG(...) engine::utils::log::debug(__FILE__, __LINE__, __func__, __VA_ARGS__)
+#else
+#define ENGINE_LOG_DEBUG(...) ENGINE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if ENGINE_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
 #define ENGINE_LOG_INFO(...) engine::utils::log::info(__FILE__, __LINE__, __func__, __VA_ARGS__)
+#else
+#define ENGINE_LOG_INFO(...) ENGINE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if ENGINE_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
 #define ENGINE_LOG_WARN(...) engine::utils::log::warn(__FILE__, __LINE__, __func__, __VA_ARGS__)
+#else
+#define ENGINE_LOG_WARN(...) ENGINE_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if ENGINE_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
 #define ENGINE_LOG_ERROR(...) engine::utils::log::error(__FILE__, __LINE__, __func__, __VA_ARGS__)
+#else
+#define ENGINE_LOG_ERROR(...) ENGINE_LOG_DISABLED(__VA_ARGS__)
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+/**
+ * @file mapped_file.h
+ * @brief 只读内存映射文件（RAII），用于零拷贝读取预编译的二进制资源。
+ */
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace engine::utils {
+
+/**
+ * @class MappedFile
+ * @brief 以只读方式将整个文件映射到进程地址空间
+ *
+ * @details
+ * Windows 使用 CreateFileMapping/MapViewOfFile，其他平台使用 mmap。映射在对象析构时解除，
+ * 通过 bytes() 取得的视图不得超出对象生命周期。空文件或打开失败时 isOpen() 为 false。
+ */
+class MappedFile final {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief 映射文件（已映射时先解除旧映射）
+     * @param path 文件路径
+     * @return 映射成功返回 true
+     */
+    bool open(const std::string& path);
+    /// @brief 解除映射并关闭文件
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return data_ != nullptr; }
+    [[nodiscard]] const std::byte* data() const { return data_; }
+    [[nodiscard]] std::size_t size() const { return size_; }
+    [[nodiscard]] std::span<const std::byte> bytes() const { return { data_, size_ }; }
+
+private:
+    const std::byte* data_{nullptr};
+    std::size_t size_{0};
+#ifdef _WIN32
+    void* file_handle_{nullptr};        ///< HANDLE（避免在头文件中引入 windows.h）
+    void* mapping_handle_{nullptr};     ///< 文件映射对象 HANDLE
+#endif
+};
+
+} // namespace engine::utils
@@ -0,0 +1,455 @@
+#include "math.h"
+
+#include <bit>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define ENGINE_DISTANCE_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define ENGINE_TARGET_AVX2
+#else
+#define ENGINE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__)
+#define ENGINE_DISTANCE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace engine::utils {
+
+namespace {
+
+/// @brief 一组批量距离与位置积分实现；radius_sq 均为已平方的半径，integrate_ 的 count 为浮点分量数
+struct DistanceKernels {
+    const char* name_;
+    void (*batch_)(float px, float py, const float* xs, const float* ys, std::size_t count, float* out);
+    std::size_t (*first_)(float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq);
+    std::size_t (*min_)(float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq, float* best_sq);
+    std::size_t (*count_)(float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq);
+    void (*integrate_)(float* positions, const float* velocities, std::size_t count, float dt);
+};
+
+// --- 标量实现：也用于向量实现处理末尾不足一组的部分（从 begin 开始） ---
+
+inline float scalarDistanceSq(float px, float py, float x, float y) {
+    const float dx = x - px;
+    const float dy = y - py;
+    return dx * dx + dy * dy;
+}
+
+void batchScalar(float px, float py, const float* xs, const float* ys, std::size_t begin, std::size_t count, float* out) {
+    for (std::size_t i = begin; i < count; ++i) {
+        out[i] = scalarDistanceSq(px, py, xs[i], ys[i]);
+    }
+}
+
+std::size_t firstScalar(float px, float py, const float* xs, const float* ys, std::size_t begin, std::size_t count, float radius_sq) {
+    for (std::size_t i = begin; i < count; ++i) {
+        if (scalarDistanceSq(px, py, xs[i], ys[i]) <= radius_sq) {
+            return i;
+        }
+    }
+    return count;
+}
+
+/// @brief 在 [begin, count) 中寻找严格小于 *best_sq 的最近点，找到时更新 best_index 与 *best_sq
+void minScalar(float px, float py, const float* xs, const float* ys, std::size_t begin, std::size_t count, float radius_sq,
+               std::size_t& best_index, float& best_sq) {
+    for (std::size_t i = begin; i < count; ++i) {
+        const float distance_sq = scalarDistanceSq(px, py, xs[i], ys[i]);
+        if (distance_sq <= radius_sq && distance_sq < best_sq) {
+            best_sq = distance_sq;
+            best_index = i;
+        }
+    }
+}
+
+std::size_t countScalar(float px, float py, const float* xs, const float* ys, std::size_t begin, std::size_t count, float radius_sq) {
+    std::size_t within = 0;
+    for (std::size_t i = begin; i < count; ++i) {
+        within += scalarDistanceSq(px, py, xs[i], ys[i]) <= radius_sq ? 1 : 0;
+    }
+    return within;
+}
+
+void integrateScalar(float* positions, const float* velocities, std::size_t begin, std::size_t count, float dt) {
+    for (std::size_t i = begin; i < count; ++i) {
+        positions[i] += velocities[i] * dt;
+    }
+}
+
+#if defined(ENGINE_DISTANCE_X86) || defined(ENGINE_DISTANCE_NEON)
+/// @brief 各向量实现共用：合并每通道的最近点（同距离取下标小者），没有时 best_index 保持 count
+void reduceLanes(const float* lane_sq, const std::int32_t* lane_index, std::size_t lanes, std::size_t& best_index, float& best_sq) {
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+        if (lane_index[lane] < 0) {
+            continue;
+        }
+        const auto index = static_cast<std::size_t>(lane_index[lane]);
+        if (lane_sq[lane] < best_sq || (lane_sq[lane] == best_sq && index < best_index)) {
+            best_sq = lane_sq[lane];
+            best_index = index;
+        }
+    }
+}
+#endif
+
+const DistanceKernels SCALAR_KERNELS{
+    "scalar",
+    [](float px, float py, const float* xs, const float* ys, std::size_t count, float* out) {
+        batchScalar(px, py, xs, ys, 0, count, out);
+    },
+    [](float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq) {
+        return firstScalar(px, py, xs, ys, 0, count, radius_sq);
+    },
+    [](float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq, float* best_sq) {
+        std::size_t best_index = count;
+        float best = std::numeric_limits<float>::infinity();
+        minScalar(px, py, xs, ys, 0, count, radius_sq, best_index, best);
+        if (best_index < count && best_sq) {
+            *best_sq = best;
+        }
+        return best_index;
+    },
+    [](float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq) {
+        return countScalar(px, py, xs, ys, 0, count, radius_sq);
+    },
+    [](float* positions, const float* velocities, std::size_t count, float dt) {
+        integrateScalar(positions, velocities, 0, count, dt);
+    },
+};
+
+#if defined(ENGINE_DISTANCE_X86)
+
+// --- SSE2（x86-64 基线指令集，每次 4 个） ---
+
+inline __m128 sseDistanceSq(__m128 px, __m128 py, const float* xs, const float* ys, std::size_t i) {
+    const __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), px);
+    const __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), py);
+    return _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+}
+
+void batchSse2(float px, float py, const float* xs, const float* ys, std::size_t count, float* out) {
+    const __m128 vpx = _mm_set1_ps(px);
+    const __m128 vpy = _mm_set1_ps(py);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(out + i, sseDistanceSq(vpx, vpy, xs, ys, i));
+    }
+    batchScalar(px, py, xs, ys, i, count, out);
+}
+
+std::size_t firstSse2(float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq) {
+    const __m128 vpx = _mm_set1_ps(px);
+    const __m128 vpy = _mm_set1_ps(py);
+    const __m128 vr = _mm_set1_ps(radius_sq);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const int bits = _mm_movemask_ps(_mm_cmple_ps(sseDistanceSq(vpx, vpy, xs, ys, i), vr));
+        if (bits != 0) {
+            return i + static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(bits)));
+        }
+    }
+    return firstScalar(px, py, xs, ys, i, count, radius_sq);
+}
+
+std::size_t minSse2(float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq, float* best_sq) {
+    const __m128 vpx = _mm_set1_ps(px);
+    const __m128 vpy = _mm_set1_ps(py);
+    const __m128 vr = _mm_set1_ps(radius_sq);
+    __m128 best = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    __m128i best_index = _mm_set1_epi32(-1);
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i step = _mm_set1_epi32(4);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 distance_sq = sseDistanceSq(vpx, vpy, xs, ys, i);
+        // 严格小于：同一通道内先出现的点保留
+        const __m128 better = _mm_and_ps(_mm_cmplt_ps(distance_sq, best), _mm_cmple_ps(distance_sq, vr));
+        best = _mm_or_ps(_mm_and_ps(better, distance_sq), _mm_andnot_ps(better, best));
+        const __m128i mask = _mm_castps_si128(better);
+        best_index = _mm_or_si128(_mm_and_si128(mask, index), _mm_andnot_si128(mask, best_index));
+        index = _mm_add_epi32(index, step);
+    }
+    alignas(16) float lane_sq[4];
+    alignas(16) std::int32_t lane_index[4];
+    _mm_store_ps(lane_sq, best);
+    _mm_store_si128(reinterpret_cast<__m128i*>(lane_index), best_index);
+
+    std::size_t result = count;
+    float result_sq = std::numeric_limits<float>::infinity();
+    reduceLanes(lane_sq, lane_index, 4, result, result_sq);
+    minScalar(px, py, xs, ys, i, count, radius_sq, result, result_sq);
+    if (result < count && best_sq) {
+        *best_sq = result_sq;
+    }
+    return result;
+}
+
+std::size_t countSse2(float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq) {
+    const __m128 vpx = _mm_set1_ps(px);
+    const __m128 vpy = _mm_set1_ps(py);
+    const __m128 vr = _mm_set1_ps(radius_sq);
+    std::size_t within = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const int bits = _mm_movemask_ps(_mm_cmple_ps(sseDistanceSq(vpx, vpy, xs, ys, i), vr));
+        within += static_cast<std::size_t>(std::popcount(static_cast<unsigned>(bits)));
+    }
+    return within + countScalar(px, py, xs, ys, i, count, radius_sq);
+}
+
+/// @brief 每次 4 个分量（2 个实体）
+void integrateSse2(float* positions, const float* velocities, std::size_t count, float dt) {
+    const __m128 vdt = _mm_set1_ps(dt);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 step = _mm_mul_ps(_mm_loadu_ps(velocities + i), vdt);
+        _mm_storeu_ps(positions + i, _mm_add_ps(_mm_loadu_ps(positions + i), step));
+    }
+    integrateScalar(positions, velocities, i, count, dt);
+}
+
+const DistanceKernels SSE2_KERNELS{ "sse2", &batchSse2, &firstSse2, &minSse2, &countSse2, &integrateSse2 };
+
+// --- AVX2（运行时检测，每次 8 个） ---
+
+ENGINE_TARGET_AVX2 inline __m256 avxDistanceSq(__m256 px, __m256 py, const float* xs, const float* ys, std::size_t i) {
+    const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), px);
+    const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), py);
+    return _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+}
+
+ENGINE_TARGET_AVX2 void batchAvx2(float px, float py, const float* xs, const float* ys, std::size_t count, float* out) {
+    const __m256 vpx = _mm256_set1_ps(px);
+    const __m256 vpy = _mm256_set1_ps(py);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(out + i, avxDistanceSq(vpx, vpy, xs, ys, i));
+    }
+    batchScalar(px, py, xs, ys, i, count, out);
+}
+
+ENGINE_TARGET_AVX2 std::size_t firstAvx2(float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq) {
+    const __m256 vpx = _mm256_set1_ps(px);
+    const __m256 vpy = _mm256_set1_ps(py);
+    const __m256 vr = _mm256_set1_ps(radius_sq);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const int bits = _mm256_movemask_ps(_mm256_cmp_ps(avxDistanceSq(vpx, vpy, xs, ys, i), vr, _CMP_LE_OQ));
+        if (bits != 0) {
+            return i + static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(bits)));
+        }
+    }
+    return firstScalar(px, py, xs, ys, i, count, radius_sq);
+}
+
+ENGINE_TARGET_AVX2 std::size_t minAvx2(float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq, float* best_sq) {
+    const __m256 vpx = _mm256_set1_ps(px);
+    const __m256 vpy = _mm256_set1_ps(py);
+    const __m256 vr = _mm256_set1_ps(radius_sq);
+    __m256 best = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    __m256i best_index = _mm256_set1_epi32(-1);
+    __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i step = _mm256_set1_epi32(8);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 distance_sq = avxDistanceSq(vpx, vpy, xs, ys, i);
+        const __m256 better = _mm256_and_ps(_mm256_cmp_ps(distance_sq, best, _CMP_LT_OQ), _mm256_cmp_ps(distance_sq, vr, _CMP_LE_OQ));
+        best = _mm256_blendv_ps(best, distance_sq, better);
+        best_index = _mm256_blendv_epi8(best_index, index, _mm256_castps_si256(better));
+        index = _mm256_add_epi32(index, step);
+    }
+    alignas(32) float lane_sq[8];
+    alignas(32) std::int32_t lane_index[8];
+    _mm256_store_ps(lane_sq, best);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lane_index), best_index);
+
+    std::size_t result = count;
+    float result_sq = std::numeric_limits<float>::infinity();
+    reduceLanes(lane_sq, lane_index, 8, result, result_sq);
+    minScalar(px, py, xs, ys, i, count, radius_sq, result, result_sq);
+    if (result < count && best_sq) {
+        *best_sq = result_sq;
+    }
+    return result;
+}
+
+ENGINE_TARGET_AVX2 std::size_t countAvx2(float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq) {
+    const __m256 vpx = _mm256_set1_ps(px);
+    const __m256 vpy = _mm256_set1_ps(py);
+    const __m256 vr = _mm256_set1_ps(radius_sq);
+    std::size_t within = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const int bits = _mm256_movemask_ps(_mm256_cmp_ps(avxDistanceSq(vpx, vpy, xs, ys, i), vr, _CMP_LE_OQ));
+        within += static_cast<std::size_t>(std::popcount(static_cast<unsigned>(bits)));
+    }
+    return within + countScalar(px, py, xs, ys, i, count, radius_sq);
+}
+
+/// @brief 每次 8 个分量（4 个实体）
+ENGINE_TARGET_AVX2 void integrateAvx2(float* positions, const float* velocities, std::size_t count, float dt) {
+    const __m256 vdt = _mm256_set1_ps(dt);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 step = _mm256_mul_ps(_mm256_loadu_ps(velocities + i), vdt);
+        _mm256_storeu_ps(positions + i, _mm256_add_ps(_mm256_loadu_ps(positions + i), step));
+    }
+    integrateScalar(positions, velocities, i, count, dt);
+}
+
+const DistanceKernels AVX2_KERNELS{ "avx2", &batchAvx2, &firstAvx2, &minAvx2, &countAvx2, &integrateAvx2 };
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;   // OSXSAVE 且系统保存 YMM 状态
+    __cpuidex(info, 7, 0);
+    return os_saves_ymm && (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#elif defined(ENGINE_DISTANCE_NEON)
+
+// --- NEON（AArch64 基线指令集，每次 4 个） ---
+
+inline float32x4_t neonDistanceSq(float32x4_t px, float32x4_t py, const float* xs, const float* ys, std::size_t i) {
+    const float32x4_t dx = vsubq_f32(vld1q_f32(xs + i), px);
+    const float32x4_t dy = vsubq_f32(vld1q_f32(ys + i), py);
+    return vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));     // 乘与加分开，不用 vfmaq
+}
+
+void batchNeon(float px, float py, const float* xs, const float* ys, std::size_t count, float* out) {
+    const float32x4_t vpx = vdupq_n_f32(px);
+    const float32x4_t vpy = vdupq_n_f32(py);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(out + i, neonDistanceSq(vpx, vpy, xs, ys, i));
+    }
+    batchScalar(px, py, xs, ys, i, count, out);
+}
+
+std::size_t firstNeon(float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq) {
+    const float32x4_t vpx = vdupq_n_f32(px);
+    const float32x4_t vpy = vdupq_n_f32(py);
+    const float32x4_t vr = vdupq_n_f32(radius_sq);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        if (vmaxvq_u32(vcleq_f32(neonDistanceSq(vpx, vpy, xs, ys, i), vr)) != 0) {
+            return firstScalar(px, py, xs, ys, i, i + 4, radius_sq);
+        }
+    }
+    return firstScalar(px, py, xs, ys, i, count, radius_sq);
+}
+
+std::size_t minNeon(float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq, float* best_sq) {
+    const float32x4_t vpx = vdupq_n_f32(px);
+    const float32x4_t vpy = vdupq_n_f32(py);
+    const float32x4_t vr = vdupq_n_f32(radius_sq);
+    float32x4_t best = vdupq_n_f32(std::numeric_limits<float>::infinity());
+    int32x4_t best_index = vdupq_n_s32(-1);
+    const std::int32_t first_lanes[4] = { 0, 1, 2, 3 };
+    int32x4_t index = vld1q_s32(first_lanes);
+    const int32x4_t step = vdupq_n_s32(4);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t distance_sq = neonDistanceSq(vpx, vpy, xs, ys, i);
+        const uint32x4_t better = vandq_u32(vcltq_f32(distance_sq, best), vcleq_f32(distance_sq, vr));
+        best = vbslq_f32(better, distance_sq, best);
+        best_index = vbslq_s32(better, index, best_index);
+        index = vaddq_s32(index, step);
+    }
+    float lane_sq[4];
+    std::int32_t lane_index[4];
+    vst1q_f32(lane_sq, best);
+    vst1q_s32(lane_index, best_index);
+
+    std::size_t result = count;
+    float result_sq = std::numeric_limits<float>::infinity();
+    reduceLanes(lane_sq, lane_index, 4, result, result_sq);
+    minScalar(px, py, xs, ys, i, count, radius_sq, result, result_sq);
+    if (result < count && best_sq) {
+        *best_sq = result_sq;
+    }
+    return result;
+}
+
+std::size_t countNeon(float px, float py, const float* xs, const float* ys, std::size_t count, float radius_sq) {
+    const float32x4_t vpx = vdupq_n_f32(px);
+    const float32x4_t vpy = vdupq_n_f32(py);
+    const float32x4_t vr = vdupq_n_f32(radius_sq);
+    uint32x4_t within = vdupq_n_u32(0);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        within = vsubq_u32(within, vcleq_f32(neonDistanceSq(vpx, vpy, xs, ys, i), vr));    // 命中通道为全 1（-1）
+    }
+    return static_cast<std::size_t>(vaddvq_u32(within)) + countScalar(px, py, xs, ys, i, count, radius_sq);
+}
+
+void integrateNeon(float* positions, const float* velocities, std::size_t count, float dt) {
+    const float32x4_t vdt = vdupq_n_f32(dt);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(positions + i, vaddq_f32(vld1q_f32(positions + i), vmulq_f32(vld1q_f32(velocities + i), vdt)));  // 不用 vfmaq
+    }
+    integrateScalar(positions, velocities, i, count, dt);
+}
+
+const DistanceKernels NEON_KERNELS{ "neon", &batchNeon, &firstNeon, &minNeon, &countNeon, &integrateNeon };
+
+#endif
+
+const DistanceKernels& selectKernels() {
+#if defined(ENGINE_DISTANCE_X86)
+    return cpuHasAvx2() ? AVX2_KERNELS : SSE2_KERNELS;
+#elif defined(ENGINE_DISTANCE_NEON)
+    return NEON_KERNELS;
+#else
+    return SCALAR_KERNELS;
+#endif
+}
+
+/// @brief 首次调用时选定（函数内静态变量的初始化是线程安全的）
+const DistanceKernels& kernels() {
+    static const DistanceKernels& selected = selectKernels();
+    return selected;
+}
+
+} // namespace
+
+void distanceSquaredBatch(const glm::vec2& point, const float* xs, const float* ys, std::size_t count, float* out) {
+    kernels().batch_(point.x, point.y, xs, ys, count, out);
+}
+
+std::size_t firstWithinRadius(const glm::vec2& point, const float* xs, const float* ys, std::size_t count, float radius) {
+    return kernels().first_(point.x, point.y, xs, ys, count, radius * radius);
+}
+
+std::size_t minDistanceIndex(const glm::vec2& point, const float* xs, const float* ys, std::size_t count, float radius, float* distance_sq) {
+    return kernels().min_(point.x, point.y, xs, ys, count, radius * radius, distance_sq);
+}
+
+std::size_t countWithinRadius(const glm::vec2& point, const float* xs, const float* ys, std::size_t count, float radius) {
+    return kernels().count_(point.x, point.y, xs, ys, count, radius * radius);
+}
+
+void integratePositions(glm::vec2* positions, const glm::vec2* velocities, std::size_t count, float dt) {
+    static_assert(sizeof(glm::vec2) == 2 * sizeof(float));
+    kernels().integrate_(reinterpret_cast<float*>(positions), reinterpret_cast<const float*>(velocities), count * 2, dt);
+}
+
+const char* distanceKernelName() {
+    return kernels().name_;
+}
+
+} // namespace engine::utils
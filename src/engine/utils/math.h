@@ -1,7 +1,9 @@
 #pragma once
 #include <glm/vec2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <string_view>
-#include <random>
 
 
 namespace engine::utils {
@@ -32,6 +34,32 @@ struct FColor
     constexpr FColor(float r, float g, float b, float a = 1.0f) : r(r), g(g), b(b), a(a) {}
 };
 
+/**
+ * @brief 每通道 8 位的紧凑颜色（4 字节），用于逐实体存储的颜色调制；提交绘制时再转换为 FColor。
+ */
+struct Color8
+{
+    std::uint8_t r{ 255 };
+    std::uint8_t g{ 255 };
+    std::uint8_t b{ 255 };
+    std::uint8_t a{ 255 };
+    constexpr Color8() = default;   ///< 默认为不透明白色（不调制）
+    constexpr Color8(float r, float g, float b, float a = 1.0f)
+        : r(toChannel(r)), g(toChannel(g)), b(toChannel(b)), a(toChannel(a)) {}
+    constexpr Color8(const FColor& color) : Color8(color.r, color.g, color.b, color.a) {}
+
+    [[nodiscard]] constexpr FColor toFColor() const {
+        return FColor{ r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f };
+    }
+    [[nodiscard]] constexpr bool operator==(const Color8&) const = default;
+
+private:
+    static constexpr std::uint8_t toChannel(float value) {
+        const float clamped = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+        return static_cast<std::uint8_t>(clamped * 255.0f + 0.5f);
+    }
+};
+
 namespace {
     /**
      * @brief 内部工具：将十六进制字符转换为整数
@@ -44,15 +72,6 @@ namespace {
         if ('A' <= c && c <= 'F') return 10 + (c - 'A');
         return 0;
     }
-
-    /**
-     * @brief 内部工具：获取线程本地随机数生成器
-     * @return 线程本地的 std::mt19937 引用
-     */
-    std::mt19937& getThreadLocalGenerator() {
-        static thread_local std::mt19937 generator{std::random_device{}()};
-        return generator;
-    }
 }
 
 /**
@@ -86,17 +105,6 @@ namespace {
     };
 }
 
-/**
- * @brief 生成指定范围内的随机整数 [min, max]
- * @param min 最小值（包含）
- * @param max 最大值（包含）
- * @return 随机整数
- */
- inline int randomInt(int min, int max) {
-    std::uniform_int_distribution<int> distribution(min, max);
-    return distribution(getThreadLocalGenerator());
-}
-
 /**
  * @brief 根据等级和稀有度计算属性缩放值
  * @param base 基础属性值
@@ -124,4 +132,43 @@ inline float distanceSquared(const glm::vec2& a, const glm::vec2& b) {
     return diff.x * diff.x + diff.y * diff.y;
 }
 
+// --- 批量距离计算 ---
+// 以下函数对 SoA 数组（xs[i], ys[i] 为第 i 个点）批量计算到 point 的平方距离，实现见 math.cpp：
+// 首次调用时按 CPU 能力选择 AVX2（每次 8 个）/ SSE2 / NEON（每次 4 个）或标量实现。
+// 各实现都按 dx * dx + dy * dy 分别做乘与加（不使用乘加融合），x86 上与标量 distanceSquared() 的结果逐位相同；
+// 「半径内」均为闭区间（distance_sq <= radius * radius），与 SpatialGrid::forEachInRadius 一致。
+
+/**
+ * @brief 计算每个点到 point 的平方距离
+ * @param out 输出数组，长度至少为 count（可与 xs / ys 不同）
+ */
+void distanceSquaredBatch(const glm::vec2& point, const float* xs, const float* ys, std::size_t count, float* out);
+
+/**
+ * @brief 第一个落在半径内的点
+ * @return 下标；没有时返回 count
+ */
+[[nodiscard]] std::size_t firstWithinRadius(const glm::vec2& point, const float* xs, const float* ys, std::size_t count, float radius);
+
+/**
+ * @brief 半径内距离最近的点，距离相同时取下标较小者
+ * @param distance_sq 非空时写入最近点的平方距离（没有时不写）
+ * @return 下标；没有时返回 count
+ */
+[[nodiscard]] std::size_t minDistanceIndex(const glm::vec2& point, const float* xs, const float* ys, std::size_t count,
+                                           float radius = std::numeric_limits<float>::max(), float* distance_sq = nullptr);
+
+/// @brief 半径内的点数
+[[nodiscard]] std::size_t countWithinRadius(const glm::vec2& point, const float* xs, const float* ys, std::size_t count, float radius);
+
+/**
+ * @brief 批量欧拉积分：positions[i] += velocities[i] * dt（两个数组都是紧密排列的 count 个 vec2）
+ * @details 与批量距离使用同一套实现（AVX2 每次 4 个实体 / SSE2、NEON 每次 2 个），乘与加分开，
+ *          结果与逐实体的 position += velocity * dt 逐位相同。positions 与 velocities 不能重叠。
+ */
+void integratePositions(glm::vec2* positions, const glm::vec2* velocities, std::size_t count, float dt);
+
+/// @brief 当前使用的批量距离实现名称（"avx2" / "sse2" / "neon" / "scalar"），用于日志与调试面板
+[[nodiscard]] const char* distanceKernelName();
+
 } // namespace engine::utils
@@ -0,0 +1,116 @@
+#pragma once
+/**
+ * @file mpsc_queue.h
+ * @brief 固定容量的多生产者/单消费者无锁队列。
+ *
+ * @details
+ * 有界环形缓冲，每个槽位带一个序号（Vyukov 有界队列的单消费者版本）：
+ * - 生产者以 CAS 递增 head_ 占下一个槽位，写入元素后发布该槽位的序号；多个生产者互不等待对方写完
+ * - 消费者看到槽位序号已发布才读取，读完把序号推进一圈，交还给生产者
+ *
+ * 与 SpscQueue 相同：只存放可平凡拷贝的小消息，队列满时 tryPush 返回 false，永不阻塞也不分配。
+ *
+ * @code
+ * engine::utils::MpscQueue<Message, 256> queue;
+ * queue.tryPush(Message{ ... });          // 任意线程
+ * queue.drain([](const Message& m) { });  // 唯一的消费者线程
+ * @endcode
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "spsc_queue.h"
+
+namespace engine::utils {
+
+template <typename T, std::size_t Capacity>
+class MpscQueue final {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "MpscQueue 容量必须为 2 的幂");
+    static_assert(std::is_trivially_copyable_v<T>, "MpscQueue 只存放可平凡拷贝的小消息");
+
+public:
+    static constexpr std::size_t CAPACITY = Capacity;
+
+    MpscQueue() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            cells_[i].sequence_.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /// @brief 任意线程写入一个元素，队列已满时返回 false
+    bool tryPush(const T& value) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        while (true) {
+            cell = &cells_[head & (Capacity - 1)];
+            const std::size_t sequence = cell->sequence_.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(head);
+            if (diff == 0) {
+                // 槽位空闲：占下它（失败时 head 被更新为最新值，重试）
+                if (head_.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;   // 槽位还存着上一圈未读出的元素
+            } else {
+                head = head_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value_ = value;
+        cell->sequence_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief 消费者取出一个元素，队列为空（或下一个槽位尚未写完）时返回 false
+    bool tryPop(T& out) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[tail & (Capacity - 1)];
+        if (cell.sequence_.load(std::memory_order_acquire) != tail + 1) {
+            return false;
+        }
+        out = cell.value_;
+        cell.sequence_.store(tail + Capacity, std::memory_order_release);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 消费者按写入顺序处理当前可读的元素，最多一圈（生产者持续写入时也会返回）
+     * @return 处理的元素数
+     */
+    template <typename Fn>
+    std::size_t drain(Fn&& fn) {
+        std::size_t count = 0;
+        T value;
+        while (count < Capacity && tryPop(value)) {
+            fn(value);
+            ++count;
+        }
+        return count;
+    }
+
+    /// @brief 近似的元素数（含已占位、尚未写完的槽位，仅供统计）
+    [[nodiscard]] std::size_t sizeApprox() const {
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        return head > tail ? head - tail : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence_;     ///< == 位置：可写；== 位置 + 1：可读
+        T value_;
+    };
+
+    alignas(CACHE_LINE_SIZE) std::array<Cell, Capacity> cells_;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_{ 0 };   ///< 下一个待占用的位置（生产者竞争）
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_{ 0 };   ///< 下一次读取位置（消费者持有）
+};
+
+} // namespace engine::utils
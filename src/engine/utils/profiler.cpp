@@ -0,0 +1,309 @@
+#include "profiler.h"
+#include "../memory/allocation_counter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace engine::utils {
+
+namespace {
+    thread_local ProfileRingBuffer* t_buffer = nullptr;
+    thread_local std::uint32_t t_depth = 0;
+    thread_local bool t_suppressed = false;
+
+    std::int64_t steadyNowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    double percentile(std::vector<double>& values, double p) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        const auto index = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+        return values[index];
+    }
+}
+
+// --- ProfileRingBuffer ---
+
+bool ProfileRingBuffer::push(const ProfileSample& sample) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    const std::size_t tail = tail_.load(std::memory_order_acquire);
+    if (head - tail >= CAPACITY) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    samples_[head & (CAPACITY - 1)] = sample;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void ProfileRingBuffer::drain(std::vector<ProfileSample>& out) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const std::size_t head = head_.load(std::memory_order_acquire);
+    for (std::size_t i = tail; i != head; ++i) {
+        out.push_back(samples_[i & (CAPACITY - 1)]);
+    }
+    tail_.store(head, std::memory_order_release);
+}
+
+// --- Profiler ---
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : epoch_ns_(steadyNowNs()) {}
+
+std::uint64_t Profiler::nowNs() const {
+    return static_cast<std::uint64_t>(steadyNowNs() - epoch_ns_);
+}
+
+ProfileRingBuffer& Profiler::threadBuffer() {
+    if (!t_buffer) {
+        std::lock_guard lock(buffers_mutex_);
+        auto thread_id = static_cast<std::uint32_t>(buffers_.size());
+        buffers_.push_back(std::make_unique<ProfileRingBuffer>(thread_id));
+        t_buffer = buffers_.back().get();
+    }
+    return *t_buffer;
+}
+
+std::uint64_t Profiler::getDroppedCount() const {
+    std::lock_guard lock(buffers_mutex_);
+    std::uint64_t dropped = 0;
+    for (const auto& buffer : buffers_) {
+        dropped += buffer->getDroppedCount();
+    }
+    return dropped;
+}
+
+void Profiler::setHistorySize(std::size_t size) {
+    history_size_ = std::max<std::size_t>(size, 1);
+    while (history_.size() > history_size_) {
+        history_.pop_front();
+    }
+}
+
+void Profiler::beginFrame() {
+    frame_start_ns_ = nowNs();
+    {
+        std::lock_guard lock(counters_mutex_);
+        frame_counters_.clear();
+    }
+    const auto allocations = engine::memory::threadAllocations();
+    frame_start_allocations_ = allocations.count_;
+    frame_start_bytes_ = allocations.bytes_;
+}
+
+void Profiler::endFrame() {
+    // 先取分配计数，归档本身的分配不算入本帧
+    const auto allocations = engine::memory::threadAllocations();
+    FrameCapture capture;
+    capture.allocations_ = allocations.count_ - frame_start_allocations_;
+    capture.allocated_bytes_ = allocations.bytes_ - frame_start_bytes_;
+    capture.frame_index_ = frame_index_++;
+    capture.start_ns_ = frame_start_ns_;
+    capture.end_ns_ = nowNs();
+    // 复制而不是移走，frame_counters_ 保留容量，帧内 setCounter 不再分配
+    {
+        std::lock_guard lock(counters_mutex_);
+        capture.counters_ = frame_counters_;
+        frame_counters_.clear();
+    }
+
+    {
+        std::lock_guard lock(buffers_mutex_);
+        for (auto& buffer : buffers_) {
+            buffer->drain(capture.samples_);
+        }
+    }
+
+    // 暂停或禁用时仍需清空缓冲区，避免写满后丢弃恢复后的记录
+    if (capture_paused_ || !isEnabled()) {
+        return;
+    }
+
+    std::sort(capture.samples_.begin(), capture.samples_.end(), [](const ProfileSample& a, const ProfileSample& b) {
+        return a.start_ns_ != b.start_ns_ ? a.start_ns_ < b.start_ns_ : a.depth_ < b.depth_;
+    });
+
+    history_.push_back(std::move(capture));
+    while (history_.size() > history_size_) {
+        history_.pop_front();
+    }
+}
+
+void Profiler::setThreadSuppressed(bool suppressed) {
+    t_suppressed = suppressed;
+}
+
+bool Profiler::isThreadSuppressed() {
+    return t_suppressed;
+}
+
+void Profiler::setCounter(const char* name, std::int64_t value) {
+    if (t_suppressed) {
+        return;
+    }
+    std::lock_guard lock(counters_mutex_);
+    for (auto& [counter_name, counter_value] : frame_counters_) {
+        if (counter_name == name) {
+            counter_value = value;
+            return;
+        }
+    }
+    frame_counters_.emplace_back(name, value);
+}
+
+const char* Profiler::internName(std::string_view name) {
+    std::lock_guard lock(names_mutex_);
+    for (const auto& interned : interned_names_) {
+        if (interned == name) {
+            return interned.c_str();
+        }
+    }
+    return interned_names_.emplace_back(name).c_str();
+}
+
+std::vector<ProfileScopeStats> Profiler::computeScopeStats() const {
+    struct Accumulator {
+        std::vector<double> frame_ms_;
+        double last_ms_{0.0};
+        std::uint32_t last_calls_{0};
+        std::uint32_t last_allocations_{0};
+    };
+    struct FrameTotal {
+        double ms_{0.0};
+        std::uint32_t calls_{0};
+        std::uint32_t allocations_{0};
+    };
+    std::unordered_map<std::string_view, Accumulator> accumulators;
+    std::unordered_map<std::string_view, const char*> names;
+
+    for (std::size_t frame = 0; frame < history_.size(); ++frame) {
+        const bool is_last = frame + 1 == history_.size();
+        std::unordered_map<std::string_view, FrameTotal> frame_totals;
+        for (const auto& sample : history_[frame].samples_) {
+            auto& total = frame_totals[sample.name_];
+            total.ms_ += static_cast<double>(sample.end_ns_ - sample.start_ns_) / 1.0e6;
+            ++total.calls_;
+            total.allocations_ += sample.allocations_;
+            names.try_emplace(sample.name_, sample.name_);
+        }
+        for (const auto& [name, total] : frame_totals) {
+            auto& acc = accumulators[name];
+            acc.frame_ms_.push_back(total.ms_);
+            if (is_last) {
+                acc.last_ms_ = total.ms_;
+                acc.last_calls_ = total.calls_;
+                acc.last_allocations_ = total.allocations_;
+            }
+        }
+    }
+
+    std::vector<ProfileScopeStats> result;
+    result.reserve(accumulators.size());
+    for (auto& [name, acc] : accumulators) {
+        ProfileScopeStats stats;
+        stats.name_ = names[name];
+        stats.last_ms_ = acc.last_ms_;
+        stats.calls_ = acc.last_calls_;
+        stats.allocations_ = acc.last_allocations_;
+        stats.p50_ms_ = percentile(acc.frame_ms_, 0.50);
+        stats.p99_ms_ = percentile(acc.frame_ms_, 0.99);
+        result.push_back(stats);
+    }
+    std::sort(result.begin(), result.end(), [](const ProfileScopeStats& a, const ProfileScopeStats& b) {
+        return a.last_ms_ > b.last_ms_;
+    });
+    return result;
+}
+
+bool Profiler::exportChromeTrace(const std::string& path, std::size_t frame_count) const {
+    const std::size_t count = frame_count == 0 ? history_.size() : std::min(frame_count, history_.size());
+    const std::size_t first = history_.size() - count;
+
+    nlohmann::json events = nlohmann::json::array();
+    for (std::size_t i = first; i < history_.size(); ++i) {
+        const auto& frame = history_[i];
+        events.push_back({
+            {"name", "Frame " + std::to_string(frame.frame_index_)},
+            {"cat", "frame"},
+            {"ph", "X"},
+            {"ts", static_cast<double>(frame.start_ns_) / 1000.0},
+            {"dur", static_cast<double>(frame.end_ns_ - frame.start_ns_) / 1000.0},
+            {"pid", 1},
+            {"tid", 0},
+            {"args", {{"allocations", frame.allocations_}, {"allocated_bytes", frame.allocated_bytes_}}},
+        });
+        for (const auto& sample : frame.samples_) {
+            events.push_back({
+                {"name", sample.name_},
+                {"cat", "scope"},
+                {"ph", "X"},
+                {"ts", static_cast<double>(sample.start_ns_) / 1000.0},
+                {"dur", static_cast<double>(sample.end_ns_ - sample.start_ns_) / 1000.0},
+                {"pid", 1},
+                {"tid", sample.thread_id_},
+                {"args", {{"allocations", sample.allocations_}}},
+            });
+        }
+        for (const auto& [name, value] : frame.counters_) {
+            events.push_back({
+                {"name", name},
+                {"ph", "C"},
+                {"ts", static_cast<double>(frame.end_ns_) / 1000.0},
+                {"pid", 1},
+                {"args", {{"value", value}}},
+            });
+        }
+    }
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        spdlog::error("无法写入性能数据文件: {}", path);
+        return false;
+    }
+    file << nlohmann::json{{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}}.dump();
+    spdlog::info("已导出 {} 帧性能数据到 {}", count, path);
+    return true;
+}
+
+// --- ProfileScope ---
+
+ProfileScope::ProfileScope(const char* name) : name_(name) {
+    if (t_suppressed) {
+        return;
+    }
+    auto& profiler = Profiler::instance();
+    if (!profiler.isEnabled()) {
+        return;
+    }
+    active_ = true;
+    depth_ = t_depth++;
+    start_allocations_ = engine::memory::threadAllocations().count_;
+    start_ns_ = profiler.nowNs();
+}
+
+ProfileScope::~ProfileScope() {
+    if (!active_) {
+        return;
+    }
+    auto& profiler = Profiler::instance();
+    const std::uint64_t end_ns = profiler.nowNs();
+    // 在首次注册线程缓冲区（会分配）之前取计数
+    const auto allocations = static_cast<std::uint32_t>(engine::memory::threadAllocations().count_ - start_allocations_);
+    --t_depth;
+    auto& buffer = profiler.threadBuffer();
+    buffer.push(ProfileSample{ name_, start_ns_, end_ns, depth_, buffer.getThreadId(), allocations });
+}
+
+} // namespace engine::utils
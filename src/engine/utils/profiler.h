@@ -0,0 +1,266 @@
+#pragma once
+/**
+ * @file profiler.h
+ * @brief 轻量级逐帧性能分析器：作用域计时、逐线程无锁环形缓冲与 Chrome trace 导出。
+ *
+ * @details
+ * 用法：
+ * @code
+ * void GameScene::update(float dt) {
+ *     ENGINE_PROFILE_SCOPE("SetTargetSystem");
+ *     ...
+ * }
+ * @endcode
+ *
+ * 计时数据写入当前线程的单生产者/单消费者环形缓冲区，热路径上没有锁；
+ * 主线程在 endFrame() 时统一取出并归档为一帧 FrameCapture，保留最近若干帧用于
+ * 火焰图、分位数统计与导出。定义 ENGINE_PROFILE_ENABLED=0 可在编译期移除全部计时代码。
+ *
+ * 以 CMake 选项 MONSTERWAR_TRACY=ON 构建时，同一批宏同时转发给 Tracy：作用域成为 Tracy zone，
+ * 计数器成为 Tracy plot，ENGINE_PROFILE_FRAME_MARK 标记帧边界，ENGINE_PROFILE_THREAD_NAME 命名线程；
+ * 全局 operator new/delete 由 memory/allocation_hooks.cpp 接入 Tracy 的内存分析。未开启时这些转发全部编译为空。
+ * 作用域与计数器名字必须是静态生命周期字符串（Tracy zone 名直接作为字面量使用）。
+ *
+ * 每个作用域与每帧还记录期间经 operator new 的分配次数（见 memory/allocation_counter.h）：
+ * 作用域为所在线程的计数（含嵌套作用域），帧为主线程从 beginFrame() 到 endFrame() 的计数。
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifndef ENGINE_PROFILE_ENABLED
+#define ENGINE_PROFILE_ENABLED 1
+#endif
+
+#ifndef MONSTERWAR_TRACY
+#define MONSTERWAR_TRACY 0
+#endif
+
+#if MONSTERWAR_TRACY
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace engine::utils {
+
+/**
+ * @brief 单条作用域计时记录
+ */
+struct ProfileSample {
+    const char* name_{nullptr};     ///< 作用域名称（必须是静态生命周期字符串）
+    std::uint64_t start_ns_{0};     ///< 开始时间（相对分析器启动，纳秒）
+    std::uint64_t end_ns_{0};       ///< 结束时间（相对分析器启动，纳秒）
+    std::uint32_t depth_{0};        ///< 嵌套深度（0 为最外层）
+    std::uint32_t thread_id_{0};    ///< 记录所在线程的分析器编号
+    std::uint32_t allocations_{0};  ///< 作用域内（含嵌套作用域）的分配次数
+};
+
+/**
+ * @brief 一帧的归档数据
+ */
+struct FrameCapture {
+    std::uint64_t frame_index_{0};
+    std::uint64_t start_ns_{0};
+    std::uint64_t end_ns_{0};
+    std::vector<ProfileSample> samples_;                         ///< 本帧所有作用域记录（按开始时间排序）
+    std::vector<std::pair<const char*, std::int64_t>> counters_; ///< 本帧计数器（如实体数量）
+    std::uint64_t allocations_{0};                               ///< 主线程本帧的分配次数
+    std::uint64_t allocated_bytes_{0};                           ///< 主线程本帧请求的字节数
+
+    [[nodiscard]] double durationMs() const { return static_cast<double>(end_ns_ - start_ns_) / 1.0e6; }
+};
+
+/**
+ * @brief 按作用域名称汇总的统计结果
+ */
+struct ProfileScopeStats {
+    const char* name_{nullptr};
+    double last_ms_{0.0};       ///< 最近一帧的累计耗时
+    double p50_ms_{0.0};        ///< 历史帧耗时中位数
+    double p99_ms_{0.0};        ///< 历史帧耗时 99 分位
+    std::uint32_t calls_{0};    ///< 最近一帧的调用次数
+    std::uint32_t allocations_{0};  ///< 最近一帧的分配次数（各次调用之和）
+};
+
+/**
+ * @brief 单生产者/单消费者无锁环形缓冲区
+ *
+ * @details
+ * 生产者为记录计时的线程，消费者为调用 endFrame() 的主线程。缓冲区写满时丢弃新记录并计数，
+ * 不会阻塞生产者。
+ */
+class ProfileRingBuffer final {
+public:
+    static constexpr std::size_t CAPACITY = 1u << 13;   ///< 容量（必须为 2 的幂）
+
+    explicit ProfileRingBuffer(std::uint32_t thread_id) : thread_id_(thread_id) {}
+
+    /// @brief 生产者写入一条记录，缓冲区已满时返回 false
+    bool push(const ProfileSample& sample);
+
+    /// @brief 消费者取出全部记录并追加到 out
+    void drain(std::vector<ProfileSample>& out);
+
+    [[nodiscard]] std::uint32_t getThreadId() const { return thread_id_; }
+    [[nodiscard]] std::uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    std::array<ProfileSample, CAPACITY> samples_{};
+    alignas(64) std::atomic<std::size_t> head_{0};   ///< 下一次写入位置（生产者持有）
+    alignas(64) std::atomic<std::size_t> tail_{0};   ///< 下一次读取位置（消费者持有）
+    std::atomic<std::uint64_t> dropped_{0};
+    std::uint32_t thread_id_{0};
+};
+
+/**
+ * @class Profiler
+ * @brief 全局性能分析器，负责帧边界、历史帧管理与统计
+ */
+class Profiler final {
+public:
+    static constexpr std::size_t DEFAULT_HISTORY_SIZE = 240;    ///< 默认保留的历史帧数
+
+    static Profiler& instance();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /// @brief 标记一帧开始（主线程调用）
+    void beginFrame();
+    /// @brief 标记一帧结束，取出所有线程的记录并归档（主线程调用）
+    void endFrame();
+
+    /// @brief 记录本帧计数器（同名计数器以最后一次为准）
+    void setCounter(const char* name, std::int64_t value);
+
+    /**
+     * @brief 把运行时拼出的名字驻留为进程内常驻字符串，供 setCounter 等只保存指针的接口使用
+     * @details 历史帧只保存名字指针，场景销毁后面板仍会读取，因此驻留的字符串永不释放；同名返回同一指针。
+     */
+    const char* internName(std::string_view name);
+
+    /**
+     * @brief 当前线程是否屏蔽分析器（计时与计数器都不记录）
+     * @details 批量模拟的工作线程不属于任何一帧，也不能并发写主线程的计数器表，运行期间屏蔽。
+     */
+    static void setThreadSuppressed(bool suppressed);
+    [[nodiscard]] static bool isThreadSuppressed();
+
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    [[nodiscard]] bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /// @brief 暂停归档，面板可停留在当前历史上查看
+    void setCapturePaused(bool paused) { capture_paused_ = paused; }
+    [[nodiscard]] bool isCapturePaused() const { return capture_paused_; }
+
+    void setHistorySize(std::size_t size);
+    [[nodiscard]] const std::deque<FrameCapture>& getHistory() const { return history_; }
+
+    /**
+     * @brief 统计历史帧中每个作用域的耗时分布
+     * @return 按最近一帧耗时从高到低排序的统计
+     */
+    [[nodiscard]] std::vector<ProfileScopeStats> computeScopeStats() const;
+
+    /**
+     * @brief 将最近 frame_count 帧导出为 Chrome trace JSON（chrome://tracing / Perfetto 可读）
+     * @param path 输出文件路径
+     * @param frame_count 导出帧数，0 表示全部历史
+     * @return 写入成功返回 true
+     */
+    bool exportChromeTrace(const std::string& path, std::size_t frame_count = 0) const;
+
+    /// @brief 当前时间（相对分析器启动，纳秒）
+    [[nodiscard]] std::uint64_t nowNs() const;
+
+    /// @brief 当前线程的环形缓冲区（首次调用时注册）
+    ProfileRingBuffer& threadBuffer();
+
+    [[nodiscard]] std::uint64_t getDroppedCount() const;
+
+private:
+    Profiler();
+
+    std::atomic<bool> enabled_{true};
+    bool capture_paused_{false};
+    std::int64_t epoch_ns_{0};
+
+    mutable std::mutex buffers_mutex_;                          ///< 仅保护线程注册，不在计时热路径上
+    std::vector<std::unique_ptr<ProfileRingBuffer>> buffers_;
+
+    std::uint64_t frame_index_{0};
+    std::uint64_t frame_start_ns_{0};
+    std::uint64_t frame_start_allocations_{0};
+    std::uint64_t frame_start_bytes_{0};
+    std::mutex counters_mutex_;                                 ///< 调度器并行阶段中的系统也会设置计数器
+    std::vector<std::pair<const char*, std::int64_t>> frame_counters_;
+    std::mutex names_mutex_;
+    std::deque<std::string> interned_names_;                    ///< deque 扩容不移动已有元素，指针长期有效
+    std::deque<FrameCapture> history_;
+    std::size_t history_size_{DEFAULT_HISTORY_SIZE};
+};
+
+/**
+ * @brief RAII 作用域计时器，构造时记录开始时间，析构时写入线程缓冲区
+ */
+class ProfileScope final {
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;
+    std::uint64_t start_ns_{0};
+    std::uint64_t start_allocations_{0};
+    std::uint32_t depth_{0};
+    bool active_{false};
+};
+
+} // namespace engine::utils
+
+#define ENGINE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_INNER(a, b)
+
+#if MONSTERWAR_TRACY
+#define ENGINE_PROFILE_TRACY_ZONE(name) ZoneScopedN(name)
+#define ENGINE_PROFILE_TRACY_ZONE_INTERNED(name) ZoneTransientN(ENGINE_PROFILE_CONCAT(engine_tracy_zone_, __LINE__), name, true)
+#define ENGINE_PROFILE_TRACY_PLOT(name, value) TracyPlot(name, static_cast<std::int64_t>(value))
+#define ENGINE_PROFILE_FRAME_MARK() FrameMark
+#define ENGINE_PROFILE_THREAD_NAME(name) ::tracy::SetThreadName(name)
+#else
+#define ENGINE_PROFILE_TRACY_ZONE(name) static_cast<void>(0)
+#define ENGINE_PROFILE_TRACY_ZONE_INTERNED(name) static_cast<void>(0)
+#define ENGINE_PROFILE_TRACY_PLOT(name, value) static_cast<void>(0)
+#define ENGINE_PROFILE_FRAME_MARK() static_cast<void>(0)
+#define ENGINE_PROFILE_THREAD_NAME(name) static_cast<void>(0)
+#endif
+
+#if ENGINE_PROFILE_ENABLED
+#define ENGINE_PROFILE_SCOPE(name) \
+    ENGINE_PROFILE_TRACY_ZONE(name); \
+    ::engine::utils::ProfileScope ENGINE_PROFILE_CONCAT(engine_profile_scope_, __LINE__)(name)
+/// 运行时拼出的作用域名（须经 Profiler::internName 驻留）；Tracy 按临时 zone 记录
+#define ENGINE_PROFILE_SCOPE_INTERNED(name) \
+    ENGINE_PROFILE_TRACY_ZONE_INTERNED(name); \
+    ::engine::utils::ProfileScope ENGINE_PROFILE_CONCAT(engine_profile_scope_, __LINE__)(name)
+#define ENGINE_PROFILE_COUNTER(name, value) \
+    do { \
+        ENGINE_PROFILE_TRACY_PLOT(name, value); \
+        ::engine::utils::Profiler::instance().setCounter(name, value); \
+    } while (0)
+#else
+#define ENGINE_PROFILE_SCOPE(name) ENGINE_PROFILE_TRACY_ZONE(name)
+#define ENGINE_PROFILE_SCOPE_INTERNED(name) ENGINE_PROFILE_TRACY_ZONE_INTERNED(name)
+#define ENGINE_PROFILE_COUNTER(name, value) ENGINE_PROFILE_TRACY_PLOT(name, value)
+#endif
@@ -0,0 +1,170 @@
+#pragma once
+/**
+ * @file random.h
+ * @brief 可设定种子、跨平台确定的快速随机数：xoshiro128** 生成器与按系统分流的随机数服务。
+ *
+ * @details
+ * std::mt19937 状态 2.5KB，且 std::uniform_int_distribution 的算法由标准库实现决定，
+ * 同一种子在 MSVC / libstdc++ / libc++ 上得到的序列并不相同，回放与无头平衡模拟无法复现。
+ * 这里的生成器只用整数运算：
+ * - Xoshiro128：16 字节状态，每次 next() 为几次移位与异或，种子经 splitmix64 展开
+ * - range() 使用 Lemire 的乘法取区间（带拒绝采样，无偏），不依赖标准库分布
+ *
+ * RandomService 存放在 registry.ctx() 中，每个系统按名字取自己的流（stream("follow_path"_hs)）。
+ * 每条流的种子由主种子与流 ID 混合得到、与取用顺序无关，某个系统多用或少用随机数不会扰动其它系统。
+ *
+ * @code
+ * registry.ctx().emplace<engine::utils::RandomService>(level_config.getSeed());
+ * auto& rng = registry.ctx().get<engine::utils::RandomService>().stream("follow_path"_hs);
+ * const int branch = rng.range(0, branch_count - 1);
+ * rng.fillUniform(jitter);     // 批量生成 [0, 1) 浮点数
+ * @endcode
+ */
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <entt/core/fwd.hpp>
+#include "id_map.h"
+
+namespace engine::utils {
+
+/// @brief splitmix64 的一步：用于展开种子与混合流 ID
+constexpr std::uint64_t splitMix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @class Xoshiro128
+ * @brief xoshiro128** 生成器（32 位输出，周期 2^128 - 1）
+ */
+class Xoshiro128 final {
+public:
+    using State = std::array<std::uint32_t, 4>;
+
+    constexpr explicit Xoshiro128(std::uint64_t seed = 0) { reseed(seed); }
+
+    constexpr void reseed(std::uint64_t seed) {
+        std::uint64_t mix = seed;
+        const std::uint64_t a = splitMix64(mix);
+        const std::uint64_t b = splitMix64(mix);
+        state_ = { static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(a >> 32),
+                   static_cast<std::uint32_t>(b), static_cast<std::uint32_t>(b >> 32) };
+        if ((state_[0] | state_[1] | state_[2] | state_[3]) == 0) {
+            state_[0] = 1;  // 全零是唯一的不动点
+        }
+    }
+
+    /// @brief 下一个 32 位随机数
+    constexpr std::uint32_t next() {
+        const std::uint32_t result = rotl(state_[1] * 5u, 7) * 9u;
+        const std::uint32_t t = state_[1] << 9;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 11);
+        return result;
+    }
+
+    /// @brief [0, bound) 内的均匀整数（bound 为 0 时返回 0）
+    constexpr std::uint32_t below(std::uint32_t bound) {
+        if (bound == 0) {
+            return 0;
+        }
+        std::uint64_t product = static_cast<std::uint64_t>(next()) * bound;
+        auto low = static_cast<std::uint32_t>(product);
+        if (low < bound) {
+            // 拒绝落在不完整区间内的结果，保证无偏（绝大多数调用不进入此分支）
+            const std::uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = static_cast<std::uint64_t>(next()) * bound;
+                low = static_cast<std::uint32_t>(product);
+            }
+        }
+        return static_cast<std::uint32_t>(product >> 32);
+    }
+
+    /// @brief [min, max] 内的均匀整数（min > max 时返回 min）
+    constexpr int range(int min, int max) {
+        if (max <= min) {
+            return min;
+        }
+        const auto span = static_cast<std::uint32_t>(static_cast<std::int64_t>(max) - min) + 1u;
+        return static_cast<int>(static_cast<std::int64_t>(min) + (span == 0 ? next() : below(span)));
+    }
+
+    /// @brief [0, 1) 内的均匀浮点数（24 位精度）
+    constexpr float uniform() { return static_cast<float>(next() >> 8) * 0x1.0p-24f; }
+
+    /// @brief [min, max) 内的均匀浮点数
+    constexpr float uniform(float min, float max) { return min + (max - min) * uniform(); }
+
+    void fill(std::span<std::uint32_t> out) {
+        for (auto& value : out) {
+            value = next();
+        }
+    }
+
+    void fillRange(std::span<int> out, int min, int max) {
+        for (auto& value : out) {
+            value = range(min, max);
+        }
+    }
+
+    void fillUniform(std::span<float> out) {
+        for (auto& value : out) {
+            value = uniform();
+        }
+    }
+
+    [[nodiscard]] constexpr const State& getState() const { return state_; }
+    constexpr void setState(const State& state) { state_ = state; }
+
+private:
+    static constexpr std::uint32_t rotl(std::uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    State state_{};
+};
+
+/**
+ * @class RandomService
+ * @brief 以主种子派生各系统独立随机数流的服务（放在 registry.ctx() 中，仅主线程使用）
+ */
+class RandomService final {
+public:
+    explicit RandomService(std::uint64_t seed = 0) : seed_(seed) {}
+
+    /// @brief 更换主种子，已创建的流按新种子重置
+    void reseed(std::uint64_t seed) {
+        seed_ = seed;
+        for (auto& [id, stream] : streams_) {
+            stream.reseed(streamSeed(id));
+        }
+    }
+
+    [[nodiscard]] std::uint64_t getSeed() const { return seed_; }
+
+    /// @brief 取（不存在时创建）某个系统的随机数流；返回的引用在创建新流后可能失效，不要跨帧持有
+    Xoshiro128& stream(entt::id_type id) {
+        if (auto it = streams_.find(id); it != streams_.end()) {
+            return it->second;
+        }
+        return streams_.emplace(id, Xoshiro128{ streamSeed(id) }).first->second;
+    }
+
+private:
+    [[nodiscard]] std::uint64_t streamSeed(entt::id_type id) const {
+        std::uint64_t mix = seed_ ^ (static_cast<std::uint64_t>(id) << 32 | id);
+        return splitMix64(mix);
+    }
+
+    std::uint64_t seed_;
+    IdMap<Xoshiro128> streams_;
+};
+
+} // namespace engine::utils
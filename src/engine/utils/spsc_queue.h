@@ -0,0 +1,86 @@
+#pragma once
+/**
+ * @file spsc_queue.h
+ * @brief 固定容量的单生产者/单消费者无锁队列。
+ *
+ * @details
+ * 与 ProfileRingBuffer 相同的环形缓冲写法：生产者只写 head_，消费者只写 tail_，
+ * 元素数组与两个索引各自独占缓存行。队列满时 tryPush 返回 false，由调用方决定丢弃还是重试，永不阻塞。
+ * 多个生产者时使用 MpscQueue（mpsc_queue.h）。
+ *
+ * @code
+ * engine::utils::SpscQueue<Command, 1024> queue;
+ * queue.tryPush(Command{ ... });          // 生产者线程
+ * queue.drain([](const Command& c) { });  // 消费者线程
+ * @endcode
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace engine::utils {
+
+/// @brief 假定的缓存行大小；无锁队列的生产端与消费端索引按此对齐，避免伪共享
+inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+template <typename T, std::size_t Capacity>
+class SpscQueue final {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue 容量必须为 2 的幂");
+    static_assert(std::is_trivially_copyable_v<T>, "SpscQueue 只存放可平凡拷贝的小命令");
+
+public:
+    static constexpr std::size_t CAPACITY = Capacity;
+
+    /// @brief 生产者写入一个元素，队列已满时返回 false
+    bool tryPush(const T& value) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        if (head - tail >= Capacity) {
+            return false;
+        }
+        items_[head & (Capacity - 1)] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief 消费者取出一个元素，队列为空时返回 false
+    bool tryPop(T& out) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        if (tail == head) {
+            return false;
+        }
+        out = items_[tail & (Capacity - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 消费者按顺序处理当前可见的全部元素
+     * @return 处理的元素数
+     */
+    template <typename Fn>
+    std::size_t drain(Fn&& fn) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        for (std::size_t i = tail; i != head; ++i) {
+            fn(items_[i & (Capacity - 1)]);
+        }
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    /// @brief 近似的元素数（任一端调用均可，仅供统计）
+    [[nodiscard]] std::size_t sizeApprox() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::array<T, Capacity> items_{};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_{ 0 };   ///< 下一次写入位置（生产者持有）
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_{ 0 };   ///< 下一次读取位置（消费者持有）
+};
+
+} // namespace engine::utils
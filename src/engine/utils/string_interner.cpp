@@ -0,0 +1,44 @@
+#include "string_interner.h"
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace engine::utils {
+
+namespace {
+
+struct InternTable {
+    std::mutex mutex_;
+    std::deque<std::string> storage_;               ///< deque 追加不移动已有元素，视图保持有效
+    std::unordered_set<std::string_view> index_;    ///< 指向 storage_ 中的字符串
+};
+
+InternTable& table() {
+    static InternTable instance;   // 函数内静态：保证静态初始化期间构造的组件也能驻留
+    return instance;
+}
+
+} // namespace
+
+std::string_view StringInterner::intern(std::string_view value) {
+    if (value.empty()) {
+        return {};
+    }
+    auto& interned = table();
+    std::lock_guard lock(interned.mutex_);
+    if (auto it = interned.index_.find(value); it != interned.index_.end()) {
+        return *it;
+    }
+    const std::string_view stored = interned.storage_.emplace_back(value);
+    interned.index_.insert(stored);
+    return stored;
+}
+
+std::size_t StringInterner::size() {
+    auto& interned = table();
+    std::lock_guard lock(interned.mutex_);
+    return interned.index_.size();
+}
+
+} // namespace engine::utils
@@ -0,0 +1,35 @@
+#pragma once
+/**
+ * @file string_interner.h
+ * @brief 进程级字符串驻留表：资源路径、实体名等重复字符串只保存一份。
+ *
+ * @details
+ * Sprite、NameComponent 等组件只保存哈希 ID 与指向驻留存储的 std::string_view，
+ * 组件本身不再持有堆字符串，可平凡拷贝，渲染循环遍历时缓存更紧凑。
+ *
+ * - 驻留的字符串永不释放，返回的 string_view 在进程生命周期内有效，且以 '\0' 结尾（可只保存 data() 指针）
+ * - 同一内容返回同一段存储；空字符串返回空视图
+ * - 线程安全（资源可能在 JobSystem 工作线程中解析）
+ *
+ * @code
+ * std::string_view path = engine::utils::StringInterner::intern(texture_path);
+ * @endcode
+ */
+
+#include <cstddef>
+#include <string_view>
+
+namespace engine::utils {
+
+class StringInterner final {
+public:
+    StringInterner() = delete;
+
+    /// @brief 驻留字符串，返回进程内常驻的视图
+    static std::string_view intern(std::string_view value);
+
+    /// @brief 已驻留的字符串数（仅供统计）
+    [[nodiscard]] static std::size_t size();
+};
+
+} // namespace engine::utils
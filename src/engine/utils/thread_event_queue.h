@@ -0,0 +1,60 @@
+#pragma once
+/**
+ * @file thread_event_queue.h
+ * @brief 把工作线程产生的事件无锁地送进主线程 entt::dispatcher 事件流的类型化队列。
+ *
+ * @details
+ * 工作线程（存档写入、解码、音频线程等）不能直接调用 dispatcher：它的队列与监听者都只属于主线程。
+ * ThreadEventQueue 在生产端只做一次无锁入队（不加锁、不分配），主线程在 dispatcher.update() 之前调用
+ * dispatch()，把积累的事件 enqueue 到 dispatcher，监听者随后与其他事件一起在主线程上收到。
+ *
+ * - 默认用 MpscQueue，任意多个线程可以 post()；生产者只有一个线程时可换用 SpscQueue
+ * - 事件须可平凡拷贝（ID、计数、状态码），需要字符串时传哈希
+ * - 队列满时 post() 返回 false 并计入 getDroppedCount()，永不阻塞生产者
+ *
+ * @code
+ * engine::utils::ThreadEventQueue<SaveCompletedEvent, 64> completed;
+ * completed.post(SaveCompletedEvent{ ... });  // 写入线程
+ * completed.dispatch(dispatcher);             // 主线程，dispatcher.update() 之前
+ * @endcode
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <entt/signal/dispatcher.hpp>
+#include "mpsc_queue.h"
+
+namespace engine::utils {
+
+template <typename Event, std::size_t Capacity = 256, template <typename, std::size_t> typename Queue = MpscQueue>
+class ThreadEventQueue final {
+public:
+    /// @brief 生产者线程投递一个事件；队列已满时丢弃并返回 false
+    bool post(const Event& event) {
+        if (queue_.tryPush(event)) {
+            return true;
+        }
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * @brief 主线程把已投递的事件转入 dispatcher 的队列，由随后的 dispatcher.update() 派发
+     * @return 转入的事件数
+     */
+    std::size_t dispatch(entt::dispatcher& dispatcher) {
+        return queue_.drain([&dispatcher](const Event& event) { dispatcher.enqueue(event); });
+    }
+
+    /// @brief 近似的待转入事件数（仅供统计）
+    [[nodiscard]] std::size_t sizeApprox() const { return queue_.sizeApprox(); }
+    /// @brief 队列满而丢弃的事件数（累计）
+    [[nodiscard]] std::uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    Queue<Event, Capacity> queue_;
+    std::atomic<std::uint64_t> dropped_{ 0 };
+};
+
+} // namespace engine::utils
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <limits>
+
+namespace game::component {
+
+/**
+ * @struct AttackTimerComponent
+ * @brief 攻击冷却计时（从 StatsComponent 拆出的热数据）
+ *
+ * @details
+ * TimerSystem 每帧推进所有单位的攻击计时，只读写这两个字段；单独存放后组件存储是 8 字节一项的连续数组，
+ * 可以按 8 个一组批量比较，不再连带加载生命、等级等冷数据。
+ *
+ * 计时达到间隔时 TimerSystem 把 timer_ 置为 READY，并让 BehaviorComponent 转移到就绪状态：
+ * 就绪状态保存在计时器本身，批量更新无需逐个查询行为状态，攻击间隔在就绪期间被技能修改也不会重复转移。
+ * AttackStarterSystem 发起攻击时把 timer_ 归零并转移状态，开始下一轮冷却。
+ */
+struct AttackTimerComponent {
+    static constexpr float READY = std::numeric_limits<float>::infinity();  ///< 已就绪、等待发起攻击
+
+    float timer_ = 0.0f;        ///< 攻击计时器（秒），READY 表示已就绪
+    float interval_ = 0.0f;     ///< 攻击间隔（秒）
+
+    [[nodiscard]] bool isReady() const { return timer_ == READY; }
+};
+
+} // namespace game::component
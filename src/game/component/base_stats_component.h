@@ -0,0 +1,22 @@
+#pragma once
+
+namespace game::component {
+
+/**
+ * @brief 受状态效果修正前的基础属性
+ *
+ * @details
+ * StatusEffectSystem 在实体第一次带上属性修正时从 StatsComponent / AttackTimerComponent / EnemyComponent 拍下，
+ * 之后每次重算都以这里为基准：StatsComponent 等组件中保存的是「有效属性」（基础值乘以全部修正），
+ * 其他系统照常只读有效属性。最后一个修正移除时写回基础值并移除本组件。
+ * 升级等永久改动在本组件存在时须改这里并标记脏（见 StatusEffectStore::markDirty）。
+ */
+struct BaseStatsComponent {
+    float atk_ = 0.0f;              ///< 攻击力
+    float def_ = 0.0f;              ///< 防御力
+    float range_ = 0.0f;            ///< 攻击范围
+    float atk_interval_ = 0.0f;     ///< 攻击间隔（秒），没有 AttackTimerComponent 时为 0
+    float speed_ = 0.0f;            ///< 移动速度（像素/秒），非敌人为 0
+};
+
+} // namespace game::component
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace game::component {
+
+/**
+ * @brief 单位攻击循环的状态（BehaviorComponent::state_）
+ *
+ * @details 冷却是否结束与是否处于动作锁定相互独立（攻击间隔短于攻击动画时，动作中即可再次就绪），
+ *          因此两者的组合各占一个状态；状态只经 game::data::BehaviorIndex::transition() 改变。
+ */
+enum class BehaviorState : std::uint8_t {
+    COOLDOWN,       ///< 攻击冷却中
+    READY,          ///< 冷却结束，等待 AttackStarterSystem 发起攻击
+    ACTING,         ///< 攻击动作中（动作锁定：不寻路、不参与分离）
+    ACTING_READY,   ///< 攻击动作中且冷却已结束
+    COUNT
+};
+
+/// @brief 驱动 BehaviorState 转移的事件
+enum class BehaviorEvent : std::uint8_t {
+    COOLDOWN_DONE,  ///< TimerSystem：攻击计时达到间隔
+    ATTACK_LOCKED,  ///< AttackStarterSystem：发起带动作锁定的攻击（敌人）
+    ATTACK_FREE,    ///< AttackStarterSystem：发起不锁定的攻击或治疗（玩家单位）
+    ACTION_END,     ///< AnimationStateSystem / BlockSystem：攻击动画结束、阻挡者死亡放开
+    COUNT
+};
+
+/// @brief BehaviorComponent::flags_ 的位（不参与状态转移，也不进入按状态的列表）
+namespace behavior_flag {
+constexpr std::uint8_t INJURED = 1u << 0;       ///< 玩家单位现有生命值小于最大值，需要治疗
+constexpr std::uint8_t SKILL_READY = 1u << 1;   ///< 英雄技能冷却结束，可以释放
+} // namespace behavior_flag
+
+/**
+ * @brief 转移表：BEHAVIOR_TRANSITIONS[状态][事件] 为下一状态；不适用的事件保持原状态
+ *
+ * | 状态 \\ 事件   | COOLDOWN_DONE | ATTACK_LOCKED | ATTACK_FREE | ACTION_END |
+ * |---------------|---------------|---------------|-------------|------------|
+ * | COOLDOWN      | READY         | COOLDOWN      | COOLDOWN    | COOLDOWN   |
+ * | READY         | READY         | ACTING        | COOLDOWN    | READY      |
+ * | ACTING        | ACTING_READY  | ACTING        | ACTING      | COOLDOWN   |
+ * | ACTING_READY  | ACTING_READY  | ACTING        | ACTING      | READY      |
+ */
+inline constexpr std::array<std::array<BehaviorState, static_cast<std::size_t>(BehaviorEvent::COUNT)>,
+                            static_cast<std::size_t>(BehaviorState::COUNT)> BEHAVIOR_TRANSITIONS{ {
+    { BehaviorState::READY, BehaviorState::COOLDOWN, BehaviorState::COOLDOWN, BehaviorState::COOLDOWN },
+    { BehaviorState::READY, BehaviorState::ACTING, BehaviorState::COOLDOWN, BehaviorState::READY },
+    { BehaviorState::ACTING_READY, BehaviorState::ACTING, BehaviorState::ACTING, BehaviorState::COOLDOWN },
+    { BehaviorState::ACTING_READY, BehaviorState::ACTING, BehaviorState::ACTING, BehaviorState::READY },
+} };
+
+[[nodiscard]] constexpr BehaviorState nextBehaviorState(BehaviorState state, BehaviorEvent event) {
+    return BEHAVIOR_TRANSITIONS[static_cast<std::size_t>(state)][static_cast<std::size_t>(event)];
+}
+
+/**
+ * @brief 单位的行为状态与标志位（敌我单位创建时添加，之后不再增删）
+ *
+ * @details
+ * 取代原先反复添加 / 移除的空标签（AttackReadyTag、ActionLockTag、SkillReadyTag、InjuredTag）：
+ * 每个攻击循环的状态变化只改写这两个字节，不再在标签存储中插入、交换删除，也不会让分组失效。
+ * 需要按状态遍历的系统（AttackStarterSystem 只看就绪的单位）使用 game::data::BehaviorIndex 的按状态列表，
+ * 其余系统在已有的遍历中直接读取状态。
+ */
+struct BehaviorComponent {
+    BehaviorState state_{ BehaviorState::COOLDOWN };
+    std::uint8_t flags_{ 0 };                   ///< behavior_flag 位
+
+    /// @brief 冷却结束（READY 或 ACTING_READY）
+    [[nodiscard]] bool isAttackReady() const {
+        return state_ == BehaviorState::READY || state_ == BehaviorState::ACTING_READY;
+    }
+    /// @brief 动作锁定（ACTING 或 ACTING_READY）
+    [[nodiscard]] bool isActionLocked() const {
+        return state_ == BehaviorState::ACTING || state_ == BehaviorState::ACTING_READY;
+    }
+
+    [[nodiscard]] bool hasFlag(std::uint8_t flag) const { return (flags_ & flag) != 0; }
+    void setFlag(std::uint8_t flag, bool on) {
+        flags_ = static_cast<std::uint8_t>(on ? (flags_ | flag) : (flags_ & ~flag));
+    }
+};
+
+} // namespace game::component
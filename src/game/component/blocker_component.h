@@ -1,11 +1,37 @@
 #pragma once
 
+#include "../defs/constants.h"
+#include <entt/entity/entity.hpp>
+#include <array>
+
 namespace game::component {
 
-/// @brief 阻挡者组件，存储阻挡者最大阻挡数量和当前阻挡数量
+/// @brief 阻挡者组件，存储阻挡者最大阻挡数量、当前阻挡数量与被阻挡的敌人
 struct BlockerComponent {
     int max_count_{};
     int current_count_{};
+    /// @brief 被阻挡的敌人，只有前 current_count_ 个有效（顺序无意义）
+    std::array<entt::entity, game::defs::MAX_BLOCK_COUNT> blocked_{};
+
+    /// @brief 记录一个被阻挡的敌人；阻挡余量已满时返回 false
+    bool add(entt::entity enemy) {
+        if (current_count_ >= max_count_ || current_count_ >= game::defs::MAX_BLOCK_COUNT) {
+            return false;
+        }
+        blocked_[static_cast<std::size_t>(current_count_++)] = enemy;
+        return true;
+    }
+
+    /// @brief 移除一个被阻挡的敌人（末尾元素换到其位置）；不在其中时返回 false
+    bool erase(entt::entity enemy) {
+        for (int i = 0; i < current_count_; ++i) {
+            if (blocked_[static_cast<std::size_t>(i)] == enemy) {
+                blocked_[static_cast<std::size_t>(i)] = blocked_[static_cast<std::size_t>(--current_count_)];
+                return true;
+            }
+        }
+        return false;
+    }
 };
 
-}   // namespace game::component
\ No newline at end of file
+}   // namespace game::component
@@ -18,6 +18,8 @@
 #pragma once
 
 #include <entt/core/hashed_string.hpp>
+#include <cstdint>
+#include <limits>
 
 namespace game::component {
     /**
@@ -28,6 +30,10 @@ namespace game::component {
      * EnemyComponent 存储了敌人实体在路径导航时所需的数据：
      * - target_waypoint_id_：当前目标路径点的ID
      * - speed_：敌人的移动速度（像素/秒）
+     * - path_segment_ / segment_remaining_：当前所在路径段及沿该段到终点的剩余距离
+     * - distance_to_home_：沿路径到基地的剩余距离，由 FollowPathSystem 逐步更新，供 FIRST_ALONG_PATH 索敌策略使用
+     * - threat_：威胁度（每秒攻击力），生成时按等级/稀有度计算，供 HIGHEST_THREAT 索敌策略使用
+     * - spawn_sequence_：生成序号，需要在敌人之间确定先后时使用（实体句柄在实机与无头回放中不同）
      * 
      * 该组件与 FollowPathSystem 配合使用，实现敌人沿着预设路径移动的功能。
      */
@@ -35,5 +41,10 @@ namespace game::component {
         int target_waypoint_id_; ///< 当前目标路径点的ID，用于路径导航
         float speed_; ///< 敌人的移动速度（像素/秒）
         entt::id_type projectile_id_ = entt::null; ///< 远程敌人使用的投射物ID
+        std::uint32_t path_segment_ = std::numeric_limits<std::uint32_t>::max(); ///< 当前路径段下标（PathTable），未进入路径时为最大值
+        float segment_remaining_ = 0.0f; ///< 沿当前路径段方向到段终点的剩余距离
+        float distance_to_home_ = std::numeric_limits<float>::max(); ///< 沿路径到基地的剩余距离，未进入路径时为最大值
+        float threat_ = 0.0f; ///< 威胁度（每秒攻击力）
+        std::uint32_t spawn_sequence_ = 0; ///< 生成序号（EntityFactory 按生成顺序分配，实机与回放一致）
     };
 }
@@ -1,27 +1,25 @@
 #pragma once
 
+#include <cstdint>
 #include <entt/core/hashed_string.hpp>
 
 namespace game::component {
 
+/**
+ * @brief 英雄技能状态
+ *
+ * 冷却与持续时间不逐帧递减：释放时在模拟计时器（engine::core::TimerWheel）上登记到期步，
+ * 这里只记下到期步，用于剩余时间显示与判断冷却；到期事件由 TimerSystem 产生。
+ * 主动技能的属性倍率作为状态效果（效果ID 即 skill_id_）施加，由 StatusEffectSystem 汇总到属性组件。
+ */
 struct HeroSkillComponent {
     entt::id_type skill_id_{ entt::null };
     float cooldown_{ 0.0f };
-    float cooldown_timer_{ 0.0f };
+    std::uint64_t cooldown_end_tick_{ 0 };      ///< 冷却结束的计时器步，不晚于当前步即已冷却
     float duration_{ 0.0f };
-    float duration_timer_{ 0.0f };
+    std::uint64_t duration_end_tick_{ 0 };      ///< 持续结束的计时器步（active_ 时有效）
     bool passive_{ false };
     bool active_{ false };
-    float atk_multiplier_{ 1.0f };
-    float def_multiplier_{ 1.0f };
-    float range_multiplier_{ 1.0f };
-    float atk_interval_multiplier_{ 1.0f };
-    float base_hp_{ 0.0f };
-    float base_max_hp_{ 0.0f };
-    float base_atk_{ 0.0f };
-    float base_def_{ 0.0f };
-    float base_range_{ 0.0f };
-    float base_atk_interval_{ 0.0f };
 };
 
 } // namespace game::component
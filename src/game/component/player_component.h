@@ -1,6 +1,8 @@
 #pragma once
 
 #include <entt/core/hashed_string.hpp>
+#include <cstdint>
+#include "../defs/constants.h"
 
 namespace game::component {
 /**
@@ -10,5 +12,10 @@ namespace game::component {
 struct PlayerComponent {
     int cost_;
     entt::id_type projectile_id_ = entt::null;
+    game::defs::TargetPolicy target_policy_ = game::defs::TargetPolicy::CLOSEST;   ///< 索敌策略
+    game::defs::AreaShape area_shape_ = game::defs::AreaShape::NONE;               ///< 范围攻击形状，NONE 为单体
+    float area_radius_ = 0.0f;                                                     ///< 范围半径
+    float area_cos_half_angle_ = 1.0f;                                             ///< 扇形半张角的余弦
+    std::uint32_t spawn_sequence_ = 0;                                             ///< 生成序号（与 EnemyComponent 共用 EntityFactory 的计数）
 };
 }
\ No newline at end of file
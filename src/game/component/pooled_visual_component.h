@@ -0,0 +1,25 @@
+#pragma once
+
+#include <entt/core/fwd.hpp>
+#include <cstdint>
+
+namespace game::component {
+
+/**
+ * @brief 池化视觉实体的类别
+ */
+enum class VisualKind : std::uint8_t {
+    PROJECTILE,     ///< 投射物（projectile_data.json）
+    EFFECT          ///< 特效（effect_data.json）
+};
+
+/**
+ * @struct PooledVisualComponent
+ * @brief 记录视觉实体所属的对象池，停用时据此归还到对应空闲列表
+ */
+struct PooledVisualComponent {
+    VisualKind kind_{ VisualKind::EFFECT };
+    entt::id_type visual_id_{ 0 };  ///< projectile_id 或 effect_id
+};
+
+} // namespace game::component
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <entt/core/hashed_string.hpp>
+#include "../defs/ids.h"
 #include <glm/vec2.hpp>
 
 namespace game::component {
@@ -12,7 +12,7 @@ struct ProjectileVisualComponent {
     float flight_time_{ 0.5f };
     float elapsed_time_{ 0.0f };
     float rotation_offset_deg_{ 0.0f };
-    entt::id_type effect_id_{ entt::hashed_string("skill_active") };
+    entt::id_type effect_id_{ game::ids::hashOf(game::ids::Effect::SKILL_ACTIVE) };
 };
 
 } // namespace game::component
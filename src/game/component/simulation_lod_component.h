@@ -0,0 +1,16 @@
+#pragma once
+
+namespace game::component {
+
+/**
+ * @brief 低细节模拟状态（只存在于带 LowDetailTag 的敌人上）
+ *
+ * @details FollowPathSystem 在到达路径段终点之前可以整段跳过：路径段与速度在此期间都不变，
+ *          位置由 MovementSystem 照常推进，跳过的步数按剩余距离与速度解析地算出。
+ */
+struct SimulationLodComponent {
+    unsigned path_skip_ticks_{0};   ///< FollowPathSystem 还可以跳过的步数
+    float speed_{0.0f};             ///< 计算跳过步数时的速度，速度变化时立即重新检查
+};
+
+}   // namespace game::component
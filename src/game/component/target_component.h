@@ -1,6 +1,7 @@
 #pragma once
 
 #include <entt/entt.hpp>
+#include <glm/vec2.hpp>
 namespace game::component {
     /**
      * @struct TargetComponent
@@ -12,6 +13,9 @@ namespace game::component {
      *
      * @par 数据成员
      * - entity_: 锁定的目标实体的 ID。如果为 entt::null，表示当前没有目标。
+     *   SetTargetSystem 在目标死亡（DeadTag）或失去 TransformComponent 时立即将其置空，
+     *   因此非空的 entity_ 总是指向带 TransformComponent 的存活实体。
+     * - self_anchor_ / target_anchor_ / slack_sq_: 射程校验的迟滞状态，见 SetTargetSystem。
      *
      * @par 设计初衷
      * - 解耦搜索和动作：搜索系统（如 SetTargetSystem）负责寻找目标并添加此组件，
@@ -20,5 +24,8 @@ namespace game::component {
      */
     struct TargetComponent {
         entt::entity entity_{ entt::null }; ///< 锁定的目标实体
+        glm::vec2 self_anchor_{ 0.0f };     ///< 上次射程校验时自身的位置
+        glm::vec2 target_anchor_{ 0.0f };   ///< 上次射程校验时目标的位置
+        float slack_sq_{ -1.0f };           ///< 双方各自允许的位移平方，负数表示尚未校验
     };
 };// namespace game::component
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <entt/entity/registry.hpp>
+#include <cstddef>
+
+namespace game::data {
+
+/**
+ * @brief 由注册表信号维护的组件计数：Component 构造时加一、销毁时减一
+ *
+ * @details 替代每步 registry.view<Component>().size() 的查询（如波次清空检测），计数只在实体增减时变化。
+ *          回退检查点等整体替换注册表内容的操作之后调用 recount() 与注册表重新对齐。
+ *          连接期间对象地址不能改变。
+ */
+template <typename Component>
+class AliveCounter final {
+public:
+    void connect(entt::registry& registry) {
+        registry.on_construct<Component>().template connect<&AliveCounter::onConstruct>(*this);
+        registry.on_destroy<Component>().template connect<&AliveCounter::onDestroy>(*this);
+        recount(registry);
+    }
+
+    void disconnect(entt::registry& registry) {
+        registry.on_construct<Component>().disconnect(*this);
+        registry.on_destroy<Component>().disconnect(*this);
+    }
+
+    /// @brief 按注册表当前内容重新计数
+    void recount(const entt::registry& registry) {
+        const auto* storage = registry.storage<Component>();
+        count_ = storage ? storage->size() : 0;
+    }
+
+    [[nodiscard]] std::size_t get() const { return count_; }
+
+private:
+    void onConstruct(entt::registry&, entt::entity) { ++count_; }
+    void onDestroy(entt::registry&, entt::entity) {
+        if (count_ > 0) {
+            --count_;
+        }
+    }
+
+    std::size_t count_ = 0;
+};
+
+} // namespace game::data
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../component/attack_timer_component.h"
+#include "../component/base_stats_component.h"
+#include "../component/behavior_component.h"
+#include "../component/blocked_by_component.h"
+#include "../component/blocker_component.h"
+#include "../component/class_name_component.h"
+#include "../component/enemy_component.h"
+#include "../component/hero_skill_component.h"
+#include "../component/place_occupied_component.h"
+#include "../component/player_component.h"
+#include "../component/pooled_visual_component.h"
+#include "../component/projectile_visual_component.h"
+#include "../component/simulation_lod_component.h"
+#include "../component/stats_component.h"
+#include "../component/target_component.h"
+#include "../component/unit_prep_component.h"
+#include "../defs/tags.h"
+#include "../../engine/component/animation_component.h"
+#include "../../engine/component/animation_request_component.h"
+#include "../../engine/component/audio_component.h"
+#include "../../engine/component/disabled_tag.h"
+#include "../../engine/component/lod_icon_component.h"
+#include "../../engine/component/low_detail_tag.h"
+#include "../../engine/component/name_component.h"
+#include "../../engine/component/parallax_component.h"
+#include "../../engine/component/previous_transform_component.h"
+#include "../../engine/component/render_component.h"
+#include "../../engine/component/sheet_animation_component.h"
+#include "../../engine/component/sprite_component.h"
+#include "../../engine/component/tile_animation_component.h"
+#include "../../engine/component/tilelayer_component.h"
+#include "../../engine/component/transform_component.h"
+#include "../../engine/component/velocity_component.h"
+#include "../../engine/ecs/registry_snapshot.h"
+
+namespace game::data {
+
+/**
+ * @brief GameScene 注册表的完整内存快照（重开关卡、重试波次与调试回退使用）
+ *
+ * @details
+ * 列表须覆盖场景中出现的所有组件类型；新增组件时同步加入，否则恢复后该组件丢失
+ * （GameScene 在拍快照时用 findUncovered() 检查并告警）。
+ * 带 PooledVisualComponent 的停用实体由 VisualPool 监听 DisabledTag 回收，PooledVisualComponent 须排在 DisabledTag 之前。
+ */
+using BattleRegistrySnapshot = engine::ecs::RegistrySnapshot<
+    engine::component::TransformComponent,
+    engine::component::PreviousTransformComponent,
+    engine::component::VelocityComponent,
+    engine::component::SpriteComponent,
+    engine::component::RenderComponent,
+    engine::component::AnimationComponent,
+    engine::component::AnimationRequestComponent,
+    engine::component::AudioComponent,
+    engine::component::NameComponent,
+    engine::component::ParallaxComponent,
+    engine::component::TileLayerComponent,
+    engine::component::TileAnimationComponent,
+    engine::component::SheetAnimationComponent,
+    engine::component::LodIconComponent,
+    game::component::AttackTimerComponent,
+    game::component::BaseStatsComponent,
+    game::component::BehaviorComponent,
+    game::component::BlockedByComponent,
+    game::component::BlockerComponent,
+    game::component::ClassNameComponent,
+    game::component::EnemyComponent,
+    game::component::HeroSkillComponent,
+    game::component::PlaceOccupiedComponent,
+    game::component::PlayerComponent,
+    game::component::PooledVisualComponent,
+    game::component::ProjectileVisualComponent,
+    game::component::SimulationLodComponent,
+    game::component::StatsComponent,
+    game::component::TargetComponent,
+    game::component::UnitPrepComponent,
+    game::defs::DeadTag,
+    game::defs::FaceLeftTag,
+    game::defs::MeleeUnitTag,
+    game::defs::RangedUnitTag,
+    game::defs::HealerTag,
+    game::defs::SkillActiveTag,
+    game::defs::PassiveSkillTag,
+    game::defs::OrientableTag,
+    game::defs::MeleePlaceTag,
+    game::defs::RangePlaceTag,
+    game::defs::ShowRangeTag,
+    game::defs::VisualEffectTag,
+    engine::component::LowDetailTag,
+    engine::component::DisabledTag>;
+
+} // namespace game::data
@@ -0,0 +1,72 @@
+#include "battle_compaction.h"
+#include "battle_checkpoint.h"
+#include "../../engine/ecs/storage_compaction.h"
+#include "../../engine/memory/memory_tracker.h"
+#include "../../engine/utils/logging.h"
+#include "../../engine/utils/profiler.h"
+#include <entt/entity/registry.hpp>
+#include <cstdint>
+#include <limits>
+
+namespace game::data {
+
+namespace {
+
+/// @brief 重排键：单位取生成序号（实机与回放一致），其他实体（特效、投射物等）排在单位之后并保持原有顺序
+std::uint64_t spawnOrderKey(const entt::registry& registry, entt::entity entity) {
+    if (const auto* enemy = registry.try_get<game::component::EnemyComponent>(entity)) {
+        return enemy->spawn_sequence_;
+    }
+    if (const auto* player = registry.try_get<game::component::PlayerComponent>(entity)) {
+        return player->spawn_sequence_;
+    }
+    return std::numeric_limits<std::uint64_t>::max();
+}
+
+} // namespace
+
+BattleCompaction compactBattleStorages(entt::registry& registry, std::size_t headroom, bool shrink) {
+    ENGINE_PROFILE_SCOPE("compactBattleStorages");
+    BattleCompaction result;
+    // 单位的非拥有组件与标签；Transform / Sprite / Render / Velocity / Stats 归分组所有，不能在这里排序。
+    // 按生成序号而不是实体下标排序：下标在实机与无头回放中不同，排出的遍历顺序会让 BlockSystem 等依赖顺序的系统分歧
+    result.sorted_ = engine::ecs::sortStoragesByKey<
+        engine::component::PreviousTransformComponent,
+        engine::component::AnimationComponent,
+        engine::component::AnimationRequestComponent,
+        engine::component::AudioComponent,
+        game::component::AttackTimerComponent,
+        game::component::BaseStatsComponent,
+        game::component::BehaviorComponent,
+        game::component::BlockedByComponent,
+        game::component::BlockerComponent,
+        game::component::ClassNameComponent,
+        game::component::EnemyComponent,
+        game::component::PlayerComponent,
+        game::component::SimulationLodComponent,
+        game::component::TargetComponent,
+        game::defs::FaceLeftTag,
+        game::defs::MeleeUnitTag,
+        game::defs::RangedUnitTag,
+        game::defs::HealerTag,
+        game::defs::OrientableTag>(registry, [&registry](entt::entity entity) { return spawnOrderKey(registry, entity); });
+
+    if (shrink) {
+        const auto before = BattleRegistrySnapshot::getStorageBytes(registry);
+        const auto shrunk = engine::ecs::shrinkStorages(registry, headroom);
+        const auto after = BattleRegistrySnapshot::getStorageBytes(registry);
+        result.shrunk_ = shrunk.storages_;
+        result.reclaimed_bytes_ = before > after ? before - after : 0;
+        if (result.reclaimed_bytes_ > 0) {
+            engine::memory::MemoryTracker::instance().addReclaimed(engine::memory::MemoryTag::REGISTRY, result.reclaimed_bytes_);
+        }
+        if (shrunk.skipped_) {
+            ENGINE_LOG_DEBUG("注册表使用 StorageArena，波次间隔不收缩存储");
+        }
+    }
+    ENGINE_LOG_DEBUG("波次间隔整理: 重排 {} 个存储，收缩 {} 个，回收 {:.1f} KB（保留 {} 个敌人的余量）",
+        result.sorted_, result.shrunk_, static_cast<double>(result.reclaimed_bytes_) / 1024.0, headroom);
+    return result;
+}
+
+} // namespace game::data
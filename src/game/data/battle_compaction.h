@@ -0,0 +1,32 @@
+#pragma once
+/**
+ * @file battle_compaction.h
+ * @brief 战斗注册表的波次间隔整理：单位组件存储按生成序号重排，按后续波次的需求收缩峰值容量。
+ *
+ * @details
+ * GameScene 与无头模拟在同一时机调用（场上敌人清空、波次间隔开始的那一步）。重排键是单位的生成序号
+ * （EnemyComponent / PlayerComponent::spawn_sequence_），两边相同；实体句柄则不同（实机有预热、UI 与地图区块实体），
+ * 不能作为键。非单位实体排在单位之后并保持原有顺序。重排只涉及不被分组拥有的单位组件与标签（见 engine/ecs/storage_compaction.h）；
+ * 收缩前后按 BattleRegistrySnapshot::getStorageBytes() 估算回收的字节数，累计到内存面板的 registry 标签。
+ */
+
+#include <cstddef>
+#include <entt/entity/fwd.hpp>
+
+namespace game::data {
+
+/// @brief 一次整理的结果
+struct BattleCompaction {
+    std::size_t sorted_{ 0 };           ///< 重排的存储数
+    std::size_t shrunk_{ 0 };           ///< 收缩的存储数
+    std::size_t reclaimed_bytes_{ 0 };  ///< 收缩回收的字节数（估算）
+};
+
+/**
+ * @brief 整理战斗注册表
+ * @param headroom 收缩时每个存储在当前数量之外保留的容量（后续波次的敌人峰值）
+ * @param shrink 为 false 时只重排（如无尽模式，后续波次的规模不断增长）
+ */
+BattleCompaction compactBattleStorages(entt::registry& registry, std::size_t headroom, bool shrink = true);
+
+} // namespace game::data
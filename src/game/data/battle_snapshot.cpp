@@ -0,0 +1,55 @@
+#include "battle_snapshot.h"
+
+#include <entt/entity/registry.hpp>
+#include <entt/entity/snapshot.hpp>
+#include "../component/enemy_component.h"
+#include "../component/player_component.h"
+#include "../component/stats_component.h"
+#include "../defs/tags.h"
+#include "../../engine/component/transform_component.h"
+#include "../../engine/component/velocity_component.h"
+#include "../../engine/io/binary_archive.h"
+
+namespace game::data {
+
+namespace {
+
+/// @brief 写出与读取共用同一份组件顺序，增删组件时同时递增 BATTLE_SAVE_SCHEMA
+template <typename Snapshot, typename Archive>
+void archiveComponents(Snapshot&& snapshot, Archive& archive) {
+    snapshot.template get<entt::entity>(archive)
+        .template get<engine::component::TransformComponent>(archive)
+        .template get<engine::component::VelocityComponent>(archive)
+        .template get<game::component::StatsComponent>(archive)
+        .template get<game::component::EnemyComponent>(archive)
+        .template get<game::component::PlayerComponent>(archive)
+        .template get<game::defs::MeleeUnitTag>(archive)
+        .template get<game::defs::RangedUnitTag>(archive)
+        .template get<game::defs::HealerTag>(archive)
+        .template get<game::defs::DeadTag>(archive);
+}
+
+} // namespace
+
+std::vector<std::byte> captureBattleSnapshot(const entt::registry& registry, const BattleSnapshotHeader& header, std::size_t reserve) {
+    std::vector<std::byte> payload;
+    payload.reserve(reserve);
+    engine::io::BinaryOutputArchive output{ payload };
+    output(header);
+    archiveComponents(entt::snapshot{ registry }, output);
+    return payload;
+}
+
+bool restoreBattleSnapshot(entt::registry& registry, std::span<const std::byte> payload, BattleSnapshotHeader& header) {
+    engine::io::BinaryInputArchive input{ payload };
+    input(header);
+    if (!input.ok()) {
+        return false;
+    }
+    entt::snapshot_loader loader{ registry };
+    archiveComponents(loader, input);
+    loader.orphans();
+    return input.ok() && input.done();
+}
+
+} // namespace game::data
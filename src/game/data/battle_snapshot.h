@@ -0,0 +1,47 @@
+#pragma once
+
+#include "game_stats.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <entt/core/hashed_string.hpp>
+#include <entt/entity/fwd.hpp>
+
+namespace game::data {
+
+inline constexpr entt::id_type BATTLE_SAVE_KIND = entt::hashed_string::value("battle");     ///< .mwsav 内容类型
+inline constexpr std::uint32_t BATTLE_SAVE_SCHEMA = 3;     ///< 快照组件列表或任一组件布局变化时递增（3：敌我组件加入 spawn_sequence_）
+
+/**
+ * @brief 战斗快照的场景级状态（注册表之外的部分）
+ */
+struct BattleSnapshotHeader {
+    std::uint32_t level_index_{ 0 };    ///< 关卡下标（从 0 开始）
+    std::int32_t wave_{ 0 };            ///< 快照时已开始的波次
+    std::uint64_t tick_{ 0 };           ///< 快照时的模拟步数
+    GameStats stats_;
+};
+
+static_assert(std::is_trivially_copyable_v<BattleSnapshotHeader>);
+
+/**
+ * @brief 把注册表中的战斗状态编码为存档负载。
+ *
+ * @details
+ * 经 entt::snapshot 写出实体表与位置、速度、属性、敌我组件及单位类型标签；只含可平凡拷贝的数据，
+ * 几百个实体的快照只需一次遍历与若干次 memcpy，可以每波调用。精灵、动画等表现层组件不在快照中，
+ * 恢复后由蓝图重建。
+ * @param reserve 预留的字节数（传入上一次快照的大小以避免扩容）
+ */
+[[nodiscard]] std::vector<std::byte> captureBattleSnapshot(const entt::registry& registry, const BattleSnapshotHeader& header,
+                                                           std::size_t reserve = 0);
+
+/**
+ * @brief 把 captureBattleSnapshot() 的负载恢复到一个空注册表
+ * @return 数据完整且恰好读完时返回 true
+ */
+[[nodiscard]] bool restoreBattleSnapshot(entt::registry& registry, std::span<const std::byte> payload, BattleSnapshotHeader& header);
+
+} // namespace game::data
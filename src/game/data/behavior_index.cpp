@@ -0,0 +1,48 @@
+#include "behavior_index.h"
+#include <entt/entity/registry.hpp>
+
+namespace game::data {
+
+using game::component::BehaviorComponent;
+using game::component::BehaviorEvent;
+
+BehaviorIndex::BehaviorIndex(entt::registry& registry) : registry_(registry) {
+    registry_.on_construct<BehaviorComponent>().connect<&BehaviorIndex::onConstruct>(this);
+    registry_.on_destroy<BehaviorComponent>().connect<&BehaviorIndex::onDestroy>(this);
+    // 接管创建前已存在的单位
+    for (auto [entity, behavior] : registry_.view<BehaviorComponent>().each()) {
+        lists_[static_cast<std::size_t>(behavior.state_)].push(entity);
+    }
+}
+
+BehaviorIndex::~BehaviorIndex() {
+    registry_.on_construct<BehaviorComponent>().disconnect(this);
+    registry_.on_destroy<BehaviorComponent>().disconnect(this);
+}
+
+bool BehaviorIndex::transition(entt::entity entity, BehaviorEvent event) {
+    auto* behavior = registry_.try_get<BehaviorComponent>(entity);
+    if (!behavior) {
+        return false;
+    }
+    const auto next = game::component::nextBehaviorState(behavior->state_, event);
+    if (next == behavior->state_) {
+        return false;
+    }
+    lists_[static_cast<std::size_t>(behavior->state_)].remove(entity);
+    lists_[static_cast<std::size_t>(next)].push(entity);
+    behavior->state_ = next;
+    return true;
+}
+
+void BehaviorIndex::onConstruct(entt::registry& registry, entt::entity entity) {
+    const auto state = registry.get<BehaviorComponent>(entity).state_;
+    lists_[static_cast<std::size_t>(state)].push(entity);
+}
+
+void BehaviorIndex::onDestroy(entt::registry& registry, entt::entity entity) {
+    const auto state = registry.get<BehaviorComponent>(entity).state_;
+    lists_[static_cast<std::size_t>(state)].remove(entity);
+}
+
+} // namespace game::data
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../component/behavior_component.h"
+#include <entt/entity/fwd.hpp>
+#include <entt/entity/sparse_set.hpp>
+#include <array>
+#include <cstddef>
+
+namespace game::data {
+
+/**
+ * @brief 按 BehaviorState 分组的单位列表，并执行 BehaviorComponent 的状态转移
+ *
+ * @details
+ * 每个状态一份 entt::sparse_set（不是注册表存储，增删不发信号、不影响视图与分组），
+ * 经 on_construct / on_destroy 信号跟随 BehaviorComponent 的添加与销毁，检查点恢复（registry.insert）时自动重建。
+ * 状态只应经 transition() 修改，列表才与组件一致。
+ *
+ * 由 GameScene / HeadlessSimulation 持有，以引用放入 registry.ctx()（registry.ctx().get<BehaviorIndex&>()），
+ * 必须先于注册表销毁。改变状态的系统在调度器中声明 writes<BehaviorComponent>() 与 writesResource<BehaviorIndex>()。
+ */
+class BehaviorIndex final {
+public:
+    explicit BehaviorIndex(entt::registry& registry);
+    ~BehaviorIndex();
+
+    BehaviorIndex(const BehaviorIndex&) = delete;
+    BehaviorIndex& operator=(const BehaviorIndex&) = delete;
+
+    /**
+     * @brief 按转移表推进 entity 的状态
+     * @return 状态是否改变；没有 BehaviorComponent 的实体返回 false
+     */
+    bool transition(entt::entity entity, game::component::BehaviorEvent event);
+
+    /// @brief 当前处于 state 的单位（按进入该状态的先后，转移会交换删除，遍历中转移须先复制）
+    [[nodiscard]] const entt::sparse_set& inState(game::component::BehaviorState state) const {
+        return lists_[static_cast<std::size_t>(state)];
+    }
+
+    /// @brief 冷却结束（READY 与 ACTING_READY）的单位数
+    [[nodiscard]] std::size_t readyCount() const {
+        return inState(game::component::BehaviorState::READY).size() + inState(game::component::BehaviorState::ACTING_READY).size();
+    }
+
+private:
+    void onConstruct(entt::registry& registry, entt::entity entity);
+    void onDestroy(entt::registry& registry, entt::entity entity);
+
+    entt::registry& registry_;
+    std::array<entt::sparse_set, static_cast<std::size_t>(game::component::BehaviorState::COUNT)> lists_;
+};
+
+} // namespace game::data
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+namespace game::data {
+
+/**
+ * @brief 战斗检查点概况，GameScene 每次拍快照后写入 registry.ctx()，供调试面板显示与选择回退目标
+ */
+struct CheckpointInfo {
+    int last_wave_{ 0 };                ///< 已有检查点的最大波次（第 N 波开始前；0 为关卡初始状态）
+    std::size_t entity_count_{ 0 };     ///< 最近一次快照的存活实体数
+    std::size_t component_count_{ 0 };  ///< 最近一次快照的组件实例数
+    float capture_ms_{ 0.0f };          ///< 最近一次快照耗时
+};
+
+} // namespace game::data
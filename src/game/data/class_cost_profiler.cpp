@@ -0,0 +1,149 @@
+#include "class_cost_profiler.h"
+
+#include "../component/class_name_component.h"
+#include "../component/stats_component.h"
+#include "../../engine/utils/logging.h"
+#include <algorithm>
+#include <entt/entity/registry.hpp>
+
+namespace game::data {
+
+namespace {
+
+constexpr const char* CATEGORY_NAMES[COST_CATEGORY_COUNT] = { "索敌", "动画事件", "战斗结算" };
+
+bool cost_attribution_enabled = false;
+
+} // namespace
+
+void setCostAttributionEnabled(bool enabled) {
+    cost_attribution_enabled = enabled;
+}
+
+bool isCostAttributionEnabled() {
+    return cost_attribution_enabled;
+}
+
+ClassCostProfiler::ClassCostProfiler(std::uint32_t sample_stride) : sample_stride_(sample_stride > 0 ? sample_stride : 1) {
+    classes_.push_back(ClassCost{ 0, "(无类型)" });
+}
+
+ClassCostProfiler::Scope::Scope(ClassCostProfiler* profiler, const entt::registry& registry, entt::entity entity, CostCategory category)
+    : profiler_(profiler), category_(category) {
+    if (!profiler_) {
+        return;
+    }
+    class_index_ = profiler_->classIndex(registry, entity);
+    ++profiler_->classes_[class_index_].items_[static_cast<std::size_t>(category_)];
+    sampled_ = profiler_->sample_counter_++ % profiler_->sample_stride_ == 0;
+    if (sampled_) {
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+ClassCostProfiler::Scope::~Scope() {
+    if (!sampled_) {
+        return;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+    auto& cost = profiler_->classes_[class_index_];
+    const auto category = static_cast<std::size_t>(category_);
+    ++cost.sampled_items_[category];
+    cost.sampled_ns_[category] += static_cast<std::uint64_t>(elapsed);
+}
+
+std::size_t ClassCostProfiler::classIndex(const entt::registry& registry, entt::entity entity) {
+    const auto* class_name = registry.valid(entity) ? registry.try_get<game::component::ClassNameComponent>(entity) : nullptr;
+    if (!class_name) {
+        return 0;
+    }
+    const auto [it, inserted] = index_.try_emplace(class_name->class_id_, classes_.size());
+    if (inserted) {
+        classes_.push_back(ClassCost{ class_name->class_id_, class_name->class_name_ });
+    }
+    return it->second;
+}
+
+void ClassCostProfiler::countEvents(const entt::registry& registry, entt::entity entity, std::uint32_t count) {
+    classes_[classIndex(registry, entity)].events_ += count;
+}
+
+void ClassCostProfiler::addMeasured(const entt::registry& registry, entt::entity entity, CostCategory category, std::uint64_t elapsed_ns) {
+    const auto index = static_cast<std::size_t>(category);
+    auto& cost = classes_[classIndex(registry, entity)];
+    ++cost.items_[index];
+    ++cost.sampled_items_[index];
+    cost.sampled_ns_[index] += elapsed_ns;
+}
+
+void ClassCostProfiler::sampleTick(const entt::registry& registry, float delta_time) {
+    simulated_seconds_ += delta_time;
+    tick_units_.assign(classes_.size(), 0);
+    for (const auto entity : registry.view<const game::component::StatsComponent, const game::component::ClassNameComponent>()) {
+        const auto index = classIndex(registry, entity);
+        if (index >= tick_units_.size()) {
+            tick_units_.resize(classes_.size(), 0);
+        }
+        ++tick_units_[index];
+    }
+    for (std::size_t i = 0; i < tick_units_.size(); ++i) {
+        classes_[i].unit_seconds_ += static_cast<double>(tick_units_[i]) * delta_time;
+    }
+}
+
+std::vector<ClassCostSummary> ClassCostProfiler::summarize() const {
+    std::vector<ClassCostSummary> summaries;
+    if (simulated_seconds_ <= 0.0) {
+        return summaries;
+    }
+    for (const auto& cost : classes_) {
+        ClassCostSummary summary;
+        summary.class_id_ = cost.class_id_;
+        summary.class_name_ = cost.class_name_;
+        summary.average_units_ = cost.unit_seconds_ / simulated_seconds_;
+        for (std::size_t category = 0; category < COST_CATEGORY_COUNT; ++category) {
+            summary.items_ += cost.items_[category];
+            if (cost.sampled_items_[category] == 0) {
+                continue;
+            }
+            // 抽样的平均耗时 × 全部工作项
+            const double estimated_ns = static_cast<double>(cost.sampled_ns_[category]) *
+                static_cast<double>(cost.items_[category]) / static_cast<double>(cost.sampled_items_[category]);
+            summary.ms_per_second_[category] = estimated_ns / 1.0e6 / simulated_seconds_;
+            summary.total_ms_per_second_ += summary.ms_per_second_[category];
+        }
+        if (summary.items_ == 0 && cost.events_ == 0) {
+            continue;
+        }
+        summary.us_per_unit_second_ = cost.unit_seconds_ > 0.0 ? summary.total_ms_per_second_ * 1.0e3 / summary.average_units_ : 0.0;
+        summary.events_per_second_ = static_cast<double>(cost.events_) / simulated_seconds_;
+        summaries.push_back(std::move(summary));
+    }
+    std::ranges::sort(summaries, std::ranges::greater{}, &ClassCostSummary::total_ms_per_second_);
+    return summaries;
+}
+
+void ClassCostProfiler::report() const {
+    const auto summaries = summarize();
+    if (summaries.empty()) {
+        return;
+    }
+    ENGINE_LOG_INFO("单位类型开销（{:.1f}s 模拟时间，每 {} 项抽样 1 项；单位 ms/s）:", simulated_seconds_, sample_stride_);
+    ENGINE_LOG_INFO("  {:<20} {:>7} {:>8} {:>8} {:>8} {:>8} {:>10} {:>8}",
+        "类型", "平均数", CATEGORY_NAMES[0], CATEGORY_NAMES[1], CATEGORY_NAMES[2], "合计", "us/单位·s", "事件/s");
+    for (const auto& summary : summaries) {
+        ENGINE_LOG_INFO("  {:<20} {:>7.1f} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.3f} {:>10.2f} {:>8.1f}",
+            summary.class_name_, summary.average_units_, summary.ms_per_second_[0], summary.ms_per_second_[1],
+            summary.ms_per_second_[2], summary.total_ms_per_second_, summary.us_per_unit_second_, summary.events_per_second_);
+    }
+}
+
+void ClassCostProfiler::reset() {
+    classes_.resize(1);
+    classes_.front() = ClassCost{ 0, "(无类型)" };
+    index_.clear();
+    sample_counter_ = 0;
+    simulated_seconds_ = 0.0;
+}
+
+} // namespace game::data
@@ -0,0 +1,136 @@
+#pragma once
+/**
+ * @file class_cost_profiler.h
+ * @brief 按单位类型归因的 CPU 开销：插桩系统逐实体抽样计时，按 ClassNameComponent 的类型汇总为「每秒毫秒数」。
+ *
+ * @details
+ * 系统级计时只说明 SetTargetSystem 很贵，不说明贵在治疗者、远程哥布林还是哪个英雄。开启归因后
+ * （GameScene / 无头模拟在注册表上下文中放入一个 ClassCostProfiler），以下位置逐实体记录开销：
+ * | 类别 | 位置 | 归给 |
+ * |------|------|------|
+ * | TARGETING | SetTargetSystem：空闲玩家单位索敌、远程敌人索敌、治疗者选目标 | 搜索的单位 |
+ * | ANIMATION_EVENTS | AnimationEventsSystem：命中 / 发射帧事件 | 出手的单位 |
+ * | COMBAT | CombatResolveSystem：范围命中查询、伤害与治疗结算 | 查询归攻击者，结算归受击者 |
+ * 另按攻击者计数进入战斗结算的事件（AttackHit / HealerHit / AreaHit）。
+ *
+ * 每 sample_stride_ 个工作项只有一个读时钟，按「抽样耗时 × 工作项数 / 抽样数」估计总耗时；工作项数与事件数是精确的。
+ * 索敌的快照暴力扫描跑在工作线程上，整段耗时在提交时平均分给本步搜索的单位。
+ * 每个模拟步调用 sampleTick() 累计各类型的存活单位数，报告同时给出「每单位每秒微秒数」，
+ * 便于在出波次表之前比较单位类型的性能影响。
+ *
+ * 各插桩点彼此不会并发执行（SetTargetSystem 可能在调度器的工作线程上，但与其他插桩点分属不同阶段），记录不加锁；
+ * 没有开启时各系统只多一次 ctx().find()。命令行 --cost-attribution 开启（setCostAttributionEnabled），
+ * GameScene 在场景结束、无头模拟在 run() 结束时输出汇总。
+ * @code
+ * auto& costs = registry.ctx().emplace<game::data::ClassCostProfiler>();
+ * ...每步 costs.sampleTick(registry, dt);
+ * costs.report();
+ * @endcode
+ */
+
+#include <entt/entity/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace game::data {
+
+enum class CostCategory : std::uint8_t {
+    TARGETING,
+    ANIMATION_EVENTS,
+    COMBAT,
+};
+
+inline constexpr std::size_t COST_CATEGORY_COUNT = 3;
+
+/**
+ * @brief 一个单位类型的汇总
+ */
+struct ClassCostSummary {
+    entt::id_type class_id_{ 0 };
+    std::string class_name_;
+    double average_units_{ 0.0 };                               ///< 平均存活数
+    std::array<double, COST_CATEGORY_COUNT> ms_per_second_{};   ///< 各类别每模拟秒的估计耗时
+    double total_ms_per_second_{ 0.0 };
+    double us_per_unit_second_{ 0.0 };                          ///< 每个单位每模拟秒的估计耗时（平均存活数为 0 时为 0）
+    double events_per_second_{ 0.0 };
+    std::uint64_t items_{ 0 };                                  ///< 各类别工作项之和
+};
+
+/// @brief 新建的战斗场景与无头模拟是否开启归因（启动时设置）
+void setCostAttributionEnabled(bool enabled);
+[[nodiscard]] bool isCostAttributionEnabled();
+
+class ClassCostProfiler final {
+public:
+    static constexpr std::uint32_t DEFAULT_SAMPLE_STRIDE = 4;
+
+    explicit ClassCostProfiler(std::uint32_t sample_stride = DEFAULT_SAMPLE_STRIDE);
+
+    /**
+     * @brief 一个实体的一项工作：构造时计数，抽中时计时到析构
+     * @details profiler 为 nullptr 时什么也不做（未开启归因）
+     */
+    class Scope final {
+    public:
+        Scope(ClassCostProfiler* profiler, const entt::registry& registry, entt::entity entity, CostCategory category);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ClassCostProfiler* profiler_;
+        std::size_t class_index_{ 0 };
+        CostCategory category_;
+        bool sampled_{ false };
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    /// @brief 记下 entity 发出的 count 个事件
+    void countEvents(const entt::registry& registry, entt::entity entity, std::uint32_t count = 1);
+
+    /// @brief 记下 entity 一项已测得耗时的工作（整段计时后由调用方平均分摊）
+    void addMeasured(const entt::registry& registry, entt::entity entity, CostCategory category, std::uint64_t elapsed_ns);
+
+    /// @brief 每个模拟步调用一次：累计模拟时间与各类型的存活单位数（带 StatsComponent 的实体）
+    void sampleTick(const entt::registry& registry, float delta_time);
+
+    /// @brief 按每秒总耗时降序的各类型汇总
+    [[nodiscard]] std::vector<ClassCostSummary> summarize() const;
+
+    /// @brief 以日志输出汇总表（没有模拟时间时什么也不做）
+    void report() const;
+
+    void reset();
+
+    [[nodiscard]] double getSimulatedSeconds() const { return simulated_seconds_; }
+
+private:
+    struct ClassCost {
+        entt::id_type class_id_{ 0 };
+        std::string class_name_;
+        std::array<std::uint64_t, COST_CATEGORY_COUNT> items_{};
+        std::array<std::uint64_t, COST_CATEGORY_COUNT> sampled_items_{};
+        std::array<std::uint64_t, COST_CATEGORY_COUNT> sampled_ns_{};
+        std::uint64_t events_{ 0 };
+        double unit_seconds_{ 0.0 };
+    };
+
+    /// @brief entity 所属类型在 classes_ 中的下标（没有 ClassNameComponent 的实体归入 0 号"(无类型)"）
+    std::size_t classIndex(const entt::registry& registry, entt::entity entity);
+
+    std::uint32_t sample_stride_;
+    std::uint32_t sample_counter_{ 0 };
+    std::vector<ClassCost> classes_;
+    std::unordered_map<entt::id_type, std::size_t> index_;
+    std::vector<std::uint32_t> tick_units_;         ///< sampleTick 的逐类型计数（容量复用）
+    double simulated_seconds_{ 0.0 };
+};
+
+} // namespace game::data
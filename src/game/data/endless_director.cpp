@@ -0,0 +1,158 @@
+#include "endless_director.h"
+#include "../../engine/core/frame_budget.h"
+#include "../../engine/utils/logging.h"
+#include <algorithm>
+#include <cmath>
+
+namespace game::data {
+
+namespace {
+
+/// @brief 已排序数组的分位数（最近秩）
+double percentile(const std::vector<float>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<std::size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+    return static_cast<double>(sorted[std::min(rank, sorted.size() - 1)]);
+}
+
+} // namespace
+
+void EndlessDirector::begin(const EndlessConfig& config, std::size_t wave_count, bool adaptive) {
+    config_ = config;
+    wave_count_ = wave_count;
+    adaptive_ = adaptive && config.adaptive_cap_;
+    population_cap_ = config.population_cap_;
+    pressure_frames_ = 0;
+    relief_frames_ = 0;
+    cycle_ = Cycle{};
+    cycle_.frame_ms_.reserve(RESERVED_FRAMES);
+}
+
+int EndlessDirector::cycleOf(int wave) const {
+    if (wave_count_ == 0 || wave < 1) {
+        return 0;
+    }
+    return (wave - 1) / static_cast<int>(wave_count_);
+}
+
+bool EndlessDirector::isCycleStart(int wave) const {
+    return wave_count_ > 0 && wave >= 1 && (wave - 1) % static_cast<int>(wave_count_) == 0;
+}
+
+int EndlessDirector::enemyLevel(int base_level, int cycle) const {
+    return base_level + config_.level_step_ * cycle;
+}
+
+int EndlessDirector::enemyRarity(int base_rarity, int cycle) const {
+    const int bonus = config_.rarity_every_ > 0 ? cycle / config_.rarity_every_ : 0;
+    return std::min(base_rarity + bonus, std::max(base_rarity, config_.max_rarity_));
+}
+
+void EndlessDirector::scaleWave(const WaveConfig& base, int cycle, WaveConfig& out) const {
+    out.groups_.assign(base.groups_.begin(), base.groups_.end());
+    out.next_wave_interval_ = base.next_wave_interval_;
+    out.enemy_count_ = 0;
+    const float scale = 1.0f + config_.count_growth_ * static_cast<float>(cycle);
+    for (auto& group : out.groups_) {
+        group.count_ = std::max(1, static_cast<int>(std::lround(static_cast<float>(group.count_) * scale)));
+        out.enemy_count_ += static_cast<std::size_t>(group.count_);
+    }
+}
+
+EndlessSpawnPlan EndlessDirector::planSpawn(std::size_t count, std::size_t population) const {
+    EndlessSpawnPlan plan;
+    plan.merge_factor_ = static_cast<std::size_t>(config_.merge_factor_);
+    plan.normal_ = std::min(count, population_cap_ > population ? population_cap_ - population : 0);
+    const std::size_t rest = count - plan.normal_;
+    const std::size_t occupied = population + plan.normal_;
+    const std::size_t hard_cap = config_.hardCap();
+    const std::size_t elite_slots = hard_cap > occupied ? hard_cap - occupied : 0;
+    plan.merged_ = std::min(rest, elite_slots * plan.merge_factor_);
+    plan.absorbed_ = rest - plan.merged_;
+    return plan;
+}
+
+void EndlessDirector::recordSpawn(const EndlessSpawnPlan& plan) {
+    cycle_.spawned_ += plan.normal_ + plan.merged_ + plan.absorbed_;
+    cycle_.elites_ += plan.eliteCount();
+    cycle_.merged_ += plan.merged_;
+    cycle_.absorbed_ += plan.absorbed_;
+}
+
+void EndlessDirector::recordFrame(double frame_ms, int budget_level, bool over_budget, std::size_t population, std::size_t entities) {
+    if (cycle_.cycle_ < 0) {
+        return;
+    }
+    cycle_.frame_ms_.push_back(static_cast<float>(frame_ms));
+    cycle_.seconds_ += frame_ms / 1000.0;
+    cycle_.over_budget_frames_ += over_budget ? 1 : 0;
+    cycle_.peak_budget_level_ = std::max(cycle_.peak_budget_level_, budget_level);
+    cycle_.peak_population_ = std::max(cycle_.peak_population_, population);
+    cycle_.peak_entities_ = std::max(cycle_.peak_entities_, entities);
+
+    if (!adaptive_) {
+        return;
+    }
+    // 画质已降到底仍超预算：模拟本身是瓶颈，只能少放实体；收紧快、放宽慢
+    if (budget_level >= engine::core::FrameBudget::MAX_LEVEL && over_budget) {
+        relief_frames_ = 0;
+        if (++pressure_frames_ >= PRESSURE_FRAMES) {
+            pressure_frames_ = 0;
+            const std::size_t floor = std::max<std::size_t>(8, config_.population_cap_ / 4);
+            population_cap_ = std::max(floor, population_cap_ - population_cap_ / 8);
+            cycle_.min_cap_ = std::min(cycle_.min_cap_, population_cap_);
+            ENGINE_LOG_WARN("无尽模式：帧预算持续超出，存活敌人上限收紧为 {}", population_cap_);
+        }
+    } else if (budget_level == 0 && population_cap_ < config_.population_cap_) {
+        pressure_frames_ = 0;
+        if (++relief_frames_ >= RELIEF_FRAMES) {
+            relief_frames_ = 0;
+            population_cap_ = std::min(config_.population_cap_, population_cap_ + std::max<std::size_t>(1, config_.population_cap_ / 16));
+        }
+    } else {
+        pressure_frames_ = 0;
+        relief_frames_ = 0;
+    }
+}
+
+void EndlessDirector::beginCycle(int cycle, int enemy_level, int enemy_rarity, std::size_t storage_bytes) {
+    cycle_.cycle_ = cycle;
+    cycle_.waves_ = 0;
+    cycle_.enemy_level_ = enemy_level;
+    cycle_.enemy_rarity_ = enemy_rarity;
+    cycle_.frame_ms_.clear();
+    cycle_.seconds_ = 0.0;
+    cycle_.over_budget_frames_ = 0;
+    cycle_.peak_budget_level_ = 0;
+    cycle_.spawned_ = 0;
+    cycle_.elites_ = 0;
+    cycle_.merged_ = 0;
+    cycle_.absorbed_ = 0;
+    cycle_.peak_population_ = 0;
+    cycle_.peak_entities_ = 0;
+    cycle_.min_cap_ = population_cap_;
+    cycle_.storage_bytes_start_ = storage_bytes;
+}
+
+void EndlessDirector::finishCycle(std::size_t storage_bytes, bool fell) {
+    if (cycle_.cycle_ < 0) {
+        return;
+    }
+    auto& frames = cycle_.frame_ms_;
+    std::ranges::sort(frames);
+    const double over_percent = frames.empty() ? 0.0 : 100.0 * static_cast<double>(cycle_.over_budget_frames_) / static_cast<double>(frames.size());
+    ENGINE_LOG_INFO("无尽模式第 {} 轮{}：{} 波 {:.1f} 秒，敌人 Lv{} 稀有度 {}，出场 {}（合并 {} → 精英 {}，并入在场 {}），"
+                    "存活峰值 {} / 上限 {}（最低 {}），实体峰值 {}，注册表 {} → {} KB，"
+                    "帧 p50 {:.2f} / p99 {:.2f} / 最大 {:.2f} ms，超预算 {:.1f}%，最高降级档 {}",
+                    cycle_.cycle_ + 1, fell ? "（基地失守）" : "", cycle_.waves_, cycle_.seconds_,
+                    cycle_.enemy_level_, cycle_.enemy_rarity_, cycle_.spawned_, cycle_.merged_, cycle_.elites_, cycle_.absorbed_,
+                    cycle_.peak_population_, config_.population_cap_, cycle_.min_cap_, cycle_.peak_entities_,
+                    cycle_.storage_bytes_start_ / 1024, storage_bytes / 1024,
+                    percentile(frames, 0.50), percentile(frames, 0.99), frames.empty() ? 0.0 : static_cast<double>(frames.back()),
+                    over_percent, cycle_.peak_budget_level_);
+    cycle_.cycle_ = -1;
+}
+
+} // namespace game::data
@@ -0,0 +1,126 @@
+#pragma once
+/**
+ * @file endless_director.h
+ * @brief 无尽模式的调度：按轮次放大波次、在人口上限下拆分刷怪批次，并在每轮结束时输出性能汇总。
+ *
+ * @details
+ * 关卡配置了 "endless"（EndlessConfig）时由 GameScene 持有。波次表每播放一遍为一轮（第 0 轮即原始波次）：
+ * - 强度：敌人等级、稀有度与各组数量只由轮次决定（见 enemyLevel / enemyRarity / scaleWave），
+ *   回退到检查点后按恢复的波次序号自然重算
+ * - 人口：planSpawn() 按当前存活敌人把一批敌人分成「照常生成」「合并为精英」「并入在场敌人」三部分，
+ *   存活敌人数不超过 EndlessConfig::hardCap()；GameScene 开局即按硬上限预留敌人存储，之后不再扩容
+ * - 帧时间：recordFrame() 累计本轮的帧时长与帧预算档位；adaptive_cap_ 开启时，
+ *   帧预算降到最低档仍持续超预算则逐步收紧软上限，长时间无降级后再放回
+ *
+ * 每轮的帧时长数组在开局时预留，跨轮复用容量；汇总在 finishCycle() 时写一条日志。
+ */
+
+#include "level_config.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace game::data {
+
+/// @brief 一批敌人在人口上限下的生成方式，三部分之和为批次敌人数
+struct EndlessSpawnPlan {
+    std::size_t normal_ = 0;    ///< 照常生成的敌人
+    std::size_t merged_ = 0;    ///< 合并为精英的敌人（每 merge_factor_ 只生成一只精英，见 eliteCount()）
+    std::size_t absorbed_ = 0;  ///< 已达硬上限，不生成实体而并入在场敌人的数量
+    std::size_t merge_factor_ = 1;
+
+    /// @brief 本批生成的精英数
+    [[nodiscard]] std::size_t eliteCount() const { return (merged_ + merge_factor_ - 1) / merge_factor_; }
+    /// @brief 本批实际创建的实体数
+    [[nodiscard]] std::size_t entityCount() const { return normal_ + eliteCount(); }
+};
+
+class EndlessDirector final {
+public:
+    static constexpr std::size_t RESERVED_FRAMES = 60 * 180;   ///< 每轮帧时长数组的预留长度（60 FPS 下三分钟）
+    static constexpr int PRESSURE_FRAMES = 60;                  ///< 最低档仍超预算持续多少帧收紧一次上限
+    static constexpr int RELIEF_FRAMES = 300;                   ///< 无降级持续多少帧放宽一次上限
+
+    /**
+     * @brief 开启无尽模式
+     * @param wave_count 关卡的波次数（一轮的长度，须大于 0）
+     * @param adaptive 是否允许按帧预算收紧上限（联机时传 false）
+     */
+    void begin(const EndlessConfig& config, std::size_t wave_count, bool adaptive);
+
+    [[nodiscard]] bool isActive() const { return wave_count_ > 0; }
+    [[nodiscard]] const EndlessConfig& getConfig() const { return config_; }
+
+    /// @brief 第 wave 波（从 1 开始）所在的轮次
+    [[nodiscard]] int cycleOf(int wave) const;
+    /// @brief 第 wave 波是否是一轮的第一波
+    [[nodiscard]] bool isCycleStart(int wave) const;
+
+    [[nodiscard]] int enemyLevel(int base_level, int cycle) const;
+    [[nodiscard]] int enemyRarity(int base_rarity, int cycle) const;
+
+    /// @brief 按轮次放大各组敌人数，写入 out（复用其容量）
+    void scaleWave(const WaveConfig& base, int cycle, WaveConfig& out) const;
+
+    /**
+     * @brief 拆分一批敌人
+     * @param count 批次敌人数
+     * @param population 当前存活敌人数
+     */
+    [[nodiscard]] EndlessSpawnPlan planSpawn(std::size_t count, std::size_t population) const;
+    /// @brief 记下一批的实际生成结果（计入本轮汇总）
+    void recordSpawn(const EndlessSpawnPlan& plan);
+    /// @brief 记下本轮又开始了一波
+    void recordWave() { ++cycle_.waves_; }
+
+    /**
+     * @brief 每帧调用：累计帧时长、存活峰值，并按帧预算调整软上限
+     * @param budget_level FrameBudget 当前档位
+     * @param over_budget 平滑后的工作耗时是否超出预算
+     */
+    void recordFrame(double frame_ms, int budget_level, bool over_budget, std::size_t population, std::size_t entities);
+
+    /// @brief 开始第 cycle 轮的统计
+    void beginCycle(int cycle, int enemy_level, int enemy_rarity, std::size_t storage_bytes);
+    /**
+     * @brief 结束本轮并输出汇总（没有进行中的轮次时什么也不做）
+     * @param fell 基地失守；场景中途退出时为 false，汇总的是未打完的一轮
+     */
+    void finishCycle(std::size_t storage_bytes, bool fell);
+    /// @brief 丢弃进行中一轮的统计（回退到检查点时）
+    void discardCycle() { cycle_.cycle_ = -1; }
+
+    /// @brief 当前生效的软上限（adaptive_cap_ 关闭时等于配置值）
+    [[nodiscard]] std::size_t getPopulationCap() const { return population_cap_; }
+
+private:
+    /// @brief 一轮的原始记录
+    struct Cycle {
+        int cycle_ = -1;                ///< -1 表示没有进行中的轮次
+        int waves_ = 0;
+        int enemy_level_ = 1;
+        int enemy_rarity_ = 1;
+        std::vector<float> frame_ms_;
+        double seconds_ = 0.0;
+        std::size_t over_budget_frames_ = 0;
+        int peak_budget_level_ = 0;
+        std::size_t spawned_ = 0;       ///< 计入合并前的敌人总数
+        std::size_t elites_ = 0;
+        std::size_t merged_ = 0;
+        std::size_t absorbed_ = 0;
+        std::size_t peak_population_ = 0;
+        std::size_t peak_entities_ = 0;
+        std::size_t min_cap_ = 0;       ///< 本轮软上限的最低值
+        std::size_t storage_bytes_start_ = 0;
+    };
+
+    EndlessConfig config_;
+    std::size_t wave_count_ = 0;
+    bool adaptive_ = false;
+    std::size_t population_cap_ = 0;
+    int pressure_frames_ = 0;
+    int relief_frames_ = 0;
+    Cycle cycle_;
+};
+
+} // namespace game::data
@@ -1,10 +1,12 @@
 #pragma once
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <entt/core/hashed_string.hpp>
 #include <entt/entity/entity.hpp>
 #include <glm/vec2.hpp>
+#include "../../engine/component/audio_component.h"
 #include "../../engine/utils/math.h"
 #include "../defs/constants.h"
 
@@ -51,7 +53,8 @@ struct AnimationBlueprint {
  * @brief 音效蓝图，存储动作到音效的映射
  */
 struct SoundBlueprint {
-    std::unordered_map<entt::id_type, entt::id_type> sounds_;
+    /// 解析时构建、之后只读；同一职业的全部单位经 AudioComponent 指向这一份（复制蓝图只增加引用）
+    std::shared_ptr<const engine::component::SoundTable> table_;
 };
 
 /**
@@ -75,6 +78,10 @@ struct PlayerBlueprint {
     int cost_ = 0;
     entt::id_type skill_id_ = entt::null;
     entt::id_type projectile_id_ = entt::null;
+    game::defs::TargetPolicy target_policy_ = game::defs::TargetPolicy::CLOSEST;  ///< 索敌策略（"target_policy"）
+    game::defs::AreaShape area_shape_ = game::defs::AreaShape::NONE;   ///< 范围攻击形状（"area": {"shape"}），NONE 为单体
+    float area_radius_ = 0.0f;                                          ///< 范围半径（"area": {"radius"}）
+    float area_half_angle_ = 45.0f;                                     ///< 扇形半张角，单位度（"area": {"angle"}）
 };
 
 /**
@@ -126,6 +133,13 @@ struct ProjectileBlueprint {
     float arc_height_ = 0.0f;
     float total_flight_time_ = 0.5f;
     float rotation_offset_deg_ = 0.0f;
+    int pool_size_ = game::defs::PROJECTILE_POOL_SIZE;  ///< 预热的池化实体数
+    // --- 模拟投射物（"simulated" 字段，缺省时攻击在出手时立即命中，投射物只是视觉） ---
+    bool simulated_ = false;        ///< 由 ProjectileSystem 逐步飞行并扫掠判定命中
+    float speed_ = 600.0f;          ///< 飞行速度（像素/秒）
+    float hit_radius_ = 8.0f;       ///< 命中判定半径（再加上目标的 UNIT_RADIUS）
+    int pierce_ = 0;                ///< 命中后还能继续穿透的目标数
+    float lifetime_ = 1.5f;         ///< 最长飞行时间（秒），到时未命中即落空
 };
 
 /**
@@ -136,6 +150,10 @@ struct EffectBlueprint {
     entt::id_type effect_id_ = entt::null;
     SpriteBlueprint sprite_;
     AnimationBlueprint animation_;
+    int pool_size_ = game::defs::EFFECT_POOL_SIZE;      ///< 预热的池化实体数
+    int particle_capacity_ = 0;                         ///< 大于 0 时由 EffectParticleSystem 以粒子绘制（同时存在的上限），不使用池化实体
+    float particle_rise_speed_ = 0.0f;                  ///< 粒子每秒向上移动的像素
+    bool particle_fade_ = false;                        ///< 粒子透明度随播放进度降到 0
 };
 
 /**
@@ -154,6 +172,8 @@ struct SkillBlueprint {
     float cooldown_ = 0.0f;
     float duration_ = 0.0f;
     float cost_regen_ = 0.0f;
+    float area_radius_ = 0.0f;              ///< 释放时对周围敌人造成一次范围伤害的半径，0 表示没有
+    float area_damage_multiplier_ = 1.0f;   ///< 范围伤害为释放者攻击力的倍数
 };
 
 } // namespace game::data
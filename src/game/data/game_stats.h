@@ -5,10 +5,12 @@ namespace game::data {
 struct GameStats {
     float cost_{ 10.0f };
     float cost_gen_per_second_{ 1.0f };
+    float passive_cost_regen_{ 0.0f };  ///< 在场被动技能的回费合计（每秒），HeroSkillSystem 只在编队变化时重算
     int home_hp_{ 5 };
     int enemy_count_{ 0 };
     int enemy_arrived_count_{ 0 };
     int enemy_killed_count_{ 0 };
+    int peak_kills_per_tick_{ 0 };      ///< 单个模拟步内的最多击杀数（CombatResolveSystem 汇总写入）
 };
 
 } // namespace game::data
@@ -0,0 +1,46 @@
+#include "injury_queue.h"
+#include "../component/behavior_component.h"
+#include "../component/player_component.h"
+#include "../component/stats_component.h"
+#include "../defs/tags.h"
+#include <entt/entity/registry.hpp>
+#include <algorithm>
+
+namespace game::data {
+
+namespace {
+bool lessEntry(const InjuryQueue::Entry& a, const InjuryQueue::Entry& b) {
+    return a.hp_ratio_ != b.hp_ratio_ ? a.hp_ratio_ < b.hp_ratio_ : a.entity_ < b.entity_;
+}
+} // namespace
+
+void InjuryQueue::insertSorted(const Entry& entry) {
+    entries_.insert(std::lower_bound(entries_.begin(), entries_.end(), entry, lessEntry), entry);
+}
+
+void InjuryQueue::update(entt::entity entity, float hp_ratio) {
+    remove(entity);
+    insertSorted({ entity, hp_ratio });
+}
+
+void InjuryQueue::remove(entt::entity entity) {
+    const auto it = std::find_if(entries_.begin(), entries_.end(), [entity](const Entry& entry) { return entry.entity_ == entity; });
+    if (it != entries_.end()) {
+        entries_.erase(it);
+    }
+}
+
+void InjuryQueue::rebuild(const entt::registry& registry) {
+    entries_.clear();
+    auto view = registry.view<game::component::PlayerComponent, game::component::StatsComponent, game::component::BehaviorComponent>(
+        entt::exclude<game::defs::DeadTag>);
+    for (auto [entity, player, stats, behavior] : view.each()) {
+        if (!behavior.hasFlag(game::component::behavior_flag::INJURED)) {
+            continue;
+        }
+        entries_.push_back({ entity, stats.max_hp_ > 0.0f ? stats.hp_ / stats.max_hp_ : 1.0f });
+    }
+    std::sort(entries_.begin(), entries_.end(), lessEntry);
+}
+
+} // namespace game::data
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <entt/entity/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace game::data {
+
+/**
+ * @brief 受伤玩家单位的治疗优先队列，按生命比例升序，放在 registry.ctx() 中
+ *
+ * @details
+ * CombatResolveSystem 结算玩家单位的伤害或治疗后调用 update() / remove()，
+ * SetTargetSystem 为治疗者选目标时按生命比例从低到高查看、取第一个在射程内的，不再逐个比较射程内全部受伤单位。
+ * 受伤单位通常只有几个到几十个，条目保存在一个有序数组中（比例相同按实体序号，结果确定）。
+ * 撤退、销毁等不经结算离开的单位由使用方发现后调用 remove()；回退检查点后调用 rebuild()。
+ */
+class InjuryQueue final {
+public:
+    struct Entry {
+        entt::entity entity_{ entt::null };
+        float hp_ratio_{ 1.0f };
+    };
+
+    /// @brief 写入或更新 entity 的生命比例
+    void update(entt::entity entity, float hp_ratio);
+
+    /// @brief 移除 entity（不在队列中时忽略）
+    void remove(entt::entity entity);
+
+    /// @brief 按注册表中带 behavior_flag::INJURED 的玩家单位重建
+    void rebuild(const entt::registry& registry);
+
+    void clear() { entries_.clear(); }
+
+    /// @brief 按生命比例升序的全部条目
+    [[nodiscard]] const std::vector<Entry>& entries() const { return entries_; }
+    [[nodiscard]] std::size_t size() const { return entries_.size(); }
+    [[nodiscard]] bool empty() const { return entries_.empty(); }
+
+private:
+    void insertSorted(const Entry& entry);
+
+    std::vector<Entry> entries_;
+};
+
+} // namespace game::data
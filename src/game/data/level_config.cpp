@@ -0,0 +1,154 @@
+#include "level_config.h"
+
+#include <algorithm>
+#include <entt/core/hashed_string.hpp>
+#include <nlohmann/json.hpp>
+#include "../../engine/io/virtual_fs.h"
+#include "../../engine/utils/logging.h"
+
+namespace game::data {
+namespace {
+/**
+ * @brief 旧格式 "enemy_types": {"slime": 8, ...} 编译为首尾相接的顺序组
+ * @details 所有类型共用波次的 spawn_interval / burst，下一组在上一组最后一批之后一个间隔出场；
+ *          轮换偏移接续上一组，起点的轮换顺序与逐个展开时相同。
+ */
+void compileEnemyTypes(const nlohmann::json& wave_json, float interval, int burst, WaveConfig& wave) {
+    if (!wave_json.contains("enemy_types") || !wave_json["enemy_types"].is_object()) {
+        return;
+    }
+
+    float delay = interval;
+    int offset = 1;
+    for (const auto& [name, count_json] : wave_json["enemy_types"].items()) {
+        if (!count_json.is_number_integer() || count_json.get<int>() <= 0) {
+            continue;
+        }
+        SpawnGroup group;
+        group.class_id_ = entt::hashed_string(name.c_str()).value();
+        group.count_ = count_json.get<int>();
+        group.delay_ = delay;
+        group.interval_ = interval;
+        group.burst_ = burst;
+        group.start_point_ = offset;
+        wave.groups_.push_back(group);
+
+        const int batches = (group.count_ + burst - 1) / burst;
+        delay += static_cast<float>(batches) * interval;
+        offset += group.count_;
+    }
+}
+
+/**
+ * @brief 新格式 "groups": [{"enemy", "count", "delay", "interval", "burst", "start_point"}]，各组并行出场
+ * @details 未填写的间隔与每批数量取波次的 spawn_interval / burst；填写 "start_point" 时固定从该起点出场，否则轮换全部起点。
+ */
+void compileGroups(const nlohmann::json& wave_json, float interval, int burst, WaveConfig& wave, const std::string& level_name) {
+    if (!wave_json.contains("groups") || !wave_json["groups"].is_array()) {
+        return;
+    }
+
+    for (const auto& group_json : wave_json["groups"]) {
+        const auto enemy = group_json.value("enemy", std::string{});
+        const int count = group_json.value("count", 0);
+        if (enemy.empty() || count <= 0) {
+            ENGINE_LOG_WARN("关卡 {} 的刷怪组缺少 enemy 或 count，已忽略", level_name);
+            continue;
+        }
+        SpawnGroup group;
+        group.class_id_ = entt::hashed_string(enemy.c_str()).value();
+        group.count_ = count;
+        group.delay_ = std::max(0.0f, group_json.value("delay", interval));
+        group.interval_ = std::max(0.1f, group_json.value("interval", interval));
+        group.burst_ = std::max(1, group_json.value("burst", burst));
+        if (const auto it = group_json.find("start_point"); it != group_json.end() && it->is_number_integer()) {
+            group.pattern_ = SpawnPattern::FIXED;
+            group.start_point_ = std::max(0, it->get<int>());
+        } else {
+            group.start_point_ = std::max(0, group_json.value("start_offset", 0));
+        }
+        wave.groups_.push_back(group);
+    }
+}
+} // namespace
+
+bool LevelConfig::load(std::string_view level_config_path, std::size_t level_index)
+{
+    const auto file = engine::io::VirtualFS::instance().read(level_config_path);
+    if (!file) {
+        ENGINE_LOG_ERROR("无法打开关卡配置文件: {}", level_config_path);
+        return false;
+    }
+
+    nlohmann::json config_json;
+    try {
+        config_json = nlohmann::json::parse(file->text());
+    }
+    catch (const std::exception& e) {
+        ENGINE_LOG_ERROR("解析关卡配置失败: {}", e.what());
+        return false;
+    }
+
+    if (!config_json.is_array() || config_json.empty()) {
+        ENGINE_LOG_ERROR("关卡配置文件为空或格式无效: {}", level_config_path);
+        return false;
+    }
+
+    level_index_ = level_index < config_json.size() ? level_index : 0;
+
+    const auto& level_json = config_json.at(level_index_);
+    name_ = level_json.value("name", name_);
+    map_path_ = level_json.value("map_path", map_path_);
+    prep_time_ = level_json.value("prep_time", prep_time_);
+    enemy_level_ = level_json.value("enemy_level", enemy_level_);
+    enemy_rarity_ = level_json.value("enemy_rarity", enemy_rarity_);
+    seed_.reset();
+    if (const auto it = level_json.find("seed"); it != level_json.end() && it->is_number_unsigned()) {
+        seed_ = it->get<std::uint64_t>();
+    }
+
+    navigation_ = game::defs::NavigationMode::WAYPOINT;
+    if (const auto navigation = level_json.value("navigation", std::string{ "waypoint" }); navigation == "flow_field") {
+        navigation_ = game::defs::NavigationMode::FLOW_FIELD;
+    } else if (navigation != "waypoint") {
+        ENGINE_LOG_WARN("关卡 {} 的导航方式 '{}' 无效，使用路径点导航", name_, navigation);
+    }
+    crowd_separation_ = level_json.value("crowd_separation", false);
+
+    endless_.reset();
+    if (const auto it = level_json.find("endless"); it != level_json.end() && it->is_object()) {
+        EndlessConfig endless;
+        endless.level_step_ = std::max(0, it->value("level_step", endless.level_step_));
+        endless.rarity_every_ = std::max(0, it->value("rarity_every", endless.rarity_every_));
+        endless.max_rarity_ = std::max(1, it->value("max_rarity", endless.max_rarity_));
+        endless.count_growth_ = std::max(0.0f, it->value("count_growth", endless.count_growth_));
+        endless.population_cap_ = std::max<std::size_t>(8, it->value("population_cap", endless.population_cap_));
+        endless.merge_factor_ = std::max(2, it->value("merge_factor", endless.merge_factor_));
+        endless.adaptive_cap_ = it->value("adaptive_cap", endless.adaptive_cap_);
+        endless_ = endless;
+    }
+
+    waves_.clear();
+    if (level_json.contains("waves") && level_json["waves"].is_array()) {
+        for (const auto& wave_json : level_json["waves"]) {
+            WaveConfig wave;
+            const float interval = std::max(0.1f, wave_json.value("spawn_interval", game::defs::WAVE_SPAWN_INTERVAL));
+            const int burst = std::max(1, wave_json.value("burst", 1));
+            wave.next_wave_interval_ = std::max(0.1f, wave_json.value("next_wave_interval", game::defs::WAVE_BREAK_DURATION));
+            compileEnemyTypes(wave_json, interval, burst, wave);
+            compileGroups(wave_json, interval, burst, wave, name_);
+            for (const auto& group : wave.groups_) {
+                wave.enemy_count_ += static_cast<std::size_t>(group.count_);
+            }
+
+            if (!wave.groups_.empty()) {
+                waves_.push_back(std::move(wave));
+            }
+        }
+    }
+
+    ENGINE_LOG_INFO("关卡配置加载完成: {} -> {}，波次数: {}", name_, map_path_, waves_.size());
+    return true;
+}
+
+} // namespace game::data
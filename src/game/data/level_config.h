@@ -0,0 +1,106 @@
+#pragma once
+
+#include <entt/entity/fwd.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../defs/constants.h"
+
+namespace game::data {
+
+/// @brief 刷怪组选择起点的方式
+enum class SpawnPattern : std::uint8_t {
+    ROUND_ROBIN,    ///< 依次轮换全部起点
+    FIXED,          ///< 总是从同一个起点出场
+};
+
+/**
+ * @brief 一个刷怪组：同一类型的敌人按固定间隔分批出场（游程编码，不逐个展开）
+ */
+struct SpawnGroup {
+    entt::id_type class_id_ = entt::null;
+    int count_ = 0;                                         ///< 敌人总数
+    float delay_ = game::defs::WAVE_SPAWN_INTERVAL;         ///< 波次开始到第一批出场的时间（秒）
+    float interval_ = game::defs::WAVE_SPAWN_INTERVAL;      ///< 两批之间的间隔（秒）
+    int burst_ = 1;                                         ///< 每批同时出场的敌人数
+    SpawnPattern pattern_ = SpawnPattern::ROUND_ROBIN;
+    int start_point_ = 0;   ///< FIXED：起点下标；ROUND_ROBIN：轮换的起始偏移（再加上波次序号）
+};
+
+/**
+ * @brief 单个波次的配置，加载时编译为若干刷怪组
+ * @details 各组按各自的 delay_ / interval_ 并行出场；旧格式 "enemy_types" 编译为首尾相接的顺序组。
+ */
+struct WaveConfig {
+    std::vector<SpawnGroup> groups_;
+    float next_wave_interval_ = game::defs::WAVE_BREAK_DURATION;
+    std::size_t enemy_count_ = 0;   ///< 全部组的敌人数之和
+};
+
+/**
+ * @brief 无尽模式参数（关卡的 "endless" 字段）：波次循环播放，每轮提升敌人等级、稀有度与数量，直到基地失守
+ * @details 存活敌人超过 population_cap_ 后，新出场的敌人每 merge_factor_ 只合并为一只精英；
+ *          达到 hardCap() 时不再生成新实体，整批并入已在场的敌人。
+ */
+struct EndlessConfig {
+    int level_step_ = 1;                ///< 每轮敌人等级的增量
+    int rarity_every_ = 3;              ///< 每隔几轮稀有度 +1（0 表示不提升）
+    int max_rarity_ = 5;                ///< 稀有度上限
+    float count_growth_ = 0.25f;        ///< 每轮各组敌人数相对第一轮增加的比例
+    std::size_t population_cap_ = 200;  ///< 存活敌人软上限
+    int merge_factor_ = 4;              ///< 超出软上限后几只敌人合并为一只精英
+    bool adaptive_cap_ = false;         ///< 帧预算已降到最低档仍超预算时临时收紧上限（与帧时间有关，回放不可复现；联机时忽略）
+
+    /// @brief 存活敌人的硬上限（软上限再加四分之一的精英余量）
+    [[nodiscard]] std::size_t hardCap() const { return population_cap_ + population_cap_ / 4; }
+};
+
+/**
+ * @brief 关卡配置（assets/data/level_config.json 中的一项）
+ *
+ * @details GameScene 与无头模拟共用，保证两者读取到相同的地图与波次数据。
+ */
+class LevelConfig final {
+public:
+    /**
+     * @brief 读取关卡配置
+     * @param level_config_path 配置文件路径
+     * @param level_index 关卡下标，越界时回退到第 0 关
+     * @return 读取成功返回 true
+     */
+    [[nodiscard]] bool load(std::string_view level_config_path, std::size_t level_index);
+
+    [[nodiscard]] std::size_t getLevelIndex() const { return level_index_; }
+    [[nodiscard]] const std::string& getName() const { return name_; }
+    [[nodiscard]] const std::string& getMapPath() const { return map_path_; }
+    [[nodiscard]] float getPrepTime() const { return prep_time_; }
+    [[nodiscard]] int getEnemyLevel() const { return enemy_level_; }
+    [[nodiscard]] int getEnemyRarity() const { return enemy_rarity_; }
+    [[nodiscard]] const std::vector<WaveConfig>& getWaves() const { return waves_; }
+    /// @brief 关卡固定的随机种子（"seed" 字段），未配置时由调用方自行决定（游戏内随机、无头模拟用默认值）
+    [[nodiscard]] std::optional<std::uint64_t> getSeed() const { return seed_; }
+    /// @brief 敌人的导航方式（"navigation": "waypoint" | "flow_field"，默认沿路径点）
+    [[nodiscard]] game::defs::NavigationMode getNavigation() const { return navigation_; }
+    /// @brief 是否启用敌人之间的分离（"crowd_separation" 字段，默认关闭）
+    [[nodiscard]] bool isCrowdSeparationEnabled() const { return crowd_separation_; }
+    /// @brief 无尽模式参数，未配置 "endless" 时为空
+    [[nodiscard]] const std::optional<EndlessConfig>& getEndless() const { return endless_; }
+
+private:
+    std::size_t level_index_ = 0;
+    std::string name_ = "Level 1";
+    std::string map_path_ = "assets/maps/level1.tmj";
+    float prep_time_ = 5.0f;
+    int enemy_level_ = 1;
+    int enemy_rarity_ = 1;
+    std::optional<std::uint64_t> seed_;
+    game::defs::NavigationMode navigation_ = game::defs::NavigationMode::WAYPOINT;
+    bool crowd_separation_ = false;
+    std::optional<EndlessConfig> endless_;
+    std::vector<WaveConfig> waves_;
+};
+
+} // namespace game::data
@@ -0,0 +1,45 @@
+#pragma once
+/**
+ * @file observable_stat.h
+ * @brief 定义 ObservableStat，值变化时才发布事件的整数统计项。
+ *
+ * @details
+ * HUD 展示的金币、波次、基地生命等都是整数，且绝大多数帧保持不变。ObservableStat 只在写入的值
+ * 与上次不同时在 SignalChannel 上发布 StatChanged<Type>，绑定的文本控件因此只在变化的那一帧重新格式化。
+ * 事件类型由模板参数在编译期确定，发布不装箱、不分配。初始值为 INT_MIN，保证第一次写入一定会发布。
+ */
+
+#include <limits>
+#include "../../engine/interface/signal_channel.h"
+
+namespace game::data {
+
+template <engine::interface::EventType Type>
+class ObservableStat final {
+public:
+    using Event = engine::interface::StatChanged<Type>;
+
+    /**
+     * @brief 写入新值，与当前值不同时发布事件
+     * @return 是否发生了变化
+     */
+    bool set(int value) {
+        if (value == value_) {
+            return false;
+        }
+        value_ = value;
+        channel_.publish(Event{ value_ });
+        return true;
+    }
+
+    [[nodiscard]] int get() const { return value_; }
+
+    /// @brief 值变化事件的连接入口
+    [[nodiscard]] auto onChanged() { return channel_.sink(); }
+
+private:
+    engine::interface::SignalChannel<Event> channel_;
+    int value_{ std::numeric_limits<int>::min() };
+};
+
+} // namespace game::data
@@ -0,0 +1,99 @@
+#include "path_table.h"
+
+#include <algorithm>
+#include <glm/geometric.hpp>
+#include <spdlog/spdlog.h>
+
+namespace game::data {
+
+void PathTable::clear() {
+    nodes_.clear();
+    segments_.clear();
+    id_to_index_.clear();
+}
+
+void PathTable::build(const std::unordered_map<int, WaypointNode>& waypoint_nodes) {
+    clear();
+
+    // 按ID排序，保证同一关卡每次编译出的下标一致
+    std::vector<int> ids;
+    ids.reserve(waypoint_nodes.size());
+    for (const auto& [id, node] : waypoint_nodes) {
+        ids.push_back(id);
+    }
+    std::sort(ids.begin(), ids.end());
+
+    nodes_.reserve(ids.size());
+    for (int id : ids) {
+        id_to_index_.emplace(id, static_cast<std::uint32_t>(nodes_.size()));
+        nodes_.push_back(PathNode{ id, waypoint_nodes.at(id).position_ });
+    }
+
+    for (auto& node : nodes_) {
+        node.first_segment_ = static_cast<std::uint32_t>(segments_.size());
+        for (int next_id : waypoint_nodes.at(node.id_).next_node_ids_) {
+            const auto next_index = indexOf(next_id);
+            if (next_index == INVALID_INDEX) {
+                spdlog::warn("路径点 {} 指向不存在的路径点 {}，已忽略", node.id_, next_id);
+                continue;
+            }
+            const glm::vec2 delta = nodes_[next_index].position_ - node.position_;
+            const float length = glm::length(delta);
+            const glm::vec2 direction = length > 0.0f ? delta / length : glm::vec2{ 0.0f };
+            segments_.push_back(PathSegment{ next_index, direction, length });
+        }
+        node.segment_count_ = static_cast<std::uint32_t>(segments_.size()) - node.first_segment_;
+    }
+
+    computeDistanceToHome();
+    spdlog::info("路径表编译完成: {} 个节点, {} 条路径段", nodes_.size(), segments_.size());
+}
+
+std::uint32_t PathTable::indexOf(int waypoint_id) const {
+    auto it = id_to_index_.find(waypoint_id);
+    return it != id_to_index_.end() ? it->second : INVALID_INDEX;
+}
+
+void PathTable::computeDistanceToHome() {
+    // 节点数量很少（数十个），直接用 O(N^2) 的 Dijkstra，从所有终点出发沿反向边松弛
+    constexpr float UNREACHABLE = std::numeric_limits<float>::max();
+    std::vector<bool> settled(nodes_.size(), false);
+    for (auto& node : nodes_) {
+        node.distance_to_home_ = node.segment_count_ == 0 ? 0.0f : UNREACHABLE;
+    }
+
+    for (std::size_t round = 0; round < nodes_.size(); ++round) {
+        // 选取尚未确定、且能以最短距离到达终点的节点
+        std::uint32_t best = INVALID_INDEX;
+        float best_distance = UNREACHABLE;
+        for (std::uint32_t i = 0; i < nodes_.size(); ++i) {
+            if (settled[i]) {
+                continue;
+            }
+            float distance = nodes_[i].distance_to_home_;
+            for (const auto& segment : getSegments(nodes_[i])) {
+                if (settled[segment.to_node_]) {
+                    distance = std::min(distance, segment.length_ + nodes_[segment.to_node_].distance_to_home_);
+                }
+            }
+            nodes_[i].distance_to_home_ = distance;
+            if (distance < best_distance) {
+                best = i;
+                best_distance = distance;
+            }
+        }
+        if (best == INVALID_INDEX) {
+            break;
+        }
+        settled[best] = true;
+    }
+
+    for (auto& node : nodes_) {
+        if (node.distance_to_home_ == UNREACHABLE) {
+            spdlog::warn("路径点 {} 无法到达终点", node.id_);
+            node.distance_to_home_ = 0.0f;
+        }
+    }
+}
+
+} // namespace game::data
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "waypoint_node.h"
+#include <glm/vec2.hpp>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace game::data {
+
+/**
+ * @brief 编译后的路径段：从所属节点指向 to_node_ 的一条有向边
+ */
+struct PathSegment {
+    std::uint32_t to_node_{0};      ///< 终点节点下标（PathTable 内部下标）
+    glm::vec2 direction_{0.0f};     ///< 单位方向向量
+    float length_{0.0f};            ///< 段长度
+};
+
+/**
+ * @brief 编译后的路径节点
+ */
+struct PathNode {
+    int id_{0};                         ///< 原始路径点ID
+    glm::vec2 position_{0.0f};
+    std::uint32_t first_segment_{0};    ///< 出边在 segments_ 中的起始下标
+    std::uint32_t segment_count_{0};    ///< 出边数量，0 表示终点
+    float distance_to_home_{0.0f};      ///< 沿最短路径到任一终点的距离
+};
+
+/**
+ * @brief 关卡加载时由路径点图编译出的扁平路径表
+ *
+ * @details
+ * 节点与出边都按下标连续存放，段方向与长度预先计算，FollowPathSystem 每帧只需查表与点积，
+ * 不再拷贝 WaypointNode 或做开方。distance_to_home_ 由终点反向求最短路得到，
+ * 可作为敌人“离基地还有多远”的目标优先级依据。
+ */
+class PathTable final {
+public:
+    static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * @brief 从路径点图构建路径表（指向不存在节点的连接会被忽略）
+     */
+    void build(const std::unordered_map<int, WaypointNode>& waypoint_nodes);
+
+    void clear();
+
+    /// @brief 原始路径点ID对应的节点下标，不存在时返回 INVALID_INDEX
+    [[nodiscard]] std::uint32_t indexOf(int waypoint_id) const;
+
+    [[nodiscard]] const PathNode& getNode(std::uint32_t index) const { return nodes_[index]; }
+    [[nodiscard]] const PathSegment& getSegment(std::uint32_t index) const { return segments_[index]; }
+    [[nodiscard]] std::span<const PathSegment> getSegments(const PathNode& node) const {
+        return { segments_.data() + node.first_segment_, node.segment_count_ };
+    }
+
+    [[nodiscard]] bool empty() const { return nodes_.empty(); }
+    [[nodiscard]] std::size_t getNodeCount() const { return nodes_.size(); }
+
+private:
+    void computeDistanceToHome();
+
+    std::vector<PathNode> nodes_;
+    std::vector<PathSegment> segments_;
+    std::unordered_map<int, std::uint32_t> id_to_index_;   ///< 仅在生成与初始化时使用
+};
+
+} // namespace game::data
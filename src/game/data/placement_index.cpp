@@ -0,0 +1,203 @@
+#include "placement_index.h"
+#include "../component/place_occupied_component.h"
+#include "../defs/tags.h"
+#include "../../engine/component/sprite_component.h"
+#include "../../engine/component/transform_component.h"
+#include <entt/entity/registry.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace game::data {
+
+void PlacementIndex::clear() {
+    slots_.clear();
+    cells_.clear();
+    origin_ = { 0.0f, 0.0f };
+    cols_ = 0;
+    rows_ = 0;
+    free_count_[MELEE] = 0;
+    free_count_[RANGED] = 0;
+    by_place_.clear();
+    by_occupant_.clear();
+    built_ = false;
+}
+
+void PlacementIndex::rebuild(const entt::registry& registry) {
+    clear();
+
+    // 中心点与 PlaceUnitSystem 放置单位的位置相同
+    auto collect = [&](auto view, std::size_t kind) {
+        for (auto entity : view) {
+            const auto* sprite = registry.try_get<engine::component::SpriteComponent>(entity);
+            const glm::vec2 center = view.template get<engine::component::TransformComponent>(entity).position_ +
+                                     (sprite ? (sprite->size_ * 0.5f) : glm::vec2{ 32.0f, 32.0f });
+            const auto* occupied = registry.try_get<game::component::PlaceOccupiedComponent>(entity);
+            slots_.push_back({ entity, center, kind, occupied ? occupied->occupied_by_ : entt::null });
+        }
+    };
+    collect(registry.view<game::defs::MeleePlaceTag, engine::component::TransformComponent>(), MELEE);
+    collect(registry.view<game::defs::RangePlaceTag, engine::component::TransformComponent>(), RANGED);
+    built_ = true;
+    if (slots_.empty()) {
+        return;
+    }
+
+    glm::vec2 min_corner{ std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+    glm::vec2 max_corner{ std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+    for (const auto& slot : slots_) {
+        min_corner = { std::min(min_corner.x, slot.center_.x), std::min(min_corner.y, slot.center_.y) };
+        max_corner = { std::max(max_corner.x, slot.center_.x), std::max(max_corner.y, slot.center_.y) };
+    }
+    const float radius = game::defs::PLACE_RADIUS;
+    origin_ = { min_corner.x - radius, min_corner.y - radius };
+    cols_ = static_cast<int>((max_corner.x + radius - origin_.x) / CELL_SIZE) + 1;
+    rows_ = static_cast<int>((max_corner.y + radius - origin_.y) / CELL_SIZE) + 1;
+    cells_.resize(static_cast<std::size_t>(cols_) * static_cast<std::size_t>(rows_));
+
+    by_place_.reserve(slots_.size());
+    for (std::uint32_t index = 0; index < slots_.size(); ++index) {
+        const auto& slot = slots_[index];
+        by_place_[slot.place_] = index;
+        if (slot.occupant_ == entt::null) {
+            insertFree(index);
+        } else {
+            by_occupant_[slot.occupant_] = index;
+        }
+    }
+}
+
+template<typename Fn>
+void PlacementIndex::forEachCoveredCell(const Slot& slot, Fn&& fn) {
+    const float radius = game::defs::PLACE_RADIUS;
+    const int x0 = std::clamp(static_cast<int>(std::floor((slot.center_.x - radius - origin_.x) / CELL_SIZE)), 0, cols_ - 1);
+    const int x1 = std::clamp(static_cast<int>(std::floor((slot.center_.x + radius - origin_.x) / CELL_SIZE)), 0, cols_ - 1);
+    const int y0 = std::clamp(static_cast<int>(std::floor((slot.center_.y - radius - origin_.y) / CELL_SIZE)), 0, rows_ - 1);
+    const int y1 = std::clamp(static_cast<int>(std::floor((slot.center_.y + radius - origin_.y) / CELL_SIZE)), 0, rows_ - 1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            fn(cells_[static_cast<std::size_t>(y) * static_cast<std::size_t>(cols_) + static_cast<std::size_t>(x)]);
+        }
+    }
+}
+
+void PlacementIndex::insertFree(std::uint32_t slot_index) {
+    const auto& slot = slots_[slot_index];
+    forEachCoveredCell(slot, [&](Cell& cell) {
+        // 保持槽位下标升序，同距离时结果与占用 / 释放的先后无关
+        auto& list = cell.free_[slot.kind_];
+        list.insert(std::lower_bound(list.begin(), list.end(), slot_index), slot_index);
+    });
+    ++free_count_[slot.kind_];
+}
+
+void PlacementIndex::eraseFree(std::uint32_t slot_index) {
+    const auto& slot = slots_[slot_index];
+    forEachCoveredCell(slot, [&](Cell& cell) {
+        auto& list = cell.free_[slot.kind_];
+        if (const auto it = std::lower_bound(list.begin(), list.end(), slot_index); it != list.end() && *it == slot_index) {
+            list.erase(it);
+        }
+    });
+    --free_count_[slot.kind_];
+}
+
+const PlacementIndex::Cell* PlacementIndex::cellAt(const glm::vec2& position) const {
+    if (cells_.empty()) {
+        return nullptr;
+    }
+    const float fx = std::floor((position.x - origin_.x) / CELL_SIZE);
+    const float fy = std::floor((position.y - origin_.y) / CELL_SIZE);
+    if (!(fx >= 0.0f && fy >= 0.0f && fx < static_cast<float>(cols_) && fy < static_cast<float>(rows_))) {
+        return nullptr;
+    }
+    return &cells_[static_cast<std::size_t>(fy) * static_cast<std::size_t>(cols_) + static_cast<std::size_t>(fx)];
+}
+
+entt::entity PlacementIndex::findNearest(const glm::vec2& position, game::defs::PlayerType type) const {
+    const auto* cell = cellAt(position);
+    if (!cell) {
+        return entt::null;
+    }
+
+    const float radius_sq = game::defs::PLACE_RADIUS * game::defs::PLACE_RADIUS;
+    std::uint32_t best = std::numeric_limits<std::uint32_t>::max();
+    float best_distance_sq = std::numeric_limits<float>::max();
+    auto consider = [&](std::size_t kind) {
+        for (const auto index : cell->free_[kind]) {
+            const glm::vec2 offset = slots_[index].center_ - position;
+            const float distance_sq = offset.x * offset.x + offset.y * offset.y;
+            if (distance_sq > radius_sq) {
+                continue;
+            }
+            if (distance_sq < best_distance_sq || (distance_sq == best_distance_sq && index < best)) {
+                best_distance_sq = distance_sq;
+                best = index;
+            }
+        }
+    };
+    switch (type) {
+    case game::defs::PlayerType::MELEE:
+        consider(MELEE);
+        break;
+    case game::defs::PlayerType::RANGED:
+        consider(RANGED);
+        break;
+    case game::defs::PlayerType::MIXED:
+    default:
+        consider(MELEE);
+        consider(RANGED);
+        break;
+    }
+    return best < slots_.size() ? slots_[best].place_ : entt::null;
+}
+
+bool PlacementIndex::getCenter(entt::entity place, glm::vec2& center) const {
+    const auto it = by_place_.find(place);
+    if (it == by_place_.end()) {
+        return false;
+    }
+    center = slots_[it->second].center_;
+    return true;
+}
+
+void PlacementIndex::occupy(entt::entity place, entt::entity occupant) {
+    const auto it = by_place_.find(place);
+    if (it == by_place_.end()) {
+        return;
+    }
+    auto& slot = slots_[it->second];
+    if (slot.occupant_ != entt::null) {
+        by_occupant_.erase(slot.occupant_);
+    } else {
+        eraseFree(it->second);
+    }
+    slot.occupant_ = occupant;
+    by_occupant_[occupant] = it->second;
+}
+
+entt::entity PlacementIndex::release(entt::entity occupant) {
+    const auto it = by_occupant_.find(occupant);
+    if (it == by_occupant_.end()) {
+        return entt::null;
+    }
+    const auto index = it->second;
+    by_occupant_.erase(it);
+    slots_[index].occupant_ = entt::null;
+    insertFree(index);
+    return slots_[index].place_;
+}
+
+std::size_t PlacementIndex::freeCount(game::defs::PlayerType type) const {
+    switch (type) {
+    case game::defs::PlayerType::MELEE:
+        return free_count_[MELEE];
+    case game::defs::PlayerType::RANGED:
+        return free_count_[RANGED];
+    case game::defs::PlayerType::MIXED:
+    default:
+        return free_count_[MELEE] + free_count_[RANGED];
+    }
+}
+
+} // namespace game::data
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../defs/constants.h"
+#include <entt/entity/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include <glm/vec2.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace game::data {
+
+/**
+ * @brief 建造位的增量索引：按网格格子保存近战 / 远程各自的空闲建造位，由 PlaceUnitSystem 持有
+ *
+ * @details
+ * 格子边长为放置判定半径的两倍，每个建造位登记在其判定圆外接正方形覆盖的格子里（至多 4 个），
+ * 因此悬停查询只读鼠标所在的一个格子。占用与释放只改动该建造位所在格子的空闲列表，
+ * 占用者到建造位的映射使单位死亡时的释放不必遍历全部建造位。
+ * 建造位在关卡加载后不再增减；回退检查点等整体替换注册表内容的操作之后调用 rebuild()。
+ */
+class PlacementIndex final {
+public:
+    /// @brief 按注册表中的建造位（MeleePlaceTag / RangePlaceTag）与 PlaceOccupiedComponent 重建
+    void rebuild(const entt::registry& registry);
+
+    /// @brief 清空，下一次使用前需要重建
+    void clear();
+
+    [[nodiscard]] bool isBuilt() const { return built_; }
+
+    /**
+     * @brief 判定半径内（闭区间）离 position 最近的空闲建造位
+     * @param type 出击单位类型；MIXED 同时查找近战与远程建造位
+     * @return 建造位实体，没有时为 entt::null（同距离取登记在前者）
+     */
+    [[nodiscard]] entt::entity findNearest(const glm::vec2& position, game::defs::PlayerType type) const;
+
+    /// @brief 建造位的中心点（单位放置的位置），未登记时返回 false
+    bool getCenter(entt::entity place, glm::vec2& center) const;
+
+    /// @brief 标记建造位被 occupant 占用，从空闲列表中移除
+    void occupy(entt::entity place, entt::entity occupant);
+
+    /**
+     * @brief 释放 occupant 占用的建造位，放回空闲列表
+     * @return 被释放的建造位，occupant 未占用建造位时为 entt::null
+     */
+    entt::entity release(entt::entity occupant);
+
+    /// @brief 空闲的建造位数（MIXED 为两类之和）
+    [[nodiscard]] std::size_t freeCount(game::defs::PlayerType type) const;
+
+private:
+    static constexpr float CELL_SIZE = game::defs::PLACE_RADIUS * 2.0f;
+    static constexpr std::size_t MELEE = 0;
+    static constexpr std::size_t RANGED = 1;
+
+    struct Slot {
+        entt::entity place_{ entt::null };
+        glm::vec2 center_{ 0.0f, 0.0f };
+        std::size_t kind_{ MELEE };                     ///< MELEE / RANGED
+        entt::entity occupant_{ entt::null };
+    };
+
+    /// @brief 一个格子中两类建造位各自的空闲槽位（槽位下标）
+    struct Cell {
+        std::vector<std::uint32_t> free_[2];
+    };
+
+    void addSlot(entt::entity place, const glm::vec2& center, std::size_t kind, entt::entity occupant);
+    /// @brief 对槽位判定圆覆盖的每个格子调用 fn(cell)
+    template<typename Fn>
+    void forEachCoveredCell(const Slot& slot, Fn&& fn);
+    void insertFree(std::uint32_t slot_index);
+    void eraseFree(std::uint32_t slot_index);
+    [[nodiscard]] const Cell* cellAt(const glm::vec2& position) const;
+
+    std::vector<Slot> slots_;
+    std::vector<Cell> cells_;
+    glm::vec2 origin_{ 0.0f, 0.0f };
+    int cols_ = 0;
+    int rows_ = 0;
+    std::size_t free_count_[2]{ 0, 0 };
+    std::unordered_map<entt::entity, std::uint32_t> by_place_;
+    std::unordered_map<entt::entity, std::uint32_t> by_occupant_;
+    bool built_ = false;
+};
+
+} // namespace game::data
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <entt/entity/entity.hpp>
+#include <glm/vec2.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace game::data {
+
+/// @brief PositionCache 的分类
+enum class PositionCategory : std::uint8_t {
+    ENEMY,          ///< 存活的敌方单位
+    PLAYER,         ///< 存活的玩家单位
+    INJURED,        ///< 受伤的玩家单位（治疗目标候选，behavior_flag::INJURED）
+    COUNT
+};
+
+/**
+ * @brief 一类实体的位置（SoA：x_[i], y_[i], entity_[i] 为同一实体），可直接交给 engine::utils 的批量距离函数
+ * @details 重建后被销毁或占用的实体不移动其余条目，只把坐标置为 NaN、实体置空：NaN 与任何半径比较都为假，
+ *          批量距离函数自然跳过，下标也保持稳定。
+ */
+struct PositionSet {
+    std::vector<float> x_;
+    std::vector<float> y_;
+    std::vector<entt::entity> entity_;
+
+    [[nodiscard]] std::size_t size() const { return entity_.size(); }
+    [[nodiscard]] bool empty() const { return entity_.empty(); }
+
+    void clear() {
+        x_.clear();
+        y_.clear();
+        entity_.clear();
+    }
+
+    void push(entt::entity entity, const glm::vec2& position) {
+        x_.push_back(position.x);
+        y_.push_back(position.y);
+        entity_.push_back(entity);
+    }
+
+    /// @brief 使第 index 个条目失效（坐标置为 NaN，实体置空）
+    void invalidate(std::size_t index) {
+        x_[index] = std::numeric_limits<float>::quiet_NaN();
+        y_[index] = std::numeric_limits<float>::quiet_NaN();
+        entity_[index] = entt::null;
+    }
+
+    /// @brief 使所有满足 pred(entity) 的条目失效
+    template<typename Pred>
+    void invalidateIf(Pred&& pred) {
+        for (std::size_t i = 0; i < entity_.size(); ++i) {
+            if (entity_[i] != entt::null && pred(entity_[i])) {
+                invalidate(i);
+            }
+        }
+    }
+};
+
+/**
+ * @brief 每个模拟步在 MovementSystem 之后重建的分类位置镜像，放在 registry.ctx() 中
+ *
+ * @details
+ * 由 SpatialIndexSystem 与空间网格在同一次遍历中重建。之后本步（以及下一步 MovementSystem 之前）
+ * 的索敌、出击选位等只读这里的连续数组，不再经 TransformComponent 的稀疏集合间接访问。
+ * 重建之后的变化只以「失效」的形式反映：RemoveDeadSystem 销毁的实体；新出现的单位在下一次重建时加入。
+ * 空闲建造位不在这里，由 PlaceUnitSystem 的 PlacementIndex 增量维护。
+ */
+class PositionCache {
+public:
+    [[nodiscard]] PositionSet& get(PositionCategory category) { return sets_[static_cast<std::size_t>(category)]; }
+    [[nodiscard]] const PositionSet& get(PositionCategory category) const { return sets_[static_cast<std::size_t>(category)]; }
+
+    /// @brief 清空所有分类，开始重建
+    void beginBuild() {
+        for (auto& set : sets_) {
+            set.clear();
+        }
+        built_ = true;
+    }
+
+    /// @brief 是否已重建过（场景刚创建、尚未执行模拟步时为 false，使用方退回直接读注册表）
+    [[nodiscard]] bool isBuilt() const { return built_; }
+
+    /// @brief 在所有分类中使满足 pred(entity) 的条目失效
+    template<typename Pred>
+    void invalidateIf(Pred&& pred) {
+        for (auto& set : sets_) {
+            set.invalidateIf(pred);
+        }
+    }
+
+    /// @brief 在一个分类中使 entity 的条目失效
+    void invalidate(PositionCategory category, entt::entity entity) {
+        get(category).invalidateIf([entity](entt::entity other) { return other == entity; });
+    }
+
+private:
+    std::array<PositionSet, static_cast<std::size_t>(PositionCategory::COUNT)> sets_;
+    bool built_{false};
+};
+
+} // namespace game::data
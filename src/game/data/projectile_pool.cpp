@@ -0,0 +1,106 @@
+#include "projectile_pool.h"
+
+namespace game::data {
+
+namespace {
+template <typename T>
+void swapRemove(std::vector<T>& values, std::size_t index) {
+    values[index] = values.back();
+    values.pop_back();
+}
+} // namespace
+
+const ProjectileKind* ProjectilePool::findKind(entt::id_type projectile_id) const {
+    const auto it = kinds_.find(projectile_id);
+    return it != kinds_.end() ? &it->second : nullptr;
+}
+
+std::size_t ProjectilePool::spawn(const ProjectileLaunch& launch) {
+    x_.push_back(launch.origin_.x);
+    y_.push_back(launch.origin_.y);
+    prev_x_.push_back(launch.origin_.x);
+    prev_y_.push_back(launch.origin_.y);
+    vx_.push_back(launch.velocity_.x);
+    vy_.push_back(launch.velocity_.y);
+    life_.push_back(launch.lifetime_);
+    damage_.push_back(launch.damage_);
+    hit_radius_.push_back(launch.hit_radius_);
+    mask_.push_back(launch.mask_);
+    pierce_.push_back(launch.pierce_);
+    attacker_.push_back(launch.attacker_);
+    visual_.push_back(launch.visual_);
+    last_hit_.push_back(entt::null);
+    return x_.size() - 1;
+}
+
+void ProjectilePool::integrate(float delta_time) {
+    const std::size_t count = x_.size();
+    float* x = x_.data();
+    float* y = y_.data();
+    float* prev_x = prev_x_.data();
+    float* prev_y = prev_y_.data();
+    const float* vx = vx_.data();
+    const float* vy = vy_.data();
+    float* life = life_.data();
+    // 各数组互不重叠，逐元素运算没有跨迭代依赖
+    for (std::size_t i = 0; i < count; ++i) {
+        prev_x[i] = x[i];
+        prev_y[i] = y[i];
+        x[i] += vx[i] * delta_time;
+        y[i] += vy[i] * delta_time;
+        life[i] -= delta_time;
+    }
+}
+
+void ProjectilePool::remove(std::size_t index) {
+    swapRemove(x_, index);
+    swapRemove(y_, index);
+    swapRemove(prev_x_, index);
+    swapRemove(prev_y_, index);
+    swapRemove(vx_, index);
+    swapRemove(vy_, index);
+    swapRemove(life_, index);
+    swapRemove(damage_, index);
+    swapRemove(hit_radius_, index);
+    swapRemove(mask_, index);
+    swapRemove(pierce_, index);
+    swapRemove(attacker_, index);
+    swapRemove(visual_, index);
+    swapRemove(last_hit_, index);
+}
+
+void ProjectilePool::clear() {
+    x_.clear();
+    y_.clear();
+    prev_x_.clear();
+    prev_y_.clear();
+    vx_.clear();
+    vy_.clear();
+    life_.clear();
+    damage_.clear();
+    hit_radius_.clear();
+    mask_.clear();
+    pierce_.clear();
+    attacker_.clear();
+    visual_.clear();
+    last_hit_.clear();
+}
+
+void ProjectilePool::reserve(std::size_t count) {
+    x_.reserve(count);
+    y_.reserve(count);
+    prev_x_.reserve(count);
+    prev_y_.reserve(count);
+    vx_.reserve(count);
+    vy_.reserve(count);
+    life_.reserve(count);
+    damage_.reserve(count);
+    hit_radius_.reserve(count);
+    mask_.reserve(count);
+    pierce_.reserve(count);
+    attacker_.reserve(count);
+    visual_.reserve(count);
+    last_hit_.reserve(count);
+}
+
+} // namespace game::data
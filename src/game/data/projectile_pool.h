@@ -0,0 +1,88 @@
+#pragma once
+
+#include <entt/core/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include <glm/vec2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace game::data {
+
+/// @brief 一种模拟投射物的飞行参数（来自投射物蓝图的 "simulated" 字段）
+struct ProjectileKind {
+    float speed_{ 600.0f };         ///< 飞行速度（像素/秒）
+    float hit_radius_{ 8.0f };      ///< 命中判定半径（再加上目标的 UNIT_RADIUS）
+    int pierce_{ 0 };               ///< 命中后还能继续穿透的目标数
+    float lifetime_{ 1.5f };        ///< 最长飞行时间（秒），到时未命中即落空
+};
+
+/// @brief 发射一枚投射物所需的全部数据
+struct ProjectileLaunch {
+    entt::entity attacker_{ entt::null };
+    entt::entity visual_{ entt::null };     ///< 跟随的视觉实体（可为空，命中时停用）
+    glm::vec2 origin_{ 0.0f };
+    glm::vec2 velocity_{ 0.0f };
+    float damage_{ 0.0f };
+    float hit_radius_{ 0.0f };
+    float lifetime_{ 0.0f };
+    std::uint32_t mask_{ 0 };               ///< 可命中的空间图层（spatial_layer）
+    int pierce_{ 0 };
+};
+
+/**
+ * @brief 飞行中的模拟投射物（SoA），放在 registry.ctx() 中，不占用注册表实体
+ *
+ * @details
+ * 每枚投射物的各字段分别存放在连续数组中，第 i 个元素属于同一枚投射物。数组保持紧凑：
+ * 移除时与末尾交换，积分循环 integrate() 只是几条同长度 float 数组上的逐元素运算，
+ * 编译器可直接向量化，数千枚同时飞行也只是几次顺序扫描。
+ * 每步积分前的位置保存在 prev_x_ / prev_y_ 中，与当前位置构成本步扫过的线段，供 ProjectileSystem 做扫掠命中判定。
+ *
+ * 飞行参数按投射物ID登记（registerKind），AnimationEventsSystem 据此决定攻击是立即命中还是发射模拟投射物。
+ */
+class ProjectilePool final {
+public:
+    void registerKind(entt::id_type projectile_id, const ProjectileKind& kind) { kinds_[projectile_id] = kind; }
+    /// @brief 投射物ID的飞行参数，不是模拟投射物时返回 nullptr
+    [[nodiscard]] const ProjectileKind* findKind(entt::id_type projectile_id) const;
+
+    /// @brief 发射一枚投射物，返回其下标（在下一次 remove() 之前有效）
+    std::size_t spawn(const ProjectileLaunch& launch);
+
+    /// @brief 所有投射物前进一步：记录上一位置、推进位置、扣减剩余时间
+    void integrate(float delta_time);
+
+    /// @brief 移除第 index 枚投射物（与末尾交换，末尾的投射物换到 index）
+    void remove(std::size_t index);
+
+    /// @brief 清空飞行中的投射物（保留已登记的飞行参数）
+    void clear();
+
+    void reserve(std::size_t count);
+
+    [[nodiscard]] std::size_t size() const { return x_.size(); }
+    [[nodiscard]] bool empty() const { return x_.empty(); }
+
+    // --- 各字段数组（下标为投射物下标） ---
+    std::vector<float> x_;
+    std::vector<float> y_;
+    std::vector<float> prev_x_;
+    std::vector<float> prev_y_;
+    std::vector<float> vx_;
+    std::vector<float> vy_;
+    std::vector<float> life_;               ///< 剩余飞行时间（秒），不大于 0 时落空
+    std::vector<float> damage_;
+    std::vector<float> hit_radius_;
+    std::vector<std::uint32_t> mask_;
+    std::vector<int> pierce_;               ///< 剩余穿透数，为负时移除
+    std::vector<entt::entity> attacker_;
+    std::vector<entt::entity> visual_;
+    std::vector<entt::entity> last_hit_;    ///< 最近命中的目标，穿透时不在相邻两步重复命中同一目标
+
+private:
+    std::unordered_map<entt::id_type, ProjectileKind> kinds_;
+};
+
+} // namespace game::data
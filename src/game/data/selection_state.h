@@ -1,11 +1,13 @@
 #pragma once
 
 #include <entt/entity/entity.hpp>
+#include <glm/vec2.hpp>
 
 namespace game::data {
 
 struct SelectionState {
-    entt::entity hovered_unit_{ entt::null };
+    glm::vec2 mouse_world_{ 0.0f, 0.0f };          ///< 本帧鼠标的世界坐标（SelectionSystem 每帧换算一次）
+    entt::entity hovered_unit_{ entt::null };      ///< 鼠标下的单位，鼠标、相机与空间网格都未变时沿用上一帧
     entt::entity selected_unit_{ entt::null };
     entt::id_type hovered_portrait_name_id_{ 0 };
 };
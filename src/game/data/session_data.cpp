@@ -3,6 +3,8 @@
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
+#include "../../engine/io/binary_archive.h"
+#include "../../engine/io/save_service.h"
 #include "../../engine/utils/logging.h"
 
 namespace game::data {
@@ -44,4 +46,79 @@ bool SessionData::load(std::string_view session_json_path)
     return true;
 }
 
+bool SessionData::loadSave(const std::string& save_path)
+{
+    std::string error_message;
+    auto content = engine::io::readSaveFile(save_path, SESSION_SAVE_KIND, error_message);
+    if (!content) {
+        ENGINE_LOG_ERROR("读取存档失败: {}", error_message);
+        return false;
+    }
+    if (content->schema_ != SESSION_SAVE_SCHEMA) {
+        ENGINE_LOG_ERROR("存档内容版本不受支持: {} (schema={})", save_path, content->schema_);
+        return false;
+    }
+    if (!decodeSave(content->payload_)) {
+        ENGINE_LOG_ERROR("存档内容损坏: {}", save_path);
+        return false;
+    }
+    ENGINE_LOG_INFO("SessionData 读取存档完成: units={}, level={}, point={}, clear={}", unit_map_.size(), level_, point_, level_clear_);
+    return true;
+}
+
+std::vector<std::byte> SessionData::encodeSave(int level, int point, bool level_clear) const
+{
+    std::vector<std::byte> payload;
+    engine::io::BinaryOutputArchive output{ payload };
+    output(static_cast<std::int32_t>(level));
+    output(static_cast<std::int32_t>(point));
+    output(static_cast<std::uint8_t>(level_clear ? 1 : 0));
+    output(static_cast<std::uint32_t>(unit_map_.size()));
+    for (const auto& [name_id, unit] : unit_map_) {
+        output.string(unit.name_);
+        output.string(unit.class_name_);
+        output(static_cast<std::int32_t>(unit.level_));
+        output(static_cast<std::int32_t>(unit.rarity_));
+    }
+    return payload;
+}
+
+bool SessionData::decodeSave(std::span<const std::byte> payload)
+{
+    engine::io::BinaryInputArchive input{ payload };
+    std::int32_t level = 0;
+    std::int32_t point = 0;
+    std::uint8_t level_clear = 0;
+    std::uint32_t unit_count = 0;
+    input(level);
+    input(point);
+    input(level_clear);
+    input(unit_count);
+
+    std::unordered_map<entt::id_type, UnitData> unit_map;
+    for (std::uint32_t i = 0; i < unit_count && input.ok(); ++i) {
+        UnitData unit;
+        std::int32_t unit_level = 1;
+        std::int32_t unit_rarity = 1;
+        input.string(unit.name_);
+        input.string(unit.class_name_);
+        input(unit_level);
+        input(unit_rarity);
+        unit.name_id_ = entt::hashed_string::value(unit.name_.data(), unit.name_.size());
+        unit.class_id_ = entt::hashed_string::value(unit.class_name_.data(), unit.class_name_.size());
+        unit.level_ = unit_level;
+        unit.rarity_ = unit_rarity;
+        unit_map[unit.name_id_] = std::move(unit);
+    }
+    if (!input.ok() || !input.done()) {
+        return false;
+    }
+
+    unit_map_ = std::move(unit_map);
+    level_ = level;
+    point_ = point;
+    level_clear_ = level_clear != 0;
+    return true;
+}
+
 } // namespace game::data
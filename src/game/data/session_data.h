@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <entt/core/hashed_string.hpp>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace game::data {
 
@@ -15,10 +19,25 @@ struct UnitData {
     int rarity_{ 1 };
 };
 
+inline constexpr entt::id_type SESSION_SAVE_KIND = entt::hashed_string::value("session");     ///< .mwsav 内容类型
+inline constexpr std::uint32_t SESSION_SAVE_SCHEMA = 1;
+
 class SessionData final {
 public:
     [[nodiscard]] bool load(std::string_view session_json_path);
 
+    /// @brief 读取二进制会话存档（.mwsav），校验失败时保持原数据不变
+    [[nodiscard]] bool loadSave(const std::string& save_path);
+
+    /**
+     * @brief 把当前单位表与给定的关卡进度编码为存档负载（交给 engine::io::SaveService）
+     * @param level 从 1 开始的关卡号
+     */
+    [[nodiscard]] std::vector<std::byte> encodeSave(int level, int point, bool level_clear) const;
+
+    /// @brief 解码 encodeSave() 的负载，失败时保持原数据不变
+    [[nodiscard]] bool decodeSave(std::span<const std::byte> payload);
+
     [[nodiscard]] const std::unordered_map<entt::id_type, UnitData>& getUnitMap() const { return unit_map_; }
     [[nodiscard]] int getLevel() const { return level_; }
     [[nodiscard]] int getPoint() const { return point_; }
@@ -0,0 +1,199 @@
+#include "session_telemetry.h"
+#include "../../engine/io/save_service.h"
+#include "../../engine/utils/logging.h"
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <iterator>
+#include <utility>
+#include <nlohmann/json.hpp>
+
+namespace game::data {
+
+namespace {
+
+/// @brief 已排序数组的分位数（最近秩）
+double percentile(const std::vector<float>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<std::size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+    return static_cast<double>(sorted[std::min(rank, sorted.size() - 1)]);
+}
+
+std::vector<std::byte> toBytes(const std::string& text) {
+    const auto* begin = reinterpret_cast<const std::byte*>(text.data());
+    return std::vector<std::byte>(begin, begin + text.size());
+}
+
+} // namespace
+
+void SessionTelemetry::begin(std::string level_name, std::size_t level_index, double load_ms,
+                             const engine::resource::TextureCacheStats& texture_stats) {
+    level_name_ = std::move(level_name);
+    level_index_ = level_index;
+    load_ms_ = load_ms;
+    texture_start_ = texture_stats;
+    started_at_ = std::chrono::system_clock::now();
+    waves_.clear();
+    current_ = nullptr;
+    active_ = true;
+    setWave(0);
+}
+
+void SessionTelemetry::setWave(int wave) {
+    if (!active_ || (current_ && current_->wave_ == wave)) {
+        return;
+    }
+    auto it = std::ranges::find(waves_, wave, &Wave::wave_);
+    if (it == waves_.end()) {
+        waves_.push_back(Wave{ wave });
+        it = std::prev(waves_.end());
+    }
+    current_ = &*it;
+}
+
+void SessionTelemetry::recordFrame(double frame_ms, double sim_ms, double render_ms, std::size_t entities) {
+    if (!current_) {
+        return;
+    }
+    auto& wave = *current_;
+    wave.frame_ms_.push_back(static_cast<float>(frame_ms));
+    wave.sim_ms_sum_ += sim_ms;
+    wave.render_ms_sum_ += render_ms;
+    wave.sim_ms_max_ = std::max(wave.sim_ms_max_, static_cast<float>(sim_ms));
+    wave.render_ms_max_ = std::max(wave.render_ms_max_, static_cast<float>(render_ms));
+    wave.peak_entities_ = std::max(wave.peak_entities_, entities);
+}
+
+SessionTelemetry::WaveSummary SessionTelemetry::summarize(Wave& wave) {
+    WaveSummary summary;
+    summary.wave_ = wave.wave_;
+    summary.frames_ = wave.frame_ms_.size();
+    summary.peak_entities_ = wave.peak_entities_;
+    if (summary.frames_ == 0) {
+        return summary;
+    }
+    const double frames = static_cast<double>(summary.frames_);
+    for (const float ms : wave.frame_ms_) {
+        summary.seconds_ += static_cast<double>(ms) / 1000.0;
+    }
+    // 原始数组写出后不再使用，直接原位排序
+    std::ranges::sort(wave.frame_ms_);
+    summary.p50_ms_ = percentile(wave.frame_ms_, 0.50);
+    summary.p95_ms_ = percentile(wave.frame_ms_, 0.95);
+    summary.p99_ms_ = percentile(wave.frame_ms_, 0.99);
+    summary.max_ms_ = static_cast<double>(wave.frame_ms_.back());
+    summary.sim_avg_ms_ = wave.sim_ms_sum_ / frames;
+    summary.sim_max_ms_ = static_cast<double>(wave.sim_ms_max_);
+    summary.render_avg_ms_ = wave.render_ms_sum_ / frames;
+    summary.render_max_ms_ = static_cast<double>(wave.render_ms_max_);
+    return summary;
+}
+
+bool SessionTelemetry::write(const std::string& directory, std::span<const engine::ecs::EventChannelStats> events,
+                             const engine::resource::TextureCacheStats& texture_stats) {
+    if (!active_) {
+        return false;
+    }
+    active_ = false;
+    current_ = nullptr;
+    std::size_t frames = 0;
+    for (const auto& wave : waves_) {
+        frames += wave.frame_ms_.size();
+    }
+    if (frames == 0 || directory.empty()) {
+        return false;
+    }
+
+    std::vector<WaveSummary> summaries;
+    summaries.reserve(waves_.size());
+    for (auto& wave : waves_) {
+        if (!wave.frame_ms_.empty()) {
+            summaries.push_back(summarize(wave));
+        }
+    }
+    std::ranges::sort(summaries, {}, &WaveSummary::wave_);
+
+    engine::resource::TextureCacheStats texture;
+    texture.lookups_ = texture_stats.lookups_ - texture_start_.lookups_;
+    texture.sync_loads_ = texture_stats.sync_loads_ - texture_start_.sync_loads_;
+    texture.async_misses_ = texture_stats.async_misses_ - texture_start_.async_misses_;
+
+    const auto since_epoch = started_at_.time_since_epoch();
+    const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch).count() % 1000;
+    const std::string stem = std::format("{:%Y%m%d_%H%M%S}_{:03}_level{}",
+        std::chrono::floor<std::chrono::seconds>(started_at_), millis, level_index_ + 1);
+    const auto base = std::filesystem::path(directory) / stem;
+
+    auto& saves = engine::io::SaveService::instance();
+    saves.submitRaw(base.string() + ".json", toBytes(buildJson(summaries, events, texture)));
+    saves.submitRaw(base.string() + ".csv", toBytes(buildCsv(summaries)));
+    ENGINE_LOG_INFO("性能遥测已提交: {}.json / .csv（{} 帧，{} 波）", base.string(), frames, summaries.size());
+    waves_.clear();
+    return true;
+}
+
+std::string SessionTelemetry::buildJson(const std::vector<WaveSummary>& waves, std::span<const engine::ecs::EventChannelStats> events,
+                                        const engine::resource::TextureCacheStats& texture) const {
+    double seconds = 0.0;
+    std::size_t peak_entities = 0;
+    nlohmann::json wave_array = nlohmann::json::array();
+    for (const auto& wave : waves) {
+        seconds += wave.seconds_;
+        peak_entities = std::max(peak_entities, wave.peak_entities_);
+        wave_array.push_back({
+            {"wave", wave.wave_},
+            {"frames", wave.frames_},
+            {"seconds", wave.seconds_},
+            {"frame_ms", {{"p50", wave.p50_ms_}, {"p95", wave.p95_ms_}, {"p99", wave.p99_ms_}, {"max", wave.max_ms_}}},
+            {"sim_ms", {{"avg", wave.sim_avg_ms_}, {"max", wave.sim_max_ms_}}},
+            {"render_ms", {{"avg", wave.render_avg_ms_}, {"max", wave.render_max_ms_}}},
+            {"peak_entities", wave.peak_entities_}
+        });
+    }
+
+    nlohmann::json event_array = nlohmann::json::array();
+    for (const auto& channel : events) {
+        if (channel.total_ == 0) {
+            continue;
+        }
+        event_array.push_back({
+            {"name", channel.name_},
+            {"total", channel.total_},
+            {"per_second", seconds > 0.0 ? static_cast<double>(channel.total_) / seconds : 0.0},
+            {"peak_per_frame", channel.peak_frame_count_},
+            {"peak_queue", channel.peak_}
+        });
+    }
+
+    const nlohmann::json root = {
+        {"schema", SCHEMA},
+        {"started_at", std::format("{:%FT%TZ}", std::chrono::floor<std::chrono::seconds>(started_at_))},
+        {"level", {{"index", level_index_ + 1}, {"name", level_name_}, {"load_ms", load_ms_}}},
+        {"seconds", seconds},
+        {"peak_entities", peak_entities},
+        {"waves", std::move(wave_array)},
+        {"events", std::move(event_array)},
+        {"texture_cache", {
+            {"lookups", texture.lookups_},
+            {"sync_loads", texture.sync_loads_},
+            {"async_misses", texture.async_misses_},
+            {"hit_rate", texture.hitRate()}
+        }}
+    };
+    return root.dump(2);
+}
+
+std::string SessionTelemetry::buildCsv(const std::vector<WaveSummary>& waves) {
+    std::string csv = "wave,frames,seconds,frame_p50_ms,frame_p95_ms,frame_p99_ms,frame_max_ms,"
+                      "sim_avg_ms,sim_max_ms,render_avg_ms,render_max_ms,peak_entities\n";
+    for (const auto& wave : waves) {
+        std::format_to(std::back_inserter(csv), "{},{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{}\n",
+            wave.wave_, wave.frames_, wave.seconds_, wave.p50_ms_, wave.p95_ms_, wave.p99_ms_, wave.max_ms_,
+            wave.sim_avg_ms_, wave.sim_max_ms_, wave.render_avg_ms_, wave.render_max_ms_, wave.peak_entities_);
+    }
+    return csv;
+}
+
+} // namespace game::data
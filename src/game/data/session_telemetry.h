@@ -0,0 +1,106 @@
+#pragma once
+/**
+ * @file session_telemetry.h
+ * @brief 一局战斗的性能遥测：按波次汇总帧时长分位数、模拟/渲染耗时、实体峰值，场景退出时写出 JSON 与 CSV。
+ *
+ * @details
+ * GameScene 每帧调用 recordFrame()，只做一次 push_back 与几次比较（帧时长数组在会话内增长，
+ * 60 FPS 下十分钟约 150 KB）；分位数、事件频率与命中率在 write() 时统一计算。
+ * 两份文件都经 SaveService::submitRaw() 交给存档写入线程，不阻塞场景切换：
+ *
+ * - `<目录>/<时间戳>_level<N>.json`：会话信息、加载耗时、逐波统计、事件通道峰值、纹理缓存命中率
+ * - `<目录>/<时间戳>_level<N>.csv`：逐波一行，便于多台机器的结果直接拼接汇总
+ *
+ * 第 0 波为开战前的准备阶段。战斗回退到检查点后继续按当前波次累计。
+ *
+ * @code
+ * telemetry.begin(level_name, level_index, load_ms, texture_stats_at_start);
+ * telemetry.setWave(current_wave_);
+ * telemetry.recordFrame(frame_ms, sim_ms, render_ms, alive);
+ * telemetry.write("logs/telemetry", event_queues.getStats(), texture_stats_now);
+ * @endcode
+ */
+
+#include "../../engine/ecs/event_queues.h"
+#include "../../engine/resource/texture_atlas.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace game::data {
+
+class SessionTelemetry final {
+public:
+    static constexpr int SCHEMA = 1;    ///< JSON 中的 schema 字段，字段含义变化时递增
+
+    /**
+     * @brief 开始一局：清空已记录内容
+     * @param load_ms 场景初始化（含等待异步加载）的耗时
+     * @param texture_stats 开局时的纹理缓存统计，结束时取差值
+     */
+    void begin(std::string level_name, std::size_t level_index, double load_ms,
+               const engine::resource::TextureCacheStats& texture_stats);
+
+    /// @brief 之后的帧归入第 wave 波
+    void setWave(int wave);
+
+    /// @brief 记录一帧：帧间隔、本帧模拟与渲染耗时（毫秒）与存活实体数
+    void recordFrame(double frame_ms, double sim_ms, double render_ms, std::size_t entities);
+
+    /**
+     * @brief 提交 JSON 与 CSV 两份文件的异步写入并结束本局
+     * @param directory 输出目录，为空时不写出
+     * @return 未 begin 或没有记录任何帧时返回 false
+     */
+    bool write(const std::string& directory, std::span<const engine::ecs::EventChannelStats> events,
+               const engine::resource::TextureCacheStats& texture_stats);
+
+    [[nodiscard]] bool isActive() const { return active_; }
+
+private:
+    /// @brief 一波的原始记录
+    struct Wave {
+        int wave_{ 0 };
+        std::vector<float> frame_ms_;
+        double sim_ms_sum_{ 0.0 };
+        double render_ms_sum_{ 0.0 };
+        float sim_ms_max_{ 0.0f };
+        float render_ms_max_{ 0.0f };
+        std::size_t peak_entities_{ 0 };
+    };
+
+    /// @brief 写出时计算的逐波汇总
+    struct WaveSummary {
+        int wave_{ 0 };
+        std::size_t frames_{ 0 };
+        double seconds_{ 0.0 };
+        double p50_ms_{ 0.0 };
+        double p95_ms_{ 0.0 };
+        double p99_ms_{ 0.0 };
+        double max_ms_{ 0.0 };
+        double sim_avg_ms_{ 0.0 };
+        double sim_max_ms_{ 0.0 };
+        double render_avg_ms_{ 0.0 };
+        double render_max_ms_{ 0.0 };
+        std::size_t peak_entities_{ 0 };
+    };
+
+    [[nodiscard]] static WaveSummary summarize(Wave& wave);
+    [[nodiscard]] std::string buildJson(const std::vector<WaveSummary>& waves, std::span<const engine::ecs::EventChannelStats> events,
+                                        const engine::resource::TextureCacheStats& texture) const;
+    [[nodiscard]] static std::string buildCsv(const std::vector<WaveSummary>& waves);
+
+    bool active_{ false };
+    std::string level_name_;
+    std::size_t level_index_{ 0 };
+    double load_ms_{ 0.0 };
+    engine::resource::TextureCacheStats texture_start_;
+    std::chrono::system_clock::time_point started_at_{};
+    std::vector<Wave> waves_;       ///< 按首次进入的顺序
+    Wave* current_{ nullptr };
+};
+
+} // namespace game::data
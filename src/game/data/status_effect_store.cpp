@@ -0,0 +1,180 @@
+#include "status_effect_store.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace game::data {
+
+bool StatusEffectStore::apply(entt::entity target, const StatusEffectSpec& spec, std::uint64_t expire_tick) {
+    dirty_.push_back(target);
+    if (const auto index = find(target, spec.effect_id_); index != NONE) {
+        write(index, target, spec, expire_tick);
+        return false;
+    }
+
+    std::uint32_t index;
+    if (!free_.empty()) {
+        index = free_.back();
+        free_.pop_back();
+    } else {
+        index = static_cast<std::uint32_t>(target_.size());
+        target_.emplace_back();
+        effect_id_.emplace_back();
+        source_.emplace_back();
+        expire_tick_.emplace_back();
+        atk_multiplier_.emplace_back();
+        def_multiplier_.emplace_back();
+        range_multiplier_.emplace_back();
+        atk_interval_multiplier_.emplace_back();
+        speed_multiplier_.emplace_back();
+        dps_.emplace_back();
+        shield_.emplace_back();
+        modifies_stats_.emplace_back();
+    }
+    write(index, target, spec, expire_tick);
+    by_target_[target].push_back(index);
+    return true;
+}
+
+bool StatusEffectStore::remove(entt::entity target, entt::id_type effect_id) {
+    const auto it = by_target_.find(target);
+    if (it == by_target_.end()) {
+        return false;
+    }
+    auto& indices = it->second;
+    const auto pos = std::ranges::find_if(indices, [&](std::uint32_t index) { return effect_id_[index] == effect_id; });
+    if (pos == indices.end()) {
+        return false;
+    }
+    release(*pos);
+    indices.erase(pos);
+    if (indices.empty()) {
+        by_target_.erase(it);
+    }
+    dirty_.push_back(target);
+    return true;
+}
+
+void StatusEffectStore::removeTarget(entt::entity target) {
+    const auto it = by_target_.find(target);
+    if (it == by_target_.end()) {
+        return;
+    }
+    for (const auto index : it->second) {
+        release(index);
+    }
+    by_target_.erase(it);
+}
+
+std::size_t StatusEffectStore::removeExpired(entt::entity target, std::uint64_t now) {
+    const auto it = by_target_.find(target);
+    if (it == by_target_.end()) {
+        return 0;
+    }
+    auto& indices = it->second;
+    const auto removed = std::erase_if(indices, [&](std::uint32_t index) {
+        if (expire_tick_[index] > now) {
+            return false;
+        }
+        release(index);
+        return true;
+    });
+    if (indices.empty()) {
+        by_target_.erase(it);
+    }
+    if (removed > 0) {
+        dirty_.push_back(target);
+    }
+    return removed;
+}
+
+float StatusEffectStore::absorbDamage(entt::entity target, float damage) {
+    const auto it = by_target_.find(target);
+    if (it == by_target_.end()) {
+        return damage;
+    }
+    for (const auto index : it->second) {
+        if (damage <= 0.0f) {
+            break;
+        }
+        const float absorbed = std::min(shield_[index], damage);
+        shield_[index] -= absorbed;
+        damage -= absorbed;
+    }
+    return damage;
+}
+
+bool StatusEffectStore::has(entt::entity target, entt::id_type effect_id) const {
+    return find(target, effect_id) != NONE;
+}
+
+StatModifiers StatusEffectStore::modifiers(entt::entity target) const {
+    StatModifiers result;
+    const auto it = by_target_.find(target);
+    if (it == by_target_.end()) {
+        return result;
+    }
+    for (const auto index : it->second) {
+        if (!modifies_stats_[index]) {
+            continue;
+        }
+        result.atk_ *= atk_multiplier_[index];
+        result.def_ *= def_multiplier_[index];
+        result.range_ *= range_multiplier_[index];
+        result.atk_interval_ *= atk_interval_multiplier_[index];
+        result.speed_ *= speed_multiplier_[index];
+        result.any_ = true;
+    }
+    return result;
+}
+
+std::vector<entt::entity> StatusEffectStore::takeDirty() {
+    std::ranges::sort(dirty_);
+    const auto duplicates = std::ranges::unique(dirty_);
+    dirty_.erase(duplicates.begin(), duplicates.end());
+    return std::exchange(dirty_, {});
+}
+
+void StatusEffectStore::clear() {
+    *this = StatusEffectStore{};
+}
+
+std::uint32_t StatusEffectStore::find(entt::entity target, entt::id_type effect_id) const {
+    const auto it = by_target_.find(target);
+    if (it == by_target_.end()) {
+        return NONE;
+    }
+    for (const auto index : it->second) {
+        if (effect_id_[index] == effect_id) {
+            return index;
+        }
+    }
+    return NONE;
+}
+
+void StatusEffectStore::write(std::uint32_t index, entt::entity target, const StatusEffectSpec& spec, std::uint64_t expire_tick) {
+    target_[index] = target;
+    effect_id_[index] = spec.effect_id_;
+    source_[index] = spec.source_;
+    expire_tick_[index] = expire_tick;
+    atk_multiplier_[index] = spec.atk_multiplier_;
+    def_multiplier_[index] = spec.def_multiplier_;
+    range_multiplier_[index] = spec.range_multiplier_;
+    atk_interval_multiplier_[index] = spec.atk_interval_multiplier_;
+    speed_multiplier_[index] = spec.speed_multiplier_;
+    dps_[index] = spec.damage_per_second_;
+    shield_[index] = spec.shield_;
+    modifies_stats_[index] = spec.atk_multiplier_ != 1.0f || spec.def_multiplier_ != 1.0f || spec.range_multiplier_ != 1.0f ||
+                             spec.atk_interval_multiplier_ != 1.0f || spec.speed_multiplier_ != 1.0f;
+}
+
+void StatusEffectStore::release(std::uint32_t index) {
+    // 空闲记录的持续伤害与护盾清零，扫描时无需再判断 target_
+    target_[index] = entt::null;
+    dps_[index] = 0.0f;
+    shield_[index] = 0.0f;
+    modifies_stats_[index] = 0;
+    free_.push_back(index);
+}
+
+} // namespace game::data
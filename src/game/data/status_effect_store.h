@@ -0,0 +1,120 @@
+#pragma once
+
+#include <entt/core/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace game::data {
+
+/// @brief 一次施加的状态效果（减速、灼烧、护盾、光环增益等）
+struct StatusEffectSpec {
+    entt::id_type effect_id_{ 0 };          ///< 效果ID；同一目标上同 ID 的效果再次施加时刷新而不叠加
+    entt::entity source_{ entt::null };     ///< 施加者（可为空）
+    float duration_{ 0.0f };                ///< 持续时间（秒）
+    float atk_multiplier_{ 1.0f };
+    float def_multiplier_{ 1.0f };
+    float range_multiplier_{ 1.0f };
+    float atk_interval_multiplier_{ 1.0f };
+    float speed_multiplier_{ 1.0f };
+    float damage_per_second_{ 0.0f };       ///< 持续伤害（无视防御），0 表示无
+    float shield_{ 0.0f };                  ///< 护盾量，先于生命值吸收伤害
+};
+
+/// @brief 一个目标上全部效果的乘积
+struct StatModifiers {
+    float atk_{ 1.0f };
+    float def_{ 1.0f };
+    float range_{ 1.0f };
+    float atk_interval_{ 1.0f };
+    float speed_{ 1.0f };
+    bool any_{ false };                     ///< 至少有一个效果带属性修正
+};
+
+/**
+ * @brief 全部状态效果记录（SoA），放在 registry.ctx() 中，随战斗快照整体拷贝
+ *
+ * @details
+ * 每条记录的各字段分别存放在连续数组中，第 i 个元素属于同一条记录；移除的记录进入空闲列表，
+ * 下标在复用前保持稳定。持续伤害只需顺序扫描 target_ 与 dps_ 两个数组，与效果种类数无关。
+ * by_target_ 按目标索引记录下标，刷新、移除、汇总修正都只看该目标自己的几条记录。
+ *
+ * 属性修正不在施加时立即写入组件：施加、移除、到期都只把目标记入脏列表，
+ * StatusEffectSystem 每步对脏目标汇总一次（见 takeDirty()）。
+ * 到期由 engine::core::TimerWheel 驱动（timer_event::STATUS_EFFECT_EXPIRE），这里只记录到期步。
+ */
+class StatusEffectStore final {
+public:
+    /**
+     * @brief 施加或刷新效果
+     * @param expire_tick 到期的计时器步
+     * @return 新增记录时为 true，刷新已有记录时为 false
+     */
+    bool apply(entt::entity target, const StatusEffectSpec& spec, std::uint64_t expire_tick);
+
+    /// @brief 移除目标上的一个效果，不存在时返回 false
+    bool remove(entt::entity target, entt::id_type effect_id);
+
+    /// @brief 移除目标上全部效果（目标被销毁时调用，不记入脏列表）
+    void removeTarget(entt::entity target);
+
+    /// @brief 移除目标上到期步不晚于 now 的效果，返回移除的条数（刷新过的效果到期步更晚，不受旧计时器影响）
+    std::size_t removeExpired(entt::entity target, std::uint64_t now);
+
+    /**
+     * @brief 用目标身上的护盾吸收伤害（按施加顺序消耗）
+     * @return 护盾吸收后剩余的伤害
+     */
+    [[nodiscard]] float absorbDamage(entt::entity target, float damage);
+
+    [[nodiscard]] bool has(entt::entity target, entt::id_type effect_id) const;
+    [[nodiscard]] bool hasAny(entt::entity target) const { return by_target_.contains(target); }
+
+    /// @brief 汇总目标上全部效果的属性修正
+    [[nodiscard]] StatModifiers modifiers(entt::entity target) const;
+
+    /// @brief 目标的基础属性被外部修改（如升级），下一步重新汇总
+    void markDirty(entt::entity target) { dirty_.push_back(target); }
+
+    /// @brief 取出并清空脏列表（已去重）
+    [[nodiscard]] std::vector<entt::entity> takeDirty();
+
+    void clear();
+
+    // --- 持续伤害扫描：target_[i] 为 entt::null 表示空闲记录 ---
+    [[nodiscard]] std::span<const entt::entity> targets() const { return target_; }
+    [[nodiscard]] std::span<const entt::entity> sources() const { return source_; }
+    [[nodiscard]] std::span<const float> damagePerSecond() const { return dps_; }
+
+    /// @brief 有效记录数
+    [[nodiscard]] std::size_t size() const { return target_.size() - free_.size(); }
+
+private:
+    [[nodiscard]] std::uint32_t find(entt::entity target, entt::id_type effect_id) const;
+    void write(std::uint32_t index, entt::entity target, const StatusEffectSpec& spec, std::uint64_t expire_tick);
+    void release(std::uint32_t index);
+
+    static constexpr std::uint32_t NONE = ~std::uint32_t{ 0 };
+
+    std::vector<entt::entity> target_;
+    std::vector<entt::id_type> effect_id_;
+    std::vector<entt::entity> source_;
+    std::vector<std::uint64_t> expire_tick_;
+    std::vector<float> atk_multiplier_;
+    std::vector<float> def_multiplier_;
+    std::vector<float> range_multiplier_;
+    std::vector<float> atk_interval_multiplier_;
+    std::vector<float> speed_multiplier_;
+    std::vector<float> dps_;
+    std::vector<float> shield_;
+    std::vector<std::uint8_t> modifies_stats_;  ///< 任一倍率不为 1，汇总时才需要读取
+
+    std::vector<std::uint32_t> free_;
+    std::unordered_map<entt::entity, std::vector<std::uint32_t>> by_target_;
+    std::vector<entt::entity> dirty_;
+};
+
+} // namespace game::data
@@ -1,8 +1,8 @@
 #include "ui_config.h"
 
-#include <fstream>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
+#include "../../engine/io/virtual_fs.h"
 #include "../../engine/utils/logging.h"
 
 namespace game::data {
@@ -23,15 +23,15 @@ engine::render::Image parseImage(const nlohmann::json& json_data)
 
 bool UIConfig::load(std::string_view ui_config_path)
 {
-    std::ifstream input_file{ std::string(ui_config_path) };
-    if (!input_file.is_open()) {
+    const auto input_file = engine::io::VirtualFS::instance().read(ui_config_path);
+    if (!input_file) {
         ENGINE_LOG_ERROR("无法打开 UI 配置文件: {}", ui_config_path);
         return false;
     }
 
     nlohmann::json json_data;
     try {
-        input_file >> json_data;
+        json_data = nlohmann::json::parse(input_file->text());
     }
     catch (const std::exception& e) {
         ENGINE_LOG_ERROR("解析 UI 配置失败: {}", e.what());
@@ -86,7 +86,24 @@ bool UIConfig::load(std::string_view ui_config_path)
         }
     }
 
-    ENGINE_LOG_INFO("UIConfig 加载完成: icons={}, portraits={}, frames={}", icon_map_.size(), portrait_map_.size(), portrait_frame_map_.size());
+    font_preload_.clear();
+    if (json_data.contains("font_preload") && json_data["font_preload"].is_array()) {
+        for (const auto& item : json_data["font_preload"]) {
+            engine::resource::FontPreload font;
+            font.path_ = item.value("font", std::string{});
+            font.sizes_ = item.value("sizes", std::vector<int>{});
+            font.glyphs_ = item.value("glyphs", std::string{});
+            font.scalable_ = item.value("scalable", false);
+            if (font.path_.empty() || (font.sizes_.empty() && !font.scalable_)) {
+                ENGINE_LOG_WARN("忽略无效的字体预加载项（缺少 font 或 sizes）");
+                continue;
+            }
+            font_preload_.push_back(std::move(font));
+        }
+    }
+
+    ENGINE_LOG_INFO("UIConfig 加载完成: icons={}, portraits={}, frames={}, font_preload={}",
+                    icon_map_.size(), portrait_map_.size(), portrait_frame_map_.size(), font_preload_.size());
     return true;
 }
 
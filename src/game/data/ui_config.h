@@ -4,7 +4,9 @@
 #include <glm/vec2.hpp>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include "../../engine/render/image.h"
+#include "../../engine/resource/resource_manager.h"
 
 namespace game::data {
 
@@ -26,11 +28,15 @@ public:
 
     [[nodiscard]] const UnitPanelLayout& getUnitPanelLayout() const { return unit_panel_layout_; }
 
+    /// @brief "font_preload"：启动时在工作线程上打开的字体与字号
+    [[nodiscard]] const std::vector<engine::resource::FontPreload>& getFontPreload() const { return font_preload_; }
+
 private:
     std::unordered_map<entt::id_type, engine::render::Image> icon_map_;
     std::unordered_map<entt::id_type, engine::render::Image> portrait_map_;
     std::unordered_map<int, engine::render::Image> portrait_frame_map_;
     UnitPanelLayout unit_panel_layout_;
+    std::vector<engine::resource::FontPreload> font_preload_;
 };
 
 } // namespace game::data
@@ -0,0 +1,55 @@
+#include "wave_spawner.h"
+#include "../defs/constants.h"
+#include <algorithm>
+
+namespace game::data {
+
+void WaveSpawner::start(const WaveConfig& wave, engine::core::TimerWheel& timers) {
+    cancel(timers);
+    groups_.reserve(wave.groups_.size());
+    for (const auto& group : wave.groups_) {
+        auto& cursor = groups_.emplace_back();
+        cursor.group_ = group;
+        const auto index = static_cast<entt::entity>(groups_.size() - 1);
+        cursor.timer_ = timers.scheduleAfter(timers.ticksFor(group.delay_), index, game::defs::timer_event::WAVE_SPAWN);
+        remaining_ += static_cast<std::size_t>(group.count_);
+    }
+}
+
+void WaveSpawner::cancel(engine::core::TimerWheel& timers) {
+    for (auto& cursor : groups_) {
+        timers.cancel(cursor.timer_);
+    }
+    groups_.clear();
+    remaining_ = 0;
+}
+
+std::optional<SpawnBatch> WaveSpawner::onTimer(const engine::core::TimerWheel::Expiry& expiry, engine::core::TimerWheel& timers) {
+    const auto index = static_cast<std::size_t>(entt::to_integral(expiry.entity_));
+    if (index >= groups_.size()) {
+        return std::nullopt;
+    }
+    auto& cursor = groups_[index];
+    const int left = cursor.group_.count_ - cursor.spawned_;
+    if (left <= 0) {
+        return std::nullopt;
+    }
+
+    SpawnBatch batch;
+    batch.class_id_ = cursor.group_.class_id_;
+    batch.count_ = static_cast<std::size_t>(std::min(left, cursor.group_.burst_));
+    batch.first_ = static_cast<std::size_t>(cursor.spawned_);
+    batch.pattern_ = cursor.group_.pattern_;
+    batch.start_point_ = cursor.group_.start_point_;
+
+    cursor.spawned_ += static_cast<int>(batch.count_);
+    remaining_ -= batch.count_;
+    if (cursor.spawned_ < cursor.group_.count_) {
+        cursor.timer_ = timers.scheduleAfter(timers.ticksFor(cursor.group_.interval_), expiry.entity_, game::defs::timer_event::WAVE_SPAWN);
+    } else {
+        cursor.timer_ = {};
+    }
+    return batch;
+}
+
+} // namespace game::data
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "level_config.h"
+#include "../../engine/core/timer_wheel.h"
+#include <entt/entity/fwd.hpp>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace game::data {
+
+/// @brief 一个刷怪组本次到期应出场的一批敌人
+struct SpawnBatch {
+    entt::id_type class_id_ = entt::null;
+    std::size_t count_ = 0;
+    std::size_t first_ = 0;             ///< 本批第一个敌人在组内的序号
+    SpawnPattern pattern_ = SpawnPattern::ROUND_ROBIN;
+    int start_point_ = 0;
+
+    /**
+     * @brief 本批第 i 个敌人的起点槽位（start_points 的下标）
+     * @param wave 当前波次序号（轮换时与组的偏移相加，不同波次从不同起点开始）
+     * @param slots 起点数量（须大于 0）
+     */
+    [[nodiscard]] std::size_t startSlot(std::size_t i, int wave, std::size_t slots) const {
+        if (pattern_ == SpawnPattern::FIXED) {
+            return static_cast<std::size_t>(start_point_) % slots;
+        }
+        return (static_cast<std::size_t>(wave) + static_cast<std::size_t>(start_point_) + first_ + i) % slots;
+    }
+};
+
+/**
+ * @brief 执行一个波次的刷怪时间线：每个刷怪组在 TimerWheel 上各占一个计时器，各组并行推进
+ *
+ * @details
+ * start() 为每组登记首批的 WAVE_SPAWN 计时器，到期条目的实体字段存放组下标；
+ * 调用方遍历本步到期条目，对 WAVE_SPAWN 调用 onTimer() 取得该组本批的敌人并登记下一批。
+ * 每组只保存已出场数与计时器句柄，不展开逐个敌人的队列。
+ * 值类型，可与 TimerWheel 一起拷贝进战斗检查点（TimerId 在时间轮的拷贝之间保持有效）。
+ */
+class WaveSpawner final {
+public:
+    /// @brief 取消上一波尚未到期的刷怪计时器，开始执行 wave 的时间线
+    void start(const WaveConfig& wave, engine::core::TimerWheel& timers);
+
+    /// @brief 取消全部刷怪计时器并清空
+    void cancel(engine::core::TimerWheel& timers);
+
+    /**
+     * @brief 处理一个本步到期的 WAVE_SPAWN 条目
+     * @return 该组本批出场的敌人；组下标无效（如回退前登记的过期条目）时返回空
+     */
+    [[nodiscard]] std::optional<SpawnBatch> onTimer(const engine::core::TimerWheel::Expiry& expiry, engine::core::TimerWheel& timers);
+
+    /// @brief 是否还有敌人尚未出场
+    [[nodiscard]] bool isSpawning() const { return remaining_ > 0; }
+    /// @brief 尚未出场的敌人数
+    [[nodiscard]] std::size_t getRemaining() const { return remaining_; }
+
+private:
+    struct GroupCursor {
+        SpawnGroup group_;
+        int spawned_ = 0;
+        engine::core::TimerId timer_;
+    };
+
+    std::vector<GroupCursor> groups_;
+    std::size_t remaining_ = 0;
+};
+
+} // namespace game::data
@@ -1,10 +1,14 @@
 #pragma once
 
 #include "../../engine/utils/math.h"
+#include <cstddef>
+#include <cstdint>
+#include <entt/core/hashed_string.hpp>
 
 namespace game::defs {
 
 constexpr float BLOCK_RADIUS = 40.0f;   ///< @brief 阻挡半径
+constexpr int MAX_BLOCK_COUNT = 4;      ///< @brief 单个阻挡者最多同时阻挡的敌人数（蓝图的 block 超出时截断）
 constexpr float UNIT_RADIUS = 16.0f;    ///< @brief 单位判定半径，用于射程补偿
 constexpr float HOVER_RADIUS = 30.0f;   ///< @brief 鼠标悬浮/点选判定半径
 constexpr float PLACE_RADIUS = 24.0f;   ///< @brief 放置点判定半径
@@ -14,6 +18,55 @@ constexpr int INITIAL_GOLD = 10;         ///< @brief 初始金币
 constexpr float WAVE_SPAWN_INTERVAL = 0.9f;   ///< @brief 单个敌人刷出间隔
 constexpr float WAVE_BREAK_DURATION = 3.0f;    ///< @brief 波次间隔
 constexpr int WAVE_BASE_COUNT = 4;      ///< @brief 基础波次敌人数
+constexpr std::size_t ENDLESS_LEVEL_INDEX = 2;  ///< @brief 标题界面「无尽模式」进入的关卡（level_config.json 中配置了 endless 的一项）
+constexpr int PROJECTILE_POOL_SIZE = 32;  ///< @brief 每种投射物预热的池化实体数（可由 pool_size 覆盖）
+constexpr int EFFECT_POOL_SIZE = 8;       ///< @brief 每种特效预热的池化实体数（可由 pool_size 覆盖）
+constexpr std::uint32_t HEALTH_BAR_THROTTLE_FRAMES = 3;  ///< @brief 帧预算降级时血条每隔多少帧更新一次
+constexpr std::uint32_t REDUCED_EFFECT_STRIDE = 2;       ///< @brief 帧预算降级时每多少个命中特效只生成一个
+constexpr float AUDIO_LISTENER_RADIUS_SCALE = 0.75f;    ///< @brief 空间化音效的听觉半径 = 视野对角线长度 × 该系数
+constexpr engine::utils::FColor PLAYER_ICON_COLOR = { 0.3f, 0.6f, 1.0f, 1.0f };   ///< @brief 相机拉远时玩家单位的远景图标颜色
+constexpr engine::utils::FColor ENEMY_ICON_COLOR = { 0.95f, 0.25f, 0.2f, 1.0f };  ///< @brief 相机拉远时敌人的远景图标颜色
+constexpr float CAMERA_ZOOM_STEP = 1.25f;               ///< @brief 鼠标滚轮每格的相机缩放倍率
+constexpr std::uint32_t TARGET_ACQUIRE_BUCKETS = 4;     ///< @brief 空闲单位分成几组轮流索敌（1 为每步全部索敌）
+constexpr float SEPARATION_RADIUS = UNIT_RADIUS * 2.0f;    ///< @brief 敌人分离的作用半径（两单位判定圆相切）
+constexpr std::size_t SEPARATION_MAX_CHECKS = 8;          ///< @brief 每个敌人每步最多检查的邻近条目数（含自身）
+constexpr float SEPARATION_STRENGTH = 0.6f;               ///< @brief 分离修正的最大速度 = 敌人速度 × 该系数
+constexpr std::uint8_t FLOW_FIELD_OCCUPIED_COST = 8;    ///< @brief 流场导航中被占用建造位所在格子的权重（绕行但不封死道路）
+constexpr float ELITE_ATK_SHARE = 0.25f;                ///< @brief 无尽模式精英每并入一只敌人，攻击力增加其攻击力的该比例（生命值全额累加）
+constexpr float ELITE_SCALE_STEP = 0.05f;               ///< @brief 精英每并入一只敌人增加的体型缩放
+constexpr float ELITE_MAX_SCALE = 1.8f;                 ///< @brief 精英体型缩放上限
+constexpr engine::utils::FColor ELITE_COLOR = { 1.0f, 0.82f, 0.45f, 1.0f };  ///< @brief 精英的着色
+
+/// @brief 空间索引图层掩码（engine::spatial::SpatialGrid 条目的 mask_）
+namespace spatial_layer {
+constexpr std::uint32_t PLAYER = 1u << 0;       ///< @brief 玩家单位（PlayerComponent）
+constexpr std::uint32_t ENEMY = 1u << 1;        ///< @brief 敌方单位（EnemyComponent）
+constexpr std::uint32_t INJURED = 1u << 2;      ///< @brief 受伤的玩家单位（behavior_flag::INJURED）
+constexpr std::uint32_t BLOCKER = 1u << 3;      ///< @brief 可阻挡敌人的单位（BlockerComponent）
+constexpr std::uint32_t SELECTABLE = 1u << 4;   ///< @brief 可被鼠标悬浮/点选的单位
+}   // namespace spatial_layer
+
+/// @brief 内置职业ID（与 assets/data/player_data.json、enemy_data.json 的键一致），编译期求值
+namespace class_id {
+constexpr entt::id_type WARRIOR = entt::hashed_string("warrior").value();       ///< @brief 战士（近战）
+constexpr entt::id_type ARCHER = entt::hashed_string("archer").value();         ///< @brief 弓箭手（远程）
+constexpr entt::id_type LANCER = entt::hashed_string("lancer").value();         ///< @brief 枪兵（近战）
+constexpr entt::id_type WITCH = entt::hashed_string("witch").value();           ///< @brief 女巫（远程治疗）
+constexpr entt::id_type SLIME = entt::hashed_string("slime").value();           ///< @brief 史莱姆
+constexpr entt::id_type WOLF = entt::hashed_string("wolf").value();             ///< @brief 狼
+constexpr entt::id_type GOBLIN = entt::hashed_string("goblin").value();         ///< @brief 哥布林
+constexpr entt::id_type DARK_WITCH = entt::hashed_string("dark_witch").value(); ///< @brief 黑暗女巫
+}   // namespace class_id
+
+/// @brief 模拟计时器（engine::core::TimerWheel）的事件ID，到期时由对应系统处理
+namespace timer_event {
+constexpr entt::id_type SKILL_READY = entt::hashed_string("timer.skill_ready").value();         ///< @brief 技能冷却结束（TimerSystem）
+constexpr entt::id_type SKILL_DURATION_END = entt::hashed_string("timer.skill_end").value();    ///< @brief 技能持续结束（TimerSystem）
+constexpr entt::id_type WAVE_BREAK = entt::hashed_string("timer.wave_break").value();           ///< @brief 波次间隔结束，开始下一波
+constexpr entt::id_type WAVE_SPAWN = entt::hashed_string("timer.wave_spawn").value();           ///< @brief 刷怪组出场下一批敌人（实体字段为组下标，见 WaveSpawner）
+constexpr entt::id_type WAVE_BANNER = entt::hashed_string("timer.wave_banner").value();         ///< @brief 隐藏波次横幅（GameScene）
+constexpr entt::id_type STATUS_EFFECT_EXPIRE = entt::hashed_string("timer.status_expire").value(); ///< @brief 状态效果到期（StatusEffectSystem）
+}   // namespace timer_event
 
 /// @brief 玩家类型枚举
 enum class PlayerType {
@@ -23,4 +76,31 @@ enum class PlayerType {
     MIXED       ///< @brief 混合型，可以放在任意区域（暂不实现，未来可拓展）
 };
 
+/// @brief 玩家攻击单位的索敌策略（在射程内的候选敌人中选择）
+enum class TargetPolicy : std::uint8_t {
+    CLOSEST,            ///< @brief 距离最近
+    FIRST_ALONG_PATH,   ///< @brief 沿路径离基地最近（走得最远）
+    LOWEST_HP,          ///< @brief 当前生命值最低
+    HIGHEST_THREAT,     ///< @brief 威胁度（每秒攻击力）最高
+};
+
+/// @brief 范围攻击的形状（AreaHitEvent）
+enum class AreaShape : std::uint8_t {
+    NONE,       ///< @brief 单体攻击
+    CIRCLE,     ///< @brief 以目标（或施放者）为圆心的圆形溅射
+    CONE,       ///< @brief 以攻击者为顶点、朝向目标的扇形横扫
+    CAPSULE,    ///< @brief 从攻击者到目标的穿透路径（线段外扩半径）
+};
+
+/// @brief 敌人的导航方式（关卡配置的 "navigation" 字段）
+enum class NavigationMode : std::uint8_t {
+    WAYPOINT,   ///< @brief 沿路径点图的路径段前进，岔路随机选择
+    FLOW_FIELD, ///< @brief 采样由瓦片层 SOLID 格子构建的流场，自动绕开障碍（开阔地图）
+};
+
+/// @brief 未在蓝图中指定 "target_policy" 时按单位类型选择的默认策略
+constexpr TargetPolicy defaultTargetPolicy(PlayerType type) {
+    return type == PlayerType::RANGED ? TargetPolicy::FIRST_ALONG_PATH : TargetPolicy::CLOSEST;
+}
+
 }   // namespace game::defs
\ No newline at end of file
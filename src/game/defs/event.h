@@ -53,17 +53,56 @@ struct AttackHitEvent {
 	float damage_amount_;             ///< 伤害量
 };
 
+/**
+ * @brief 一次范围攻击（溅射、扇形横扫、穿透路径、范围技能）
+ *
+ * 经 EventQueues 批量交给 CombatResolveSystem：每个事件在空间网格上查询一次范围内的单位，
+ * 受害者与单体命中一起按目标合并结算，不再为每个受害者发出单独的事件。
+ */
+struct AreaHitEvent {
+	entt::entity attacker_entity_;     ///< 攻击者实体
+	AreaShape shape_;                  ///< 范围形状
+	glm::vec2 origin_;                 ///< 圆心 / 扇形顶点 / 胶囊起点
+	glm::vec2 target_;                 ///< 扇形朝向的点 / 胶囊终点（圆形忽略）
+	float radius_;                     ///< 圆与扇形的半径、胶囊的外扩半径
+	float cos_half_angle_;             ///< 扇形半张角的余弦（其他形状忽略）
+	float damage_amount_;              ///< 攻击力，对每个受害者按其防御换算
+	std::uint32_t mask_;               ///< 受害者的空间图层（spatial_layer）
+};
+
+/// @brief 状态效果的持续伤害（无视防御，经 EventQueues 批量交给 CombatResolveSystem）
+struct StatusDamageEvent {
+	entt::entity source_entity_;       ///< 施加者实体（可为空）
+	entt::entity target_entity_;       ///< 目标实体
+	float damage_amount_;             ///< 本步伤害量
+};
+
 struct SpawnProjectileVisualEvent {
   entt::entity source_entity_{};
 	entt::entity target_entity_{};
 	entt::id_type projectile_id_{};
 };
 
+/**
+ * @brief 发射一枚模拟投射物（投射物蓝图带 "simulated" 字段时代替立即命中）
+ *
+ * 经 EventQueues 批量交给 ProjectileSystem：投射物在 ProjectilePool 中飞行，沿途扫掠判定命中，
+ * 命中时再发出 AttackHitEvent。
+ */
+struct LaunchProjectileEvent {
+	entt::entity attacker_entity_;     ///< 攻击者实体
+	entt::entity target_entity_;       ///< 瞄准的目标实体
+	entt::id_type projectile_id_;      ///< 投射物ID
+	float damage_amount_;              ///< 攻击力，命中时按目标防御换算
+	std::uint32_t mask_;               ///< 可命中的空间图层（spatial_layer）
+};
+
 struct SpawnEffectVisualEvent {
   entt::entity target_entity_{};
 	entt::id_type effect_id_{};
 };
 
+/// @brief 进入出击准备（玩家指令，肖像点击时即时 trigger，见 engine/core/event_phase.h）
 struct PrepUnitEvent {
 	entt::id_type name_id_{ 0 };
 	entt::id_type class_id_{ 0 };
@@ -72,6 +111,25 @@ struct PrepUnitEvent {
 	int rarity_{ 1 };
 };
 
+/// @brief 单位放置成功（PlaceUnitSystem 立即 trigger，供回放录制使用）
+struct UnitPlacedEvent {
+	entt::entity entity_{ entt::null };
+	entt::id_type class_id_{ 0 };
+	glm::vec2 position_{ 0.0f };
+	int cost_{ 0 };
+	int level_{ 1 };
+	int rarity_{ 1 };
+};
+
+/// @brief 锁步联机时确认出击：放置不立即生效，由 GameScene 提交为指令，在约定的模拟步统一执行（trigger）
+struct PlaceUnitRequestEvent {
+	entt::id_type class_id_{ 0 };
+	glm::vec2 position_{ 0.0f };	///< 已解析的建造位中心
+	int cost_{ 0 };
+	int level_{ 1 };
+	int rarity_{ 1 };
+};
+
 struct UIPortraitHoverEnterEvent {
 	entt::id_type name_id_{ 0 };
 };
@@ -119,6 +177,12 @@ struct SkillDurationEndEvent {
 
 struct RestartEvent {};
 
+struct RetryWaveEvent {};           ///< 回到当前波次开始前的检查点
+
+struct RewindToWaveEvent {
+	int wave_{ 0 };                 ///< 回到第 wave_ 波开始前的检查点（0 为关卡初始状态）
+};
+
 struct BackToTitleEvent {};
 
 struct SaveEvent {};
@@ -0,0 +1,27 @@
+#pragma once
+/**
+ * @file groups.h
+ * @brief 游戏层热点组件组合的 EnTT 分组，与 engine/ecs/groups.h 一起在场景初始化时建立。
+ */
+
+#include <entt/entity/registry.hpp>
+#include "tags.h"
+#include "../component/stats_component.h"
+#include "../../engine/component/transform_component.h"
+#include "../../engine/ecs/groups.h"
+
+namespace game::defs {
+
+/// @brief 存活的战斗单位：拥有 Stats，获取 Transform（Transform 归渲染分组所有）
+inline auto statsGroup(entt::registry& registry) {
+    return registry.group<game::component::StatsComponent>(
+        entt::get<engine::component::TransformComponent>, entt::exclude<DeadTag>);
+}
+
+/// @brief 建立引擎层与游戏层的全部分组
+inline void declareGroups(entt::registry& registry) {
+    engine::ecs::declareGroups(registry);
+    static_cast<void>(statsGroup(registry));
+}
+
+} // namespace game::defs
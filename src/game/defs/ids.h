@@ -0,0 +1,89 @@
+#pragma once
+/**
+ * @file ids.h
+ * @brief 构建期生成的稠密 ID：动画、帧事件、音效动作、特效、技能与输入动作的枚举及哈希↔下标换算。
+ *
+ * @details
+ * generated_ids.h 由 tools/id_codegen 在构建时扫描 assets/data/*.json 与 assets/config.json 生成，
+ * 每一类取名称排序后的下标作为枚举值（末尾的 COUNT 即项数），因此：
+ * - 代码里可以写 ids::Effect::DEATH 代替 "death"_hs，拼写错误在编译期发现
+ * - 以 ID 为键的表可以是 std::array<T, ids::count<Id>()>，用 ids::indexOf() 直接取下标，不再需要 unordered_map
+ * - 运行期从数据读到的哈希经 fromHash() 二分查找换成枚举；不在表内时返回 COUNT
+ * 数据里新增名称后重新构建即可得到新的枚举项；同一类别内哈希冲突会让生成器报错、构建失败。
+ *
+ * 引擎层（AnimationSet、InputManager、SoundTable）不依赖游戏数据，仍以 entt::id_type 为键；
+ * 游戏代码与之交互时用 hashOf() 取哈希。
+ */
+
+#include "game/defs/generated_ids.h"
+#include <entt/core/hashed_string.hpp>
+#include <algorithm>
+
+namespace game::ids {
+
+/// @brief 该类 ID 的项数（等于 Id::COUNT）
+template<typename Id>
+[[nodiscard]] constexpr std::size_t count() {
+    return IdTable<Id>::SIZE;
+}
+
+/// @brief 枚举 -> 稠密下标
+template<typename Id>
+[[nodiscard]] constexpr std::size_t indexOf(Id id) {
+    return static_cast<std::size_t>(id);
+}
+
+/// @brief 枚举 -> 与 entt::hashed_string 相同的哈希
+template<typename Id>
+[[nodiscard]] constexpr entt::id_type hashOf(Id id) {
+    return IdTable<Id>::HASHES[indexOf(id)];
+}
+
+/// @brief 枚举 -> 数据中的名称
+template<typename Id>
+[[nodiscard]] constexpr std::string_view nameOf(Id id) {
+    return IdTable<Id>::NAMES[indexOf(id)];
+}
+
+/// @brief 哈希 -> 枚举；不是该类已知名称时返回 Id::COUNT
+template<typename Id>
+[[nodiscard]] constexpr Id fromHash(entt::id_type hash) {
+    const auto& table = IdTable<Id>::BY_HASH;
+    const auto it = std::lower_bound(table.begin(), table.end(), hash,
+                                     [](const auto& entry, entt::id_type value) { return entry.first < value; });
+    return (it != table.end() && it->first == hash) ? static_cast<Id>(it->second) : Id::COUNT;
+}
+
+namespace detail {
+
+/// @brief 生成表与 entt 哈希一致、按哈希严格升序（同时排除冲突）
+template<typename Id>
+constexpr bool validTable() {
+    using Table = IdTable<Id>;
+    if (Table::SIZE != static_cast<std::size_t>(Id::COUNT)) {
+        return false;
+    }
+    for (std::size_t i = 0; i < Table::SIZE; ++i) {
+        if (Table::HASHES[i] != entt::hashed_string::value(Table::NAMES[i].data(), Table::NAMES[i].size())) {
+            return false;
+        }
+        if (i > 0 && Table::BY_HASH[i - 1].first >= Table::BY_HASH[i].first) {
+            return false;
+        }
+        if (Table::HASHES[Table::BY_HASH[i].second] != Table::BY_HASH[i].first) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace detail
+
+static_assert(detail::validTable<Animation>(), "generated_ids.h 与 entt 哈希不一致，请重新生成");
+static_assert(detail::validTable<FrameEvent>(), "generated_ids.h 与 entt 哈希不一致，请重新生成");
+static_assert(detail::validTable<SoundAction>(), "generated_ids.h 与 entt 哈希不一致，请重新生成");
+static_assert(detail::validTable<Effect>(), "generated_ids.h 与 entt 哈希不一致，请重新生成");
+static_assert(detail::validTable<Skill>(), "generated_ids.h 与 entt 哈希不一致，请重新生成");
+static_assert(detail::validTable<InputAction>(), "generated_ids.h 与 entt 哈希不一致，请重新生成");
+
+} // namespace game::ids
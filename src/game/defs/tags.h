@@ -106,24 +106,7 @@ struct RangedUnitTag {};        ///< 远程单位标签
  */
 struct HealerTag {};        ///< 治疗单位标签
 
-/**
- * @struct AttackReadyTag
- * @brief 攻击准备就绪标签。
- * 
- * @details
- * 当单位的攻击冷却结束，可以发起下一次攻击时，添加此标签。
- * TimerSystem 负责计时并添加此标签，AttackStarterSystem 负责发起攻击并移除此标签。
- */
-struct AttackReadyTag {};
-
-/**
- * @struct SkillReadyTag
- * @brief 技能就绪标签。
- *
- * @details
- * 当技能冷却结束后由 TimerSystem 添加，表示该技能可以被手动激活。
- */
-struct SkillReadyTag {};
+// 攻击就绪、动作锁定、技能就绪与受伤状态不再是标签，见 game::component::BehaviorComponent
 
 /**
  * @struct SkillActiveTag
@@ -143,39 +126,12 @@ struct SkillActiveTag {};
  */
 struct PassiveSkillTag {};
 
-/**
- * @struct InjuredTag
- * @brief 受伤标签。
- * 
- * @details
- * 当单位当前的生命值（HP）小于最大生命值（Max HP）时，添加此标签。
- * 治疗单位（Healer）会优先寻找带有此标签的友好单位作为目标。
- */
-struct InjuredTag {};
-
-/**
- * @struct ActionLockTag
- * @brief 动作锁定标签（硬直）。
- * 
- * @details
- * 标记实体当前正在执行一个不可中断的动作（如播放攻击动画）。
- * 带有此标签的实体通常不允许进行移动。
- * 动画播放系统会在动画结束时负责移除此标签。
- */
-struct ActionLockTag {};
-
 /**
  * @struct VisualEffectTag
  * @brief 临时视觉实体标签，用于投射物和攻击特效的自动清理。
  */
 struct VisualEffectTag {};
 
-/**
- * @struct InactiveVisualTag
- * @brief 临时视觉实体池中的空闲实体标签，用于对象池复用。
- */
-struct InactiveVisualTag {};
-
 /**
  * @struct MeleePlaceTag
  * @brief 近战建造位标签，用于标记地图上的近战可建造位置。
@@ -188,6 +144,12 @@ struct MeleePlaceTag {};
  */
 struct RangePlaceTag {};
 
+/**
+ * @struct OrientableTag
+ * @brief 可转向标签，EntityFactory 为战斗单位添加，OrientationSystem 只处理带此标签的实体。
+ */
+struct OrientableTag {};
+
 /**
  * @struct ShowRangeTag
  * @brief 范围显示标签，用于驱动远程单位攻击范围预览渲染。
@@ -4,6 +4,7 @@
  * 
  * @details
  * 本文件实现了 BlueprintManager 类的所有方法，包括：
+ * - 并行解析全部蓝图文件（JSON 或预编译的 .mwb）并在调用线程上合并
  * - 从 JSON 文件加载敌人蓝图
  * - 解析各种蓝图数据结构
  * - 管理蓝图缓存
@@ -18,223 +19,451 @@
 
 #include "blueprint_manager.h"
 
-#include <string>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <future>
+#include <stdexcept>
+#include <string>
 #include <iostream>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 #include <entt/core/hashed_string.hpp>
 
+#include "../../engine/core/task_pool.h"
+#include "../../engine/io/virtual_fs.h"
+#include "../../engine/memory/memory_estimate.h"
 #include "../../engine/resource/resource_manager.h"
 #include "../../engine/utils/logging.h"
+#include "../../engine/utils/profiler.h"
 
 namespace game::factory {
 
+namespace {
+    // AnimationLibrary 分组，区分不同来源的同名条目
+    constexpr entt::id_type ENEMY_ANIMATION_GROUP = entt::hashed_string("enemy").value();
+    constexpr entt::id_type PLAYER_ANIMATION_GROUP = entt::hashed_string("player").value();
+    constexpr entt::id_type PROJECTILE_ANIMATION_GROUP = entt::hashed_string("projectile").value();
+    constexpr entt::id_type EFFECT_ANIMATION_GROUP = entt::hashed_string("effect").value();
+
+    /// @brief 按 ClassIndex 取稠密数组元素，越界时抛出 std::out_of_range
+    template <typename Value>
+    const Value& checkedAt(const std::vector<Value>& values, ClassIndex index, const char* what) {
+        if (index >= values.size()) {
+            throw std::out_of_range(std::string(what) + ": 下标越界 " + std::to_string(index));
+        }
+        return values[index];
+    }
+
+    /// 预编译蓝图（.mwb）：文件头 + 源 JSON 的 MessagePack 编码
+    constexpr std::uint32_t COOKED_MAGIC = 0x5042574Du;     // "MWBP"（小端）
+    constexpr std::uint32_t COOKED_VERSION = 1;
+    constexpr const char* COOKED_EXTENSION = ".mwb";
+
+    struct CookedBlueprintHeader {
+        std::uint32_t magic_{COOKED_MAGIC};
+        std::uint32_t version_{COOKED_VERSION};
+        std::uint64_t source_size_{0};
+        std::int64_t source_write_time_{0};     ///< std::filesystem::file_time_type 的计数
+    };
+
+    std::string cookedBlueprintPath(const std::string& json_path) {
+        return std::filesystem::path(json_path).replace_extension(COOKED_EXTENSION).string();
+    }
+
+    /**
+     * @brief 读取 json_path 旁的 .mwb；不存在、格式不符或已过期时返回 false
+     * @details 源文件仍在磁盘上时校验大小与修改时间；磁盘上没有源文件（发行包只带预编译数据）时直接使用。
+     */
+    bool readCookedBlueprints(const std::string& json_path, nlohmann::json& out_json) {
+        const auto cooked_path = cookedBlueprintPath(json_path);
+        const auto file = engine::io::VirtualFS::instance().read(cooked_path);
+        if (!file) {
+            return false;
+        }
+        const auto bytes = file->bytes();
+        CookedBlueprintHeader header;
+        if (bytes.size() < sizeof(header)) {
+            ENGINE_LOG_WARN("预编译蓝图文件过小，回退到 JSON: {}", cooked_path);
+            return false;
+        }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (header.magic_ != COOKED_MAGIC || header.version_ != COOKED_VERSION) {
+            ENGINE_LOG_WARN("预编译蓝图格式或版本不匹配，回退到 JSON: {}", cooked_path);
+            return false;
+        }
+
+        std::error_code ec;
+        if (std::filesystem::exists(json_path, ec)) {
+            const auto size = std::filesystem::file_size(json_path, ec);
+            const auto write_time = std::filesystem::last_write_time(json_path, ec);
+            if (ec || size != header.source_size_ || write_time.time_since_epoch().count() != header.source_write_time_) {
+                ENGINE_LOG_INFO("预编译蓝图已过期（源文件变化），回退到 JSON: {}", cooked_path);
+                return false;
+            }
+        }
+
+        const auto* begin = reinterpret_cast<const std::uint8_t*>(bytes.data());
+        out_json = nlohmann::json::from_msgpack(begin + sizeof(header), begin + bytes.size(), true, false);
+        if (out_json.is_discarded()) {
+            ENGINE_LOG_WARN("预编译蓝图解码失败，回退到 JSON: {}", cooked_path);
+            return false;
+        }
+        return true;
+    }
+
+    /// 读取蓝图：优先使用未过期的 .mwb，否则解析 JSON 文本（可在工作线程上调用）
+    bool readBlueprintJson(const std::string& path, const char* kind_name, nlohmann::json& out_json) {
+        if (readCookedBlueprints(path, out_json)) {
+            return true;
+        }
+        const auto input_file = engine::io::VirtualFS::instance().read(path);
+        if (!input_file) {
+            ENGINE_LOG_ERROR("无法打开{}蓝图文件: {}", kind_name, path);
+            return false;
+        }
+        try {
+            out_json = nlohmann::json::parse(input_file->text());
+        } catch (const nlohmann::json::exception& e) {
+            ENGINE_LOG_ERROR("解析{}蓝图 JSON 失败: {}", kind_name, e.what());
+            return false;
+        }
+        return true;
+    }
+}
+
 /**
  * @brief BlueprintManager 构造函数
  * @param resource_manager 资源管理器引用，用于预加载音效
  */
 BlueprintManager::BlueprintManager(engine::resource::ResourceManager& resource_manager)
-    : resource_manager_(resource_manager) {
+    : resource_manager_(&resource_manager) {
     ENGINE_LOG_INFO("BlueprintManager initialized");
 }
 
-/**
- * @brief 从 JSON 文件加载敌人蓝图
- * @param enemy_json_path 敌人数据 JSON 文件路径
- * @return 加载成功返回 true
- * 
- * @details
- * 该方法实现了以下功能：
- * 1. 打开并解析 JSON 文件
- * 2. 遍历 JSON 中的每个敌人类型
- * 3. 解析各个子蓝图（统计、精灵、动画、音效、敌人属性、显示信息）
- * 4. 组装完整的敌人蓝图
- * 5. 将蓝图存入缓存
- * 6. 记录加载结果
- */
-bool BlueprintManager::loadEnemyClassBlueprints(std::string_view enemy_json_path) {
-    std::string path_str(enemy_json_path);
-    std::ifstream input_file(path_str);
-    if (!input_file.is_open()) {
-        ENGINE_LOG_ERROR("无法打开敌人蓝图文件: {}", enemy_json_path);
-        return false;
-    }
-
-    nlohmann::json json_data;
-    try {
-        input_file >> json_data;
-    } catch (const nlohmann::json::exception& e) {
-        ENGINE_LOG_ERROR("解析敌人蓝图 JSON 失败: {}", e.what());
-        return false;
-    }
+BlueprintManager::BlueprintManager() {
+    ENGINE_LOG_INFO("BlueprintManager initialized (no resource preloading)");
+}
 
-    // 遍历 JSON 中的每个敌人类型
-    for (auto& [class_name, data_json] : json_data.items()) {
-        entt::id_type class_id = entt::hashed_string(class_name.c_str());
+bool BlueprintManager::loadEnemyClassBlueprints(std::string_view enemy_json_path) {
+    return loadFile(BlueprintKind::ENEMY, enemy_json_path);
+}
 
-        // 解析各个子蓝图
-        data::StatsBlueprint stats = parseStats(data_json);
-        data::SpriteBlueprint sprite = parseSprite(data_json);
-        auto animations = parseAnimationsMap(data_json);
-        data::SoundBlueprint sounds = parseSound(data_json);
-        data::EnemyBlueprint enemy = parseEnemy(data_json);
-        data::DisplayInfoBlueprint display_info = parseDisplayInfo(data_json);
+bool BlueprintManager::loadPlayerClassBlueprints(std::string_view player_json_path) {
+    return loadFile(BlueprintKind::PLAYER, player_json_path);
+}
 
-        // 组装完整蓝图
-        data::EnemyClassBlueprint blueprint;
-        blueprint.class_id_ = class_id;
-        blueprint.class_name_ = class_name;
-        blueprint.stats_ = stats;
-        blueprint.enemy_ = enemy;
-        blueprint.sounds_ = sounds;
-        blueprint.sprite_ = sprite;
-        blueprint.display_info_ = display_info;
-        blueprint.animations_ = std::move(animations);
+bool BlueprintManager::loadProjectileBlueprints(std::string_view projectile_json_path) {
+    return loadFile(BlueprintKind::PROJECTILE, projectile_json_path);
+}
 
-        // 存入映射表
-        enemy_class_blueprints_.emplace(class_id, std::move(blueprint));
-        ENGINE_LOG_INFO("已加载敌人蓝图: {} (ID: {})", class_name, class_id);
-    }
+bool BlueprintManager::loadEffectBlueprints(std::string_view effect_json_path) {
+    return loadFile(BlueprintKind::EFFECT, effect_json_path);
+}
 
-    ENGINE_LOG_INFO("成功加载 {} 个敌人蓝图", enemy_class_blueprints_.size());
-    return true;
+bool BlueprintManager::loadSkillBlueprints(std::string_view skill_json_path) {
+    return loadFile(BlueprintKind::SKILL, skill_json_path);
 }
 
 /**
- * @brief 从 JSON 文件加载玩家蓝图
- * @param player_json_path 玩家数据 JSON 文件路径
- * @return 加载成功返回 true
+ * @brief 并行解析全部蓝图文件后按固定顺序合并
+ *
+ * @details
+ * 1. 每个文件一个任务：读取（.mwb 或 JSON）、解析子蓝图、构建动画集合，结果写入独立的 ParsedBlueprints
+ * 2. 等待全部任务结束（任务捕获了 this 与 sources，不能提前返回）
+ * 3. 按 敌人、玩家、技能、投射物、特效 的顺序合并，ClassIndex 分配与逐个加载时相同
+ * 4. 一次提交全部音效与纹理的后台加载
  */
-bool BlueprintManager::loadPlayerClassBlueprints(std::string_view player_json_path) {
-    std::string path_str(player_json_path);
-    std::ifstream input_file(path_str);
-    if (!input_file.is_open()) {
-        ENGINE_LOG_ERROR("无法打开玩家蓝图文件: {}", player_json_path);
-        return false;
+bool BlueprintManager::loadAll(const BlueprintSources& sources, engine::core::TaskPool* task_pool) {
+    ENGINE_PROFILE_SCOPE("BlueprintManager::loadAll");
+    const std::array<std::pair<BlueprintKind, const std::string*>, 5> files{{
+        { BlueprintKind::ENEMY, &sources.enemy_ },
+        { BlueprintKind::PLAYER, &sources.player_ },
+        { BlueprintKind::SKILL, &sources.skill_ },
+        { BlueprintKind::PROJECTILE, &sources.projectile_ },
+        { BlueprintKind::EFFECT, &sources.effect_ },
+    }};
+
+    std::vector<std::future<ParsedBlueprints>> futures;
+    futures.reserve(files.size());
+    for (const auto& [kind, path] : files) {
+        futures.push_back(engine::core::runAsync(task_pool, engine::core::TaskPriority::FRAME,
+            [this, kind, path] { return parseFile(kind, *path); }));
+    }
+    for (auto& future : futures) {
+        future.wait();
     }
 
-    nlohmann::json json_data;
-    try {
-        input_file >> json_data;
-    } catch (const nlohmann::json::exception& e) {
-        ENGINE_LOG_ERROR("解析玩家蓝图 JSON 失败: {}", e.what());
+    std::vector<ParsedBlueprints> parsed;
+    parsed.reserve(futures.size());
+    for (auto& future : futures) {
+        parsed.push_back(future.get());
+    }
+    if (!std::ranges::all_of(parsed, &ParsedBlueprints::ok_)) {
         return false;
     }
 
-    // 遍历 JSON 中的每个玩家单位类型
-    for (auto& [class_name, data_json] : json_data.items()) {
-        entt::id_type class_id = entt::hashed_string(class_name.c_str());
-
-        // 解析各个子蓝图
-        data::StatsBlueprint stats = parseStats(data_json);
-        data::SpriteBlueprint sprite = parseSprite(data_json);
-        auto animations = parseAnimationsMap(data_json);
-        data::SoundBlueprint sounds = parseSound(data_json);
-        data::PlayerBlueprint player = parsePlayer(data_json);
-        data::DisplayInfoBlueprint display_info = parseDisplayInfo(data_json);
-
-        // 组装完整蓝图
-        data::PlayerClassBlueprint blueprint;
-        blueprint.class_id_ = class_id;
-        blueprint.class_name_ = class_name;
-        blueprint.stats_ = stats;
-        blueprint.player_ = player;
-        blueprint.sounds_ = sounds;
-        blueprint.sprite_ = sprite;
-        blueprint.display_info_ = display_info;
-        blueprint.animations_ = std::move(animations);
-
-        // 存入映射表
-        player_class_blueprints_.emplace(class_id, std::move(blueprint));
-        ENGINE_LOG_INFO("已加载玩家蓝图: {} (ID: {})", class_name, class_id);
+    for (auto& file : parsed) {
+        merge(std::move(file));
     }
-
-    ENGINE_LOG_INFO("成功加载 {} 个玩家蓝图", player_class_blueprints_.size());
+    requestResources();
     return true;
 }
 
-bool BlueprintManager::loadProjectileBlueprints(std::string_view projectile_json_path) {
-    std::string path_str(projectile_json_path);
-    std::ifstream input_file(path_str);
-    if (!input_file.is_open()) {
-        ENGINE_LOG_ERROR("无法打开投射物蓝图文件: {}", projectile_json_path);
+bool BlueprintManager::loadFile(BlueprintKind kind, std::string_view path) {
+    auto parsed = parseFile(kind, std::string(path));
+    if (!parsed.ok_) {
         return false;
     }
+    merge(std::move(parsed));
+    requestResources();
+    return true;
+}
+
+const char* BlueprintManager::kindName(BlueprintKind kind) {
+    switch (kind) {
+    case BlueprintKind::ENEMY: return "敌人";
+    case BlueprintKind::PLAYER: return "玩家";
+    case BlueprintKind::SKILL: return "技能";
+    case BlueprintKind::PROJECTILE: return "投射物";
+    case BlueprintKind::EFFECT: return "特效";
+    }
+    return "未知";
+}
+
+/**
+ * @brief 读取并解析一个蓝图文件
+ *
+ * @details
+ * 只读取 JSON 与调用各 parse* / build*AnimationSet 辅助函数（均为 const，不访问资源管理器），
+ * 因此多个文件可以同时在不同线程上解析。JSON 类型错误在这里捕获，结果标记为失败。
+ */
+BlueprintManager::ParsedBlueprints BlueprintManager::parseFile(BlueprintKind kind, const std::string& path) const {
+    ParsedBlueprints parsed;
+    parsed.kind_ = kind;
 
     nlohmann::json json_data;
-    try {
-        input_file >> json_data;
-    } catch (const nlohmann::json::exception& e) {
-        ENGINE_LOG_ERROR("解析投射物蓝图 JSON 失败: {}", e.what());
-        return false;
+    if (!readBlueprintJson(path, kindName(kind), json_data)) {
+        return parsed;
     }
 
-    for (auto& [projectile_name, data_json] : json_data.items()) {
-        entt::id_type projectile_id = entt::hashed_string(projectile_name.c_str());
-        auto blueprint = parseProjectile(data_json, projectile_id);
-        projectile_blueprints_.emplace(projectile_id, std::move(blueprint));
-        ENGINE_LOG_INFO("已加载投射物蓝图: {} (ID: {})", projectile_name, projectile_id);
+    try {
+        for (auto& [name, data_json] : json_data.items()) {
+            const entt::id_type id = entt::hashed_string(name.c_str());
+            switch (kind) {
+            case BlueprintKind::ENEMY: {
+                data::EnemyClassBlueprint blueprint;
+                blueprint.class_id_ = id;
+                blueprint.class_name_ = name;
+                blueprint.stats_ = parseStats(data_json);
+                blueprint.enemy_ = parseEnemy(data_json);
+                blueprint.sounds_ = parseSound(data_json);
+                blueprint.sprite_ = parseSprite(data_json);
+                blueprint.display_info_ = parseDisplayInfo(data_json);
+                blueprint.animations_ = parseAnimationsMap(data_json);
+                parsed.animation_sets_.push_back(buildClassAnimationSet(blueprint.animations_, blueprint.sprite_));
+                parsed.enemies_.push_back(std::move(blueprint));
+                break;
+            }
+            case BlueprintKind::PLAYER: {
+                data::PlayerClassBlueprint blueprint;
+                blueprint.class_id_ = id;
+                blueprint.class_name_ = name;
+                blueprint.stats_ = parseStats(data_json);
+                blueprint.player_ = parsePlayer(data_json);
+                blueprint.sounds_ = parseSound(data_json);
+                blueprint.sprite_ = parseSprite(data_json);
+                blueprint.display_info_ = parseDisplayInfo(data_json);
+                blueprint.animations_ = parseAnimationsMap(data_json);
+                // 玩家单位与准备单位共用同一份动画集合
+                parsed.animation_sets_.push_back(buildClassAnimationSet(blueprint.animations_, blueprint.sprite_));
+                parsed.players_.push_back(std::move(blueprint));
+                break;
+            }
+            case BlueprintKind::SKILL:
+                parsed.skills_.push_back(parseSkill(data_json, id));
+                break;
+            case BlueprintKind::PROJECTILE:
+                parsed.projectiles_.push_back(parseProjectile(data_json, id));
+                parsed.animation_sets_.push_back(buildProjectileAnimationSet(parsed.projectiles_.back()));
+                break;
+            case BlueprintKind::EFFECT:
+                parsed.effects_.push_back(parseEffect(data_json, id));
+                parsed.animation_sets_.push_back(buildEffectAnimationSet(parsed.effects_.back()));
+                break;
+            }
+        }
+    } catch (const nlohmann::json::exception& e) {
+        ENGINE_LOG_ERROR("解析{}蓝图失败: {} ({})", kindName(kind), path, e.what());
+        return parsed;
     }
 
-    ENGINE_LOG_INFO("成功加载 {} 个投射物蓝图", projectile_blueprints_.size());
-    return true;
+    parsed.ok_ = true;
+    return parsed;
 }
 
-bool BlueprintManager::loadEffectBlueprints(std::string_view effect_json_path) {
-    std::string path_str(effect_json_path);
-    std::ifstream input_file(path_str);
-    if (!input_file.is_open()) {
-        ENGINE_LOG_ERROR("无法打开特效蓝图文件: {}", effect_json_path);
-        return false;
+/**
+ * @brief 把解析结果写入蓝图表与动画库
+ * @details 职业蓝图存入稠密数组，ID 在此处一次性解析为下标；同 ID 的后加载蓝图原地覆盖。
+ */
+void BlueprintManager::merge(ParsedBlueprints&& parsed) {
+    auto& animation_sets = parsed.animation_sets_;
+    switch (parsed.kind_) {
+    case BlueprintKind::ENEMY:
+        for (std::size_t i = 0; i < parsed.enemies_.size(); ++i) {
+            auto& blueprint = parsed.enemies_[i];
+            const auto class_id = blueprint.class_id_;
+            auto animation_set = animation_library_.add(ENEMY_ANIMATION_GROUP, class_id, std::move(animation_sets[i]));
+            const auto index = storeClass(enemy_classes_, enemy_class_animations_, enemy_class_index_, std::move(blueprint), std::move(animation_set));
+            if (index == INVALID_CLASS_INDEX) {
+                ENGINE_LOG_ERROR("敌人职业数量超过上限，忽略: {}", class_id);
+                continue;
+            }
+            ENGINE_LOG_INFO("已加载敌人蓝图: {} (ID: {}, 下标: {})", enemy_classes_[index].class_name_, class_id, index);
+        }
+        ENGINE_LOG_INFO("成功加载 {} 个敌人蓝图", enemy_classes_.size());
+        break;
+    case BlueprintKind::PLAYER:
+        for (std::size_t i = 0; i < parsed.players_.size(); ++i) {
+            auto& blueprint = parsed.players_[i];
+            const auto class_id = blueprint.class_id_;
+            auto animation_set = animation_library_.add(PLAYER_ANIMATION_GROUP, class_id, std::move(animation_sets[i]));
+            const auto index = storeClass(player_classes_, player_class_animations_, player_class_index_, std::move(blueprint), std::move(animation_set));
+            if (index == INVALID_CLASS_INDEX) {
+                ENGINE_LOG_ERROR("玩家职业数量超过上限，忽略: {}", class_id);
+                continue;
+            }
+            ENGINE_LOG_INFO("已加载玩家蓝图: {} (ID: {}, 下标: {})", player_classes_[index].class_name_, class_id, index);
+        }
+        ENGINE_LOG_INFO("成功加载 {} 个玩家蓝图", player_classes_.size());
+        break;
+    case BlueprintKind::SKILL:
+        for (auto& blueprint : parsed.skills_) {
+            const auto skill_id = blueprint.skill_id_;
+            skill_blueprints_.emplace(skill_id, std::move(blueprint));
+        }
+        ENGINE_LOG_INFO("成功加载 {} 个技能蓝图", skill_blueprints_.size());
+        break;
+    case BlueprintKind::PROJECTILE:
+        for (std::size_t i = 0; i < parsed.projectiles_.size(); ++i) {
+            auto& blueprint = parsed.projectiles_[i];
+            const auto projectile_id = blueprint.projectile_id_;
+            animation_library_.add(PROJECTILE_ANIMATION_GROUP, projectile_id, std::move(animation_sets[i]));
+            projectile_blueprints_.emplace(projectile_id, std::move(blueprint));
+        }
+        ENGINE_LOG_INFO("成功加载 {} 个投射物蓝图", projectile_blueprints_.size());
+        break;
+    case BlueprintKind::EFFECT:
+        for (std::size_t i = 0; i < parsed.effects_.size(); ++i) {
+            auto& blueprint = parsed.effects_[i];
+            const auto effect_id = blueprint.effect_id_;
+            animation_library_.add(EFFECT_ANIMATION_GROUP, effect_id, std::move(animation_sets[i]));
+            effect_blueprints_.emplace(effect_id, std::move(blueprint));
+        }
+        ENGINE_LOG_INFO("成功加载 {} 个特效蓝图", effect_blueprints_.size());
+        break;
     }
+}
 
-    nlohmann::json json_data;
-    try {
-        input_file >> json_data;
-    } catch (const nlohmann::json::exception& e) {
-        ENGINE_LOG_ERROR("解析特效蓝图 JSON 失败: {}", e.what());
-        return false;
+/**
+ * @brief 汇总职业音效与投射物/特效纹理，一次提交后台加载
+ * @details 音效通过资源映射表解析真实路径，解码在工作线程进行；重复的资源只提交一次。
+ */
+void BlueprintManager::requestResources() const {
+    if (!resource_manager_) {
+        return;
     }
+    engine::resource::PreloadManifest manifest;
+    std::unordered_set<entt::id_type> seen_textures;
+    std::unordered_set<entt::id_type> seen_sounds;
+    auto add_sounds = [&](const data::SoundBlueprint& sounds) {
+        if (!sounds.table_) {
+            return;
+        }
+        for (const auto sound_id : sounds.table_->sounds_) {
+            if (seen_sounds.insert(sound_id).second) {
+                manifest.sounds_.push_back(sound_id);
+            }
+        }
+    };
+    auto add_texture = [&](const data::SpriteBlueprint& sprite) {
+        if (!sprite.path_.empty() && seen_textures.insert(sprite.id_).second) {
+            manifest.textures_.push_back(sprite.path_);
+        }
+    };
 
-    for (auto& [effect_name, data_json] : json_data.items()) {
-        entt::id_type effect_id = entt::hashed_string(effect_name.c_str());
-        auto blueprint = parseEffect(data_json, effect_id);
-        effect_blueprints_.emplace(effect_id, std::move(blueprint));
-        ENGINE_LOG_INFO("已加载特效蓝图: {} (ID: {})", effect_name, effect_id);
+    for (const auto& blueprint : enemy_classes_) {
+        add_sounds(blueprint.sounds_);
     }
-
-    ENGINE_LOG_INFO("成功加载 {} 个特效蓝图", effect_blueprints_.size());
-    return true;
+    for (const auto& blueprint : player_classes_) {
+        add_sounds(blueprint.sounds_);
+    }
+    for (const auto& [id, projectile] : projectile_blueprints_) {
+        add_texture(projectile.sprite_);
+    }
+    for (const auto& [id, effect] : effect_blueprints_) {
+        add_texture(effect.sprite_);
+    }
+    resource_manager_->requestPreload(manifest);
 }
 
-bool BlueprintManager::loadSkillBlueprints(std::string_view skill_json_path) {
-    std::string path_str(skill_json_path);
-    std::ifstream input_file(path_str);
-    if (!input_file.is_open()) {
-        ENGINE_LOG_ERROR("无法打开技能蓝图文件: {}", skill_json_path);
+bool BlueprintManager::cookBlueprintFile(const std::string& json_path, std::string& error_message) {
+    std::error_code ec;
+    CookedBlueprintHeader header;
+    header.source_size_ = std::filesystem::file_size(json_path, ec);
+    if (ec) {
+        error_message = "无法读取蓝图源文件: " + json_path;
         return false;
     }
-
-    nlohmann::json json_data;
-    try {
-        input_file >> json_data;
-    } catch (const nlohmann::json::exception& e) {
-        ENGINE_LOG_ERROR("解析技能蓝图 JSON 失败: {}", e.what());
+    header.source_write_time_ = static_cast<std::int64_t>(std::filesystem::last_write_time(json_path, ec).time_since_epoch().count());
+    if (ec) {
+        error_message = "无法读取蓝图源文件修改时间: " + json_path;
         return false;
     }
 
-    for (auto& [skill_name, data_json] : json_data.items()) {
-        entt::id_type skill_id = entt::hashed_string(skill_name.c_str());
-        auto blueprint = parseSkill(data_json, skill_id);
-        skill_blueprints_.emplace(skill_id, std::move(blueprint));
-        ENGINE_LOG_INFO("已加载技能蓝图: {} (ID: {})", skill_name, skill_id);
+    std::vector<std::uint8_t> payload;
+    {
+        std::ifstream input(json_path, std::ios::binary);
+        if (!input.is_open()) {
+            error_message = "无法打开蓝图源文件: " + json_path;
+            return false;
+        }
+        try {
+            payload = nlohmann::json::to_msgpack(nlohmann::json::parse(input));
+        } catch (const nlohmann::json::exception& e) {
+            error_message = "解析蓝图 JSON 失败: " + json_path + " (" + e.what() + ")";
+            return false;
+        }
     }
 
-    ENGINE_LOG_INFO("成功加载 {} 个技能蓝图", skill_blueprints_.size());
+    const auto cooked_path = cookedBlueprintPath(json_path);
+    const std::string temp_path = cooked_path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            error_message = "无法写入预编译蓝图: " + temp_path;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        if (!file) {
+            error_message = "写入预编译蓝图失败: " + temp_path;
+            return false;
+        }
+    }
+    std::filesystem::rename(temp_path, cooked_path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        error_message = "无法替换预编译蓝图: " + cooked_path;
+        return false;
+    }
+    ENGINE_LOG_INFO("蓝图预编译完成: {} -> {}（{} 字节）", json_path, cooked_path, payload.size());
     return true;
 }
 
@@ -245,7 +474,7 @@ bool BlueprintManager::loadSkillBlueprints(std::string_view skill_json_path) {
  * @throws std::out_of_range 如果蓝图不存在
  */
 const data::EnemyClassBlueprint& BlueprintManager::getEnemyClassBlueprint(entt::id_type id) const {
-    return enemy_class_blueprints_.at(id);
+    return enemy_classes_[engine::utils::getOrThrow(enemy_class_index_, id, "敌人蓝图")];
 }
 
 /**
@@ -255,7 +484,7 @@ const data::EnemyClassBlueprint& BlueprintManager::getEnemyClassBlueprint(entt::
  * @throws std::out_of_range 如果蓝图不存在
  */
 const data::PlayerClassBlueprint& BlueprintManager::getPlayerClassBlueprint(entt::id_type id) const {
-    return player_class_blueprints_.at(id);
+    return player_classes_[engine::utils::getOrThrow(player_class_index_, id, "玩家蓝图")];
 }
 
 /**
@@ -264,7 +493,7 @@ const data::PlayerClassBlueprint& BlueprintManager::getPlayerClassBlueprint(entt
  * @return 存在返回 true
  */
 bool BlueprintManager::hasEnemyClassBlueprint(entt::id_type id) const {
-    return enemy_class_blueprints_.find(id) != enemy_class_blueprints_.end();
+    return enemy_class_index_.contains(id);
 }
 
 /**
@@ -273,31 +502,151 @@ bool BlueprintManager::hasEnemyClassBlueprint(entt::id_type id) const {
  * @return 存在返回 true
  */
 bool BlueprintManager::hasPlayerClassBlueprint(entt::id_type id) const {
-    return player_class_blueprints_.find(id) != player_class_blueprints_.end();
+    return player_class_index_.contains(id);
+}
+
+ClassIndex BlueprintManager::findEnemyClass(entt::id_type id) const {
+    auto it = enemy_class_index_.find(id);
+    return it == enemy_class_index_.end() ? INVALID_CLASS_INDEX : it->second;
+}
+
+ClassIndex BlueprintManager::findPlayerClass(entt::id_type id) const {
+    auto it = player_class_index_.find(id);
+    return it == player_class_index_.end() ? INVALID_CLASS_INDEX : it->second;
+}
+
+const data::EnemyClassBlueprint& BlueprintManager::getEnemyClassAt(ClassIndex index) const {
+    return checkedAt(enemy_classes_, index, "敌人蓝图");
+}
+
+const data::PlayerClassBlueprint& BlueprintManager::getPlayerClassAt(ClassIndex index) const {
+    return checkedAt(player_classes_, index, "玩家蓝图");
+}
+
+engine::resource::AnimationLibrary::AnimationSetPtr BlueprintManager::getEnemyAnimationSetAt(ClassIndex index) const {
+    return checkedAt(enemy_class_animations_, index, "敌人动画集合");
+}
+
+engine::resource::AnimationLibrary::AnimationSetPtr BlueprintManager::getPlayerAnimationSetAt(ClassIndex index) const {
+    return checkedAt(player_class_animations_, index, "玩家动画集合");
+}
+
+template <typename Blueprint>
+ClassIndex BlueprintManager::storeClass(std::vector<Blueprint>& classes,
+                                        std::vector<engine::resource::AnimationLibrary::AnimationSetPtr>& animations,
+                                        engine::utils::IdMap<ClassIndex>& index,
+                                        Blueprint blueprint,
+                                        engine::resource::AnimationLibrary::AnimationSetPtr animation_set) {
+    if (auto it = index.find(blueprint.class_id_); it != index.end()) {
+        classes[it->second] = std::move(blueprint);
+        animations[it->second] = std::move(animation_set);
+        return it->second;
+    }
+    if (classes.size() >= INVALID_CLASS_INDEX) {
+        return INVALID_CLASS_INDEX;
+    }
+    const auto slot = static_cast<ClassIndex>(classes.size());
+    index.emplace(blueprint.class_id_, slot);
+    classes.push_back(std::move(blueprint));
+    animations.push_back(std::move(animation_set));
+    return slot;
 }
 
 bool BlueprintManager::hasProjectileBlueprint(entt::id_type id) const {
-    return projectile_blueprints_.find(id) != projectile_blueprints_.end();
+    return projectile_blueprints_.contains(id);
 }
 
 bool BlueprintManager::hasEffectBlueprint(entt::id_type id) const {
-    return effect_blueprints_.find(id) != effect_blueprints_.end();
+    return effect_blueprints_.contains(id);
 }
 
 bool BlueprintManager::hasSkillBlueprint(entt::id_type id) const {
-    return skill_blueprints_.find(id) != skill_blueprints_.end();
+    return skill_blueprints_.contains(id);
 }
 
 const data::ProjectileBlueprint& BlueprintManager::getProjectileBlueprint(entt::id_type id) const {
-    return projectile_blueprints_.at(id);
+    return engine::utils::getOrThrow(projectile_blueprints_, id, "投射物蓝图");
 }
 
 const data::EffectBlueprint& BlueprintManager::getEffectBlueprint(entt::id_type id) const {
-    return effect_blueprints_.at(id);
+    return engine::utils::getOrThrow(effect_blueprints_, id, "特效蓝图");
 }
 
 const data::SkillBlueprint& BlueprintManager::getSkillBlueprint(entt::id_type id) const {
-    return skill_blueprints_.at(id);
+    return engine::utils::getOrThrow(skill_blueprints_, id, "技能蓝图");
+}
+
+engine::resource::AnimationLibrary::AnimationSetPtr BlueprintManager::getEnemyAnimationSet(entt::id_type id) const {
+    return animation_library_.get(ENEMY_ANIMATION_GROUP, id);
+}
+
+engine::resource::AnimationLibrary::AnimationSetPtr BlueprintManager::getPlayerAnimationSet(entt::id_type id) const {
+    return animation_library_.get(PLAYER_ANIMATION_GROUP, id);
+}
+
+engine::resource::AnimationLibrary::AnimationSetPtr BlueprintManager::getProjectileAnimationSet(entt::id_type id) const {
+    return animation_library_.get(PROJECTILE_ANIMATION_GROUP, id);
+}
+
+engine::resource::AnimationLibrary::AnimationSetPtr BlueprintManager::getEffectAnimationSet(entt::id_type id) const {
+    return animation_library_.get(EFFECT_ANIMATION_GROUP, id);
+}
+
+/**
+ * @brief 根据动画蓝图与精灵蓝图构建单位动画集合
+ * @param animations 动画蓝图映射
+ * @param sprite 精灵蓝图数据（用于计算帧大小）
+ * @return 动画集合
+ */
+engine::component::AnimationSet BlueprintManager::buildClassAnimationSet(
+    const std::unordered_map<entt::id_type, data::AnimationBlueprint>& animations,
+    const data::SpriteBlueprint& sprite) const
+{
+    engine::component::AnimationSet anim_map;
+    const float frame_width = sprite.src_rect_.size.x;
+    const float frame_height = sprite.src_rect_.size.y;
+
+    for (const auto& [anim_id, anim_blueprint] : animations) {
+        std::vector<engine::component::AnimationFrame> frames;
+        frames.reserve(anim_blueprint.frames_.size());
+        for (int frame_idx : anim_blueprint.frames_) {
+            float x = frame_idx * frame_width;
+            float y = anim_blueprint.row_ * frame_height;
+            engine::utils::Rect frame_rect{x, y, frame_width, frame_height};
+            frames.emplace_back(frame_rect, anim_blueprint.ms_per_frame_);
+        }
+
+        anim_map.emplace(anim_id, engine::component::Animation{std::move(frames), anim_blueprint.events_, true});
+    }
+    return anim_map;
+}
+
+/**
+ * @brief 构建投射物飞行动画（单帧，时长等于飞行时间，不循环）
+ */
+engine::component::AnimationSet BlueprintManager::buildProjectileAnimationSet(const data::ProjectileBlueprint& blueprint) const {
+    const float flight_time = blueprint.total_flight_time_ > 0.1f ? blueprint.total_flight_time_ : 0.1f;
+    std::vector<engine::component::AnimationFrame> frames;
+    frames.emplace_back(blueprint.sprite_.src_rect_, flight_time * 1000.0f);
+    engine::component::AnimationSet animations;
+    animations.emplace(entt::hashed_string("fly"), engine::component::Animation{ std::move(frames), {}, false });
+    return animations;
+}
+
+/**
+ * @brief 构建特效动画（以特效ID作为动画ID，不循环）
+ */
+engine::component::AnimationSet BlueprintManager::buildEffectAnimationSet(const data::EffectBlueprint& blueprint) const {
+    std::vector<engine::component::AnimationFrame> frames;
+    for (int frame_index : blueprint.animation_.frames_) {
+        const float x = blueprint.sprite_.src_rect_.position.x + blueprint.sprite_.src_rect_.size.x * static_cast<float>(frame_index);
+        const float y = blueprint.sprite_.src_rect_.position.y + blueprint.animation_.row_ * blueprint.sprite_.src_rect_.size.y;
+        engine::utils::Rect frame_rect{ x, y, blueprint.sprite_.src_rect_.size.x, blueprint.sprite_.src_rect_.size.y };
+        frames.emplace_back(frame_rect, blueprint.animation_.ms_per_frame_);
+    }
+    engine::component::AnimationSet animations;
+    animations.emplace(blueprint.effect_id_, engine::component::Animation{ std::move(frames), {}, false });
+    return animations;
 }
 
 /**
@@ -383,24 +732,24 @@ BlueprintManager::parseAnimationsMap(const nlohmann::json& json) const
  * @return 解析后的音效蓝图
  * 
  * @details
- * 该方法不仅解析音效数据，还会预加载音效资源到 ResourceManager。
+ * 只记录音效 ID；预加载在合并后由 requestResources() 统一提交。
  */
-data::SoundBlueprint BlueprintManager::parseSound(const nlohmann::json& json) {
+data::SoundBlueprint BlueprintManager::parseSound(const nlohmann::json& json) const {
     data::SoundBlueprint sounds;
 
     if (!json.contains("sounds")) {
         return sounds;
     }
 
+    auto table = std::make_shared<engine::component::SoundTable>();
     for (auto& [sound_key, sound_value] : json["sounds"].items()) {
         std::string sound_key_name = sound_value.get<std::string>();
         entt::id_type sound_id = entt::hashed_string(sound_key_name.c_str());
-
-      // 通过资源映射表解析真实音效路径并预加载
-        resource_manager_.getSound(sound_id);
-
         entt::id_type sound_key_id = entt::hashed_string(sound_key.c_str());
-        sounds.sounds_.emplace(sound_key_id, sound_id);
+        table->add(sound_key_id, sound_id);
+    }
+    if (!table->empty()) {
+        sounds.table_ = std::move(table);
     }
 
     return sounds;
@@ -433,6 +782,10 @@ data::PlayerBlueprint BlueprintManager::parsePlayer(const nlohmann::json& json)
                     game::defs::PlayerType::UNKNOWN);
     player.is_healer_ = json.value("healer", false);
     player.block_ = json.value("block", 0);
+    if (player.block_ > game::defs::MAX_BLOCK_COUNT) {
+        ENGINE_LOG_WARN("阻挡数 {} 超过上限，截断为 {}", player.block_, game::defs::MAX_BLOCK_COUNT);
+        player.block_ = game::defs::MAX_BLOCK_COUNT;
+    }
     player.cost_ = json.value("cost", 0);
     if (json.contains("skill")) {
         player.skill_id_ = entt::hashed_string(json["skill"].get<std::string>().c_str()).value();
@@ -440,6 +793,35 @@ data::PlayerBlueprint BlueprintManager::parsePlayer(const nlohmann::json& json)
     if (json.contains("projectile")) {
         player.projectile_id_ = entt::hashed_string(json["projectile"].get<std::string>().c_str()).value();
     }
+    const auto policy = json.value("target_policy", "");
+    if (policy == "closest") {
+        player.target_policy_ = game::defs::TargetPolicy::CLOSEST;
+    } else if (policy == "first") {
+        player.target_policy_ = game::defs::TargetPolicy::FIRST_ALONG_PATH;
+    } else if (policy == "lowest_hp") {
+        player.target_policy_ = game::defs::TargetPolicy::LOWEST_HP;
+    } else if (policy == "threat") {
+        player.target_policy_ = game::defs::TargetPolicy::HIGHEST_THREAT;
+    } else {
+        if (!policy.empty()) {
+            ENGINE_LOG_WARN("未知的索敌策略 \"{}\"，按单位类型使用默认策略", policy);
+        }
+        player.target_policy_ = game::defs::defaultTargetPolicy(player.type_);
+    }
+    if (const auto area = json.find("area"); area != json.end() && area->is_object()) {
+        const auto shape = area->value("shape", "");
+        if (shape == "circle") {
+            player.area_shape_ = game::defs::AreaShape::CIRCLE;
+        } else if (shape == "cone") {
+            player.area_shape_ = game::defs::AreaShape::CONE;
+        } else if (shape == "line") {
+            player.area_shape_ = game::defs::AreaShape::CAPSULE;
+        } else {
+            ENGINE_LOG_WARN("未知的范围攻击形状 \"{}\"，按单体攻击处理", shape);
+        }
+        player.area_radius_ = area->value("radius", 0.0f);
+        player.area_half_angle_ = area->value("angle", 45.0f);
+    }
     return player;
 }
 
@@ -455,7 +837,7 @@ data::DisplayInfoBlueprint BlueprintManager::parseDisplayInfo(const nlohmann::js
     return display_info;
 }
 
-data::ProjectileBlueprint BlueprintManager::parseProjectile(const nlohmann::json& json, entt::id_type projectile_id) {
+data::ProjectileBlueprint BlueprintManager::parseProjectile(const nlohmann::json& json, entt::id_type projectile_id) const {
     data::ProjectileBlueprint projectile;
     projectile.projectile_id_ = projectile_id;
     projectile.sprite_.path_ = json.value("sprite_sheet", "");
@@ -472,11 +854,22 @@ data::ProjectileBlueprint BlueprintManager::parseProjectile(const nlohmann::json
     projectile.arc_height_ = json.value("arc_height", 0.0f);
     projectile.total_flight_time_ = json.value("total_flight_time", 0.5f);
     projectile.rotation_offset_deg_ = json.value("rotation_offset_deg", 0.0f);
-    resource_manager_.loadTexture(projectile.sprite_.id_, projectile.sprite_.path_);
+    projectile.pool_size_ = json.value("pool_size", game::defs::PROJECTILE_POOL_SIZE);
+    if (auto it = json.find("simulated"); it != json.end() && it->is_object()) {
+        projectile.simulated_ = true;
+        projectile.speed_ = it->value("speed", projectile.speed_);
+        projectile.hit_radius_ = it->value("radius", projectile.hit_radius_);
+        projectile.pierce_ = it->value("pierce", projectile.pierce_);
+        projectile.lifetime_ = it->value("lifetime", projectile.lifetime_);
+        if (projectile.speed_ <= 0.0f || projectile.lifetime_ <= 0.0f) {
+            ENGINE_LOG_WARN("投射物 {} 的 simulated 速度或飞行时间无效，按立即命中处理", projectile_id);
+            projectile.simulated_ = false;
+        }
+    }
     return projectile;
 }
 
-data::EffectBlueprint BlueprintManager::parseEffect(const nlohmann::json& json, entt::id_type effect_id) {
+data::EffectBlueprint BlueprintManager::parseEffect(const nlohmann::json& json, entt::id_type effect_id) const {
     data::EffectBlueprint effect;
     effect.effect_id_ = effect_id;
     effect.sprite_.path_ = json.value("sprite_sheet", "");
@@ -492,6 +885,17 @@ data::EffectBlueprint BlueprintManager::parseEffect(const nlohmann::json& json,
     effect.sprite_.src_rect_ = engine::utils::Rect{ x, y, width, height };
     effect.sprite_.size_ = glm::vec2{ size_x, size_y };
     effect.sprite_.offset_ = glm::vec2{ json.value("offset_x", 0.0f), json.value("offset_y", 0.0f) };
+    effect.pool_size_ = json.value("pool_size", game::defs::EFFECT_POOL_SIZE);
+    if (json.contains("particles") && json["particles"].is_object()) {
+        const auto& particles_json = json["particles"];
+        effect.particle_capacity_ = particles_json.value("capacity", 0);
+        effect.particle_rise_speed_ = particles_json.value("rise_speed", 0.0f);
+        effect.particle_fade_ = particles_json.value("fade", false);
+        if (effect.particle_capacity_ <= 0) {
+            ENGINE_LOG_WARN("特效粒子容量无效: {}，使用池化实体", effect.particle_capacity_);
+            effect.particle_capacity_ = 0;
+        }
+    }
 
     if (json.contains("animation") && json["animation"].is_object()) {
         const auto& anim_json = json["animation"];
@@ -501,11 +905,99 @@ data::EffectBlueprint BlueprintManager::parseEffect(const nlohmann::json& json,
             effect.animation_.frames_ = anim_json["frames"].get<std::vector<int>>();
         }
     }
-
-    resource_manager_.loadTexture(effect.sprite_.id_, effect.sprite_.path_);
     return effect;
 }
 
+namespace {
+
+/// @brief 按 ID 去重地把精灵表与音效表加入清单
+struct ManifestBuilder {
+    engine::resource::PreloadManifest manifest_;
+    std::unordered_set<entt::id_type> seen_textures_;
+    std::unordered_set<entt::id_type> seen_sounds_;
+
+    void add(const data::SpriteBlueprint& sprite, const data::SoundBlueprint& sounds) {
+        if (!sprite.path_.empty() && seen_textures_.insert(sprite.id_).second) {
+            manifest_.textures_.push_back(sprite.path_);
+        }
+        if (!sounds.table_) {
+            return;
+        }
+        for (const auto sound_id : sounds.table_->sounds_) {
+            if (seen_sounds_.insert(sound_id).second) {
+                manifest_.sounds_.push_back(sound_id);
+            }
+        }
+    }
+};
+
+} // namespace
+
+engine::resource::PreloadManifest BlueprintManager::buildSharedManifest() const {
+    ManifestBuilder builder;
+    for (const auto& player : player_classes_) {
+        builder.add(player.sprite_, player.sounds_);
+    }
+    for (const auto& [id, projectile] : projectile_blueprints_) {
+        builder.add(projectile.sprite_, {});
+    }
+    for (const auto& [id, effect] : effect_blueprints_) {
+        builder.add(effect.sprite_, {});
+    }
+    return std::move(builder.manifest_);
+}
+
+engine::resource::PreloadManifest BlueprintManager::buildWaveManifest(const data::WaveConfig& wave) const {
+    ManifestBuilder builder;
+    for (const auto& group : wave.groups_) {
+        if (const auto index = findEnemyClass(group.class_id_); index != INVALID_CLASS_INDEX) {
+            builder.add(enemy_classes_[index].sprite_, enemy_classes_[index].sounds_);
+        }
+    }
+    return std::move(builder.manifest_);
+}
+
+std::size_t BlueprintManager::getMemoryBytes() const {
+    using engine::memory::containerBytes;
+    auto animation_bytes = [](const data::AnimationBlueprint& animation) {
+        return containerBytes(animation.events_) + containerBytes(animation.frames_);
+    };
+    auto class_bytes = [&](const auto& blueprint) {
+        std::size_t bytes = containerBytes(blueprint.class_name_) + containerBytes(blueprint.sprite_.path_) +
+                            containerBytes(blueprint.animations_) +
+                            containerBytes(blueprint.display_info_.name_) + containerBytes(blueprint.display_info_.description_);
+        for (const auto& [id, animation] : blueprint.animations_) {
+            bytes += animation_bytes(animation);
+        }
+        if (const auto& table = blueprint.sounds_.table_) {
+            bytes += sizeof(*table) + containerBytes(table->actions_) + containerBytes(table->sounds_);
+        }
+        return bytes;
+    };
+
+    std::size_t bytes = containerBytes(enemy_classes_) + containerBytes(player_classes_) +
+                        containerBytes(enemy_class_animations_) + containerBytes(player_class_animations_) +
+                        containerBytes(enemy_class_index_) + containerBytes(player_class_index_) +
+                        containerBytes(projectile_blueprints_) + containerBytes(effect_blueprints_) +
+                        containerBytes(skill_blueprints_);
+    for (const auto& blueprint : enemy_classes_) {
+        bytes += class_bytes(blueprint);
+    }
+    for (const auto& blueprint : player_classes_) {
+        bytes += class_bytes(blueprint);
+    }
+    for (const auto& [id, projectile] : projectile_blueprints_) {
+        bytes += containerBytes(projectile.sprite_.path_);
+    }
+    for (const auto& [id, effect] : effect_blueprints_) {
+        bytes += containerBytes(effect.sprite_.path_) + animation_bytes(effect.animation_);
+    }
+    for (const auto& [id, skill] : skill_blueprints_) {
+        bytes += containerBytes(skill.name_) + containerBytes(skill.description_);
+    }
+    return bytes;
+}
+
 data::SkillBlueprint BlueprintManager::parseSkill(const nlohmann::json& json, entt::id_type skill_id) const {
     data::SkillBlueprint skill;
     skill.skill_id_ = skill_id;
@@ -519,6 +1011,8 @@ data::SkillBlueprint BlueprintManager::parseSkill(const nlohmann::json& json, en
     skill.cooldown_ = json.value("cooldown", 0.0f);
     skill.duration_ = json.value("duration", 0.0f);
     skill.cost_regen_ = json.value("cost_regen", 0.0f);
+    skill.area_radius_ = json.value("area_radius", 0.0f);
+    skill.area_damage_multiplier_ = json.value("area_damage", 1.0f);
     return skill;
 }
 
@@ -1,14 +1,40 @@
 #pragma once
+#include <cstdint>
+#include <limits>
+#include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include <entt/core/hashed_string.hpp>
 #include "../data/entity_blueprint.h"
+#include "../data/level_config.h"
+#include "../../engine/resource/resource_manager.h"
+#include "../../engine/resource/animation_library.h"
+#include "../../engine/utils/id_map.h"
 
-namespace engine::resource { class ResourceManager; }
+namespace engine::core {
+class TaskPool;
+}
 
 namespace game::factory {
 
+/// @brief 已加载职业蓝图在稠密数组中的下标（加载时按 JSON 中的出现顺序分配）
+using ClassIndex = std::uint16_t;
+inline constexpr ClassIndex INVALID_CLASS_INDEX = std::numeric_limits<ClassIndex>::max();
+
+/// @brief 全部蓝图源文件（JSON 路径；同目录同名的 .mwb 预编译文件可用时优先读取）
+struct BlueprintSources {
+    std::string enemy_{ "assets/data/enemy_data.json" };
+    std::string player_{ "assets/data/player_data.json" };
+    std::string skill_{ "assets/data/skill_data.json" };
+    std::string projectile_{ "assets/data/projectile_data.json" };
+    std::string effect_{ "assets/data/effect_data.json" };
+
+    /// @brief 按 loadAll() 的合并顺序列出全部路径（ContentCache 依赖列表、预编译使用）
+    [[nodiscard]] std::vector<std::string> paths() const { return { enemy_, player_, skill_, projectile_, effect_ }; }
+};
+
 /**
  * @class BlueprintManager
  * @brief 蓝图管理器，负责加载和缓存单位蓝图数据
@@ -16,6 +42,16 @@ namespace game::factory {
  * @details
  * BlueprintManager 从 JSON 文件加载敌人/单位的蓝图配置，解析为 C++ 结构体，
  * 并使用哈希ID作为 key 存储在内存中供后续查询。同时负责预加载音效资源。
+ *
+ * 加载蓝图时会为每个类别构建一份不可变的动画集合并存入 AnimationLibrary，
+ * EntityFactory 生成实体时只需引用共享句柄，无需逐实体复制动画数据。
+ *
+ * 敌人与玩家职业蓝图按加载顺序存放在连续数组中，ID 只在加载时解析一次为 ClassIndex；
+ * 之后的生成与费用查询可直接以下标访问蓝图与动画集合（*At 系列接口，越界时抛出异常）。
+ *
+ * 加载分三步：各文件独立解析为 ParsedBlueprints（只读 JSON，可在工作线程上并行）；在调用线程上按固定顺序合并；
+ * 最后把全部音效与纹理汇成一份 PreloadManifest，一次提交给 ResourceManager。
+ * 源文件旁存在未过期的 .mwb（MessagePack 编码，见 cookBlueprintFile）时读取它，省去 JSON 文本解析。
  */
 class BlueprintManager {
 public:
@@ -25,6 +61,28 @@ public:
      */
     explicit BlueprintManager(engine::resource::ResourceManager& resource_manager);
 
+    /**
+     * @brief 无资源管理器的构造函数（无头模拟使用）
+     * @details 只解析蓝图数据，不预加载音效与纹理。
+     */
+    BlueprintManager();
+
+    /**
+     * @brief 并行解析全部蓝图文件，在调用线程上合并，最后一次性提交资源预加载
+     * @param sources 蓝图源文件
+     * @param task_pool 非空时各文件提交到该线程池解析，否则退回 std::async（无头模拟、基准）；调用线程阻塞到全部解析完成
+     * @return 全部文件读取成功返回 true；失败时不合并任何文件
+     */
+    [[nodiscard]] bool loadAll(const BlueprintSources& sources = {}, engine::core::TaskPool* task_pool = nullptr);
+
+    /**
+     * @brief 把蓝图 JSON 预编译为同目录同名的 .mwb（文件头记录源文件大小与修改时间 + MessagePack 正文）
+     * @details 源文件仍在磁盘上且大小或修改时间不一致时，运行时判定过期并回退到 JSON；
+     *          发行包中只带 .mwb、磁盘上没有源文件时直接使用。
+     * @return 写入成功返回 true
+     */
+    [[nodiscard]] static bool cookBlueprintFile(const std::string& json_path, std::string& error_message);
+
     /**
      * @brief 从 JSON 文件加载敌人蓝图
      * @param enemy_json_path 敌人数据 JSON 文件路径
@@ -90,6 +148,27 @@ public:
      */
     bool hasPlayerClassBlueprint(entt::id_type id) const;
 
+    /**
+     * @brief 将职业ID解析为稠密下标
+     * @return 未加载该职业时返回 INVALID_CLASS_INDEX
+     */
+    [[nodiscard]] ClassIndex findEnemyClass(entt::id_type id) const;
+    [[nodiscard]] ClassIndex findPlayerClass(entt::id_type id) const;
+
+    /**
+     * @brief 按下标获取职业蓝图
+     * @throws std::out_of_range 下标越界（含 INVALID_CLASS_INDEX）
+     */
+    const data::EnemyClassBlueprint& getEnemyClassAt(ClassIndex index) const;
+    const data::PlayerClassBlueprint& getPlayerClassAt(ClassIndex index) const;
+
+    /// @brief 按下标获取职业共享动画集合（下标越界时抛出 std::out_of_range）
+    engine::resource::AnimationLibrary::AnimationSetPtr getEnemyAnimationSetAt(ClassIndex index) const;
+    engine::resource::AnimationLibrary::AnimationSetPtr getPlayerAnimationSetAt(ClassIndex index) const;
+
+    [[nodiscard]] std::size_t getEnemyClassCount() const { return enemy_classes_.size(); }
+    [[nodiscard]] std::size_t getPlayerClassCount() const { return player_classes_.size(); }
+
     bool hasProjectileBlueprint(entt::id_type id) const;
     bool hasEffectBlueprint(entt::id_type id) const;
     bool hasSkillBlueprint(entt::id_type id) const;
@@ -98,25 +177,110 @@ public:
     const data::EffectBlueprint& getEffectBlueprint(entt::id_type id) const;
     const data::SkillBlueprint& getSkillBlueprint(entt::id_type id) const;
 
+    /// @brief 全部投射物/特效蓝图（用于对象池预热）
+    const engine::utils::IdMap<data::ProjectileBlueprint>& getProjectileBlueprints() const { return projectile_blueprints_; }
+    const engine::utils::IdMap<data::EffectBlueprint>& getEffectBlueprints() const { return effect_blueprints_; }
+
+    /**
+     * @brief 获取共享动画集合（不存在时返回 nullptr）
+     * @param id 对应蓝图的类型ID
+     */
+    engine::resource::AnimationLibrary::AnimationSetPtr getEnemyAnimationSet(entt::id_type id) const;
+    engine::resource::AnimationLibrary::AnimationSetPtr getPlayerAnimationSet(entt::id_type id) const;
+    engine::resource::AnimationLibrary::AnimationSetPtr getProjectileAnimationSet(entt::id_type id) const;
+    engine::resource::AnimationLibrary::AnimationSetPtr getEffectAnimationSet(entt::id_type id) const;
+
+    const engine::resource::AnimationLibrary& getAnimationLibrary() const { return animation_library_; }
+
+    /**
+     * @brief 整关常驻的预加载清单
+     * @details 包含全部玩家职业的精灵表和音效（编成可能包含任意职业），以及全部投射物与特效的精灵表
+     *          （种类少，且已全部预热为池化实体），供场景初始化时提交后台加载，
+     *          避免第一次放置、第一次开火时在绘制途中同步读盘。
+     */
+    engine::resource::PreloadManifest buildSharedManifest() const;
+
+    /**
+     * @brief 一个波次的预加载清单：该波出现的敌人类型的精灵表与音效（WaveResourceStreamer 按波次流式加载）
+     * @param wave 波次配置（LevelConfig::getWaves() 中的一项）
+     */
+    engine::resource::PreloadManifest buildWaveManifest(const data::WaveConfig& wave) const;
+
+    /**
+     * @brief 蓝图数组、索引表与其中字符串/映射的堆内存估算（字节，不含动画库）
+     * @details 供内存面板上报 MemoryTag::BLUEPRINTS；动画库用量见 getAnimationLibrary().getContentBytes()。
+     */
+    [[nodiscard]] std::size_t getMemoryBytes() const;
+
 private:
-    engine::resource::ResourceManager& resource_manager_;
-    std::unordered_map<entt::id_type, data::EnemyClassBlueprint> enemy_class_blueprints_;
-    std::unordered_map<entt::id_type, data::PlayerClassBlueprint> player_class_blueprints_;
-    std::unordered_map<entt::id_type, data::ProjectileBlueprint> projectile_blueprints_;
-    std::unordered_map<entt::id_type, data::EffectBlueprint> effect_blueprints_;
-    std::unordered_map<entt::id_type, data::SkillBlueprint> skill_blueprints_;
+    /// @brief 蓝图文件种类（决定解析函数与合并目标）
+    enum class BlueprintKind : std::uint8_t { ENEMY, PLAYER, SKILL, PROJECTILE, EFFECT };
+
+    /// @brief 一个蓝图文件的解析结果：按文件中的出现顺序排列，尚未写入管理器，也未请求任何资源
+    struct ParsedBlueprints {
+        BlueprintKind kind_{ BlueprintKind::ENEMY };
+        bool ok_{ false };
+        std::vector<data::EnemyClassBlueprint> enemies_;
+        std::vector<data::PlayerClassBlueprint> players_;
+        std::vector<data::SkillBlueprint> skills_;
+        std::vector<data::ProjectileBlueprint> projectiles_;
+        std::vector<data::EffectBlueprint> effects_;
+        std::vector<engine::component::AnimationSet> animation_sets_;   ///< 与上面非空的蓝图数组同序（技能没有动画）
+    };
+
+    /// @brief 日志中使用的种类名（"敌人"、"投射物" 等）
+    [[nodiscard]] static const char* kindName(BlueprintKind kind);
+
+    /// @brief 读取并解析一个蓝图文件（不修改管理器，可在工作线程上调用）
+    [[nodiscard]] ParsedBlueprints parseFile(BlueprintKind kind, const std::string& path) const;
+    /// @brief 把解析结果写入蓝图表与动画库（调用线程）
+    void merge(ParsedBlueprints&& parsed);
+    /// @brief 单文件加载：解析、合并并提交该文件用到的资源
+    bool loadFile(BlueprintKind kind, std::string_view path);
+    /// @brief 汇总已合并蓝图用到的音效与纹理，一次提交给 ResourceManager
+    void requestResources() const;
+
+    engine::resource::ResourceManager* resource_manager_{nullptr};  ///< 为空时跳过资源预加载
+    engine::resource::AnimationLibrary animation_library_;  ///< 按类别共享的不可变动画集合
+    std::vector<data::EnemyClassBlueprint> enemy_classes_;      ///< 按 ClassIndex 排列的敌人职业蓝图
+    std::vector<data::PlayerClassBlueprint> player_classes_;    ///< 按 ClassIndex 排列的玩家职业蓝图
+    std::vector<engine::resource::AnimationLibrary::AnimationSetPtr> enemy_class_animations_;   ///< 与 enemy_classes_ 同下标
+    std::vector<engine::resource::AnimationLibrary::AnimationSetPtr> player_class_animations_;  ///< 与 player_classes_ 同下标
+    engine::utils::IdMap<ClassIndex> enemy_class_index_;        ///< 职业ID -> 下标
+    engine::utils::IdMap<ClassIndex> player_class_index_;
+    engine::utils::IdMap<data::ProjectileBlueprint> projectile_blueprints_;
+    engine::utils::IdMap<data::EffectBlueprint> effect_blueprints_;
+    engine::utils::IdMap<data::SkillBlueprint> skill_blueprints_;
+
+    /**
+     * @brief 将蓝图写入稠密数组：已存在同ID时原地覆盖，否则追加并分配新下标
+     * @return 分配的下标；数量超过 ClassIndex 容量时返回 INVALID_CLASS_INDEX
+     */
+    template <typename Blueprint>
+    static ClassIndex storeClass(std::vector<Blueprint>& classes,
+                                 std::vector<engine::resource::AnimationLibrary::AnimationSetPtr>& animations,
+                                 engine::utils::IdMap<ClassIndex>& index,
+                                 Blueprint blueprint,
+                                 engine::resource::AnimationLibrary::AnimationSetPtr animation_set);
 
     // 解析辅助函数
     [[nodiscard]] data::StatsBlueprint parseStats(const nlohmann::json& json) const;
     [[nodiscard]] data::SpriteBlueprint parseSprite(const nlohmann::json& json) const;
     [[nodiscard]] std::unordered_map<entt::id_type, data::AnimationBlueprint> parseAnimationsMap(const nlohmann::json& json) const;
-    [[nodiscard]] data::SoundBlueprint parseSound(const nlohmann::json& json);
+    [[nodiscard]] data::SoundBlueprint parseSound(const nlohmann::json& json) const;
     [[nodiscard]] data::EnemyBlueprint parseEnemy(const nlohmann::json& json) const;
     [[nodiscard]] data::PlayerBlueprint parsePlayer(const nlohmann::json& json) const;
     [[nodiscard]] data::DisplayInfoBlueprint parseDisplayInfo(const nlohmann::json& json) const;
-    [[nodiscard]] data::ProjectileBlueprint parseProjectile(const nlohmann::json& json, entt::id_type projectile_id);
-    [[nodiscard]] data::EffectBlueprint parseEffect(const nlohmann::json& json, entt::id_type effect_id);
+    [[nodiscard]] data::ProjectileBlueprint parseProjectile(const nlohmann::json& json, entt::id_type projectile_id) const;
+    [[nodiscard]] data::EffectBlueprint parseEffect(const nlohmann::json& json, entt::id_type effect_id) const;
     [[nodiscard]] data::SkillBlueprint parseSkill(const nlohmann::json& json, entt::id_type skill_id) const;
+
+    // 动画集合构建辅助函数
+    [[nodiscard]] engine::component::AnimationSet buildClassAnimationSet(
+        const std::unordered_map<entt::id_type, data::AnimationBlueprint>& animations,
+        const data::SpriteBlueprint& sprite) const;
+    [[nodiscard]] engine::component::AnimationSet buildProjectileAnimationSet(const data::ProjectileBlueprint& blueprint) const;
+    [[nodiscard]] engine::component::AnimationSet buildEffectAnimationSet(const data::EffectBlueprint& blueprint) const;
 };
 
 } // namespace game::factory
@@ -0,0 +1,80 @@
+#include "capacity_planner.h"
+#include "../component/attack_timer_component.h"
+#include "../component/blocker_component.h"
+#include "../component/class_name_component.h"
+#include "../component/enemy_component.h"
+#include "../component/player_component.h"
+#include "../component/stats_component.h"
+#include "../../engine/component/animation_component.h"
+#include "../../engine/component/audio_component.h"
+#include "../../engine/component/render_component.h"
+#include "../../engine/component/sprite_component.h"
+#include "../../engine/component/transform_component.h"
+#include "../../engine/component/velocity_component.h"
+#include "../../engine/ecs/registry_arena.h"
+#include "../../engine/utils/logging.h"
+#include <algorithm>
+
+namespace game::factory {
+
+CapacityPlan CapacityPlanner::plan(std::span<const data::WaveConfig> waves, std::size_t placement_slots) {
+    CapacityPlan plan;
+    for (const auto& wave : waves) {
+        plan.enemies_ = std::max(plan.enemies_, wave.enemy_count_);
+    }
+    plan.players_ = placement_slots;
+    return plan;
+}
+
+std::size_t CapacityPlanner::upcomingEnemies(std::span<const data::WaveConfig> waves, std::size_t next_index) {
+    return plan(next_index < waves.size() ? waves.subspan(next_index) : waves, 0).enemies_;
+}
+
+template <typename Component>
+void CapacityPlanner::reserve(entt::registry& registry, const char* name, std::size_t count) {
+    auto& storage = registry.storage<Component>();
+    const std::size_t target = storage.size() + count;
+    engine::ecs::reserveStorage<Component>(registry, target);
+    entries_.push_back({ name, &storage, target, storage.size() });
+}
+
+void CapacityPlanner::apply(entt::registry& registry, const CapacityPlan& plan) {
+    plan_ = plan;
+    entries_.clear();
+
+    // 敌人与玩家单位共有的组件按总人数预留，专属组件按各自人数
+    const std::size_t units = plan.units();
+    reserve<entt::entity>(registry, "entity", units);
+    reserve<engine::component::TransformComponent>(registry, "Transform", units);
+    reserve<engine::component::VelocityComponent>(registry, "Velocity", units);
+    reserve<engine::component::SpriteComponent>(registry, "Sprite", units);
+    reserve<engine::component::AnimationComponent>(registry, "Animation", units);
+    reserve<engine::component::AudioComponent>(registry, "Audio", units);
+    reserve<engine::component::RenderComponent>(registry, "Render", units);
+    reserve<game::component::StatsComponent>(registry, "Stats", units);
+    reserve<game::component::AttackTimerComponent>(registry, "AttackTimer", units);
+    reserve<game::component::ClassNameComponent>(registry, "ClassName", units);
+    reserve<game::component::EnemyComponent>(registry, "Enemy", plan.enemies_);
+    reserve<game::component::PlayerComponent>(registry, "Player", plan.players_);
+    reserve<game::component::BlockerComponent>(registry, "Blocker", plan.players_);
+
+    ENGINE_LOG_INFO("容量规划: 敌人峰值 {}，放置点 {}，已预留 {} 类存储", plan.enemies_, plan.players_, entries_.size());
+}
+
+void CapacityPlanner::sample() {
+    for (auto& entry : entries_) {
+        entry.peak_ = std::max(entry.peak_, entry.storage_->size());
+    }
+}
+
+void CapacityPlanner::report() const {
+    for (const auto& entry : entries_) {
+        if (entry.peak_ > entry.reserved_) {
+            ENGINE_LOG_WARN("容量规划 {}: 峰值 {} 超出预留 {}，战斗中发生了扩容", entry.name_, entry.peak_, entry.reserved_);
+        } else {
+            ENGINE_LOG_INFO("容量规划 {}: 峰值 {} / 预留 {}", entry.name_, entry.peak_, entry.reserved_);
+        }
+    }
+}
+
+} // namespace game::factory
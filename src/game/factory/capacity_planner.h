@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../data/level_config.h"
+#include <entt/entity/registry.hpp>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace game::factory {
+
+/**
+ * @struct CapacityPlan
+ * @brief 按关卡配置估算的同时在场单位峰值
+ */
+struct CapacityPlan {
+    std::size_t enemies_{0};    ///< 最大波次的敌人数（下一波要等场上敌人清空后才开始）
+    std::size_t players_{0};    ///< 放置点数量（每个放置点至多驻留一个单位）
+
+    [[nodiscard]] std::size_t units() const { return enemies_ + players_; }
+};
+
+/**
+ * @class CapacityPlanner
+ * @brief 关卡开始前按峰值人口一次性预留实体与组件存储，关卡结束时报告实际高水位
+ *
+ * @details
+ * EnTT 的组件存储从空开始按倍数增长，波次逐步变大时会在战斗中途重新分配
+ * Transform/Sprite/Animation 等大组件的存储，造成数毫秒的卡顿。apply() 在各存储
+ * 当前大小的基础上预留 CapacityPlan 估算的数量；sample() 每个模拟步记录各存储的最大长度，
+ * report() 输出预留量与实际峰值，峰值超出预留（发生了扩容）时以警告输出，便于校准估算。
+ */
+class CapacityPlanner final {
+public:
+    /**
+     * @brief 根据波次与放置点估算峰值
+     * @param waves 关卡波次配置
+     * @param placement_slots 放置点（或预计放置的单位）数量
+     */
+    [[nodiscard]] static CapacityPlan plan(std::span<const data::WaveConfig> waves, std::size_t placement_slots);
+
+    /**
+     * @brief 后续波次的敌人峰值（波次间隔收缩存储时保留的余量）
+     * @param next_index 下一波在波次表中的下标；超出波次表（循环播放）时按整张表估算
+     */
+    [[nodiscard]] static std::size_t upcomingEnemies(std::span<const data::WaveConfig> waves, std::size_t next_index);
+
+    /// @brief 预留存储并开始跟踪（重复调用会重新开始跟踪）
+    void apply(entt::registry& registry, const CapacityPlan& plan);
+
+    /// @brief 记录各存储当前长度的最大值（每个模拟步调用一次）
+    void sample();
+
+    /// @brief 输出各存储的预留量与实际峰值
+    void report() const;
+
+private:
+    struct Entry {
+        const char* name_;
+        const entt::sparse_set* storage_;
+        std::size_t reserved_;      ///< 预留后的目标长度（apply 时的长度 + 计划数量）
+        std::size_t peak_;          ///< 观测到的最大长度
+    };
+
+    template <typename Component>
+    void reserve(entt::registry& registry, const char* name, std::size_t count);
+
+    CapacityPlan plan_;
+    std::vector<Entry> entries_;
+};
+
+} // namespace game::factory
@@ -19,6 +19,8 @@
  */
 
 #include "entity_factory.h"
+#include "../component/attack_timer_component.h"
+#include "../component/behavior_component.h"
 #include "../component/stats_component.h"
 #include "../component/class_name_component.h"
 #include "../component/enemy_component.h"
@@ -27,30 +29,104 @@
 #include "../component/projectile_visual_component.h"
 #include "../component/unit_prep_component.h"
 #include "../component/blocker_component.h"
+#include "../component/base_stats_component.h"
+#include "../data/status_effect_store.h"
+#include "../defs/constants.h"
 #include "../defs/tags.h"
 #include "../factory/blueprint_manager.h"
 #include "../../engine/component/transform_component.h"
 #include "../../engine/component/sprite_component.h"
 #include "../../engine/component/animation_component.h"
 #include "../../engine/component/audio_component.h"
+#include "../../engine/component/lod_icon_component.h"
 #include "../../engine/component/render_component.h"
 #include "../../engine/component/velocity_component.h"
+#include "../../engine/ecs/registry_arena.h"
 #include "../../engine/utils/math.h"
 #include "../../engine/utils/logging.h"
+#include "../../engine/utils/deferred_log.h"
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <glm/trigonometric.hpp>
 
 namespace game::factory {
 
+namespace {
+    /// @brief 按稀有度折算的部署费用
+    int unitCost(const data::PlayerBlueprint& player, int rarity) {
+        return static_cast<int>(std::round(player.cost_ * (0.9f + 0.1f * rarity)));
+    }
+
+    /// @brief 敌人威胁度：每秒攻击力（HIGHEST_THREAT 索敌策略的缓存分数）
+    float threatOf(const game::component::StatsComponent& stats, float atk_interval) {
+        return stats.atk_ / std::max(atk_interval, 0.1f);
+    }
+
+    /// @brief 在各组件存储当前大小的基础上再预留 count 个元素
+    template <typename... Component>
+    void reserveStorage(entt::registry& registry, std::size_t count) {
+        (engine::ecs::reserveStorage<Component>(registry, registry.storage<Component>().size() + count), ...);
+    }
+}
+
+/**
+ * @struct EntityFactory::EnemyTemplate
+ * @brief 单个敌人职业的预装配组件，生成实体时逐个复制到新实体上
+ *
+ * @details
+ * 除属性随等级/稀有度变化外，其余组件对同一职业的所有实例都相同；
+ * 模板在该职业首次生成时构建，等级或稀有度变化时只重算属性。
+ */
+struct EntityFactory::EnemyTemplate {
+    int level_{};
+    int rarity_{};
+    engine::component::SpriteComponent sprite_;
+    std::optional<engine::component::AnimationComponent> animation_;    ///< 缺少动画集合时为空
+    engine::component::AudioComponent audio_;
+    game::component::StatsComponent stats_;
+    game::component::AttackTimerComponent attack_timer_;
+    game::component::EnemyComponent enemy_;     ///< target_waypoint_id_ 在生成时覆盖
+    game::component::ClassNameComponent class_name_;
+    bool face_left_{false};
+    bool ranged_{false};
+};
+
+/**
+ * @struct EntityFactory::PlayerTemplate
+ * @brief 单个玩家职业的预装配组件（构建与失效规则同 EnemyTemplate）
+ */
+struct EntityFactory::PlayerTemplate {
+    int level_{};
+    int rarity_{};
+    engine::component::SpriteComponent sprite_;
+    std::optional<engine::component::AnimationComponent> animation_;
+    engine::component::AudioComponent audio_;
+    game::component::StatsComponent stats_;
+    game::component::AttackTimerComponent attack_timer_;
+    game::component::PlayerComponent player_;   ///< cost_ 随稀有度重算
+    std::optional<game::component::BlockerComponent> blocker_;      ///< 仅近战单位
+    std::optional<game::component::HeroSkillComponent> skill_;      ///< 仅配置了有效技能的单位
+    game::component::ClassNameComponent class_name_;
+    game::defs::PlayerType type_{game::defs::PlayerType::UNKNOWN};
+    bool healer_{false};
+    bool face_left_{false};
+};
+
 /**
  * @brief EntityFactory 构造函数
  * @param registry EnTT 注册表引用，用于创建和管理实体
  * @param blueprint_manager 蓝图管理器引用，用于获取实体蓝图数据
  */
 EntityFactory::EntityFactory(entt::registry& registry, const BlueprintManager& blueprint_manager)
-    : registry_(registry), blueprint_manager_(blueprint_manager) {
+    : registry_(registry), blueprint_manager_(blueprint_manager), visual_pool_(registry) {
     ENGINE_LOG_INFO("EntityFactory initialized");
 }
 
+EntityFactory::~EntityFactory() = default;
+
 /**
  * @brief 创建敌人单位
  * @param class_id 敌人类型ID（使用 entt::hashed_string 生成，如 "wolf"_hs）
@@ -59,10 +135,29 @@ EntityFactory::EntityFactory(entt::registry& registry, const BlueprintManager& b
  * @param level 等级（默认为1）
  * @param rarity 稀有度（默认为1）
  * @return 创建的实体句柄
- * 
+ *
+ * @details 将 ID 解析为 ClassIndex 后转交 createEnemyUnitAt()。
+ */
+entt::entity EntityFactory::createEnemyUnit(entt::id_type class_id,
+                                            const glm::vec2& position,
+                                            int target_waypoint_id,
+                                            int level,
+                                            int rarity) {
+    // 检查蓝图是否存在
+    const auto index = blueprint_manager_.findEnemyClass(class_id);
+    if (index == INVALID_CLASS_INDEX) {
+        ENGINE_LOG_ERROR("找不到敌人类型ID: {}", class_id);
+        return entt::null;
+    }
+    return createEnemyUnitAt(index, position, target_waypoint_id, level, rarity);
+}
+
+/**
+ * @brief 按职业下标创建敌人单位
+ *
  * @details
  * 该方法实现了敌人实体的完整创建流程：
- * 1. 检查蓝图是否存在
+ * 1. 取得（必要时构建）该职业的组件模板
  * 2. 创建新实体
  * 3. 按顺序装配各种组件：
  *    - TransformComponent（位置）
@@ -70,13 +165,13 @@ EntityFactory::EntityFactory(entt::registry& registry, const BlueprintManager& b
  *    - SpriteComponent（外观）
  *    - AnimationComponent（动画）
  *    - AudioComponent（音效）
- *    - StatsComponent（属性）
+ *    - StatsComponent / AttackTimerComponent / BehaviorComponent（属性、攻击计时与行为状态）
  *    - EnemyComponent（敌人特定属性）
  *    - ClassNameComponent（类型标识）
  *    - RenderComponent（渲染排序）
  * 4. 根据蓝图数据添加标签（朝向、攻击类型）
  * 5. 记录创建结果
- * 
+ *
  * @par 组件装配顺序
  * 组件装配顺序很重要，因为某些组件可能依赖于其他组件的数据。
  * 本方法按照从基础到特定的顺序装配组件：
@@ -86,53 +181,177 @@ EntityFactory::EntityFactory(entt::registry& registry, const BlueprintManager& b
  * 4. 敌人特定组件
  * 5. 类型和渲染组件
  */
-entt::entity EntityFactory::createEnemyUnit(entt::id_type class_id,
-                                            const glm::vec2& position,
-                                            int target_waypoint_id,
-                                            int level,
-                                            int rarity) {
-    // 检查蓝图是否存在
-    if (!blueprint_manager_.hasEnemyClassBlueprint(class_id)) {
-        ENGINE_LOG_ERROR("找不到敌人类型ID: {}", class_id);
-        return entt::null;
-    }
-
-    const auto& blueprint = blueprint_manager_.getEnemyClassBlueprint(class_id);
+entt::entity EntityFactory::createEnemyUnitAt(ClassIndex index,
+                                              const glm::vec2& position,
+                                              int target_waypoint_id,
+                                              int level,
+                                              int rarity) {
+    const auto& prefab = enemyTemplate(index, level, rarity);
 
     // 创建实体
     entt::entity entity = registry_.create();
 
-    // 按顺序装配组件
+    // 按顺序装配组件（除位置与路径点外均从模板复制）
     addTransformComponent(entity, position);
     addVelocityComponent(entity);
-    addSpriteComponent(entity, blueprint.sprite_);
-    addAnimationComponent(entity, blueprint.animations_, blueprint.sprite_, entt::hashed_string("walk"));
-    addAudioComponent(entity, blueprint.sounds_);
-    addStatsComponent(entity, blueprint.stats_, level, rarity);
-    addEnemyComponent(entity, blueprint.enemy_, target_waypoint_id);
+    registry_.emplace<engine::component::SpriteComponent>(entity, prefab.sprite_);
+    if (prefab.animation_) {
+        registry_.emplace<engine::component::AnimationComponent>(entity, *prefab.animation_);
+    }
+    registry_.emplace<engine::component::AudioComponent>(entity, prefab.audio_);
+    registry_.emplace<game::component::StatsComponent>(entity, prefab.stats_);
+    registry_.emplace<game::component::AttackTimerComponent>(entity, prefab.attack_timer_);
+    registry_.emplace<game::component::BehaviorComponent>(entity);
+    auto& enemy = registry_.emplace<game::component::EnemyComponent>(entity, prefab.enemy_);
+    enemy.target_waypoint_id_ = target_waypoint_id;
+    enemy.spawn_sequence_ = next_spawn_sequence_++;
 
     // 添加类名组件
-    registry_.emplace<game::component::ClassNameComponent>(entity, class_id, blueprint.display_info_.name_);
+    registry_.emplace<game::component::ClassNameComponent>(entity, prefab.class_name_);
 
     // 添加渲染组件（默认主战斗图层编号为10）
     addRenderComponent(entity, 10);
+    registry_.emplace<engine::component::LodIconComponent>(entity, game::defs::ENEMY_ICON_COLOR);
 
     // 根据朝向添加标签
-    if (!blueprint.sprite_.face_right_) {
+    registry_.emplace<game::defs::OrientableTag>(entity);
+    if (prefab.face_left_) {
         registry_.emplace<game::defs::FaceLeftTag>(entity);
     }
 
     // 根据攻击类型添加标签
-    if (blueprint.enemy_.ranged_) {
+    if (prefab.ranged_) {
         registry_.emplace<game::defs::RangedUnitTag>(entity);
     } else {
         registry_.emplace<game::defs::MeleeUnitTag>(entity);
     }
 
-    ENGINE_LOG_INFO("创建敌人单位: {} (等级: {}, 稀有度: {})", blueprint.display_info_.name_, level, rarity);
+    ENGINE_LOG_INFO("创建敌人单位: {} (等级: {}, 稀有度: {})", prefab.class_name_.class_name_, level, rarity);
     return entity;
 }
 
+std::span<const entt::entity> EntityFactory::createEnemyUnits(entt::id_type class_id,
+                                                              std::span<const glm::vec2> positions,
+                                                              std::span<const int> target_waypoint_ids,
+                                                              int level,
+                                                              int rarity) {
+    batch_entities_.clear();
+    if (positions.size() != target_waypoint_ids.size()) {
+        ENGINE_LOG_ERROR("批量创建敌人参数长度不一致: {} 个位置, {} 个路径点", positions.size(), target_waypoint_ids.size());
+        return {};
+    }
+    const auto index = blueprint_manager_.findEnemyClass(class_id);
+    if (index == INVALID_CLASS_INDEX) {
+        ENGINE_LOG_ERROR("找不到敌人类型ID: {}", class_id);
+        return {};
+    }
+    if (positions.empty()) {
+        return {};
+    }
+
+    const auto& prefab = enemyTemplate(index, level, rarity);
+    reserveEnemyUnits(positions.size());
+
+    batch_entities_.resize(positions.size());
+    registry_.create(batch_entities_.begin(), batch_entities_.end());
+    const auto first = batch_entities_.begin();
+    const auto last = batch_entities_.end();
+
+    // 逐实体不同的组件先在连续数组（成员缓冲）中构建，再整段写入存储
+    batch_transforms_.clear();
+    batch_enemies_.assign(positions.size(), prefab.enemy_);
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        batch_transforms_.emplace_back(positions[i]);
+        batch_enemies_[i].target_waypoint_id_ = target_waypoint_ids[i];
+        batch_enemies_[i].spawn_sequence_ = next_spawn_sequence_++;
+    }
+
+    registry_.insert<engine::component::TransformComponent>(first, last, batch_transforms_.begin());
+    registry_.insert<engine::component::VelocityComponent>(first, last, engine::component::VelocityComponent{ glm::vec2(0.0f, 0.0f) });
+    registry_.insert<engine::component::SpriteComponent>(first, last, prefab.sprite_);
+    if (prefab.animation_) {
+        registry_.insert<engine::component::AnimationComponent>(first, last, *prefab.animation_);
+    }
+    registry_.insert<engine::component::AudioComponent>(first, last, prefab.audio_);
+    registry_.insert<game::component::StatsComponent>(first, last, prefab.stats_);
+    registry_.insert<game::component::AttackTimerComponent>(first, last, prefab.attack_timer_);
+    registry_.insert<game::component::BehaviorComponent>(first, last, game::component::BehaviorComponent{});
+    registry_.insert<game::component::EnemyComponent>(first, last, batch_enemies_.begin());
+    registry_.insert<game::component::ClassNameComponent>(first, last, prefab.class_name_);
+    registry_.insert<engine::component::RenderComponent>(first, last, engine::component::RenderComponent{ 10 });
+    registry_.insert<engine::component::LodIconComponent>(first, last, engine::component::LodIconComponent{ game::defs::ENEMY_ICON_COLOR });
+
+    registry_.insert<game::defs::OrientableTag>(first, last);
+    if (prefab.face_left_) {
+        registry_.insert<game::defs::FaceLeftTag>(first, last);
+    }
+    if (prefab.ranged_) {
+        registry_.insert<game::defs::RangedUnitTag>(first, last);
+    } else {
+        registry_.insert<game::defs::MeleeUnitTag>(first, last);
+    }
+
+    ENGINE_LOG_INFO_DEFERRED("批量创建敌人单位: {} x{} (等级: {}, 稀有度: {})", prefab.class_name_.class_name_, batch_entities_.size(), level, rarity);
+    return batch_entities_;
+}
+
+void EntityFactory::reserveEnemyUnits(std::size_t count) {
+    reserveStorage<entt::entity,
+                   engine::component::TransformComponent,
+                   engine::component::VelocityComponent,
+                   engine::component::SpriteComponent,
+                   engine::component::AnimationComponent,
+                   engine::component::AudioComponent,
+                   engine::component::RenderComponent,
+                   engine::component::LodIconComponent,
+                   game::component::StatsComponent,
+                   game::component::AttackTimerComponent,
+                   game::component::BehaviorComponent,
+                   game::component::EnemyComponent,
+                   game::component::ClassNameComponent>(registry_, count);
+    batch_entities_.reserve(count);
+    batch_transforms_.reserve(count);
+    batch_enemies_.reserve(count);
+}
+
+bool EntityFactory::absorbEnemies(entt::entity elite, entt::id_type class_id, std::size_t count, int level, int rarity) {
+    if (count == 0) {
+        return true;
+    }
+    const auto index = blueprint_manager_.findEnemyClass(class_id);
+    if (index == INVALID_CLASS_INDEX || !registry_.valid(elite)
+        || !registry_.all_of<game::component::EnemyComponent, game::component::StatsComponent>(elite)) {
+        return false;
+    }
+    const auto& absorbed = enemyTemplate(index, level, rarity).stats_;
+    const auto n = static_cast<float>(count);
+
+    auto& stats = registry_.get<game::component::StatsComponent>(elite);
+    stats.max_hp_ += absorbed.max_hp_ * n;
+    stats.hp_ += absorbed.max_hp_ * n;
+    const float atk_gain = absorbed.atk_ * n * game::defs::ELITE_ATK_SHARE;
+    // 带属性修正的敌人改基础属性，由 StatusEffectSystem 重新汇总出有效属性
+    auto* base = registry_.try_get<game::component::BaseStatsComponent>(elite);
+    auto* effects = registry_.ctx().find<game::data::StatusEffectStore>();
+    if (base && effects) {
+        base->atk_ += atk_gain;
+        effects->markDirty(elite);
+    } else {
+        stats.atk_ += atk_gain;
+    }
+    const auto* attack_timer = registry_.try_get<game::component::AttackTimerComponent>(elite);
+    registry_.get<game::component::EnemyComponent>(elite).threat_ = threatOf(stats, attack_timer ? attack_timer->interval_ : 0.0f);
+
+    if (auto* transform = registry_.try_get<engine::component::TransformComponent>(elite)) {
+        const float scale = std::min(std::abs(transform->scale_.y) + game::defs::ELITE_SCALE_STEP * n, game::defs::ELITE_MAX_SCALE);
+        transform->scale_ = { std::copysign(scale, transform->scale_.x), scale };
+    }
+    if (auto* render = registry_.try_get<engine::component::RenderComponent>(elite)) {
+        render->color_ = game::defs::ELITE_COLOR;
+    }
+    return true;
+}
+
 /**
  * @brief 创建玩家单位
  * @param class_id 玩家类型ID（使用 entt::hashed_string 生成，如 "archer"_hs）
@@ -140,25 +359,37 @@ entt::entity EntityFactory::createEnemyUnit(entt::id_type class_id,
  * @param level 等级（默认为1）
  * @param rarity 稀有度（默认为1）
  * @return 创建的实体句柄
- * 
- * @details
- * 该方法实现了玩家实体的完整创建流程：
- * 1. 检查蓝图是否存在
- * 2. 创建新实体
- * 3. 按顺序装配各种组件
- * 4. 记录创建结果
+ *
+ * @details 将 ID 解析为 ClassIndex 后转交 createPlayerUnitAt()。
  */
 entt::entity EntityFactory::createPlayerUnit(entt::id_type class_id,
                                              const glm::vec2& position,
                                              int level,
                                              int rarity) {
     // 检查蓝图是否存在
-    if (!blueprint_manager_.hasPlayerClassBlueprint(class_id)) {
+    const auto index = blueprint_manager_.findPlayerClass(class_id);
+    if (index == INVALID_CLASS_INDEX) {
         ENGINE_LOG_ERROR("找不到玩家类型ID: {}", class_id);
         return entt::null;
     }
+    return createPlayerUnitAt(index, position, level, rarity);
+}
 
-    const auto& blueprint = blueprint_manager_.getPlayerClassBlueprint(class_id);
+/**
+ * @brief 按职业下标创建玩家单位
+ *
+ * @details
+ * 该方法实现了玩家实体的完整创建流程：
+ * 1. 取得（必要时构建）该职业的组件模板
+ * 2. 创建新实体
+ * 3. 按顺序复制模板中的组件，并按职业类型添加标签
+ * 4. 记录创建结果
+ */
+entt::entity EntityFactory::createPlayerUnitAt(ClassIndex index,
+                                               const glm::vec2& position,
+                                               int level,
+                                               int rarity) {
+    const auto& prefab = playerTemplate(index, level, rarity);
 
     // 创建实体
     entt::entity entity = registry_.create();
@@ -166,44 +397,49 @@ entt::entity EntityFactory::createPlayerUnit(entt::id_type class_id,
     // 按顺序装配组件
     addTransformComponent(entity, position);
     addVelocityComponent(entity);
-    addSpriteComponent(entity, blueprint.sprite_);
-    // 玩家默认动画通常是 idle
-    addAnimationComponent(entity, blueprint.animations_, blueprint.sprite_, entt::hashed_string("idle"));
-    addAudioComponent(entity, blueprint.sounds_);
-    addStatsComponent(entity, blueprint.stats_, level, rarity);
-    addPlayerComponent(entity, blueprint.player_, rarity);
-    if (blueprint.player_.skill_id_ != entt::null && blueprint_manager_.hasSkillBlueprint(blueprint.player_.skill_id_)) {
-        const auto& skill = blueprint_manager_.getSkillBlueprint(blueprint.player_.skill_id_);
-        registry_.emplace<game::component::HeroSkillComponent>(entity,
-            skill.skill_id_,
-            skill.cooldown_,
-            0.0f,
-            skill.duration_,
-            0.0f,
-            skill.passive_,
-            false,
-            skill.atk_multiplier_,
-            skill.def_multiplier_,
-            skill.range_multiplier_,
-            skill.atk_interval_multiplier_);
-        if (skill.passive_) {
+    registry_.emplace<engine::component::SpriteComponent>(entity, prefab.sprite_);
+    if (prefab.animation_) {
+        registry_.emplace<engine::component::AnimationComponent>(entity, *prefab.animation_);
+    }
+    registry_.emplace<engine::component::AudioComponent>(entity, prefab.audio_);
+    registry_.emplace<game::component::StatsComponent>(entity, prefab.stats_);
+    registry_.emplace<game::component::AttackTimerComponent>(entity, prefab.attack_timer_);
+    auto& behavior = registry_.emplace<game::component::BehaviorComponent>(entity);
+    registry_.emplace<game::component::PlayerComponent>(entity, prefab.player_).spawn_sequence_ = next_spawn_sequence_++;
+
+    if (prefab.type_ == game::defs::PlayerType::MELEE) {
+        registry_.emplace<game::defs::MeleeUnitTag>(entity);
+    } else if (prefab.type_ == game::defs::PlayerType::RANGED) {
+        registry_.emplace<game::defs::RangedUnitTag>(entity);
+    }
+    if (prefab.blocker_) {
+        registry_.emplace<game::component::BlockerComponent>(entity, *prefab.blocker_);
+    }
+    if (prefab.healer_) {
+        registry_.emplace<game::defs::HealerTag>(entity);
+    }
+    if (prefab.skill_) {
+        registry_.emplace<game::component::HeroSkillComponent>(entity, *prefab.skill_);
+        if (prefab.skill_->passive_) {
             registry_.emplace<game::defs::PassiveSkillTag>(entity);
-            registry_.emplace<game::defs::SkillReadyTag>(entity);
+            behavior.setFlag(game::component::behavior_flag::SKILL_READY, true);
         }
     }
 
     // 添加类名组件
-    registry_.emplace<game::component::ClassNameComponent>(entity, class_id, blueprint.display_info_.name_);
+    registry_.emplace<game::component::ClassNameComponent>(entity, prefab.class_name_);
 
     // 添加渲染组件
     addRenderComponent(entity, 10);
+    registry_.emplace<engine::component::LodIconComponent>(entity, game::defs::PLAYER_ICON_COLOR);
 
     // 根据朝向添加标签
-    if (!blueprint.sprite_.face_right_) {
+    registry_.emplace<game::defs::OrientableTag>(entity);
+    if (prefab.face_left_) {
         registry_.emplace<game::defs::FaceLeftTag>(entity);
     }
 
-    ENGINE_LOG_INFO("创建玩家单位过程完成: {} (等级: {}, 稀有度: {})", blueprint.display_info_.name_, level, rarity);
+    ENGINE_LOG_INFO("创建玩家单位过程完成: {} (等级: {}, 稀有度: {})", prefab.class_name_.class_name_, level, rarity);
     return entity;
 }
 
@@ -213,17 +449,18 @@ entt::entity EntityFactory::createUnitPrep(entt::id_type name_id,
                                           int cost,
                                           int level,
                                           int rarity) {
-    if (!blueprint_manager_.hasPlayerClassBlueprint(class_id)) {
+    const auto index = blueprint_manager_.findPlayerClass(class_id);
+    if (index == INVALID_CLASS_INDEX) {
         ENGINE_LOG_ERROR("找不到玩家类型ID: {}", class_id);
         return entt::null;
     }
 
-    const auto& blueprint = blueprint_manager_.getPlayerClassBlueprint(class_id);
+    const auto& blueprint = blueprint_manager_.getPlayerClassAt(index);
     entt::entity entity = registry_.create();
 
     addTransformComponent(entity, position);
     addSpriteComponent(entity, blueprint.sprite_);
-    addAnimationComponent(entity, blueprint.animations_, blueprint.sprite_, entt::hashed_string("idle"));
+    addAnimationComponent(entity, blueprint_manager_.getPlayerAnimationSetAt(index), entt::hashed_string("idle"));
 
     registry_.emplace<game::component::UnitPrepComponent>(entity,
         name_id,
@@ -249,13 +486,106 @@ entt::entity EntityFactory::createUnitPrep(entt::id_type name_id,
 }
 
 int EntityFactory::getPlayerUnitCost(entt::id_type class_id, int rarity) const {
-    if (!blueprint_manager_.hasPlayerClassBlueprint(class_id)) {
-        spdlog::error("找不到玩家类型ID: {}", class_id);
+    const auto index = blueprint_manager_.findPlayerClass(class_id);
+    if (index == INVALID_CLASS_INDEX) {
+        ENGINE_LOG_ERROR("找不到玩家类型ID: {}", class_id);
         return 0;
     }
+    return getPlayerUnitCostAt(index, rarity);
+}
+
+int EntityFactory::getPlayerUnitCostAt(ClassIndex index, int rarity) const {
+    return unitCost(blueprint_manager_.getPlayerClassAt(index).player_, rarity);
+}
+
+/**
+ * @brief 取得敌人职业模板，首次访问时构建
+ * @throws std::out_of_range 下标越界
+ */
+const EntityFactory::EnemyTemplate& EntityFactory::enemyTemplate(ClassIndex index, int level, int rarity) {
+    const auto& blueprint = blueprint_manager_.getEnemyClassAt(index);
+    if (index >= enemy_templates_.size()) {
+        enemy_templates_.resize(blueprint_manager_.getEnemyClassCount());
+    }
 
-    const auto& blueprint = blueprint_manager_.getPlayerClassBlueprint(class_id);
-    return static_cast<int>(std::round(blueprint.player_.cost_ * (0.9f + 0.1f * rarity)));
+    auto& prefab = enemy_templates_[index];
+    if (!prefab) {
+        prefab = std::make_unique<EnemyTemplate>(EnemyTemplate{
+            level,
+            rarity,
+            makeSpriteComponent(blueprint.sprite_),
+            makeAnimationComponent(blueprint_manager_.getEnemyAnimationSetAt(index), entt::hashed_string("walk")),
+            makeAudioComponent(blueprint.sounds_),
+            makeStatsComponent(blueprint.stats_, level, rarity),
+            game::component::AttackTimerComponent{ 0.0f, blueprint.stats_.atk_interval_ },
+            game::component::EnemyComponent{ 0, blueprint.enemy_.speed_, blueprint.enemy_.projectile_id_ },
+            game::component::ClassNameComponent{ blueprint.class_id_, blueprint.display_info_.name_ },
+            !blueprint.sprite_.face_right_,
+            blueprint.enemy_.ranged_ });
+    } else if (prefab->level_ != level || prefab->rarity_ != rarity) {
+        prefab->stats_ = makeStatsComponent(blueprint.stats_, level, rarity);
+        prefab->level_ = level;
+        prefab->rarity_ = rarity;
+    }
+    prefab->enemy_.threat_ = threatOf(prefab->stats_, blueprint.stats_.atk_interval_);
+    return *prefab;
+}
+
+/**
+ * @brief 取得玩家职业模板，首次访问时构建
+ * @throws std::out_of_range 下标越界
+ */
+const EntityFactory::PlayerTemplate& EntityFactory::playerTemplate(ClassIndex index, int level, int rarity) {
+    const auto& blueprint = blueprint_manager_.getPlayerClassAt(index);
+    if (index >= player_templates_.size()) {
+        player_templates_.resize(blueprint_manager_.getPlayerClassCount());
+    }
+
+    auto& prefab = player_templates_[index];
+    if (!prefab) {
+        const auto& player = blueprint.player_;
+        std::optional<game::component::BlockerComponent> blocker;
+        if (player.type_ == game::defs::PlayerType::MELEE) {
+            blocker = game::component::BlockerComponent{ player.block_ };
+        }
+        std::optional<game::component::HeroSkillComponent> skill;
+        if (player.skill_id_ != entt::null && blueprint_manager_.hasSkillBlueprint(player.skill_id_)) {
+            const auto& skill_blueprint = blueprint_manager_.getSkillBlueprint(player.skill_id_);
+            skill = game::component::HeroSkillComponent{
+                skill_blueprint.skill_id_,
+                skill_blueprint.cooldown_,
+                0,
+                skill_blueprint.duration_,
+                0,
+                skill_blueprint.passive_,
+                false };
+        }
+
+        // 玩家默认动画通常是 idle
+        prefab = std::make_unique<PlayerTemplate>(PlayerTemplate{
+            level,
+            rarity,
+            makeSpriteComponent(blueprint.sprite_),
+            makeAnimationComponent(blueprint_manager_.getPlayerAnimationSetAt(index), entt::hashed_string("idle")),
+            makeAudioComponent(blueprint.sounds_),
+            makeStatsComponent(blueprint.stats_, level, rarity),
+            game::component::AttackTimerComponent{ 0.0f, blueprint.stats_.atk_interval_ },
+            game::component::PlayerComponent{ unitCost(player, rarity), player.projectile_id_, player.target_policy_,
+                                              player.area_shape_, player.area_radius_,
+                                              std::cos(glm::radians(player.area_half_angle_)) },
+            blocker,
+            skill,
+            game::component::ClassNameComponent{ blueprint.class_id_, blueprint.display_info_.name_ },
+            player.type_,
+            player.is_healer_,
+            !blueprint.sprite_.face_right_ });
+    } else if (prefab->level_ != level || prefab->rarity_ != rarity) {
+        prefab->stats_ = makeStatsComponent(blueprint.stats_, level, rarity);
+        prefab->player_.cost_ = unitCost(blueprint.player_, rarity);
+        prefab->level_ = level;
+        prefab->rarity_ = rarity;
+    }
+    return *prefab;
 }
 
 /**
@@ -284,71 +614,63 @@ void EntityFactory::addVelocityComponent(entt::entity entity) {
  * @param sprite 精灵蓝图数据
  */
 void EntityFactory::addSpriteComponent(entt::entity entity, const data::SpriteBlueprint& sprite) {
-    spdlog::debug("创建SpriteComponent: path={}, src_rect=[{},{},{},{}], size=[{},{}], offset=[{},{}]",
-                  sprite.path_, sprite.src_rect_.position.x, sprite.src_rect_.position.y,
-                  sprite.src_rect_.size.x, sprite.src_rect_.size.y,
-                  sprite.size_.x, sprite.size_.y, sprite.offset_.x, sprite.offset_.y);
-    
-    engine::component::Sprite sprite_data(sprite.path_, sprite.src_rect_, !sprite.face_right_);
-    registry_.emplace_or_replace<engine::component::SpriteComponent>(entity, std::move(sprite_data), sprite.size_, sprite.offset_);
+    registry_.emplace_or_replace<engine::component::SpriteComponent>(entity, makeSpriteComponent(sprite));
 }
 
 /**
  * @brief 添加动画组件
  * @param entity 目标实体
- * @param animations 动画蓝图映射
- * @param sprite 精灵蓝图数据（用于计算帧大小）
+ * @param animations 共享动画集合（来自 BlueprintManager 的 AnimationLibrary）
  * @param default_anim_id 默认动画ID
+ *
+ * @details
+ * 组件只持有共享句柄与播放状态，同类实体之间不复制动画数据。
  */
 void EntityFactory::addAnimationComponent(entt::entity entity,
-                                          const std::unordered_map<entt::id_type, data::AnimationBlueprint>& animations,
-                                          const data::SpriteBlueprint& sprite,
+                                          engine::resource::AnimationLibrary::AnimationSetPtr animations,
                                           entt::id_type default_anim_id) {
-    std::unordered_map<entt::id_type, engine::component::Animation> anim_map;
-
-    for (const auto& [anim_id, anim_blueprint] : animations) {
-        //float ms_per_frame_ = 100.0f;
-        //int row_ = 0;
-        //std::unordered_map<int, entt::id_type> events_;
-        //std::vector<int> frames_;
-        std::vector<engine::component::AnimationFrame> frames;
-        std::unordered_map<int, entt::id_type> events;
-
-        float frame_width = sprite.src_rect_.size.x;
-        float frame_height = sprite.src_rect_.size.y;
-        events = anim_blueprint.events_;
-        for (int frame_idx : anim_blueprint.frames_) {
-            float x = frame_idx * frame_width;
-            float y = anim_blueprint.row_ * frame_height;
-            engine::utils::Rect frame_rect{x, y, frame_width, frame_height};
-            frames.emplace_back(frame_rect, anim_blueprint.ms_per_frame_);
-        }
+    if (auto animation = makeAnimationComponent(std::move(animations), default_anim_id)) {
+        registry_.emplace_or_replace<engine::component::AnimationComponent>(entity, std::move(*animation));
+    } else {
+        ENGINE_LOG_WARN("实体 {} 缺少共享动画集合", entt::to_integral(entity));
+    }
+}
+
+engine::component::SpriteComponent EntityFactory::makeSpriteComponent(const data::SpriteBlueprint& sprite) {
+    ENGINE_LOG_DEBUG("创建SpriteComponent: path={}, src_rect=[{},{},{},{}], size=[{},{}], offset=[{},{}]",
+                  sprite.path_, sprite.src_rect_.position.x, sprite.src_rect_.position.y,
+                  sprite.src_rect_.size.x, sprite.src_rect_.size.y,
+                  sprite.size_.x, sprite.size_.y, sprite.offset_.x, sprite.offset_.y);
+
+    engine::component::Sprite sprite_data(sprite.path_, sprite.src_rect_, !sprite.face_right_);
+    return engine::component::SpriteComponent(std::move(sprite_data), sprite.size_, sprite.offset_);
+}
 
-        anim_map.emplace(anim_id, engine::component::Animation{std::move(frames),std::move(events), true});
+std::optional<engine::component::AnimationComponent> EntityFactory::makeAnimationComponent(
+    engine::resource::AnimationLibrary::AnimationSetPtr animations,
+    entt::id_type default_anim_id) {
+    if (!animations) {
+        return std::nullopt;
     }
 
     // 如果没有指定默认动画，使用第一个可用的动画
-    if (default_anim_id == entt::null && !anim_map.empty()) {
-        default_anim_id = anim_map.begin()->first;
+    if (default_anim_id == entt::null && !animations->empty()) {
+        default_anim_id = animations->begin()->first;
     }
-
-    registry_.emplace_or_replace<engine::component::AnimationComponent>(entity, std::move(anim_map), default_anim_id);
+    return engine::component::AnimationComponent(std::move(animations), default_anim_id);
 }
 
 /**
- * @brief 添加音频组件
- * @param entity 目标实体
+ * @brief 构建音频组件
  * @param sounds 音效蓝图数据
+ * @details 组件只指向蓝图中共享的音效表，不复制动作映射
  */
-void EntityFactory::addAudioComponent(entt::entity entity, const data::SoundBlueprint& sounds) {
-    engine::component::AudioComponent audio;
-    audio.action_sounds_ = sounds.sounds_;
-    registry_.emplace_or_replace<engine::component::AudioComponent>(entity, std::move(audio));
+engine::component::AudioComponent EntityFactory::makeAudioComponent(const data::SoundBlueprint& sounds) {
+    return engine::component::AudioComponent{ sounds.table_.get() };
 }
 
 /**
- * @brief 添加统计组件
- * @param entity 目标实体
+ * @brief 构建统计组件
  * @param stats 统计蓝图数据
  * @param level 等级
  * @param rarity 稀有度
@@ -357,45 +679,16 @@ void EntityFactory::addAudioComponent(entt::entity entity, const data::SoundBlue
  * 该方法使用 statModify 函数根据等级和稀有度调整实体属性，
  * 实现敌人强度的动态调整。
  */
-void EntityFactory::addStatsComponent(entt::entity entity, const data::StatsBlueprint& stats, int level, int rarity) {
+game::component::StatsComponent EntityFactory::makeStatsComponent(const data::StatsBlueprint& stats, int level, int rarity) {
     game::component::StatsComponent stats_comp;
     stats_comp.max_hp_ = engine::utils::statModify(stats.hp_, level, rarity);
     stats_comp.hp_ = stats_comp.max_hp_;
     stats_comp.atk_ = engine::utils::statModify(stats.atk_, level, rarity);
     stats_comp.def_ = engine::utils::statModify(stats.def_, level, rarity);
     stats_comp.range_ = stats.range_;
-    stats_comp.atk_interval_ = stats.atk_interval_;
-    stats_comp.atk_timer_ = 0.0f;
     stats_comp.level_ = level;
     stats_comp.rarity_ = rarity;
-    registry_.emplace_or_replace<game::component::StatsComponent>(entity, std::move(stats_comp));
-}
-
-/**
- * @brief 添加敌人组件
- * @param entity 目标实体
- * @param enemy 敌人蓝图数据
- * @param target_waypoint_id 目标路径点ID
- */
-void EntityFactory::addEnemyComponent(entt::entity entity, const data::EnemyBlueprint& enemy, int target_waypoint_id) {
-    registry_.emplace_or_replace<game::component::EnemyComponent>(entity, target_waypoint_id, enemy.speed_, enemy.projectile_id_);
-}
-
-void EntityFactory::addPlayerComponent(entt::entity entity, const data::PlayerBlueprint &player, int rarity)
-{
-    auto cost = static_cast<int>(std::round(player.cost_ * (0.9f + 0.1f * rarity)));
-    registry_.emplace_or_replace<game::component::PlayerComponent>(entity, cost, player.projectile_id_);
-    
-    if(player.type_ == game::defs::PlayerType::MELEE) {
-        registry_.emplace_or_replace<game::defs::MeleeUnitTag>(entity);
-        registry_.emplace_or_replace<game::component::BlockerComponent>(entity, player.block_);
-    } else if(player.type_ == game::defs::PlayerType::RANGED) {
-        registry_.emplace_or_replace<game::defs::RangedUnitTag>(entity);
-    } 
-    
-    if(player.is_healer_) {
-        registry_.emplace_or_replace<game::defs::HealerTag>(entity);
-    }
+    return stats_comp;
 }
 
 entt::entity EntityFactory::createProjectileVisual(entt::id_type projectile_id,
@@ -409,19 +702,8 @@ entt::entity EntityFactory::createProjectileVisual(entt::id_type projectile_id,
     }
 
     const auto& blueprint = blueprint_manager_.getProjectileBlueprint(projectile_id);
-    auto entity = [&]() {
-        auto view = registry_.view<game::defs::VisualEffectTag, game::defs::InactiveVisualTag>();
-        if (auto it = view.begin(); it != view.end()) {
-            auto reused = *it;
-            registry_.remove<game::defs::InactiveVisualTag>(reused);
-            return reused;
-        }
-        return registry_.create();
-    }();
-
-    if (!registry_.all_of<game::defs::VisualEffectTag>(entity)) {
-        registry_.emplace_or_replace<game::defs::VisualEffectTag>(entity);
-    }
+    // 复用实体的组件全部原地覆盖，无需区分新建与复用
+    auto entity = visual_pool_.acquire(game::component::VisualKind::PROJECTILE, projectile_id);
 
     const glm::vec2 delta = target_position - source_position;
     const float delta_len = std::sqrt(delta.x * delta.x + delta.y * delta.y);
@@ -451,12 +733,44 @@ entt::entity EntityFactory::createProjectileVisual(entt::id_type projectile_id,
     constexpr float rad_to_deg = 180.0f / 3.14159265358979323846f;
     transform.rotation_ = std::atan2(initial_tangent_y, lead_delta.x) * rad_to_deg + blueprint.rotation_offset_deg_;
 
-    std::vector<engine::component::AnimationFrame> frames;
-    frames.emplace_back(blueprint.sprite_.src_rect_, flight_time * 1000.0f);
-    std::unordered_map<entt::id_type, engine::component::Animation> animations;
-    animations.emplace(entt::hashed_string("fly"), engine::component::Animation{ std::move(frames), {}, false });
-    registry_.emplace_or_replace<engine::component::AnimationComponent>(entity, std::move(animations), entt::hashed_string("fly"));
-    registry_.emplace_or_replace<game::defs::VisualEffectTag>(entity);
+    addAnimationComponent(entity, blueprint_manager_.getProjectileAnimationSet(projectile_id), entt::hashed_string("fly"));
+    return entity;
+}
+
+entt::entity EntityFactory::createSimulatedProjectileVisual(entt::id_type projectile_id,
+                                                            const glm::vec2& origin,
+                                                            const glm::vec2& velocity,
+                                                            float flight_time)
+{
+    if (!blueprint_manager_.hasProjectileBlueprint(projectile_id)) {
+        ENGINE_LOG_WARN("找不到投射物蓝图: {}", projectile_id);
+        return entt::null;
+    }
+
+    const auto& blueprint = blueprint_manager_.getProjectileBlueprint(projectile_id);
+    auto entity = visual_pool_.acquire(game::component::VisualKind::PROJECTILE, projectile_id);
+
+    addTransformComponent(entity, origin);
+    auto sprite = blueprint.sprite_;
+    sprite.face_right_ = true;
+    addSpriteComponent(entity, sprite);
+    addRenderComponent(entity, 12);
+
+    // 命中由模拟决定，视觉不走弧线，否则与判定位置对不上
+    registry_.emplace_or_replace<game::component::ProjectileVisualComponent>(
+        entity,
+        origin,
+        origin + velocity * flight_time,
+        0.0f,
+        flight_time,
+        0.0f,
+        blueprint.rotation_offset_deg_);
+
+    auto& transform = registry_.get<engine::component::TransformComponent>(entity);
+    constexpr float rad_to_deg = 180.0f / 3.14159265358979323846f;
+    transform.rotation_ = std::atan2(velocity.y, velocity.x) * rad_to_deg + blueprint.rotation_offset_deg_;
+
+    addAnimationComponent(entity, blueprint_manager_.getProjectileAnimationSet(projectile_id), entt::hashed_string("fly"));
     return entity;
 }
 
@@ -469,29 +783,61 @@ entt::entity EntityFactory::createEffectVisual(entt::id_type effect_id,
     }
 
     const auto& blueprint = blueprint_manager_.getEffectBlueprint(effect_id);
-    auto entity = registry_.create();
-
-    if (!registry_.all_of<game::defs::VisualEffectTag>(entity)) {
-        registry_.emplace<game::defs::VisualEffectTag>(entity);
-    }
+    auto entity = visual_pool_.acquire(game::component::VisualKind::EFFECT, effect_id);
 
     addTransformComponent(entity, position);
     addSpriteComponent(entity, blueprint.sprite_);
     addRenderComponent(entity, 12);
 
-    std::vector<engine::component::AnimationFrame> frames;
-    for (int frame_index : blueprint.animation_.frames_) {
-        const float x = blueprint.sprite_.src_rect_.position.x + blueprint.sprite_.src_rect_.size.x * static_cast<float>(frame_index);
-        const float y = blueprint.sprite_.src_rect_.position.y + blueprint.animation_.row_ * blueprint.sprite_.src_rect_.size.y;
-        engine::utils::Rect frame_rect{ x, y, blueprint.sprite_.src_rect_.size.x, blueprint.sprite_.src_rect_.size.y };
-        frames.emplace_back(frame_rect, blueprint.animation_.ms_per_frame_);
+    addAnimationComponent(entity, blueprint_manager_.getEffectAnimationSet(effect_id), blueprint.effect_id_);
+    return entity;
+}
+
+void EntityFactory::prewarmVisualPools() {
+    std::vector<entt::entity> warmed;
+    for (const auto& [projectile_id, blueprint] : blueprint_manager_.getProjectileBlueprints()) {
+        for (int i = 0; i < blueprint.pool_size_; ++i) {
+            warmed.push_back(createProjectileVisual(projectile_id, glm::vec2{ 0.0f }, glm::vec2{ 1.0f, 0.0f }, glm::vec2{ 0.0f }));
+        }
+    }
+    for (const auto& [effect_id, blueprint] : blueprint_manager_.getEffectBlueprints()) {
+        if (blueprint.particle_capacity_ > 0) {
+            continue;   // 由 EffectParticleSystem 以粒子绘制，不预热实体
+        }
+        for (int i = 0; i < blueprint.pool_size_; ++i) {
+            warmed.push_back(createEffectVisual(effect_id, glm::vec2{ 0.0f }));
+        }
+    }
+    // 全部创建后再统一停用，否则后续 acquire 会立即取回刚停用的实体
+    for (auto entity : warmed) {
+        visual_pool_.release(entity);
     }
+    ENGINE_LOG_INFO("视觉实体池预热完成: {} 个实体", warmed.size());
+}
 
-    std::unordered_map<entt::id_type, engine::component::Animation> animations;
-    animations.emplace(blueprint.effect_id_, engine::component::Animation{ std::move(frames), {}, false });
-    registry_.emplace_or_replace<engine::component::AnimationComponent>(entity, std::move(animations), blueprint.effect_id_);
-    registry_.emplace_or_replace<game::defs::VisualEffectTag>(entity);
-    return entity;
+std::size_t EntityFactory::warmUpClasses(const std::vector<data::WaveConfig>& waves) {
+    constexpr glm::vec2 OFFSCREEN{ -100000.0f, -100000.0f };
+    const auto spawn_sequence = next_spawn_sequence_;     // 只在实机中预热，不消耗生成序号
+    std::vector<bool> enemy_seen(blueprint_manager_.getEnemyClassCount(), false);
+    std::vector<entt::entity> warmed;
+    for (const auto& wave : waves) {
+        for (const auto& group : wave.groups_) {
+            const auto index = blueprint_manager_.findEnemyClass(group.class_id_);
+            if (index == INVALID_CLASS_INDEX || enemy_seen[index]) {
+                continue;
+            }
+            enemy_seen[index] = true;
+            warmed.push_back(createEnemyUnitAt(index, OFFSCREEN, 0));
+        }
+    }
+    // 编成可能包含任意职业，与预加载清单一致，全部玩家职业都预热
+    for (std::size_t index = 0; index < blueprint_manager_.getPlayerClassCount(); ++index) {
+        warmed.push_back(createPlayerUnitAt(static_cast<ClassIndex>(index), OFFSCREEN));
+    }
+    registry_.destroy(warmed.begin(), warmed.end());
+    next_spawn_sequence_ = spawn_sequence;
+    ENGINE_LOG_INFO("职业实体预热完成: {} 个职业", warmed.size());
+    return warmed.size();
 }
 
 /**
@@ -2,8 +2,20 @@
 #include <entt/entity/registry.hpp>
 #include <entt/core/hashed_string.hpp>
 #include <glm/vec2.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string_view>
+#include <vector>
 #include "blueprint_manager.h"
+#include "visual_pool.h"
+#include "../component/enemy_component.h"
+#include "../component/stats_component.h"
+#include "../../engine/component/animation_component.h"
+#include "../../engine/component/audio_component.h"
+#include "../../engine/component/sprite_component.h"
+#include "../../engine/component/transform_component.h"
 
 namespace game::factory {
 
@@ -14,6 +26,10 @@ namespace game::factory {
  * @details
  * EntityFactory 使用 BlueprintManager 提供的蓝图数据，按步骤将组件装配到实体上。
  * 这是数据驱动架构的核心，将"创建逻辑"与"数据配置"分离。
+ *
+ * 敌人与玩家单位按职业缓存一份预装配的组件模板：首次生成某职业时从蓝图构建，
+ * 之后的生成只是把模板中的组件逐个复制到新实体上，不再重复解析蓝图、构造精灵与音效表。
+ * 已持有 ClassIndex 的调用方可使用 *At 系列接口跳过 ID 查找。
  */
 class EntityFactory {
 public:
@@ -23,6 +39,7 @@ public:
      * @param blueprint_manager 蓝图管理器引用
      */
     EntityFactory(entt::registry& registry, const BlueprintManager& blueprint_manager);
+    ~EntityFactory();
 
     /**
      * @brief 创建敌人单位
@@ -38,6 +55,55 @@ public:
                                  int target_waypoint_id,
                                  int level = 1,
                                  int rarity = 1);
+
+    /**
+     * @brief 按职业下标创建敌人单位（参数同 createEnemyUnit）
+     * @throws std::out_of_range 下标越界
+     */
+    entt::entity createEnemyUnitAt(ClassIndex index,
+                                   const glm::vec2& position,
+                                   int target_waypoint_id,
+                                   int level = 1,
+                                   int rarity = 1);
+
+    /**
+     * @brief 批量创建同一职业的敌人单位（波次开场、成群刷怪）
+     * @param class_id 敌人类型ID
+     * @param positions 各实体的初始位置
+     * @param target_waypoint_ids 各实体的目标路径点ID，长度须与 positions 相同
+     * @param level 等级（默认为1）
+     * @param rarity 稀有度（默认为1）
+     * @return 创建的实体，顺序与 positions 一致；类型不存在或参数长度不一致时为空。
+     *         指向工厂内部的缓冲，下一次批量创建前有效
+     *
+     * @details 一次性创建全部实体，再按组件逐个存储整段写入模板值，组件存储只增长一次。
+     *          逐实体的中间数组是成员缓冲，由 reserveEnemyUnits() 一并预留，刷怪过程中不分配。
+     */
+    std::span<const entt::entity> createEnemyUnits(entt::id_type class_id,
+                                               std::span<const glm::vec2> positions,
+                                               std::span<const int> target_waypoint_ids,
+                                               int level = 1,
+                                               int rarity = 1);
+
+    /**
+     * @brief 为即将生成的 count 个敌人预留实体与组件存储
+     * @details 在波次开始时按 WaveConfig::enemy_count_ 调用，避免刷怪过程中存储逐步扩容；
+     *          createEnemyUnits() 的批量缓冲也按 count 预留。
+     */
+    void reserveEnemyUnits(std::size_t count);
+
+    /**
+     * @brief 把 count 只同类型的敌人并入一个已在场的敌人（无尽模式的精英合并）
+     * @param elite 接收合并的敌人
+     * @param class_id 被并入敌人的类型ID，属性按其 level / rarity 的模板值计算
+     * @return 类型不存在或 elite 不是敌人时返回 false
+     *
+     * @details 生命值与上限全额累加，攻击力累加 ELITE_ATK_SHARE 比例，威胁度随之更新；
+     *          体型每只放大 ELITE_SCALE_STEP，至多 ELITE_MAX_SCALE 倍，并着 ELITE_COLOR。
+     *          带属性修正的敌人改 BaseStatsComponent 并标记脏。
+     */
+    bool absorbEnemies(entt::entity elite, entt::id_type class_id, std::size_t count, int level = 1, int rarity = 1);
+
     /**
      * @brief 创建玩家单位
      * @param class_id 玩家类型ID（使用 entt::hashed_string 生成，如 "archer"_hs）
@@ -51,6 +117,15 @@ public:
                                  int level = 1,
                                  int rarity = 1);
 
+    /**
+     * @brief 按职业下标创建玩家单位（参数同 createPlayerUnit）
+     * @throws std::out_of_range 下标越界
+     */
+    entt::entity createPlayerUnitAt(ClassIndex index,
+                                    const glm::vec2& position,
+                                    int level = 1,
+                                    int rarity = 1);
+
     entt::entity createUnitPrep(entt::id_type name_id,
                                 entt::id_type class_id,
                                 const glm::vec2& position,
@@ -63,28 +138,83 @@ public:
                                          const glm::vec2& target_position,
                                          const glm::vec2& target_velocity);
 
+    /**
+     * @brief 模拟投射物的视觉实体：从 origin 沿 velocity 直线飞行 flight_time 秒
+     * @details 位置与 ProjectilePool 中的积分一致（同一速度、同一步长），命中或落空时由 ProjectileSystem 停用。
+     */
+    entt::entity createSimulatedProjectileVisual(entt::id_type projectile_id,
+                                                 const glm::vec2& origin,
+                                                 const glm::vec2& velocity,
+                                                 float flight_time);
+
     entt::entity createEffectVisual(entt::id_type effect_id,
                                     const glm::vec2& position);
 
+    /**
+     * @brief 按蓝图的 pool_size 为每种投射物与特效预先创建停用实体
+     * @details 在关卡加载时调用，战斗中的视觉实体从池中取出，不再分配实体与组件存储。
+     */
+    void prewarmVisualPools();
+
+    /**
+     * @brief 为本关波次中的每种敌人与全部玩家职业各创建并立即销毁一个实体
+     * @param waves 关卡波次配置
+     * @return 预热的职业数
+     *
+     * @details 在关卡加载时调用：首次生成某职业时才构建的组件模板、只有个别职业才带的组件存储
+     *          （英雄技能、阻挡者等）都在这里创建，第一波刷怪与第一次出击不再承担这部分开销。
+     *          实体创建在视野外，期间不运行任何系统。
+     */
+    std::size_t warmUpClasses(const std::vector<data::WaveConfig>& waves);
+
+    /**
+     * @brief 下一个单位的生成序号
+     * @details 每生成一个敌人或玩家单位递增，写入 EnemyComponent / PlayerComponent 的 spawn_sequence_。实机与无头回放的生成顺序相同，
+     *          序号因此一致（实体句柄则不同：实机的预热、UI 与地图区块实体也会占用下标）。
+     *          warmUpClasses() 不消耗序号；检查点须连同注册表一起保存与恢复。
+     */
+    [[nodiscard]] std::uint32_t getSpawnSequence() const { return next_spawn_sequence_; }
+    void setSpawnSequence(std::uint32_t sequence) { next_spawn_sequence_ = sequence; }
+
+    /// @brief 注册表整体恢复快照后调用：重建视觉实体池的空闲列表
+    void onRegistryRestored() { visual_pool_.rebuild(); }
+
     [[nodiscard]] int getPlayerUnitCost(entt::id_type class_id, int rarity = 1) const;
+    /// @brief 按职业下标查询部署费用（下标越界时抛出 std::out_of_range）
+    [[nodiscard]] int getPlayerUnitCostAt(ClassIndex index, int rarity = 1) const;
 
 private:
+    struct EnemyTemplate;
+    struct PlayerTemplate;
+
     entt::registry& registry_;
     const BlueprintManager& blueprint_manager_;
+    VisualPool visual_pool_;    ///< 投射物与特效实体池
+    std::vector<std::unique_ptr<EnemyTemplate>> enemy_templates_;     ///< 按 ClassIndex 排列，首次生成时构建
+    std::vector<std::unique_ptr<PlayerTemplate>> player_templates_;
+    std::uint32_t next_spawn_sequence_{ 0 };    ///< 见 getSpawnSequence()
+    std::vector<entt::entity> batch_entities_;                              ///< createEnemyUnits() 的结果，容量跨批次复用
+    std::vector<engine::component::TransformComponent> batch_transforms_;   ///< createEnemyUnits() 的逐实体变换
+    std::vector<game::component::EnemyComponent> batch_enemies_;            ///< createEnemyUnits() 的逐实体敌人组件
+
+    const EnemyTemplate& enemyTemplate(ClassIndex index, int level, int rarity);
+    const PlayerTemplate& playerTemplate(ClassIndex index, int level, int rarity);
 
     // 组件装配辅助函数
     void addTransformComponent(entt::entity entity, const glm::vec2& position);
     void addSpriteComponent(entt::entity entity, const data::SpriteBlueprint& sprite);
     void addAnimationComponent(entt::entity entity,
-                               const std::unordered_map<entt::id_type, data::AnimationBlueprint>& animations,
-                               const data::SpriteBlueprint& sprite,
+                               engine::resource::AnimationLibrary::AnimationSetPtr animations,
                                entt::id_type default_anim_id);
-    void addAudioComponent(entt::entity entity, const data::SoundBlueprint& sounds);
-    void addStatsComponent(entt::entity entity, const data::StatsBlueprint& stats, int level, int rarity);
-    void addEnemyComponent(entt::entity entity, const data::EnemyBlueprint& enemy, int target_waypoint_id);
-    void addPlayerComponent(entt::entity entity, const data::PlayerBlueprint& player, int rarity);
     void addRenderComponent(entt::entity entity, int layer_index);
     void addVelocityComponent(entt::entity entity);
+
+    // 组件构建辅助函数（供模板与单次装配共用）
+    [[nodiscard]] static engine::component::SpriteComponent makeSpriteComponent(const data::SpriteBlueprint& sprite);
+    [[nodiscard]] static std::optional<engine::component::AnimationComponent> makeAnimationComponent(
+        engine::resource::AnimationLibrary::AnimationSetPtr animations, entt::id_type default_anim_id);
+    [[nodiscard]] static engine::component::AudioComponent makeAudioComponent(const data::SoundBlueprint& sounds);
+    [[nodiscard]] static game::component::StatsComponent makeStatsComponent(const data::StatsBlueprint& stats, int level, int rarity);
 };
 
 } // namespace game::factory
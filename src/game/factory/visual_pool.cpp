@@ -0,0 +1,64 @@
+#include "visual_pool.h"
+#include "../defs/tags.h"
+#include "../../engine/component/disabled_tag.h"
+
+namespace game::factory {
+
+VisualPool::VisualPool(entt::registry& registry) : registry_(registry) {
+    registry_.on_construct<engine::component::DisabledTag>().connect<&VisualPool::onDisabled>(this);
+}
+
+VisualPool::~VisualPool() {
+    registry_.on_construct<engine::component::DisabledTag>().disconnect(this);
+}
+
+std::uint64_t VisualPool::makeKey(component::VisualKind kind, entt::id_type visual_id) {
+    return (static_cast<std::uint64_t>(kind) << 32) | static_cast<std::uint64_t>(visual_id);
+}
+
+entt::entity VisualPool::acquire(component::VisualKind kind, entt::id_type visual_id) {
+    if (auto it = free_lists_.find(makeKey(kind, visual_id)); it != free_lists_.end()) {
+        auto& free_list = it->second;
+        while (!free_list.empty()) {
+            const auto entity = free_list.back();
+            free_list.pop_back();
+            // 注册表清空或实体被外部销毁后，句柄版本号失效
+            if (registry_.valid(entity) && registry_.all_of<engine::component::DisabledTag>(entity)) {
+                registry_.remove<engine::component::DisabledTag>(entity);
+                return entity;
+            }
+        }
+    }
+
+    const auto entity = registry_.create();
+    registry_.emplace<component::PooledVisualComponent>(entity, kind, visual_id);
+    registry_.emplace<game::defs::VisualEffectTag>(entity);
+    return entity;
+}
+
+void VisualPool::release(entt::entity entity) {
+    if (registry_.valid(entity) && !registry_.all_of<engine::component::DisabledTag>(entity)) {
+        registry_.emplace<engine::component::DisabledTag>(entity);
+    }
+}
+
+std::size_t VisualPool::getFreeCount(component::VisualKind kind, entt::id_type visual_id) const {
+    auto it = free_lists_.find(makeKey(kind, visual_id));
+    return it != free_lists_.end() ? it->second.size() : 0;
+}
+
+void VisualPool::rebuild() {
+    free_lists_.clear();
+    auto view = registry_.view<component::PooledVisualComponent, engine::component::DisabledTag>();
+    for (auto [entity, pooled] : view.each()) {
+        free_lists_[makeKey(pooled.kind_, pooled.visual_id_)].push_back(entity);
+    }
+}
+
+void VisualPool::onDisabled(entt::registry& registry, entt::entity entity) {
+    if (const auto* pooled = registry.try_get<component::PooledVisualComponent>(entity)) {
+        free_lists_[makeKey(pooled->kind_, pooled->visual_id_)].push_back(entity);
+    }
+}
+
+} // namespace game::factory
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../component/pooled_visual_component.h"
+#include <entt/entity/registry.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace game::factory {
+
+/**
+ * @class VisualPool
+ * @brief 投射物与特效实体的对象池
+ *
+ * @details
+ * 视觉实体结束时不再逐个移除组件并销毁，而是添加 engine::component::DisabledTag 停用；
+ * 池监听 on_construct<DisabledTag>，把带 PooledVisualComponent 的实体放回对应
+ * （类别, 视觉ID）的空闲列表。取出时移除 DisabledTag，由 EntityFactory 用
+ * emplace_or_replace 原地重新初始化组件，整个周期没有实体或组件的构造与销毁。
+ */
+class VisualPool final {
+public:
+    explicit VisualPool(entt::registry& registry);
+    ~VisualPool();
+
+    VisualPool(const VisualPool&) = delete;
+    VisualPool& operator=(const VisualPool&) = delete;
+
+    /**
+     * @brief 取出一个空闲实体（已移除 DisabledTag），没有空闲实体时新建
+     * @details 新建实体只带 PooledVisualComponent 与 VisualEffectTag，其余组件由调用方装配。
+     */
+    entt::entity acquire(component::VisualKind kind, entt::id_type visual_id);
+
+    /// @brief 停用实体并归还到池中（等价于直接添加 DisabledTag）
+    void release(entt::entity entity);
+
+    [[nodiscard]] std::size_t getFreeCount(component::VisualKind kind, entt::id_type visual_id) const;
+
+    /// @brief 按注册表中现有的停用实体重建空闲列表（整体恢复注册表快照之后调用）
+    void rebuild();
+
+private:
+    static std::uint64_t makeKey(component::VisualKind kind, entt::id_type visual_id);
+    void onDisabled(entt::registry& registry, entt::entity entity);
+
+    entt::registry& registry_;
+    std::unordered_map<std::uint64_t, std::vector<entt::entity>> free_lists_;
+};
+
+} // namespace game::factory
@@ -0,0 +1,57 @@
+#include "wave_resource_streamer.h"
+#include "blueprint_manager.h"
+#include "../../engine/utils/logging.h"
+#include <algorithm>
+
+namespace game::factory {
+
+WaveResourceStreamer::WaveResourceStreamer(engine::resource::ResourceManager& resource_manager,
+                                           const BlueprintManager& blueprint_manager,
+                                           const std::vector<data::WaveConfig>& waves)
+    : resource_manager_(resource_manager) {
+    manifests_.reserve(waves.size());
+    for (const auto& wave : waves) {
+        manifests_.push_back(blueprint_manager.buildWaveManifest(wave));
+    }
+    held_.reserve(MAX_HELD_WAVES);
+}
+
+std::size_t WaveResourceStreamer::normalize(std::size_t wave_index) const {
+    return manifests_.empty() ? NO_WAVE : wave_index % manifests_.size();
+}
+
+bool WaveResourceStreamer::isHeld(std::size_t wave_index) const {
+    return std::ranges::any_of(held_, [wave_index](const HeldWave& held) { return held.wave_index_ == wave_index; });
+}
+
+void WaveResourceStreamer::stream(std::size_t wave_index) {
+    wave_index = normalize(wave_index);
+    if (wave_index == NO_WAVE || isHeld(wave_index)) {
+        return;
+    }
+    // 先获取新波次再放开旧的：两者共用的资源引用计数不会归零
+    auto scope = std::make_unique<engine::resource::ResourceScope>(resource_manager_);
+    const auto& manifest = manifests_[wave_index];
+    resource_manager_.acquireManifest(manifest, *scope);
+    resource_manager_.requestPreload(manifest);
+    if (held_.size() >= MAX_HELD_WAVES) {
+        held_.erase(held_.begin());
+    }
+    held_.push_back(HeldWave{ wave_index, std::move(scope) });
+    ENGINE_LOG_DEBUG("流式加载第 {} 个波次的资源: {} 纹理, {} 音效", wave_index + 1, manifest.textures_.size(), manifest.sounds_.size());
+}
+
+void WaveResourceStreamer::retainOnly(std::size_t wave_index) {
+    wave_index = normalize(wave_index);
+    if (wave_index == NO_WAVE) {
+        return;
+    }
+    stream(wave_index);
+    std::erase_if(held_, [wave_index](const HeldWave& held) { return held.wave_index_ != wave_index; });
+}
+
+void WaveResourceStreamer::releaseAll() {
+    held_.clear();
+}
+
+} // namespace game::factory
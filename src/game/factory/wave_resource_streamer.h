@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../data/level_config.h"
+#include "../../engine/resource/resource_handle.h"
+#include "../../engine/resource/resource_manager.h"
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace game::factory {
+
+class BlueprintManager;
+
+/**
+ * @class WaveResourceStreamer
+ * @brief 按波次流式加载敌人的精灵表与音效：第 N 波进行时只持有第 N 波的引用，波次间隔中预取下一波
+ *
+ * @details
+ * 清单由 BlueprintManager::buildWaveManifest() 从 level_config.json 的波次（"groups" / 旧格式 "enemy_types"）
+ * 与敌人蓝图的精灵、音效引用推导，构造时为每个波次算好一份。玩家职业、投射物与特效的资源整关常驻
+ * （buildSharedManifest()，记入场景的 resources_），不在这里管理。
+ *
+ * 每个波次的引用放在一个独立的 ResourceScope 中，同时至多持有 MAX_HELD_WAVES 个：
+ * - stream(N)：获取第 N 波的引用并提交后台加载（已持有时什么也不做），在波次间隔开始时调用，
+ *   解码在 TaskPool 的工作线程上与间隔计时并行
+ * - retainOnly(N)：释放其他波次的引用，在第 N 波开战时调用
+ * 释放只让引用计数归零，同一帧内被后续波次重新获取的资源（两波共用的敌人类型）不会被卸载；
+ * 其余资源在之后的 ResourceManager::update() 中卸载，常驻内存因此只与当前及下一波的敌人组成有关。
+ */
+class WaveResourceStreamer final {
+public:
+    static constexpr std::size_t MAX_HELD_WAVES = 2;    ///< 当前波次 + 预取的下一波
+
+    WaveResourceStreamer(engine::resource::ResourceManager& resource_manager,
+                         const BlueprintManager& blueprint_manager,
+                         const std::vector<data::WaveConfig>& waves);
+
+    /**
+     * @brief 获取第 wave_index 个波次（波次表下标，超出时按波次数取模）的资源引用并提交后台加载
+     * @details 已持有 MAX_HELD_WAVES 个波次时先放开最早获取的一个
+     */
+    void stream(std::size_t wave_index);
+
+    /// @brief 只保留第 wave_index 个波次的引用（未持有时先获取），释放其余波次
+    void retainOnly(std::size_t wave_index);
+
+    /// @brief 释放全部波次的引用
+    void releaseAll();
+
+    [[nodiscard]] std::size_t getWaveCount() const { return manifests_.size(); }
+    [[nodiscard]] std::size_t getHeldCount() const { return held_.size(); }
+
+private:
+    struct HeldWave {
+        std::size_t wave_index_{ 0 };
+        std::unique_ptr<engine::resource::ResourceScope> scope_;
+    };
+
+    /// @brief 取模后的波次下标；没有波次时返回 NO_WAVE
+    [[nodiscard]] std::size_t normalize(std::size_t wave_index) const;
+    [[nodiscard]] bool isHeld(std::size_t wave_index) const;
+
+    static constexpr std::size_t NO_WAVE = std::numeric_limits<std::size_t>::max();
+
+    engine::resource::ResourceManager& resource_manager_;
+    std::vector<engine::resource::PreloadManifest> manifests_;     ///< 按波次表下标
+    std::vector<HeldWave> held_;                                    ///< 按获取顺序，至多 MAX_HELD_WAVES 个
+};
+
+} // namespace game::factory
@@ -2,6 +2,7 @@
 #include "spdlog/spdlog.h"
 #include "../defs/tags.h"
 #include "../../engine/component/tilelayer_component.h"
+#include "../../engine/loader/cooked_level.h"
 namespace game::loader {
     EntityBuilderMW::EntityBuilderMW(engine::loader::LevelLoader &level_loader, engine::core::Context &context, entt::registry &registry, std::unordered_map<int, game::data::WaypointNode> &waypoint_nodes, std::vector<int> &start_points)
     : BasicEntityBuilder(level_loader, context, registry),
@@ -29,22 +30,29 @@ namespace game::loader {
             spdlog::warn("buildPath: object_json_ is null");
             return;
         }
-        bool is_point = object_json_->value("point", false);
+        parseWaypoint(*object_json_, waypoint_nodes_, start_points_);
+    }
+
+    bool EntityBuilderMW::parseWaypoint(const nlohmann::json& object_json,
+        std::unordered_map<int, game::data::WaypointNode>& waypoint_nodes,
+        std::vector<int>& start_points)
+    {
+        bool is_point = object_json.value("point", false);
         if (!is_point) {
-            return;
+            return false;
         }
-        auto id = object_json_->value("id", 0);
+        auto id = object_json.value("id", 0);
         if (id == 0) {
-            return;
+            return false;
         }
         
         game::data::WaypointNode node;
         node.id_ = id;
-        node.position_ = glm::vec2(object_json_->value("x", 0.0f), object_json_->value("y", 0.0f));
+        node.position_ = glm::vec2(object_json.value("x", 0.0f), object_json.value("y", 0.0f));
         
         // 安全地获取 properties 数组
-        auto it = object_json_->find("properties");
-        if (it != object_json_->end() && it->is_array()) {
+        auto it = object_json.find("properties");
+        if (it != object_json.end() && it->is_array()) {
             for (const auto& prop : *it) {
                 std::string prop_name = prop.value("name", "");
                 std::string prop_type = prop.value("type", "");
@@ -56,7 +64,7 @@ namespace game::loader {
 
                     }
                 } else if (prop_name == "start" && prop.value("value", false) == true) {
-                    start_points_.push_back(id);
+                    start_points.push_back(id);
 
                 }
             }
@@ -64,8 +72,51 @@ namespace game::loader {
             spdlog::info("  -> 未找到 properties 数组");
         }
         
-        waypoint_nodes_[id] = std::move(node);
-      
+        waypoint_nodes[id] = std::move(node);
+        return true;
+    }
+
+    std::size_t EntityBuilderMW::collectWaypoints(const engine::loader::LevelLoadData& level_data,
+        std::unordered_map<int, game::data::WaypointNode>& waypoint_nodes,
+        std::vector<int>& start_points)
+    {
+        std::size_t count = 0;
+        if (level_data.cooked_) {
+            const auto& level = *level_data.cooked_;
+            for (const auto& layer : level.getLayers()) {
+                if (layer.type_ != engine::loader::cooked::LayerType::OBJECT || layer.objects_size_ == 0) {
+                    continue;
+                }
+                const auto bytes = level.getBlob(layer.objects_offset_, layer.objects_size_);
+                const auto objects = nlohmann::json::from_msgpack(bytes.begin(), bytes.end(), true, false);
+                if (objects.is_discarded()) {
+                    spdlog::error("预编译关卡对象图层解码失败: {}", level.getPath());
+                    continue;
+                }
+                for (const auto& object_json : objects) {
+                    if (parseWaypoint(object_json, waypoint_nodes, start_points)) {
+                        ++count;
+                    }
+                }
+            }
+            return count;
+        }
+
+        const auto& level_json = level_data.level_json;
+        if (!level_json.contains("layers") || !level_json["layers"].is_array()) {
+            return count;
+        }
+        for (const auto& layer_json : level_json["layers"]) {
+            if (layer_json.value("type", "") != "objectgroup" || !layer_json.contains("objects")) {
+                continue;
+            }
+            for (const auto& object_json : layer_json["objects"]) {
+                if (parseWaypoint(object_json, waypoint_nodes, start_points)) {
+                    ++count;
+                }
+            }
+        }
+        return count;
     }
 
     void EntityBuilderMW::buildPlacementTag()
@@ -2,6 +2,7 @@
 #include <unordered_map>
 #include <vector>
 #include "../../engine/loader/basic_entity_builder.h"
+#include "../../engine/loader/level_loader.h"
 #include "../data/waypoint_node.h"
 
 namespace game::loader {
@@ -19,6 +20,23 @@ namespace game::loader {
         ~EntityBuilderMW() override;
         EntityBuilderMW* build() override;
         void buildPath();
+
+        /**
+         * @brief 解析单个路径点对象（带 point 标记的 Tiled 对象）
+         * @return 是路径点对象时返回 true
+         */
+        static bool parseWaypoint(const nlohmann::json& object_json,
+            std::unordered_map<int, game::data::WaypointNode>& waypoint_nodes,
+            std::vector<int>& start_points);
+
+        /**
+         * @brief 直接从关卡数据的对象图层收集路径点，不创建任何实体（无头模拟使用）
+         * @details 预编译关卡从其 MessagePack 对象图层解码，否则遍历关卡 JSON。
+         * @return 收集到的路径点数量
+         */
+        static std::size_t collectWaypoints(const engine::loader::LevelLoadData& level_data,
+            std::unordered_map<int, game::data::WaypointNode>& waypoint_nodes,
+            std::vector<int>& start_points);
     private:
         void buildPlacementTag();
     };
@@ -3,12 +3,20 @@
 #include "../component/player_component.h"
 #include "../factory/entity_factory.h"
 #include "../factory/blueprint_manager.h"
+#include "../factory/wave_resource_streamer.h"
+#include "../data/battle_compaction.h"
 #include "../loader/entity_builder_mw.h"
 #include "./title_scene.h"
 #include "./level_clear_scene.h"
+#include "../ui/hud_bindings.h"
 #include "../ui/units_portrait_ui.h"
 #include "../system/followpath_system.h"
-#include "../../engine/utils/future_utils.h"
+#include "../system/simulation_lod_system.h"
+#include "../../engine/core/content_cache.h"
+#include "../../engine/core/startup_profiler.h"
+#include "../../engine/ecs/registry_arena.h"
+#include "../../engine/ecs/storage_capacity_hints.h"
+#include "../../engine/memory/storage_arena.h"
 #include "../system/remove_dead_system.h"
 #include "../system/block_system.h"
 #include "../system/set_target_system.h"
@@ -24,20 +32,67 @@
 #include "../system/hero_skill_system.h"
 #include "../system/place_unit_system.h"
 #include "../system/render_range_system.h"
+#include "../system/spatial_index_system.h"
+#include "../system/status_effect_system.h"
+#include "../system/crowd_separation_system.h"
+#include "../system/projectile_system.h"
+#include "../system/effect_particle_system.h"
+#include "../system/damage_number_system.h"
+#include "../system/health_bar_system.h"
+#include "../sim/replay_recorder.h"
+#include "../sim/lockstep_session.h"
+#include "../sim/state_checksum.h"
 #include "../data/selection_state.h"
+#include "../data/position_cache.h"
+#include "../data/behavior_index.h"
+#include "../data/status_effect_store.h"
+#include "../data/injury_queue.h"
+#include "../data/class_cost_profiler.h"
+#include "../data/projectile_pool.h"
+#include "../data/battle_snapshot.h"
+#include "../data/battle_checkpoint.h"
+#include "../data/checkpoint_info.h"
+#include "../../engine/io/save_service.h"
+#include "../defs/groups.h"
 #include "../defs/tags.h"
 #include "../defs/constants.h"
+#include "../defs/ids.h"
 #include "../data/game_stats.h"
 #include "../component/hero_skill_component.h"
 #include "../component/stats_component.h"
+#include "../component/attack_timer_component.h"
+#include "../component/base_stats_component.h"
+#include "../component/blocked_by_component.h"
+#include "../component/blocker_component.h"
+#include "../component/class_name_component.h"
+#include "../component/pooled_visual_component.h"
+#include "../component/projectile_visual_component.h"
+#include "../component/simulation_lod_component.h"
+#include "../component/target_component.h"
 #include "../../engine/component/transform_component.h"
 #include "../../engine/component/velocity_component.h"
 #include "../../engine/component/sprite_component.h"
 #include "../../engine/component/render_component.h"
+#include "../../engine/component/animation_component.h"
+#include "../../engine/component/animation_request_component.h"
+#include "../../engine/component/tile_animation_component.h"
+#include "../../engine/component/disabled_tag.h"
+#include "../../engine/component/low_detail_tag.h"
+#include "../../engine/component/parallax_component.h"
 #include "../../engine/resource/resource_manager.h"
+#include "../../engine/utils/random.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/core/context.h"
 #include "../../engine/core/game_state.h"
+#include "../../engine/core/job_system.h"
+#include "../../engine/core/task_pool.h"
+#include "../../engine/async/task.h"
+#include "../../engine/core/time.h"
+#include "../../engine/core/frame_budget.h"
+#include "../../engine/memory/allocation_counter.h"
+#include "../../engine/memory/frame_arena.h"
+#include "../../engine/memory/memory_tracker.h"
+#include "../../engine/ecs/registry_census.h"
 #include "../../engine/ui/ui_manager.h"
 #include "../../engine/ui/ui_button.h"
 #include "../../engine/ui/ui_panel.h"
@@ -47,93 +102,277 @@
 #include "../../engine/ui/state/hover_state.h"
 #include "../../engine/ui/state/pressed_state.h"
 #include "../../engine/system/render_system.h"
+#include "../../engine/system/parallax_render_system.h"
 #include "../../engine/system/movement_system.h"
 #include "../../engine/system/animation_system.h"
 #include "../../engine/system/ysort_system.h"
+#include "../../engine/system/interpolation_system.h"
 #include "../../engine/system/audio_system.h"
 #include "../../engine/loader/level_loader.h"
-#include "../../engine/utils/logging.h"
+#include "../../engine/spatial/spatial_grid.h"
+#include "../../engine/spatial/flow_field.h"
+#include "../../engine/spatial/tile_grid.h"
+#include "../../engine/render/minimap.h"
+#include "../../engine/render/camera.h"
+#include "../../engine/utils/deferred_log.h"
+#include "../../engine/utils/profiler.h"
 #include "../data/session_data.h"
 #include "../data/ui_config.h"
-#include <fstream>
+#include "../../engine/resource/glyph_atlas.h"
 #include <algorithm>
-#include <future>
+#include <chrono>
+#include <cmath>
+#include <format>
 #include <entt/core/hashed_string.hpp>
+#include <glm/geometric.hpp>
+#include <entt/signal/dispatcher.hpp>
 #include <entt/signal/sigh.hpp>
-#include <nlohmann/json.hpp>
 #include <limits>
+#include <random>
 #include <string>
 
 using namespace entt::literals;
 
-namespace {
-
-void appendEnemyTypesToQueue(const nlohmann::json& wave_json, std::vector<entt::id_type>& enemy_queue) {
-    if (!wave_json.contains("enemy_types") || !wave_json["enemy_types"].is_object()) {
-        return;
-    }
-
-    for (auto it = wave_json["enemy_types"].begin(); it != wave_json["enemy_types"].end(); ++it) {
-        if (!it.value().is_number_integer()) {
-            continue;
-        }
-
-        const int count = it.value().get<int>();
-        if (count <= 0) {
-            continue;
-        }
-
-        const auto class_id = entt::hashed_string(it.key().c_str());
-        for (int i = 0; i < count; ++i) {
-            enemy_queue.push_back(class_id);
-        }
-    }
-}
-
-} // namespace
-
 namespace game::scene {
 
 GameScene::GameScene(engine::core::Context& context, std::size_t level_index)
     : engine::scene::Scene("GameScene", context), selected_level_index_(level_index) {
     auto& dispatcher = context.getDispatcher();
+    // 仍走 dispatcher 的高频事件只采样队列长度，与批量通道一起出现在性能面板计数器中
+    event_queues_.track<engine::utils::AnimationEvent>();
+    event_queues_.track<engine::utils::PlaySoundEvent>();
+    event_queues_.track<game::defs::SpawnEffectVisualEvent>();
+    event_queues_.track<game::defs::SpawnProjectileVisualEvent>();
     // 初始化系统
     render_system_ = std::make_unique<engine::system::RenderSystem>();
+    parallax_render_system_ = std::make_unique<engine::system::ParallaxRenderSystem>();
     movement_system_ = std::make_unique<engine::system::MovementSystem>();
     animation_system_ = std::make_unique<engine::system::AnimationSystem>(registry_, dispatcher);
-    ysort_system_ = std::make_unique<engine::system::YSortSystem>();
+    ysort_system_ = std::make_unique<engine::system::YSortSystem>(registry_);
+    interpolation_system_ = std::make_unique<engine::system::InterpolationSystem>();
 	audio_system_ = std::make_unique<engine::system::AudioSystem>(registry_, dispatcher);
 
+    simulation_lod_system_ = std::make_unique<game::system::SimulationLodSystem>();
     follow_path_system_ = std::make_unique<game::system::FollowPathSystem>();
     remove_dead_system_ = std::make_unique<game::system::RemoveDeadSystem>();
     block_system_ = std::make_unique<game::system::BlockSystem>();
-    set_target_system_ = std::make_unique<game::system::SetTargetSystem>();
+    set_target_system_ = std::make_unique<game::system::SetTargetSystem>(registry_);
     timer_system_ = std::make_unique<game::system::TimerSystem>();
     attack_starter_system_ = std::make_unique<game::system::AttackStarterSystem>();
     projectile_visual_system_ = std::make_unique<game::system::ProjectileVisualSystem>();
     animation_state_system_ = std::make_unique<game::system::AnimationStateSystem>(registry_, dispatcher);
     orientation_system_ = std::make_unique<game::system::OrientationSystem>();
-	animation_events_system_ = std::make_unique<game::system::AnimationEventsSystem>(registry_, dispatcher);
-	combat_resolve_system_ = std::make_unique<game::system::CombatResolveSystem>(registry_, dispatcher);
+	animation_events_system_ = std::make_unique<game::system::AnimationEventsSystem>(registry_, dispatcher, event_queues_);
+	combat_resolve_system_ = std::make_unique<game::system::CombatResolveSystem>(registry_, dispatcher, event_queues_);
+    combat_resolve_system_->setFrameArena(&context.getFrameArena());     // 范围攻击的受害者列表只在本帧结算中使用
+    damage_number_system_ = std::make_unique<game::system::DamageNumberSystem>();
+    damage_number_system_->prewarm(context.getTextRenderer());
+    combat_resolve_system_->setDamageNumbers(damage_number_system_.get());
+    spatial_index_system_ = std::make_unique<game::system::SpatialIndexSystem>();
+    status_effect_system_ = std::make_unique<game::system::StatusEffectSystem>();
+    crowd_separation_system_ = std::make_unique<game::system::CrowdSeparationSystem>();
+    health_bar_system_ = std::make_unique<game::system::HealthBarSystem>(registry_);
+    // 死亡实体的收尾集中在批量销毁之前的一个阶段
+    remove_dead_system_->onBeforeDestroy().connect<&game::system::HealthBarSystem::onEntitiesDestroyed>(*health_bar_system_);
+    remove_dead_system_->onBeforeDestroy().connect<&game::system::BlockSystem::onEntitiesDestroyed>(*block_system_);
+    remove_dead_system_->onBeforeDestroy().connect<&game::system::SpatialIndexSystem::onEntitiesDestroyed>(*spatial_index_system_);
+    remove_dead_system_->onBeforeDestroy().connect<&game::system::StatusEffectSystem::onEntitiesDestroyed>(*status_effect_system_);
+    replay_recorder_ = std::make_unique<game::sim::ReplayRecorder>(dispatcher);
+    enemy_counter_.connect(registry_);
 
     ENGINE_LOG_INFO("GameScene 构造完成");
 }
 
+struct GameScene::LoadTasks {
+    engine::async::Task<bool> task_;                ///< loadAsync() 协程
+    engine::loader::LevelLoadData level_data_;      ///< 协程解析出的地图，init() 取走
+    float progress_ = 0.0f;                         ///< 预取进度 [0, 1]
+    engine::core::TaskPool* pool_ = nullptr;
+
+    /// 协程及其提交的工作线程任务捕获了 GameScene，须在场景成员析构前结束
+    ~LoadTasks() {
+        if (pool_ && task_.isStarted() && !task_.isDone()) {
+            engine::async::runToCompletion(*pool_, task_);
+        }
+    }
+};
+
+struct GameScene::BattleCheckpoint {
+    game::data::BattleRegistrySnapshot registry_;
+    std::optional<engine::utils::RandomService> random_;
+    game::data::GameStats stats_;
+    std::vector<entt::id_type> hidden_unit_portrait_ids_;
+    game::data::WaveSpawner wave_spawner_;                          ///< 刷怪计时器在 timers_ 中
+    std::optional<engine::core::TimerWheel> timers_;
+    std::optional<game::data::StatusEffectStore> status_effects_;   ///< 效果记录的到期计时器在 timers_ 中
+    std::optional<engine::spatial::FlowField> flow_field_;          ///< 含被占用建造位的权重，与 registry_ 中的占用状态一致
+    engine::core::TimerId wave_timer_;
+    engine::core::TimerId wave_banner_timer_;
+    float wave_break_duration_ = 0.0f;
+    std::uint32_t spawn_sequence_ = 0;                              ///< EntityFactory 的生成序号，与 registry_ 中的单位一致
+    int current_wave_ = 0;
+    int base_hp_ = 0;
+    bool wave_running_ = false;
+};
+
 GameScene::~GameScene() {
+    enemy_counter_.disconnect(registry_);
+}
+
+entt::id_type GameScene::prefetchKey(std::size_t level_index) {
+    return entt::hashed_string{ "GameScene" }.value() + static_cast<entt::id_type>(level_index);
+}
+
+void GameScene::setLockstep(std::unique_ptr<game::sim::LockstepSession> session, std::uint64_t seed) {
+    lockstep_ = std::move(session);
+    lockstep_seed_ = seed;
+}
+
+void GameScene::startLoadTasks(engine::core::TaskPriority priority) {
+    if (load_tasks_) {
+        return;
+    }
+    load_tasks_ = std::make_unique<LoadTasks>();
+    load_tasks_->pool_ = &context_.getTaskPool();
+    load_tasks_->task_ = loadAsync(priority);
+    load_tasks_->task_.start();
+}
+
+engine::async::Task<bool> GameScene::loadAsync(engine::core::TaskPriority priority) {
+    auto& pool = context_.getTaskPool();
+    auto& tasks = *load_tasks_;
+
+    // 三项解析互不依赖，同时提交到工作线程
+    auto level_config = engine::async::runOnPool(pool, priority, [this]() {
+        ENGINE_PROFILE_SCOPE("GameScene::loadLevelConfig");
+        return loadLevelConfig();
+    });
+    auto session_data = engine::async::runOnPool(pool, priority, [this]() {
+        ENGINE_PROFILE_SCOPE("GameScene::initSessionData");
+        return initSessionData();
+    });
+    auto ui_config = engine::async::runOnPool(pool, priority, [this]() {
+        ENGINE_PROFILE_SCOPE("GameScene::initUIConfig");
+        return initUIConfig();
+    });
+
+    // 主线程步骤之后让出一帧，过场界面上不出现明显的单帧卡顿
+    {
+        ENGINE_STARTUP_PHASE("scene.blueprints");
+        if (!loadBlueprints()) {
+            ENGINE_LOG_WARN("预加载蓝图失败，进入场景时重试");
+        }
+    }
+    tasks.progress_ = 0.1f;
+    co_await engine::async::nextFrame(pool);
+
+    const bool level_config_ok = co_await level_config;
+    std::optional<engine::async::PoolAwaiter<engine::loader::LevelLoadData>> level_data;
+    if (level_config_ok) {
+        // 本关会用到的精灵表与音效在工作线程上解码，与地图解析并行
+        if (blueprint_manager_) {
+            // 整关常驻的纹理与音效记入场景的资源引用：引用期间纹理不因显存预算被淘汰，离开本关后卸载
+            const auto manifest = blueprint_manager_->buildSharedManifest();
+            context_.getResourceManager().acquireManifest(manifest, resources_);
+            context_.getResourceManager().requestPreload(manifest);
+            // 敌人按波次流式加载：开局只取第一波，之后每个波次间隔预取下一波
+            wave_resources_ = std::make_unique<game::factory::WaveResourceStreamer>(
+                context_.getResourceManager(), *blueprint_manager_, level_waves_);
+            wave_resources_->stream(0);
+        }
+        level_data.emplace(pool, priority, [path = current_map_path_, cache = &context_.getContentCache()]() {
+            return engine::loader::LevelLoader::loadLevelData(path, true, cache);
+        });
+    }
+    tasks.progress_ = 0.2f;
+
+    // 提前返回之前也要等完捕获了 this 的任务
+    const bool session_data_ok = co_await session_data;
+    const bool ui_config_ok = co_await ui_config;
+    if (!level_config_ok) {
+        ENGINE_LOG_ERROR("初始化关卡配置失败");
+        co_return false;
+    }
+    if (!session_data_ok) {
+        ENGINE_LOG_ERROR("初始化 SessionData 失败");
+        co_return false;
+    }
+    if (!ui_config_ok) {
+        ENGINE_LOG_ERROR("初始化 UIConfig 失败");
+        co_return false;
+    }
+
+    try {
+        tasks.level_data_ = co_await *level_data;
+    } catch (const std::exception& e) {
+        ENGINE_LOG_ERROR("等待关卡数据异步任务失败: {}", e.what());
+        co_return false;
+    }
+    if (!tasks.level_data_.valid_) {
+        ENGINE_LOG_ERROR("关卡数据解析失败: {}", tasks.level_data_.error_message);
+        co_return false;
+    }
+    tasks.progress_ = 0.5f;
+
+    // 预取时等本关纹理与音效解码、上传完毕再进入，开场不出现占位纹理；同步进入时不等
+    if (priority == engine::core::TaskPriority::BACKGROUND) {
+        const auto& resources = context_.getResourceManager();
+        const auto total = std::max<std::size_t>(resources.getPendingCount(), 1);
+        while (const auto pending = resources.getPendingCount()) {
+            tasks.progress_ = 0.5f + 0.5f * (1.0f - static_cast<float>(std::min(pending, total)) / static_cast<float>(total));
+            co_await engine::async::nextFrame(pool);
+        }
+    }
+    tasks.progress_ = 1.0f;
+    co_return true;
+}
+
+void GameScene::prefetch() {
+    ENGINE_LOG_INFO("GameScene 开始预取第 {} 关", selected_level_index_ + 1);
+    startLoadTasks(engine::core::TaskPriority::BACKGROUND);
+}
+
+bool GameScene::isReadyToInit() const {
+    return !load_tasks_ || load_tasks_->task_.isDone();
+}
+
+float GameScene::getLoadProgress() const {
+    return load_tasks_ ? load_tasks_->progress_ : 0.0f;
 }
 
 void GameScene::init() {
     ENGINE_LOG_INFO("GameScene 初始化开始");
+    ENGINE_STARTUP_PHASE("scene.init");
+    const auto init_start = std::chrono::steady_clock::now();
 
     auto fail_and_clean = [this](const char* message) {
         ENGINE_LOG_ERROR("{}", message);
         clean();
     };
 
-    auto level_config_future = std::async(std::launch::async, [this]() { return loadLevelConfig(); });
-    auto session_data_future = std::async(std::launch::async, [this]() { return initSessionData(); });
-    auto ui_config_future = std::async(std::launch::async, [this]() { return initUIConfig(); });
-    std::future<engine::loader::LevelLoadData> level_data_future;
+    // 已预取时加载协程早已完成（SceneManager 等到 isReadyToInit() 才切换），否则现在启动、稍后同步等待
+    startLoadTasks(engine::core::TaskPriority::FRAME);
+
+    // 配置了 registry_arena_mb 时，存储预留（分组、容量提示、CapacityPlanner、工厂批量预留）落在同一段连续区间
+    if (const auto arena_bytes = engine::memory::StorageArena::getConfiguredCapacity(); arena_bytes > 0 && !storage_arena_) {
+        storage_arena_ = std::make_unique<engine::memory::StorageArena>(arena_bytes);
+        registry_.ctx().emplace<engine::ecs::RegistryArena>(storage_arena_.get());
+    }
+
+    // 在创建任何实体（预热对象池、加载关卡）之前建立拥有型分组
+    {
+        const engine::memory::StorageArenaScope arena_scope{ storage_arena_.get() };
+        game::defs::declareGroups(registry_);
+    }
+    // 切关/重建场景：按上一个战斗场景的存储容量一次预留，新注册表不再从空存储逐级扩容
+    capacity_hints_ = context_.getContentCache().getOrLoad<engine::ecs::StorageCapacityHints>("storage_capacity"_hs, {}, [] {
+        return std::make_shared<engine::ecs::StorageCapacityHints>();
+    });
+    if (capacity_hints_ && !capacity_hints_->empty()) {
+        capacity_hints_->reserveEntities(registry_);
+        game::data::BattleRegistrySnapshot::forEachComponent([this]<typename T>() { capacity_hints_->reserve<T>(registry_); });
+        ENGINE_LOG_DEBUG("按上一场景的存储容量预留注册表: {} 个元素", capacity_hints_->totalCapacity());
+    }
 
     if (!initEventConnections()) {
         fail_and_clean("初始化事件连接失败");
@@ -148,46 +387,33 @@ void GameScene::init() {
         return;
     }
 
-    if (!level_config_future.get()) {
-        fail_and_clean("初始化关卡配置失败");
-        return;
+    auto& load = *load_tasks_;
+    {
+        ENGINE_STARTUP_PHASE("scene.load_wait");
+        engine::async::runToCompletion(context_.getTaskPool(), load.task_);
     }
-
-    level_data_future = engine::loader::LevelLoader::loadLevelDataAsync(current_map_path_);
-
-    engine::loader::LevelLoadData level_data;
-    if (!engine::utils::consumeFuture(
-        level_data_future,
-        [&](engine::loader::LevelLoadData data) {
-            level_data = std::move(data);
-            if (!level_data.valid_) {
-                ENGINE_LOG_ERROR("关卡数据解析失败: {}", level_data.error_message);
-                return false;
-            }
-            return true;
-        },
-        [&](const std::exception& e) {
-            ENGINE_LOG_ERROR("等待关卡数据异步任务失败: {}", e.what());
-            return false;
-        })) {
+    if (!load.task_.result()) {
         fail_and_clean("加载关卡失败");
         return;
     }
-
-    if (!session_data_future.get()) {
-        fail_and_clean("初始化 SessionData 失败");
-        return;
-    }
-    if (!ui_config_future.get()) {
-        fail_and_clean("初始化 UIConfig 失败");
-        return;
-    }
+    engine::loader::LevelLoadData level_data = std::move(load.level_data_);
+    load_tasks_.reset();
 
     if (!loadLevel(level_data)) {
         fail_and_clean("加载关卡失败");
         return;
     }
 
+    // 放置点瓦片已生成：按波次峰值与放置点数一次性预留单位存储，避免战斗中途扩容
+    const auto placement_slots = registry_.view<game::defs::MeleePlaceTag>().size() + registry_.view<game::defs::RangePlaceTag>().size();
+    capacity_planner_.apply(registry_, game::factory::CapacityPlanner::plan(level_waves_, placement_slots));
+    if (endless_config_ && !level_waves_.empty()) {
+        // 无尽模式：存活敌人不超过硬上限，按它一次预留，之后各波不再按（逐轮放大的）敌人数扩容
+        endless_.begin(*endless_config_, level_waves_.size(), !lockstep_);
+        entity_factory_->reserveEnemyUnits(endless_config_->hardCap());
+    }
+    render_system_->reserve(registry_.storage<engine::component::SpriteComponent>().capacity());
+
     if (!initRegistryContext()) {
         fail_and_clean("初始化注册表上下文失败");
         return;
@@ -208,11 +434,18 @@ void GameScene::init() {
         fail_and_clean("初始化出击系统失败");
         return;
     }
+    if (!initSystemScheduler()) {
+        fail_and_clean("初始化系统调度失败");
+        return;
+    }
     Scene::init();
     context_.getGameState().setState(engine::core::GameStateType::Playing);
-    if (!initUI()) {
-        fail_and_clean("初始化 UI 失败");
-        return;
+    {
+        ENGINE_STARTUP_PHASE("scene.ui_build");
+        if (!initUI()) {
+            fail_and_clean("初始化 UI 失败");
+            return;
+        }
     }
     context_.getResourceManager().stopMusic();
     context_.getResourceManager().playMusic(entt::hashed_string("battle_bgm").value());
@@ -220,88 +453,385 @@ void GameScene::init() {
     game_stats_.home_hp_ = base_hp_;
     game_stats_.cost_ = static_cast<float>(game::defs::INITIAL_GOLD);
     game_stats_.cost_gen_per_second_ = 1.0f;
-    last_unit_panel_cost_ = static_cast<int>(game_stats_.cost_);
     current_wave_ = 0;
     wave_running_ = false;
     selected_unit_id_ = 0;
     selected_unit_name_.clear();
-    health_bar_widgets_.clear();
-    wave_spawn_timer_ = 0.0f;
-    wave_break_timer_ = 0.0f;
     wave_break_duration_ = level_prep_time_;
-    ENGINE_LOG_INFO("GameScene 初始化完成");
+    wave_spawner_ = {};     // 计时器随新的时间轮一起清空
+    auto& timers = registry_.ctx().insert_or_assign(engine::core::TimerWheel{ context_.getTime().getFixedDeltaTime() });
+    wave_timer_ = timers.scheduleAfter(timers.ticksFor(wave_break_duration_), entt::null, game::defs::timer_event::WAVE_BREAK);
+    streamWaveResources();
+
+    // 模拟用随机数：种子写入回放日志，无头模拟重放时按同一种子复现路径分支等随机选择
+    const std::uint64_t seed = lockstep_seed_ ? *lockstep_seed_
+                             : level_seed_.value_or((static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}());
+    registry_.ctx().insert_or_assign(engine::utils::RandomService{ seed });
+    replay_recorder_->begin(seed, static_cast<std::uint32_t>(selected_level_index_), context_.getTime().getFixedDeltaTime());
+    updateTileStreaming();  // 初始视野内的区块在预热与第一次提取之前载入
+    {
+        ENGINE_STARTUP_PHASE("scene.warmup");
+        warmUp();
+    }
+    captureCheckpoint(0);
+    extractRenderState();   // 第一次模拟步之前也有快照可画
+    const double load_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - init_start).count();
+    telemetry_.begin(current_level_name_, selected_level_index_, load_ms, context_.getResourceManager().getTextureCacheStats());
+    ENGINE_LOG_INFO("GameScene 初始化完成（{:.1f} ms）", load_ms);
+    engine::core::StartupProfiler::instance().notifySceneReady();
 }
 
 void GameScene::update(float delta_time) {
+    // 区块烘焙与实体创建会分配内存，放在零分配检查范围之外；相机在上一帧末尾已更新
+    updateTileStreaming();
+    if (pending_rewind_wave_) {
+        restoreCheckpoint(*pending_rewind_wave_);
+        pending_rewind_wave_.reset();
+        extractRenderState();
+    }
+    animateWaveBanner(delta_time);
     if (context_.getGameState().isGameOver()) {
-        updateUi(delta_time);
+        if (wave_banner_text_ && wave_banner_text_->isVisible()) {
+            wave_banner_text_->setVisible(false);   // 模拟已停止，横幅计时器不会再到期
+        }
+        updateUi();
         Scene::update(delta_time);
         return;
     }
 
-    auto& dispatcher = context_.getDispatcher();
+    // 开战后的稳态帧不应有堆分配；--zero-alloc 时统计本帧的分配，=assert 时在分配处断言
+    engine::memory::ZeroAllocationScope zero_allocation(current_wave_ > 0);
 
     if (selection_system_) {
-        selection_system_->update(registry_, context_);
+        ENGINE_PROFILE_SCOPE("SelectionSystem");
+        selection_system_->update(registry_, context_, isRateDue(hover_rate_, hover_tick_));
     }
 
-    dispatcher.update();
+    if (audio_system_) {
+        // 听众在视口中心；听觉半径略大于半对角线，屏幕边缘的音效衰减但仍可闻，屏幕外远处的直接剔除
+        const auto& camera = context_.getCamera();
+        const glm::vec2 view = camera.getViewSize();
+        audio_system_->setListener(camera.getPosition() + view * 0.5f, glm::length(view) * game::defs::AUDIO_LISTENER_RADIUS_SCALE);
+    }
+
+    // 模拟按固定步长推进，本帧要补跑的步数由 Time 的累加器给出（快进时为多个子步）；UI 与输入仍按帧更新
+    auto& time = context_.getTime();
+    if (lockstep_) {
+        // 锁步按双方都已就绪的步数执行，可能少于（等待）或多于（追赶）Time 调度的步数；步序号以实际执行的为准
+        time.overrideSimulationSteps(pollLockstep(time.getSimulationSteps()));
+    }
+    const int steps = time.getSimulationSteps();
+    const std::uint64_t first_tick = time.getSimulationTick() - static_cast<std::uint64_t>(steps) + 1;
+    const auto sim_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps && !context_.getGameState().isGameOver(); ++i) {
+        if (lockstep_) {
+            applyLockstepCommands();
+        }
+        simulate(time.getFixedDeltaTime(), first_tick + static_cast<std::uint64_t>(i), i + 1 == steps);
+        if (lockstep_) {
+            endLockstepStep();
+        }
+    }
+    if (steps > 0) {
+        extractRenderState();   // 子步之间的中间结果不会被画出，只提取本帧最后的状态
+        if (effect_particle_system_ && !context_.getGameState().isPaused()) {
+            ENGINE_PROFILE_SCOPE("EffectParticleSystem");
+            effect_particle_system_->update(time.getFixedDeltaTime() * static_cast<float>(steps));
+        }
+        if (!context_.getGameState().isPaused()) {
+            damage_number_system_->update(time.getFixedDeltaTime() * static_cast<float>(steps));
+        }
+    }
+    const double sim_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sim_start).count();
+
+    {
+        ENGINE_PROFILE_SCOPE("GameScene::updateUi");
+        updateUi();
+    }
+    Scene::update(delta_time);
+
+    const std::size_t alive = registry_.storage<entt::entity>().size();
+    ENGINE_PROFILE_COUNTER("alive", static_cast<std::int64_t>(alive));
+    event_queues_.publishStats();
+    if (zero_allocation.isActive()) {
+        // 遥测数组按会话增长，不在检查范围内
+        reportFrameAllocations(zero_allocation.finish());
+    }
+    telemetry_.setWave(current_wave_);
+    telemetry_.recordFrame(static_cast<double>(time.getDeltaTime()) * 1000.0, sim_ms, last_render_ms_, alive);
+    if (endless_.isActive()) {
+        const auto& budget = context_.getFrameBudget();
+        endless_.recordFrame(static_cast<double>(time.getDeltaTime()) * 1000.0, budget.getLevel(),
+                             budget.getSmoothedMs() > budget.getBudgetMs(), enemy_counter_.get(), alive);
+    }
+    ENGINE_LOG_DEBUG("alive={}", registry_.storage<entt::entity>().size());
+}
+
+void GameScene::reportFrameAllocations(const engine::memory::AllocationCount& allocated) {
+    ENGINE_PROFILE_COUNTER("mem.update_allocs", static_cast<std::int64_t>(allocated.count_));
+    if (allocated.count_ == 0) {
+        return;
+    }
+    ++zero_alloc_violations_;
+    if (zero_alloc_reported_wave_ == current_wave_) {
+        return;
+    }
+    zero_alloc_reported_wave_ = current_wave_;
+    ENGINE_LOG_WARN("零分配检查: 第 {} 波 GameScene::update 分配了 {} 次（{} B），累计 {} 帧违例；各作用域的分配见性能面板",
+        current_wave_, allocated.count_, allocated.bytes_, zero_alloc_violations_);
+}
+
+void GameScene::simulate(float delta_time, std::uint64_t tick, bool last_substep) {
+    auto& dispatcher = context_.getDispatcher();
+
+    // 渲染只在最后一步之间插值；提前结束（游戏结束）时快照序号对不上，渲染自动不插值
+    if (last_substep) {
+        ENGINE_PROFILE_SCOPE("InterpolationSystem");
+        interpolation_system_->snapshot(registry_, tick);   // 记录本步之前的位置，供渲染插值
+    }
+    {
+        // EventPhase::SIMULATION：每个固定步派发一次
+        ENGINE_PROFILE_SCOPE("Dispatcher::update");
+        event_queues_.sample(dispatcher);
+        dispatcher.update();
+    }
+    {
+        // 动画事件在上面的派发中产生命中/治疗事件，本步即整段结算
+        ENGINE_PROFILE_SCOPE("EventQueues::flush");
+        event_queues_.flush();
+    }
+    {
+        ENGINE_PROFILE_SCOPE("CombatResolveSystem");
+        combat_resolve_system_->resolve();   // flush 只累计伤害/治疗，这里按目标一次结算
+    }
 
     if (!context_.getGameState().isPaused()) {
+        replay_recorder_->beginStep(delta_time);
+        {
+            // 本步到期的计时器在下面的 updateWaveFlow 与 TimerSystem 中处理
+            ENGINE_PROFILE_SCOPE("TimerWheel");
+            auto& timers = registry_.ctx().get<engine::core::TimerWheel>();
+            timers.advance();
+            ENGINE_PROFILE_COUNTER("timer.pending", static_cast<std::int64_t>(timers.size()));
+        }
         if (game_rule_system_) {
+            ENGINE_PROFILE_SCOPE("GameRuleSystem");
             game_rule_system_->update(delta_time);
         }
         if (hero_skill_system_) {
+            ENGINE_PROFILE_SCOPE("HeroSkillSystem");
             hero_skill_system_->update(delta_time);
         }
         if (game_stats_.home_hp_ <= 0) {
             context_.getGameState().setState(engine::core::GameStateType::GameOver);
+            endless_.finishCycle(engine::ecs::RegistrySnapshot<>::getStorageBytes(registry_), true);
         }
         if (place_unit_system_) {
+            ENGINE_PROFILE_SCOPE("PlaceUnitSystem");
             place_unit_system_->update(delta_time);
         }
-        updateWaveFlow(delta_time);
-
-        // 每一帧最先清理死亡实体(要在dispatcher处理完事件后再清理，因此放在下一帧开头)
-        remove_dead_system_->update(registry_);
-
-        // 注意系统更新的顺序
-        follow_path_system_->update(registry_, dispatcher, waypoint_nodes_);
-        block_system_->update(registry_, dispatcher);
-
-        // 战斗循环
-        set_target_system_->update(registry_);
-        timer_system_->update(registry_, dispatcher, delta_time);
-        attack_starter_system_->update(registry_, dispatcher);
-        projectile_visual_system_->update(registry_, delta_time);
+        {
+            ENGINE_PROFILE_SCOPE("WaveFlow");
+            updateWaveFlow();
+        }
 
-        movement_system_->update(registry_, delta_time);
-        animation_system_->update(delta_time);
+        // RemoveDead 到 YSort 的顺序与读写声明见 initSystemScheduler()
+        step_delta_time_ = delta_time;
+        last_substep_ = last_substep;
+        {
+            ENGINE_PROFILE_SCOPE("SystemScheduler");
+            system_scheduler_.run(registry_);
+        }
+        if (replay_recorder_->isChecksumTick()) {
+            replay_recorder_->recordChecksum(game::sim::computeStateChecksum(registry_, game_stats_));
+        }
+        replay_recorder_->endStep();
+        capacity_planner_.sample();
+        if (auto* costs = registry_.ctx().find<game::data::ClassCostProfiler>()) {
+            costs->sampleTick(registry_, delta_time);
+        }
+    }
+}
 
-        // 视觉修正
-        orientation_system_->update(registry_);
-        ysort_system_->update(registry_);   // 调用顺序要在MovementSystem之后
+void GameScene::updateTileStreaming() {
+    if (!level_loader_) {
+        return;
     }
+    const auto& camera = context_.getCamera();
+    level_loader_->updateStreaming(camera.getViewRect());
+}
 
-    updateUi(delta_time);
-    Scene::update(delta_time);
+void GameScene::extractRenderState() {
+    ENGINE_PROFILE_SCOPE("RenderSystem::extract");
+    // 排序统计是上一帧渲染的结果，在模拟侧写入注册表上下文供调试面板读取
+    registry_.ctx().insert_or_assign(render_system_->getSortStats());
+    // 动画时钟取关卡开始以来的模拟时间：暂停时精灵表动画随模拟一起停止
+    const auto& timers = registry_.ctx().get<engine::core::TimerWheel>();
+    const double animation_time_ms = static_cast<double>(timers.getTick()) * timers.getTickSeconds() * 1000.0;
+    render_system_->extract(registry_, &context_.getCamera(), context_.getTime().getSimulationTick(), animation_time_ms);
+}
 
-    ENGINE_LOG_DEBUG("alive={}", registry_.storage<entt::entity>().size());
+glm::vec2 GameScene::latchCursorSprites() {
+    const auto prep = place_unit_system_ ? place_unit_system_->getActivePrep() : entt::null;
+    const auto* transform = prep != entt::null ? registry_.try_get<engine::component::TransformComponent>(prep) : nullptr;
+    if (!transform) {
+        return glm::vec2{ 0.0f };
+    }
+    // 准备实体的变换就是快照中的位置（只在模拟步中随鼠标移动），修正量即晚采样位置与它之差
+    const auto mouse_world = context_.getCamera().screenToWorld(context_.getInputManager().latchLogicalMousePosition());
+    const glm::vec2 offset = mouse_world - transform->position_;
+    render_system_->setLateLatchOffset(prep, offset);
+    return offset;
 }
 
 void GameScene::render() {
-    if (render_range_system_) {
-        render_range_system_->update(registry_, context_.getRenderer(), context_.getCamera());
+    const auto render_start = std::chrono::steady_clock::now();
+    // 空闲帧（暂停、游戏结束）由渲染器重放冻结的世界层，这里只画 UI
+    if (!context_.getRenderer().isWorldReplaying()) {
+        const glm::vec2 prep_offset = latchCursorSprites();
+        {
+            ENGINE_PROFILE_SCOPE("ParallaxRenderSystem");
+            parallax_render_system_->update(registry_, context_.getRenderer(), context_.getCamera());   // 背景图层先于一切世界精灵
+        }
+        if (render_range_system_) {
+            ENGINE_PROFILE_SCOPE("RenderRangeSystem");
+            const bool selected_only = context_.getFrameBudget().isReduced(engine::core::QualityStep::SELECTED_RANGE_ONLY);
+            render_range_system_->update(registry_, context_.getRenderer(), context_.getCamera(), selected_only, prep_offset);
+        }
+        {
+            ENGINE_PROFILE_SCOPE("RenderSystem");
+            const auto& time = context_.getTime();
+            // 帧预算最后一档：关闭插值，直接绘制最新模拟位置
+            const bool interpolate = !context_.getFrameBudget().isReduced(engine::core::QualityStep::NO_INTERPOLATION);
+            render_system_->setInterpolation(interpolate ? time.getInterpolationAlpha() : 1.0f, time.getSimulationTick());
+            render_system_->update(context_.getRenderer(), context_.getCamera());
+        }
+        if (effect_particle_system_) {
+            ENGINE_PROFILE_SCOPE("EffectParticleSystem::render");
+            effect_particle_system_->render(context_.getRenderer(), context_.getCamera());
+        }
+        {
+            ENGINE_PROFILE_SCOPE("HealthBarSystem::render");
+            health_bar_system_->render(context_.getRenderer(), context_.getCamera());
+        }
+        {
+            ENGINE_PROFILE_SCOPE("DamageNumberSystem::render");
+            damage_number_system_->render(context_.getTextRenderer(), context_.getCamera());    // 飘字压在血条之上
+        }
+        if (minimap_) {
+            ENGINE_PROFILE_SCOPE("Minimap");
+            // 只有地图超出视野时才需要总览
+            const auto& camera = context_.getCamera();
+            const glm::vec2 viewport = camera.getViewportSize();
+            const glm::vec2 view = camera.getViewSize();
+            const glm::vec2 world = level_world_size_;
+            if (world.x > view.x || world.y > view.y) {
+                static constexpr engine::render::Minimap::MarkerStyle MARKER_STYLES[] = {
+                    { game::defs::spatial_layer::ENEMY, { 0.95f, 0.25f, 0.2f, 1.0f } },
+                    { game::defs::spatial_layer::PLAYER, { 0.3f, 0.6f, 1.0f, 1.0f } },
+                };
+                const glm::vec2 position{ viewport.x - minimap_->getSize().x - MINIMAP_MARGIN, MINIMAP_MARGIN };
+                minimap_->draw(context_.getRenderer(), registry_, camera,
+                               registry_.ctx().get<engine::spatial::SpatialGrid>(), MARKER_STYLES, position);
+            }
+        }
     }
-    render_system_->update(registry_, context_.getRenderer(), context_.getCamera());
 
     Scene::render();
+    last_render_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - render_start).count();
+}
+
+void GameScene::warmUp() {
+    ENGINE_PROFILE_SCOPE("GameScene::warmUp");
+    const auto start = std::chrono::steady_clock::now();
+    auto& resources = context_.getResourceManager();
+    std::vector<SDL_Texture*> textures;
+
+    // 纹理与音效：后台加载未完成的在这里同步收尾（解码早已提交，通常只剩上传）；之后的波次由波次间隔流式加载
+    std::size_t sounds = 0;
+    auto warm_manifest = [&](const engine::resource::PreloadManifest& manifest) {
+        for (const auto& path : manifest.textures_) {
+            if (auto* texture = resources.getTextureRegion(engine::resource::toResourceId(path), path, false).texture_) {
+                textures.push_back(texture);
+            }
+        }
+        for (const auto sound_id : manifest.sounds_) {
+            sounds += resources.getSound(sound_id) != nullptr;
+        }
+    };
+    warm_manifest(blueprint_manager_->buildSharedManifest());
+    if (!level_waves_.empty()) {
+        warm_manifest(blueprint_manager_->buildWaveManifest(level_waves_.front()));
+    }
+
+    // 界面字号：启动时的后台打开可能尚未收入，这里直接取用并光栅化清单中的字符
+    for (const auto& font : ui_config_->getFontPreload()) {
+        const auto font_id = engine::resource::toResourceId(font.path_);
+        auto warm_atlas = [&](engine::resource::GlyphAtlas* atlas) {
+            if (!atlas) {
+                return;
+            }
+            atlas->warm(font.glyphs_);
+            for (std::uint32_t page = 0; page < atlas->getPageCount(); ++page) {
+                textures.push_back(atlas->getPageTexture(page));
+            }
+        };
+        for (const int size : font.sizes_) {
+            warm_atlas(resources.getGlyphAtlas(font_id, font.path_, size));
+        }
+        if (font.scalable_) {
+            warm_atlas(resources.getScalableGlyphAtlas(font_id, font.path_));
+        }
+    }
+
+    // 组件模板与只有个别职业才有的组件存储
+    const auto classes = entity_factory_->warmUpClasses(level_waves_);
+
+    // 图集页被多个区域共享，去重后每张纹理只画一次
+    std::ranges::sort(textures);
+    const auto [first, last] = std::ranges::unique(textures);
+    textures.erase(first, last);
+    const auto drawn = context_.getRenderer().warmTextures(textures);
+
+    const double warm_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ENGINE_LOG_INFO("首帧预热完成（{:.1f} ms）: {} 张纹理, {} 个音效, {} 个职业", warm_ms, drawn, sounds, classes);
+}
+
+void GameScene::reportMemoryUsage() const {
+    using engine::memory::MemoryTag;
+    Scene::reportMemoryUsage();
+    auto& tracker = engine::memory::MemoryTracker::instance();
+    tracker.setReported(MemoryTag::REGISTRY, game::data::BattleRegistrySnapshot::getStorageBytes(registry_));
+    if (blueprint_manager_) {
+        tracker.setReported(MemoryTag::BLUEPRINTS, blueprint_manager_->getMemoryBytes());
+        tracker.setReported(MemoryTag::ANIMATION, blueprint_manager_->getAnimationLibrary().getContentBytes());
+    }
 }
 
 void GameScene::clean() {
     auto& dispatcher = context_.getDispatcher();
     auto& input_manager = context_.getInputManager();
-    waitForPendingSaveTasks(true);
+    load_tasks_.reset();    // 初始化中途失败时等待仍在运行的加载任务
+    telemetry_.write(telemetry_dir_, event_queues_.getStats(), context_.getResourceManager().getTextureCacheStats());
+    // 常驻写入线程不随场景销毁，但重开/切关后的新场景可能立即读取存档，退出前等待写完
+    if (!engine::io::SaveService::instance().flush()) {
+        ENGINE_LOG_ERROR("部分存档写入失败，见上方日志");
+    }
+    if (replay_recorder_) {
+        replay_recorder_->save(replay_path_);
+    }
+    lockstep_.reset();
+    capacity_planner_.report();
+    wave_resources_.reset();    // 与 resources_ 一样在 Scene::clean() 之前释放，之后的帧中卸载
+    if (const auto* costs = registry_.ctx().find<game::data::ClassCostProfiler>()) {
+        costs->report();
+    }
+    endless_.finishCycle(engine::ecs::RegistrySnapshot<>::getStorageBytes(registry_), false);
+    if (capacity_hints_) {
+        capacity_hints_->record(registry_);
+        capacity_hints_.reset();
+    }
+    system_scheduler_.logTimings();
     // 断开所有事件连接
     dispatcher.disconnect(this);
     // 断开输入信号连接
@@ -310,54 +840,31 @@ void GameScene::clean() {
     input_manager.onAction("move_left"_hs).disconnect<&GameScene::onCreateTestPlayerHealer>(this);
     input_manager.onAction("release_skill"_hs).disconnect<&GameScene::onReleaseSelectedHeroSkill>(this);
     input_manager.onAction("pause"_hs).disconnect<&GameScene::togglePause>(this);
-    health_bar_widgets_.clear();
     hidden_unit_portrait_ids_.clear();
-    health_bar_layer_ = nullptr;
+    // 相机由应用持有，下一个场景从默认视野开始
+    context_.getCamera().setZoom(1.0f);
+    context_.getCamera().setLimitBounds(std::nullopt);
+    units_portrait_ui_.reset();
+    hud_bindings_.reset();
     unit_panel_ = nullptr;
     pause_overlay_ = nullptr;
     selection_system_.reset();
     game_rule_system_.reset();
     hero_skill_system_.reset();
+    if (place_unit_system_) {
+        remove_dead_system_->onBeforeDestroy().disconnect(place_unit_system_.get());
+    }
     place_unit_system_.reset();
     render_range_system_.reset();
+    minimap_.reset();
+    level_loader_.reset();
     Scene::clean();
 }
 
-bool GameScene::waitForPendingSaveTasks(bool log_as_error) {
-    bool all_ok = true;
-    for (auto& pending_task : pending_save_tasks_) {
-        if (!engine::utils::consumeFuture(
-            pending_task.task,
-            [&](bool result) {
-                if (!result) {
-                    all_ok = false;
-                    if (log_as_error) {
-                        ENGINE_LOG_ERROR("异步保存任务返回失败: {}", pending_task.save_path);
-                    } else {
-                        ENGINE_LOG_WARN("异步保存任务返回失败: {}", pending_task.save_path);
-                    }
-                }
-                return result;
-            },
-            [&](const std::exception& e) {
-                all_ok = false;
-                if (log_as_error) {
-                    ENGINE_LOG_ERROR("异步保存任务失败: {} ({})", pending_task.save_path, e.what());
-                } else {
-                    ENGINE_LOG_WARN("异步保存任务异常: {} ({})", pending_task.save_path, e.what());
-                }
-                return false;
-            })) {
-            all_ok = false;
-        }
-    }
-
-    pending_save_tasks_.clear();
-    return all_ok;
-}
-
 bool GameScene::loadLevel(const engine::loader::LevelLoadData& level_data) {
-    engine::loader::LevelLoader level_loader;
+    level_loader_.reset();
+    auto level_loader_owner = std::make_unique<engine::loader::LevelLoader>();
+    auto& level_loader = *level_loader_owner;
     // 设置拓展的构建器EntityBuilderMW
     level_loader.setEntityBuilder(std::make_unique<game::loader::EntityBuilderMW>(level_loader, 
         context_, 
@@ -369,9 +876,73 @@ bool GameScene::loadLevel(const engine::loader::LevelLoadData& level_data) {
         ENGINE_LOG_ERROR("加载关卡失败: {}", current_map_path_);
         return false;
     }
+    if (level_loader.isStreaming()) {
+        level_loader_ = std::move(level_loader_owner);     // 区块随相机移动载入，构建器与映射的关卡文件须一直可用
+    }
+    path_table_.build(waypoint_nodes_);
+
+    // 瓦片格子表：各瓦片层合并一次，之后的障碍与危险格查询都是数组读取
+    registry_.ctx().insert_or_assign(engine::spatial::TileGrid{});
+    registry_.ctx().get<engine::spatial::TileGrid>().build(registry_, level_loader.getMapSize(), level_loader.getTileSize());
+
+    // 流场总在上下文中（调度器按资源声明读取），只有流场导航的关卡才构建
+    registry_.ctx().insert_or_assign(engine::spatial::FlowField{});
+    if (navigation_mode_ == game::defs::NavigationMode::FLOW_FIELD) {
+        buildFlowField(level_loader.getMapSize(), level_loader.getTileSize());
+    }
+
+    // 小地图：底图在首次绘制时烘焙一次，路径线段按路径点连接关系生成
+    level_world_size_ = glm::vec2{ level_loader.getMapSize() * level_loader.getTileSize() };
+    // 滚轮缩放后相机不移出地图（拉远到视野大于地图时停在左上角）
+    context_.getCamera().setLimitBounds(engine::utils::Rect{ glm::vec2(0.0f), level_world_size_ });
+    std::vector<std::pair<glm::vec2, glm::vec2>> path_segments;
+    for (const auto& [id, node] : waypoint_nodes_) {
+        for (const int next_id : node.next_node_ids_) {
+            if (auto it = waypoint_nodes_.find(next_id); it != waypoint_nodes_.end()) {
+                path_segments.emplace_back(node.position_, it->second.position_);
+            }
+        }
+    }
+    minimap_ = std::make_unique<engine::render::Minimap>();
+    minimap_->setWorld(level_world_size_);
+    minimap_->setPaths(std::move(path_segments));
     return true;
 }
 
+void GameScene::buildFlowField(glm::ivec2 map_size, glm::ivec2 tile_size) {
+    ENGINE_PROFILE_SCOPE("GameScene::buildFlowField");
+    if (map_size.x <= 0 || map_size.y <= 0 || tile_size.x <= 0) {
+        ENGINE_LOG_WARN("地图尺寸无效，流场导航不可用，敌人沿路径点前进");
+        return;
+    }
+
+    // 任一瓦片层在该格是 SOLID 即不可通行（TileGrid 已合并与地图同尺寸的图层）
+    std::vector<std::uint8_t> costs(static_cast<std::size_t>(map_size.x) * static_cast<std::size_t>(map_size.y),
+                                    engine::spatial::FlowField::DEFAULT_COST);
+    const auto& tile_grid = registry_.ctx().get<engine::spatial::TileGrid>();
+    if (tile_grid.isBuilt() && tile_grid.getSize() == map_size) {
+        const auto cells = tile_grid.getCells();
+        for (std::size_t i = 0; i < costs.size(); ++i) {
+            if ((cells[i] & engine::spatial::TileGrid::BLOCKED) != 0) {
+                costs[i] = engine::spatial::FlowField::BLOCKED;
+            }
+        }
+    }
+
+    // 所有终点共用一张流场：敌人走向最近的终点
+    std::vector<glm::vec2> goals;
+    for (std::size_t i = 0; i < path_table_.getNodeCount(); ++i) {
+        const auto& node = path_table_.getNode(static_cast<std::uint32_t>(i));
+        if (node.segment_count_ == 0) {
+            goals.push_back(node.position_);
+        }
+    }
+
+    auto& flow_field = registry_.ctx().get<engine::spatial::FlowField>();
+    flow_field.build(glm::vec2{ 0.0f }, static_cast<float>(tile_size.x), map_size, std::move(costs), goals);
+    ENGINE_LOG_INFO("流场构建完成: {}x{}，{} 个终点", map_size.x, map_size.y, goals.size());
+}
+
 bool GameScene::initSessionData()
 {
     session_data_ = std::make_unique<game::data::SessionData>();
@@ -393,52 +964,25 @@ bool GameScene::initUIConfig()
 }
 
 bool GameScene::loadLevelConfig() {
-    std::ifstream file(level_config_path_);
-    if (!file.is_open()) {
-        ENGINE_LOG_ERROR("无法打开关卡配置文件: {}", level_config_path_);
-        return false;
-    }
-
-    nlohmann::json config_json;
-    try {
-        file >> config_json;
-    }
-    catch (const std::exception& e) {
-        ENGINE_LOG_ERROR("解析关卡配置失败: {}", e.what());
-        return false;
-    }
-
-    if (!config_json.is_array() || config_json.empty()) {
-        ENGINE_LOG_ERROR("关卡配置文件为空或格式无效: {}", level_config_path_);
+    game::data::LevelConfig level_config;
+    if (!level_config.load(level_config_path_, selected_level_index_)) {
         return false;
     }
 
-    if (selected_level_index_ >= config_json.size()) {
-        selected_level_index_ = 0;
-    }
-
-    const auto& level_json = config_json.at(selected_level_index_);
-    current_level_name_ = level_json.value("name", current_level_name_);
-    current_map_path_ = level_json.value("map_path", current_map_path_);
-    level_prep_time_ = level_json.value("prep_time", level_prep_time_);
-    enemy_level_ = level_json.value("enemy_level", enemy_level_);
-    enemy_rarity_ = level_json.value("enemy_rarity", enemy_rarity_);
-
-    level_waves_.clear();
-    if (level_json.contains("waves") && level_json["waves"].is_array()) {
-        for (const auto& wave_json : level_json["waves"]) {
-            WaveConfig wave;
-            wave.spawn_interval_ = wave_json.value("spawn_interval", game::defs::WAVE_SPAWN_INTERVAL);
-            wave.next_wave_interval_ = wave_json.value("next_wave_interval", game::defs::WAVE_BREAK_DURATION);
-            appendEnemyTypesToQueue(wave_json, wave.enemy_queue_);
-
-            if (!wave.enemy_queue_.empty()) {
-                level_waves_.push_back(std::move(wave));
-            }
-        }
-    }
-
-    ENGINE_LOG_INFO("关卡配置加载完成: {} -> {}，波次数: {}", current_level_name_, current_map_path_, level_waves_.size());
+    selected_level_index_ = level_config.getLevelIndex();
+    current_level_name_ = level_config.getName();
+    if (hud_bindings_) {
+        hud_bindings_->invalidate();
+    }
+    current_map_path_ = level_config.getMapPath();
+    level_prep_time_ = level_config.getPrepTime();
+    level_seed_ = level_config.getSeed();
+    navigation_mode_ = level_config.getNavigation();
+    crowd_separation_ = level_config.isCrowdSeparationEnabled();
+    enemy_level_ = level_config.getEnemyLevel();
+    enemy_rarity_ = level_config.getEnemyRarity();
+    level_waves_ = level_config.getWaves();
+    endless_config_ = level_config.getEndless();
     return true;
 }
 
@@ -450,9 +994,13 @@ bool GameScene::initEventConnections() {
     dispatcher.sink<game::defs::UIPortraitHoverEnterEvent>().connect<&GameScene::onUIPortraitHoverEnter>(this);
     dispatcher.sink<game::defs::UIPortraitHoverLeaveEvent>().connect<&GameScene::onUIPortraitHoverLeave>(this);
     dispatcher.sink<game::defs::RestartEvent>().connect<&GameScene::onRestartRequested>(this);
+    dispatcher.sink<game::defs::RetryWaveEvent>().connect<&GameScene::onRetryWaveRequested>(this);
+    dispatcher.sink<game::defs::RewindToWaveEvent>().connect<&GameScene::onRewindToWaveRequested>(this);
     dispatcher.sink<game::defs::BackToTitleEvent>().connect<&GameScene::onBackToTitleRequested>(this);
     dispatcher.sink<game::defs::SaveEvent>().connect<&GameScene::onSaveRequested>(this);
+    dispatcher.sink<engine::io::SaveCompletedEvent>().connect<&GameScene::onSaveCompleted>(this);
     dispatcher.sink<game::defs::LevelClearEvent>().connect<&GameScene::onLevelClearRequested>(this);
+    dispatcher.sink<game::defs::PlaceUnitRequestEvent>().connect<&GameScene::onPlaceUnitRequested>(this);
     return true;
 }
 
@@ -462,20 +1010,36 @@ bool GameScene::initInputConnections() {
     return true;
 }
 
+bool GameScene::loadBlueprints() {
+    if (blueprint_manager_) {
+        return true;
+    }
+    // 蓝图表在应用生命周期内共享：重新开始、切换关卡不再重新解析，源文件修改后才重新加载
+    static const game::factory::BlueprintSources BLUEPRINT_SOURCES{};
+    static const std::vector<std::string> BLUEPRINT_PATHS = BLUEPRINT_SOURCES.paths();
+    blueprint_manager_ = context_.getContentCache().getOrLoad<game::factory::BlueprintManager>("blueprints"_hs, BLUEPRINT_PATHS,
+        [this]() -> std::shared_ptr<game::factory::BlueprintManager> {
+            // 五个蓝图文件在 TaskPool 上并行解析，合并与资源预加载请求在主线程上一次完成
+            auto blueprint_manager = std::make_shared<game::factory::BlueprintManager>(context_.getResourceManager());
+            if (!blueprint_manager->loadAll(BLUEPRINT_SOURCES, &context_.getTaskPool())) {
+                ENGINE_LOG_ERROR("蓝图资源加载失败");
+                return nullptr;
+            }
+            return blueprint_manager;
+        });
+    return blueprint_manager_ != nullptr;
+}
+
 bool GameScene::initEntityFactory() {
-    if (!blueprint_manager_) {
-        blueprint_manager_ = std::make_shared<game::factory::BlueprintManager>(context_.getResourceManager());
-        if (!blueprint_manager_->loadEnemyClassBlueprints("assets/data/enemy_data.json") ||
-            !blueprint_manager_->loadPlayerClassBlueprints("assets/data/player_data.json") ||
-            !blueprint_manager_->loadSkillBlueprints("assets/data/skill_data.json") ||
-            !blueprint_manager_->loadProjectileBlueprints("assets/data/projectile_data.json") ||
-            !blueprint_manager_->loadEffectBlueprints("assets/data/effect_data.json")) {
-            ENGINE_LOG_ERROR("蓝图资源加载失败");
-            return false;
-        }
+    if (!loadBlueprints()) {
+        return false;
     }
 
     entity_factory_ = std::make_unique<game::factory::EntityFactory>(registry_, *blueprint_manager_);
+    entity_factory_->prewarmVisualPools();
+    projectile_system_ = std::make_unique<game::system::ProjectileSystem>(registry_, event_queues_, entity_factory_.get());
+    effect_particle_system_ = std::make_unique<game::system::EffectParticleSystem>();
+    effect_particle_system_->registerEmitters(*blueprint_manager_);
     ENGINE_LOG_INFO("entity_factory_ 加载完成");
     return true;
 }
@@ -486,7 +1050,31 @@ bool GameScene::initRegistryContext() {
         registry_.ctx().emplace<std::shared_ptr<game::data::SessionData>>(std::shared_ptr<game::data::SessionData>(session_data_.get(), [](game::data::SessionData*) {}));
         registry_.ctx().emplace<std::shared_ptr<game::data::UIConfig>>(std::shared_ptr<game::data::UIConfig>(ui_config_.get(), [](game::data::UIConfig*) {}));
         registry_.ctx().emplace<game::data::GameStats&>(game_stats_);
+        behaviors_ = std::make_unique<game::data::BehaviorIndex>(registry_);
+        registry_.ctx().emplace<game::data::BehaviorIndex&>(*behaviors_);
         registry_.ctx().emplace<game::data::SelectionState>();
+        registry_.ctx().emplace<engine::spatial::SpatialGrid>(game::defs::BLOCK_RADIUS * 2.0f);
+        registry_.ctx().emplace<game::data::PositionCache>();
+        registry_.ctx().emplace<game::data::StatusEffectStore>();
+        registry_.ctx().emplace<game::data::InjuryQueue>();
+        game::system::ProjectileSystem::registerKinds(registry_.ctx().emplace<game::data::ProjectilePool>(), *blueprint_manager_);
+        registry_.ctx().emplace<engine::core::JobSystem&>(context_.getJobSystem());
+        if (game::data::isCostAttributionEnabled()) {
+            registry_.ctx().emplace<game::data::ClassCostProfiler>();
+        }
+
+        census_ = std::make_unique<engine::ecs::RegistryCensus>(registry_);
+        game::data::BattleRegistrySnapshot::forEachComponent([this]<typename T>() { census_->watch<T>(); });
+        census_->addArchetype<game::component::EnemyComponent>("敌人");
+        census_->addArchetype<game::component::EnemyComponent, game::component::BlockedByComponent>("敌人+被阻挡");
+        census_->addArchetype<game::component::EnemyComponent, engine::component::LowDetailTag>("敌人+低细节");
+        census_->addArchetype<game::component::PlayerComponent>("玩家");
+        census_->addArchetype<game::component::PlayerComponent, game::component::TargetComponent>("玩家+目标");
+        census_->addArchetype<game::component::BehaviorComponent>("行为状态单位");
+        census_->addArchetype<game::defs::VisualEffectTag>("视觉特效");
+        census_->addArchetype<game::defs::VisualEffectTag, engine::component::DisabledTag>("视觉特效(池中停用)");
+        census_->addArchetype<game::defs::DeadTag>("待移除");
+        registry_.ctx().emplace<engine::ecs::RegistryCensus&>(*census_);
     } catch (const std::exception& e) {
         ENGINE_LOG_ERROR("初始化注册表上下文失败: {}", e.what());
         return false;
@@ -506,7 +1094,7 @@ bool GameScene::initSelectionSystem() {
 
 bool GameScene::initHeroSkillSystem() {
     try {
-        hero_skill_system_ = std::make_unique<game::system::HeroSkillSystem>(registry_, context_.getDispatcher());
+        hero_skill_system_ = std::make_unique<game::system::HeroSkillSystem>(registry_, context_.getDispatcher(), event_queues_);
     } catch (const std::exception& e) {
         ENGINE_LOG_ERROR("初始化英雄技能系统失败: {}", e.what());
         return false;
@@ -527,6 +1115,8 @@ bool GameScene::initGameRuleSystem() {
 bool GameScene::initPlacementSystem() {
     try {
         place_unit_system_ = std::make_unique<game::system::PlaceUnitSystem>(registry_, context_.getDispatcher(), context_, *entity_factory_);
+        place_unit_system_->setDeferredPlacement(lockstep_ != nullptr);
+        remove_dead_system_->onBeforeDestroy().connect<&game::system::PlaceUnitSystem::onEntitiesDestroyed>(*place_unit_system_);
         render_range_system_ = std::make_unique<game::system::RenderRangeSystem>();
     } catch (const std::exception& e) {
         ENGINE_LOG_ERROR("初始化出击系统失败: {}", e.what());
@@ -535,6 +1125,140 @@ bool GameScene::initPlacementSystem() {
     return true;
 }
 
+bool GameScene::initSystemScheduler() {
+    using namespace engine::component;
+    using namespace game::component;
+    using namespace game::defs;
+    auto& dispatcher = context_.getDispatcher();
+    auto& scheduler = system_scheduler_;
+
+    // 系统内 insert_or_assign 的统计先放入上下文，并行阶段中不再插入新的上下文变量
+    registry_.ctx().insert_or_assign(game::system::SimulationLodStats{});
+    registry_.ctx().insert_or_assign(game::system::TargetAcquireStats{});
+
+    // 登记顺序即原先的串行顺序，冲突的系统仍按此顺序执行
+    // 每一步最先清理死亡实体(要在dispatcher处理完事件后再清理，因此放在下一帧开头)
+    scheduler.add("RemoveDeadSystem", [this](engine::ecs::CommandBuffer&) { remove_dead_system_->update(registry_); })
+        .exclusive();   // 销毁实体，并经 onBeforeDestroy 通知血条/阻挡/出击/状态效果系统
+    scheduler.add("StatusEffectSystem", [this](engine::ecs::CommandBuffer&) {
+            status_effect_system_->update(registry_, event_queues_, step_delta_time_);
+        })
+        // 汇总倍率改写有效属性；首次带修正的单位添加 BaseStatsComponent
+        .writes<StatsComponent, AttackTimerComponent, EnemyComponent, BaseStatsComponent>()
+        .readsResource<engine::core::TimerWheel>()
+        .writesResource<game::data::StatusEffectStore, engine::ecs::EventQueues>();
+    scheduler.add("SimulationLodSystem", [this](engine::ecs::CommandBuffer&) {
+            simulation_lod_system_->update(registry_, context_.getCamera());   // 使用上一步重建的空间网格
+        })
+        .reads<EnemyComponent, StatsComponent, PlayerComponent, TransformComponent, TargetComponent, BlockedByComponent,
+               BehaviorComponent, DeadTag>()
+        .writes<LowDetailTag, SimulationLodComponent>()
+        .readsResource<engine::spatial::SpatialGrid, engine::render::Camera>()
+        .writesResource<game::system::SimulationLodStats>();
+    scheduler.add("FollowPathSystem", [this, &dispatcher](engine::ecs::CommandBuffer&) {
+            follow_path_system_->update(registry_, dispatcher, path_table_, step_delta_time_);
+        })
+        .reads<TransformComponent, BlockedByComponent, BehaviorComponent>()
+        // 直接添加 DeadTag：SetTargetSystem 的信号回调随即改写锁定者的 TargetComponent
+        .writes<EnemyComponent, VelocityComponent, SimulationLodComponent, DeadTag, TargetComponent>()
+        .readsResource<game::data::PathTable, engine::spatial::FlowField>()
+        .writesResource<engine::utils::RandomService, entt::dispatcher, game::system::SetTargetSystem>();
+    scheduler.add("BlockSystem", [this](engine::ecs::CommandBuffer& commands) { block_system_->update(registry_, commands); })
+        .reads<EnemyComponent, TransformComponent>()
+        .writes<BlockedByComponent, BlockerComponent, AnimationRequestComponent, VelocityComponent>()
+        .readsResource<engine::spatial::SpatialGrid>();
+
+    // 战斗循环
+    scheduler.add("SetTargetSystem", [this](engine::ecs::CommandBuffer& commands) { set_target_system_->update(registry_, commands); })
+        .reads<TransformComponent, StatsComponent, PlayerComponent, EnemyComponent, RangedUnitTag, HealerTag, BehaviorComponent, DeadTag>()
+        .writes<TargetComponent>()
+        .readsResource<engine::spatial::SpatialGrid>()
+        .writesResource<game::system::SetTargetSystem, game::system::TargetAcquireStats, game::data::InjuryQueue>();
+    scheduler.add("TimerSystem", [this, &dispatcher](engine::ecs::CommandBuffer&) {
+            timer_system_->update(registry_, dispatcher, step_delta_time_);
+        })
+        .reads<HeroSkillComponent>()
+        // 就绪经 BehaviorIndex 转移状态，技能就绪改写标志位
+        .writes<AttackTimerComponent, BehaviorComponent>()
+        .readsResource<engine::core::TimerWheel>()
+        .writesResource<entt::dispatcher, game::data::BehaviorIndex>();
+    scheduler.add("AttackStarterSystem", [this](engine::ecs::CommandBuffer& commands) { attack_starter_system_->update(registry_, commands); })
+        .reads<EnemyComponent, PlayerComponent, BlockedByComponent, TargetComponent, HealerTag>()
+        .writes<AttackTimerComponent, BehaviorComponent, AnimationRequestComponent, VelocityComponent>()
+        .writesResource<game::data::BehaviorIndex>();
+    scheduler.add("ProjectileVisualSystem", [this](engine::ecs::CommandBuffer&) {
+            projectile_visual_system_->update(registry_, step_delta_time_);
+        })
+        .reads<PooledVisualComponent>()
+        // 添加 DisabledTag 会把实体移出拥有型分组（重排渲染/移动分组拥有的存储），并回收到对象池；
+        // patch<TransformComponent> 经信号写入 YSortSystem 的脏集合
+        .writes<ProjectileVisualComponent, DisabledTag, TransformComponent, RenderComponent, SpriteComponent, VelocityComponent>()
+        .writesResource<game::factory::VisualPool, engine::system::YSortSystem>();
+    // 分离修正叠加在本步已确定的速度上（寻路、阻挡、攻击之后），由关卡配置开启
+    follow_path_system_->setPathSkipping(!crowd_separation_);
+    scheduler.add("CrowdSeparationSystem", [this](engine::ecs::CommandBuffer&) { crowd_separation_system_->update(registry_); })
+        .reads<EnemyComponent, TransformComponent, BlockedByComponent, BehaviorComponent, DeadTag>()
+        .writes<VelocityComponent>()
+        .readsResource<engine::spatial::SpatialGrid>()
+        .runIf([this] { return crowd_separation_; });
+    scheduler.add("MovementSystem", [this](engine::ecs::CommandBuffer&) { movement_system_->update(registry_, step_delta_time_); })
+        .reads<VelocityComponent, DisabledTag>()
+        .writes<TransformComponent>()
+        .writesResource<engine::system::YSortSystem>();    // 为移动过的实体 patch<TransformComponent>
+    scheduler.add("SpatialIndexSystem", [this](engine::ecs::CommandBuffer&) {
+            spatial_index_system_->update(registry_);   // 位置更新后重建空间索引，供下一帧的阻挡/索敌/拾取查询
+        })
+        .reads<TransformComponent, PlayerComponent, BehaviorComponent, EnemyComponent, BlockerComponent, ClassNameComponent, DeadTag>()
+        .writesResource<engine::spatial::SpatialGrid, game::data::PositionCache>();
+    // 动画帧事件驱动命中与治疗，每个子步都要推进
+    // 用刚重建的空间网格扫掠判定投射物命中，命中事件在下一步开头结算
+    scheduler.add("ProjectileSystem", [this](engine::ecs::CommandBuffer&) { projectile_system_->update(step_delta_time_); })
+        .reads<DeadTag>()
+        // 停用视觉实体与 ProjectileVisualSystem 相同：移出拥有型分组并回收到对象池
+        .writes<DisabledTag, ProjectileVisualComponent, TransformComponent, RenderComponent, SpriteComponent, VelocityComponent>()
+        .readsResource<engine::spatial::SpatialGrid>()
+        .writesResource<game::data::ProjectilePool, game::factory::VisualPool, engine::system::YSortSystem, engine::ecs::EventQueues>();
+    scheduler.add("AnimationSystem", [this](engine::ecs::CommandBuffer&) { animation_system_->update(step_delta_time_); })
+        .reads<DisabledTag, LowDetailTag, TileAnimationComponent>()
+        .writes<AnimationComponent, SpriteComponent, AnimationRequestComponent>()
+        .writesResource<entt::dispatcher, engine::component::TileAnimationClocks>();
+
+    // 视觉修正：只取决于最后一步的状态，快进的中间子步跳过
+    auto last_substep = [this] { return last_substep_; };
+    scheduler.add("OrientationSystem", [this](engine::ecs::CommandBuffer&) { orientation_system_->update(registry_); })
+        .reads<OrientableTag, FaceLeftTag, TargetComponent, BlockedByComponent, TransformComponent, VelocityComponent,
+               DisabledTag, LowDetailTag>()
+        .writes<SpriteComponent>()
+        .runIf(last_substep)
+        .throttleable();    // 朝向只影响翻转，晚几步修正看不出来
+    scheduler.add("YSortSystem", [this](engine::ecs::CommandBuffer&) { ysort_system_->update(registry_); })
+        .reads<TransformComponent, SpriteComponent, ParallaxComponent>()
+        .writes<RenderComponent>()
+        .writesResource<engine::system::YSortSystem>()
+        .runIf(last_substep);
+
+    // 按帧执行的表现类系统与调度器中的降频系统一起分配相位
+    scheduler.addExternalRate("HealthBarSystem");
+    scheduler.addExternalRate("SelectionSystem");
+    const float fixed_delta_time = context_.getTime().getFixedDeltaTime();
+    scheduler.setTickHz(fixed_delta_time > 0.0f ? 1.0f / fixed_delta_time : 0.0f);
+
+    if (!scheduler.build(registry_)) {
+        return false;
+    }
+    health_bar_rate_ = scheduler.getRate("HealthBarSystem");
+    hover_rate_ = scheduler.getRate("SelectionSystem");
+    scheduler.logSchedule();
+    return true;
+}
+
+bool GameScene::isRateDue(const engine::core::TickRate& rate, std::uint64_t& last_tick) {
+    const std::uint64_t tick = system_scheduler_.getTick();
+    const bool due = rate.interval_ <= 1 || context_.getGameState().isPaused() || rate.isDueIn(last_tick, tick);
+    last_tick = tick;
+    return due;
+}
+
 bool GameScene::initUI() {
     auto* ui_manager = getUIManager();
     if (!ui_manager) {
@@ -554,6 +1278,7 @@ bool GameScene::initUI() {
     hud_panel->setBackgroundColor({ 0.0f, 0.0f, 0.0f, 0.0f });
     hud_panel->setBorderColor({ 0.0f, 0.0f, 0.0f, 0.0f });
     hud_panel->setBorderWidth(0.0f);
+    hud_panel->setCached(true);     // 文本只在数值变化时更新，其余帧只贴一次缓存
     auto* hud_panel_ptr = hud_panel.get();
 
     auto hp_icon = std::make_unique<engine::ui::UIImage>(context_, engine::resource::toResourceId("ui_circle"), glm::vec2{ 14.0f, 14.0f }, glm::vec2{ 24.0f, 24.0f });
@@ -562,13 +1287,6 @@ bool GameScene::initUI() {
     auto gold_icon = std::make_unique<engine::ui::UIImage>(context_, engine::resource::toResourceId("ui_weapon_icon"), glm::vec2{ 14.0f, 50.0f }, glm::vec2{ 24.0f, 24.0f });
     hud_panel_ptr->addChild(std::move(gold_icon));
 
-    auto health_bar_layer = std::make_unique<engine::ui::UIPanel>(context_);
-    health_bar_layer->setPosition({ 0.0f, 0.0f });
-    health_bar_layer->setSize(window_size);
-    health_bar_layer->setBackgroundColor({ 0.0f, 0.0f, 0.0f, 0.0f });
-    health_bar_layer_ = health_bar_layer.get();
-    ui_manager->addElement(std::move(health_bar_layer));
-
     auto pause_button = std::make_unique<engine::ui::UIButton>(context_, "Pause", font_path_, 24);
     pause_button->setPosition({ window_size.x - 160.0f, 18.0f });
     pause_button->setSize({ 140.0f, 40.0f });
@@ -587,12 +1305,14 @@ bool GameScene::initUI() {
     gold_text_ = gold_text.get();
     gold_text_->setColor({ 1.0f, 0.92f, 0.45f, 1.0f });
     hud_panel_ptr->addChild(std::move(gold_text));
+    hud_bindings_ = std::make_unique<game::ui::HudBindings>(*hud_text_, gold_text_, current_level_name_, selected_unit_name_);
 
     ui_manager->addElement(std::move(hud_panel));
 
     createUnitsPortraitUI();
 
     auto wave_banner = std::make_unique<engine::ui::UIText>(context_, "", font_path_, 26);
+    wave_banner->setScalable(true);     // 弹出动画逐帧改变字号，共用一个可缩放图集
     wave_banner->setAlignment(engine::ui::TextAlignment::CENTER);
     wave_banner->setPosition({ window_size.x * 0.5f, 72.0f });
     wave_banner_text_ = wave_banner.get();
@@ -605,6 +1325,7 @@ bool GameScene::initUI() {
     pause_overlay->setSize({ 300.0f, 180.0f });
     pause_overlay->setBackgroundColor({ 0.0f, 0.0f, 0.0f, 0.0f });
     pause_overlay->setVisible(false);
+    pause_overlay->setCached(true);
     pause_overlay_ = pause_overlay.get();
     ui_manager->addElement(std::move(pause_overlay));
 
@@ -645,184 +1366,89 @@ void GameScene::createUnitsPortraitUI()
         return;
     }
 
-    const auto& layout = ui_config_->getUnitPanelLayout();
-    const auto window_size = context_.getGameState().getWindowLogicalSize();
-
     if (registry_.ctx().contains<game::data::SelectionState>()) {
         registry_.ctx().get<game::data::SelectionState>().hovered_portrait_name_id_ = 0;
     }
 
-    if (!unit_panel_) {
+    // 控件只在首次调用时创建，之后只刷新单位列表
+    if (!units_portrait_ui_) {
+        auto* ui_manager = getUIManager();
+        if (!ui_manager) {
+            return;
+        }
         auto unit_panel = std::make_unique<engine::ui::UIPanel>(context_);
         unit_panel->setBackgroundColor({ 0.0f, 0.0f, 0.0f, 0.0f });
+        unit_panel->setCached(true);
         unit_panel_ = unit_panel.get();
-        if (auto* ui_manager = getUIManager()) {
-            ui_manager->addElement(std::move(unit_panel));
-        }
-    }
-    const float previous_scroll_x = unit_panel_scroll_x_;
-    unit_panel_content_width_ = 0.0f;
-    game::ui::rebuildUnitsPortraitUI(
-        *unit_panel_,
-        context_,
-        *session_data_,
-        *ui_config_,
-        *entity_factory_,
-        game_stats_,
-        hidden_unit_portrait_ids_,
-        unit_panel_scroll_x_,
-        &unit_panel_content_width_,
-        [this](const game::data::UnitData& unit, int cost) {
-            selected_unit_id_ = unit.name_id_;
-            selected_unit_name_ = unit.name_;
-            ENGINE_LOG_INFO("选择角色肖像: {} ({})", unit.name_, unit.class_name_);
-            context_.getDispatcher().enqueue(game::defs::PrepUnitEvent{ unit.name_id_, unit.class_id_, cost, unit.level_, unit.rarity_ });
-        });
+        ui_manager->addElement(std::move(unit_panel));
 
-    unit_panel_max_scroll_x_ = std::max(0.0f, unit_panel_content_width_ - (window_size.x - static_cast<float>(layout.padding_) * 2.0f));
-    unit_panel_scroll_x_ = std::clamp(unit_panel_scroll_x_, 0.0f, unit_panel_max_scroll_x_);
-    if (unit_panel_scroll_x_ != previous_scroll_x) {
-        unit_panel_content_width_ = 0.0f;
-        game::ui::rebuildUnitsPortraitUI(
-            *unit_panel_,
+        units_portrait_ui_ = std::make_unique<game::ui::UnitsPortraitUI>(
             context_,
-            *session_data_,
+            *unit_panel_,
             *ui_config_,
-            *entity_factory_,
-            game_stats_,
-            hidden_unit_portrait_ids_,
-            unit_panel_scroll_x_,
-            &unit_panel_content_width_,
             [this](const game::data::UnitData& unit, int cost) {
                 selected_unit_id_ = unit.name_id_;
                 selected_unit_name_ = unit.name_;
                 ENGINE_LOG_INFO("选择角色肖像: {} ({})", unit.name_, unit.class_name_);
-                context_.getDispatcher().enqueue(game::defs::PrepUnitEvent{ unit.name_id_, unit.class_id_, cost, unit.level_, unit.rarity_ });
+                // 玩家指令走即时路径：准备实体在本帧 update 之前创建，不等任何一次派发
+                context_.getDispatcher().trigger(game::defs::PrepUnitEvent{ unit.name_id_, unit.class_id_, cost, unit.level_, unit.rarity_ });
             });
     }
+    units_portrait_ui_->setCost(static_cast<int>(game_stats_.cost_));
+    units_portrait_ui_->setUnits(*session_data_, *entity_factory_, hidden_unit_portrait_ids_);
 }
 
-void GameScene::updateHealthBars()
-{
-    if (!health_bar_layer_) {
+void GameScene::animateWaveBanner(float delta_time) {
+    if (!wave_banner_text_ || wave_banner_pop_ <= 0.0f) {
         return;
     }
-
-    std::vector<entt::id_type> alive_entities;
-    alive_entities.reserve(registry_.storage<entt::entity>().size());
-
-    registry_.view<game::component::StatsComponent, engine::component::TransformComponent>().each([&](auto entity, const auto& stats, const auto& transform) {
-        const auto entity_id = static_cast<entt::id_type>(entity);
-        alive_entities.push_back(entity_id);
-
-        auto [it, inserted] = health_bar_widgets_.try_emplace(entity_id);
-        auto& widget = it->second;
-        if (inserted || !widget.container_) {
-            auto container = std::unique_ptr<engine::ui::UIPanel>(new engine::ui::UIPanel(context_));
-            container->setId(entity_id);
-            container->setSize({ 48.0f, 6.0f });
-            container->setBackgroundColor({ 0.08f, 0.08f, 0.08f, 0.95f });
-            container->setBorderColor({ 0.0f, 0.0f, 0.0f, 0.85f });
-            container->setBorderWidth(1.0f);
-
-            auto fill = std::unique_ptr<engine::ui::UIPanel>(new engine::ui::UIPanel(context_));
-            fill->setPosition({ 1.0f, 1.0f });
-            fill->setSize({ 46.0f, 4.0f });
-            fill->setBackgroundColor({ 0.2f, 0.8f, 0.2f, 1.0f });
-            widget.fill_ = fill.get();
-            container->addChild(std::move(fill));
-
-            widget.container_ = container.get();
-            health_bar_layer_->addChild(std::move(container));
-        }
-
-        const float hp_ratio = stats.max_hp_ > 0.0f ? std::clamp(stats.hp_ / stats.max_hp_, 0.0f, 1.0f) : 0.0f;
-        const glm::vec2 screen_pos = context_.getCamera().worldToScreen(transform.position_ + glm::vec2(-24.0f, 28.0f));
-        widget.container_->setPosition(screen_pos);
-
-        if (widget.fill_) {
-            widget.fill_->setSize({ 46.0f * hp_ratio, 4.0f });
-            if (hp_ratio > 0.66f) {
-                widget.fill_->setBackgroundColor({ 0.18f, 0.78f, 0.18f, 1.0f });
-            } else if (hp_ratio > 0.33f) {
-                widget.fill_->setBackgroundColor({ 0.92f, 0.72f, 0.12f, 1.0f });
-            } else {
-                widget.fill_->setBackgroundColor({ 0.92f, 0.18f, 0.18f, 1.0f });
-            }
-        }
-
-        widget.container_->setVisible(true);
-    });
-
-    std::vector<entt::id_type> to_remove;
-    for (const auto& [entity_id, widget] : health_bar_widgets_) {
-        if (std::find(alive_entities.begin(), alive_entities.end(), entity_id) == alive_entities.end()) {
-            if (health_bar_layer_) {
-                health_bar_layer_->removeChildById(entity_id);
-            }
-            to_remove.push_back(entity_id);
-        }
-    }
-
-    for (auto entity_id : to_remove) {
-        health_bar_widgets_.erase(entity_id);
-    }
+    constexpr float POP_SECONDS = 0.3f;
+    constexpr float POP_EXTRA_SCALE = 0.8f;     ///< 出现时放大到 1.8 倍，缓动回到原字号
+    wave_banner_pop_ = std::max(0.0f, wave_banner_pop_ - delta_time / POP_SECONDS);
+    wave_banner_text_->setScale(1.0f + POP_EXTRA_SCALE * wave_banner_pop_ * wave_banner_pop_);
 }
 
-void GameScene::updateUi(float delta_time) {
-    updateHealthBars();
+void GameScene::updateUi() {
+    const bool throttle_health_bars = context_.getFrameBudget().isReduced(engine::core::QualityStep::THROTTLE_HEALTH_BARS);
+    if (isRateDue(health_bar_rate_, health_bar_tick_) &&
+        (!throttle_health_bars || health_bar_frame_++ % game::defs::HEALTH_BAR_THROTTLE_FRAMES == 0)) {
+        ENGINE_PROFILE_SCOPE("HealthBarSystem");
+        health_bar_system_->update();
+    }
 
     const auto wheel_delta = context_.getInputManager().getMouseWheelDelta();
-    if (unit_panel_ && wheel_delta.y != 0.0f && unit_panel_->containsPoint(context_.getInputManager().getLogicalMousePosition())) {
-        const float next_scroll = std::clamp(unit_panel_scroll_x_ - wheel_delta.y * 28.0f, 0.0f, unit_panel_max_scroll_x_);
-        if (next_scroll != unit_panel_scroll_x_) {
-            unit_panel_scroll_x_ = next_scroll;
-            createUnitsPortraitUI();
+    const auto mouse_position = context_.getInputManager().getLogicalMousePosition();
+    const bool over_unit_panel = unit_panel_ && unit_panel_->containsPoint(mouse_position);
+    if (wheel_delta.y != 0.0f && !over_unit_panel) {
+        // 面板外滚动缩放相机，鼠标下的世界位置保持不动
+        auto& camera = context_.getCamera();
+        camera.setZoom(camera.getZoom() * std::pow(game::defs::CAMERA_ZOOM_STEP, wheel_delta.y), mouse_position);
+    }
+    if (units_portrait_ui_) {
+        if (wheel_delta.y != 0.0f && over_unit_panel) {
+            units_portrait_ui_->scrollBy(-wheel_delta.y * 28.0f);
         }
-    }
-
-    const int current_unit_panel_cost = static_cast<int>(game_stats_.cost_);
-    if (unit_panel_ && current_unit_panel_cost != last_unit_panel_cost_) {
-        last_unit_panel_cost_ = current_unit_panel_cost;
-        createUnitsPortraitUI();
+        // 只翻转可负担状态变化的槽位，不重建控件
+        units_portrait_ui_->setCost(static_cast<int>(game_stats_.cost_));
     }
 
     refreshHudText();
-
-    if (wave_banner_text_ && wave_banner_text_->isVisible()) {
-        if (wave_banner_timer_ > 0.0f) {
-            wave_banner_timer_ -= delta_time;
-        }
-        if (wave_banner_timer_ <= 0.0f) {
-            wave_banner_text_->setVisible(false);
-        }
-    }
 }
 
 void GameScene::refreshHudText() {
-    if (!hud_text_) {
+    if (!hud_bindings_) {
         return;
     }
 
-    std::string state_text = "Playing";
+    auto state = game::ui::HudState::PLAYING;
     if (context_.getGameState().isPaused()) {
-        state_text = "Paused";
+        state = game::ui::HudState::PAUSED;
     } else if (context_.getGameState().isGameOver()) {
-        state_text = "Game Over";
+        state = game::ui::HudState::GAME_OVER;
     }
 
-    hud_text_->setText(
-        current_level_name_ +
-        " | " +
-        "Wave " + std::to_string(current_wave_) +
-        " | HP " + std::to_string(game_stats_.home_hp_) +
-        " | " + state_text +
-        (selected_unit_name_.empty() ? std::string{} : (" | Selected " + selected_unit_name_))
-    );
-
-    if (gold_text_) {
-        gold_text_->setText("Gold " + std::to_string(static_cast<int>(game_stats_.cost_)));
-    }
+    // 每帧只采样整数：未变化的项不会格式化，也不会触碰 UIText
+    hud_bindings_->publish(static_cast<int>(game_stats_.cost_), game_stats_.home_hp_, current_wave_, state, selected_unit_id_);
 }
 
 void GameScene::setPauseOverlayVisible(bool visible) {
@@ -838,6 +1464,10 @@ bool GameScene::togglePause() {
     if (context_.getGameState().isGameOver()) {
         return false;
     }
+    if (lockstep_) {
+        ENGINE_LOG_INFO("联机对局不能暂停");
+        return false;
+    }
 
     const bool should_pause = !context_.getGameState().isPaused();
     context_.getGameState().setState(should_pause ? engine::core::GameStateType::Paused
@@ -861,6 +1491,7 @@ void GameScene::onEnemyArriveHome(const game::defs::EnemyArriveHomeEvent&) {
         context_.getResourceManager().playMusic(entt::hashed_string("lose").value());
         context_.getGameState().setState(engine::core::GameStateType::GameOver);
         ENGINE_LOG_WARN("基地生命耗尽，游戏结束");
+        endless_.finishCycle(engine::ecs::RegistrySnapshot<>::getStorageBytes(registry_), true);
     }
 }
 
@@ -889,7 +1520,18 @@ void GameScene::onSpawnEffectVisual(const game::defs::SpawnEffectVisualEvent& ev
     if (!target_transform) {
         return;
     }
+    // 帧预算降级只抽掉纯表现的特效（死亡、治疗等命中反馈）；升级与技能就绪/释放提示玩家操作，始终生成
+    const auto effect = game::ids::fromHash<game::ids::Effect>(event.effect_id_);
+    const bool gameplay_cue = effect == game::ids::Effect::LEVEL_UP || effect == game::ids::Effect::SKILL_READY ||
+                              effect == game::ids::Effect::SKILL_ACTIVE;
+    if (!gameplay_cue && context_.getFrameBudget().isReduced(engine::core::QualityStep::REDUCED_EFFECTS) &&
+        effect_spawn_count_++ % game::defs::REDUCED_EFFECT_STRIDE != 0) {
+        return;
+    }
 
+    if (effect_particle_system_ && effect_particle_system_->spawn(event.effect_id_, target_transform->position_)) {
+        return;
+    }
     entity_factory_->createEffectVisual(event.effect_id_, target_transform->position_);
 }
 
@@ -899,7 +1541,7 @@ void GameScene::onRemoveUIPortrait(const game::defs::RemoveUIPortraitEvent& even
     }
     selected_unit_id_ = 0;
     selected_unit_name_.clear();
-    if (unit_panel_) {
+    if (units_portrait_ui_) {
         createUnitsPortraitUI();
     }
 }
@@ -917,10 +1559,39 @@ void GameScene::onUIPortraitHoverLeave(const game::defs::UIPortraitHoverLeaveEve
 }
 
 void GameScene::onRestartRequested(const game::defs::RestartEvent&) {
+    if (lockstep_) {
+        ENGINE_LOG_WARN("联机对局不能重开");
+        return;
+    }
+    if (!checkpoints_.empty() && checkpoints_.front()) {
+        ENGINE_LOG_INFO("收到重开请求，恢复关卡初始检查点");
+        pending_rewind_wave_ = 0;
+        return;
+    }
     ENGINE_LOG_INFO("收到重开请求，重新构建 GameScene");
     requestReplaceScene(std::unique_ptr<engine::scene::Scene>(new game::scene::GameScene(context_, selected_level_index_)));
 }
 
+void GameScene::onRetryWaveRequested(const game::defs::RetryWaveEvent&) {
+    if (lockstep_) {
+        ENGINE_LOG_WARN("联机对局不能重试波次");
+        return;
+    }
+    // 波次间歇期间重试的是刚结束的那一波
+    const int wave = std::max(current_wave_, 0);
+    ENGINE_LOG_INFO("收到重试波次请求: wave={}", wave);
+    pending_rewind_wave_ = wave;
+}
+
+void GameScene::onRewindToWaveRequested(const game::defs::RewindToWaveEvent& event) {
+    if (lockstep_) {
+        ENGINE_LOG_WARN("联机对局不能回退");
+        return;
+    }
+    ENGINE_LOG_INFO("收到回退请求: wave={}", event.wave_);
+    pending_rewind_wave_ = event.wave_;
+}
+
 void GameScene::onBackToTitleRequested(const game::defs::BackToTitleEvent&) {
     ENGINE_LOG_INFO("收到回标题请求");
     requestReplaceScene(std::unique_ptr<engine::scene::Scene>(new game::scene::TitleScene(context_)));
@@ -931,70 +1602,320 @@ void GameScene::onSaveRequested(const game::defs::SaveEvent&) {
         return;
     }
 
-    nlohmann::json json_data;
-    json_data["level"] = static_cast<int>(selected_level_index_) + 1;
-    json_data["point"] = static_cast<int>(game_stats_.cost_);
-    json_data["level_clear"] = false;
-
-    auto& unit_json = json_data["unit"];
-    for (const auto& [name_id, unit] : session_data_->getUnitMap()) {
-        unit_json[unit.name_]["class"] = unit.class_name_;
-        unit_json[unit.name_]["level"] = unit.level_;
-        unit_json[unit.name_]["rarity"] = unit.rarity_;
-    }
-
-    const std::string save_path = "assets/save/SLOT_1.json";
-    const std::string payload = json_data.dump(4);
-    pending_save_tasks_.push_back(PendingSaveTask{
-        save_path,
-        std::async(std::launch::async, [save_path, payload]() -> bool {
-        try {
-            std::ofstream out_file(save_path);
-            if (!out_file.is_open()) {
-                ENGINE_LOG_ERROR("保存失败，无法写入文件: {}", save_path);
-                return false;
-            }
+    auto payload = session_data_->encodeSave(static_cast<int>(selected_level_index_) + 1, static_cast<int>(game_stats_.cost_), false);
+    engine::io::SaveService::instance().submit(save_path_, game::data::SESSION_SAVE_KIND, game::data::SESSION_SAVE_SCHEMA, std::move(payload));
+    ENGINE_LOG_INFO("已提交保存: {}", save_path_);
+}
 
-            out_file << payload;
-            if (!out_file.good()) {
-                ENGINE_LOG_ERROR("保存失败，写入文件异常: {}", save_path);
-                return false;
-            }
-            return true;
+void GameScene::onSaveCompleted(const engine::io::SaveCompletedEvent& event) {
+    const auto hash = [](const std::string& path) { return entt::hashed_string::value(path.c_str(), path.size()); };
+    if (event.path_hash_ == hash(save_path_)) {
+        if (event.ok_) {
+            ENGINE_LOG_INFO("保存完成: {}", save_path_);
+        } else {
+            ENGINE_LOG_ERROR("保存失败: {}", save_path_);
         }
-        catch (const std::exception& e) {
-            ENGINE_LOG_ERROR("保存任务异常: {} ({})", save_path, e.what());
-            return false;
+    } else if (event.path_hash_ == hash(autosave_path_) && !event.ok_) {
+        ENGINE_LOG_WARN("自动存档写入失败，下一波开始时重试: {}", autosave_path_);
+    }
+}
+
+void GameScene::autosaveBattle() {
+    ENGINE_PROFILE_SCOPE("GameScene::autosaveBattle");
+    game::data::BattleSnapshotHeader header;
+    header.level_index_ = static_cast<std::uint32_t>(selected_level_index_);
+    header.wave_ = current_wave_;
+    header.tick_ = context_.getTime().getSimulationTick();
+    header.stats_ = game_stats_;
+    auto payload = game::data::captureBattleSnapshot(registry_, header, last_autosave_size_);
+    last_autosave_size_ = payload.size();
+    engine::io::SaveService::instance().submit(autosave_path_, game::data::BATTLE_SAVE_KIND, game::data::BATTLE_SAVE_SCHEMA, std::move(payload));
+}
+
+void GameScene::captureCheckpoint(int wave) {
+    ENGINE_PROFILE_SCOPE("GameScene::captureCheckpoint");
+    const auto start = std::chrono::steady_clock::now();
+    const auto index = static_cast<std::size_t>(wave);
+    if (checkpoints_.size() <= index) {
+        checkpoints_.resize(index + 1);
+    }
+    auto& checkpoint = checkpoints_[index];
+    if (!checkpoint) {
+        checkpoint = std::make_unique<BattleCheckpoint>();
+        // 每个检查点只检查一次：漏掉的组件类型在恢复后会丢失
+        for (const auto name : game::data::BattleRegistrySnapshot::findUncovered(registry_)) {
+            ENGINE_LOG_WARN("检查点未覆盖组件类型 {}，恢复后该组件会丢失", name);
         }
-        })
-    });
-    ENGINE_LOG_INFO("已提交异步保存任务: {}", save_path);
+    }
+
+    checkpoint->registry_.capture(registry_);
+    if (const auto* random = registry_.ctx().find<engine::utils::RandomService>()) {
+        checkpoint->random_ = *random;
+    }
+    if (const auto* timers = registry_.ctx().find<engine::core::TimerWheel>()) {
+        checkpoint->timers_ = *timers;
+    }
+    if (const auto* effects = registry_.ctx().find<game::data::StatusEffectStore>()) {
+        checkpoint->status_effects_ = *effects;
+    }
+    if (const auto* flow_field = registry_.ctx().find<engine::spatial::FlowField>(); flow_field && flow_field->isBuilt()) {
+        checkpoint->flow_field_ = *flow_field;
+    }
+    checkpoint->stats_ = game_stats_;
+    checkpoint->hidden_unit_portrait_ids_ = hidden_unit_portrait_ids_;
+    checkpoint->wave_spawner_ = wave_spawner_;
+    checkpoint->wave_timer_ = wave_timer_;
+    checkpoint->wave_banner_timer_ = wave_banner_timer_;
+    checkpoint->wave_break_duration_ = wave_break_duration_;
+    checkpoint->spawn_sequence_ = entity_factory_->getSpawnSequence();
+    checkpoint->current_wave_ = current_wave_;
+    checkpoint->base_hp_ = base_hp_;
+    checkpoint->wave_running_ = wave_running_;
+
+    const float elapsed_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    registry_.ctx().insert_or_assign(game::data::CheckpointInfo{
+        static_cast<int>(checkpoints_.size()) - 1,
+        checkpoint->registry_.getEntityCount(),
+        checkpoint->registry_.getComponentCount(),
+        elapsed_ms });
+    ENGINE_LOG_DEBUG("检查点 wave={} 已记录: {} 实体, {} 组件, {:.2f} ms", wave,
+        checkpoint->registry_.getEntityCount(), checkpoint->registry_.getComponentCount(), elapsed_ms);
+}
+
+void GameScene::restoreCheckpoint(int wave) {
+    const auto index = static_cast<std::size_t>(wave);
+    if (wave < 0 || index >= checkpoints_.size() || !checkpoints_[index]) {
+        ENGINE_LOG_WARN("没有第 {} 波的检查点，忽略回退请求", wave);
+        return;
+    }
+    ENGINE_PROFILE_SCOPE("GameScene::restoreCheckpoint");
+    const auto& checkpoint = *checkpoints_[index];
+
+    // 排队中的事件与批量事件引用的是回退前的实体，一并丢弃（场景切换走 trigger，不受影响）
+    context_.getDispatcher().clear();
+    event_queues_.clear();
+    if (auto* projectiles = registry_.ctx().find<game::data::ProjectilePool>()) {
+        projectiles->clear();   // 飞行中的投射物同样引用回退前的实体；其视觉实体按飞行时间自行停用
+    }
+    if (effect_particle_system_) {
+        effect_particle_system_->clear();
+    }
+    damage_number_system_->clear();
+
+    checkpoint.registry_.restore(registry_);
+    if (level_loader_) {
+        // 恢复出的是存档时驻留的区块，按当前视野重新载入
+        level_loader_->resetStreaming();
+        updateTileStreaming();
+    }
+    enemy_counter_.recount(registry_);
+    if (checkpoint.random_) {
+        registry_.ctx().insert_or_assign(*checkpoint.random_);
+    }
+    if (checkpoint.timers_) {
+        registry_.ctx().insert_or_assign(*checkpoint.timers_);
+    }
+    if (checkpoint.status_effects_) {
+        registry_.ctx().insert_or_assign(*checkpoint.status_effects_);
+    }
+    if (checkpoint.flow_field_) {
+        registry_.ctx().insert_or_assign(*checkpoint.flow_field_);
+    }
+    if (auto* selection = registry_.ctx().find<game::data::SelectionState>()) {
+        *selection = game::data::SelectionState{};
+    }
+    if (auto* injuries = registry_.ctx().find<game::data::InjuryQueue>()) {
+        injuries->rebuild(registry_);
+    }
+    entity_factory_->onRegistryRestored();
+    entity_factory_->setSpawnSequence(checkpoint.spawn_sequence_);
+    set_target_system_->resetAcquireSchedule();
+    spatial_index_system_->update(registry_);      // 网格与位置缓存立即对应恢复后的实体（暂停时也不会留着回退前的）
+    if (place_unit_system_) {
+        place_unit_system_->cancelPrep();
+    }
+
+    game_stats_ = checkpoint.stats_;
+    hidden_unit_portrait_ids_ = checkpoint.hidden_unit_portrait_ids_;
+    wave_spawner_ = checkpoint.wave_spawner_;
+    wave_timer_ = checkpoint.wave_timer_;
+    wave_banner_timer_ = checkpoint.wave_banner_timer_;
+    auto& timers = registry_.ctx().get<engine::core::TimerWheel>();
+    if (!checkpoint.wave_running_ && !timers.isPending(checkpoint.wave_timer_)) {
+        // 波次检查点在波次间隔到期、开战之前拍下，恢复后下一步即开始该波
+        wave_timer_ = timers.scheduleAfter(1, entt::null, game::defs::timer_event::WAVE_BREAK);
+    }
+    wave_break_duration_ = checkpoint.wave_break_duration_;
+    current_wave_ = checkpoint.current_wave_;
+    base_hp_ = checkpoint.base_hp_;
+    wave_running_ = checkpoint.wave_running_;
+    if (endless_.isActive()) {
+        // 回退前这一轮的统计作废；下一波开启新一轮时由 startNextWave 开始统计，否则从恢复点续计本轮
+        endless_.discardCycle();
+        if (const int next_wave = current_wave_ + 1; !endless_.isCycleStart(next_wave)) {
+            const int cycle = endless_.cycleOf(next_wave);
+            endless_.beginCycle(cycle, endless_.enemyLevel(enemy_level_, cycle), endless_.enemyRarity(enemy_rarity_, cycle),
+                                engine::ecs::RegistrySnapshot<>::getStorageBytes(registry_));
+        }
+    }
+    streamWaveResources();
+    selected_unit_id_ = 0;
+    selected_unit_name_.clear();
+
+    // 回到初始状态时随机流也回到初始，重新开始录制仍可重放；中途检查点之前的指令已不在日志中
+    if (wave == 0 && checkpoint.random_) {
+        replay_recorder_->save(replay_path_);
+        replay_recorder_->begin(checkpoint.random_->getSeed(), static_cast<std::uint32_t>(selected_level_index_), context_.getTime().getFixedDeltaTime());
+    } else {
+        replay_recorder_->discard();
+    }
+
+    context_.getGameState().setState(engine::core::GameStateType::Playing);
+    setPauseOverlayVisible(false);
+    if (wave_banner_text_) {
+        wave_banner_text_->setVisible(false);
+    }
+    if (units_portrait_ui_) {
+        createUnitsPortraitUI();
+    }
+    refreshHudText();
+    ENGINE_LOG_INFO("已恢复检查点 wave={}：{} 实体", wave, checkpoint.registry_.getEntityCount());
 }
 
 void GameScene::onLevelClearRequested(const game::defs::LevelClearEvent&) {
+    if (endless_.isActive()) {
+        ENGINE_LOG_INFO("无尽模式没有通关，忽略通关请求");
+        return;
+    }
     ENGINE_LOG_INFO("收到通关请求，推入通关覆盖层: level={}", selected_level_index_ + 1);
     requestPushScene(std::unique_ptr<engine::scene::Scene>(new game::scene::LevelClearScene(context_, selected_level_index_)));
 }
 
+void GameScene::onPlaceUnitRequested(const game::defs::PlaceUnitRequestEvent& event) {
+    if (!lockstep_) {
+        return;
+    }
+    game::sim::ReplayCommand command;
+    command.type_ = game::sim::ReplayCommandType::PLACE_UNIT;
+    command.class_id_ = event.class_id_;
+    command.position_ = event.position_;
+    command.level_ = event.level_;
+    command.rarity_ = event.rarity_;
+    command.cost_ = event.cost_;
+    const auto tick = lockstep_->submit(command);
+    ENGINE_LOG_DEBUG("锁步联机: 放置指令将在第 {} 步执行", tick);
+}
+
+// --- 锁步联机 ---
+int GameScene::pollLockstep(int steps) {
+    lockstep_->poll();
+    if (lockstep_->isPeerLost()) {
+        // 对方的后续指令已不可能到达：本地按已执行的状态继续单人进行
+        ENGINE_LOG_WARN("锁步联机: 对方已掉线（第 {} 步），转为单人继续", lockstep_->getNextTick());
+        lockstep_.reset();
+        place_unit_system_->setDeferredPlacement(false);
+        return steps;
+    }
+    if (const auto desync_tick = lockstep_->getDesyncTick(); desync_tick && !lockstep_desync_reported_) {
+        lockstep_desync_reported_ = true;
+        ENGINE_LOG_ERROR("锁步联机: 两端状态自第 {} 步起不一致（{}），对局结果不再可信",
+            *desync_tick, game::sim::describeChecksumDiff(lockstep_->getDesyncComponents()));
+    }
+    // 落后对方时多跑一步追上，否则两端会长期以较慢一方的帧率步进
+    const int wanted = steps + (steps > 0 && lockstep_->getPeerLead() > 0 ? 1 : 0);
+    const auto ready = lockstep_->getReadySteps();
+    ENGINE_PROFILE_COUNTER("lockstep.peer_lead", lockstep_->getPeerLead());
+    return static_cast<int>(std::min<std::uint64_t>(static_cast<std::uint64_t>(wanted), ready));
+}
+
+void GameScene::applyLockstepCommands() {
+    lockstep_commands_.clear();
+    lockstep_->takeStepCommands(lockstep_commands_);
+    auto& dispatcher = context_.getDispatcher();
+    for (const auto& command : lockstep_commands_) {
+        const auto unit = command.unit_ < lockstep_units_.size() ? lockstep_units_[command.unit_] : entt::entity{ entt::null };
+        switch (command.type_) {
+        case game::sim::ReplayCommandType::SET_DELTA_TIME:
+        case game::sim::ReplayCommandType::CHECKSUM:
+            break;      // 联机使用握手时约定的固定步长；校验值不随指令发送
+        case game::sim::ReplayCommandType::PLACE_UNIT: {
+            // 两端在同一步、以同样的顺序执行，同一建造位或金币被双方同时争用时结果也一致
+            const auto entity = place_unit_system_->placeUnitAt(command.class_id_, command.position_, command.cost_, command.level_, command.rarity_);
+            if (entity != entt::null) {
+                lockstep_units_.push_back(entity);
+            }
+            break;
+        }
+        case game::sim::ReplayCommandType::UPGRADE_UNIT:
+            dispatcher.enqueue(game::defs::UpgradeUnitEvent{ unit, command.cost_ });
+            break;
+        case game::sim::ReplayCommandType::RETREAT_UNIT:
+            dispatcher.enqueue(game::defs::RetreatEvent{ unit, command.cost_ });
+            break;
+        case game::sim::ReplayCommandType::RELEASE_SKILL:
+            dispatcher.enqueue(game::defs::ReleaseHeroSkillEvent{ unit });
+            break;
+        }
+    }
+}
+
+void GameScene::endLockstepStep() {
+    lockstep_->endStep();
+    if (lockstep_->isChecksumTick()) {
+        lockstep_->recordChecksum(game::sim::computeStateChecksum(registry_, game_stats_));
+    }
+}
+
+bool GameScene::issueUnitCommand(game::sim::ReplayCommandType type, entt::entity entity, int cost) {
+    auto& dispatcher = context_.getDispatcher();
+    if (!lockstep_) {
+        switch (type) {
+        case game::sim::ReplayCommandType::UPGRADE_UNIT:
+            dispatcher.enqueue(game::defs::UpgradeUnitEvent{ entity, cost });
+            return true;
+        case game::sim::ReplayCommandType::RETREAT_UNIT:
+            dispatcher.enqueue(game::defs::RetreatEvent{ entity, cost });
+            return true;
+        case game::sim::ReplayCommandType::RELEASE_SKILL:
+            dispatcher.enqueue(game::defs::ReleaseHeroSkillEvent{ entity });
+            return true;
+        default:
+            return false;
+        }
+    }
+    const auto it = std::ranges::find(lockstep_units_, entity);
+    if (it == lockstep_units_.end()) {
+        ENGINE_LOG_WARN("锁步联机: 单位 {} 不是经指令放置的，忽略操作", entt::to_integral(entity));
+        return false;
+    }
+    game::sim::ReplayCommand command;
+    command.type_ = type;
+    command.unit_ = static_cast<std::uint32_t>(it - lockstep_units_.begin());
+    command.cost_ = cost;
+    lockstep_->submit(command);
+    return true;
+}
+
 // --- 测试函数 ---
 void GameScene::createTestEnemy() {
     startNextWave();
 }
 
 bool GameScene::onCreateTestPlayerMelee() {
-    return tryCreateTestPlayerUnit("warrior"_hs, "战士", true);
+    return tryCreateTestPlayerUnit(game::defs::class_id::WARRIOR, "战士", true);
 }
 
 bool GameScene::onCreateTestPlayerRanged() {
-    return tryCreateTestPlayerUnit("archer"_hs, "弓箭手", true);
+    return tryCreateTestPlayerUnit(game::defs::class_id::ARCHER, "弓箭手", true);
 }
 
 bool GameScene::onCreateTestPlayerHealer() {
-    return tryCreateTestPlayerUnit("witch"_hs, "治疗者", false);
+    return tryCreateTestPlayerUnit(game::defs::class_id::WITCH, "治疗者", false);
 }
 
 bool GameScene::tryCreateTestPlayerUnit(entt::id_type class_id, const char* log_name, bool injured) {
-    if (!context_.getGameState().isPlaying() || !entity_factory_) {
+    // 测试单位不经过指令，联机时会使两端失步
+    if (!context_.getGameState().isPlaying() || !entity_factory_ || lockstep_) {
         return false;
     }
 
@@ -1017,8 +1938,9 @@ bool GameScene::tryCreateTestPlayerUnit(entt::id_type class_id, const char* log_
 
     if (injured) {
         if (auto* stats = registry_.try_get<game::component::StatsComponent>(entity)) {
-            stats->hp_ = stats->max_hp_ / 2.0f;
-            registry_.emplace<game::defs::InjuredTag>(entity);
+            registry_.patch<game::component::StatsComponent>(entity, [](auto& value) { value.hp_ = value.max_hp_ / 2.0f; });
+            registry_.get<game::component::BehaviorComponent>(entity).setFlag(game::component::behavior_flag::INJURED, true);
+            registry_.ctx().get<game::data::InjuryQueue>().update(entity, 0.5f);
         }
     }
 
@@ -1056,8 +1978,7 @@ bool GameScene::onUpgradeClosestPlayer() {
     }
 
     const auto& player = registry_.get<game::component::PlayerComponent>(target);
-    context_.getDispatcher().enqueue(game::defs::UpgradeUnitEvent{ target, player.cost_ });
-    return true;
+    return issueUnitCommand(game::sim::ReplayCommandType::UPGRADE_UNIT, target, player.cost_);
 }
 
 bool GameScene::onSellClosestPlayer() {
@@ -1085,7 +2006,9 @@ bool GameScene::onSellClosestPlayer() {
     }
 
     const auto& player = registry_.get<game::component::PlayerComponent>(target);
-    context_.getDispatcher().enqueue(game::defs::RetreatEvent{ target, player.cost_ });
+    if (!issueUnitCommand(game::sim::ReplayCommandType::RETREAT_UNIT, target, player.cost_)) {
+        return false;
+    }
 
     ENGINE_LOG_INFO("撤退单位已触发: entity={}, cost={}", entt::to_integral(target), player.cost_);
     return true;
@@ -1113,14 +2036,16 @@ bool GameScene::onReleaseSelectedHeroSkill() {
         return false;
     }
 
-    context_.getDispatcher().enqueue(game::defs::ReleaseHeroSkillEvent{ selected_unit });
+    if (!issueUnitCommand(game::sim::ReplayCommandType::RELEASE_SKILL, selected_unit, 0)) {
+        return false;
+    }
     ENGINE_LOG_INFO("技能释放热键已触发 entity={}", entt::to_integral(selected_unit));
     return true;
 }
 
 bool GameScene::onClearAllPlayers() {
-    std::vector<entt::entity> entities;
     auto view = registry_.view<game::component::PlayerComponent>();
+    auto entities = context_.getFrameArena().makeVector<entt::entity>(view.size());
     for (auto entity : view) {
         entities.push_back(entity);
     }
@@ -1132,12 +2057,14 @@ bool GameScene::onClearAllPlayers() {
 }
 
 void GameScene::startNextWave() {
+    // 每波一次的检查点、自动存档、资源流送与预留不在逐步的零分配检查范围内
+    const engine::memory::ZeroAllocationSuspend allow_allocation;
+    captureCheckpoint(current_wave_ + 1);
     ++current_wave_;
-    pending_wave_enemies_.clear();
-    pending_wave_index_ = 0;
-    wave_spawn_timer_ = 0.0f;
-    wave_break_timer_ = 0.0f;
     wave_running_ = true;
+    auto& timers = registry_.ctx().get<engine::core::TimerWheel>();
+    timers.cancel(wave_timer_);     // 测试按钮提前开战时，上一个波次间隔还未到期
+    wave_spawner_.cancel(timers);   // 或上一波还有刷怪组未出完
 
     if (level_waves_.empty()) {
         wave_running_ = false;
@@ -1146,23 +2073,45 @@ void GameScene::startNextWave() {
     }
 
     const auto wave_index = (current_wave_ - 1) % level_waves_.size();
-    const auto& wave = level_waves_[wave_index];
-    pending_wave_enemies_ = wave.enemy_queue_;
-    wave_spawn_interval_ = std::max(0.1f, wave.spawn_interval_);
-    wave_break_duration_ = std::max(0.1f, wave.next_wave_interval_);
-
-    game_stats_.enemy_count_ += static_cast<int>(pending_wave_enemies_.size());
-
-    ENGINE_LOG_INFO("{} 第 {} 波开始，共 {} 只敌人", current_level_name_, current_wave_, pending_wave_enemies_.size());
+    const game::data::WaveConfig* wave_config = &level_waves_[wave_index];
+    if (endless_.isActive()) {
+        // 每播放完一遍波次表进入下一轮：上一轮输出汇总，本轮按轮次放大敌人数
+        const int cycle = endless_.cycleOf(current_wave_);
+        if (endless_.isCycleStart(current_wave_)) {
+            const auto storage_bytes = engine::ecs::RegistrySnapshot<>::getStorageBytes(registry_);
+            endless_.finishCycle(storage_bytes, false);
+            endless_.beginCycle(cycle, endless_.enemyLevel(enemy_level_, cycle), endless_.enemyRarity(enemy_rarity_, cycle), storage_bytes);
+        }
+        endless_.recordWave();
+        endless_.scaleWave(*wave_config, cycle, endless_wave_);
+        wave_config = &endless_wave_;
+    } else {
+        entity_factory_->reserveEnemyUnits(wave_config->enemy_count_);   // 无尽模式开局已按人口硬上限预留
+    }
+    const auto& wave = *wave_config;
+    spawn_positions_.reserve(wave.enemy_count_);    // 一组刷怪不超过整波敌人数，刷怪时不再扩容
+    spawn_waypoints_.reserve(wave.enemy_count_);
+    wave_break_duration_ = wave.next_wave_interval_;
+    wave_spawner_.start(wave, timers);
+    streamWaveResources();
+
+    game_stats_.enemy_count_ += static_cast<int>(wave.enemy_count_);
+
+    ENGINE_LOG_INFO_DEFERRED("{} 第 {} 波开始，共 {} 组 {} 只敌人", current_level_name_, current_wave_, wave.groups_.size(), wave.enemy_count_);
     if (wave_banner_text_) {
-        wave_banner_text_->setText("Wave " + std::to_string(current_wave_));
+        wave_banner_text_->setText(endless_.isActive()
+            ? std::format("Wave {} · 第 {} 轮", current_wave_, endless_.cycleOf(current_wave_) + 1)
+            : "Wave " + std::to_string(current_wave_));
         wave_banner_text_->setVisible(true);
-        wave_banner_timer_ = 2.0f;
+        wave_banner_pop_ = 1.0f;
+        timers.cancel(wave_banner_timer_);
+        wave_banner_timer_ = timers.scheduleAfter(timers.ticksFor(2.0f), entt::null, game::defs::timer_event::WAVE_BANNER);
     }
     refreshHudText();
+    autosaveBattle();
 }
 
-void GameScene::updateWaveFlow(float delta_time) {
+void GameScene::updateWaveFlow() {
     if (start_points_.empty() || !entity_factory_) {
         return;
     }
@@ -1171,44 +2120,127 @@ void GameScene::updateWaveFlow(float delta_time) {
         return;
     }
 
-    if (!wave_running_) {
-        wave_break_timer_ += delta_time;
-        if (wave_break_timer_ >= wave_break_duration_ ) {
+    // 计时器只在到期的那一步出现在列表中；startNextWave 登记的新计时器不会影响正在遍历的到期列表
+    auto& timers = registry_.ctx().get<engine::core::TimerWheel>();
+    for (const auto& expiry : timers.getExpired()) {
+        switch (expiry.event_) {
+        case game::defs::timer_event::WAVE_BREAK:
             startNextWave();
+            break;
+        case game::defs::timer_event::WAVE_SPAWN:
+            if (const auto batch = wave_spawner_.onTimer(expiry, timers)) {
+                spawnEnemies(*batch);
+            }
+            break;
+        case game::defs::timer_event::WAVE_BANNER:
+            if (wave_banner_text_) {
+                wave_banner_text_->setVisible(false);
+            }
+            break;
+        default:
+            break;
         }
-        return;
     }
 
-    if (pending_wave_index_ < pending_wave_enemies_.size()) {
-        wave_spawn_timer_ += delta_time;
-        if (wave_spawn_timer_ >= wave_spawn_interval_) {
-            wave_spawn_timer_ = 0.0f;
-            spawnNextEnemy();
-        }
+    if (!wave_running_ || wave_spawner_.isSpawning()) {
         return;
     }
-
-    const auto enemy_count = registry_.view<game::component::EnemyComponent>().size();
-    if (enemy_count == 0) {
+    if (enemy_counter_.get() == 0) {
+        // 波次间隔的计时、资源流送与存储整理每波一次，不在零分配检查范围内
+        const engine::memory::ZeroAllocationSuspend allow_allocation;
         wave_running_ = false;
-        wave_break_timer_ = 0.0f;
-        ENGINE_LOG_INFO("第 {} 波已清空，准备下一波", current_wave_);
+        wave_timer_ = timers.scheduleAfter(timers.ticksFor(wave_break_duration_), entt::null, game::defs::timer_event::WAVE_BREAK);
+        ENGINE_LOG_INFO_DEFERRED("第 {} 波已清空，准备下一波", current_wave_);
+        streamWaveResources();
+        compactStorages();
+    }
+}
+
+void GameScene::compactStorages() {
+    // 收缩前记下峰值容量，下一个战斗场景仍按峰值预留
+    if (capacity_hints_) {
+        capacity_hints_->record(registry_);
     }
+    // 无尽模式逐轮放大敌人数，后续需求无法按波次表估算，只重排不收缩
+    const auto headroom = game::factory::CapacityPlanner::upcomingEnemies(level_waves_, static_cast<std::size_t>(current_wave_));
+    game::data::compactBattleStorages(registry_, headroom, !endless_.isActive());
 }
 
-void GameScene::spawnNextEnemy() {
-    if (pending_wave_index_ >= pending_wave_enemies_.size() || start_points_.empty()) {
+void GameScene::streamWaveResources() {
+    if (!wave_resources_ || level_waves_.empty()) {
         return;
     }
+    // 第 current_wave_ 波（从 1 开始）对应波次表下标 current_wave_ - 1，波次表按无尽模式循环
+    if (wave_running_ && current_wave_ > 0) {
+        wave_resources_->retainOnly(static_cast<std::size_t>(current_wave_ - 1));
+    } else {
+        wave_resources_->stream(static_cast<std::size_t>(current_wave_));
+    }
+}
 
-    const auto class_id = pending_wave_enemies_[pending_wave_index_++];
-    const auto start_index = start_points_[(current_wave_ + pending_wave_index_) % start_points_.size()];
-    const auto position = waypoint_nodes_.at(start_index).position_;
+void GameScene::spawnEnemies(const game::data::SpawnBatch& batch) {
+    if (start_points_.empty()) {
+        return;
+    }
 
-    auto entity = entity_factory_->createEnemyUnit(class_id, position, start_index, enemy_level_, enemy_rarity_);
-    if (entity == entt::null) {
-        ENGINE_LOG_ERROR("敌人生成失败: {}", class_id);
+    int level = enemy_level_;
+    int rarity = enemy_rarity_;
+    // 无尽模式：按轮次提升等级与稀有度，超出人口上限的部分合并为精英或并入在场敌人
+    game::data::EndlessSpawnPlan plan;
+    plan.normal_ = batch.count_;
+    if (endless_.isActive()) {
+        const int cycle = endless_.cycleOf(current_wave_);
+        level = endless_.enemyLevel(enemy_level_, cycle);
+        rarity = endless_.enemyRarity(enemy_rarity_, cycle);
+        plan = endless_.planSpawn(batch.count_, enemy_counter_.get());
+    }
+
+    spawn_positions_.clear();
+    spawn_waypoints_.clear();
+    for (std::size_t i = 0; i < plan.entityCount(); ++i) {
+        const auto start_index = start_points_[batch.startSlot(i, current_wave_, start_points_.size())];
+        spawn_positions_.push_back(waypoint_nodes_.at(start_index).position_);
+        spawn_waypoints_.push_back(start_index);
+    }
+    std::span<const entt::entity> created;      // 指向工厂的批量缓冲，本函数内不再批量创建
+    if (!spawn_positions_.empty()) {
+        created = entity_factory_->createEnemyUnits(batch.class_id_, spawn_positions_, spawn_waypoints_, level, rarity);
+        if (created.empty()) {
+            ENGINE_LOG_ERROR("敌人生成失败: {}", batch.class_id_);
+        }
+    }
+    if (!endless_.isActive()) {
+        return;
+    }
+
+    // 照常生成的之后依次是精英：每只并入同批 merge_factor_ - 1 只，最后一只并入余数
+    std::size_t merged = plan.merged_;
+    for (std::size_t i = plan.normal_; i < created.size(); ++i) {
+        const auto weight = std::min(merged, plan.merge_factor_);
+        merged -= weight;
+        entity_factory_->absorbEnemies(created[i], batch.class_id_, weight - 1, level, rarity);
+    }
+    if (plan.absorbed_ > 0) {
+        const auto target = !created.empty() ? created.back() : findAbsorbTarget();
+        if (target == entt::null || !entity_factory_->absorbEnemies(target, batch.class_id_, plan.absorbed_, level, rarity)) {
+            ENGINE_LOG_WARN("无尽模式：没有可并入的敌人，丢弃 {} 只 {}", plan.absorbed_, batch.class_id_);
+        }
+    }
+    // 合并掉的敌人不会单独被击杀或到达基地，从本局敌人总数中扣除
+    game_stats_.enemy_count_ -= static_cast<int>(batch.count_ - created.size());
+    endless_.recordSpawn(plan);
+}
+
+entt::entity GameScene::findAbsorbTarget() const {
+    entt::entity target = entt::null;
+    float farthest = -1.0f;
+    for (const auto [entity, enemy] : registry_.view<game::component::EnemyComponent>(entt::exclude<game::defs::DeadTag>).each()) {
+        if (enemy.distance_to_home_ > farthest) {
+            farthest = enemy.distance_to_home_;
+            target = entity;
+        }
     }
+    return target;
 }
 
 int GameScene::getUnitCost(entt::id_type class_id, int rarity) const {
@@ -1227,7 +2259,7 @@ bool GameScene::trySpendGold(int amount) {
         return false;
     }
     game_stats_.cost_ -= static_cast<float>(amount);
-    ENGINE_LOG_INFO("消耗金币 {}，当前金币: {}", amount, static_cast<int>(game_stats_.cost_));
+    ENGINE_LOG_INFO_DEFERRED("消耗金币 {}，当前金币: {}", amount, static_cast<int>(game_stats_.cost_));
     return true;
 }
 
@@ -1,14 +1,30 @@
 #pragma once
 #include "../data/waypoint_node.h"
+#include "../data/path_table.h"
 #include "../data/game_stats.h"
+#include "../data/level_config.h"
+#include "../data/wave_spawner.h"
+#include "../data/endless_director.h"
+#include "../data/alive_counter.h"
+#include "../component/enemy_component.h"
+#include "../data/session_telemetry.h"
 #include "../defs/constants.h"
 #include "../defs/event.h"
+#include "../factory/capacity_planner.h"
+#include "../sim/replay_log.h"
 #include "../system/fwd.h"
 #include "../../engine/scene/scene.h"
+#include "../../engine/core/system_scheduler.h"
+#include "../../engine/async/task.h"
+#include "../../engine/core/timer_wheel.h"
+#include "../../engine/ecs/event_queues.h"
+#include "../../engine/memory/allocation_counter.h"
 #include "../../engine/system/fwd.h"
 #include <entt/core/hashed_string.hpp>
-#include <future>
+#include <glm/vec2.hpp>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -16,15 +32,36 @@
 namespace game::factory {
     class EntityFactory;
     class BlueprintManager;
+    class WaveResourceStreamer;
+}
+
+namespace game::sim {
+    class ReplayRecorder;
+    class LockstepSession;
 }
 
 namespace game::data {
     class SessionData;
     class UIConfig;
+    class BehaviorIndex;
 }
 
 namespace engine::loader {
     struct LevelLoadData;
+    class LevelLoader;
+}
+
+namespace engine::render {
+    class Minimap;
+}
+
+namespace engine::ecs {
+    class RegistryCensus;
+    class StorageCapacityHints;
+}
+
+namespace engine::io {
+    struct SaveCompletedEvent;
 }
 
 namespace engine::ui {
@@ -33,22 +70,25 @@ namespace engine::ui {
     class UIText;
 }
 
+namespace game::ui {
+    class UnitsPortraitUI;
+    class HudBindings;
+}
+
 namespace game::scene {
 
 class GameScene final: public engine::scene::Scene {
 private:
-    struct WaveConfig {
-        std::vector<entt::id_type> enemy_queue_;
-        float spawn_interval_ = 0.5f;
-        float next_wave_interval_ = 20.0f;
-    };
-
+    engine::ecs::EventQueues event_queues_;     ///< 批量事件通道，须先于持有其监听的系统构造、晚于它们析构
     std::unique_ptr<engine::system::RenderSystem> render_system_;
+    std::unique_ptr<engine::system::ParallaxRenderSystem> parallax_render_system_;
     std::unique_ptr<engine::system::MovementSystem> movement_system_;
     std::unique_ptr<engine::system::AnimationSystem> animation_system_;
     std::unique_ptr<engine::system::YSortSystem> ysort_system_;
+    std::unique_ptr<engine::system::InterpolationSystem> interpolation_system_;
 	std::unique_ptr<engine::system::AudioSystem> audio_system_;
 
+    std::unique_ptr<game::system::SimulationLodSystem> simulation_lod_system_;
     std::unique_ptr<game::system::FollowPathSystem> follow_path_system_;
     std::unique_ptr<game::system::RemoveDeadSystem> remove_dead_system_;
     std::unique_ptr<game::system::BlockSystem> block_system_;
@@ -62,20 +102,56 @@ private:
 	std::unique_ptr<game::system::CombatResolveSystem> combat_resolve_system_;
     std::unique_ptr<game::system::SelectionSystem> selection_system_;
     std::unique_ptr<game::system::HeroSkillSystem> hero_skill_system_;
+    engine::core::SystemScheduler system_scheduler_;    ///< 每步的模拟系统（RemoveDead 到 YSort），按声明的读写并行
+    float step_delta_time_ = 0.0f;                      ///< 当前模拟步的步长，供调度器中的系统读取
+    bool last_substep_ = false;                         ///< 当前步是否为本帧最后一步（视觉修正系统的执行条件）
     std::unique_ptr<game::system::PlaceUnitSystem> place_unit_system_;
     std::unique_ptr<game::system::RenderRangeSystem> render_range_system_;
     std::unique_ptr<game::system::GameRuleSystem> game_rule_system_;
+    std::unique_ptr<game::system::SpatialIndexSystem> spatial_index_system_;
+    std::unique_ptr<game::system::StatusEffectSystem> status_effect_system_;
+    std::unique_ptr<game::system::CrowdSeparationSystem> crowd_separation_system_;
+    std::unique_ptr<game::system::ProjectileSystem> projectile_system_;    ///< 创建视觉实体需要工厂，在 initEntityFactory 中创建
+    std::unique_ptr<game::system::EffectParticleSystem> effect_particle_system_;   ///< 死亡、治疗等高频特效的粒子层
+    std::unique_ptr<game::system::DamageNumberSystem> damage_number_system_;       ///< 伤害 / 治疗飘字
+    std::unique_ptr<game::system::HealthBarSystem> health_bar_system_;
+    std::unique_ptr<engine::render::Minimap> minimap_;          ///< 关卡底图与单位点，地图大于视口时显示
+    std::unique_ptr<engine::loader::LevelLoader> level_loader_; ///< 关卡有流式瓦片图层时随场景保留，按相机视野载入区块，否则为空
+    glm::vec2 level_world_size_{ 0.0f };                        ///< 关卡地图的世界尺寸（像素）
+    static constexpr float MINIMAP_MARGIN = 8.0f;               ///< 小地图与屏幕右上角的间距
+    std::unique_ptr<game::sim::ReplayRecorder> replay_recorder_;   ///< 录制本局回放，场景结束时写出
+    std::unique_ptr<game::sim::LockstepSession> lockstep_;        ///< 双人锁步联机（--coop-host= / --coop-join=），单人时为空
+    std::optional<std::uint64_t> lockstep_seed_;                    ///< 主机下发的种子，优先于关卡配置
+    std::vector<entt::entity> lockstep_units_;                      ///< 放置序号 → 单位（两端一致，指令以序号引用单位）
+    std::vector<game::sim::ReplayCommand> lockstep_commands_;       ///< 本步双方的指令（帧间复用）
+    bool lockstep_desync_reported_ = false;
+    game::factory::CapacityPlanner capacity_planner_;               ///< 关卡存储预留与高水位统计
+    std::shared_ptr<engine::ecs::StorageCapacityHints> capacity_hints_; ///< 上一个战斗场景留下的存储容量（ContentCache 共享，跨场景保留）
+    std::unique_ptr<engine::ecs::RegistryCensus> census_;           ///< 调试面板的注册表普查（面板展开时才连接信号）
+    std::unique_ptr<game::data::BehaviorIndex> behaviors_;          ///< 按行为状态的单位列表，以引用放入注册表上下文
+    game::data::SessionTelemetry telemetry_;                        ///< 本局性能遥测，场景结束时写出
+    double last_render_ms_ = 0.0;                                   ///< 上一帧 render() 的耗时，下一帧与模拟耗时一并记录
+    std::uint64_t zero_alloc_violations_ = 0;                       ///< --zero-alloc 时开战后 update 发生分配的帧数
+    int zero_alloc_reported_wave_ = 0;                              ///< 已报告过违例的波次（每波只报告第一帧）
+    std::uint32_t health_bar_frame_ = 0;        ///< 血条降频计数（帧预算降级时使用）
+    engine::core::TickRate health_bar_rate_;    ///< 配置的血条更新频率（调度器分配相位）
+    engine::core::TickRate hover_rate_;         ///< 配置的悬停拾取频率
+    std::uint64_t health_bar_tick_ = 0;         ///< 上次检查血条频率时调度器的步数
+    std::uint64_t hover_tick_ = 0;
+    std::uint32_t effect_spawn_count_ = 0;      ///< 命中特效计数（帧预算降级时按步长抽稀）
 
     std::unordered_map<int, game::data::WaypointNode> waypoint_nodes_;  // 路径节点ID到节点数据的映射
     std::vector<int> start_points_;                                     // 起点ID列表
-    std::vector<WaveConfig> level_waves_;
-    std::vector<entt::id_type> pending_wave_enemies_;
-    std::size_t pending_wave_index_ = 0;
-    float wave_spawn_timer_ = 0.0f;
-    float wave_break_timer_ = 0.0f;
+    game::data::PathTable path_table_;                                  // 由路径节点编译出的路径表
+    std::vector<game::data::WaveConfig> level_waves_;
+    game::data::WaveSpawner wave_spawner_;      ///< 当前波次各刷怪组的进度与计时器
+    game::data::AliveCounter<game::component::EnemyComponent> enemy_counter_;  ///< 存活敌人数（波次清空检测）
+    std::unique_ptr<game::factory::WaveResourceStreamer> wave_resources_;     ///< 当前与下一波敌人的资源引用（加载协程中创建）
+    engine::core::TimerId wave_timer_;          ///< 波次间隔的计时器
     float wave_break_duration_ = game::defs::WAVE_BREAK_DURATION;
-    float wave_spawn_interval_ = game::defs::WAVE_SPAWN_INTERVAL;
-    float wave_banner_timer_ = 0.0f;
+    std::vector<glm::vec2> spawn_positions_;    ///< 批量刷怪的位置缓冲（帧间复用）
+    std::vector<int> spawn_waypoints_;          ///< 与 spawn_positions_ 对应的目标路径点
+    engine::core::TimerId wave_banner_timer_;  ///< 波次横幅的隐藏计时器
     int current_wave_ = 0;
     int enemy_level_ = 1;
     int enemy_rarity_ = 1;
@@ -88,6 +164,12 @@ private:
     std::string current_level_name_ = "Level 1";
     std::string current_map_path_ = "assets/maps/level1.tmj";
     float level_prep_time_ = 5.0f;
+    std::optional<std::uint64_t> level_seed_;     ///< 关卡配置的固定种子，未配置时每局随机
+    game::defs::NavigationMode navigation_mode_ = game::defs::NavigationMode::WAYPOINT;
+    bool crowd_separation_ = false;                ///< 关卡配置的 "crowd_separation"
+    std::optional<game::data::EndlessConfig> endless_config_;  ///< 关卡配置的 "endless"，为空时波次循环但强度不变
+    game::data::EndlessDirector endless_;           ///< 无尽模式的轮次强度、人口上限与逐轮汇总
+    game::data::WaveConfig endless_wave_;           ///< 当前波次按轮次放大后的配置（跨波复用容量）
 
     entt::entity hovered_unit_{ entt::null };
     entt::entity selected_unit_{ entt::null };
@@ -96,54 +178,85 @@ private:
     std::unique_ptr<game::data::UIConfig> ui_config_;
     game::data::GameStats game_stats_;
 
-    struct PendingSaveTask {
-        std::string save_path;
-        std::future<bool> task;
-    };
-    std::vector<PendingSaveTask> pending_save_tasks_;
+    std::string save_path_ = "assets/save/SLOT_1.mwsav";
+    std::string autosave_path_ = "assets/save/AUTOSAVE.mwsav";     ///< 每波开始时的战斗快照
+    std::size_t last_autosave_size_ = 0;                            ///< 上一次快照的字节数，用于预留缓冲
+
+    /// @brief 注册表完整快照 + 波次与经济状态：重开关卡、重试波次与调试回退直接恢复，不重新加载关卡
+    struct BattleCheckpoint;
+    std::vector<std::unique_ptr<BattleCheckpoint>> checkpoints_;   ///< 下标 N 为第 N 波开始前（0 为关卡初始状态）
+    std::optional<int> pending_rewind_wave_;                        ///< 下一帧开始时要恢复的检查点
 
     std::string font_path_ = "assets/fonts/VonwaonBitmap-16px.ttf";
+    std::string replay_path_ = "replays/last.mwr";     ///< 最近一局的回放（--headless --replay= 重放）
+    std::string telemetry_dir_ = "logs/telemetry";     ///< 每局的性能遥测 JSON/CSV 输出目录
 
     engine::ui::UIText* hud_text_ = nullptr;
     engine::ui::UIText* gold_text_ = nullptr;
+    std::unique_ptr<game::ui::HudBindings> hud_bindings_;     ///< HUD 文本只在数值变化时重新格式化
     engine::ui::UIText* wave_banner_text_ = nullptr;
+    float wave_banner_pop_ = 0.0f;                      ///< 横幅弹出动画的剩余进度（1 → 0），按真实时间衰减
     engine::ui::UIPanel* pause_overlay_ = nullptr;
     engine::ui::UIText* pause_title_text_ = nullptr;
     engine::ui::UIButton* pause_button_ = nullptr;
     engine::ui::UIButton* resume_button_ = nullptr;
     engine::ui::UIButton* quit_button_ = nullptr;
-    engine::ui::UIPanel* health_bar_layer_ = nullptr;
     engine::ui::UIPanel* unit_panel_ = nullptr;
-    int last_unit_panel_cost_ = -1;
-    float unit_panel_scroll_x_ = 0.0f;
-    float unit_panel_content_width_ = 0.0f;
-    float unit_panel_max_scroll_x_ = 0.0f;
+    std::unique_ptr<game::ui::UnitsPortraitUI> units_portrait_ui_;     ///< 常驻肖像栏，金币/滚动变化只改状态
     entt::id_type selected_unit_id_{ 0 };
     std::string selected_unit_name_;
     std::vector<entt::id_type> hidden_unit_portrait_ids_;
 
-    struct HealthBarWidget {
-        engine::ui::UIPanel* container_{ nullptr };
-        engine::ui::UIPanel* fill_{ nullptr };
-    };
-    std::unordered_map<entt::id_type, HealthBarWidget> health_bar_widgets_;
-
     std::unique_ptr<game::factory::EntityFactory> entity_factory_;      // 实体工厂，负责创建和管理实体
 
     // 管理数据的实例很可能同时被多个场景使用，因此使用共享指针
     std::shared_ptr<game::factory::BlueprintManager> blueprint_manager_;// 蓝图管理器，负责管理蓝图数据
+
+    /// @brief 关卡加载的后台任务：prefetch() 提前启动，否则由 init() 启动
+    struct LoadTasks;
+    std::unique_ptr<LoadTasks> load_tasks_;     ///< 放在最后：析构时最先等待这些捕获了 this 的任务
     
 public:
     GameScene(engine::core::Context& context, std::size_t level_index = 0);
     ~GameScene();
 
     void init() override;
+    /// @brief 在过场界面期间启动加载协程：解析关卡配置、存档、UI 配置与地图，并流式加载本关资源
+    void prefetch() override;
+    /// @brief 加载协程已结束（成功或失败）时才可进入
+    [[nodiscard]] bool isReadyToInit() const override;
+    [[nodiscard]] float getLoadProgress() const override;
     void update(float delta_time) override;
     void render() override;
     void clean() override;
+    /// @brief 在基类上报之外，按检查点组件列表计入组件值，并上报蓝图与动画库
+    void reportMemoryUsage() const override;
+
+    /// @brief 预取第 level_index 关时使用的场景 key（见 SceneManager 的场景预取）
+    [[nodiscard]] static entt::id_type prefetchKey(std::size_t level_index);
+
+    /**
+     * @brief 以已连接的锁步会话进行双人合作（init 之前调用）
+     * @details 种子取自会话下发的对局参数；放置、升级、撤退与释放技能改为提交指令，在约定的模拟步两端同时执行。
+     *          联机期间暂停、重试波次、回退与重开不可用。
+     */
+    void setLockstep(std::unique_ptr<game::sim::LockstepSession> session, std::uint64_t seed);
 
 private:
+    /**
+     * @brief 启动加载协程（已启动时什么也不做）
+     * @param priority 预取时为 BACKGROUND，未预取、进入场景时为 FRAME
+     */
+    void startLoadTasks(engine::core::TaskPriority priority);
+    /**
+     * @brief 加载协程：工作线程上解析配置与地图，主线程上加载蓝图、提交资源预加载，步骤之间让出帧
+     * @details BACKGROUND（预取）时还等待本关纹理与音效全部就绪；结果写入 LoadTasks，失败时记录错误日志并返回 false。
+     */
+    engine::async::Task<bool> loadAsync(engine::core::TaskPriority priority);
+    [[nodiscard]] bool loadBlueprints();
     [[nodiscard]] bool loadLevel(const engine::loader::LevelLoadData& level_data);
+    /// @brief 以 TileGrid 的 BLOCKED 格子为障碍、所有路径终点为目标构建流场（流场导航的关卡）
+    void buildFlowField(glm::ivec2 map_size, glm::ivec2 tile_size);
     [[nodiscard]] bool loadLevelConfig();
     [[nodiscard]] bool initSessionData();
     [[nodiscard]] bool initUIConfig();
@@ -155,17 +268,66 @@ private:
     [[nodiscard]] bool initPlacementSystem();
     [[nodiscard]] bool initGameRuleSystem();
     [[nodiscard]] bool initHeroSkillSystem();
+    [[nodiscard]] bool initSystemScheduler();
+    /**
+     * @brief 提交绘制前按晚采样的鼠标位置修正跟随鼠标的放置预览（精灵与范围圈）
+     * @return 范围圈的修正量（世界坐标），没有放置预览时为零
+     */
+    [[nodiscard]] glm::vec2 latchCursorSprites();
+    /// @brief 按帧执行的降频系统本帧是否执行：上次检查以来的模拟步中有执行步、未降频或暂停中（暂停时仍需响应放置与鼠标）
+    [[nodiscard]] bool isRateDue(const engine::core::TickRate& rate, std::uint64_t& last_tick);
     [[nodiscard]] bool initUI();
     void startNextWave();
-    void updateWaveFlow(float delta_time);
-    void updateUi(float delta_time);
-    void updateHealthBars();
+    /// @brief 按波次进度调整持有的敌人资源：开战时只留本波，波次间隔中预取下一波
+    void streamWaveResources();
+    /// @brief 波次间隔开始时整理注册表存储（与无头模拟同一步执行，见 battle_compaction.h）
+    void compactStorages();
+    /// @brief 处理本步到期的波次计时器（开战、刷怪、隐藏横幅），场上敌人清空时开始波次间隔
+    void updateWaveFlow();
+    /// @brief 无尽模式达到硬上限时接收并入的敌人：离基地最远（刚出场）的存活敌人，没有时为 entt::null
+    [[nodiscard]] entt::entity findAbsorbTarget() const;
+    /**
+     * @brief 执行一个模拟步：快照位置、派发事件、推进所有游戏逻辑系统
+     * @param last_substep 是否为本帧最后一步；快进时之前的子步跳过插值快照、朝向与 Y 排序等只影响画面的系统
+     */
+    void simulate(float delta_time, std::uint64_t tick, bool last_substep = true);
+    /**
+     * @brief 接收对方指令并检查掉线与失步
+     * @return 本帧可以执行的模拟步数（steps 与双方都已定稿的步数取小，落后对方时多跑一步追上）
+     */
+    int pollLockstep(int steps);
+    /// @brief 执行下一步双方的指令（在 simulate 之前调用）
+    void applyLockstepCommands();
+    /// @brief simulate 之后推进锁步进度，到间隔时记录状态校验值
+    void endLockstepStep();
+    /// @brief 联机时把对单位的操作提交为指令，单人时直接发出事件；返回是否已发出
+    bool issueUnitCommand(game::sim::ReplayCommandType type, entt::entity entity, int cost);
+    /// @brief 把本次模拟更新的结果提取为渲染快照（RenderSystem 绘制时只读快照，不访问注册表）
+    void extractRenderState();
+    /// @brief 按相机视野载入与释放流式瓦片区块（关卡没有流式图层时什么也不做）
+    void updateTileStreaming();
+    void updateUi();
+    /// @brief 波次横幅的弹出缩放动画（可缩放文本，逐帧改变字号不会重新光栅化）
+    void animateWaveBanner(float delta_time);
+    /// @brief 报告开战后一帧 update 内的分配（--zero-alloc 模式）
+    void reportFrameAllocations(const engine::memory::AllocationCount& allocated);
     void refreshHudText();
     void setPauseOverlayVisible(bool visible);
-    bool waitForPendingSaveTasks(bool log_as_error);
+    /// @brief 注册表与场景状态打成战斗快照，交给写入线程（每波开始时调用）
+    void autosaveBattle();
+    /// @brief 在内存中记录第 wave 波开始前的检查点（同一波次重复记录时覆盖）
+    void captureCheckpoint(int wave);
+    /// @brief 恢复第 wave 波开始前的检查点；只在模拟步之外调用（update 开头）
+    void restoreCheckpoint(int wave);
     void createUnitsPortraitUI();
+    /**
+     * @brief 加载末尾的预热：取用本关全部纹理、音效与界面字号，各职业实体创建一次，纹理离屏绘制一次
+     * @details 排除第一波新敌人出场、第一次开火或播放音效时的同步加载、纹理上传与组件存储创建。
+     */
+    void warmUp();
     [[nodiscard]] bool togglePause();
-    void spawnNextEnemy();
+    /// @brief 批量生成一个刷怪组本次出场的敌人
+    void spawnEnemies(const game::data::SpawnBatch& batch);
     [[nodiscard]] int getUnitCost(entt::id_type class_id, int rarity = 1) const;
     [[nodiscard]] bool trySpendGold(int amount);
 
@@ -177,9 +339,13 @@ private:
     void onUIPortraitHoverEnter(const game::defs::UIPortraitHoverEnterEvent& event);
     void onUIPortraitHoverLeave(const game::defs::UIPortraitHoverLeaveEvent& event);
     void onRestartRequested(const game::defs::RestartEvent& event);
+    void onRetryWaveRequested(const game::defs::RetryWaveEvent& event);
+    void onRewindToWaveRequested(const game::defs::RewindToWaveEvent& event);
     void onBackToTitleRequested(const game::defs::BackToTitleEvent& event);
     void onSaveRequested(const game::defs::SaveEvent& event);
+    void onSaveCompleted(const engine::io::SaveCompletedEvent& event);
     void onLevelClearRequested(const game::defs::LevelClearEvent& event);
+    void onPlaceUnitRequested(const game::defs::PlaceUnitRequestEvent& event);
 
     // 测试函数
     void createTestEnemy();
@@ -10,6 +10,7 @@
 #include "../../engine/ui/ui_manager.h"
 #include "../../engine/ui/ui_panel.h"
 #include "../../engine/ui/ui_text.h"
+#include <format>
 #include <glm/vec2.hpp>
 
 namespace game::scene {
@@ -39,7 +40,7 @@ void LevelClearScene::init() {
     auto overlay = std::unique_ptr<engine::ui::UIPanel>(new engine::ui::UIPanel(context_));
     overlay->setPosition({ 0.0f, 0.0f });
     overlay->setSize(window_size);
-    overlay->setBackgroundColor({ 0.0f, 0.0f, 0.0f, 0.45f });
+    overlay->setBackgroundColor({ 0.0f, 0.0f, 0.0f, 0.0f });    // 压暗由底图完成（getUnderlayStyle）
     auto* overlay_ptr = overlay.get();
 
     auto panel = std::unique_ptr<engine::ui::UIPanel>(new engine::ui::UIPanel(context_));
@@ -66,6 +67,7 @@ void LevelClearScene::init() {
     continue_button->setPosition({ 90.0f, 150.0f });
     continue_button->setSize({ 220.0f, 40.0f });
     continue_button->setClickCallback([this]() { startNextLevel(); });
+    continue_button_ = continue_button.get();
     panel_ptr->addChild(std::move(continue_button));
 
     auto title_button = std::unique_ptr<engine::ui::UIButton>(new engine::ui::UIButton(context_, "返回标题", "assets/fonts/VonwaonBitmap-16px.ttf", 24));
@@ -76,6 +78,10 @@ void LevelClearScene::init() {
 
     overlay_ptr->addChild(std::move(panel));
     ui_manager->addElement(std::move(overlay));
+
+    // 玩家停留在结算界面期间，下一关在后台完成解析与资源流式加载
+    requestPrefetchScene(GameScene::prefetchKey(next_level_index_),
+        std::unique_ptr<engine::scene::Scene>(new game::scene::GameScene(context_, next_level_index_)));
 }
 
 void LevelClearScene::update(float delta_time) {
@@ -90,8 +96,20 @@ void LevelClearScene::clean() {
     Scene::clean();
 }
 
+void LevelClearScene::onLoadProgress(float progress) {
+    if (continue_button_) {
+        continue_button_->setText(std::format("加载中 {}%", static_cast<int>(progress * 100.0f)));
+    }
+}
+
 void LevelClearScene::startNextLevel() {
-    requestReplaceScene(std::unique_ptr<engine::scene::Scene>(new game::scene::GameScene(context_, next_level_index_)));
+    // 预取的场景已交给 SceneManager，重复点击只会再创建一个未预取的场景
+    if (starting_) {
+        return;
+    }
+    starting_ = true;
+    requestReplaceScene(GameScene::prefetchKey(next_level_index_),
+        std::unique_ptr<engine::scene::Scene>(new game::scene::GameScene(context_, next_level_index_)));
 }
 
 void LevelClearScene::returnToTitle() {
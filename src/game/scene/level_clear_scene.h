@@ -2,6 +2,10 @@
 
 #include "../../engine/scene/scene.h"
 
+namespace engine::ui {
+class UIButton;
+}
+
 namespace game::scene {
 
 class LevelClearScene final : public engine::scene::Scene {
@@ -13,10 +17,15 @@ public:
     void update(float delta_time) override;
     void render() override;
     void clean() override;
+    void onLoadProgress(float progress) override;
+    /// @brief 下方的关卡画面模糊并压暗（捕获时烘焙一次）
+    engine::scene::UnderlayStyle getUnderlayStyle() const override { return { 0.45f, 2 }; }
 
 private:
     std::size_t current_level_index_ = 0;
     std::size_t next_level_index_ = 0;
+    engine::ui::UIButton* continue_button_ = nullptr;     ///< 加载下一关期间显示进度
+    bool starting_ = false;                               ///< 已请求进入下一关（切换可能推迟到加载完成）
 
     void startNextLevel();
     void returnToTitle();
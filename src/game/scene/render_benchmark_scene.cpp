@@ -0,0 +1,263 @@
+#include "render_benchmark_scene.h"
+
+#include "../../engine/core/context.h"
+#include "../../engine/core/game_state.h"
+#include "../../engine/render/camera.h"
+#include "../../engine/render/renderer.h"
+#include "../../engine/resource/resource_manager.h"
+#include "../../engine/ui/ui_manager.h"
+#include "../../engine/ui/ui_panel.h"
+#include "../../engine/ui/ui_text.h"
+#include "../../engine/utils/random.h"
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_timer.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <format>
+#include <functional>
+#include <string_view>
+
+namespace game::scene {
+
+namespace {
+
+constexpr std::string_view FONT_PATH = "assets/fonts/VonwaonBitmap-16px.ttf";
+constexpr glm::vec2 SPRITE_SIZE{ 32.0f, 32.0f };
+constexpr int SUMMARY_INTERVAL = 30;        ///< 屏幕统计的刷新间隔（帧）
+
+/// @brief 轮流使用的纹理（分属不同图集页时每次切换都会开启新的批次段）
+constexpr std::array<std::string_view, 8> TEXTURE_PATHS{
+    "assets/textures/Units/Warrior.png",
+    "assets/textures/Units/Archer.png",
+    "assets/textures/Units/Lancer.png",
+    "assets/textures/Units/Witch.png",
+    "assets/textures/Enemy/goblin.png",
+    "assets/textures/Enemy/slime.png",
+    "assets/textures/Enemy/wolf.png",
+    "assets/textures/FX/Heal_Effect.png",
+};
+
+template <typename T, typename Proj>
+double percentile(std::vector<T>& values, Proj proj, double q) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::ranges::sort(values, {}, proj);
+    const auto rank = static_cast<std::size_t>(q * static_cast<double>(values.size() - 1) + 0.5);
+    return static_cast<double>(std::invoke(proj, values[std::min(rank, values.size() - 1)]));
+}
+
+} // namespace
+
+RenderBenchmarkScene::RenderBenchmarkScene(engine::core::Context& context, const RenderBenchmarkOptions& options)
+    : engine::scene::Scene("RenderBenchmarkScene", context), options_(options) {
+}
+
+RenderBenchmarkScene::~RenderBenchmarkScene() = default;
+
+void RenderBenchmarkScene::init() {
+    Scene::init();
+    bounds_ = context_.getGameState().getWindowLogicalSize();
+    context_.getCamera().setPosition({ 0.0f, 0.0f });   // 世界坐标即屏幕坐标
+
+    auto& renderer = context_.getRenderer();
+    if (!options_.vsync_ && !SDL_SetRenderVSync(renderer.getSDLRenderer(), SDL_RENDERER_VSYNC_DISABLED)) {
+        spdlog::warn("渲染压测：关闭垂直同步失败，帧间隔将受刷新率限制：{}", SDL_GetError());
+    }
+
+    spawnSprites();
+    spawnUI();
+    if (options_.frames_ > 0) {
+        samples_.reserve(static_cast<std::size_t>(options_.frames_));
+    }
+
+    const char* backend = SDL_GetRendererName(renderer.getSDLRenderer());
+    spdlog::info("渲染压测开始：后端 {}，{}，{} 纹理；精灵 静止 {} / 移动 {} / 旋转 {} / 着色 {}，文字 {}，面板 {}",
+        backend ? backend : "unknown", options_.batched_ ? "批处理" : "逐个绘制", options_.mixed_atlases_ ? "多张" : "单张",
+        options_.static_sprites_, options_.moving_sprites_, options_.rotated_sprites_, options_.tinted_sprites_,
+        options_.text_labels_, options_.ui_panels_);
+}
+
+void RenderBenchmarkScene::spawnSprites() {
+    auto& resources = context_.getResourceManager();
+    std::array<engine::component::Sprite, TEXTURE_PATHS.size()> templates{};
+    for (std::size_t i = 0; i < TEXTURE_PATHS.size(); ++i) {
+        // 精灵表取左上角的一块，与单位帧的尺寸相当
+        const glm::vec2 texture_size = resources.getTextureSize(std::string(TEXTURE_PATHS[i]));
+        const float side = texture_size.x > 0.0f ? std::min({ texture_size.x, texture_size.y, 192.0f }) : SPRITE_SIZE.x;
+        templates[i] = engine::component::Sprite(TEXTURE_PATHS[i], engine::utils::Rect{ { 0.0f, 0.0f }, { side, side } });
+    }
+
+    engine::utils::Xoshiro128 rng(0x5EED);
+    const auto spawn = [&](int count, Motion motion) {
+        for (int i = 0; i < count; ++i) {
+            BenchSprite sprite;
+            sprite.sprite_ = templates[options_.mixed_atlases_ ? sprites_.size() % templates.size() : 0];
+            sprite.sprite_.is_flipped_ = (rng.next() & 1u) != 0;
+            sprite.position_ = { rng.uniform(0.0f, bounds_.x - SPRITE_SIZE.x), rng.uniform(0.0f, bounds_.y - SPRITE_SIZE.y) };
+            sprite.motion_ = motion;
+            sprite.phase_ = rng.uniform(0.0f, 6.2831853f);
+            if (motion == Motion::MOVING) {
+                sprite.velocity_ = { rng.uniform(-120.0f, 120.0f), rng.uniform(-120.0f, 120.0f) };
+            } else if (motion == Motion::ROTATED) {
+                sprite.spin_ = rng.uniform(-180.0f, 180.0f);
+                sprite.angle_ = rng.uniform(0.0f, 360.0f);
+            }
+            sprites_.push_back(sprite);
+        }
+    };
+    sprites_.reserve(static_cast<std::size_t>(options_.static_sprites_ + options_.moving_sprites_ +
+                                              options_.rotated_sprites_ + options_.tinted_sprites_));
+    spawn(options_.static_sprites_, Motion::STATIC);
+    spawn(options_.moving_sprites_, Motion::MOVING);
+    spawn(options_.rotated_sprites_, Motion::ROTATED);
+    spawn(options_.tinted_sprites_, Motion::TINTED);
+}
+
+void RenderBenchmarkScene::spawnUI() {
+    auto* ui_manager = getUIManager();
+    if (!ui_manager) {
+        return;
+    }
+    ui_manager->init(bounds_);
+    ui_manager->clear();
+
+    const std::string font_path(FONT_PATH);
+    const glm::vec2 panel_size{ 96.0f, 48.0f };
+    const int columns = std::max(1, static_cast<int>(bounds_.x / (panel_size.x + 8.0f)));
+    for (int i = 0; i < options_.ui_panels_; ++i) {
+        auto panel = std::unique_ptr<engine::ui::UIPanel>(new engine::ui::UIPanel(context_));
+        panel->setPosition({ 8.0f + static_cast<float>(i % columns) * (panel_size.x + 8.0f),
+                             40.0f + static_cast<float>(i / columns) * (panel_size.y + 8.0f) });
+        panel->setSize(panel_size);
+        panel->setBackgroundColor({ 0.0f, 0.0f, 0.0f, 0.45f });
+        panel->setBorderWidth(2.0f);
+        panel->setBorderColor({ 1.0f, 1.0f, 1.0f, 0.25f });
+        ui_manager->addElement(std::move(panel));
+    }
+
+    engine::utils::Xoshiro128 rng(0x7E47);
+    labels_.reserve(static_cast<std::size_t>(options_.text_labels_));
+    for (int i = 0; i < options_.text_labels_; ++i) {
+        auto label = std::unique_ptr<engine::ui::UIText>(new engine::ui::UIText(context_, std::format("label {}", i), font_path, 16));
+        label->setPosition({ rng.uniform(0.0f, bounds_.x - 80.0f), rng.uniform(24.0f, bounds_.y - 16.0f) });
+        labels_.push_back(label.get());
+        ui_manager->addElement(std::move(label));
+    }
+
+    auto summary = std::unique_ptr<engine::ui::UIText>(new engine::ui::UIText(context_, "warming up", font_path, 16));
+    summary->setPosition({ 8.0f, 8.0f });
+    summary->setColor({ 1.0f, 0.96f, 0.72f, 1.0f });
+    summary_text_ = summary.get();
+    ui_manager->addElement(std::move(summary));
+}
+
+void RenderBenchmarkScene::update(float delta_time) {
+    Scene::update(delta_time);
+    time_ += delta_time;
+
+    // 上一帧的提交、present 与帧间隔在此时都已确定
+    if (frame_ >= options_.warmup_frames_ && !reported_) {
+        const auto& stats = context_.getRenderer().getFrameStats();
+        samples_.push_back(FrameSample{ last_submit_ms_, static_cast<float>(stats.present_ms_), delta_time * 1000.0f,
+                                        static_cast<std::uint32_t>(stats.draw_calls_), static_cast<std::uint32_t>(stats.batches_) });
+        if (summary_text_ && samples_.size() % SUMMARY_INTERVAL == 0) {
+            const auto& last = samples_.back();
+            summary_text_->setText(std::format("{} sprites  submit {:.2f}ms  present {:.2f}ms  frame {:.2f}ms  draws {}  batches {}",
+                sprites_.size(), last.submit_ms_, last.present_ms_, last.frame_ms_, last.draw_calls_, last.batches_));
+        }
+        if (options_.frames_ > 0 && samples_.size() >= static_cast<std::size_t>(options_.frames_)) {
+            logReport();
+            quit();
+            return;
+        }
+    }
+    ++frame_;
+
+    for (auto& sprite : sprites_) {
+        switch (sprite.motion_) {
+            case Motion::MOVING:
+                sprite.position_ += sprite.velocity_ * delta_time;
+                if (sprite.position_.x < 0.0f || sprite.position_.x > bounds_.x - SPRITE_SIZE.x) {
+                    sprite.velocity_.x = -sprite.velocity_.x;
+                    sprite.position_.x = std::clamp(sprite.position_.x, 0.0f, bounds_.x - SPRITE_SIZE.x);
+                }
+                if (sprite.position_.y < 0.0f || sprite.position_.y > bounds_.y - SPRITE_SIZE.y) {
+                    sprite.velocity_.y = -sprite.velocity_.y;
+                    sprite.position_.y = std::clamp(sprite.position_.y, 0.0f, bounds_.y - SPRITE_SIZE.y);
+                }
+                break;
+            case Motion::ROTATED:
+                sprite.angle_ = std::fmod(sprite.angle_ + sprite.spin_ * delta_time, 360.0f);
+                break;
+            case Motion::TINTED: {
+                const float t = time_ * 2.0f + sprite.phase_;
+                sprite.tint_ = { 0.5f + 0.5f * std::sin(t), 0.5f + 0.5f * std::sin(t + 2.094f), 0.5f + 0.5f * std::sin(t + 4.189f), 1.0f };
+                break;
+            }
+            case Motion::STATIC:
+                break;
+        }
+    }
+
+    // 文字每帧改写，压测排版与字形提交而不是只命中缓存
+    for (std::size_t i = 0; i < labels_.size(); ++i) {
+        labels_[i]->setText(std::format("label {} #{}", i, frame_));
+    }
+}
+
+void RenderBenchmarkScene::render() {
+    const std::uint64_t start_ns = SDL_GetTicksNS();
+    auto& renderer = context_.getRenderer();
+    const auto& camera = context_.getCamera();
+    if (options_.batched_) {
+        renderer.beginSpriteBatch();
+    }
+    for (const auto& sprite : sprites_) {
+        renderer.drawSprite(camera, sprite.sprite_, sprite.position_, SPRITE_SIZE, sprite.angle_, sprite.tint_);
+    }
+    if (options_.batched_) {
+        renderer.endSpriteBatch();
+    }
+    Scene::render();
+    last_submit_ms_ = static_cast<float>(SDL_GetTicksNS() - start_ns) / 1'000'000.0f;
+}
+
+void RenderBenchmarkScene::clean() {
+    if (!reported_ && !samples_.empty()) {
+        logReport();        // 提前关闭窗口时也输出已有的统计
+    }
+    labels_.clear();
+    summary_text_ = nullptr;
+    Scene::clean();
+}
+
+void RenderBenchmarkScene::logReport() {
+    reported_ = true;
+    const double frames = static_cast<double>(samples_.size());
+    double submit_sum = 0.0, present_sum = 0.0, frame_sum = 0.0, draw_sum = 0.0, batch_sum = 0.0;
+    for (const auto& sample : samples_) {
+        submit_sum += sample.submit_ms_;
+        present_sum += sample.present_ms_;
+        frame_sum += sample.frame_ms_;
+        draw_sum += sample.draw_calls_;
+        batch_sum += sample.batches_;
+    }
+    const auto summarize = [this](auto proj) {
+        return std::array<double, 3>{ percentile(samples_, proj, 0.50), percentile(samples_, proj, 0.95), percentile(samples_, proj, 1.0) };
+    };
+    const auto submit = summarize(&FrameSample::submit_ms_);
+    const auto present = summarize(&FrameSample::present_ms_);
+    const auto frame = summarize(&FrameSample::frame_ms_);
+
+    spdlog::info("渲染压测结果（{} 帧，{} 精灵，{}）：", samples_.size(), sprites_.size(), options_.batched_ ? "批处理" : "逐个绘制");
+    spdlog::info("  CPU 提交  avg {:.3f} ms  p50 {:.3f}  p95 {:.3f}  max {:.3f}", submit_sum / frames, submit[0], submit[1], submit[2]);
+    spdlog::info("  present   avg {:.3f} ms  p50 {:.3f}  p95 {:.3f}  max {:.3f}", present_sum / frames, present[0], present[1], present[2]);
+    spdlog::info("  帧间隔    avg {:.3f} ms  p50 {:.3f}  p95 {:.3f}  max {:.3f}（{:.1f} FPS）",
+        frame_sum / frames, frame[0], frame[1], frame[2], frame_sum > 0.0 ? 1000.0 * frames / frame_sum : 0.0);
+    spdlog::info("  每帧绘制调用 {:.1f}，批次 {:.1f}", draw_sum / frames, batch_sum / frames);
+}
+
+} // namespace game::scene
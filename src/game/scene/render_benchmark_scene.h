@@ -0,0 +1,93 @@
+#pragma once
+
+#include "../../engine/scene/scene.h"
+#include "../../engine/component/sprite_component.h"
+#include "../../engine/utils/math.h"
+#include <glm/vec2.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace engine::ui {
+class UIText;
+}
+
+namespace game::scene {
+
+/// @brief 渲染压测的规模与模式（命令行 --render-bench 与 --bench-*= 参数）
+struct RenderBenchmarkOptions {
+    int static_sprites_{ 2000 };    ///< 静止精灵
+    int moving_sprites_{ 2000 };    ///< 在窗口内反弹移动的精灵
+    int rotated_sprites_{ 500 };    ///< 持续旋转的精灵（走旋转顶点 / SDL_RenderTextureRotated）
+    int tinted_sprites_{ 500 };     ///< 每帧改变颜色调制的精灵
+    int text_labels_{ 50 };         ///< 每帧改写内容的文本标签
+    int ui_panels_{ 20 };           ///< 带边框的 UI 面板
+    bool batched_{ true };          ///< 精灵走 begin/endSpriteBatch；false 时逐个 SDL_RenderTexture
+    bool mixed_atlases_{ true };    ///< 精灵轮流使用多张纹理；false 时全部使用同一张
+    bool vsync_{ false };           ///< 保留垂直同步（默认关闭，帧间隔才反映吞吐）
+    int warmup_frames_{ 60 };       ///< 不计入统计的预热帧（纹理加载、图集打包、字形缓存）
+    int frames_{ 600 };             ///< 统计的帧数，达到后输出报告并退出；0 表示一直运行
+};
+
+/**
+ * @class RenderBenchmarkScene
+ * @brief 与玩法无关的渲染压测场景：生成给定数量的各类精灵、文字与 UI 面板，统计每帧的渲染开销。
+ *
+ * @details
+ * 每帧记录：
+ * - CPU 提交：render() 的耗时（精灵记录、批次展开与 SDL_Render* 调用、UI 与文字）
+ * - present：Renderer::getFrameStats().present_ms_。SDL_Renderer（含 gpu 后端）不提供 GPU 时间戳查询，
+ *   关闭垂直同步时 GPU 跟不上的部分体现为 present 阻塞，作为 GPU 耗时的近似
+ * - 帧间隔：两次 update 的间隔，即实际吞吐
+ * - 绘制调用与批次数：Renderer::getFrameStats()（不含 TextRenderer 与 ImGui 的调用）
+ * 统计结束时以日志输出均值与 p50 / p95 / max，配合 --renderer= 比较 SDL 默认后端、批处理与否以及 gpu 后端。
+ */
+class RenderBenchmarkScene final : public engine::scene::Scene {
+public:
+    RenderBenchmarkScene(engine::core::Context& context, const RenderBenchmarkOptions& options);
+    ~RenderBenchmarkScene() override;
+
+    void init() override;
+    void update(float delta_time) override;
+    void render() override;
+    void clean() override;
+
+private:
+    enum class Motion : std::uint8_t { STATIC, MOVING, ROTATED, TINTED };
+
+    struct BenchSprite {
+        engine::component::Sprite sprite_;
+        glm::vec2 position_{ 0.0f };
+        glm::vec2 velocity_{ 0.0f };
+        float angle_{ 0.0f };
+        float spin_{ 0.0f };                ///< 度 / 秒
+        float phase_{ 0.0f };               ///< 着色动画的相位
+        engine::utils::FColor tint_{ 1.0f, 1.0f, 1.0f, 1.0f };
+        Motion motion_{ Motion::STATIC };
+    };
+
+    /// @brief 一帧的采样
+    struct FrameSample {
+        float submit_ms_{ 0.0f };
+        float present_ms_{ 0.0f };
+        float frame_ms_{ 0.0f };
+        std::uint32_t draw_calls_{ 0 };
+        std::uint32_t batches_{ 0 };
+    };
+
+    void spawnSprites();
+    void spawnUI();
+    void logReport();
+
+    RenderBenchmarkOptions options_;
+    std::vector<BenchSprite> sprites_;
+    std::vector<engine::ui::UIText*> labels_;       ///< 归 UIManager 所有
+    engine::ui::UIText* summary_text_{ nullptr };   ///< 屏幕上的实时统计
+    std::vector<FrameSample> samples_;
+    glm::vec2 bounds_{ 0.0f };                      ///< 逻辑分辨率
+    float time_{ 0.0f };
+    float last_submit_ms_{ 0.0f };
+    int frame_{ 0 };
+    bool reported_{ false };
+};
+
+} // namespace game::scene
@@ -1,6 +1,7 @@
 #include "title_scene.h"
 
 #include "game_scene.h"
+#include "../defs/constants.h"
 #include "../defs/event.h"
 #include "../../engine/core/context.h"
 #include "../../engine/core/game_state.h"
@@ -10,6 +11,7 @@
 #include "../../engine/ui/ui_button.h"
 #include "../../engine/ui/ui_panel.h"
 #include "../../engine/ui/ui_text.h"
+#include <format>
 #include <glm/vec2.hpp>
 
 using namespace entt::literals;
@@ -38,8 +40,8 @@ void TitleScene::init() {
     ui_manager->addElement(std::move(background));
 
     auto panel = std::unique_ptr<engine::ui::UIPanel>(new engine::ui::UIPanel(context_));
-    panel->setPosition({ (window_size.x - 280.0f) * 0.5f, (window_size.y - 160.0f) * 0.5f });
-    panel->setSize({ 280.0f, 160.0f });
+    panel->setPosition({ (window_size.x - 280.0f) * 0.5f, (window_size.y - 200.0f) * 0.5f });
+    panel->setSize({ 280.0f, 200.0f });
     panel->setBackgroundColor({ 0.0f, 0.0f, 0.0f, 0.45f });
     panel->setBorderWidth(2.0f);
     panel->setBorderColor({ 1.0f, 1.0f, 1.0f, 0.25f });
@@ -54,11 +56,21 @@ void TitleScene::init() {
     auto start_button = std::unique_ptr<engine::ui::UIButton>(new engine::ui::UIButton(context_, "开始游戏", "assets/fonts/VonwaonBitmap-16px.ttf", 24));
     start_button->setPosition({ 40.0f, 72.0f });
     start_button->setSize({ 200.0f, 32.0f });
-    start_button->setClickCallback([this]() { startGame(); });
+    start_button->setClickCallback([this]() { startGame(0); });
+    start_button_ = start_button.get();
+    updateReadiness();
     panel_ptr->addChild(std::move(start_button));
 
+    auto endless_button = std::unique_ptr<engine::ui::UIButton>(new engine::ui::UIButton(context_, "无尽模式", "assets/fonts/VonwaonBitmap-16px.ttf", 24));
+    endless_button->setPosition({ 40.0f, 112.0f });
+    endless_button->setSize({ 200.0f, 32.0f });
+    endless_button->setClickCallback([this]() { startGame(game::defs::ENDLESS_LEVEL_INDEX); });
+    endless_button_ = endless_button.get();
+    updateReadiness();
+    panel_ptr->addChild(std::move(endless_button));
+
     auto quit_button = std::unique_ptr<engine::ui::UIButton>(new engine::ui::UIButton(context_, "退出", "assets/fonts/VonwaonBitmap-16px.ttf", 24));
-    quit_button->setPosition({ 40.0f, 112.0f });
+    quit_button->setPosition({ 40.0f, 152.0f });
     quit_button->setSize({ 200.0f, 32.0f });
     quit_button->setClickCallback([this]() { quit(); });
     panel_ptr->addChild(std::move(quit_button));
@@ -67,12 +79,42 @@ void TitleScene::init() {
 
     context_.getResourceManager().stopMusic();
     context_.getResourceManager().playMusic(entt::hashed_string("title_bgm").value());
+
+    // 标题界面期间预取第一关
+    requestPrefetchScene(GameScene::prefetchKey(0),
+        std::unique_ptr<engine::scene::Scene>(new game::scene::GameScene(context_, 0)));
 }
 
 void TitleScene::update(float delta_time) {
+    updateReadiness();
     Scene::update(delta_time);
 }
 
+void TitleScene::updateReadiness() {
+    if (content_ready_ || !start_button_) {
+        return;
+    }
+    const auto& resources = context_.getResourceManager();
+    if (resources.isMappedPreloadComplete()) {
+        content_ready_ = true;
+        start_button_->setInteractive(true);
+        start_button_->setText("开始游戏");
+        if (endless_button_) {
+            endless_button_->setInteractive(true);
+        }
+        return;
+    }
+    start_button_->setInteractive(false);
+    if (endless_button_) {
+        endless_button_->setInteractive(false);
+    }
+    const int progress = static_cast<int>(resources.getMappedPreloadProgress() * 100.0f);
+    if (progress != shown_progress_) {
+        shown_progress_ = progress;
+        start_button_->setText(std::format("准备中 {}%", progress));
+    }
+}
+
 void TitleScene::render() {
     Scene::render();
 }
@@ -81,8 +123,21 @@ void TitleScene::clean() {
     Scene::clean();
 }
 
-void TitleScene::startGame() {
-    requestReplaceScene(std::unique_ptr<engine::scene::Scene>(new game::scene::GameScene(context_, 0)));
+void TitleScene::onLoadProgress(float progress) {
+    if (start_button_) {
+        start_button_->setText(std::format("加载中 {}%", static_cast<int>(progress * 100.0f)));
+    }
+}
+
+void TitleScene::startGame(std::size_t level_index) {
+    // 预取的场景已交给 SceneManager，重复点击只会再创建一个未预取的场景
+    if (starting_ || !content_ready_) {
+        return;
+    }
+    starting_ = true;
+    // 只预取了第一关；无尽模式没有可用的预取，按关卡键取不到时直接使用新建的场景
+    requestReplaceScene(GameScene::prefetchKey(level_index),
+        std::unique_ptr<engine::scene::Scene>(new game::scene::GameScene(context_, level_index)));
 }
 
 } // namespace game::scene
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "../../engine/scene/scene.h"
+#include <cstddef>
+
+namespace engine::ui {
+class UIButton;
+}
 
 namespace game::scene {
 
@@ -13,9 +18,18 @@ public:
     void update(float delta_time) override;
     void render() override;
     void clean() override;
+    void onLoadProgress(float progress) override;
 
 private:
-    void startGame();
+    engine::ui::UIButton* start_button_ = nullptr;    ///< 后台资源与第一关加载期间显示进度
+    engine::ui::UIButton* endless_button_ = nullptr;  ///< 进入无尽模式，与开始按钮同时可用
+    bool starting_ = false;                           ///< 已请求进入第一关（切换可能推迟到加载完成）
+    bool content_ready_ = false;                      ///< 启动时延迟的图集已就绪，开始按钮可用
+    int shown_progress_ = -1;                         ///< 按钮上显示的准备进度（百分比），变化时才改文字
+
+    void startGame(std::size_t level_index);
+    /// @brief 启动时延迟到后台的资源就绪前禁用开始按钮并显示进度
+    void updateReadiness();
 };
 
 } // namespace game::scene
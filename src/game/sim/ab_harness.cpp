@@ -0,0 +1,181 @@
+#include "ab_harness.h"
+
+#include "../component/blocked_by_component.h"
+#include "../component/stats_component.h"
+#include "../component/target_component.h"
+#include "../../engine/component/transform_component.h"
+#include "../../engine/utils/logging.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace game::sim {
+
+namespace {
+
+/// @brief 已排序样本的 q 分位
+double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<std::size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void summarize(std::vector<double>& samples, AbTiming& timing) {
+    if (samples.empty()) {
+        return;
+    }
+    for (const double ms : samples) {
+        timing.total_ms_ += ms;
+    }
+    timing.mean_ms_ = timing.total_ms_ / static_cast<double>(samples.size());
+    std::ranges::sort(samples);
+    timing.p50_ms_ = percentile(samples, 0.50);
+    timing.p95_ms_ = percentile(samples, 0.95);
+    timing.p99_ms_ = percentile(samples, 0.99);
+    timing.max_ms_ = samples.back();
+}
+
+/// @brief 目标 / 阻挡者实体（没有该组件时为 entt::null）
+template <typename Component>
+entt::entity linkedEntity(const entt::registry& registry, entt::entity entity) {
+    const auto* component = registry.try_get<Component>(entity);
+    return component ? component->entity_ : entt::null;
+}
+
+} // namespace
+
+AbHarness::AbHarness(AbOptions options) : options_(std::move(options)) {}
+
+AbReport AbHarness::run() {
+    AbReport report;
+    report.a_.name_ = options_.variant_a_;
+    report.b_.name_ = options_.variant_b_;
+
+    // 回放与关卡内容只加载一次，两份模拟共享
+    auto base = options_.base_;
+    base.set_target_variant_.clear();
+    base.block_variant_.clear();
+    if (!base.replay_ && !base.replay_path_.empty()) {
+        auto replay = std::make_shared<ReplayLog>();
+        std::string error_message;
+        if (!replay->load(base.replay_path_, error_message)) {
+            ENGINE_LOG_ERROR("{}", error_message);
+            return report;
+        }
+        base.replay_ = std::move(replay);
+    }
+    if (base.replay_) {
+        base.level_index_ = base.replay_->header_.level_index_;
+    }
+    const auto content = HeadlessContent::load(base.level_config_path_, base.level_index_);
+    if (!content) {
+        return report;
+    }
+
+    const auto make_options = [&](const std::string& variant) {
+        auto options = base;
+        auto& slot_variant = options_.slot_ == SystemSlot::SET_TARGET ? options.set_target_variant_ : options.block_variant_;
+        slot_variant = variant;
+        options.stop_on_desync_ = false;
+        return options;
+    };
+    HeadlessSimulation a(make_options(options_.variant_a_), content);
+    HeadlessSimulation b(make_options(options_.variant_b_), content);
+    if (!a.init() || !b.init()) {
+        ENGINE_LOG_ERROR("A/B 对比: 模拟初始化失败");
+        return report;
+    }
+    if (const auto mask = a.computeChecksum().diff(b.computeChecksum())) {
+        ENGINE_LOG_ERROR("A/B 对比: 两份模拟开局状态即不一致（{}），无法对比", describeChecksumDiff(mask));
+        return report;
+    }
+
+    const auto ticks = a.getTickLimit();
+    std::vector<double> samples_a;
+    std::vector<double> samples_b;
+    samples_a.reserve(static_cast<std::size_t>(ticks));
+    samples_b.reserve(static_cast<std::size_t>(ticks));
+    ENGINE_LOG_INFO("A/B 对比 {}: {} 对 {}，{} 步", systemSlotName(options_.slot_), options_.variant_a_, options_.variant_b_, ticks);
+
+    for (std::uint64_t tick = 0; tick < ticks; ++tick) {
+        // 轮流先后执行，避免总是后执行的一方吃到热缓存
+        if (tick % 2 == 0) {
+            a.step();
+            b.step();
+        } else {
+            b.step();
+            a.step();
+        }
+        samples_a.push_back(a.getVariantMs());
+        samples_b.push_back(b.getVariantMs());
+        report.ticks_ = tick + 1;
+
+        if (const auto mask = a.computeChecksum().diff(b.computeChecksum())) {
+            report.divergence_tick_ = tick;
+            report.divergence_components_ = mask;
+            ENGINE_LOG_ERROR("A/B 对比: 第 {} 步执行后 {} 与 {} 不一致（{}），此前 {} 步全部一致",
+                tick, options_.variant_a_, options_.variant_b_, describeChecksumDiff(mask), tick);
+            logEntityDifferences(a, b);
+            break;
+        }
+        if (base.stop_on_game_over_ && a.getGameStats().home_hp_ <= 0) {
+            ENGINE_LOG_INFO("A/B 对比: 基地生命耗尽，在第 {} 步结束", a.getTick());
+            break;
+        }
+    }
+
+    summarize(samples_a, report.a_);
+    summarize(samples_b, report.b_);
+    report.a_.replay_desync_tick_ = a.getDesyncTick();
+    report.b_.replay_desync_tick_ = b.getDesyncTick();
+    report.ok_ = true;
+
+    for (const auto* timing : { &report.a_, &report.b_ }) {
+        ENGINE_LOG_INFO("  {:<16} avg {:.4f} ms  p50 {:.4f}  p95 {:.4f}  p99 {:.4f}  max {:.4f}  合计 {:.1f} ms",
+            timing->name_, timing->mean_ms_, timing->p50_ms_, timing->p95_ms_, timing->p99_ms_, timing->max_ms_, timing->total_ms_);
+        if (timing->replay_desync_tick_) {
+            ENGINE_LOG_WARN("  {} 在第 {} 步偏离了回放日志的校验值", timing->name_, *timing->replay_desync_tick_);
+        }
+    }
+    ENGINE_LOG_INFO("A/B 对比完成: {} 步，{}，加速比 {:.2f}x", report.ticks_,
+        report.divergence_tick_ ? "行为不一致" : "逐步一致", report.speedup());
+    return report;
+}
+
+void AbHarness::logEntityDifferences(HeadlessSimulation& a, HeadlessSimulation& b) const {
+    using game::component::BlockedByComponent;
+    using game::component::TargetComponent;
+    const auto& registry_a = a.getRegistry();
+    const auto& registry_b = b.getRegistry();
+    std::size_t reported = 0;
+    std::size_t differing = 0;
+    const auto units = registry_a.view<const game::component::StatsComponent, const engine::component::TransformComponent>();
+    for (const auto entity : units) {
+        const auto& transform = units.get<const engine::component::TransformComponent>(entity);
+        const auto* other = registry_b.valid(entity) ? registry_b.try_get<engine::component::TransformComponent>(entity) : nullptr;
+        const bool same = other && other->position_ == transform.position_ &&
+            linkedEntity<TargetComponent>(registry_a, entity) == linkedEntity<TargetComponent>(registry_b, entity) &&
+            linkedEntity<BlockedByComponent>(registry_a, entity) == linkedEntity<BlockedByComponent>(registry_b, entity);
+        if (same) {
+            continue;
+        }
+        ++differing;
+        if (reported >= MAX_REPORTED_ENTITIES) {
+            continue;
+        }
+        ++reported;
+        if (!other) {
+            ENGINE_LOG_ERROR("  实体 {}: 只存在于 {}", entt::to_integral(entity), options_.variant_a_);
+            continue;
+        }
+        ENGINE_LOG_ERROR("  实体 {}: 位置 ({:.3f}, {:.3f}) / ({:.3f}, {:.3f})  目标 {} / {}  阻挡者 {} / {}",
+            entt::to_integral(entity), transform.position_.x, transform.position_.y, other->position_.x, other->position_.y,
+            entt::to_integral(linkedEntity<TargetComponent>(registry_a, entity)), entt::to_integral(linkedEntity<TargetComponent>(registry_b, entity)),
+            entt::to_integral(linkedEntity<BlockedByComponent>(registry_a, entity)), entt::to_integral(linkedEntity<BlockedByComponent>(registry_b, entity)));
+    }
+    ENGINE_LOG_ERROR("  共 {} 个单位的位置、目标或阻挡者不同（以 {} 为准遍历）", differing, options_.variant_a_);
+}
+
+} // namespace game::sim
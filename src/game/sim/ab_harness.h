@@ -0,0 +1,86 @@
+#pragma once
+/**
+ * @file ab_harness.h
+ * @brief 系统实现的 A/B 对比：同一局战斗以两个注册的实现各跑一份，逐步比对状态校验值并统计各自的耗时分布。
+ *
+ * @details
+ * 用于证明一个新的 SetTargetSystem / BlockSystem 实现（见 system_variants.h）既更快、行为又完全相同：
+ * @code
+ * MonsterWar --headless --ab=set_target --variants=default,grid_only --replay=replays/last.mwr
+ * MonsterWar --headless --ab=block --variants=default,default --level=2 --ticks=36000   // 自检：两份应逐步一致
+ * @endcode
+ * 两份 HeadlessSimulation 共享同一份 HeadlessContent 与回放日志，以相同的种子与步长初始化，
+ * 开局状态逐字节相同（包括实体 ID），相当于在同一时刻克隆注册表；之后只有被替换的槽位不同。
+ * 每步两份各推进一次（轮流先后，抵消缓存冷热），比对 StateChecksum：
+ * - 第一个不一致的步记入 AbReport，并列出该步位置、目标或阻挡者不同的前 MAX_REPORTED_ENTITIES 个单位，随后结束
+ *   （之后的分歧只是第一次分歧的后果）
+ * - 槽位耗时逐步记录（HeadlessSimulation::getVariantMs()），结束时输出均值与 p50 / p95 / p99 / max
+ * 有回放时两份还各自与录制的校验值比对，区分「两个实现不一致」与「两个都偏离了录制」。
+ */
+
+#include "headless_simulation.h"
+#include "state_checksum.h"
+#include "system_variants.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace game::sim {
+
+/**
+ * @brief 对比参数
+ */
+struct AbOptions {
+    HeadlessOptions base_;                      ///< 关卡、步数、种子与回放（set_target_variant_ / block_variant_ 被忽略）
+    SystemSlot slot_{ SystemSlot::SET_TARGET };
+    std::string variant_a_{ "default" };        ///< 基准实现
+    std::string variant_b_{ "default" };        ///< 候选实现
+};
+
+/**
+ * @brief 一个实现的槽位耗时分布（毫秒，每步一个样本）
+ */
+struct AbTiming {
+    std::string name_;
+    double mean_ms_{ 0.0 };
+    double p50_ms_{ 0.0 };
+    double p95_ms_{ 0.0 };
+    double p99_ms_{ 0.0 };
+    double max_ms_{ 0.0 };
+    double total_ms_{ 0.0 };
+    std::optional<std::uint64_t> replay_desync_tick_;   ///< 与回放日志第一个不一致的步
+};
+
+/**
+ * @brief 对比结果
+ */
+struct AbReport {
+    bool ok_{ false };                              ///< 两份模拟都初始化成功并跑完
+    std::uint64_t ticks_{ 0 };                      ///< 比对过的步数
+    std::optional<std::uint64_t> divergence_tick_;  ///< 第一个校验值不一致的步（该步执行完之后）
+    std::uint32_t divergence_components_{ 0 };      ///< 不一致的组件类型（StateChecksum::diff）
+    AbTiming a_;
+    AbTiming b_;
+
+    /// @brief 候选相对基准的加速比（按均值），样本为空时为 0
+    [[nodiscard]] double speedup() const { return b_.mean_ms_ > 0.0 ? a_.mean_ms_ / b_.mean_ms_ : 0.0; }
+};
+
+class AbHarness final {
+public:
+    static constexpr std::size_t MAX_REPORTED_ENTITIES = 8;    ///< 分歧时最多列出的单位数
+
+    explicit AbHarness(AbOptions options);
+
+    /// @brief 加载内容并逐步对比，结果同时写入日志
+    [[nodiscard]] AbReport run();
+
+private:
+    /// @brief 分歧时列出两份中同一实体的位置、目标或阻挡者不同的单位
+    void logEntityDifferences(HeadlessSimulation& a, HeadlessSimulation& b) const;
+
+    AbOptions options_;
+};
+
+} // namespace game::sim
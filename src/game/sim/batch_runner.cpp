@@ -0,0 +1,221 @@
+#include "batch_runner.h"
+
+#include "../../engine/core/job_system.h"
+#include "../../engine/utils/logging.h"
+#include "../../engine/utils/profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <spdlog/logger.h>
+
+namespace game::sim {
+
+namespace {
+
+/// @brief 工作线程执行一次模拟期间：日志导向静默日志器、屏蔽分析器，结束时恢复（调用线程也会执行任务）
+class WorkerScope final {
+public:
+    explicit WorkerScope(spdlog::logger* logger) : logger_(logger) {
+        engine::utils::Profiler::setThreadSuppressed(true);
+    }
+    ~WorkerScope() { engine::utils::Profiler::setThreadSuppressed(false); }
+
+    WorkerScope(const WorkerScope&) = delete;
+    WorkerScope& operator=(const WorkerScope&) = delete;
+
+private:
+    engine::utils::log::ScopedThreadLogger logger_;
+};
+
+/// @brief 以分号连接的数值列表（单个 CSV 字段）
+template <typename T>
+void writeJoined(std::ofstream& file, const std::vector<T>& values) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        file << (i > 0 ? ";" : "") << values[i];
+    }
+}
+
+} // namespace
+
+BatchRunner::BatchRunner(BatchOptions options)
+    : options_(std::move(options)) {}
+
+bool BatchRunner::run() {
+    content_ = HeadlessContent::load(options_.level_config_path_, options_.level_index_);
+    if (!content_) {
+        ENGINE_LOG_ERROR("批量模拟: 关卡 {} 加载失败", options_.level_index_ + 1);
+        return false;
+    }
+
+    placements_.clear();
+    for (const auto& path : options_.placement_paths_) {
+        auto replay = std::make_shared<ReplayLog>();
+        std::string error_message;
+        if (!replay->load(path, error_message)) {
+            ENGINE_LOG_ERROR("批量模拟: {}", error_message);
+            return false;
+        }
+        if (replay->header_.level_index_ != options_.level_index_) {
+            ENGINE_LOG_ERROR("批量模拟: 放置方案 {} 录制于关卡 {}，与关卡 {} 不一致",
+                path, replay->header_.level_index_ + 1, options_.level_index_ + 1);
+            return false;
+        }
+        placements_.push_back(std::move(replay));
+    }
+
+    // 展开组合：放置方案 × 敌人等级 × 敌人稀有度 × 种子
+    const auto& level_config = content_->level_config_;
+    const std::vector<int> levels = options_.enemy_levels_.empty() ? std::vector<int>{ level_config.getEnemyLevel() } : options_.enemy_levels_;
+    const std::vector<int> rarities = options_.enemy_rarities_.empty() ? std::vector<int>{ level_config.getEnemyRarity() } : options_.enemy_rarities_;
+    const std::size_t placement_count = std::max<std::size_t>(placements_.size(), 1);
+    results_.clear();
+    results_.reserve(placement_count * levels.size() * rarities.size() * options_.runs_);
+    for (std::size_t placement = 0; placement < placement_count; ++placement) {
+        for (const int level : levels) {
+            for (const int rarity : rarities) {
+                for (std::uint64_t i = 0; i < options_.runs_; ++i) {
+                    BatchRunResult result;
+                    result.placement_ = placement;
+                    result.enemy_level_ = level;
+                    result.enemy_rarity_ = rarity;
+                    result.seed_ = options_.base_seed_ + i;
+                    results_.push_back(result);
+                }
+            }
+        }
+    }
+
+    const std::size_t threads = options_.threads_ > 0 ? options_.threads_ : engine::core::JobSystem::defaultWorkerCount() + 1;
+    ENGINE_LOG_INFO("批量模拟: {}，{} 次模拟（{} 个放置方案 × {} 个敌人等级 × {} 个稀有度 × {} 个种子），{} 个线程",
+        level_config.getName(), results_.size(), placement_count, levels.size(), rarities.size(), options_.runs_, threads);
+
+    // 静默日志器没有 sink 且级别为 off，ENGINE_LOG_* 在格式化之前就返回；不注册到 spdlog 注册表
+    auto quiet_logger = std::make_shared<spdlog::logger>("batch");
+    quiet_logger->set_level(spdlog::level::off);
+
+    const auto start = std::chrono::steady_clock::now();
+    engine::core::JobSystem jobs(threads - 1);  // 调用线程也参与执行
+    jobs.parallelFor(results_.size(), [&](std::size_t index) {
+        WorkerScope scope(quiet_logger.get());
+        auto& result = results_[index];
+
+        HeadlessOptions options;
+        options.level_index_ = options_.level_index_;
+        options.level_config_path_ = options_.level_config_path_;
+        options.ticks_ = options_.max_ticks_;
+        options.fixed_dt_ = options_.fixed_dt_;
+        options.seed_ = result.seed_;
+        options.enemy_level_ = result.enemy_level_;
+        options.enemy_rarity_ = result.enemy_rarity_;
+        options.stop_on_level_clear_ = true;
+        if (!placements_.empty()) {
+            options.replay_ = placements_[result.placement_];
+        }
+
+        HeadlessSimulation simulation(std::move(options), content_);
+        if (!simulation.init()) {
+            return;
+        }
+        result.report_ = simulation.run();
+        result.ok_ = true;
+    });
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto failed = static_cast<std::size_t>(std::ranges::count(results_, false, &BatchRunResult::ok_));
+    ENGINE_LOG_INFO("批量模拟完成: {} 次，失败 {} 次，耗时 {:.2f}s", results_.size(), failed, wall_seconds);
+    return true;
+}
+
+std::vector<BatchRunner::Summary> BatchRunner::summarize() const {
+    std::vector<Summary> summaries;
+    for (const auto& result : results_) {
+        if (!result.ok_) {
+            continue;
+        }
+        auto it = std::ranges::find_if(summaries, [&](const Summary& summary) {
+            return summary.placement_ == result.placement_ && summary.enemy_level_ == result.enemy_level_ &&
+                   summary.enemy_rarity_ == result.enemy_rarity_;
+        });
+        if (it == summaries.end()) {
+            summaries.push_back(Summary{ result.placement_, result.enemy_level_, result.enemy_rarity_ });
+            it = std::prev(summaries.end());
+        }
+        const auto& report = result.report_;
+        ++it->runs_;
+        it->wins_ += report.level_cleared_ ? 1 : 0;
+        it->leaked_ += report.stats_.enemy_arrived_count_;
+        it->home_hp_ += report.stats_.home_hp_;
+        if (it->wave_clear_sum_.size() < report.wave_clear_seconds_.size()) {
+            it->wave_clear_sum_.resize(report.wave_clear_seconds_.size(), 0.0);
+            it->wave_clear_count_.resize(report.wave_clear_seconds_.size(), 0);
+        }
+        for (std::size_t wave = 0; wave < report.wave_clear_seconds_.size(); ++wave) {
+            it->wave_clear_sum_[wave] += report.wave_clear_seconds_[wave];
+            ++it->wave_clear_count_[wave];
+        }
+    }
+    return summaries;
+}
+
+std::string BatchRunner::getSummaryPath() const {
+    std::filesystem::path path(options_.csv_path_);
+    path.replace_extension(".summary.csv");
+    return path.string();
+}
+
+bool BatchRunner::writeCsv() const {
+    auto placementName = [this](std::size_t placement) {
+        return placement < options_.placement_paths_.size() ? options_.placement_paths_[placement] : std::string("-");
+    };
+
+    {
+        std::ofstream file(options_.csv_path_, std::ios::trunc);
+        if (!file.is_open()) {
+            ENGINE_LOG_ERROR("无法写入批量模拟结果: {}", options_.csv_path_);
+            return false;
+        }
+        file << "run,placement,enemy_level,enemy_rarity,seed,ok,cleared,home_hp,waves,killed,leaked,ticks,sim_seconds,wall_ms,wave_clear_seconds\n";
+        for (std::size_t i = 0; i < results_.size(); ++i) {
+            const auto& result = results_[i];
+            const auto& report = result.report_;
+            file << i << ',' << placementName(result.placement_) << ',' << result.enemy_level_ << ',' << result.enemy_rarity_ << ','
+                 << result.seed_ << ',' << (result.ok_ ? 1 : 0) << ',' << (report.level_cleared_ ? 1 : 0) << ','
+                 << report.stats_.home_hp_ << ',' << report.waves_started_ << ',' << report.stats_.enemy_killed_count_ << ','
+                 << report.stats_.enemy_arrived_count_ << ',' << report.ticks_ << ',' << report.simulated_seconds_ << ','
+                 << report.wall_seconds_ * 1000.0 << ',';
+            writeJoined(file, report.wave_clear_seconds_);
+            file << '\n';
+        }
+    }
+
+    const auto summary_path = getSummaryPath();
+    std::ofstream file(summary_path, std::ios::trunc);
+    if (!file.is_open()) {
+        ENGINE_LOG_ERROR("无法写入批量模拟汇总: {}", summary_path);
+        return false;
+    }
+    file << "placement,enemy_level,enemy_rarity,runs,win_rate,avg_leaked,avg_home_hp,avg_wave_clear_seconds\n";
+    for (const auto& summary : summarize()) {
+        const double runs = static_cast<double>(summary.runs_);
+        std::vector<double> wave_average;
+        wave_average.reserve(summary.wave_clear_sum_.size());
+        for (std::size_t wave = 0; wave < summary.wave_clear_sum_.size(); ++wave) {
+            wave_average.push_back(summary.wave_clear_sum_[wave] / static_cast<double>(summary.wave_clear_count_[wave]));
+        }
+        file << placementName(summary.placement_) << ',' << summary.enemy_level_ << ',' << summary.enemy_rarity_ << ','
+             << summary.runs_ << ',' << static_cast<double>(summary.wins_) / runs << ',' << summary.leaked_ / runs << ','
+             << summary.home_hp_ / runs << ',';
+        writeJoined(file, wave_average);
+        file << '\n';
+
+        ENGINE_LOG_INFO("方案 {} 敌人等级 {} 稀有度 {}: 胜率 {:.1f}%，平均漏怪 {:.2f}（{} 次）",
+            placementName(summary.placement_), summary.enemy_level_, summary.enemy_rarity_,
+            100.0 * static_cast<double>(summary.wins_) / runs, summary.leaked_ / runs, summary.runs_);
+    }
+    ENGINE_LOG_INFO("批量模拟结果已写出: {}、{}", options_.csv_path_, summary_path);
+    return true;
+}
+
+} // namespace game::sim
@@ -0,0 +1,99 @@
+#pragma once
+/**
+ * @file batch_runner.h
+ * @brief 多实例并行的无头模拟：同一关卡按种子、放置方案与敌人等级/稀有度组合批量模拟，汇总为 CSV。
+ *
+ * @details
+ * @code
+ * MonsterWar --sweep --level=2 --runs=64 --enemy-levels=1,2,3 --enemy-rarities=1,2 \
+ *            --placements=replays/a.mwr,replays/b.mwr --csv=sweep.csv [--threads=N] [--max-ticks=N]
+ * @endcode
+ * - 关卡与蓝图只加载一次（HeadlessContent），各实例只读共享；每个实例持有独立的注册表、分发器与系统
+ * - 放置方案来自回放日志（放置/升级/撤退等指令原样重放），不指定时不放置任何单位
+ * - 每种组合跑 runs 个种子（base_seed + 0 ... runs - 1），不同组合使用同一组种子，便于成对比较
+ * - 实例作为任务提交到独立的 JobSystem；工作线程上的日志写入无 sink 的静默日志器，分析器计时被屏蔽，
+ *   模拟路径不访问 AudioLocator 与 spdlog 默认日志器
+ *
+ * 输出两份文件：逐次结果 `<csv>` 与按组合汇总的 `<csv 去扩展名>.summary.csv`（胜率、平均漏怪、各波平均清空时间）。
+ */
+
+#include "headless_simulation.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace game::sim {
+
+/**
+ * @brief 批量模拟参数
+ */
+struct BatchOptions {
+    std::size_t level_index_{ 0 };
+    std::string level_config_path_{ "assets/data/level_config.json" };
+    std::uint64_t runs_{ 16 };                                      ///< 每种组合的模拟次数（种子数）
+    std::uint64_t base_seed_{ HeadlessOptions::DEFAULT_SEED };
+    std::vector<int> enemy_levels_;                                 ///< 为空时使用关卡配置
+    std::vector<int> enemy_rarities_;                               ///< 为空时使用关卡配置
+    std::vector<std::string> placement_paths_;                      ///< 提供放置方案的回放日志，为空时不放置单位
+    std::uint64_t max_ticks_{ 60ull * 60ull * 30ull };              ///< 单次模拟的步数上限（全部波次清空或基地被攻破时提前结束）
+    float fixed_dt_{ 1.0f / 60.0f };                                ///< 没有放置方案时的固定步长（有方案时取自回放）
+    std::size_t threads_{ 0 };                                      ///< 工作线程数，0 为 JobSystem::defaultWorkerCount()
+    std::string csv_path_{ "sweep.csv" };
+};
+
+/**
+ * @brief 单次模拟的组合与结果
+ */
+struct BatchRunResult {
+    std::size_t placement_{ 0 };        ///< 放置方案下标（没有方案时为 0）
+    int enemy_level_{ 0 };
+    int enemy_rarity_{ 0 };
+    std::uint64_t seed_{ 0 };
+    bool ok_{ false };                  ///< 初始化成功并跑完
+    HeadlessReport report_;
+};
+
+/**
+ * @class BatchRunner
+ * @brief 展开组合、并行执行并写出结果
+ */
+class BatchRunner final {
+public:
+    explicit BatchRunner(BatchOptions options);
+
+    /// @brief 加载共享内容并执行全部模拟（阻塞）；共享内容或放置方案加载失败时返回 false
+    [[nodiscard]] bool run();
+
+    /// @brief 写出逐次结果与汇总两份 CSV
+    [[nodiscard]] bool writeCsv() const;
+
+    [[nodiscard]] const std::vector<BatchRunResult>& getResults() const { return results_; }
+
+    /// @brief 汇总文件路径：csv_path_ 去掉扩展名后加 ".summary.csv"
+    [[nodiscard]] std::string getSummaryPath() const;
+
+private:
+    /// @brief 按组合分组的汇总
+    struct Summary {
+        std::size_t placement_{ 0 };
+        int enemy_level_{ 0 };
+        int enemy_rarity_{ 0 };
+        std::size_t runs_{ 0 };
+        std::size_t wins_{ 0 };
+        double leaked_{ 0.0 };                      ///< 到达终点的敌人总数
+        double home_hp_{ 0.0 };
+        std::vector<double> wave_clear_sum_;        ///< 各波清空时间之和
+        std::vector<std::size_t> wave_clear_count_; ///< 各波清空的次数
+    };
+
+    [[nodiscard]] std::vector<Summary> summarize() const;
+
+    BatchOptions options_;
+    std::shared_ptr<const HeadlessContent> content_;
+    std::vector<std::shared_ptr<const ReplayLog>> placements_;
+    std::vector<BatchRunResult> results_;
+};
+
+} // namespace game::sim
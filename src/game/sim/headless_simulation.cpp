@@ -0,0 +1,600 @@
+#include "headless_simulation.h"
+#include "system_variants.h"
+
+#include "../component/behavior_component.h"
+#include "../component/enemy_component.h"
+#include "../component/hero_skill_component.h"
+#include "../data/battle_compaction.h"
+#include "../data/class_cost_profiler.h"
+#include "../data/position_cache.h"
+#include "../data/status_effect_store.h"
+#include "../data/injury_queue.h"
+#include "../data/projectile_pool.h"
+#include "../factory/blueprint_manager.h"
+#include "../factory/entity_factory.h"
+#include "../loader/entity_builder_mw.h"
+#include "../defs/groups.h"
+#include "../defs/constants.h"
+#include "../defs/tags.h"
+#include "../system/followpath_system.h"
+#include "../system/remove_dead_system.h"
+#include "../system/block_system.h"
+#include "../system/set_target_system.h"
+#include "../system/timer_system.h"
+#include "../system/attack_starter_system.h"
+#include "../system/projectile_visual_system.h"
+#include "../system/animation_state_system.h"
+#include "../system/orientation_system.h"
+#include "../system/animation_events_system.h"
+#include "../system/combat_resolve_system.h"
+#include "../system/game_rule_system.h"
+#include "../system/hero_skill_system.h"
+#include "../system/spatial_index_system.h"
+#include "../system/status_effect_system.h"
+#include "../system/crowd_separation_system.h"
+#include "../system/projectile_system.h"
+#include "../system/effect_particle_system.h"
+#include "../../engine/component/transform_component.h"
+#include "../../engine/component/velocity_component.h"
+#include "../../engine/system/movement_system.h"
+#include "../../engine/system/animation_system.h"
+#include "../../engine/system/ysort_system.h"
+#include "../../engine/loader/level_loader.h"
+#include "../../engine/spatial/spatial_grid.h"
+#include "../../engine/utils/future_utils.h"
+#include "../../engine/utils/logging.h"
+#include "../../engine/utils/random.h"
+#include <algorithm>
+#include <chrono>
+
+namespace game::sim {
+
+HeadlessSimulation::HeadlessSimulation(HeadlessOptions options, std::shared_ptr<const HeadlessContent> content)
+    : options_(std::move(options)), content_(std::move(content)) {
+    movement_system_ = std::make_unique<engine::system::MovementSystem>();
+    animation_system_ = std::make_unique<engine::system::AnimationSystem>(registry_, dispatcher_);
+    ysort_system_ = std::make_unique<engine::system::YSortSystem>(registry_);
+
+    follow_path_system_ = std::make_unique<game::system::FollowPathSystem>();
+    remove_dead_system_ = std::make_unique<game::system::RemoveDeadSystem>();
+    auto& variants = SystemVariantRegistry::instance();
+    if (options_.block_variant_.empty()) {
+        block_system_ = std::make_unique<game::system::BlockSystem>();
+    } else {
+        block_variant_ = variants.create(SystemSlot::BLOCK, options_.block_variant_, registry_);
+    }
+    if (options_.set_target_variant_.empty()) {
+        set_target_system_ = std::make_unique<game::system::SetTargetSystem>(registry_);
+    } else {
+        set_target_variant_ = variants.create(SystemSlot::SET_TARGET, options_.set_target_variant_, registry_);
+    }
+    timer_system_ = std::make_unique<game::system::TimerSystem>();
+    attack_starter_system_ = std::make_unique<game::system::AttackStarterSystem>();
+    projectile_visual_system_ = std::make_unique<game::system::ProjectileVisualSystem>();
+    animation_state_system_ = std::make_unique<game::system::AnimationStateSystem>(registry_, dispatcher_);
+    orientation_system_ = std::make_unique<game::system::OrientationSystem>();
+    animation_events_system_ = std::make_unique<game::system::AnimationEventsSystem>(registry_, dispatcher_, event_queues_);
+    combat_resolve_system_ = std::make_unique<game::system::CombatResolveSystem>(registry_, dispatcher_, event_queues_);
+    game_rule_system_ = std::make_unique<game::system::GameRuleSystem>(registry_, dispatcher_);
+    hero_skill_system_ = std::make_unique<game::system::HeroSkillSystem>(registry_, dispatcher_, event_queues_);
+    spatial_index_system_ = std::make_unique<game::system::SpatialIndexSystem>();
+    status_effect_system_ = std::make_unique<game::system::StatusEffectSystem>();
+    if (block_system_) {
+        remove_dead_system_->onBeforeDestroy().connect<&game::system::BlockSystem::onEntitiesDestroyed>(*block_system_);
+    } else if (block_variant_) {
+        remove_dead_system_->onBeforeDestroy().connect<&SystemVariant::onEntitiesDestroyed>(*block_variant_);
+    }
+    remove_dead_system_->onBeforeDestroy().connect<&game::system::SpatialIndexSystem::onEntitiesDestroyed>(*spatial_index_system_);
+    remove_dead_system_->onBeforeDestroy().connect<&game::system::StatusEffectSystem::onEntitiesDestroyed>(*status_effect_system_);
+    enemy_counter_.connect(registry_);
+}
+
+HeadlessSimulation::~HeadlessSimulation() {
+    dispatcher_.disconnect(this);
+    enemy_counter_.disconnect(registry_);
+}
+
+std::shared_ptr<const HeadlessContent> HeadlessContent::load(const std::string& level_config_path, std::size_t level_index) {
+    auto content = std::make_shared<HeadlessContent>();
+    if (!content->level_config_.load(level_config_path, level_index)) {
+        return nullptr;
+    }
+
+    auto level_data_future = engine::loader::LevelLoader::loadLevelDataAsync(content->level_config_.getMapPath());
+    engine::loader::LevelLoadData level_data;
+    if (!engine::utils::consumeFuture(
+        level_data_future,
+        [&](engine::loader::LevelLoadData data) {
+            level_data = std::move(data);
+            if (!level_data.valid_) {
+                ENGINE_LOG_ERROR("关卡数据解析失败: {}", level_data.error_message);
+                return false;
+            }
+            return true;
+        },
+        [&](const std::exception& e) {
+            ENGINE_LOG_ERROR("等待关卡数据异步任务失败: {}", e.what());
+            return false;
+        })) {
+        return nullptr;
+    }
+
+    game::loader::EntityBuilderMW::collectWaypoints(level_data, content->waypoint_nodes_, content->start_points_);
+    if (content->start_points_.empty()) {
+        ENGINE_LOG_ERROR("关卡 {} 没有起点路径点，无法模拟", content->level_config_.getMapPath());
+        return nullptr;
+    }
+    content->path_table_.build(content->waypoint_nodes_);
+    if (content->level_config_.getNavigation() == game::defs::NavigationMode::FLOW_FIELD) {
+        // 流场由瓦片图层的 SOLID 格子构建，而无头模拟不创建瓦片图层
+        ENGINE_LOG_WARN("无头模拟不支持流场导航，关卡 {} 的敌人沿路径点前进", content->level_config_.getName());
+    }
+
+    content->blueprint_manager_ = std::make_shared<game::factory::BlueprintManager>();
+    auto& blueprints = *content->blueprint_manager_;
+    if (!blueprints.loadAll()) {
+        ENGINE_LOG_ERROR("蓝图资源加载失败");
+        return nullptr;
+    }
+    return content;
+}
+
+bool HeadlessSimulation::init() {
+    const auto check_variant = [](SystemSlot slot, const std::string& name, const SystemVariant* variant) {
+        if (name.empty() || variant) {
+            return true;
+        }
+        std::string known;
+        for (const auto registered : SystemVariantRegistry::instance().names(slot)) {
+            known += known.empty() ? "" : ", ";
+            known += registered;
+        }
+        ENGINE_LOG_ERROR("{} 没有名为 {} 的实现（已注册: {}）", systemSlotName(slot), name, known);
+        return false;
+    };
+    if (!check_variant(SystemSlot::SET_TARGET, options_.set_target_variant_, set_target_variant_.get()) ||
+        !check_variant(SystemSlot::BLOCK, options_.block_variant_, block_variant_.get())) {
+        return false;
+    }
+    if (!options_.replay_ && !options_.replay_path_.empty()) {
+        auto replay = std::make_shared<ReplayLog>();
+        std::string error_message;
+        if (!replay->load(options_.replay_path_, error_message)) {
+            ENGINE_LOG_ERROR("{}", error_message);
+            return false;
+        }
+        options_.replay_ = std::move(replay);
+    }
+    if (options_.replay_) {
+        const auto& header = options_.replay_->header_;
+        options_.level_index_ = header.level_index_;
+        options_.fixed_dt_ = header.delta_time_;
+        if (options_.ticks_ == 0) {
+            options_.ticks_ = header.tick_count_;
+        }
+        if (!options_.seed_) {
+            options_.seed_ = header.seed_;
+        }
+        ENGINE_LOG_INFO("重放 {}: 关卡 {}，{} 步，{} 条指令", options_.replay_path_,
+            options_.level_index_ + 1, header.tick_count_, options_.replay_->commands_.size());
+        replay_ = options_.replay_;
+    } else {
+        replay_ = std::make_shared<ReplayLog>();
+    }
+    delta_time_ = options_.fixed_dt_;
+
+    if (!content_) {
+        content_ = HeadlessContent::load(options_.level_config_path_, options_.level_index_);
+        if (!content_) {
+            return false;
+        }
+    } else if (content_->level_config_.getLevelIndex() != options_.level_index_) {
+        ENGINE_LOG_ERROR("共享关卡内容是关卡 {}，与模拟参数的关卡 {} 不一致",
+            content_->level_config_.getLevelIndex() + 1, options_.level_index_ + 1);
+        return false;
+    }
+    const auto& level_config = content_->level_config_;
+    if (level_config.isCrowdSeparationEnabled()) {
+        crowd_separation_system_ = std::make_unique<game::system::CrowdSeparationSystem>();
+        follow_path_system_->setPathSkipping(false);
+    }
+
+    game::defs::declareGroups(registry_);
+    entity_factory_ = std::make_unique<game::factory::EntityFactory>(registry_, *content_->blueprint_manager_);
+    entity_factory_->prewarmVisualPools();
+    projectile_system_ = std::make_unique<game::system::ProjectileSystem>(registry_, event_queues_, entity_factory_.get());
+    effect_particle_system_ = std::make_unique<game::system::EffectParticleSystem>();
+    effect_particle_system_->registerEmitters(*content_->blueprint_manager_);
+
+    // 无头模式没有放置点瓦片，玩家单位数取回放中的放置指令数
+    auto placements = static_cast<std::size_t>(std::ranges::count(replay_->commands_, ReplayCommandType::PLACE_UNIT, &ReplayCommand::type_));
+    for (const auto& spec : options_.extra_units_) {
+        placements += spec.count_;
+    }
+    capacity_planner_.apply(registry_, game::factory::CapacityPlanner::plan(level_config.getWaves(), placements));
+
+    registry_.ctx().emplace<std::shared_ptr<game::factory::BlueprintManager>>(content_->blueprint_manager_);
+    registry_.ctx().emplace<game::data::GameStats&>(game_stats_);
+    registry_.ctx().emplace<game::data::BehaviorIndex&>(behaviors_);
+    registry_.ctx().emplace<engine::spatial::SpatialGrid>(game::defs::BLOCK_RADIUS * 2.0f);
+    registry_.ctx().emplace<game::data::PositionCache>();
+    registry_.ctx().emplace<game::data::StatusEffectStore>();
+    registry_.ctx().emplace<game::data::InjuryQueue>();
+    if (game::data::isCostAttributionEnabled()) {
+        registry_.ctx().emplace<game::data::ClassCostProfiler>();
+    }
+    game::system::ProjectileSystem::registerKinds(registry_.ctx().emplace<game::data::ProjectilePool>(), *content_->blueprint_manager_);
+    const auto seed = options_.seed_.value_or(level_config.getSeed().value_or(HeadlessOptions::DEFAULT_SEED));
+    registry_.ctx().emplace<engine::utils::RandomService>(seed);
+    auto& timers = registry_.ctx().emplace<engine::core::TimerWheel>(delta_time_);
+    ENGINE_LOG_INFO("无头模拟随机种子: {}", seed);
+
+    dispatcher_.sink<game::defs::SpawnProjectileVisualEvent>().connect<&HeadlessSimulation::onSpawnProjectileVisual>(this);
+    dispatcher_.sink<game::defs::SpawnEffectVisualEvent>().connect<&HeadlessSimulation::onSpawnEffectVisual>(this);
+    dispatcher_.sink<game::defs::RemovePlayerUnitEvent>().connect<&HeadlessSimulation::onRemovePlayerUnit>(this);
+
+    game_stats_.home_hp_ = game::defs::INITIAL_BASE_HP;
+    game_stats_.cost_ = static_cast<float>(game::defs::INITIAL_GOLD);
+    game_stats_.cost_gen_per_second_ = 1.0f;
+    wave_break_duration_ = level_config.getPrepTime();
+    wave_timer_ = timers.scheduleAfter(timers.ticksFor(wave_break_duration_), entt::null, game::defs::timer_event::WAVE_BREAK);
+
+    placeExtraUnits();
+    for (const auto& spec : options_.extra_enemies_) {
+        extra_enemy_queue_.insert(extra_enemy_queue_.end(), spec.count_, &spec);
+    }
+    if (!extra_enemy_queue_.empty()) {
+        entity_factory_->reserveEnemyUnits(extra_enemy_queue_.size());
+        game_stats_.enemy_count_ += static_cast<int>(extra_enemy_queue_.size());
+    }
+
+    ENGINE_LOG_INFO("无头模拟初始化完成: {}，路径点 {}，起点 {}，波次 {}",
+        level_config.getName(), content_->waypoint_nodes_.size(), content_->start_points_.size(), level_config.getWaves().size());
+    return true;
+}
+
+void HeadlessSimulation::step() {
+    applyReplayCommands();
+    const float delta_time = delta_time_;
+
+    // 与 GameScene::simulate 的顺序保持一致
+    dispatcher_.update();
+    event_queues_.flush();
+    combat_resolve_system_->resolve();
+
+    registry_.ctx().get<engine::core::TimerWheel>().advance();
+    game_rule_system_->update(delta_time);
+    hero_skill_system_->update(delta_time);
+    updateWaveFlow();
+    spawnExtraEnemies();
+    if (options_.auto_release_skills_) {
+        releaseReadySkills();
+    }
+
+    remove_dead_system_->update(registry_);
+    status_effect_system_->update(registry_, event_queues_, delta_time);
+
+    // 无头模拟没有相机，不做模拟细节切换；低细节的跳过与逐步更新结果相同，回放不受影响
+    follow_path_system_->update(registry_, dispatcher_, content_->path_table_, delta_time);
+    variant_ms_ = 0.0;
+    if (block_variant_) {
+        runVariant(*block_variant_);
+    } else {
+        block_system_->update(registry_, command_buffer_);
+    }
+    command_buffer_.apply(registry_);
+
+    if (set_target_variant_) {
+        runVariant(*set_target_variant_);
+    } else {
+        set_target_system_->update(registry_, command_buffer_);
+    }
+    command_buffer_.apply(registry_);
+    timer_system_->update(registry_, dispatcher_, delta_time);
+    attack_starter_system_->update(registry_, command_buffer_);
+    command_buffer_.apply(registry_);
+    projectile_visual_system_->update(registry_, delta_time);
+    if (crowd_separation_system_) {
+        crowd_separation_system_->update(registry_);
+    }
+
+    movement_system_->update(registry_, delta_time);
+    spatial_index_system_->update(registry_);
+    projectile_system_->update(delta_time);
+    animation_system_->update(delta_time);
+    effect_particle_system_->update(delta_time);
+
+    orientation_system_->update(registry_);
+    ysort_system_->update(registry_);
+    verifyReplayChecksum();
+
+    ++tick_;
+    simulated_seconds_ += delta_time;
+    peak_entities_ = std::max(peak_entities_, registry_.storage<entt::entity>().size());
+    capacity_planner_.sample();
+    if (auto* costs = registry_.ctx().find<game::data::ClassCostProfiler>()) {
+        costs->sampleTick(registry_, delta_time);
+    }
+}
+
+HeadlessReport HeadlessSimulation::run() {
+    HeadlessReport report;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < options_.ticks_; ++i) {
+        const auto step_start = std::chrono::steady_clock::now();
+        step();
+        const double step_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - step_start).count();
+        if (step_ms > report.slowest_tick_ms_) {
+            report.slowest_tick_ms_ = step_ms;
+            report.slowest_tick_ = i;
+        }
+        if (options_.stop_on_game_over_ && game_stats_.home_hp_ <= 0) {
+            ENGINE_LOG_INFO("基地生命耗尽，模拟在第 {} 步结束", tick_);
+            break;
+        }
+        if (options_.stop_on_desync_ && desync_tick_) {
+            break;
+        }
+        if (options_.stop_on_level_clear_ && isLevelCleared()) {
+            ENGINE_LOG_INFO("全部 {} 波已清空，模拟在第 {} 步结束", wave_clear_seconds_.size(), tick_);
+            break;
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    report.ticks_ = tick_;
+    report.simulated_seconds_ = simulated_seconds_;
+    report.wall_seconds_ = std::chrono::duration<double>(end - start).count();
+    report.ticks_per_second_ = report.wall_seconds_ > 0.0 ? static_cast<double>(tick_) / report.wall_seconds_ : 0.0;
+    report.waves_started_ = current_wave_;
+    report.alive_entities_ = registry_.storage<entt::entity>().size();
+    report.peak_entities_ = peak_entities_;
+    report.level_cleared_ = isLevelCleared();
+    report.wave_clear_seconds_ = wave_clear_seconds_;
+    report.stats_ = game_stats_;
+    report.replay_commands_ = next_replay_command_;
+    report.checksums_verified_ = checksums_verified_;
+    report.desync_tick_ = desync_tick_;
+    report.desync_components_ = desync_components_;
+    capacity_planner_.report();
+    if (const auto* costs = registry_.ctx().find<game::data::ClassCostProfiler>()) {
+        costs->report();
+    }
+    return report;
+}
+
+StateChecksum HeadlessSimulation::computeChecksum() const {
+    return computeStateChecksum(registry_, game_stats_);
+}
+
+void HeadlessSimulation::runVariant(SystemVariant& variant) {
+    const auto start = std::chrono::steady_clock::now();
+    variant.update(registry_, command_buffer_);
+    variant_ms_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool HeadlessSimulation::isLevelCleared() const {
+    const auto wave_count = content_->level_config_.getWaves().size();
+    return game_stats_.home_hp_ > 0 && wave_count > 0 && wave_clear_seconds_.size() >= wave_count;
+}
+
+void HeadlessSimulation::applyReplayCommands() {
+    const auto& commands = replay_->commands_;
+    for (; next_replay_command_ < commands.size() && commands[next_replay_command_].tick_ <= tick_; ++next_replay_command_) {
+        const auto& command = commands[next_replay_command_];
+        const auto unit = command.unit_ < placed_units_.size() ? placed_units_[command.unit_] : entt::entity{ entt::null };
+        switch (command.type_) {
+        case ReplayCommandType::SET_DELTA_TIME:
+            delta_time_ = command.delta_time_;
+            break;
+        case ReplayCommandType::PLACE_UNIT: {
+            // 放置点已在录制时解析，这里直接按记录的位置创建（无头模式不加载放置点瓦片）
+            game_stats_.cost_ -= static_cast<float>(command.cost_);
+            const auto entity = entity_factory_->createPlayerUnit(command.class_id_, command.position_, command.level_, command.rarity_);
+            if (entity == entt::null) {
+                game_stats_.cost_ += static_cast<float>(command.cost_);
+                ENGINE_LOG_WARN("重放第 {} 步放置单位失败: class_id={}", tick_, command.class_id_);
+            }
+            placed_units_.push_back(entity);
+            break;
+        }
+        case ReplayCommandType::UPGRADE_UNIT:
+            dispatcher_.enqueue(game::defs::UpgradeUnitEvent{ unit, command.cost_ });
+            break;
+        case ReplayCommandType::RETREAT_UNIT:
+            dispatcher_.enqueue(game::defs::RetreatEvent{ unit, command.cost_ });
+            break;
+        case ReplayCommandType::RELEASE_SKILL:
+            dispatcher_.enqueue(game::defs::ReleaseHeroSkillEvent{ unit });
+            break;
+        case ReplayCommandType::CHECKSUM:
+            break;
+        }
+    }
+}
+
+void HeadlessSimulation::verifyReplayChecksum() {
+    const auto& checksums = replay_->checksums_;
+    while (next_replay_checksum_ < checksums.size() && checksums[next_replay_checksum_].tick_ < tick_) {
+        ++next_replay_checksum_;
+    }
+    if (desync_tick_ || next_replay_checksum_ >= checksums.size() || checksums[next_replay_checksum_].tick_ != tick_) {
+        return;
+    }
+    const auto& expected = checksums[next_replay_checksum_++];
+    const auto mask = computeStateChecksum(registry_, game_stats_).diff(expected.checksum_);
+    if (mask == 0) {
+        ++checksums_verified_;
+        return;
+    }
+    desync_tick_ = tick_;
+    desync_components_ = mask;
+    const auto previous_tick = next_replay_checksum_ >= 2 ? checksums[next_replay_checksum_ - 2].tick_ : 0;
+    ENGINE_LOG_ERROR("重放失步: 第 {} 步的状态与录制时不一致（{}），分歧发生在第 {} 步之后；此前 {} 个校验值一致",
+        tick_, describeChecksumDiff(mask), previous_tick, checksums_verified_);
+}
+
+void HeadlessSimulation::updateWaveFlow() {
+    if (content_->level_config_.getWaves().empty()) {
+        return;
+    }
+
+    auto& timers = registry_.ctx().get<engine::core::TimerWheel>();
+    for (const auto& expiry : timers.getExpired()) {
+        if (expiry.event_ == game::defs::timer_event::WAVE_BREAK) {
+            startNextWave();
+        } else if (expiry.event_ == game::defs::timer_event::WAVE_SPAWN) {
+            if (const auto batch = wave_spawner_.onTimer(expiry, timers)) {
+                spawnEnemies(*batch);
+            }
+        }
+    }
+
+    if (!wave_running_ || wave_spawner_.isSpawning()) {
+        return;
+    }
+    if (enemy_counter_.get() == 0) {
+        wave_running_ = false;
+        wave_timer_ = timers.scheduleAfter(timers.ticksFor(wave_break_duration_), entt::null, game::defs::timer_event::WAVE_BREAK);
+        wave_clear_seconds_.push_back(static_cast<float>(simulated_seconds_ - wave_start_seconds_));
+        // 与 GameScene::compactStorages() 同一步重排存储，遍历顺序保持一致
+        game::data::compactBattleStorages(registry_,
+            game::factory::CapacityPlanner::upcomingEnemies(content_->level_config_.getWaves(), static_cast<std::size_t>(current_wave_)));
+    }
+}
+
+void HeadlessSimulation::startNextWave() {
+    ++current_wave_;
+    const auto& waves = content_->level_config_.getWaves();
+    const auto& wave = waves[(current_wave_ - 1) % waves.size()];
+    wave_break_duration_ = wave.next_wave_interval_;
+    entity_factory_->reserveEnemyUnits(wave.enemy_count_);
+    wave_spawner_.start(wave, registry_.ctx().get<engine::core::TimerWheel>());
+    wave_running_ = true;
+    wave_start_seconds_ = simulated_seconds_;
+    game_stats_.enemy_count_ += static_cast<int>(wave.enemy_count_);
+}
+
+void HeadlessSimulation::spawnEnemies(const game::data::SpawnBatch& batch) {
+    const auto& start_points = content_->start_points_;
+    if (start_points.empty()) {
+        return;
+    }
+    const auto& level_config = content_->level_config_;
+    const int enemy_level = options_.enemy_level_.value_or(level_config.getEnemyLevel());
+    const int enemy_rarity = options_.enemy_rarity_.value_or(level_config.getEnemyRarity());
+
+    spawn_positions_.clear();
+    spawn_waypoints_.clear();
+    for (std::size_t i = 0; i < batch.count_; ++i) {
+        const auto start_index = start_points[batch.startSlot(i, current_wave_, start_points.size())];
+        spawn_positions_.push_back(content_->waypoint_nodes_.at(start_index).position_);
+        spawn_waypoints_.push_back(start_index);
+    }
+    if (entity_factory_->createEnemyUnits(batch.class_id_, spawn_positions_, spawn_waypoints_, enemy_level, enemy_rarity).empty()) {
+        ENGINE_LOG_ERROR("敌人生成失败: {}", batch.class_id_);
+    }
+}
+
+void HeadlessSimulation::placeExtraUnits() {
+    if (options_.extra_units_.empty()) {
+        return;
+    }
+    // 按路径点 id 排序，保证同一关卡、同一参数的摆放结果确定
+    std::vector<glm::vec2> anchors;
+    anchors.reserve(content_->waypoint_nodes_.size());
+    std::vector<int> ids;
+    ids.reserve(content_->waypoint_nodes_.size());
+    for (const auto& [id, node] : content_->waypoint_nodes_) {
+        ids.push_back(id);
+    }
+    std::ranges::sort(ids);
+    for (const int id : ids) {
+        anchors.push_back(content_->waypoint_nodes_.at(id).position_);
+    }
+    if (anchors.empty()) {
+        return;
+    }
+
+    constexpr float SPACING = 40.0f;
+    std::size_t index = 0;
+    std::size_t placed = 0;
+    for (const auto& spec : options_.extra_units_) {
+        for (std::size_t i = 0; i < spec.count_; ++i, ++index) {
+            // 每个路径点依次放在上、下两侧，一圈放满后向外扩一格
+            const auto ring = index / anchors.size();
+            const float side = ring % 2 == 0 ? -1.0f : 1.0f;
+            const float offset = SPACING * static_cast<float>(ring / 2 + 1);
+            const auto position = anchors[index % anchors.size()] + glm::vec2{ 0.0f, side * offset };
+            if (entity_factory_->createPlayerUnit(spec.class_id_, position, spec.level_, spec.rarity_) != entt::null) {
+                ++placed;
+            }
+        }
+    }
+    ENGINE_LOG_INFO("无头模拟追加放置单位 {}/{} 个", placed, index);
+}
+
+void HeadlessSimulation::spawnExtraEnemies() {
+    const auto& start_points = content_->start_points_;
+    const auto end = std::min(extra_enemy_queue_.size(), extra_enemy_index_ + options_.extra_enemies_per_tick_);
+    while (extra_enemy_index_ < end) {
+        const auto* spec = extra_enemy_queue_[extra_enemy_index_];
+        spawn_positions_.clear();
+        spawn_waypoints_.clear();
+        while (extra_enemy_index_ < end && extra_enemy_queue_[extra_enemy_index_] == spec) {
+            const auto start_index = start_points[extra_enemy_index_ % start_points.size()];
+            spawn_positions_.push_back(content_->waypoint_nodes_.at(start_index).position_);
+            spawn_waypoints_.push_back(start_index);
+            ++extra_enemy_index_;
+        }
+        if (entity_factory_->createEnemyUnits(spec->class_id_, spawn_positions_, spawn_waypoints_, spec->level_, spec->rarity_).empty()) {
+            ENGINE_LOG_ERROR("额外敌人生成失败: {}", spec->class_id_);
+        }
+    }
+}
+
+void HeadlessSimulation::releaseReadySkills() {
+    // 事件在下一步的 dispatcher_.update() 中处理并清除 SKILL_READY，同一单位不会重复排队
+    auto view = registry_.view<game::component::HeroSkillComponent, game::component::BehaviorComponent>(entt::exclude<game::defs::DeadTag>);
+    for (auto [entity, skill, behavior] : view.each()) {
+        if (behavior.hasFlag(game::component::behavior_flag::SKILL_READY)) {
+            dispatcher_.enqueue(game::defs::ReleaseHeroSkillEvent{ entity });
+        }
+    }
+}
+
+void HeadlessSimulation::onSpawnProjectileVisual(const game::defs::SpawnProjectileVisualEvent& event) {
+    if (!registry_.valid(event.source_entity_) || !registry_.valid(event.target_entity_)) {
+        return;
+    }
+
+    const auto* source_transform = registry_.try_get<engine::component::TransformComponent>(event.source_entity_);
+    const auto* target_transform = registry_.try_get<engine::component::TransformComponent>(event.target_entity_);
+    if (!source_transform || !target_transform) {
+        return;
+    }
+
+    const auto* target_velocity = registry_.try_get<engine::component::VelocityComponent>(event.target_entity_);
+    const glm::vec2 target_velocity_value = target_velocity ? target_velocity->velocity_ : glm::vec2{ 0.0f, 0.0f };
+    entity_factory_->createProjectileVisual(event.projectile_id_, source_transform->position_, target_transform->position_, target_velocity_value);
+}
+
+void HeadlessSimulation::onSpawnEffectVisual(const game::defs::SpawnEffectVisualEvent& event) {
+    if (!registry_.valid(event.target_entity_)) {
+        return;
+    }
+
+    if (const auto* target_transform = registry_.try_get<engine::component::TransformComponent>(event.target_entity_)) {
+        if (!effect_particle_system_->spawn(event.effect_id_, target_transform->position_)) {
+            entity_factory_->createEffectVisual(event.effect_id_, target_transform->position_);
+        }
+    }
+}
+
+void HeadlessSimulation::onRemovePlayerUnit(const game::defs::RemovePlayerUnitEvent& event) {
+    if (registry_.valid(event.entity_) && !registry_.all_of<game::defs::DeadTag>(event.entity_)) {
+        registry_.emplace<game::defs::DeadTag>(event.entity_);
+    }
+}
+
+} // namespace game::sim
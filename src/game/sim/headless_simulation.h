@@ -0,0 +1,258 @@
+#pragma once
+/**
+ * @file headless_simulation.h
+ * @brief 无头定步长模拟：不创建窗口、渲染器与音频，按固定 dt 尽可能快地推进战斗逻辑。
+ *
+ * @details
+ * 用于平衡性批量模拟与模拟吞吐量回归测试：
+ * @code
+ * MonsterWar --headless --ticks=36000 --level=2 [--dt=0.016667]
+ * MonsterWar --headless --replay=replays/last.mwr      // 重放录制的一局，关卡/步长/种子取自日志
+ * @endcode
+ * 重放时逐一比对日志中的状态校验值，报告第一个不一致的步与组件类型（见 state_checksum.h）。
+ * 关卡通过 LevelLoader::loadLevelDataAsync 解析（只提取路径点，不创建瓦片实体），
+ * 蓝图通过不预加载资源的 BlueprintManager 读取，系统更新顺序与 GameScene::update 保持一致
+ * （去掉依赖输入的 SelectionSystem / PlaceUnitSystem 以及渲染、音频系统）。
+ *
+ * 关卡与蓝图打包为只读的 HeadlessContent，多个实例（见 BatchRunner）可共享同一份，各自只持有注册表、
+ * 分发器与系统；模拟路径不访问 AudioLocator，日志经 ENGINE_LOG_* 写入当前线程的日志器。
+ */
+
+#include "../data/behavior_index.h"
+#include "../data/game_stats.h"
+#include "../data/level_config.h"
+#include "../data/wave_spawner.h"
+#include "../data/alive_counter.h"
+#include "../component/enemy_component.h"
+#include "../data/path_table.h"
+#include "../data/waypoint_node.h"
+#include "../defs/event.h"
+#include "../factory/capacity_planner.h"
+#include "replay_log.h"
+#include "state_checksum.h"
+#include "../system/fwd.h"
+#include "../../engine/core/timer_wheel.h"
+#include "../../engine/ecs/command_buffer.h"
+#include "../../engine/ecs/event_queues.h"
+#include "../../engine/system/fwd.h"
+#include <entt/entity/registry.hpp>
+#include <entt/signal/dispatcher.hpp>
+#include <glm/vec2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace game::factory {
+    class BlueprintManager;
+    class EntityFactory;
+}
+
+namespace game::sim {
+
+class SystemVariant;
+
+/**
+ * @brief 可在多个模拟实例间共享的只读内容：关卡配置、路径点、路径表与蓝图
+ */
+struct HeadlessContent {
+    game::data::LevelConfig level_config_;
+    std::unordered_map<int, game::data::WaypointNode> waypoint_nodes_;
+    std::vector<int> start_points_;
+    game::data::PathTable path_table_;
+    std::shared_ptr<game::factory::BlueprintManager> blueprint_manager_;    ///< 加载完成后只读
+
+    /// @brief 加载第 level_index 个关卡的配置、地图路径点与全部蓝图，失败时返回空
+    [[nodiscard]] static std::shared_ptr<const HeadlessContent> load(const std::string& level_config_path, std::size_t level_index);
+};
+
+/**
+ * @brief 压力场景追加的一组单位（见 PerfScenarioRunner）
+ */
+struct HeadlessUnitSpec {
+    entt::id_type class_id_{ 0 };
+    std::size_t count_{ 0 };
+    int level_{ 1 };
+    int rarity_{ 1 };
+};
+
+/**
+ * @brief 无头模拟参数
+ */
+struct HeadlessOptions {
+    static constexpr std::uint64_t DEFAULT_SEED = 0x4D6F6E7374657257ull;    ///< 未指定种子时使用（保证批量模拟可复现）
+
+    std::uint64_t ticks_{ 3600 };                                   ///< 模拟步数（重放时为 0 表示使用日志的步数）
+    std::size_t level_index_{ 0 };                                  ///< 关卡下标（命令行 --level 从 1 开始）
+    float fixed_dt_{ 1.0f / 60.0f };                                ///< 固定步长（秒）
+    bool stop_on_game_over_{ true };                                ///< 基地生命耗尽时提前结束
+    std::string level_config_path_{ "assets/data/level_config.json" };
+    std::string replay_path_;                                       ///< 非空时重放该回放日志
+    std::shared_ptr<const ReplayLog> replay_;                       ///< 已加载的回放日志（优先于 replay_path_，批量模拟共享）
+    std::optional<std::uint64_t> seed_;                             ///< 随机种子：依次取本项、回放日志、关卡配置、DEFAULT_SEED
+    std::optional<int> enemy_level_;                                ///< 覆盖关卡配置的敌人等级
+    std::optional<int> enemy_rarity_;                               ///< 覆盖关卡配置的敌人稀有度
+    bool stop_on_level_clear_{ false };                             ///< 最后一波（关卡配置中的波次数）清空后结束
+    std::vector<HeadlessUnitSpec> extra_units_;                     ///< 开局直接放置的玩家单位（不扣点数），沿路径点两侧排开
+    std::vector<HeadlessUnitSpec> extra_enemies_;                   ///< 开局起额外刷出的敌人，与关卡波次并行
+    std::size_t extra_enemies_per_tick_{ 10 };                      ///< 额外敌人每步刷出的数量（轮流从各起点出发）
+    bool auto_release_skills_{ false };                             ///< 技能就绪（behavior_flag::SKILL_READY）的单位每步自动释放
+    bool stop_on_desync_{ true };                                   ///< 与回放日志的校验值不一致时结束（之后的结果已无意义）
+    std::string set_target_variant_;                                ///< 非空时以注册的同名实现代替 SetTargetSystem（见 system_variants.h）
+    std::string block_variant_;                                     ///< 非空时以注册的同名实现代替 BlockSystem
+};
+
+/**
+ * @brief 无头模拟结果
+ */
+struct HeadlessReport {
+    std::uint64_t ticks_{ 0 };          ///< 实际执行的步数
+    double simulated_seconds_{ 0.0 };   ///< 模拟的游戏时间
+    double wall_seconds_{ 0.0 };        ///< 实际耗时
+    double ticks_per_second_{ 0.0 };
+    int waves_started_{ 0 };
+    std::uint64_t slowest_tick_{ 0 };   ///< 耗时最长的一步（用于定位卡顿帧）
+    double slowest_tick_ms_{ 0.0 };
+    std::size_t replay_commands_{ 0 };  ///< 已应用的回放指令数
+    std::size_t checksums_verified_{ 0 };           ///< 与回放日志一致的校验值个数
+    std::optional<std::uint64_t> desync_tick_;      ///< 第一个不一致的校验值所在的步（之前一个记录的步之后开始分歧）
+    std::uint32_t desync_components_{ 0 };          ///< 不一致的组件类型（StateChecksum::diff）
+    std::size_t alive_entities_{ 0 };   ///< 结束时的实体数量
+    std::size_t peak_entities_{ 0 };    ///< 模拟期间实体数量峰值
+    bool level_cleared_{ false };       ///< 关卡配置的全部波次都已清空（且基地未被攻破）
+    std::vector<float> wave_clear_seconds_;     ///< 各波从开始到清空的游戏时间（秒），未清空的波次不记录
+    game::data::GameStats stats_;       ///< 结束时的战况
+};
+
+/**
+ * @class HeadlessSimulation
+ * @brief 持有独立的注册表与分发器，按固定步长推进关卡模拟
+ */
+class HeadlessSimulation final {
+public:
+    /**
+     * @param options 模拟参数
+     * @param content 共享的关卡与蓝图；为空时 init() 按 options 自行加载
+     */
+    explicit HeadlessSimulation(HeadlessOptions options, std::shared_ptr<const HeadlessContent> content = nullptr);
+    ~HeadlessSimulation();
+
+    HeadlessSimulation(const HeadlessSimulation&) = delete;
+    HeadlessSimulation& operator=(const HeadlessSimulation&) = delete;
+
+    /// @brief 加载回放与（未共享时的）关卡内容，创建工厂并初始化注册表上下文
+    [[nodiscard]] bool init();
+
+    /// @brief 推进一个固定步长
+    void step();
+
+    /// @brief 执行全部步数并返回结果
+    [[nodiscard]] HeadlessReport run();
+
+    [[nodiscard]] entt::registry& getRegistry() { return registry_; }
+    [[nodiscard]] const game::data::GameStats& getGameStats() const { return game_stats_; }
+    /// @brief 已执行的步数
+    [[nodiscard]] std::uint64_t getTick() const { return tick_; }
+    /// @brief 要执行的步数（init() 之后，重放时已按日志补全）
+    [[nodiscard]] std::uint64_t getTickLimit() const { return options_.ticks_; }
+    /// @brief 第一个与回放日志不一致的校验值所在的步
+    [[nodiscard]] std::optional<std::uint64_t> getDesyncTick() const { return desync_tick_; }
+    /// @brief 当前状态的校验值
+    [[nodiscard]] StateChecksum computeChecksum() const;
+    /// @brief 上一步中被替换槽位（set_target_variant_ / block_variant_）的耗时（毫秒），没有替换时为 0
+    [[nodiscard]] double getVariantMs() const { return variant_ms_; }
+
+private:
+    /// @brief 同 GameScene::updateWaveFlow（没有横幅）
+    void updateWaveFlow();
+    void startNextWave();
+    /// @brief 同 GameScene::spawnEnemies
+    void spawnEnemies(const game::data::SpawnBatch& batch);
+    /// @brief 应用 tick 等于当前步的回放指令
+    void applyReplayCommands();
+    /// @brief 本步执行完后与回放日志中同一步的校验值比对
+    void verifyReplayChecksum();
+    /// @brief 按 extra_units_ 放置单位：第 i 个单位放在第 i % N 个路径点旁，逐圈外扩
+    void placeExtraUnits();
+    /// @brief 从 extra_enemies_ 的队列中刷出本步的敌人
+    void spawnExtraEnemies();
+    /// @brief 为技能就绪的单位排队 ReleaseHeroSkillEvent
+    void releaseReadySkills();
+    /// @brief 执行替换槽位的实现并累计 variant_ms_
+    void runVariant(SystemVariant& variant);
+    /// @brief 关卡配置的每一波都已清空且基地未被攻破
+    [[nodiscard]] bool isLevelCleared() const;
+
+    // 事件回调函数
+    void onSpawnProjectileVisual(const game::defs::SpawnProjectileVisualEvent& event);
+    void onSpawnEffectVisual(const game::defs::SpawnEffectVisualEvent& event);
+    void onRemovePlayerUnit(const game::defs::RemovePlayerUnitEvent& event);
+
+    HeadlessOptions options_;
+    entt::registry registry_;
+    game::data::BehaviorIndex behaviors_{ registry_ };     ///< 按行为状态的单位列表（在注册表之后声明，先于注册表析构）
+    entt::dispatcher dispatcher_;
+    engine::ecs::CommandBuffer command_buffer_;     ///< 战斗循环系统的延迟结构性修改
+    engine::ecs::EventQueues event_queues_;         ///< 命中/治疗事件的批量通道
+    game::data::GameStats game_stats_;
+
+    std::shared_ptr<const HeadlessContent> content_;
+    std::unique_ptr<game::factory::EntityFactory> entity_factory_;
+    game::factory::CapacityPlanner capacity_planner_;
+
+    std::unique_ptr<engine::system::MovementSystem> movement_system_;
+    std::unique_ptr<engine::system::AnimationSystem> animation_system_;
+    std::unique_ptr<engine::system::YSortSystem> ysort_system_;
+    std::unique_ptr<game::system::FollowPathSystem> follow_path_system_;
+    std::unique_ptr<game::system::RemoveDeadSystem> remove_dead_system_;
+    std::unique_ptr<game::system::BlockSystem> block_system_;
+    std::unique_ptr<game::system::SetTargetSystem> set_target_system_;
+    std::unique_ptr<game::system::TimerSystem> timer_system_;
+    std::unique_ptr<game::system::AttackStarterSystem> attack_starter_system_;
+    std::unique_ptr<game::system::ProjectileVisualSystem> projectile_visual_system_;
+    std::unique_ptr<game::system::AnimationStateSystem> animation_state_system_;
+    std::unique_ptr<game::system::OrientationSystem> orientation_system_;
+    std::unique_ptr<game::system::AnimationEventsSystem> animation_events_system_;
+    std::unique_ptr<game::system::CombatResolveSystem> combat_resolve_system_;
+    std::unique_ptr<game::system::GameRuleSystem> game_rule_system_;
+    std::unique_ptr<game::system::HeroSkillSystem> hero_skill_system_;
+    std::unique_ptr<game::system::SpatialIndexSystem> spatial_index_system_;
+    std::unique_ptr<game::system::StatusEffectSystem> status_effect_system_;
+    std::unique_ptr<game::system::CrowdSeparationSystem> crowd_separation_system_;     ///< 关卡开启 "crowd_separation" 时才创建
+    std::unique_ptr<game::system::ProjectileSystem> projectile_system_;
+    std::unique_ptr<game::system::EffectParticleSystem> effect_particle_system_;
+    std::unique_ptr<SystemVariant> set_target_variant_;     ///< 非空时代替 set_target_system_
+    std::unique_ptr<SystemVariant> block_variant_;          ///< 非空时代替 block_system_
+    double variant_ms_ = 0.0;
+
+    game::data::WaveSpawner wave_spawner_;
+    game::data::AliveCounter<game::component::EnemyComponent> enemy_counter_;
+    engine::core::TimerId wave_timer_;      ///< 波次间隔的计时器
+    float wave_break_duration_ = 0.0f;
+    std::vector<glm::vec2> spawn_positions_;
+    std::vector<int> spawn_waypoints_;
+    int current_wave_ = 0;
+    bool wave_running_ = false;
+    double wave_start_seconds_ = 0.0;
+    std::vector<float> wave_clear_seconds_;
+    std::vector<const HeadlessUnitSpec*> extra_enemy_queue_;    ///< 展开后的额外敌人（指向 options_.extra_enemies_）
+    std::size_t extra_enemy_index_ = 0;
+
+    std::uint64_t tick_ = 0;
+    std::size_t peak_entities_ = 0;
+    float delta_time_ = 0.0f;
+    double simulated_seconds_ = 0.0;
+
+    std::shared_ptr<const ReplayLog> replay_;       ///< 始终非空（没有回放时为空日志）
+    std::size_t next_replay_command_ = 0;
+    std::size_t next_replay_checksum_ = 0;
+    std::size_t checksums_verified_ = 0;
+    std::optional<std::uint64_t> desync_tick_;
+    std::uint32_t desync_components_ = 0;
+    std::vector<entt::entity> placed_units_;    ///< 按放置序号排列（回放指令以序号引用单位）
+};
+
+} // namespace game::sim
@@ -0,0 +1,286 @@
+#include "lockstep_session.h"
+
+#include "../../engine/utils/logging.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace game::sim {
+
+namespace {
+
+/// 握手期间重发 HELLO / WELCOME 的间隔
+constexpr auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
+/// 保留的校验值条数：对方落后超过这么多个间隔时，旧的校验值不再比对
+constexpr std::size_t MAX_CHECKSUM_ENTRIES = 64;
+/// 一个数据报最多容纳的指令数：每条至少有类型与 tick 增量两个字节
+constexpr std::size_t MAX_COMMANDS_PER_PACKET = engine::io::UdpSocket::MAX_DATAGRAM_SIZE / 2;
+
+static_assert(std::is_trivially_copyable_v<LockstepMatch>);
+
+} // namespace
+
+LockstepSession::LockstepSession(const LockstepOptions& options)
+    : options_(options),
+      receive_buffer_(engine::io::UdpSocket::MAX_DATAGRAM_SIZE) {
+    options_.input_delay_ = std::max<std::uint32_t>(options_.input_delay_, 1);
+    options_.checksum_interval_ = std::max<std::uint32_t>(options_.checksum_interval_, 1);
+    received_commands_.reserve(MAX_COMMANDS_PER_PACKET);
+}
+
+bool LockstepSession::connect(LockstepMatch& match) {
+    if (!socket_.open(options_.host_ ? options_.port_ : 0)) {
+        ENGINE_LOG_ERROR("锁步联机: {}", socket_.getLastError());
+        return false;
+    }
+    if (options_.host_) {
+        welcome_ = match;
+        ENGINE_LOG_INFO("锁步联机: 主机在端口 {} 等待加入（最长 {:.0f} 秒）", socket_.getLocalPort(), options_.connect_timeout_);
+    } else {
+        if (!options_.peer_) {
+            ENGINE_LOG_ERROR("锁步联机: 加入方未指定主机地址");
+            return false;
+        }
+        peer_ = *options_.peer_;
+        ENGINE_LOG_INFO("锁步联机: 正在加入 {}", peer_.toString());
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                      std::chrono::duration<float>(options_.connect_timeout_));
+    auto next_resend = start;
+    LockstepMatch received{};
+    while (!connected_) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            ENGINE_LOG_ERROR("锁步联机: 握手超时");
+            return false;
+        }
+        // 加入方重发 HELLO 直到收到 WELCOME；主机在收到 HELLO 时回复 WELCOME（见 handlePacket）
+        if (!options_.host_ && now >= next_resend) {
+            send(PacketType::HELLO);
+            next_resend = now + HANDSHAKE_RESEND_INTERVAL;
+        }
+        engine::io::UdpEndpoint from;
+        while (const auto size = socket_.receive(receive_buffer_, from)) {
+            handlePacket(*size, from, &received);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    if (!options_.host_) {
+        match = received;
+    }
+    last_receive_ = std::chrono::steady_clock::now();
+    sendInput();
+    ENGINE_LOG_INFO("锁步联机: 已连接 {}（玩家 {}），关卡 {}，种子 {}，输入延迟 {} 步",
+        peer_.toString(), getPlayerIndex(), match.level_index_ + 1, match.seed_, options_.input_delay_);
+    return true;
+}
+
+void LockstepSession::poll() {
+    if (!connected_) {
+        return;
+    }
+    engine::io::UdpEndpoint from;
+    while (const auto size = socket_.receive(receive_buffer_, from)) {
+        handlePacket(*size, from, nullptr);
+    }
+    sendInput();
+}
+
+std::uint64_t LockstepSession::submit(ReplayCommand command) {
+    command.tick_ = localConfirmedEnd();
+    local_unacked_.push_back(command);
+    local_pending_.push_back(command);
+    return command.tick_;
+}
+
+bool LockstepSession::canStep() const {
+    return connected_ && next_tick_ < remote_confirmed_end_;
+}
+
+void LockstepSession::takeStepCommands(std::vector<ReplayCommand>& out) {
+    auto take = [&](std::deque<ReplayCommand>& pending) {
+        while (!pending.empty() && pending.front().tick_ <= next_tick_) {
+            out.push_back(pending.front());
+            pending.pop_front();
+        }
+    };
+    // 两端以相同的顺序执行：玩家 0（主机）的指令在前
+    if (options_.host_) {
+        take(local_pending_);
+        take(remote_pending_);
+    } else {
+        take(remote_pending_);
+        take(local_pending_);
+    }
+}
+
+void LockstepSession::recordChecksum(const StateChecksum& checksum) {
+    last_checksum_tick_ = next_tick_;
+    last_checksum_ = checksum;
+    if (auto* entry = checksumEntry(next_tick_)) {
+        entry->local_ = checksum;
+        entry->has_local_ = true;
+        compareChecksum(*entry);
+    }
+}
+
+bool LockstepSession::isPeerLost() const {
+    return connected_ && std::chrono::steady_clock::now() - last_receive_ > std::chrono::duration<float>(PEER_TIMEOUT_SECONDS);
+}
+
+std::int64_t LockstepSession::getPeerLead() const {
+    return static_cast<std::int64_t>(remote_confirmed_end_) - static_cast<std::int64_t>(localConfirmedEnd());
+}
+
+void LockstepSession::send(PacketType type, std::span<const std::uint8_t> payload) {
+    PacketHeader header;
+    header.type_ = type;
+    header.player_ = static_cast<std::uint8_t>(getPlayerIndex());
+    packet_.resize(sizeof(header));
+    std::memcpy(packet_.data(), &header, sizeof(header));
+    packet_.insert(packet_.end(), payload.begin(), payload.end());
+    socket_.sendTo(peer_, packet_);
+}
+
+void LockstepSession::sendInput() {
+    PacketHeader header;
+    header.type_ = PacketType::INPUT;
+    header.player_ = static_cast<std::uint8_t>(getPlayerIndex());
+    header.confirmed_end_ = localConfirmedEnd();
+    header.ack_end_ = remote_confirmed_end_;
+    header.first_tick_ = remote_ack_end_;
+    header.checksum_tick_ = last_checksum_tick_;
+    header.checksum_ = last_checksum_;
+
+    packet_.resize(sizeof(header));
+    // 只发送已定稿的指令（逐条编码，tick 增量依次相接）。放不进一个数据报时截断，
+    // 并把定稿进度退到第一条没发出的指令所在的步：同一步已发出的部分会被对方忽略，下一包整步重发
+    std::uint64_t previous_tick = header.first_tick_;
+    for (const auto& command : local_unacked_) {
+        if (command.tick_ >= header.confirmed_end_) {
+            break;
+        }
+        const auto size_before = packet_.size();
+        ReplayLog::encodeCommands(std::span{ &command, 1 }, previous_tick, packet_);
+        if (packet_.size() > engine::io::UdpSocket::MAX_DATAGRAM_SIZE) {
+            packet_.resize(size_before);
+            header.confirmed_end_ = command.tick_;
+            break;
+        }
+        previous_tick = command.tick_;
+    }
+    std::memcpy(packet_.data(), &header, sizeof(header));
+    socket_.sendTo(peer_, packet_);
+}
+
+void LockstepSession::handlePacket(std::size_t size, const engine::io::UdpEndpoint& from, LockstepMatch* match) {
+    PacketHeader header;
+    if (size < sizeof(header)) {
+        return;
+    }
+    std::memcpy(&header, receive_buffer_.data(), sizeof(header));
+    if (header.magic_ != LOCKSTEP_MAGIC || header.version_ != LOCKSTEP_VERSION || header.player_ == getPlayerIndex()) {
+        return;
+    }
+    // 主机从第一个 HELLO 得知加入方地址，之后只接受这一个对端
+    if (connected_ || !options_.host_) {
+        if (!(from == peer_)) {
+            return;
+        }
+    }
+
+    switch (header.type_) {
+    case PacketType::HELLO:
+        if (options_.host_ && welcome_) {
+            peer_ = from;
+            send(PacketType::WELCOME, std::span{ reinterpret_cast<const std::uint8_t*>(&*welcome_), sizeof(LockstepMatch) });
+        }
+        break;
+    case PacketType::WELCOME:
+        if (!options_.host_ && !connected_ && match && size >= sizeof(header) + sizeof(LockstepMatch)) {
+            std::memcpy(match, receive_buffer_.data() + sizeof(header), sizeof(LockstepMatch));
+            connected_ = true;
+        }
+        break;
+    case PacketType::INPUT:
+        // 主机在收到加入方的第一个 INPUT（对方已收到 WELCOME）时完成握手
+        if (options_.host_ && !connected_ && from == peer_) {
+            connected_ = true;
+        }
+        if (connected_) {
+            last_receive_ = std::chrono::steady_clock::now();
+            handleInput(header, size);
+        }
+        break;
+    }
+}
+
+void LockstepSession::handleInput(const PacketHeader& header, std::size_t size) {
+    // 对方已确认收到的本地指令不再重发
+    if (header.ack_end_ > remote_ack_end_) {
+        remote_ack_end_ = header.ack_end_;
+        while (!local_unacked_.empty() && local_unacked_.front().tick_ < remote_ack_end_) {
+            local_unacked_.pop_front();
+        }
+    }
+
+    if (header.checksum_tick_ > 0) {
+        if (auto* entry = checksumEntry(header.checksum_tick_); entry && !entry->has_remote_) {
+            entry->remote_ = header.checksum_;
+            entry->has_remote_ = true;
+            compareChecksum(*entry);
+        }
+    }
+
+    // 乱序到达的旧数据包不会带来新的定稿步；包内的指令覆盖 [first_tick_, confirmed_end_)，
+    // 对方只在收到本地的确认后才前移 first_tick_，因此一定与已收到的部分相接
+    if (header.confirmed_end_ <= remote_confirmed_end_ || header.first_tick_ > remote_confirmed_end_) {
+        return;
+    }
+    received_commands_.clear();
+    receive_buffer_.resize(size);
+    const bool ok = ReplayLog::decodeCommands(receive_buffer_, sizeof(header), header.first_tick_, received_commands_);
+    receive_buffer_.resize(engine::io::UdpSocket::MAX_DATAGRAM_SIZE);
+    if (!ok) {
+        ENGINE_LOG_WARN("锁步联机: 丢弃损坏的数据包");
+        return;
+    }
+    for (const auto& command : received_commands_) {
+        if (command.tick_ >= remote_confirmed_end_ && command.tick_ < header.confirmed_end_) {
+            remote_pending_.push_back(command);
+        }
+    }
+    remote_confirmed_end_ = header.confirmed_end_;
+}
+
+void LockstepSession::compareChecksum(const ChecksumEntry& entry) {
+    if (!entry.has_local_ || !entry.has_remote_ || entry.local_ == entry.remote_ || desync_tick_) {
+        return;
+    }
+    desync_tick_ = entry.tick_;
+    desync_components_ = entry.local_.diff(entry.remote_);
+    ENGINE_LOG_ERROR("锁步联机: 第 {} 步失步，不一致的组件: {}（本地校验值 {:016x}，对方 {:016x}）",
+        entry.tick_, describeChecksumDiff(desync_components_), entry.local_.combined(), entry.remote_.combined());
+}
+
+LockstepSession::ChecksumEntry* LockstepSession::checksumEntry(std::uint64_t tick) {
+    auto it = std::ranges::lower_bound(checksums_, tick, {}, &ChecksumEntry::tick_);
+    if (it != checksums_.end() && it->tick_ == tick) {
+        return &*it;
+    }
+    if (checksums_.size() >= MAX_CHECKSUM_ENTRIES) {
+        if (it == checksums_.begin()) {
+            return nullptr;     // 比保留的都旧，不再比对
+        }
+        checksums_.pop_front();
+        it = std::ranges::lower_bound(checksums_, tick, {}, &ChecksumEntry::tick_);
+    }
+    ChecksumEntry entry;
+    entry.tick_ = tick;
+    return &*checksums_.insert(it, entry);
+}
+
+} // namespace game::sim
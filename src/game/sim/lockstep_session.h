@@ -0,0 +1,178 @@
+#pragma once
+/**
+ * @file lockstep_session.h
+ * @brief 双人合作的锁步联机：只交换玩家指令，两端各自以同一种子与步长运行完全相同的模拟。
+ *
+ * @details
+ * 注册表状态从不上网：敌人再多，每步的数据包也只有几十字节。流程：
+ * - 主机（玩家 0）监听端口，加入方（玩家 1）发送 HELLO；主机回复 WELCOME，带上关卡、种子与固定步长
+ * - 本地指令（放置、升级、撤退、释放技能，编码与回放日志相同）延迟 input_delay_ 步生效，
+ *   预留出网络往返的时间；每帧把对方尚未确认的指令连同「本地已定稿到第几步」一起重发
+ * - 第 t 步只有在双方都已定稿 t 时才能执行（canStep），两端按「玩家序号、提交顺序」合并同一步的指令
+ * - 每 checksum_interval_ 步记录一次状态校验值（StateChecksum，按组件类型分别散列）并随数据包发给对方，
+ *   同一步的值不同即判定失步，并报告不一致的组件类型
+ *
+ * 丢包只会让对方稍晚定稿（下一帧的数据包包含全部未确认指令），不需要重传计时器；
+ * 超过 PEER_TIMEOUT_SECONDS 收不到数据包视为对方掉线。
+ *
+ * @code
+ * LockstepSession session(options);
+ * if (session.connect(match)) {            // 阻塞到握手完成或超时
+ *     // 每帧：session.poll();
+ *     // 每个模拟步：if (!session.canStep()) break; session.takeStepCommands(out); ...; session.endStep();
+ *     //            if (session.isChecksumTick()) session.recordChecksum(computeStateChecksum(registry, stats));
+ * }
+ * @endcode
+ */
+
+#include "replay_log.h"
+#include "state_checksum.h"
+#include "../../engine/io/udp_socket.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace game::sim {
+
+inline constexpr std::uint32_t LOCKSTEP_MAGIC = 0x4B4C574Du;    ///< "MWLK"（小端）
+inline constexpr std::uint32_t LOCKSTEP_VERSION = 2;
+
+/**
+ * @struct LockstepOptions
+ * @brief 联机参数（命令行 --coop-host= / --coop-join=）
+ */
+struct LockstepOptions {
+    bool host_{ true };                                 ///< 主机决定关卡、种子与步长
+    std::uint16_t port_{ 0 };                           ///< 主机监听的端口；加入方为 0（系统分配）
+    std::optional<engine::io::UdpEndpoint> peer_;       ///< 加入方连接的主机地址
+    std::uint32_t input_delay_{ 6 };                    ///< 本地指令延迟生效的步数（60Hz 下约 100ms，需大于单程延迟）
+    std::uint32_t checksum_interval_{ 60 };             ///< 每隔多少步比对一次状态校验值
+    float connect_timeout_{ 60.0f };                    ///< 握手等待的最长秒数
+};
+
+/**
+ * @struct LockstepMatch
+ * @brief 握手时由主机下发、两端必须一致的对局参数
+ */
+struct LockstepMatch {
+    std::uint64_t seed_{ 0 };
+    std::uint32_t level_index_{ 0 };
+    float delta_time_{ 1.0f / 60.0f };
+};
+
+/**
+ * @class LockstepSession
+ * @brief 一场双人锁步对局的网络与步进状态
+ */
+class LockstepSession final {
+public:
+    static constexpr float PEER_TIMEOUT_SECONDS = 10.0f;
+
+    explicit LockstepSession(const LockstepOptions& options);
+
+    LockstepSession(const LockstepSession&) = delete;
+    LockstepSession& operator=(const LockstepSession&) = delete;
+
+    /**
+     * @brief 打开套接字并完成握手（阻塞，最长 connect_timeout_ 秒）
+     * @param match 主机：要下发的对局参数；加入方：收到的对局参数
+     */
+    bool connect(LockstepMatch& match);
+
+    /// @brief 每帧调用：接收对方的数据包并发送本地未确认的指令
+    void poll();
+
+    /**
+     * @brief 提交一条本地指令，tick_ 由会话填写（下一步 + input_delay_）
+     * @return 指令生效的模拟步
+     */
+    std::uint64_t submit(ReplayCommand command);
+
+    /// @brief 下一步（getNextTick()）的双方指令均已定稿
+    [[nodiscard]] bool canStep() const;
+    /// @brief 从下一步起双方指令均已定稿的步数（本地的定稿总是领先执行进度 input_delay_ 步，只受对方限制）
+    [[nodiscard]] std::uint64_t getReadySteps() const { return connected_ ? remote_confirmed_end_ - next_tick_ : 0; }
+
+    /// @brief 取出下一步的全部指令（玩家 0 在前，各自按提交顺序），追加到 out
+    void takeStepCommands(std::vector<ReplayCommand>& out);
+
+    /// @brief 下一步执行完毕
+    void endStep() { ++next_tick_; }
+
+    /// @brief endStep() 之后调用：已执行的步数是否到了记录校验值的间隔
+    [[nodiscard]] bool isChecksumTick() const { return next_tick_ % options_.checksum_interval_ == 0; }
+    /// @brief 记录执行完 getNextTick() 步之后的本地校验值，与对方同一步的值比对
+    void recordChecksum(const StateChecksum& checksum);
+
+    [[nodiscard]] std::uint64_t getNextTick() const { return next_tick_; }
+    [[nodiscard]] std::uint32_t getPlayerIndex() const { return options_.host_ ? 0u : 1u; }
+    [[nodiscard]] bool isConnected() const { return connected_ && !isPeerLost(); }
+    [[nodiscard]] bool isPeerLost() const;
+    /// @brief 第一次检测到校验值不一致的模拟步
+    [[nodiscard]] std::optional<std::uint64_t> getDesyncTick() const { return desync_tick_; }
+    /// @brief 失步时不一致的组件类型（StateChecksum::diff 的结果）
+    [[nodiscard]] std::uint32_t getDesyncComponents() const { return desync_components_; }
+    /// @brief 对方定稿的进度减去本地定稿的进度：正值表示对方领先，本地在等待时通常为负
+    [[nodiscard]] std::int64_t getPeerLead() const;
+
+private:
+    enum class PacketType : std::uint8_t { HELLO = 1, WELCOME = 2, INPUT = 3 };
+
+    /// @brief 数据包头；INPUT 之后是 ReplayLog 编码的指令（tick 相对 first_tick_ 编码），WELCOME 之后是 LockstepMatch
+    struct PacketHeader {
+        std::uint32_t magic_{ LOCKSTEP_MAGIC };
+        std::uint16_t version_{ LOCKSTEP_VERSION };
+        PacketType type_{ PacketType::INPUT };
+        std::uint8_t player_{ 0 };
+        std::uint64_t confirmed_end_{ 0 };      ///< 发送方小于这一步的指令均已定稿
+        std::uint64_t ack_end_{ 0 };            ///< 发送方已收到对方小于这一步的全部指令
+        std::uint64_t first_tick_{ 0 };         ///< 包内指令覆盖的第一步
+        std::uint64_t checksum_tick_{ 0 };      ///< checksum_ 对应的步数（0 表示尚无校验值）
+        StateChecksum checksum_;
+    };
+
+    struct ChecksumEntry {
+        std::uint64_t tick_{ 0 };
+        StateChecksum local_;
+        StateChecksum remote_;
+        bool has_local_{ false };
+        bool has_remote_{ false };
+    };
+
+    /// @brief 本地小于这一步的指令均已定稿（新指令落在这一步）
+    [[nodiscard]] std::uint64_t localConfirmedEnd() const { return next_tick_ + options_.input_delay_; }
+    void send(PacketType type, std::span<const std::uint8_t> payload = {});
+    void sendInput();
+    /// @brief 处理一个数据包；握手阶段 match 非空（加入方收到 WELCOME 时写入）
+    void handlePacket(std::size_t size, const engine::io::UdpEndpoint& from, LockstepMatch* match);
+    void handleInput(const PacketHeader& header, std::size_t size);
+    void compareChecksum(const ChecksumEntry& entry);
+    /// @brief 查找或插入第 tick 步的校验值记录；比保留范围还旧时返回 nullptr
+    ChecksumEntry* checksumEntry(std::uint64_t tick);
+
+    LockstepOptions options_;
+    engine::io::UdpSocket socket_;
+    engine::io::UdpEndpoint peer_;
+    std::optional<LockstepMatch> welcome_;              ///< 主机下发的对局参数（握手后继续回复迟到的 HELLO）
+    std::deque<ReplayCommand> local_unacked_;           ///< 对方尚未确认收到的本地指令（按 tick 非递减）
+    std::deque<ReplayCommand> local_pending_;           ///< 尚未执行的本地指令
+    std::deque<ReplayCommand> remote_pending_;          ///< 已收到、尚未执行的对方指令
+    std::deque<ChecksumEntry> checksums_;               ///< 最近的校验值，按 tick 递增
+    std::vector<std::uint8_t> packet_;                  ///< 发送缓冲（复用）
+    std::vector<std::uint8_t> receive_buffer_;
+    std::vector<ReplayCommand> received_commands_;      ///< handleInput() 的解码缓冲（按一个数据报的上限预留，复用）
+    std::uint64_t next_tick_{ 0 };
+    std::uint64_t remote_confirmed_end_{ 0 };           ///< 对方小于这一步的指令均已收到
+    std::uint64_t remote_ack_end_{ 0 };                 ///< 对方已收到本地小于这一步的指令
+    std::uint64_t last_checksum_tick_{ 0 };
+    StateChecksum last_checksum_;
+    std::optional<std::uint64_t> desync_tick_;
+    std::uint32_t desync_components_{ 0 };
+    std::chrono::steady_clock::time_point last_receive_;
+    bool connected_{ false };
+};
+
+} // namespace game::sim
@@ -0,0 +1,169 @@
+#include "perf_scenario.h"
+
+#include "../../engine/io/virtual_fs.h"
+#include "../../engine/memory/allocation_counter.h"
+#include "../../engine/utils/logging.h"
+#include <algorithm>
+#include <chrono>
+#include <entt/core/hashed_string.hpp>
+#include <nlohmann/json.hpp>
+
+namespace game::sim {
+
+namespace {
+
+/// @brief 解析 [{"class": "archer", "count": 40, "level": 1, "rarity": 1}, ...]
+std::vector<HeadlessUnitSpec> parseUnits(const nlohmann::json& array) {
+    std::vector<HeadlessUnitSpec> specs;
+    if (!array.is_array()) {
+        return specs;
+    }
+    for (const auto& item : array) {
+        const auto name = item.value("class", std::string{});
+        if (name.empty()) {
+            ENGINE_LOG_WARN("压力场景: 单位缺少 class 字段，已忽略");
+            continue;
+        }
+        HeadlessUnitSpec spec;
+        spec.class_id_ = entt::hashed_string(name.c_str()).value();
+        spec.count_ = item.value("count", std::size_t{ 0 });
+        spec.level_ = std::max(1, item.value("level", 1));
+        spec.rarity_ = std::max(1, item.value("rarity", 1));
+        specs.push_back(spec);
+    }
+    return specs;
+}
+
+} // namespace
+
+bool PerfScenarioRunner::load(const std::string& path) {
+    const auto file = engine::io::VirtualFS::instance().read(path);
+    if (!file) {
+        ENGINE_LOG_ERROR("无法打开压力场景文件: {}", path);
+        return false;
+    }
+
+    nlohmann::json root;
+    try {
+        root = nlohmann::json::parse(file->text());
+    }
+    catch (const std::exception& e) {
+        ENGINE_LOG_ERROR("解析压力场景文件失败: {}", e.what());
+        return false;
+    }
+
+    level_config_path_ = root.value("level_config", level_config_path_);
+    scenarios_.clear();
+    const auto it = root.find("scenarios");
+    if (it == root.end() || !it->is_array()) {
+        ENGINE_LOG_ERROR("压力场景文件缺少 scenarios 数组: {}", path);
+        return false;
+    }
+    for (const auto& item : *it) {
+        PerfScenario scenario;
+        scenario.name_ = item.value("name", std::string{});
+        if (scenario.name_.empty()) {
+            scenario.name_ = "scenario" + std::to_string(scenarios_.size() + 1);
+        }
+        scenario.level_index_ = static_cast<std::size_t>(std::max(1, item.value("level", 1)) - 1);
+        scenario.seed_ = item.value("seed", scenario.seed_);
+        scenario.warmup_ticks_ = item.value("warmup_ticks", scenario.warmup_ticks_);
+        scenario.ticks_ = std::max<std::uint64_t>(1, item.value("ticks", scenario.ticks_));
+        scenario.fixed_dt_ = std::max(1.0e-4f, item.value("dt", scenario.fixed_dt_));
+        scenario.units_ = parseUnits(item.value("units", nlohmann::json::array()));
+        scenario.enemies_ = parseUnits(item.value("enemies", nlohmann::json::array()));
+        scenario.enemies_per_tick_ = std::max<std::size_t>(1, item.value("enemies_per_tick", scenario.enemies_per_tick_));
+        scenario.hero_skills_ = item.value("hero_skills", scenario.hero_skills_);
+        if (const auto thresholds = item.find("thresholds"); thresholds != item.end() && thresholds->is_object()) {
+            scenario.min_ticks_per_second_ = thresholds->value("min_ticks_per_second", scenario.min_ticks_per_second_);
+            scenario.max_allocations_per_tick_ = thresholds->value("max_allocations_per_tick", scenario.max_allocations_per_tick_);
+        }
+        scenarios_.push_back(std::move(scenario));
+    }
+    if (scenarios_.empty()) {
+        ENGINE_LOG_ERROR("压力场景文件没有任何场景: {}", path);
+        return false;
+    }
+    return true;
+}
+
+bool PerfScenarioRunner::run(std::string_view only) {
+    results_.clear();
+    for (const auto& scenario : scenarios_) {
+        if (!only.empty() && scenario.name_ != only) {
+            continue;
+        }
+        results_.push_back(runScenario(scenario, level_config_path_));
+    }
+    if (results_.empty()) {
+        ENGINE_LOG_ERROR("没有名为 {} 的压力场景", only);
+        return false;
+    }
+
+    const auto passed = static_cast<std::size_t>(std::ranges::count(results_, true, &PerfScenarioResult::passed_));
+    ENGINE_LOG_INFO("压力场景完成: 通过 {}/{}", passed, results_.size());
+    return passed == results_.size();
+}
+
+PerfScenarioResult PerfScenarioRunner::runScenario(const PerfScenario& scenario, const std::string& level_config_path) {
+    PerfScenarioResult result;
+    result.name_ = scenario.name_;
+
+    HeadlessOptions options;
+    options.level_index_ = scenario.level_index_;
+    options.level_config_path_ = level_config_path;
+    options.fixed_dt_ = scenario.fixed_dt_;
+    options.seed_ = scenario.seed_;
+    options.extra_units_ = scenario.units_;
+    options.extra_enemies_ = scenario.enemies_;
+    options.extra_enemies_per_tick_ = scenario.enemies_per_tick_;
+    options.auto_release_skills_ = scenario.hero_skills_;
+
+    HeadlessSimulation simulation(std::move(options));
+    if (!simulation.init()) {
+        ENGINE_LOG_ERROR("压力场景 {}: 初始化失败", scenario.name_);
+        return result;
+    }
+    for (std::uint64_t i = 0; i < scenario.warmup_ticks_; ++i) {
+        simulation.step();
+    }
+
+    // 测量阶段直接逐步推进：基地被攻破后仍继续，保证每个场景测量的步数相同
+    auto& registry = simulation.getRegistry();
+    const auto allocations_before = engine::memory::threadAllocations();
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < scenario.ticks_; ++i) {
+        const auto step_start = std::chrono::steady_clock::now();
+        simulation.step();
+        const double step_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - step_start).count();
+        result.slowest_tick_ms_ = std::max(result.slowest_tick_ms_, step_ms);
+        result.peak_entities_ = std::max(result.peak_entities_, registry.storage<entt::entity>().size());
+    }
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto allocated = engine::memory::threadAllocations() - allocations_before;
+
+    const double ticks = static_cast<double>(scenario.ticks_);
+    result.ok_ = true;
+    result.ticks_ = scenario.ticks_;
+    result.ticks_per_second_ = wall_seconds > 0.0 ? ticks / wall_seconds : 0.0;
+    result.allocations_per_tick_ = static_cast<double>(allocated.count_) / ticks;
+    result.bytes_per_tick_ = static_cast<double>(allocated.bytes_) / ticks;
+
+    const bool fast_enough = scenario.min_ticks_per_second_ <= 0.0 || result.ticks_per_second_ >= scenario.min_ticks_per_second_;
+    const bool lean_enough = scenario.max_allocations_per_tick_ < 0.0 || result.allocations_per_tick_ <= scenario.max_allocations_per_tick_;
+    result.passed_ = fast_enough && lean_enough;
+
+    ENGINE_LOG_INFO("压力场景 {}: {} ticks/sec（下限 {}），{:.2f} 次分配/步（上限 {}），{:.0f} 字节/步，最慢一步 {:.3f}ms，实体峰值 {}",
+        scenario.name_, static_cast<std::uint64_t>(result.ticks_per_second_), scenario.min_ticks_per_second_,
+        result.allocations_per_tick_, scenario.max_allocations_per_tick_, result.bytes_per_tick_,
+        result.slowest_tick_ms_, result.peak_entities_);
+    if (result.passed_) {
+        ENGINE_LOG_INFO("压力场景 {}: PASS", scenario.name_);
+    } else {
+        ENGINE_LOG_ERROR("压力场景 {}: FAIL{}{}", scenario.name_,
+            fast_enough ? "" : "（吞吐量低于下限）", lean_enough ? "" : "（每步分配次数超过上限）");
+    }
+    return result;
+}
+
+} // namespace game::sim
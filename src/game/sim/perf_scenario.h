@@ -0,0 +1,89 @@
+#pragma once
+/**
+ * @file perf_scenario.h
+ * @brief 脚本化的端到端压力场景：以无头模拟跑固定步数，按吞吐量与每步分配次数判定通过/失败。
+ *
+ * @details
+ * 场景定义在 assets/data/perf_scenarios.json（与 level_config.json 同目录），每个场景指定关卡、种子、
+ * 预热与测量步数、追加的敌人与玩家单位、是否自动释放技能，以及两项阈值：
+ * - `min_ticks_per_second`：测量阶段的每秒步数下限
+ * - `max_allocations_per_tick`：测量阶段平均每步经 operator new 的分配次数上限（见 allocation_counter.h）
+ *
+ * @code
+ * MonsterWar --perf-scenarios[=assets/data/perf_scenarios.json] [--scenario=名称]
+ * cmake --build build --target perf-scenarios
+ * @endcode
+ * 场景依次在调用线程上执行（吞吐量不受其他实例争用影响），任一场景失败时进程退出码为 1。
+ * 预热阶段用于刷完额外敌人、让存储与对象池扩容到稳态，不计入统计。
+ */
+
+#include "headless_simulation.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace game::sim {
+
+/**
+ * @brief 一个压力场景的定义
+ */
+struct PerfScenario {
+    std::string name_;
+    std::size_t level_index_{ 0 };
+    std::uint64_t seed_{ HeadlessOptions::DEFAULT_SEED };
+    std::uint64_t warmup_ticks_{ 120 };
+    std::uint64_t ticks_{ 1800 };
+    float fixed_dt_{ 1.0f / 60.0f };
+    std::vector<HeadlessUnitSpec> units_;
+    std::vector<HeadlessUnitSpec> enemies_;
+    std::size_t enemies_per_tick_{ 10 };
+    bool hero_skills_{ false };                 ///< 技能就绪即释放
+    double min_ticks_per_second_{ 0.0 };        ///< 0 表示不检查
+    double max_allocations_per_tick_{ -1.0 };   ///< 负数表示不检查
+};
+
+/**
+ * @brief 一个场景的测量结果
+ */
+struct PerfScenarioResult {
+    std::string name_;
+    bool ok_{ false };                  ///< 初始化成功并跑完
+    bool passed_{ false };              ///< ok_ 且满足全部阈值
+    std::uint64_t ticks_{ 0 };          ///< 测量阶段的步数
+    double ticks_per_second_{ 0.0 };
+    double slowest_tick_ms_{ 0.0 };
+    double allocations_per_tick_{ 0.0 };
+    double bytes_per_tick_{ 0.0 };
+    std::size_t peak_entities_{ 0 };
+};
+
+/**
+ * @class PerfScenarioRunner
+ * @brief 读取场景文件并依次执行
+ */
+class PerfScenarioRunner final {
+public:
+    /// @brief 读取场景定义文件，格式错误或没有场景时返回 false
+    [[nodiscard]] bool load(const std::string& path);
+
+    /**
+     * @brief 依次执行场景
+     * @param only 非空时只执行同名场景
+     * @return 至少执行了一个场景且全部通过
+     */
+    [[nodiscard]] bool run(std::string_view only = {});
+
+    [[nodiscard]] const std::vector<PerfScenario>& getScenarios() const { return scenarios_; }
+    [[nodiscard]] const std::vector<PerfScenarioResult>& getResults() const { return results_; }
+
+private:
+    [[nodiscard]] static PerfScenarioResult runScenario(const PerfScenario& scenario, const std::string& level_config_path);
+
+    std::string level_config_path_{ "assets/data/level_config.json" };
+    std::vector<PerfScenario> scenarios_;
+    std::vector<PerfScenarioResult> results_;
+};
+
+} // namespace game::sim
@@ -0,0 +1,246 @@
+#include "replay_log.h"
+
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <system_error>
+
+namespace game::sim {
+
+namespace {
+
+class Writer {
+public:
+    explicit Writer(std::vector<std::uint8_t>& bytes) : bytes_(bytes) {}
+
+    std::vector<std::uint8_t>& bytes_;
+
+    void varint(std::uint64_t value) {
+        while (value >= 0x80u) {
+            bytes_.push_back(static_cast<std::uint8_t>(value | 0x80u));
+            value >>= 7;
+        }
+        bytes_.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    template <typename T>
+    void raw(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* begin = reinterpret_cast<const std::uint8_t*>(&value);
+        bytes_.insert(bytes_.end(), begin, begin + sizeof(T));
+    }
+};
+
+class Reader {
+public:
+    Reader(const std::vector<std::uint8_t>& bytes, std::size_t offset) : bytes_(bytes), offset_(offset) {}
+
+    [[nodiscard]] bool done() const { return offset_ >= bytes_.size(); }
+
+    bool varint(std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (done()) {
+                return false;
+            }
+            const std::uint8_t byte = bytes_[offset_++];
+            value |= static_cast<std::uint64_t>(byte & 0x7Fu) << shift;
+            if ((byte & 0x80u) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename T>
+    bool raw(T& value) {
+        if (bytes_.size() - offset_ < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, bytes_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return true;
+    }
+
+private:
+    const std::vector<std::uint8_t>& bytes_;
+    std::size_t offset_;
+};
+
+} // namespace
+
+void ReplayLog::encodeCommands(std::span<const ReplayCommand> commands, std::uint64_t base_tick, std::vector<std::uint8_t>& bytes) {
+    static_assert(std::endian::native == std::endian::little, "回放日志按小端直接写出");
+
+    Writer writer(bytes);
+    std::uint64_t previous_tick = base_tick;
+    for (const auto& command : commands) {
+        if (command.type_ == ReplayCommandType::CHECKSUM) {
+            continue;   // 校验值不在 commands_ 中，由 save() 按 checksums_ 写出
+        }
+        writer.raw(command.type_);
+        writer.varint(command.tick_ - previous_tick);
+        previous_tick = command.tick_;
+        switch (command.type_) {
+        case ReplayCommandType::SET_DELTA_TIME:
+            writer.raw(command.delta_time_);
+            break;
+        case ReplayCommandType::PLACE_UNIT:
+            writer.raw(command.class_id_);
+            writer.raw(command.position_.x);
+            writer.raw(command.position_.y);
+            writer.varint(static_cast<std::uint64_t>(command.level_));
+            writer.varint(static_cast<std::uint64_t>(command.rarity_));
+            writer.varint(static_cast<std::uint64_t>(command.cost_));
+            break;
+        case ReplayCommandType::UPGRADE_UNIT:
+        case ReplayCommandType::RETREAT_UNIT:
+            writer.varint(command.unit_);
+            writer.varint(static_cast<std::uint64_t>(command.cost_));
+            break;
+        case ReplayCommandType::RELEASE_SKILL:
+            writer.varint(command.unit_);
+            break;
+        case ReplayCommandType::CHECKSUM:
+            break;
+        }
+    }
+}
+
+bool ReplayLog::decodeCommands(const std::vector<std::uint8_t>& bytes, std::size_t offset, std::uint64_t base_tick,
+                               std::vector<ReplayCommand>& commands, std::vector<ReplayChecksum>* checksums) {
+    Reader reader(bytes, offset);
+    std::uint64_t tick = base_tick;
+    while (!reader.done()) {
+        ReplayCommand command;
+        std::uint64_t tick_delta = 0;
+        std::uint64_t level = 0;
+        std::uint64_t rarity = 0;
+        std::uint64_t cost = 0;
+        std::uint64_t unit = 0;
+        bool ok = reader.raw(command.type_) && reader.varint(tick_delta);
+        switch (command.type_) {
+        case ReplayCommandType::SET_DELTA_TIME:
+            ok = ok && reader.raw(command.delta_time_);
+            break;
+        case ReplayCommandType::PLACE_UNIT:
+            ok = ok && reader.raw(command.class_id_) && reader.raw(command.position_.x) && reader.raw(command.position_.y) &&
+                 reader.varint(level) && reader.varint(rarity) && reader.varint(cost);
+            break;
+        case ReplayCommandType::UPGRADE_UNIT:
+        case ReplayCommandType::RETREAT_UNIT:
+            ok = ok && reader.varint(unit) && reader.varint(cost);
+            break;
+        case ReplayCommandType::RELEASE_SKILL:
+            ok = ok && reader.varint(unit);
+            break;
+        case ReplayCommandType::CHECKSUM: {
+            ReplayChecksum checksum;
+            ok = ok && reader.raw(checksum.checksum_);
+            if (!ok) {
+                return false;
+            }
+            tick += tick_delta;
+            checksum.tick_ = tick;
+            if (checksums) {
+                checksums->push_back(checksum);
+            }
+            continue;
+        }
+        default:
+            ok = false;
+            break;
+        }
+        if (!ok) {
+            return false;
+        }
+        tick += tick_delta;
+        command.tick_ = tick;
+        command.level_ = static_cast<std::int32_t>(level);
+        command.rarity_ = static_cast<std::int32_t>(rarity);
+        command.cost_ = static_cast<std::int32_t>(cost);
+        command.unit_ = static_cast<std::uint32_t>(unit);
+        commands.push_back(command);
+    }
+    return true;
+}
+
+bool ReplayLog::save(const std::string& path, std::string& error_message) const {
+    std::vector<std::uint8_t> bytes;
+    Writer writer(bytes);
+    ReplayHeader header = header_;
+    header.magic_ = REPLAY_MAGIC;
+    header.version_ = REPLAY_VERSION;
+    writer.raw(header);
+    // 指令与校验值按 tick 归并为一条流（同一步的指令在前：校验值记录的是该步执行完之后的状态）
+    std::uint64_t previous_tick = 0;
+    std::size_t next_checksum = 0;
+    auto write_checksums_before = [&](std::uint64_t tick) {
+        for (; next_checksum < checksums_.size() && checksums_[next_checksum].tick_ < tick; ++next_checksum) {
+            const auto& checksum = checksums_[next_checksum];
+            writer.raw(ReplayCommandType::CHECKSUM);
+            writer.varint(checksum.tick_ - previous_tick);
+            writer.raw(checksum.checksum_);
+            previous_tick = checksum.tick_;
+        }
+    };
+    for (const auto& command : commands_) {
+        write_checksums_before(command.tick_);
+        encodeCommands(std::span{ &command, 1 }, previous_tick, bytes);
+        previous_tick = command.tick_;
+    }
+    write_checksums_before(std::numeric_limits<std::uint64_t>::max());
+
+    std::error_code ec;
+    if (const auto parent = std::filesystem::path(path).parent_path(); !parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            error_message = "无法写入回放日志: " + temp_path;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            error_message = "写入回放日志失败: " + temp_path;
+            return false;
+        }
+    }
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        error_message = "重命名回放日志失败: " + ec.message();
+        return false;
+    }
+    return true;
+}
+
+bool ReplayLog::load(const std::string& path, std::string& error_message) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        error_message = "无法打开回放日志: " + path;
+        return false;
+    }
+    const std::vector<std::uint8_t> bytes{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+    Reader reader(bytes, 0);
+    if (!reader.raw(header_) || header_.magic_ != REPLAY_MAGIC || header_.version_ < REPLAY_MIN_VERSION ||
+        header_.version_ > REPLAY_VERSION) {
+        error_message = "回放日志格式或版本不匹配: " + path;
+        return false;
+    }
+
+    commands_.clear();
+    checksums_.clear();
+    if (!decodeCommands(bytes, sizeof(ReplayHeader), 0, commands_, &checksums_)) {
+        error_message = "回放日志指令损坏: " + path + "（第 " + std::to_string(commands_.size()) + " 条之后）";
+        return false;
+    }
+    return true;
+}
+
+} // namespace game::sim
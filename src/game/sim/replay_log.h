@@ -0,0 +1,106 @@
+#pragma once
+/**
+ * @file replay_log.h
+ * @brief 战斗回放日志（.mwr）：随机种子、固定步长与按模拟步排列的玩家指令。
+ *
+ * @details
+ * 回放记录的不是原始按键与鼠标坐标，而是它们在模拟层产生的结果：放置单位时记录已解析的
+ * 放置点坐标，升级、撤退、释放技能以「第几个放置的单位」引用目标（实体 ID 在两次运行间不稳定）。
+ * 配合种子与每步的 dt，无头模拟可以在不创建窗口、输入与 UI 的情况下逐步复现同一场战斗。
+ *
+ * 每条指令的 tick_ 表示它在第几个模拟步开始前生效（GameScene 中暂停期间不计步）。
+ *
+ * 布局：Header | 指令流。指令为 1 字节类型 + 变长整数编码的 tick 增量 + 按类型固定的负载，
+ * 字节序为小端。指令本身一场十分钟的战斗通常只有几百字节。
+ *
+ * 版本 2 起指令流中按 tick 穿插状态校验值（CHECKSUM 记录，见 state_checksum.h），记录的是该步执行完之后的状态；
+ * 无头重放逐一比对，报告第一个不一致的步与组件类型。版本 1 的文件没有校验值，仍可读取。
+ *
+ * @code
+ * MonsterWar --headless --replay=replays/last.mwr     // 以最快速度重放并报告最慢的一步
+ * @endcode
+ */
+
+#include "state_checksum.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <entt/core/fwd.hpp>
+#include <glm/vec2.hpp>
+
+namespace game::sim {
+
+inline constexpr std::uint32_t REPLAY_MAGIC = 0x50524D57u;     ///< "MWRP"（小端）
+inline constexpr std::uint32_t REPLAY_VERSION = 2;
+inline constexpr std::uint32_t REPLAY_MIN_VERSION = 1;     ///< 仍可读取的最低版本（没有校验值）
+
+enum class ReplayCommandType : std::uint8_t {
+    SET_DELTA_TIME = 1,     ///< 之后各步的 dt 改为 delta_time_（时间缩放或变步长模拟）
+    PLACE_UNIT = 2,         ///< 在 position_ 处放置 class_id_ 单位并扣除 cost_
+    UPGRADE_UNIT = 3,       ///< 升级第 unit_ 个放置的单位
+    RETREAT_UNIT = 4,       ///< 撤退第 unit_ 个放置的单位
+    RELEASE_SKILL = 5,      ///< 第 unit_ 个放置的单位释放技能
+    CHECKSUM = 6,           ///< 状态校验值（只出现在文件中，解码到 ReplayLog::checksums_）
+};
+
+struct ReplayCommand {
+    std::uint64_t tick_{ 0 };
+    ReplayCommandType type_{ ReplayCommandType::SET_DELTA_TIME };
+    entt::id_type class_id_{ 0 };
+    glm::vec2 position_{ 0.0f };
+    std::int32_t level_{ 1 };
+    std::int32_t rarity_{ 1 };
+    std::int32_t cost_{ 0 };
+    std::uint32_t unit_{ 0 };       ///< 放置序号（PLACE_UNIT 按出现顺序从 0 编号）
+    float delta_time_{ 0.0f };
+};
+
+struct ReplayHeader {
+    std::uint32_t magic_{ REPLAY_MAGIC };
+    std::uint32_t version_{ REPLAY_VERSION };
+    std::uint64_t seed_{ 0 };               ///< engine::utils::RandomService 的主种子
+    std::uint64_t tick_count_{ 0 };         ///< 录制结束时的模拟步数
+    std::uint32_t level_index_{ 0 };        ///< 关卡下标（从 0 开始）
+    float delta_time_{ 1.0f / 60.0f };      ///< 初始固定步长（秒）
+};
+
+static_assert(std::is_trivially_copyable_v<ReplayHeader>);
+
+/// @brief 执行完第 tick_ 步（从 0 计）之后的状态校验值
+struct ReplayChecksum {
+    std::uint64_t tick_{ 0 };
+    StateChecksum checksum_;
+};
+
+/**
+ * @class ReplayLog
+ * @brief 内存中的回放日志，负责与 .mwr 文件互相转换
+ */
+class ReplayLog final {
+public:
+    ReplayHeader header_;
+    std::vector<ReplayCommand> commands_;   ///< 按 tick_ 非递减排列
+    std::vector<ReplayChecksum> checksums_;  ///< 按 tick_ 递增排列
+
+    /// @brief 编码并写出文件（先写临时文件再重命名）
+    bool save(const std::string& path, std::string& error_message) const;
+
+    /// @brief 读取并解码文件，格式或版本不匹配时返回 false
+    bool load(const std::string& path, std::string& error_message);
+
+    /**
+     * @brief 按日志格式把指令追加到 bytes（锁步联机的数据包复用同一编码）
+     * @param base_tick 第一条指令的 tick 增量相对于它编码
+     */
+    static void encodeCommands(std::span<const ReplayCommand> commands, std::uint64_t base_tick, std::vector<std::uint8_t>& bytes);
+    /**
+     * @brief 解码 bytes 从 offset 到末尾的指令并追加到 commands，数据损坏时返回 false（已解码的保留）
+     * @param checksums 非空时接收 CHECKSUM 记录，为空时跳过它们
+     */
+    static bool decodeCommands(const std::vector<std::uint8_t>& bytes, std::size_t offset, std::uint64_t base_tick,
+                               std::vector<ReplayCommand>& commands, std::vector<ReplayChecksum>* checksums = nullptr);
+};
+
+} // namespace game::sim
@@ -0,0 +1,108 @@
+#include "replay_recorder.h"
+
+#include "../../engine/utils/logging.h"
+#include <entt/signal/dispatcher.hpp>
+
+namespace game::sim {
+
+ReplayRecorder::ReplayRecorder(entt::dispatcher& dispatcher)
+    : dispatcher_(dispatcher) {
+    dispatcher_.sink<game::defs::UnitPlacedEvent>().connect<&ReplayRecorder::onUnitPlaced>(this);
+    dispatcher_.sink<game::defs::UpgradeUnitEvent>().connect<&ReplayRecorder::onUpgradeUnit>(this);
+    dispatcher_.sink<game::defs::RetreatEvent>().connect<&ReplayRecorder::onRetreat>(this);
+    dispatcher_.sink<game::defs::ReleaseHeroSkillEvent>().connect<&ReplayRecorder::onReleaseHeroSkill>(this);
+}
+
+ReplayRecorder::~ReplayRecorder() {
+    dispatcher_.disconnect(this);
+}
+
+void ReplayRecorder::begin(std::uint64_t seed, std::uint32_t level_index, float delta_time) {
+    log_ = {};
+    log_.header_.seed_ = seed;
+    log_.header_.level_index_ = level_index;
+    log_.header_.delta_time_ = delta_time;
+    unit_ordinals_.clear();
+    tick_ = 0;
+    delta_time_ = delta_time;
+    recording_ = true;
+}
+
+void ReplayRecorder::beginStep(float delta_time) {
+    if (recording_ && delta_time != delta_time_) {
+        delta_time_ = delta_time;
+        ReplayCommand command;
+        command.tick_ = tick_;
+        command.type_ = ReplayCommandType::SET_DELTA_TIME;
+        command.delta_time_ = delta_time;
+        log_.commands_.push_back(command);
+    }
+}
+
+bool ReplayRecorder::save(const std::string& path) {
+    if (!recording_) {
+        return false;
+    }
+    recording_ = false;     // 每次录制只写出一次（场景 clean 可能被调用多次）
+    log_.header_.tick_count_ = tick_;
+    std::string error_message;
+    if (!log_.save(path, error_message)) {
+        ENGINE_LOG_WARN("保存回放失败: {}", error_message);
+        return false;
+    }
+    ENGINE_LOG_INFO("回放已保存: {}（{} 步，{} 条指令，{} 个校验值）", path, tick_, log_.commands_.size(), log_.checksums_.size());
+    return true;
+}
+
+void ReplayRecorder::recordChecksum(const StateChecksum& checksum) {
+    if (recording_) {
+        log_.checksums_.push_back(ReplayChecksum{ tick_, checksum });
+    }
+}
+
+void ReplayRecorder::onUnitPlaced(const game::defs::UnitPlacedEvent& event) {
+    if (!recording_) {
+        return;
+    }
+    ReplayCommand command;
+    command.tick_ = tick_;
+    command.type_ = ReplayCommandType::PLACE_UNIT;
+    command.class_id_ = event.class_id_;
+    command.position_ = event.position_;
+    command.level_ = event.level_;
+    command.rarity_ = event.rarity_;
+    command.cost_ = event.cost_;
+    unit_ordinals_[event.entity_] = static_cast<std::uint32_t>(unit_ordinals_.size());
+    log_.commands_.push_back(command);
+}
+
+void ReplayRecorder::onUpgradeUnit(const game::defs::UpgradeUnitEvent& event) {
+    recordUnitCommand(ReplayCommandType::UPGRADE_UNIT, event.entity_, event.cost_);
+}
+
+void ReplayRecorder::onRetreat(const game::defs::RetreatEvent& event) {
+    recordUnitCommand(ReplayCommandType::RETREAT_UNIT, event.entity_, event.cost_);
+}
+
+void ReplayRecorder::onReleaseHeroSkill(const game::defs::ReleaseHeroSkillEvent& event) {
+    recordUnitCommand(ReplayCommandType::RELEASE_SKILL, event.entity_, 0);
+}
+
+void ReplayRecorder::recordUnitCommand(ReplayCommandType type, entt::entity entity, int cost) {
+    if (!recording_) {
+        return;
+    }
+    const auto it = unit_ordinals_.find(entity);
+    if (it == unit_ordinals_.end()) {
+        ENGINE_LOG_DEBUG("回放忽略未经放置的单位指令: entity={}", entt::to_integral(entity));
+        return;
+    }
+    ReplayCommand command;
+    command.tick_ = tick_;
+    command.type_ = type;
+    command.unit_ = it->second;
+    command.cost_ = cost;
+    log_.commands_.push_back(command);
+}
+
+} // namespace game::sim
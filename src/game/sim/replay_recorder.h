@@ -0,0 +1,79 @@
+#pragma once
+/**
+ * @file replay_recorder.h
+ * @brief 在 GameScene 中录制回放日志：监听玩家指令事件并按模拟步打上 tick。
+ *
+ * @code
+ * recorder.begin(seed, level_index, fixed_dt);
+ * // GameScene::simulate 中每个未暂停的模拟步：
+ * recorder.beginStep(delta_time);
+ * ...
+ * if (recorder.isChecksumTick()) recorder.recordChecksum(computeStateChecksum(registry, stats));
+ * recorder.endStep();
+ * // 场景结束：
+ * recorder.save("replays/last.mwr");
+ * @endcode
+ */
+
+#include "replay_log.h"
+#include "../defs/event.h"
+#include <entt/entity/entity.hpp>
+#include <entt/signal/fwd.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace game::sim {
+
+class ReplayRecorder final {
+public:
+    /// @brief 默认的校验值间隔：60Hz 下每秒 4 次，十分钟约 140KB
+    static constexpr std::uint32_t DEFAULT_CHECKSUM_INTERVAL = 15;
+
+    explicit ReplayRecorder(entt::dispatcher& dispatcher);
+    ~ReplayRecorder();
+
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+    /// @brief 清空已录制内容并开始新的录制
+    void begin(std::uint64_t seed, std::uint32_t level_index, float delta_time);
+
+    /// @brief 一个模拟步开始，dt 与上一步不同时记录 SET_DELTA_TIME
+    void beginStep(float delta_time);
+    /// @brief 一个模拟步结束，之后的指令归入下一步
+    void endStep() { ++tick_; }
+
+    /// @brief 本步（endStep 之前）是否要记录状态校验值：每 DEFAULT_CHECKSUM_INTERVAL 步一次，录制中才为 true
+    [[nodiscard]] bool isChecksumTick() const { return recording_ && (tick_ + 1) % checksum_interval_ == 0; }
+    /// @brief 记录本步执行完之后的状态校验值（endStep 之前调用）
+    void recordChecksum(const StateChecksum& checksum);
+    /// @brief 校验值的记录间隔（步），1 表示每步记录，可以精确到第一个不一致的步
+    void setChecksumInterval(std::uint32_t interval) { checksum_interval_ = interval > 0 ? interval : 1; }
+
+    /// @brief 写出日志并结束录制（未在录制中时直接返回 false）
+    bool save(const std::string& path);
+
+    /// @brief 放弃本次录制且不写出（战斗回退到中途检查点后，录制内容已无法重放）
+    void discard() { recording_ = false; }
+
+    [[nodiscard]] const ReplayLog& getLog() const { return log_; }
+
+private:
+    void onUnitPlaced(const game::defs::UnitPlacedEvent& event);
+    void onUpgradeUnit(const game::defs::UpgradeUnitEvent& event);
+    void onRetreat(const game::defs::RetreatEvent& event);
+    void onReleaseHeroSkill(const game::defs::ReleaseHeroSkillEvent& event);
+    /// @brief 按放置序号记录引用某个单位的指令，未经放置的单位（如测试刷出的）忽略
+    void recordUnitCommand(ReplayCommandType type, entt::entity entity, int cost);
+
+    entt::dispatcher& dispatcher_;
+    ReplayLog log_;
+    std::unordered_map<entt::entity, std::uint32_t> unit_ordinals_;
+    std::uint64_t tick_{ 0 };
+    float delta_time_{ 0.0f };
+    std::uint32_t checksum_interval_{ DEFAULT_CHECKSUM_INTERVAL };
+    bool recording_{ false };
+};
+
+} // namespace game::sim
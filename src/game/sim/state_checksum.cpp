@@ -0,0 +1,162 @@
+#include "state_checksum.h"
+
+#include "../component/blocked_by_component.h"
+#include "../component/enemy_component.h"
+#include "../component/hero_skill_component.h"
+#include "../component/stats_component.h"
+#include "../component/target_component.h"
+#include "../../engine/component/transform_component.h"
+#include "../../engine/utils/profiler.h"
+#include <bit>
+#include <entt/entity/registry.hpp>
+
+namespace game::sim {
+
+namespace {
+
+/// splitmix64 的终结函数：乘法与移位，没有分支
+constexpr std::uint64_t mix(std::uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ull;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+constexpr std::uint64_t bits(float value) {
+    return std::bit_cast<std::uint32_t>(value);
+}
+
+constexpr std::uint64_t bits(int value) {
+    return static_cast<std::uint32_t>(value);
+}
+
+/// 两个 32 位字段拼成一个 64 位字，减少一半的混合次数
+constexpr std::uint64_t pack(std::uint64_t high, std::uint64_t low) {
+    return (high << 32) | (low & 0xFFFFFFFFull);
+}
+
+constexpr std::uint64_t hashOf(const glm::vec2& position) {
+    return mix(pack(bits(position.x), bits(position.y)));
+}
+
+/// 被引用单位的位置；空引用或已销毁的单位使用固定值
+std::uint64_t hashReference(const entt::registry& registry, entt::entity entity) {
+    if (entity == entt::null || !registry.valid(entity)) {
+        return 0x6E756C6C656E7479ull;
+    }
+    const auto* transform = registry.try_get<engine::component::TransformComponent>(entity);
+    return transform ? hashOf(transform->position_) : 0x6E6F706F73697469ull;
+}
+
+/// 各元素的散列相加（与顺序无关），最后混入元素个数
+template <typename... Components, typename Fn>
+std::uint64_t sumOver(const entt::registry& registry, Fn&& hash) {
+    std::uint64_t sum = 0;
+    std::uint64_t count = 0;
+    registry.view<const Components...>().each([&](const Components&... components) {
+        sum += hash(components...);
+        ++count;
+    });
+    return mix(sum ^ mix(count));
+}
+
+} // namespace
+
+std::string_view checksumComponentName(ChecksumComponent component) {
+    switch (component) {
+    case ChecksumComponent::TRANSFORM: return "Transform";
+    case ChecksumComponent::STATS: return "Stats";
+    case ChecksumComponent::ENEMY: return "Enemy";
+    case ChecksumComponent::TARGET: return "Target";
+    case ChecksumComponent::BLOCKED_BY: return "BlockedBy";
+    case ChecksumComponent::HERO_SKILL: return "HeroSkill";
+    case ChecksumComponent::GAME_STATS: return "GameStats";
+    }
+    return "Unknown";
+}
+
+std::uint64_t StateChecksum::combined() const {
+    std::uint64_t hash = 0;
+    for (const auto component : components_) {
+        hash = mix(hash ^ component);
+    }
+    return hash;
+}
+
+std::uint32_t StateChecksum::diff(const StateChecksum& other) const {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < CHECKSUM_COMPONENT_COUNT; ++i) {
+        if (components_[i] != other.components_[i]) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+StateChecksum computeStateChecksum(const entt::registry& registry, const game::data::GameStats& game_stats) {
+    ENGINE_PROFILE_SCOPE("StateChecksum");
+    using engine::component::TransformComponent;
+    using game::component::StatsComponent;
+    StateChecksum checksum;
+    auto& out = checksum.components_;
+
+    // 只有单位（带 StatsComponent）的位置影响战斗；视图以较小的 Stats 存储驱动
+    out[static_cast<std::size_t>(ChecksumComponent::TRANSFORM)] = sumOver<TransformComponent, StatsComponent>(registry,
+        [](const TransformComponent& transform, const StatsComponent&) {
+            return hashOf(transform.position_) ^ mix(bits(transform.rotation_));
+        });
+    out[static_cast<std::size_t>(ChecksumComponent::STATS)] = sumOver<StatsComponent>(registry,
+        [](const StatsComponent& stats) {
+            std::uint64_t hash = mix(pack(bits(stats.hp_), bits(stats.max_hp_)));
+            hash = mix(hash ^ pack(bits(stats.atk_), bits(stats.def_)));
+            hash = mix(hash ^ pack(bits(stats.range_), bits(stats.level_)));
+            return mix(hash ^ bits(stats.rarity_));
+        });
+    out[static_cast<std::size_t>(ChecksumComponent::ENEMY)] = sumOver<game::component::EnemyComponent>(registry,
+        [](const game::component::EnemyComponent& enemy) {
+            // segment_remaining_ / distance_to_home_ 由位置与路径段推导，低细节敌人跳过路径检查期间不刷新
+            // （是否低细节取决于视口），不参与校验
+            std::uint64_t hash = mix(pack(bits(enemy.target_waypoint_id_), bits(enemy.speed_)));
+            return mix(hash ^ pack(enemy.path_segment_, bits(enemy.threat_)));
+        });
+    out[static_cast<std::size_t>(ChecksumComponent::TARGET)] = sumOver<game::component::TargetComponent>(registry,
+        [&registry](const game::component::TargetComponent& target) {
+            std::uint64_t hash = hashReference(registry, target.entity_);
+            hash = mix(hash ^ hashOf(target.self_anchor_));
+            hash = mix(hash ^ hashOf(target.target_anchor_));
+            return mix(hash ^ bits(target.slack_sq_));
+        });
+    out[static_cast<std::size_t>(ChecksumComponent::BLOCKED_BY)] = sumOver<game::component::BlockedByComponent>(registry,
+        [&registry](const game::component::BlockedByComponent& blocked) {
+            return hashReference(registry, blocked.entity_);
+        });
+    out[static_cast<std::size_t>(ChecksumComponent::HERO_SKILL)] = sumOver<game::component::HeroSkillComponent>(registry,
+        [](const game::component::HeroSkillComponent& skill) {
+            std::uint64_t hash = mix(pack(skill.skill_id_, bits(skill.cooldown_)));
+            hash = mix(hash ^ skill.cooldown_end_tick_);
+            hash = mix(hash ^ pack(bits(skill.duration_), (skill.passive_ ? 2u : 0u) | (skill.active_ ? 1u : 0u)));
+            return mix(hash ^ skill.duration_end_tick_);
+        });
+
+    std::uint64_t stats_hash = mix(pack(bits(game_stats.cost_), bits(game_stats.cost_gen_per_second_)));
+    stats_hash = mix(stats_hash ^ pack(bits(game_stats.home_hp_), bits(game_stats.enemy_count_)));
+    stats_hash = mix(stats_hash ^ pack(bits(game_stats.enemy_arrived_count_), bits(game_stats.enemy_killed_count_)));
+    out[static_cast<std::size_t>(ChecksumComponent::GAME_STATS)] = stats_hash;
+    return checksum;
+}
+
+std::string describeChecksumDiff(std::uint32_t mask) {
+    std::string text;
+    for (std::size_t i = 0; i < CHECKSUM_COMPONENT_COUNT; ++i) {
+        if (mask & (1u << i)) {
+            if (!text.empty()) {
+                text += ", ";
+            }
+            text += checksumComponentName(static_cast<ChecksumComponent>(i));
+        }
+    }
+    return text;
+}
+
+} // namespace game::sim
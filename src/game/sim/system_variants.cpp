@@ -0,0 +1,97 @@
+#include "system_variants.h"
+
+#include "../system/block_system.h"
+#include "../system/set_target_system.h"
+#include <algorithm>
+#include <entt/entity/registry.hpp>
+
+namespace game::sim {
+
+namespace {
+
+/// @brief 现有的 SetTargetSystem
+class DefaultSetTarget final : public SystemVariant {
+public:
+    explicit DefaultSetTarget(entt::registry& registry) : system_(registry) {}
+
+    void update(entt::registry& registry, engine::ecs::CommandBuffer& commands) override {
+        system_.update(registry, commands);
+    }
+
+private:
+    game::system::SetTargetSystem system_;
+};
+
+/// @brief 现有的 BlockSystem
+class DefaultBlock final : public SystemVariant {
+public:
+    void update(entt::registry& registry, engine::ecs::CommandBuffer& commands) override {
+        system_.update(registry, commands);
+    }
+
+    void onEntitiesDestroyed(entt::registry& registry, std::span<const entt::entity> entities) override {
+        system_.onEntitiesDestroyed(registry, entities);
+    }
+
+private:
+    game::system::BlockSystem system_;
+};
+
+} // namespace
+
+std::string_view systemSlotName(SystemSlot slot) {
+    switch (slot) {
+    case SystemSlot::SET_TARGET: return "set_target";
+    case SystemSlot::BLOCK: return "block";
+    }
+    return "set_target";
+}
+
+std::optional<SystemSlot> parseSystemSlot(std::string_view name) {
+    for (const auto slot : { SystemSlot::SET_TARGET, SystemSlot::BLOCK }) {
+        if (name == systemSlotName(slot)) {
+            return slot;
+        }
+    }
+    return std::nullopt;
+}
+
+SystemVariantRegistry& SystemVariantRegistry::instance() {
+    static SystemVariantRegistry registry;
+    return registry;
+}
+
+SystemVariantRegistry::SystemVariantRegistry() {
+    add(SystemSlot::SET_TARGET, "default", [](entt::registry& registry) -> std::unique_ptr<SystemVariant> {
+        return std::make_unique<DefaultSetTarget>(registry);
+    });
+    add(SystemSlot::BLOCK, "default", [](entt::registry&) -> std::unique_ptr<SystemVariant> {
+        return std::make_unique<DefaultBlock>();
+    });
+}
+
+void SystemVariantRegistry::add(SystemSlot slot, std::string name, SystemVariantFactory factory) {
+    const auto it = std::ranges::find_if(entries_, [&](const Entry& entry) { return entry.slot_ == slot && entry.name_ == name; });
+    if (it != entries_.end()) {
+        it->factory_ = factory;
+        return;
+    }
+    entries_.push_back(Entry{ slot, std::move(name), factory });
+}
+
+std::unique_ptr<SystemVariant> SystemVariantRegistry::create(SystemSlot slot, std::string_view name, entt::registry& registry) const {
+    const auto it = std::ranges::find_if(entries_, [&](const Entry& entry) { return entry.slot_ == slot && entry.name_ == name; });
+    return it != entries_.end() ? it->factory_(registry) : nullptr;
+}
+
+std::vector<std::string_view> SystemVariantRegistry::names(SystemSlot slot) const {
+    std::vector<std::string_view> result;
+    for (const auto& entry : entries_) {
+        if (entry.slot_ == slot) {
+            result.emplace_back(entry.name_);
+        }
+    }
+    return result;
+}
+
+} // namespace game::sim
@@ -0,0 +1,87 @@
+#pragma once
+/**
+ * @file system_variants.h
+ * @brief 可替换系统的具名实现：同一个系统槽位（索敌、阻挡）注册多个实现，无头模拟按名字选用，供 A/B 对比。
+ *
+ * @details
+ * 优化 SetTargetSystem / BlockSystem 时，新实现以 SystemVariant 包装后在 SystemVariantRegistry 注册，
+ * 不改动 GameScene 与无头模拟的系统顺序：
+ * @code
+ * class GridOnlySetTarget final : public game::sim::SystemVariant { ... };
+ * game::sim::SystemVariantRegistry::instance().add(game::sim::SystemSlot::SET_TARGET, "grid_only",
+ *     [](entt::registry& registry) -> std::unique_ptr<game::sim::SystemVariant> { return std::make_unique<GridOnlySetTarget>(registry); });
+ * @endcode
+ * "default" 是现有实现本身。HeadlessOptions::set_target_variant_ / block_variant_ 非空时，
+ * 无头模拟用注册的实现代替该槽位，并逐步记录其耗时（HeadlessSimulation::getVariantMs()）；对比见 ab_harness.h。
+ *
+ * 注册只在启动时、单线程进行；之后 create() 可在任意线程调用。
+ */
+
+#include <entt/entity/fwd.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::ecs {
+class CommandBuffer;
+}
+
+namespace game::sim {
+
+enum class SystemSlot : std::uint8_t {
+    SET_TARGET,     ///< 目标锁定（SetTargetSystem）
+    BLOCK,          ///< 阻挡（BlockSystem）
+};
+
+/// @brief 槽位名（"set_target" / "block"），用于命令行与日志
+[[nodiscard]] std::string_view systemSlotName(SystemSlot slot);
+
+/// @brief 解析槽位名，未知名称返回空
+[[nodiscard]] std::optional<SystemSlot> parseSystemSlot(std::string_view name);
+
+/**
+ * @brief 一个槽位的实现：与被替换的系统在同一位置、以同样的参数每步调用一次
+ */
+class SystemVariant {
+public:
+    virtual ~SystemVariant() = default;
+
+    virtual void update(entt::registry& registry, engine::ecs::CommandBuffer& commands) = 0;
+
+    /// @brief RemoveDeadSystem 批量收尾（只有 BLOCK 槽位会连接）
+    virtual void onEntitiesDestroyed(entt::registry& /*registry*/, std::span<const entt::entity> /*entities*/) {}
+};
+
+/// @brief 为一个注册表创建实现（在注册表创建之后、第一次 update() 之前调用）
+using SystemVariantFactory = std::unique_ptr<SystemVariant> (*)(entt::registry& registry);
+
+class SystemVariantRegistry final {
+public:
+    /// @brief 进程内唯一的注册表（首次访问时注册各槽位的 "default"）
+    [[nodiscard]] static SystemVariantRegistry& instance();
+
+    /// @brief 注册实现，同一槽位重名时替换
+    void add(SystemSlot slot, std::string name, SystemVariantFactory factory);
+
+    /// @brief 按名字创建实现，未注册时返回 nullptr
+    [[nodiscard]] std::unique_ptr<SystemVariant> create(SystemSlot slot, std::string_view name, entt::registry& registry) const;
+
+    /// @brief 槽位已注册的实现名（注册顺序）
+    [[nodiscard]] std::vector<std::string_view> names(SystemSlot slot) const;
+
+private:
+    SystemVariantRegistry();
+
+    struct Entry {
+        SystemSlot slot_;
+        std::string name_;
+        SystemVariantFactory factory_;
+    };
+    std::vector<Entry> entries_;
+};
+
+} // namespace game::sim
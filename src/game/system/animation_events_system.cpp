@@ -4,15 +4,20 @@
 #include "../component/target_component.h"
 #include "../component/stats_component.h"
 #include "../component/blocked_by_component.h"
+#include "../../engine/component/transform_component.h"
+#include "../defs/ids.h"
 #include "../defs/tags.h"
 #include "../defs/event.h"
+#include "../data/class_cost_profiler.h"
+#include "../data/projectile_pool.h"
 #include <entt/entt.hpp>
+#include "../../engine/ecs/event_queues.h"
 #include "../../engine/utils/logging.h"
 
 using namespace entt::literals;
 namespace game::system {
-	AnimationEventsSystem::AnimationEventsSystem(entt::registry& registry, entt::dispatcher& dispatcher)
-		: registry_(registry), dispatcher_(dispatcher) {
+	AnimationEventsSystem::AnimationEventsSystem(entt::registry& registry, entt::dispatcher& dispatcher, engine::ecs::EventQueues& event_queues)
+		: registry_(registry), dispatcher_(dispatcher), event_queues_(event_queues) {
 		dispatcher_.sink<engine::utils::AnimationEvent>().connect<&AnimationEventsSystem::onAnimationEvent>(this);
 	}
 	AnimationEventsSystem::~AnimationEventsSystem() {
@@ -30,7 +35,10 @@ namespace game::system {
           ENGINE_LOG_WARN("无效实体: entity={}, event_id={:x}, animation_id={:x}", entt::to_integral(event.entity_), event.event_id_, event.animation_id_);
 			return;
 		}
-      if (event.event_id_ == "hit"_hs || event.event_id_ == "emit"_hs) {
+      const auto frame_event = game::ids::fromHash<game::ids::FrameEvent>(event.event_id_);
+      if (frame_event == game::ids::FrameEvent::HIT || frame_event == game::ids::FrameEvent::EMIT) {
+			const game::data::ClassCostProfiler::Scope cost{ registry_.ctx().find<game::data::ClassCostProfiler>(), registry_, event.entity_,
+				game::data::CostCategory::ANIMATION_EVENTS };
 			handleHitEvent(event);
 		}
 	}
@@ -47,24 +55,36 @@ namespace game::system {
 				target = attack_target->entity_;
 			}
 			if (target != entt::null) {
-               if (auto enemy = registry_.try_get<game::component::EnemyComponent>(event.entity_); enemy && enemy->projectile_id_ != entt::null) {
-					dispatcher_.enqueue(game::defs::SpawnProjectileVisualEvent{ event.entity_, target, enemy->projectile_id_ });
+               const auto& enemy = registry_.get<game::component::EnemyComponent>(event.entity_);
+				const float damage = stats ? stats->atk_ : 0.0f;
+				if (!enqueueLaunch(event.entity_, target, enemy.projectile_id_, damage, game::defs::spatial_layer::PLAYER)) {
+					if (enemy.projectile_id_ != entt::null) {
+						dispatcher_.enqueue(game::defs::SpawnProjectileVisualEvent{ event.entity_, target, enemy.projectile_id_ });
+					}
+					event_queues_.enqueue(game::defs::AttackHitEvent{ event.entity_, target, damage });
 				}
-				dispatcher_.enqueue(game::defs::AttackHitEvent{ event.entity_, target, stats ? stats->atk_ : 0.0f });
 				dispatcher_.enqueue(engine::utils::PlaySoundEvent{ event.entity_, event.event_id_ });
 			}
 		} else if (registry_.all_of<game::component::PlayerComponent>(event.entity_)) {
             ENGINE_LOG_DEBUG("处理命中事件: 实体={} 是玩家", entt::to_integral(event.entity_));
 			auto stats = registry_.try_get<game::component::StatsComponent>(event.entity_);
-			if (auto target = registry_.try_get<game::component::TargetComponent>(event.entity_)) {
+			if (auto target = registry_.try_get<game::component::TargetComponent>(event.entity_); target && target->entity_ != entt::null) {
 				if (registry_.all_of<game::defs::HealerTag>(event.entity_)) {
-					dispatcher_.enqueue(game::defs::HealerHitEvent{ event.entity_, target->entity_, stats ? stats->atk_ : 0.0f });
+					event_queues_.enqueue(game::defs::HealerHitEvent{ event.entity_, target->entity_, stats ? stats->atk_ : 0.0f });
 				}
 				else{
-                  if (auto player = registry_.try_get<game::component::PlayerComponent>(event.entity_); player && player->projectile_id_ != entt::null) {
-						dispatcher_.enqueue(game::defs::SpawnProjectileVisualEvent{ event.entity_, target->entity_, player->projectile_id_ });
+                  const auto& player = registry_.get<game::component::PlayerComponent>(event.entity_);
+					const float damage = stats ? stats->atk_ : 0.0f;
+					// 范围攻击仍在出手时立即结算，只有单体攻击才发射模拟投射物
+					const bool area = player.area_shape_ != game::defs::AreaShape::NONE;
+					if (area || !enqueueLaunch(event.entity_, target->entity_, player.projectile_id_, damage, game::defs::spatial_layer::ENEMY)) {
+						if (player.projectile_id_ != entt::null) {
+							dispatcher_.enqueue(game::defs::SpawnProjectileVisualEvent{ event.entity_, target->entity_, player.projectile_id_ });
+						}
+						if (!enqueueAreaHit(event.entity_, player, target->entity_, damage)) {
+							event_queues_.enqueue(game::defs::AttackHitEvent{ event.entity_, target->entity_, damage });
+						}
 					}
-					dispatcher_.enqueue(game::defs::AttackHitEvent{ event.entity_, target->entity_, stats ? stats->atk_ : 0.0f });
 				}
               dispatcher_.enqueue(engine::utils::PlaySoundEvent{ event.entity_, event.event_id_ });
                ENGINE_LOG_DEBUG("处理命中事件完成: entity={}", entt::to_integral(event.entity_));
@@ -76,4 +96,43 @@ namespace game::system {
 
 	}
 
+	bool AnimationEventsSystem::enqueueLaunch(entt::entity attacker, entt::entity target, entt::id_type projectile_id, float damage, std::uint32_t mask)
+	{
+		if (projectile_id == entt::null) {
+			return false;
+		}
+		const auto* pool = registry_.ctx().find<game::data::ProjectilePool>();
+		if (!pool || !pool->findKind(projectile_id)) {
+			return false;
+		}
+		event_queues_.enqueue(game::defs::LaunchProjectileEvent{ attacker, target, projectile_id, damage, mask });
+		return true;
+	}
+
+	bool AnimationEventsSystem::enqueueAreaHit(entt::entity attacker, const game::component::PlayerComponent& player, entt::entity target, float damage)
+	{
+		if (player.area_shape_ == game::defs::AreaShape::NONE || player.area_radius_ <= 0.0f) {
+			return false;
+		}
+		// contains() 比较完整句柄（含版本），已销毁的目标不会命中
+		const auto& transforms = registry_.storage<engine::component::TransformComponent>();
+		const auto* from = transforms.contains(attacker) ? &transforms.get(attacker) : nullptr;
+		const auto* to = transforms.contains(target) ? &transforms.get(target) : nullptr;
+		if (!from || !to) {
+			return false;
+		}
+		// 圆形以目标为圆心；扇形与穿透路径从攻击者指向目标
+		const bool circle = player.area_shape_ == game::defs::AreaShape::CIRCLE;
+		event_queues_.enqueue(game::defs::AreaHitEvent{
+			attacker,
+			player.area_shape_,
+			circle ? to->position_ : from->position_,
+			to->position_,
+			player.area_radius_,
+			player.area_cos_half_angle_,
+			damage,
+			game::defs::spatial_layer::ENEMY });
+		return true;
+	}
+
 }
\ No newline at end of file
@@ -2,6 +2,16 @@
 #include "../../engine/utils/events.h"
 #include <entt/entity/fwd.hpp>
 #include <entt/signal/fwd.hpp>
+#include <entt/core/fwd.hpp>
+#include <cstdint>
+
+namespace engine::ecs {
+	class EventQueues;
+}
+
+namespace game::component {
+	struct PlayerComponent;
+}
 
 namespace game::system {
 	/**
@@ -16,8 +26,9 @@ namespace game::system {
 		 * @brief 构造动画事件处理系统并完成事件订阅初始化。
 		 * @param registry EnTT 实体注册表引用，用于访问和操作实体组件。
 		 * @param dispatcher EnTT 事件分发器引用，用于接收动画事件。
+		 * @param event_queues 批量事件通道，命中/治疗事件写入其中由 CombatResolveSystem 整段结算。
 		 */
-		AnimationEventsSystem(entt::registry& registry, entt::dispatcher& dispatcher);
+		AnimationEventsSystem(entt::registry& registry, entt::dispatcher& dispatcher, engine::ecs::EventQueues& event_queues);
 
 		/**
 		 * @brief 析构函数。
@@ -39,10 +50,25 @@ namespace game::system {
 		 */
 		void handleHitEvent(const engine::utils::AnimationEvent& event);
 
+		/**
+		 * @brief 投射物ID登记为模拟投射物时改发一个 LaunchProjectileEvent，由 ProjectileSystem 在飞行中判定命中。
+		 * @return 没有投射物、不是模拟投射物或场景未创建 ProjectilePool 时返回 false，由调用方照常立即命中。
+		 */
+		bool enqueueLaunch(entt::entity attacker, entt::entity target, entt::id_type projectile_id, float damage, std::uint32_t mask);
+
+		/**
+		 * @brief 带范围攻击的玩家单位改发一个 AreaHitEvent（受害者在结算时由空间网格查询）。
+		 * @return 单体攻击单位或缺少变换组件时返回 false，由调用方照常发出 AttackHitEvent。
+		 */
+		bool enqueueAreaHit(entt::entity attacker, const game::component::PlayerComponent& player, entt::entity target, float damage);
+
 		/** @brief 实体注册表引用。 */
 		entt::registry& registry_;
 
 		/** @brief 事件分发器引用。 */
 		entt::dispatcher& dispatcher_;
+
+		/** @brief 批量事件通道引用。 */
+		engine::ecs::EventQueues& event_queues_;
 	};
 }
\ No newline at end of file
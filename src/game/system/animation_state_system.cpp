@@ -3,12 +3,12 @@
 #include "game/component/player_component.h"
 #include "game/component/hero_skill_component.h"
 #include "game/component/blocked_by_component.h"
+#include "game/data/behavior_index.h"
+#include "game/defs/ids.h"
 #include "game/defs/tags.h"
 #include "../../engine/component/animation_component.h"
-#include "../../engine/component/transform_component.h"
-#include "../../engine/component/sprite_component.h"
-#include "../../engine/component/velocity_component.h"
-#include "../../engine/component/render_component.h"
+#include "../../engine/component/animation_request_component.h"
+#include "../../engine/component/disabled_tag.h"
 #include <entt/signal/dispatcher.hpp>
 #include "../../engine/utils/logging.h"
 
@@ -33,31 +33,15 @@ void AnimationStateSystem::onAnimationFinished(const AnimationFinishedEvent& eve
     auto entity = event.entity_;
     if (!registry_.valid(entity)) return;
 
-    // 移除动作锁
-    if (registry_.all_of<ActionLockTag>(entity)) {
-        registry_.remove<ActionLockTag>(entity);
-    }
+    // 解除动作锁（非锁定状态下转移表保持原状态）
+    registry_.ctx().get<game::data::BehaviorIndex&>().transition(entity, BehaviorEvent::ACTION_END);
 
     if (registry_.all_of<VisualEffectTag>(entity)) {
-        if (registry_.all_of<TransformComponent>(entity)) {
-            registry_.remove<TransformComponent>(entity);
-        }
-        if (registry_.all_of<AnimationComponent>(entity)) {
-            registry_.remove<AnimationComponent>(entity);
-        }
-        if (registry_.all_of<SpriteComponent>(entity)) {
-            registry_.remove<SpriteComponent>(entity);
-        }
-        if (registry_.all_of<VelocityComponent>(entity)) {
-            registry_.remove<VelocityComponent>(entity);
-        }
-        if (registry_.all_of<RenderComponent>(entity)) {
-            registry_.remove<RenderComponent>(entity);
-        }
-        if (!registry_.all_of<DeadTag>(entity)) {
-            registry_.emplace<DeadTag>(entity);
+        // 停用而非销毁，由 VisualPool 回收复用（组件原样保留，下次取出时覆盖）
+        if (!registry_.all_of<DisabledTag>(entity)) {
+            registry_.emplace<DisabledTag>(entity);
         }
-        ENGINE_LOG_DEBUG("视觉实体动画结束并标记删除: {}", entt::to_integral(entity));
+        ENGINE_LOG_DEBUG("视觉实体动画结束并回收: {}", entt::to_integral(entity));
         return;
     }
 
@@ -66,23 +50,23 @@ void AnimationStateSystem::onAnimationFinished(const AnimationFinishedEvent& eve
         // 敌人：被阻挡则回 idle，否则回 walk
         if (registry_.all_of<BlockedByComponent>(entity)) {
             ENGINE_LOG_DEBUG("动画结束后回切敌方受阻实体: {}", entt::to_integral(entity));
-            dispatcher_.enqueue(PlayAnimationEvent{entity, "idle"_hs, true});
+            registry_.emplace_or_replace<AnimationRequestComponent>(entity, "idle"_hs, true);
         } else {
             ENGINE_LOG_DEBUG("动画结束后回切敌方移动实体: {}", entt::to_integral(entity));
-            dispatcher_.enqueue(PlayAnimationEvent{entity, "walk"_hs, true});
+            registry_.emplace_or_replace<AnimationRequestComponent>(entity, "walk"_hs, true);
         }
     } else if (registry_.all_of<PlayerComponent>(entity)) {
         if (registry_.all_of<SkillActiveTag>(entity) && registry_.all_of<game::component::HeroSkillComponent>(entity)) {
             const auto& skill = registry_.get<game::component::HeroSkillComponent>(entity);
-            if (skill.skill_id_ == entt::hashed_string("shield").value()) {
+            if (skill.skill_id_ == game::ids::hashOf(game::ids::Skill::SHIELD)) {
                 ENGINE_LOG_DEBUG("动画结束后回切盾御实体守备姿态: {}", entt::to_integral(entity));
-                dispatcher_.enqueue(PlayAnimationEvent{entity, "guard"_hs, true});
+                registry_.emplace_or_replace<AnimationRequestComponent>(entity, "guard"_hs, true);
                 return;
             }
         }
 
         ENGINE_LOG_DEBUG("动画结束后回切玩家实体: {}", entt::to_integral(entity));
-        dispatcher_.enqueue(PlayAnimationEvent{entity, "idle"_hs, true});
+        registry_.emplace_or_replace<AnimationRequestComponent>(entity, "idle"_hs, true);
     }
 }
 
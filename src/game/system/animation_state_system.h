@@ -11,7 +11,7 @@ namespace game::system {
  * 
  * @details
  * 该系统监听 AnimationFinishedEvent 事件。当非循环动画（如攻击、治疗）播放结束时：
- * 1. 移除 ActionLockTag。
+ * 1. 发出 ACTION_END 转移，解除动作锁定（BehaviorComponent）。
  * 2. 根据单位当前状态（是否被阻挡等）切换回 idle 或 walk 动画。
  */
 class AnimationStateSystem {
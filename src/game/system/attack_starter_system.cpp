@@ -1,13 +1,19 @@
 #include "attack_starter_system.h"
+#include "engine/component/animation_request_component.h"
 #include "engine/component/velocity_component.h"
-#include "game/component/stats_component.h"
+#include "game/component/attack_timer_component.h"
+#include "game/component/behavior_component.h"
 #include "game/component/enemy_component.h"
 #include "game/component/player_component.h"
 #include "game/component/target_component.h"
 #include "game/component/blocked_by_component.h"
+#include "game/data/behavior_index.h"
 #include "game/defs/tags.h"
 #include "engine/utils/events.h"
+#include "engine/ecs/command_buffer.h"
 #include "../../engine/utils/logging.h"
+#include "../../engine/utils/profiler.h"
+#include <cstdint>
 
 namespace game::system {
 
@@ -17,50 +23,52 @@ using namespace game::component;
 using namespace game::defs;
 using namespace entt::literals;
 
-void AttackStarterSystem::update(entt::registry& registry, entt::dispatcher& dispatcher) {
-    // 1. 处理被阻挡的敌人（近战攻击）
-    auto view_enemy_blocked = registry.view<EnemyComponent, BlockedByComponent, AttackReadyTag, StatsComponent>();
-    for (auto enemy_entity : view_enemy_blocked) {
-        // 标记动作锁定，移除准备就绪标签，重置计时器
-        registry.emplace_or_replace<ActionLockTag>(enemy_entity);
-        registry.remove<AttackReadyTag>(enemy_entity);
-        registry.get<StatsComponent>(enemy_entity).atk_timer_ = 0.0f;
+void AttackStarterSystem::update(entt::registry& registry, engine::ecs::CommandBuffer& commands) {
+    auto& behaviors = registry.ctx().get<game::data::BehaviorIndex&>();
 
-        // 发送播放攻击动画事件
-        dispatcher.enqueue(PlayAnimationEvent{enemy_entity, "attack"_hs, false});
-        ENGINE_LOG_DEBUG("敌方近战攻击启动 entity={}", entt::to_integral(enemy_entity));
+    // 只看冷却已结束的单位；转移会改动列表，先复制
+    ready_.clear();
+    for (const auto state : { BehaviorState::READY, BehaviorState::ACTING_READY }) {
+        const auto& list = behaviors.inState(state);
+        ready_.insert(ready_.end(), list.begin(), list.end());
     }
+    ENGINE_PROFILE_COUNTER("attack.ready", static_cast<std::int64_t>(ready_.size()));
 
-    // 2. 处理远程敌人（在射程内有目标，且未被阻挡）
-    auto view_enemy_ranged = registry.view<EnemyComponent, TargetComponent, AttackReadyTag, StatsComponent>(
-        entt::exclude<BlockedByComponent>
-    );
-    for (auto enemy_entity : view_enemy_ranged) {
-        registry.emplace_or_replace<ActionLockTag>(enemy_entity);
-        registry.remove<AttackReadyTag>(enemy_entity);
-        registry.get<StatsComponent>(enemy_entity).atk_timer_ = 0.0f;
+    for (const auto entity : ready_) {
+        auto& timer = registry.get<AttackTimerComponent>(entity);
+        if (registry.all_of<EnemyComponent>(entity)) {
+            // 1. 被阻挡的敌人（近战攻击）；2. 射程内有目标且未被阻挡的远程敌人
+            const bool blocked = registry.all_of<BlockedByComponent>(entity);
+            if (!blocked && !registry.all_of<TargetComponent>(entity)) {
+                continue;
+            }
+            // 进入动作锁定，重置计时器
+            behaviors.transition(entity, BehaviorEvent::ATTACK_LOCKED);
+            timer.timer_ = 0.0f;
+            if (blocked) {
+                commands.emplace<AnimationRequestComponent>(entity, "attack"_hs, false);
+                ENGINE_LOG_DEBUG("敌方近战攻击启动 entity={}", entt::to_integral(entity));
+                continue;
+            }
 
-        // 远程攻击时停止移动
-        if (auto* vel = registry.try_get<VelocityComponent>(enemy_entity)) {
-            vel->velocity_ = {0.0f, 0.0f};
-        }
-
-        dispatcher.enqueue(PlayAnimationEvent{enemy_entity, "ranged_attack"_hs, false});
-        ENGINE_LOG_DEBUG("敌方远程攻击启动 entity={}", entt::to_integral(enemy_entity));
-    }
-
-    // 3. 处理玩家单位（攻击或治疗）
-    auto view_player = registry.view<PlayerComponent, TargetComponent, AttackReadyTag, StatsComponent>();
-    for (auto player_entity : view_player) {
-        registry.remove<AttackReadyTag>(player_entity);
-        registry.get<StatsComponent>(player_entity).atk_timer_ = 0.0f;
+            // 远程攻击时停止移动
+            if (auto* vel = registry.try_get<VelocityComponent>(entity)) {
+                vel->velocity_ = {0.0f, 0.0f};
+            }
+            commands.emplace<AnimationRequestComponent>(entity, "ranged_attack"_hs, false);
+            ENGINE_LOG_DEBUG("敌方远程攻击启动 entity={}", entt::to_integral(entity));
+        } else if (registry.all_of<PlayerComponent, TargetComponent>(entity)) {
+            // 3. 玩家单位（攻击或治疗），不锁定动作
+            behaviors.transition(entity, BehaviorEvent::ATTACK_FREE);
+            timer.timer_ = 0.0f;
 
-        if (registry.all_of<HealerTag>(player_entity)) {
-            dispatcher.enqueue(PlayAnimationEvent{player_entity, "heal"_hs, false});
-            ENGINE_LOG_DEBUG("玩家治疗启动 entity={}", entt::to_integral(player_entity));
-        } else {
-            dispatcher.enqueue(PlayAnimationEvent{player_entity, "attack"_hs, false});
-            ENGINE_LOG_DEBUG("玩家攻击启动 entity={}", entt::to_integral(player_entity));
+            if (registry.all_of<HealerTag>(entity)) {
+                commands.emplace<AnimationRequestComponent>(entity, "heal"_hs, false);
+                ENGINE_LOG_DEBUG("玩家治疗启动 entity={}", entt::to_integral(entity));
+            } else {
+                commands.emplace<AnimationRequestComponent>(entity, "attack"_hs, false);
+                ENGINE_LOG_DEBUG("玩家攻击启动 entity={}", entt::to_integral(entity));
+            }
         }
     }
 }
@@ -1,6 +1,11 @@
 #pragma once
 
 #include <entt/entt.hpp>
+#include <vector>
+
+namespace engine::ecs {
+class CommandBuffer;
+}
 
 namespace game::system {
 
@@ -14,19 +19,23 @@ namespace game::system {
  * 2. 检查远程单位的 TargetComponent，触发远程攻击。
  * 3. 检查治疗单位的 TargetComponent，触发治疗动作。
  * 
+ * 只遍历 game::data::BehaviorIndex 中冷却已结束（READY / ACTING_READY）的单位，不再扫描带标签的视图。
  * 触发攻击时，会：
- * - 播放对应的攻击动画（通过 PlayAnimationEvent）。
- * - 为实体添加 ActionLockTag（如果是需要锁定的动作）。
- * - 移除 AttackReadyTag，重置攻击冷却计时器。
+ * - 请求播放对应的攻击动画（写入 AnimationRequestComponent）。
+ * - 经转移表进入动作锁定（敌人，ATTACK_LOCKED）或直接回到冷却（玩家单位，ATTACK_FREE）。
+ * - 重置攻击冷却计时器。
  */
 class AttackStarterSystem {
 public:
     /**
      * @brief 检查并启动符合条件的攻击。
      * @param registry EnTT 注册表。
-     * @param dispatcher 事件分发器。
+     * @param commands 组件增删记录到此缓冲，由调用方在同步点提交。
      */
-    void update(entt::registry& registry, entt::dispatcher& dispatcher);
+    void update(entt::registry& registry, engine::ecs::CommandBuffer& commands);
+
+private:
+    std::vector<entt::entity> ready_;   ///< 本步冷却已结束的单位（帧间复用容量）
 };
 
 } // namespace game::system
@@ -2,42 +2,29 @@
 #include "../component/blocker_component.h"
 #include "../component/enemy_component.h"
 #include "../component/blocked_by_component.h"
+#include "../component/behavior_component.h"
+#include "../data/behavior_index.h"
 #include "../defs/tags.h"
 #include "../defs/constants.h"
+#include "../../engine/component/animation_request_component.h"
 #include "../../engine/component/transform_component.h"
 #include "../../engine/component/velocity_component.h"
 #include "../../engine/utils/events.h"
 #include "../../engine/utils/math.h"
+#include "../../engine/spatial/spatial_grid.h"
+#include "../../engine/ecs/command_buffer.h"
 #include <entt/entity/view.hpp>
-#include <spdlog/spdlog.h>
+#include "../../engine/utils/deferred_log.h"
 
 using namespace entt::literals;
 
 namespace game::system {
 
-void BlockSystem::update(entt::registry& registry, entt::dispatcher& dispatcher) {
-    spdlog::trace("BlockSystem::update");
-    // --- 检查阻挡者是否依然有效 ---
-    auto view_blocked_by = registry.view<game::component::BlockedByComponent>();   
-    for (auto blocked_by_entity : view_blocked_by) {
-        auto& blocked_by_component = view_blocked_by.get<game::component::BlockedByComponent>(blocked_by_entity);
-        // 如果BlockedBy指向的实体无效(例如死亡)，移除被阻挡组件，并发送播放动画“walk”事件
-        if (!registry.valid(blocked_by_component.entity_)) {
-            registry.remove<game::component::BlockedByComponent>(blocked_by_entity);
-            
-            // 阻挡关系移除时，顺带移除动作锁并恢复行走动画
-            if (registry.all_of<game::defs::ActionLockTag>(blocked_by_entity)) {
-                registry.remove<game::defs::ActionLockTag>(blocked_by_entity);
-            }
-            dispatcher.enqueue(engine::utils::PlayAnimationEvent{blocked_by_entity, "walk"_hs, true});
-            
-            spdlog::info("阻挡者: ID: {}, 无效, 移除阻挡者组件", entt::to_integral(blocked_by_entity));
-        }
-    }
-
+void BlockSystem::update(entt::registry& registry, engine::ecs::CommandBuffer& commands) {
+    ENGINE_LOG_TRACE("BlockSystem::update");
     // --- 判断是否需要添加阻挡者组件 ---
-    // 获取所有阻挡者
-    auto view_blocker = registry.view<game::component::BlockerComponent, engine::component::TransformComponent>();
+    // 阻挡者通过空间网格查询，只检查敌人附近的单元
+    const auto& grid = registry.ctx().get<engine::spatial::SpatialGrid>();
     // 获取所有敌人，使用 entt::exclude 排除“包含指定组件的实体”（已经存在阻挡者组件的敌人不需要再添加）
     auto view_enemy = registry.view<game::component::EnemyComponent, 
         engine::component::TransformComponent, 
@@ -46,27 +33,70 @@ void BlockSystem::update(entt::registry& registry, entt::dispatcher& dispatcher)
     for (auto enemy_entity : view_enemy) {
         const auto& enemy_transform = view_enemy.get<engine::component::TransformComponent>(enemy_entity);
         auto& enemy_velocity = view_enemy.get<engine::component::VelocityComponent>(enemy_entity);
-        // 每个敌人遍历所有阻挡者，检查是否被阻挡
-        for (auto blocker_entity : view_blocker) {
-            const auto& blocker_transform = view_blocker.get<engine::component::TransformComponent>(blocker_entity);
-            auto& blocker_blocker = view_blocker.get<game::component::BlockerComponent>(blocker_entity);
-            // 如果被阻挡（检查敌人和阻挡者之间的距离是否小于阻挡半径）
-            if (engine::utils::distanceSquared(enemy_transform.position_, blocker_transform.position_) < 
-                    game::defs::BLOCK_RADIUS * game::defs::BLOCK_RADIUS) {
+
+        // 在阻挡半径内选择距离最近且仍有阻挡余量的阻挡者
+        entt::entity blocker_entity = entt::null;
+        float best_distance_sq = game::defs::BLOCK_RADIUS * game::defs::BLOCK_RADIUS;
+        grid.forEachInRadius(enemy_transform.position_, game::defs::BLOCK_RADIUS, game::defs::spatial_layer::BLOCKER,
+            [&](const auto& entry, float distance_sq) {
+                // 如果被阻挡（检查敌人和阻挡者之间的距离是否小于阻挡半径）
+                if (distance_sq >= best_distance_sq || !registry.valid(entry.entity_)) {
+                    return;
+                }
+                const auto* blocker = registry.try_get<game::component::BlockerComponent>(entry.entity_);
                 // 检查阻挡者是否还能阻挡
-                if (blocker_blocker.current_count_ >= blocker_blocker.max_count_) {
-                    continue;   // 如果不能阻挡，则跳过
+                if (!blocker || blocker->current_count_ >= blocker->max_count_ || blocker->current_count_ >= game::defs::MAX_BLOCK_COUNT) {
+                    return;
                 }
-                blocker_blocker.current_count_++;                   // 增加阻挡数量
-                enemy_velocity.velocity_ = glm::vec2(0.0f, 0.0f);   // 设置敌人速度为0
-                // 给敌人添加被阻挡组件
-                registry.emplace<game::component::BlockedByComponent>(enemy_entity, blocker_entity);
-                spdlog::info("敌人: ID: {}, 被阻挡, 阻挡者: ID: {}", entt::to_integral(enemy_entity), entt::to_integral(blocker_entity));
-                
-                // 切换到 idle 动画（等待 AttackStarterSystem 触发攻击）
-                dispatcher.enqueue(engine::utils::PlayAnimationEvent{enemy_entity, "idle"_hs, true});
+                best_distance_sq = distance_sq;
+                blocker_entity = entry.entity_;
+            });
+        if (blocker_entity == entt::null) {
+            continue;
+        }
+
+        registry.get<game::component::BlockerComponent>(blocker_entity).add(enemy_entity);   // 记录被阻挡者并增加阻挡数量
+        enemy_velocity.velocity_ = glm::vec2(0.0f, 0.0f);   // 设置敌人速度为0
+        // 给敌人添加被阻挡组件
+        commands.emplace<game::component::BlockedByComponent>(enemy_entity, blocker_entity);
+        ENGINE_LOG_INFO_DEFERRED("敌人: ID: {}, 被阻挡, 阻挡者: ID: {}", entt::to_integral(enemy_entity), entt::to_integral(blocker_entity));
+        
+        // 切换到 idle 动画（等待 AttackStarterSystem 触发攻击）
+        commands.emplace<engine::component::AnimationRequestComponent>(enemy_entity, "idle"_hs, true);
+    }
+}
+
+void BlockSystem::onEntitiesDestroyed(entt::registry& registry, std::span<const entt::entity> entities) {
+    // 整批待删除实体都带 DeadTag，此时仍然有效；链接两端直接查各自的存储，contains() 比较完整句柄（含版本），无需另行 valid()
+    const auto& dead = registry.storage<game::defs::DeadTag>();
+    auto& blockers = registry.storage<game::component::BlockerComponent>();
+    const auto& blocked_storage = registry.storage<game::component::BlockedByComponent>();
+    auto& behaviors = registry.ctx().get<game::data::BehaviorIndex&>();
+    for (const auto entity : entities) {
+        // 被阻挡的敌人死亡：从阻挡者的列表中移除，归还名额
+        if (blocked_storage.contains(entity)) {
+            if (const auto blocker_entity = blocked_storage.get(entity).entity_; blockers.contains(blocker_entity)) {
+                blockers.get(blocker_entity).erase(entity);
+            }
+        }
+
+        // 阻挡者死亡：放开它阻挡的敌人，移除动作锁并恢复行走动画，本步的 BlockSystem 即可重新为其选择阻挡者
+        if (!blockers.contains(entity)) {
+            continue;
+        }
+        auto& blocker = blockers.get(entity);
+        for (int i = 0; i < blocker.current_count_; ++i) {
+            const auto enemy_entity = blocker.blocked_[static_cast<std::size_t>(i)];
+            if (dead.contains(enemy_entity) || !blocked_storage.contains(enemy_entity) ||
+                blocked_storage.get(enemy_entity).entity_ != entity) {
+                continue;
             }
+            registry.remove<game::component::BlockedByComponent>(enemy_entity);
+            behaviors.transition(enemy_entity, game::component::BehaviorEvent::ACTION_END);
+            registry.emplace_or_replace<engine::component::AnimationRequestComponent>(enemy_entity, "walk"_hs, true);
+            ENGINE_LOG_INFO_DEFERRED("阻挡者: ID: {}, 死亡, 放开敌人: ID: {}", entt::to_integral(entity), entt::to_integral(enemy_entity));
         }
+        blocker.current_count_ = 0;
     }
 }
 
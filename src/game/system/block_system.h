@@ -1,17 +1,27 @@
 #pragma once
 
 #include <entt/entity/registry.hpp>
-#include <entt/signal/dispatcher.hpp>
+#include <span>
+
+namespace engine::ecs {
+class CommandBuffer;
+}
 
 namespace game::system {
 
 /**
  * @brief 阻挡系统
  * 用于判断敌人是否被阻挡，并更新阻挡相关组件。
+ * 组件的添加（含动画切换请求）记录到 commands，由调用方在同步点提交。
+ * 阻挡关系两端都有记录：敌人的 BlockedByComponent 指向阻挡者，阻挡者的 BlockerComponent::blocked_ 列出被阻挡的敌人，
+ * 任一端被销毁时由 onEntitiesDestroyed() 解除，不再每步检查全部阻挡关系。
  */
 class BlockSystem {
 public:
-    void update(entt::registry& registry, entt::dispatcher& dispatcher);
+    void update(entt::registry& registry, engine::ecs::CommandBuffer& commands);
+
+    /// @brief RemoveDeadSystem 批量收尾：死亡敌人归还阻挡名额，死亡阻挡者放开其阻挡的敌人（恢复行走）
+    void onEntitiesDestroyed(entt::registry& registry, std::span<const entt::entity> entities);
 };
 
 }   // namespace game::system
\ No newline at end of file
@@ -1,107 +1,253 @@
 #include "combat_resolve_system.h"
 #include <entt/entt.hpp>
+#include "game/component/behavior_component.h"
 #include "game/component/enemy_component.h"
 #include "game/component/player_component.h"
 #include "game/component/stats_component.h"
-#include "game/component/blocker_component.h"
-#include "game/component/blocked_by_component.h"
+#include "game/data/class_cost_profiler.h"
 #include "game/data/game_stats.h"
+#include "game/data/injury_queue.h"
+#include "game/data/status_effect_store.h"
+#include "damage_number_system.h"
+#include "../defs/ids.h"
 #include "../defs/tags.h"
 #include <algorithm>
+#include <cmath>
+#include <memory_resource>
+#include "../../engine/component/transform_component.h"
+#include "../../engine/ecs/event_queues.h"
+#include "../../engine/memory/frame_arena.h"
+#include "../../engine/spatial/spatial_grid.h"
 #include "../../engine/utils/logging.h"
+#include "../../engine/utils/profiler.h"
 
 namespace game::system {
-	CombatResolveSystem::CombatResolveSystem(entt::registry& registry, entt::dispatcher& dispatcher)
-		: registry_(registry), dispatcher_(dispatcher)
+	CombatResolveSystem::CombatResolveSystem(entt::registry& registry, entt::dispatcher& dispatcher, engine::ecs::EventQueues& event_queues)
+		: registry_(registry), dispatcher_(dispatcher), event_queues_(event_queues)
 	{
-		dispatcher_.sink<game::defs::AttackHitEvent>().connect<&CombatResolveSystem::onAttackEvent>(this);
-		dispatcher_.sink<game::defs::HealerHitEvent>().connect<&CombatResolveSystem::onHealEvent>(this);
+		event_queues_.sink<game::defs::AttackHitEvent>().connect<&CombatResolveSystem::onAttackEvents>(this);
+		event_queues_.sink<game::defs::HealerHitEvent>().connect<&CombatResolveSystem::onHealEvents>(this);
+		event_queues_.sink<game::defs::StatusDamageEvent>().connect<&CombatResolveSystem::onStatusDamageEvents>(this);
+		event_queues_.sink<game::defs::AreaHitEvent>().connect<&CombatResolveSystem::onAreaHitEvents>(this);
 	}
 	CombatResolveSystem::~CombatResolveSystem()
 	{
-		dispatcher_.disconnect(this);
+		event_queues_.disconnect(this);
 	}
-	void CombatResolveSystem::onAttackEvent(const game::defs::AttackHitEvent& event)
+	void CombatResolveSystem::onAttackEvents(std::span<const game::defs::AttackHitEvent> events)
 	{
-		if (!registry_.valid(event.target_entity_)) {
+		for (const auto& event : events) {
+			pending_.push_back({ event.target_entity_, event.damage_amount_, false });
+		}
+		if (auto* costs = registry_.ctx().find<game::data::ClassCostProfiler>()) {
+			for (const auto& event : events) {
+				costs->countEvents(registry_, event.attacker_entity_);
+			}
+		}
+	}
+	void CombatResolveSystem::onHealEvents(std::span<const game::defs::HealerHitEvent> events)
+	{
+		for (const auto& event : events) {
+			pending_.push_back({ event.target_entity_, event.heal_amount_, true });
+		}
+		if (auto* costs = registry_.ctx().find<game::data::ClassCostProfiler>()) {
+			for (const auto& event : events) {
+				costs->countEvents(registry_, event.healer_entity_);
+			}
+		}
+	}
+	void CombatResolveSystem::onAreaHitEvents(std::span<const game::defs::AreaHitEvent> events)
+	{
+		const auto* grid = registry_.ctx().find<engine::spatial::SpatialGrid>();
+		if (!grid) {
+			return;
+		}
+		// 本批全部受害者追加到同一个帧内存容器，查询之间不分配
+		std::pmr::memory_resource* resource = frame_arena_ ? static_cast<std::pmr::memory_resource*>(frame_arena_) : std::pmr::get_default_resource();
+		std::pmr::vector<entt::entity> victims{ resource };
+		auto* costs = registry_.ctx().find<game::data::ClassCostProfiler>();
+		for (const auto& event : events) {
+			const game::data::ClassCostProfiler::Scope cost{ costs, registry_, event.attacker_entity_, game::data::CostCategory::COMBAT };
+			if (costs) {
+				costs->countEvents(registry_, event.attacker_entity_);
+			}
+			std::span<const entt::entity> hits;
+			switch (event.shape_) {
+			case game::defs::AreaShape::CIRCLE:
+				hits = grid->queryCircle(event.origin_, event.radius_, event.mask_, victims);
+				break;
+			case game::defs::AreaShape::CONE: {
+				glm::vec2 direction = event.target_ - event.origin_;
+				const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+				direction = length > 0.0f ? direction / length : glm::vec2{ 1.0f, 0.0f };
+				hits = grid->queryCone(event.origin_, direction, event.radius_, event.cos_half_angle_, event.mask_, victims);
+				break;
+			}
+			case game::defs::AreaShape::CAPSULE:
+				hits = grid->queryCapsule(event.origin_, event.target_, event.radius_, event.mask_, victims);
+				break;
+			case game::defs::AreaShape::NONE:
+				break;
+			}
+			for (const auto victim : hits) {
+				pending_.push_back({ victim, event.damage_amount_, false });
+			}
+		}
+		ENGINE_PROFILE_COUNTER("combat.area_victims", static_cast<std::int64_t>(victims.size()));
+	}
+	void CombatResolveSystem::onStatusDamageEvents(std::span<const game::defs::StatusDamageEvent> events)
+	{
+		for (const auto& event : events) {
+			pending_.push_back({ event.target_entity_, event.damage_amount_, false, true });
+		}
+	}
+
+	void CombatResolveSystem::resolve()
+	{
+		if (pending_.empty()) {
+			ENGINE_PROFILE_COUNTER("combat.kills", 0);
+			return;
+		}
+
+		// 按目标聚合：同一目标的记录相邻，每个目标只做一次组件查找。
+		// 以入队顺序为次键，同一目标的伤害按固定顺序累加，浮点结果不随标准库的排序实现而变（stable_sort 需要临时缓冲）
+		for (std::size_t i = 0; i < pending_.size(); ++i) {
+			pending_[i].order_ = static_cast<std::uint32_t>(i);
+		}
+		std::ranges::sort(pending_, [](const PendingDelta& lhs, const PendingDelta& rhs) {
+			return lhs.target_ != rhs.target_ ? lhs.target_ < rhs.target_ : lhs.order_ < rhs.order_;
+		});
+		int kills = 0;
+		auto* costs = registry_.ctx().find<game::data::ClassCostProfiler>();
+		for (auto first = pending_.begin(); first != pending_.end();) {
+			const auto target = first->target_;
+			const auto last = std::find_if(first, pending_.end(), [target](const PendingDelta& delta) { return delta.target_ != target; });
+			const game::data::ClassCostProfiler::Scope cost{ costs, registry_, target, game::data::CostCategory::COMBAT };
+			if (resolveTarget(target, { first, last })) {
+				++kills;
+			}
+			first = last;
+		}
+		pending_.clear();
+
+		ENGINE_PROFILE_COUNTER("combat.kills", kills);
+		if (kills == 0) {
 			return;
 		}
+		auto& game_stats = registry_.ctx().get<game::data::GameStats&>();
+		game_stats.enemy_killed_count_ += kills;
+		game_stats.peak_kills_per_tick_ = std::max(game_stats.peak_kills_per_tick_, kills);
+		ENGINE_LOG_DEBUG("敌人击杀统计更新: +{} killed={}, arrived={}, total={}", kills, game_stats.enemy_killed_count_, game_stats.enemy_arrived_count_, game_stats.enemy_count_);
+		if ((game_stats.enemy_killed_count_ + game_stats.enemy_arrived_count_) >= game_stats.enemy_count_) {
+			ENGINE_LOG_INFO("当前关卡敌人处理完成，等待后续关卡流程");
+		}
+	}
+
+	bool CombatResolveSystem::resolveTarget(entt::entity target, std::span<const PendingDelta> deltas)
+	{
+		// try_get 比较完整句柄（含版本），已销毁的目标取不到 StatsComponent，命中路径不再另行 valid()
+		auto* stats = registry_.try_get<game::component::StatsComponent>(target);
+		if (!stats) {
+			if (registry_.valid(target) && !registry_.all_of<game::defs::DeadTag>(target)) {
+				ENGINE_LOG_WARN("战斗结算目标实体 {} 没有 StatsComponent", entt::to_integral(target));
+			}
+			return false;
+		}
+		if (registry_.all_of<game::defs::DeadTag>(target)) {
+			return false;
+		}
 
-		auto stats = registry_.try_get<game::component::StatsComponent>(event.target_entity_);
-		if (stats) {
-			const float damage = calculateDamage(event.damage_amount_, stats->def_);
-			stats->hp_ = std::max(0.0f, stats->hp_ - damage);
-             ENGINE_LOG_DEBUG("实体 {} 受到攻击，造成 {} 点伤害，剩余 HP: {}", entt::to_integral(event.target_entity_), damage, stats->hp_);
+		float damage = 0.0f;
+		float heal = 0.0f;
+		bool hit = false;
+		bool healed = false;
+		for (const auto& delta : deltas) {
+			if (delta.heal_) {
+				heal += delta.amount_;
+				healed = true;
+			} else {
+				damage += delta.true_damage_ ? delta.amount_ : calculateDamage(delta.amount_, stats->def_);
+				hit = true;
+			}
+		}
+		if (hit) {
+			if (auto* effects = registry_.ctx().find<game::data::StatusEffectStore>()) {
+				damage = effects->absorbDamage(target, damage);
+			}
 		}
 
-		if (registry_.all_of<game::component::EnemyComponent>(event.target_entity_)) {
-           ENGINE_LOG_DEBUG("目标实体 {} 是敌人", entt::to_integral(event.target_entity_));
-			if (stats && stats->hp_ <= 0) {
-              ENGINE_LOG_INFO("敌人单位 {} 已被击败", entt::to_integral(event.target_entity_));
-				stats->hp_ = 0;
-                dispatcher_.enqueue(game::defs::SpawnEffectVisualEvent{ event.target_entity_, entt::hashed_string("death") });
-				registry_.emplace_or_replace<game::defs::DeadTag>(event.target_entity_);
-				registry_.remove<game::defs::InjuredTag>(event.target_entity_);
-              auto& game_stats = registry_.ctx().get<game::data::GameStats&>();
-				game_stats.enemy_killed_count_ += 1;
-             ENGINE_LOG_DEBUG("敌人击杀统计更新: killed={}, arrived={}, total={}", game_stats.enemy_killed_count_, game_stats.enemy_arrived_count_, game_stats.enemy_count_);
-				if (registry_.all_of<game::component::BlockedByComponent>(event.target_entity_)) {
-					auto blocked_by = registry_.get<game::component::BlockedByComponent>(event.target_entity_);
-					if (registry_.valid(blocked_by.entity_)) {
-						registry_.remove<game::component::BlockedByComponent>(event.target_entity_);
-						auto& blocker = registry_.get<game::component::BlockerComponent>(blocked_by.entity_);
-						blocker.current_count_--;
-                     ENGINE_LOG_DEBUG("敌人 {} 被击败，解除阻挡 {} 的状态", entt::to_integral(event.target_entity_), entt::to_integral(blocked_by.entity_));
-					}
+		const bool is_enemy = registry_.all_of<game::component::EnemyComponent>(target);
+		const bool is_player = !is_enemy && registry_.all_of<game::component::PlayerComponent>(target);
+		// 飘字显示合计值：同一步内的多次命中只产生一个数字
+		const auto* transform = damage_numbers_ ? registry_.try_get<engine::component::TransformComponent>(target) : nullptr;
+		if (hit) {
+			registry_.patch<game::component::StatsComponent>(target, [damage](auto& value) { value.hp_ = std::max(0.0f, value.hp_ - damage); });
+			if (transform) {
+				damage_numbers_->add(target, transform->position_, damage, false);
+			}
+			ENGINE_LOG_DEBUG("实体 {} 受到 {} 次攻击，共 {} 点伤害，剩余 HP: {}", entt::to_integral(target), deltas.size(), damage, stats->hp_);
+			if (!is_enemy && !is_player) {
+				ENGINE_LOG_WARN("目标实体 {} 既不是敌人也不是玩家", entt::to_integral(target));
+			}
+			else if (stats->hp_ <= 0.0f) {
+				dispatcher_.enqueue(game::defs::SpawnEffectVisualEvent{ target, game::ids::hashOf(game::ids::Effect::DEATH) });
+				if (is_enemy) {
+					ENGINE_LOG_INFO("敌人单位 {} 已被击败", entt::to_integral(target));
+					killEnemy(target);
+					return true;
 				}
-             if ((game_stats.enemy_killed_count_ + game_stats.enemy_arrived_count_) >= game_stats.enemy_count_) {
-					ENGINE_LOG_INFO("当前关卡敌人处理完成，等待后续关卡流程");
+				ENGINE_LOG_INFO("玩家单位 {} 已被击败", entt::to_integral(target));
+				if (auto* injuries = registry_.ctx().find<game::data::InjuryQueue>()) {
+					injuries->remove(target);
 				}
-				return;
+				dispatcher_.enqueue(game::defs::RemovePlayerUnitEvent{ target });
+				return false;
 			}
-         if (stats && stats->hp_ < stats->max_hp_) {
-				registry_.emplace_or_replace<game::defs::InjuredTag>(event.target_entity_);
+		}
+
+		if (healed) {
+			const float hp_before = stats->hp_;
+			registry_.patch<game::component::StatsComponent>(target, [heal](auto& value) { value.hp_ = std::min(value.max_hp_, value.hp_ + heal); });
+			if (transform) {
+				damage_numbers_->add(target, transform->position_, stats->hp_ - hp_before, true);	// 只显示实际恢复量
 			}
+			ENGINE_LOG_DEBUG("实体 {} 被治疗，恢复 {} 点 HP，当前 HP: {}", entt::to_integral(target), heal, stats->hp_);
+			dispatcher_.enqueue(game::defs::SpawnEffectVisualEvent{ target, game::ids::hashOf(game::ids::Effect::HEAL) });
 		}
-		else if (registry_.all_of<game::component::PlayerComponent>(event.target_entity_)) {
-           ENGINE_LOG_DEBUG("目标实体 {} 是玩家", entt::to_integral(event.target_entity_));
-			if (stats && stats->hp_ <= 0) {
-              ENGINE_LOG_INFO("玩家单位 {} 已被击败", entt::to_integral(event.target_entity_));
-				stats->hp_ = 0;
-                dispatcher_.enqueue(game::defs::SpawnEffectVisualEvent{ event.target_entity_, entt::hashed_string("death") });
-                dispatcher_.enqueue(game::defs::RemovePlayerUnitEvent{ event.target_entity_ });
-				return;
+
+		// 受伤状态只改写标志位，不增删组件
+		auto* behavior = registry_.try_get<game::component::BehaviorComponent>(target);
+		if (behavior) {
+			if (stats->hp_ < stats->max_hp_) {
+				if (hit && (is_enemy || is_player)) {
+					behavior->setFlag(game::component::behavior_flag::INJURED, true);
+				}
 			}
-         if (stats && stats->hp_ < stats->max_hp_) {
-				registry_.emplace_or_replace<game::defs::InjuredTag>(event.target_entity_);
+			else if (healed && behavior->hasFlag(game::component::behavior_flag::INJURED)) {
+				behavior->setFlag(game::component::behavior_flag::INJURED, false);
+				ENGINE_LOG_DEBUG("实体 {} 已完全恢复，移除受伤状态", entt::to_integral(target));
 			}
 		}
-		else {
-            ENGINE_LOG_WARN("目标实体 {} 既不是敌人也不是玩家", entt::to_integral(event.target_entity_));
+
+		// 治疗者的目标队列只收录受伤的玩家单位，生命比例随本次结算更新
+		if (is_player) {
+			if (auto* injuries = registry_.ctx().find<game::data::InjuryQueue>()) {
+				if (behavior && behavior->hasFlag(game::component::behavior_flag::INJURED)) {
+					injuries->update(target, stats->hp_ / stats->max_hp_);
+				} else {
+					injuries->remove(target);
+				}
+			}
 		}
+		return false;
 	}
 
-	void CombatResolveSystem::onHealEvent(const game::defs::HealerHitEvent& event)
+	void CombatResolveSystem::killEnemy(entt::entity target)
 	{
-		if (registry_.valid(event.target_entity_)) {
-			auto stats = registry_.try_get<game::component::StatsComponent>(event.target_entity_);
-			if (stats) {
-				stats->hp_ += event.heal_amount_;
-				if (stats->hp_ > stats->max_hp_) {
-					stats->hp_ = stats->max_hp_; // 确保 HP 不超过最大值
-				}
-             ENGINE_LOG_DEBUG("实体 {} 被治疗，恢复 {} 点 HP，当前 HP: {}", entt::to_integral(event.target_entity_), event.heal_amount_, stats->hp_);
-				// 如果之前受伤，现在恢复了，移除 InjuredTag
-				if (registry_.all_of<game::defs::InjuredTag>(event.target_entity_) && stats->hp_ == stats->max_hp_) {
-					registry_.remove<game::defs::InjuredTag>(event.target_entity_);
-                 ENGINE_LOG_DEBUG("实体 {} 已完全恢复，移除受伤状态", entt::to_integral(event.target_entity_));
-				}
-                dispatcher_.enqueue(game::defs::SpawnEffectVisualEvent{ event.target_entity_, entt::hashed_string("heal").value() });
-			} else {
-             ENGINE_LOG_WARN("治疗事件目标实体 {} 没有 StatsComponent", entt::to_integral(event.target_entity_));
-			}
-		} else {
-            ENGINE_LOG_WARN("治疗事件目标实体 {} 无效", entt::to_integral(event.target_entity_));
+		// 阻挡名额在 RemoveDeadSystem 批量收尾时归还（见 BlockSystem::onEntitiesDestroyed）
+		registry_.emplace<game::defs::DeadTag>(target);
+		if (auto* behavior = registry_.try_get<game::component::BehaviorComponent>(target)) {
+			behavior->setFlag(game::component::behavior_flag::INJURED, false);
 		}
 	}
 
@@ -111,4 +257,4 @@ namespace game::system {
 		damage = std::max(damage, def*0.1f); // 确保至少造成点伤害
 		return damage;
 	}
-}
+}
\ No newline at end of file
@@ -1,20 +1,75 @@
 #pragma once
 #include "game/defs/event.h"
+#include <cstdint>
 #include <entt/entity/fwd.hpp>
 #include <entt/signal/fwd.hpp>
+#include <span>
+#include <vector>
+
+namespace engine::ecs {
+	class EventQueues;
+}
+
+namespace engine::memory {
+	class FrameArena;
+}
 
 namespace game::system {
-	
+	class DamageNumberSystem;
+
+	/**
+	 * @brief 命中与治疗结算。
+	 *
+	 * @details
+	 * 事件通道 flush 时只把伤害/治疗量追加到扁平缓冲区；resolve() 按目标排序后每个目标只查一次组件，
+	 * 合计本步全部伤害与治疗，死亡、受伤状态各切换一次，击杀数汇总后一次写入 GameStats。
+	 * 同一步内先结算伤害再结算治疗：本步被击败的单位不会被同步到达的治疗救回。
+	 * 状态效果的持续伤害（StatusDamageEvent）不经防御换算；目标带护盾效果时先由护盾吸收合计伤害。
+	 * 范围攻击（AreaHitEvent）在 flush 时各做一次空间网格查询，每个受害者追加一条记录，与单体命中一起结算。
+	 */
 	class CombatResolveSystem {
 	public:
-		CombatResolveSystem(entt::registry& registry, entt::dispatcher& dispatcher);
+		/// @param event_queues 命中/治疗事件的批量通道（AnimationEventsSystem 写入，GameScene 每帧 flush）
+		CombatResolveSystem(entt::registry& registry, entt::dispatcher& dispatcher, engine::ecs::EventQueues& event_queues);
 		~CombatResolveSystem();
+
+		/// @brief 结算本步累计的全部伤害与治疗（在 event_queues.flush() 之后调用）
+		void resolve();
+
+		/// @brief 范围攻击查询结果使用的帧内存（为空时使用默认内存资源，如无头模拟）
+		void setFrameArena(engine::memory::FrameArena* frame_arena) { frame_arena_ = frame_arena; }
+
+		/// @brief 每个目标本步合计的伤害 / 治疗写入的飘字层（为空时不显示，如无头模拟）
+		void setDamageNumbers(DamageNumberSystem* damage_numbers) { damage_numbers_ = damage_numbers; }
+
 	private:
-		void onAttackEvent(const game::defs::AttackHitEvent& event);
-		void onHealEvent(const game::defs::HealerHitEvent& event);
+		/// @brief 本步的一条伤害或治疗记录
+		struct PendingDelta {
+			entt::entity target_;
+			float amount_{0.0f};	///< 攻击方攻击力（伤害需按目标防御换算）、持续伤害量或治疗量
+			bool heal_{false};
+			bool true_damage_{false};	///< 持续伤害，不按防御换算
+			std::uint32_t order_{0};	///< 入队顺序，resolve() 排序时作为同一目标内的次键
+		};
+
+		/// @brief 累计本帧全部命中事件
+		void onAttackEvents(std::span<const game::defs::AttackHitEvent> events);
+		/// @brief 累计本帧全部治疗事件
+		void onHealEvents(std::span<const game::defs::HealerHitEvent> events);
+		/// @brief 累计本帧全部状态效果持续伤害
+		void onStatusDamageEvents(std::span<const game::defs::StatusDamageEvent> events);
+		/// @brief 查询本帧全部范围攻击的受害者，每个受害者累计一条伤害记录
+		void onAreaHitEvents(std::span<const game::defs::AreaHitEvent> events);
+		/// @brief 结算同一目标的全部记录，目标被击败的敌人返回 true
+		bool resolveTarget(entt::entity target, std::span<const PendingDelta> deltas);
+		void killEnemy(entt::entity target);
 	private:
 		float calculateDamage(float attack, float def);
 		entt::registry& registry_;
 		entt::dispatcher& dispatcher_;
+		engine::ecs::EventQueues& event_queues_;
+		engine::memory::FrameArena* frame_arena_{nullptr};
+		DamageNumberSystem* damage_numbers_{nullptr};
+		std::vector<PendingDelta> pending_;		///< 本步累计的记录，容量帧间复用
 	};
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "crowd_separation_system.h"
+
+#include "../component/behavior_component.h"
+#include "../component/blocked_by_component.h"
+#include "../component/enemy_component.h"
+#include "../defs/constants.h"
+#include "../defs/tags.h"
+#include "../../engine/component/transform_component.h"
+#include "../../engine/component/velocity_component.h"
+#include "../../engine/spatial/spatial_grid.h"
+#include "../../engine/utils/profiler.h"
+#include <entt/entity/registry.hpp>
+#include <cmath>
+#include <cstdint>
+
+namespace game::system {
+
+namespace {
+constexpr float COINCIDENT_DISTANCE_SQ = 1e-4f;     ///< 小于该距离平方视为完全重合
+}
+
+void CrowdSeparationSystem::update(entt::registry& registry) {
+    const auto* grid = registry.ctx().find<engine::spatial::SpatialGrid>();
+    if (!grid) {
+        return;
+    }
+
+    constexpr float radius = game::defs::SEPARATION_RADIUS;
+    auto view = registry.view<game::component::EnemyComponent,
+                              engine::component::TransformComponent,
+                              engine::component::VelocityComponent,
+                              game::component::BehaviorComponent>(
+        entt::exclude<game::component::BlockedByComponent, game::defs::DeadTag>);
+
+    std::size_t checks = 0;
+    std::size_t adjusted = 0;
+    for (auto [entity, enemy, transform, velocity, behavior] : view.each()) {
+        if (enemy.speed_ <= 0.0f || behavior.isActionLocked()) {
+            continue;
+        }
+        const glm::vec2 self = transform.position_;
+        glm::vec2 push{ 0.0f };
+        checks += grid->forEachNearby(self, radius, game::defs::spatial_layer::ENEMY, game::defs::SEPARATION_MAX_CHECKS,
+            [&](const engine::spatial::SpatialGrid::Entry& entry, float distance_sq) {
+                if (entry.entity_ == entity) {
+                    return;
+                }
+                if (distance_sq > COINCIDENT_DISTANCE_SQ) {
+                    const float distance = std::sqrt(distance_sq);
+                    push += (self - entry.position_) * ((radius - distance) / (radius * distance));
+                    return;
+                }
+                // 完全重合：沿速度的垂线分开，两者按生成序号取相反的一侧（实体句柄在实机与回放中不同）
+                const float speed_sq = velocity.velocity_.x * velocity.velocity_.x + velocity.velocity_.y * velocity.velocity_.y;
+                glm::vec2 side{ 1.0f, 0.0f };
+                if (speed_sq > 0.0f) {
+                    const float inv_speed = 1.0f / std::sqrt(speed_sq);
+                    side = glm::vec2{ -velocity.velocity_.y * inv_speed, velocity.velocity_.x * inv_speed };
+                }
+                const auto* other = registry.try_get<game::component::EnemyComponent>(entry.entity_);
+                const bool first = other ? enemy.spawn_sequence_ < other->spawn_sequence_ : entity < entry.entity_;
+                push += first ? side : -side;
+            });
+
+        const float length_sq = push.x * push.x + push.y * push.y;
+        if (length_sq <= 0.0f) {
+            continue;
+        }
+        if (length_sq > 1.0f) {
+            push /= std::sqrt(length_sq);
+        }
+        velocity.velocity_ += push * (enemy.speed_ * game::defs::SEPARATION_STRENGTH);
+        ++adjusted;
+    }
+
+    ENGINE_PROFILE_COUNTER("separation.adjusted", static_cast<std::int64_t>(adjusted));
+    ENGINE_PROFILE_COUNTER("separation.checks", static_cast<std::int64_t>(checks));
+}
+
+} // namespace game::system
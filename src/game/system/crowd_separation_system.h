@@ -0,0 +1,28 @@
+#pragma once
+
+#include <entt/entity/fwd.hpp>
+
+namespace game::system {
+
+/**
+ * @class CrowdSeparationSystem
+ * @brief 敌人分离：在 MovementSystem 积分之前给移动中的敌人叠加一个远离邻近敌人的速度修正。
+ *
+ * @details
+ * 沿同一路径段前进的敌人速度完全相同，不做处理会叠在同一像素上。本系统用上一步重建的空间网格
+ * （位置即 MovementSystem 之前的当前位置）查询邻近敌人，只查所在单元与相邻一圈单元，
+ * 每个敌人最多检查 SEPARATION_MAX_CHECKS 个条目，总开销与敌人数成线性：
+ * - 半径 SEPARATION_RADIUS 内的邻居按 (半径 - 距离) / 半径 加权推开，合力长度截断到 1
+ * - 完全重合的两个敌人沿速度的垂线向两侧分开，方向由实体序号决定（结果确定，回放一致）
+ * - 修正 = 合力 × 速度 × SEPARATION_STRENGTH，直接加到 VelocityComponent 上
+ *
+ * 被阻挡、动作锁中的敌人不移动，只作为邻居把其他敌人推开。修正每步都依赖 FollowPathSystem 重写的速度，
+ * 启用时须关闭 FollowPathSystem 的低细节跳过（setPathSkipping(false)）。
+ * 由关卡配置的 "crowd_separation" 开启，默认不运行。
+ */
+class CrowdSeparationSystem {
+public:
+    void update(entt::registry& registry);
+};
+
+} // namespace game::system
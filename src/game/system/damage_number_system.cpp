@@ -0,0 +1,133 @@
+#include "damage_number_system.h"
+
+#include "../../engine/render/camera.h"
+#include "../../engine/resource/resource_id.h"
+#include "../../engine/utils/profiler.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <string>
+
+namespace game::system {
+
+namespace {
+constexpr engine::utils::FColor DAMAGE_COLOR{ 1.0f, 0.85f, 0.3f, 1.0f };
+constexpr engine::utils::FColor HEAL_COLOR{ 0.4f, 1.0f, 0.45f, 1.0f };
+constexpr float FADE_START = 0.6f;      ///< 年龄超过寿命的这一比例后开始淡出
+constexpr auto FONT_ID = engine::resource::toResourceId(DamageNumberSystem::FONT_PATH);
+} // namespace
+
+DamageNumberSystem::DamageNumberSystem() {
+    age_.fill(LIFETIME);
+    target_.fill(entt::null);
+    open_.reserve(CAPACITY);
+    items_.reserve(CAPACITY);
+}
+
+void DamageNumberSystem::prewarm(engine::render::TextRenderer& text_renderer) const {
+    text_renderer.getTextSize(std::string{ "+0123456789" }, FONT_ID, FONT_PATH, FONT_SIZE);
+}
+
+void DamageNumberSystem::add(entt::entity target, const glm::vec2& position, float amount, bool heal) {
+    if (!(amount >= 0.5f)) {
+        return;     // 四舍五入后为 0 的数值不显示
+    }
+    const auto key = keyOf(target, heal);
+    if (const auto it = open_.find(key); it != open_.end()) {
+        const auto slot = it->second;
+        // 槽位可能已被环形覆盖给其他目标
+        if (target_[slot] == target && (heal_[slot] != 0) == heal && age_[slot] < AGGREGATE_WINDOW) {
+            value_[slot] += amount;
+            format(slot);
+            return;
+        }
+        open_.erase(it);
+    }
+
+    const auto slot = next_;
+    next_ = (next_ + 1) % CAPACITY;
+    if (age_[slot] < LIFETIME) {
+        --active_;      // 覆盖仍在显示的最早数字
+        if (age_[slot] < AGGREGATE_WINDOW) {
+            open_.erase(keyOf(target_[slot], heal_[slot] != 0));
+        }
+    }
+    const glm::vec2 anchor = position + ANCHOR_OFFSET;
+    target_[slot] = target;
+    x_[slot] = anchor.x;
+    y_[slot] = anchor.y;
+    age_[slot] = 0.0f;
+    value_[slot] = amount;
+    heal_[slot] = heal ? 1 : 0;
+    format(slot);
+    open_[key] = slot;
+    ++active_;
+}
+
+void DamageNumberSystem::format(std::size_t slot) {
+    auto& text = text_[slot];
+    char* first = text.data();
+    char* const last = text.data() + text.size();
+    if (heal_[slot] != 0) {
+        *first++ = '+';
+    }
+    const auto value = static_cast<std::uint32_t>(std::min(std::round(value_[slot]), 4.0e9f));
+    const auto result = std::to_chars(first, last, value);
+    text_length_[slot] = static_cast<std::uint8_t>(result.ptr - text.data());
+}
+
+void DamageNumberSystem::update(float delta_time) {
+    if (active_ == 0) {
+        return;
+    }
+    const float rise = RISE_SPEED * delta_time;
+    std::size_t active = 0;
+    for (std::size_t i = 0; i < CAPACITY; ++i) {
+        if (age_[i] >= LIFETIME) {
+            continue;
+        }
+        const bool was_open = age_[i] < AGGREGATE_WINDOW;
+        age_[i] += delta_time;
+        y_[i] -= rise;
+        if (was_open && age_[i] >= AGGREGATE_WINDOW) {
+            open_.erase(keyOf(target_[i], heal_[i] != 0));
+        }
+        if (age_[i] < LIFETIME) {
+            ++active;
+        } else {
+            target_[i] = entt::null;
+        }
+    }
+    active_ = active;
+    ENGINE_PROFILE_COUNTER("effect.damage_numbers", static_cast<std::int64_t>(active_));
+}
+
+void DamageNumberSystem::render(engine::render::TextRenderer& text_renderer, const engine::render::Camera& camera) {
+    if (active_ == 0) {
+        return;
+    }
+    items_.clear();
+    for (std::size_t i = 0; i < CAPACITY; ++i) {
+        const float age = age_[i];
+        if (age >= LIFETIME) {
+            continue;
+        }
+        auto color = heal_[i] != 0 ? HEAL_COLOR : DAMAGE_COLOR;
+        const float fade_age = LIFETIME * FADE_START;
+        if (age > fade_age) {
+            color.a = std::clamp(1.0f - (age - fade_age) / (LIFETIME - fade_age), 0.0f, 1.0f);
+        }
+        items_.push_back({ std::string_view{ text_[i].data(), text_length_[i] }, glm::vec2{ x_[i], y_[i] }, color });
+    }
+    text_renderer.drawTextBatch(camera, items_, FONT_ID, FONT_PATH, FONT_SIZE);
+}
+
+void DamageNumberSystem::clear() {
+    age_.fill(LIFETIME);
+    target_.fill(entt::null);
+    open_.clear();
+    next_ = 0;
+    active_ = 0;
+}
+
+} // namespace game::system
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../../engine/render/text_renderer.h"
+#include <entt/entity/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include <glm/vec2.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::render {
+    class Camera;
+}
+
+namespace game::system {
+
+/**
+ * @class DamageNumberSystem
+ * @brief 伤害 / 治疗飘字层：定长环形缓冲中的数字实例，不创建注册表实体。
+ *
+ * @details
+ * CombatResolveSystem 每步按目标合计伤害与治疗后调用 add()；同一目标在 AGGREGATE_WINDOW 内的后续数值
+ * 累加到已有的数字上，连续命中只显示一个不断变大的数字。实例槽位满时覆盖最早的一个。
+ * - 数值变化时用 std::to_chars 写入槽位自带的字符缓冲，不分配内存
+ * - update() 推进年龄与上升位移，透明度在 render() 中由年龄算出
+ * - render() 把全部数字交给 TextRenderer::drawTextBatch()，按字形图集页合并提交
+ * 飘字只是视觉，不进入检查点与回放；回退检查点时 clear()。
+ */
+class DamageNumberSystem final {
+public:
+    static constexpr std::size_t CAPACITY = 128;            ///< 同时显示的数字上限
+    static constexpr float LIFETIME = 0.8f;                 ///< 每个数字的显示时长（秒）
+    static constexpr float AGGREGATE_WINDOW = 0.25f;        ///< 同一目标的数值在此时长内合并
+    static constexpr float RISE_SPEED = 40.0f;              ///< 每秒向上移动的像素
+    static constexpr glm::vec2 ANCHOR_OFFSET{ 0.0f, -40.0f };    ///< 相对目标位置的起点
+    static constexpr std::string_view FONT_PATH = "assets/fonts/VonwaonBitmap-16px.ttf";
+    static constexpr int FONT_SIZE = 16;
+
+    DamageNumberSystem();
+
+    /// @brief 预先光栅化数字字形，第一次出现飘字时不再临时生成
+    void prewarm(engine::render::TextRenderer& text_renderer) const;
+
+    /**
+     * @brief 在 position（目标位置）上方显示或累加一个数值
+     * @param heal 治疗数值与伤害数值分别合并、分别显示
+     */
+    void add(entt::entity target, const glm::vec2& position, float amount, bool heal);
+
+    /// @brief 推进全部数字（dt 为本帧实际推进的模拟时间，暂停时不调用）
+    void update(float delta_time);
+
+    /// @brief 以一次文本批处理绘制全部数字
+    void render(engine::render::TextRenderer& text_renderer, const engine::render::Camera& camera);
+
+    /// @brief 移除全部数字
+    void clear();
+
+    /// @brief 当前显示中的数字数
+    [[nodiscard]] std::size_t getActiveCount() const { return active_; }
+
+private:
+    static constexpr std::size_t TEXT_CAPACITY = 12;        ///< "+" 与 10 位整数
+
+    /// @brief 合并键：目标实体与伤害 / 治疗
+    [[nodiscard]] static std::uint64_t keyOf(entt::entity target, bool heal) {
+        return (static_cast<std::uint64_t>(entt::to_integral(target)) << 1) | (heal ? 1u : 0u);
+    }
+    void format(std::size_t slot);
+
+    // SoA：第 i 个元素属于同一个槽位；age_ >= LIFETIME 的槽位空闲
+    std::array<entt::entity, CAPACITY> target_{};
+    std::array<float, CAPACITY> x_{};
+    std::array<float, CAPACITY> y_{};
+    std::array<float, CAPACITY> age_{};
+    std::array<float, CAPACITY> value_{};
+    std::array<std::uint8_t, CAPACITY> heal_{};
+    std::array<std::array<char, TEXT_CAPACITY>, CAPACITY> text_{};
+    std::array<std::uint8_t, CAPACITY> text_length_{};
+
+    std::size_t next_ = 0;                                  ///< 下一次写入的槽位（环形）
+    std::size_t active_ = 0;
+    std::unordered_map<std::uint64_t, std::size_t> open_;  ///< 合并窗口未结束的键 -> 槽位
+    std::vector<engine::render::TextRenderer::WorldTextItem> items_;    ///< render() 的批处理条目，容量帧间复用
+};
+
+} // namespace game::system
@@ -0,0 +1,144 @@
+#include "effect_particle_system.h"
+
+#include "../factory/blueprint_manager.h"
+#include "../../engine/render/camera.h"
+#include "../../engine/render/renderer.h"
+#include "../../engine/utils/logging.h"
+#include "../../engine/utils/profiler.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace game::system {
+
+void EffectParticleSystem::registerEmitters(const game::factory::BlueprintManager& blueprint_manager) {
+    emitters_.clear();
+    index_.fill(NO_EMITTER);
+    std::size_t total = 0;
+    for (const auto& [effect_id, blueprint] : blueprint_manager.getEffectBlueprints()) {
+        if (blueprint.particle_capacity_ <= 0) {
+            continue;
+        }
+        const auto effect = game::ids::fromHash<game::ids::Effect>(effect_id);
+        if (effect == game::ids::Effect::COUNT) {
+            ENGINE_LOG_WARN("特效 {:#x} 不在生成的 ID 表中（数据变化后需要重新构建），不建立粒子发射器", effect_id);
+            continue;
+        }
+        Emitter emitter;
+        emitter.sprite_ = engine::component::Sprite(blueprint.sprite_.path_, blueprint.sprite_.src_rect_, !blueprint.sprite_.face_right_);
+        // 与 BlueprintManager::buildEffectAnimationSet 的切帧方式相同
+        const auto& frame_size = blueprint.sprite_.src_rect_.size;
+        for (int frame_index : blueprint.animation_.frames_) {
+            emitter.frames_.push_back(engine::utils::Rect{
+                blueprint.sprite_.src_rect_.position.x + frame_size.x * static_cast<float>(frame_index),
+                blueprint.sprite_.src_rect_.position.y + frame_size.y * static_cast<float>(blueprint.animation_.row_),
+                frame_size.x, frame_size.y });
+        }
+        if (emitter.frames_.empty()) {
+            emitter.frames_.push_back(blueprint.sprite_.src_rect_);
+        }
+        emitter.seconds_per_frame_ = std::max(blueprint.animation_.ms_per_frame_, 1.0f) / 1000.0f;
+        emitter.lifetime_ = emitter.seconds_per_frame_ * static_cast<float>(emitter.frames_.size());
+        emitter.size_ = blueprint.sprite_.size_;
+        emitter.offset_ = blueprint.sprite_.offset_;
+        emitter.rise_speed_ = blueprint.particle_rise_speed_;
+        emitter.fade_ = blueprint.particle_fade_;
+        emitter.capacity_ = static_cast<std::size_t>(blueprint.particle_capacity_);
+        emitter.x_.reserve(emitter.capacity_);
+        emitter.y_.reserve(emitter.capacity_);
+        emitter.age_.reserve(emitter.capacity_);
+        total += emitter.capacity_;
+
+        index_[game::ids::indexOf(effect)] = emitters_.size();
+        emitters_.push_back(std::move(emitter));
+    }
+    ENGINE_LOG_INFO("特效粒子发射器: {} 种，共 {} 个粒子容量", emitters_.size(), total);
+}
+
+bool EffectParticleSystem::spawn(entt::id_type effect_id, const glm::vec2& position) {
+    const auto effect = game::ids::fromHash<game::ids::Effect>(effect_id);
+    if (effect == game::ids::Effect::COUNT) {
+        return false;
+    }
+    const std::size_t slot = index_[game::ids::indexOf(effect)];
+    if (slot >= emitters_.size()) {
+        return false;
+    }
+    auto& emitter = emitters_[slot];
+    if (emitter.age_.size() >= emitter.capacity_) {
+        return true;    // 已满：丢弃，不退回实体
+    }
+    emitter.x_.push_back(position.x);
+    emitter.y_.push_back(position.y);
+    emitter.age_.push_back(0.0f);
+    return true;
+}
+
+void EffectParticleSystem::update(float delta_time) {
+    std::size_t active = 0;
+    for (auto& emitter : emitters_) {
+        const std::size_t count = emitter.age_.size();
+        float* age = emitter.age_.data();
+        float* y = emitter.y_.data();
+        const float rise = emitter.rise_speed_ * delta_time;
+        for (std::size_t i = 0; i < count; ++i) {
+            age[i] += delta_time;
+            y[i] -= rise;
+        }
+
+        // 到期的粒子用末尾元素覆盖
+        std::size_t i = 0;
+        std::size_t alive = count;
+        while (i < alive) {
+            if (age[i] < emitter.lifetime_) {
+                ++i;
+                continue;
+            }
+            --alive;
+            emitter.x_[i] = emitter.x_[alive];
+            y[i] = y[alive];
+            age[i] = age[alive];
+        }
+        emitter.x_.resize(alive);
+        emitter.y_.resize(alive);
+        emitter.age_.resize(alive);
+        active += alive;
+    }
+    ENGINE_PROFILE_COUNTER("effect.particles", static_cast<std::int64_t>(active));
+}
+
+void EffectParticleSystem::render(engine::render::Renderer& renderer, const engine::render::Camera& camera) const {
+    if (getActiveCount() == 0) {
+        return;
+    }
+    renderer.beginSpriteBatch();
+    for (const auto& emitter : emitters_) {
+        auto sprite = emitter.sprite_;
+        const std::size_t last_frame = emitter.frames_.size() - 1;
+        for (std::size_t i = 0; i < emitter.age_.size(); ++i) {
+            const float age = emitter.age_[i];
+            sprite.src_rect_ = emitter.frames_[std::min(static_cast<std::size_t>(age / emitter.seconds_per_frame_), last_frame)];
+            const float alpha = emitter.fade_ ? std::clamp(1.0f - age / emitter.lifetime_, 0.0f, 1.0f) : 1.0f;
+            renderer.drawSprite(camera, sprite, glm::vec2{ emitter.x_[i], emitter.y_[i] } + emitter.offset_, emitter.size_,
+                                0.0f, engine::utils::FColor{ 1.0f, 1.0f, 1.0f, alpha });
+        }
+    }
+    renderer.endSpriteBatch();
+}
+
+void EffectParticleSystem::clear() {
+    for (auto& emitter : emitters_) {
+        emitter.x_.clear();
+        emitter.y_.clear();
+        emitter.age_.clear();
+    }
+}
+
+std::size_t EffectParticleSystem::getActiveCount() const {
+    std::size_t active = 0;
+    for (const auto& emitter : emitters_) {
+        active += emitter.age_.size();
+    }
+    return active;
+}
+
+} // namespace game::system
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../../engine/component/sprite_component.h"
+#include "../../engine/utils/math.h"
+#include "../defs/ids.h"
+#include <entt/entity/fwd.hpp>
+#include <glm/vec2.hpp>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace engine::render {
+    class Camera;
+    class Renderer;
+}
+
+namespace game::factory {
+    class BlueprintManager;
+}
+
+namespace game::system {
+
+/**
+ * @class EffectParticleSystem
+ * @brief 高频一次性特效（死亡、治疗等）的粒子层：不创建注册表实体，每种特效一个定长 SoA 发射器。
+ *
+ * @details
+ * effect_data.json 中带 "particles" 字段的特效在 registerEmitters() 时建立发射器，
+ * 发射器按构建期生成的 ids::Effect 下标直接索引（spawn() 中一次二分查找把哈希换成下标，不再查哈希表）。
+ * spawn() 只在发射器的位置 / 年龄数组末尾追加一项；容量已满时丢弃新的粒子（高峰期少几个特效不影响玩法）。
+ * - update() 对每个发射器顺序推进年龄与上升位移，到期的粒子用末尾元素覆盖移除
+ * - 帧序号与透明度在 render() 中由年龄算出，不单独存储
+ * - render() 在 RenderSystem 之后把全部粒子放进一次精灵批处理，同一图集的粒子合并为一次几何提交
+ * 粒子只是视觉，不进入检查点与回放；回退检查点时 clear()。
+ */
+class EffectParticleSystem final {
+public:
+    /// @brief 为带粒子配置的特效蓝图建立发射器并按容量预留
+    void registerEmitters(const game::factory::BlueprintManager& blueprint_manager);
+
+    /**
+     * @brief 在 position 处发射一个特效粒子
+     * @return 该特效没有发射器时返回 false，调用方退回池化的特效实体
+     */
+    bool spawn(entt::id_type effect_id, const glm::vec2& position);
+
+    /// @brief 推进全部粒子（dt 为本帧实际推进的模拟时间，暂停时不调用）
+    void update(float delta_time);
+
+    /// @brief 以一次精灵批处理绘制全部粒子
+    void render(engine::render::Renderer& renderer, const engine::render::Camera& camera) const;
+
+    /// @brief 移除全部粒子（保留发射器与容量）
+    void clear();
+
+    /// @brief 当前存活的粒子数
+    [[nodiscard]] std::size_t getActiveCount() const;
+
+private:
+    /// @brief 一种特效的发射器
+    struct Emitter {
+        engine::component::Sprite sprite_;              ///< 图集与翻转；源矩形按帧替换
+        std::vector<engine::utils::Rect> frames_;       ///< 每帧的源矩形
+        float seconds_per_frame_ = 0.05f;
+        float lifetime_ = 0.0f;                         ///< 播完全部帧的时间
+        glm::vec2 size_{ 0.0f, 0.0f };
+        glm::vec2 offset_{ 0.0f, 0.0f };
+        float rise_speed_ = 0.0f;                       ///< 每秒向上移动的像素
+        bool fade_ = false;                             ///< 透明度随年龄线性降到 0
+        std::size_t capacity_ = 0;
+
+        // SoA：第 i 个元素属于同一个粒子
+        std::vector<float> x_;
+        std::vector<float> y_;
+        std::vector<float> age_;
+    };
+
+    static constexpr std::size_t NO_EMITTER = static_cast<std::size_t>(-1);
+
+    std::vector<Emitter> emitters_;
+    std::array<std::size_t, game::ids::count<game::ids::Effect>()> index_{};  ///< ids::Effect 下标 -> emitters_ 下标（NO_EMITTER 表示没有粒子配置）
+};
+
+} // namespace game::system
@@ -5,50 +5,88 @@
  * @details
  * 本文件实现了 FollowPathSystem::update() 方法，处理敌人实体沿着预设路径移动的逻辑。
  * 该系统实现了以下功能：
- * - 敌人自动沿着路径点移动
- * - 到达路径点后自动切换到下一个路径点
+ * - 敌人沿着预编译路径表中的路径段移动
+ * - 到达段终点后自动切换到下一路径段
  * - 支持路径分支（随机选择下一个路径点）
  * - 到达最终路径点时触发事件
  * - 自动清理到达终点的敌人
+ * - 流场导航的关卡中采样 registry.ctx() 里的 engine::spatial::FlowField，绕开障碍与被占用的建造位
  * 
  * @see game::system::FollowPathSystem 路径跟随系统类定义
  * @see game::component::EnemyComponent 存储敌人路径导航数据的组件
  */
 
 #include "followpath_system.h"
+#include "game/component/behavior_component.h"
 #include "game/component/enemy_component.h"
 #include "engine/component/transform_component.h"
 #include "engine/component/velocity_component.h"
-#include "engine/utils/math.h"
-#include "game/data/waypoint_node.h"
+#include "engine/utils/random.h"
+#include "engine/spatial/flow_field.h"
+#include "game/data/path_table.h"
 #include "game/defs/tags.h"
 #include "game/defs/event.h"
 #include "../component/blocked_by_component.h"
-#include <spdlog/spdlog.h>
-#include <glm/glm.hpp>
+#include "../component/simulation_lod_component.h"
+#include "engine/utils/logging.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/geometric.hpp>
 
 namespace game::system {
 
+namespace {
+    constexpr float ARRIVE_THRESHOLD = 5.0f;    ///< 到达段终点的判定距离（像素）
+    constexpr float DRIFT_TOLERANCE = 0.5f;     ///< 偏离路径段超过该距离（像素）时朝段终点转向
+    constexpr unsigned MAX_PATH_SKIP_TICKS = 15;    ///< 低细节敌人最多连续跳过的步数（仍定期刷新 distance_to_home_）
+
+    /**
+     * @brief 在节点处为敌人选择下一条路径段（多个分支时随机选择）
+     * @return 节点为终点（没有出边）时返回 false
+     */
+    bool enterNextSegment(game::component::EnemyComponent& enemy,
+                          engine::utils::Xoshiro128& rng,
+                          const game::data::PathTable& path_table,
+                          std::uint32_t node_index,
+                          const glm::vec2& position) {
+        const auto segments = path_table.getSegments(path_table.getNode(node_index));
+        if (segments.empty()) {
+            return false;
+        }
+
+        const auto choice = segments.size() == 1
+            ? 0u
+            : rng.below(static_cast<std::uint32_t>(segments.size()));
+        const auto& segment = segments[choice];
+        const auto& target_node = path_table.getNode(segment.to_node_);
+
+        enemy.path_segment_ = path_table.getNode(node_index).first_segment_ + choice;
+        enemy.target_waypoint_id_ = target_node.id_;
+        enemy.segment_remaining_ = glm::dot(target_node.position_ - position, segment.direction_);
+        return true;
+    }
+}
+
     /**
      * @brief 更新所有敌人的路径跟随状态
      * @param registry EnTT 实体注册表，包含所有实体和组件
      * @param dispatcher EnTT 事件分发器，用于发布 EnemyArriveHomeEvent
-     * @param waypoint_nodes 路径点ID到路径点数据的映射
+     * @param path_table 关卡加载时编译的路径表
+     * @param delta_time 模拟步长，用于计算低细节敌人可跳过的步数
      * 
      * @details
      * 该方法实现了敌人的路径跟随逻辑：
      * 1. 查询所有具有 EnemyComponent、TransformComponent 和 VelocityComponent 的实体
      * 2. 对每个敌人实体：
-     *    a. 获取当前目标路径点
-     *    b. 计算到目标路径点的方向向量
-     *    c. 检查是否到达目标路径点
-     *    d. 如果到达，处理路径点切换或终点到达
-     *    e. 更新敌人的速度向量
+     *    a. 刚生成的敌人从其目标路径点（起点）进入第一条路径段
+     *    b. 将当前位置投影到路径段方向上，得到到段终点的剩余距离
+     *    c. 如果到达段终点，进入下一路径段或处理终点到达
+     *    d. 以预计算的段方向更新敌人的速度向量
      * 
-     * @par 路径点切换逻辑
-     * - 当敌人距离目标路径点小于5.0f像素时，认为到达该路径点
-     * - 如果路径点有多个下一个路径点，随机选择一个
-     * - 如果路径点没有下一个路径点，认为到达终点
+     * @par 路径段切换逻辑
+     * - 当沿路径段方向的剩余距离小于5.0f像素时，认为到达段终点
+     * - 如果段终点有多条出边，随机选择一条
+     * - 如果段终点没有出边，认为到达终点
      * 
      * @par 终点到达处理
      * - 发布 EnemyArriveHomeEvent 事件
@@ -58,55 +96,142 @@ namespace game::system {
     void FollowPathSystem::update(
         entt::registry& registry,
         entt::dispatcher& dispatcher,
-        std::unordered_map<int, game::data::WaypointNode>& waypoint_nodes)
+        const game::data::PathTable& path_table,
+        float delta_time)
     {
-        // 创建实体视图，获取所有需要路径跟随的敌人实体
+        // 创建实体视图，获取所有需要路径跟随的敌人实体（低细节的敌人在下面单独处理；动作锁定的在遍历中跳过）
         auto view = registry.view<
             game::component::EnemyComponent,
             engine::component::TransformComponent,
-            engine::component::VelocityComponent>(
-            entt::exclude<game::component::BlockedByComponent, game::defs::ActionLockTag>
+            engine::component::VelocityComponent,
+            game::component::BehaviorComponent>(
+            entt::exclude<game::component::BlockedByComponent, game::component::SimulationLodComponent>
             );
 
-        // 遍历所有敌人实体
-        for (auto entity : view) {
-            // 获取必要的组件
-            auto& enemy = registry.get<game::component::EnemyComponent>(entity);
-            auto& transform = registry.get<engine::component::TransformComponent>(entity);
-            auto& velocity = registry.get<engine::component::VelocityComponent>(entity);
-
-            // 获取当前目标路径点
-            auto target_node = waypoint_nodes.at(enemy.target_waypoint_id_);
-
-            // 计算当前位置到目标位置的方向向量
-            glm::vec2 direction = target_node.position_ - transform.position_;
-
-            // 如果距离小于阈值，则切换到下一个节点
-            if (glm::length(direction) < 5.0f) {
-                // 获取下一个路径点ID列表的大小
-                size_t size = target_node.next_node_ids_.size();
-                
-                // 如果下一个节点ID列表为空，代表到达终点
-                if (size == 0) {
-                    spdlog::info("敌人到达终点");
-                    // 发送敌人到达基地事件
-                    dispatcher.enqueue<game::defs::EnemyArriveHomeEvent>();
-                    // 添加死亡标记，后续会被 RemoveDeadSystem 清理
-                    registry.emplace<game::defs::DeadTag>(entity);
-                    continue;
+        // 分支选择使用独立的随机数流，同一种子下与其它系统的随机数消耗无关
+        auto& rng = registry.ctx().get<engine::utils::RandomService>().stream(entt::hashed_string{ "follow_path" });
+
+        // 流场导航的关卡在加载时构建流场；其余关卡没有这一项，只沿路径点前进
+        const auto* flow_field = registry.ctx().find<engine::spatial::FlowField>();
+        if (flow_field && !flow_field->isBuilt()) {
+            flow_field = nullptr;
+        }
+
+        auto arrive_home = [&](entt::entity entity, game::component::EnemyComponent& enemy) {
+            ENGINE_LOG_INFO("敌人到达终点");
+            // 发送敌人到达基地事件
+            dispatcher.enqueue<game::defs::EnemyArriveHomeEvent>();
+            // 添加死亡标记，后续会被 RemoveDeadSystem 清理
+            registry.emplace<game::defs::DeadTag>(entity);
+            enemy.distance_to_home_ = 0.0f;
+        };
+
+        // 推进一个敌人的路径状态；到达终点时返回 false
+        auto advance = [&](entt::entity entity,
+                           game::component::EnemyComponent& enemy,
+                           engine::component::TransformComponent& transform,
+                           engine::component::VelocityComponent& velocity) {
+            if (flow_field) {
+                // 流场：只查所在格子的方向，与敌人数量无关；不可达或在网格外时退回路径点导航
+                const int cell = flow_field->cellAt(transform.position_);
+                if (flow_field->isGoal(cell)) {
+                    arrive_home(entity, enemy);
+                    return false;
+                }
+                if (flow_field->isReachable(cell)) {
+                    velocity.velocity_ = flow_field->sample(transform.position_) * enemy.speed_;
+                    enemy.distance_to_home_ = flow_field->distance(cell);
+                    return true;
+                }
+            }
+
+            bool arrived_home = false;
+
+            if (enemy.path_segment_ == game::data::PathTable::INVALID_INDEX) {
+                // 刚生成的敌人位于其起点，直接从起点进入第一条路径段
+                const auto node_index = path_table.indexOf(enemy.target_waypoint_id_);
+                if (node_index == game::data::PathTable::INVALID_INDEX) {
+                    ENGINE_LOG_WARN("敌人的目标路径点 {} 不存在", enemy.target_waypoint_id_);
+                    velocity.velocity_ = glm::vec2{ 0.0f };
+                    return false;
                 }
+                arrived_home = !enterNextSegment(enemy, rng, path_table, node_index, transform.position_);
+            } else {
+                // 沿路径段方向的投影即剩余距离，越过终点时为负值
+                const auto& segment = path_table.getSegment(enemy.path_segment_);
+                enemy.segment_remaining_ = glm::dot(
+                    path_table.getNode(segment.to_node_).position_ - transform.position_, segment.direction_);
 
-                // 随机选择下一个节点
-                auto target_index = engine::utils::randomInt(0, static_cast<int>(size) - 1);
-                enemy.target_waypoint_id_ = target_node.next_node_ids_[target_index];
+                // 如果剩余距离小于阈值，则切换到下一路径段
+                if (enemy.segment_remaining_ < ARRIVE_THRESHOLD) {
+                    arrived_home = !enterNextSegment(enemy, rng, path_table, segment.to_node_, transform.position_);
+                }
+            }
+
+            if (arrived_home) {
+                arrive_home(entity, enemy);
+                return false;
+            }
 
-                // 更新目标节点与方向矢量
-                target_node = waypoint_nodes.at(enemy.target_waypoint_id_);
-                direction = target_node.position_ - transform.position_;
+            // 更新速度组件：在路径段上时 velocity = 路径段方向（预计算的单位向量） * 速度；
+            // 提前切段、分离与击退使敌人偏离路径段时，改为朝段终点转向（与逐点寻路时相同），偏移不会累积
+            const auto& segment = path_table.getSegment(enemy.path_segment_);
+            const glm::vec2 to_end = path_table.getNode(segment.to_node_).position_ - transform.position_;
+            const glm::vec2 drift = to_end - segment.direction_ * glm::dot(to_end, segment.direction_);
+            const float to_end_sq = glm::dot(to_end, to_end);
+            if (glm::dot(drift, drift) > DRIFT_TOLERANCE * DRIFT_TOLERANCE && to_end_sq > ARRIVE_THRESHOLD * ARRIVE_THRESHOLD) {
+                velocity.velocity_ = to_end * (enemy.speed_ / std::sqrt(to_end_sq));
+            } else {
+                velocity.velocity_ = segment.direction_ * enemy.speed_;
             }
+            enemy.distance_to_home_ = std::max(enemy.segment_remaining_, 0.0f)
+                + path_table.getNode(segment.to_node_).distance_to_home_;
+            return true;
+        };
+
+        // 遍历所有敌人实体
+        for (auto [entity, enemy, transform, velocity, behavior] : view.each()) {
+            if (behavior.isActionLocked()) {
+                continue;
+            }
+            advance(entity, enemy, transform, velocity);
+        }
 
-            // 更新速度组件：velocity = 方向矢量（归一化） * 速度
-            velocity.velocity_ = glm::normalize(direction) * enemy.speed_;
+        // 低细节敌人：到达段终点之前路径段与速度都不变，逐步检查的结果只是重复写入同一速度，
+        // 因此按剩余距离解析地算出可跳过的步数（少算一步留出浮点误差），期间位置仍由 MovementSystem 推进
+        auto low_view = registry.view<
+            game::component::EnemyComponent,
+            engine::component::TransformComponent,
+            engine::component::VelocityComponent,
+            game::component::SimulationLodComponent,
+            game::component::BehaviorComponent>(
+            entt::exclude<game::component::BlockedByComponent>
+            );
+        for (auto [entity, enemy, transform, velocity, lod, behavior] : low_view.each()) {
+            if (behavior.isActionLocked()) {
+                continue;
+            }
+            if (flow_field || !path_skipping_) {
+                // 流场方向随格子变化，没有可解析跳过的区间（采样本身只是一次查表）；
+                // 关闭跳过时（敌人分离）速度每步都要重写
+                lod.path_skip_ticks_ = 0;
+                advance(entity, enemy, transform, velocity);
+                continue;
+            }
+            if (lod.path_skip_ticks_ > 0 && lod.speed_ == enemy.speed_) {
+                --lod.path_skip_ticks_;
+                continue;
+            }
+            lod.path_skip_ticks_ = 0;
+            if (!advance(entity, enemy, transform, velocity)) {
+                continue;
+            }
+            const float step = enemy.speed_ * delta_time;
+            lod.speed_ = enemy.speed_;
+            if (step > 0.0f) {
+                const float ticks = std::floor((enemy.segment_remaining_ - ARRIVE_THRESHOLD) / step) - 1.0f;
+                lod.path_skip_ticks_ = static_cast<unsigned>(std::clamp(ticks, 0.0f, static_cast<float>(MAX_PATH_SKIP_TICKS)));
+            }
         }
     }
 
@@ -13,24 +13,25 @@
  * - 发布：当敌人到达最终路径点时发布 EnemyArriveHomeEvent
  * 
  * @par 路径跟随原理
- * 1. 读取敌人的目标路径点ID
- * 2. 从路径点地图中获取目标路径点的位置
- * 3. 计算敌人当前位置到目标路径点的方向向量
- * 4. 归一化方向向量并乘以敌人速度，得到速度向量
- * 5. 更新敌人的速度组件
- * 6. 检查敌人是否到达目标路径点
- * 7. 如果到达，更新目标路径点为下一个路径点
- * 8. 如果到达最终路径点，发布 EnemyArriveHomeEvent
+ * 1. 关卡加载时将路径点图编译为 PathTable（扁平节点/路径段数组，预计算方向与长度）
+ * 2. 敌人记录当前所在路径段，每帧用点积求出沿路径段到段终点的剩余距离
+ * 3. 速度为路径段方向乘以敌人速度，无需每帧归一化
+ * 4. 剩余距离小于阈值时进入下一路径段（多个分支时随机选择）
+ * 5. 到达终点（没有出边的节点）时发布 EnemyArriveHomeEvent
+ *
+ * @par 流场导航
+ * 关卡配置 "navigation": "flow_field" 时，GameScene 以所有终点为目标构建 engine::spatial::FlowField
+ * 放入 registry.ctx()。敌人的速度取所在格子的流场方向，到达目标格子即视为到达终点，
+ * distance_to_home_ 取流场的加权距离；不在网格内或不可达的敌人退回路径点导航。
  * 
  * @see game::component::EnemyComponent 存储敌人路径导航数据的组件
- * @see game::data::WaypointNode 定义路径点数据的结构
+ * @see game::data::PathTable 编译后的路径表
  * @see game::defs::EnemyArriveHomeEvent 敌人到达基地的事件
  */
 
 #pragma once
 #include <entt/entt.hpp>
-#include <unordered_map>
-#include "game/data/waypoint_node.h"
+#include "game/data/path_table.h"
 
 namespace game::system {
     /**
@@ -51,23 +52,35 @@ namespace game::system {
          * @brief 更新所有敌人的路径跟随状态
          * @param registry EnTT 实体注册表，包含所有实体和组件
          * @param dispatcher EnTT 事件分发器，用于发布 EnemyArriveHomeEvent
-         * @param waypoint_nodes 路径点ID到路径点数据的映射
+         * @param path_table 关卡加载时编译的路径表
+         * @param delta_time 模拟步长
          * 
          * @details
          * 该方法实现了以下功能：
          * 1. 查询所有具有 EnemyComponent、TransformComponent 和 VelocityComponent 的实体
          * 2. 对每个敌人实体：
-         *    a. 获取目标路径点数据
-         *    b. 计算移动方向和速度
-         *    c. 更新速度组件
-         *    d. 检查是否到达路径点
-         *    e. 更新目标路径点或发布到达事件
+         *    a. 沿当前路径段方向计算剩余距离（点积，无开方）
+         *    b. 检查是否到达段终点，进入下一段或发布到达事件
+         *    c. 以预计算的段方向更新速度组件
+         *    d. 更新到基地的剩余距离
          * 
          * @par 注意事项
          * - 该系统假设路径点网络是有效的，即每个路径点都有正确的下一个路径点
          * - 当敌人到达没有下一个路径点的路径点时，认为其到达了最终目标
+         * - 带 SimulationLodComponent 的低细节敌人在到达段终点之前按解析算出的步数跳过检查，结果与逐步检查相同
+         * - registry.ctx() 中有已构建的 engine::spatial::FlowField 时优先采样流场（低细节敌人也逐步采样）
          */
-        void update(entt::registry& registry, entt::dispatcher& dispatcher, 
-        std::unordered_map<int, game::data::WaypointNode>& waypoint_nodes);
+        void update(entt::registry& registry, entt::dispatcher& dispatcher,
+            const game::data::PathTable& path_table, float delta_time);
+
+        /**
+         * @brief 是否允许低细节敌人按解析步数跳过检查（默认允许）
+         * @details 启用 CrowdSeparationSystem 时须关闭：分离在每步的速度上叠加修正，跳过的步数里速度不会被重写，
+         *          修正会逐步累积；而只对完整模拟的敌人做分离又会让轨迹取决于相机，回放不再一致。
+         */
+        void setPathSkipping(bool enabled) { path_skipping_ = enabled; }
+
+    private:
+        bool path_skipping_{ true };
     };
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 namespace game::system {
 
 class FollowPathSystem;
+class SimulationLodSystem;
 class RemoveDeadSystem;
 class BlockSystem;
 class SetTargetSystem;
@@ -18,5 +19,12 @@ class SelectionSystem;
 class RenderRangeSystem;
 class GameRuleSystem;
 class HeroSkillSystem;
+class SpatialIndexSystem;
+class StatusEffectSystem;
+class HealthBarSystem;
+class CrowdSeparationSystem;
+class ProjectileSystem;
+class EffectParticleSystem;
+class DamageNumberSystem;
 
 }   // namespace game::system
\ No newline at end of file
@@ -2,12 +2,14 @@
 
 #include "../component/class_name_component.h"
 #include "../component/player_component.h"
+#include "../component/attack_timer_component.h"
 #include "../component/stats_component.h"
 #include "../defs/event.h"
+#include "../defs/ids.h"
 #include "../factory/blueprint_manager.h"
 #include "../data/game_stats.h"
 #include "../../engine/utils/math.h"
-#include "../../engine/audio/audio_locator.h"
+#include "../../engine/utils/events.h"
 #include "../../engine/utils/logging.h"
 #include <algorithm>
 #include <memory>
@@ -71,11 +73,14 @@ void GameRuleSystem::onUpgradeUnit(const game::defs::UpgradeUnitEvent& event) {
     stats.atk_ = engine::utils::statModify(blueprint.stats_.atk_, stats.level_, stats.rarity_);
     stats.def_ = engine::utils::statModify(blueprint.stats_.def_, stats.level_, stats.rarity_);
     stats.range_ = engine::utils::statModify(blueprint.stats_.range_, stats.level_, stats.rarity_);
-    stats.atk_interval_ = std::max(0.1f, engine::utils::statModify(blueprint.stats_.atk_interval_, stats.level_, stats.rarity_));
+    registry_.get<game::component::AttackTimerComponent>(event.entity_).interval_ =
+        std::max(0.1f, engine::utils::statModify(blueprint.stats_.atk_interval_, stats.level_, stats.rarity_));
     stats.hp_ = stats.max_hp_;
+    registry_.patch<game::component::StatsComponent>(event.entity_);    // 就地改写后补发 on_update
 
-    dispatcher_.trigger(game::defs::SpawnEffectVisualEvent{ event.entity_, entt::hashed_string("level_up") });
-    engine::audio::AudioLocator::get().playSound(entt::hashed_string("unit_upgrade").value());
+    dispatcher_.trigger(game::defs::SpawnEffectVisualEvent{ event.entity_, game::ids::hashOf(game::ids::Effect::LEVEL_UP) });
+    // 经事件交给 AudioSystem 播放，模拟本身不访问全局音频服务（无头模拟没有 AudioSystem）
+    dispatcher_.enqueue(engine::utils::PlaySoundEvent{ entt::null, entt::hashed_string("unit_upgrade").value() });
     ENGINE_LOG_INFO("升级单位成功 entity={}, level={}, gold={}", entt::to_integral(event.entity_), stats.level_, static_cast<int>(game_stats.cost_));
 }
 
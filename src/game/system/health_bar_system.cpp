@@ -0,0 +1,148 @@
+#include "health_bar_system.h"
+#include "game/component/stats_component.h"
+#include "../../engine/component/transform_component.h"
+#include "../../engine/render/camera.h"
+#include <algorithm>
+
+namespace game::system {
+
+using namespace game::component;
+using namespace engine::component;
+
+namespace {
+    constexpr glm::vec2 BAR_OFFSET{ -24.0f, 28.0f };   ///< 血条相对实体位置的偏移
+    constexpr glm::vec2 BAR_SIZE{ 48.0f, 6.0f };       ///< 含 1 像素边框的整体尺寸
+    constexpr float BAR_BORDER = 1.0f;
+    constexpr float FILL_WIDTH = BAR_SIZE.x - BAR_BORDER * 2.0f;
+    constexpr float FILL_HEIGHT = BAR_SIZE.y - BAR_BORDER * 2.0f;
+
+    constexpr engine::utils::FColor BORDER_COLOR{ 0.0f, 0.0f, 0.0f, 0.85f };
+    constexpr engine::utils::FColor BACKGROUND_COLOR{ 0.08f, 0.08f, 0.08f, 0.95f };
+    constexpr engine::utils::FColor HIGH_HP_COLOR{ 0.18f, 0.78f, 0.18f, 1.0f };
+    constexpr engine::utils::FColor MID_HP_COLOR{ 0.92f, 0.72f, 0.12f, 1.0f };
+    constexpr engine::utils::FColor LOW_HP_COLOR{ 0.92f, 0.18f, 0.18f, 1.0f };
+}
+
+HealthBarSystem::HealthBarSystem(entt::registry& registry) : registry_(registry) {
+    registry_.on_construct<StatsComponent>().connect<&HealthBarSystem::onStatsConstruct>(this);
+    registry_.on_destroy<StatsComponent>().connect<&HealthBarSystem::onStatsDestroy>(this);
+
+    // 接管系统创建前已存在的实体
+    for (auto entity : registry_.view<StatsComponent>()) {
+        onStatsConstruct(registry_, entity);
+    }
+}
+
+HealthBarSystem::~HealthBarSystem() {
+    registry_.on_construct<StatsComponent>().disconnect(this);
+    registry_.on_destroy<StatsComponent>().disconnect(this);
+}
+
+void HealthBarSystem::onStatsConstruct(entt::registry&, entt::entity entity) {
+    auto [it, inserted] = bar_index_.try_emplace(entity, bars_.size());
+    if (inserted) {
+        bars_.push_back(HealthBar{ entity });
+    }
+}
+
+void HealthBarSystem::onStatsDestroy(entt::registry&, entt::entity entity) {
+    auto it = bar_index_.find(entity);
+    if (it == bar_index_.end()) {
+        return;
+    }
+    const std::size_t index = it->second;
+    bar_index_.erase(it);
+    if (index + 1 != bars_.size()) {
+        bars_[index] = bars_.back();
+        bar_index_[bars_[index].entity_] = index;
+    }
+    bars_.pop_back();
+}
+
+void HealthBarSystem::onEntitiesDestroyed(entt::registry&, std::span<const entt::entity> entities) {
+    std::size_t removed = 0;
+    for (auto entity : entities) {
+        if (auto it = bar_index_.find(entity); it != bar_index_.end()) {
+            bars_[it->second].entity_ = entt::null;
+            bar_index_.erase(it);
+            ++removed;
+        }
+    }
+    if (removed == 0) {
+        return;
+    }
+    // 一次压缩，只为位置变化的血条重写下标
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < bars_.size(); ++i) {
+        if (bars_[i].entity_ == entt::null) {
+            continue;
+        }
+        if (kept != i) {
+            bars_[kept] = bars_[i];
+            bar_index_[bars_[kept].entity_] = kept;
+        }
+        ++kept;
+    }
+    bars_.resize(kept);
+}
+
+void HealthBarSystem::update() {
+    for (auto& bar : bars_) {
+        const auto* transform = registry_.try_get<TransformComponent>(bar.entity_);
+        if (!transform) {
+            bar.visible_ = false;
+            continue;
+        }
+        bar.visible_ = true;
+
+        const auto& stats = registry_.get<StatsComponent>(bar.entity_);
+        const glm::vec2 anchor = transform->position_ + BAR_OFFSET;
+        if (stats.hp_ == bar.hp_ && stats.max_hp_ == bar.max_hp_ && anchor == bar.anchor_) {
+            continue;
+        }
+
+        bar.anchor_ = anchor;
+        if (stats.hp_ != bar.hp_ || stats.max_hp_ != bar.max_hp_) {
+            bar.hp_ = stats.hp_;
+            bar.max_hp_ = stats.max_hp_;
+            const float hp_ratio = stats.max_hp_ > 0.0f ? std::clamp(stats.hp_ / stats.max_hp_, 0.0f, 1.0f) : 0.0f;
+            bar.fill_width_ = FILL_WIDTH * hp_ratio;
+            if (hp_ratio > 0.66f) {
+                bar.fill_color_ = HIGH_HP_COLOR;
+            } else if (hp_ratio > 0.33f) {
+                bar.fill_color_ = MID_HP_COLOR;
+            } else {
+                bar.fill_color_ = LOW_HP_COLOR;
+            }
+        }
+    }
+}
+
+void HealthBarSystem::render(engine::render::Renderer& renderer, const engine::render::Camera& camera) {
+    const glm::vec2 viewport = camera.getViewportSize();
+    rects_.clear();
+    rects_.reserve(bars_.size() * 3);
+
+    for (const auto& bar : bars_) {
+        if (!bar.visible_) {
+            continue;
+        }
+        const glm::vec2 screen_pos = camera.worldToScreen(bar.anchor_);
+        if (screen_pos.x + BAR_SIZE.x < 0.0f || screen_pos.y + BAR_SIZE.y < 0.0f ||
+            screen_pos.x > viewport.x || screen_pos.y > viewport.y) {
+            continue;
+        }
+
+        // 边框、底色、填充依次覆盖
+        const glm::vec2 inner_pos = screen_pos + glm::vec2{ BAR_BORDER, BAR_BORDER };
+        rects_.push_back({ engine::utils::Rect{ screen_pos, BAR_SIZE }, BORDER_COLOR });
+        rects_.push_back({ engine::utils::Rect{ inner_pos, { FILL_WIDTH, FILL_HEIGHT } }, BACKGROUND_COLOR });
+        if (bar.fill_width_ > 0.0f) {
+            rects_.push_back({ engine::utils::Rect{ inner_pos, { bar.fill_width_, FILL_HEIGHT } }, bar.fill_color_ });
+        }
+    }
+
+    renderer.drawUIFilledRects(rects_);
+}
+
+} // namespace game::system
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <glm/vec2.hpp>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "../../engine/render/renderer.h"
+
+namespace engine::render {
+    class Camera;
+}
+
+namespace game::system {
+
+/**
+ * @class HealthBarSystem
+ * @brief 血条系统：跟踪所有带 StatsComponent 的实体，并在一次批量绘制中画出全部血条。
+ *
+ * @details
+ * 通过 on_construct/on_destroy<StatsComponent> 信号增删血条，不再每帧对照存活实体列表；
+ * update() 只为生命值或位置发生变化的实体重新计算血条几何，render() 将可见血条
+ * 合并为一次 Renderer::drawUIFilledRects 调用，不经过 UIElement 树。
+ */
+class HealthBarSystem final {
+public:
+    explicit HealthBarSystem(entt::registry& registry);
+    ~HealthBarSystem();
+
+    HealthBarSystem(const HealthBarSystem&) = delete;
+    HealthBarSystem& operator=(const HealthBarSystem&) = delete;
+
+    /// @brief 为生命值或位置变化的实体更新血条（世界空间）
+    void update();
+
+    /// @brief 绘制视口内的所有血条（屏幕空间，一次提交）
+    void render(engine::render::Renderer& renderer, const engine::render::Camera& camera);
+
+    [[nodiscard]] std::size_t getBarCount() const { return bars_.size(); }
+
+    /// @brief RemoveDeadSystem 批量收尾：一次性移除整批实体的血条（之后的 on_destroy 回调直接命中空）
+    void onEntitiesDestroyed(entt::registry& registry, std::span<const entt::entity> entities);
+
+private:
+    struct HealthBar {
+        entt::entity entity_{ entt::null };
+        glm::vec2 anchor_{ 0.0f };      ///< 血条左上角（世界坐标）
+        float hp_{ -1.0f };             ///< 上次布局时的生命值，用于变化检测
+        float max_hp_{ -1.0f };
+        float fill_width_{ 0.0f };      ///< 填充条宽度（像素）
+        engine::utils::FColor fill_color_{};
+        bool visible_{ false };         ///< 没有 TransformComponent 时不绘制
+    };
+
+    void onStatsConstruct(entt::registry& registry, entt::entity entity);
+    void onStatsDestroy(entt::registry& registry, entt::entity entity);
+
+    entt::registry& registry_;
+    std::vector<HealthBar> bars_;                               ///< 紧凑存储，删除时与末尾交换
+    std::unordered_map<entt::entity, std::size_t> bar_index_;   ///< 实体到 bars_ 下标
+    std::vector<engine::render::UIFilledRect> rects_;           ///< 每帧复用的绘制缓冲
+};
+
+} // namespace game::system
@@ -1,13 +1,23 @@
 #include "hero_skill_system.h"
 
 #include "../component/class_name_component.h"
+#include "../component/behavior_component.h"
 #include "../component/hero_skill_component.h"
 #include "../component/player_component.h"
+#include "../component/base_stats_component.h"
 #include "../component/stats_component.h"
 #include "../data/game_stats.h"
+#include "../data/status_effect_store.h"
 #include "../factory/blueprint_manager.h"
+#include "../defs/constants.h"
+#include "../defs/ids.h"
 #include "../defs/tags.h"
+#include "status_effect_system.h"
+#include "../../engine/core/timer_wheel.h"
+#include "../../engine/ecs/event_queues.h"
+#include "../../engine/component/transform_component.h"
 #include "../../engine/utils/events.h"
+#include "../../engine/component/animation_request_component.h"
 #include "../../engine/component/render_component.h"
 #include "../../engine/utils/logging.h"
 #include <memory>
@@ -17,17 +27,22 @@ using namespace entt::literals;
 
 namespace game::system {
 
-HeroSkillSystem::HeroSkillSystem(entt::registry& registry, entt::dispatcher& dispatcher)
-    : registry_(registry), dispatcher_(dispatcher) {
+HeroSkillSystem::HeroSkillSystem(entt::registry& registry, entt::dispatcher& dispatcher, engine::ecs::EventQueues& event_queues)
+    : registry_(registry), dispatcher_(dispatcher), event_queues_(event_queues) {
     dispatcher_.sink<game::defs::UpgradeHeroEvent>().connect<&HeroSkillSystem::onUpgradeHeroEvent>(this);
     dispatcher_.sink<game::defs::ReleaseHeroSkillEvent>().connect<&HeroSkillSystem::onReleaseHeroSkillEvent>(this);
     dispatcher_.sink<game::defs::SkillReadyEvent>().connect<&HeroSkillSystem::onSkillReadyEvent>(this);
     dispatcher_.sink<game::defs::SkillActiveEvent>().connect<&HeroSkillSystem::onSkillActiveEvent>(this);
     dispatcher_.sink<game::defs::SkillDurationEndEvent>().connect<&HeroSkillSystem::onSkillDurationEndEvent>(this);
+    // 放置、移除、快照恢复都经过标签的构造/销毁信号
+    registry_.on_construct<game::defs::PassiveSkillTag>().connect<&HeroSkillSystem::onPassiveRosterChanged>(this);
+    registry_.on_destroy<game::defs::PassiveSkillTag>().connect<&HeroSkillSystem::onPassiveRosterChanged>(this);
 }
 
 HeroSkillSystem::~HeroSkillSystem() {
     dispatcher_.disconnect(this);
+    registry_.on_construct<game::defs::PassiveSkillTag>().disconnect<&HeroSkillSystem::onPassiveRosterChanged>(this);
+    registry_.on_destroy<game::defs::PassiveSkillTag>().disconnect<&HeroSkillSystem::onPassiveRosterChanged>(this);
 }
 
 void HeroSkillSystem::update(float delta_time) {
@@ -40,18 +55,29 @@ void HeroSkillSystem::update(float delta_time) {
     if (!blueprint_manager_ptr) {
         return;
     }
-    auto& blueprint_manager = *blueprint_manager_ptr;
     auto& game_stats = registry_.ctx().get<game::data::GameStats&>();
+    if (passive_regen_dirty_) {
+        refreshPassiveRegen(*blueprint_manager_ptr, game_stats);
+    }
+    if (game_stats.passive_cost_regen_ > 0.0f) {
+        game_stats.cost_ += game_stats.passive_cost_regen_ * delta_time;
+    }
+}
 
-    registry_.view<game::component::HeroSkillComponent, game::component::StatsComponent, game::component::PlayerComponent>().each(
-        [&](auto entity, game::component::HeroSkillComponent& skill, auto&, auto&) {
-            if (skill.passive_ && blueprint_manager.hasSkillBlueprint(skill.skill_id_)) {
-                const auto& blueprint = blueprint_manager.getSkillBlueprint(skill.skill_id_);
-                if (blueprint.cost_regen_ > 0.0f) {
-                    game_stats.cost_ += blueprint.cost_regen_ * delta_time;
-                }
-            }
-        });
+void HeroSkillSystem::onPassiveRosterChanged(entt::registry&, entt::entity) {
+    passive_regen_dirty_ = true;
+}
+
+void HeroSkillSystem::refreshPassiveRegen(const game::factory::BlueprintManager& blueprint_manager, game::data::GameStats& game_stats) {
+    // 信号只置脏，汇总推迟到 update：此时被销毁单位的标签已移除
+    float regen = 0.0f;
+    for (auto [entity, skill] : registry_.view<game::defs::PassiveSkillTag, game::component::HeroSkillComponent>().each()) {
+        if (blueprint_manager.hasSkillBlueprint(skill.skill_id_)) {
+            regen += blueprint_manager.getSkillBlueprint(skill.skill_id_).cost_regen_;
+        }
+    }
+    game_stats.passive_cost_regen_ = regen;
+    passive_regen_dirty_ = false;
 }
 
 void HeroSkillSystem::onUpgradeHeroEvent(const game::defs::UpgradeHeroEvent& event) {
@@ -72,9 +98,9 @@ void HeroSkillSystem::onUpgradeHeroEvent(const game::defs::UpgradeHeroEvent& eve
     }
 
     game_stats.cost_ -= static_cast<float>(upgrade_cost);
-    auto& stats = registry_.get<game::component::StatsComponent>(event.entity_);
-    auto* skill = registry_.try_get<game::component::HeroSkillComponent>(event.entity_);
-    applyUpgrade(event.entity_, skill, stats);
+    // 经 patch 写入，变化跟踪（ecs::ChangeTracker）能看到生命上限与属性的变化
+    const auto& stats = registry_.patch<game::component::StatsComponent>(event.entity_,
+        [&](auto& value) { applyUpgrade(event.entity_, value); });
     ENGINE_LOG_INFO("英雄升级成功 entity={}, cost={}, level={}", entt::to_integral(event.entity_), upgrade_cost, stats.level_);
 }
 
@@ -87,11 +113,11 @@ void HeroSkillSystem::onSkillReadyEvent(const game::defs::SkillReadyEvent& event
         return;
     }
 
-    if (!registry_.all_of<game::defs::SkillReadyTag>(event.entity_)) {
-        registry_.emplace<game::defs::SkillReadyTag>(event.entity_);
+    if (auto* behavior = registry_.try_get<game::component::BehaviorComponent>(event.entity_)) {
+        behavior->setFlag(game::component::behavior_flag::SKILL_READY, true);
     }
 
-    dispatcher_.trigger(game::defs::SpawnEffectVisualEvent{ event.entity_, entt::hashed_string("skill_ready").value() });
+    dispatcher_.trigger(game::defs::SpawnEffectVisualEvent{ event.entity_, game::ids::hashOf(game::ids::Effect::SKILL_READY) });
 }
 
 void HeroSkillSystem::onSkillActiveEvent(const game::defs::SkillActiveEvent& event) {
@@ -115,36 +141,40 @@ void HeroSkillSystem::onSkillActiveEvent(const game::defs::SkillActiveEvent& eve
     }
 
     const auto& blueprint = blueprint_manager.getSkillBlueprint(skill->skill_id_);
-    auto& stats = registry_.get<game::component::StatsComponent>(event.entity_);
     if (skill->passive_) {
         ENGINE_LOG_INFO("[HeroSkillSystem::onSkillActiveEvent] 被动技能无需主动释放 entity={}, skill={}", entt::to_integral(event.entity_), blueprint.name_);
         return;
     }
 
-    if (skill->active_ || skill->cooldown_timer_ > 0.0f) {
-        ENGINE_LOG_WARN("[HeroSkillSystem::onSkillActiveEvent] 技能冷却中 entity={}, skill={}, cooldown={}", entt::to_integral(event.entity_), blueprint.name_, skill->cooldown_timer_);
+    const auto* timers = registry_.ctx().find<engine::core::TimerWheel>();
+    if (!timers) {
+        ENGINE_LOG_ERROR("[HeroSkillSystem::onSkillActiveEvent] 注册表上下文中没有模拟计时器，无法释放技能");
+        return;
+    }
+    if (skill->active_ || timers->getTick() < skill->cooldown_end_tick_) {
+        ENGINE_LOG_WARN("[HeroSkillSystem::onSkillActiveEvent] 技能冷却中 entity={}, skill={}, cooldown={}", entt::to_integral(event.entity_), blueprint.name_, timers->secondsUntil(skill->cooldown_end_tick_));
         return;
     }
 
-    activateSkill(event.entity_, *skill, stats, blueprint);
-    if (registry_.all_of<game::defs::SkillReadyTag>(event.entity_)) {
-        registry_.remove<game::defs::SkillReadyTag>(event.entity_);
+    activateSkill(event.entity_, *skill, blueprint);
+    auto* behavior = registry_.try_get<game::component::BehaviorComponent>(event.entity_);
+    if (behavior) {
+        behavior->setFlag(game::component::behavior_flag::SKILL_READY, false);
     }
     registry_.emplace_or_replace<game::defs::SkillActiveTag>(event.entity_);
-    if (skill->skill_id_ == entt::hashed_string("shield").value() && !registry_.all_of<game::defs::ActionLockTag>(event.entity_)) {
-        dispatcher_.enqueue(engine::utils::PlayAnimationEvent{ event.entity_, "guard"_hs, true });
+    if (skill->skill_id_ == game::ids::hashOf(game::ids::Skill::SHIELD) && !(behavior && behavior->isActionLocked())) {
+        registry_.emplace_or_replace<engine::component::AnimationRequestComponent>(event.entity_, "guard"_hs, true);
     }
-    dispatcher_.enqueue(game::defs::SpawnEffectVisualEvent{ event.entity_, entt::hashed_string("skill_active").value() });
+    dispatcher_.enqueue(game::defs::SpawnEffectVisualEvent{ event.entity_, game::ids::hashOf(game::ids::Effect::SKILL_ACTIVE) });
     ENGINE_LOG_INFO("[HeroSkillSystem::onSkillActiveEvent] 英雄释放技能 entity={}, skill={}", entt::to_integral(event.entity_), blueprint.name_);
 }
 
 void HeroSkillSystem::onSkillDurationEndEvent(const game::defs::SkillDurationEndEvent& event) {
-    if (!registry_.valid(event.entity_) || !registry_.all_of<game::component::HeroSkillComponent, game::component::StatsComponent>(event.entity_)) {
+    if (!registry_.valid(event.entity_) || !registry_.all_of<game::component::HeroSkillComponent>(event.entity_)) {
         return;
     }
 
     auto& skill = registry_.get<game::component::HeroSkillComponent>(event.entity_);
-    auto& stats = registry_.get<game::component::StatsComponent>(event.entity_);
     if (!skill.active_) {
         return;
     }
@@ -152,57 +182,64 @@ void HeroSkillSystem::onSkillDurationEndEvent(const game::defs::SkillDurationEnd
     if (registry_.all_of<game::defs::SkillActiveTag>(event.entity_)) {
         registry_.remove<game::defs::SkillActiveTag>(event.entity_);
     }
-    deactivateSkill(event.entity_, skill, stats);
-    if (skill.skill_id_ == entt::hashed_string("shield").value() && !registry_.all_of<game::defs::ActionLockTag>(event.entity_)) {
-        dispatcher_.enqueue(engine::utils::PlayAnimationEvent{ event.entity_, "idle"_hs, true });
+    deactivateSkill(event.entity_, skill);
+    const auto* behavior = registry_.try_get<game::component::BehaviorComponent>(event.entity_);
+    if (skill.skill_id_ == game::ids::hashOf(game::ids::Skill::SHIELD) && !(behavior && behavior->isActionLocked())) {
+        registry_.emplace_or_replace<engine::component::AnimationRequestComponent>(event.entity_, "idle"_hs, true);
     }
     ENGINE_LOG_INFO("[HeroSkillSystem::onSkillDurationEndEvent] 技能结束 entity={}", entt::to_integral(event.entity_));
 }
 
 void HeroSkillSystem::activateSkill(entt::entity entity,
                                    game::component::HeroSkillComponent& skill,
-                                   game::component::StatsComponent& stats,
                                    const game::data::SkillBlueprint& blueprint) {
-    skill.base_hp_ = stats.hp_;
-    skill.base_max_hp_ = stats.max_hp_;
-    skill.base_atk_ = stats.atk_;
-    skill.base_def_ = stats.def_;
-    skill.base_range_ = stats.range_;
-    skill.base_atk_interval_ = stats.atk_interval_;
-
-    skill.atk_multiplier_ = blueprint.atk_multiplier_;
-    skill.def_multiplier_ = blueprint.def_multiplier_;
-    skill.range_multiplier_ = blueprint.range_multiplier_;
-    skill.atk_interval_multiplier_ = blueprint.atk_interval_multiplier_;
-
-    stats.hp_ = skill.base_hp_;
-    stats.max_hp_ = skill.base_max_hp_;
-    stats.atk_ = skill.base_atk_ * skill.atk_multiplier_;
-    stats.def_ = skill.base_def_ * skill.def_multiplier_;
-    stats.range_ = skill.base_range_ * skill.range_multiplier_;
-    stats.atk_interval_ = skill.base_atk_interval_ * skill.atk_interval_multiplier_;
+    // 倍率作为状态效果施加，本步 StatusEffectSystem 汇总时写入属性；与持续时间同时到期
+    game::data::StatusEffectSpec effect;
+    effect.effect_id_ = skill.skill_id_;
+    effect.source_ = entity;
+    effect.duration_ = blueprint.duration_;
+    effect.atk_multiplier_ = blueprint.atk_multiplier_;
+    effect.def_multiplier_ = blueprint.def_multiplier_;
+    effect.range_multiplier_ = blueprint.range_multiplier_;
+    effect.atk_interval_multiplier_ = blueprint.atk_interval_multiplier_;
+    StatusEffectSystem::apply(registry_, entity, effect);
+
+    // 范围技能：以释放者为圆心的一次伤害，受害者在战斗结算时由空间网格查询
+    if (blueprint.area_radius_ > 0.0f) {
+        const auto* transform = registry_.try_get<engine::component::TransformComponent>(entity);
+        const auto* stats = registry_.try_get<game::component::StatsComponent>(entity);
+        if (transform && stats) {
+            event_queues_.enqueue(game::defs::AreaHitEvent{
+                entity,
+                game::defs::AreaShape::CIRCLE,
+                transform->position_,
+                transform->position_,
+                blueprint.area_radius_,
+                1.0f,
+                stats->atk_ * blueprint.area_damage_multiplier_,
+                game::defs::spatial_layer::ENEMY });
+        }
+    }
 
     skill.duration_ = blueprint.duration_;
-    skill.duration_timer_ = blueprint.duration_;
     skill.cooldown_ = blueprint.cooldown_;
-    skill.cooldown_timer_ = blueprint.cooldown_;
     skill.passive_ = blueprint.passive_;
     skill.active_ = true;
 
+    // 到期时由 TimerSystem 发出 SkillDurationEndEvent / SkillReadyEvent；冷却与持续同时开始计时
+    auto& timers = registry_.ctx().get<engine::core::TimerWheel>();
+    skill.duration_end_tick_ = timers.getTick() + timers.ticksFor(blueprint.duration_);
+    skill.cooldown_end_tick_ = timers.getTick() + timers.ticksFor(blueprint.cooldown_);
+    timers.schedule(skill.duration_end_tick_, entity, game::defs::timer_event::SKILL_DURATION_END);
+    timers.schedule(skill.cooldown_end_tick_, entity, game::defs::timer_event::SKILL_READY);
+
     if (auto* render = registry_.try_get<engine::component::RenderComponent>(entity)) {
         render->color_ = { 1.0f, 0.40f, 0.40f, 1.0f };
     }
 }
 
-void HeroSkillSystem::deactivateSkill(entt::entity entity,
-                                     game::component::HeroSkillComponent& skill,
-                                     game::component::StatsComponent& stats) {
-    stats.hp_ = skill.base_hp_;
-    stats.max_hp_ = skill.base_max_hp_;
-    stats.atk_ = skill.base_atk_;
-    stats.def_ = skill.base_def_;
-    stats.range_ = skill.base_range_;
-    stats.atk_interval_ = skill.base_atk_interval_;
+void HeroSkillSystem::deactivateSkill(entt::entity entity, game::component::HeroSkillComponent& skill) {
+    StatusEffectSystem::remove(registry_, entity, skill.skill_id_);     // 通常已在同一步随计时器到期
     skill.active_ = false;
 
     if (auto* render = registry_.try_get<engine::component::RenderComponent>(entity)) {
@@ -210,26 +247,18 @@ void HeroSkillSystem::deactivateSkill(entt::entity entity,
     }
 }
 
-void HeroSkillSystem::applyUpgrade(entt::entity,
-                                  game::component::HeroSkillComponent* skill,
-                                  game::component::StatsComponent& stats) {
+void HeroSkillSystem::applyUpgrade(entt::entity entity, game::component::StatsComponent& stats) {
     stats.level_ += 1;
-    if (skill && skill->active_) {
-        skill->base_hp_ *= 1.20f;
-        skill->base_max_hp_ *= 1.20f;
-        skill->base_atk_ *= 1.12f;
-        skill->base_def_ *= 1.00f;
-        skill->base_range_ *= 1.05f;
-        skill->base_atk_interval_ *= 1.00f;
-        stats.hp_ = skill->base_hp_;
-        stats.max_hp_ = skill->base_max_hp_;
-        stats.atk_ = skill->base_atk_ * skill->atk_multiplier_;
-        stats.def_ = skill->base_def_ * skill->def_multiplier_;
-        stats.range_ = skill->base_range_ * skill->range_multiplier_;
-        stats.atk_interval_ = skill->base_atk_interval_ * skill->atk_interval_multiplier_;
+    stats.max_hp_ *= 1.20f;
+    stats.hp_ = stats.max_hp_;
+    // 带属性修正的单位改基础属性，由 StatusEffectSystem 重新汇总出有效属性
+    auto* base = registry_.try_get<game::component::BaseStatsComponent>(entity);
+    auto* effects = registry_.ctx().find<game::data::StatusEffectStore>();
+    if (base && effects) {
+        base->atk_ *= 1.12f;
+        base->range_ *= 1.05f;
+        effects->markDirty(entity);
     } else {
-        stats.max_hp_ *= 1.20f;
-        stats.hp_ = stats.max_hp_;
         stats.atk_ *= 1.12f;
         stats.range_ *= 1.05f;
     }
@@ -8,20 +8,38 @@
 #include "../data/entity_blueprint.h"
 #include "../defs/event.h"
 
+namespace engine::ecs {
+class EventQueues;
+}
+
+namespace game::data {
+struct GameStats;
+}
+
+namespace game::factory {
+class BlueprintManager;
+}
+
 namespace game::system {
 
 class HeroSkillSystem final {
 private:
     entt::registry& registry_;
     entt::dispatcher& dispatcher_;
+    engine::ecs::EventQueues& event_queues_;    ///< 范围技能的 AreaHitEvent 写入其中
+    bool passive_regen_dirty_{ true };          ///< 带被动技能的单位增减后重算 GameStats::passive_cost_regen_
 
 public:
-    HeroSkillSystem(entt::registry& registry, entt::dispatcher& dispatcher);
+    HeroSkillSystem(entt::registry& registry, entt::dispatcher& dispatcher, engine::ecs::EventQueues& event_queues);
     ~HeroSkillSystem();
 
+    /// @brief 按被动回费合计增加金币；只主动技能参与逐步计时（到期由 TimerSystem 经计时器轮发出）
     void update(float delta_time);
 
 private:
+    void onPassiveRosterChanged(entt::registry& registry, entt::entity entity);
+    /// @brief 重新汇总在场被动技能的回费
+    void refreshPassiveRegen(const game::factory::BlueprintManager& blueprint_manager, game::data::GameStats& game_stats);
     void onUpgradeHeroEvent(const game::defs::UpgradeHeroEvent& event);
     void onReleaseHeroSkillEvent(const game::defs::ReleaseHeroSkillEvent& event);
     void onSkillReadyEvent(const game::defs::SkillReadyEvent& event);
@@ -30,14 +48,9 @@ private:
 
     void activateSkill(entt::entity entity,
                        game::component::HeroSkillComponent& skill,
-                       game::component::StatsComponent& stats,
                        const game::data::SkillBlueprint& blueprint);
-    void deactivateSkill(entt::entity entity,
-                         game::component::HeroSkillComponent& skill,
-                         game::component::StatsComponent& stats);
-    void applyUpgrade(entt::entity entity,
-                      game::component::HeroSkillComponent* skill,
-                      game::component::StatsComponent& stats);
+    void deactivateSkill(entt::entity entity, game::component::HeroSkillComponent& skill);
+    void applyUpgrade(entt::entity entity, game::component::StatsComponent& stats);
 };
 
 } // namespace game::system
@@ -2,9 +2,12 @@
 #include "engine/component/transform_component.h"
 #include "engine/component/sprite_component.h"
 #include "engine/component/velocity_component.h"
+#include "engine/component/disabled_tag.h"
+#include "engine/component/low_detail_tag.h"
 #include "game/component/target_component.h"
 #include "game/component/blocked_by_component.h"
 #include "game/defs/tags.h"
+#include <cmath>
 
 namespace game::system {
 
@@ -13,51 +16,39 @@ using namespace game::component;
 using namespace game::defs;
 
 void OrientationSystem::update(entt::registry& registry) {
-    auto view = registry.view<SpriteComponent, TransformComponent>();
-
-    for (auto entity : view) {
-        auto& sprite = view.get<SpriteComponent>(entity).sprite_;
-        auto& pos = view.get<TransformComponent>(entity).position_;
-        
-        bool face_left = false;
-        bool has_priority_target = false;
-
-        // 1. 如果有锁定目标，面朝目标
-        if (auto* target = registry.try_get<TargetComponent>(entity); target && registry.valid(target->entity_)) {
-            if (auto* target_transform = registry.try_get<TransformComponent>(target->entity_)) {
-                face_left = (target_transform->position_.x < pos.x);
-                has_priority_target = true;
-            }
-        }
-
-        // 2. 如果被阻挡，面朝阻挡者 (仅当没有锁定目标时)
-        if (!has_priority_target) {
-            if (auto* blocked = registry.try_get<BlockedByComponent>(entity); blocked && registry.valid(blocked->entity_)) {
-                if (auto* blocker_transform = registry.try_get<TransformComponent>(blocked->entity_)) {
-                    face_left = (blocker_transform->position_.x < pos.x);
-                    has_priority_target = true;
-                }
-            }
+    const auto& face_left_tags = registry.storage<FaceLeftTag>();
+    // 跟随目标 / 阻挡者链接：直接查 Transform 的存储（contains() 含版本比较），不再经注册表逐次查找存储
+    const auto& transforms = registry.storage<TransformComponent>();
+    // 应用 FaceLeftTag 修正 (如果素材默认朝左，则翻转逻辑反过来)
+    const auto apply = [&face_left_tags](entt::entity entity, SpriteComponent& sprite, bool face_left) {
+        sprite.sprite_.is_flipped_ = face_left_tags.contains(entity) ? !face_left : face_left;
+    };
+
+    // 1. 如果有锁定目标，面朝目标
+    // （非空目标由 SetTargetSystem 保证存活且带 TransformComponent；置空的目标下一次 SetTargetSystem 更新时移除）
+    auto targeting = registry.view<OrientableTag, TargetComponent, SpriteComponent, TransformComponent>(
+        entt::exclude<DisabledTag>);
+    for (auto [entity, target, sprite, transform] : targeting.each()) {
+        if (target.entity_ != entt::null) {
+            apply(entity, sprite, transforms.get(target.entity_).position_.x < transform.position_.x);
         }
+    }
 
-        // 3. 否则，如果是移动中的实体，面朝移动方向
-        if (!has_priority_target) {
-            if (auto* vel = registry.try_get<VelocityComponent>(entity)) {
-                if (std::abs(vel->velocity_.x) > 0.1f) {
-                    face_left = (vel->velocity_.x < 0.0f);
-                } else {
-                    continue;
-                }
-            } else {
-                continue;
-            }
+    // 2. 如果被阻挡，面朝阻挡者 (仅当没有锁定目标时)
+    auto blocked_view = registry.view<OrientableTag, BlockedByComponent, SpriteComponent, TransformComponent>(
+        entt::exclude<TargetComponent, DisabledTag>);
+    for (auto [entity, blocked, sprite, transform] : blocked_view.each()) {
+        if (transforms.contains(blocked.entity_)) {
+            apply(entity, sprite, transforms.get(blocked.entity_).position_.x < transform.position_.x);
         }
+    }
 
-        // 应用 FaceLeftTag 修正 (如果素材默认朝左，则翻转逻辑反过来)
-        if (registry.all_of<FaceLeftTag>(entity)) {
-            sprite.is_flipped_ = !face_left;
-        } else {
-            sprite.is_flipped_ = face_left;
+    // 3. 否则，如果是移动中的实体，面朝移动方向（低细节的敌人在屏幕外，恢复完整模拟后再转向）
+    auto moving = registry.view<OrientableTag, VelocityComponent, SpriteComponent>(
+        entt::exclude<TargetComponent, BlockedByComponent, DisabledTag, LowDetailTag>);
+    for (auto [entity, velocity, sprite] : moving.each()) {
+        if (std::abs(velocity.velocity_.x) > 0.1f) {
+            apply(entity, sprite, velocity.velocity_.x < 0.0f);
         }
     }
 }
@@ -9,7 +9,8 @@ namespace game::system {
  * @brief 朝向系统，负责根据目标位置或移动方向调整实体的翻转状态。
  * 
  * @details
- * 优先级处理规则：
+ * 只处理带 OrientableTag 的实体（EntityFactory 为战斗单位添加），瓦片与装饰物不参与。
+ * 优先级处理规则，每条规则对应一个视图，后两个视图用 exclude 排除前面规则已处理的实体：
  * 1. 如果有锁定目标（TargetComponent），面朝目标。
  * 2. 如果被阻挡（BlockedByComponent），面朝阻挡者。
  * 3. 否则，如果是移动中的敌人，面朝移动方向。
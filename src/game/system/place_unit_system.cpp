@@ -5,6 +5,7 @@
 #include "../component/player_component.h"
 #include "../component/stats_component.h"
 #include "../data/game_stats.h"
+#include "../data/selection_state.h"
 #include "../defs/event.h"
 #include "../defs/tags.h"
 #include "../factory/entity_factory.h"
@@ -12,16 +13,34 @@
 #include "../../engine/component/transform_component.h"
 #include "../../engine/component/sprite_component.h"
 #include "../../engine/core/context.h"
+#include "../../engine/spatial/flow_field.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/audio/audio_locator.h"
 #include "../../engine/utils/logging.h"
 #include <algorithm>
-#include <limits>
 
 using namespace entt::literals;
 
 namespace game::system {
 
+namespace {
+/// @brief 流场导航的关卡中，被占用建造位所在格子提高权重（敌人绕行但道路不会被封死），空出时恢复
+void updatePlaceFlowCost(entt::registry& registry, entt::entity place_entity, bool occupied) {
+    auto* flow_field = registry.ctx().find<engine::spatial::FlowField>();
+    const auto* transform = registry.try_get<engine::component::TransformComponent>(place_entity);
+    if (!flow_field || !flow_field->isBuilt() || !transform) {
+        return;
+    }
+    const auto* sprite = registry.try_get<engine::component::SpriteComponent>(place_entity);
+    const int cell = flow_field->cellAt(transform->position_ + (sprite ? sprite->size_ * 0.5f : glm::vec2{ 32.0f, 32.0f }));
+    if (occupied) {
+        flow_field->setCellCost(cell, std::max(flow_field->getCellCost(cell), game::defs::FLOW_FIELD_OCCUPIED_COST));
+    } else {
+        flow_field->resetCellCost(cell);
+    }
+}
+} // namespace
+
 PlaceUnitSystem::PlaceUnitSystem(entt::registry& registry,
                                  entt::dispatcher& dispatcher,
                                  engine::core::Context& context,
@@ -57,8 +76,10 @@ void PlaceUnitSystem::update(float) {
         return;
     }
 
-    const auto mouse_world = context_.getCamera().screenToWorld(context_.getInputManager().getLogicalMousePosition());
-    transform->position_ = mouse_world;
+    const auto mouse_world = mouseWorld();
+    // 经 patch 写入，发出 on_update 信号（YSortSystem 据此重算排序索引）
+    registry_.patch<engine::component::TransformComponent>(active_prep_entity_,
+        [&mouse_world](auto& value) { value.position_ = mouse_world; });
     target_place_entity_ = findNearestPlace(mouse_world, prep->type_);
     render->color_ = target_place_entity_ != entt::null
         ? engine::utils::FColor{ 0.32f, 1.0f, 0.32f, 1.0f }
@@ -68,7 +89,7 @@ void PlaceUnitSystem::update(float) {
 void PlaceUnitSystem::onPrepUnitEvent(const game::defs::PrepUnitEvent& event) {
     clearActivePrep();
 
-    const auto mouse_world = context_.getCamera().screenToWorld(context_.getInputManager().getLogicalMousePosition());
+    const auto mouse_world = mouseWorld();
     active_prep_entity_ = entity_factory_.createUnitPrep(event.name_id_, event.class_id_, mouse_world, event.cost_, event.level_, event.rarity_);
     if (!registry_.valid(active_prep_entity_)) {
         active_prep_entity_ = entt::null;
@@ -76,6 +97,7 @@ void PlaceUnitSystem::onPrepUnitEvent(const game::defs::PrepUnitEvent& event) {
         return;
     }
 
+    context_.getInputManager().markCommand();
     ENGINE_LOG_INFO("进入出击准备: name_id={}, class_id={}, cost={}", event.name_id_, event.class_id_, event.cost_);
 }
 
@@ -84,8 +106,6 @@ void PlaceUnitSystem::onRemovePlayerUnitEvent(const game::defs::RemovePlayerUnit
         return;
     }
 
-    removePlaceOccupancy(event.entity_);
-
     if (event.entity_ == active_prep_entity_) {
         clearActivePrep();
     }
@@ -101,9 +121,8 @@ bool PlaceUnitSystem::onPlaceUnit() {
     }
 
     auto* prep = registry_.try_get<game::component::UnitPrepComponent>(active_prep_entity_);
-    auto* place_transform = registry_.try_get<engine::component::TransformComponent>(target_place_entity_);
-    const auto* place_sprite = registry_.try_get<engine::component::SpriteComponent>(target_place_entity_);
-    if (!prep || !place_transform) {
+    glm::vec2 place_center{ 0.0f, 0.0f };
+    if (!prep || !placement_index_.getCenter(target_place_entity_, place_center)) {
         return false;
     }
 
@@ -111,47 +130,96 @@ bool PlaceUnitSystem::onPlaceUnit() {
         return false;
     }
 
+    if (deferred_placement_) {
+        // 金币在指令执行时才扣除，这里只做提示性检查；两名玩家同时花钱时以执行顺序为准
+        if (registry_.ctx().contains<game::data::GameStats&>()) {
+            const auto& game_stats = registry_.ctx().get<game::data::GameStats&>();
+            if (game_stats.cost_ < static_cast<float>(prep->cost_)) {
+                ENGINE_LOG_WARN("放置英雄金币不足: current={}, need={}", static_cast<int>(game_stats.cost_), prep->cost_);
+                return false;
+            }
+        }
+        dispatcher_.trigger(game::defs::PlaceUnitRequestEvent{ prep->class_id_, place_center, prep->cost_, prep->level_, prep->rarity_ });
+    } else if (placeOn(target_place_entity_, place_center, prep->class_id_, prep->cost_, prep->level_, prep->rarity_) == entt::null) {
+        return false;
+    }
+    if (!deferred_placement_) {
+        context_.getInputManager().markCommand();   // 单位已在输入回调中创建，本帧 render 可见
+    }
+
+    dispatcher_.enqueue(game::defs::RemoveUIPortraitEvent{ prep->name_id_ });
+    dispatcher_.enqueue(game::defs::RemovePlayerUnitEvent{ active_prep_entity_ });
+    ENGINE_LOG_INFO("出击确认: name_id={}, cost={}{}", prep->name_id_, prep->cost_, deferred_placement_ ? "（等待锁步执行）" : "");
+    clearActivePrep();
+    return true;
+}
+
+entt::entity PlaceUnitSystem::placeUnitAt(entt::id_type class_id, const glm::vec2& position, int cost, int level, int rarity) {
+    if (!registry_.ctx().contains<std::shared_ptr<game::factory::BlueprintManager>>()) {
+        ENGINE_LOG_WARN("放置英雄失败: BlueprintManager 上下文不存在");
+        return entt::null;
+    }
+    const auto& blueprints = registry_.ctx().get<std::shared_ptr<game::factory::BlueprintManager>>();
+    const auto index = blueprints->findPlayerClass(class_id);
+    if (index == game::factory::INVALID_CLASS_INDEX) {
+        ENGINE_LOG_WARN("放置英雄失败: 未知职业 class_id={}", class_id);
+        return entt::null;
+    }
+    // 建造位中心由地图确定，两端完全相同；最近的空闲建造位不在这里说明已被先执行的指令占用
+    const auto place_entity = findNearestPlace(position, blueprints->getPlayerClassAt(index).player_.type_);
+    glm::vec2 place_center{ 0.0f, 0.0f };
+    if (place_entity == entt::null || !placement_index_.getCenter(place_entity, place_center) || place_center != position) {
+        ENGINE_LOG_WARN("放置英雄失败: ({}, {}) 没有空闲建造位", position.x, position.y);
+        return entt::null;
+    }
+    // 本地正在准备的单位恰好瞄准这个建造位时改为重新寻找
+    if (place_entity == target_place_entity_) {
+        target_place_entity_ = entt::null;
+    }
+    return placeOn(place_entity, place_center, class_id, cost, level, rarity);
+}
+
+entt::entity PlaceUnitSystem::placeOn(entt::entity place_entity, const glm::vec2& place_center, entt::id_type class_id, int cost, int level, int rarity) {
     if (!registry_.ctx().contains<game::data::GameStats&>()) {
         ENGINE_LOG_WARN("放置英雄失败: GameStats 上下文不存在");
-        return false;
+        return entt::null;
     }
     auto& game_stats = registry_.ctx().get<game::data::GameStats&>();
-    if (game_stats.cost_ < static_cast<float>(prep->cost_)) {
-        ENGINE_LOG_WARN("放置英雄金币不足: current={}, need={}", static_cast<int>(game_stats.cost_), prep->cost_);
-        return false;
+    if (game_stats.cost_ < static_cast<float>(cost)) {
+        ENGINE_LOG_WARN("放置英雄金币不足: current={}, need={}", static_cast<int>(game_stats.cost_), cost);
+        return entt::null;
     }
 
-    game_stats.cost_ -= static_cast<float>(prep->cost_);
+    game_stats.cost_ -= static_cast<float>(cost);
 
-    const glm::vec2 place_center = place_transform->position_ + (place_sprite ? (place_sprite->size_ * 0.5f) : glm::vec2{ 32.0f, 32.0f });
-    const auto player_entity = entity_factory_.createPlayerUnit(prep->class_id_, place_center, prep->level_, prep->rarity_);
+    const auto player_entity = entity_factory_.createPlayerUnit(class_id, place_center, level, rarity);
     if (player_entity == entt::null) {
-        game_stats.cost_ += static_cast<float>(prep->cost_);
-        return false;
+        game_stats.cost_ += static_cast<float>(cost);
+        return entt::null;
     }
 
-    auto& occupied = registry_.emplace_or_replace<game::component::PlaceOccupiedComponent>(target_place_entity_);
+    auto& occupied = registry_.emplace_or_replace<game::component::PlaceOccupiedComponent>(place_entity);
     occupied.occupied_by_ = player_entity;
+    updatePlaceFlowCost(registry_, place_entity, true);
+    placement_index_.occupy(place_entity, player_entity);
 
-    if (const auto* place_render = registry_.try_get<engine::component::RenderComponent>(target_place_entity_)) {
+    if (const auto* place_render = registry_.try_get<engine::component::RenderComponent>(place_entity)) {
         if (auto* player_render = registry_.try_get<engine::component::RenderComponent>(player_entity)) {
-            player_render->layer_index_ = place_render->layer_index_ + 1;
+            player_render->setLayerIndex(place_render->getLayerIndex() + 1);
         }
     }
 
-    dispatcher_.enqueue(game::defs::RemoveUIPortraitEvent{ prep->name_id_ });
-    dispatcher_.enqueue(game::defs::RemovePlayerUnitEvent{ active_prep_entity_ });
+    dispatcher_.trigger(game::defs::UnitPlacedEvent{ player_entity, class_id, place_center, cost, level, rarity });
 
     engine::audio::AudioLocator::get().playSound(entt::hashed_string("unit_placed").value());
 
-    ENGINE_LOG_INFO("出击确认成功: name_id={}, cost={}, remaining_gold={}, place_entity={}, player_entity={}",
-                    prep->name_id_,
-                    prep->cost_,
+    ENGINE_LOG_INFO("放置英雄成功: class_id={}, cost={}, remaining_gold={}, place_entity={}, player_entity={}",
+                    class_id,
+                    cost,
                     static_cast<int>(game_stats.cost_),
-                    entt::to_integral(target_place_entity_),
+                    entt::to_integral(place_entity),
                     entt::to_integral(player_entity));
-    clearActivePrep();
-    return true;
+    return player_entity;
 }
 
 bool PlaceUnitSystem::onCancelPrepUnit() {
@@ -165,47 +233,19 @@ bool PlaceUnitSystem::onCancelPrepUnit() {
     return true;
 }
 
-entt::entity PlaceUnitSystem::findNearestPlace(const glm::vec2& mouse_world, game::defs::PlayerType type) const {
-    entt::entity nearest = entt::null;
-    float best_distance_sq = std::numeric_limits<float>::max();
+glm::vec2 PlaceUnitSystem::mouseWorld() const {
+    // SelectionSystem 每帧换算一次；尚未换算（场景没有选择状态）时自行换算
+    if (const auto* selection = registry_.ctx().find<game::data::SelectionState>()) {
+        return selection->mouse_world_;
+    }
+    return context_.getCamera().screenToWorld(context_.getInputManager().getLogicalMousePosition());
+}
 
-    auto consider_place = [&](auto view) {
-        for (auto entity : view) {
-            if (registry_.all_of<game::component::PlaceOccupiedComponent>(entity)) {
-                continue;
-            }
-            const auto* transform = registry_.try_get<engine::component::TransformComponent>(entity);
-            const auto* sprite = registry_.try_get<engine::component::SpriteComponent>(entity);
-            if (!transform) {
-                continue;
-            }
-            const glm::vec2 place_center = transform->position_ + (sprite ? (sprite->size_ * 0.5f) : glm::vec2{ 32.0f, 32.0f });
-            const float distance_sq = engine::utils::distanceSquared(mouse_world, place_center);
-            if (distance_sq > game::defs::PLACE_RADIUS * game::defs::PLACE_RADIUS) {
-                continue;
-            }
-            if (distance_sq < best_distance_sq) {
-                best_distance_sq = distance_sq;
-                nearest = entity;
-            }
-        }
-    };
-
-    switch (type) {
-    case game::defs::PlayerType::MELEE:
-        consider_place(registry_.view<game::defs::MeleePlaceTag, engine::component::TransformComponent>());
-        break;
-    case game::defs::PlayerType::RANGED:
-        consider_place(registry_.view<game::defs::RangePlaceTag, engine::component::TransformComponent>());
-        break;
-    case game::defs::PlayerType::MIXED:
-    default:
-        consider_place(registry_.view<game::defs::MeleePlaceTag, engine::component::TransformComponent>());
-        consider_place(registry_.view<game::defs::RangePlaceTag, engine::component::TransformComponent>());
-        break;
-    }
-
-    return nearest;
+entt::entity PlaceUnitSystem::findNearestPlace(const glm::vec2& mouse_world, game::defs::PlayerType type) {
+    if (!placement_index_.isBuilt()) {
+        placement_index_.rebuild(registry_);
+    }
+    return placement_index_.findNearest(mouse_world, type);
 }
 
 void PlaceUnitSystem::clearActivePrep() {
@@ -218,14 +258,27 @@ void PlaceUnitSystem::clearActivePrep() {
     target_place_entity_ = entt::null;
 }
 
-void PlaceUnitSystem::removePlaceOccupancy(entt::entity unit_entity) {
-    auto view = registry_.view<game::component::PlaceOccupiedComponent>();
-    for (auto place_entity : view) {
-        auto& occupied = view.get<game::component::PlaceOccupiedComponent>(place_entity);
-        if (occupied.occupied_by_ == unit_entity) {
-            registry_.remove<game::component::PlaceOccupiedComponent>(place_entity);
-            break;
+void PlaceUnitSystem::cancelPrep() {
+    for (auto entity : registry_.view<game::component::UnitPrepComponent>(entt::exclude<game::defs::DeadTag>)) {
+        registry_.emplace<game::defs::DeadTag>(entity);
+    }
+    active_prep_entity_ = entt::null;
+    target_place_entity_ = entt::null;
+    placement_index_.rebuild(registry_);
+}
+
+void PlaceUnitSystem::onEntitiesDestroyed(entt::registry& registry, std::span<const entt::entity> entities) {
+    if (!placement_index_.isBuilt()) {
+        placement_index_.rebuild(registry);
+    }
+    // 每个死亡实体查一次占用者映射，不遍历建造位
+    for (const auto entity : entities) {
+        const auto place_entity = placement_index_.release(entity);
+        if (place_entity == entt::null || !registry.valid(place_entity)) {
+            continue;
         }
+        registry.remove<game::component::PlaceOccupiedComponent>(place_entity);
+        updatePlaceFlowCost(registry, place_entity, false);
     }
 }
 
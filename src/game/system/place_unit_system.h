@@ -3,12 +3,14 @@
 #include <entt/entt.hpp>
 #include <entt/core/hashed_string.hpp>
 #include <glm/vec2.hpp>
+#include <span>
 
 #include "../defs/event.h"
 #include "../defs/tags.h"
 #include "../defs/constants.h"
 #include "../component/unit_prep_component.h"
 #include "../component/place_occupied_component.h"
+#include "../data/placement_index.h"
 
 namespace engine::core {
     class Context;
@@ -29,6 +31,10 @@ private:
 
     entt::entity active_prep_entity_{ entt::null };
     entt::entity target_place_entity_{ entt::null };
+    bool deferred_placement_{ false };
+
+    // 空闲建造位的网格索引；关卡加载后首次使用时建立，恢复快照后重建
+    game::data::PlacementIndex placement_index_;
 
 public:
     PlaceUnitSystem(entt::registry& registry,
@@ -39,14 +45,35 @@ public:
 
     void update(float delta_time);
 
+    /// @brief RemoveDeadSystem 批量收尾：按占用者查找并释放被整批死亡单位占用的建造位
+    void onEntitiesDestroyed(entt::registry& registry, std::span<const entt::entity> entities);
+
+    /// @brief 放弃进行中的出击准备（含注册表快照带回的准备实体）并按注册表重建建造位索引，恢复快照后调用
+    void cancelPrep();
+
+    /// @brief 锁步联机时开启：确认出击只发出 PlaceUnitRequestEvent，实际放置由 placeUnitAt() 在约定的模拟步执行
+    void setDeferredPlacement(bool deferred) { deferred_placement_ = deferred; }
+
+    /// @brief 跟随鼠标的准备实体，没有进行中的出击准备时为 entt::null
+    [[nodiscard]] entt::entity getActivePrep() const { return active_prep_entity_; }
+
+    /**
+     * @brief 在中心为 position 的空闲建造位上放置单位并扣除金币（锁步指令的执行端）
+     * @return 放置的单位；该处没有空闲建造位、金币不足或创建失败时为 entt::null
+     */
+    entt::entity placeUnitAt(entt::id_type class_id, const glm::vec2& position, int cost, int level, int rarity);
+
 private:
     void onPrepUnitEvent(const game::defs::PrepUnitEvent& event);
     void onRemovePlayerUnitEvent(const game::defs::RemovePlayerUnitEvent& event);
     bool onPlaceUnit();
+    /// @brief 在建造位上创建单位、扣除金币并登记占用，成功时 trigger UnitPlacedEvent
+    entt::entity placeOn(entt::entity place_entity, const glm::vec2& place_center, entt::id_type class_id, int cost, int level, int rarity);
     bool onCancelPrepUnit();
-    entt::entity findNearestPlace(const glm::vec2& mouse_world, game::defs::PlayerType type) const;
+    /// @brief 本帧鼠标的世界坐标
+    glm::vec2 mouseWorld() const;
+    entt::entity findNearestPlace(const glm::vec2& mouse_world, game::defs::PlayerType type);
     void clearActivePrep();
-    void removePlaceOccupancy(entt::entity unit_entity);
 };
 
 } // namespace game::system
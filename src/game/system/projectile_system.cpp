@@ -0,0 +1,165 @@
+#include "projectile_system.h"
+
+#include "../data/projectile_pool.h"
+#include "../defs/constants.h"
+#include "../defs/tags.h"
+#include "../factory/blueprint_manager.h"
+#include "../factory/entity_factory.h"
+#include "../../engine/component/disabled_tag.h"
+#include "../../engine/component/transform_component.h"
+#include "../../engine/component/velocity_component.h"
+#include "../../engine/ecs/event_queues.h"
+#include "../../engine/spatial/spatial_grid.h"
+#include "../../engine/utils/profiler.h"
+#include <entt/entity/registry.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace game::system {
+
+namespace {
+constexpr float LAUNCH_OFFSET = 24.0f;          ///< 发射点相对攻击者的前移距离（与立即命中的视觉一致）
+constexpr float VISUAL_MARGIN = 0.1f;           ///< 视觉实体比模拟多飞的时间，保证总是由模拟先停用
+}
+
+ProjectileSystem::ProjectileSystem(entt::registry& registry, engine::ecs::EventQueues& event_queues,
+                                   game::factory::EntityFactory* entity_factory)
+    : registry_(registry), event_queues_(event_queues), entity_factory_(entity_factory) {
+    event_queues_.sink<game::defs::LaunchProjectileEvent>().connect<&ProjectileSystem::onLaunchProjectileEvents>(this);
+}
+
+ProjectileSystem::~ProjectileSystem() {
+    event_queues_.disconnect(this);
+}
+
+void ProjectileSystem::registerKinds(game::data::ProjectilePool& pool, const game::factory::BlueprintManager& blueprint_manager) {
+    std::size_t capacity = 0;
+    for (const auto& [projectile_id, blueprint] : blueprint_manager.getProjectileBlueprints()) {
+        if (!blueprint.simulated_) {
+            continue;
+        }
+        pool.registerKind(projectile_id, { blueprint.speed_, blueprint.hit_radius_, blueprint.pierce_, blueprint.lifetime_ });
+        capacity += static_cast<std::size_t>(std::max(blueprint.pool_size_, 0));
+    }
+    pool.reserve(capacity);
+}
+
+void ProjectileSystem::onLaunchProjectileEvents(std::span<const game::defs::LaunchProjectileEvent> events) {
+    auto* pool = registry_.ctx().find<game::data::ProjectilePool>();
+    if (!pool) {
+        return;
+    }
+    for (const auto& event : events) {
+        const auto* kind = pool->findKind(event.projectile_id_);
+        if (!kind || !registry_.valid(event.attacker_entity_) || !registry_.valid(event.target_entity_)) {
+            continue;
+        }
+        const auto* from = registry_.try_get<engine::component::TransformComponent>(event.attacker_entity_);
+        const auto* to = registry_.try_get<engine::component::TransformComponent>(event.target_entity_);
+        if (!from || !to) {
+            continue;
+        }
+
+        // 按飞到目标当前位置所需的时间取提前量
+        glm::vec2 aim = to->position_;
+        if (const auto* velocity = registry_.try_get<engine::component::VelocityComponent>(event.target_entity_)) {
+            const glm::vec2 delta = to->position_ - from->position_;
+            const float travel_time = std::sqrt(delta.x * delta.x + delta.y * delta.y) / kind->speed_;
+            aim = aim + velocity->velocity_ * travel_time;
+        }
+        const glm::vec2 delta = aim - from->position_;
+        const float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+        const glm::vec2 direction = length > 0.001f ? delta * (1.0f / length) : glm::vec2{ 1.0f, 0.0f };
+
+        game::data::ProjectileLaunch launch;
+        launch.attacker_ = event.attacker_entity_;
+        launch.origin_ = from->position_ + direction * LAUNCH_OFFSET;
+        launch.velocity_ = direction * kind->speed_;
+        launch.damage_ = event.damage_amount_;
+        launch.hit_radius_ = kind->hit_radius_ + game::defs::UNIT_RADIUS;
+        launch.lifetime_ = kind->lifetime_;
+        launch.mask_ = event.mask_;
+        launch.pierce_ = kind->pierce_;
+        if (entity_factory_) {
+            launch.visual_ = entity_factory_->createSimulatedProjectileVisual(
+                event.projectile_id_, launch.origin_, launch.velocity_, kind->lifetime_ + VISUAL_MARGIN);
+        }
+        pool->spawn(launch);
+    }
+}
+
+void ProjectileSystem::update(float delta_time) {
+    auto* pool = registry_.ctx().find<game::data::ProjectilePool>();
+    if (!pool || pool->empty()) {
+        return;
+    }
+    const auto* grid = registry_.ctx().find<engine::spatial::SpatialGrid>();
+
+    pool->integrate(delta_time);
+
+    hits_.clear();
+    std::size_t removed = 0;
+    std::size_t index = 0;
+    while (index < pool->size()) {
+        if (grid) {
+            const glm::vec2 from{ pool->prev_x_[index], pool->prev_y_[index] };
+            const glm::vec2 to{ pool->x_[index], pool->y_[index] };
+            const glm::vec2 segment = to - from;
+            const float length_sq = segment.x * segment.x + segment.y * segment.y;
+            const float inv_length_sq = length_sq > 0.0f ? 1.0f / length_sq : 0.0f;
+            const entt::entity last_hit = pool->last_hit_[index];
+
+            candidates_.clear();
+            grid->forEachInCapsule(from, to, pool->hit_radius_[index], pool->mask_[index],
+                [&](const engine::spatial::SpatialGrid::Entry& entry, float) {
+                    if (entry.entity_ == last_hit) {
+                        return;
+                    }
+                    const glm::vec2 offset = entry.position_ - from;
+                    candidates_.push_back({ (offset.x * segment.x + offset.y * segment.y) * inv_length_sq, entry.entity_ });
+                });
+            if (!candidates_.empty()) {
+                // 沿飞行方向依次命中；t 相同时按实体序号，结果与网格内的存放顺序无关
+                std::sort(candidates_.begin(), candidates_.end(), [](const Candidate& a, const Candidate& b) {
+                    return a.t_ != b.t_ ? a.t_ < b.t_ : a.entity_ < b.entity_;
+                });
+                for (const auto& candidate : candidates_) {
+                    if (!registry_.valid(candidate.entity_) || registry_.all_of<game::defs::DeadTag>(candidate.entity_)) {
+                        continue;
+                    }
+                    hits_.push_back({ pool->attacker_[index], candidate.entity_, pool->damage_[index] });
+                    pool->last_hit_[index] = candidate.entity_;
+                    if (--pool->pierce_[index] < 0) {
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (pool->pierce_[index] < 0 || pool->life_[index] <= 0.0f) {
+            disableVisual(pool->visual_[index]);
+            pool->remove(index);    // 末尾的投射物换到 index，不前进
+            ++removed;
+            continue;
+        }
+        ++index;
+    }
+
+    for (const auto& hit : hits_) {
+        event_queues_.enqueue(hit);
+    }
+
+    ENGINE_PROFILE_COUNTER("projectile.active", static_cast<std::int64_t>(pool->size()));
+    ENGINE_PROFILE_COUNTER("projectile.hits", static_cast<std::int64_t>(hits_.size()));
+    ENGINE_PROFILE_COUNTER("projectile.removed", static_cast<std::int64_t>(removed));
+}
+
+void ProjectileSystem::disableVisual(entt::entity visual) {
+    if (visual == entt::null || !registry_.valid(visual) || registry_.all_of<engine::component::DisabledTag>(visual)) {
+        return;
+    }
+    registry_.emplace<engine::component::DisabledTag>(visual);
+}
+
+} // namespace game::system
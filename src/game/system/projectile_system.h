@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../defs/event.h"
+#include <entt/entity/fwd.hpp>
+#include <span>
+#include <vector>
+
+namespace engine::ecs {
+    class EventQueues;
+}
+
+namespace game::data {
+    class ProjectilePool;
+}
+
+namespace game::factory {
+    class BlueprintManager;
+    class EntityFactory;
+}
+
+namespace game::system {
+
+/**
+ * @class ProjectileSystem
+ * @brief 模拟投射物：在 ProjectilePool 中逐步飞行，用本步扫过的线段判定命中。
+ *
+ * @details
+ * 投射物蓝图带 "simulated" 字段时，AnimationEventsSystem 不再在出手时立即命中，而是发出 LaunchProjectileEvent。
+ * 本系统在事件通道 flush 时把本批发射写入 ProjectilePool（瞄准目标按其速度的提前量），
+ * 并从视觉池取一个直线飞行的视觉实体；投射物本身不是注册表实体。
+ *
+ * update() 在 SpatialIndexSystem 之后执行：
+ * - ProjectilePool::integrate() 一次顺序扫描推进全部投射物
+ * - 每枚投射物用上一位置→当前位置的胶囊体（半径 = 投射物半径 + UNIT_RADIUS）查询空间网格，
+ *   高速时也不会因一步越过目标而漏判；候选按沿线段的先后排序，穿透的投射物依次命中
+ * - 本步全部命中收集后一次写入 AttackHitEvent 通道，在下一步开头与其他命中一起由 CombatResolveSystem 结算
+ * - 穿透数用尽或飞行时间耗尽的投射物移除，并停用其视觉实体
+ */
+class ProjectileSystem {
+public:
+    /// @param entity_factory 创建视觉实体，为空时只模拟不显示
+    ProjectileSystem(entt::registry& registry, engine::ecs::EventQueues& event_queues, game::factory::EntityFactory* entity_factory);
+    ~ProjectileSystem();
+
+    /// @brief 推进全部投射物并判定命中（dt 为模拟步长）
+    void update(float delta_time);
+
+    /// @brief 按蓝图登记模拟投射物的飞行参数，并按其 pool_size 预留容量
+    static void registerKinds(game::data::ProjectilePool& pool, const game::factory::BlueprintManager& blueprint_manager);
+
+private:
+    /// @brief 沿线段的一个命中候选
+    struct Candidate {
+        float t_;               ///< 在本步线段上的投影位置（0 为上一位置，1 为当前位置）
+        entt::entity entity_;
+    };
+
+    /// @brief 本批发射写入 ProjectilePool
+    void onLaunchProjectileEvents(std::span<const game::defs::LaunchProjectileEvent> events);
+
+    /// @brief 停用投射物的视觉实体（已被视觉系统停用的不重复处理）
+    void disableVisual(entt::entity visual);
+
+    entt::registry& registry_;
+    engine::ecs::EventQueues& event_queues_;
+    game::factory::EntityFactory* entity_factory_{ nullptr };
+    std::vector<Candidate> candidates_;                     ///< 单枚投射物的候选（临时，容量复用）
+    std::vector<game::defs::AttackHitEvent> hits_;          ///< 本步全部命中（临时，容量复用）
+};
+
+} // namespace game::system
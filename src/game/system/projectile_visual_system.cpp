@@ -1,7 +1,8 @@
 #include "projectile_visual_system.h"
 #include "../component/projectile_visual_component.h"
-#include "../defs/tags.h"
+#include "../../engine/component/disabled_tag.h"
 #include "../../engine/component/transform_component.h"
+#include "../../engine/core/job_system.h"
 #include <entt/entity/registry.hpp>
 #include <glm/geometric.hpp>
 #include <glm/common.hpp>
@@ -10,8 +11,9 @@
 namespace game::system {
 
 void ProjectileVisualSystem::update(entt::registry& registry, float delta_time) {
-    auto view = registry.view<game::component::ProjectileVisualComponent, engine::component::TransformComponent>();
-    for (auto entity : view) {
+    auto view = registry.view<game::component::ProjectileVisualComponent, engine::component::TransformComponent>(
+        entt::exclude<engine::component::DisabledTag>);
+    engine::core::parallelEach(registry, view, [&](entt::entity entity, engine::ecs::CommandBuffer& commands) {
         auto& projectile = view.get<game::component::ProjectileVisualComponent>(entity);
         auto& transform = view.get<engine::component::TransformComponent>(entity);
 
@@ -30,8 +32,14 @@ void ProjectileVisualSystem::update(entt::registry& registry, float delta_time)
         transform.rotation_ = glm::degrees(glm::atan(tangent_y, delta.x)) + projectile.rotation_offset_deg_;
 
         if (projectile.elapsed_time_ >= flight_time) {
-            registry.emplace_or_replace<game::defs::DeadTag>(entity);
+            // 停用后由 VisualPool 回收，不销毁实体（池的信号回调不是线程安全的，延迟到遍历结束后执行）
+            commands.emplace<engine::component::DisabledTag>(entity);
         }
+    });
+
+    // 位置在并行遍历中直接写入；信号回调不是线程安全的，遍历结束后统一发出 on_update（供 YSortSystem 增量更新）
+    for (auto entity : view) {
+        registry.patch<engine::component::TransformComponent>(entity);
     }
 }
 
@@ -12,9 +12,8 @@
 
 #include "remove_dead_system.h"
 #include "game/defs/tags.h"
-#include "game/defs/event.h"
-#include <spdlog/spdlog.h>
 #include "../../engine/utils/logging.h"
+#include "../../engine/utils/profiler.h"
 
 /**
  * @brief 更新系统，清理标记为死亡的实体
@@ -22,17 +21,16 @@
  * 
  * @details
  * 该方法实现了死亡实体的清理逻辑：
- * 1. 查询所有带有 DeadTag 的实体
- * 2. 遍历这些实体
- * 3. 从注册表中删除每个实体
- * 4. 记录删除结果
+ * 1. 收集所有带有 DeadTag 的实体
+ * 2. 发布批量收尾信号，各系统对整批实体一次性处理
+ * 3. 按范围删除整批实体
+ * 4. 记录删除数量，累计值发布为计数器 dead.destroyed（没有要删除的实体时也发布，便于逐帧比较）
  * 
  * @par 执行流程
  * 1. 创建实体视图：registry.view<game::defs::DeadTag>()
- * 2. 遍历视图中的所有实体
- * 3. 获取实体的ID用于日志记录
- * 4. 调用 registry.destroy(entity) 删除实体
- * 5. 记录删除操作
+ * 2. 把视图中的实体复制到 dying_（收尾回调可能增删 DeadTag，不能直接遍历视图）
+ * 3. before_destroy_.publish(registry, dying_)
+ * 4. 调用 registry.destroy(first, last) 删除整批实体
  * 
  * @par 注意事项
  * - 该方法应该在所有其他系统更新之后调用，确保死亡实体的所有逻辑都已处理完毕
@@ -42,16 +40,19 @@
 void game::system::RemoveDeadSystem::update(entt::registry& registry) {
     // 查询所有带有 DeadTag 的实体
     auto view = registry.view<defs::DeadTag>();
-    
-    // 遍历并删除标记为死亡的实体
-    for (auto entity : view) {
-        // 获取实体的ID用于日志记录
-        auto entity_id = static_cast<entt::id_type>(entity);
-        
-        // 从注册表中删除实体
-        registry.destroy(entity);
-        
-        // 记录删除操作
-     ENGINE_LOG_DEBUG("Entity {} destroyed", entity_id);
+    if (view.empty()) {
+        ENGINE_PROFILE_COUNTER("dead.destroyed", static_cast<std::int64_t>(destroyed_total_));
+        return;
     }
+    dying_.assign(view.begin(), view.end());
+
+    // 批量收尾：每个监听者对整批实体只处理一次
+    before_destroy_.publish(registry, std::span<const entt::entity>{ dying_ });
+
+    // 按范围删除整批实体
+    registry.destroy(dying_.begin(), dying_.end());
+    ENGINE_LOG_DEBUG("{} entities destroyed", dying_.size());
+    destroyed_total_ += dying_.size();
+    ENGINE_PROFILE_COUNTER("dead.destroyed", static_cast<std::int64_t>(destroyed_total_));
+    dying_.clear();
 }
@@ -20,9 +20,9 @@
  * 
  * @par 工作原理
  * 1. 其他系统或逻辑在实体应该死亡时，为其添加 DeadTag
- * 2. RemoveDeadSystem 在每帧更新时查询所有带有 DeadTag 的实体
- * 3. 从注册表中删除这些实体
- * 4. 实体的所有组件也会被自动清理
+ * 2. RemoveDeadSystem 在每帧更新时收集所有带有 DeadTag 的实体
+ * 3. 通过 onBeforeDestroy() 把整批实体一次交给各系统做收尾（血条、阻挡计数、建造位占用）
+ * 4. 按范围一次删除这些实体，实体的所有组件也会被自动清理
  * 
  * @see game::defs::DeadTag 死亡标签组件
  * @see entt::registry EnTT 的实体注册表
@@ -30,6 +30,9 @@
 
 #pragma once
 #include <entt/entt.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 namespace game::system {
 
@@ -42,9 +45,9 @@ namespace game::system {
  * 避免了直接删除实体可能导致的各种问题。
  * 
  * @par 系统执行流程
- * 1. 查询所有带有 DeadTag 的实体
- * 2. 遍历这些实体
- * 3. 从注册表中删除每个实体
+ * 1. 把所有带有 DeadTag 的实体收集到复用的缓冲区
+ * 2. 发布 onBeforeDestroy 信号：每个监听者对整批实体只处理一次，保持 O(N)
+ * 3. registry.destroy(first, last) 按范围删除
  * 4. 实体的所有组件会被 EnTT 自动清理
  * 
  * @par 应用场景
@@ -53,24 +56,39 @@ namespace game::system {
  * - 临时实体（如特效、投射物）生命周期结束后
  * - 任何需要从游戏世界中移除的实体
  */
-class RemoveDeadSystem {
+class RemoveDeadSystem final {
 public:
+    /**
+     * @brief 批量收尾入口，监听函数签名为 void(entt::registry&, std::span<const entt::entity>)
+     * @details 在整批销毁之前调用一次，此时实体及其组件仍然有效且都带有 DeadTag。
+     *          监听函数中新标记 DeadTag 的实体留到下一次 update() 删除。
+     * @code
+     * remove_dead_system.onBeforeDestroy().connect<&HealthBarSystem::onEntitiesDestroyed>(health_bar_system);
+     * @endcode
+     */
+    [[nodiscard]] auto onBeforeDestroy() { return entt::sink{ before_destroy_ }; }
+
     /**
      * @brief 更新系统，清理标记为死亡的实体
      * @param registry EnTT 实体注册表，包含所有实体和组件
      * 
      * @details
      * 该方法实现了死亡实体的清理逻辑：
-     * 1. 创建实体视图：registry.view<game::defs::DeadTag>()
-     * 2. 遍历视图中的所有实体
-     * 3. 从注册表中删除每个实体
-     * 4. 记录删除结果
+     * 1. 收集 registry.view<game::defs::DeadTag>() 中的所有实体
+     * 2. 发布 onBeforeDestroy 批量收尾信号
+     * 3. 按范围删除整批实体
+     * 4. 记录删除数量（累计值发布为分析器计数器 dead.destroyed，卡顿日志据此给出每帧删除数）
      * 
      * @par 注意事项
      * - 该系统应该在所有其他系统更新之后运行，确保死亡实体的所有逻辑都已处理完毕
      * - 删除实体时，EnTT 会自动清理实体的所有组件，无需手动处理
      */
     void update(entt::registry& registry);
+
+private:
+    entt::sigh<void(entt::registry&, std::span<const entt::entity>)> before_destroy_;
+    std::vector<entt::entity> dying_;       ///< 本次要删除的实体，容量帧间复用
+    std::uint64_t destroyed_total_{ 0 };    ///< 累计删除的实体数
 };
 
 }   // namespace game::system
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "../component/player_component.h"
 #include "../component/stats_component.h"
 #include "../component/unit_prep_component.h"
+#include "../data/selection_state.h"
 #include "../defs/tags.h"
 #include "../../engine/component/transform_component.h"
 #include "../../engine/render/camera.h"
@@ -10,7 +11,8 @@
 
 namespace game::system {
 
-void RenderRangeSystem::update(entt::registry& registry, engine::render::Renderer& renderer, const engine::render::Camera& camera) {
+void RenderRangeSystem::update(entt::registry& registry, engine::render::Renderer& renderer, const engine::render::Camera& camera,
+                               bool selected_only, const glm::vec2& prep_offset) {
     auto prep_view = registry.view<game::defs::ShowRangeTag, engine::component::TransformComponent, game::component::UnitPrepComponent>();
     for (auto entity : prep_view) {
         const auto& transform = prep_view.get<engine::component::TransformComponent>(entity);
@@ -18,18 +20,27 @@ void RenderRangeSystem::update(entt::registry& registry, engine::render::Rendere
         if (prep.range_ <= 0.0f) {
             continue;
         }
-        renderer.drawFilledCircle(camera, transform.position_, prep.range_, game::defs::RANGE_COLOR);
+        renderer.drawFilledCircle(camera, transform.position_ + prep_offset, prep.range_, game::defs::RANGE_COLOR);
     }
 
+    // 已放置单位：收集圆列表，与上一帧相同（通常如此）时直接合成缓存的遮罩
+    circles_.clear();
     auto selected_view = registry.view<game::defs::ShowRangeTag, engine::component::TransformComponent, game::component::StatsComponent, game::component::PlayerComponent>();
-    for (auto entity : selected_view) {
-        const auto& transform = selected_view.get<engine::component::TransformComponent>(entity);
-        const auto& stats = selected_view.get<game::component::StatsComponent>(entity);
-        if (stats.range_ <= 0.0f) {
-            continue;
+    if (selected_only) {
+        const auto* selection = registry.ctx().find<game::data::SelectionState>();
+        const auto entity = selection ? selection->selected_unit_ : entt::null;
+        if (entity != entt::null && selected_view.contains(entity)) {
+            circles_.push_back({ selected_view.get<engine::component::TransformComponent>(entity).position_,
+                                 selected_view.get<game::component::StatsComponent>(entity).range_ });
+        }
+    } else {
+        for (auto entity : selected_view) {
+            circles_.push_back({ selected_view.get<engine::component::TransformComponent>(entity).position_,
+                                 selected_view.get<game::component::StatsComponent>(entity).range_ });
         }
-        renderer.drawFilledCircle(camera, transform.position_, stats.range_, game::defs::RANGE_COLOR);
     }
+    range_layer_.setCircles(circles_);
+    range_layer_.draw(renderer, camera, game::defs::RANGE_COLOR);
 }
 
 } // namespace game::system
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <entt/entt.hpp>
+#include <glm/vec2.hpp>
+#include <vector>
+#include "../../engine/render/circle_mask_layer.h"
 
 namespace engine::render {
     class Renderer;
@@ -9,12 +12,28 @@ namespace engine::render {
 
 namespace game::system {
 
+/**
+ * @brief 绘制攻击范围
+ *
+ * 放置预览随鼠标移动，每帧直接绘制；已放置单位的范围汇总为一个圆列表交给 CircleMaskLayer，
+ * 只有单位、位置或射程变化时才重建遮罩，重叠的范围以并集一次合成（不会叠加变深）。
+ */
 class RenderRangeSystem final {
 public:
     RenderRangeSystem() = default;
     ~RenderRangeSystem() = default;
 
-    void update(entt::registry& registry, engine::render::Renderer& renderer, const engine::render::Camera& camera);
+    /**
+     * @brief 绘制放置预览与已放置单位的攻击范围
+     * @param selected_only 为 true 时（帧预算降级）已放置单位只绘制当前选中的那一个，放置预览不受影响
+     * @param prep_offset 放置预览范围的晚采样修正（世界坐标，见 RenderSystem::setLateLatchOffset）
+     */
+    void update(entt::registry& registry, engine::render::Renderer& renderer, const engine::render::Camera& camera,
+                bool selected_only = false, const glm::vec2& prep_offset = glm::vec2{ 0.0f });
+
+private:
+    engine::render::CircleMaskLayer range_layer_;                   ///< 已放置单位范围的并集遮罩
+    std::vector<engine::render::CircleMaskLayer::Circle> circles_;  ///< 本帧的范围列表（复用容量）
 };
 
 } // namespace game::system
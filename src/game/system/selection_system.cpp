@@ -8,38 +8,69 @@
 #include "../data/selection_state.h"
 #include "../../engine/component/transform_component.h"
 #include "../../engine/core/context.h"
+#include "../../engine/core/time.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/utils/math.h"
+#include "../../engine/spatial/spatial_grid.h"
 #include <limits>
 
 namespace game::system {
 
 namespace {
+
+using namespace entt::literals;
+
+constexpr entt::id_type MOUSE_LEFT_ACTION = "mouse_left"_hs;
+constexpr entt::id_type MOUSE_RIGHT_ACTION = "mouse_right"_hs;
+
 } // namespace
 
-void SelectionSystem::update(entt::registry& registry, engine::core::Context& context) {
+void SelectionSystem::update(entt::registry& registry, engine::core::Context& context, bool refresh_hover) {
     if (!registry.ctx().contains<game::data::SelectionState>()) {
         return;
     }
 
-    updateHoveredUnit(registry, context);
+    if (refresh_hover) {
+        updateHoveredUnit(registry, context);
+    }
     updateSelectedUnit(registry, context);
 }
 
 void SelectionSystem::updateHoveredUnit(entt::registry& registry, engine::core::Context& context) {
     auto& selection = registry.ctx().get<game::data::SelectionState>();
-    selection.hovered_unit_ = entt::null;
-
     const auto mouse_world = context.getCamera().screenToWorld(context.getInputManager().getLogicalMousePosition());
-    auto view = registry.view<game::component::ClassNameComponent, engine::component::TransformComponent, game::component::StatsComponent>();
+    selection.mouse_world_ = mouse_world;
 
+    // 鼠标不动时：悬停单位仍在原处就沿用；没有悬停单位时只有本帧没有模拟步（单位都没动）才沿用
+    const auto tick = context.getTime().getSimulationTick();
+    if (has_pick_ && mouse_world == picked_mouse_world_) {
+        const auto hovered = selection.hovered_unit_;
+        if (hovered == entt::null) {
+            if (tick == picked_tick_) {
+                return;
+            }
+        } else if (const auto* transform = registry.valid(hovered) ? registry.try_get<engine::component::TransformComponent>(hovered) : nullptr;
+                   transform && transform->position_ == picked_hover_position_) {
+            return;
+        }
+    }
+    has_pick_ = true;
+    picked_mouse_world_ = mouse_world;
+    picked_tick_ = tick;
+
+    const auto& grid = registry.ctx().get<engine::spatial::SpatialGrid>();
+
+    selection.hovered_unit_ = entt::null;
     float best_distance_sq = std::numeric_limits<float>::max();
-    for (auto entity : view) {
-        const auto& transform = view.get<engine::component::TransformComponent>(entity);
-        const auto distance_sq = engine::utils::distanceSquared(mouse_world, transform.position_);
-        if (distance_sq <= game::defs::HOVER_RADIUS * game::defs::HOVER_RADIUS && distance_sq < best_distance_sq) {
+    grid.forEachInRadius(mouse_world, game::defs::HOVER_RADIUS, game::defs::spatial_layer::SELECTABLE, [&](const auto& entry, float distance_sq) {
+        if (distance_sq < best_distance_sq && registry.valid(entry.entity_)) {
             best_distance_sq = distance_sq;
-            selection.hovered_unit_ = entity;
+            selection.hovered_unit_ = entry.entity_;
+        }
+    });
+    if (selection.hovered_unit_ != entt::null) {
+        if (const auto* transform = registry.try_get<engine::component::TransformComponent>(selection.hovered_unit_)) {
+            picked_hover_position_ = transform->position_;
         }
     }
 }
@@ -52,8 +83,8 @@ void SelectionSystem::updateSelectedUnit(entt::registry& registry, engine::core:
         selection.selected_unit_ = entt::null;
     }
 
-    const auto left_pressed = context.getInputManager().isActionPressed(entt::hashed_string("mouse_left").value());
-    const auto right_pressed = context.getInputManager().isActionPressed(entt::hashed_string("mouse_right").value());
+    const auto left_pressed = context.getInputManager().isActionPressed(MOUSE_LEFT_ACTION);
+    const auto right_pressed = context.getInputManager().isActionPressed(MOUSE_RIGHT_ACTION);
     const auto hovered_unit = selection.hovered_unit_;
 
     if (right_pressed) {
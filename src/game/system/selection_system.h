@@ -1,6 +1,8 @@
 #pragma once
 
 #include <entt/entt.hpp>
+#include <glm/vec2.hpp>
+#include <cstdint>
 
 namespace engine::core {
     class Context;
@@ -10,11 +12,19 @@ namespace game::system {
 
 class SelectionSystem final {
 public:
-    void update(entt::registry& registry, engine::core::Context& context);
+    /// @param refresh_hover 是否重新拾取悬停单位（降频时为 false，沿用上一次的结果）
+    void update(entt::registry& registry, engine::core::Context& context, bool refresh_hover = true);
 
 private:
     void updateHoveredUnit(entt::registry& registry, engine::core::Context& context);
     void updateSelectedUnit(entt::registry& registry, engine::core::Context& context);
+
+    // 上一次拾取查询的输入：鼠标世界坐标（含相机移动）未变，且悬停单位未移动时不再查询；
+    // 没有悬停单位时只在没有模拟步（暂停）时沿用，否则走进光标下的单位会被漏掉
+    glm::vec2 picked_mouse_world_{ 0.0f, 0.0f };
+    glm::vec2 picked_hover_position_{ 0.0f, 0.0f };    ///< 悬停单位在拾取时的位置
+    std::uint64_t picked_tick_{ 0 };                    ///< 拾取时的模拟步序号
+    bool has_pick_{ false };
 };
 
 } // namespace game::system
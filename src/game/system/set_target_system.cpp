@@ -1,12 +1,24 @@
 #include "set_target_system.h"
 #include "engine/component/transform_component.h"
+#include "game/component/behavior_component.h"
 #include "game/component/stats_component.h"
 #include "game/component/player_component.h"
 #include "game/component/enemy_component.h"
 #include "game/component/target_component.h"
 #include "game/defs/tags.h"
 #include "game/defs/constants.h"
+#include "game/data/class_cost_profiler.h"
+#include "game/data/injury_queue.h"
+#include "game/data/position_cache.h"
 #include "engine/utils/math.h"
+#include "engine/spatial/spatial_grid.h"
+#include "engine/ecs/command_buffer.h"
+#include "engine/core/job_system.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <limits>
 
 namespace game::system {
 
@@ -15,126 +27,469 @@ using namespace game::component;
 using namespace game::defs;
 using namespace engine::utils;
 
-void SetTargetSystem::update(entt::registry& registry) {
-    updateHasTarget(registry);
-    updateNoTargetPlayer(registry);
-    updateNoTargetEnemy(registry);
-    updateHealer(registry);
+namespace {
+
+/// @brief 网格单元坐标打包为可排序的键
+std::uint64_t cellKey(int x, int y) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
 }
 
-void SetTargetSystem::updateHasTarget(entt::registry& registry) {
-    auto view = registry.view<TransformComponent, StatsComponent, TargetComponent>();
+/// @brief 单位所属的索敌分组：只依赖放置位置，与实体标识无关（回放中实体标识可能不同）
+std::uint32_t acquireBucket(const glm::vec2& position, std::uint32_t buckets) {
+    const auto x = static_cast<std::uint32_t>(static_cast<int>(std::floor(position.x)));
+    const auto y = static_cast<std::uint32_t>(static_cast<int>(std::floor(position.y)));
+    return ((x * 73856093u) ^ (y * 19349663u)) % buckets;
+}
+
+/// @brief 新出现敌人的单元超过该数量时，所有空闲单位本步都搜索（如整波同时刷出）
+constexpr std::size_t WAKE_ALL_CELL_COUNT = 64;
+
+/// @brief 每个有敌人的单元平均超过该数量时视为网格退化（敌人聚成一团），考虑改用快照暴力扫描
+constexpr std::size_t CLUSTERED_ENEMIES_PER_CELL = 16;
+/// @brief 搜索单位数 × 敌人数低于该值时网格查询已足够快，不构建快照
+constexpr std::size_t BRUTE_FORCE_MIN_PAIRS = 16384;
+/// @brief 暴力扫描时每块的搜索单位数
+constexpr std::size_t BRUTE_FORCE_CHUNK = 32;
+/// @brief 暴力扫描每组批量计算距离的敌人数（栈上缓冲）
+constexpr std::size_t SCAN_BLOCK = 256;
+
+/// @brief 候选敌人在给定策略下的分数，越小越优先（各项均直接读取已缓存的组件字段）
+float policyScore(TargetPolicy policy, const EnemyComponent& enemy, const StatsComponent& stats, float distance_sq) {
+    switch (policy) {
+        case TargetPolicy::FIRST_ALONG_PATH: return enemy.distance_to_home_;
+        case TargetPolicy::LOWEST_HP:        return stats.hp_;
+        case TargetPolicy::HIGHEST_THREAT:   return -enemy.threat_;
+        case TargetPolicy::CLOSEST:
+        default:                             return distance_sq;
+    }
+}
+
+} // namespace
+
+SetTargetSystem::SetTargetSystem(entt::registry& registry)
+    : registry_(registry), acquire_buckets_(std::max<std::uint32_t>(TARGET_ACQUIRE_BUCKETS, 1)) {
+    registry_.on_construct<TargetComponent>().connect<&SetTargetSystem::onTargetSet>(this);
+    registry_.on_update<TargetComponent>().connect<&SetTargetSystem::onTargetSet>(this);
+    registry_.on_destroy<TargetComponent>().connect<&SetTargetSystem::onTargetDestroy>(this);
+    registry_.on_construct<DeadTag>().connect<&SetTargetSystem::onTargetGone>(this);
+    registry_.on_destroy<TransformComponent>().connect<&SetTargetSystem::onTargetGone>(this);
+
+    // 接管系统创建前已存在的锁定关系
+    for (auto entity : registry_.view<TargetComponent>()) {
+        onTargetSet(registry_, entity);
+    }
+}
 
+SetTargetSystem::~SetTargetSystem() {
+    registry_.on_construct<TargetComponent>().disconnect(this);
+    registry_.on_update<TargetComponent>().disconnect(this);
+    registry_.on_destroy<TargetComponent>().disconnect(this);
+    registry_.on_construct<DeadTag>().disconnect(this);
+    registry_.on_destroy<TransformComponent>().disconnect(this);
+}
+
+void SetTargetSystem::onTargetSet(entt::registry& registry, entt::entity attacker) {
+    const auto target = registry.get<TargetComponent>(attacker).entity_;
+    if (target == entt::null) {
+        return;
+    }
+    auto& attackers = targeted_by_[target];
+    if (std::ranges::find(attackers, attacker) == attackers.end()) {
+        attackers.push_back(attacker);
+    }
+}
+
+void SetTargetSystem::onTargetDestroy(entt::registry& registry, entt::entity attacker) {
+    const auto target = registry.get<TargetComponent>(attacker).entity_;
+    if (auto it = targeted_by_.find(target); it != targeted_by_.end()) {
+        std::erase(it->second, attacker);
+        if (it->second.empty()) {
+            targeted_by_.erase(it);
+        }
+    }
+}
+
+void SetTargetSystem::onTargetGone(entt::registry& registry, entt::entity target) {
+    auto it = targeted_by_.find(target);
+    if (it == targeted_by_.end()) {
+        return;
+    }
+    // 只改组件的值，不做结构性修改：回调可能发生在其他系统遍历视图期间
+    for (auto attacker : it->second) {
+        if (!registry.valid(attacker)) {
+            continue;
+        }
+        if (auto* component = registry.try_get<TargetComponent>(attacker); component && component->entity_ == target) {
+            component->entity_ = entt::null;
+            invalidated_.push_back(attacker);
+        }
+    }
+    targeted_by_.erase(it);
+}
+
+void SetTargetSystem::update(entt::registry& registry, engine::ecs::CommandBuffer& commands) {
+    updateHasTarget(registry, commands);
+    // 阶段同步点：失去目标的单位需要在本帧重新索敌
+    commands.apply(registry);
+    updateNoTargetPlayer(registry, commands);
+    updateNoTargetEnemy(registry, commands);
+    updateHealer(registry, commands);
+}
+
+void SetTargetSystem::updateHasTarget(entt::registry& registry, engine::ecs::CommandBuffer& commands) {
+    // 1. 目标已死亡或被销毁：信号回调中已置空，这里只移除组件
+    for (auto attacker : invalidated_) {
+        if (!registry.valid(attacker)) {
+            continue;
+        }
+        if (auto* target = registry.try_get<TargetComponent>(attacker); target && target->entity_ == entt::null) {
+            commands.remove<TargetComponent>(attacker);
+        }
+    }
+    invalidated_.clear();
+
+    // 2. 校验距离（非空目标必然存活且带 TransformComponent，直接取目标的存储，不再经注册表查找存储与校验实体）
+    const auto& transforms = registry.storage<TransformComponent>();
+    auto view = registry.view<TransformComponent, StatsComponent, TargetComponent>();
     for (auto entity : view) {
         auto& target = view.get<TargetComponent>(entity);
-        
-        // 1. 校验目标是否仍然有效
-        if (!registry.valid(target.entity_)) {
-            registry.remove<TargetComponent>(entity);
+        if (target.entity_ == entt::null) {
+            continue;   // 已在第 1 步移除
+        }
+
+        const auto& self_pos = view.get<TransformComponent>(entity).position_;
+        const auto& target_pos = transforms.get(target.entity_).position_;
+
+        // 迟滞：双方位移都未超过余量的一半，距离不可能越过射程边界
+        if (distanceSquared(self_pos, target.self_anchor_) <= target.slack_sq_ &&
+            distanceSquared(target_pos, target.target_anchor_) <= target.slack_sq_) {
             continue;
         }
 
-        // 2. 校验距离
-        auto& self_pos = view.get<TransformComponent>(entity).position_;
-        if (!registry.all_of<TransformComponent>(target.entity_)) {
-             registry.remove<TargetComponent>(entity);
-             continue;
+        const float range_radius = view.get<StatsComponent>(entity).range_ + UNIT_RADIUS;
+        const float distance_sq = distanceSquared(self_pos, target_pos);
+        if (distance_sq > range_radius * range_radius) {
+            commands.remove<TargetComponent>(entity);
+            continue;
         }
-        auto& target_pos = registry.get<TransformComponent>(target.entity_).position_;
-        auto& stats = view.get<StatsComponent>(entity);
+        const float slack = (range_radius - std::sqrt(distance_sq)) * 0.5f;
+        target.self_anchor_ = self_pos;
+        target.target_anchor_ = target_pos;
+        target.slack_sq_ = slack * slack;
+    }
+}
 
-        float range_radius = stats.range_ + UNIT_RADIUS;
-        if (distanceSquared(self_pos, target_pos) > range_radius * range_radius) {
-            registry.remove<TargetComponent>(entity);
+void SetTargetSystem::resetAcquireSchedule() {
+    acquire_tick_ = 0;
+    enemy_cells_.clear();
+    prev_enemy_cells_.clear();
+    new_enemy_cells_.clear();
+}
+
+void SetTargetSystem::collectNewEnemyCells(const engine::spatial::SpatialGrid& grid) {
+    cell_size_ = grid.getCellSize();
+    std::swap(enemy_cells_, prev_enemy_cells_);
+    enemy_cells_.clear();
+    for (const auto& entry : grid.getEntries()) {
+        if ((entry.mask_ & spatial_layer::ENEMY) != 0) {
+            enemy_cells_.push_back(cellKey(static_cast<int>(std::floor(entry.position_.x / cell_size_)),
+                                           static_cast<int>(std::floor(entry.position_.y / cell_size_))));
         }
     }
+    enemy_entry_count_ = enemy_cells_.size();
+    std::ranges::sort(enemy_cells_);
+    const auto [last, end] = std::ranges::unique(enemy_cells_);
+    enemy_cells_.erase(last, end);
+
+    new_enemy_cells_.clear();
+    std::vector<std::uint64_t> added;
+    std::ranges::set_difference(enemy_cells_, prev_enemy_cells_, std::back_inserter(added));
+    for (const auto key : added) {
+        new_enemy_cells_.emplace_back(static_cast<int>(static_cast<std::uint32_t>(key >> 32)),
+                                      static_cast<int>(static_cast<std::uint32_t>(key)));
+    }
 }
 
-void SetTargetSystem::updateNoTargetPlayer(entt::registry& registry) {
+bool SetTargetSystem::hasNewEnemyNear(const glm::vec2& center, float radius) const {
+    const int min_x = static_cast<int>(std::floor((center.x - radius) / cell_size_));
+    const int max_x = static_cast<int>(std::floor((center.x + radius) / cell_size_));
+    const int min_y = static_cast<int>(std::floor((center.y - radius) / cell_size_));
+    const int max_y = static_cast<int>(std::floor((center.y + radius) / cell_size_));
+    return std::ranges::any_of(new_enemy_cells_, [&](const glm::ivec2& cell) {
+        return cell.x >= min_x && cell.x <= max_x && cell.y >= min_y && cell.y <= max_y;
+    });
+}
+
+void SetTargetSystem::updateNoTargetPlayer(entt::registry& registry, engine::ecs::CommandBuffer& commands) {
     // 玩家攻击单位：有 PlayerComponent，没有 TargetComponent，也不是治疗者
     auto view_player = registry.view<TransformComponent, StatsComponent, PlayerComponent>(
         entt::exclude<TargetComponent, HealerTag>
     );
+    const auto& grid = registry.ctx().get<engine::spatial::SpatialGrid>();
 
-    auto view_enemy = registry.view<TransformComponent, EnemyComponent>();
+    collectNewEnemyCells(grid);
+    const auto active_bucket = static_cast<std::uint32_t>(acquire_tick_++ % acquire_buckets_);
+    const bool wake_all = acquire_buckets_ == 1 || new_enemy_cells_.size() > WAKE_ALL_CELL_COUNT;
+    TargetAcquireStats acquire_stats;
 
+    pending_scans_.clear();
     for (auto player_entity : view_player) {
         auto& player_pos = view_player.get<TransformComponent>(player_entity).position_;
         auto& stats = view_player.get<StatsComponent>(player_entity);
+        const auto policy = view_player.get<PlayerComponent>(player_entity).target_policy_;
         float range_radius = stats.range_ + UNIT_RADIUS;
 
-        for (auto enemy_entity : view_enemy) {
-            auto& enemy_pos = view_enemy.get<TransformComponent>(enemy_entity).position_;
+        // 不在本步分组：只有射程附近刚出现敌人时才提前搜索
+        if (!wake_all && acquireBucket(player_pos, acquire_buckets_) != active_bucket) {
+            if (!hasNewEnemyNear(player_pos, range_radius)) {
+                ++acquire_stats.deferred_;
+                continue;
+            }
+            ++acquire_stats.woken_;
+        }
+        pending_scans_.push_back(PendingScan{player_entity, player_pos, range_radius, policy});
+    }
+    acquire_stats.scanned_ = pending_scans_.size();
 
-            if (distanceSquared(player_pos, enemy_pos) <= range_radius * range_radius) {
-                registry.emplace<TargetComponent>(player_entity, enemy_entity);
-                break; // 锁定一个目标即可
+    // 敌人聚成一团且搜索量大：网格每次查询都要逐个检查整团敌人，改为扫描一次性拷贝的快照
+    const bool clustered = !enemy_cells_.empty() && enemy_entry_count_ >= enemy_cells_.size() * CLUSTERED_ENEMIES_PER_CELL;
+    scan_results_.assign(pending_scans_.size(), entt::null);
+    auto* costs = registry.ctx().find<game::data::ClassCostProfiler>();
+    if (clustered && pending_scans_.size() * enemy_entry_count_ >= BRUTE_FORCE_MIN_PAIRS) {
+        const auto snapshot_start = std::chrono::steady_clock::now();
+        buildEnemySnapshot(registry, grid);
+        const std::size_t count = pending_scans_.size();
+        const std::size_t chunk_count = (count + BRUTE_FORCE_CHUNK - 1) / BRUTE_FORCE_CHUNK;
+        auto* jobs = registry.ctx().contains<engine::core::JobSystem&>() ? &registry.ctx().get<engine::core::JobSystem&>() : nullptr;
+        // 系统调度器的并行阶段中已处在任务内部，不能嵌套 parallelFor，在本线程上按块扫描
+        if (jobs && jobs->getThreadCount() > 1 && chunk_count > 1 && !engine::core::JobSystem::isInsideJob()) {
+            jobs->parallelFor(chunk_count, [this, count](std::size_t chunk) {
+                ENGINE_PROFILE_SCOPE("TargetScanChunk");
+                const std::size_t begin = chunk * BRUTE_FORCE_CHUNK;
+                scanSnapshot(begin, std::min(begin + BRUTE_FORCE_CHUNK, count));
+            });
+        } else {
+            scanSnapshot(0, count);
+        }
+        acquire_stats.brute_force_ = count;
+        if (costs) {
+            // 工作线程上不记录归因：整段（含快照）平均分给本步搜索的单位
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - snapshot_start).count();
+            const auto share = static_cast<std::uint64_t>(elapsed) / count;
+            for (const auto& scan : pending_scans_) {
+                costs->addMeasured(registry, scan.entity_, game::data::CostCategory::TARGETING, share);
             }
         }
+    } else {
+        for (std::size_t i = 0; i < pending_scans_.size(); ++i) {
+            const game::data::ClassCostProfiler::Scope cost{ costs, registry, pending_scans_[i].entity_, game::data::CostCategory::TARGETING };
+            scan_results_[i] = scanWithGrid(registry, grid, pending_scans_[i]);
+        }
+    }
+
+    // 按视图顺序提交，与逐个搜索的修改顺序一致
+    for (std::size_t i = 0; i < pending_scans_.size(); ++i) {
+        if (scan_results_[i] != entt::null) {
+            commands.emplace<TargetComponent>(pending_scans_[i].entity_, scan_results_[i]);
+        }
+    }
+    registry.ctx().insert_or_assign(acquire_stats);
+}
+
+entt::entity SetTargetSystem::scanWithGrid(entt::registry& registry, const engine::spatial::SpatialGrid& grid,
+                                           const PendingScan& scan) const {
+    // 通过空间网格只检查射程内的敌人，按索敌策略取分数最小者，同分时取距离更近的
+    entt::entity best_target = entt::null;
+    float best_score = std::numeric_limits<float>::max();
+    float best_distance_sq = std::numeric_limits<float>::max();
+    grid.forEachInRadius(scan.position_, scan.range_radius_, spatial_layer::ENEMY, [&](const auto& entry, float distance_sq) {
+        if (!registry.valid(entry.entity_) || !registry.all_of<TransformComponent>(entry.entity_)) {
+            return;
+        }
+        const auto* enemy = registry.try_get<EnemyComponent>(entry.entity_);
+        const auto* enemy_stats = registry.try_get<StatsComponent>(entry.entity_);
+        if (!enemy || !enemy_stats) {
+            return;
+        }
+        const float score = policyScore(scan.policy_, *enemy, *enemy_stats, distance_sq);
+        if (score < best_score || (score == best_score && distance_sq < best_distance_sq)) {
+            best_score = score;
+            best_distance_sq = distance_sq;
+            best_target = entry.entity_;
+        }
+    });
+    return best_target;
+}
+
+void SetTargetSystem::buildEnemySnapshot(entt::registry& registry, const engine::spatial::SpatialGrid& grid) {
+    auto& snapshot = enemy_snapshot_;
+    snapshot.x_.clear();
+    snapshot.y_.clear();
+    snapshot.distance_to_home_.clear();
+    snapshot.hp_.clear();
+    snapshot.threat_.clear();
+    snapshot.entity_.clear();
+    // 有效性只在这里检查一次，扫描时不再访问注册表
+    auto add_enemy = [&](entt::entity entity, float x, float y) {
+        const auto* enemy = registry.try_get<EnemyComponent>(entity);
+        const auto* enemy_stats = registry.try_get<StatsComponent>(entity);
+        if (!enemy || !enemy_stats) {
+            return;
+        }
+        snapshot.x_.push_back(x);
+        snapshot.y_.push_back(y);
+        snapshot.distance_to_home_.push_back(enemy->distance_to_home_);
+        snapshot.hp_.push_back(enemy_stats->hp_);
+        snapshot.threat_.push_back(-enemy->threat_);
+        snapshot.entity_.push_back(entity);
+    };
+
+    // 优先取 PositionCache 的敌人坐标（已销毁的实体已置空），没有时从网格条目中筛选
+    if (const auto* cache = registry.ctx().find<game::data::PositionCache>(); cache && cache->isBuilt()) {
+        const auto& enemies = cache->get(game::data::PositionCategory::ENEMY);
+        for (std::size_t i = 0; i < enemies.size(); ++i) {
+            if (enemies.entity_[i] != entt::null) {
+                add_enemy(enemies.entity_[i], enemies.x_[i], enemies.y_[i]);
+            }
+        }
+        return;
+    }
+    for (const auto& entry : grid.getEntries()) {
+        if ((entry.mask_ & spatial_layer::ENEMY) != 0 && registry.valid(entry.entity_) &&
+            registry.all_of<TransformComponent>(entry.entity_)) {
+            add_enemy(entry.entity_, entry.position_.x, entry.position_.y);
+        }
     }
 }
 
-void SetTargetSystem::updateNoTargetEnemy(entt::registry& registry) {
+void SetTargetSystem::scanSnapshot(std::size_t begin, std::size_t end) {
+    const auto& snapshot = enemy_snapshot_;
+    const std::size_t enemy_count = snapshot.entity_.size();
+    const float* xs = snapshot.x_.data();
+    const float* ys = snapshot.y_.data();
+    for (std::size_t i = begin; i < end; ++i) {
+        const auto& scan = pending_scans_[i];
+        // 其余策略读取快照中对应的字段（threat_ 已取负）
+        const float* scores = nullptr;
+        switch (scan.policy_) {
+            case TargetPolicy::FIRST_ALONG_PATH: scores = snapshot.distance_to_home_.data(); break;
+            case TargetPolicy::LOWEST_HP:        scores = snapshot.hp_.data(); break;
+            case TargetPolicy::HIGHEST_THREAT:   scores = snapshot.threat_.data(); break;
+            case TargetPolicy::CLOSEST:
+            default:                             break;
+        }
+        // 距离平方即 CLOSEST 的分数：同分比较退化为严格小于，即取最近者中下标最小的
+        if (!scores) {
+            const auto index = minDistanceIndex(scan.position_, xs, ys, enemy_count, scan.range_radius_);
+            scan_results_[i] = index < enemy_count ? snapshot.entity_[index] : entt::null;
+            continue;
+        }
+
+        const float radius_sq = scan.range_radius_ * scan.range_radius_;
+        std::size_t best_index = enemy_count;
+        float best_score = std::numeric_limits<float>::max();
+        float best_distance_sq = std::numeric_limits<float>::max();
+        float distance_sq[SCAN_BLOCK];
+        for (std::size_t base = 0; base < enemy_count; base += SCAN_BLOCK) {
+            const std::size_t length = std::min(SCAN_BLOCK, enemy_count - base);
+            distanceSquaredBatch(scan.position_, xs + base, ys + base, length, distance_sq);
+            for (std::size_t j = 0; j < length; ++j) {
+                if (distance_sq[j] > radius_sq) {
+                    continue;
+                }
+                const float score = scores[base + j];
+                if (score < best_score || (score == best_score && distance_sq[j] < best_distance_sq)) {
+                    best_score = score;
+                    best_distance_sq = distance_sq[j];
+                    best_index = base + j;
+                }
+            }
+        }
+        scan_results_[i] = best_index < enemy_count ? snapshot.entity_[best_index] : entt::null;
+    }
+}
+
+void SetTargetSystem::updateNoTargetEnemy(entt::registry& registry, engine::ecs::CommandBuffer& commands) {
     // 敌方远程单位：有 EnemyComponent, RangedUnitTag, 没有 TargetComponent，且未被阻挡（通常由近战处理）
     // 注意：这里我们只处理远程敌人寻找玩家目标。近战敌人逻辑通常在 BlockSystem 处理。
     auto view_enemy = registry.view<TransformComponent, StatsComponent, EnemyComponent, RangedUnitTag>(
         entt::exclude<TargetComponent>
     );
-
-    auto view_player = registry.view<TransformComponent, PlayerComponent>();
+    const auto& grid = registry.ctx().get<engine::spatial::SpatialGrid>();
+    auto* costs = registry.ctx().find<game::data::ClassCostProfiler>();
 
     for (auto enemy_entity : view_enemy) {
+        const game::data::ClassCostProfiler::Scope cost{ costs, registry, enemy_entity, game::data::CostCategory::TARGETING };
         auto& enemy_pos = view_enemy.get<TransformComponent>(enemy_entity).position_;
         auto& stats = view_enemy.get<StatsComponent>(enemy_entity);
         float range_radius = stats.range_ + UNIT_RADIUS;
 
-        for (auto player_entity : view_player) {
-            auto& player_pos = view_player.get<TransformComponent>(player_entity).position_;
-
-            if (distanceSquared(enemy_pos, player_pos) <= range_radius * range_radius) {
-                registry.emplace<TargetComponent>(enemy_entity, player_entity);
-                break;
+        entt::entity best_target = entt::null;
+        float best_distance_sq = range_radius * range_radius;
+        grid.forEachInRadius(enemy_pos, range_radius, spatial_layer::PLAYER, [&](const auto& entry, float distance_sq) {
+            if (distance_sq <= best_distance_sq && registry.valid(entry.entity_) &&
+                registry.all_of<TransformComponent, PlayerComponent>(entry.entity_)) {
+                best_distance_sq = distance_sq;
+                best_target = entry.entity_;
             }
+        });
+
+        if (best_target != entt::null) {
+            commands.emplace<TargetComponent>(enemy_entity, best_target);
         }
     }
 }
 
-void SetTargetSystem::updateHealer(entt::registry& registry) {
+void SetTargetSystem::updateHealer(entt::registry& registry, engine::ecs::CommandBuffer& commands) {
+    auto* injuries = registry.ctx().find<game::data::InjuryQueue>();
     // 治疗者：有 HealerTag
     auto view_healer = registry.view<TransformComponent, StatsComponent, HealerTag>();
-    
-    // 候选目标：带 InjuredTag 的玩家单位
-    auto view_injured = registry.view<TransformComponent, StatsComponent, PlayerComponent, InjuredTag>();
+    stale_injuries_.clear();
+    auto* costs = registry.ctx().find<game::data::ClassCostProfiler>();
+    // contains() 比较完整句柄（含版本），已销毁或索引被复用的实体不会命中，无需另行 valid()
+    const auto& transforms = registry.storage<TransformComponent>();
+    const auto& behaviors = registry.storage<BehaviorComponent>();
+    const auto& dead = registry.storage<DeadTag>();
 
     for (auto healer_entity : view_healer) {
-        auto& healer_pos = view_healer.get<TransformComponent>(healer_entity).position_;
-        auto& stats = view_healer.get<StatsComponent>(healer_entity);
-        float range_radius = stats.range_ + UNIT_RADIUS;
+        const game::data::ClassCostProfiler::Scope cost{ costs, registry, healer_entity, game::data::CostCategory::TARGETING };
+        const auto& healer_pos = view_healer.get<TransformComponent>(healer_entity).position_;
+        const auto& stats = view_healer.get<StatsComponent>(healer_entity);
+        const float range_radius = stats.range_ + UNIT_RADIUS;
 
+        // 按生命比例从低到高，第一个在射程内的受伤友军即为目标
         entt::entity best_target = entt::null;
-        float min_hp_percent = 2.0f; // 百分比范围 0-1
-
-        for (auto target_entity : view_injured) {
-            auto& target_pos = view_injured.get<TransformComponent>(target_entity).position_;
-            
-            if (distanceSquared(healer_pos, target_pos) <= range_radius * range_radius) {
-                auto& target_stats = view_injured.get<StatsComponent>(target_entity);
-                float hp_percent = target_stats.hp_ / target_stats.max_hp_;
-                
-                if (hp_percent < min_hp_percent) {
-                    min_hp_percent = hp_percent;
-                    best_target = target_entity;
+        if (injuries) {
+            for (const auto& entry : injuries->entries()) {
+                const auto* transform = transforms.contains(entry.entity_) ? &transforms.get(entry.entity_) : nullptr;
+                const auto* behavior = transform && behaviors.contains(entry.entity_) ? &behaviors.get(entry.entity_) : nullptr;
+                if (!behavior || !behavior->hasFlag(behavior_flag::INJURED) || dead.contains(entry.entity_)) {
+                    stale_injuries_.push_back(entry.entity_);    // 撤退或未经结算离开的单位
+                    continue;
+                }
+                const glm::vec2 delta = transform->position_ - healer_pos;
+                if (delta.x * delta.x + delta.y * delta.y <= range_radius * range_radius) {
+                    best_target = entry.entity_;
+                    break;
                 }
             }
         }
 
+        // 只在选择变化时写入，避免每步替换 TargetComponent
+        const auto* current = registry.try_get<TargetComponent>(healer_entity);
         if (best_target != entt::null) {
-            registry.emplace_or_replace<TargetComponent>(healer_entity, best_target);
-        } else {
-            // 如果没找到受伤的，清除已有目标（以免一直对着一个满血的人）
-            if (registry.all_of<TargetComponent>(healer_entity)) {
-                registry.remove<TargetComponent>(healer_entity);
+            if (!current || current->entity_ != best_target) {
+                commands.emplace<TargetComponent>(healer_entity, best_target);
             }
+        } else if (current) {
+            // 如果没找到受伤的，清除已有目标（以免一直对着一个满血的人）
+            commands.remove<TargetComponent>(healer_entity);
+        }
+    }
+
+    if (injuries) {
+        for (const auto entity : stale_injuries_) {
+            injuries->remove(entity);
         }
     }
 }
@@ -1,9 +1,31 @@
 #pragma once
 
 #include <entt/entt.hpp>
+#include <glm/vec2.hpp>
+#include "game/defs/constants.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::ecs {
+class CommandBuffer;
+}
+
+namespace engine::spatial {
+class SpatialGrid;
+}
 
 namespace game::system {
 
+/// @brief 空闲玩家单位本步的索敌统计，写入 registry.ctx() 供调试面板显示
+struct TargetAcquireStats {
+    std::size_t scanned_{0};    ///< 本步执行了搜索的单位数（含被唤醒的）
+    std::size_t woken_{0};      ///< 不在本步分组、因附近出现新敌人而提前搜索的单位数
+    std::size_t deferred_{0};   ///< 推迟到所在分组轮次的单位数
+    std::size_t brute_force_{0};    ///< 其中经敌人快照暴力扫描（而非网格查询）的单位数
+};
+
 /**
  * @class SetTargetSystem
  * @brief 目标锁定系统，负责为单位寻找和管理攻击/治疗目标。
@@ -11,37 +33,127 @@ namespace game::system {
  * @details
  * 该系统每帧运行，处理不同类型单位的目标逻辑：
  * 1. 验证已有目标的有效性（是否存在、是否超出射程）。
- * 2. 为没有目标的攻击单位寻找射程内的敌人。
- * 3. 为治疗单位（Healer）寻找受伤的友方单位（InjuredTag）。
+ * 2. 为没有目标的攻击单位寻找射程内的敌人：玩家单位按 PlayerComponent::target_policy_
+ *    （最近 / 沿路径最前 / 生命最低 / 威胁最高）打分，分数直接取自敌人身上已缓存的
+ *    distance_to_home_、hp_、threat_，不做额外计算。
+ * 3. 为治疗单位（Healer）寻找受伤的友方单位（behavior_flag::INJURED）：按 game::data::InjuryQueue 的生命比例顺序取第一个在射程内的，
+ *    选择不变时不写 TargetComponent。
+ *
+ * 候选目标通过 registry 上下文中的 engine::spatial::SpatialGrid 查询，
+ * 只检查射程附近网格单元内的单位。
+ * TargetComponent 的增删记录到 CommandBuffer，由调用方在同步点提交。
+ *
+ * 系统维护「谁锁定了我」的反向索引（on_construct/on_update/on_destroy<TargetComponent>）：
+ * 目标获得 DeadTag 或失去 TransformComponent 时，信号回调立即把所有攻击者的 entity_ 置空，
+ * 下一次 update() 只处理这些被置空的攻击者，不再逐实体调用 registry.valid 校验。
+ * 射程校验带迟滞：上次校验时记录双方位置与「距离射程边界的余量」，双方位移都不超过余量的一半时
+ * 距离不可能越过射程，跳过本次距离计算。
+ *
+ * 空闲玩家单位分时索敌：按放置位置的稳定哈希分成 K 组（TARGET_ACQUIRE_BUCKETS），每步只搜索其中一组；
+ * 上一步没有敌人、本步出现敌人的网格单元落在某单位射程包围盒内时，该单位立即搜索，不等待轮次。
+ * 分组只依赖位置与步数，回放与无头模拟按同样的步调索敌。
+ *
+ * 敌人聚成一团时（每个有敌人的单元平均超过 CLUSTERED_ENEMIES_PER_CELL 个）网格查询退化为逐个检查整团敌人，
+ * 且每个候选都要查注册表。此时若本步搜索量足够大，改为先把敌人位置与打分字段拷贝成 SoA 快照，
+ * 按块把待搜索的玩家单位分给 JobSystem 的工作线程，每块把结果写入自己的区段，最后在调用线程上按顺序提交。
+ * 快照的坐标取自 game::data::PositionCache（没有时取网格条目），比较规则与网格查询相同；
+ * 分数与距离都相同的候选按各自的遍历顺序取舍，两条路径都是确定的。
  */
-class SetTargetSystem {
+class SetTargetSystem final {
 public:
+    explicit SetTargetSystem(entt::registry& registry);
+    ~SetTargetSystem();
+
+    SetTargetSystem(const SetTargetSystem&) = delete;
+    SetTargetSystem& operator=(const SetTargetSystem&) = delete;
+
     /**
      * @brief 更新所有实体的目标锁定状态。
      * @param registry EnTT 注册表。
+     * @param commands 组件增删缓冲。
      */
-    void update(entt::registry& registry);
+    void update(entt::registry& registry, engine::ecs::CommandBuffer& commands);
+
+    /// @brief 设置空闲单位的分组数（至少为 1，1 表示每步全部搜索）
+    void setAcquireBuckets(std::uint32_t buckets) { acquire_buckets_ = buckets > 0 ? buckets : 1; }
+
+    /// @brief 分组轮次与敌人单元记录回到初始状态（回退检查点后调用，使重新录制的回放与无头模拟一致）
+    void resetAcquireSchedule();
 
 private:
     /**
      * @brief 处理已有目标的逻辑（距离校验、存活校验）。
      */
-    void updateHasTarget(entt::registry& registry);
+    void updateHasTarget(entt::registry& registry, engine::ecs::CommandBuffer& commands);
 
     /**
      * @brief 为没有目标的玩家单位寻找敌人。
      */
-    void updateNoTargetPlayer(entt::registry& registry);
+    void updateNoTargetPlayer(entt::registry& registry, engine::ecs::CommandBuffer& commands);
 
     /**
      * @brief 为没有目标的敌方远程单位寻找射程内的目标。
      */
-    void updateNoTargetEnemy(entt::registry& registry);
+    void updateNoTargetEnemy(entt::registry& registry, engine::ecs::CommandBuffer& commands);
 
     /**
-     * @brief 为没有目标的治疗单位寻找受伤最重的友军。
+     * @brief 为治疗单位选择射程内受伤最重的友军，选择变化时才改写 TargetComponent。
      */
-    void updateHealer(entt::registry& registry);
+    void updateHealer(entt::registry& registry, engine::ecs::CommandBuffer& commands);
+
+    void onTargetSet(entt::registry& registry, entt::entity attacker);
+    void onTargetDestroy(entt::registry& registry, entt::entity attacker);
+    /// @brief 实体死亡或失去变换：置空所有仍锁定它的攻击者
+    void onTargetGone(entt::registry& registry, entt::entity target);
+
+    /// @brief 对比上一步，收集本步新出现敌人的网格单元（new_enemy_cells_）
+    void collectNewEnemyCells(const engine::spatial::SpatialGrid& grid);
+    /// @brief 以 center 为圆心、radius 为半径的包围盒是否覆盖了新出现敌人的单元
+    [[nodiscard]] bool hasNewEnemyNear(const glm::vec2& center, float radius) const;
+
+    /// @brief 本步要搜索的一个空闲玩家单位
+    struct PendingScan {
+        entt::entity entity_{entt::null};
+        glm::vec2 position_{0.0f, 0.0f};
+        float range_radius_{0.0f};
+        game::defs::TargetPolicy policy_{game::defs::TargetPolicy::CLOSEST};
+    };
+
+    /// @brief 有效敌人的 SoA 快照，供暴力扫描连续读取
+    struct EnemySnapshot {
+        std::vector<float> x_;
+        std::vector<float> y_;
+        std::vector<float> distance_to_home_;
+        std::vector<float> hp_;
+        std::vector<float> threat_;
+        std::vector<entt::entity> entity_;
+    };
+
+    /// @brief 网格查询：为 scan 在射程内选出分数最小的敌人，没有时返回 entt::null
+    [[nodiscard]] entt::entity scanWithGrid(entt::registry& registry, const engine::spatial::SpatialGrid& grid,
+                                            const PendingScan& scan) const;
+    /// @brief 拷贝 PositionCache（或网格）中仍有效的敌人到 enemy_snapshot_
+    void buildEnemySnapshot(entt::registry& registry, const engine::spatial::SpatialGrid& grid);
+    /// @brief 暴力扫描 pending_scans_ 的 [begin, end)，结果写入 scan_results_ 的同一区段
+    void scanSnapshot(std::size_t begin, std::size_t end);
+
+    entt::registry& registry_;
+    /// 目标 -> 锁定它的攻击者；攻击者改换目标时旧条目惰性清理（置空前会确认其当前目标）
+    std::unordered_map<entt::entity, std::vector<entt::entity>> targeted_by_;
+    std::vector<entt::entity> invalidated_;     ///< 目标已失效、等待移除 TargetComponent 的攻击者
+
+    std::uint32_t acquire_buckets_;             ///< 空闲单位的分组数
+    std::uint64_t acquire_tick_{0};             ///< 已执行的索敌步数，决定本步轮到的分组
+    float cell_size_{64.0f};                    ///< 新敌人单元使用的网格边长（取自 SpatialGrid）
+    std::vector<std::uint64_t> enemy_cells_;        ///< 本步有敌人的单元（排序）
+    std::vector<std::uint64_t> prev_enemy_cells_;   ///< 上一步有敌人的单元（排序）
+    std::vector<glm::ivec2> new_enemy_cells_;       ///< 本步新出现敌人的单元
+    std::size_t enemy_entry_count_{0};              ///< 本步网格中的敌人条目数
+
+    std::vector<PendingScan> pending_scans_;        ///< 本步要搜索的单位（视图顺序）
+    std::vector<entt::entity> scan_results_;        ///< 与 pending_scans_ 一一对应的搜索结果
+    EnemySnapshot enemy_snapshot_;                  ///< 暴力扫描使用的敌人快照（容量跨步复用）
+    std::vector<entt::entity> stale_injuries_;      ///< 本步发现已离开的受伤单位，遍历结束后移出 InjuryQueue
 };
 
 } // namespace game::system
@@ -0,0 +1,98 @@
+#include "simulation_lod_system.h"
+#include "engine/component/low_detail_tag.h"
+#include "engine/component/transform_component.h"
+#include "engine/render/camera.h"
+#include "engine/spatial/spatial_grid.h"
+#include "game/component/behavior_component.h"
+#include "game/component/blocked_by_component.h"
+#include "game/component/enemy_component.h"
+#include "game/component/player_component.h"
+#include "game/component/simulation_lod_component.h"
+#include "game/component/stats_component.h"
+#include "game/component/target_component.h"
+#include "game/defs/constants.h"
+#include "game/defs/tags.h"
+#include <entt/entity/registry.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace game::system {
+
+using namespace engine::component;
+using namespace game::component;
+using namespace game::defs;
+
+namespace {
+    constexpr float VIEW_MARGIN = 64.0f;    ///< 视口外扩的边距，精灵完全离开画面后才降级
+
+    std::uint64_t cellKey(int x, int y) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    }
+
+    int cellCoord(float value, float inv_cell_size) {
+        return static_cast<int>(std::floor(value * inv_cell_size));
+    }
+}
+
+void SimulationLodSystem::update(entt::registry& registry, const engine::render::Camera& camera) {
+    const float cell_size = registry.ctx().get<engine::spatial::SpatialGrid>().getCellSize();
+    const float inv_cell_size = 1.0f / cell_size;
+
+    // 敌人的最大射程也计入作用圆：远程敌人能从己方射程之外发起攻击
+    float enemy_range = 0.0f;
+    for (auto [entity, enemy, stats] : registry.view<EnemyComponent, StatsComponent>(entt::exclude<DeadTag>).each()) {
+        enemy_range = std::max(enemy_range, stats.range_);
+    }
+
+    covered_cells_.clear();
+    for (auto [entity, player, stats, transform] :
+         registry.view<PlayerComponent, StatsComponent, TransformComponent>(entt::exclude<DeadTag>).each()) {
+        const float radius = std::max({ stats.range_, enemy_range, BLOCK_RADIUS }) + UNIT_RADIUS;
+        const int x0 = cellCoord(transform.position_.x - radius, inv_cell_size);
+        const int x1 = cellCoord(transform.position_.x + radius, inv_cell_size);
+        const int y0 = cellCoord(transform.position_.y - radius, inv_cell_size);
+        const int y1 = cellCoord(transform.position_.y + radius, inv_cell_size);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                covered_cells_.push_back(cellKey(x, y));
+            }
+        }
+    }
+    std::ranges::sort(covered_cells_);
+    covered_cells_.erase(std::unique(covered_cells_.begin(), covered_cells_.end()), covered_cells_.end());
+
+    const glm::vec2 view_min = camera.getPosition() - VIEW_MARGIN;
+    const glm::vec2 view_max = camera.getPosition() + camera.getViewSize() + VIEW_MARGIN;
+
+    SimulationLodStats stats;
+    promote_.clear();
+    demote_.clear();
+    for (auto [entity, enemy, transform, behavior] : registry.view<EnemyComponent, TransformComponent, BehaviorComponent>(entt::exclude<DeadTag>).each()) {
+        ++stats.enemy_count_;
+        const glm::vec2& position = transform.position_;
+        const bool visible = position.x >= view_min.x && position.x <= view_max.x &&
+                             position.y >= view_min.y && position.y <= view_max.y;
+        const bool engaged = behavior.isActionLocked() || registry.any_of<TargetComponent, BlockedByComponent>(entity) ||
+            std::ranges::binary_search(covered_cells_, cellKey(cellCoord(position.x, inv_cell_size),
+                                                                cellCoord(position.y, inv_cell_size)));
+        const bool low = !visible && !engaged;
+        const bool was_low = registry.all_of<LowDetailTag>(entity);
+        if (low != was_low) {
+            (low ? demote_ : promote_).push_back(entity);
+        }
+        stats.low_count_ += low ? 1u : 0u;
+    }
+
+    for (const auto entity : promote_) {
+        registry.remove<LowDetailTag, SimulationLodComponent>(entity);
+    }
+    for (const auto entity : demote_) {
+        registry.emplace<LowDetailTag>(entity);
+        registry.emplace<SimulationLodComponent>(entity);  // 跳过步数为 0：本步先完整检查一次
+    }
+    stats.promoted_ = promote_.size();
+    stats.demoted_ = demote_.size();
+    registry.ctx().insert_or_assign(stats);
+}
+
+} // namespace game::system
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <entt/entity/fwd.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::render {
+class Camera;
+}
+
+namespace game::system {
+
+/// @brief 模拟细节统计，写入 registry.ctx() 供调试面板显示
+struct SimulationLodStats {
+    std::size_t enemy_count_{0};    ///< 本步参与评估的敌人数
+    std::size_t low_count_{0};      ///< 其中以低细节模拟的数量
+    std::size_t promoted_{0};       ///< 本步恢复为完整模拟的数量
+    std::size_t demoted_{0};        ///< 本步降为低细节的数量
+};
+
+/**
+ * @class SimulationLodSystem
+ * @brief 为敌人切换模拟细节，每个模拟步在 FollowPathSystem 之前运行。
+ *
+ * @details
+ * 把每个己方单位的作用圆（max(自身射程, 敌人最大射程, 阻挡半径) + 单位半径）覆盖到的
+ * 空间网格单元标记出来；敌人满足以下全部条件时降为低细节：
+ * - 所在单元未被标记（不在任何己方单位的攻击、被攻击或阻挡范围内）
+ * - 没有目标、未被阻挡、不在动作锁中
+ * - 在相机视口（加边距）之外
+ *
+ * 低细节敌人带 LowDetailTag 与 SimulationLodComponent：动画帧与朝向不更新，
+ * FollowPathSystem 在到达路径段终点之前跳过它（结果与逐步更新完全相同，回放不受相机影响）。
+ * 进入标记单元或视口的敌人在同一步恢复完整模拟。
+ */
+class SimulationLodSystem {
+public:
+    void update(entt::registry& registry, const engine::render::Camera& camera);
+
+private:
+    std::vector<std::uint64_t> covered_cells_;  ///< 己方作用范围覆盖的网格单元（排序后二分查找，帧间复用）
+    std::vector<entt::entity> promote_;         ///< 本步要恢复/降级的敌人（遍历结束后统一增删组件）
+    std::vector<entt::entity> demote_;
+};
+
+} // namespace game::system
@@ -0,0 +1,80 @@
+#include "spatial_index_system.h"
+#include "engine/component/transform_component.h"
+#include "engine/spatial/spatial_grid.h"
+#include "game/component/behavior_component.h"
+#include "game/component/stats_component.h"
+#include "game/component/player_component.h"
+#include "game/component/enemy_component.h"
+#include "game/component/blocker_component.h"
+#include "game/component/class_name_component.h"
+#include "game/data/position_cache.h"
+#include "game/defs/tags.h"
+#include "game/defs/constants.h"
+#include "game/defs/groups.h"
+
+namespace game::system {
+
+using namespace engine::component;
+using namespace game::component;
+using namespace game::defs;
+using game::data::PositionCategory;
+
+void SpatialIndexSystem::update(entt::registry& registry) {
+    auto& grid = registry.ctx().get<engine::spatial::SpatialGrid>();
+    auto* cache = registry.ctx().find<game::data::PositionCache>();
+    grid.beginBuild();
+    if (cache) {
+        cache->beginBuild();
+    }
+
+    // 参与查询的都是带属性的战斗单位
+    auto view = game::defs::statsGroup(registry);
+    for (auto entity : view) {
+        const auto& position = view.get<TransformComponent>(entity).position_;
+        std::uint32_t mask = 0;
+        if (registry.all_of<PlayerComponent>(entity)) {
+            mask |= spatial_layer::PLAYER;
+            const auto* behavior = registry.try_get<game::component::BehaviorComponent>(entity);
+            if (behavior && behavior->hasFlag(game::component::behavior_flag::INJURED)) {
+                mask |= spatial_layer::INJURED;
+            }
+        }
+        if (registry.all_of<EnemyComponent>(entity)) {
+            mask |= spatial_layer::ENEMY;
+        }
+        if (cache) {
+            if ((mask & spatial_layer::ENEMY) != 0) {
+                cache->get(PositionCategory::ENEMY).push(entity, position);
+            }
+            if ((mask & spatial_layer::PLAYER) != 0) {
+                cache->get(PositionCategory::PLAYER).push(entity, position);
+            }
+            if ((mask & spatial_layer::INJURED) != 0) {
+                cache->get(PositionCategory::INJURED).push(entity, position);
+            }
+        }
+        if (registry.all_of<BlockerComponent>(entity)) {
+            mask |= spatial_layer::BLOCKER;
+        }
+        if (registry.all_of<ClassNameComponent>(entity)) {
+            mask |= spatial_layer::SELECTABLE;
+        }
+        if (mask != 0) {
+            grid.insert(entity, position, mask);
+        }
+    }
+
+    grid.endBuild();
+}
+
+void SpatialIndexSystem::onEntitiesDestroyed(entt::registry& registry, std::span<const entt::entity>) {
+    auto* cache = registry.ctx().find<game::data::PositionCache>();
+    if (!cache) {
+        return;
+    }
+    // 整批待删除实体都带 DeadTag，每个分类只需遍历一次
+    const auto& dead = registry.storage<DeadTag>();
+    cache->invalidateIf([&dead](entt::entity entity) { return dead.contains(entity); });
+}
+
+} // namespace game::system
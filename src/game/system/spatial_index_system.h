@@ -0,0 +1,35 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <span>
+
+namespace game::system {
+
+/**
+ * @class SpatialIndexSystem
+ * @brief 空间索引系统，每帧在 MovementSystem 之后重建共享的 SpatialGrid 与 PositionCache。
+ *
+ * @details
+ * 网格保存在 registry 上下文中（engine::spatial::SpatialGrid），供 BlockSystem、
+ * SetTargetSystem、SelectionSystem 做半径/最近邻查询，替代各自的暴力双重循环。
+ * 条目的图层掩码见 game::defs::spatial_layer。
+ *
+ * 上下文中有 game::data::PositionCache 时，同一次遍历按分类（敌人、玩家、受伤玩家）
+ * 写入连续的坐标数组，供索敌快照与出击选位直接交给批量距离函数。
+ *
+ * @note 网格查询结果来自上一次重建，其间被销毁的实体需由使用方通过 registry.valid() 过滤；
+ *       PositionCache 中的这些实体由 onEntitiesDestroyed() 置为失效。
+ */
+class SpatialIndexSystem {
+public:
+    /**
+     * @brief 用所有存活单位的当前位置重建空间网格
+     * @param registry EnTT 注册表（上下文中需已存在 SpatialGrid）
+     */
+    void update(entt::registry& registry);
+
+    /// @brief RemoveDeadSystem 批量收尾：使 PositionCache 中整批被销毁实体的条目失效
+    void onEntitiesDestroyed(entt::registry& registry, std::span<const entt::entity> entities);
+};
+
+} // namespace game::system
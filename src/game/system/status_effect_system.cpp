@@ -0,0 +1,127 @@
+#include "status_effect_system.h"
+
+#include "../component/attack_timer_component.h"
+#include "../component/base_stats_component.h"
+#include "../component/enemy_component.h"
+#include "../component/stats_component.h"
+#include "../defs/constants.h"
+#include "../defs/event.h"
+#include "../../engine/core/timer_wheel.h"
+#include "../../engine/ecs/event_queues.h"
+#include "../../engine/utils/profiler.h"
+
+namespace game::system {
+
+bool StatusEffectSystem::apply(entt::registry& registry, entt::entity target, const game::data::StatusEffectSpec& spec) {
+    auto* store = registry.ctx().find<game::data::StatusEffectStore>();
+    auto* timers = registry.ctx().find<engine::core::TimerWheel>();
+    if (!store || !timers || !registry.valid(target)) {
+        return false;
+    }
+    const std::uint64_t expire_tick = timers->getTick() + timers->ticksFor(spec.duration_);
+    store->apply(target, spec, expire_tick);
+    timers->schedule(expire_tick, target, game::defs::timer_event::STATUS_EFFECT_EXPIRE);
+    return true;
+}
+
+bool StatusEffectSystem::remove(entt::registry& registry, entt::entity target, entt::id_type effect_id) {
+    auto* store = registry.ctx().find<game::data::StatusEffectStore>();
+    return store && store->remove(target, effect_id);
+}
+
+void StatusEffectSystem::update(entt::registry& registry, engine::ecs::EventQueues& event_queues, float delta_time) {
+    auto* store = registry.ctx().find<game::data::StatusEffectStore>();
+    const auto* timers = registry.ctx().find<engine::core::TimerWheel>();
+    if (!store || !timers) {
+        return;
+    }
+
+    const std::uint64_t now = timers->getTick();
+    std::size_t expired = 0;
+    for (const auto& expiry : timers->getExpired()) {
+        if (expiry.event_ == game::defs::timer_event::STATUS_EFFECT_EXPIRE) {
+            expired += store->removeExpired(expiry.entity_, now);
+        }
+    }
+
+    // 空闲记录的 dps 为 0，只需比较一个连续数组
+    const auto targets = store->targets();
+    const auto sources = store->sources();
+    const auto dps = store->damagePerSecond();
+    for (std::size_t i = 0; i < dps.size(); ++i) {
+        if (dps[i] > 0.0f) {
+            event_queues.enqueue(game::defs::StatusDamageEvent{ sources[i], targets[i], dps[i] * delta_time });
+        }
+    }
+
+    foldModifiers(registry, *store);
+    ENGINE_PROFILE_COUNTER("status.active", static_cast<std::int64_t>(store->size()));
+    ENGINE_PROFILE_COUNTER("status.expired", static_cast<std::int64_t>(expired));
+}
+
+void StatusEffectSystem::onEntitiesDestroyed(entt::registry& registry, std::span<const entt::entity> entities) {
+    auto* store = registry.ctx().find<game::data::StatusEffectStore>();
+    if (!store) {
+        return;
+    }
+    for (const auto entity : entities) {
+        store->removeTarget(entity);
+    }
+}
+
+void StatusEffectSystem::foldModifiers(entt::registry& registry, game::data::StatusEffectStore& store) {
+    using game::component::AttackTimerComponent;
+    using game::component::BaseStatsComponent;
+    using game::component::EnemyComponent;
+    using game::component::StatsComponent;
+
+    for (const auto entity : store.takeDirty()) {
+        if (!registry.valid(entity)) {
+            continue;
+        }
+        auto* stats = registry.try_get<StatsComponent>(entity);
+        if (!stats) {
+            continue;
+        }
+        auto* attack_timer = registry.try_get<AttackTimerComponent>(entity);
+        auto* enemy = registry.try_get<EnemyComponent>(entity);
+        auto* base = registry.try_get<BaseStatsComponent>(entity);
+        const auto modifiers = store.modifiers(entity);
+
+        if (!modifiers.any_) {
+            if (base) {
+                stats->atk_ = base->atk_;
+                stats->def_ = base->def_;
+                stats->range_ = base->range_;
+                if (attack_timer) {
+                    attack_timer->interval_ = base->atk_interval_;
+                }
+                if (enemy) {
+                    enemy->speed_ = base->speed_;
+                }
+                registry.remove<BaseStatsComponent>(entity);
+            }
+            continue;
+        }
+
+        if (!base) {
+            base = &registry.emplace<BaseStatsComponent>(entity, BaseStatsComponent{
+                stats->atk_,
+                stats->def_,
+                stats->range_,
+                attack_timer ? attack_timer->interval_ : 0.0f,
+                enemy ? enemy->speed_ : 0.0f });
+        }
+        stats->atk_ = base->atk_ * modifiers.atk_;
+        stats->def_ = base->def_ * modifiers.def_;
+        stats->range_ = base->range_ * modifiers.range_;
+        if (attack_timer) {
+            attack_timer->interval_ = base->atk_interval_ * modifiers.atk_interval_;
+        }
+        if (enemy) {
+            enemy->speed_ = base->speed_ * modifiers.speed_;
+        }
+    }
+}
+
+} // namespace game::system
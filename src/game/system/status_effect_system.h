@@ -0,0 +1,55 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <span>
+#include <vector>
+
+#include "../data/status_effect_store.h"
+
+namespace engine::ecs {
+class EventQueues;
+}
+
+namespace game::system {
+
+/**
+ * @class StatusEffectSystem
+ * @brief 状态效果系统：减速、灼烧、护盾、技能与光环增益等效果的到期、持续伤害与属性汇总。
+ *
+ * @details
+ * 效果记录保存在注册表上下文的 game::data::StatusEffectStore 中（SoA），施加时在 engine::core::TimerWheel
+ * 上登记 timer_event::STATUS_EFFECT_EXPIRE，到期前不逐帧检查。每步：
+ * 1. 处理本步到期的条目，移除目标上已到期的效果（刷新过的效果到期步更晚，旧计时器到期时不受影响）
+ * 2. 顺序扫描持续伤害数组，每条效果发出一个 StatusDamageEvent，下一步由 CombatResolveSystem 与命中一起按目标结算
+ * 3. 只对本步施加、移除、到期或被外部标记的脏目标汇总倍率：以 BaseStatsComponent 为基准写入 StatsComponent
+ *    的攻击/防御/范围、AttackTimerComponent 的攻击间隔与 EnemyComponent 的速度，其他系统照常只读这些组件
+ *
+ * 护盾在 CombatResolveSystem 结算伤害时经 StatusEffectStore::absorbDamage() 先行吸收。
+ */
+class StatusEffectSystem {
+public:
+    /**
+     * @brief 对目标施加（或刷新）一个效果，并登记到期计时器
+     * @return 上下文中缺少 StatusEffectStore 或 TimerWheel、或目标无效时返回 false
+     */
+    static bool apply(entt::registry& registry, entt::entity target, const game::data::StatusEffectSpec& spec);
+
+    /// @brief 提前移除目标上的一个效果（已登记的计时器到期时自然忽略）
+    static bool remove(entt::registry& registry, entt::entity target, entt::id_type effect_id);
+
+    /**
+     * @brief 处理到期、发出持续伤害、汇总脏目标的属性
+     * @param event_queues 持续伤害事件的批量通道
+     * @param delta_time 本步时长（秒），只用于持续伤害
+     */
+    void update(entt::registry& registry, engine::ecs::EventQueues& event_queues, float delta_time);
+
+    /// @brief RemoveDeadSystem 批量收尾：丢弃整批被销毁实体身上的效果
+    void onEntitiesDestroyed(entt::registry& registry, std::span<const entt::entity> entities);
+
+private:
+    /// @brief 以基础属性乘以全部倍率写回有效属性；没有倍率时写回基础值并移除 BaseStatsComponent
+    void foldModifiers(entt::registry& registry, game::data::StatusEffectStore& store);
+};
+
+} // namespace game::system
@@ -1,48 +1,122 @@
 #include "timer_system.h"
 
+#include "../component/attack_timer_component.h"
+#include "../component/behavior_component.h"
 #include "../component/hero_skill_component.h"
 #include "../component/stats_component.h"
+#include "../data/behavior_index.h"
 #include "../defs/event.h"
-#include "../defs/tags.h"
+#include "../defs/constants.h"
+#include "../../engine/core/timer_wheel.h"
+#include "../../engine/utils/profiler.h"
 #include <algorithm>
+#include <bit>
+#include <cstdint>
 
 namespace game::system {
 
-void TimerSystem::update(entt::registry& registry, entt::dispatcher& dispatcher, float delta_time) {
-    auto attack_view = registry.view<game::component::StatsComponent>(entt::exclude<game::defs::AttackReadyTag>);
-
-    for (auto entity : attack_view) {
-        auto& stats = attack_view.get<game::component::StatsComponent>(entity);
-        
-        stats.atk_timer_ += delta_time;
-        if (stats.atk_timer_ >= stats.atk_interval_) {
-            registry.emplace<game::defs::AttackReadyTag>(entity);
-            // 注意：计时器不在这里归零，而是在攻击真正发起时（AttackStarterSystem）归零。
-            // 这样可以确保如果单位一直找不到目标，AttackReadyTag 会一直保持，直到下一次攻击。
-        }
+namespace {
+
+using game::component::AttackTimerComponent;
+
+constexpr std::size_t TIMER_LANES = 8;     ///< 每组比较的计时器数量（一个 256 位寄存器的 float 数）
+
+/**
+ * @brief 推进一组计时器并返回新就绪位掩码（第 i 位对应第 i 个计时器）
+ *
+ * 循环体无分支，N 为编译期常量时编译器会展开并向量化；已就绪（READY）的计时器加上 dt 仍为 READY，且不计入掩码。
+ */
+template <std::size_t N>
+inline std::uint32_t advanceTimers(AttackTimerComponent* timers, float delta_time) {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        const float timer = timers[i].timer_;
+        const float next = timer + delta_time;
+        const bool crossed = (timer != AttackTimerComponent::READY) & (next >= timers[i].interval_);
+        timers[i].timer_ = crossed ? AttackTimerComponent::READY : next;
+        mask |= static_cast<std::uint32_t>(crossed) << i;
     }
+    return mask;
+}
+
+/// @brief 不足一组的尾部逐个处理
+inline std::uint32_t advanceTimers(AttackTimerComponent* timers, std::size_t count, float delta_time) {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        mask |= advanceTimers<1>(timers + i, delta_time) << i;
+    }
+    return mask;
+}
+
+} // namespace
+
+void TimerSystem::updateAttackTimers(entt::registry& registry, float delta_time) {
+    auto& timers = registry.storage<AttackTimerComponent>();
+    constexpr std::size_t page_size = entt::component_traits<AttackTimerComponent>::page_size;
+    static_assert(page_size % TIMER_LANES == 0, "组件页大小需是分组宽度的整数倍，分组才不会跨页");
 
-    auto skill_view = registry.view<game::component::HeroSkillComponent, game::component::StatsComponent>();
-    for (auto entity : skill_view) {
-        auto& skill = skill_view.get<game::component::HeroSkillComponent>(entity);
+    // 组件按页连续存放，第 i 个组件对应打包数组中的第 i 个实体
+    auto pages = timers.raw();
+    const entt::entity* entities = timers.data();
+    const std::size_t count = timers.size();
 
-        if (skill.passive_) {
-            continue;
+    ready_.clear();
+    auto collect = [&](std::uint32_t mask, std::size_t base) {
+        while (mask != 0) {
+            const auto lane = static_cast<std::size_t>(std::countr_zero(mask));
+            ready_.push_back(entities[base + lane]);
+            mask &= mask - 1;
         }
+    };
 
-        if (skill.cooldown_timer_ > 0.0f) {
-            skill.cooldown_timer_ = std::max(0.0f, skill.cooldown_timer_ - delta_time);
-            if (skill.cooldown_timer_ <= 0.0f && !registry.all_of<game::defs::SkillReadyTag>(entity)) {
-                registry.emplace<game::defs::SkillReadyTag>(entity);
+    for (std::size_t base = 0; base < count; base += TIMER_LANES) {
+        AttackTimerComponent* block = &pages[base / page_size][base % page_size];
+        const std::size_t lanes = std::min(TIMER_LANES, count - base);
+        const std::uint32_t mask = lanes == TIMER_LANES
+            ? advanceTimers<TIMER_LANES>(block, delta_time)
+            : advanceTimers(block, lanes, delta_time);
+        collect(mask, base);
+    }
+
+    // 注意：计时器不在这里归零，而是在攻击真正发起时（AttackStarterSystem）归零。
+    // 这样可以确保如果单位一直找不到目标，就绪状态会一直保持，直到下一次攻击。
+    // 已就绪的单位再收到 COOLDOWN_DONE 时转移表保持原状态，外部改动计时器也不会重复进入列表。
+    auto& behaviors = registry.ctx().get<game::data::BehaviorIndex&>();
+    for (const auto entity : ready_) {
+        behaviors.transition(entity, game::component::BehaviorEvent::COOLDOWN_DONE);
+    }
+    ENGINE_PROFILE_COUNTER("timer.ready", static_cast<std::int64_t>(ready_.size()));
+}
+
+void TimerSystem::update(entt::registry& registry, entt::dispatcher& dispatcher, float delta_time) {
+    updateAttackTimers(registry, delta_time);
+
+    const auto* timers = registry.ctx().find<engine::core::TimerWheel>();
+    if (!timers) {
+        return;
+    }
+    const std::uint64_t now = timers->getTick();
+    for (const auto& expiry : timers->getExpired()) {
+        const entt::entity entity = expiry.entity_;
+        switch (expiry.event_) {
+        case game::defs::timer_event::SKILL_READY: {
+            const auto* skill = registry.valid(entity) ? registry.try_get<game::component::HeroSkillComponent>(entity) : nullptr;
+            auto* behavior = skill ? registry.try_get<game::component::BehaviorComponent>(entity) : nullptr;
+            if (behavior && skill->cooldown_end_tick_ == now && !behavior->hasFlag(game::component::behavior_flag::SKILL_READY)) {
+                behavior->setFlag(game::component::behavior_flag::SKILL_READY, true);
                 dispatcher.enqueue(game::defs::SkillReadyEvent{ entity });
             }
+            break;
         }
-
-        if (skill.active_ && skill.duration_timer_ > 0.0f) {
-            skill.duration_timer_ = std::max(0.0f, skill.duration_timer_ - delta_time);
-            if (skill.duration_timer_ <= 0.0f) {
+        case game::defs::timer_event::SKILL_DURATION_END: {
+            const auto* skill = registry.valid(entity) ? registry.try_get<game::component::HeroSkillComponent>(entity) : nullptr;
+            if (skill && skill->active_ && skill->duration_end_tick_ == now) {
                 dispatcher.enqueue(game::defs::SkillDurationEndEvent{ entity });
             }
+            break;
+        }
+        default:
+            break;      // 波次等其他计时器由各自的所有者处理
         }
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <entt/entt.hpp>
+#include <vector>
 
 namespace game::system {
 
@@ -9,18 +10,31 @@ namespace game::system {
  * @brief 计时器系统，处理所有带有攻击冷却计时的实体。
  * 
  * @details
- * 该系统负责维护 StatsComponent 中的 atk_timer_。
- * 当计时器达到攻击间隔（atk_interval_）时，会为实体添加 AttackReadyTag，
- * 表示该单位可以进行下一次攻击。
+ * 该系统负责推进 AttackTimerComponent 中的攻击计时。
+ * 当计时器达到攻击间隔时，经 BehaviorIndex 发出 COOLDOWN_DONE 转移，表示该单位可以进行下一次攻击。
+ *
+ * 攻击计时直接遍历组件存储的连续数组，每 8 个一组无分支地比较计时与间隔、得到就绪位掩码，
+ * 本帧新就绪的实体最后逐个转移状态；已就绪的计时器保持 READY，不会重复转移。
+ *
+ * 技能的冷却与持续时间登记在注册表上下文的 engine::core::TimerWheel 中（HeroSkillSystem 释放技能时登记），
+ * 这里只处理本步到期的条目：冷却结束设置 behavior_flag::SKILL_READY 并发出 SkillReadyEvent，持续结束发出 SkillDurationEndEvent，
+ * 不再逐个遍历技能组件。到期步与组件记录的不一致（实体已被替换）的条目直接忽略。
  */
 class TimerSystem {
 public:
     /**
      * @brief 更新所有实体的计时器。
      * @param registry EnTT 注册表。
-     * @param delta_time 自上一帧以来的时间间隔（秒）。
+     * @param dispatcher 事件分发器。
+     * @param delta_time 自上一帧以来的时间间隔（秒），只用于攻击计时；技能计时器由模拟循环每步推进一次。
      */
     void update(entt::registry& registry, entt::dispatcher& dispatcher, float delta_time);
+
+private:
+    /// @brief 推进所有攻击计时器，将本帧新就绪的实体转移到就绪状态
+    void updateAttackTimers(entt::registry& registry, float delta_time);
+
+    std::vector<entt::entity> ready_;   ///< 本帧新就绪的实体（帧间复用容量）
 };
 
 } // namespace game::system
@@ -3,6 +3,7 @@
 #include "../component/class_name_component.h"
 #include "../component/hero_skill_component.h"
 #include "../component/player_component.h"
+#include "../component/attack_timer_component.h"
 #include "../component/stats_component.h"
 #include "../data/game_stats.h"
 #include "../data/selection_state.h"
@@ -11,6 +12,7 @@
 #include "../defs/event.h"
 #include "../factory/blueprint_manager.h"
 #include "../../engine/core/context.h"
+#include "../../engine/core/timer_wheel.h"
 #include "../../engine/component/transform_component.h"
 #include "../../engine/scene/scene.h"
 #include "../../engine/utils/math.h"
@@ -23,7 +25,8 @@ namespace {
 
 bool isValidUnit(entt::registry& registry, entt::entity entity) {
     return entity != entt::null && registry.valid(entity) &&
-        registry.all_of<game::component::ClassNameComponent, engine::component::TransformComponent, game::component::StatsComponent>(entity);
+        registry.all_of<game::component::ClassNameComponent, engine::component::TransformComponent, game::component::StatsComponent,
+                         game::component::AttackTimerComponent>(entity);
 }
 
 void renderUnitTooltip(entt::registry& registry,
@@ -36,6 +39,7 @@ void renderUnitTooltip(entt::registry& registry,
     const auto& name = registry.get<game::component::ClassNameComponent>(entity);
     const auto& transform = registry.get<engine::component::TransformComponent>(entity);
     const auto& stats = registry.get<game::component::StatsComponent>(entity);
+    const auto& attack_timer = registry.get<game::component::AttackTimerComponent>(entity);
     const auto* skill = registry.try_get<game::component::HeroSkillComponent>(entity);
 
     ImGui::BeginTooltip();
@@ -46,7 +50,7 @@ void renderUnitTooltip(entt::registry& registry,
     ImGui::Text("攻击：%.1f", stats.atk_);
     ImGui::Text("防御：%.1f", stats.def_);
     ImGui::Text("射程：%.1f", stats.range_);
-    ImGui::Text("攻击间隔：%.2f", stats.atk_interval_);
+    ImGui::Text("攻击间隔：%.2f", attack_timer.interval_);
     ImGui::Text("坐标：%.1f, %.1f", transform.position_.x, transform.position_.y);
 
     if (skill && blueprint_manager.hasSkillBlueprint(skill->skill_id_)) {
@@ -112,6 +116,7 @@ void renderSelectedUnitPanel(entt::registry& registry,
     ImGui::SetWindowFontScale(1.15f);
     const auto& name = registry.get<game::component::ClassNameComponent>(selected_unit);
     const auto& stats = registry.get<game::component::StatsComponent>(selected_unit);
+    const auto& attack_timer = registry.get<game::component::AttackTimerComponent>(selected_unit);
     const auto& player = registry.get<game::component::PlayerComponent>(selected_unit);
     const auto* skill = registry.try_get<game::component::HeroSkillComponent>(selected_unit);
 
@@ -121,7 +126,7 @@ void renderSelectedUnitPanel(entt::registry& registry,
     ImGui::Text("攻击：%.1f", stats.atk_);
     ImGui::Text("防御：%.1f", stats.def_);
     ImGui::Text("射程：%.1f", stats.range_);
-    ImGui::Text("攻击间隔：%.2f", stats.atk_interval_);
+    ImGui::Text("攻击间隔：%.2f", attack_timer.interval_);
     ImGui::Text("费用：%d", player.cost_);
     ImGui::Text("投射物：0x%llx", static_cast<unsigned long long>(player.projectile_id_));
     ImGui::Separator();
@@ -132,12 +137,15 @@ void renderSelectedUnitPanel(entt::registry& registry,
         ImGui::SeparatorText("技能");
         ImGui::Text("%s", skill_bp.name_.c_str());
         ImGui::TextWrapped("%s", skill_bp.description_.c_str());
+        const auto* timers = registry.ctx().find<engine::core::TimerWheel>();
+        const float cooldown_left = timers ? timers->secondsUntil(skill->cooldown_end_tick_) : 0.0f;
+        const float duration_left = timers && skill->active_ ? timers->secondsUntil(skill->duration_end_tick_) : 0.0f;
         if (skill->passive_) {
             ImGui::TextColored(ImVec4(0.45f, 0.85f, 1.0f, 1.0f), "状态：被动技能激活中");
         } else if (skill->active_) {
-            ImGui::TextColored(ImVec4(0.35f, 1.0f, 0.45f, 1.0f), "状态：激活中，剩余 %.1f 秒", skill->duration_timer_);
-        } else if (skill->cooldown_timer_ > 0.0f) {
-            ImGui::TextColored(ImVec4(1.0f, 0.75f, 0.25f, 1.0f), "状态：冷却中，剩余 %.1f 秒", skill->cooldown_timer_);
+            ImGui::TextColored(ImVec4(0.35f, 1.0f, 0.45f, 1.0f), "状态：激活中，剩余 %.1f 秒", duration_left);
+        } else if (cooldown_left > 0.0f) {
+            ImGui::TextColored(ImVec4(1.0f, 0.75f, 0.25f, 1.0f), "状态：冷却中，剩余 %.1f 秒", cooldown_left);
         } else {
             ImGui::TextColored(ImVec4(0.65f, 1.0f, 0.65f, 1.0f), "状态：就绪，可释放");
         }
@@ -146,9 +154,9 @@ void renderSelectedUnitPanel(entt::registry& registry,
             ImGui::Text("被动回费：%.2f", skill_bp.cost_regen_);
         } else {
             ImGui::Text("总冷却：%.1f 秒", skill_bp.cooldown_);
-            ImGui::Text("剩余冷却：%.1f 秒", skill->cooldown_timer_);
+            ImGui::Text("剩余冷却：%.1f 秒", cooldown_left);
             ImGui::Text("总持续：%.1f 秒", skill_bp.duration_);
-            ImGui::Text("剩余持续：%.1f 秒", skill->duration_timer_);
+            ImGui::Text("剩余持续：%.1f 秒", duration_left);
             ImGui::Text("攻击 x%.2f  防御 x%.2f  射程 x%.2f  间隔 x%.2f",
                         skill_bp.atk_multiplier_,
                         skill_bp.def_multiplier_,
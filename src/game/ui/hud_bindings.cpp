@@ -0,0 +1,81 @@
+#include "hud_bindings.h"
+
+#include "../../engine/ui/ui_text.h"
+#include <algorithm>
+#include <charconv>
+#include <format>
+
+namespace game::ui {
+
+namespace {
+
+constexpr std::string_view stateText(int state) {
+    switch (static_cast<HudState>(state)) {
+        case HudState::PAUSED: return "Paused";
+        case HudState::GAME_OVER: return "Game Over";
+        default: return "Playing";
+    }
+}
+
+} // namespace
+
+StatTextBinding::StatTextBinding(engine::ui::UIText& text, std::string_view prefix)
+    : text_(text),
+      prefix_length_(std::min(prefix.size(), buffer_.size() / 2)) {
+    std::copy_n(prefix.begin(), prefix_length_, buffer_.begin());
+}
+
+void StatTextBinding::setValue(int value) {
+    char* begin = buffer_.data() + prefix_length_;
+    const auto result = std::to_chars(begin, buffer_.data() + buffer_.size(), value);
+    text_.setText(std::string_view(buffer_.data(), static_cast<std::size_t>(result.ptr - buffer_.data())));
+}
+
+HudBindings::HudBindings(engine::ui::UIText& status_text,
+                         engine::ui::UIText* gold_text,
+                         const std::string& level_name,
+                         const std::string& selected_name)
+    : status_text_(status_text),
+      level_name_(level_name),
+      selected_name_(selected_name) {
+    using namespace engine::interface;
+    connections_[0] = home_hp_.onChanged().connect<&HudBindings::onStatChanged<HealthChanged>>(this);
+    connections_[1] = wave_.onChanged().connect<&HudBindings::onStatChanged<WaveChanged>>(this);
+    connections_[2] = state_.onChanged().connect<&HudBindings::onStatChanged<StateChanged>>(this);
+    connections_[3] = selected_.onChanged().connect<&HudBindings::onStatChanged<SelectionChanged>>(this);
+    if (gold_text) {
+        gold_binding_ = std::make_unique<StatTextBinding>(*gold_text, "Gold ");
+        connections_[4] = gold_.onChanged().connect<&StatTextBinding::onChanged<GoldChanged>>(*gold_binding_);
+    }
+}
+
+void HudBindings::publish(int gold, int home_hp, int wave, HudState state, entt::id_type selected_id) {
+    gold_.set(gold);
+    home_hp_.set(home_hp);
+    wave_.set(wave);
+    state_.set(static_cast<int>(state));
+    selected_.set(static_cast<int>(selected_id));
+    if (status_dirty_) {
+        rebuildStatus();
+    }
+}
+
+void HudBindings::invalidate() {
+    status_dirty_ = true;
+}
+
+void HudBindings::rebuildStatus() {
+    status_dirty_ = false;
+    // 超长时截断而不是分配
+    char* out = status_buffer_.data();
+    char* const end = status_buffer_.data() + status_buffer_.size();
+    out = std::format_to_n(out, end - out, "{} | Wave {} | HP {} | {}",
+                           level_name_, wave_.get(), home_hp_.get(), stateText(state_.get())).out;
+    if (!selected_name_.empty() && out < end) {
+        out = std::format_to_n(out, end - out, " | Selected {}", selected_name_).out;
+    }
+    out = std::min(out, end);
+    status_text_.setText(std::string_view(status_buffer_.data(), static_cast<std::size_t>(out - status_buffer_.data())));
+}
+
+} // namespace game::ui
@@ -0,0 +1,105 @@
+#pragma once
+/**
+ * @file hud_bindings.h
+ * @brief 定义 HudBindings，把 HUD 文本绑定到可观察的整数统计项上。
+ *
+ * @details
+ * 场景每帧只把整数（金币、基地生命、波次、游戏状态、选中单位 ID）写入 publish()；
+ * 值未变化时什么都不做，变化时对应的绑定在固定大小的栈缓冲区里格式化并调用 UIText::setText，
+ * 全程不产生 std::string 临时对象。
+ */
+
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <entt/core/fwd.hpp>
+#include <entt/signal/sigh.hpp>
+#include "../data/observable_stat.h"
+
+namespace engine::ui {
+    class UIText;
+}
+
+namespace game::ui {
+
+/// @brief HUD 显示的游戏状态
+enum class HudState : int {
+    PLAYING,
+    PAUSED,
+    GAME_OVER,
+};
+
+/**
+ * @class StatTextBinding
+ * @brief 「前缀 + 整数」形式的单值文本绑定（如 "Gold 42"），整数直接以 std::to_chars 写入缓冲区
+ */
+class StatTextBinding final {
+public:
+    StatTextBinding(engine::ui::UIText& text, std::string_view prefix);
+
+    /// @brief 连接到任意 StatChanged 通道的监听函数
+    template <typename Event>
+    void onChanged(const Event& event) { setValue(event.value_); }
+
+    void setValue(int value);
+
+private:
+    engine::ui::UIText& text_;
+    std::array<char, 48> buffer_{};
+    std::size_t prefix_length_{ 0 };
+};
+
+/**
+ * @class HudBindings
+ * @brief 持有 HUD 用到的可观察统计项及其文本绑定
+ *
+ * 状态栏文本同时依赖多个统计项，由本类监听它们的变化事件，publish() 末尾最多重建一次；关卡名与选中单位名以引用方式读取，
+ * 前者变化时需调用 invalidate()，后者总是与选中单位 ID 一起变化。
+ */
+class HudBindings final {
+public:
+    /**
+     * @param status_text 状态栏文本（"关卡 | Wave | HP | 状态 | Selected"）
+     * @param gold_text 金币文本，可为空
+     * @param level_name 关卡名（生命周期须长于本对象）
+     * @param selected_name 选中单位名（生命周期须长于本对象）
+     */
+    HudBindings(engine::ui::UIText& status_text,
+                engine::ui::UIText* gold_text,
+                const std::string& level_name,
+                const std::string& selected_name);
+
+    HudBindings(const HudBindings&) = delete;
+    HudBindings& operator=(const HudBindings&) = delete;
+
+    /// @brief 写入本帧的统计值，只有发生变化的项会重新格式化对应文本
+    void publish(int gold, int home_hp, int wave, HudState state, entt::id_type selected_id);
+
+    /// @brief 关卡名等非统计项变化后强制重建状态栏文本
+    void invalidate();
+
+private:
+    template <typename Event>
+    void onStatChanged(const Event&) { status_dirty_ = true; }
+
+    void rebuildStatus();
+
+    engine::ui::UIText& status_text_;
+    const std::string& level_name_;
+    const std::string& selected_name_;
+
+    // 统计项（通道）须先于连接构造、晚于连接析构
+    game::data::ObservableStat<engine::interface::EventType::GOLD_CHANGED> gold_;
+    game::data::ObservableStat<engine::interface::EventType::HEALTH_CHANGED> home_hp_;
+    game::data::ObservableStat<engine::interface::EventType::WAVE_CHANGED> wave_;
+    game::data::ObservableStat<engine::interface::EventType::STATE_CHANGED> state_;
+    game::data::ObservableStat<engine::interface::EventType::SELECTION_CHANGED> selected_;
+
+    std::unique_ptr<StatTextBinding> gold_binding_;
+    std::array<entt::scoped_connection, 5> connections_;   ///< 析构时先于统计项与绑定断开
+    std::array<char, 192> status_buffer_{};
+    bool status_dirty_{ true };
+};
+
+} // namespace game::ui
@@ -0,0 +1,180 @@
+#include "profiler_ui.h"
+
+#include "../component/enemy_component.h"
+#include "../component/player_component.h"
+#include "../../engine/core/context.h"
+#include "../../engine/memory/frame_arena.h"
+#include "../../engine/scene/scene.h"
+#include "../../engine/utils/profiler.h"
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <vector>
+#include <imgui.h>
+
+namespace game::ui {
+
+namespace {
+
+constexpr float FLAME_ROW_HEIGHT = 18.0f;
+
+ImU32 scopeColor(const char* name) {
+    // 同名作用域在不同帧保持同一颜色
+    const auto hash = std::hash<std::string_view>{}(name);
+    const auto r = static_cast<int>(90 + (hash & 0x7F));
+    const auto g = static_cast<int>(90 + ((hash >> 8) & 0x7F));
+    const auto b = static_cast<int>(90 + ((hash >> 16) & 0x7F));
+    return IM_COL32(r, g, b, 255);
+}
+
+void renderFlameGraph(const engine::utils::FrameCapture& frame) {
+    std::uint32_t max_depth = 0;
+    for (const auto& sample : frame.samples_) {
+        max_depth = std::max(max_depth, sample.depth_);
+    }
+
+    const float width = std::max(ImGui::GetContentRegionAvail().x, 100.0f);
+    const float height = FLAME_ROW_HEIGHT * static_cast<float>(max_depth + 1);
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImGui::InvisibleButton("##flame_graph", ImVec2(width, height));
+
+    const double frame_ns = static_cast<double>(std::max<std::uint64_t>(frame.end_ns_ - frame.start_ns_, 1));
+    const float scale = static_cast<float>(width / frame_ns);
+    auto* draw_list = ImGui::GetWindowDrawList();
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+    const engine::utils::ProfileSample* hovered = nullptr;
+
+    for (const auto& sample : frame.samples_) {
+        // 只绘制主线程记录；其他线程的记录保留在导出的 trace 中
+        if (sample.thread_id_ != 0 || sample.start_ns_ < frame.start_ns_) {
+            continue;
+        }
+        const float x0 = origin.x + static_cast<float>(sample.start_ns_ - frame.start_ns_) * scale;
+        const float x1 = std::max(x0 + 1.0f, origin.x + static_cast<float>(sample.end_ns_ - frame.start_ns_) * scale);
+        const float y0 = origin.y + FLAME_ROW_HEIGHT * static_cast<float>(sample.depth_);
+        const float y1 = y0 + FLAME_ROW_HEIGHT - 1.0f;
+        draw_list->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), scopeColor(sample.name_));
+
+        const float text_width = ImGui::CalcTextSize(sample.name_).x;
+        if (x1 - x0 > text_width + 4.0f) {
+            draw_list->AddText(ImVec2(x0 + 2.0f, y0 + 1.0f), IM_COL32(0, 0, 0, 255), sample.name_);
+        }
+        if (mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1) {
+            hovered = &sample;
+        }
+    }
+
+    if (hovered && ImGui::IsItemHovered()) {
+        ImGui::BeginTooltip();
+        ImGui::Text("%s", hovered->name_);
+        ImGui::Text("%.3f ms", static_cast<double>(hovered->end_ns_ - hovered->start_ns_) / 1.0e6);
+        ImGui::EndTooltip();
+    }
+}
+
+} // namespace
+
+void ProfilerUI::render(engine::scene::Scene& scene) {
+    auto& profiler = engine::utils::Profiler::instance();
+    const auto& history = profiler.getHistory();
+
+    ImGui::SetNextWindowPos(ImVec2(460.0f, 12.0f), ImGuiCond_Once);
+    ImGui::SetNextWindowSize(ImVec2(560.0f, 420.0f), ImGuiCond_Once);
+    ImGui::SetNextWindowBgAlpha(0.85f);
+    if (!ImGui::Begin("性能分析", nullptr, ImGuiWindowFlags_NoFocusOnAppearing)) {
+        ImGui::End();
+        return;
+    }
+
+    bool enabled = profiler.isEnabled();
+    if (ImGui::Checkbox("启用", &enabled)) {
+        profiler.setEnabled(enabled);
+    }
+    ImGui::SameLine();
+    bool paused = profiler.isCapturePaused();
+    if (ImGui::Checkbox("暂停采集", &paused)) {
+        profiler.setCapturePaused(paused);
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("跟随最新帧", &follow_latest_);
+
+    auto& registry = scene.getRegistry();
+    ImGui::Text("实体：%zu  敌人：%zu  干员：%zu  丢弃记录：%llu",
+        registry.storage<entt::entity>().size(),
+        registry.view<game::component::EnemyComponent>().size(),
+        registry.view<game::component::PlayerComponent>().size(),
+        static_cast<unsigned long long>(profiler.getDroppedCount()));
+
+    if (history.empty()) {
+        ImGui::TextDisabled("暂无采样数据");
+        ImGui::End();
+        return;
+    }
+
+    // 滚动帧耗时曲线
+    auto frame_ms = scene.getContext().getFrameArena().makeVector<float>(history.size());
+    for (const auto& frame : history) {
+        frame_ms.push_back(static_cast<float>(frame.durationMs()));
+    }
+    const float max_ms = *std::max_element(frame_ms.begin(), frame_ms.end());
+    ImGui::PlotLines("##frame_times", frame_ms.data(), static_cast<int>(frame_ms.size()), 0,
+        "帧耗时 (ms)", 0.0f, std::max(max_ms, 16.7f), ImVec2(-1.0f, 60.0f));
+
+    const int last_index = static_cast<int>(history.size()) - 1;
+    if (follow_latest_) {
+        selected_frame_ = last_index;
+    }
+    selected_frame_ = std::clamp(selected_frame_, 0, last_index);
+    if (ImGui::SliderInt("历史帧", &selected_frame_, 0, last_index)) {
+        follow_latest_ = false;
+    }
+
+    const auto& frame = history[static_cast<std::size_t>(selected_frame_)];
+    ImGui::Text("帧 #%llu：%.3f ms  分配：%llu 次 / %llu B", static_cast<unsigned long long>(frame.frame_index_), frame.durationMs(),
+        static_cast<unsigned long long>(frame.allocations_), static_cast<unsigned long long>(frame.allocated_bytes_));
+    for (const auto& [name, value] : frame.counters_) {
+        ImGui::SameLine();
+        ImGui::Text(" %s=%lld", name, static_cast<long long>(value));
+    }
+    renderFlameGraph(frame);
+
+    // 各作用域分位数统计
+    if (ImGui::BeginTable("##scope_stats", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY,
+            ImVec2(0.0f, 160.0f))) {
+        ImGui::TableSetupColumn("作用域");
+        ImGui::TableSetupColumn("最近(ms)");
+        ImGui::TableSetupColumn("p50(ms)");
+        ImGui::TableSetupColumn("p99(ms)");
+        ImGui::TableSetupColumn("次数");
+        ImGui::TableSetupColumn("分配");
+        ImGui::TableHeadersRow();
+        for (const auto& stats : profiler.computeScopeStats()) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(stats.name_);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.last_ms_);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.p50_ms_);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.p99_ms_);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", stats.calls_);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", stats.allocations_);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::InputInt("导出帧数", &export_frame_count_);
+    export_frame_count_ = std::max(export_frame_count_, 1);
+    ImGui::SameLine();
+    if (ImGui::Button("导出 Chrome Trace")) {
+        profiler.exportChromeTrace("profile_trace.json", static_cast<std::size_t>(export_frame_count_));
+    }
+
+    ImGui::End();
+}
+
+} // namespace game::ui
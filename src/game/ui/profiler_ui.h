@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+namespace engine::scene {
+    class Scene;
+}
+
+namespace game::ui {
+
+/**
+ * @brief 性能分析面板：帧耗时曲线、选中帧火焰图、各作用域 p50/p99 与实体数量
+ */
+class ProfilerUI final {
+public:
+    void render(engine::scene::Scene& scene);
+
+private:
+    bool follow_latest_{true};      ///< 是否始终显示最新一帧
+    int selected_frame_{0};         ///< 火焰图显示的历史帧下标
+    int export_frame_count_{120};   ///< 导出的帧数
+};
+
+} // namespace game::ui
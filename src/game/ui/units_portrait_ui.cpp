@@ -2,11 +2,11 @@
 
 #include "../data/session_data.h"
 #include "../data/ui_config.h"
-#include "../data/game_stats.h"
 #include "../defs/event.h"
 #include "../factory/entity_factory.h"
 #include "../../engine/core/context.h"
 #include "../../engine/core/game_state.h"
+#include "../../engine/input/input_manager.h"
 #include "../../engine/render/image.h"
 #include "../../engine/ui/ui_button.h"
 #include "../../engine/ui/ui_image.h"
@@ -16,6 +16,7 @@
 #include "../../engine/ui/state/hover_state.h"
 #include "../../engine/ui/state/pressed_state.h"
 #include <algorithm>
+#include <cmath>
 #include <glm/vec2.hpp>
 #include <memory>
 #include <string>
@@ -23,112 +24,231 @@
 
 namespace game::ui {
 
-void rebuildUnitsPortraitUI(engine::ui::UIPanel& anchor_panel,
-                            engine::core::Context& context,
-                            const game::data::SessionData& session_data,
-                            const game::data::UIConfig& ui_config,
-                            const game::factory::EntityFactory& entity_factory,
-                            const game::data::GameStats& game_stats,
-                            const std::vector<entt::id_type>& hidden_unit_portrait_ids,
-                            float scroll_offset_x,
-                            float* content_width,
-                            PortraitClickCallback on_portrait_selected) {
-    anchor_panel.clearChildren();
-
-    const auto& layout = ui_config.getUnitPanelLayout();
-    const auto window_size = context.getGameState().getWindowLogicalSize();
-    const float frame_w = layout.frame_size_.x;
-    const float frame_h = layout.frame_size_.y;
-    const float padding = static_cast<float>(layout.padding_);
+namespace {
+    /// 槽位内子元素的绘制顺序（按钮自带的文本元素为 0）
+    enum ChildOrder : int {
+        PORTRAIT = 1,
+        ICON,
+        COST_TEXT,
+        COVER,
+    };
+
+    /// @brief 有图片时显示并替换，没有时隐藏
+    void showOptionalImage(engine::ui::UIImage& element, const engine::render::Image* image) {
+        if (image) {
+            element.setImage(*image);
+        }
+        element.setVisible(image != nullptr);
+    }
+}
+
+UnitsPortraitUI::UnitsPortraitUI(engine::core::Context& context,
+                                 engine::ui::UIPanel& anchor_panel,
+                                 const game::data::UIConfig& ui_config,
+                                 PortraitClickCallback on_portrait_selected)
+    : context_(context),
+      anchor_panel_(anchor_panel),
+      ui_config_(ui_config),
+      on_portrait_selected_(std::move(on_portrait_selected)) {
+    const auto& layout = ui_config_.getUnitPanelLayout();
+    const auto window_size = context_.getGameState().getWindowLogicalSize();
+    padding_ = static_cast<float>(layout.padding_);
+    stride_ = std::max(layout.frame_size_.x + padding_, 1.0f);
+    viewport_width_ = window_size.x - padding_ * 2.0f;
+    slot_capacity_ = static_cast<std::size_t>(std::ceil(viewport_width_ / stride_)) + 1;
+
+    const float panel_height = layout.frame_size_.y + padding_ * 2.0f;
+    anchor_panel_.clearChildren();
+    anchor_panel_.setPosition(glm::vec2{ padding_, window_size.y - panel_height });
+    anchor_panel_.setSize(glm::vec2{ viewport_width_, panel_height });
+    anchor_panel_.setClipChildren(true);
+    slots_.reserve(slot_capacity_);
+}
 
-    std::vector<const game::data::UnitData*> units;
-    units.reserve(session_data.getUnitMap().size());
+void UnitsPortraitUI::setUnits(const game::data::SessionData& session_data,
+                               const game::factory::EntityFactory& entity_factory,
+                               const std::vector<entt::id_type>& hidden_unit_portrait_ids) {
+    entries_.clear();
+    entries_.reserve(session_data.getUnitMap().size());
     for (const auto& [_, unit] : session_data.getUnitMap()) {
-        units.push_back(&unit);
+        if (std::find(hidden_unit_portrait_ids.begin(), hidden_unit_portrait_ids.end(), unit.name_id_) != hidden_unit_portrait_ids.end()) {
+            continue;
+        }
+        entries_.push_back({ &unit, entity_factory.getPlayerUnitCost(unit.class_id_, unit.rarity_) });
     }
-
-    std::sort(units.begin(), units.end(), [&entity_factory](const auto* lhs, const auto* rhs) {
-        const int lhs_cost = entity_factory.getPlayerUnitCost(lhs->class_id_, lhs->rarity_);
-        const int rhs_cost = entity_factory.getPlayerUnitCost(rhs->class_id_, rhs->rarity_);
-        if (lhs_cost != rhs_cost) {
-            return lhs_cost < rhs_cost;
+    std::sort(entries_.begin(), entries_.end(), [](const Entry& lhs, const Entry& rhs) {
+        if (lhs.cost_ != rhs.cost_) {
+            return lhs.cost_ < rhs.cost_;
         }
-        return lhs->name_ < rhs->name_;
+        return lhs.unit_->name_ < rhs.unit_->name_;
     });
 
-    const int visible_count = static_cast<int>(std::count_if(units.begin(), units.end(), [&hidden_unit_portrait_ids](const auto* unit) {
-        return std::find(hidden_unit_portrait_ids.begin(), hidden_unit_portrait_ids.end(), unit->name_id_) == hidden_unit_portrait_ids.end();
-    }));
-    const float content_width_value = padding + static_cast<float>(visible_count) * (frame_w + padding);
-    if (content_width) {
-        *content_width = content_width_value;
+    const std::size_t needed = std::min(slot_capacity_, entries_.size());
+    while (slots_.size() < needed) {
+        createSlot(slots_.size());
+    }
+    // 列表变化后下标全部失效，在 refreshVisible 中重新绑定
+    for (auto& slot : slots_) {
+        slot.entry_ = NO_ENTRY;
     }
 
-    const float panel_width = window_size.x - padding * 2.0f;
-    const float panel_height = frame_h + padding * 2.0f;
-
-    anchor_panel.setPosition(glm::vec2{ padding, window_size.y - panel_height });
-    anchor_panel.setSize(glm::vec2{ panel_width, panel_height });
+    scroll_x_ = std::clamp(scroll_x_, 0.0f, getMaxScroll());
+    refreshVisible();
+}
 
-    size_t visible_index = 0;
-    for (const auto* unit : units) {
-        if (std::find(hidden_unit_portrait_ids.begin(), hidden_unit_portrait_ids.end(), unit->name_id_) != hidden_unit_portrait_ids.end()) {
-            continue;
+void UnitsPortraitUI::setCost(int cost) {
+    if (cost == cost_) {
+        return;
+    }
+    cost_ = cost;
+    for (auto& slot : slots_) {
+        if (slot.entry_ != NO_ENTRY) {
+            applyAffordable(slot, entries_[slot.entry_].cost_ <= cost_);
         }
+    }
+}
 
-        const auto* portrait = ui_config.getPortrait(unit->name_id_);
-        const auto* icon = ui_config.getIcon(unit->class_id_);
-        const int cost = entity_factory.getPlayerUnitCost(unit->class_id_, unit->rarity_);
-        const bool affordable = cost <= game_stats.cost_;
-        const auto* frame = ui_config.getPortraitFrame(affordable ? 2 : 1);
-
-        auto frame_panel = std::make_unique<engine::ui::UIButton>(context, std::string{}, layout.font_path_, layout.font_size_);
-        frame_panel->setPosition({ padding + static_cast<float>(visible_index) * (frame_w + padding) - scroll_offset_x, padding });
-        frame_panel->setSize(layout.frame_size_);
-        frame_panel->setId(unit->name_id_);
-        frame_panel->setInteractive(true);
-        frame_panel->setClickCallback([on_portrait_selected, unit, cost, affordable]() {
-            if (affordable && on_portrait_selected) {
-                on_portrait_selected(*unit, cost);
-            }
-        });
-        frame_panel->setHoverEnterCallback([&context, name_id = unit->name_id_]() {
-            context.getDispatcher().trigger(game::defs::UIPortraitHoverEnterEvent{ name_id });
-        });
-        frame_panel->setHoverLeaveCallback([&context]() {
-            context.getDispatcher().trigger(game::defs::UIPortraitHoverLeaveEvent{});
-        });
-
-        if (portrait) {
-            frame_panel->addChild(std::make_unique<engine::ui::UIImage>(context, *portrait, glm::vec2{ 8.0f, 8.0f }, glm::vec2{ frame_w - 16.0f, frame_h - 16.0f }));
-        }
-        if (frame) {
-            frame_panel->addImage(engine::resource::typeId<engine::ui::state::NormalState>(), std::make_unique<engine::render::Image>(*frame));
-            frame_panel->addImage(engine::resource::typeId<engine::ui::state::HoverState>(), std::make_unique<engine::render::Image>(*frame));
-            frame_panel->addImage(engine::resource::typeId<engine::ui::state::PressedState>(), std::make_unique<engine::render::Image>(*frame));
-        }
-        if (icon) {
-            frame_panel->addChild(std::make_unique<engine::ui::UIImage>(context, *icon, glm::vec2{ 8.0f, 8.0f }, glm::vec2{ 32.0f, 32.0f }));
+bool UnitsPortraitUI::scrollBy(float delta) {
+    const float next = std::clamp(scroll_x_ + delta, 0.0f, getMaxScroll());
+    if (next == scroll_x_) {
+        return false;
+    }
+    scroll_x_ = next;
+    refreshVisible();
+    return true;
+}
+
+float UnitsPortraitUI::getMaxScroll() const {
+    const float content_width = padding_ + static_cast<float>(entries_.size()) * stride_;
+    return std::max(0.0f, content_width - viewport_width_);
+}
+
+void UnitsPortraitUI::createSlot(std::size_t slot_index) {
+    const auto& layout = ui_config_.getUnitPanelLayout();
+    const float frame_w = layout.frame_size_.x;
+    const float frame_h = layout.frame_size_.y;
+
+    auto button = std::make_unique<engine::ui::UIButton>(context_, std::string{}, layout.font_path_, layout.font_size_);
+    button->setSize(layout.frame_size_);
+    button->setInteractive(true);
+    button->setClickCallback([this, slot_index]() { onSlotClicked(slot_index); });
+    button->setHoverEnterCallback([this, slot_index]() { onSlotHoverEnter(slot_index); });
+    button->setHoverLeaveCallback([this]() {
+        context_.getDispatcher().trigger(game::defs::UIPortraitHoverLeaveEvent{});
+    });
+    button->setVisible(false);
+
+    Slot slot;
+    slot.button_ = button.get();
+
+    auto portrait = std::make_unique<engine::ui::UIImage>(context_, engine::render::Image{}, glm::vec2{ 8.0f, 8.0f }, glm::vec2{ frame_w - 16.0f, frame_h - 16.0f });
+    slot.portrait_ = portrait.get();
+    button->addChild(std::move(portrait), PORTRAIT);
+
+    auto icon = std::make_unique<engine::ui::UIImage>(context_, engine::render::Image{}, glm::vec2{ 8.0f, 8.0f }, glm::vec2{ 32.0f, 32.0f });
+    slot.icon_ = icon.get();
+    button->addChild(std::move(icon), ICON);
+
+    auto cost_text = std::make_unique<engine::ui::UIText>(context_, std::string{}, layout.font_path_, layout.font_size_);
+    cost_text->setPosition(layout.font_offset_);
+    cost_text->setColor({ 1.0f, 1.0f, 0.85f, 1.0f });
+    slot.cost_text_ = cost_text.get();
+    button->addChild(std::move(cost_text), COST_TEXT);
+
+    auto cover = std::make_unique<engine::ui::UIPanel>(context_);
+    cover->setSize(layout.frame_size_);
+    cover->setBackgroundColor({ 0.45f, 0.45f, 0.45f, 0.45f });
+    slot.cover_ = cover.get();
+    button->addChild(std::move(cover), COVER);
+    button->sortChildrenByOrderIndex();
+
+    anchor_panel_.addChild(std::move(button));
+    slots_.push_back(slot);
+}
+
+void UnitsPortraitUI::refreshVisible() {
+    if (slots_.empty()) {
+        return;
+    }
+    // 第 first 个肖像的右边缘恰好不早于视口左边缘；last 为第一个左边缘越过视口右边缘的肖像
+    const std::size_t first = std::min(entries_.size(), static_cast<std::size_t>(scroll_x_ / stride_));
+    const std::size_t last = std::min(entries_.size(),
+        static_cast<std::size_t>(std::max(0.0f, std::ceil((viewport_width_ + scroll_x_ - padding_) / stride_))));
+
+    for (std::size_t index = first; index < last; ++index) {
+        auto& slot = slots_[index % slots_.size()];
+        bindSlot(slot, index);
+        slot.button_->setPosition({ padding_ + static_cast<float>(index) * stride_ - scroll_x_, padding_ });
+        slot.button_->setVisible(true);
+    }
+    for (auto& slot : slots_) {
+        if (slot.entry_ == NO_ENTRY || slot.entry_ < first || slot.entry_ >= last) {
+            slot.button_->setVisible(false);
         }
+    }
+}
 
-        auto cost_text = std::make_unique<engine::ui::UIText>(context, std::to_string(cost), layout.font_path_, layout.font_size_);
-        cost_text->setPosition(layout.font_offset_);
-        cost_text->setColor({ 1.0f, 1.0f, 0.85f, 1.0f });
-        frame_panel->addChild(std::move(cost_text));
+void UnitsPortraitUI::bindSlot(Slot& slot, std::size_t entry_index) {
+    if (slot.entry_ == entry_index) {
+        return;
+    }
+    const bool rebinding = slot.entry_ != NO_ENTRY && slot.button_->isVisible();
+    slot.entry_ = entry_index;
+
+    const auto& entry = entries_[entry_index];
+    slot.button_->setId(entry.unit_->name_id_);
+    showOptionalImage(*slot.portrait_, ui_config_.getPortrait(entry.unit_->name_id_));
+    showOptionalImage(*slot.icon_, ui_config_.getIcon(entry.unit_->class_id_));
+    slot.cost_text_->setText(std::to_string(entry.cost_));
+    slot.affordable_ = entry.cost_ > cost_;     // 保证下面一定刷新边框
+    applyAffordable(slot, entry.cost_ <= cost_);
+
+    // 悬停中的槽位换了单位：按钮的悬停状态保持不变，需要手动通知新单位的悬停
+    if (rebinding && slot.button_->containsPoint(context_.getInputManager().getLogicalMousePosition())) {
+        context_.getDispatcher().trigger(game::defs::UIPortraitHoverEnterEvent{ entry.unit_->name_id_ });
+    }
+}
 
-        auto cover_panel = std::make_unique<engine::ui::UIPanel>(context);
-        cover_panel->setPosition({ 0.0f, 0.0f });
-        cover_panel->setSize(layout.frame_size_);
-        cover_panel->setBackgroundColor(affordable ? engine::utils::FColor{ 0.0f, 0.0f, 0.0f, 0.0f }
-                                                   : engine::utils::FColor{ 0.45f, 0.45f, 0.45f, 0.45f });
-        cover_panel->setVisible(!affordable);
-        frame_panel->addChild(std::move(cover_panel));
+void UnitsPortraitUI::applyAffordable(Slot& slot, bool affordable) {
+    if (slot.affordable_ == affordable) {
+        return;
+    }
+    slot.affordable_ = affordable;
+    slot.cover_->setVisible(!affordable);
 
-        anchor_panel.addChild(std::move(frame_panel), cost);
-        ++visible_index;
+    const auto* frame = ui_config_.getPortraitFrame(affordable ? 2 : 1);
+    if (!frame) {
+        return;
     }
+    // 原地替换各状态的图片：按钮当前图片指针保持有效
+    for (const auto state_id : { engine::resource::typeId<engine::ui::state::NormalState>(),
+                                 engine::resource::typeId<engine::ui::state::HoverState>(),
+                                 engine::resource::typeId<engine::ui::state::PressedState>() }) {
+        if (auto* image = slot.button_->getImage(state_id)) {
+            *image = *frame;
+        } else {
+            slot.button_->addImage(state_id, std::make_unique<engine::render::Image>(*frame));
+        }
+    }
+    slot.button_->markDirty();
+}
 
-    anchor_panel.sortChildrenByOrderIndex();
+void UnitsPortraitUI::onSlotClicked(std::size_t slot_index) const {
+    const auto& slot = slots_[slot_index];
+    if (slot.entry_ == NO_ENTRY || !on_portrait_selected_) {
+        return;
+    }
+    const auto& entry = entries_[slot.entry_];
+    if (entry.cost_ <= cost_) {
+        on_portrait_selected_(*entry.unit_, entry.cost_);
+    }
+}
+
+void UnitsPortraitUI::onSlotHoverEnter(std::size_t slot_index) const {
+    const auto& slot = slots_[slot_index];
+    if (slot.entry_ != NO_ENTRY) {
+        context_.getDispatcher().trigger(game::defs::UIPortraitHoverEnterEvent{ entries_[slot.entry_].unit_->name_id_ });
+    }
 }
 
 } // namespace game::ui
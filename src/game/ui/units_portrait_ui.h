@@ -1,6 +1,17 @@
 #pragma once
+/**
+ * @file units_portrait_ui.h
+ * @brief 定义 UnitsPortraitUI，底部单位肖像栏的常驻控件集合。
+ *
+ * @details
+ * 肖像按费用排序后横向排列，锚点面板裁剪子元素实现滚动。列表是虚拟化的：只创建能同时出现在
+ * 视口内的槽位（视口宽度 / 步长 + 1 个），第 i 个单位固定使用第 i % 槽位数 个槽位，滚动一格只需
+ * 重新绑定一个槽位。金币变化时只切换状态翻转的槽位（边框图片与灰色遮罩），不重建任何控件。
+ */
 
+#include <cstddef>
 #include <functional>
+#include <limits>
 #include <vector>
 #include <entt/core/hashed_string.hpp>
 
@@ -8,12 +19,14 @@ namespace engine::core {
     class Context;
 }
 namespace engine::ui {
+    class UIButton;
+    class UIImage;
     class UIPanel;
+    class UIText;
 }
 namespace game::data {
     class SessionData;
     class UIConfig;
-    struct GameStats;
     struct UnitData;
 }
 namespace game::factory {
@@ -24,15 +37,74 @@ namespace game::ui {
 
 using PortraitClickCallback = std::function<void(const game::data::UnitData&, int)>;
 
-void rebuildUnitsPortraitUI(engine::ui::UIPanel& anchor_panel,
-                            engine::core::Context& context,
-                            const game::data::SessionData& session_data,
-                            const game::data::UIConfig& ui_config,
-                            const game::factory::EntityFactory& entity_factory,
-                            const game::data::GameStats& game_stats,
-                            const std::vector<entt::id_type>& hidden_unit_portrait_ids,
-                            float scroll_offset_x,
-                            float* content_width,
-                            PortraitClickCallback on_portrait_selected);
+class UnitsPortraitUI final {
+public:
+    /**
+     * @param anchor_panel 肖像栏面板（由调用方加入 UI 树，本类只管理其子元素并设置其位置与尺寸）
+     * @param on_portrait_selected 点击可负担的肖像时调用
+     */
+    UnitsPortraitUI(engine::core::Context& context,
+                    engine::ui::UIPanel& anchor_panel,
+                    const game::data::UIConfig& ui_config,
+                    PortraitClickCallback on_portrait_selected);
+    UnitsPortraitUI(const UnitsPortraitUI&) = delete;
+    UnitsPortraitUI& operator=(const UnitsPortraitUI&) = delete;
+
+    /// @brief 重新收集并按费用排序单位列表（进入关卡、肖像被移除时调用）
+    void setUnits(const game::data::SessionData& session_data,
+                  const game::factory::EntityFactory& entity_factory,
+                  const std::vector<entt::id_type>& hidden_unit_portrait_ids);
+
+    /// @brief 按当前金币刷新可负担状态，只修改状态发生翻转的槽位
+    void setCost(int cost);
+
+    /// @brief 水平滚动 delta 像素（夹在内容范围内）
+    /// @return 滚动位置是否变化
+    bool scrollBy(float delta);
+
+    [[nodiscard]] float getScroll() const { return scroll_x_; }
+    [[nodiscard]] float getMaxScroll() const;
+    [[nodiscard]] std::size_t getSlotCount() const { return slots_.size(); }
+
+private:
+    static constexpr std::size_t NO_ENTRY = std::numeric_limits<std::size_t>::max();
+
+    struct Entry {
+        const game::data::UnitData* unit_{nullptr};
+        int cost_{0};
+    };
+
+    struct Slot {
+        engine::ui::UIButton* button_{nullptr};
+        engine::ui::UIImage* portrait_{nullptr};
+        engine::ui::UIImage* icon_{nullptr};
+        engine::ui::UIText* cost_text_{nullptr};
+        engine::ui::UIPanel* cover_{nullptr};
+        std::size_t entry_{NO_ENTRY};       ///< 当前绑定的 entries_ 下标
+        bool affordable_{false};
+    };
+
+    void createSlot(std::size_t slot_index);
+    /// @brief 按滚动位置绑定可见范围内的单位，隐藏其余槽位
+    void refreshVisible();
+    void bindSlot(Slot& slot, std::size_t entry_index);
+    void applyAffordable(Slot& slot, bool affordable);
+    void onSlotClicked(std::size_t slot_index) const;
+    void onSlotHoverEnter(std::size_t slot_index) const;
+
+    engine::core::Context& context_;
+    engine::ui::UIPanel& anchor_panel_;
+    const game::data::UIConfig& ui_config_;
+    PortraitClickCallback on_portrait_selected_;
+
+    std::vector<Entry> entries_;        ///< 未隐藏的单位，按费用、名称排序
+    std::vector<Slot> slots_;
+    std::size_t slot_capacity_{0};      ///< 视口内最多同时可见的肖像数
+    float padding_{0.0f};
+    float stride_{0.0f};                ///< 相邻肖像的间距（宽度 + 留白）
+    float viewport_width_{0.0f};
+    float scroll_x_{0.0f};
+    int cost_{0};
+};
 
 } // namespace game::ui
@@ -5,23 +5,51 @@
 
 #include "engine/core/game_app.h"
 #include<spdlog/spdlog.h>
+#include <spdlog/async.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
 #include "engine/scene/scene_manager.h"
+#include "game/scene/render_benchmark_scene.h"
+#include "game/scene/game_scene.h"
 #include "game/scene/title_scene.h"
+#include "game/factory/blueprint_manager.h"
+#include "game/data/ui_config.h"
+#include "game/sim/headless_simulation.h"
+#include "game/sim/batch_runner.h"
+#include "game/sim/perf_scenario.h"
+#include "game/sim/ab_harness.h"
+#include "game/data/class_cost_profiler.h"
+#include "game/sim/lockstep_session.h"
 #include "engine/core/context.h"
-#include "engine/utils/logging.h"
+#include "engine/core/startup_profiler.h"
+#include "engine/core/time.h"
+#include "engine/io/virtual_fs.h"
+#include "engine/loader/level_loader.h"
+#include "engine/memory/allocation_counter.h"
+#include "engine/memory/memory_tracker.h"
+#include "engine/resource/resource_manager.h"
+#include "engine/utils/deferred_log.h"
 #include <entt/signal/dispatcher.hpp>
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <random>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
-static std::string getRendererBackendFromArgs(int argc, char* argv[])
+static std::string getArgValue(int argc, char* argv[], std::string_view prefix)
 {
     for (int i = 1; i < argc; ++i) {
         if (argv[i] == nullptr) {
             continue;
         }
 
-        constexpr std::string_view prefix = "--renderer=";
         std::string_view arg = argv[i];
         if (arg.starts_with(prefix)) {
             return std::string(arg.substr(prefix.size()));
@@ -30,6 +58,483 @@ static std::string getRendererBackendFromArgs(int argc, char* argv[])
 
     return {};
 }
+
+static bool hasArg(int argc, char* argv[], std::string_view flag)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i] != nullptr && std::string_view(argv[i]) == flag) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::string getRendererBackendFromArgs(int argc, char* argv[])
+{
+    return getArgValue(argc, argv, "--renderer=");
+}
+
+/**
+ * @brief 初始化日志输出
+ * @param log_file 日志文件路径（为空时只输出到控制台）
+ *
+ * @details
+ * 指定日志文件时改用异步 logger：控制台与文件 sink 由后台线程写入，
+ * 队列满时丢弃最旧的消息（overrun_oldest），保证写日志不会阻塞游戏帧。
+ * 同时启动延迟日志的后台线程：ENGINE_LOG_*_DEFERRED 的调用点只记录原始参数，格式化在该线程上进行。
+ */
+static void setupLogging(const std::string& log_file)
+{
+    if (!log_file.empty()) {
+        try {
+            constexpr std::size_t queue_size = 8192;
+            spdlog::init_thread_pool(queue_size, 1);
+            auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+            auto file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(log_file, true);
+            auto logger = std::make_shared<spdlog::async_logger>(
+                "async",
+                spdlog::sinks_init_list{ console_sink, file_sink },
+                spdlog::thread_pool(),
+                spdlog::async_overflow_policy::overrun_oldest);
+            spdlog::set_default_logger(std::move(logger));
+        } catch (const spdlog::spdlog_ex& e) {
+            spdlog::error("无法创建日志文件 '{}': {}", log_file, e.what());
+        }
+    }
+
+    spdlog::set_level(spdlog::level::debug);
+    spdlog::flush_on(spdlog::level::warn);
+    engine::utils::log::DeferredLog::instance().start();
+}
+
+/// @brief 写出延迟日志的剩余记录后关闭 spdlog
+static void shutdownLogging()
+{
+    engine::utils::log::DeferredLog::instance().stop();
+    spdlog::shutdown();
+}
+/**
+ * @brief 以两个注册的实现各跑一份无头模拟，逐步比对状态并输出各自的耗时分布。
+ * @param slot 被替换的槽位（"set_target" / "block"）
+ * @param variants "A,B"（基准, 候选），为空时两份都用 "default"（确定性自检）
+ * @return 进程退出码；两个实现在某一步分歧时为 3
+ */
+static int runAbComparison(game::sim::HeadlessOptions options, const std::string& slot, const std::string& variants)
+{
+    game::sim::AbOptions ab_options;
+    const auto parsed_slot = game::sim::parseSystemSlot(slot);
+    if (!parsed_slot) {
+        spdlog::error("未知的 A/B 槽位: {}（可选 set_target、block）", slot);
+        return 1;
+    }
+    ab_options.slot_ = *parsed_slot;
+    if (!variants.empty()) {
+        const auto comma = variants.find(',');
+        if (comma == std::string::npos || comma == 0 || comma + 1 == variants.size()) {
+            spdlog::error("--variants 须为 A,B 形式: {}", variants);
+            return 1;
+        }
+        ab_options.variant_a_ = variants.substr(0, comma);
+        ab_options.variant_b_ = variants.substr(comma + 1);
+    }
+    ab_options.base_ = std::move(options);
+
+    game::sim::AbHarness harness(std::move(ab_options));
+    const auto report = harness.run();
+    if (!report.ok_) {
+        return 1;
+    }
+    return report.divergence_tick_ ? 3 : 0;
+}
+
+/**
+ * @brief 以无头模式运行固定步长模拟并输出吞吐量。
+ * @details 参数：--ticks=N（步数）、--level=N（从 1 开始的关卡序号）、--dt=秒（固定步长）、
+ *          --replay=路径（重放回放日志，关卡/步长/种子取自日志，未指定 --ticks 时跑完整局）、
+ *          --seed=N（随机种子，覆盖回放与关卡配置）；
+ *          --ab=set_target|block --variants=A,B 时改为两个实现的逐步对比（见 runAbComparison）。
+ * @return 进程退出码；重放与日志中的校验值不一致时为 2
+ */
+static int runHeadless(int argc, char* argv[])
+{
+    game::sim::HeadlessOptions options;
+    options.replay_path_ = getArgValue(argc, argv, "--replay=");
+    if (!options.replay_path_.empty()) {
+        options.ticks_ = 0;
+    }
+    try {
+        if (const auto ticks = getArgValue(argc, argv, "--ticks="); !ticks.empty()) {
+            options.ticks_ = std::stoull(ticks);
+        }
+        if (const auto level = getArgValue(argc, argv, "--level="); !level.empty()) {
+            options.level_index_ = static_cast<std::size_t>(std::max(1, std::stoi(level)) - 1);
+        }
+        if (const auto seed = getArgValue(argc, argv, "--seed="); !seed.empty()) {
+            options.seed_ = std::stoull(seed);
+        }
+        if (const auto dt = getArgValue(argc, argv, "--dt="); !dt.empty()) {
+            options.fixed_dt_ = std::max(1.0e-4f, std::stof(dt));
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("无头模式参数无效: {}", e.what());
+        return 1;
+    }
+    if (const auto slot = getArgValue(argc, argv, "--ab="); !slot.empty()) {
+        return runAbComparison(std::move(options), slot, getArgValue(argc, argv, "--variants="));
+    }
+
+    game::sim::HeadlessSimulation simulation(options);
+    if (!simulation.init()) {
+        spdlog::error("无头模拟初始化失败");
+        return 1;
+    }
+
+    const auto report = simulation.run();
+    spdlog::info("无头模拟完成: ticks={} sim={:.1f}s wall={:.3f}s ticks/sec={:.0f}",
+        report.ticks_, report.simulated_seconds_, report.wall_seconds_, report.ticks_per_second_);
+    spdlog::info("实体: alive={} peak={}  波次={}  敌人 生成={} 击杀={} 到达={}  基地生命={}",
+        report.alive_entities_, report.peak_entities_, report.waves_started_,
+        report.stats_.enemy_count_, report.stats_.enemy_killed_count_, report.stats_.enemy_arrived_count_,
+        report.stats_.home_hp_);
+    spdlog::info("最慢的一步: tick={} {:.3f}ms  回放指令={}", report.slowest_tick_, report.slowest_tick_ms_, report.replay_commands_);
+    if (report.desync_tick_) {
+        spdlog::error("重放失步: tick={} 组件={}（此前 {} 个校验值一致）",
+            *report.desync_tick_, game::sim::describeChecksumDiff(report.desync_components_), report.checksums_verified_);
+        return 2;
+    }
+    if (report.checksums_verified_ > 0) {
+        spdlog::info("重放校验: {} 个校验值全部一致", report.checksums_verified_);
+    }
+    return 0;
+}
+
+/// @brief 解析逗号分隔的列表（如 "1,2,3"），空字符串得到空列表
+static std::vector<std::string> splitList(const std::string& text)
+{
+    std::vector<std::string> items;
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+        const auto end = std::min(text.find(',', begin), text.size());
+        if (end > begin) {
+            items.push_back(text.substr(begin, end - begin));
+        }
+        begin = end + 1;
+    }
+    return items;
+}
+
+/**
+ * @brief 多实例并行的批量无头模拟，结果写出为 CSV。
+ * @details 参数：--level=N、--runs=N（每种组合的种子数）、--seed=N（起始种子）、
+ *          --enemy-levels=1,2,...、--enemy-rarities=1,2,...、--placements=a.mwr,b.mwr（放置方案回放）、
+ *          --max-ticks=N、--dt=秒、--threads=N、--csv=路径。
+ * @return 进程退出码
+ */
+static int runSweep(int argc, char* argv[])
+{
+    game::sim::BatchOptions options;
+    try {
+        if (const auto level = getArgValue(argc, argv, "--level="); !level.empty()) {
+            options.level_index_ = static_cast<std::size_t>(std::max(1, std::stoi(level)) - 1);
+        }
+        if (const auto runs = getArgValue(argc, argv, "--runs="); !runs.empty()) {
+            options.runs_ = std::max<std::uint64_t>(1, std::stoull(runs));
+        }
+        if (const auto seed = getArgValue(argc, argv, "--seed="); !seed.empty()) {
+            options.base_seed_ = std::stoull(seed);
+        }
+        for (const auto& level : splitList(getArgValue(argc, argv, "--enemy-levels="))) {
+            options.enemy_levels_.push_back(std::max(1, std::stoi(level)));
+        }
+        for (const auto& rarity : splitList(getArgValue(argc, argv, "--enemy-rarities="))) {
+            options.enemy_rarities_.push_back(std::max(1, std::stoi(rarity)));
+        }
+        options.placement_paths_ = splitList(getArgValue(argc, argv, "--placements="));
+        if (const auto ticks = getArgValue(argc, argv, "--max-ticks="); !ticks.empty()) {
+            options.max_ticks_ = std::stoull(ticks);
+        }
+        if (const auto dt = getArgValue(argc, argv, "--dt="); !dt.empty()) {
+            options.fixed_dt_ = std::max(1.0e-4f, std::stof(dt));
+        }
+        if (const auto threads = getArgValue(argc, argv, "--threads="); !threads.empty()) {
+            options.threads_ = static_cast<std::size_t>(std::max(1, std::stoi(threads)));
+        }
+        if (const auto csv = getArgValue(argc, argv, "--csv="); !csv.empty()) {
+            options.csv_path_ = csv;
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("批量模拟参数无效: {}", e.what());
+        return 1;
+    }
+
+    game::sim::BatchRunner runner(std::move(options));
+    if (!runner.run()) {
+        spdlog::error("批量模拟失败");
+        return 1;
+    }
+    return runner.writeCsv() ? 0 : 1;
+}
+
+/**
+ * @brief 依次执行压力场景并按阈值判定。
+ * @details 参数：--perf-scenarios[=路径]（默认 assets/data/perf_scenarios.json）、--scenario=名称（只执行该场景）。
+ * @return 进程退出码（任一场景失败时为 1）
+ */
+static int runPerfScenarios(int argc, char* argv[])
+{
+    std::string path = getArgValue(argc, argv, "--perf-scenarios=");
+    if (path.empty()) {
+        path = "assets/data/perf_scenarios.json";
+    }
+    game::sim::PerfScenarioRunner runner;
+    if (!runner.load(path)) {
+        return 1;
+    }
+    return runner.run(getArgValue(argc, argv, "--scenario=")) ? 0 : 1;
+}
+
+/**
+ * @brief 将目录下所有 Tiled 地图预编译为 .mwl 二进制关卡。
+ * @details 参数：--maps=目录（默认 assets/maps）。输出写在各地图同目录，源文件变化后运行时自动回退到 JSON。
+ * @return 进程退出码（任一地图失败时为 1）
+ */
+static int runCookLevels(int argc, char* argv[])
+{
+    std::string maps_dir = getArgValue(argc, argv, "--maps=");
+    if (maps_dir.empty()) {
+        maps_dir = "assets/maps";
+    }
+
+    std::error_code ec;
+    std::size_t cooked = 0;
+    std::size_t failed = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(maps_dir, ec)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".tmj") {
+            continue;
+        }
+        std::string error_message;
+        if (engine::loader::LevelLoader::cookLevel(entry.path().string(), {}, error_message)) {
+            ++cooked;
+        } else {
+            spdlog::error("预编译关卡失败: {}", error_message);
+            ++failed;
+        }
+    }
+    if (ec) {
+        spdlog::error("无法遍历地图目录 '{}': {}", maps_dir, ec.message());
+        return 1;
+    }
+    spdlog::info("关卡预编译完成: 成功 {} 个，失败 {} 个", cooked, failed);
+    return failed == 0 ? 0 : 1;
+}
+
+/**
+ * @brief 将全部蓝图 JSON 预编译为同目录的 .mwb（MessagePack）文件。
+ * @details 源文件修改后运行时自动回退到 JSON；发行包只带 .mwb 时直接读取。
+ * @return 进程退出码（任一文件失败时为 1）
+ */
+static int runCookBlueprints()
+{
+    std::size_t cooked = 0;
+    std::size_t failed = 0;
+    for (const auto& path : game::factory::BlueprintSources{}.paths()) {
+        std::string error_message;
+        if (game::factory::BlueprintManager::cookBlueprintFile(path, error_message)) {
+            ++cooked;
+        } else {
+            spdlog::error("预编译蓝图失败: {}", error_message);
+            ++failed;
+        }
+    }
+    spdlog::info("蓝图预编译完成: 成功 {} 个，失败 {} 个", cooked, failed);
+    return failed == 0 ? 0 : 1;
+}
+
+/// 资源包位于工作目录，条目路径相对工作目录（如 "assets/textures/a.png"）
+static constexpr const char* ASSET_PACK_PATH = "assets.mwpak";
+
+static int runPackAssets(int argc, char* argv[])
+{
+    std::string assets_dir = getArgValue(argc, argv, "--assets=");
+    if (assets_dir.empty()) {
+        assets_dir = "assets";
+    }
+    std::string output_path = getArgValue(argc, argv, "--output=");
+    if (output_path.empty()) {
+        output_path = ASSET_PACK_PATH;
+    }
+
+    std::error_code ec;
+    const auto base = std::filesystem::current_path(ec).string();
+    std::string error_message;
+    if (!engine::io::pack::writeAssetPack(assets_dir, output_path, base, error_message)) {
+        spdlog::error("打包资源失败: {}", error_message);
+        return 1;
+    }
+    spdlog::info("资源打包完成: {}", output_path);
+    return 0;
+}
+
+/**
+ * @brief 解析渲染压测参数
+ * @details --bench-static= / --bench-moving= / --bench-rotated= / --bench-tinted=（各类精灵数）、
+ *          --bench-labels= / --bench-panels=（文字与面板数）、--bench-frames=N（统计帧数，0 一直运行）、
+ *          --bench-warmup=N、--bench-unbatched（逐个绘制）、--bench-single-atlas（只用一张纹理）、--bench-vsync。
+ * @return 参数无效时返回 false
+ */
+static bool parseRenderBenchmarkOptions(int argc, char* argv[], game::scene::RenderBenchmarkOptions& options)
+{
+    const std::pair<std::string_view, int*> counts[] = {
+        { "--bench-static=", &options.static_sprites_ },
+        { "--bench-moving=", &options.moving_sprites_ },
+        { "--bench-rotated=", &options.rotated_sprites_ },
+        { "--bench-tinted=", &options.tinted_sprites_ },
+        { "--bench-labels=", &options.text_labels_ },
+        { "--bench-panels=", &options.ui_panels_ },
+        { "--bench-frames=", &options.frames_ },
+        { "--bench-warmup=", &options.warmup_frames_ },
+    };
+    try {
+        for (const auto& [prefix, value] : counts) {
+            if (const auto text = getArgValue(argc, argv, prefix); !text.empty()) {
+                *value = std::max(0, std::stoi(text));
+            }
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("渲染压测参数无效: {}", e.what());
+        return false;
+    }
+    options.batched_ = !hasArg(argc, argv, "--bench-unbatched");
+    options.mixed_atlases_ = !hasArg(argc, argv, "--bench-single-atlas");
+    options.vsync_ = hasArg(argc, argv, "--bench-vsync");
+    return true;
+}
+
+/**
+ * @brief 解析双人合作参数
+ * @details --coop-host=端口（主机，可配合 --level=N 与 --seed=N）或 --coop-join=主机:端口（加入方，关卡与种子由主机下发）。
+ * @return 两者都未指定时为空；参数无效时 error 为 true
+ */
+static std::optional<std::pair<game::sim::LockstepOptions, game::sim::LockstepMatch>> parseCoopOptions(int argc, char* argv[], bool& error)
+{
+    error = false;
+    const auto host_port = getArgValue(argc, argv, "--coop-host=");
+    const auto join = getArgValue(argc, argv, "--coop-join=");
+    if (host_port.empty() && join.empty()) {
+        return std::nullopt;
+    }
+    game::sim::LockstepOptions options;
+    game::sim::LockstepMatch match;
+    try {
+        if (!host_port.empty()) {
+            options.host_ = true;
+            options.port_ = static_cast<std::uint16_t>(std::stoul(host_port));
+            if (const auto level = getArgValue(argc, argv, "--level="); !level.empty()) {
+                match.level_index_ = static_cast<std::uint32_t>(std::max(1, std::stoi(level)) - 1);
+            }
+            const auto seed = getArgValue(argc, argv, "--seed=");
+            match.seed_ = !seed.empty() ? std::stoull(seed)
+                                        : (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+        } else {
+            options.host_ = false;
+            options.peer_ = engine::io::UdpEndpoint::parse(join);
+            if (!options.peer_) {
+                spdlog::error("无法解析联机地址: {}", join);
+                error = true;
+                return std::nullopt;
+            }
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("联机参数无效: {}", e.what());
+        error = true;
+        return std::nullopt;
+    }
+    return std::make_pair(options, match);
+}
+
+/**
+ * @brief 完成联机握手后直接进入对局；失败时回到标题界面
+ * @details 握手阻塞主线程（最长 LockstepOptions::connect_timeout_ 秒），窗口在此期间不响应。
+ */
+static void setupCoopScene(engine::core::Context& context, const game::sim::LockstepOptions& options, game::sim::LockstepMatch match)
+{
+    match.delta_time_ = context.getTime().getFixedDeltaTime();
+    auto session = std::make_unique<game::sim::LockstepSession>(options);
+    std::unique_ptr<engine::scene::Scene> scene;
+    if (!session->connect(match)) {
+        ENGINE_LOG_ERROR("联机失败，回到标题界面");
+    } else if (match.delta_time_ != context.getTime().getFixedDeltaTime()) {
+        // 步长相同是两端逐步一致的前提，由双方的配置决定，这里不改动本地的 Time
+        ENGINE_LOG_ERROR("联机失败: 主机的固定步长 {} 与本地 {} 不同", match.delta_time_, context.getTime().getFixedDeltaTime());
+    } else {
+        auto game_scene = std::make_unique<game::scene::GameScene>(context, static_cast<std::size_t>(match.level_index_));
+        game_scene->setLockstep(std::move(session), match.seed_);
+        scene = std::move(game_scene);
+    }
+    if (!scene) {
+        scene = std::make_unique<game::scene::TitleScene>(context);
+    }
+    context.getDispatcher().trigger<engine::utils::PushSceneEvent>(engine::utils::PushSceneEvent{ std::move(scene) });
+}
+
+/**
+ * @brief 启动剖析：重复 N 次「启动 → 直接进入关卡 → 本关首帧」，输出各阶段耗时汇总
+ * @details --profile-startup[=N]（默认 5 次）、--level=N（从 1 开始，默认第 1 关）、
+ *          --profile-startup-out=路径（CSV，默认 startup_profile.csv）。第一次为进程冷启动，其余在同一进程内重复；
+ *          冷磁盘缓存的数据需先清空系统文件缓存再启动。阶段见 StartupProfiler（init.* / preload.* / scene.* / level.* / t.*）。
+ * @return 进程退出码（任一次运行没有到达本关首帧时为 1）
+ */
+static int runProfileStartup(int argc, char* argv[])
+{
+    int iterations = 5;
+    std::size_t level_index = 0;
+    try {
+        if (const auto text = getArgValue(argc, argv, "--profile-startup="); !text.empty()) {
+            iterations = std::max(1, std::stoi(text));
+        }
+        if (const auto level = getArgValue(argc, argv, "--level="); !level.empty()) {
+            level_index = static_cast<std::size_t>(std::max(1, std::stoi(level)) - 1);
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("启动剖析参数无效: {}", e.what());
+        return 1;
+    }
+    std::string output_path = getArgValue(argc, argv, "--profile-startup-out=");
+    if (output_path.empty()) {
+        output_path = "startup_profile.csv";
+    }
+
+    auto& startup = engine::core::StartupProfiler::instance();
+    startup.setEnabled(true);
+    bool all_reached = true;
+    for (int i = 0; i < iterations; ++i) {
+        spdlog::info("启动剖析：第 {} / {} 次", i + 1, iterations);
+        startup.beginRun();
+        {
+            engine::core::GameApp app;
+            app.setRendererBackend(getRendererBackendFromArgs(argc, argv));
+            app.setStartupProfiling(true);
+            app.setOnInitCallback([level_index](engine::core::Context& context) {
+                std::unique_ptr<engine::scene::Scene> scene;
+                {
+                    ENGINE_STARTUP_PHASE("scene.construct");
+                    scene = std::make_unique<game::scene::GameScene>(context, level_index);
+                }
+                context.getDispatcher().trigger<engine::utils::PushSceneEvent>(engine::utils::PushSceneEvent{ std::move(scene) });
+            });
+            app.run();
+        }
+        if (!startup.hasMark("t.first_scene_frame")) {
+            spdlog::error("启动剖析：第 {} 次没有到达本关首帧", i + 1);
+            all_reached = false;
+        }
+        startup.endRun();
+    }
+    startup.writeReport(output_path);
+    startup.setEnabled(false);
+    return all_reached ? 0 : 1;
+}
+
 /**
  * @brief 游戏的主入口函数。
  * @param argc 命令行参数数量
@@ -38,11 +543,28 @@ static std::string getRendererBackendFromArgs(int argc, char* argv[])
  * 
  * @details 该函数是游戏的入口点，负责以下操作：
  * 1. 创建 GameApp 实例
- * 2. 设置 spdlog 日志级别为 trace，用于详细的调试信息
- * 3. 启动游戏应用的运行循环
- * 4. 返回退出状态码
+ * 2. 初始化日志（--log-file=<路径> 时启用异步文件日志），--headless 时进入无头模拟，--sweep 时并行批量模拟，
+ *    --perf-scenarios[=路径] 时执行压力场景（任一失败时退出码为 1），
+ *    --cook-levels 时预编译关卡后退出，--cook-blueprints 时预编译蓝图后退出，--pack-assets 时把 assets/ 打包为 assets.mwpak 后退出，
+ *    --profile-startup[=N] 时重复 N 次启动并进入关卡，输出各阶段耗时汇总后退出（见 runProfileStartup）
+ * 3. 挂载资源包（存在时）；--loose-assets 时磁盘上的松散文件优先于包内条目；
+ *    --memreport[=路径] 时每个场景退出前输出按子系统的内存报告（日志，指定路径时另写 CSV）；
+ *    --cost-attribution 时战斗场景与无头模拟按单位类型归因索敌、动画事件与战斗结算的开销，结束时输出汇总（见 class_cost_profiler.h）；
+ *    --zero-alloc 时报告开战后 GameScene::update 内的堆分配，--zero-alloc=assert 时在分配处断言（调试构建）；
+ *    --capture[=目录] 时启动即开始录帧（默认 captures/，F12 截图、F9 开关录制）；
+ *    --render-bench 时以渲染压测场景代替标题界面（规模见 parseRenderBenchmarkOptions，可与 --renderer= 组合）；
+ *    --coop-host= / --coop-join= 时联机握手后直接进入双人合作对局（见 parseCoopOptions）
+ * 4. 启动游戏应用的运行循环
+ * 5. 返回退出状态码
  */
 void setupInitialScene(engine::core::Context& context) {
+    // UI 用到的字号在工作线程上打开、随后在主线程预先光栅化常用字符，新字号第一次出现时不再卡顿
+    if (game::data::UIConfig ui_config; ui_config.load("assets/data/ui_config.json")) {
+        engine::resource::PreloadManifest fonts;
+        fonts.fonts_ = ui_config.getFontPreload();
+        context.getResourceManager().requestPreload(fonts);
+    }
+
     // GameApp在调用run方法之前，先创建并设置初始场景
     auto game_scene = std::unique_ptr<engine::scene::Scene>(new game::scene::TitleScene(context));
     auto& dispatcher = context.getDispatcher();
@@ -56,10 +578,85 @@ void setupInitialScene(engine::core::Context& context) {
 
 int main(int argc, char* argv[]) {
     _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
-    engine::core::GameApp app;
-    spdlog::set_level(spdlog::level::debug);
-    app.setRendererBackend(getRendererBackendFromArgs(argc, argv));
-    app.setOnInitCallback(setupInitialScene);
-    app.run();
+    setupLogging(getArgValue(argc, argv, "--log-file="));
+    if (hasArg(argc, argv, "--pack-assets")) {
+        const int exit_code = runPackAssets(argc, argv);
+        shutdownLogging();
+        return exit_code;
+    }
+    auto& vfs = engine::io::VirtualFS::instance();
+    vfs.setLooseOverride(hasArg(argc, argv, "--loose-assets"));
+    vfs.mount(ASSET_PACK_PATH);
+    game::data::setCostAttributionEnabled(hasArg(argc, argv, "--cost-attribution"));
+    if (hasArg(argc, argv, "--headless")) {
+        const int exit_code = runHeadless(argc, argv);
+        shutdownLogging();
+        return exit_code;
+    }
+    if (hasArg(argc, argv, "--sweep")) {
+        const int exit_code = runSweep(argc, argv);
+        shutdownLogging();
+        return exit_code;
+    }
+    if (hasArg(argc, argv, "--perf-scenarios") || !getArgValue(argc, argv, "--perf-scenarios=").empty()) {
+        const int exit_code = runPerfScenarios(argc, argv);
+        shutdownLogging();
+        return exit_code;
+    }
+    if (hasArg(argc, argv, "--cook-levels")) {
+        const int exit_code = runCookLevels(argc, argv);
+        shutdownLogging();
+        return exit_code;
+    }
+    if (hasArg(argc, argv, "--cook-blueprints")) {
+        const int exit_code = runCookBlueprints();
+        shutdownLogging();
+        return exit_code;
+    }
+    if (hasArg(argc, argv, "--profile-startup") || !getArgValue(argc, argv, "--profile-startup=").empty()) {
+        const int exit_code = runProfileStartup(argc, argv);
+        shutdownLogging();
+        return exit_code;
+    }
+    if (const auto memreport_path = getArgValue(argc, argv, "--memreport="); !memreport_path.empty() || hasArg(argc, argv, "--memreport")) {
+        auto& tracker = engine::memory::MemoryTracker::instance();
+        tracker.setReportEnabled(true);
+        tracker.setReportPath(memreport_path);
+    }
+    if (const auto zero_alloc = getArgValue(argc, argv, "--zero-alloc="); !zero_alloc.empty() || hasArg(argc, argv, "--zero-alloc")) {
+        engine::memory::setZeroAllocationMode(zero_alloc == "assert" ? engine::memory::ZeroAllocationMode::ASSERT
+                                                                     : engine::memory::ZeroAllocationMode::WARN);
+    }
+    const bool render_bench = hasArg(argc, argv, "--render-bench");
+    game::scene::RenderBenchmarkOptions bench_options;
+    if (render_bench && !parseRenderBenchmarkOptions(argc, argv, bench_options)) {
+        shutdownLogging();
+        return 1;
+    }
+    bool coop_error = false;
+    const auto coop = parseCoopOptions(argc, argv, coop_error);
+    if (coop_error) {
+        shutdownLogging();
+        return 1;
+    }
+    {
+        // GameApp 需在 spdlog::shutdown 之前析构，以便析构期间的日志仍可输出
+        engine::core::GameApp app;
+        app.setRendererBackend(getRendererBackendFromArgs(argc, argv));
+        const auto capture_dir = getArgValue(argc, argv, "--capture=");
+        app.setCaptureOptions(!capture_dir.empty() || hasArg(argc, argv, "--capture"), capture_dir);
+        if (render_bench) {
+            app.setOnInitCallback([bench_options](engine::core::Context& context) {
+                context.getDispatcher().trigger<engine::utils::PushSceneEvent>(engine::utils::PushSceneEvent{
+                    std::unique_ptr<engine::scene::Scene>(new game::scene::RenderBenchmarkScene(context, bench_options)) });
+            });
+        } else if (coop) {
+            app.setOnInitCallback([coop](engine::core::Context& context) { setupCoopScene(context, coop->first, coop->second); });
+        } else {
+            app.setOnInitCallback(setupInitialScene);
+        }
+        app.run();
+    }
+    shutdownLogging();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "content_cooker.h"
+#include "engine/io/asset_pack.h"
+#include "engine/loader/cooked_level.h"
+#include "engine/loader/level_loader.h"
+#include "game/factory/blueprint_manager.h"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace game::cook {
+
+namespace {
+
+/// @brief 清单与步骤名统一使用 '/' 分隔的路径
+std::string genericPath(const std::filesystem::path& path) {
+    return path.lexically_normal().generic_string();
+}
+
+} // namespace
+
+CookReport ContentCooker::run() {
+    if (!options_.force_) {
+        manifest_.load(options_.manifest_path_);
+    }
+    CookReport report;
+    cookLevels(report);
+    cookBlueprints(report);
+    if (options_.pack_) {
+        packAssets(report);
+    }
+
+    std::string error_message;
+    if (!manifest_.save(options_.manifest_path_, error_message)) {
+        spdlog::error("{}", error_message);
+        ++report.failed_;
+    }
+    spdlog::info("预编译完成: 重建 {} 个，跳过 {} 个，失败 {} 个（本次哈希 {} KB）",
+                 report.built_, report.skipped_, report.failed_, manifest_.bytesHashed() / 1024);
+    return report;
+}
+
+void ContentCooker::runStep(const std::string& step, const std::vector<std::string>& inputs, const std::vector<std::string>& outputs,
+                            bool track_write_time, const std::function<bool(std::string&)>& build, CookReport& report) {
+    if (!options_.force_ && manifest_.isUpToDate(step, inputs, outputs, track_write_time)) {
+        spdlog::debug("已是最新: {}", step);
+        ++report.skipped_;
+        return;
+    }
+    std::string error_message;
+    if (!build(error_message)) {
+        spdlog::error("{} 失败: {}", step, error_message);
+        manifest_.forget(step);
+        ++report.failed_;
+        return;
+    }
+    spdlog::info("已重建: {}", step);
+    manifest_.record(step, inputs, outputs);
+    ++report.built_;
+}
+
+void ContentCooker::cookLevels(CookReport& report) {
+    std::error_code ec;
+    std::vector<std::string> maps;
+    for (const auto& entry : std::filesystem::directory_iterator(options_.maps_dir_, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".tmj") {
+            maps.push_back(genericPath(entry.path()));
+        }
+    }
+    if (ec) {
+        spdlog::error("无法遍历地图目录 '{}': {}", options_.maps_dir_, ec.message());
+        ++report.failed_;
+        return;
+    }
+    std::ranges::sort(maps);
+    for (const auto& map : maps) {
+        const auto output = genericPath(engine::loader::cooked::cookedPathFor(map));
+        // .mwl 记录了源文件的修改时间，运行时按修改时间判过期
+        runStep("level:" + map, levelInputs(map), { output }, true, [&map](std::string& error_message) {
+            return engine::loader::LevelLoader::cookLevel(map, {}, error_message);
+        }, report);
+    }
+}
+
+void ContentCooker::cookBlueprints(CookReport& report) {
+    for (const auto& path : game::factory::BlueprintSources{}.paths()) {
+        const auto source = genericPath(path);
+        const auto output = genericPath(std::filesystem::path(source).replace_extension(".mwb"));
+        runStep("blueprint:" + source, { source }, { output }, true, [&source](std::string& error_message) {
+            return game::factory::BlueprintManager::cookBlueprintFile(source, error_message);
+        }, report);
+    }
+}
+
+void ContentCooker::packAssets(CookReport& report) {
+    std::error_code ec;
+    const auto pack_abs = std::filesystem::weakly_canonical(options_.pack_path_, ec);
+    std::vector<std::string> inputs;
+    for (auto it = std::filesystem::recursive_directory_iterator(options_.assets_dir_, ec);
+         !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        if (!it->is_regular_file()) {
+            continue;
+        }
+        // 与 writeAssetPack 的取舍一致：不打包资源包自身与未写完的临时文件
+        const auto& file = it->path();
+        std::error_code same_ec;
+        if (file.extension() == engine::io::pack::EXTENSION || file.extension() == ".tmp" ||
+            std::filesystem::equivalent(file, pack_abs, same_ec)) {
+            continue;
+        }
+        inputs.push_back(genericPath(file));
+    }
+    if (ec) {
+        spdlog::error("无法遍历资源目录 '{}': {}", options_.assets_dir_, ec.message());
+        ++report.failed_;
+        return;
+    }
+    std::ranges::sort(inputs);
+    // 包内只有文件内容，修改时间变化不需要重打
+    runStep("pack", inputs, { genericPath(options_.pack_path_) }, false, [this](std::string& error_message) {
+        std::error_code cwd_ec;
+        const auto base = std::filesystem::current_path(cwd_ec).string();
+        return engine::io::pack::writeAssetPack(options_.assets_dir_, options_.pack_path_, base, error_message);
+    }, report);
+}
+
+std::vector<std::string> ContentCooker::levelInputs(const std::string& map_path) {
+    std::vector<std::string> inputs{ map_path };
+    std::ifstream file(map_path);
+    if (!file.is_open()) {
+        return inputs;      // 由 cookLevel 报告错误
+    }
+    const auto json = nlohmann::json::parse(file, nullptr, false);
+    if (json.is_discarded() || !json.contains("tilesets") || !json["tilesets"].is_array()) {
+        return inputs;
+    }
+    const auto map_dir = std::filesystem::path(map_path).parent_path();
+    for (const auto& tileset : json["tilesets"]) {
+        if (tileset.contains("source") && tileset["source"].is_string()) {
+            inputs.push_back(genericPath(map_dir / tileset["source"].get<std::string>()));
+        }
+    }
+    std::ranges::sort(inputs);
+    inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+    return inputs;
+}
+
+} // namespace game::cook
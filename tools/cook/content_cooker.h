@@ -0,0 +1,65 @@
+#pragma once
+/**
+ * @file content_cooker.h
+ * @brief 统一的离线预编译：关卡（.mwl）、蓝图（.mwb）与资源包（.mwpak），按 CookManifest 只重建变化的部分。
+ *
+ * @details
+ * 步骤按依赖顺序执行，每个步骤只在输入内容（或产物）变化时运行：
+ * | 步骤 | 输入 | 输出 | 实现 |
+ * |------|------|------|------|
+ * | `level:<地图>` | .tmj 及其引用的全部 .tsj | 同目录 .mwl | LevelLoader::cookLevel |
+ * | `blueprint:<文件>` | BlueprintSources 中的一个 JSON | 同目录 .mwb | BlueprintManager::cookBlueprintFile |
+ * | `pack` | assets/ 下全部文件（含刚生成的 .mwl / .mwb） | assets.mwpak | pack::writeAssetPack |
+ *
+ * 资源包最后打：任一关卡或蓝图重建后产物内容变化，打包步骤随之重跑。
+ * 运行时的取用方式不变：LevelLoader / BlueprintManager 优先读未过期的预编译文件，main() 挂载资源包。
+ */
+
+#include "cook_manifest.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace game::cook {
+
+struct CookOptions {
+    std::string assets_dir_ = "assets";
+    std::string maps_dir_ = "assets/maps";
+    std::string manifest_path_ = "cook_manifest.json";
+    std::string pack_path_ = "assets.mwpak";     ///< 与 main() 挂载的路径一致
+    bool pack_ = true;                           ///< 是否打资源包
+    bool force_ = false;                         ///< 忽略清单，全部重建
+};
+
+struct CookReport {
+    std::size_t built_ = 0;
+    std::size_t skipped_ = 0;
+    std::size_t failed_ = 0;
+};
+
+class ContentCooker final {
+public:
+    explicit ContentCooker(CookOptions options) : options_(std::move(options)) {}
+
+    /// @brief 执行全部步骤并写回清单
+    CookReport run();
+
+private:
+    /// @brief 执行一个步骤：已是最新则跳过，否则构建并记录
+    void runStep(const std::string& step, const std::vector<std::string>& inputs, const std::vector<std::string>& outputs,
+                 bool track_write_time, const std::function<bool(std::string&)>& build, CookReport& report);
+
+    void cookLevels(CookReport& report);
+    void cookBlueprints(CookReport& report);
+    void packAssets(CookReport& report);
+
+    /// @brief 关卡的全部源文件：地图本身及其引用的外部 tileset
+    [[nodiscard]] static std::vector<std::string> levelInputs(const std::string& map_path);
+
+    CookOptions options_;
+    CookManifest manifest_;
+};
+
+} // namespace game::cook
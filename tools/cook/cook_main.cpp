@@ -0,0 +1,63 @@
+/**
+ * @file cook_main.cpp
+ * @brief 离线预编译工具入口：MonsterWar-cook。
+ *
+ * @details
+ * 在仓库根目录运行（或由构建目标 `cook` 调用），只重建输入变化的产物：
+ * @code
+ * MonsterWar-cook                     # 关卡 + 蓝图 + assets.mwpak
+ * MonsterWar-cook --no-pack           # 只预编译关卡与蓝图（开发时配合 --loose-assets）
+ * MonsterWar-cook --force             # 忽略清单，全部重建
+ * MonsterWar-cook --manifest=build/cook_manifest.json --output=build/assets.mwpak
+ * @endcode
+ * 不挂载资源包：工具读取的始终是磁盘上的松散文件。任一步骤失败时退出码为 1。
+ */
+
+#include "content_cooker.h"
+#include <spdlog/spdlog.h>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+bool hasArg(int argc, char* argv[], std::string_view flag) {
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i] != nullptr && flag == argv[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void readArg(int argc, char* argv[], std::string_view prefix, std::string& value) {
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i] == nullptr) {
+            continue;
+        }
+        const std::string_view arg = argv[i];
+        if (arg.starts_with(prefix)) {
+            value = std::string(arg.substr(prefix.size()));
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    spdlog::set_pattern("[%H:%M:%S.%e] [%^%l%$] %v");
+    if (hasArg(argc, argv, "--verbose")) {
+        spdlog::set_level(spdlog::level::debug);
+    }
+
+    game::cook::CookOptions options;
+    readArg(argc, argv, "--assets=", options.assets_dir_);
+    readArg(argc, argv, "--maps=", options.maps_dir_);
+    readArg(argc, argv, "--manifest=", options.manifest_path_);
+    readArg(argc, argv, "--output=", options.pack_path_);
+    options.pack_ = !hasArg(argc, argv, "--no-pack");
+    options.force_ = hasArg(argc, argv, "--force");
+
+    const auto report = game::cook::ContentCooker(std::move(options)).run();
+    return report.failed_ == 0 ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+#include "cook_manifest.h"
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <array>
+#include <filesystem>
+#include <fstream>
+
+namespace game::cook {
+
+namespace {
+
+constexpr int MANIFEST_VERSION = 1;
+
+std::uint64_t hashFile(const std::string& path, std::size_t& bytes_hashed, bool& ok) {
+    std::ifstream file(path, std::ios::binary);
+    ok = file.is_open();
+    std::uint64_t hash = 14695981039346656037ull;
+    std::array<char, 64 * 1024> buffer{};
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const auto count = static_cast<std::size_t>(file.gcount());
+        for (std::size_t i = 0; i < count; ++i) {
+            hash ^= static_cast<std::uint8_t>(buffer[i]);
+            hash *= 1099511628211ull;
+        }
+        bytes_hashed += count;
+    }
+    ok = ok && !file.bad();
+    return hash;
+}
+
+nlohmann::json toJson(const FileFingerprint& fingerprint) {
+    return { { "size", fingerprint.size_ }, { "write_time", fingerprint.write_time_ }, { "hash", fingerprint.hash_ } };
+}
+
+FileFingerprint fromJson(const nlohmann::json& json) {
+    FileFingerprint fingerprint;
+    fingerprint.size_ = json.value("size", std::uint64_t{0});
+    fingerprint.write_time_ = json.value("write_time", std::int64_t{0});
+    fingerprint.hash_ = json.value("hash", std::uint64_t{0});
+    return fingerprint;
+}
+
+} // namespace
+
+void CookManifest::load(const std::string& path) {
+    files_.clear();
+    steps_.clear();
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return;
+    }
+    try {
+        const auto json = nlohmann::json::parse(file);
+        if (json.value("version", 0) != MANIFEST_VERSION) {
+            spdlog::info("预编译清单版本不符，全部重建: {}", path);
+            return;
+        }
+        for (const auto& [file_path, entry] : json.at("files").items()) {
+            files_[file_path] = fromJson(entry);
+        }
+        for (const auto& [name, entry] : json.at("steps").items()) {
+            auto& step = steps_[name];
+            for (const auto& [input, fingerprint] : entry.at("inputs").items()) {
+                step.inputs_[input] = fromJson(fingerprint);
+            }
+            for (const auto& [output, fingerprint] : entry.at("outputs").items()) {
+                step.outputs_[output] = fromJson(fingerprint);
+            }
+        }
+    } catch (const nlohmann::json::exception& e) {
+        spdlog::warn("无法解析预编译清单，全部重建: {} ({})", path, e.what());
+        files_.clear();
+        steps_.clear();
+    }
+}
+
+bool CookManifest::save(const std::string& path, std::string& error_message) const {
+    nlohmann::json files = nlohmann::json::object();
+    for (const auto& [file_path, fingerprint] : files_) {
+        files[file_path] = toJson(fingerprint);
+    }
+    nlohmann::json steps = nlohmann::json::object();
+    for (const auto& [name, step] : steps_) {
+        nlohmann::json inputs = nlohmann::json::object();
+        for (const auto& [input, fingerprint] : step.inputs_) {
+            inputs[input] = toJson(fingerprint);
+        }
+        nlohmann::json outputs = nlohmann::json::object();
+        for (const auto& [output, fingerprint] : step.outputs_) {
+            outputs[output] = toJson(fingerprint);
+        }
+        steps[name] = { { "inputs", std::move(inputs) }, { "outputs", std::move(outputs) } };
+    }
+    const nlohmann::json json = { { "version", MANIFEST_VERSION }, { "files", std::move(files) }, { "steps", std::move(steps) } };
+
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::trunc);
+        if (!file.is_open()) {
+            error_message = "无法写入预编译清单: " + temp_path;
+            return false;
+        }
+        file << json.dump(2);
+        if (!file) {
+            error_message = "写入预编译清单失败: " + temp_path;
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        error_message = "无法替换预编译清单: " + path;
+        return false;
+    }
+    return true;
+}
+
+std::optional<FileFingerprint> CookManifest::fingerprint(const std::string& path) {
+    std::error_code ec;
+    FileFingerprint current;
+    current.size_ = static_cast<std::uint64_t>(std::filesystem::file_size(path, ec));
+    if (ec) {
+        files_.erase(path);
+        return std::nullopt;
+    }
+    current.write_time_ = static_cast<std::int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+    if (ec) {
+        files_.erase(path);
+        return std::nullopt;
+    }
+
+    auto& cached = files_[path];
+    if (cached.size_ == current.size_ && cached.write_time_ == current.write_time_ && cached.hash_ != 0) {
+        return cached;
+    }
+    bool ok = false;
+    current.hash_ = hashFile(path, bytes_hashed_, ok);
+    if (!ok) {
+        files_.erase(path);
+        return std::nullopt;
+    }
+    cached = current;
+    return cached;
+}
+
+bool CookManifest::isUpToDate(const std::string& step, const std::vector<std::string>& inputs,
+                              const std::vector<std::string>& outputs, bool track_write_time) {
+    const auto it = steps_.find(step);
+    if (it == steps_.end() || it->second.inputs_.size() != inputs.size() || it->second.outputs_.size() != outputs.size()) {
+        return false;
+    }
+    const auto unchanged = [this](const std::map<std::string, FileFingerprint>& recorded,
+                                                    const std::string& path, bool compare_time) {
+        const auto entry = recorded.find(path);
+        if (entry == recorded.end()) {
+            return false;
+        }
+        const auto current = fingerprint(path);
+        return current && current->hash_ == entry->second.hash_ &&
+               (!compare_time || current->write_time_ == entry->second.write_time_);
+    };
+    for (const auto& input : inputs) {
+        if (!unchanged(it->second.inputs_, input, track_write_time)) {
+            return false;
+        }
+    }
+    // 产物只比内容：被手动删除或改写时重建
+    for (const auto& output : outputs) {
+        if (!unchanged(it->second.outputs_, output, false)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CookManifest::record(const std::string& step, const std::vector<std::string>& inputs, const std::vector<std::string>& outputs) {
+    Step entry;
+    for (const auto& input : inputs) {
+        if (const auto current = fingerprint(input)) {
+            entry.inputs_[input] = *current;
+        }
+    }
+    for (const auto& output : outputs) {
+        if (const auto current = fingerprint(output)) {
+            entry.outputs_[output] = *current;
+        }
+    }
+    steps_[step] = std::move(entry);
+}
+
+} // namespace game::cook
@@ -0,0 +1,73 @@
+#pragma once
+/**
+ * @file cook_manifest.h
+ * @brief 预编译工具的增量清单：记录每个源文件的内容哈希与每个预编译步骤上次的输入，未变化的步骤直接跳过。
+ *
+ * @details
+ * 清单是一份 JSON（默认 cook_manifest.json，位于工作目录），两部分：
+ * - files：路径 → { size, write_time, hash }。大小与修改时间都未变化时沿用记录的哈希，不重新读文件
+ * - steps：步骤名 → { inputs: 路径 → 哈希（及修改时间）, outputs: [路径] }
+ *
+ * 步骤「已是最新」的条件：输入集合与各输入的内容哈希与上次一致，且全部输出仍然存在、未被改动。
+ * 产物内嵌源文件修改时间的步骤（.mwl / .mwb，运行时按修改时间判过期）以 track_write_time 调用，
+ * 内容相同但修改时间变化时同样重建，保证运行时不会拒绝刚跳过的产物。
+ *
+ * 哈希为 64 位 FNV-1a，只用于判断变化，不用于校验完整性。
+ */
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace game::cook {
+
+/// @brief 一个文件在某一时刻的状态
+struct FileFingerprint {
+    std::uint64_t size_{0};
+    std::int64_t write_time_{0};        ///< std::filesystem::file_time_type 的计数
+    std::uint64_t hash_{0};
+};
+
+class CookManifest final {
+public:
+    /**
+     * @brief 读取清单；文件不存在或无法解析时从空清单开始（首次运行即全部重建）
+     */
+    void load(const std::string& path);
+    /// @brief 写出清单（先写临时文件再重命名）
+    bool save(const std::string& path, std::string& error_message) const;
+
+    /**
+     * @brief 取得文件当前的指纹（大小与修改时间未变时复用记录的哈希）
+     * @return 文件不存在或无法读取时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<FileFingerprint> fingerprint(const std::string& path);
+
+    /**
+     * @brief 步骤是否已是最新
+     * @param track_write_time 产物内嵌源文件修改时间时为 true：修改时间变化也要重建
+     */
+    [[nodiscard]] bool isUpToDate(const std::string& step, const std::vector<std::string>& inputs,
+                                  const std::vector<std::string>& outputs, bool track_write_time);
+    /// @brief 步骤成功后记下当前的输入与输出
+    void record(const std::string& step, const std::vector<std::string>& inputs, const std::vector<std::string>& outputs);
+    /// @brief 删除步骤记录（步骤失败时，下次必定重建）
+    void forget(const std::string& step) { steps_.erase(step); }
+
+    [[nodiscard]] std::size_t fileCount() const { return files_.size(); }
+    [[nodiscard]] std::size_t bytesHashed() const { return bytes_hashed_; }
+
+private:
+    struct Step {
+        std::map<std::string, FileFingerprint> inputs_;
+        std::map<std::string, FileFingerprint> outputs_;
+    };
+
+    std::map<std::string, FileFingerprint> files_;
+    std::map<std::string, Step> steps_;
+    std::size_t bytes_hashed_{0};       ///< 本次运行实际读取并哈希的字节数（日志用）
+};
+
+} // namespace game::cook
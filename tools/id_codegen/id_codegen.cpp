@@ -0,0 +1,262 @@
+/**
+ * @file id_codegen.cpp
+ * @brief 构建期 ID 表生成器：扫描数据 JSON 与配置，生成 game::ids 的稠密枚举与哈希↔下标表。
+ *
+ * @details
+ * 用法：monsterwar-idgen <输出头文件> <数据目录> <config.json>
+ *
+ * 每一类 ID 取自固定的数据位置，按名称排序后编号（结果与 JSON 中的顺序无关）：
+ * | 类别         | 来源 |
+ * |--------------|------|
+ * | Animation    | enemy_data / player_data 中每个职业 "animation" 的键，外加代码中使用的 "fly" |
+ * | FrameEvent   | 上述动画 "events" 的键 |
+ * | SoundAction  | enemy / player / projectile 数据 "sounds" 的键 |
+ * | Effect       | effect_data.json 的顶层键 |
+ * | Skill        | skill_data.json 的顶层键 |
+ * | InputAction  | config.json "input_mappings" 的键 |
+ *
+ * 哈希与 entt::hashed_string 相同（32 位 FNV-1a）。同一类别中两个名称哈希相同、或名称不能转成 C++ 标识符时
+ * 生成失败（返回非零），构建随之中止。输出内容未变化时不改写文件，避免无谓的重新编译。
+ */
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// @brief 与 entt::basic_hashed_string 的 32 位实现相同
+std::uint32_t fnv1a(const std::string& text) {
+    std::uint32_t value = 2166136261u;
+    for (const unsigned char c : text) {
+        value = (value ^ c) * 16777619u;
+    }
+    return value;
+}
+
+struct Category {
+    std::string enum_name_;
+    std::string description_;
+    std::set<std::string> names_;
+};
+
+bool readJson(const std::filesystem::path& path, nlohmann::json& json) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "id_codegen: 无法打开 " << path.string() << "\n";
+        return false;
+    }
+    try {
+        json = nlohmann::json::parse(file, nullptr, true, true);
+    } catch (const nlohmann::json::exception& e) {
+        std::cerr << "id_codegen: 解析 " << path.string() << " 失败: " << e.what() << "\n";
+        return false;
+    }
+    return true;
+}
+
+/// @brief "ranged_attack" -> "RANGED_ATTACK"；不能成为标识符时返回空串
+std::string toEnumerator(const std::string& name) {
+    std::string result;
+    for (const unsigned char c : name) {
+        if (std::isalnum(c)) {
+            result.push_back(static_cast<char>(std::toupper(c)));
+        } else if (c == '_' || c == '-' || c == ' ') {
+            result.push_back('_');
+        } else {
+            return {};
+        }
+    }
+    if (result.empty() || std::isdigit(static_cast<unsigned char>(result.front())) || result == "COUNT") {
+        return {};
+    }
+    return result;
+}
+
+void collectClassData(const nlohmann::json& classes, Category& animations, Category& events, Category& sounds) {
+    if (!classes.is_object()) {
+        return;
+    }
+    for (const auto& [class_name, data] : classes.items()) {
+        if (!data.is_object()) {
+            continue;
+        }
+        if (const auto it = data.find("animation"); it != data.end() && it->is_object()) {
+            for (const auto& [animation_name, animation] : it->items()) {
+                // 特效与投射物的 "animation" 是单个动画（键为 duration / frames 等），这里只处理职业的动画表
+                if (!animation.is_object()) {
+                    continue;
+                }
+                animations.names_.insert(animation_name);
+                if (const auto events_it = animation.find("events"); events_it != animation.end() && events_it->is_object()) {
+                    for (const auto& [event_name, frame] : events_it->items()) {
+                        events.names_.insert(event_name);
+                    }
+                }
+            }
+        }
+        if (const auto it = data.find("sounds"); it != data.end() && it->is_object()) {
+            for (const auto& [action, sound] : it->items()) {
+                sounds.names_.insert(action);
+            }
+        }
+    }
+}
+
+void collectKeys(const nlohmann::json& json, Category& category) {
+    if (!json.is_object()) {
+        return;
+    }
+    for (const auto& [key, value] : json.items()) {
+        category.names_.insert(key);
+    }
+}
+
+bool writeCategory(std::ostringstream& out, const Category& category) {
+    std::vector<std::string> names(category.names_.begin(), category.names_.end());
+    std::map<std::uint32_t, std::string> by_hash;
+    std::vector<std::string> enumerators;
+    for (const auto& name : names) {
+        const auto enumerator = toEnumerator(name);
+        if (enumerator.empty()) {
+            std::cerr << "id_codegen: " << category.enum_name_ << " 名称 \"" << name << "\" 不能转换为枚举标识符\n";
+            return false;
+        }
+        if (std::find(enumerators.begin(), enumerators.end(), enumerator) != enumerators.end()) {
+            std::cerr << "id_codegen: " << category.enum_name_ << " 中有多个名称对应枚举 " << enumerator << "\n";
+            return false;
+        }
+        enumerators.push_back(enumerator);
+        const auto hash = fnv1a(name);
+        if (const auto [it, inserted] = by_hash.emplace(hash, name); !inserted) {
+            std::cerr << "id_codegen: " << category.enum_name_ << " 哈希冲突: \"" << it->second << "\" 与 \"" << name << "\"\n";
+            return false;
+        }
+    }
+    if (names.size() > 255) {
+        std::cerr << "id_codegen: " << category.enum_name_ << " 超过 255 项\n";
+        return false;
+    }
+
+    const auto& type = category.enum_name_;
+    out << "/// @brief " << category.description_ << "\n";
+    out << "enum class " << type << " : std::uint8_t {\n";
+    for (const auto& enumerator : enumerators) {
+        out << "    " << enumerator << ",\n";
+    }
+    out << "    COUNT\n};\n\n";
+
+    out << "template<>\nstruct IdTable<" << type << "> {\n";
+    out << "    static constexpr std::size_t SIZE = " << names.size() << ";\n";
+    out << "    static constexpr std::array<std::string_view, SIZE> NAMES{";
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        out << (i == 0 ? "\n        " : ",\n        ") << '"' << names[i] << '"';
+    }
+    out << (names.empty() ? "" : "\n    ") << "};\n";
+    out << "    static constexpr std::array<entt::id_type, SIZE> HASHES{";
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "0x%08Xu", fnv1a(names[i]));
+        out << (i == 0 ? "\n        " : ",\n        ") << buffer;
+    }
+    out << (names.empty() ? "" : "\n    ") << "};\n";
+    out << "    /// 按哈希升序的 (哈希, 下标)，fromHash() 二分查找\n";
+    out << "    static constexpr std::array<std::pair<entt::id_type, std::uint8_t>, SIZE> BY_HASH{{";
+    bool first = true;
+    for (const auto& [hash, name] : by_hash) {
+        const auto index = static_cast<std::size_t>(std::find(names.begin(), names.end(), name) - names.begin());
+        char buffer[40];
+        std::snprintf(buffer, sizeof(buffer), "{ 0x%08Xu, %zu }", hash, index);
+        out << (first ? "\n        " : ",\n        ") << buffer;
+        first = false;
+    }
+    out << (names.empty() ? "" : "\n    ") << "}};\n};\n\n";
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        std::cerr << "用法: " << argv[0] << " <输出头文件> <数据目录> <config.json>\n";
+        return 2;
+    }
+    const std::filesystem::path output = argv[1];
+    const std::filesystem::path data_dir = argv[2];
+    const std::filesystem::path config_path = argv[3];
+
+    Category animations{ "Animation", "职业动画（animation 表的键）", {} };
+    Category events{ "FrameEvent", "动画帧事件（animation.events 的键）", {} };
+    Category sounds{ "SoundAction", "带音效的动作（sounds 的键）", {} };
+    Category effects{ "Effect", "特效（effect_data.json）", {} };
+    Category skills{ "Skill", "英雄技能（skill_data.json）", {} };
+    Category inputs{ "InputAction", "输入动作（config.json 的 input_mappings）", {} };
+
+    // 投射物的飞行动画由 BlueprintManager::buildProjectileAnimationSet 以固定名称建立，不出现在数据中
+    animations.names_.insert("fly");
+
+    for (const char* file : { "enemy_data.json", "player_data.json", "projectile_data.json" }) {
+        nlohmann::json json;
+        if (!readJson(data_dir / file, json)) {
+            return 1;
+        }
+        collectClassData(json, animations, events, sounds);
+    }
+    nlohmann::json effect_json;
+    nlohmann::json skill_json;
+    nlohmann::json config_json;
+    if (!readJson(data_dir / "effect_data.json", effect_json) || !readJson(data_dir / "skill_data.json", skill_json) ||
+        !readJson(config_path, config_json)) {
+        return 1;
+    }
+    collectKeys(effect_json, effects);
+    collectKeys(skill_json, skills);
+    if (const auto it = config_json.find("input_mappings"); it != config_json.end()) {
+        collectKeys(*it, inputs);
+    }
+
+    std::ostringstream out;
+    out << "#pragma once\n"
+           "// 由 tools/id_codegen 根据 assets/data/*.json 与 assets/config.json 生成，请勿手动修改。\n"
+           "// 辅助函数与编译期校验见 src/game/defs/ids.h。\n\n"
+           "#include <array>\n#include <cstddef>\n#include <cstdint>\n#include <string_view>\n#include <utility>\n"
+           "#include <entt/core/fwd.hpp>\n\n"
+           "namespace game::ids {\n\n"
+           "template<typename Id>\nstruct IdTable;\n\n";
+    for (const auto* category : { &animations, &events, &sounds, &effects, &skills, &inputs }) {
+        if (!writeCategory(out, *category)) {
+            return 1;
+        }
+    }
+    out << "} // namespace game::ids\n";
+
+    const std::string content = out.str();
+    {
+        std::ifstream existing(output, std::ios::binary);
+        if (existing) {
+            const std::string previous((std::istreambuf_iterator<char>(existing)), std::istreambuf_iterator<char>());
+            if (previous == content) {
+                return 0;
+            }
+        }
+    }
+    std::filesystem::create_directories(output.parent_path());
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "id_codegen: 无法写入 " << output.string() << "\n";
+        return 1;
+    }
+    file << content;
+    return file ? 0 : 1;
+}